@@ -62,9 +62,23 @@ namespace gendev
         FileSearch searcher(m_ProjectRoot);
         searcher.SetMaxResults(m_MaxResults);
         searcher.SetContextLines(m_ContextLines);
+        searcher.SetUseIndex(m_UseIndex);
 
         std::vector<SearchResult> results = searcher.Search(query);
 
+        if (m_UseIndex)
+        {
+            const SearchIndex::UpdateStats& stats = searcher.GetIndexStats();
+            if (stats.ScannedFiles > 0 || stats.RemovedFiles > 0)
+            {
+                std::ostringstream indexInfo;
+                indexInfo << "Updated search index: " << stats.ScannedFiles << " file(s) scanned, "
+                          << stats.RemovedFiles << " removed, " << stats.TotalFiles << " indexed";
+                Console::PrintInfo(indexInfo.str());
+                Console::Print("");
+            }
+        }
+
         if (results.empty())
         {
             Console::PrintWarning("No results found for: " + query);
@@ -10,6 +10,7 @@
 
 #include "FileSearch.h"
 
+#include <map>
 #include <string>
 #include <vector>
 
@@ -51,10 +52,16 @@ namespace gendev
          */
         void SetContextLines(int lines) { m_ContextLines = lines; }
 
+        /**
+         * @brief Enable or disable the persistent search index (.gendev/)
+         */
+        void SetUseIndex(bool useIndex) { m_UseIndex = useIndex; }
+
     private:
         std::string m_ProjectRoot;
         size_t m_MaxResults = 10;
         int m_ContextLines = 3;
+        bool m_UseIndex = true;
 
         /**
          * @brief Print search results to console
@@ -0,0 +1,598 @@
+/**
+ * @file BenchCommand.cpp
+ * @brief Implementation of bench command handler
+ */
+
+#include "BenchCommand.h"
+#include "CLI.h"
+#include "SearchIndex.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <sstream>
+
+namespace gendev
+{
+    // ============================================================================
+    // Constants
+    // ============================================================================
+
+    static constexpr unsigned long DEFAULT_REPETITIONS = 10;
+
+    /** Directories never searched for the benchmark executable */
+    static const char* const SKIPPED_DIRECTORIES[] = { "src", "external", "assets", "shaders", "gendev", "tests" };
+
+    // ============================================================================
+    // BenchCommand Implementation
+    // ============================================================================
+
+    BenchCommand::BenchCommand(const std::string& projectRoot)
+        : m_ProjectRoot(projectRoot)
+    {
+    }
+
+    int BenchCommand::Execute(
+        const std::vector<std::string>& args,
+        const std::map<std::string, std::string>& flags)
+    {
+        if (args.empty())
+        {
+            PrintUsage();
+            return 1;
+        }
+
+        std::string subcommand = args[0];
+        std::transform(subcommand.begin(), subcommand.end(), subcommand.begin(),
+            [](unsigned char c) { return std::tolower(c); });
+
+        if (subcommand == "list")
+        {
+            return List();
+        }
+
+        if (!ApplyCompareFlags(flags))
+        {
+            return 1;
+        }
+
+        if (subcommand == "run")
+        {
+            if (args.size() < 2)
+            {
+                Console::PrintError("Error: Missing baseline name.");
+                PrintUsage();
+                return 1;
+            }
+            return Run(args[1], flags);
+        }
+        else if (subcommand == "compare")
+        {
+            if (args.size() < 3)
+            {
+                Console::PrintError("Error: compare needs a baseline and a candidate.");
+                PrintUsage();
+                return 1;
+            }
+            return Compare(args[1], args[2]);
+        }
+        else
+        {
+            Console::PrintError("Error: Unknown bench subcommand '" + subcommand + "'.");
+            Console::Print("Valid subcommands: run, compare, list");
+            return 1;
+        }
+    }
+
+    int BenchCommand::Run(const std::string& name, const std::map<std::string, std::string>& flags)
+    {
+        if (!IsValidBaselineName(name))
+        {
+            Console::PrintError("Error: Invalid baseline name '" + name + "' (use letters, digits, '-', '_', '.').");
+            return 1;
+        }
+
+        auto flag = [&flags](const std::string& key) {
+            auto it = flags.find(key);
+            return it != flags.end() ? it->second : std::string();
+        };
+
+        unsigned long repetitions = DEFAULT_REPETITIONS;
+        if (!flag("repetitions").empty())
+        {
+            try
+            {
+                repetitions = std::stoul(flag("repetitions"));
+            }
+            catch (...)
+            {
+                repetitions = 0;
+            }
+
+            if (repetitions == 0)
+            {
+                Console::PrintError("Error: Invalid repetitions value.");
+                return 1;
+            }
+        }
+
+        std::string executable = flag("bench");
+        if (executable.empty())
+        {
+            executable = FindBenchExecutable();
+        }
+
+        if (executable.empty() || !std::filesystem::exists(executable))
+        {
+            Console::PrintError(std::string("Error: ") + BENCH_EXECUTABLE + " not found.");
+            Console::Print("Configure with -DSM_BUILD_BENCHMARKS=ON and build it, or pass --bench=<path>.");
+            return 1;
+        }
+
+        const std::filesystem::path outputPath = GetBaselinePath(name);
+        std::error_code ec;
+        std::filesystem::create_directories(outputPath.parent_path(), ec);
+
+        // Written beside the baseline and swapped in once it parses, so a failed run keeps the old one
+        std::filesystem::path tempPath = outputPath;
+        tempPath += ".tmp";
+
+        std::ostringstream command;
+        command << "\"" << executable << "\""
+                << " --benchmark_repetitions=" << repetitions
+                << " --benchmark_display_aggregates_only=true"
+                << " --benchmark_out=\"" << tempPath.string() << "\""
+                << " --benchmark_out_format=json";
+        if (!m_Filter.empty())
+        {
+            command << " --benchmark_filter=\"" << m_Filter << "\"";
+        }
+
+        std::string commandLine = command.str();
+#ifdef _WIN32
+        // cmd.exe strips the outer quotes when the line starts with one
+        commandLine = "\"" + commandLine + "\"";
+#endif
+
+        Console::PrintInfo("Running " + std::to_string(repetitions) + " repetition(s): " + executable);
+        Console::Print("");
+
+        const int status = std::system(commandLine.c_str());
+        if (status != 0)
+        {
+            std::filesystem::remove(tempPath, ec);
+            Console::PrintError("Error: Benchmark run failed (exit status " + std::to_string(status) + ").");
+            return 1;
+        }
+
+        BenchResults results;
+        if (!results.Load(tempPath.string()))
+        {
+            std::filesystem::remove(tempPath, ec);
+            Console::PrintError("Error: " + results.GetLastError());
+            return 1;
+        }
+
+        std::filesystem::rename(tempPath, outputPath, ec);
+        if (ec)
+        {
+            Console::PrintError("Error: Failed to store baseline: " + ec.message());
+            return 1;
+        }
+
+        Console::Print("");
+        Console::PrintSuccess("Stored baseline '" + name + "' (" + std::to_string(results.GetBenchmarks().size()) +
+                              " benchmarks): " + outputPath.string());
+
+        if (!flag("compare").empty())
+        {
+            Console::Print("");
+            return Compare(flag("compare"), name);
+        }
+
+        return 0;
+    }
+
+    int BenchCommand::Compare(const std::string& baselineName, const std::string& candidateName)
+    {
+        BenchResults baseline;
+        if (!baseline.Load(GetBaselinePath(baselineName)))
+        {
+            Console::PrintError("Error: Baseline '" + baselineName + "': " + baseline.GetLastError());
+            return 1;
+        }
+
+        BenchResults candidate;
+        if (!candidate.Load(GetBaselinePath(candidateName)))
+        {
+            Console::PrintError("Error: Baseline '" + candidateName + "': " + candidate.GetLastError());
+            return 1;
+        }
+
+        auto describe = [](const std::string& name, const BenchResults& results) {
+            std::string description = "'" + name + "'";
+            const std::string commit = results.GetContext("commit");
+            if (!commit.empty())
+            {
+                description += " (" + commit + ")";
+            }
+            return description;
+        };
+
+        std::vector<BenchComparison> comparisons = CompareBenchResults(baseline, candidate, m_Metric);
+        if (!m_Filter.empty())
+        {
+            try
+            {
+                const std::regex filter(m_Filter);
+                std::erase_if(comparisons, [&filter](const BenchComparison& comparison) {
+                    return !std::regex_search(comparison.Name, filter);
+                });
+            }
+            catch (const std::regex_error&)
+            {
+                Console::PrintError("Error: Invalid filter regex '" + m_Filter + "'.");
+                return 1;
+            }
+        }
+
+        if (comparisons.empty())
+        {
+            Console::PrintWarning("No benchmarks in common between the two baselines.");
+            return 0;
+        }
+
+        std::ostringstream header;
+        header << "Comparing " << describe(baselineName, baseline) << " -> " << describe(candidateName, candidate)
+               << " on " << (m_Metric == BenchMetric::CPUTime ? "CPU" : "real") << " time, alpha " << m_Alpha;
+        Console::PrintInfo(header.str());
+        Console::Print("");
+
+        size_t nameWidth = 9;
+        for (const BenchComparison& comparison : comparisons)
+        {
+            nameWidth = std::max(nameWidth, comparison.Name.size());
+        }
+
+        std::ostringstream columns;
+        columns << std::left << std::setw(static_cast<int>(nameWidth)) << "Benchmark" << std::right
+                << std::setw(13) << "Baseline" << std::setw(13) << "Candidate" << std::setw(10) << "Change"
+                << std::setw(10) << "p-value";
+        Console::Print(columns.str());
+
+        size_t regressions = 0;
+        size_t improvements = 0;
+        bool tooFewRepetitions = false;
+
+        for (const BenchComparison& comparison : comparisons)
+        {
+            // Smallest p-value the exact test can give: every baseline run on one side
+            double arrangements = 1.0;
+            for (size_t i = 1; i <= comparison.BaselineCount; ++i)
+            {
+                arrangements *= static_cast<double>(comparison.CandidateCount + i) / static_cast<double>(i);
+            }
+            if (2.0 / arrangements > m_Alpha)
+            {
+                tooFewRepetitions = true;
+            }
+
+            const double threshold = GetThreshold(comparison.Name);
+            const bool significant = comparison.PValue < m_Alpha;
+
+            std::ostringstream line;
+            line << std::left << std::setw(static_cast<int>(nameWidth)) << comparison.Name << std::right
+                 << std::setw(13) << FormatTime(comparison.BaselineMedian)
+                 << std::setw(13) << FormatTime(comparison.CandidateMedian)
+                 << std::setw(9) << std::fixed << std::setprecision(1) << std::showpos << comparison.ChangePercent
+                 << std::noshowpos << '%' << std::setw(10) << std::setprecision(4) << comparison.PValue;
+
+            if (significant && comparison.ChangePercent > threshold)
+            {
+                line << "  REGRESSION (> " << std::setprecision(1) << threshold << "%)";
+                Console::PrintWarning(line.str());
+                regressions++;
+            }
+            else if (significant && comparison.ChangePercent < -threshold)
+            {
+                line << "  improved";
+                Console::PrintSuccess(line.str());
+                improvements++;
+            }
+            else
+            {
+                Console::Print(line.str());
+            }
+        }
+
+        Console::Print("");
+        if (tooFewRepetitions)
+        {
+            Console::PrintWarning("Warning: Too few repetitions for any difference to be significant; "
+                                  "rerun with a higher --repetitions.");
+        }
+
+        if (m_Filter.empty())
+        {
+            const size_t skipped = baseline.GetBenchmarks().size() + candidate.GetBenchmarks().size() - 2 * comparisons.size();
+            if (skipped > 0)
+            {
+                Console::PrintInfo(std::to_string(skipped) + " benchmark(s) present in only one baseline were skipped.");
+            }
+        }
+
+        if (regressions > 0)
+        {
+            Console::PrintError(std::to_string(regressions) + " regression(s), " + std::to_string(improvements) +
+                                " improvement(s) in " + std::to_string(comparisons.size()) + " benchmarks.");
+            return 1;
+        }
+
+        Console::PrintSuccess("No regressions (" + std::to_string(improvements) + " improvement(s) in " +
+                              std::to_string(comparisons.size()) + " benchmarks).");
+        return 0;
+    }
+
+    int BenchCommand::List()
+    {
+        const std::filesystem::path directory =
+            std::filesystem::path(m_ProjectRoot) / SearchIndex::STATE_DIRECTORY / BASELINE_DIRECTORY;
+
+        std::vector<std::filesystem::path> files;
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator(directory, ec))
+        {
+            if (entry.is_regular_file() && entry.path().extension() == ".json")
+            {
+                files.push_back(entry.path());
+            }
+        }
+
+        if (files.empty())
+        {
+            Console::PrintWarning("No baselines stored. Create one with: gendev bench run <name>");
+            return 0;
+        }
+
+        std::sort(files.begin(), files.end());
+        Console::PrintInfo("Baselines in " + directory.string() + ":");
+
+        for (const std::filesystem::path& file : files)
+        {
+            BenchResults results;
+            std::ostringstream line;
+            line << "  " << std::left << std::setw(24) << file.stem().string();
+
+            if (results.Load(file.string()))
+            {
+                line << results.GetBenchmarks().size() << " benchmarks";
+                const std::string commit = results.GetContext("commit");
+                if (!commit.empty())
+                {
+                    line << ", commit " << commit;
+                }
+                const std::string date = results.GetContext("date");
+                if (!date.empty())
+                {
+                    line << ", " << date;
+                }
+            }
+            else
+            {
+                line << "(unreadable: " << results.GetLastError() << ")";
+            }
+
+            Console::Print(line.str());
+        }
+
+        return 0;
+    }
+
+    bool BenchCommand::ApplyCompareFlags(const std::map<std::string, std::string>& flags)
+    {
+        try
+        {
+            auto it = flags.find("threshold");
+            if (it != flags.end())
+            {
+                m_Threshold = std::stod(it->second);
+            }
+
+            it = flags.find("alpha");
+            if (it != flags.end())
+            {
+                m_Alpha = std::stod(it->second);
+                if (m_Alpha <= 0.0 || m_Alpha >= 1.0)
+                {
+                    Console::PrintError("Error: alpha must be between 0 and 1.");
+                    return false;
+                }
+            }
+
+            // Comma-separated kernel:percent pairs; the percent follows the last ':'
+            it = flags.find("thresholds");
+            if (it != flags.end())
+            {
+                std::stringstream list(it->second);
+                std::string item;
+                while (std::getline(list, item, ','))
+                {
+                    const size_t colon = item.rfind(':');
+                    if (colon == std::string::npos || colon == 0)
+                    {
+                        Console::PrintError("Error: Invalid threshold '" + item + "' (expected kernel:percent).");
+                        return false;
+                    }
+
+                    // "FBM::Sample" names benchmark BM_FBM_Sample
+                    std::string prefix = item.substr(0, colon);
+                    for (size_t pos = prefix.find("::"); pos != std::string::npos; pos = prefix.find("::", pos))
+                    {
+                        prefix.replace(pos, 2, "_");
+                    }
+                    if (prefix.rfind("BM_", 0) != 0)
+                    {
+                        prefix = "BM_" + prefix;
+                    }
+
+                    m_KernelThresholds.emplace_back(prefix, std::stod(item.substr(colon + 1)));
+                }
+            }
+        }
+        catch (...)
+        {
+            Console::PrintError("Error: Invalid threshold or alpha value.");
+            return false;
+        }
+
+        auto filter = flags.find("filter");
+        if (filter != flags.end())
+        {
+            m_Filter = filter->second;
+        }
+
+        auto it = flags.find("metric");
+        if (it != flags.end())
+        {
+            if (it->second == "cpu")
+            {
+                m_Metric = BenchMetric::CPUTime;
+            }
+            else if (it->second == "real")
+            {
+                m_Metric = BenchMetric::RealTime;
+            }
+            else
+            {
+                Console::PrintError("Error: metric must be 'real' or 'cpu'.");
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    double BenchCommand::GetThreshold(const std::string& benchmark) const
+    {
+        double threshold = m_Threshold;
+        size_t matched = 0;
+        for (const auto& [prefix, percent] : m_KernelThresholds)
+        {
+            if (prefix.size() > matched && benchmark.rfind(prefix, 0) == 0)
+            {
+                threshold = percent;
+                matched = prefix.size();
+            }
+        }
+        return threshold;
+    }
+
+    std::string BenchCommand::FindBenchExecutable() const
+    {
+        const std::string names[] = { std::string(BENCH_EXECUTABLE), std::string(BENCH_EXECUTABLE) + ".exe" };
+
+        std::filesystem::path newest;
+        std::filesystem::file_time_type newestTime{};
+
+        std::error_code ec;
+        auto it = std::filesystem::recursive_directory_iterator(
+            m_ProjectRoot,
+            std::filesystem::directory_options::skip_permission_denied,
+            ec);
+
+        for (; !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec))
+        {
+            const auto& entry = *it;
+            const std::string fileName = entry.path().filename().string();
+
+            // Build trees only: no hidden or source directories
+            if (entry.is_directory(ec))
+            {
+                const bool skipped = std::find(std::begin(SKIPPED_DIRECTORIES), std::end(SKIPPED_DIRECTORIES), fileName) !=
+                    std::end(SKIPPED_DIRECTORIES);
+                if (fileName.empty() || fileName[0] == '.' || (it.depth() == 0 && skipped))
+                {
+                    it.disable_recursion_pending();
+                }
+                continue;
+            }
+
+            if (fileName != names[0] && fileName != names[1])
+            {
+                continue;
+            }
+
+            const auto writeTime = entry.last_write_time(ec);
+            if (!ec && (newest.empty() || writeTime > newestTime))
+            {
+                newest = entry.path();
+                newestTime = writeTime;
+            }
+        }
+
+        return newest.string();
+    }
+
+    std::string BenchCommand::GetBaselinePath(const std::string& name) const
+    {
+        return (std::filesystem::path(m_ProjectRoot) / SearchIndex::STATE_DIRECTORY / BASELINE_DIRECTORY /
+                (name + ".json")).string();
+    }
+
+    bool BenchCommand::IsValidBaselineName(const std::string& name)
+    {
+        if (name.empty() || name[0] == '.')
+        {
+            return false;
+        }
+
+        return std::all_of(name.begin(), name.end(), [](unsigned char c) {
+            return std::isalnum(c) || c == '-' || c == '_' || c == '.';
+        });
+    }
+
+    std::string BenchCommand::FormatTime(double nanoseconds)
+    {
+        std::ostringstream text;
+        text << std::fixed << std::setprecision(2);
+        if (nanoseconds >= 1e9) text << nanoseconds / 1e9 << " s";
+        else if (nanoseconds >= 1e6) text << nanoseconds / 1e6 << " ms";
+        else if (nanoseconds >= 1e3) text << nanoseconds / 1e3 << " us";
+        else text << nanoseconds << " ns";
+        return text.str();
+    }
+
+    void BenchCommand::PrintUsage()
+    {
+        Console::Print("Usage: gendev bench <subcommand> [arguments] [options]");
+        Console::Print("");
+        Console::Print("Subcommands:");
+        Console::Print("  run <name>                 Run ShatteredMoonBench and store the report as baseline <name>");
+        Console::Print("  compare <baseline> <name>  Compare two baselines; exits 1 on a regression");
+        Console::Print("  list                       List stored baselines (.gendev/bench/)");
+        Console::Print("");
+        Console::Print("Options:");
+        Console::Print("  --filter=<regex>           Only benchmarks matching the regex");
+        Console::Print("");
+        Console::Print("Run options:");
+        Console::Print("  --repetitions=<n>          Runs of each benchmark (default 10)");
+        Console::Print("  --bench=<path>             Benchmark executable (default: newest build found)");
+        Console::Print("  --compare=<baseline>       Compare against a baseline after the run");
+        Console::Print("");
+        Console::Print("Compare options (also apply to run --compare):");
+        Console::Print("  --threshold=<percent>      Slowdown that counts as a regression (default 5)");
+        Console::Print("  --thresholds=<list>        Per-kernel thresholds, e.g. FBM::Sample:3,World::ForEach:10");
+        Console::Print("  --alpha=<p>                Significance level of the Mann-Whitney U test (default 0.05)");
+        Console::Print("  --metric=real|cpu          Time to compare (default real)");
+        Console::Print("");
+        Console::Print("Examples:");
+        Console::Print("  gendev bench run main");
+        Console::Print("  gendev bench run mychange --compare=main --thresholds=Chunk::BuildVertices:2");
+        Console::Print("  gendev bench compare main mychange --filter=BM_FBM");
+    }
+
+} // namespace gendev
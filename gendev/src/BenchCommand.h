@@ -0,0 +1,132 @@
+/**
+ * @file BenchCommand.h
+ * @brief Bench command handler for gendev
+ *
+ * Handles "gendev bench": runs the ShatteredMoonBench suite with repeated
+ * runs, stores its JSON report as a named baseline under .gendev/bench/,
+ * and compares two baselines, flagging benchmarks that got slower beyond a
+ * threshold with statistical significance.
+ */
+
+#pragma once
+
+#include "BenchResults.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace gendev
+{
+    // ============================================================================
+    // BenchCommand Class
+    // ============================================================================
+
+    /**
+     * @brief Handler for the "bench" command
+     *
+     * Subcommands:
+     *   run <name>                    Run the suite and store the report as baseline <name>
+     *   compare <baseline> <name>     Compare two stored baselines
+     *   list                          List stored baselines
+     */
+    class BenchCommand
+    {
+    public:
+        /**
+         * @brief Construct the bench command handler
+         * @param projectRoot Root directory of the project
+         */
+        explicit BenchCommand(const std::string& projectRoot);
+
+        /**
+         * @brief Execute the bench command
+         * @param args Command arguments (subcommand, baseline names)
+         * @param flags Command flags (e.g., --repetitions=10)
+         * @return Exit code (0 = success or no regressions, 1 = error or regressions)
+         */
+        int Execute(
+            const std::vector<std::string>& args,
+            const std::map<std::string, std::string>& flags);
+
+        /**
+         * @brief Directory under .gendev/ holding the baselines
+         */
+        static constexpr const char* BASELINE_DIRECTORY = "bench";
+
+        /**
+         * @brief Name of the benchmark executable (without extension)
+         */
+        static constexpr const char* BENCH_EXECUTABLE = "ShatteredMoonBench";
+
+    private:
+        std::string m_ProjectRoot;
+
+        // Comparison settings
+        double m_Threshold = 5.0;                       ///< Percent slowdown flagged by default
+        std::vector<std::pair<std::string, double>> m_KernelThresholds;  ///< (name prefix, percent)
+        double m_Alpha = 0.05;                          ///< Significance level
+        BenchMetric m_Metric = BenchMetric::RealTime;
+        std::string m_Filter;                           ///< Regex on benchmark names; empty = all
+
+        /**
+         * @brief Run the suite and store the report
+         * @param name Baseline name
+         * @param flags Command flags (--repetitions, --bench, --compare)
+         * @return Exit code
+         */
+        int Run(const std::string& name, const std::map<std::string, std::string>& flags);
+
+        /**
+         * @brief Compare two stored baselines and print the table
+         * @param baselineName Reference baseline
+         * @param candidateName Baseline being checked
+         * @return Exit code (1 if any benchmark regressed)
+         */
+        int Compare(const std::string& baselineName, const std::string& candidateName);
+
+        /**
+         * @brief Print the stored baselines
+         * @return Exit code
+         */
+        int List();
+
+        /**
+         * @brief Read the comparison flags (--threshold, --thresholds, --alpha, --metric, --filter)
+         * @return false if a value was invalid
+         */
+        bool ApplyCompareFlags(const std::map<std::string, std::string>& flags);
+
+        /**
+         * @brief Get the slowdown threshold for a benchmark (longest matching prefix)
+         */
+        double GetThreshold(const std::string& benchmark) const;
+
+        /**
+         * @brief Find the most recently built benchmark executable under the project root
+         * @return Path, or empty string if none was found
+         */
+        std::string FindBenchExecutable() const;
+
+        /**
+         * @brief Get the file a baseline is stored in
+         */
+        std::string GetBaselinePath(const std::string& name) const;
+
+        /**
+         * @brief Check that a baseline name is usable as a file name
+         */
+        static bool IsValidBaselineName(const std::string& name);
+
+        /**
+         * @brief Format nanoseconds with a readable unit
+         */
+        static std::string FormatTime(double nanoseconds);
+
+        /**
+         * @brief Print usage information for the bench command
+         */
+        void PrintUsage();
+    };
+
+} // namespace gendev
@@ -0,0 +1,641 @@
+/**
+ * @file BenchResults.cpp
+ * @brief Implementation of benchmark result loading and comparison
+ */
+
+#include "BenchResults.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+namespace gendev
+{
+    // ============================================================================
+    // JSON Reader
+    // ============================================================================
+
+    namespace
+    {
+        /**
+         * @brief Parsed JSON value (just enough for benchmark reports)
+         */
+        struct JsonValue
+        {
+            enum class Type { Null, Bool, Number, String, Array, Object };
+
+            Type Kind = Type::Null;
+            bool Bool = false;
+            double Number = 0.0;
+            std::string String;
+            std::vector<JsonValue> Array;
+            std::vector<std::pair<std::string, JsonValue>> Object;
+
+            const JsonValue* Find(const std::string& key) const
+            {
+                for (const auto& [name, value] : Object)
+                {
+                    if (name == key)
+                    {
+                        return &value;
+                    }
+                }
+                return nullptr;
+            }
+        };
+
+        class JsonParser
+        {
+        public:
+            explicit JsonParser(const std::string& text)
+                : m_Text(text)
+            {
+            }
+
+            bool Parse(JsonValue& out)
+            {
+                if (!ParseValue(out, 0))
+                {
+                    return false;
+                }
+
+                SkipWhitespace();
+                return m_Pos == m_Text.size() || Fail("trailing characters");
+            }
+
+            const std::string& GetError() const { return m_Error; }
+
+        private:
+            static constexpr int MAX_DEPTH = 64;
+
+            const std::string& m_Text;
+            size_t m_Pos = 0;
+            std::string m_Error;
+
+            bool Fail(const std::string& message)
+            {
+                if (m_Error.empty())
+                {
+                    m_Error = message + " at offset " + std::to_string(m_Pos);
+                }
+                return false;
+            }
+
+            void SkipWhitespace()
+            {
+                while (m_Pos < m_Text.size() &&
+                       (m_Text[m_Pos] == ' ' || m_Text[m_Pos] == '\t' || m_Text[m_Pos] == '\n' || m_Text[m_Pos] == '\r'))
+                {
+                    ++m_Pos;
+                }
+            }
+
+            bool Consume(const char* literal)
+            {
+                const size_t length = std::char_traits<char>::length(literal);
+                if (m_Text.compare(m_Pos, length, literal) != 0)
+                {
+                    return false;
+                }
+                m_Pos += length;
+                return true;
+            }
+
+            bool ParseValue(JsonValue& out, int depth)
+            {
+                if (depth > MAX_DEPTH)
+                {
+                    return Fail("nesting too deep");
+                }
+
+                SkipWhitespace();
+                if (m_Pos >= m_Text.size())
+                {
+                    return Fail("unexpected end of input");
+                }
+
+                const char c = m_Text[m_Pos];
+                if (c == '{')
+                {
+                    return ParseObject(out, depth);
+                }
+                if (c == '[')
+                {
+                    return ParseArray(out, depth);
+                }
+                if (c == '"')
+                {
+                    out.Kind = JsonValue::Type::String;
+                    return ParseString(out.String);
+                }
+                if (Consume("true"))
+                {
+                    out.Kind = JsonValue::Type::Bool;
+                    out.Bool = true;
+                    return true;
+                }
+                if (Consume("false"))
+                {
+                    out.Kind = JsonValue::Type::Bool;
+                    out.Bool = false;
+                    return true;
+                }
+                if (Consume("null"))
+                {
+                    out.Kind = JsonValue::Type::Null;
+                    return true;
+                }
+                return ParseNumber(out);
+            }
+
+            bool ParseObject(JsonValue& out, int depth)
+            {
+                out.Kind = JsonValue::Type::Object;
+                ++m_Pos;
+
+                SkipWhitespace();
+                if (m_Pos < m_Text.size() && m_Text[m_Pos] == '}')
+                {
+                    ++m_Pos;
+                    return true;
+                }
+
+                while (true)
+                {
+                    SkipWhitespace();
+                    std::string key;
+                    if (m_Pos >= m_Text.size() || m_Text[m_Pos] != '"' || !ParseString(key))
+                    {
+                        return Fail("expected object key");
+                    }
+
+                    SkipWhitespace();
+                    if (m_Pos >= m_Text.size() || m_Text[m_Pos] != ':')
+                    {
+                        return Fail("expected ':'");
+                    }
+                    ++m_Pos;
+
+                    out.Object.emplace_back(std::move(key), JsonValue());
+                    if (!ParseValue(out.Object.back().second, depth + 1))
+                    {
+                        return false;
+                    }
+
+                    SkipWhitespace();
+                    if (m_Pos < m_Text.size() && m_Text[m_Pos] == ',')
+                    {
+                        ++m_Pos;
+                        continue;
+                    }
+                    if (m_Pos < m_Text.size() && m_Text[m_Pos] == '}')
+                    {
+                        ++m_Pos;
+                        return true;
+                    }
+                    return Fail("expected ',' or '}'");
+                }
+            }
+
+            bool ParseArray(JsonValue& out, int depth)
+            {
+                out.Kind = JsonValue::Type::Array;
+                ++m_Pos;
+
+                SkipWhitespace();
+                if (m_Pos < m_Text.size() && m_Text[m_Pos] == ']')
+                {
+                    ++m_Pos;
+                    return true;
+                }
+
+                while (true)
+                {
+                    out.Array.emplace_back();
+                    if (!ParseValue(out.Array.back(), depth + 1))
+                    {
+                        return false;
+                    }
+
+                    SkipWhitespace();
+                    if (m_Pos < m_Text.size() && m_Text[m_Pos] == ',')
+                    {
+                        ++m_Pos;
+                        continue;
+                    }
+                    if (m_Pos < m_Text.size() && m_Text[m_Pos] == ']')
+                    {
+                        ++m_Pos;
+                        return true;
+                    }
+                    return Fail("expected ',' or ']'");
+                }
+            }
+
+            bool ParseString(std::string& out)
+            {
+                ++m_Pos;    // Opening quote
+                while (m_Pos < m_Text.size())
+                {
+                    const char c = m_Text[m_Pos++];
+                    if (c == '"')
+                    {
+                        return true;
+                    }
+                    if (c != '\\')
+                    {
+                        out += c;
+                        continue;
+                    }
+
+                    if (m_Pos >= m_Text.size())
+                    {
+                        break;
+                    }
+
+                    const char escape = m_Text[m_Pos++];
+                    switch (escape)
+                    {
+                        case '"':  out += '"'; break;
+                        case '\\': out += '\\'; break;
+                        case '/':  out += '/'; break;
+                        case 'b':  out += '\b'; break;
+                        case 'f':  out += '\f'; break;
+                        case 'n':  out += '\n'; break;
+                        case 'r':  out += '\r'; break;
+                        case 't':  out += '\t'; break;
+                        case 'u':
+                        {
+                            uint32_t codepoint = 0;
+                            if (!ParseHex4(codepoint))
+                            {
+                                return Fail("invalid \\u escape");
+                            }
+
+                            // Surrogate pair
+                            if (codepoint >= 0xD800 && codepoint <= 0xDBFF && Consume("\\u"))
+                            {
+                                uint32_t low = 0;
+                                if (!ParseHex4(low) || low < 0xDC00 || low > 0xDFFF)
+                                {
+                                    return Fail("invalid surrogate pair");
+                                }
+                                codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+                            }
+                            AppendUTF8(out, codepoint);
+                            break;
+                        }
+                        default:
+                            return Fail("invalid escape");
+                    }
+                }
+                return Fail("unterminated string");
+            }
+
+            bool ParseHex4(uint32_t& out)
+            {
+                if (m_Pos + 4 > m_Text.size())
+                {
+                    return false;
+                }
+
+                out = 0;
+                for (int i = 0; i < 4; ++i)
+                {
+                    const char c = m_Text[m_Pos++];
+                    out <<= 4;
+                    if (c >= '0' && c <= '9') out |= static_cast<uint32_t>(c - '0');
+                    else if (c >= 'a' && c <= 'f') out |= static_cast<uint32_t>(c - 'a' + 10);
+                    else if (c >= 'A' && c <= 'F') out |= static_cast<uint32_t>(c - 'A' + 10);
+                    else return false;
+                }
+                return true;
+            }
+
+            static void AppendUTF8(std::string& out, uint32_t codepoint)
+            {
+                if (codepoint < 0x80)
+                {
+                    out += static_cast<char>(codepoint);
+                }
+                else if (codepoint < 0x800)
+                {
+                    out += static_cast<char>(0xC0 | (codepoint >> 6));
+                    out += static_cast<char>(0x80 | (codepoint & 0x3F));
+                }
+                else if (codepoint < 0x10000)
+                {
+                    out += static_cast<char>(0xE0 | (codepoint >> 12));
+                    out += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+                    out += static_cast<char>(0x80 | (codepoint & 0x3F));
+                }
+                else
+                {
+                    out += static_cast<char>(0xF0 | (codepoint >> 18));
+                    out += static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+                    out += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+                    out += static_cast<char>(0x80 | (codepoint & 0x3F));
+                }
+            }
+
+            bool ParseNumber(JsonValue& out)
+            {
+                // strtod accepts more than JSON does (hex, inf); reports never contain those
+                const char* begin = m_Text.c_str() + m_Pos;
+                char* end = nullptr;
+                const double value = std::strtod(begin, &end);
+                if (end == begin)
+                {
+                    return Fail("unexpected character");
+                }
+
+                out.Kind = JsonValue::Type::Number;
+                out.Number = value;
+                m_Pos += static_cast<size_t>(end - begin);
+                return true;
+            }
+        };
+
+        /**
+         * @brief Nanoseconds per Google Benchmark time_unit
+         */
+        double GetUnitScale(const std::string& unit)
+        {
+            if (unit == "us") return 1e3;
+            if (unit == "ms") return 1e6;
+            if (unit == "s") return 1e9;
+            return 1.0;
+        }
+
+        std::string GetString(const JsonValue& object, const std::string& key)
+        {
+            const JsonValue* value = object.Find(key);
+            return (value && value->Kind == JsonValue::Type::String) ? value->String : std::string();
+        }
+    }
+
+    // ============================================================================
+    // BenchResults Implementation
+    // ============================================================================
+
+    bool BenchResults::Load(const std::string& path)
+    {
+        m_Benchmarks.clear();
+        m_Context.clear();
+        m_LastError.clear();
+
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open())
+        {
+            m_LastError = "Failed to open " + path;
+            return false;
+        }
+
+        std::stringstream content;
+        content << file.rdbuf();
+        const std::string text = content.str();
+
+        JsonValue root;
+        JsonParser parser(text);
+        if (!parser.Parse(root))
+        {
+            m_LastError = "Invalid JSON in " + path + ": " + parser.GetError();
+            return false;
+        }
+
+        if (const JsonValue* context = root.Find("context"))
+        {
+            for (const auto& [key, value] : context->Object)
+            {
+                if (value.Kind == JsonValue::Type::String)
+                {
+                    m_Context[key] = value.String;
+                }
+            }
+        }
+
+        const JsonValue* benchmarks = root.Find("benchmarks");
+        if (!benchmarks || benchmarks->Kind != JsonValue::Type::Array)
+        {
+            m_LastError = "No \"benchmarks\" array in " + path;
+            return false;
+        }
+
+        for (const JsonValue& entry : benchmarks->Array)
+        {
+            // Aggregates (mean, median, stddev) are recomputed from the repetitions
+            const std::string runType = GetString(entry, "run_type");
+            if (!runType.empty() && runType != "iteration")
+            {
+                continue;
+            }
+
+            const JsonValue* error = entry.Find("error_occurred");
+            if (error && error->Kind == JsonValue::Type::Bool && error->Bool)
+            {
+                continue;
+            }
+
+            const JsonValue* realTime = entry.Find("real_time");
+            const JsonValue* cpuTime = entry.Find("cpu_time");
+            if (!realTime || !cpuTime || realTime->Kind != JsonValue::Type::Number ||
+                cpuTime->Kind != JsonValue::Type::Number)
+            {
+                continue;
+            }
+
+            std::string name = GetString(entry, "run_name");
+            if (name.empty())
+            {
+                name = GetString(entry, "name");
+            }
+
+            const double scale = GetUnitScale(GetString(entry, "time_unit"));
+            BenchSamples& samples = m_Benchmarks[name];
+            samples.RealTimes.push_back(realTime->Number * scale);
+            samples.CPUTimes.push_back(cpuTime->Number * scale);
+        }
+
+        if (m_Benchmarks.empty())
+        {
+            m_LastError = "No benchmark results in " + path;
+            return false;
+        }
+
+        return true;
+    }
+
+    std::string BenchResults::GetContext(const std::string& key) const
+    {
+        auto it = m_Context.find(key);
+        return it != m_Context.end() ? it->second : std::string();
+    }
+
+    // ============================================================================
+    // Statistics
+    // ============================================================================
+
+    std::vector<BenchComparison> CompareBenchResults(
+        const BenchResults& baseline,
+        const BenchResults& candidate,
+        BenchMetric metric)
+    {
+        std::vector<BenchComparison> comparisons;
+
+        for (const auto& [name, baseSamples] : baseline.GetBenchmarks())
+        {
+            auto it = candidate.GetBenchmarks().find(name);
+            if (it == candidate.GetBenchmarks().end())
+            {
+                continue;
+            }
+
+            const std::vector<double>& before = baseSamples.Get(metric);
+            const std::vector<double>& after = it->second.Get(metric);
+
+            BenchComparison comparison;
+            comparison.Name = name;
+            comparison.BaselineMedian = Median(before);
+            comparison.CandidateMedian = Median(after);
+            comparison.ChangePercent = comparison.BaselineMedian > 0.0
+                ? (comparison.CandidateMedian / comparison.BaselineMedian - 1.0) * 100.0
+                : 0.0;
+            comparison.PValue = MannWhitneyPValue(before, after);
+            comparison.BaselineCount = before.size();
+            comparison.CandidateCount = after.size();
+            comparisons.push_back(comparison);
+        }
+
+        return comparisons;
+    }
+
+    double Median(std::vector<double> values)
+    {
+        if (values.empty())
+        {
+            return 0.0;
+        }
+
+        const size_t middle = values.size() / 2;
+        std::nth_element(values.begin(), values.begin() + middle, values.end());
+        const double upper = values[middle];
+        if (values.size() % 2 != 0)
+        {
+            return upper;
+        }
+
+        const double lower = *std::max_element(values.begin(), values.begin() + middle);
+        return (lower + upper) * 0.5;
+    }
+
+    double MannWhitneyPValue(const std::vector<double>& a, const std::vector<double>& b)
+    {
+        const size_t n1 = a.size();
+        const size_t n2 = b.size();
+        if (n1 == 0 || n2 == 0)
+        {
+            return 1.0;
+        }
+
+        // Rank the pooled sample, ties sharing their average rank
+        std::vector<std::pair<double, bool>> pooled;    // (value, from a)
+        pooled.reserve(n1 + n2);
+        for (double value : a) pooled.emplace_back(value, true);
+        for (double value : b) pooled.emplace_back(value, false);
+        std::sort(pooled.begin(), pooled.end(),
+            [](const auto& x, const auto& y) { return x.first < y.first; });
+
+        const size_t n = pooled.size();
+        double rankSumA = 0.0;
+        double tieTerm = 0.0;       // Sum of t^3 - t over tie groups
+        for (size_t i = 0; i < n;)
+        {
+            size_t j = i;
+            while (j < n && pooled[j].first == pooled[i].first)
+            {
+                ++j;
+            }
+
+            const double rank = (static_cast<double>(i + 1) + static_cast<double>(j)) * 0.5;
+            for (size_t k = i; k < j; ++k)
+            {
+                if (pooled[k].second)
+                {
+                    rankSumA += rank;
+                }
+            }
+
+            const double t = static_cast<double>(j - i);
+            tieTerm += t * t * t - t;
+            i = j;
+        }
+
+        const double u1 = rankSumA - static_cast<double>(n1) * static_cast<double>(n1 + 1) * 0.5;
+        const double product = static_cast<double>(n1) * static_cast<double>(n2);
+        const double u = std::min(u1, product - u1);
+
+        // Exact null distribution: arrangements of n1 + n2 ranks by their U
+        constexpr size_t EXACT_LIMIT = 30;
+        if (tieTerm == 0.0 && n1 <= EXACT_LIMIT && n2 <= EXACT_LIMIT)
+        {
+            // counts[i][j][k]: orderings of i a-values and j b-values with U = k,
+            // built one sample at a time; only the last row of i is kept
+            const size_t maxU = n1 * n2;
+            std::vector<std::vector<double>> previous(n2 + 1, std::vector<double>(maxU + 1, 0.0));
+            for (size_t j = 0; j <= n2; ++j)
+            {
+                previous[j][0] = 1.0;   // No a-values: U is 0
+            }
+
+            for (size_t i = 1; i <= n1; ++i)
+            {
+                std::vector<std::vector<double>> current(n2 + 1, std::vector<double>(maxU + 1, 0.0));
+                current[0][0] = 1.0;
+                for (size_t j = 1; j <= n2; ++j)
+                {
+                    for (size_t k = 0; k <= i * j; ++k)
+                    {
+                        // Largest value is an a (beats all j b-values) or a b
+                        double count = current[j - 1][k];
+                        if (k >= j)
+                        {
+                            count += previous[j][k - j];
+                        }
+                        current[j][k] = count;
+                    }
+                }
+                previous = std::move(current);
+            }
+
+            const std::vector<double>& distribution = previous[n2];
+            double total = 0.0;
+            double tail = 0.0;
+            for (size_t k = 0; k <= maxU; ++k)
+            {
+                total += distribution[k];
+                if (static_cast<double>(k) <= u)
+                {
+                    tail += distribution[k];
+                }
+            }
+            return std::min(1.0, 2.0 * tail / total);
+        }
+
+        // Normal approximation with tie and continuity corrections
+        const double mean = product * 0.5;
+        const double nd = static_cast<double>(n);
+        const double variance = product / 12.0 * ((nd + 1.0) - tieTerm / (nd * (nd - 1.0)));
+        if (variance <= 0.0)
+        {
+            return 1.0;     // Every value identical
+        }
+
+        const double z = std::max(0.0, std::abs(u1 - mean) - 0.5) / std::sqrt(variance);
+        return std::min(1.0, std::erfc(z / std::sqrt(2.0)));
+    }
+
+} // namespace gendev
@@ -0,0 +1,134 @@
+/**
+ * @file BenchResults.h
+ * @brief Benchmark result loading and comparison for gendev
+ *
+ * Reads the JSON reports Google Benchmark writes (--benchmark_out) and
+ * compares two of them per benchmark: the change in median time, and a
+ * two-sided Mann-Whitney U test over the repetitions, so noise between
+ * runs is not reported as a regression.
+ */
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace gendev
+{
+    // ============================================================================
+    // Result Structures
+    // ============================================================================
+
+    /**
+     * @brief Which per-iteration time of a report to compare
+     */
+    enum class BenchMetric
+    {
+        RealTime,   // Wall clock (the meaningful one for multi-threaded runs)
+        CPUTime     // Main-thread CPU time
+    };
+
+    /**
+     * @brief Repetitions of one benchmark (e.g. "BM_FBM_Sample/8")
+     */
+    struct BenchSamples
+    {
+        /** Per-repetition time in nanoseconds */
+        std::vector<double> RealTimes;
+        std::vector<double> CPUTimes;
+
+        const std::vector<double>& Get(BenchMetric metric) const
+        {
+            return metric == BenchMetric::CPUTime ? CPUTimes : RealTimes;
+        }
+    };
+
+    /**
+     * @brief Outcome of comparing one benchmark between two reports
+     */
+    struct BenchComparison
+    {
+        std::string Name;
+        double BaselineMedian = 0.0;    ///< Nanoseconds
+        double CandidateMedian = 0.0;
+        double ChangePercent = 0.0;     ///< Positive = slower
+        double PValue = 1.0;            ///< Two-sided Mann-Whitney U
+        size_t BaselineCount = 0;
+        size_t CandidateCount = 0;
+    };
+
+    // ============================================================================
+    // BenchResults Class
+    // ============================================================================
+
+    /**
+     * @brief One Google Benchmark JSON report
+     *
+     * Only the per-repetition ("iteration") entries are kept; aggregates
+     * are recomputed from them. Benchmarks that reported an error are skipped.
+     */
+    class BenchResults
+    {
+    public:
+        /**
+         * @brief Load a report
+         * @param path JSON file written with --benchmark_out_format=json
+         * @return true if the file parsed and held at least one benchmark
+         */
+        bool Load(const std::string& path);
+
+        /**
+         * @brief Get the benchmarks, by run name
+         */
+        const std::map<std::string, BenchSamples>& GetBenchmarks() const { return m_Benchmarks; }
+
+        /**
+         * @brief Get a string from the report's context (e.g. "date", "commit")
+         */
+        std::string GetContext(const std::string& key) const;
+
+        /**
+         * @brief Get the error from the last failed Load
+         */
+        const std::string& GetLastError() const { return m_LastError; }
+
+    private:
+        std::map<std::string, BenchSamples> m_Benchmarks;
+        std::map<std::string, std::string> m_Context;
+        std::string m_LastError;
+    };
+
+    // ============================================================================
+    // Statistics
+    // ============================================================================
+
+    /**
+     * @brief Compare every benchmark present in both reports
+     * @param baseline Reference report
+     * @param candidate Report being checked
+     * @param metric Time to compare
+     * @return One entry per common benchmark, in name order
+     */
+    std::vector<BenchComparison> CompareBenchResults(
+        const BenchResults& baseline,
+        const BenchResults& candidate,
+        BenchMetric metric);
+
+    /**
+     * @brief Median of a sample (0 when empty)
+     */
+    double Median(std::vector<double> values);
+
+    /**
+     * @brief Two-sided p-value of the Mann-Whitney U test
+     *
+     * Exact for small samples without ties, otherwise the normal
+     * approximation with tie and continuity corrections.
+     *
+     * @return Probability of a rank difference at least this large if both
+     *         samples came from the same distribution (1 if either is empty)
+     */
+    double MannWhitneyPValue(const std::vector<double>& a, const std::vector<double>& b);
+
+} // namespace gendev
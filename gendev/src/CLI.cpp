@@ -249,16 +249,25 @@ namespace gendev
 
         std::cout << "Commands:\n";
         std::cout << "  ask <query>              Search project files for relevant information\n";
-        std::cout << "  create <type> <name>     Generate code from templates\n\n";
+        std::cout << "  create <type> <name>     Generate code from templates\n";
+        std::cout << "  bench <subcommand>       Run and compare benchmark baselines\n\n";
 
         std::cout << "Create Types:\n";
         std::cout << "  component <Name> [member:type ...]  Create ECS component\n";
         std::cout << "  system <Name>                       Create ECS system\n";
         std::cout << "  event <Name> [member:type ...]      Create event structure\n\n";
 
+        std::cout << "Bench Subcommands:\n";
+        std::cout << "  run <name>                          Run ShatteredMoonBench, store as baseline\n";
+        std::cout << "  compare <baseline> <candidate>      Flag significant slowdowns\n";
+        std::cout << "  list                                List stored baselines\n\n";
+
         std::cout << "Options:\n";
+        std::cout << "  --no-index               Search without the .gendev/ search index\n";
         std::cout << "  --update-cmake           Add generated files to CMakeLists.txt\n";
         std::cout << "  --output=<path>          Specify output directory\n";
+        std::cout << "  --repetitions=<n>        Benchmark repetitions per run (default 10)\n";
+        std::cout << "  --threshold=<percent>    Slowdown flagged as a regression (default 5)\n";
         std::cout << "  --no-color               Disable colored output\n";
         std::cout << "  -h, --help               Show this help message\n";
         std::cout << "  -v, --version            Show version information\n\n";
@@ -269,6 +278,7 @@ namespace gendev
         std::cout << "  " << m_ProgramName << " create event PlayerDeath playerID:int\n";
         std::cout << "  " << m_ProgramName << " ask \"How does the ECS system work?\"\n";
         std::cout << "  " << m_ProgramName << " ask TransformComponent\n";
+        std::cout << "  " << m_ProgramName << " bench run mychange --compare=main\n";
     }
 
     void CLI::PrintVersion() const
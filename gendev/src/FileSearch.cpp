@@ -4,6 +4,7 @@
  */
 
 #include "FileSearch.h"
+#include "MappedFile.h"
 
 #include <fstream>
 #include <sstream>
@@ -13,6 +14,11 @@
 #include <set>
 #include <iomanip>
 #include <map>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <thread>
 
 namespace gendev
 {
@@ -162,6 +168,138 @@ namespace gendev
         return unique;
     }
 
+    // ============================================================================
+    // Raw Byte Matching
+    // ============================================================================
+
+    namespace
+    {
+        inline char LowerAscii(char c)
+        {
+            return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c;
+        }
+
+        /**
+         * @brief Find the next case-insensitive occurrence of a lowercase keyword
+         *
+         * Candidate positions come from memchr on both cases of the first
+         * byte, which the C library vectorizes; only those positions are
+         * compared in full.
+         *
+         * @return Start of the match, or nullptr
+         */
+        const char* FindKeyword(const char* begin, const char* end, const std::string& lowerKeyword)
+        {
+            const size_t length = lowerKeyword.size();
+            if (length == 0 || static_cast<size_t>(end - begin) < length)
+            {
+                return nullptr;
+            }
+
+            const char* startEnd = end - length + 1;    // One past the last possible match start
+            const char lower = lowerKeyword[0];
+            const char upper = (lower >= 'a' && lower <= 'z') ? static_cast<char>(lower - ('a' - 'A')) : lower;
+
+            auto findByte = [startEnd](const char* from, char c)
+            {
+                const void* hit = std::memchr(from, c, static_cast<size_t>(startEnd - from));
+                return hit ? static_cast<const char*>(hit) : startEnd;
+            };
+
+            const char* nextLower = findByte(begin, lower);
+            const char* nextUpper = upper != lower ? findByte(begin, upper) : startEnd;
+
+            while (true)
+            {
+                const char* candidate = std::min(nextLower, nextUpper);
+                if (candidate == startEnd)
+                {
+                    return nullptr;
+                }
+
+                size_t i = 1;
+                while (i < length && LowerAscii(candidate[i]) == lowerKeyword[i])
+                {
+                    ++i;
+                }
+                if (i == length)
+                {
+                    return candidate;
+                }
+
+                if (candidate == nextLower)
+                {
+                    nextLower = findByte(candidate + 1, lower);
+                }
+                else
+                {
+                    nextUpper = findByte(candidate + 1, upper);
+                }
+            }
+        }
+
+        /**
+         * @brief Ordering key: relevance first, then search order for a stable tie-break
+         */
+        struct RankKey
+        {
+            float Relevance = 0.0f;
+            size_t FileOrder = 0;
+            int LineNumber = 0;
+        };
+
+        inline bool RanksBefore(const RankKey& a, const RankKey& b)
+        {
+            if (a.Relevance != b.Relevance) return a.Relevance > b.Relevance;
+            if (a.FileOrder != b.FileOrder) return a.FileOrder < b.FileOrder;
+            return a.LineNumber < b.LineNumber;
+        }
+
+        struct RankedResult
+        {
+            RankKey Key;
+            SearchResult Result;
+        };
+
+        inline bool RankedBefore(const RankedResult& a, const RankedResult& b)
+        {
+            return RanksBefore(a.Key, b.Key);
+        }
+    }
+
+    // ============================================================================
+    // ScanContext
+    // ============================================================================
+
+    struct FileSearch::ScanContext
+    {
+        size_t MaxResults = 0;
+
+        /** Heap ordered by RankedBefore: the front is the worst result kept */
+        std::vector<RankedResult> Heap;
+
+        // Scratch reused across files
+        std::vector<size_t> LineStarts;
+        std::vector<uint16_t> LineHits;
+        std::vector<std::string_view> Lines;
+
+        bool WouldKeep(const RankKey& key) const
+        {
+            return Heap.size() < MaxResults || RanksBefore(key, Heap.front().Key);
+        }
+
+        void Push(RankedResult&& result)
+        {
+            Heap.push_back(std::move(result));
+            std::push_heap(Heap.begin(), Heap.end(), RankedBefore);
+            if (Heap.size() > MaxResults)
+            {
+                std::pop_heap(Heap.begin(), Heap.end(), RankedBefore);
+                Heap.pop_back();
+            }
+        }
+    };
+
     // ============================================================================
     // FileSearch Implementation
     // ============================================================================
@@ -204,25 +342,81 @@ namespace gendev
     {
         std::vector<SearchResult> results;
 
-        if (keywords.empty())
+        if (keywords.empty() || m_MaxResults == 0)
         {
             return results;
         }
 
+        // Lowercase once here rather than per line in SearchFile
+        std::vector<std::string> lowerKeywords;
+        lowerKeywords.reserve(keywords.size());
+        for (const auto& keyword : keywords)
+        {
+            lowerKeywords.push_back(ToLower(keyword));
+        }
+
         auto files = GetSearchableFiles();
 
-        for (const auto& filePath : files)
+        if (m_UseIndex)
         {
-            SearchFile(filePath, keywords, results);
+            // The index only narrows the file list; a failed save just means
+            // the next search rescans the same files
+            SearchIndex index(m_RootPath);
+            index.Load();
+            m_IndexStats = index.Update(files);
+            if (index.IsDirty())
+            {
+                index.Save();
+            }
+            files = index.FindCandidates(lowerKeywords);
         }
 
-        // Sort by relevance
-        std::sort(results.begin(), results.end());
+        // Scan files across worker threads, each keeping its own top m_MaxResults
+        size_t threadCount = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), files.size());
+        std::vector<ScanContext> contexts(std::max<size_t>(threadCount, 1));
+        for (ScanContext& context : contexts)
+        {
+            context.MaxResults = m_MaxResults;
+        }
+
+        std::atomic<size_t> next{ 0 };
+        auto worker = [&](ScanContext& context)
+        {
+            for (size_t i = next.fetch_add(1); i < files.size(); i = next.fetch_add(1))
+            {
+                SearchFile(files[i], i, lowerKeywords, context);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (size_t i = 1; i < threadCount; ++i)
+        {
+            threads.emplace_back(worker, std::ref(contexts[i]));
+        }
+        worker(contexts[0]);
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        // Merge the per-worker heaps and sort by relevance
+        std::vector<RankedResult> ranked;
+        for (ScanContext& context : contexts)
+        {
+            std::move(context.Heap.begin(), context.Heap.end(), std::back_inserter(ranked));
+        }
+        std::sort(ranked.begin(), ranked.end(), RankedBefore);
 
         // Limit results
-        if (results.size() > m_MaxResults)
+        if (ranked.size() > m_MaxResults)
+        {
+            ranked.resize(m_MaxResults);
+        }
+
+        results.reserve(ranked.size());
+        for (RankedResult& entry : ranked)
         {
-            results.resize(m_MaxResults);
+            results.push_back(std::move(entry.Result));
         }
 
         return results;
@@ -234,10 +428,25 @@ namespace gendev
 
         try
         {
-            for (const auto& entry : std::filesystem::recursive_directory_iterator(
+            auto it = std::filesystem::recursive_directory_iterator(
                 m_RootPath,
-                std::filesystem::directory_options::skip_permission_denied))
+                std::filesystem::directory_options::skip_permission_denied);
+
+            for (; it != std::filesystem::recursive_directory_iterator(); ++it)
             {
+                const auto& entry = *it;
+
+                // Don't descend into excluded directories at all
+                if (entry.is_directory())
+                {
+                    std::string dirName = entry.path().filename().string();
+                    if (std::find(m_ExcludedDirs.begin(), m_ExcludedDirs.end(), dirName) != m_ExcludedDirs.end())
+                    {
+                        it.disable_recursion_pending();
+                    }
+                    continue;
+                }
+
                 if (!entry.is_regular_file())
                 {
                     continue;
@@ -325,68 +534,119 @@ namespace gendev
 
     void FileSearch::SearchFile(
         const std::filesystem::path& filePath,
-        const std::vector<std::string>& keywords,
-        std::vector<SearchResult>& results)
+        size_t fileOrder,
+        const std::vector<std::string>& lowerKeywords,
+        ScanContext& context) const
     {
-        std::ifstream file(filePath);
-        if (!file.is_open())
+        MappedFile file;
+        if (!file.Open(filePath))
         {
             return;
         }
 
-        std::vector<std::string> lines;
-        std::string line;
-        while (std::getline(file, line))
+        std::string_view text = file.GetView();
+        if (text.empty())
         {
-            lines.push_back(line);
+            return;
         }
-        file.close();
 
-        float fileWeight = GetFileWeight(filePath);
+        const char* data = text.data();
+        const char* end = data + text.size();
 
-        for (size_t i = 0; i < lines.size(); ++i)
+        // Line starts; like std::getline, a trailing newline doesn't open another line
+        std::vector<size_t>& lineStarts = context.LineStarts;
+        lineStarts.assign(1, 0);
+        for (const char* p = data; const void* newline = std::memchr(p, '\n', static_cast<size_t>(end - p));)
         {
-            const std::string& currentLine = lines[i];
-            int matchCount = 0;
+            p = static_cast<const char*>(newline) + 1;
+            if (p == end)
+            {
+                break;
+            }
+            lineStarts.push_back(static_cast<size_t>(p - data));
+        }
+        const size_t lineCount = lineStarts.size();
 
-            // Count keyword matches in this line
-            for (const auto& keyword : keywords)
+        // Count keyword matches per line, each keyword at most once per line
+        std::vector<uint16_t>& lineHits = context.LineHits;
+        lineHits.assign(lineCount, 0);
+        for (const auto& keyword : lowerKeywords)
+        {
+            const char* p = data;
+            while (const char* hit = FindKeyword(p, end, keyword))
             {
-                if (ContainsKeyword(currentLine, keyword))
-                {
-                    ++matchCount;
-                }
+                size_t line = static_cast<size_t>(
+                    std::upper_bound(lineStarts.begin(), lineStarts.end(), static_cast<size_t>(hit - data)) -
+                    lineStarts.begin()) - 1;
+                ++lineHits[line];
+                p = line + 1 < lineCount ? data + lineStarts[line + 1] : end;
             }
+        }
+
+        float fileWeight = GetFileWeight(filePath);
+        std::vector<std::string_view>& lines = context.Lines;
+        lines.clear();
 
-            if (matchCount > 0)
+        for (size_t i = 0; i < lineCount; ++i)
+        {
+            int matchCount = lineHits[i];
+            if (matchCount == 0)
             {
-                SearchResult result;
-                result.FilePath = filePath.string();
-                result.LineNumber = static_cast<int>(i + 1); // 1-indexed
-                result.MatchLine = currentLine;
-                result.Context = GetContext(lines, i);
-                result.MatchCount = matchCount;
+                continue;
+            }
 
-                // Calculate relevance
-                // Base relevance from match count ratio
-                float matchRatio = static_cast<float>(matchCount) / static_cast<float>(keywords.size());
+            // Calculate relevance
+            // Base relevance from match count ratio
+            float matchRatio = static_cast<float>(matchCount) / static_cast<float>(lowerKeywords.size());
 
-                // Bonus for matching more keywords
-                float multiMatchBonus = matchCount > 1 ? 0.2f * (matchCount - 1) : 0.0f;
+            // Bonus for matching more keywords
+            float multiMatchBonus = matchCount > 1 ? 0.2f * (matchCount - 1) : 0.0f;
 
-                result.Relevance = (matchRatio + multiMatchBonus) * fileWeight;
+            // Cap at 1.0
+            float relevance = std::min((matchRatio + multiMatchBonus) * fileWeight, 1.0f);
 
-                // Cap at 1.0
-                result.Relevance = std::min(result.Relevance, 1.0f);
+            RankKey key{ relevance, fileOrder, static_cast<int>(i + 1) }; // 1-indexed
+            if (!context.WouldKeep(key))
+            {
+                continue;
+            }
 
-                results.push_back(result);
+            // Split lines lazily, only once the file has a result worth keeping
+            if (lines.empty())
+            {
+                lines.reserve(lineCount);
+                for (size_t l = 0; l < lineCount; ++l)
+                {
+                    size_t start = lineStarts[l];
+                    size_t stop = l + 1 < lineCount ? lineStarts[l + 1] - 1 : text.size();
+                    if (stop > start && text[stop - 1] == '\n')
+                    {
+                        --stop;
+                    }
+                    if (stop > start && text[stop - 1] == '\r')
+                    {
+                        --stop;
+                    }
+                    lines.push_back(text.substr(start, stop - start));
+                }
             }
+
+            RankedResult ranked;
+            ranked.Key = key;
+            ranked.Result.FilePath = filePath.string();
+            ranked.Result.LineNumber = key.LineNumber;
+            ranked.Result.MatchLine = std::string(lines[i]);
+            ranked.Result.Context = GetContext(lines, i);
+            ranked.Result.MatchCount = matchCount;
+            ranked.Result.Relevance = relevance;
+
+            context.Push(std::move(ranked));
         }
     }
 
     std::string FileSearch::GetContext(
-        const std::vector<std::string>& lines,
-        size_t matchLine)
+        const std::vector<std::string_view>& lines,
+        size_t matchLine) const
     {
         std::ostringstream context;
 
@@ -8,8 +8,12 @@
 
 #pragma once
 
+#include "SearchIndex.h"
+
 #include <string>
+#include <string_view>
 #include <vector>
+#include <map>
 #include <filesystem>
 
 namespace gendev
@@ -90,6 +94,19 @@ namespace gendev
          */
         void SetContextLines(int lines) { m_ContextLines = lines; }
 
+        /**
+         * @brief Enable or disable the persistent search index
+         *
+         * When enabled (the default), the index under .gendev/ is refreshed
+         * before each search and only files it reports as candidates are read.
+         */
+        void SetUseIndex(bool useIndex) { m_UseIndex = useIndex; }
+
+        /**
+         * @brief Get what the last search changed in the index
+         */
+        const SearchIndex::UpdateStats& GetIndexStats() const { return m_IndexStats; }
+
         /**
          * @brief Search for a query string
          * @param query The search query
@@ -119,10 +136,12 @@ namespace gendev
     private:
         std::string m_RootPath;
         std::vector<std::string> m_Extensions = { ".h", ".hpp", ".cpp", ".md", ".txt" };
-        std::vector<std::string> m_ExcludedDirs = { "build", ".git", "external", "_deps" };
+        std::vector<std::string> m_ExcludedDirs = { "build", ".git", "external", "_deps", SearchIndex::STATE_DIRECTORY };
         std::map<std::string, float> m_FileWeights;
         size_t m_MaxResults = 20;
         int m_ContextLines = 3;
+        bool m_UseIndex = true;
+        SearchIndex::UpdateStats m_IndexStats;
 
         /**
          * @brief Get all searchable files in the root path
@@ -143,15 +162,22 @@ namespace gendev
             const std::filesystem::path& filePath);
 
         /**
-         * @brief Search a single file
+         * @brief Per-worker scratch buffers and bounded result heap (FileSearch.cpp)
+         */
+        struct ScanContext;
+
+        /**
+         * @brief Search a single memory-mapped file
          * @param filePath Path to the file
-         * @param keywords Keywords to search for
-         * @param results Output vector to append results to
+         * @param fileOrder Position of the file in the search list (breaks relevance ties)
+         * @param lowerKeywords Keywords to search for, already lowercased
+         * @param context Worker state receiving the results
          */
         void SearchFile(
             const std::filesystem::path& filePath,
-            const std::vector<std::string>& keywords,
-            std::vector<SearchResult>& results);
+            size_t fileOrder,
+            const std::vector<std::string>& lowerKeywords,
+            ScanContext& context) const;
 
         /**
          * @brief Get context lines around a match
@@ -160,8 +186,8 @@ namespace gendev
          * @return Context string with line numbers
          */
         std::string GetContext(
-            const std::vector<std::string>& lines,
-            size_t matchLine);
+            const std::vector<std::string_view>& lines,
+            size_t matchLine) const;
 
         /**
          * @brief Check if a directory should be excluded
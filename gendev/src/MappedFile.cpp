@@ -0,0 +1,142 @@
+/**
+ * @file MappedFile.cpp
+ * @brief Implementation of the read-only memory-mapped file
+ */
+
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace gendev
+{
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+#ifdef _WIN32
+
+    bool MappedFile::Open(const std::filesystem::path& path)
+    {
+        Close();
+
+        HANDLE file = CreateFileW(
+            path.c_str(), GENERIC_READ,
+            FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+            nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+
+        LARGE_INTEGER size = {};
+        if (!GetFileSizeEx(file, &size))
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        // CreateFileMapping rejects zero-length files
+        if (size.QuadPart == 0)
+        {
+            CloseHandle(file);
+            return true;
+        }
+
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping)
+        {
+            return false;
+        }
+
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view)
+        {
+            CloseHandle(mapping);
+            return false;
+        }
+
+        m_Mapping = mapping;
+        m_Data = static_cast<const char*>(view);
+        m_Size = static_cast<size_t>(size.QuadPart);
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (m_Data)
+        {
+            UnmapViewOfFile(m_Data);
+        }
+        if (m_Mapping)
+        {
+            CloseHandle(m_Mapping);
+        }
+
+        m_Data = nullptr;
+        m_Size = 0;
+        m_Mapping = nullptr;
+    }
+
+#else
+
+    bool MappedFile::Open(const std::filesystem::path& path)
+    {
+        Close();
+
+        int descriptor = open(path.c_str(), O_RDONLY);
+        if (descriptor < 0)
+        {
+            return false;
+        }
+
+        struct stat info = {};
+        if (fstat(descriptor, &info) != 0)
+        {
+            close(descriptor);
+            return false;
+        }
+
+        // mmap rejects zero-length mappings
+        if (info.st_size == 0)
+        {
+            close(descriptor);
+            return true;
+        }
+
+        void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+        close(descriptor);
+        if (view == MAP_FAILED)
+        {
+            return false;
+        }
+
+        madvise(view, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+
+        m_Data = static_cast<const char*>(view);
+        m_Size = static_cast<size_t>(info.st_size);
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (m_Data)
+        {
+            munmap(const_cast<char*>(m_Data), m_Size);
+        }
+
+        m_Data = nullptr;
+        m_Size = 0;
+    }
+
+#endif
+
+} // namespace gendev
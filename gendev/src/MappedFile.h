@@ -0,0 +1,58 @@
+/**
+ * @file MappedFile.h
+ * @brief Read-only memory-mapped file
+ *
+ * Lets the search paths scan file bytes in place instead of copying
+ * them through std::ifstream.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+
+namespace gendev
+{
+    // ============================================================================
+    // MappedFile Class
+    // ============================================================================
+
+    /**
+     * @brief Read-only view of a whole file mapped into memory
+     */
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /**
+         * @brief Map a file, closing any previously mapped one
+         * @return true on success (an empty file maps to an empty view)
+         */
+        bool Open(const std::filesystem::path& path);
+
+        /**
+         * @brief Unmap the file
+         */
+        void Close();
+
+        /**
+         * @brief Get the mapped bytes
+         */
+        std::string_view GetView() const { return std::string_view(m_Data, m_Size); }
+
+    private:
+        const char* m_Data = nullptr;
+        size_t m_Size = 0;
+
+#ifdef _WIN32
+        void* m_Mapping = nullptr;  ///< HANDLE of the file mapping object
+#endif
+    };
+
+} // namespace gendev
@@ -0,0 +1,499 @@
+/**
+ * @file SearchIndex.cpp
+ * @brief Implementation of the persistent trigram index
+ */
+
+#include "SearchIndex.h"
+#include "MappedFile.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+namespace gendev
+{
+    // ============================================================================
+    // Helpers
+    // ============================================================================
+
+    namespace
+    {
+        /**
+         * @brief Lowercase ASCII only, matching FileSearch::ToLower
+         */
+        inline uint8_t LowerByte(char c)
+        {
+            uint8_t b = static_cast<uint8_t>(c);
+            return (b >= 'A' && b <= 'Z') ? static_cast<uint8_t>(b + ('a' - 'A')) : b;
+        }
+
+        template<typename T>
+        void WriteValue(std::ofstream& out, const T& value)
+        {
+            out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        template<typename T>
+        void WriteArray(std::ofstream& out, const std::vector<T>& values)
+        {
+            if (!values.empty())
+            {
+                out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+            }
+        }
+
+        /**
+         * @brief Bounds-checked reader over the loaded index file
+         */
+        struct ByteReader
+        {
+            const std::vector<char>& Data;
+            size_t Offset = 0;
+
+            bool Read(void* dst, size_t size)
+            {
+                if (Data.size() - Offset < size)
+                {
+                    return false;
+                }
+                std::memcpy(dst, Data.data() + Offset, size);
+                Offset += size;
+                return true;
+            }
+
+            template<typename T>
+            bool ReadValue(T& value) { return Read(&value, sizeof(T)); }
+
+            template<typename T>
+            bool ReadArray(std::vector<T>& values, size_t count)
+            {
+                if ((Data.size() - Offset) / sizeof(T) < count)
+                {
+                    return false;
+                }
+                values.resize(count);
+                return count == 0 || Read(values.data(), count * sizeof(T));
+            }
+        };
+    }
+
+    // ============================================================================
+    // SearchIndex Implementation
+    // ============================================================================
+
+    SearchIndex::SearchIndex(const std::string& rootPath)
+        : m_RootPath(rootPath)
+    {
+    }
+
+    std::filesystem::path SearchIndex::GetIndexPath() const
+    {
+        return std::filesystem::path(m_RootPath) / STATE_DIRECTORY / "search_index.bin";
+    }
+
+    bool SearchIndex::Load()
+    {
+        m_Files.clear();
+        m_PostingKeys.clear();
+        m_PostingOffsets.assign(1, 0);
+        m_PostingFiles.clear();
+
+        std::ifstream file(GetIndexPath(), std::ios::binary);
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        ByteReader reader{ data };
+
+        uint32_t magic = 0, version = 0, fileCount = 0, keyCount = 0, postingCount = 0;
+        if (!reader.ReadValue(magic) || !reader.ReadValue(version) ||
+            magic != INDEX_MAGIC || version != INDEX_VERSION ||
+            !reader.ReadValue(fileCount) || !reader.ReadValue(keyCount) || !reader.ReadValue(postingCount))
+        {
+            return false;
+        }
+
+        std::vector<FileEntry> files(fileCount);
+        for (FileEntry& entry : files)
+        {
+            uint32_t pathLength = 0;
+            if (!reader.ReadValue(pathLength) || data.size() - reader.Offset < pathLength)
+            {
+                return false;
+            }
+            entry.Path.assign(data.data() + reader.Offset, pathLength);
+            reader.Offset += pathLength;
+
+            if (!reader.ReadValue(entry.ModifiedTime) || !reader.ReadValue(entry.Size))
+            {
+                return false;
+            }
+        }
+
+        std::vector<uint32_t> keys, offsets, postings;
+        if (!reader.ReadArray(keys, keyCount) ||
+            !reader.ReadArray(offsets, static_cast<size_t>(keyCount) + 1) ||
+            !reader.ReadArray(postings, postingCount) ||
+            offsets.back() != postingCount)
+        {
+            return false;
+        }
+
+        for (uint32_t fileIndex : postings)
+        {
+            if (fileIndex >= fileCount)
+            {
+                return false;
+            }
+        }
+
+        m_Files = std::move(files);
+        m_PostingKeys = std::move(keys);
+        m_PostingOffsets = std::move(offsets);
+        m_PostingFiles = std::move(postings);
+        return true;
+    }
+
+    bool SearchIndex::Save() const
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(GetIndexPath().parent_path(), ec);
+
+        // Write beside the real file and swap so an interrupted save never leaves a torn index
+        std::filesystem::path tempPath = GetIndexPath();
+        tempPath += ".tmp";
+
+        {
+            std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+            if (!out.is_open())
+            {
+                return false;
+            }
+
+            WriteValue(out, INDEX_MAGIC);
+            WriteValue(out, INDEX_VERSION);
+            WriteValue(out, static_cast<uint32_t>(m_Files.size()));
+            WriteValue(out, static_cast<uint32_t>(m_PostingKeys.size()));
+            WriteValue(out, static_cast<uint32_t>(m_PostingFiles.size()));
+
+            for (const FileEntry& entry : m_Files)
+            {
+                WriteValue(out, static_cast<uint32_t>(entry.Path.size()));
+                out.write(entry.Path.data(), entry.Path.size());
+                WriteValue(out, entry.ModifiedTime);
+                WriteValue(out, entry.Size);
+            }
+
+            WriteArray(out, m_PostingKeys);
+            WriteArray(out, m_PostingOffsets);
+            WriteArray(out, m_PostingFiles);
+
+            if (!out.good())
+            {
+                return false;
+            }
+        }
+
+        std::filesystem::rename(tempPath, GetIndexPath(), ec);
+        return !ec;
+    }
+
+    SearchIndex::UpdateStats SearchIndex::Update(const std::vector<std::filesystem::path>& files)
+    {
+        UpdateStats stats;
+        m_Dirty = false;
+
+        std::unordered_map<std::string, uint32_t> previous;
+        previous.reserve(m_Files.size());
+        for (uint32_t i = 0; i < static_cast<uint32_t>(m_Files.size()); ++i)
+        {
+            previous.emplace(m_Files[i].Path, i);
+        }
+
+        // Stat every file; unchanged ones keep their trigrams from the old postings
+        std::vector<FileEntry> entries;
+        std::vector<int64_t> previousIndex;
+        std::vector<size_t> toScan;
+        entries.reserve(files.size());
+        previousIndex.reserve(files.size());
+
+        for (const auto& path : files)
+        {
+            std::error_code ec;
+            auto modified = std::filesystem::last_write_time(path, ec);
+            if (ec)
+            {
+                continue;
+            }
+            uint64_t size = std::filesystem::file_size(path, ec);
+            if (ec)
+            {
+                continue;
+            }
+
+            FileEntry entry;
+            entry.Path = path.string();
+            entry.ModifiedTime = static_cast<int64_t>(modified.time_since_epoch().count());
+            entry.Size = size;
+
+            auto it = previous.find(entry.Path);
+            if (it != previous.end() &&
+                m_Files[it->second].ModifiedTime == entry.ModifiedTime &&
+                m_Files[it->second].Size == entry.Size)
+            {
+                previousIndex.push_back(it->second);
+            }
+            else
+            {
+                previousIndex.push_back(-1);
+                toScan.push_back(entries.size());
+            }
+            entries.push_back(std::move(entry));
+        }
+
+        if (toScan.empty() && entries.size() == m_Files.size())
+        {
+            stats.TotalFiles = m_Files.size();
+            return stats;
+        }
+
+        // Recover the per-file trigram sets of kept files by inverting the postings
+        std::vector<int64_t> remap(m_Files.size(), -1);
+        for (size_t i = 0; i < entries.size(); ++i)
+        {
+            if (previousIndex[i] >= 0)
+            {
+                remap[static_cast<size_t>(previousIndex[i])] = static_cast<int64_t>(i);
+            }
+        }
+
+        std::vector<std::vector<uint32_t>> trigrams(entries.size());
+        for (size_t k = 0; k < m_PostingKeys.size(); ++k)
+        {
+            for (uint32_t p = m_PostingOffsets[k]; p < m_PostingOffsets[k + 1]; ++p)
+            {
+                int64_t target = remap[m_PostingFiles[p]];
+                if (target >= 0)
+                {
+                    trigrams[static_cast<size_t>(target)].push_back(m_PostingKeys[k]);
+                }
+            }
+        }
+
+        // Re-read new and modified files in parallel
+        std::vector<uint8_t> readOk(toScan.size(), 0);
+        std::atomic<size_t> next{ 0 };
+        auto worker = [&]()
+        {
+            for (size_t i = next.fetch_add(1); i < toScan.size(); i = next.fetch_add(1))
+            {
+                size_t entryIndex = toScan[i];
+                readOk[i] = ScanFile(entries[entryIndex].Path, trigrams[entryIndex]) ? 1 : 0;
+            }
+        };
+
+        size_t threadCount = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), toScan.size());
+        std::vector<std::thread> threads;
+        for (size_t i = 1; i < threadCount; ++i)
+        {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        // Drop files that could not be read
+        std::vector<uint8_t> keep(entries.size(), 1);
+        for (size_t i = 0; i < toScan.size(); ++i)
+        {
+            keep[toScan[i]] = readOk[i];
+        }
+
+        std::vector<FileEntry> keptEntries;
+        std::vector<std::vector<uint32_t>> keptTrigrams;
+        keptEntries.reserve(entries.size());
+        keptTrigrams.reserve(entries.size());
+        for (size_t i = 0; i < entries.size(); ++i)
+        {
+            if (keep[i])
+            {
+                keptEntries.push_back(std::move(entries[i]));
+                keptTrigrams.push_back(std::move(trigrams[i]));
+            }
+        }
+
+        size_t keptPrevious = 0;
+        for (int64_t index : remap)
+        {
+            keptPrevious += index >= 0 ? 1 : 0;
+        }
+
+        stats.TotalFiles = keptEntries.size();
+        stats.ScannedFiles = toScan.size();
+        stats.RemovedFiles = m_Files.size() - keptPrevious;
+
+        m_Files = std::move(keptEntries);
+        BuildPostings(keptTrigrams);
+        m_Dirty = true;
+        return stats;
+    }
+
+    std::vector<std::filesystem::path> SearchIndex::FindCandidates(const std::vector<std::string>& keywords) const
+    {
+        std::vector<uint8_t> matched(m_Files.size(), 0);
+
+        for (const auto& keyword : keywords)
+        {
+            std::string lower;
+            lower.reserve(keyword.size());
+            for (char c : keyword)
+            {
+                lower += static_cast<char>(LowerByte(c));
+            }
+
+            std::vector<uint32_t> keywordTrigrams;
+            CollectTrigrams(lower, keywordTrigrams);
+
+            // Too short to filter on: every file is a candidate
+            if (keywordTrigrams.empty())
+            {
+                std::fill(matched.begin(), matched.end(), 1);
+                break;
+            }
+
+            std::sort(keywordTrigrams.begin(), keywordTrigrams.end());
+            keywordTrigrams.erase(std::unique(keywordTrigrams.begin(), keywordTrigrams.end()), keywordTrigrams.end());
+
+            std::vector<uint32_t> current;
+            bool first = true;
+            for (uint32_t trigram : keywordTrigrams)
+            {
+                auto it = std::lower_bound(m_PostingKeys.begin(), m_PostingKeys.end(), trigram);
+                if (it == m_PostingKeys.end() || *it != trigram)
+                {
+                    current.clear();
+                    break;
+                }
+
+                size_t k = static_cast<size_t>(it - m_PostingKeys.begin());
+                auto begin = m_PostingFiles.begin() + m_PostingOffsets[k];
+                auto end = m_PostingFiles.begin() + m_PostingOffsets[k + 1];
+
+                if (first)
+                {
+                    current.assign(begin, end);
+                    first = false;
+                }
+                else
+                {
+                    std::vector<uint32_t> intersection;
+                    std::set_intersection(current.begin(), current.end(), begin, end, std::back_inserter(intersection));
+                    current = std::move(intersection);
+                }
+
+                if (current.empty())
+                {
+                    break;
+                }
+            }
+
+            for (uint32_t fileIndex : current)
+            {
+                matched[fileIndex] = 1;
+            }
+        }
+
+        std::vector<std::filesystem::path> candidates;
+        for (size_t i = 0; i < m_Files.size(); ++i)
+        {
+            if (matched[i])
+            {
+                candidates.emplace_back(m_Files[i].Path);
+            }
+        }
+        return candidates;
+    }
+
+    void SearchIndex::BuildPostings(const std::vector<std::vector<uint32_t>>& fileTrigrams)
+    {
+        std::vector<std::pair<uint32_t, uint32_t>> pairs;
+        size_t total = 0;
+        for (const auto& set : fileTrigrams)
+        {
+            total += set.size();
+        }
+        pairs.reserve(total);
+
+        for (uint32_t fileIndex = 0; fileIndex < static_cast<uint32_t>(fileTrigrams.size()); ++fileIndex)
+        {
+            for (uint32_t trigram : fileTrigrams[fileIndex])
+            {
+                pairs.emplace_back(trigram, fileIndex);
+            }
+        }
+        std::sort(pairs.begin(), pairs.end());
+
+        m_PostingKeys.clear();
+        m_PostingOffsets.clear();
+        m_PostingFiles.clear();
+        m_PostingFiles.reserve(pairs.size());
+
+        for (const auto& [trigram, fileIndex] : pairs)
+        {
+            if (m_PostingKeys.empty() || m_PostingKeys.back() != trigram)
+            {
+                m_PostingKeys.push_back(trigram);
+                m_PostingOffsets.push_back(static_cast<uint32_t>(m_PostingFiles.size()));
+            }
+            m_PostingFiles.push_back(fileIndex);
+        }
+        m_PostingOffsets.push_back(static_cast<uint32_t>(m_PostingFiles.size()));
+    }
+
+    bool SearchIndex::ScanFile(const std::string& path, std::vector<uint32_t>& trigrams)
+    {
+        MappedFile file;
+        if (!file.Open(path))
+        {
+            return false;
+        }
+
+        trigrams.clear();
+        CollectTrigrams(file.GetView(), trigrams);
+        std::sort(trigrams.begin(), trigrams.end());
+        trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+        return true;
+    }
+
+    void SearchIndex::CollectTrigrams(std::string_view text, std::vector<uint32_t>& out)
+    {
+        // Trigrams never span a newline: FileSearch matches keywords line by line
+        uint32_t window = 0;
+        size_t run = 0;
+        for (char c : text)
+        {
+            if (c == '\n')
+            {
+                run = 0;
+                continue;
+            }
+
+            window = ((window << 8) | LowerByte(c)) & 0xFFFFFFu;
+            if (++run >= 3)
+            {
+                out.push_back(window);
+            }
+        }
+    }
+
+} // namespace gendev
@@ -0,0 +1,136 @@
+/**
+ * @file SearchIndex.h
+ * @brief Persistent trigram index for gendev ask
+ *
+ * Records the lowercase byte trigrams of every searchable file together
+ * with its modification time and size. The index lives in
+ * .gendev/search_index.bin under the project root and is refreshed
+ * incrementally: only files whose mtime or size changed are re-read.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace gendev
+{
+    // ============================================================================
+    // SearchIndex Class
+    // ============================================================================
+
+    /**
+     * @brief Trigram postings over the project's searchable files
+     *
+     * Used as a filter: a file is a candidate for a keyword only when it
+     * contains every trigram of that keyword. Candidates still need a
+     * line-level scan to produce results and context.
+     */
+    class SearchIndex
+    {
+    public:
+        /**
+         * @brief Statistics from the last Update call
+         */
+        struct UpdateStats
+        {
+            size_t TotalFiles = 0;      ///< Files in the index after the update
+            size_t ScannedFiles = 0;    ///< New or modified files that were re-read
+            size_t RemovedFiles = 0;    ///< Files dropped because they no longer exist
+        };
+
+        /**
+         * @brief Construct an index for a project
+         * @param rootPath Project root; the index file is stored under it
+         */
+        explicit SearchIndex(const std::string& rootPath);
+
+        /**
+         * @brief Load the index file if present
+         * @return true if a compatible index was loaded
+         */
+        bool Load();
+
+        /**
+         * @brief Write the index file, creating .gendev/ if needed
+         * @return true on success
+         */
+        bool Save() const;
+
+        /**
+         * @brief Bring the index in line with the given file list
+         *
+         * New and modified files are re-read on worker threads; files that
+         * are no longer in the list are removed.
+         *
+         * @param files Current searchable files
+         * @return What changed
+         */
+        UpdateStats Update(const std::vector<std::filesystem::path>& files);
+
+        /**
+         * @brief Get files that may contain any of the keywords
+         * @param keywords Keywords to look up (case-insensitive)
+         * @return Candidate file paths, in index order
+         */
+        std::vector<std::filesystem::path> FindCandidates(const std::vector<std::string>& keywords) const;
+
+        /**
+         * @brief Check whether the last Update changed anything
+         */
+        bool IsDirty() const { return m_Dirty; }
+
+        /**
+         * @brief Get the path of the index file
+         */
+        std::filesystem::path GetIndexPath() const;
+
+        /**
+         * @brief Directory under the project root that holds gendev state
+         */
+        static constexpr const char* STATE_DIRECTORY = ".gendev";
+
+    private:
+        struct FileEntry
+        {
+            std::string Path;               ///< Path as returned by the directory walk
+            int64_t ModifiedTime = 0;       ///< file_time_type ticks
+            uint64_t Size = 0;
+        };
+
+        static constexpr uint32_t INDEX_MAGIC = 0x58444747;    ///< "GGDX"
+        static constexpr uint32_t INDEX_VERSION = 1;
+
+        std::string m_RootPath;
+        std::vector<FileEntry> m_Files;
+
+        // Postings in CSR form: files containing m_PostingKeys[k] are
+        // m_PostingFiles[m_PostingOffsets[k] .. m_PostingOffsets[k + 1]), ascending
+        std::vector<uint32_t> m_PostingKeys;        ///< Sorted trigrams
+        std::vector<uint32_t> m_PostingOffsets = { 0 };
+        std::vector<uint32_t> m_PostingFiles;
+
+        bool m_Dirty = false;
+
+        /**
+         * @brief Rebuild the postings from per-file trigram sets
+         * @param fileTrigrams Sorted, unique trigrams per entry of m_Files
+         */
+        void BuildPostings(const std::vector<std::vector<uint32_t>>& fileTrigrams);
+
+        /**
+         * @brief Read a file and collect its sorted, unique trigrams
+         * @return false if the file could not be read
+         */
+        static bool ScanFile(const std::string& path, std::vector<uint32_t>& trigrams);
+
+        /**
+         * @brief Append the trigrams of text to out (lowercased, unsorted)
+         */
+        static void CollectTrigrams(std::string_view text, std::vector<uint32_t>& out);
+    };
+
+} // namespace gendev
@@ -10,11 +10,14 @@
  *   gendev create component <name> [members...]     Create ECS component
  *   gendev create system <name>                     Create ECS system
  *   gendev create event <name> [members...]         Create event struct
+ *   gendev bench run <name>                         Run benchmarks, store baseline
+ *   gendev bench compare <baseline> <candidate>     Compare two baselines
  */
 
 #include "CLI.h"
 #include "AskCommand.h"
 #include "CreateCommand.h"
+#include "BenchCommand.h"
 
 #include <iostream>
 #include <filesystem>
@@ -135,6 +138,11 @@ int main(int argc, char* argv[])
             }
         }
 
+        if (args.HasFlag("no-index"))
+        {
+            askCmd.SetUseIndex(false);
+        }
+
         return askCmd.Execute(args.Arguments);
     }
     else if (args.Command == "create")
@@ -154,6 +162,11 @@ int main(int argc, char* argv[])
 
         return createCmd.Execute(args.Arguments, args.Flags);
     }
+    else if (args.Command == "bench")
+    {
+        gendev::BenchCommand benchCmd(projectRoot);
+        return benchCmd.Execute(args.Arguments, args.Flags);
+    }
     else
     {
         gendev::Console::PrintError("Error: Unknown command '" + args.Command + "'.");
@@ -161,6 +174,7 @@ int main(int argc, char* argv[])
         gendev::Console::Print("Available commands:");
         gendev::Console::Print("  ask     Search project files for information");
         gendev::Console::Print("  create  Generate code from templates");
+        gendev::Console::Print("  bench   Run and compare benchmark baselines");
         gendev::Console::Print("");
         gendev::Console::Print("Use 'gendev --help' for more information.");
         return 1;
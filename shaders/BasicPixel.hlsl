@@ -33,6 +33,12 @@ cbuffer Material : register(b2)
     float2 UVOffset;        // Texture offset
 };
 
+// Draw root constants (b3)
+cbuffer DrawConstants : register(b3)
+{
+    uint BaseTextureIndex;  // Bindless heap index of the base texture
+};
+
 // ============================================================================
 // Lighting Constants
 // ============================================================================
@@ -49,9 +55,15 @@ static const float3 AmbientColor = float3(0.15f, 0.18f, 0.25f);
 // Textures and Samplers
 // ============================================================================
 
-Texture2D<float4> BaseTexture : register(t0);
+// Bindless heap: every texture SRV, indexed by Texture::GetBindlessIndex
+Texture2D<float4> g_Textures[] : register(t0, space1);
 SamplerState LinearSampler : register(s0);
 
+float4 SampleBaseTexture(float2 uv)
+{
+    return g_Textures[BaseTextureIndex].Sample(LinearSampler, uv);
+}
+
 // ============================================================================
 // Input Structure
 // ============================================================================
@@ -110,7 +122,7 @@ float4 main(PS_INPUT input) : SV_TARGET
 
     // Sample texture (if available) and apply UV transform
     float2 uv = input.TexCoord * UVScale + UVOffset;
-    float4 texColor = BaseTexture.Sample(LinearSampler, uv);
+    float4 texColor = SampleBaseTexture(uv);
 
     // Combine base color with texture and vertex color
     float4 albedo = BaseColor * texColor * input.Color;
@@ -153,7 +165,7 @@ float4 main(PS_INPUT input) : SV_TARGET
 float4 UnlitPS(PS_INPUT input) : SV_TARGET
 {
     float2 uv = input.TexCoord * UVScale + UVOffset;
-    float4 texColor = BaseTexture.Sample(LinearSampler, uv);
+    float4 texColor = SampleBaseTexture(uv);
     return BaseColor * texColor * input.Color;
 }
 
@@ -27,6 +27,14 @@ cbuffer PerObject : register(b1)
     float4x4 WorldInverseTranspose;
 };
 
+// Per-instance transforms for InstancedVS (t0), must match MeshInstanceData
+struct MeshInstance
+{
+    float4 WorldRows[3];    // Rows of the transposed world matrix (object -> world)
+};
+
+StructuredBuffer<MeshInstance> Instances : register(t0);
+
 // ============================================================================
 // Input/Output Structures
 // ============================================================================
@@ -79,6 +87,41 @@ VS_OUTPUT main(VS_INPUT input)
 // Alternative Entry Points
 // ============================================================================
 
+// Instanced variant of main: the transform comes from the instance buffer and
+// the normal matrix is rebuilt from its rows instead of being uploaded
+VS_OUTPUT InstancedVS(VS_INPUT input, uint instanceID : SV_InstanceID)
+{
+    MeshInstance instance = Instances[instanceID];
+    float3 row0 = instance.WorldRows[0].xyz;
+    float3 row1 = instance.WorldRows[1].xyz;
+    float3 row2 = instance.WorldRows[2].xyz;
+
+    VS_OUTPUT output;
+
+    float4 position = float4(input.Position, 1.0f);
+    output.WorldPosition = float3(
+        dot(instance.WorldRows[0], position),
+        dot(instance.WorldRows[1], position),
+        dot(instance.WorldRows[2], position));
+    output.Position = mul(float4(output.WorldPosition, 1.0f), ViewProjection);
+
+    // Inverse transpose of the 3x3 part up to scale: its rows are the cross
+    // products of the rows. The determinant's sign keeps mirrored normals outward.
+    float3 cofactor0 = cross(row1, row2);
+    float3 cofactor1 = cross(row2, row0);
+    float3 cofactor2 = cross(row0, row1);
+    float handedness = dot(row0, cofactor0) < 0.0f ? -1.0f : 1.0f;
+    output.WorldNormal = normalize(handedness * float3(
+        dot(cofactor0, input.Normal),
+        dot(cofactor1, input.Normal),
+        dot(cofactor2, input.Normal)));
+
+    output.TexCoord = input.TexCoord;
+    output.Color = input.Color;
+
+    return output;
+}
+
 // Simple vertex shader for position-only rendering (shadows, depth-only pass)
 float4 PositionOnlyVS(float3 Position : POSITION) : SV_POSITION
 {
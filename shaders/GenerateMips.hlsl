@@ -0,0 +1,48 @@
+/**
+ * @file GenerateMips.hlsl
+ * @brief Compute shader that builds one mip level from the level above
+ *
+ * Each thread box-filters the 2x2 source texels under its destination
+ * texel; on odd-sized levels the last row and column are clamped. The
+ * generator dispatches once per level, so level N reads the finished N-1.
+ */
+
+// ============================================================================
+// Resources
+// ============================================================================
+
+// Level sizes (root constants, b0)
+cbuffer MipConstants : register(b0)
+{
+    uint2 SourceSize;       // Source level size in texels
+    uint2 DestSize;         // Destination level size in texels
+};
+
+// Source level (t0)
+Texture2D<float4> SourceMip : register(t0);
+
+// Destination level (u0)
+RWTexture2D<float4> DestMip : register(u0);
+
+// ============================================================================
+// Entry Point
+// ============================================================================
+
+[numthreads(8, 8, 1)]
+void main(uint3 dispatchID : SV_DispatchThreadID)
+{
+    if (any(dispatchID.xy >= DestSize))
+    {
+        return;
+    }
+
+    uint2 base = dispatchID.xy * 2;
+    uint2 last = SourceSize - 1;
+
+    float4 sum = SourceMip.Load(int3(min(base, last), 0))
+               + SourceMip.Load(int3(min(base + uint2(1, 0), last), 0))
+               + SourceMip.Load(int3(min(base + uint2(0, 1), last), 0))
+               + SourceMip.Load(int3(min(base + uint2(1, 1), last), 0));
+
+    DestMip[dispatchID.xy] = sum * 0.25f;
+}
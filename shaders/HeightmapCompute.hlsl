@@ -0,0 +1,170 @@
+/**
+ * @file HeightmapCompute.hlsl
+ * @brief Compute shader that generates terrain heightmaps
+ *
+ * GPU port of the HeightmapSettings pipeline: Perlin FBM, optional domain
+ * warp, island falloff and terracing, remapped to [MinHeight, MaxHeight].
+ * Uses the same permutation table as PCG::PerlinNoise, so heights match the
+ * CPU generator up to float rounding.
+ */
+
+// ============================================================================
+// Resources
+// ============================================================================
+
+// Generation parameters (root constants, b0)
+cbuffer HeightmapConstants : register(b0)
+{
+    float OriginX;          // Sample-space X of texel (0, 0)
+    float OriginY;          // Sample-space Y of texel (0, 0)
+    float Step;             // Sample-space distance between texels
+    float WarpStrength;     // Domain warp strength
+    uint Width;             // Output width in texels
+    uint Height;            // Output height in texels
+    uint Octaves;           // FBM octave count
+    uint Flags;             // HEIGHTMAP_FLAG_* bits
+    float Frequency;        // FBM starting frequency
+    float Amplitude;        // FBM starting amplitude
+    float Lacunarity;       // FBM frequency multiplier per octave
+    float Persistence;      // FBM amplitude multiplier per octave
+    float Normalization;    // Sum of octave amplitudes (divides the FBM sum)
+    float MinHeight;        // Output height range minimum
+    float MaxHeight;        // Output height range maximum
+    uint TerraceCount;      // Number of terrace levels
+};
+
+// Doubled 256-entry permutation table (t0)
+StructuredBuffer<int> Permutation : register(t0);
+
+// Output heightmap (u0)
+RWTexture2D<float> OutputHeightmap : register(u0);
+
+#define HEIGHTMAP_FLAG_DOMAIN_WARP 0x1
+#define HEIGHTMAP_FLAG_FALLOFF     0x2
+#define HEIGHTMAP_FLAG_TERRACING   0x4
+
+// ============================================================================
+// Perlin Noise
+// ============================================================================
+
+float Fade(float t)
+{
+    // 6t^5 - 15t^4 + 10t^3 (improved Perlin fade function)
+    return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+}
+
+float Grad(int hash, float x, float y)
+{
+    // Same gradient selection as PerlinNoise::Grad on the z = 0 plane
+    int h = hash & 15;
+    float u = h < 8 ? x : y;
+    float v = h < 4 ? y : ((h == 12 || h == 14) ? x : 0.0f);
+    return ((h & 1) == 0 ? u : -u) + ((h & 2) == 0 ? v : -v);
+}
+
+float Perlin(float x, float y)
+{
+    float floorX = floor(x);
+    float floorY = floor(y);
+    int X = int(floorX) & 255;
+    int Y = int(floorY) & 255;
+
+    x -= floorX;
+    y -= floorY;
+
+    float u = Fade(x);
+    float v = Fade(y);
+
+    int A = Permutation[X] + Y;
+    int AA = Permutation[A];
+    int AB = Permutation[A + 1];
+    int B = Permutation[X + 1] + Y;
+    int BA = Permutation[B];
+    int BB = Permutation[B + 1];
+
+    float x0 = lerp(Grad(Permutation[AA], x, y), Grad(Permutation[BA], x - 1.0f, y), u);
+    float x1 = lerp(Grad(Permutation[AB], x, y - 1.0f), Grad(Permutation[BB], x - 1.0f, y - 1.0f), u);
+    return lerp(x0, x1, v);
+}
+
+// ============================================================================
+// FBM
+// ============================================================================
+
+float FBM(float x, float y)
+{
+    float sum = 0.0f;
+    float frequency = Frequency;
+    float amplitude = Amplitude;
+
+    for (uint i = 0; i < Octaves; ++i)
+    {
+        sum += Perlin(x * frequency, y * frequency) * amplitude;
+        frequency *= Lacunarity;
+        amplitude *= Persistence;
+    }
+
+    return sum / Normalization;
+}
+
+float WarpedFBM(float x, float y)
+{
+    // Same offsets as FBM::WarpedSample
+    float qx = FBM(x, y);
+    float qy = FBM(x + 5.2f, y + 1.3f);
+
+    return FBM(x + WarpStrength * qx * 4.0f, y + WarpStrength * qy * 4.0f);
+}
+
+// ============================================================================
+// Post-Processing
+// ============================================================================
+
+float Falloff(uint2 texel)
+{
+    // Square falloff over the dispatched region (HeightmapGenerator::GenerateFalloffMap)
+    float nx = float(texel.x) / float(Width) * 2.0f - 1.0f;
+    float ny = float(texel.y) / float(Height) * 2.0f - 1.0f;
+    float value = max(abs(nx), abs(ny));
+
+    float a = value * value * value;
+    float b = (2.2f - 2.2f * value);
+    value = a / (a + b * b * b);
+
+    return 1.0f - value;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+[numthreads(8, 8, 1)]
+void main(uint3 dispatchThreadID : SV_DispatchThreadID)
+{
+    uint2 texel = dispatchThreadID.xy;
+    if (texel.x >= Width || texel.y >= Height)
+    {
+        return;
+    }
+
+    float x = OriginX + float(texel.x) * Step;
+    float y = OriginY + float(texel.y) * Step;
+
+    float value = (Flags & HEIGHTMAP_FLAG_DOMAIN_WARP) ? WarpedFBM(x, y) : FBM(x, y);
+
+    // Remap from [-1, 1] to [0, 1]
+    float height = (value + 1.0f) * 0.5f;
+
+    if (Flags & HEIGHTMAP_FLAG_FALLOFF)
+    {
+        height *= Falloff(texel);
+    }
+
+    if (Flags & HEIGHTMAP_FLAG_TERRACING)
+    {
+        float levels = float(TerraceCount);
+        height = floor(height * levels + 0.5f) / levels;
+    }
+
+    OutputHeightmap[texel] = MinHeight + height * (MaxHeight - MinHeight);
+}
@@ -0,0 +1,78 @@
+/**
+ * @file HiZ.hlsl
+ * @brief Min/max hierarchical depth pyramid (HiZPyramid)
+ *
+ * DownsampleDepthCS reduces the depth buffer into mip 0 and DownsampleHiZCS
+ * reduces each mip into the next, one dispatch per level. Every texel stores
+ * the nearest (x) and farthest (y) depth of the pixels under it: occlusion
+ * tests compare against y, screen-space effects can bound their search with x.
+ */
+
+// ============================================================================
+// Resources
+// ============================================================================
+
+// Source and destination sizes in texels (root constants, b0)
+cbuffer DownsampleConstants : register(b0)
+{
+    uint SourceWidth;
+    uint SourceHeight;
+    uint DestWidth;
+    uint DestHeight;
+};
+
+// Depth buffer (t0), previous pyramid level (t1)
+Texture2D<float> SourceDepth : register(t0);
+Texture2D<float2> SourceMip : register(t1);
+
+// Level being written (u0)
+RWTexture2D<float2> DestMip : register(u0);
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+// Destination texel (x, y) covers source texels [2x, 2x + 1] x [2y, 2y + 1];
+// mip 0 is padded to a power of two, so texels past the depth edge clamp to it
+int3 SourceTexel(uint2 dest, uint2 offset)
+{
+    return int3(min(dest * 2 + offset, uint2(SourceWidth, SourceHeight) - 1), 0);
+}
+
+// ============================================================================
+// Entry Points
+// ============================================================================
+
+[numthreads(8, 8, 1)]
+void DownsampleDepthCS(uint3 dispatchThreadID : SV_DispatchThreadID)
+{
+    uint2 dest = dispatchThreadID.xy;
+    if (dest.x >= DestWidth || dest.y >= DestHeight)
+    {
+        return;
+    }
+
+    float d0 = SourceDepth.Load(SourceTexel(dest, uint2(0, 0)));
+    float d1 = SourceDepth.Load(SourceTexel(dest, uint2(1, 0)));
+    float d2 = SourceDepth.Load(SourceTexel(dest, uint2(0, 1)));
+    float d3 = SourceDepth.Load(SourceTexel(dest, uint2(1, 1)));
+
+    DestMip[dest] = float2(min(min(d0, d1), min(d2, d3)), max(max(d0, d1), max(d2, d3)));
+}
+
+[numthreads(8, 8, 1)]
+void DownsampleHiZCS(uint3 dispatchThreadID : SV_DispatchThreadID)
+{
+    uint2 dest = dispatchThreadID.xy;
+    if (dest.x >= DestWidth || dest.y >= DestHeight)
+    {
+        return;
+    }
+
+    float2 d0 = SourceMip.Load(SourceTexel(dest, uint2(0, 0)));
+    float2 d1 = SourceMip.Load(SourceTexel(dest, uint2(1, 0)));
+    float2 d2 = SourceMip.Load(SourceTexel(dest, uint2(0, 1)));
+    float2 d3 = SourceMip.Load(SourceTexel(dest, uint2(1, 1)));
+
+    DestMip[dest] = float2(min(min(d0.x, d1.x), min(d2.x, d3.x)), max(max(d0.y, d1.y), max(d2.y, d3.y)));
+}
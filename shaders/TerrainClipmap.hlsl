@@ -0,0 +1,123 @@
+/**
+ * @file TerrainClipmap.hlsl
+ * @brief Geometry clipmap terrain vertex shader
+ *
+ * Every clipmap level draws the same (GridSize + 1)^2 vertex grid, with the
+ * finer level's hole cut out by its index buffer and no vertex buffer. X/Z
+ * come from SV_VertexID and the level's origin and step; heights come from
+ * the level's toroidal ring in the height buffer. Vertices near the outer
+ * edge blend toward the parent level's surface, so at the edge they lie on
+ * the coarser grid and nested levels meet without cracks. Shading matches
+ * TerrainVertex.hlsl, so TerrainPixel.hlsl is shared.
+ */
+
+#include "TerrainVertex.hlsl"
+
+// ============================================================================
+// Level Constants
+// ============================================================================
+
+// Must match PCG::ClipmapLevelData (b3)
+cbuffer ClipmapLevel : register(b3)
+{
+    float2 GridOrigin;              // World XZ of grid vertex (0, 0)
+    float GridStep;                 // World distance between grid vertices
+    float MorphWidth;               // Grid units over which vertices blend into the parent
+    float2 CameraGrid;              // Camera XZ in grid units from GridOrigin
+    uint RingSize;                  // Ring texels per side
+    uint GridSize;                  // Grid quads per side
+    uint2 RingOffset;               // Ring texel of grid vertex (0, 0)
+    uint2 ParentRingOffset;         // Parent ring texel of grid vertex (0, 0)
+    uint HeightOffset;              // Byte offset of this level's ring in Heightfield
+    uint ParentHeightOffset;        // Byte offset of the parent's ring
+    uint HasParent;                 // 0 for the coarsest level
+    float ClipmapTextureScale;
+    float ClipmapMinHeight;         // Height range mapped to the color ramp
+    float ClipmapMaxHeight;
+    float2 ClipmapPadding;
+};
+
+// Heightfield (t1) holds every level's ring of world-space float heights
+
+// ============================================================================
+// Ring Access
+// ============================================================================
+
+// Height at a grid position of this level (-1 to GridSize + 1)
+float LoadLevelHeight(int2 grid)
+{
+    uint2 texel = (RingOffset + uint2(grid + (int)RingSize)) % RingSize;
+    return asfloat(Heightfield.Load(HeightOffset + (texel.y * RingSize + texel.x) * 4));
+}
+
+// Height at a parent grid position, relative to this level's vertex (0, 0)
+float LoadParentHeight(int2 parentGrid)
+{
+    uint2 texel = (ParentRingOffset + uint2(parentGrid + (int)RingSize)) % RingSize;
+    return asfloat(Heightfield.Load(ParentHeightOffset + (texel.y * RingSize + texel.x) * 4));
+}
+
+// Central-difference normal, as Chunk::CalculateNormal computes it
+float3 LevelNormal(int2 grid)
+{
+    float hL = LoadLevelHeight(grid + int2(-1, 0));
+    float hR = LoadLevelHeight(grid + int2(1, 0));
+    float hD = LoadLevelHeight(grid + int2(0, -1));
+    float hU = LoadLevelHeight(grid + int2(0, 1));
+    return normalize(float3(hL - hR, 2.0f * GridStep, hD - hU));
+}
+
+float3 ParentNormal(int2 parentGrid)
+{
+    float hL = LoadParentHeight(parentGrid + int2(-1, 0));
+    float hR = LoadParentHeight(parentGrid + int2(1, 0));
+    float hD = LoadParentHeight(parentGrid + int2(0, -1));
+    float hU = LoadParentHeight(parentGrid + int2(0, 1));
+    return normalize(float3(hL - hR, 4.0f * GridStep, hD - hU));
+}
+
+// ============================================================================
+// Vertex Shader
+// ============================================================================
+
+VS_OUTPUT ClipmapVS(uint vertexID : SV_VertexID)
+{
+    uint verticesPerSide = GridSize + 1;
+    int2 grid = int2(vertexID % verticesPerSide, vertexID / verticesPerSide);
+
+    float height = LoadLevelHeight(grid);
+    float3 normal = LevelNormal(grid);
+
+    // Blend over the outer band; the camera is at most two vertices off
+    // centre, so every edge vertex is fully on the parent's surface
+    float2 distance = abs(float2(grid) - CameraGrid);
+    float edgeStart = GridSize * 0.5f - 2.0f - MorphWidth;
+    float morph = HasParent ? saturate((max(distance.x, distance.y) - edgeStart) / MorphWidth) : 0.0f;
+
+    if (morph > 0.0f)
+    {
+        // Odd vertices take the midpoint of the parent edge (or diagonal,
+        // matching the mesh split) they lie on
+        int2 parentGrid = grid / 2;
+        int2 odd = grid & 1;
+        float parentHeight = 0.5f * (LoadParentHeight(parentGrid) + LoadParentHeight(parentGrid + odd));
+        float3 parentNormal = normalize(ParentNormal(parentGrid) + ParentNormal(parentGrid + odd));
+
+        height = lerp(height, parentHeight, morph);
+        normal = normalize(lerp(normal, parentNormal, morph));
+    }
+
+    TerrainVertex vertex;
+    vertex.Position = float3(GridOrigin.x + grid.x * GridStep, height, GridOrigin.y + grid.y * GridStep);
+    vertex.Normal = normal;
+    vertex.TexCoord = vertex.Position.xz / (ChunkSize * VertexSpacing);
+    vertex.Height = (ClipmapMaxHeight - ClipmapMinHeight) > 0.001f
+        ? saturate((height - ClipmapMinHeight) / (ClipmapMaxHeight - ClipmapMinHeight))
+        : 0.5f;
+
+    // Only the texture scale is read from the chunk parameters
+    ChunkParams params = (ChunkParams)0;
+    params.TextureScale = ClipmapTextureScale;
+
+    return ShadeTerrainVertex(vertex, params);
+}
@@ -0,0 +1,173 @@
+/**
+ * @file TerrainCull.hlsl
+ * @brief GPU-driven terrain chunk culling
+ *
+ * CullCS tests every chunk's bounds against the view frustum and the
+ * renderer's Hi-Z pyramid (HiZ.hlsl), then appends the draw command of each
+ * survivor to an ExecuteIndirect argument buffer.
+ */
+
+// ============================================================================
+// Culling Resources
+// ============================================================================
+
+// Culling parameters (b0)
+cbuffer CullConstants : register(b0)
+{
+    float4 FrustumPlanes[6];        // Inward-facing planes (xyz normal, w distance)
+    float4x4 PrevViewProjection;    // View-projection the Hi-Z was rendered with
+    uint RecordCount;               // Number of entries in ChunkRecords
+    uint HiZEnabled;                // Non-zero when the Hi-Z pyramid is valid
+    uint DepthWidth;                // Depth buffer width (Hi-Z mip 0 covers 2x2 pixels per texel)
+    uint DepthHeight;               // Depth buffer height
+    uint HiZMipCount;               // Number of Hi-Z mips
+    uint3 CullPadding;
+};
+
+// Must match TerrainGPUDrawCommand (VBV, IBV, chunk index, indexed draw)
+struct DrawCommand
+{
+    uint2 VertexBufferLocation;
+    uint VertexBufferSize;
+    uint VertexBufferStride;
+    uint2 IndexBufferLocation;
+    uint IndexBufferSize;
+    uint IndexBufferFormat;
+    uint ChunkIndex;
+    uint IndexCountPerInstance;
+    uint InstanceCount;
+    uint StartIndexLocation;
+    int BaseVertexLocation;
+    uint StartInstanceLocation;
+};
+
+// Must match TerrainCullRecord
+struct ChunkRecord
+{
+    float3 BoundsMin;
+    uint RecordPadding0;
+    float3 BoundsMax;
+    uint RecordPadding1;
+    DrawCommand Command;
+};
+
+StructuredBuffer<ChunkRecord> ChunkRecords : register(t0);
+Texture2D<float2> HiZ : register(t1);    // Nearest (x) and farthest (y) depth per texel
+
+RWStructuredBuffer<DrawCommand> OutputCommands : register(u0);
+RWByteAddressBuffer OutputCount : register(u1);
+
+// ============================================================================
+// Culling
+// ============================================================================
+
+bool IsInsideFrustum(float3 boundsMin, float3 boundsMax)
+{
+    [unroll]
+    for (uint i = 0; i < 6; ++i)
+    {
+        float4 plane = FrustumPlanes[i];
+
+        // Corner furthest along the plane normal
+        float3 corner = float3(
+            plane.x >= 0.0f ? boundsMax.x : boundsMin.x,
+            plane.y >= 0.0f ? boundsMax.y : boundsMin.y,
+            plane.z >= 0.0f ? boundsMax.z : boundsMin.z);
+
+        if (dot(plane.xyz, corner) + plane.w < 0.0f)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool IsOccluded(float3 boundsMin, float3 boundsMax)
+{
+    float2 screenMin = float2(1.0f, 1.0f);
+    float2 screenMax = float2(0.0f, 0.0f);
+    float nearestDepth = 1.0f;
+
+    [unroll]
+    for (uint i = 0; i < 8; ++i)
+    {
+        float3 corner = float3(
+            (i & 1) ? boundsMax.x : boundsMin.x,
+            (i & 2) ? boundsMax.y : boundsMin.y,
+            (i & 4) ? boundsMax.z : boundsMin.z);
+
+        float4 clip = mul(float4(corner, 1.0f), PrevViewProjection);
+
+        // Crossing the previous near plane: cannot be tested conservatively
+        if (clip.w <= 1e-4f)
+        {
+            return false;
+        }
+
+        float3 ndc = clip.xyz / clip.w;
+        float2 uv = float2(ndc.x * 0.5f + 0.5f, 0.5f - ndc.y * 0.5f);
+
+        screenMin = min(screenMin, uv);
+        screenMax = max(screenMax, uv);
+        nearestDepth = min(nearestDepth, ndc.z);
+    }
+
+    // Off-screen last frame: no depth to test against
+    if (any(screenMax < 0.0f) || any(screenMin > 1.0f))
+    {
+        return false;
+    }
+
+    float2 depthSize = float2(DepthWidth, DepthHeight);
+    uint2 pixelMin = (uint2)clamp(screenMin * depthSize, 0.0f, depthSize - 1.0f);
+    uint2 pixelMax = (uint2)clamp(screenMax * depthSize, 0.0f, depthSize - 1.0f);
+
+    // Mip k texel (x, y) covers depth pixels [x, x + 1] << (k + 1), so pick the
+    // first mip where the rectangle spans at most 2x2 texels
+    uint mip = 0;
+    while (mip + 1 < HiZMipCount && any(((pixelMax >> (mip + 1)) - (pixelMin >> (mip + 1))) > 1))
+    {
+        ++mip;
+    }
+
+    uint2 texelMin = pixelMin >> (mip + 1);
+    uint2 texelMax = pixelMax >> (mip + 1);
+
+    float farthest = 0.0f;
+    for (uint y = texelMin.y; y <= texelMax.y; ++y)
+    {
+        for (uint x = texelMin.x; x <= texelMax.x; ++x)
+        {
+            farthest = max(farthest, HiZ.Load(int3(x, y, mip)).y);
+        }
+    }
+
+    return nearestDepth > farthest;
+}
+
+[numthreads(64, 1, 1)]
+void CullCS(uint3 dispatchThreadID : SV_DispatchThreadID)
+{
+    uint index = dispatchThreadID.x;
+    if (index >= RecordCount)
+    {
+        return;
+    }
+
+    ChunkRecord record = ChunkRecords[index];
+
+    if (!IsInsideFrustum(record.BoundsMin, record.BoundsMax))
+    {
+        return;
+    }
+
+    if (HiZEnabled != 0 && IsOccluded(record.BoundsMin, record.BoundsMax))
+    {
+        return;
+    }
+
+    uint slot;
+    OutputCount.InterlockedAdd(0, 1, slot);
+    OutputCommands[slot] = record.Command;
+}
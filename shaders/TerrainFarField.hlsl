@@ -0,0 +1,75 @@
+/**
+ * @file TerrainFarField.hlsl
+ * @brief Far-field horizon terrain vertex shader
+ *
+ * Draws the camera-centred ring beyond the chunk view distance as one
+ * (GridSize + 1)^2 vertex grid without a vertex buffer. X/Z come from
+ * SV_VertexID and the grid origin and step; heights come from the ring's
+ * height array, which has one border vertex per side for normals. The
+ * surface is lowered by Sink so streamed chunks win where the two overlap.
+ * Shading and fog match TerrainVertex.hlsl, so TerrainPixel.hlsl is shared.
+ */
+
+#include "TerrainVertex.hlsl"
+
+// ============================================================================
+// Ring Constants
+// ============================================================================
+
+// Must match PCG::FarFieldData (b3)
+cbuffer FarField : register(b3)
+{
+    float2 FarGridOrigin;           // World XZ of grid vertex (0, 0)
+    float FarGridStep;              // World distance between grid vertices
+    uint FarGridSize;               // Grid quads per side
+    float FarSink;                  // Downward offset
+    float FarTextureScale;
+    float FarMinHeight;             // Height range mapped to the color ramp
+    float FarMaxHeight;
+};
+
+// Heightfield (t1) holds (FarGridSize + 3)^2 world-space float heights
+
+// ============================================================================
+// Height Access
+// ============================================================================
+
+// Height at a grid position (-1 to FarGridSize + 1)
+float LoadFarHeight(int2 grid)
+{
+    uint rowLength = FarGridSize + 3;
+    uint2 texel = uint2(grid + 1);
+    return asfloat(Heightfield.Load((texel.y * rowLength + texel.x) * 4));
+}
+
+// ============================================================================
+// Vertex Shader
+// ============================================================================
+
+VS_OUTPUT FarFieldVS(uint vertexID : SV_VertexID)
+{
+    uint verticesPerSide = FarGridSize + 1;
+    int2 grid = int2(vertexID % verticesPerSide, vertexID / verticesPerSide);
+
+    float height = LoadFarHeight(grid);
+
+    // Central-difference normal, as Chunk::CalculateNormal computes it
+    float hL = LoadFarHeight(grid + int2(-1, 0));
+    float hR = LoadFarHeight(grid + int2(1, 0));
+    float hD = LoadFarHeight(grid + int2(0, -1));
+    float hU = LoadFarHeight(grid + int2(0, 1));
+
+    TerrainVertex vertex;
+    vertex.Position = float3(FarGridOrigin.x + grid.x * FarGridStep, height - FarSink, FarGridOrigin.y + grid.y * FarGridStep);
+    vertex.Normal = normalize(float3(hL - hR, 2.0f * FarGridStep, hD - hU));
+    vertex.TexCoord = vertex.Position.xz / (ChunkSize * VertexSpacing);
+    vertex.Height = (FarMaxHeight - FarMinHeight) > 0.001f
+        ? saturate((height - FarMinHeight) / (FarMaxHeight - FarMinHeight))
+        : 0.5f;
+
+    // Only the texture scale is read from the chunk parameters
+    ChunkParams params = (ChunkParams)0;
+    params.TextureScale = FarTextureScale;
+
+    return ShadeTerrainVertex(vertex, params);
+}
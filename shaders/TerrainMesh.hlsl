@@ -0,0 +1,265 @@
+/**
+ * @file TerrainMesh.hlsl
+ * @brief Amplification/mesh shader terrain path with per-meshlet culling
+ *
+ * Each chunk is split into meshlets of up to 8x8 quads at the chunk's drawn
+ * grid step. The amplification shader culls meshlets against the frustum,
+ * their normal cone and a maximum distance; the mesh shader emits the
+ * surviving grids straight from the chunk's heightfield, with no input
+ * assembler and no index buffer. Vertices decode exactly as in
+ * TerrainVertex.hlsl, so TerrainPixel.hlsl shades both paths. The
+ * heightfield binding and reader live there too.
+ *
+ * Requires Shader Model 6.5; built offline only (see CMakeLists.txt).
+ */
+
+#include "TerrainVertex.hlsl"
+
+// ============================================================================
+// Meshlet Layout
+// ============================================================================
+
+#define MESHLET_QUADS 8                                     // Quads per meshlet side
+#define MESHLET_MAX_VERTICES 81                             // (MESHLET_QUADS + 1)^2
+#define MESHLET_MAX_TRIANGLES 128                           // 2 * MESHLET_QUADS^2
+#define MAX_MESHLETS_PER_CHUNK 16                           // (ChunkSize / MESHLET_QUADS)^2
+
+// How a chunk drawn at one grid step splits into meshlets
+struct MeshletLayout
+{
+    uint DrawStep;      // Grid step between meshlet vertices
+    uint Quads;         // Quads per meshlet side (fewer than MESHLET_QUADS on coarse LODs)
+    uint PerSide;       // Meshlets per chunk side
+    uint Count;         // Meshlets in the chunk
+};
+
+MeshletLayout GetMeshletLayout(ChunkParams chunk)
+{
+    MeshletLayout layout;
+    layout.DrawStep = max(chunk.DrawStep, 1u);
+
+    uint quadsPerSide = ChunkSize / layout.DrawStep;
+    layout.Quads = min(quadsPerSide, (uint)MESHLET_QUADS);
+    layout.PerSide = quadsPerSide / layout.Quads;
+    layout.Count = layout.PerSide * layout.PerSide;
+    return layout;
+}
+
+// Chunk grid position of a meshlet's first vertex
+uint2 GetMeshletOrigin(uint meshlet, MeshletLayout layout)
+{
+    return uint2(meshlet % layout.PerSide, meshlet / layout.PerSide) * layout.Quads * layout.DrawStep;
+}
+
+// ============================================================================
+// Edge Stitching
+// ============================================================================
+
+// Snap border vertices onto the coarser grid agreed with the neighbouring
+// chunk. The extra vertices collapse onto their coarse neighbours, so the
+// edge matches the neighbour's exactly, like the stitched index buffer.
+uint2 SnapToEdgeGrid(uint2 grid, ChunkParams chunk)
+{
+    if (grid.x == 0 && chunk.EdgeStep.x > chunk.DrawStep)
+    {
+        grid.y -= grid.y % chunk.EdgeStep.x;
+    }
+    else if (grid.x == ChunkSize && chunk.EdgeStep.y > chunk.DrawStep)
+    {
+        grid.y -= grid.y % chunk.EdgeStep.y;
+    }
+
+    if (grid.y == 0 && chunk.EdgeStep.z > chunk.DrawStep)
+    {
+        grid.x -= grid.x % chunk.EdgeStep.z;
+    }
+    else if (grid.y == ChunkSize && chunk.EdgeStep.w > chunk.DrawStep)
+    {
+        grid.x -= grid.x % chunk.EdgeStep.w;
+    }
+
+    return grid;
+}
+
+// ============================================================================
+// Meshlet Culling
+// ============================================================================
+
+// True if every corner of the box is outside the same clip plane
+bool IsBoxOutsideFrustum(float3 boundsMin, float3 boundsMax)
+{
+    uint outsideAll = 0x3F;
+    for (uint corner = 0; corner < 8; ++corner)
+    {
+        float3 position = float3(
+            (corner & 1) ? boundsMax.x : boundsMin.x,
+            (corner & 2) ? boundsMax.y : boundsMin.y,
+            (corner & 4) ? boundsMax.z : boundsMin.z);
+        float4 clip = mul(float4(position, 1.0f), ViewProjection);
+
+        uint outside = 0;
+        outside |= clip.x < -clip.w ? 0x01 : 0;
+        outside |= clip.x >  clip.w ? 0x02 : 0;
+        outside |= clip.y < -clip.w ? 0x04 : 0;
+        outside |= clip.y >  clip.w ? 0x08 : 0;
+        outside |= clip.z <  0.0f   ? 0x10 : 0;
+        outside |= clip.z >  clip.w ? 0x20 : 0;
+        outsideAll &= outside;
+    }
+
+    return outsideAll != 0;
+}
+
+bool IsMeshletVisible(uint meshlet, MeshletLayout layout, ChunkParams chunk)
+{
+    uint2 origin = GetMeshletOrigin(meshlet, layout);
+    uint side = layout.Quads + 1;
+
+    // Height range (covering both geomorph endpoints) and summed normal
+    float minHeight = 1.0f;
+    float maxHeight = 0.0f;
+    float3 normalSum = 0.0f;
+    for (uint z = 0; z < side; ++z)
+    {
+        for (uint x = 0; x < side; ++x)
+        {
+            VS_INPUT input = LoadHeightfieldVertex(origin + uint2(x, z) * layout.DrawStep, chunk);
+            minHeight = min(minHeight, min(input.Height, input.MorphHeight));
+            maxHeight = max(maxHeight, max(input.Height, input.MorphHeight));
+            normalSum += DecodeOctahedralNormal(input.Normal);
+        }
+    }
+
+    float extent = layout.Quads * layout.DrawStep * VertexSpacing;
+    float3 boundsMin = float3(chunk.ChunkOffset.x + origin.x * VertexSpacing,
+                              lerp(chunk.MinHeight, chunk.MaxHeight, minHeight),
+                              chunk.ChunkOffset.y + origin.y * VertexSpacing);
+    float3 boundsMax = float3(boundsMin.x + extent,
+                              lerp(chunk.MinHeight, chunk.MaxHeight, maxHeight),
+                              boundsMin.z + extent);
+
+    float3 center = (boundsMin + boundsMax) * 0.5f;
+    float radius = length(boundsMax - center);
+    float3 toCenter = center - CameraPosition;
+    float cameraDistance = length(toCenter);
+
+    if (cameraDistance - radius > MeshletCullDistance)
+    {
+        return false;
+    }
+
+    if (IsBoxOutsideFrustum(boundsMin, boundsMax))
+    {
+        return false;
+    }
+
+    // Normal cone: the widest angle between any vertex normal and the mean.
+    // Vertex normals only approximate the face normals, so the cone is widened.
+    float3 axis = normalize(normalSum);
+    float minDot = 1.0f;
+    for (uint cz = 0; cz < side; ++cz)
+    {
+        for (uint cx = 0; cx < side; ++cx)
+        {
+            VS_INPUT input = LoadHeightfieldVertex(origin + uint2(cx, cz) * layout.DrawStep, chunk);
+            minDot = min(minDot, dot(axis, DecodeOctahedralNormal(input.Normal)));
+        }
+    }
+
+    float coneCos = minDot - 0.1f;
+    if (coneCos > 0.0f)
+    {
+        // Back-facing if every view direction into the bounds is more than
+        // 90 degrees minus the cone angle away from the axis
+        float coneSin = sqrt(1.0f - coneCos * coneCos);
+        if (dot(toCenter, axis) > coneSin * cameraDistance + radius)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// ============================================================================
+// Amplification Shader
+// ============================================================================
+
+struct MeshletPayload
+{
+    uint MeshletIndices[MAX_MESHLETS_PER_CHUNK];
+};
+
+groupshared MeshletPayload s_Payload;
+groupshared uint s_VisibleCount;
+
+// One group per chunk, one thread per meshlet
+[numthreads(MAX_MESHLETS_PER_CHUNK, 1, 1)]
+void MeshletAS(uint threadID : SV_GroupThreadID)
+{
+    ChunkParams chunk = GetChunkParams();
+    MeshletLayout layout = GetMeshletLayout(chunk);
+
+    if (threadID == 0)
+    {
+        s_VisibleCount = 0;
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    if (threadID < layout.Count && IsMeshletVisible(threadID, layout, chunk))
+    {
+        uint slot;
+        InterlockedAdd(s_VisibleCount, 1, slot);
+        s_Payload.MeshletIndices[slot] = threadID;
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    DispatchMesh(s_VisibleCount, 1, 1, s_Payload);
+}
+
+// ============================================================================
+// Mesh Shader
+// ============================================================================
+
+// One group per visible meshlet; threads emit a vertex and a triangle each
+[numthreads(MESHLET_MAX_TRIANGLES, 1, 1)]
+[outputtopology("triangle")]
+void MeshletMS(
+    uint threadID : SV_GroupThreadID,
+    uint groupID : SV_GroupID,
+    in payload MeshletPayload payload,
+    out vertices VS_OUTPUT vertices[MESHLET_MAX_VERTICES],
+    out indices uint3 triangles[MESHLET_MAX_TRIANGLES])
+{
+    ChunkParams chunk = GetChunkParams();
+    MeshletLayout layout = GetMeshletLayout(chunk);
+
+    uint meshlet = payload.MeshletIndices[groupID];
+    uint2 origin = GetMeshletOrigin(meshlet, layout);
+    uint side = layout.Quads + 1;
+
+    uint vertexCount = side * side;
+    uint triangleCount = layout.Quads * layout.Quads * 2;
+    SetMeshOutputCounts(vertexCount, triangleCount);
+
+    if (threadID < vertexCount)
+    {
+        uint2 grid = origin + uint2(threadID % side, threadID / side) * layout.DrawStep;
+        VS_INPUT input = LoadHeightfieldVertex(SnapToEdgeGrid(grid, chunk), chunk);
+        vertices[threadID] = TransformTerrainVertex(input, chunk);
+    }
+
+    if (threadID < triangleCount)
+    {
+        // Same winding as Chunk::GenerateLODIndices
+        uint quad = threadID / 2;
+        uint topLeft = (quad / layout.Quads) * side + quad % layout.Quads;
+        uint topRight = topLeft + 1;
+        uint bottomLeft = topLeft + side;
+        uint bottomRight = bottomLeft + 1;
+
+        triangles[threadID] = (threadID & 1) == 0
+            ? uint3(topLeft, bottomLeft, bottomRight)
+            : uint3(topLeft, bottomRight, topRight);
+    }
+}
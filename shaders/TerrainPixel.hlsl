@@ -6,9 +6,18 @@
  * - Height-based color blending (water, sand, grass, rock, snow)
  * - Slope-based texture blending
  * - Simple directional lighting
+ * - Cascaded sun shadows (static and dynamic depth slices, PCF)
  * - Distance fog
  */
 
+// ============================================================================
+// Permutations (built offline for every combination, see CMakeLists.txt)
+// ============================================================================
+
+#ifndef TERRAIN_FOG
+#define TERRAIN_FOG 1           // Blend toward FogColor by the vertex fog factor
+#endif
+
 // ============================================================================
 // Constant Buffers
 // ============================================================================
@@ -24,7 +33,8 @@ cbuffer PerFrame : register(b0)
     float4 FogColor;
     float FogStart;
     float FogEnd;
-    float2 Padding;
+    float MeshletCullDistance;
+    float TessellationScale;
 };
 
 // Per-chunk constants (b1)
@@ -35,9 +45,34 @@ cbuffer PerChunk : register(b1)
     float TextureScale;
     float MinHeight;
     float MaxHeight;
-    float3 ChunkPadding;
+    uint LODStep;
+    uint DrawStep;
+    float MorphFactor;
+    uint4 EdgeStep;
+    float4 EdgeMorph;
 };
 
+// Must match PCG::ShadowCascadeData (b4); CascadeCount 0 disables shadowing
+cbuffer ShadowCascades : register(b4)
+{
+    float4x4 ShadowViewProjection[4];   // World to shadow map, per cascade
+    float4 ShadowSplitDepths;           // View depth where each cascade ends
+    float4 ShadowNormalOffsets;         // Receiver offset along the normal, per cascade
+    float3 ShadowCameraForward;         // Direction split depths are measured along
+    uint ShadowCascadeCount;
+    float ShadowTexelSize;              // 1 / map resolution
+    uint ShadowDynamicMask;             // Cascades whose dynamic slice holds casters
+    float2 ShadowPadding;
+};
+
+// ============================================================================
+// Shadow Maps
+// ============================================================================
+
+Texture2DArray<float> StaticShadowMaps : register(t2);     // Cached terrain depth, one slice per cascade
+Texture2DArray<float> DynamicShadowMaps : register(t3);    // Per-frame caster depth, one slice per cascade
+SamplerComparisonState ShadowSampler : register(s0);
+
 // ============================================================================
 // Input Structure
 // ============================================================================
@@ -201,6 +236,77 @@ float3 CalculateSpecular(float3 normal, float3 lightDir, float3 viewDir, float w
     return SunColor * spec * 0.5f;
 }
 
+// Lit fraction of a cascade with 3x3 PCF; dynamic casters win where nearer
+float SampleShadowCascade(uint cascade, float3 worldPosition)
+{
+    float4 shadowPos = mul(float4(worldPosition, 1.0f), ShadowViewProjection[cascade]);
+    float2 uv = float2(shadowPos.x * 0.5f + 0.5f, 0.5f - shadowPos.y * 0.5f);
+    float depth = shadowPos.z;
+
+    // Receivers beyond the box's far plane cannot be shadowed by what it holds
+    if (depth >= 1.0f)
+    {
+        return 1.0f;
+    }
+
+    bool dynamicCasters = (ShadowDynamicMask >> cascade) & 1;
+
+    float lit = 0.0f;
+    [unroll]
+    for (int y = -1; y <= 1; ++y)
+    {
+        [unroll]
+        for (int x = -1; x <= 1; ++x)
+        {
+            float3 coord = float3(uv + float2(x, y) * ShadowTexelSize, cascade);
+            float visible = StaticShadowMaps.SampleCmpLevelZero(ShadowSampler, coord, depth);
+            if (dynamicCasters)
+            {
+                visible = min(visible, DynamicShadowMaps.SampleCmpLevelZero(ShadowSampler, coord, depth));
+            }
+            lit += visible;
+        }
+    }
+
+    return lit / 9.0f;
+}
+
+// Sun visibility at a surface point (1 = fully lit)
+float GetShadowFactor(float3 worldPosition, float3 normal)
+{
+    if (ShadowCascadeCount == 0)
+    {
+        return 1.0f;
+    }
+
+    float viewDepth = dot(worldPosition - CameraPosition, ShadowCameraForward);
+    float splits[4] = { ShadowSplitDepths.x, ShadowSplitDepths.y, ShadowSplitDepths.z, ShadowSplitDepths.w };
+    float offsets[4] = { ShadowNormalOffsets.x, ShadowNormalOffsets.y, ShadowNormalOffsets.z, ShadowNormalOffsets.w };
+
+    uint cascade = 0;
+    [unroll]
+    for (uint i = 0; i < 3; ++i)
+    {
+        if (i + 1 < ShadowCascadeCount && viewDepth > splits[i])
+        {
+            cascade = i + 1;
+        }
+    }
+
+    float lastSplit = splits[ShadowCascadeCount - 1];
+    if (viewDepth > lastSplit)
+    {
+        return 1.0f;
+    }
+
+    // Offsetting the receiver along its normal hides acne on slopes the depth bias misses
+    float lit = SampleShadowCascade(cascade, worldPosition + normal * offsets[cascade]);
+
+    // Fade out over the last tenth of the shadow distance
+    float fade = saturate((lastSplit - viewDepth) / (lastSplit * 0.1f));
+    return lerp(1.0f, lit, fade);
+}
+
 // ============================================================================
 // Main Pixel Shader
 // ============================================================================
@@ -223,17 +329,18 @@ float4 main(PS_INPUT input) : SV_TARGET
     float detailVar = GetDetailVariation(input.TexCoord);
     terrainColor *= detailVar;
 
-    // Optionally blend with vertex color (from CPU calculation)
-    // This allows for smoother gradients from the mesh generation
+    // Optionally blend with vertex color (per-vertex ramp from the vertex shader)
+    // This allows for smoother gradients across the mesh
     terrainColor = lerp(terrainColor, input.VertexColor.rgb, 0.3f);
 
     // Calculate lighting
-    float3 diffuse = CalculateDiffuse(normal, LightDirection, SunColor, SunIntensity);
+    float shadow = GetShadowFactor(input.WorldPosition, normal);
+    float3 diffuse = CalculateDiffuse(normal, LightDirection, SunColor, SunIntensity) * shadow;
 
     // Add specular for water/wet areas
     float wetness = smoothstep(WaterLevel, ShallowWaterLevel, input.Height);
     wetness = 1.0f - wetness; // Invert so lower = more wet
-    float3 specular = CalculateSpecular(normal, LightDirection, viewDir, wetness * 0.5f);
+    float3 specular = CalculateSpecular(normal, LightDirection, viewDir, wetness * 0.5f) * shadow;
 
     // Combine lighting
     float3 ambient = AmbientColor;
@@ -245,7 +352,11 @@ float4 main(PS_INPUT input) : SV_TARGET
     float3 litColor = terrainColor * (ambient + diffuse) + specular;
 
     // Apply fog
+#if TERRAIN_FOG
     float3 finalColor = lerp(litColor, FogColor.rgb, input.FogFactor);
+#else
+    float3 finalColor = litColor;
+#endif
 
     // Gamma correction (assuming sRGB output)
     finalColor = pow(abs(finalColor), 1.0f / 2.2f);
@@ -291,7 +402,7 @@ float4 DebugSlopePS(PS_INPUT input) : SV_TARGET
     return float4(slope, 1.0f - slope, 0.0f, 1.0f);
 }
 
-// Vertex color passthrough (debug CPU-side coloring)
+// Vertex color passthrough (debug per-vertex coloring)
 float4 VertexColorPS(PS_INPUT input) : SV_TARGET
 {
     return input.VertexColor;
@@ -0,0 +1,87 @@
+/**
+ * @file TerrainShadingRate.hlsl
+ * @brief Screen-space shading rate image for the terrain pass (TerrainShadingRate)
+ *
+ * BuildShadingRateCS writes one D3D12_SHADING_RATE per image tile from the
+ * renderer's Hi-Z pyramid (HiZ.hlsl). The tile's nearest depth is turned
+ * back into a world position, so its distance and fog factor match what
+ * TerrainVertex.hlsl computes for the closest terrain under the tile: heavy
+ * fog gets the coarsest rate, light fog and the far distance get 2x2, the
+ * rest stays at full rate.
+ */
+
+// ============================================================================
+// Resources
+// ============================================================================
+
+// D3D12_SHADING_RATE values
+static const uint SHADING_RATE_1X1 = 0x0;
+static const uint SHADING_RATE_2X2 = 0x5;
+
+// Build parameters (b0)
+cbuffer ShadingRateConstants : register(b0)
+{
+    float4x4 InvViewProjection;     // Inverse of the view-projection the Hi-Z was rendered with
+    float3 CameraPosition;
+    float FarDistance;              // 2x2 beyond this distance
+    float FogStart;                 // Same fog range as the terrain shaders
+    float FogEnd;
+    float FogThreshold;             // 2x2 at or above this fog factor
+    float HeavyFogThreshold;        // CoarsestRate at or above this fog factor
+    uint DepthWidth;                // Hi-Z viewport size in pixels
+    uint DepthHeight;
+    uint ImageWidth;                // Shading rate image size in tiles
+    uint ImageHeight;
+    uint TileSize;                  // Pixels per tile side
+    uint HiZMip;                    // Hi-Z mip whose texels cover one tile
+    uint CoarsestRate;              // 4x4 where supported, otherwise 2x2
+    uint ShadingRatePadding;
+};
+
+Texture2D<float2> HiZ : register(t0);    // Nearest (x) and farthest (y) depth per texel
+
+RWTexture2D<uint> ShadingRateImage : register(u0);
+
+// ============================================================================
+// Entry Points
+// ============================================================================
+
+[numthreads(8, 8, 1)]
+void BuildShadingRateCS(uint3 dispatchThreadID : SV_DispatchThreadID)
+{
+    uint2 tile = dispatchThreadID.xy;
+    if (tile.x >= ImageWidth || tile.y >= ImageHeight)
+    {
+        return;
+    }
+
+    // Hi-Z texel (x, y) of mip k covers pixels [x, x + 1] << (k + 1), the same area as the tile;
+    // tiles past the viewport are never rasterized, so they just repeat the edge
+    uint2 lastTexel = (uint2(DepthWidth, DepthHeight) - 1) >> (HiZMip + 1);
+    float nearestDepth = HiZ.Load(int3(min(tile, lastTexel), HiZMip)).x;
+
+    // Nothing drawn under the tile yet: only the clear color (or sky) shows
+    if (nearestDepth >= 1.0f)
+    {
+        ShadingRateImage[tile] = CoarsestRate;
+        return;
+    }
+
+    float2 pixel = min((float2(tile) + 0.5f) * TileSize, float2(DepthWidth, DepthHeight));
+    float2 ndc = pixel / float2(DepthWidth, DepthHeight) * float2(2.0f, -2.0f) + float2(-1.0f, 1.0f);
+    float4 worldPos = mul(float4(ndc, nearestDepth, 1.0f), InvViewProjection);
+    float distToCamera = length(worldPos.xyz / worldPos.w - CameraPosition);
+    float fogFactor = saturate((distToCamera - FogStart) / (FogEnd - FogStart));
+
+    uint rate = SHADING_RATE_1X1;
+    if (fogFactor >= HeavyFogThreshold)
+    {
+        rate = CoarsestRate;
+    }
+    else if (fogFactor >= FogThreshold || distToCamera >= FarDistance)
+    {
+        rate = SHADING_RATE_2X2;
+    }
+
+    ShadingRateImage[tile] = rate;
+}
@@ -0,0 +1,122 @@
+/**
+ * @file TerrainTessellation.hlsl
+ * @brief Hardware-tessellated terrain: patch grid, hull and domain shaders
+ *
+ * Each chunk is drawn as a fixed grid of quad patches generated from
+ * SV_VertexID, with no vertex or index buffer. The hull shader picks edge
+ * factors from each edge's projected screen-space length, capped by the
+ * chunk's LOD, and the domain shader displaces the tessellated points by
+ * bilinearly sampling the chunk's heightfield. Shading matches
+ * TerrainVertex.hlsl, so TerrainPixel.hlsl is shared.
+ *
+ * The patch grid is the same for every chunk so patch edges line up across
+ * chunk borders; border edges take their cap from the LOD agreed with the
+ * neighbour, so both sides tessellate a shared edge identically.
+ */
+
+#include "TerrainVertex.hlsl"
+
+// ============================================================================
+// Patch Layout
+// ============================================================================
+
+// Must match TESSELLATION_PATCHES_PER_SIDE in TerrainRenderer.cpp
+static const uint PatchesPerSide = 4;
+static const uint PatchCells = ChunkSize / PatchesPerSide;     // Grid cells along a patch edge
+
+struct PatchControlPoint
+{
+    float2 Grid : GRID;                 // Chunk grid position of the corner
+};
+
+struct PatchConstants
+{
+    float EdgeFactors[4] : SV_TessFactor;        // -X, -Z, +X, +Z (quad domain order)
+    float InsideFactors[2] : SV_InsideTessFactor;
+};
+
+// ============================================================================
+// Vertex Shader
+// ============================================================================
+
+// Four control points per patch, corners ordered (0,0), (1,0), (0,1), (1,1)
+PatchControlPoint PatchVS(uint vertexID : SV_VertexID)
+{
+    uint patch = vertexID / 4;
+    uint corner = vertexID % 4;
+    uint2 patchCoord = uint2(patch % PatchesPerSide, patch / PatchesPerSide);
+
+    PatchControlPoint output;
+    output.Grid = float2((patchCoord + uint2(corner & 1, corner >> 1)) * PatchCells);
+    return output;
+}
+
+// ============================================================================
+// Hull Shader
+// ============================================================================
+
+// Segments for one edge. Heights are taken at a fixed reference plane, not
+// sampled, so the two chunks sharing a border compute exactly the same value.
+float EdgeTessFactor(float2 gridA, float2 gridB, uint drawStep, ChunkParams chunk)
+{
+    float referenceHeight = HeightScale * 0.5f;
+    float3 a = float3(chunk.ChunkOffset.x + gridA.x * VertexSpacing, referenceHeight, chunk.ChunkOffset.y + gridA.y * VertexSpacing);
+    float3 b = float3(chunk.ChunkOffset.x + gridB.x * VertexSpacing, referenceHeight, chunk.ChunkOffset.y + gridB.y * VertexSpacing);
+
+    // Projected length of the edge, treated as a sphere's diameter
+    float cameraDistance = max(length((a + b) * 0.5f - CameraPosition), 0.001f);
+    float segments = length(b - a) * TessellationScale / cameraDistance;
+
+    // The LOD caps detail: one segment per drawn grid step
+    float maxSegments = max((float)PatchCells / max(drawStep, 1u), 1.0f);
+    return clamp(segments, 1.0f, maxSegments);
+}
+
+PatchConstants PatchConstantsHS(InputPatch<PatchControlPoint, 4> patch)
+{
+    ChunkParams chunk = GetChunkParams();
+
+    // Drawn step per edge in EdgeFactors order; border edges use the step
+    // agreed with the neighbouring chunk
+    uint4 edgeStep = chunk.DrawStep;
+    edgeStep.x = patch[0].Grid.x == 0 ? chunk.EdgeStep.x : edgeStep.x;
+    edgeStep.y = patch[0].Grid.y == 0 ? chunk.EdgeStep.z : edgeStep.y;
+    edgeStep.z = patch[3].Grid.x == ChunkSize ? chunk.EdgeStep.y : edgeStep.z;
+    edgeStep.w = patch[3].Grid.y == ChunkSize ? chunk.EdgeStep.w : edgeStep.w;
+
+    PatchConstants output;
+    output.EdgeFactors[0] = EdgeTessFactor(patch[0].Grid, patch[2].Grid, edgeStep.x, chunk);
+    output.EdgeFactors[1] = EdgeTessFactor(patch[0].Grid, patch[1].Grid, edgeStep.y, chunk);
+    output.EdgeFactors[2] = EdgeTessFactor(patch[1].Grid, patch[3].Grid, edgeStep.z, chunk);
+    output.EdgeFactors[3] = EdgeTessFactor(patch[2].Grid, patch[3].Grid, edgeStep.w, chunk);
+    output.InsideFactors[0] = max(output.EdgeFactors[1], output.EdgeFactors[3]);
+    output.InsideFactors[1] = max(output.EdgeFactors[0], output.EdgeFactors[2]);
+    return output;
+}
+
+[domain("quad")]
+[partitioning("fractional_odd")]
+[outputtopology("triangle_cw")]
+[outputcontrolpoints(4)]
+[patchconstantfunc("PatchConstantsHS")]
+[maxtessfactor(64.0f)]
+PatchControlPoint PatchHS(InputPatch<PatchControlPoint, 4> patch, uint pointID : SV_OutputControlPointID)
+{
+    return patch[pointID];
+}
+
+// ============================================================================
+// Domain Shader
+// ============================================================================
+
+[domain("quad")]
+VS_OUTPUT PatchDS(PatchConstants constants, float2 uv : SV_DomainLocation,
+                  const OutputPatch<PatchControlPoint, 4> patch)
+{
+    ChunkParams chunk = GetChunkParams();
+
+    float2 grid = lerp(lerp(patch[0].Grid, patch[1].Grid, uv.x),
+                       lerp(patch[2].Grid, patch[3].Grid, uv.x), uv.y);
+
+    return ShadeTerrainVertex(SampleHeightfield(grid, chunk), chunk);
+}
@@ -2,10 +2,25 @@
  * @file TerrainVertex.hlsl
  * @brief Terrain vertex shader with height-based transformations
  *
- * Transforms terrain vertices and passes height/normal data
- * to the pixel shader for terrain-specific rendering.
+ * Decodes compressed terrain vertices (16-bit height, octahedral normal),
+ * rebuilds X/Z and UV from the vertex index within the chunk's LOD grid,
+ * geomorphs heights toward the next coarser LOD,
+ * derives the height/slope vertex color, and passes height/normal data to
+ * the pixel shader for terrain-specific rendering.
  */
 
+// ============================================================================
+// Permutations (built offline for every combination, see CMakeLists.txt)
+// ============================================================================
+
+#ifndef TERRAIN_FOG
+#define TERRAIN_FOG 1           // Distance fog factor
+#endif
+
+#ifndef TERRAIN_GEOMORPH
+#define TERRAIN_GEOMORPH 1      // Blend heights toward the next coarser LOD
+#endif
+
 // ============================================================================
 // Constant Buffers
 // ============================================================================
@@ -21,7 +36,8 @@ cbuffer PerFrame : register(b0)
     float4 FogColor;
     float FogStart;
     float FogEnd;
-    float2 Padding;
+    float MeshletCullDistance;
+    float TessellationScale;
 };
 
 // Per-chunk constants (b1)
@@ -32,19 +48,51 @@ cbuffer PerChunk : register(b1)
     float TextureScale;
     float MinHeight;
     float MaxHeight;
-    float3 ChunkPadding;
+    uint LODStep;                   // Grid step the mesh was built with
+    uint DrawStep;                  // Grid step being drawn
+    float MorphFactor;              // Interior blend toward the grid twice as coarse
+    uint4 EdgeStep;                 // Drawn grid step of border vertices (-X, +X, -Z, +Z)
+    float4 EdgeMorph;               // Morph factor of border vertices
 };
 
+// Per-chunk data for indirect drawing (t0), same layout as PerChunk
+struct ChunkInstance
+{
+    float4x4 World;
+    float2 ChunkOffset;
+    float TextureScale;
+    float MinHeight;
+    float MaxHeight;
+    uint LODStep;
+    uint DrawStep;
+    float MorphFactor;
+    uint4 EdgeStep;
+    float4 EdgeMorph;
+};
+
+StructuredBuffer<ChunkInstance> ChunkInstances : register(t0);
+
+// Index into ChunkInstances, written per draw by ExecuteIndirect (b2)
+cbuffer IndirectDraw : register(b2)
+{
+    uint ChunkIndex;
+};
+
+// The chunk's TerrainVertex array, for paths without an input assembler (t1):
+// 8 bytes each, row-major over the chunk's LOD grid
+ByteAddressBuffer Heightfield : register(t1);
+
 // ============================================================================
 // Input/Output Structures
 // ============================================================================
 
+// Must match PCG::TerrainVertex
 struct VS_INPUT
 {
-    float3 Position : POSITION;
-    float3 Normal   : NORMAL;
-    float2 TexCoord : TEXCOORD;
-    float4 Color    : COLOR;
+    float Height    : HEIGHT;       // R16_UNORM, [0, 1] between MinHeight and MaxHeight
+    float MorphHeight : HEIGHT1;    // R16_UNORM, next coarser grid's surface at this vertex
+    float2 Normal   : NORMAL;       // R16G16_SNORM, octahedral-encoded
+    uint VertexID   : SV_VertexID;  // Row-major index in the LOD grid
 };
 
 struct VS_OUTPUT
@@ -59,56 +107,306 @@ struct VS_OUTPUT
 };
 
 // ============================================================================
-// Main Vertex Shader
+// Vertex Decoding
 // ============================================================================
 
-VS_OUTPUT main(VS_INPUT input)
+// Must match Chunk::SIZE and Chunk::SCALE
+static const uint ChunkSize = 32;
+static const float VertexSpacing = 1.0f;
+
+// Per-chunk parameters needed to decode a vertex
+struct ChunkParams
 {
-    VS_OUTPUT output;
+    float2 ChunkOffset;
+    float TextureScale;
+    float MinHeight;
+    float MaxHeight;
+    uint LODStep;
+    uint DrawStep;
+    float MorphFactor;
+    uint4 EdgeStep;
+    float4 EdgeMorph;
+};
 
-    // The vertex position is already in world space from chunk generation
-    float4 worldPos = float4(input.Position, 1.0f);
-    output.WorldPosition = worldPos.xyz;
+// Decoded terrain vertex
+struct TerrainVertex
+{
+    float3 Position;    // World space
+    float3 Normal;      // World space, unit length
+    float2 TexCoord;    // [0, 1] across the chunk
+    float Height;       // Normalized height [0, 1]
+};
 
-    // Transform to clip space
-    output.Position = mul(worldPos, ViewProjection);
+ChunkParams GetChunkParams()
+{
+    ChunkParams params;
+    params.ChunkOffset = ChunkOffset;
+    params.TextureScale = TextureScale;
+    params.MinHeight = MinHeight;
+    params.MaxHeight = MaxHeight;
+    params.LODStep = LODStep;
+    params.DrawStep = DrawStep;
+    params.MorphFactor = MorphFactor;
+    params.EdgeStep = EdgeStep;
+    params.EdgeMorph = EdgeMorph;
+    return params;
+}
+
+ChunkParams GetChunkParams(ChunkInstance chunk)
+{
+    ChunkParams params;
+    params.ChunkOffset = chunk.ChunkOffset;
+    params.TextureScale = chunk.TextureScale;
+    params.MinHeight = chunk.MinHeight;
+    params.MaxHeight = chunk.MaxHeight;
+    params.LODStep = chunk.LODStep;
+    params.DrawStep = chunk.DrawStep;
+    params.MorphFactor = chunk.MorphFactor;
+    params.EdgeStep = chunk.EdgeStep;
+    params.EdgeMorph = chunk.EdgeMorph;
+    return params;
+}
+
+// Inverse of EncodeOctahedralNormal in Chunk.cpp (+Y is the upper hemisphere)
+float3 DecodeOctahedralNormal(float2 encoded)
+{
+    float3 n = float3(encoded.x, 1.0f - abs(encoded.x) - abs(encoded.y), encoded.y);
+    float fold = saturate(-n.y);
+    n.x += n.x >= 0.0f ? -fold : fold;
+    n.z += n.z >= 0.0f ? -fold : fold;
+    return normalize(n);
+}
+
+// Blend a vertex toward the next coarser LOD; at 1 the surface matches that LOD exactly
+float GeomorphHeight(VS_INPUT input, uint2 grid, ChunkParams chunk)
+{
+#if TERRAIN_GEOMORPH
+    // Border vertices use the step and morph agreed with the neighbouring chunk
+    uint drawStep = chunk.DrawStep;
+    float morph = chunk.MorphFactor;
+    if (grid.x == 0)
+    {
+        drawStep = chunk.EdgeStep.x;
+        morph = chunk.EdgeMorph.x;
+    }
+    else if (grid.x == ChunkSize)
+    {
+        drawStep = chunk.EdgeStep.y;
+        morph = chunk.EdgeMorph.y;
+    }
+    else if (grid.y == 0)
+    {
+        drawStep = chunk.EdgeStep.z;
+        morph = chunk.EdgeMorph.z;
+    }
+    else if (grid.y == ChunkSize)
+    {
+        drawStep = chunk.EdgeStep.w;
+        morph = chunk.EdgeMorph.w;
+    }
+
+    // Vertices shared with the coarser grid stay put
+    uint coarseStep = max(drawStep, 1u) * 2;
+    bool onCoarseGrid = (grid.x % coarseStep) == 0 && (grid.y % coarseStep) == 0;
+
+    return onCoarseGrid ? input.Height : lerp(input.Height, input.MorphHeight, morph);
+#else
+    return input.Height;
+#endif
+}
+
+// Distance fog blend factor (0 = no fog)
+float CalculateFogFactor(float3 worldPos)
+{
+#if TERRAIN_FOG
+    float distToCamera = length(CameraPosition - worldPos);
+    return saturate((distToCamera - FogStart) / (FogEnd - FogStart));
+#else
+    return 0.0f;
+#endif
+}
+
+TerrainVertex DecodeTerrainVertex(VS_INPUT input, ChunkParams chunk)
+{
+    TerrainVertex vertex;
 
-    // Normal is already in world space
-    output.WorldNormal = normalize(input.Normal);
+    // Vertices are stored row-major by Z over the LOD grid
+    uint lodStep = max(chunk.LODStep, 1u);
+    uint verticesPerSide = ChunkSize / lodStep + 1;
+    uint2 grid = uint2(input.VertexID % verticesPerSide, input.VertexID / verticesPerSide) * lodStep;
 
-    // Pass through texture coordinates (scaled for tiling)
-    output.TexCoord = input.TexCoord * TextureScale;
+    float height = GeomorphHeight(input, grid, chunk);
 
-    // Pass through vertex color (contains height-based coloring from CPU)
-    output.VertexColor = input.Color;
+    vertex.Position = float3(
+        chunk.ChunkOffset.x + grid.x * VertexSpacing,
+        lerp(chunk.MinHeight, chunk.MaxHeight, height),
+        chunk.ChunkOffset.y + grid.y * VertexSpacing);
 
-    // Calculate normalized height for shader use
-    float heightRange = MaxHeight - MinHeight;
-    if (heightRange > 0.001f)
+    vertex.Normal = DecodeOctahedralNormal(input.Normal);
+    vertex.TexCoord = float2(grid) / ChunkSize;
+
+    // Flat chunks sit mid-range, as the CPU color ramp expects
+    vertex.Height = (chunk.MaxHeight - chunk.MinHeight) > 0.001f ? height : 0.5f;
+
+    return vertex;
+}
+
+// Height/slope color ramp (formerly computed per vertex on the CPU)
+float4 CalculateVertexColor(float height, float3 normal)
+{
+    static const float3 DeepWater = float3(0.05f, 0.1f, 0.3f);
+    static const float3 ShallowWater = float3(0.1f, 0.3f, 0.5f);
+    static const float3 Sand = float3(0.76f, 0.70f, 0.50f);
+    static const float3 Grass = float3(0.2f, 0.5f, 0.15f);
+    static const float3 Rock = float3(0.5f, 0.5f, 0.5f);
+    static const float3 Snow = float3(0.95f, 0.95f, 0.98f);
+
+    static const float WaterLevel = 0.2f;
+    static const float SandLevel = 0.25f;
+    static const float GrassLevel = 0.6f;
+    static const float RockLevel = 0.8f;
+
+    // 0 = flat, 1 = vertical
+    float slope = 1.0f - normal.y;
+
+    float3 color;
+    if (height < WaterLevel)
+    {
+        color = lerp(DeepWater, ShallowWater, height / WaterLevel);
+    }
+    else if (height < SandLevel)
+    {
+        color = lerp(ShallowWater, Sand, (height - WaterLevel) / (SandLevel - WaterLevel));
+    }
+    else if (height < GrassLevel)
+    {
+        color = lerp(Sand, Grass, (height - SandLevel) / (GrassLevel - SandLevel));
+
+        // Blend with rock on steep slopes
+        color = lerp(color, Rock, saturate((slope - 0.3f) / 0.4f));
+    }
+    else if (height < RockLevel)
     {
-        output.Height = saturate((input.Position.y - MinHeight) / heightRange);
+        color = lerp(Grass, Rock, (height - GrassLevel) / (RockLevel - GrassLevel));
     }
     else
     {
-        output.Height = 0.5f;
+        color = lerp(Rock, Snow, (height - RockLevel) / (1.0f - RockLevel));
     }
 
+    return float4(color, 1.0f);
+}
+
+// ============================================================================
+// Heightfield Access
+// ============================================================================
+
+// Read the vertex at a chunk grid position, as the input assembler would supply it
+VS_INPUT LoadHeightfieldVertex(uint2 grid, ChunkParams chunk)
+{
+    uint lodStep = max(chunk.LODStep, 1u);
+    uint verticesPerSide = ChunkSize / lodStep + 1;
+    uint vertexIndex = (grid.y / lodStep) * verticesPerSide + grid.x / lodStep;
+
+    // Height and MorphHeight (UNORM16), then the two SNORM16 normal components
+    uint2 packed = Heightfield.Load2(vertexIndex * 8);
+
+    VS_INPUT input;
+    input.Height = (packed.x & 0xFFFF) / 65535.0f;
+    input.MorphHeight = (packed.x >> 16) / 65535.0f;
+    input.Normal = max(float2(int(packed.y << 16) >> 16, int(packed.y) >> 16) / 32767.0f, -1.0f);
+    input.VertexID = vertexIndex;
+    return input;
+}
+
+// Bilinearly sample the heightfield anywhere in the chunk (no geomorph)
+TerrainVertex SampleHeightfield(float2 grid, ChunkParams chunk)
+{
+    uint lodStep = max(chunk.LODStep, 1u);
+    float2 cell = clamp(grid / lodStep, 0.0f, (float)(ChunkSize / lodStep));
+    uint2 base = min((uint2)cell, ChunkSize / lodStep - 1);
+    float2 t = cell - base;
+
+    VS_INPUT v00 = LoadHeightfieldVertex((base + uint2(0, 0)) * lodStep, chunk);
+    VS_INPUT v10 = LoadHeightfieldVertex((base + uint2(1, 0)) * lodStep, chunk);
+    VS_INPUT v01 = LoadHeightfieldVertex((base + uint2(0, 1)) * lodStep, chunk);
+    VS_INPUT v11 = LoadHeightfieldVertex((base + uint2(1, 1)) * lodStep, chunk);
+
+    float height = lerp(lerp(v00.Height, v10.Height, t.x), lerp(v01.Height, v11.Height, t.x), t.y);
+    float3 normal = lerp(
+        lerp(DecodeOctahedralNormal(v00.Normal), DecodeOctahedralNormal(v10.Normal), t.x),
+        lerp(DecodeOctahedralNormal(v01.Normal), DecodeOctahedralNormal(v11.Normal), t.x), t.y);
+
+    TerrainVertex vertex;
+    vertex.Position = float3(
+        chunk.ChunkOffset.x + grid.x * VertexSpacing,
+        lerp(chunk.MinHeight, chunk.MaxHeight, height),
+        chunk.ChunkOffset.y + grid.y * VertexSpacing);
+    vertex.Normal = normalize(normal);
+    vertex.TexCoord = grid / ChunkSize;
+    vertex.Height = (chunk.MaxHeight - chunk.MinHeight) > 0.001f ? height : 0.5f;
+    return vertex;
+}
+
+// ============================================================================
+// Main Vertex Shader
+// ============================================================================
+
+// Project a decoded vertex and derive everything the pixel shader needs
+VS_OUTPUT ShadeTerrainVertex(TerrainVertex vertex, ChunkParams chunk)
+{
+    VS_OUTPUT output;
+
+    float4 worldPos = float4(vertex.Position, 1.0f);
+    output.WorldPosition = worldPos.xyz;
+
+    // Transform to clip space; precise so the depth pre-pass (DepthOnlyVS)
+    // produces bit-identical depth and the LESS_EQUAL color test passes
+    precise float4 clipPosition = mul(worldPos, ViewProjection);
+    output.Position = clipPosition;
+
+    output.WorldNormal = vertex.Normal;
+
+    // Texture coordinates (scaled for tiling)
+    output.TexCoord = vertex.TexCoord * chunk.TextureScale;
+
+    // Height-based coloring
+    output.VertexColor = CalculateVertexColor(vertex.Height, vertex.Normal);
+    output.Height = vertex.Height;
+
     // Calculate fog factor based on distance from camera
-    float distToCamera = length(CameraPosition - worldPos.xyz);
-    output.FogFactor = saturate((distToCamera - FogStart) / (FogEnd - FogStart));
+    output.FogFactor = CalculateFogFactor(worldPos.xyz);
 
     return output;
 }
 
+VS_OUTPUT TransformTerrainVertex(VS_INPUT input, ChunkParams chunk)
+{
+    return ShadeTerrainVertex(DecodeTerrainVertex(input, chunk), chunk);
+}
+
+VS_OUTPUT main(VS_INPUT input)
+{
+    return TransformTerrainVertex(input, GetChunkParams());
+}
+
+// Indirect draw: per-chunk constants come from ChunkInstances[ChunkIndex]
+VS_OUTPUT IndirectVS(VS_INPUT input)
+{
+    return TransformTerrainVertex(input, GetChunkParams(ChunkInstances[ChunkIndex]));
+}
+
 // ============================================================================
 // Alternative Entry Points
 // ============================================================================
 
-// Simple depth-only vertex shader (for shadow mapping)
+// Depth-only vertex shader (shadow maps and the depth pre-pass); must
+// transform exactly like ShadeTerrainVertex
 float4 DepthOnlyVS(VS_INPUT input) : SV_POSITION
 {
-    float4 worldPos = float4(input.Position, 1.0f);
-    return mul(worldPos, ViewProjection);
+    TerrainVertex vertex = DecodeTerrainVertex(input, GetChunkParams());
+    precise float4 clipPosition = mul(float4(vertex.Position, 1.0f), ViewProjection);
+    return clipPosition;
 }
 
 // Vertex shader with wind animation (for grass/vegetation on terrain)
@@ -116,13 +414,16 @@ VS_OUTPUT WindAnimatedVS(VS_INPUT input)
 {
     VS_OUTPUT output;
 
+    ChunkParams chunk = GetChunkParams();
+    TerrainVertex vertex = DecodeTerrainVertex(input, chunk);
+
     // Base world position
-    float4 worldPos = float4(input.Position, 1.0f);
+    float4 worldPos = float4(vertex.Position, 1.0f);
 
     // Simple wind animation based on height and time
     float windStrength = 0.1f;
     float windFrequency = 2.0f;
-    float heightFactor = saturate((input.Position.y - MinHeight) / max(MaxHeight - MinHeight, 0.001f));
+    float heightFactor = input.Height;
 
     // Wind offset (only affects vertices above a certain height)
     float windOffset = sin(Time * windFrequency + worldPos.x * 0.5f + worldPos.z * 0.3f) * windStrength;
@@ -131,15 +432,12 @@ VS_OUTPUT WindAnimatedVS(VS_INPUT input)
 
     output.WorldPosition = worldPos.xyz;
     output.Position = mul(worldPos, ViewProjection);
-    output.WorldNormal = normalize(input.Normal);
-    output.TexCoord = input.TexCoord * TextureScale;
-    output.VertexColor = input.Color;
-
-    float heightRange = MaxHeight - MinHeight;
-    output.Height = heightRange > 0.001f ? saturate((input.Position.y - MinHeight) / heightRange) : 0.5f;
+    output.WorldNormal = vertex.Normal;
+    output.TexCoord = vertex.TexCoord * chunk.TextureScale;
+    output.VertexColor = CalculateVertexColor(vertex.Height, vertex.Normal);
+    output.Height = vertex.Height;
 
-    float distToCamera = length(CameraPosition - worldPos.xyz);
-    output.FogFactor = saturate((distToCamera - FogStart) / (FogEnd - FogStart));
+    output.FogFactor = CalculateFogFactor(worldPos.xyz);
 
     return output;
 }
@@ -0,0 +1,50 @@
+/**
+ * @file Upscale.hlsl
+ * @brief Bilinear upscale of the dynamic-resolution scene target (DynamicResolution)
+ *
+ * The scene is rendered into the top-left RenderWidth x RenderHeight region
+ * of a larger target. One fullscreen triangle maps that region onto the back
+ * buffer; samples are clamped half a texel inside it so bilinear filtering
+ * never reads stale pixels from outside the rendered area.
+ */
+
+// ============================================================================
+// Resources
+// ============================================================================
+
+// Root constants (b0)
+cbuffer UpscaleConstants : register(b0)
+{
+    float2 UVScale;     // Rendered region / target size
+    float2 UVClamp;     // Last sampleable UV inside the region
+};
+
+Texture2D<float4> SceneColor : register(t0);
+SamplerState LinearClamp : register(s0);
+
+struct VSOutput
+{
+    float4 Position : SV_POSITION;
+    float2 UV : TEXCOORD0;
+};
+
+// ============================================================================
+// Entry Points
+// ============================================================================
+
+VSOutput FullscreenVS(uint vertexID : SV_VertexID)
+{
+    // Vertices (0,0), (2,0), (0,2) in UV cover the screen with one triangle
+    float2 uv = float2((vertexID << 1) & 2, vertexID & 2);
+
+    VSOutput output;
+    output.Position = float4(uv * float2(2.0f, -2.0f) + float2(-1.0f, 1.0f), 0.0f, 1.0f);
+    output.UV = uv;
+    return output;
+}
+
+float4 UpscalePS(VSOutput input) : SV_TARGET
+{
+    float2 uv = min(input.UV * UVScale, UVClamp);
+    return float4(SceneColor.SampleLevel(LinearClamp, uv, 0.0f).rgb, 1.0f);
+}
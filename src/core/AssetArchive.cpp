@@ -0,0 +1,412 @@
+#include "core/AssetArchive.h"
+#include "core/Compression.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace SM
+{
+    namespace
+    {
+        constexpr uint64_t FNV_OFFSET = 14695981039346656037ull;
+        constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+        constexpr uint64_t BLOCK_ALIGNMENT = 16;
+        constexpr uint64_t TABLE_ALIGNMENT = 8;
+
+        uint64_t AlignUp(uint64_t value, uint64_t alignment)
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        void WritePadding(std::ofstream& file, uint64_t& offset, uint64_t alignment)
+        {
+            static const char zeros[BLOCK_ALIGNMENT] = {};
+            uint64_t aligned = AlignUp(offset, alignment);
+            file.write(zeros, static_cast<std::streamsize>(aligned - offset));
+            offset = aligned;
+        }
+
+        template<typename T>
+        void WriteArray(std::ofstream& file, uint64_t& offset, const std::vector<T>& values)
+        {
+            file.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+            offset += values.size() * sizeof(T);
+        }
+    }
+
+    // ============================================================================
+    // AssetArchive
+    // ============================================================================
+
+    bool AssetArchive::Open(const std::string& path)
+    {
+        Close();
+
+        if (!m_File.Open(path))
+        {
+            return false;
+        }
+
+        const uint8_t* base = m_File.GetData();
+        const uint64_t fileSize = m_File.GetSize();
+
+        auto fail = [this, &path](const char* reason) {
+            std::cerr << "[AssetArchive] " << path << ": " << reason << std::endl;
+            Close();
+            return false;
+        };
+
+        if (fileSize < sizeof(ArchiveHeader))
+        {
+            return fail("file too small");
+        }
+
+        std::memcpy(&m_Header, base, sizeof(ArchiveHeader));
+        if (m_Header.Magic != ARCHIVE_MAGIC || m_Header.Version != ARCHIVE_VERSION || m_Header.BlockSize != BLOCK_SIZE)
+        {
+            return fail("not a supported archive");
+        }
+
+        auto tableFits = [fileSize](uint64_t offset, uint64_t size) {
+            return offset % TABLE_ALIGNMENT == 0 && offset <= fileSize && size <= fileSize - offset;
+        };
+
+        if (!tableFits(m_Header.BlockTableOffset, uint64_t(m_Header.BlockCount) * sizeof(ArchiveBlock)) ||
+            !tableFits(m_Header.EntryTableOffset, uint64_t(m_Header.EntryCount) * sizeof(ArchiveEntry)) ||
+            m_Header.PathsOffset > fileSize || m_Header.PathsSize > fileSize - m_Header.PathsOffset)
+        {
+            return fail("truncated tables");
+        }
+
+        m_Blocks = reinterpret_cast<const ArchiveBlock*>(base + m_Header.BlockTableOffset);
+        m_Entries = reinterpret_cast<const ArchiveEntry*>(base + m_Header.EntryTableOffset);
+        m_Paths = reinterpret_cast<const char*>(base + m_Header.PathsOffset);
+
+        // Validate once so reads never need to bounds-check the tables again
+        for (uint32_t i = 0; i < m_Header.BlockCount; ++i)
+        {
+            const ArchiveBlock& block = m_Blocks[i];
+            if (block.Offset > fileSize || block.CompressedSize > fileSize - block.Offset)
+            {
+                return fail("block out of bounds");
+            }
+        }
+
+        for (uint32_t i = 0; i < m_Header.EntryCount; ++i)
+        {
+            const ArchiveEntry& entry = m_Entries[i];
+            uint64_t expectedBlocks = (entry.Size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+            if (entry.BlockCount != expectedBlocks ||
+                uint64_t(entry.FirstBlock) + entry.BlockCount > m_Header.BlockCount ||
+                uint64_t(entry.PathOffset) + entry.PathLength > m_Header.PathsSize ||
+                (i > 0 && entry.PathHash < m_Entries[i - 1].PathHash))
+            {
+                return fail("corrupt entry table");
+            }
+        }
+
+        m_Path = path;
+        return true;
+    }
+
+    void AssetArchive::Close()
+    {
+        m_File.Close();
+        m_Path.clear();
+        m_Header = ArchiveHeader();
+        m_Blocks = nullptr;
+        m_Entries = nullptr;
+        m_Paths = nullptr;
+    }
+
+    const ArchiveEntry* AssetArchive::Find(std::string_view path) const
+    {
+        if (!IsOpen())
+        {
+            return nullptr;
+        }
+
+        std::string normalized = NormalizePath(path);
+        uint64_t hash = HashPath(normalized);
+
+        const ArchiveEntry* end = m_Entries + m_Header.EntryCount;
+        const ArchiveEntry* it = std::lower_bound(m_Entries, end, hash,
+            [](const ArchiveEntry& entry, uint64_t value) { return entry.PathHash < value; });
+
+        for (; it != end && it->PathHash == hash; ++it)
+        {
+            if (GetEntryPath(*it) == normalized)
+            {
+                return it;
+            }
+        }
+
+        return nullptr;
+    }
+
+    std::string_view AssetArchive::GetEntryPath(const ArchiveEntry& entry) const
+    {
+        return std::string_view(m_Paths + entry.PathOffset, entry.PathLength);
+    }
+
+    bool AssetArchive::Read(const ArchiveEntry& entry, std::vector<uint8_t>& outData) const
+    {
+        outData.resize(static_cast<size_t>(entry.Size));
+        if (!ReadRange(entry, 0, outData.size(), outData.data()))
+        {
+            outData.clear();
+            return false;
+        }
+        return true;
+    }
+
+    bool AssetArchive::ReadRange(const ArchiveEntry& entry, uint64_t offset, size_t size, void* dst) const
+    {
+        if (!IsOpen() || offset > entry.Size || size > entry.Size - offset)
+        {
+            return false;
+        }
+
+        uint8_t* out = static_cast<uint8_t*>(dst);
+        std::vector<uint8_t> partial;
+
+        uint64_t end = offset + size;
+        while (offset < end)
+        {
+            uint64_t blockIndex = offset / BLOCK_SIZE;
+            uint64_t blockStart = blockIndex * BLOCK_SIZE;
+            size_t blockBytes = static_cast<size_t>(std::min<uint64_t>(BLOCK_SIZE, entry.Size - blockStart));
+            const ArchiveBlock& block = m_Blocks[entry.FirstBlock + blockIndex];
+
+            size_t skip = static_cast<size_t>(offset - blockStart);
+            size_t take = static_cast<size_t>(std::min<uint64_t>(blockBytes - skip, end - offset));
+
+            if (skip == 0 && take == blockBytes)
+            {
+                // Whole block: decode in place
+                if (!DecodeBlock(block, blockBytes, out))
+                {
+                    return false;
+                }
+            }
+            else
+            {
+                partial.resize(blockBytes);
+                if (!DecodeBlock(block, blockBytes, partial.data()))
+                {
+                    return false;
+                }
+                std::memcpy(out, partial.data() + skip, take);
+            }
+
+            out += take;
+            offset += take;
+        }
+
+        return true;
+    }
+
+    bool AssetArchive::DecodeBlock(const ArchiveBlock& block, size_t uncompressedSize, uint8_t* dst) const
+    {
+        const uint8_t* src = m_File.GetData() + block.Offset;
+
+        if (block.Flags & ARCHIVE_BLOCK_STORED)
+        {
+            if (block.CompressedSize != uncompressedSize)
+            {
+                return false;
+            }
+            std::memcpy(dst, src, uncompressedSize);
+            return true;
+        }
+
+        return Compression::DecompressLZ4(src, block.CompressedSize, dst, uncompressedSize);
+    }
+
+    std::string AssetArchive::NormalizePath(std::string_view path)
+    {
+        std::string result(path);
+        for (char& c : result)
+        {
+            if (c == '\\')
+            {
+                c = '/';
+            }
+            else if (c >= 'A' && c <= 'Z')
+            {
+                c = static_cast<char>(c - 'A' + 'a');
+            }
+        }
+
+        // Drop leading "./" and "/" so "./textures/a.png" and "textures/a.png" match
+        size_t start = 0;
+        while (start < result.size())
+        {
+            if (result[start] == '/')
+            {
+                ++start;
+            }
+            else if (result.compare(start, 2, "./") == 0)
+            {
+                start += 2;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        return result.substr(start);
+    }
+
+    uint64_t AssetArchive::HashPath(std::string_view normalizedPath)
+    {
+        uint64_t hash = FNV_OFFSET;
+        for (char c : normalizedPath)
+        {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= FNV_PRIME;
+        }
+        return hash;
+    }
+
+    // ============================================================================
+    // AssetArchiveWriter
+    // ============================================================================
+
+    void AssetArchiveWriter::AddFile(const std::string& filePath, const std::string& archivePath)
+    {
+        m_Files.push_back({ filePath, AssetArchive::NormalizePath(archivePath) });
+    }
+
+    size_t AssetArchiveWriter::AddDirectory(const std::string& directory)
+    {
+        size_t added = 0;
+        for (const std::string& file : FileSystem::GetFilesInDirectory(directory, "", true))
+        {
+            AddFile(file, FileSystem::GetRelativePath(directory, file));
+            ++added;
+        }
+        return added;
+    }
+
+    bool AssetArchiveWriter::Write(const std::string& archivePath, std::string* outError) const
+    {
+        auto fail = [outError](const std::string& message) {
+            if (outError)
+            {
+                *outError = message;
+            }
+            return false;
+        };
+
+        // Sorted up front so the entry table is written in lookup order
+        std::vector<const PendingFile*> files;
+        files.reserve(m_Files.size());
+        for (const PendingFile& file : m_Files)
+        {
+            files.push_back(&file);
+        }
+        std::sort(files.begin(), files.end(), [](const PendingFile* a, const PendingFile* b) {
+            uint64_t hashA = AssetArchive::HashPath(a->ArchivePath);
+            uint64_t hashB = AssetArchive::HashPath(b->ArchivePath);
+            return hashA != hashB ? hashA < hashB : a->ArchivePath < b->ArchivePath;
+        });
+
+        for (size_t i = 1; i < files.size(); ++i)
+        {
+            if (files[i]->ArchivePath == files[i - 1]->ArchivePath)
+            {
+                return fail("Duplicate archive path: " + files[i]->ArchivePath);
+            }
+        }
+
+        std::ofstream out(archivePath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open())
+        {
+            return fail("Failed to create archive: " + archivePath);
+        }
+
+        ArchiveHeader header;
+        header.BlockSize = AssetArchive::BLOCK_SIZE;
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        uint64_t offset = sizeof(header);
+
+        std::vector<ArchiveBlock> blocks;
+        std::vector<ArchiveEntry> entries;
+        std::string paths;
+        std::vector<uint8_t> compressed;
+
+        for (const PendingFile* file : files)
+        {
+            // Empty files cannot be mapped but are valid entries
+            MappedFile mapping = FileSystem::MapFile(file->FilePath);
+            if (!mapping.IsOpen() && (!FileSystem::FileExists(file->FilePath) || FileSystem::GetFileSize(file->FilePath) != 0))
+            {
+                return fail("Failed to read: " + file->FilePath);
+            }
+
+            ArchiveEntry& entry = entries.emplace_back();
+            entry.PathHash = AssetArchive::HashPath(file->ArchivePath);
+            entry.PathOffset = static_cast<uint32_t>(paths.size());
+            entry.PathLength = static_cast<uint32_t>(file->ArchivePath.size());
+            entry.Size = mapping.GetSize();
+            entry.FirstBlock = static_cast<uint32_t>(blocks.size());
+            paths += file->ArchivePath;
+
+            for (size_t blockStart = 0; blockStart < mapping.GetSize(); blockStart += AssetArchive::BLOCK_SIZE)
+            {
+                const uint8_t* src = mapping.GetData() + blockStart;
+                size_t blockBytes = std::min<size_t>(AssetArchive::BLOCK_SIZE, mapping.GetSize() - blockStart);
+
+                Compression::CompressLZ4(src, blockBytes, compressed);
+
+                WritePadding(out, offset, BLOCK_ALIGNMENT);
+                ArchiveBlock& block = blocks.emplace_back();
+                block.Offset = offset;
+
+                // Incompressible data (already-compressed textures, audio) is stored
+                if (compressed.size() >= blockBytes)
+                {
+                    block.Flags = ARCHIVE_BLOCK_STORED;
+                    block.CompressedSize = static_cast<uint32_t>(blockBytes);
+                    out.write(reinterpret_cast<const char*>(src), static_cast<std::streamsize>(blockBytes));
+                }
+                else
+                {
+                    block.CompressedSize = static_cast<uint32_t>(compressed.size());
+                    out.write(reinterpret_cast<const char*>(compressed.data()), static_cast<std::streamsize>(compressed.size()));
+                }
+                offset += block.CompressedSize;
+            }
+
+            entry.BlockCount = static_cast<uint32_t>(blocks.size()) - entry.FirstBlock;
+        }
+
+        WritePadding(out, offset, TABLE_ALIGNMENT);
+        header.BlockTableOffset = offset;
+        header.BlockCount = static_cast<uint32_t>(blocks.size());
+        WriteArray(out, offset, blocks);
+
+        header.EntryTableOffset = offset;
+        header.EntryCount = static_cast<uint32_t>(entries.size());
+        WriteArray(out, offset, entries);
+
+        header.PathsOffset = offset;
+        header.PathsSize = paths.size();
+        out.write(paths.data(), static_cast<std::streamsize>(paths.size()));
+
+        out.seekp(0);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        if (!out.good())
+        {
+            return fail("Failed to write archive: " + archivePath);
+        }
+        return true;
+    }
+
+} // namespace SM
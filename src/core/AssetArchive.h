@@ -0,0 +1,218 @@
+#pragma once
+
+/**
+ * @file AssetArchive.h
+ * @brief Shattered Moon Engine - Packed Asset Archives
+ *
+ * A .smpak archive stores many assets in one file so a cold start opens
+ * (and maps) a single file instead of one per asset. Layout:
+ *
+ *   ArchiveHeader
+ *   compressed blocks (each 16-byte aligned)
+ *   ArchiveBlock[BlockCount]
+ *   ArchiveEntry[EntryCount]  sorted by (PathHash, path)
+ *   path strings
+ *
+ * Each asset is split into BLOCK_SIZE (64 KB) blocks at 64 KB-aligned
+ * offsets of its data, and every block is LZ4-compressed on its own (or
+ * stored when that does not help), so a byte range decodes only the blocks
+ * it overlaps. Paths are normalized (forward slashes, lower case) before
+ * hashing, matching Windows' case-insensitive lookups.
+ */
+
+#include "core/FileSystem.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SM
+{
+    // ============================================================================
+    // On-disk Format
+    // ============================================================================
+
+    constexpr uint32_t ARCHIVE_MAGIC = 0x4B504D53;     ///< "SMPK"
+    constexpr uint32_t ARCHIVE_VERSION = 1;
+
+    struct ArchiveHeader
+    {
+        uint32_t Magic = ARCHIVE_MAGIC;
+        uint32_t Version = ARCHIVE_VERSION;
+        uint32_t EntryCount = 0;
+        uint32_t BlockCount = 0;
+        uint32_t BlockSize = 0;             ///< Uncompressed bytes per block
+        uint32_t Reserved = 0;
+        uint64_t BlockTableOffset = 0;
+        uint64_t EntryTableOffset = 0;
+        uint64_t PathsOffset = 0;
+        uint64_t PathsSize = 0;
+    };
+
+    struct ArchiveBlock
+    {
+        uint64_t Offset = 0;                ///< Byte offset of the block in the archive
+        uint32_t CompressedSize = 0;        ///< Stored size in bytes
+        uint32_t Flags = 0;                 ///< ARCHIVE_BLOCK_STORED
+    };
+
+    constexpr uint32_t ARCHIVE_BLOCK_STORED = 1u << 0;  ///< Block holds raw bytes
+
+    struct ArchiveEntry
+    {
+        uint64_t PathHash = 0;
+        uint32_t PathOffset = 0;            ///< Into the path strings
+        uint32_t PathLength = 0;
+        uint64_t Size = 0;                  ///< Uncompressed asset size
+        uint32_t FirstBlock = 0;
+        uint32_t BlockCount = 0;
+    };
+
+    // ============================================================================
+    // AssetArchive
+    // ============================================================================
+
+    /**
+     * @brief Read-only view of a mounted archive
+     *
+     * The archive file stays memory-mapped while open. Lookups and reads
+     * only touch the mapping, so they are safe from any number of threads.
+     */
+    class AssetArchive
+    {
+    public:
+        static constexpr uint32_t BLOCK_SIZE = 64 * 1024;
+
+        AssetArchive() = default;
+
+        // Prevent copying
+        AssetArchive(const AssetArchive&) = delete;
+        AssetArchive& operator=(const AssetArchive&) = delete;
+
+        /**
+         * @brief Map an archive and validate its tables
+         * @param path Archive file path
+         * @return false if the file is missing, not an archive or truncated
+         */
+        bool Open(const std::string& path);
+
+        /**
+         * @brief Unmap the archive
+         */
+        void Close();
+
+        bool IsOpen() const { return m_File.IsOpen(); }
+        const std::string& GetPath() const { return m_Path; }
+        uint32_t GetEntryCount() const { return m_Header.EntryCount; }
+
+        /**
+         * @brief Find an asset by path (binary search on the hash)
+         * @param path Asset path relative to the archive root, any separators or case
+         * @return Entry, nullptr if the archive does not contain the path
+         */
+        const ArchiveEntry* Find(std::string_view path) const;
+
+        /**
+         * @brief Get the stored path of an entry
+         */
+        std::string_view GetEntryPath(const ArchiveEntry& entry) const;
+
+        /**
+         * @brief Decompress a whole asset
+         * @param entry Entry from Find
+         * @param outData Receives entry.Size bytes
+         * @return false if a block is corrupt
+         */
+        bool Read(const ArchiveEntry& entry, std::vector<uint8_t>& outData) const;
+
+        /**
+         * @brief Decompress a byte range of an asset
+         * @param entry Entry from Find
+         * @param offset First byte to read
+         * @param size Bytes to read; offset + size must not exceed entry.Size
+         * @param dst Output buffer of at least size bytes
+         * @return false if the range is out of bounds or a block is corrupt
+         *
+         * Decodes only the blocks the range overlaps, so large assets can be
+         * streamed in pieces.
+         */
+        bool ReadRange(const ArchiveEntry& entry, uint64_t offset, size_t size, void* dst) const;
+
+        /**
+         * @brief Normalize a path the way archive lookups do
+         */
+        static std::string NormalizePath(std::string_view path);
+
+        /**
+         * @brief Hash a normalized path (64-bit FNV-1a)
+         */
+        static uint64_t HashPath(std::string_view normalizedPath);
+
+    private:
+        /**
+         * @brief Decode one block into dst (BLOCK_SIZE or the entry's tail)
+         */
+        bool DecodeBlock(const ArchiveBlock& block, size_t uncompressedSize, uint8_t* dst) const;
+
+    private:
+        MappedFile m_File;
+        std::string m_Path;
+        ArchiveHeader m_Header;
+        const ArchiveBlock* m_Blocks = nullptr;
+        const ArchiveEntry* m_Entries = nullptr;
+        const char* m_Paths = nullptr;
+    };
+
+    // ============================================================================
+    // AssetArchiveWriter
+    // ============================================================================
+
+    /**
+     * @brief Builds an archive from files on disk
+     *
+     * Example usage:
+     * @code
+     *   AssetArchiveWriter writer;
+     *   writer.AddDirectory("assets");
+     *   writer.Write("assets.smpak");
+     * @endcode
+     */
+    class AssetArchiveWriter
+    {
+    public:
+        /**
+         * @brief Queue a file
+         * @param filePath File on disk
+         * @param archivePath Path the asset is looked up by
+         */
+        void AddFile(const std::string& filePath, const std::string& archivePath);
+
+        /**
+         * @brief Queue every file below a directory, keyed by its path relative to it
+         * @return Number of files queued
+         */
+        size_t AddDirectory(const std::string& directory);
+
+        /**
+         * @brief Compress every queued file and write the archive
+         * @param archivePath Output file
+         * @param outError Receives a message on failure
+         * @return true if successful
+         */
+        bool Write(const std::string& archivePath, std::string* outError = nullptr) const;
+
+        size_t GetFileCount() const { return m_Files.size(); }
+
+    private:
+        struct PendingFile
+        {
+            std::string FilePath;
+            std::string ArchivePath;        ///< Normalized
+        };
+
+        std::vector<PendingFile> m_Files;
+    };
+
+} // namespace SM
@@ -32,6 +32,14 @@ namespace SM
         RawAssetData* rawData = static_cast<RawAssetData*>(outData);
         rawData->Clear();
 
+        // Large files are served straight from the page cache
+        if (FileSystem::GetFileSize(path) >= MAPPED_LOAD_THRESHOLD && rawData->Mapping.Open(path))
+        {
+            rawData->SourcePath = path;
+            rawData->OriginalSize = rawData->Mapping.GetSize();
+            return true;
+        }
+
         rawData->Data = FileSystem::ReadFile(path);
         if (rawData->Data.empty())
         {
@@ -48,6 +56,21 @@ namespace SM
         return true;
     }
 
+    bool RawAssetLoader::LoadFromMemory(std::span<const uint8_t> bytes, const std::string& path, void* outData)
+    {
+        if (!outData)
+        {
+            return false;
+        }
+
+        RawAssetData* rawData = static_cast<RawAssetData*>(outData);
+        rawData->Clear();
+        rawData->Data.assign(bytes.begin(), bytes.end());
+        rawData->SourcePath = path;
+        rawData->OriginalSize = bytes.size();
+        return true;
+    }
+
     void RawAssetLoader::Unload(void* data)
     {
         if (data)
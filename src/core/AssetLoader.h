@@ -9,10 +9,13 @@
  * loader implementation.
  */
 
+#include "core/FileSystem.h"
+
 #include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
+#include <span>
 
 namespace SM
 {
@@ -95,6 +98,51 @@ namespace SM
          */
         virtual bool Load(const std::string& path, void* outData) = 0;
 
+        /**
+         * @brief Parse an asset from bytes already in memory
+         * @param bytes File contents (e.g. a MappedFile view); only valid during the call
+         * @param path Path the bytes came from, for diagnostics
+         * @param outData Pointer to receive loaded data
+         * @return true if parsing succeeded
+         *
+         * Loaders that override this (and SupportsMemoryLoading) parse straight
+         * from mapped memory via LoadMapped, skipping the read into a heap buffer.
+         */
+        virtual bool LoadFromMemory(std::span<const uint8_t> bytes, const std::string& path, void* outData)
+        {
+            (void)bytes;
+            (void)path;
+            (void)outData;
+            return false;
+        }
+
+        /**
+         * @brief Check if LoadMapped should parse through LoadFromMemory
+         */
+        virtual bool SupportsMemoryLoading() const { return false; }
+
+        /**
+         * @brief Load through a read-only file mapping when the loader supports it
+         * @param path Path to the asset file
+         * @param outData Pointer to receive loaded data
+         * @return true if loading succeeded
+         *
+         * The mapping is released before returning, so loaders must copy
+         * whatever they keep. Falls back to Load otherwise.
+         */
+        bool LoadMapped(const std::string& path, void* outData)
+        {
+            if (SupportsMemoryLoading())
+            {
+                MappedFile file = FileSystem::MapFile(path);
+                if (file.IsOpen())
+                {
+                    return LoadFromMemory(file.GetBytes(), path, outData);
+                }
+            }
+            return Load(path, outData);
+        }
+
         /**
          * @brief Load an asset with detailed result
          * @param path Path to the asset file
@@ -178,18 +226,27 @@ namespace SM
      * @brief Simple container for raw loaded data
      *
      * Used for assets that are just raw byte data without specific structure.
+     * Large files stay memory-mapped instead of being copied into Data;
+     * read through GetBytes to handle both.
      */
     struct RawAssetData
     {
-        std::vector<uint8_t> Data;    // Raw byte data
+        std::vector<uint8_t> Data;    // Raw byte data (small files)
+        MappedFile Mapping;            // Read-only view of the file (large files)
         std::string SourcePath;        // Original file path
         size_t OriginalSize = 0;       // Size when loaded
 
-        bool IsValid() const { return !Data.empty(); }
+        std::span<const uint8_t> GetBytes() const
+        {
+            return Mapping.IsOpen() ? Mapping.GetBytes() : std::span<const uint8_t>(Data);
+        }
+
+        bool IsValid() const { return !GetBytes().empty(); }
         void Clear()
         {
             Data.clear();
             Data.shrink_to_fit();
+            Mapping.Close();
             SourcePath.clear();
             OriginalSize = 0;
         }
@@ -203,11 +260,18 @@ namespace SM
      * @brief Simple loader that reads files as raw binary data
      *
      * Useful for loading custom file formats or when raw byte access is needed.
+     * Files of at least MAPPED_LOAD_THRESHOLD bytes are kept mapped rather
+     * than copied. Windows refuses to truncate a mapped file, so editing one
+     * of those while it is loaded needs the resource unloaded first.
      */
     class RawAssetLoader : public IAssetLoader
     {
     public:
+        static constexpr size_t MAPPED_LOAD_THRESHOLD = 1024 * 1024;
+
         bool Load(const std::string& path, void* outData) override;
+        /// Copies the bytes; Load keeps large files mapped instead, so LoadMapped uses that
+        bool LoadFromMemory(std::span<const uint8_t> bytes, const std::string& path, void* outData) override;
         void Unload(void* data) override;
 
         std::vector<std::string> GetSupportedExtensions() const override
@@ -0,0 +1,381 @@
+#include "core/AsyncFileQueue.h"
+#include "core/FileSystem.h"
+#include "core/Memory.h"
+#include "core/Profiler.h"
+
+#include <algorithm>
+#include <iostream>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <Windows.h>
+#endif
+
+namespace SM
+{
+#ifdef _WIN32
+    namespace
+    {
+        constexpr ULONG_PTR WAKE_KEY = 1;                   // Posted by Submit/Cancel/Shutdown
+        constexpr ULONG_PTR READ_KEY = 2;                   // Completion of a file read
+        constexpr uint32_t MAX_CHUNK_SIZE = 16 * 1024 * 1024; // Bytes per ReadFile
+    }
+
+    struct AsyncFileQueue::PendingRead
+    {
+        OVERLAPPED Overlapped = {};     // First member: completion packets point here
+        Request Source;
+        HANDLE File = INVALID_HANDLE_VALUE;
+        std::vector<uint8_t> Data;
+        uint64_t Offset = 0;            // Bytes read so far
+    };
+#endif
+
+    AsyncFileQueue::~AsyncFileQueue()
+    {
+        Shutdown();
+    }
+
+    bool AsyncFileQueue::Initialize(uint32_t maxInFlight)
+    {
+        if (IsInitialized())
+        {
+            return true;
+        }
+
+        m_MaxInFlight = std::max(1u, maxInFlight);
+        m_StopRequested = false;
+
+#ifdef _WIN32
+        m_CompletionPort = CreateIoCompletionPort(INVALID_HANDLE_VALUE, nullptr, 0, 1);
+        if (!m_CompletionPort)
+        {
+            std::cerr << "[AsyncFileQueue] Failed to create I/O completion port" << std::endl;
+            return false;
+        }
+#endif
+
+        m_Thread = std::thread(&AsyncFileQueue::IOThreadLoop, this);
+        return true;
+    }
+
+    void AsyncFileQueue::Shutdown()
+    {
+        if (!IsInitialized())
+        {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Queue.clear();
+            m_QueuedKeys.clear();
+            m_StopRequested = true;
+        }
+
+#ifdef _WIN32
+        PostQueuedCompletionStatus(static_cast<HANDLE>(m_CompletionPort), 0, WAKE_KEY, nullptr);
+#endif
+        m_Condition.notify_all();
+        m_Thread.join();
+
+#ifdef _WIN32
+        CloseHandle(static_cast<HANDLE>(m_CompletionPort));
+        m_CompletionPort = nullptr;
+#endif
+        m_Started.clear();
+    }
+
+    AsyncFileQueue::RequestID AsyncFileQueue::Submit(const std::string& path, LoadPriority priority, ReadCallback callback)
+    {
+        RequestID id;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            id = m_NextID++;
+
+            QueueKey key = MakeKey(priority, id);
+            m_Queue.emplace(key, Request{ id, path, std::move(callback) });
+            m_QueuedKeys.emplace(id, key);
+        }
+
+#ifdef _WIN32
+        PostQueuedCompletionStatus(static_cast<HANDLE>(m_CompletionPort), 0, WAKE_KEY, nullptr);
+#endif
+        m_Condition.notify_one();
+        return id;
+    }
+
+    bool AsyncFileQueue::Cancel(RequestID id)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+
+            auto it = m_QueuedKeys.find(id);
+            if (it != m_QueuedKeys.end())
+            {
+                m_Queue.erase(it->second);
+                m_QueuedKeys.erase(it);
+                return true;
+            }
+
+            auto started = m_Started.find(id);
+            if (started == m_Started.end())
+            {
+                return false;
+            }
+
+            // Already started; the I/O thread aborts the read
+            started->second = true;
+        }
+
+#ifdef _WIN32
+        PostQueuedCompletionStatus(static_cast<HANDLE>(m_CompletionPort), 0, WAKE_KEY, nullptr);
+#endif
+        return false;
+    }
+
+    bool AsyncFileQueue::SetPriority(RequestID id, LoadPriority priority)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        auto it = m_QueuedKeys.find(id);
+        if (it == m_QueuedKeys.end())
+        {
+            return false;
+        }
+
+        auto node = m_Queue.extract(it->second);
+        node.key() = MakeKey(priority, id);
+        it->second = node.key();
+        m_Queue.insert(std::move(node));
+        return true;
+    }
+
+    size_t AsyncFileQueue::GetQueuedCount() const
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_Queue.size();
+    }
+
+    bool AsyncFileQueue::PopRequest(Request& out)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        if (m_StopRequested || m_Queue.empty() ||
+            m_InFlightCount.load(std::memory_order_relaxed) >= m_MaxInFlight)
+        {
+            return false;
+        }
+
+        auto it = m_Queue.begin();
+        out = std::move(it->second);
+        m_QueuedKeys.erase(out.ID);
+        m_Queue.erase(it);
+        m_Started.emplace(out.ID, false);
+        m_InFlightCount.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void AsyncFileQueue::Complete(Request& request, bool success, std::vector<uint8_t>& data)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            auto it = m_Started.find(request.ID);
+            if (it != m_Started.end())
+            {
+                success = success && !it->second;
+                m_Started.erase(it);
+            }
+        }
+
+        if (!success)
+        {
+            data.clear();
+        }
+
+        if (request.Callback)
+        {
+            request.Callback(request.ID, success, data);
+        }
+
+        m_InFlightCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+#ifdef _WIN32
+
+    // ============================================================================
+    // IOCP Backend
+    // ============================================================================
+
+    void AsyncFileQueue::IOThreadLoop()
+    {
+        SM_PROFILE_THREAD("File IO");
+        GeneralAllocator::SetThreadTag(MemoryTag::Resources);
+
+        HANDLE port = static_cast<HANDLE>(m_CompletionPort);
+
+        for (;;)
+        {
+            // Keep the device busy up to the in-flight limit; a read that
+            // fails to start has already called back
+            Request request;
+            while (PopRequest(request))
+            {
+                StartRead(request);
+            }
+
+            if (m_StopRequested && m_Reads.empty())
+            {
+                break;
+            }
+
+            DWORD bytes = 0;
+            ULONG_PTR key = 0;
+            OVERLAPPED* overlapped = nullptr;
+            BOOL ok = GetQueuedCompletionStatus(port, &bytes, &key, &overlapped, INFINITE);
+
+            if (key == READ_KEY && overlapped)
+            {
+                OnReadCompleted(reinterpret_cast<PendingRead*>(overlapped), ok != FALSE, bytes);
+            }
+
+            // Woken for a cancel or shutdown: abort the affected reads
+            CancelStartedReads();
+        }
+    }
+
+    void AsyncFileQueue::CancelStartedReads()
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        for (auto& [id, read] : m_Reads)
+        {
+            auto started = m_Started.find(id);
+            if (m_StopRequested || (started != m_Started.end() && started->second))
+            {
+                CancelIoEx(read->File, &read->Overlapped);
+            }
+        }
+    }
+
+    bool AsyncFileQueue::StartRead(Request& request)
+    {
+        auto* read = new PendingRead();
+        read->Source = std::move(request);
+
+        std::wstring widePath = FileSystem::StringToWString(read->Source.Path);
+        read->File = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+        LARGE_INTEGER size = {};
+        if (read->File == INVALID_HANDLE_VALUE || !GetFileSizeEx(read->File, &size) ||
+            !CreateIoCompletionPort(read->File, static_cast<HANDLE>(m_CompletionPort), READ_KEY, 0))
+        {
+            FinishRead(read, false);
+            return false;
+        }
+
+        read->Data.resize(static_cast<size_t>(size.QuadPart));
+        if (read->Data.empty())
+        {
+            FinishRead(read, true);
+            return true;
+        }
+
+        m_Reads.emplace(read->Source.ID, read);
+        if (!IssueChunk(read))
+        {
+            m_Reads.erase(read->Source.ID);
+            FinishRead(read, false);
+            return false;
+        }
+        return true;
+    }
+
+    bool AsyncFileQueue::IssueChunk(PendingRead* read)
+    {
+        uint64_t remaining = read->Data.size() - read->Offset;
+        DWORD chunk = static_cast<DWORD>(std::min<uint64_t>(remaining, MAX_CHUNK_SIZE));
+
+        read->Overlapped = {};
+        read->Overlapped.Offset = static_cast<DWORD>(read->Offset & 0xFFFFFFFFu);
+        read->Overlapped.OffsetHigh = static_cast<DWORD>(read->Offset >> 32);
+
+        // A synchronous success still queues a completion packet
+        if (!ReadFile(read->File, read->Data.data() + read->Offset, chunk, nullptr, &read->Overlapped) &&
+            GetLastError() != ERROR_IO_PENDING)
+        {
+            return false;
+        }
+        return true;
+    }
+
+    void AsyncFileQueue::OnReadCompleted(PendingRead* read, bool ok, uint32_t bytes)
+    {
+        if (ok && bytes > 0)
+        {
+            read->Offset += bytes;
+            if (read->Offset < read->Data.size() && IssueChunk(read))
+            {
+                return;
+            }
+        }
+
+        m_Reads.erase(read->Source.ID);
+        FinishRead(read, ok && read->Offset == read->Data.size());
+    }
+
+    void AsyncFileQueue::FinishRead(PendingRead* read, bool success)
+    {
+        if (read->File != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(read->File);
+        }
+
+        Complete(read->Source, success, read->Data);
+        delete read;
+    }
+
+#else
+
+    // ============================================================================
+    // Portable Backend
+    // ============================================================================
+
+    void AsyncFileQueue::IOThreadLoop()
+    {
+        SM_PROFILE_THREAD("File IO");
+        GeneralAllocator::SetThreadTag(MemoryTag::Resources);
+
+        for (;;)
+        {
+            Request request;
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                m_Condition.wait(lock, [this]() { return m_StopRequested || !m_Queue.empty(); });
+                if (m_StopRequested)
+                {
+                    break;
+                }
+            }
+
+            if (!PopRequest(request))
+            {
+                continue;
+            }
+
+            std::vector<uint8_t> data;
+            bool exists = FileSystem::FileExists(request.Path);
+            if (exists)
+            {
+                data = FileSystem::ReadFile(request.Path);
+            }
+            Complete(request, exists && data.size() == FileSystem::GetFileSize(request.Path), data);
+        }
+    }
+
+#endif
+
+} // namespace SM
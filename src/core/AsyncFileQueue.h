@@ -0,0 +1,183 @@
+#pragma once
+
+/**
+ * @file AsyncFileQueue.h
+ * @brief Shattered Moon Engine - Prioritized asynchronous file reads
+ *
+ * One I/O thread keeps up to a fixed number of whole-file reads in flight.
+ * On Windows the reads are overlapped and complete through an I/O
+ * completion port, so several files stream from the device at once while
+ * no thread blocks per file. Elsewhere the thread reads files one at a
+ * time with ordinary blocking I/O.
+ *
+ * Queued requests are started highest priority first, FIFO within a
+ * priority. Completion callbacks run on the I/O thread and should hand
+ * any real work (decoding) to the job system.
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace SM
+{
+    /**
+     * @brief Order in which queued loads are started
+     */
+    enum class LoadPriority : uint8_t
+    {
+        Low = 0,        // Prefetch, may wait
+        Normal,
+        High,           // Needed soon (visible or audible next frames)
+        Critical        // Blocking gameplay
+    };
+
+    /**
+     * @brief Queue of asynchronous whole-file reads
+     */
+    class AsyncFileQueue
+    {
+    public:
+        using RequestID = uint64_t;
+        static constexpr RequestID INVALID_REQUEST = 0;
+
+        /**
+         * @brief Called on the I/O thread when a read finishes
+         * @param id Request that finished
+         * @param success false if the file could not be read or the read was cancelled
+         * @param data File contents (empty on failure); the callback may take it
+         */
+        using ReadCallback = std::function<void(RequestID id, bool success, std::vector<uint8_t>& data)>;
+
+        AsyncFileQueue() = default;
+        ~AsyncFileQueue();
+
+        // Non-copyable
+        AsyncFileQueue(const AsyncFileQueue&) = delete;
+        AsyncFileQueue& operator=(const AsyncFileQueue&) = delete;
+
+        /**
+         * @brief Start the I/O thread
+         * @param maxInFlight Reads issued to the device at once
+         * @return true if the queue is running
+         */
+        bool Initialize(uint32_t maxInFlight = 4);
+
+        /**
+         * @brief Drop queued requests, cancel reads in flight and stop the thread
+         *
+         * Callbacks of requests in flight still run (with success = false).
+         */
+        void Shutdown();
+
+        bool IsInitialized() const { return m_Thread.joinable(); }
+
+        /**
+         * @brief Queue a file read
+         * @param path File to read
+         * @param priority Start order relative to other queued reads
+         * @param callback Called once when the read finishes or fails
+         * @return Request ID for Cancel and SetPriority
+         */
+        RequestID Submit(const std::string& path, LoadPriority priority, ReadCallback callback);
+
+        /**
+         * @brief Cancel a read
+         * @return true if the request was still queued and will never call back;
+         *         false if it already started (its callback reports failure)
+         *         or is unknown
+         */
+        bool Cancel(RequestID id);
+
+        /**
+         * @brief Move a queued request to another priority
+         * @return false if the request already started or is unknown
+         */
+        bool SetPriority(RequestID id, LoadPriority priority);
+
+        /**
+         * @brief Get the number of requests not yet started
+         */
+        size_t GetQueuedCount() const;
+
+        /**
+         * @brief Get the number of reads in flight
+         */
+        uint32_t GetInFlightCount() const { return m_InFlightCount.load(std::memory_order_relaxed); }
+
+    private:
+        struct Request
+        {
+            RequestID ID = INVALID_REQUEST;
+            std::string Path;
+            ReadCallback Callback;
+        };
+
+        /// Higher priority first, then submission order
+        using QueueKey = std::pair<int, RequestID>;
+
+        static QueueKey MakeKey(LoadPriority priority, RequestID id)
+        {
+            return { -static_cast<int>(priority), id };
+        }
+
+        void IOThreadLoop();
+
+        /**
+         * @brief Take the next request if another read may start
+         */
+        bool PopRequest(Request& out);
+
+        /**
+         * @brief Run a callback and retire the request
+         */
+        void Complete(Request& request, bool success, std::vector<uint8_t>& data);
+
+    private:
+        uint32_t m_MaxInFlight = 4;
+        std::thread m_Thread;
+        std::atomic<bool> m_StopRequested{ false };
+        std::atomic<uint32_t> m_InFlightCount{ 0 };
+
+        mutable std::mutex m_Mutex;
+        std::condition_variable m_Condition;        // Wakes the portable backend
+        std::map<QueueKey, Request> m_Queue;
+        std::unordered_map<RequestID, QueueKey> m_QueuedKeys;
+        std::unordered_map<RequestID, bool> m_Started;     // Reads in flight -> cancel requested
+        RequestID m_NextID = 1;
+
+#ifdef _WIN32
+        struct PendingRead;
+        void* m_CompletionPort = nullptr;   ///< HANDLE from CreateIoCompletionPort
+        std::unordered_map<RequestID, PendingRead*> m_Reads;    // Owned; I/O thread only
+
+        /**
+         * @brief Open a file and issue its first overlapped read
+         * @return false if the read could not start (already completed)
+         */
+        bool StartRead(Request& request);
+
+        /**
+         * @brief Handle one completion packet for a pending read
+         */
+        void OnReadCompleted(PendingRead* read, bool ok, uint32_t bytes);
+
+        /**
+         * @brief Issue the next chunk of a read
+         */
+        bool IssueChunk(PendingRead* read);
+
+        void FinishRead(PendingRead* read, bool success);
+        void CancelStartedReads();
+#endif
+    };
+
+} // namespace SM
@@ -0,0 +1,251 @@
+#include "core/Compression.h"
+
+#include <cstring>
+
+namespace SM
+{
+    namespace
+    {
+        // LZ4 block format limits
+        constexpr size_t MIN_MATCH = 4;
+        constexpr size_t LAST_LITERALS = 5;     ///< The last 5 bytes are always literals
+        constexpr size_t MATCH_FIND_LIMIT = 12; ///< No match may start in the last 12 bytes
+        constexpr size_t MAX_OFFSET = 65535;
+
+        constexpr uint32_t HASH_LOG = 12;
+
+        uint32_t Read32(const uint8_t* p)
+        {
+            uint32_t value;
+            std::memcpy(&value, p, sizeof(value));
+            return value;
+        }
+
+        uint32_t HashSequence(uint32_t sequence)
+        {
+            return (sequence * 2654435761u) >> (32 - HASH_LOG);
+        }
+
+        void WriteLength(std::vector<uint8_t>& dst, size_t length)
+        {
+            while (length >= 255)
+            {
+                dst.push_back(255);
+                length -= 255;
+            }
+            dst.push_back(static_cast<uint8_t>(length));
+        }
+
+        void WriteSequence(std::vector<uint8_t>& dst, const uint8_t* literals, size_t literalLength,
+                           size_t offset, size_t matchLength)
+        {
+            size_t tokenPos = dst.size();
+            dst.push_back(0);
+
+            uint8_t token = static_cast<uint8_t>((literalLength >= 15 ? 15 : literalLength) << 4);
+            if (literalLength >= 15)
+            {
+                WriteLength(dst, literalLength - 15);
+            }
+            dst.insert(dst.end(), literals, literals + literalLength);
+
+            // The final sequence carries literals only
+            if (matchLength > 0)
+            {
+                dst.push_back(static_cast<uint8_t>(offset & 0xFF));
+                dst.push_back(static_cast<uint8_t>(offset >> 8));
+
+                size_t encoded = matchLength - MIN_MATCH;
+                token |= static_cast<uint8_t>(encoded >= 15 ? 15 : encoded);
+                if (encoded >= 15)
+                {
+                    WriteLength(dst, encoded - 15);
+                }
+            }
+
+            dst[tokenPos] = token;
+        }
+
+        bool ReadLength(const uint8_t*& ip, const uint8_t* end, size_t& length)
+        {
+            uint8_t byte;
+            do
+            {
+                if (ip >= end)
+                {
+                    return false;
+                }
+                byte = *ip++;
+                length += byte;
+            } while (byte == 255);
+            return true;
+        }
+    }
+
+    // ============================================================================
+    // LZ4 Block Format
+    // ============================================================================
+
+    size_t Compression::GetMaxCompressedSize(size_t size)
+    {
+        return size + size / 255 + 16;
+    }
+
+    void Compression::CompressLZ4(const void* src, size_t size, std::vector<uint8_t>& dst)
+    {
+        dst.clear();
+        dst.reserve(GetMaxCompressedSize(size));
+
+        const uint8_t* base = static_cast<const uint8_t*>(src);
+        const uint8_t* end = base + size;
+        const uint8_t* anchor = base;
+
+        if (size > MATCH_FIND_LIMIT)
+        {
+            uint32_t table[1u << HASH_LOG] = {};
+            const uint8_t* ip = base + 1;
+            const uint8_t* matchStartLimit = end - MATCH_FIND_LIMIT;
+            const uint8_t* matchEndLimit = end - LAST_LITERALS;
+
+            while (ip < matchStartLimit)
+            {
+                uint32_t sequence = Read32(ip);
+                uint32_t hash = HashSequence(sequence);
+                const uint8_t* ref = base + table[hash];
+                table[hash] = static_cast<uint32_t>(ip - base);
+
+                if (ref >= ip || static_cast<size_t>(ip - ref) > MAX_OFFSET || Read32(ref) != sequence)
+                {
+                    ++ip;
+                    continue;
+                }
+
+                // Extend backwards over pending literals, then forwards
+                while (ip > anchor && ref > base && ip[-1] == ref[-1])
+                {
+                    --ip;
+                    --ref;
+                }
+
+                const uint8_t* matchEnd = ip + MIN_MATCH;
+                const uint8_t* refEnd = ref + MIN_MATCH;
+                while (matchEnd < matchEndLimit && *matchEnd == *refEnd)
+                {
+                    ++matchEnd;
+                    ++refEnd;
+                }
+
+                WriteSequence(dst, anchor, static_cast<size_t>(ip - anchor),
+                    static_cast<size_t>(ip - ref), static_cast<size_t>(matchEnd - ip));
+
+                ip = matchEnd;
+                anchor = ip;
+            }
+        }
+
+        WriteSequence(dst, anchor, static_cast<size_t>(end - anchor), 0, 0);
+    }
+
+    bool Compression::DecompressLZ4(const void* src, size_t compressedSize, void* dst, size_t decompressedSize)
+    {
+        const uint8_t* ip = static_cast<const uint8_t*>(src);
+        const uint8_t* ipEnd = ip + compressedSize;
+        uint8_t* const outBase = static_cast<uint8_t*>(dst);
+        uint8_t* op = outBase;
+        uint8_t* const opEnd = op + decompressedSize;
+
+        while (ip < ipEnd)
+        {
+            uint8_t token = *ip++;
+
+            size_t literalLength = token >> 4;
+            if (literalLength == 15 && !ReadLength(ip, ipEnd, literalLength))
+            {
+                return false;
+            }
+
+            if (literalLength > static_cast<size_t>(ipEnd - ip) ||
+                literalLength > static_cast<size_t>(opEnd - op))
+            {
+                return false;
+            }
+
+            std::memcpy(op, ip, literalLength);
+            ip += literalLength;
+            op += literalLength;
+
+            // Last sequence ends after its literals
+            if (ip == ipEnd)
+            {
+                break;
+            }
+
+            if (ipEnd - ip < 2)
+            {
+                return false;
+            }
+
+            size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+            ip += 2;
+            if (offset == 0 || offset > static_cast<size_t>(op - outBase))
+            {
+                return false;
+            }
+
+            size_t matchLength = token & 15;
+            if (matchLength == 15 && !ReadLength(ip, ipEnd, matchLength))
+            {
+                return false;
+            }
+            matchLength += MIN_MATCH;
+
+            if (matchLength > static_cast<size_t>(opEnd - op))
+            {
+                return false;
+            }
+
+            // Byte copy: the match may overlap the bytes it produces
+            const uint8_t* match = op - offset;
+            for (size_t i = 0; i < matchLength; ++i)
+            {
+                op[i] = match[i];
+            }
+            op += matchLength;
+        }
+
+        return op == opEnd;
+    }
+
+    // ============================================================================
+    // Byte Shuffling
+    // ============================================================================
+
+    void Compression::ShuffleBytes(const void* src, size_t elementCount, size_t elementSize, void* dst)
+    {
+        const uint8_t* in = static_cast<const uint8_t*>(src);
+        uint8_t* out = static_cast<uint8_t*>(dst);
+
+        for (size_t b = 0; b < elementSize; ++b)
+        {
+            for (size_t i = 0; i < elementCount; ++i)
+            {
+                out[b * elementCount + i] = in[i * elementSize + b];
+            }
+        }
+    }
+
+    void Compression::UnshuffleBytes(const void* src, size_t elementCount, size_t elementSize, void* dst)
+    {
+        const uint8_t* in = static_cast<const uint8_t*>(src);
+        uint8_t* out = static_cast<uint8_t*>(dst);
+
+        for (size_t b = 0; b < elementSize; ++b)
+        {
+            for (size_t i = 0; i < elementCount; ++i)
+            {
+                out[i * elementSize + b] = in[b * elementCount + i];
+            }
+        }
+    }
+
+} // namespace SM
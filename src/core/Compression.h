@@ -0,0 +1,77 @@
+#pragma once
+
+/**
+ * @file Compression.h
+ * @brief Shattered Moon Engine - Lossless Compression Utilities
+ *
+ * Fast block compression in the LZ4 block format (readable by any LZ4
+ * decoder's LZ4_decompress_safe) plus byte-plane shuffling, which groups
+ * the same byte of every element so smooth numeric data compresses well.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SM
+{
+    /**
+     * @brief Static compression utility class
+     */
+    class Compression
+    {
+    public:
+        // ====================================================================
+        // LZ4 Block Format
+        // ====================================================================
+
+        /**
+         * @brief Get the worst-case compressed size of an input
+         * @param size Input size in bytes
+         */
+        static size_t GetMaxCompressedSize(size_t size);
+
+        /**
+         * @brief Compress a buffer into a single LZ4 block
+         * @param src Input bytes
+         * @param size Input size in bytes
+         * @param dst Output; replaced with the compressed block
+         *
+         * Greedy single-pass matcher with a 4K-entry hash table; favours
+         * speed over ratio. The block does not store the input size.
+         */
+        static void CompressLZ4(const void* src, size_t size, std::vector<uint8_t>& dst);
+
+        /**
+         * @brief Decompress an LZ4 block
+         * @param src Compressed block
+         * @param compressedSize Block size in bytes
+         * @param dst Output buffer
+         * @param decompressedSize Exact decompressed size in bytes
+         * @return false if the block is malformed or does not decode to exactly decompressedSize bytes
+         *
+         * Every read and write is bounds-checked, so corrupt input is safe.
+         */
+        static bool DecompressLZ4(const void* src, size_t compressedSize, void* dst, size_t decompressedSize);
+
+        // ====================================================================
+        // Byte Shuffling
+        // ====================================================================
+
+        /**
+         * @brief Split elements into byte planes
+         * @param src elementCount elements of elementSize bytes
+         * @param dst Output: byte 0 of every element, then byte 1, ...
+         */
+        static void ShuffleBytes(const void* src, size_t elementCount, size_t elementSize, void* dst);
+
+        /**
+         * @brief Inverse of ShuffleBytes
+         */
+        static void UnshuffleBytes(const void* src, size_t elementCount, size_t elementSize, void* dst);
+
+    private:
+        Compression() = delete; // Static class
+    };
+
+} // namespace SM
@@ -1,21 +1,31 @@
 #include "core/Engine.h"
 #include "core/Window.h"
 #include "core/Memory.h"
+#include "core/MemoryTracker.h"
+#include "core/JobSystem.h"
 #include "core/ResourceManager.h"
 #include "core/FileSystem.h"
+#include "core/Profiler.h"
 #include "ecs/ECS.h"
 #include "renderer/Renderer.h"
 #include "renderer/TerrainRenderer.h"
+#include "renderer/FoliageRenderer.h"
+#include "renderer/MeshRenderSystem.h"
+#include "ecs/systems/TransformSystem.h"
 #include "pcg/PCG.h"
 #include "gameplay/Input.h"
 #include "gameplay/InputAction.h"
 #include "gameplay/Camera.h"
 #include "gameplay/CameraController.h"
+#include "gameplay/CameraPath.h"
 #include "editor/EditorUI.h"
 #include "editor/ConsolePanel.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <iomanip>
+#include <sstream>
 
 namespace SM
 {
@@ -38,6 +48,12 @@ namespace SM
         }
 
         m_Config = config;
+        SM_PROFILE_THREAD("Main");
+
+#ifdef SM_ENABLE_TRACING
+        // Before anything that records trace scopes
+        TraceProvider::Get().Register();
+#endif
 
         // Initialize Memory Management (first, as other systems may use it)
         if (!InitializeMemory())
@@ -46,6 +62,13 @@ namespace SM
             return false;
         }
 
+        // Initialize Job System (sized from the hardware unless configured)
+        if (!JobSystem::Get().Initialize(config.jobWorkerThreads))
+        {
+            std::cerr << "[Engine] Failed to initialize job system" << std::endl;
+            return false;
+        }
+
         // Initialize Resource Management
         if (!InitializeResources())
         {
@@ -61,14 +84,27 @@ namespace SM
         windowConfig.width = config.windowWidth;
         windowConfig.height = config.windowHeight;
         windowConfig.fullscreen = config.fullscreen;
+        windowConfig.messageThread = config.windowMessageThread;
 
         if (!m_Window->Initialize(windowConfig))
         {
             return false;
         }
 
+        // Falls back to draining raw input with the window's messages
+        if (config.rawInputThread)
+        {
+            m_Window->StartRawInputThread();
+        }
+
         // Initialize ECS World
-        m_World = std::make_unique<World>();
+        m_World = std::make_unique<World>(config.useArchetypeStorage
+            ? ComponentStorageMode::Archetype
+            : ComponentStorageMode::Sparse);
+        if (config.parallelSystemUpdates)
+        {
+            m_World->GetSystemManager().EnableParallelUpdates();
+        }
         InitializeECS();
 
         // Initialize DX12 Renderer
@@ -109,6 +145,15 @@ namespace SM
         // Test renderer (debug builds only)
         TestRenderer();
 
+        if (IsBenchmarkMode())
+        {
+            InitializeBenchmark();
+        }
+        else if (config.threadedSimulation)
+        {
+            StartSimulationThread();
+        }
+
         return true;
     }
 
@@ -122,25 +167,65 @@ namespace SM
         // Main game loop
         while (m_IsRunning)
         {
-            // Process window messages
-            if (!m_Window->ProcessMessages())
+            // Process window messages (their input is read by the simulation tick)
             {
-                m_IsRunning = false;
-                break;
+                std::unique_lock<std::mutex> lock(m_SimulationMutex, std::defer_lock);
+                if (IsThreadedSimulation())
+                {
+                    lock.lock();
+                    Input::Get().ApplyPendingMouseCapture();
+                }
+
+                if (!m_Window->ProcessMessages())
+                {
+                    m_IsRunning = false;
+                    break;
+                }
             }
 
+            // Close the profiler's previous frame
+            Profiler::Get().BeginFrame();
+            MemoryTracker::Get().BeginFrame();
+
             // Calculate timing
             CalculateTiming();
 
-            // Update game logic
-            Update(m_DeltaTime);
+            auto frameStart = std::chrono::high_resolution_clock::now();
+
+            // Update game logic, or pick up what the simulation thread has ticked
+            if (IsThreadedSimulation())
+            {
+                UpdateFromSimulation();
+            }
+            else
+            {
+                Update(m_DeltaTime);
+            }
 
             // Render frame
             Render();
+
+            // Bytes and command lists handed to the copy queue this frame
+            if (m_Renderer)
+            {
+                const UploadQueue& uploads = m_Renderer->GetCore()->GetUploadQueue();
+                const uint64_t uploaded = uploads.GetUploadedBytes();
+                const uint64_t submissions = uploads.GetSubmissionCount();
+                SM_TRACE_COUNTER("Upload Bytes", uploaded - m_TracedUploadBytes);
+                SM_TRACE_COUNTER("Upload Submissions", submissions - m_TracedUploadSubmissions);
+                m_TracedUploadBytes = uploaded;
+                m_TracedUploadSubmissions = submissions;
+            }
+
+            if (IsBenchmarkMode())
+            {
+                auto frameEnd = std::chrono::high_resolution_clock::now();
+                RecordBenchmarkFrame(std::chrono::duration<double, std::milli>(frameEnd - frameStart).count());
+            }
         }
 
         Shutdown();
-        return 0;
+        return m_ExitCode;
     }
 
     void Engine::RequestShutdown()
@@ -158,6 +243,11 @@ namespace SM
         return ResourceManager::Get();
     }
 
+    JobSystem& Engine::GetJobSystem()
+    {
+        return JobSystem::Get();
+    }
+
     void Engine::Shutdown()
     {
         if (!m_IsInitialized)
@@ -167,7 +257,10 @@ namespace SM
 
         // Shutdown in reverse order of initialization
 
-        // Shutdown Editor system first
+        // Stop ticking before anything the simulation touches goes away
+        StopSimulationThread();
+
+        // Shutdown Editor system
         if (m_EditorUI)
         {
             m_EditorUI->Shutdown();
@@ -175,6 +268,12 @@ namespace SM
         }
 
         // Shutdown Terrain system
+        if (m_FoliageRenderer)
+        {
+            m_FoliageRenderer->Shutdown();
+            m_FoliageRenderer.reset();
+        }
+
         if (m_TerrainRenderer)
         {
             m_TerrainRenderer->Shutdown();
@@ -190,6 +289,10 @@ namespace SM
         // Shutdown Renderer (before window)
         if (m_Renderer)
         {
+            // The video memory budget providers query the renderer's adapter
+            ResourceManager::Get().SetBudgetProvider(ResourceType::Texture, nullptr);
+            ResourceManager::Get().SetBudgetProvider(ResourceType::Mesh, nullptr);
+
             m_Renderer->Shutdown();
             m_Renderer.reset();
         }
@@ -198,6 +301,7 @@ namespace SM
         if (m_World)
         {
             m_World->ShutdownSystems();
+            m_MeshRenderSystem = nullptr;
             m_World.reset();
         }
 
@@ -211,6 +315,13 @@ namespace SM
         // Shutdown Resource Management
         ResourceManager::Get().Shutdown();
 
+        // Shutdown Job System (after everything that submits jobs)
+        JobSystem::Get().Shutdown();
+
+#ifdef SM_ENABLE_TRACING
+        TraceProvider::Get().Unregister();
+#endif
+
         // Shutdown Memory Management (last, as other systems may use it)
         MemoryManager::Get().Shutdown();
 
@@ -252,18 +363,24 @@ namespace SM
 
     void Engine::Update(float deltaTime)
     {
+        SM_PROFILE_SCOPE("Engine::Update");
         auto updateStart = std::chrono::high_resolution_clock::now();
 
         // Update Input (must be first to capture this frame's input)
         UpdateInput(deltaTime);
 
         // Update Resource Manager (process async loads)
-        ResourceManager::Get().Update();
+        {
+            ScopedMemoryTag tag(MemoryTag::Resources);
+            ResourceManager::Get().Update();
+        }
 
         // Update ECS systems
         if (m_World)
         {
+            ScopedMemoryTag tag(MemoryTag::ECS);
             m_World->Update(deltaTime);
+            SM_TRACE_COUNTER("Live Entities", m_World->GetEntityCount());
         }
 
         // TODO: Update physics
@@ -277,6 +394,186 @@ namespace SM
         m_UpdateTime = std::chrono::duration<float, std::milli>(updateEnd - updateStart).count();
     }
 
+    // ============================================================================
+    // Threaded Simulation
+    // ============================================================================
+
+    void Engine::StartSimulationThread()
+    {
+        if (IsThreadedSimulation() || m_Config.simulationHz <= 0.0f)
+        {
+            return;
+        }
+
+        if (m_MeshRenderSystem)
+        {
+            m_MeshRenderSystem->SetSnapshotMode(true);
+        }
+
+        m_SnapshotTicks = 0;
+        m_SimulationRunning = true;
+        m_SimulationThread = std::thread(&Engine::SimulationLoop, this);
+
+        std::cout << "[Engine] Simulation thread ticking at " << m_Config.simulationHz << " Hz" << std::endl;
+    }
+
+    void Engine::StopSimulationThread()
+    {
+        if (!IsThreadedSimulation())
+        {
+            return;
+        }
+
+        m_SimulationRunning = false;
+        m_SimulationThread.join();
+
+        if (m_MeshRenderSystem)
+        {
+            m_MeshRenderSystem->SetSnapshotMode(false);
+        }
+    }
+
+    void Engine::SimulationLoop()
+    {
+        SM_PROFILE_THREAD("Simulation");
+
+        using Clock = std::chrono::high_resolution_clock;
+
+        // Behind by more than this many ticks (a breakpoint, a hitch), the backlog is dropped
+        constexpr int MAX_CATCH_UP_TICKS = 5;
+
+        const float step = 1.0f / m_Config.simulationHz;
+        const Clock::duration stepDuration = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<float>(step));
+
+        Clock::time_point tickTime = Clock::now();
+        while (m_SimulationRunning)
+        {
+            SimulationTick(step, tickTime);
+            tickTime += stepDuration;
+
+            // Ticks that are due run back to back; otherwise wait for the next one
+            const Clock::time_point now = Clock::now();
+            if (now - tickTime > stepDuration * MAX_CATCH_UP_TICKS)
+            {
+                tickTime = now;
+            }
+            else
+            {
+                std::this_thread::sleep_until(tickTime);
+            }
+        }
+    }
+
+    void Engine::SimulationTick(float step, std::chrono::high_resolution_clock::time_point tickTime)
+    {
+        SM_PROFILE_SCOPE("Engine::SimulationTick");
+        auto tickStart = std::chrono::high_resolution_clock::now();
+
+        std::lock_guard<std::mutex> lock(m_SimulationMutex);
+
+        UpdateInput(step);
+
+        if (m_World)
+        {
+            ScopedMemoryTag tag(MemoryTag::ECS);
+            m_World->Update(step);
+            SM_TRACE_COUNTER("Live Entities", m_World->GetEntityCount());
+        }
+
+        CameraSnapshot camera;
+        if (m_GameCamera)
+        {
+            camera.Position = m_GameCamera->GetPositionXM();
+            camera.Forward = m_GameCamera->GetForward().ToXMFLOAT3();
+            camera.NearZ = m_GameCamera->GetNearZ();
+            camera.FarZ = m_GameCamera->GetFarZ();
+            camera.FieldOfView = m_GameCamera->GetFOV();
+            if (m_UseFPSCamera && m_FPSController)
+            {
+                camera.Velocity = m_FPSController->GetVelocity().ToXMFLOAT3();
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> snapshotLock(m_SnapshotMutex);
+
+            // The first tick has nothing to interpolate from
+            m_CameraSnapshots[0] = (m_SnapshotTicks > 0) ? m_CameraSnapshots[1] : camera;
+            m_CameraSnapshots[1] = camera;
+            m_SnapshotTime = tickTime;
+            m_SnapshotTicks++;
+
+            if (m_MeshRenderSystem)
+            {
+                m_MeshRenderSystem->PublishSnapshot();
+            }
+        }
+
+        auto tickEnd = std::chrono::high_resolution_clock::now();
+        m_UpdateTime = std::chrono::duration<float, std::milli>(tickEnd - tickStart).count();
+    }
+
+    void Engine::UpdateFromSimulation()
+    {
+        SM_PROFILE_SCOPE("Engine::UpdateFromSimulation");
+
+        // Uploads share the copy queue with rendering, so loads complete here
+        {
+            ScopedMemoryTag tag(MemoryTag::Resources);
+            ResourceManager::Get().Update();
+        }
+
+        CameraSnapshot previous;
+        CameraSnapshot latest;
+        std::chrono::high_resolution_clock::time_point tickTime;
+        {
+            std::lock_guard<std::mutex> lock(m_SnapshotMutex);
+            if (m_SnapshotTicks > 0)
+            {
+                previous = m_CameraSnapshots[0];
+                latest = m_CameraSnapshots[1];
+                tickTime = m_SnapshotTime;
+            }
+            else
+            {
+                previous = latest = m_RenderCamera;
+                tickTime = std::chrono::high_resolution_clock::now();
+            }
+
+            // Under the same lock, so meshes and camera come from the same tick
+            if (m_MeshRenderSystem)
+            {
+                m_MeshRenderSystem->TakeSnapshot();
+            }
+        }
+
+        // Drawn one tick behind: the latest tick is reached as the next one is due
+        const float alpha = std::clamp(std::chrono::duration<float>(
+            std::chrono::high_resolution_clock::now() - tickTime).count() * m_Config.simulationHz, 0.0f, 1.0f);
+
+        if (m_MeshRenderSystem)
+        {
+            m_MeshRenderSystem->InterpolateSnapshot(alpha);
+        }
+
+        DirectX::XMVECTOR from = DirectX::XMLoadFloat3(&previous.Position);
+        DirectX::XMVECTOR to = DirectX::XMLoadFloat3(&latest.Position);
+        DirectX::XMStoreFloat3(&m_RenderCamera.Position, DirectX::XMVectorLerp(from, to, alpha));
+
+        from = DirectX::XMLoadFloat3(&previous.Forward);
+        to = DirectX::XMLoadFloat3(&latest.Forward);
+        DirectX::XMStoreFloat3(&m_RenderCamera.Forward,
+                               DirectX::XMVector3Normalize(DirectX::XMVectorLerp(from, to, alpha)));
+
+        m_RenderCamera.Velocity = latest.Velocity;
+        m_RenderCamera.NearZ = latest.NearZ;
+        m_RenderCamera.FarZ = latest.FarZ;
+        m_RenderCamera.FieldOfView = previous.FieldOfView + (latest.FieldOfView - previous.FieldOfView) * alpha;
+
+        MemoryManager::Get().ClearFrameStack();
+    }
+
     void Engine::Render()
     {
         if (!m_Renderer || !m_Renderer->IsInitialized())
@@ -284,35 +581,83 @@ namespace SM
             return;
         }
 
+        SM_PROFILE_SCOPE("Engine::Render");
+        ScopedMemoryTag memoryTag(MemoryTag::Renderer);
         auto renderStart = std::chrono::high_resolution_clock::now();
 
         // Begin frame
         m_Renderer->BeginFrame();
 
-        // Clear render target with sky blue background
-        m_Renderer->Clear(0.4f, 0.6f, 0.9f, 1.0f);
+        // The frame's fence has been waited on, so its thread arenas can be recycled
+        MemoryManager::Get().BeginFrameArenas(m_Renderer->GetCore()->GetCurrentFrameIndex());
 
-        // Update per-frame constants
-        m_Renderer->UpdateFrameConstants(m_TotalTime);
+        RenderGraph& graph = m_Renderer->GetRenderGraph();
 
-        // Set viewport
-        m_Renderer->SetViewport(m_Renderer->GetWidth(), m_Renderer->GetHeight());
+        // Scene: terrain or the test scene into the back buffer (or the dynamic resolution target)
+        graph.AddPass("Scene",
+            [this](RenderGraphBuilder& builder) {
+                builder.Write(m_Renderer->GetSceneColorHandle(), D3D12_RESOURCE_STATE_RENDER_TARGET);
+                builder.Write(m_Renderer->GetDepthHandle(), D3D12_RESOURCE_STATE_DEPTH_WRITE);
+            },
+            [this](CommandList&, const RenderGraph&) {
+                // Clear render target with sky blue background
+                m_Renderer->Clear(0.4f, 0.6f, 0.9f, 1.0f);
 
-        // Render procedural terrain if enabled
-        if (m_TerrainEnabled && m_ChunkManager && m_TerrainRenderer)
-        {
-            RenderTerrain();
-        }
-        else
-        {
-            // Fallback: render test scene with primitive meshes
-            RenderTestScene();
-        }
+                // Update per-frame constants
+                m_Renderer->UpdateFrameConstants(m_TotalTime);
+
+                // Set viewport
+                m_Renderer->SetViewport(m_Renderer->GetRenderWidth(), m_Renderer->GetRenderHeight());
 
-        // Render Editor UI (ImGui)
-        RenderEditor();
+                // Render procedural terrain if enabled
+                if (m_TerrainEnabled && m_ChunkManager && m_TerrainRenderer)
+                {
+                    RenderTerrain();
+                }
+                else
+                {
+                    // Fallback: render test scene with primitive meshes
+                    RenderTestScene();
+                }
 
-        // End frame
+                // Mesh entities, one instanced draw per mesh/material batch
+                if (m_MeshRenderSystem)
+                {
+                    m_MeshRenderSystem->Render(*m_Renderer);
+                }
+
+                // Without a depth pre-pass the finished scene depth feeds next frame's Hi-Z consumers
+                if (!m_Renderer->IsHiZBuilt())
+                {
+                    const Camera& camera = m_Renderer->GetCamera();
+                    m_Renderer->BuildHiZ(DirectX::XMMatrixMultiply(camera.GetViewMatrix(),
+                                                                   camera.GetProjectionMatrix(m_Renderer->GetAspectRatio())));
+                }
+            });
+
+        // Scaled scene onto the back buffer, so the editor draws at native resolution
+        if (m_Renderer->IsDynamicResolutionActive())
+        {
+            graph.AddPass("Upscale",
+                [this](RenderGraphBuilder& builder) {
+                    builder.Read(m_Renderer->GetSceneColorHandle(), D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+                    builder.Write(m_Renderer->GetBackBufferHandle(), D3D12_RESOURCE_STATE_RENDER_TARGET);
+                },
+                [this](CommandList&, const RenderGraph&) {
+                    m_Renderer->UpscaleSceneColor();
+                });
+        }
+
+        // Editor UI (ImGui) on top of the scene
+        graph.AddPass("Editor",
+            [this](RenderGraphBuilder& builder) {
+                builder.Write(m_Renderer->GetBackBufferHandle(), D3D12_RESOURCE_STATE_RENDER_TARGET);
+            },
+            [this](CommandList&, const RenderGraph&) {
+                RenderEditor();
+            });
+
+        // End frame (compiles and records the graph)
         m_Renderer->EndFrame();
 
         // Present to screen
@@ -436,6 +781,14 @@ namespace SM
         m_World->RegisterComponent<VelocityComponent>();
         m_World->RegisterComponent<CameraComponent>();
         m_World->RegisterComponent<LightComponent>();
+        m_World->RegisterComponent<HierarchyComponent>();
+        m_World->RegisterComponent<WorldMatrixComponent>();
+
+        // Caches world matrices, parents before children
+        m_World->RegisterSystem<TransformSystem>();
+
+        // Gathers mesh entities into instanced batches for the scene pass
+        m_MeshRenderSystem = m_World->RegisterSystem<MeshRenderSystem>();
 
         // Initialize systems
         m_World->InitializeSystems();
@@ -534,10 +887,14 @@ namespace SM
 
     bool Engine::InitializeMemory()
     {
-        return MemoryManager::Get().Initialize(
-            m_Config.frameStackSize,
-            m_Config.persistentStackSize
-        );
+        auto& memory = MemoryManager::Get();
+        if (!memory.Initialize(m_Config.frameStackSize, m_Config.persistentStackSize, m_Config.stackReserveSize))
+        {
+            return false;
+        }
+
+        // One arena per frame in flight so frame data outlives the CPU frame until the GPU is done
+        return memory.InitializeFrameArenas(FRAME_BUFFER_COUNT, m_Config.frameArenaSize);
     }
 
     bool Engine::InitializeResources()
@@ -549,7 +906,18 @@ namespace SM
             return false;
         }
 
+        // Packed assets (SM_PACK_ASSETS) take precedence over the loose directory
+        std::string archivePath = FileSystem::CombinePath(FileSystem::GetExecutableDirectory(), "assets.smpak");
+        if (FileSystem::FileExists(archivePath))
+        {
+            rm.MountArchive(archivePath, "assets");
+        }
+
 #if defined(_DEBUG)
+        // Watch the asset and shader trees; shader edits rebuild the PSOs
+        rm.AddHotReloadDirectory("assets");
+        rm.AddHotReloadDirectory("shaders");
+        rm.AddFileChangeListener(".hlsl", [this](const std::vector<std::string>& files) { ReloadShaders(files); });
         rm.SetHotReloadEnabled(m_Config.enableHotReload);
 #else
         rm.SetHotReloadEnabled(false);
@@ -558,6 +926,24 @@ namespace SM
         return true;
     }
 
+    void Engine::ReloadShaders(const std::vector<std::string>& changedFiles)
+    {
+        for (const std::string& file : changedFiles)
+        {
+            std::cout << "[Engine] Shader changed: " << file << std::endl;
+        }
+
+        if (m_Renderer && m_Renderer->IsInitialized() && !m_Renderer->ReloadShaders())
+        {
+            std::cerr << "[Engine] Shader reload failed, keeping the previous shaders" << std::endl;
+        }
+
+        if (m_TerrainRenderer)
+        {
+            m_TerrainRenderer->ReloadShaders();
+        }
+    }
+
     void Engine::TestMemoryAndResources()
     {
 #if defined(_DEBUG)
@@ -722,14 +1108,42 @@ namespace SM
             m_Window->GetHandle(),
             static_cast<uint32_t>(m_Config.windowWidth),
             static_cast<uint32_t>(m_Config.windowHeight),
-            m_Config.vsync
+            m_Config.vsync,
+            m_Config.framesInFlight
         );
 
         if (result)
         {
             std::cout << "[Engine] DX12 Renderer initialized successfully" << std::endl;
+
+            // Rewrite the frame's camera constants from fresh input just before submission
+            m_Renderer->SetPreSubmitCallback([this]() { LateLatchCamera(); });
+
+            DynamicResolutionConfig dynamicResolution;
+            dynamicResolution.Enabled = m_Config.dynamicResolution;
+            dynamicResolution.TargetGPUTimeMs = m_Config.dynamicResolutionTargetMs;
+            m_Renderer->SetDynamicResolution(dynamicResolution);
             std::cout << "[Engine] Render target: " << m_Renderer->GetWidth()
                       << "x" << m_Renderer->GetHeight() << std::endl;
+
+            // GPU-bound resource caches follow the video memory budget, which
+            // shrinks when other applications need VRAM
+            auto& rm = ResourceManager::Get();
+            const DX12Core* core = m_Renderer->GetCore();
+            auto shareOfVideoMemory = [core](float share) -> ResourceManager::BudgetProvider
+            {
+                if (share <= 0.0f)
+                {
+                    return nullptr;
+                }
+                return [core, share]() -> size_t
+                {
+                    DXGI_QUERY_VIDEO_MEMORY_INFO info = {};
+                    return core->QueryVideoMemory(info) ? static_cast<size_t>(info.Budget * share) : 0;
+                };
+            };
+            rm.SetBudgetProvider(ResourceType::Texture, shareOfVideoMemory(m_Config.textureMemoryShare));
+            rm.SetBudgetProvider(ResourceType::Mesh, shareOfVideoMemory(m_Config.meshMemoryShare));
         }
 
         return result;
@@ -1033,6 +1447,16 @@ namespace SM
         m_TerrainRenderer->SetTextureScale(10.0f);
         m_TerrainRenderer->SetFog(100.0f, 400.0f, DirectX::XMFLOAT4(0.6f, 0.75f, 0.9f, 1.0f));
 
+        // Mesh entities cast into the terrain's shadow cascades once shadows are enabled
+        m_TerrainRenderer->SetDynamicShadowCasters([this](const DirectX::XMMATRIX& lightViewProjection) {
+            return m_MeshRenderSystem ? m_MeshRenderSystem->RenderShadowCasters(*m_Renderer, lightViewProjection) : 0u;
+        });
+
+        // ...and occlude terrain in the depth pre-pass once that is enabled
+        m_TerrainRenderer->SetDepthPrepassCasters([this]() {
+            return m_MeshRenderSystem ? m_MeshRenderSystem->RenderDepthPrepass(*m_Renderer) : 0u;
+        });
+
         // Create chunk manager
         m_ChunkManager = std::make_unique<PCG::ChunkManager>();
 
@@ -1042,6 +1466,7 @@ namespace SM
         chunkConfig.UnloadDistance = 250.0f;
         chunkConfig.MaxChunksPerFrame = 2;
         chunkConfig.MaxMeshBuildsPerFrame = 4;
+        chunkConfig.AsyncGeneration = true;
 
         // Configure terrain generation settings
         chunkConfig.TerrainSettings.Seed = 42;
@@ -1060,6 +1485,61 @@ namespace SM
             return false;
         }
 
+        // Create foliage renderer (scattered trees, bushes and rocks)
+        m_FoliageRenderer = std::make_unique<PCG::FoliageRenderer>();
+        if (m_FoliageRenderer->Initialize(*m_Renderer))
+        {
+            using PCG::BiomeType;
+            using PCG::ScatterLayer;
+
+            ScatterLayer trees;
+            trees.Name = "Trees";
+            trees.MeshId = PrimitiveMesh::Cone;
+            trees.BiomeMask = ScatterLayer::BiomeBit(BiomeType::Forest) | ScatterLayer::BiomeBit(BiomeType::DeciduousForest) |
+                              ScatterLayer::BiomeBit(BiomeType::ConiferousForest) | ScatterLayer::BiomeBit(BiomeType::Jungle);
+            trees.Spacing = 5.0f;
+            trees.Density = 0.6f;
+            trees.MaxSlope = 0.7f;
+            trees.MeshScale = DirectX::XMFLOAT3(2.0f, 6.0f, 2.0f);
+            trees.Color = DirectX::XMFLOAT4(0.18f, 0.42f, 0.16f, 1.0f);
+
+            ScatterLayer bushes;
+            bushes.Name = "Bushes";
+            bushes.MeshId = PrimitiveMesh::Sphere;
+            bushes.BiomeMask = ScatterLayer::BiomeBit(BiomeType::Plains) | ScatterLayer::BiomeBit(BiomeType::Grassland) |
+                               ScatterLayer::BiomeBit(BiomeType::Savanna) | ScatterLayer::BiomeBit(BiomeType::Marsh) |
+                               ScatterLayer::BiomeBit(BiomeType::Forest) | ScatterLayer::BiomeBit(BiomeType::DeciduousForest);
+            bushes.Spacing = 3.0f;
+            bushes.Density = 0.35f;
+            bushes.MeshScale = DirectX::XMFLOAT3(1.2f, 0.8f, 1.2f);
+            bushes.GroundOffset = 0.3f;
+            bushes.Color = DirectX::XMFLOAT4(0.3f, 0.5f, 0.2f, 1.0f);
+            bushes.FullDensityDistance = 40.0f;
+            bushes.DrawDistance = 120.0f;
+
+            ScatterLayer rocks;
+            rocks.Name = "Rocks";
+            rocks.MeshId = PrimitiveMesh::Cube;
+            rocks.BiomeMask = ScatterLayer::BiomeBit(BiomeType::Hills) | ScatterLayer::BiomeBit(BiomeType::Mountains) |
+                              ScatterLayer::BiomeBit(BiomeType::Desert) | ScatterLayer::BiomeBit(BiomeType::Tundra) |
+                              ScatterLayer::BiomeBit(BiomeType::Wasteland) | ScatterLayer::BiomeBit(BiomeType::Beach);
+            rocks.Spacing = 6.0f;
+            rocks.Density = 0.4f;
+            rocks.MaxSlope = 1.2f;
+            rocks.MinScale = 0.5f;
+            rocks.MaxScale = 1.6f;
+            rocks.GroundOffset = 0.3f;
+            rocks.Color = DirectX::XMFLOAT4(0.45f, 0.43f, 0.4f, 1.0f);
+
+            m_FoliageRenderer->SetLayers({ trees, bushes, rocks }, chunkConfig.TerrainSettings.Seed);
+            m_FoliageRenderer->SetBiomeDensities(m_ChunkManager->GetBiomeMap());
+        }
+        else
+        {
+            std::cerr << "[Engine] Failed to initialize foliage renderer" << std::endl;
+            m_FoliageRenderer.reset();
+        }
+
         // Force load initial chunks around origin
         m_ChunkManager->ForceLoadAround(DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f), 100.0f);
 
@@ -1069,55 +1549,146 @@ namespace SM
         return true;
     }
 
-    void Engine::UpdateTerrain(const DirectX::XMFLOAT3& cameraPosition)
+    void Engine::UpdateTerrain(const DirectX::XMFLOAT3& cameraPosition, const DirectX::XMMATRIX& viewProjection,
+                               const DirectX::XMFLOAT3& cameraVelocity)
     {
         if (!m_ChunkManager)
         {
             return;
         }
 
-        m_ChunkManager->Update(cameraPosition);
+        SM_PROFILE_SCOPE("Engine::UpdateTerrain");
+        ScopedMemoryTag memoryTag(MemoryTag::PCG);
+        m_ChunkManager->SetLastFrameTime(m_DeltaTime);
+        m_ChunkManager->Update(cameraPosition, viewProjection, cameraVelocity);
+
+        SM_TRACE_COUNTER("Pending Generations", m_ChunkManager->GetPendingCount());
+        SM_TRACE_COUNTER("Visible Chunks", m_ChunkManager->GetVisibleChunks().size());
     }
 
-    void Engine::RenderTerrain()
+    Camera Engine::BuildRendererCamera()
     {
-        if (!m_TerrainRenderer || !m_ChunkManager || !m_Renderer)
+        Camera rendererCamera = m_Renderer->GetCamera();
+        if (!m_GameCamera)
+        {
+            return rendererCamera;
+        }
+
+        // The simulation thread owns GameCamera; draw its ticks interpolated instead
+        if (IsThreadedSimulation())
+        {
+            const DirectX::XMFLOAT3& pos = m_RenderCamera.Position;
+            const DirectX::XMFLOAT3& fwd = m_RenderCamera.Forward;
+
+            rendererCamera.Position = pos;
+            rendererCamera.Target = DirectX::XMFLOAT3(pos.x + fwd.x, pos.y + fwd.y, pos.z + fwd.z);
+            rendererCamera.FarPlane = m_RenderCamera.FarZ;
+            rendererCamera.NearPlane = m_RenderCamera.NearZ;
+            rendererCamera.FieldOfView = m_RenderCamera.FieldOfView * 3.14159265358979323846f / 180.0f;
+            return rendererCamera;
+        }
+
+        // Late-latch mouse look that arrived since Update
+        GameCamera camera = *m_GameCamera;
+        if (m_UseFPSCamera && m_FPSController && Input::Get().IsMouseCaptured())
+        {
+            m_Window->PollRawInput();
+            camera = m_FPSController->GetLateLatchedCamera();
+        }
+
+        // Sync GameCamera to Renderer's Camera
+        DirectX::XMFLOAT3 pos = camera.GetPositionXM();
+        Vector3 fwd = camera.GetForward();
+
+        rendererCamera.Position = pos;
+        rendererCamera.Target = DirectX::XMFLOAT3(
+            pos.x + fwd.x,
+            pos.y + fwd.y,
+            pos.z + fwd.z
+        );
+        rendererCamera.FarPlane = camera.GetFarZ();
+        rendererCamera.NearPlane = camera.GetNearZ();
+        rendererCamera.FieldOfView = camera.GetFOV() * 3.14159265358979323846f / 180.0f;
+
+        return rendererCamera;
+    }
+
+    void Engine::LateLatchCamera()
+    {
+        const bool terrainRecorded = m_TerrainConstantsRecorded;
+        m_TerrainConstantsRecorded = false;
+
+        // Only mouse look moves the view after Update (ticks on their own thread are not latched)
+        if (IsThreadedSimulation() || !m_GameCamera || !m_UseFPSCamera || !m_FPSController || !Input::Get().IsMouseCaptured())
         {
             return;
         }
 
-        // Use GameCamera if available, otherwise fall back to Renderer's camera
-        Camera& rendererCamera = m_Renderer->GetCamera();
+        Camera camera = BuildRendererCamera();
+        m_Renderer->LateLatchCamera(camera);
 
-        if (m_GameCamera)
+        if (terrainRecorded && m_TerrainRenderer)
         {
-            // Sync GameCamera to Renderer's Camera
-            DirectX::XMFLOAT3 pos = m_GameCamera->GetPositionXM();
-            Vector3 fwd = m_GameCamera->GetForward();
+            DirectX::XMMATRIX view = camera.GetViewMatrix();
+            DirectX::XMMATRIX proj = camera.GetProjectionMatrix(m_Renderer->GetAspectRatio());
+            m_TerrainRenderer->LateLatchFrameConstants(DirectX::XMMatrixMultiply(view, proj), camera.Position);
+        }
+    }
 
-            rendererCamera.Position = pos;
-            rendererCamera.Target = DirectX::XMFLOAT3(
-                pos.x + fwd.x,
-                pos.y + fwd.y,
-                pos.z + fwd.z
-            );
-            rendererCamera.FarPlane = m_GameCamera->GetFarZ();
-            rendererCamera.NearPlane = m_GameCamera->GetNearZ();
-            rendererCamera.FieldOfView = m_GameCamera->GetFOV() * 3.14159265358979323846f / 180.0f;
+    void Engine::RenderTerrain()
+    {
+        if (!m_TerrainRenderer || !m_ChunkManager || !m_Renderer)
+        {
+            return;
         }
 
-        m_Renderer->SetCamera(rendererCamera);
+        SM_PROFILE_SCOPE("Engine::RenderTerrain");
+
+        // Use GameCamera if available, otherwise fall back to Renderer's camera
+        Camera& rendererCamera = m_Renderer->GetCamera();
+        rendererCamera = BuildRendererCamera();
 
-        // Update terrain chunks based on camera position
-        UpdateTerrain(rendererCamera.Position);
+        m_Renderer->SetCamera(rendererCamera);
 
         // Calculate view-projection matrix
         DirectX::XMMATRIX view = rendererCamera.GetViewMatrix();
         DirectX::XMMATRIX proj = rendererCamera.GetProjectionMatrix(m_Renderer->GetAspectRatio());
         DirectX::XMMATRIX viewProj = DirectX::XMMatrixMultiply(view, proj);
 
+        // Only the FPS controller translates the camera freely; orbiting stays in place
+        DirectX::XMFLOAT3 cameraVelocity(0.0f, 0.0f, 0.0f);
+        if (IsThreadedSimulation())
+        {
+            cameraVelocity = m_RenderCamera.Velocity;
+        }
+        else if (m_GameCamera && m_UseFPSCamera && m_FPSController)
+        {
+            cameraVelocity = m_FPSController->GetVelocity().ToXMFLOAT3();
+        }
+
+        if (m_CameraPath)
+        {
+            CameraPathSample sample;
+            sample.DeltaTime = m_DeltaTime;
+            sample.Position = rendererCamera.Position;
+            sample.Velocity = cameraVelocity;
+            DirectX::XMStoreFloat4x4(&sample.ViewProjection, viewProj);
+            m_CameraPath->AddSample(sample);
+        }
+
+        // Update terrain chunks and cull them against the camera
+        UpdateTerrain(rendererCamera.Position, viewProj, cameraVelocity);
+
         // Render terrain
         m_TerrainRenderer->RenderTerrain(*m_ChunkManager, viewProj, rendererCamera.Position);
+        m_TerrainConstantsRecorded = true;
+
+        // Scattered foliage on the visible chunks
+        if (m_FoliageRenderer)
+        {
+            m_FoliageRenderer->Update(*m_ChunkManager, rendererCamera.Position);
+            m_FoliageRenderer->Render(*m_ChunkManager, rendererCamera.Position);
+        }
 
 #if defined(_DEBUG)
         // Debug output (every 60 frames)
@@ -1242,8 +1813,18 @@ namespace SM
             m_EditorUI->GetStatsPanel().ToggleVisible();
         }
 
+        // Record the camera path for streaming replays with F9
+        if (!editorWantsKeyboard && input.IsKeyPressed(KeyCode::F9))
+        {
+            ToggleCameraPathRecording();
+        }
+
         // Update camera controllers only if editor doesn't want input
-        if (!editorWantsMouse)
+        if (IsBenchmarkMode())
+        {
+            UpdateBenchmarkCamera();
+        }
+        else if (!editorWantsMouse)
         {
             if (m_UseFPSCamera && m_FPSController)
             {
@@ -1276,6 +1857,252 @@ namespace SM
         }
     }
 
+    void Engine::ToggleCameraPathRecording(const std::string& path)
+    {
+        if (!m_CameraPath)
+        {
+            m_CameraPath = std::make_unique<CameraPath>();
+            ConsolePanel::Get().Log("Recording camera path (F9 to stop)", LogLevel::Info);
+            return;
+        }
+
+        std::unique_ptr<CameraPath> recorded = std::move(m_CameraPath);
+        if (recorded->Save(path))
+        {
+            std::cout << "[Engine] Saved camera path: " << recorded->GetSampleCount() << " frames to "
+                      << path << std::endl;
+            ConsolePanel::Get().Log("Saved camera path to " + path, LogLevel::Info);
+        }
+        else
+        {
+            ConsolePanel::Get().Log("Failed to save camera path to " + path, LogLevel::Error);
+        }
+    }
+
+    // ============================================================================
+    // Benchmark Mode
+    // ============================================================================
+
+    namespace
+    {
+        // Frames run before recording starts, so PSO creation and the first
+        // chunk uploads do not land in the results
+        constexpr uint32_t BENCHMARK_WARMUP_FRAMES = 60;
+
+        // The camera circles the origin once every BENCHMARK_ORBIT_FRAMES frames
+        constexpr uint32_t BENCHMARK_ORBIT_FRAMES = 1800;
+        constexpr float BENCHMARK_ORBIT_RADIUS = 120.0f;
+        constexpr float BENCHMARK_CAMERA_HEIGHT = 70.0f;
+    }
+
+    void Engine::InitializeBenchmark()
+    {
+        std::cout << "[Engine] Benchmark mode: " << m_Config.benchmarkFrames << " frames, "
+                  << m_Config.benchmarkProps << " props, view distance " << m_Config.benchmarkViewDistance
+                  << ", writing " << m_Config.benchmarkOutput << std::endl;
+
+        // Only the scene is measured
+        if (m_EditorUI)
+        {
+            m_EditorUI->SetVisible(false);
+            m_EditorVisible = false;
+        }
+
+        // GPU pass timings come from the profiler's timestamp queries
+        Profiler::Get().SetEnabled(true);
+        Profiler::Get().SetPaused(false);
+
+        // Terrain around the whole orbit is resident before the first frame
+        if (m_ChunkManager)
+        {
+            m_ChunkManager->SetViewDistance(m_Config.benchmarkViewDistance);
+            m_ChunkManager->ForceLoadAround(DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f),
+                BENCHMARK_ORBIT_RADIUS + m_Config.benchmarkViewDistance);
+        }
+
+        // Props on a grid around the origin, resting on the terrain; three meshes
+        // and three materials so the mesh renderer builds several instanced batches
+        if (m_World && m_Config.benchmarkProps > 0)
+        {
+            const MeshID meshes[] = { PrimitiveMesh::Cube, PrimitiveMesh::Sphere, PrimitiveMesh::Cylinder };
+            const Color colors[] = { Color::Red(), Color::Green(), Color::Blue() };
+
+            constexpr float SPACING = 4.0f;
+            const uint32_t perSide = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(m_Config.benchmarkProps))));
+            const float half = static_cast<float>(perSide) * SPACING * 0.5f;
+
+            for (uint32_t i = 0; i < m_Config.benchmarkProps; ++i)
+            {
+                float x = static_cast<float>(i % perSide) * SPACING - half;
+                float z = static_cast<float>(i / perSide) * SPACING - half;
+                float y = m_ChunkManager ? m_ChunkManager->GetHeightAt(x, z) + 0.5f : 0.0f;
+
+                EntityID entity = m_World->CreateEntity();
+                m_World->AddComponent(entity, TransformComponent{ Vector3(x, y, z) });
+                m_World->AddComponent(entity, MeshComponent{ meshes[i % 3] });
+                m_World->AddComponent(entity, MaterialComponent{ colors[(i / 3) % 3] });
+            }
+        }
+
+        m_BenchmarkFrames.reserve(m_Config.benchmarkFrames);
+    }
+
+    void Engine::UpdateBenchmarkCamera()
+    {
+        if (!m_GameCamera)
+        {
+            return;
+        }
+
+        // Driven by the frame count, not time, so every run sees the same views
+        uint32_t frame = m_BenchmarkFrame > BENCHMARK_WARMUP_FRAMES ? m_BenchmarkFrame - BENCHMARK_WARMUP_FRAMES : 0;
+        float angle = 2.0f * 3.14159265358979323846f *
+                      static_cast<float>(frame % BENCHMARK_ORBIT_FRAMES) / static_cast<float>(BENCHMARK_ORBIT_FRAMES);
+
+        m_GameCamera->SetPosition(std::sin(angle) * BENCHMARK_ORBIT_RADIUS, BENCHMARK_CAMERA_HEIGHT,
+                                  std::cos(angle) * BENCHMARK_ORBIT_RADIUS);
+        m_GameCamera->LookAt(0.0f, 0.0f, 0.0f);
+    }
+
+    void Engine::RecordBenchmarkFrame(double cpuFrameMs)
+    {
+        ResolveBenchmarkGPUTimes();
+
+        const uint32_t frame = m_BenchmarkFrame++;
+        if (frame >= BENCHMARK_WARMUP_FRAMES && m_BenchmarkFrames.size() < m_Config.benchmarkFrames)
+        {
+            BenchmarkFrame record;
+            record.ProfilerFrame = Profiler::Get().GetFrameNumber();
+            record.CPUFrameMs = cpuFrameMs;
+
+            if (m_TerrainEnabled && m_TerrainRenderer)
+            {
+                record.DrawCalls += m_TerrainRenderer->GetDrawCallCount();
+                record.Triangles = m_TerrainRenderer->GetRenderedTriangleCount();
+            }
+            if (m_TerrainEnabled && m_FoliageRenderer)
+            {
+                record.DrawCalls += m_FoliageRenderer->GetStats().DrawCalls;
+            }
+            if (m_MeshRenderSystem)
+            {
+                record.DrawCalls += m_MeshRenderSystem->GetStats().Batches;
+                record.Triangles += m_MeshRenderSystem->GetStats().Triangles;
+            }
+
+            DXGI_QUERY_VIDEO_MEMORY_INFO memory = {};
+            if (m_Renderer->GetCore()->QueryVideoMemory(memory))
+            {
+                record.VideoMemoryBytes = memory.CurrentUsage;
+            }
+
+            m_BenchmarkFrames.push_back(record);
+            return;
+        }
+
+        if (m_BenchmarkFrames.size() < m_Config.benchmarkFrames)
+        {
+            return;
+        }
+
+        // GPU times arrive a few frames late; give up on stragglers after a while
+        const bool resolved = std::all_of(m_BenchmarkFrames.begin(), m_BenchmarkFrames.end(),
+            [](const BenchmarkFrame& f) { return f.GPUFrameMs >= 0.0; });
+        const uint32_t drainFrames = frame - BENCHMARK_WARMUP_FRAMES - m_Config.benchmarkFrames;
+        if (!resolved && drainFrames < m_Config.framesInFlight + 8)
+        {
+            return;
+        }
+
+        if (!WriteBenchmarkResults())
+        {
+            m_ExitCode = 1;
+        }
+        RequestShutdown();
+    }
+
+    void Engine::ResolveBenchmarkGPUTimes()
+    {
+        const std::deque<ProfileFrame>& frames = Profiler::Get().GetFrames();
+
+        for (BenchmarkFrame& record : m_BenchmarkFrames)
+        {
+            if (record.GPUFrameMs >= 0.0)
+            {
+                continue;
+            }
+
+            auto it = std::find_if(frames.rbegin(), frames.rend(),
+                [&record](const ProfileFrame& f) { return f.FrameNumber == record.ProfilerFrame; });
+            if (it == frames.rend() || it->GPUEvents.empty())
+            {
+                continue;
+            }
+
+            // First pass start to last pass end on the GPU timeline
+            int64_t start = it->GPUEvents.front().Start;
+            int64_t end = it->GPUEvents.front().End;
+            for (const ProfileEvent& event : it->GPUEvents)
+            {
+                start = std::min(start, event.Start);
+                end = std::max(end, event.End);
+            }
+            record.GPUFrameMs = static_cast<double>(end - start) / 1.0e6;
+        }
+    }
+
+    bool Engine::WriteBenchmarkResults() const
+    {
+        std::ostringstream csv;
+        csv << std::fixed << std::setprecision(3);
+        csv << "frame,cpu_frame_ms,gpu_frame_ms,draw_calls,triangles,vram_mb\n";
+
+        std::vector<double> cpuTimes;
+        std::vector<double> gpuTimes;
+        cpuTimes.reserve(m_BenchmarkFrames.size());
+        gpuTimes.reserve(m_BenchmarkFrames.size());
+
+        for (size_t i = 0; i < m_BenchmarkFrames.size(); ++i)
+        {
+            const BenchmarkFrame& record = m_BenchmarkFrames[i];
+            csv << i << ',' << record.CPUFrameMs << ',';
+            if (record.GPUFrameMs >= 0.0)
+            {
+                csv << record.GPUFrameMs;
+                gpuTimes.push_back(record.GPUFrameMs);
+            }
+            csv << ',' << record.DrawCalls << ',' << record.Triangles << ','
+                << static_cast<double>(record.VideoMemoryBytes) / (1024.0 * 1024.0) << '\n';
+
+            cpuTimes.push_back(record.CPUFrameMs);
+        }
+
+        if (!FileSystem::WriteTextFile(m_Config.benchmarkOutput, csv.str()))
+        {
+            std::cerr << "[Engine] Failed to write benchmark results: " << m_Config.benchmarkOutput << std::endl;
+            return false;
+        }
+
+        // Console summary: median and 95th percentile (nearest rank)
+        auto summarize = [](const char* label, std::vector<double>& times) {
+            if (times.empty())
+            {
+                std::cout << "[Engine] Benchmark " << label << ": no samples" << std::endl;
+                return;
+            }
+            std::sort(times.begin(), times.end());
+            size_t p95 = std::min(times.size() - 1, static_cast<size_t>(std::ceil(times.size() * 0.95)) - 1);
+            std::cout << "[Engine] Benchmark " << label << ": median " << times[times.size() / 2]
+                      << " ms, p95 " << times[p95] << " ms" << std::endl;
+        };
+        summarize("CPU frame", cpuTimes);
+        summarize("GPU frame", gpuTimes);
+
+        std::cout << "[Engine] Wrote " << m_BenchmarkFrames.size() << " frames to "
+                  << m_Config.benchmarkOutput << std::endl;
+        return true;
+    }
+
     // ============================================================================
     // Editor System
     // ============================================================================
@@ -1302,6 +2129,7 @@ namespace SM
             ConsolePanel::Get().Log("Press F1 to toggle editor visibility", LogLevel::Info);
             ConsolePanel::Get().Log("Press F2 to toggle camera mode (FPS/Orbit)", LogLevel::Info);
             ConsolePanel::Get().Log("Press F3 to toggle stats panel", LogLevel::Info);
+            ConsolePanel::Get().Log("Press F9 to record a camera path", LogLevel::Info);
         }
 
         return result;
@@ -1314,20 +2142,32 @@ namespace SM
             return;
         }
 
-        // Begin ImGui frame
-        m_EditorUI->BeginFrame();
+        SM_PROFILE_SCOPE("Engine::RenderEditor");
+        ScopedMemoryTag memoryTag(MemoryTag::Editor);
 
-        // Draw editor UI
-        m_EditorUI->Draw(
-            m_World.get(),
-            m_GameCamera.get(),
-            m_FPSController.get(),
-            m_OrbitController.get(),
-            m_ChunkManager.get()
-        );
+        {
+            // The panels read and edit the ECS, camera and input a tick would be changing
+            std::unique_lock<std::mutex> lock(m_SimulationMutex, std::defer_lock);
+            if (IsThreadedSimulation())
+            {
+                lock.lock();
+            }
+
+            // Begin ImGui frame
+            m_EditorUI->BeginFrame();
 
-        // End ImGui frame
-        m_EditorUI->EndFrame();
+            // Draw editor UI
+            m_EditorUI->Draw(
+                m_World.get(),
+                m_GameCamera.get(),
+                m_FPSController.get(),
+                m_OrbitController.get(),
+                m_ChunkManager.get()
+            );
+
+            // End ImGui frame
+            m_EditorUI->EndFrame();
+        }
 
         // Render ImGui draw data
         ID3D12GraphicsCommandList* commandList = m_Renderer->GetCommandList();
@@ -8,8 +8,12 @@
  * and coordination of all engine subsystems.
  */
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 #include <chrono>
 #include <DirectXMath.h>
 
@@ -17,6 +21,7 @@ namespace PCG
 {
     class ChunkManager;
     class TerrainRenderer;
+    class FoliageRenderer;
 }
 
 // Forward declaration for Editor
@@ -31,6 +36,7 @@ namespace SM
     class GameCamera;
     class FPSCameraController;
     class OrbitCameraController;
+    class CameraPath;
 }
 
 namespace SM
@@ -38,9 +44,12 @@ namespace SM
     // Forward declarations
     class Window;
     class World;
+    class MeshRenderSystem;
     class MemoryManager;
     class ResourceManager;
+    class JobSystem;
     class Renderer;
+    struct Camera;
 
     /**
      * @brief Engine configuration structure
@@ -54,14 +63,42 @@ namespace SM
         int windowHeight = 720;
         bool vsync = true;
         bool fullscreen = false;
+        uint32_t framesInFlight = 2;    // CPU frames ahead of the GPU (2-3); fewer means lower input latency
+        bool rawInputThread = false;    // Read raw mouse input on its own thread, stamped as it arrives
+        bool windowMessageThread = false; // Pump window messages on their own thread so moving or resizing never stalls frames
+        bool dynamicResolution = false; // Scale the scene resolution to hold dynamicResolutionTargetMs of GPU time
+        float dynamicResolutionTargetMs = 16.0f;
+        bool threadedSimulation = false; // Tick input and ECS systems at simulationHz on their own thread; rendering interpolates
+        float simulationHz = 60.0f;
 
         // Memory configuration
         size_t frameStackSize = 4 * 1024 * 1024;       // 4MB per-frame allocations
         size_t persistentStackSize = 16 * 1024 * 1024; // 16MB persistent allocations
+        size_t stackReserveSize = 1024ull * 1024 * 1024; // Stacks grow on demand up to this (0 = fixed sizes above)
+        size_t frameArenaSize = 1 * 1024 * 1024;       // 1MB per thread per buffered frame
+
+        // ECS configuration
+        bool useArchetypeStorage = false; // Group entities by signature in SoA blocks
+        bool parallelSystemUpdates = true; // Run systems with disjoint component access concurrently
+
+        // Job system configuration
+        uint32_t jobWorkerThreads = 0;     // 0 = hardware concurrency - 1 (shared by ECS systems and chunk generation)
 
         // Resource configuration
         uint32_t maxAsyncResourceLoads = 4;
         bool enableHotReload = true; // Only in debug builds
+
+        // Share of the OS video memory budget that unreferenced GPU-bound
+        // resources may stay cached in (0 = unload at the last release)
+        float textureMemoryShare = 0.5f;
+        float meshMemoryShare = 0.25f;
+
+        // Benchmark mode: a scripted scene runs for benchmarkFrames frames,
+        // per-frame timings go to benchmarkOutput (CSV) and the engine exits
+        uint32_t benchmarkFrames = 0;           // 0 = normal interactive run
+        uint32_t benchmarkProps = 1000;         // Instanced ECS props placed on the terrain
+        float benchmarkViewDistance = 300.0f;   // Terrain view distance for the run
+        std::string benchmarkOutput = "benchmark.csv";
     };
 
     /**
@@ -131,6 +168,12 @@ namespace SM
          */
         ResourceManager& GetResourceManager();
 
+        /**
+         * @brief Get the job system
+         * @return Reference to the job system
+         */
+        JobSystem& GetJobSystem();
+
         /**
          * @brief Get the renderer
          * @return Pointer to the renderer, nullptr if not initialized
@@ -185,6 +228,94 @@ namespace SM
          */
         void CalculateTiming();
 
+        // ====================================================================
+        // Threaded Simulation
+        // ====================================================================
+
+        /**
+         * @brief Camera pose published by a simulation tick
+         */
+        struct CameraSnapshot
+        {
+            DirectX::XMFLOAT3 Position = { 0.0f, 0.0f, 0.0f };
+            DirectX::XMFLOAT3 Forward = { 0.0f, 0.0f, 1.0f };
+            DirectX::XMFLOAT3 Velocity = { 0.0f, 0.0f, 0.0f };
+            float NearZ = 0.1f;
+            float FarZ = 1000.0f;
+            float FieldOfView = 45.0f;      // Degrees, as GameCamera stores it
+        };
+
+        /**
+         * @brief Check if input and ECS systems tick on the simulation thread
+         */
+        bool IsThreadedSimulation() const { return m_SimulationThread.joinable(); }
+
+        /**
+         * @brief Start ticking input and ECS systems on their own thread
+         *
+         * The main thread keeps the window and becomes the render thread.
+         * Not used for benchmark runs, whose camera follows the frame count.
+         */
+        void StartSimulationThread();
+
+        /**
+         * @brief Stop and join the simulation thread
+         */
+        void StopSimulationThread();
+
+        /**
+         * @brief Simulation thread body: fixed-timestep ticks paced by the clock
+         */
+        void SimulationLoop();
+
+        /**
+         * @brief Advance input, camera and ECS systems by one fixed step and publish the result
+         * @param step Tick length in seconds
+         * @param tickTime Time the tick stands for, used to interpolate it
+         */
+        void SimulationTick(float step, std::chrono::high_resolution_clock::time_point tickTime);
+
+        /**
+         * @brief Render-thread half of a threaded frame: resource uploads and the interpolated snapshot
+         */
+        void UpdateFromSimulation();
+
+        // ====================================================================
+        // Benchmark Mode
+        // ====================================================================
+
+        /**
+         * @brief Check if the engine runs the scripted benchmark scene
+         */
+        bool IsBenchmarkMode() const { return m_Config.benchmarkFrames > 0; }
+
+        /**
+         * @brief Set up the benchmark scene: view distance, preloaded terrain and props
+         */
+        void InitializeBenchmark();
+
+        /**
+         * @brief Place the camera for the current benchmark frame
+         */
+        void UpdateBenchmarkCamera();
+
+        /**
+         * @brief Record the frame just rendered, and finish the run once every GPU time is in
+         * @param cpuFrameMs Wall time of the frame's update, render and present
+         */
+        void RecordBenchmarkFrame(double cpuFrameMs);
+
+        /**
+         * @brief Copy GPU frame times the profiler has read back into recorded frames
+         */
+        void ResolveBenchmarkGPUTimes();
+
+        /**
+         * @brief Write the recorded frames to the configured CSV
+         * @return true on success
+         */
+        bool WriteBenchmarkResults() const;
+
         /**
          * @brief Initialize the memory management system
          * @return true if successful
@@ -197,6 +328,11 @@ namespace SM
          */
         bool InitializeResources();
 
+        /**
+         * @brief Rebuild the renderers' shaders after a .hlsl edit (hot reload)
+         */
+        void ReloadShaders(const std::vector<std::string>& changedFiles);
+
         /**
          * @brief Initialize the ECS system and register components
          */
@@ -242,16 +378,31 @@ namespace SM
         bool InitializeTerrain();
 
         /**
-         * @brief Update terrain system (chunk loading/unloading)
+         * @brief Update terrain system (chunk loading/unloading, culling)
          * @param cameraPosition Current camera position
+         * @param viewProjection Camera view-projection for chunk culling
+         * @param cameraVelocity Camera velocity in units per second, for prefetching ahead
          */
-        void UpdateTerrain(const DirectX::XMFLOAT3& cameraPosition);
+        void UpdateTerrain(const DirectX::XMFLOAT3& cameraPosition, const DirectX::XMMATRIX& viewProjection,
+                           const DirectX::XMFLOAT3& cameraVelocity);
 
         /**
          * @brief Render procedural terrain
          */
         void RenderTerrain();
 
+        /**
+         * @brief Build the renderer camera from GameCamera plus mouse look read since Update
+         *
+         * With a simulation thread, from the camera interpolated between its last two ticks.
+         */
+        Camera BuildRendererCamera();
+
+        /**
+         * @brief Move the recorded frame to the latest camera pose (renderer pre-submit callback)
+         */
+        void LateLatchCamera();
+
         /**
          * @brief Initialize input system and bindings
          */
@@ -280,6 +431,20 @@ namespace SM
          */
         OrbitCameraController* GetOrbitController() const { return m_OrbitController.get(); }
 
+        /**
+         * @brief Start recording the terrain camera path, or stop and save it
+         * @param path File written when recording stops
+         *
+         * Each frame's ChunkManager::Update inputs are recorded for replay
+         * by the StreamingReplay benchmark.
+         */
+        void ToggleCameraPathRecording(const std::string& path = "camera_path.smcam");
+
+        /**
+         * @brief Check if the camera path is being recorded
+         */
+        bool IsRecordingCameraPath() const { return m_CameraPath != nullptr; }
+
         /**
          * @brief Get the editor UI
          * @return Pointer to editor UI (may be nullptr)
@@ -310,7 +475,7 @@ namespace SM
 
     private:
         // Engine state
-        bool m_IsRunning = false;
+        std::atomic<bool> m_IsRunning = false;  // The simulation thread may request shutdown
         bool m_IsInitialized = false;
 
         // Timing
@@ -326,10 +491,12 @@ namespace SM
         std::unique_ptr<Window> m_Window;
         std::unique_ptr<World> m_World;
         std::unique_ptr<Renderer> m_Renderer;
+        MeshRenderSystem* m_MeshRenderSystem = nullptr;    // Owned by m_World
 
         // Terrain systems
         std::unique_ptr<PCG::ChunkManager> m_ChunkManager;
         std::unique_ptr<PCG::TerrainRenderer> m_TerrainRenderer;
+        std::unique_ptr<PCG::FoliageRenderer> m_FoliageRenderer;
         bool m_TerrainEnabled = true;
 
         // Camera systems
@@ -337,14 +504,42 @@ namespace SM
         std::unique_ptr<FPSCameraController> m_FPSController;
         std::unique_ptr<OrbitCameraController> m_OrbitController;
         bool m_UseFPSCamera = true;  // Toggle between FPS and Orbit camera
+        std::unique_ptr<CameraPath> m_CameraPath;   // Set while recording (F9)
+        bool m_TerrainConstantsRecorded = false;    // Terrain constants of the frame being recorded may be late-latched
 
         // Editor system
         std::unique_ptr<EditorUI> m_EditorUI;
         bool m_EditorVisible = true;
 
         // Timing for stats
-        float m_UpdateTime = 0.0f;
+        std::atomic<float> m_UpdateTime = 0.0f;    // Written by the simulation thread when threaded
         float m_RenderTime = 0.0f;
+        uint64_t m_TracedUploadBytes = 0;           // Upload queue total at the last "Upload Bytes" counter
+        uint64_t m_TracedUploadSubmissions = 0;     // Submission total at the last "Upload Submissions" counter
+
+        // Threaded simulation
+        std::thread m_SimulationThread;
+        std::atomic<bool> m_SimulationRunning = false;
+        std::mutex m_SimulationMutex;               // Held by ticks, message pumping and the editor, which share the ECS and input
+        std::mutex m_SnapshotMutex;                 // Guards the published snapshots below
+        CameraSnapshot m_CameraSnapshots[2];        // Previous and latest tick
+        std::chrono::high_resolution_clock::time_point m_SnapshotTime;   // Time of the latest tick
+        uint64_t m_SnapshotTicks = 0;               // Ticks published so far
+        CameraSnapshot m_RenderCamera;              // Interpolated for the frame being rendered
+
+        // Benchmark mode
+        struct BenchmarkFrame
+        {
+            uint64_t ProfilerFrame = 0;     // Profiler frame the GPU time is read from
+            double CPUFrameMs = 0.0;
+            double GPUFrameMs = -1.0;       // < 0 until the timestamps are read back
+            uint32_t DrawCalls = 0;
+            uint32_t Triangles = 0;
+            uint64_t VideoMemoryBytes = 0;
+        };
+        std::vector<BenchmarkFrame> m_BenchmarkFrames;
+        uint32_t m_BenchmarkFrame = 0;      // Frames run, warm-up included
+        int m_ExitCode = 0;
 
         // Configuration
         EngineConfig m_Config;
@@ -4,12 +4,18 @@
 #include <sstream>
 #include <iostream>
 #include <algorithm>
+#include <utility>
 
 #ifdef _WIN32
 #ifndef WIN32_LEAN_AND_MEAN
 #define WIN32_LEAN_AND_MEAN
 #endif
 #include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 
 namespace SM
@@ -98,6 +104,13 @@ namespace SM
         return buffer.str();
     }
 
+    MappedFile FileSystem::MapFile(const std::string& path)
+    {
+        MappedFile file;
+        file.Open(path);
+        return file;
+    }
+
     bool FileSystem::ReadFileWithError(
         const std::string& path,
         std::vector<uint8_t>& outData,
@@ -657,4 +670,128 @@ namespace SM
 #endif
     }
 
+    // ============================================================================
+    // Memory-Mapped Files
+    // ============================================================================
+
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Close();
+
+            m_Data = std::exchange(other.m_Data, nullptr);
+            m_Size = std::exchange(other.m_Size, 0);
+#ifdef _WIN32
+            m_File = std::exchange(other.m_File, nullptr);
+            m_Mapping = std::exchange(other.m_Mapping, nullptr);
+#endif
+        }
+        return *this;
+    }
+
+    bool MappedFile::Open(const std::string& path)
+    {
+        Close();
+
+#ifdef _WIN32
+        std::wstring widePath = FileSystem::StringToWString(path);
+        HANDLE file = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+
+        LARGE_INTEGER size = {};
+        if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0)
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping)
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view)
+        {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        m_File = file;
+        m_Mapping = mapping;
+        m_Data = static_cast<const uint8_t*>(view);
+        m_Size = static_cast<size_t>(size.QuadPart);
+        return true;
+#else
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        struct stat info = {};
+        if (fstat(fd, &info) != 0 || info.st_size <= 0)
+        {
+            close(fd);
+            return false;
+        }
+
+        void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (view == MAP_FAILED)
+        {
+            return false;
+        }
+
+        m_Data = static_cast<const uint8_t*>(view);
+        m_Size = static_cast<size_t>(info.st_size);
+        return true;
+#endif
+    }
+
+    void MappedFile::Close()
+    {
+#ifdef _WIN32
+        if (m_Data)
+        {
+            UnmapViewOfFile(m_Data);
+        }
+        if (m_Mapping)
+        {
+            CloseHandle(static_cast<HANDLE>(m_Mapping));
+        }
+        if (m_File)
+        {
+            CloseHandle(static_cast<HANDLE>(m_File));
+        }
+        m_Mapping = nullptr;
+        m_File = nullptr;
+#else
+        if (m_Data)
+        {
+            munmap(const_cast<uint8_t*>(m_Data), m_Size);
+        }
+#endif
+        m_Data = nullptr;
+        m_Size = 0;
+    }
+
 } // namespace SM
@@ -13,9 +13,12 @@
 #include <vector>
 #include <optional>
 #include <filesystem>
+#include <span>
 
 namespace SM
 {
+    class MappedFile;
+
     /**
      * @brief File system utility functions
      *
@@ -43,6 +46,16 @@ namespace SM
          */
         static std::vector<uint8_t> ReadFile(const std::wstring& path);
 
+        /**
+         * @brief Map an entire file read-only instead of copying it
+         * @param path Path to the file
+         * @return Mapping, not open if the file could not be mapped (or is empty)
+         *
+         * Prefer over ReadFile for large files that are parsed once: the OS
+         * pages the bytes in on demand and no heap copy is made.
+         */
+        static MappedFile MapFile(const std::string& path);
+
         /**
          * @brief Read entire file as text string
          * @param path Path to the file
@@ -380,4 +393,66 @@ namespace SM
         FileSystem() = delete; // Static class
     };
 
+    /**
+     * @brief Read-only memory mapping of a whole file
+     *
+     * The view stays valid until Close or destruction. Writing to the file
+     * while it is mapped is platform-dependent (Windows refuses to truncate
+     * or extend it), so close the mapping before modifying the file.
+     */
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        // Prevent copying
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        // Allow moving (ownership of the mapping transfers)
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        /**
+         * @brief Map a file for reading
+         * @param path File path
+         * @return true if successful (empty files cannot be mapped)
+         */
+        bool Open(const std::string& path);
+
+        /**
+         * @brief Unmap the file
+         */
+        void Close();
+
+        /**
+         * @brief Check if a file is mapped
+         */
+        bool IsOpen() const { return m_Data != nullptr; }
+
+        /**
+         * @brief Get the mapped bytes
+         */
+        const uint8_t* GetData() const { return m_Data; }
+
+        /**
+         * @brief Get the mapped size in bytes
+         */
+        size_t GetSize() const { return m_Size; }
+
+        /**
+         * @brief Get the mapped bytes as a span (empty when not open)
+         */
+        std::span<const uint8_t> GetBytes() const { return { m_Data, m_Size }; }
+
+    private:
+        const uint8_t* m_Data = nullptr;
+        size_t m_Size = 0;
+#ifdef _WIN32
+        void* m_File = nullptr;       ///< HANDLE from CreateFileW
+        void* m_Mapping = nullptr;    ///< HANDLE from CreateFileMappingW
+#endif
+    };
+
 } // namespace SM
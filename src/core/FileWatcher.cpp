@@ -0,0 +1,291 @@
+#include "core/FileWatcher.h"
+#include "core/FileSystem.h"
+
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <Windows.h>
+#endif
+
+namespace SM
+{
+#ifdef _WIN32
+    namespace
+    {
+        constexpr ULONG_PTR STOP_KEY = 1;               // Posted by Stop
+        constexpr DWORD NOTIFY_BUFFER_SIZE = 64 * 1024; // Larger buffers fail on network shares
+        constexpr DWORD NOTIFY_FILTER = FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME |
+                                        FILE_NOTIFY_CHANGE_SIZE;
+    }
+
+    struct FileWatcher::WatchedDirectory
+    {
+        OVERLAPPED Overlapped = {};     // First member: completion packets point here
+        HANDLE Handle = INVALID_HANDLE_VALUE;
+        std::string Key;                ///< MakeKey of the directory
+        bool Pending = false;           ///< A ReadDirectoryChangesW is outstanding
+        alignas(DWORD) uint8_t Buffer[NOTIFY_BUFFER_SIZE];
+    };
+#endif
+
+    FileWatcher::~FileWatcher()
+    {
+        Stop();
+    }
+
+    bool FileWatcher::IsSupported()
+    {
+#ifdef _WIN32
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    std::string FileWatcher::MakeKey(const std::string& path)
+    {
+        std::string key = FileSystem::NormalizePath(FileSystem::GetAbsolutePath(path));
+        std::transform(key.begin(), key.end(), key.begin(),
+            [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        while (!key.empty() && key.back() == '/')
+        {
+            key.pop_back();
+        }
+        return key;
+    }
+
+    bool FileWatcher::AddDirectory(const std::string& directory)
+    {
+        if (!FileSystem::IsDirectory(directory))
+        {
+            return false;
+        }
+
+        std::string absolute = FileSystem::GetAbsolutePath(directory);
+        if (std::find(m_Directories.begin(), m_Directories.end(), absolute) != m_Directories.end())
+        {
+            return true;
+        }
+        m_Directories.push_back(std::move(absolute));
+
+        if (IsRunning())
+        {
+            Stop();
+            Start();
+        }
+        return true;
+    }
+
+    size_t FileWatcher::CollectChanges(std::vector<std::string>& outPaths, double settleSeconds)
+    {
+        const Clock::time_point settledBefore = Clock::now() -
+            std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(settleSeconds));
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        size_t count = 0;
+        for (auto it = m_Changes.begin(); it != m_Changes.end();)
+        {
+            if (it->second <= settledBefore)
+            {
+                outPaths.push_back(it->first);
+                it = m_Changes.erase(it);
+                ++count;
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        return count;
+    }
+
+    void FileWatcher::RecordChange(std::string key)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Changes[std::move(key)] = Clock::now();
+    }
+
+#ifdef _WIN32
+
+    // ============================================================================
+    // ReadDirectoryChangesW Backend
+    // ============================================================================
+
+    bool FileWatcher::Start()
+    {
+        if (IsRunning())
+        {
+            return true;
+        }
+
+        m_CompletionPort = CreateIoCompletionPort(INVALID_HANDLE_VALUE, nullptr, 0, 1);
+        if (!m_CompletionPort)
+        {
+            std::cerr << "[FileWatcher] Failed to create I/O completion port" << std::endl;
+            return false;
+        }
+
+        for (const std::string& directory : m_Directories)
+        {
+            auto* watch = new WatchedDirectory();
+            watch->Key = MakeKey(directory);
+
+            std::wstring widePath = FileSystem::StringToWString(directory);
+            watch->Handle = CreateFileW(widePath.c_str(), FILE_LIST_DIRECTORY,
+                FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+
+            if (watch->Handle == INVALID_HANDLE_VALUE ||
+                !CreateIoCompletionPort(watch->Handle, static_cast<HANDLE>(m_CompletionPort),
+                                        reinterpret_cast<ULONG_PTR>(watch), 0) ||
+                !IssueRead(watch))
+            {
+                std::cerr << "[FileWatcher] Failed to watch " << directory << std::endl;
+                if (watch->Handle != INVALID_HANDLE_VALUE)
+                {
+                    CloseHandle(watch->Handle);
+                }
+                delete watch;
+                continue;
+            }
+
+            m_Watches.push_back(watch);
+        }
+
+        if (m_Watches.empty())
+        {
+            CloseHandle(static_cast<HANDLE>(m_CompletionPort));
+            m_CompletionPort = nullptr;
+            return false;
+        }
+
+        m_Thread = std::thread(&FileWatcher::ThreadLoop, this);
+        return true;
+    }
+
+    void FileWatcher::Stop()
+    {
+        if (!IsRunning())
+        {
+            return;
+        }
+
+        PostQueuedCompletionStatus(static_cast<HANDLE>(m_CompletionPort), 0, STOP_KEY, nullptr);
+        m_Thread.join();
+
+        for (WatchedDirectory* watch : m_Watches)
+        {
+            CloseHandle(watch->Handle);
+            delete watch;
+        }
+        m_Watches.clear();
+
+        CloseHandle(static_cast<HANDLE>(m_CompletionPort));
+        m_CompletionPort = nullptr;
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Changes.clear();
+    }
+
+    bool FileWatcher::IssueRead(WatchedDirectory* watch)
+    {
+        watch->Overlapped = {};
+        watch->Pending = ReadDirectoryChangesW(watch->Handle, watch->Buffer, NOTIFY_BUFFER_SIZE, TRUE,
+                                               NOTIFY_FILTER, nullptr, &watch->Overlapped, nullptr) != FALSE;
+        return watch->Pending;
+    }
+
+    void FileWatcher::ThreadLoop()
+    {
+        HANDLE port = static_cast<HANDLE>(m_CompletionPort);
+        bool stopping = false;
+
+        for (;;)
+        {
+            DWORD bytes = 0;
+            ULONG_PTR key = 0;
+            OVERLAPPED* overlapped = nullptr;
+            BOOL ok = GetQueuedCompletionStatus(port, &bytes, &key, &overlapped, INFINITE);
+
+            if (key == STOP_KEY)
+            {
+                // Abort outstanding reads, then drain their completions so
+                // no buffer is freed while the kernel may still write it
+                stopping = true;
+                for (WatchedDirectory* watch : m_Watches)
+                {
+                    if (watch->Pending)
+                    {
+                        CancelIoEx(watch->Handle, &watch->Overlapped);
+                    }
+                }
+            }
+            else if (overlapped)
+            {
+                auto* watch = reinterpret_cast<WatchedDirectory*>(overlapped);
+                watch->Pending = false;
+
+                if (ok && !stopping)
+                {
+                    if (bytes == 0)
+                    {
+                        // Buffer overflowed; the individual events are gone
+                        m_Overflowed = true;
+                    }
+
+                    for (DWORD offset = 0; bytes != 0;)
+                    {
+                        auto* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(watch->Buffer + offset);
+                        if (info->Action == FILE_ACTION_ADDED || info->Action == FILE_ACTION_MODIFIED ||
+                            info->Action == FILE_ACTION_RENAMED_NEW_NAME)
+                        {
+                            std::wstring name(info->FileName, info->FileNameLength / sizeof(WCHAR));
+                            std::string relative = FileSystem::NormalizePath(FileSystem::WStringToString(name));
+                            std::transform(relative.begin(), relative.end(), relative.begin(),
+                                [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+                            RecordChange(watch->Key + "/" + relative);
+                        }
+
+                        if (info->NextEntryOffset == 0)
+                        {
+                            break;
+                        }
+                        offset += info->NextEntryOffset;
+                    }
+
+                    IssueRead(watch);
+                }
+            }
+
+            if (stopping && std::none_of(m_Watches.begin(), m_Watches.end(),
+                                         [](const WatchedDirectory* watch) { return watch->Pending; }))
+            {
+                break;
+            }
+        }
+    }
+
+#else
+
+    bool FileWatcher::Start()
+    {
+        return false;
+    }
+
+    void FileWatcher::Stop()
+    {
+    }
+
+    void FileWatcher::ThreadLoop()
+    {
+    }
+
+#endif
+
+} // namespace SM
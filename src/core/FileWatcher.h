@@ -0,0 +1,123 @@
+#pragma once
+
+/**
+ * @file FileWatcher.h
+ * @brief Shattered Moon Engine - Directory change notifications
+ *
+ * Watches directory trees for written, created and renamed files so hot
+ * reload reacts to edits instead of stat-ing every loaded file. On Windows
+ * one thread waits on overlapped ReadDirectoryChangesW calls through an
+ * I/O completion port. Other platforms have no backend; IsSupported
+ * returns false and callers keep polling.
+ *
+ * Editors often save a file in several writes, so changes are debounced:
+ * a path is reported once no new event has arrived for it for the settle
+ * time passed to CollectChanges.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace SM
+{
+    /**
+     * @brief Recursive watcher over a set of directories
+     *
+     * Example usage:
+     * @code
+     *   FileWatcher watcher;
+     *   watcher.AddDirectory("assets");
+     *   watcher.Start();
+     *
+     *   // Once per frame
+     *   std::vector<std::string> changed;
+     *   watcher.CollectChanges(changed, 0.25);
+     * @endcode
+     */
+    class FileWatcher
+    {
+    public:
+        FileWatcher() = default;
+        ~FileWatcher();
+
+        // Non-copyable
+        FileWatcher(const FileWatcher&) = delete;
+        FileWatcher& operator=(const FileWatcher&) = delete;
+
+        /**
+         * @brief Check if this platform has a watcher backend
+         */
+        static bool IsSupported();
+
+        /**
+         * @brief Watch a directory and everything below it
+         * @param directory Existing directory
+         * @return false if the directory does not exist
+         *
+         * Restarts the watcher if it is running.
+         */
+        bool AddDirectory(const std::string& directory);
+
+        /**
+         * @brief Start watching the added directories
+         * @return false if unsupported or no directory could be opened
+         */
+        bool Start();
+
+        /**
+         * @brief Stop watching; pending changes are dropped
+         */
+        void Stop();
+
+        bool IsRunning() const { return m_Thread.joinable(); }
+
+        /**
+         * @brief Take the paths whose changes have settled
+         * @param outPaths Receives absolute paths, forward slashes, lower case
+         * @param settleSeconds Quiet time a path needs before it is reported
+         * @return Number of paths appended
+         */
+        size_t CollectChanges(std::vector<std::string>& outPaths, double settleSeconds);
+
+        /**
+         * @brief Check and clear the overflow flag
+         * @return true if events were lost since the last call (too many
+         *         changes at once); the caller should rescan everything
+         */
+        bool ConsumeOverflow() { return m_Overflowed.exchange(false); }
+
+        /**
+         * @brief Build the key CollectChanges reports for a path
+         */
+        static std::string MakeKey(const std::string& path);
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        void ThreadLoop();
+        void RecordChange(std::string key);
+
+    private:
+        std::vector<std::string> m_Directories;     ///< Absolute, as added
+        std::thread m_Thread;
+        std::atomic<bool> m_Overflowed{ false };
+
+        std::mutex m_Mutex;
+        std::unordered_map<std::string, Clock::time_point> m_Changes;  // Key -> last event
+
+#ifdef _WIN32
+        struct WatchedDirectory;
+        void* m_CompletionPort = nullptr;           ///< HANDLE from CreateIoCompletionPort
+        std::vector<WatchedDirectory*> m_Watches;   // Owned; touched by the thread while running
+
+        bool IssueRead(WatchedDirectory* watch);
+#endif
+    };
+
+} // namespace SM
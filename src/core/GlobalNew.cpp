@@ -0,0 +1,83 @@
+/**
+ * @file GlobalNew.cpp
+ * @brief Replaces the global operator new/delete with GeneralAllocator
+ *
+ * Compiled into the executable only when SM_REPLACE_GLOBAL_NEW is on, so
+ * every allocation in the program (STL containers included) goes through the
+ * size-class heap and is counted under the allocating thread's MemoryTag.
+ * Replacement functions must live in exactly one translation unit of the
+ * final link, which is why this file is not part of ShatteredMoonCore.
+ */
+
+#include "core/Memory.h"
+
+#include <new>
+
+namespace
+{
+    void* AllocateOrThrow(size_t size, size_t alignment)
+    {
+        void* ptr = SM::GeneralAllocator::Allocate(size, alignment);
+        if (!ptr)
+        {
+            throw std::bad_alloc();
+        }
+        return ptr;
+    }
+
+    constexpr size_t NEW_ALIGNMENT = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+}
+
+// ============================================================================
+// Allocation
+// ============================================================================
+
+void* operator new(size_t size) { return AllocateOrThrow(size, NEW_ALIGNMENT); }
+void* operator new[](size_t size) { return AllocateOrThrow(size, NEW_ALIGNMENT); }
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    return AllocateOrThrow(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+    return AllocateOrThrow(size, static_cast<size_t>(alignment));
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return SM::GeneralAllocator::Allocate(size, NEW_ALIGNMENT);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return SM::GeneralAllocator::Allocate(size, NEW_ALIGNMENT);
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return SM::GeneralAllocator::Allocate(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return SM::GeneralAllocator::Allocate(size, static_cast<size_t>(alignment));
+}
+
+// ============================================================================
+// Deallocation (size and alignment are recovered from the span)
+// ============================================================================
+
+void operator delete(void* ptr) noexcept { SM::GeneralAllocator::Free(ptr); }
+void operator delete[](void* ptr) noexcept { SM::GeneralAllocator::Free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { SM::GeneralAllocator::Free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { SM::GeneralAllocator::Free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { SM::GeneralAllocator::Free(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { SM::GeneralAllocator::Free(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { SM::GeneralAllocator::Free(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { SM::GeneralAllocator::Free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { SM::GeneralAllocator::Free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { SM::GeneralAllocator::Free(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { SM::GeneralAllocator::Free(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { SM::GeneralAllocator::Free(ptr); }
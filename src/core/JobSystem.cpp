@@ -0,0 +1,515 @@
+#include "core/JobSystem.h"
+#include "core/Profiler.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace SM
+{
+    namespace
+    {
+        constexpr uint32_t NOT_A_WORKER = ~0u;
+
+        /// Index of the worker the current thread runs, NOT_A_WORKER elsewhere
+        thread_local uint32_t t_WorkerIndex = NOT_A_WORKER;
+    }
+
+    // ============================================================================
+    // Work-Stealing Deque Implementation
+    // ============================================================================
+
+    bool WorkStealingDeque::Push(Job* job)
+    {
+        int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+        int64_t top = m_Top.load(std::memory_order_acquire);
+        if (bottom - top >= CAPACITY)
+        {
+            return false;
+        }
+
+        m_Buffer[bottom & MASK].store(job, std::memory_order_relaxed);
+        m_Bottom.store(bottom + 1, std::memory_order_release);
+        return true;
+    }
+
+    Job* WorkStealingDeque::Pop()
+    {
+        // Claim the bottom slot before looking at top, so a concurrent thief sees it taken
+        int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+        m_Bottom.store(bottom, std::memory_order_seq_cst);
+        int64_t top = m_Top.load(std::memory_order_seq_cst);
+
+        if (top > bottom)
+        {
+            // Empty
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        Job* job = m_Buffer[bottom & MASK].load(std::memory_order_relaxed);
+        if (top == bottom)
+        {
+            // Last job: race thieves for it
+            if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                job = nullptr;
+            }
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return job;
+    }
+
+    Job* WorkStealingDeque::Steal()
+    {
+        int64_t top = m_Top.load(std::memory_order_seq_cst);
+        int64_t bottom = m_Bottom.load(std::memory_order_seq_cst);
+        if (top >= bottom)
+        {
+            return nullptr;
+        }
+
+        Job* job = m_Buffer[top & MASK].load(std::memory_order_relaxed);
+        if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            return nullptr;
+        }
+        return job;
+    }
+
+    // ============================================================================
+    // Job System Implementation
+    // ============================================================================
+
+    JobSystem& JobSystem::Get()
+    {
+        static JobSystem instance;
+        return instance;
+    }
+
+    JobSystem::~JobSystem()
+    {
+        Shutdown();
+    }
+
+    bool JobSystem::Initialize(uint32_t workerCount)
+    {
+        if (IsInitialized())
+        {
+            return true;
+        }
+
+        if (workerCount == 0)
+        {
+            uint32_t hardwareThreads = std::thread::hardware_concurrency();
+            workerCount = std::max<uint32_t>(1, hardwareThreads > 1 ? hardwareThreads - 1 : 1);
+        }
+
+        m_StopRequested = false;
+        m_QueuedCount = 0;
+        m_SleepingCount = 0;
+        m_BackgroundQueued = 0;
+        m_BackgroundRunning = 0;
+        m_MaxBackgroundRunning = std::max<uint32_t>(1, workerCount - 1);
+
+        m_Workers.clear();
+        for (uint32_t i = 0; i < workerCount; ++i)
+        {
+            m_Workers.push_back(std::make_unique<Worker>());
+        }
+
+        m_Threads.reserve(workerCount);
+        for (uint32_t i = 0; i < workerCount; ++i)
+        {
+            m_Threads.emplace_back(&JobSystem::WorkerLoop, this, i);
+        }
+
+        m_LastSampleTime = std::chrono::steady_clock::now();
+
+        std::cout << "[JobSystem] Started " << workerCount << " worker threads" << std::endl;
+
+        return true;
+    }
+
+    void JobSystem::Shutdown()
+    {
+        if (!IsInitialized())
+        {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_WakeMutex);
+            m_StopRequested = true;
+        }
+        m_WakeCondition.notify_all();
+
+        for (std::thread& thread : m_Threads)
+        {
+            if (thread.joinable())
+            {
+                thread.join();
+            }
+        }
+        m_Threads.clear();
+
+        // Recycle jobs that never ran; their counters will not reach zero
+        for (auto& worker : m_Workers)
+        {
+            while (Job* job = worker->Deque.Pop())
+            {
+                m_JobPool.Release(job);
+            }
+        }
+        m_Workers.clear();
+
+        {
+            std::lock_guard<std::mutex> lock(m_InjectionMutex);
+            for (Job* job : m_InjectionQueue)
+            {
+                m_JobPool.Release(job);
+            }
+            m_InjectionQueue.clear();
+            m_InjectionCount = 0;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_BackgroundMutex);
+            for (Job* job : m_BackgroundQueue)
+            {
+                m_JobPool.Release(job);
+            }
+            m_BackgroundQueue.clear();
+            m_BackgroundQueued = 0;
+            m_BackgroundRunning = 0;
+        }
+
+        m_QueuedCount = 0;
+    }
+
+    Job* JobSystem::CreateJob(JobFunc function, JobCounter* counter)
+    {
+        if (counter)
+        {
+            counter->Pending.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        return m_JobPool.Acquire(std::move(function), counter);
+    }
+
+    bool JobSystem::AddDependency(Job* job, Job* prerequisite)
+    {
+        if (!job || !prerequisite || job == prerequisite)
+        {
+            return false;
+        }
+
+        if (prerequisite->ContinuationCount >= Job::MAX_CONTINUATIONS)
+        {
+            std::cerr << "[JobSystem] Too many dependents on one job (max "
+                      << Job::MAX_CONTINUATIONS << ")" << std::endl;
+            return false;
+        }
+
+        prerequisite->Continuations[prerequisite->ContinuationCount++] = job;
+        job->PendingDependencies.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void JobSystem::Submit(Job* job)
+    {
+        if (!job)
+        {
+            return;
+        }
+
+        // Drop the submission hold; the last of it and the prerequisites makes the job runnable
+        if (job->PendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            Enqueue(job);
+        }
+    }
+
+    void JobSystem::RunBackground(JobFunc function, JobCounter* counter)
+    {
+        Job* job = CreateJob(std::move(function), counter);
+        job->Background = true;
+        Submit(job);
+    }
+
+    void JobSystem::Wait(JobCounter& counter)
+    {
+        uint32_t workerIndex = (t_WorkerIndex < GetWorkerCount()) ? t_WorkerIndex : GetWorkerCount();
+
+        while (!counter.IsDone())
+        {
+            bool stolen = false;
+            if (Job* job = FindJob(workerIndex, stolen))
+            {
+                Execute(job, workerIndex, stolen);
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void JobSystem::ParallelFor(uint32_t count, uint32_t grainSize, const RangeFunc& function)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        if (grainSize == 0)
+        {
+            uint32_t ways = std::max<uint32_t>(1, GetWorkerCount() + 1);
+            grainSize = std::max<uint32_t>(1, (count + ways - 1) / ways);
+        }
+
+        if (grainSize >= count || !IsInitialized())
+        {
+            function(0, count);
+            return;
+        }
+
+        JobCounter counter;
+        for (uint32_t begin = grainSize; begin < count; begin += grainSize)
+        {
+            uint32_t end = std::min(count, begin + grainSize);
+            Run([&function, begin, end]() { function(begin, end); }, &counter);
+        }
+
+        // First range on the calling thread, then help with the rest
+        function(0, grainSize);
+        Wait(counter);
+    }
+
+    void JobSystem::SampleWorkerStats(std::vector<JobWorkerStats>& out)
+    {
+        auto now = std::chrono::steady_clock::now();
+        double elapsed = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_LastSampleTime).count());
+        m_LastSampleTime = now;
+
+        out.resize(m_Workers.size());
+        for (size_t i = 0; i < m_Workers.size(); ++i)
+        {
+            Worker& worker = *m_Workers[i];
+            uint64_t busy = worker.BusyNanoseconds.load(std::memory_order_relaxed);
+
+            JobWorkerStats& stats = out[i];
+            stats.JobsExecuted = worker.JobsExecuted.load(std::memory_order_relaxed);
+            stats.JobsStolen = worker.JobsStolen.load(std::memory_order_relaxed);
+            stats.Utilization = elapsed > 0.0
+                ? std::min(1.0f, static_cast<float>((busy - worker.SampledBusyNanoseconds) / elapsed))
+                : 0.0f;
+
+            worker.SampledBusyNanoseconds = busy;
+        }
+    }
+
+    void JobSystem::WorkerLoop(uint32_t workerIndex)
+    {
+        t_WorkerIndex = workerIndex;
+        SM_PROFILE_THREAD("Job Worker " + std::to_string(workerIndex));
+
+        while (true)
+        {
+            bool stolen = false;
+            if (Job* job = FindJob(workerIndex, stolen))
+            {
+                Execute(job, workerIndex, stolen);
+                continue;
+            }
+
+            // Background work only once nothing else is runnable
+            if (Job* job = FindBackgroundJob())
+            {
+                Execute(job, workerIndex, false);
+                m_BackgroundRunning.fetch_sub(1, std::memory_order_seq_cst);
+                WakeWorker();   // A queued background job may start now
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_WakeMutex);
+            m_SleepingCount.fetch_add(1, std::memory_order_seq_cst);
+            m_WakeCondition.wait(lock, [this]() {
+                return m_StopRequested.load() || m_QueuedCount.load(std::memory_order_seq_cst) > 0 ||
+                       CanStartBackgroundJob();
+            });
+            m_SleepingCount.fetch_sub(1, std::memory_order_relaxed);
+
+            if (m_StopRequested)
+            {
+                return;
+            }
+        }
+    }
+
+    void JobSystem::Enqueue(Job* job)
+    {
+        if (!IsInitialized())
+        {
+            // No workers: run inline so callers behave the same either way
+            Execute(job, NOT_A_WORKER, false);
+            return;
+        }
+
+        if (job->Background)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_BackgroundMutex);
+                m_BackgroundQueue.push_back(job);
+                m_BackgroundQueued.fetch_add(1, std::memory_order_seq_cst);
+            }
+            WakeWorker();
+            return;
+        }
+
+        // Count before publishing so a thief never decrements below zero
+        m_QueuedCount.fetch_add(1, std::memory_order_seq_cst);
+
+        uint32_t workerIndex = t_WorkerIndex;
+        if (workerIndex >= GetWorkerCount() || !m_Workers[workerIndex]->Deque.Push(job))
+        {
+            std::lock_guard<std::mutex> lock(m_InjectionMutex);
+            m_InjectionQueue.push_back(job);
+            m_InjectionCount.fetch_add(1, std::memory_order_release);
+        }
+
+        WakeWorker();
+    }
+
+    Job* JobSystem::FindJob(uint32_t workerIndex, bool& stolen)
+    {
+        const uint32_t workerCount = GetWorkerCount();
+        Job* job = nullptr;
+
+        // Own deque: newest first, while its data is still warm in cache
+        if (workerIndex < workerCount)
+        {
+            job = m_Workers[workerIndex]->Deque.Pop();
+        }
+
+        if (!job && m_InjectionCount.load(std::memory_order_acquire) > 0)
+        {
+            std::lock_guard<std::mutex> lock(m_InjectionMutex);
+            if (!m_InjectionQueue.empty())
+            {
+                job = m_InjectionQueue.front();
+                m_InjectionQueue.pop_front();
+                m_InjectionCount.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+
+        if (!job)
+        {
+            // Steal the oldest job from another worker
+            uint32_t start = (workerIndex < workerCount) ? workerIndex + 1 : 0;
+            for (uint32_t offset = 0; offset < workerCount && !job; ++offset)
+            {
+                uint32_t victim = (start + offset) % workerCount;
+                if (victim != workerIndex)
+                {
+                    job = m_Workers[victim]->Deque.Steal();
+                }
+            }
+            stolen = (job != nullptr);
+        }
+
+        if (job)
+        {
+            m_QueuedCount.fetch_sub(1, std::memory_order_relaxed);
+        }
+        return job;
+    }
+
+    Job* JobSystem::FindBackgroundJob()
+    {
+        if (m_BackgroundQueued.load(std::memory_order_acquire) == 0)
+        {
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> lock(m_BackgroundMutex);
+        if (m_BackgroundQueue.empty() ||
+            m_BackgroundRunning.load(std::memory_order_relaxed) >= m_MaxBackgroundRunning)
+        {
+            return nullptr;
+        }
+
+        Job* job = m_BackgroundQueue.front();
+        m_BackgroundQueue.pop_front();
+        m_BackgroundQueued.fetch_sub(1, std::memory_order_relaxed);
+        m_BackgroundRunning.fetch_add(1, std::memory_order_relaxed);
+        return job;
+    }
+
+    bool JobSystem::CanStartBackgroundJob() const
+    {
+        return m_BackgroundQueued.load(std::memory_order_seq_cst) > 0 &&
+               m_BackgroundRunning.load(std::memory_order_seq_cst) < m_MaxBackgroundRunning;
+    }
+
+    void JobSystem::Execute(Job* job, uint32_t workerIndex, bool stolen)
+    {
+        bool timed = workerIndex < m_Workers.size();
+        std::chrono::steady_clock::time_point start;
+        if (timed)
+        {
+            start = std::chrono::steady_clock::now();
+        }
+
+        if (job->Function)
+        {
+            job->Function();
+        }
+
+        if (timed)
+        {
+            Worker& worker = *m_Workers[workerIndex];
+            auto busy = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+            worker.BusyNanoseconds.fetch_add(static_cast<uint64_t>(busy.count()), std::memory_order_relaxed);
+            worker.JobsExecuted.fetch_add(1, std::memory_order_relaxed);
+            if (stolen)
+            {
+                worker.JobsStolen.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        // Release dependents before signalling, so a waiter never sees the counter
+        // reach zero while a continuation is still unscheduled
+        for (uint32_t i = 0; i < job->ContinuationCount; ++i)
+        {
+            Job* continuation = job->Continuations[i];
+            if (continuation->PendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                Enqueue(continuation);
+            }
+        }
+
+        JobCounter* counter = job->Counter;
+        m_JobPool.Release(job);
+
+        if (counter)
+        {
+            counter->Pending.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+
+    void JobSystem::WakeWorker()
+    {
+        if (m_SleepingCount.load(std::memory_order_seq_cst) == 0)
+        {
+            return;
+        }
+
+        {
+            // Taking the mutex orders this notify after a sleeper's predicate check
+            std::lock_guard<std::mutex> lock(m_WakeMutex);
+        }
+        m_WakeCondition.notify_one();
+    }
+
+} // namespace SM
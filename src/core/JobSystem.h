@@ -0,0 +1,328 @@
+#pragma once
+
+/**
+ * @file JobSystem.h
+ * @brief Shattered Moon Engine - Engine-wide work-stealing job system
+ *
+ * A fixed set of worker threads, each owning a lock-free work-stealing
+ * deque. Workers pop their own newest job first and steal the oldest job
+ * from other workers when they run dry. Jobs submitted from threads outside
+ * the pool go to a shared injection queue.
+ *
+ * Jobs form a task graph: a job can depend on other jobs and only becomes
+ * runnable once all of them have finished. Callers track completion with a
+ * JobCounter, and threads waiting on a counter help execute jobs instead of
+ * blocking, so jobs may wait on jobs they spawn.
+ *
+ * Long-running work (chunk generation) goes to a separate background queue.
+ * Only workers take background jobs, after all other work, and at most
+ * workerCount - 1 run at once, so a frame's Wait never picks one up and one
+ * worker always stays free for frame jobs.
+ *
+ * Example usage:
+ * @code
+ *   JobSystem& jobs = JobSystem::Get();
+ *   JobCounter counter;
+ *
+ *   Job* generate = jobs.CreateJob([]() { ... }, &counter);
+ *   Job* build = jobs.CreateJob([]() { ... }, &counter);
+ *   jobs.AddDependency(build, generate);   // build runs after generate
+ *
+ *   jobs.Submit(build);
+ *   jobs.Submit(generate);
+ *   jobs.Wait(counter);
+ * @endcode
+ */
+
+#include "core/Memory.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SM
+{
+    // ============================================================================
+    // Job Types
+    // ============================================================================
+
+    /**
+     * @brief Number of unfinished jobs that a caller can wait on
+     *
+     * Incremented when a job is created and decremented after it has run, so
+     * a counter also covers jobs still waiting on their dependencies.
+     */
+    struct JobCounter
+    {
+        std::atomic<uint32_t> Pending{ 0 };
+
+        bool IsDone() const { return Pending.load(std::memory_order_acquire) == 0; }
+    };
+
+    /**
+     * @brief A unit of work in the task graph
+     *
+     * Created by JobSystem::CreateJob and owned by the job system. The
+     * pointer is valid until the job has been submitted; do not use it after
+     * Submit returns.
+     */
+    struct Job
+    {
+        static constexpr uint32_t MAX_CONTINUATIONS = 16;
+
+        std::function<void()> Function;
+        JobCounter* Counter = nullptr;
+
+        /// Unfinished prerequisites, plus one held until the job is submitted
+        std::atomic<uint32_t> PendingDependencies{ 1 };
+
+        uint32_t ContinuationCount = 0;
+        std::array<Job*, MAX_CONTINUATIONS> Continuations = {};   ///< Jobs waiting on this one
+
+        bool Background = false;    ///< Queued behind all other work and run only by workers
+
+        Job(std::function<void()> function, JobCounter* counter)
+            : Function(std::move(function))
+            , Counter(counter)
+        {
+        }
+    };
+
+    /**
+     * @brief Per-worker activity for display
+     */
+    struct JobWorkerStats
+    {
+        uint64_t JobsExecuted = 0;      ///< Jobs run since the system started
+        uint64_t JobsStolen = 0;        ///< Of those, jobs taken from another worker's deque
+        float Utilization = 0.0f;       ///< Fraction of time spent running jobs since the last sample
+    };
+
+    // ============================================================================
+    // Work-Stealing Deque
+    // ============================================================================
+
+    /**
+     * @brief Fixed-capacity Chase-Lev deque of jobs
+     *
+     * Only the owning worker may Push and Pop (at the bottom); any thread may
+     * Steal (from the top).
+     */
+    class WorkStealingDeque
+    {
+    public:
+        static constexpr int64_t CAPACITY = 4096;
+
+        /**
+         * @brief Push a job at the bottom (owner only)
+         * @return false if the deque is full
+         */
+        bool Push(Job* job);
+
+        /**
+         * @brief Pop the newest job (owner only)
+         * @return The job, or nullptr if empty
+         */
+        Job* Pop();
+
+        /**
+         * @brief Steal the oldest job (any thread)
+         * @return The job, or nullptr if empty or the race was lost
+         */
+        Job* Steal();
+
+    private:
+        static constexpr int64_t MASK = CAPACITY - 1;
+        static_assert((CAPACITY & MASK) == 0, "Deque capacity must be a power of two");
+
+        alignas(64) std::atomic<int64_t> m_Top{ 0 };
+        alignas(64) std::atomic<int64_t> m_Bottom{ 0 };
+        std::array<std::atomic<Job*>, CAPACITY> m_Buffer = {};
+    };
+
+    // ============================================================================
+    // Job System
+    // ============================================================================
+
+    /**
+     * @brief Singleton pool of workers executing the engine's task graph
+     */
+    class JobSystem
+    {
+    public:
+        using JobFunc = std::function<void()>;
+        using RangeFunc = std::function<void(uint32_t begin, uint32_t end)>;
+
+        /**
+         * @brief Get the singleton instance
+         * @return Reference to the job system
+         */
+        static JobSystem& Get();
+
+        // Non-copyable
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        /**
+         * @brief Start the worker threads
+         * @param workerCount Number of workers (0 = hardware concurrency - 1)
+         * @return true if the workers are running
+         */
+        bool Initialize(uint32_t workerCount = 0);
+
+        /**
+         * @brief Stop all workers
+         *
+         * Jobs still queued are discarded; wait on their counters first.
+         */
+        void Shutdown();
+
+        /**
+         * @brief Check if the workers are running
+         */
+        bool IsInitialized() const { return !m_Workers.empty(); }
+
+        /**
+         * @brief Get the number of worker threads (not counting helpers)
+         */
+        uint32_t GetWorkerCount() const { return static_cast<uint32_t>(m_Workers.size()); }
+
+        /**
+         * @brief Create a job without scheduling it
+         * @param function Work to run on any thread in the pool
+         * @param counter Counter that tracks this job (may be nullptr)
+         * @return The job; add dependencies, then pass it to Submit
+         */
+        Job* CreateJob(JobFunc function, JobCounter* counter = nullptr);
+
+        /**
+         * @brief Make a job wait for another to finish
+         * @param job Job that must run later
+         * @param prerequisite Job that must run first
+         * @return false if the prerequisite already has MAX_CONTINUATIONS dependents
+         *
+         * Both jobs must have been created but not yet submitted.
+         */
+        bool AddDependency(Job* job, Job* prerequisite);
+
+        /**
+         * @brief Release a job to run once its dependencies have finished
+         *
+         * Without workers, runnable jobs execute inline so callers behave the
+         * same either way.
+         */
+        void Submit(Job* job);
+
+        /**
+         * @brief Create and submit a job with no dependencies
+         */
+        void Run(JobFunc function, JobCounter* counter = nullptr) { Submit(CreateJob(std::move(function), counter)); }
+
+        /**
+         * @brief Create and submit a long-running job on the background queue
+         *
+         * Waiting threads never run background jobs, so waiting on their
+         * counter blocks until a worker has run them. Without workers the job
+         * runs inline like any other.
+         */
+        void RunBackground(JobFunc function, JobCounter* counter = nullptr);
+
+        /**
+         * @brief Run queued jobs on the calling thread until the counter reaches zero
+         */
+        void Wait(JobCounter& counter);
+
+        /**
+         * @brief Split [0, count) into ranges of grainSize and run them in parallel
+         * @param count Number of items
+         * @param grainSize Items per job (0 = split evenly across workers)
+         * @param function Called with [begin, end) for each range
+         *
+         * Blocks until every range has run; the caller helps.
+         */
+        void ParallelFor(uint32_t count, uint32_t grainSize, const RangeFunc& function);
+
+        /**
+         * @brief Sample every worker's activity
+         * @param out Receives one entry per worker
+         *
+         * Utilization covers the time since the previous call. Call from one
+         * thread only (the editor's stats panel).
+         */
+        void SampleWorkerStats(std::vector<JobWorkerStats>& out);
+
+    private:
+        JobSystem() = default;
+        ~JobSystem();
+
+        struct alignas(64) Worker
+        {
+            WorkStealingDeque Deque;
+            std::atomic<uint64_t> BusyNanoseconds{ 0 };
+            std::atomic<uint64_t> JobsExecuted{ 0 };
+            std::atomic<uint64_t> JobsStolen{ 0 };
+            uint64_t SampledBusyNanoseconds = 0;     ///< Busy time at the last SampleWorkerStats
+        };
+
+        void WorkerLoop(uint32_t workerIndex);
+
+        /**
+         * @brief Make a job with no remaining dependencies runnable
+         */
+        void Enqueue(Job* job);
+
+        /**
+         * @brief Find a runnable job: own deque, then injection queue, then steal
+         * @param workerIndex Calling worker, or GetWorkerCount() for other threads
+         * @param stolen Set when the job came from another worker's deque
+         */
+        Job* FindJob(uint32_t workerIndex, bool& stolen);
+
+        /**
+         * @brief Take the oldest background job if another may start (workers only)
+         */
+        Job* FindBackgroundJob();
+
+        bool CanStartBackgroundJob() const;
+
+        /**
+         * @brief Run a job, release its continuations and recycle it
+         */
+        void Execute(Job* job, uint32_t workerIndex, bool stolen);
+
+        void WakeWorker();
+
+    private:
+        ConcurrentObjectPool<Job> m_JobPool{ 1024 };
+
+        std::vector<std::unique_ptr<Worker>> m_Workers;     // Complete before any thread starts
+        std::vector<std::thread> m_Threads;
+
+        std::mutex m_InjectionMutex;                    // Jobs submitted from outside the pool
+        std::deque<Job*> m_InjectionQueue;
+        std::atomic<uint32_t> m_InjectionCount{ 0 };    // Lets workers skip the mutex when empty
+
+        std::mutex m_BackgroundMutex;                   // Long-running jobs, taken only by workers
+        std::deque<Job*> m_BackgroundQueue;
+        std::atomic<uint32_t> m_BackgroundQueued{ 0 };
+        std::atomic<uint32_t> m_BackgroundRunning{ 0 };
+        uint32_t m_MaxBackgroundRunning = 1;
+
+        std::mutex m_WakeMutex;
+        std::condition_variable m_WakeCondition;
+        std::atomic<uint32_t> m_QueuedCount{ 0 };       // Runnable jobs not yet taken
+        std::atomic<uint32_t> m_SleepingCount{ 0 };
+        std::atomic<bool> m_StopRequested{ false };
+
+        std::chrono::steady_clock::time_point m_LastSampleTime;
+    };
+
+} // namespace SM
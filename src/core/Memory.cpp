@@ -1,7 +1,20 @@
 #include "core/Memory.h"
+#include "core/MemoryTracker.h"
 
+#include <bit>
+#include <cstdlib>
 #include <cstring>
 #include <iostream>
+#include <thread>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#endif
 
 namespace SM
 {
@@ -16,6 +29,58 @@ namespace SM
     }
 #endif
 
+    // ============================================================================
+    // Concurrent Object Pool Thread Slots
+    // ============================================================================
+
+    namespace Detail
+    {
+        namespace
+        {
+            std::mutex g_ThreadSlotMutex;
+            std::vector<uint32_t> g_FreeThreadSlots;
+            uint32_t g_NextThreadSlot = 0;
+
+            /**
+             * @brief Owns the calling thread's cache slot and returns it on thread exit
+             */
+            struct ThreadSlotOwner
+            {
+                uint32_t Slot = NO_THREAD_CACHE;
+
+                ThreadSlotOwner()
+                {
+                    std::lock_guard<std::mutex> lock(g_ThreadSlotMutex);
+                    if (!g_FreeThreadSlots.empty())
+                    {
+                        Slot = g_FreeThreadSlots.back();
+                        g_FreeThreadSlots.pop_back();
+                    }
+                    else if (g_NextThreadSlot < MAX_THREAD_CACHES)
+                    {
+                        Slot = g_NextThreadSlot++;
+                    }
+                }
+
+                ~ThreadSlotOwner()
+                {
+                    if (Slot != NO_THREAD_CACHE)
+                    {
+                        // The mutex also orders the next owner after this thread's cache writes
+                        std::lock_guard<std::mutex> lock(g_ThreadSlotMutex);
+                        g_FreeThreadSlots.push_back(Slot);
+                    }
+                }
+            };
+        }
+
+        uint32_t GetThreadCacheSlot()
+        {
+            thread_local ThreadSlotOwner owner;
+            return owner.Slot;
+        }
+    }
+
     // ============================================================================
     // Pool Allocator Implementation
     // ============================================================================
@@ -171,6 +236,55 @@ namespace SM
         return p >= start && p < end;
     }
 
+    // ============================================================================
+    // Virtual Memory
+    // ============================================================================
+
+    namespace
+    {
+        /**
+         * @brief Reserve address space without backing it (returns nullptr on failure)
+         */
+        uint8_t* ReserveAddressSpace(size_t size)
+        {
+#ifdef _WIN32
+            return static_cast<uint8_t*>(VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS));
+#else
+            void* memory = mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+            return memory == MAP_FAILED ? nullptr : static_cast<uint8_t*>(memory);
+#endif
+        }
+
+        void ReleaseAddressSpace(uint8_t* memory, size_t size)
+        {
+#ifdef _WIN32
+            (void)size;
+            VirtualFree(memory, 0, MEM_RELEASE);
+#else
+            munmap(memory, size);
+#endif
+        }
+
+        bool CommitPages(uint8_t* memory, size_t size)
+        {
+#ifdef _WIN32
+            return VirtualAlloc(memory, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+#else
+            return mprotect(memory, size, PROT_READ | PROT_WRITE) == 0;
+#endif
+        }
+
+        void DecommitPages(uint8_t* memory, size_t size)
+        {
+#ifdef _WIN32
+            VirtualFree(memory, size, MEM_DECOMMIT);
+#else
+            madvise(memory, size, MADV_DONTNEED);
+            mprotect(memory, size, PROT_NONE);
+#endif
+        }
+    }
+
     // ============================================================================
     // Stack Allocator Implementation
     // ============================================================================
@@ -178,6 +292,7 @@ namespace SM
     StackAllocator::StackAllocator(size_t totalSize, size_t alignment)
         : m_TotalSize(totalSize)
         , m_DefaultAlignment(alignment)
+        , m_CommittedSize(totalSize)
     {
         m_Memory = static_cast<uint8_t*>(
             ::operator new(totalSize, std::align_val_t{ alignment })
@@ -188,50 +303,140 @@ namespace SM
 #endif
     }
 
-    StackAllocator::~StackAllocator()
+    StackAllocator::StackAllocator(const VirtualStackConfig& config, size_t alignment)
+        : m_TotalSize(AlignUp(config.ReserveSize, COMMIT_GRANULARITY))
+        , m_DefaultAlignment(alignment)
+        , m_IsVirtual(true)
+        , m_DecommitOnClear(config.DecommitOnClear)
+        , m_MinCommit(std::min(AlignUp(config.InitialCommit, COMMIT_GRANULARITY), m_TotalSize))
     {
-        if (m_Memory)
+        assert(alignment <= COMMIT_GRANULARITY && "Reserved ranges are only page aligned");
+
+        m_Memory = ReserveAddressSpace(m_TotalSize);
+        if (!m_Memory)
         {
-#if defined(_DEBUG)
-            GetMemoryStats().RecordDeallocation(m_TotalSize);
-#endif
-            ::operator delete(m_Memory, std::align_val_t{ m_DefaultAlignment });
-            m_Memory = nullptr;
+            std::cerr << "[StackAllocator] Failed to reserve " << (m_TotalSize / (1024 * 1024)) << " MB" << std::endl;
+            m_TotalSize = 0;
+            m_MinCommit = 0;
+            return;
+        }
+
+        if (!Commit(m_MinCommit))
+        {
+            std::cerr << "[StackAllocator] Failed to commit the initial " << (m_MinCommit / 1024) << " KB" << std::endl;
         }
     }
 
+    StackAllocator::~StackAllocator()
+    {
+        Release();
+    }
+
     StackAllocator::StackAllocator(StackAllocator&& other) noexcept
         : m_Memory(other.m_Memory)
         , m_TotalSize(other.m_TotalSize)
         , m_Offset(other.m_Offset)
         , m_DefaultAlignment(other.m_DefaultAlignment)
+        , m_PeakOffset(other.m_PeakOffset)
+        , m_ClearPeakOffset(other.m_ClearPeakOffset)
+        , m_IsVirtual(other.m_IsVirtual)
+        , m_DecommitOnClear(other.m_DecommitOnClear)
+        , m_CommittedSize(other.m_CommittedSize)
+        , m_MinCommit(other.m_MinCommit)
     {
         other.m_Memory = nullptr;
         other.m_TotalSize = 0;
         other.m_Offset = 0;
+        other.m_CommittedSize = 0;
     }
 
     StackAllocator& StackAllocator::operator=(StackAllocator&& other) noexcept
     {
         if (this != &other)
         {
-            if (m_Memory)
-            {
-                ::operator delete(m_Memory, std::align_val_t{ m_DefaultAlignment });
-            }
+            Release();
 
             m_Memory = other.m_Memory;
             m_TotalSize = other.m_TotalSize;
             m_Offset = other.m_Offset;
             m_DefaultAlignment = other.m_DefaultAlignment;
+            m_PeakOffset = other.m_PeakOffset;
+            m_ClearPeakOffset = other.m_ClearPeakOffset;
+            m_IsVirtual = other.m_IsVirtual;
+            m_DecommitOnClear = other.m_DecommitOnClear;
+            m_CommittedSize = other.m_CommittedSize;
+            m_MinCommit = other.m_MinCommit;
 
             other.m_Memory = nullptr;
             other.m_TotalSize = 0;
             other.m_Offset = 0;
+            other.m_CommittedSize = 0;
         }
         return *this;
     }
 
+    void StackAllocator::Release()
+    {
+        if (!m_Memory)
+        {
+            return;
+        }
+
+        if (m_IsVirtual)
+        {
+#if defined(_DEBUG)
+            GetMemoryStats().RecordDeallocation(m_CommittedSize);
+#endif
+            ReleaseAddressSpace(m_Memory, m_TotalSize);
+        }
+        else
+        {
+#if defined(_DEBUG)
+            GetMemoryStats().RecordDeallocation(m_TotalSize);
+#endif
+            ::operator delete(m_Memory, std::align_val_t{ m_DefaultAlignment });
+        }
+
+        m_Memory = nullptr;
+        m_CommittedSize = 0;
+    }
+
+    bool StackAllocator::Commit(size_t offset)
+    {
+        if (offset <= m_CommittedSize)
+        {
+            return true;
+        }
+
+        const size_t target = std::min(AlignUp(offset, COMMIT_GRANULARITY), m_TotalSize);
+        if (!CommitPages(m_Memory + m_CommittedSize, target - m_CommittedSize))
+        {
+            return false;
+        }
+
+#if defined(_DEBUG)
+        GetMemoryStats().RecordAllocation(target - m_CommittedSize);
+#endif
+        m_CommittedSize = target;
+        return true;
+    }
+
+    void StackAllocator::Decommit(size_t offset)
+    {
+        const size_t target = std::max(AlignUp(offset, COMMIT_GRANULARITY), m_MinCommit);
+        if (target >= m_CommittedSize)
+        {
+            return;
+        }
+
+        DecommitPages(m_Memory + target, m_CommittedSize - target);
+
+#if defined(_DEBUG)
+        GetMemoryStats().RecordDeallocation(m_CommittedSize - target);
+#endif
+        m_CommittedSize = target;
+    }
+
     void* StackAllocator::Push(size_t size, size_t alignment)
     {
         std::lock_guard<std::mutex> lock(m_Mutex);
@@ -250,8 +455,16 @@ namespace SM
             return nullptr; // Stack overflow
         }
 
+        if (m_IsVirtual && !Commit(newOffset))
+        {
+            std::cerr << "[StackAllocator] Failed to commit " << (newOffset / 1024) << " KB" << std::endl;
+            return nullptr;
+        }
+
         void* ptr = m_Memory + alignedOffset;
         m_Offset = newOffset;
+        m_PeakOffset = std::max(m_PeakOffset, newOffset);
+        m_ClearPeakOffset = std::max(m_ClearPeakOffset, newOffset);
 
 #if defined(_DEBUG)
         GetMemoryStats().StackAllocations++;
@@ -281,7 +494,623 @@ namespace SM
     void StackAllocator::Clear()
     {
         std::lock_guard<std::mutex> lock(m_Mutex);
+
+        // Keep what the finished frame used, so a steady load never re-commits
+        if (m_IsVirtual && m_DecommitOnClear)
+        {
+            Decommit(m_ClearPeakOffset);
+        }
+
         m_Offset = 0;
+        m_ClearPeakOffset = 0;
+    }
+
+    // ============================================================================
+    // General Allocator Implementation
+    // ============================================================================
+
+    const char* GetMemoryTagName(MemoryTag tag)
+    {
+        switch (tag)
+        {
+        case MemoryTag::Untagged:  return "Untagged";
+        case MemoryTag::Core:      return "Core";
+        case MemoryTag::ECS:       return "ECS";
+        case MemoryTag::Renderer:  return "Renderer";
+        case MemoryTag::PCG:       return "PCG";
+        case MemoryTag::Resources: return "Resources";
+        case MemoryTag::Editor:    return "Editor";
+        default:                   return "Unknown";
+        }
+    }
+
+    namespace
+    {
+        constexpr size_t SPAN_SIZE = GeneralAllocator::SPAN_SIZE;
+        constexpr uint32_t SIZE_CLASS_COUNT = GeneralAllocator::SIZE_CLASS_COUNT;
+        constexpr uint32_t LARGE_CLASS = ~0u;
+
+        /// Blocks a thread fetches from a central list at once hold about this many bytes
+        constexpr size_t BATCH_BYTES = 32 * 1024;
+
+        /**
+         * @brief Start of every span and of every large allocation (padded to a cache line)
+         *
+         * A span's block tags follow the header; its blocks start at DataOffset.
+         */
+        struct alignas(64) SpanHeader
+        {
+            uint32_t SizeClass = LARGE_CLASS;
+            uint32_t BlockSize = 0;
+            uint32_t DataOffset = 0;
+            MemoryTag LargeTag = MemoryTag::Untagged;
+            size_t LargeSize = 0;               ///< OS allocation size of a large allocation
+            void* LargeBase = nullptr;          ///< OS allocation of a large allocation (the header may sit above it)
+        };
+
+        struct SizeClassInfo
+        {
+            uint32_t Size = 0;
+            uint32_t BlockCount = 0;
+            uint32_t DataOffset = 0;
+            uint32_t BatchSize = 0;
+        };
+
+        constexpr size_t ComputeClassSize(uint32_t sizeClass)
+        {
+            if (sizeClass < 8)
+            {
+                return (sizeClass + 1) * 16;
+            }
+
+            const size_t base = size_t(128) << ((sizeClass - 8) / 4);
+            return base + ((sizeClass - 8) % 4 + 1) * (base / 4);
+        }
+
+        constexpr std::array<SizeClassInfo, SIZE_CLASS_COUNT> BuildSizeClasses()
+        {
+            std::array<SizeClassInfo, SIZE_CLASS_COUNT> classes{};
+            for (uint32_t c = 0; c < SIZE_CLASS_COUNT; ++c)
+            {
+                const size_t size = ComputeClassSize(c);
+
+                // As many blocks as fit after the header and one tag byte per block
+                size_t count = (SPAN_SIZE - sizeof(SpanHeader)) / (size + 1);
+                while (AlignUp(sizeof(SpanHeader) + count, 64) + count * size > SPAN_SIZE)
+                {
+                    --count;
+                }
+
+                classes[c].Size = static_cast<uint32_t>(size);
+                classes[c].BlockCount = static_cast<uint32_t>(count);
+                classes[c].DataOffset = static_cast<uint32_t>(AlignUp(sizeof(SpanHeader) + count, 64));
+                classes[c].BatchSize = static_cast<uint32_t>(std::clamp<size_t>(BATCH_BYTES / size, 4, 64));
+            }
+            return classes;
+        }
+
+        constexpr std::array<SizeClassInfo, SIZE_CLASS_COUNT> SIZE_CLASSES = BuildSizeClasses();
+
+        static_assert(SIZE_CLASSES[SIZE_CLASS_COUNT - 1].Size == GeneralAllocator::MAX_SMALL_SIZE,
+                      "The last size class must cover MAX_SMALL_SIZE");
+        static_assert(SIZE_CLASSES[SIZE_CLASS_COUNT - 1].BlockCount >= 4, "Spans must hold several of the largest blocks");
+
+        struct FreeBlock
+        {
+            FreeBlock* Next;
+        };
+
+        /**
+         * @brief Blocks of one size class shared by all threads
+         *
+         * Guarded by a spinlock: it is only taken once per batch, and a mutex
+         * could allocate on some platforms.
+         */
+        struct alignas(64) CentralList
+        {
+            std::atomic_flag Lock;
+            FreeBlock* Free = nullptr;
+            uint8_t* Carve = nullptr;           ///< Next never-used block of the newest span
+            uint8_t* CarveEnd = nullptr;
+
+            void Acquire()
+            {
+                while (Lock.test_and_set(std::memory_order_acquire))
+                {
+                    while (Lock.test(std::memory_order_relaxed))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+
+            void Release() { Lock.clear(std::memory_order_release); }
+        };
+
+        constinit CentralList g_Central[SIZE_CLASS_COUNT];
+
+        constinit std::atomic<size_t> g_SpanBytes{ 0 };
+        constinit std::atomic<size_t> g_LargeBytes{ 0 };
+        constinit std::atomic<size_t> g_LargeAllocations{ 0 };
+
+        /**
+         * @brief Per-thread free lists (trivially destructible, so usable during thread exit)
+         */
+        struct ThreadCache
+        {
+            FreeBlock* Heads[SIZE_CLASS_COUNT] = {};
+            uint32_t Counts[SIZE_CLASS_COUNT] = {};
+            MemoryTag Tag = MemoryTag::Untagged;
+            bool Registered = false;            ///< Exit flush scheduled
+            bool Disabled = false;              ///< Thread is exiting; go straight to the central lists
+        };
+
+        constinit thread_local ThreadCache t_Cache;
+
+        /**
+         * @brief Flushes the thread cache when its thread exits
+         */
+        struct ThreadCacheFlusher
+        {
+            ~ThreadCacheFlusher()
+            {
+                GeneralAllocator::FlushThreadCache();
+                t_Cache.Disabled = true;
+            }
+        };
+
+        void RegisterThreadCache()
+        {
+            t_Cache.Registered = true;
+            thread_local ThreadCacheFlusher flusher;
+            (void)flusher;
+        }
+
+        // ------------------------------------------------------------------------
+        // OS memory (SPAN_SIZE-aligned)
+        // ------------------------------------------------------------------------
+
+        void* OSAllocate(size_t size)
+        {
+#ifdef _WIN32
+            // VirtualAlloc returns memory aligned to the 64KB allocation granularity
+            return VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+            return std::aligned_alloc(SPAN_SIZE, AlignUp(size, SPAN_SIZE));
+#endif
+        }
+
+        void OSFree(void* ptr)
+        {
+#ifdef _WIN32
+            VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+            std::free(ptr);
+#endif
+        }
+
+        SpanHeader* GetSpan(const void* ptr)
+        {
+            // Only a large allocation aligned to SPAN_SIZE or more starts on a span
+            // boundary (everything else sits past a header); its header is in the slot below
+            uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+            if ((address & (SPAN_SIZE - 1)) == 0)
+            {
+                address -= SPAN_SIZE;
+            }
+            return reinterpret_cast<SpanHeader*>(address & ~(SPAN_SIZE - 1));
+        }
+
+        MemoryTag* GetBlockTags(SpanHeader* span)
+        {
+            return reinterpret_cast<MemoryTag*>(span + 1);
+        }
+
+        /**
+         * @brief Get the index of the block holding a pointer (blocks may be returned at an aligned offset)
+         */
+        uint32_t GetBlockIndex(const SpanHeader* span, const void* ptr)
+        {
+            const uintptr_t data = reinterpret_cast<uintptr_t>(span) + span->DataOffset;
+            return static_cast<uint32_t>((reinterpret_cast<uintptr_t>(ptr) - data) / span->BlockSize);
+        }
+
+        uint8_t* GetBlock(SpanHeader* span, uint32_t index)
+        {
+            return reinterpret_cast<uint8_t*>(span) + span->DataOffset + static_cast<size_t>(index) * span->BlockSize;
+        }
+
+        // ------------------------------------------------------------------------
+        // Central lists
+        // ------------------------------------------------------------------------
+
+        /**
+         * @brief Take one block from a locked central list, carving a new span when empty
+         */
+        FreeBlock* PopCentral(uint32_t sizeClass)
+        {
+            CentralList& central = g_Central[sizeClass];
+            if (FreeBlock* block = central.Free)
+            {
+                central.Free = block->Next;
+                return block;
+            }
+
+            if (central.Carve == central.CarveEnd)
+            {
+                const SizeClassInfo& info = SIZE_CLASSES[sizeClass];
+                void* memory = OSAllocate(SPAN_SIZE);
+                if (!memory)
+                {
+                    return nullptr;
+                }
+
+                SpanHeader* span = new (memory) SpanHeader();
+                span->SizeClass = sizeClass;
+                span->BlockSize = info.Size;
+                span->DataOffset = info.DataOffset;
+                g_SpanBytes.fetch_add(SPAN_SIZE, std::memory_order_relaxed);
+
+                central.Carve = GetBlock(span, 0);
+                central.CarveEnd = GetBlock(span, info.BlockCount);
+            }
+
+            FreeBlock* block = reinterpret_cast<FreeBlock*>(central.Carve);
+            central.Carve += SIZE_CLASSES[sizeClass].Size;
+            return block;
+        }
+
+        /**
+         * @brief Fill an empty thread list with a batch and return its first block
+         */
+        FreeBlock* RefillThreadCache(ThreadCache& cache, uint32_t sizeClass)
+        {
+            if (!cache.Registered)
+            {
+                RegisterThreadCache();
+            }
+
+            CentralList& central = g_Central[sizeClass];
+            central.Acquire();
+
+            FreeBlock* first = PopCentral(sizeClass);
+            if (first)
+            {
+                const uint32_t batch = SIZE_CLASSES[sizeClass].BatchSize;
+                for (uint32_t i = 1; i < batch; ++i)
+                {
+                    FreeBlock* block = PopCentral(sizeClass);
+                    if (!block)
+                    {
+                        break;
+                    }
+                    block->Next = cache.Heads[sizeClass];
+                    cache.Heads[sizeClass] = block;
+                    cache.Counts[sizeClass]++;
+                }
+            }
+
+            central.Release();
+            return first;
+        }
+
+        /**
+         * @brief Move up to count blocks from a thread list to the central list
+         */
+        void FlushThreadList(ThreadCache& cache, uint32_t sizeClass, uint32_t count)
+        {
+            CentralList& central = g_Central[sizeClass];
+            central.Acquire();
+
+            while (count-- > 0 && cache.Heads[sizeClass])
+            {
+                FreeBlock* block = cache.Heads[sizeClass];
+                cache.Heads[sizeClass] = block->Next;
+                cache.Counts[sizeClass]--;
+
+                block->Next = central.Free;
+                central.Free = block;
+            }
+
+            central.Release();
+        }
+
+        // ------------------------------------------------------------------------
+        // Large allocations
+        // ------------------------------------------------------------------------
+
+        void* AllocateLarge(size_t size, size_t alignment, MemoryTag tag)
+        {
+            // The header starts the OS allocation for smaller alignments; at SPAN_SIZE
+            // and above it takes the whole slot below the data, where GetSpan looks.
+            // The OS only aligns to SPAN_SIZE, so larger alignments over-allocate.
+            const size_t dataOffset = alignment < SPAN_SIZE ? std::max(sizeof(SpanHeader), alignment) : SPAN_SIZE;
+            const size_t slack = alignment > SPAN_SIZE ? alignment - SPAN_SIZE : 0;
+            if (size > SIZE_MAX - dataOffset - slack - PAGE_SIZE)
+            {
+                return nullptr;
+            }
+
+            const size_t totalSize = AlignUp(dataOffset + slack + size, PAGE_SIZE);
+            void* memory = OSAllocate(totalSize);
+            if (!memory)
+            {
+                return nullptr;
+            }
+
+            uint8_t* data = static_cast<uint8_t*>(AlignPointer(static_cast<uint8_t*>(memory) + dataOffset, alignment));
+
+            SpanHeader* span = new (data - dataOffset) SpanHeader();
+            span->SizeClass = LARGE_CLASS;
+            span->DataOffset = static_cast<uint32_t>(dataOffset);
+            span->LargeTag = tag;
+            span->LargeSize = totalSize;
+            span->LargeBase = memory;
+
+            g_LargeBytes.fetch_add(totalSize, std::memory_order_relaxed);
+            g_LargeAllocations.fetch_add(1, std::memory_order_relaxed);
+
+#if defined(_DEBUG)
+            TaggedMemoryStats& stats = GetMemoryStats().Tagged[static_cast<size_t>(tag)];
+            stats.Allocations.fetch_add(1, std::memory_order_relaxed);
+            stats.CurrentBytes.fetch_add(totalSize, std::memory_order_relaxed);
+#endif
+
+            MemoryTracker& tracker = MemoryTracker::Get();
+            if (tracker.IsEnabled())
+            {
+                tracker.RecordAllocation(tag, totalSize);
+            }
+
+            return data;
+        }
+
+        void FreeLarge(SpanHeader* span)
+        {
+            g_LargeBytes.fetch_sub(span->LargeSize, std::memory_order_relaxed);
+            g_LargeAllocations.fetch_sub(1, std::memory_order_relaxed);
+
+#if defined(_DEBUG)
+            TaggedMemoryStats& stats = GetMemoryStats().Tagged[static_cast<size_t>(span->LargeTag)];
+            stats.Deallocations.fetch_add(1, std::memory_order_relaxed);
+            stats.CurrentBytes.fetch_sub(span->LargeSize, std::memory_order_relaxed);
+#endif
+
+            MemoryTracker& tracker = MemoryTracker::Get();
+            if (tracker.IsEnabled())
+            {
+                tracker.RecordFree(span->LargeTag, span->LargeSize);
+            }
+
+            OSFree(span->LargeBase);
+        }
+    }
+
+    uint32_t GeneralAllocator::GetSizeClass(size_t size)
+    {
+        if (size <= 128)
+        {
+            return size == 0 ? 0 : static_cast<uint32_t>((size - 1) / 16);
+        }
+        if (size > MAX_SMALL_SIZE)
+        {
+            return SIZE_CLASS_COUNT;
+        }
+
+        // size lies in (2^p, 2^(p+1)], split into four steps of 2^p / 4
+        const uint32_t p = static_cast<uint32_t>(std::bit_width(size - 1)) - 1;
+        const size_t base = size_t(1) << p;
+        const size_t step = base / 4;
+        return 8 + (p - 7) * 4 + static_cast<uint32_t>((size - base + step - 1) / step) - 1;
+    }
+
+    size_t GeneralAllocator::GetClassSize(uint32_t sizeClass)
+    {
+        assert(sizeClass < SIZE_CLASS_COUNT && "Invalid size class");
+        return SIZE_CLASSES[sizeClass].Size;
+    }
+
+    void* GeneralAllocator::Allocate(size_t size, size_t alignment, MemoryTag tag)
+    {
+        assert(alignment != 0 && (alignment & (alignment - 1)) == 0 && "Alignment must be a power of 2");
+
+        if (size == 0)
+        {
+            size = 1;
+        }
+
+        // Blocks are 16-byte aligned; larger alignments take a bigger block and an offset into it
+        const size_t request = alignment <= DEFAULT_ALIGNMENT ? size : size + alignment - DEFAULT_ALIGNMENT;
+        if (alignment > MAX_SMALL_ALIGNMENT || request > MAX_SMALL_SIZE)
+        {
+            return AllocateLarge(size, alignment, tag);
+        }
+
+        const uint32_t sizeClass = GetSizeClass(request);
+        ThreadCache& cache = t_Cache;
+
+        FreeBlock* block = cache.Heads[sizeClass];
+        if (block)
+        {
+            cache.Heads[sizeClass] = block->Next;
+            cache.Counts[sizeClass]--;
+        }
+        else if (!cache.Disabled)
+        {
+            block = RefillThreadCache(cache, sizeClass);
+        }
+        else
+        {
+            g_Central[sizeClass].Acquire();
+            block = PopCentral(sizeClass);
+            g_Central[sizeClass].Release();
+        }
+
+        if (!block)
+        {
+            return nullptr;
+        }
+
+        SpanHeader* span = GetSpan(block);
+        GetBlockTags(span)[GetBlockIndex(span, block)] = tag;
+
+#if defined(_DEBUG)
+        TaggedMemoryStats& stats = GetMemoryStats().Tagged[static_cast<size_t>(tag)];
+        stats.Allocations.fetch_add(1, std::memory_order_relaxed);
+        stats.CurrentBytes.fetch_add(span->BlockSize, std::memory_order_relaxed);
+#endif
+
+        MemoryTracker& tracker = MemoryTracker::Get();
+        if (tracker.IsEnabled())
+        {
+            tracker.RecordAllocation(tag, span->BlockSize);
+        }
+
+        return AlignPointer(block, alignment);
+    }
+
+    void GeneralAllocator::Free(void* ptr)
+    {
+        if (!ptr)
+        {
+            return;
+        }
+
+        SpanHeader* span = GetSpan(ptr);
+        if (span->SizeClass == LARGE_CLASS)
+        {
+            FreeLarge(span);
+            return;
+        }
+
+        const uint32_t sizeClass = span->SizeClass;
+        const uint32_t index = GetBlockIndex(span, ptr);
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(GetBlock(span, index));
+
+#if defined(_DEBUG)
+        TaggedMemoryStats& stats = GetMemoryStats().Tagged[static_cast<size_t>(GetBlockTags(span)[index])];
+        stats.Deallocations.fetch_add(1, std::memory_order_relaxed);
+        stats.CurrentBytes.fetch_sub(span->BlockSize, std::memory_order_relaxed);
+#endif
+
+        MemoryTracker& tracker = MemoryTracker::Get();
+        if (tracker.IsEnabled())
+        {
+            tracker.RecordFree(GetBlockTags(span)[index], span->BlockSize);
+        }
+
+        ThreadCache& cache = t_Cache;
+        if (cache.Disabled)
+        {
+            CentralList& central = g_Central[sizeClass];
+            central.Acquire();
+            block->Next = central.Free;
+            central.Free = block;
+            central.Release();
+            return;
+        }
+
+        if (!cache.Registered)
+        {
+            RegisterThreadCache();
+        }
+
+        block->Next = cache.Heads[sizeClass];
+        cache.Heads[sizeClass] = block;
+
+        // Keep one batch after flushing, so alternating frees and allocations don't bounce
+        const uint32_t batch = SIZE_CLASSES[sizeClass].BatchSize;
+        if (++cache.Counts[sizeClass] > 2 * batch)
+        {
+            FlushThreadList(cache, sizeClass, batch);
+        }
+    }
+
+    size_t GeneralAllocator::GetUsableSize(const void* ptr)
+    {
+        if (!ptr)
+        {
+            return 0;
+        }
+
+        SpanHeader* span = GetSpan(ptr);
+        const uint8_t* p = static_cast<const uint8_t*>(ptr);
+        if (span->SizeClass == LARGE_CLASS)
+        {
+            return static_cast<const uint8_t*>(span->LargeBase) + span->LargeSize - p;
+        }
+
+        return GetBlock(span, GetBlockIndex(span, ptr)) + span->BlockSize - p;
+    }
+
+    MemoryTag GeneralAllocator::GetTag(const void* ptr)
+    {
+        if (!ptr)
+        {
+            return MemoryTag::Untagged;
+        }
+
+        SpanHeader* span = GetSpan(ptr);
+        if (span->SizeClass == LARGE_CLASS)
+        {
+            return span->LargeTag;
+        }
+        return GetBlockTags(span)[GetBlockIndex(span, ptr)];
+    }
+
+    MemoryTag GeneralAllocator::GetThreadTag()
+    {
+        return t_Cache.Tag;
+    }
+
+    void GeneralAllocator::SetThreadTag(MemoryTag tag)
+    {
+        t_Cache.Tag = tag;
+    }
+
+    void GeneralAllocator::FlushThreadCache()
+    {
+        ThreadCache& cache = t_Cache;
+        for (uint32_t c = 0; c < SIZE_CLASS_COUNT; ++c)
+        {
+            if (cache.Heads[c])
+            {
+                FlushThreadList(cache, c, cache.Counts[c]);
+            }
+        }
+    }
+
+    GeneralAllocatorStats GeneralAllocator::GetStats()
+    {
+        GeneralAllocatorStats stats;
+        stats.SpanBytes = g_SpanBytes.load(std::memory_order_relaxed);
+        stats.LargeBytes = g_LargeBytes.load(std::memory_order_relaxed);
+        stats.LargeAllocations = g_LargeAllocations.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    // ============================================================================
+    // General Memory Resource
+    // ============================================================================
+
+    void* GeneralMemoryResource::do_allocate(size_t bytes, size_t alignment)
+    {
+        void* ptr = GeneralAllocator::Allocate(bytes, alignment, m_Tag);
+        if (!ptr)
+        {
+            throw std::bad_alloc();
+        }
+        return ptr;
+    }
+
+    void GeneralMemoryResource::do_deallocate(void* ptr, size_t, size_t)
+    {
+        GeneralAllocator::Free(ptr);
+    }
+
+    bool GeneralMemoryResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+    {
+        return dynamic_cast<const GeneralMemoryResource*>(&other) != nullptr;
     }
 
     // ============================================================================
@@ -299,15 +1128,40 @@ namespace SM
         Shutdown();
     }
 
-    bool MemoryManager::Initialize(size_t frameStackSize, size_t persistentStackSize)
+    bool MemoryManager::Initialize(size_t frameStackSize, size_t persistentStackSize, size_t stackReserveSize)
     {
         if (m_IsInitialized)
         {
             return true;
         }
 
-        m_FrameStack = std::make_unique<StackAllocator>(frameStackSize);
-        m_PersistentStack = std::make_unique<StackAllocator>(persistentStackSize);
+        if (stackReserveSize > 0)
+        {
+            VirtualStackConfig frameConfig;
+            frameConfig.ReserveSize = std::max(stackReserveSize, frameStackSize);
+            frameConfig.InitialCommit = frameStackSize;
+            frameConfig.DecommitOnClear = true;
+
+            VirtualStackConfig persistentConfig;
+            persistentConfig.ReserveSize = std::max(stackReserveSize, persistentStackSize);
+            persistentConfig.InitialCommit = persistentStackSize;
+
+            m_FrameStack = std::make_unique<StackAllocator>(frameConfig);
+            m_PersistentStack = std::make_unique<StackAllocator>(persistentConfig);
+
+            if (m_FrameStack->GetTotalSize() == 0 || m_PersistentStack->GetTotalSize() == 0)
+            {
+                std::cerr << "[MemoryManager] Failed to reserve stack address space" << std::endl;
+                m_FrameStack.reset();
+                m_PersistentStack.reset();
+                return false;
+            }
+        }
+        else
+        {
+            m_FrameStack = std::make_unique<StackAllocator>(frameStackSize);
+            m_PersistentStack = std::make_unique<StackAllocator>(persistentStackSize);
+        }
 
         m_IsInitialized = true;
 
@@ -315,6 +1169,10 @@ namespace SM
         std::cout << "[MemoryManager] Initialized with:" << std::endl;
         std::cout << "  Frame Stack: " << (frameStackSize / 1024) << " KB" << std::endl;
         std::cout << "  Persistent Stack: " << (persistentStackSize / 1024) << " KB" << std::endl;
+        if (stackReserveSize > 0)
+        {
+            std::cout << "  Growable up to: " << (stackReserveSize / (1024 * 1024)) << " MB each" << std::endl;
+        }
 #endif
 
         return true;
@@ -331,6 +1189,13 @@ namespace SM
         PrintStats();
 #endif
 
+        {
+            std::lock_guard<std::mutex> lock(m_FrameArenaMutex);
+            m_ThreadFrameArenas.clear();
+            m_FrameArenaBufferCount = 0;
+            m_FrameArenaGeneration.fetch_add(1, std::memory_order_release);
+        }
+
         m_FrameStack.reset();
         m_PersistentStack.reset();
         m_IsInitialized = false;
@@ -344,6 +1209,93 @@ namespace SM
         }
     }
 
+    bool MemoryManager::InitializeFrameArenas(uint32_t bufferCount, size_t arenaSize)
+    {
+        if (bufferCount == 0 || arenaSize == 0)
+        {
+            std::cerr << "[MemoryManager] Invalid frame arena configuration" << std::endl;
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(m_FrameArenaMutex);
+
+        // Drop arenas of the previous configuration; threads re-register on next use
+        m_ThreadFrameArenas.clear();
+        m_FrameArenaBufferCount = bufferCount;
+        m_FrameArenaSize = arenaSize;
+        m_FrameArenaIndex.store(0, std::memory_order_relaxed);
+        m_FrameArenaGeneration.fetch_add(1, std::memory_order_release);
+
+#if defined(_DEBUG)
+        std::cout << "[MemoryManager] Frame arenas: " << bufferCount << " x "
+                  << (arenaSize / 1024) << " KB per thread" << std::endl;
+#endif
+
+        return true;
+    }
+
+    void MemoryManager::BeginFrameArenas(uint32_t frameIndex)
+    {
+        std::lock_guard<std::mutex> lock(m_FrameArenaMutex);
+
+        if (m_FrameArenaBufferCount == 0)
+        {
+            return;
+        }
+
+        uint32_t buffer = frameIndex % m_FrameArenaBufferCount;
+        for (auto& arenas : m_ThreadFrameArenas)
+        {
+            (*arenas)[buffer]->Clear();
+        }
+
+        m_FrameArenaIndex.store(buffer, std::memory_order_release);
+    }
+
+    StackAllocator* MemoryManager::GetThreadFrameArena()
+    {
+        thread_local ThreadFrameArenas* t_Arenas = nullptr;
+        thread_local uint32_t t_Generation = 0;
+
+        uint32_t generation = m_FrameArenaGeneration.load(std::memory_order_acquire);
+        if (!t_Arenas || t_Generation != generation)
+        {
+            std::lock_guard<std::mutex> lock(m_FrameArenaMutex);
+
+            if (m_FrameArenaBufferCount == 0)
+            {
+                t_Arenas = nullptr;
+                return nullptr;
+            }
+
+            auto arenas = std::make_unique<ThreadFrameArenas>();
+            arenas->reserve(m_FrameArenaBufferCount);
+            for (uint32_t i = 0; i < m_FrameArenaBufferCount; ++i)
+            {
+                arenas->push_back(std::make_unique<StackAllocator>(m_FrameArenaSize));
+            }
+
+            t_Arenas = arenas.get();
+            t_Generation = m_FrameArenaGeneration.load(std::memory_order_relaxed);
+            m_ThreadFrameArenas.push_back(std::move(arenas));
+        }
+
+        return (*t_Arenas)[m_FrameArenaIndex.load(std::memory_order_acquire)].get();
+    }
+
+    std::pmr::memory_resource* MemoryManager::GetMemoryResource(MemoryTag tag)
+    {
+        static GeneralMemoryResource s_Resources[MEMORY_TAG_COUNT] = {
+            GeneralMemoryResource(MemoryTag::Untagged), GeneralMemoryResource(MemoryTag::Core),
+            GeneralMemoryResource(MemoryTag::ECS), GeneralMemoryResource(MemoryTag::Renderer),
+            GeneralMemoryResource(MemoryTag::PCG), GeneralMemoryResource(MemoryTag::Resources),
+            GeneralMemoryResource(MemoryTag::Editor)
+        };
+
+        assert(tag < MemoryTag::Count && "Invalid memory tag");
+        return &s_Resources[static_cast<size_t>(tag)];
+    }
+
 #if defined(_DEBUG)
     void MemoryManager::PrintStats() const
     {
@@ -355,17 +1307,46 @@ namespace SM
         std::cout << "Pool Allocations: " << m_Stats.PoolAllocations << std::endl;
         std::cout << "Stack Allocations: " << m_Stats.StackAllocations << std::endl;
         std::cout << "Object Pool Allocations: " << m_Stats.ObjectPoolAllocations << std::endl;
+        std::cout << "Concurrent Pool CAS Retries: " << m_Stats.ConcurrentPoolCASRetries << std::endl;
+        std::cout << "Concurrent Pool Refills/Flushes: " << m_Stats.ConcurrentPoolRefills
+                  << " / " << m_Stats.ConcurrentPoolFlushes << std::endl;
+        std::cout << "Concurrent Pool Uncached Ops: " << m_Stats.ConcurrentPoolUncachedOps << std::endl;
+
+        for (size_t i = 0; i < MEMORY_TAG_COUNT; ++i)
+        {
+            const TaggedMemoryStats& tagged = m_Stats.Tagged[i];
+            if (tagged.Allocations == 0 && tagged.CurrentBytes == 0)
+            {
+                continue;
+            }
+
+            std::cout << "General [" << GetMemoryTagName(static_cast<MemoryTag>(i)) << "]: "
+                      << tagged.Allocations << " allocs, " << tagged.Deallocations << " frees, "
+                      << tagged.CurrentBytes << " bytes live" << std::endl;
+        }
+
+        GeneralAllocatorStats general = GeneralAllocator::GetStats();
+        std::cout << "General Spans: " << (general.SpanBytes / 1024) << " KB, Large: "
+                  << general.LargeAllocations << " (" << (general.LargeBytes / 1024) << " KB)" << std::endl;
 
         if (m_FrameStack)
         {
             std::cout << "Frame Stack Used: " << m_FrameStack->GetUsedSize()
-                      << " / " << m_FrameStack->GetTotalSize() << " bytes" << std::endl;
+                      << " / " << m_FrameStack->GetTotalSize() << " bytes (peak "
+                      << m_FrameStack->GetPeakSize() << ", committed " << m_FrameStack->GetCommittedSize() << ")" << std::endl;
         }
 
         if (m_PersistentStack)
         {
             std::cout << "Persistent Stack Used: " << m_PersistentStack->GetUsedSize()
-                      << " / " << m_PersistentStack->GetTotalSize() << " bytes" << std::endl;
+                      << " / " << m_PersistentStack->GetTotalSize() << " bytes (peak "
+                      << m_PersistentStack->GetPeakSize() << ", committed " << m_PersistentStack->GetCommittedSize() << ")" << std::endl;
+        }
+
+        if (m_FrameArenaBufferCount > 0)
+        {
+            std::cout << "Frame Arenas: " << m_ThreadFrameArenas.size() << " threads x "
+                      << m_FrameArenaBufferCount << " frames" << std::endl;
         }
 
         std::cout << "=========================" << std::endl;
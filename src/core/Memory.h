@@ -8,11 +8,18 @@
  * - PoolAllocator: Fixed-size block allocation with free list
  * - StackAllocator: LIFO allocation for frame-based temporary memory
  * - ObjectPool<T>: Type-safe object pooling with automatic expansion
+ * - ConcurrentObjectPool<T>: Object pooling with thread caches over a lock-free free stack
+ * - GeneralAllocator: Thread-caching size-class heap for everything else, with
+ *   per-subsystem tags and a std::pmr adapter (optionally behind global new)
  */
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <cstddef>
 #include <memory>
+#include <memory_resource>
 #include <mutex>
 #include <vector>
 #include <cassert>
@@ -58,11 +65,47 @@ namespace SM
         );
     }
 
+    // ============================================================================
+    // Memory Tags
+    // ============================================================================
+
+    /**
+     * @brief Subsystem a general allocation is counted under
+     */
+    enum class MemoryTag : uint8_t
+    {
+        Untagged = 0,
+        Core,
+        ECS,
+        Renderer,
+        PCG,                ///< Terrain generation and streaming
+        Resources,
+        Editor,
+        Count
+    };
+
+    constexpr size_t MEMORY_TAG_COUNT = static_cast<size_t>(MemoryTag::Count);
+
+    /**
+     * @brief Get a tag's display name
+     */
+    const char* GetMemoryTagName(MemoryTag tag);
+
     // ============================================================================
     // Memory Statistics (Debug)
     // ============================================================================
 
 #if defined(_DEBUG)
+    /**
+     * @brief GeneralAllocator traffic of one MemoryTag (updated from any thread)
+     */
+    struct TaggedMemoryStats
+    {
+        std::atomic<size_t> Allocations{ 0 };
+        std::atomic<size_t> Deallocations{ 0 };
+        std::atomic<size_t> CurrentBytes{ 0 };      ///< Block sizes, so includes size-class rounding
+    };
+
     /**
      * @brief Memory tracking statistics for debugging
      */
@@ -76,6 +119,15 @@ namespace SM
         size_t StackAllocations = 0;
         size_t ObjectPoolAllocations = 0;
 
+        // ConcurrentObjectPool contention, summed over all pools (updated from any thread)
+        std::atomic<size_t> ConcurrentPoolCASRetries{ 0 };
+        std::atomic<size_t> ConcurrentPoolRefills{ 0 };
+        std::atomic<size_t> ConcurrentPoolFlushes{ 0 };
+        std::atomic<size_t> ConcurrentPoolUncachedOps{ 0 };
+
+        // GeneralAllocator, per subsystem
+        std::array<TaggedMemoryStats, MEMORY_TAG_COUNT> Tagged;
+
         void RecordAllocation(size_t bytes)
         {
             TotalAllocations++;
@@ -101,6 +153,17 @@ namespace SM
             PoolAllocations = 0;
             StackAllocations = 0;
             ObjectPoolAllocations = 0;
+            ConcurrentPoolCASRetries = 0;
+            ConcurrentPoolRefills = 0;
+            ConcurrentPoolFlushes = 0;
+            ConcurrentPoolUncachedOps = 0;
+
+            // Live bytes stay: blocks allocated before the reset are still freed later
+            for (TaggedMemoryStats& tagged : Tagged)
+            {
+                tagged.Allocations = 0;
+                tagged.Deallocations = 0;
+            }
         }
     };
 
@@ -230,12 +293,28 @@ namespace SM
      */
     using StackMarker = size_t;
 
+    /**
+     * @brief Reserve/commit configuration for a growable StackAllocator
+     */
+    struct VirtualStackConfig
+    {
+        size_t ReserveSize = 1024ull * 1024 * 1024;    ///< Address space reserved up front (the hard limit)
+        size_t InitialCommit = 0;                       ///< Bytes committed at construction (and kept by Clear)
+        bool DecommitOnClear = false;                   ///< Clear releases pages above the last use and InitialCommit
+    };
+
     /**
      * @brief LIFO (Last-In-First-Out) stack allocator
      *
      * Efficient for frame-based temporary allocations where all allocations
      * in a frame are released together at the end.
      *
+     * Constructed with a VirtualStackConfig, the stack only reserves address
+     * space and commits it in COMMIT_GRANULARITY steps as Push advances, so
+     * a heavy frame grows the stack instead of overflowing it and memory use
+     * follows actual demand. With DecommitOnClear, Clear hands back the pages
+     * past what the finished frame used, so a one-off spike is not kept.
+     *
      * Example usage:
      * @code
      *   StackAllocator stack(1024 * 1024); // 1MB
@@ -258,6 +337,16 @@ namespace SM
          */
         explicit StackAllocator(size_t totalSize, size_t alignment = DEFAULT_ALIGNMENT);
 
+        /**
+         * @brief Construct a growable stack over reserved virtual memory
+         * @param config Reserve size, initial commit and decommit policy
+         * @param alignment Default alignment for allocations
+         */
+        explicit StackAllocator(const VirtualStackConfig& config, size_t alignment = DEFAULT_ALIGNMENT);
+
+        /// Pages are committed and decommitted in steps of this size
+        static constexpr size_t COMMIT_GRANULARITY = 64 * 1024;
+
         /**
          * @brief Destructor - releases all memory
          */
@@ -334,12 +423,53 @@ namespace SM
          */
         size_t GetFreeSize() const { return m_TotalSize - m_Offset; }
 
+        /**
+         * @brief Get the highest offset ever reached (the watermark to size a fixed stack by)
+         */
+        size_t GetPeakSize() const { return m_PeakOffset; }
+
+        /**
+         * @brief Get the bytes currently backed by memory (GetTotalSize() unless virtual)
+         */
+        size_t GetCommittedSize() const { return m_CommittedSize; }
+
+        /**
+         * @brief Check if the stack reserves and commits on demand
+         */
+        bool IsVirtual() const { return m_IsVirtual; }
+
+    private:
+        /**
+         * @brief Commit pages so that offset bytes are usable (virtual stacks)
+         */
+        bool Commit(size_t offset);
+
+        /**
+         * @brief Decommit pages past offset, keeping at least the initial commit (virtual stacks)
+         */
+        void Decommit(size_t offset);
+
+        /**
+         * @brief Release the buffer (either kind)
+         */
+        void Release();
+
     private:
         uint8_t* m_Memory = nullptr;       // Raw memory buffer
         size_t m_TotalSize = 0;            // Total size of the stack
         size_t m_Offset = 0;               // Current top of stack
         size_t m_DefaultAlignment = DEFAULT_ALIGNMENT;
 
+        // Watermarks
+        size_t m_PeakOffset = 0;           // Highest offset ever reached
+        size_t m_ClearPeakOffset = 0;      // Highest offset since the last Clear
+
+        // Virtual memory mode
+        bool m_IsVirtual = false;
+        bool m_DecommitOnClear = false;
+        size_t m_CommittedSize = 0;        // Bytes committed from m_Memory
+        size_t m_MinCommit = 0;            // Never decommitted below this
+
         mutable std::mutex m_Mutex;        // Thread safety
     };
 
@@ -588,6 +718,617 @@ namespace SM
         mutable std::mutex m_Mutex;              // Thread safety
     };
 
+    // ============================================================================
+    // Concurrent Object Pool
+    // ============================================================================
+
+    namespace Detail
+    {
+        /// Thread cache slots per ConcurrentObjectPool; threads beyond this go uncached
+        constexpr uint32_t MAX_THREAD_CACHES = 64;
+        constexpr uint32_t NO_THREAD_CACHE = ~0u;
+
+        /**
+         * @brief Get the calling thread's cache slot, shared by every ConcurrentObjectPool
+         * @return Slot in [0, MAX_THREAD_CACHES), or NO_THREAD_CACHE if all are taken
+         *
+         * A slot belongs to one live thread at a time and is returned when the
+         * thread exits, so a pool's cache for that slot needs no synchronisation.
+         */
+        uint32_t GetThreadCacheSlot();
+    }
+
+    /**
+     * @brief Contention counters of a single ConcurrentObjectPool
+     */
+    struct ConcurrentPoolStats
+    {
+        size_t CASRetries = 0;      ///< Global free-stack CAS attempts that lost a race
+        size_t Refills = 0;         ///< Batches moved from the global stack to a thread cache
+        size_t Flushes = 0;         ///< Batches returned from a thread cache to the global stack
+        size_t UncachedOps = 0;     ///< Acquire/Release calls from threads without a cache slot
+        size_t Expansions = 0;      ///< Chunks added after the global stack ran dry
+    };
+
+    /**
+     * @brief Object pool for many threads acquiring and releasing concurrently
+     *
+     * Each thread keeps a private cache of free objects, so Acquire and Release
+     * usually touch no shared state at all. Caches refill from and spill to a
+     * lock-free global stack whole batches at a time: one CAS moves BATCH_SIZE
+     * objects. The stack head packs a 32-bit node index with a 32-bit tag that
+     * changes on every update, which makes the CAS immune to ABA. Free-list
+     * links live beside each object's storage rather than inside it, so a
+     * racing pop never reads memory that another thread has handed to a T.
+     * Only growing the pool takes a lock.
+     *
+     * Objects may be released on a different thread than the one that
+     * acquired them. Objects left in an exiting thread's cache stay with its
+     * slot until the next thread claims it, so a pool without auto-expansion
+     * can run dry while free objects sit in idle caches. Release every object
+     * before destroying the pool.
+     *
+     * @tparam T Type of objects to pool
+     *
+     * Example usage:
+     * @code
+     *   ConcurrentObjectPool<Job> pool(1024);
+     *
+     *   // On any thread
+     *   Job* job = pool.Acquire(args...);
+     *   // ...
+     *   pool.Release(job);
+     * @endcode
+     */
+    template<typename T>
+    class ConcurrentObjectPool
+    {
+    public:
+        static constexpr uint32_t BATCH_SIZE = 32;                  ///< Objects moved per global stack operation
+        static constexpr uint32_t CACHE_CAPACITY = BATCH_SIZE * 2;  ///< Objects a thread cache holds before spilling
+        static constexpr uint32_t MAX_CHUNKS = 1024;
+
+        /**
+         * @brief Construct a concurrent object pool
+         * @param initialCapacity Initial number of objects to pre-allocate
+         * @param autoExpand Whether to automatically expand when exhausted
+         * @param chunkSize Objects per allocation (rounded up to a power of two >= BATCH_SIZE)
+         */
+        explicit ConcurrentObjectPool(
+            size_t initialCapacity = 256,
+            bool autoExpand = true,
+            size_t chunkSize = 256
+        )
+            : m_AutoExpand(autoExpand)
+        {
+            while ((1u << m_ChunkShift) < chunkSize && m_ChunkShift < 20)
+            {
+                m_ChunkShift++;
+            }
+            m_ChunkMask = (1u << m_ChunkShift) - 1;
+
+            for (auto& chunk : m_Chunks)
+            {
+                chunk.store(nullptr, std::memory_order_relaxed);
+            }
+
+            std::lock_guard<std::mutex> lock(m_ExpandMutex);
+            while (GetTotalCapacity() < initialCapacity && AddChunk())
+            {
+            }
+        }
+
+        /**
+         * @brief Destructor - releases memory (objects still acquired are not destroyed)
+         */
+        ~ConcurrentObjectPool()
+        {
+            for (uint32_t i = 0; i < m_ChunkCount; ++i)
+            {
+                ::operator delete(m_Chunks[i].load(std::memory_order_relaxed), std::align_val_t{ alignof(Node) });
+            }
+        }
+
+        // Non-copyable, non-movable (thread caches index into this instance)
+        ConcurrentObjectPool(const ConcurrentObjectPool&) = delete;
+        ConcurrentObjectPool& operator=(const ConcurrentObjectPool&) = delete;
+
+        /**
+         * @brief Acquire an object from the pool
+         * @tparam Args Constructor argument types
+         * @param args Arguments to forward to object constructor
+         * @return Pointer to acquired object, nullptr if pool exhausted and !autoExpand
+         */
+        template<typename... Args>
+        T* Acquire(Args&&... args)
+        {
+            uint32_t index = AcquireIndex();
+            if (index == INVALID_INDEX)
+            {
+                return nullptr;
+            }
+
+            m_ActiveCount.fetch_add(1, std::memory_order_relaxed);
+
+            Node* node = GetNode(index);
+            return new (node->Storage) T(std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Release an object back to the pool
+         * @param obj Object to release (must have been acquired from this pool)
+         */
+        void Release(T* obj)
+        {
+            if (!obj)
+            {
+                return;
+            }
+
+            obj->~T();
+
+            // Storage is the first member, so the object address is the node address
+            Node* node = reinterpret_cast<Node*>(obj);
+            m_ActiveCount.fetch_sub(1, std::memory_order_relaxed);
+
+            uint32_t slot = Detail::GetThreadCacheSlot();
+            if (slot == Detail::NO_THREAD_CACHE)
+            {
+                CountUncached();
+                node->Next.store(INVALID_INDEX, std::memory_order_relaxed);
+                PushBatch(node->Index);
+                return;
+            }
+
+            ThreadCache& cache = m_Caches[slot];
+            if (cache.Count == CACHE_CAPACITY)
+            {
+                // Spill the oldest half; the most recently released objects stay hot
+                for (uint32_t i = 0; i + 1 < BATCH_SIZE; ++i)
+                {
+                    GetNode(cache.Items[i])->Next.store(cache.Items[i + 1], std::memory_order_relaxed);
+                }
+                GetNode(cache.Items[BATCH_SIZE - 1])->Next.store(INVALID_INDEX, std::memory_order_relaxed);
+                PushBatch(cache.Items[0]);
+
+                std::copy(cache.Items + BATCH_SIZE, cache.Items + CACHE_CAPACITY, cache.Items);
+                cache.Count -= BATCH_SIZE;
+
+                m_Flushes.fetch_add(1, std::memory_order_relaxed);
+#if defined(_DEBUG)
+                GetMemoryStats().ConcurrentPoolFlushes.fetch_add(1, std::memory_order_relaxed);
+#endif
+            }
+
+            cache.Items[cache.Count++] = node->Index;
+        }
+
+        /**
+         * @brief Get the number of active (acquired) objects
+         * @return Active object count
+         */
+        size_t GetActiveCount() const { return m_ActiveCount.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Get the total capacity of the pool
+         * @return Total object count
+         */
+        size_t GetTotalCapacity() const
+        {
+            return static_cast<size_t>(m_ChunkCountPublished.load(std::memory_order_relaxed)) * (m_ChunkMask + 1);
+        }
+
+        /**
+         * @brief Check if auto-expansion is enabled
+         * @return true if pool will expand when exhausted
+         */
+        bool IsAutoExpandEnabled() const { return m_AutoExpand.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Enable or disable auto-expansion
+         * @param enable Whether to enable auto-expansion
+         */
+        void SetAutoExpand(bool enable) { m_AutoExpand.store(enable, std::memory_order_relaxed); }
+
+        /**
+         * @brief Get a snapshot of this pool's contention counters
+         */
+        ConcurrentPoolStats GetStats() const
+        {
+            ConcurrentPoolStats stats;
+            stats.CASRetries = m_CASRetries.load(std::memory_order_relaxed);
+            stats.Refills = m_Refills.load(std::memory_order_relaxed);
+            stats.Flushes = m_Flushes.load(std::memory_order_relaxed);
+            stats.UncachedOps = m_UncachedOps.load(std::memory_order_relaxed);
+            stats.Expansions = m_Expansions.load(std::memory_order_relaxed);
+            return stats;
+        }
+
+    private:
+        static constexpr uint32_t INVALID_INDEX = ~0u;
+
+        struct Node
+        {
+            alignas(T) unsigned char Storage[sizeof(T)];   // Must stay first (see Release)
+            std::atomic<uint32_t> Next;                    // Next free node in the same batch
+            std::atomic<uint32_t> NextBatch;               // Next batch on the global stack
+            uint32_t Index;                                // This node's pool index
+        };
+
+        struct alignas(64) ThreadCache
+        {
+            uint32_t Count = 0;
+            uint32_t Items[CACHE_CAPACITY];
+        };
+
+        static uint64_t PackHead(uint32_t index, uint32_t tag)
+        {
+            return (static_cast<uint64_t>(tag) << 32) | index;
+        }
+
+        static uint32_t HeadIndex(uint64_t head) { return static_cast<uint32_t>(head); }
+        static uint32_t HeadTag(uint64_t head) { return static_cast<uint32_t>(head >> 32); }
+
+        Node* GetNode(uint32_t index) const
+        {
+            return m_Chunks[index >> m_ChunkShift].load(std::memory_order_relaxed) + (index & m_ChunkMask);
+        }
+
+        uint32_t AcquireIndex()
+        {
+            uint32_t slot = Detail::GetThreadCacheSlot();
+            if (slot == Detail::NO_THREAD_CACHE)
+            {
+                CountUncached();
+
+                // Keep the batch head and hand the rest straight back
+                uint32_t batch = PopBatchOrExpand();
+                if (batch != INVALID_INDEX)
+                {
+                    uint32_t rest = GetNode(batch)->Next.load(std::memory_order_relaxed);
+                    if (rest != INVALID_INDEX)
+                    {
+                        PushBatch(rest);
+                    }
+                }
+                return batch;
+            }
+
+            ThreadCache& cache = m_Caches[slot];
+            if (cache.Count == 0)
+            {
+                uint32_t batch = PopBatchOrExpand();
+                if (batch == INVALID_INDEX)
+                {
+                    return INVALID_INDEX;
+                }
+
+                for (uint32_t i = batch; i != INVALID_INDEX; i = GetNode(i)->Next.load(std::memory_order_relaxed))
+                {
+                    assert(cache.Count < CACHE_CAPACITY && "Batch larger than thread cache");
+                    cache.Items[cache.Count++] = i;
+                }
+
+                m_Refills.fetch_add(1, std::memory_order_relaxed);
+#if defined(_DEBUG)
+                GetMemoryStats().ConcurrentPoolRefills.fetch_add(1, std::memory_order_relaxed);
+#endif
+            }
+
+            return cache.Items[--cache.Count];
+        }
+
+        /**
+         * @brief Push a batch (linked through Next) onto the global stack
+         * @param first Index of the batch's first node
+         */
+        void PushBatch(uint32_t first)
+        {
+            Node* node = GetNode(first);
+            uint64_t head = m_Head.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                node->NextBatch.store(HeadIndex(head), std::memory_order_relaxed);
+                if (m_Head.compare_exchange_weak(head, PackHead(first, HeadTag(head) + 1),
+                                                 std::memory_order_release, std::memory_order_relaxed))
+                {
+                    return;
+                }
+                CountCASRetry();
+            }
+        }
+
+        /**
+         * @brief Pop a whole batch from the global stack
+         * @return Index of the batch's first node, INVALID_INDEX if the stack is empty
+         */
+        uint32_t PopBatch()
+        {
+            uint64_t head = m_Head.load(std::memory_order_acquire);
+            for (;;)
+            {
+                uint32_t index = HeadIndex(head);
+                if (index == INVALID_INDEX)
+                {
+                    return INVALID_INDEX;
+                }
+
+                // May read a stale link if another thread wins the race; the tag then fails the CAS
+                uint32_t next = GetNode(index)->NextBatch.load(std::memory_order_relaxed);
+                if (m_Head.compare_exchange_weak(head, PackHead(next, HeadTag(head) + 1),
+                                                 std::memory_order_acquire, std::memory_order_acquire))
+                {
+                    return index;
+                }
+                CountCASRetry();
+            }
+        }
+
+        uint32_t PopBatchOrExpand()
+        {
+            uint32_t batch = PopBatch();
+            while (batch == INVALID_INDEX)
+            {
+                if (!m_AutoExpand.load(std::memory_order_relaxed))
+                {
+                    return INVALID_INDEX;
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(m_ExpandMutex);
+
+                    // Another thread may have expanded (or released) while we waited
+                    if (HeadIndex(m_Head.load(std::memory_order_acquire)) == INVALID_INDEX && !AddChunk())
+                    {
+                        return INVALID_INDEX;
+                    }
+                }
+
+                batch = PopBatch();
+            }
+            return batch;
+        }
+
+        /**
+         * @brief Allocate one chunk and push it as batches (m_ExpandMutex must be held)
+         * @return false if the chunk limit was reached
+         */
+        bool AddChunk()
+        {
+            if (m_ChunkCount >= MAX_CHUNKS)
+            {
+                return false;
+            }
+
+            uint32_t chunkSize = m_ChunkMask + 1;
+            Node* chunk = static_cast<Node*>(
+                ::operator new(sizeof(Node) * chunkSize, std::align_val_t{ alignof(Node) })
+            );
+
+            uint32_t base = m_ChunkCount << m_ChunkShift;
+            for (uint32_t i = 0; i < chunkSize; ++i)
+            {
+                Node* node = new (&chunk[i]) Node;
+                node->Index = base + i;
+                bool lastInBatch = (i % BATCH_SIZE) == BATCH_SIZE - 1 || i + 1 == chunkSize;
+                node->Next.store(lastInBatch ? INVALID_INDEX : base + i + 1, std::memory_order_relaxed);
+                node->NextBatch.store(INVALID_INDEX, std::memory_order_relaxed);
+            }
+
+            m_Chunks[m_ChunkCount].store(chunk, std::memory_order_relaxed);
+            m_ChunkCount++;
+            m_ChunkCountPublished.store(m_ChunkCount, std::memory_order_relaxed);
+
+            // The release CAS in PushBatch publishes the chunk pointer and node headers
+            for (uint32_t i = 0; i < chunkSize; i += BATCH_SIZE)
+            {
+                PushBatch(base + i);
+            }
+
+            m_Expansions.fetch_add(1, std::memory_order_relaxed);
+#if defined(_DEBUG)
+            GetMemoryStats().RecordAllocation(sizeof(Node) * chunkSize);
+#endif
+            return true;
+        }
+
+        void CountCASRetry()
+        {
+            m_CASRetries.fetch_add(1, std::memory_order_relaxed);
+#if defined(_DEBUG)
+            GetMemoryStats().ConcurrentPoolCASRetries.fetch_add(1, std::memory_order_relaxed);
+#endif
+        }
+
+        void CountUncached()
+        {
+            m_UncachedOps.fetch_add(1, std::memory_order_relaxed);
+#if defined(_DEBUG)
+            GetMemoryStats().ConcurrentPoolUncachedOps.fetch_add(1, std::memory_order_relaxed);
+#endif
+        }
+
+        alignas(64) std::atomic<uint64_t> m_Head{ PackHead(INVALID_INDEX, 0) };  // Global stack of batches
+
+        std::array<ThreadCache, Detail::MAX_THREAD_CACHES> m_Caches;
+        std::array<std::atomic<Node*>, MAX_CHUNKS> m_Chunks;
+
+        uint32_t m_ChunkShift = 5;                      // log2(objects per chunk), at least log2(BATCH_SIZE)
+        uint32_t m_ChunkMask = 0;
+        uint32_t m_ChunkCount = 0;                      // Guarded by m_ExpandMutex
+        std::atomic<uint32_t> m_ChunkCountPublished{ 0 };
+        std::atomic<bool> m_AutoExpand{ true };
+        std::mutex m_ExpandMutex;                       // Only taken to grow the pool
+
+        std::atomic<size_t> m_ActiveCount{ 0 };
+        std::atomic<size_t> m_CASRetries{ 0 };
+        std::atomic<size_t> m_Refills{ 0 };
+        std::atomic<size_t> m_Flushes{ 0 };
+        std::atomic<size_t> m_UncachedOps{ 0 };
+        std::atomic<size_t> m_Expansions{ 0 };
+    };
+
+    // ============================================================================
+    // General Allocator
+    // ============================================================================
+
+    /**
+     * @brief Always-on counters of the general allocator's OS memory
+     */
+    struct GeneralAllocatorStats
+    {
+        size_t SpanBytes = 0;           ///< Reserved for small size classes (kept until exit)
+        size_t LargeBytes = 0;          ///< Live allocations above MAX_SMALL_SIZE
+        size_t LargeAllocations = 0;
+    };
+
+    /**
+     * @brief Thread-caching size-class allocator for general-purpose memory
+     *
+     * Requests up to MAX_SMALL_SIZE are rounded to one of SIZE_CLASS_COUNT
+     * classes (16-byte steps to 128, then four steps per doubling) and carved
+     * from SPAN_SIZE spans aligned to their size, so Free finds a block's span
+     * and class by masking the pointer. Each thread keeps a free list per
+     * class and moves blocks to and from the class's central list in batches,
+     * so most Allocate/Free pairs touch no shared state. A block may be freed
+     * on any thread; it joins that thread's cache. Larger requests get their
+     * own OS allocation; one aligned to SPAN_SIZE or more keeps its header in
+     * the SPAN_SIZE slot below the data.
+     *
+     * Every block records the MemoryTag it was allocated under (a byte per
+     * block beside the span header), so frees are counted against the right
+     * subsystem in MemoryStats however they arrive. Allocate without a tag
+     * uses the calling thread's tag (see ScopedMemoryTag).
+     *
+     * Everything here is constant-initialized and never calls operator new,
+     * so it can back a replaced global operator new (SM_REPLACE_GLOBAL_NEW).
+     */
+    class GeneralAllocator
+    {
+    public:
+        static constexpr size_t SPAN_SIZE = 64 * 1024;          ///< Span size and alignment (the Windows allocation granularity)
+        static constexpr size_t MAX_SMALL_SIZE = 8 * 1024;      ///< Largest size-class request
+        static constexpr size_t MAX_SMALL_ALIGNMENT = 256;      ///< Larger alignments get their own allocation
+        static constexpr uint32_t SIZE_CLASS_COUNT = 32;
+
+        GeneralAllocator() = delete;
+
+        /**
+         * @brief Allocate under the calling thread's tag
+         * @param size Bytes to allocate (0 is treated as 1)
+         * @param alignment Power of two
+         * @return Memory, or nullptr if the OS is out of memory
+         */
+        static void* Allocate(size_t size, size_t alignment = DEFAULT_ALIGNMENT)
+        {
+            return Allocate(size, alignment, GetThreadTag());
+        }
+
+        /**
+         * @brief Allocate under an explicit tag
+         */
+        static void* Allocate(size_t size, size_t alignment, MemoryTag tag);
+
+        /**
+         * @brief Free memory from Allocate (any thread; nullptr is ignored)
+         */
+        static void Free(void* ptr);
+
+        /**
+         * @brief Get the usable size of an allocation (at least the requested size)
+         */
+        static size_t GetUsableSize(const void* ptr);
+
+        /**
+         * @brief Get the tag an allocation was counted under
+         */
+        static MemoryTag GetTag(const void* ptr);
+
+        /**
+         * @brief Get the size class serving a request, or SIZE_CLASS_COUNT above MAX_SMALL_SIZE
+         */
+        static uint32_t GetSizeClass(size_t size);
+
+        /**
+         * @brief Get the block size of a size class
+         */
+        static size_t GetClassSize(uint32_t sizeClass);
+
+        /**
+         * @brief Get or set the tag untagged Allocate calls on this thread use
+         */
+        static MemoryTag GetThreadTag();
+        static void SetThreadTag(MemoryTag tag);
+
+        /**
+         * @brief Return the calling thread's cached blocks to the central lists
+         *
+         * Runs automatically when a thread exits.
+         */
+        static void FlushThreadCache();
+
+        /**
+         * @brief Get a snapshot of the OS memory counters
+         */
+        static GeneralAllocatorStats GetStats();
+    };
+
+    /**
+     * @brief Tag untagged general allocations on this thread for a scope
+     *
+     * Example usage:
+     * @code
+     *   ScopedMemoryTag tag(MemoryTag::PCG);
+     *   void* scratch = GeneralAllocator::Allocate(bytes);     // Counted under PCG
+     * @endcode
+     */
+    class ScopedMemoryTag
+    {
+    public:
+        explicit ScopedMemoryTag(MemoryTag tag)
+            : m_Previous(GeneralAllocator::GetThreadTag())
+        {
+            GeneralAllocator::SetThreadTag(tag);
+        }
+
+        ~ScopedMemoryTag()
+        {
+            GeneralAllocator::SetThreadTag(m_Previous);
+        }
+
+        // Non-copyable
+        ScopedMemoryTag(const ScopedMemoryTag&) = delete;
+        ScopedMemoryTag& operator=(const ScopedMemoryTag&) = delete;
+
+    private:
+        MemoryTag m_Previous;
+    };
+
+    /**
+     * @brief std::pmr adapter that allocates from GeneralAllocator under a fixed tag
+     *
+     * Points containers at the general allocator per subsystem without
+     * replacing global new:
+     * @code
+     *   std::pmr::vector<Vertex> vertices(MemoryManager::Get().GetMemoryResource(MemoryTag::PCG));
+     * @endcode
+     * All instances share one heap, so any of them frees another's memory.
+     */
+    class GeneralMemoryResource final : public std::pmr::memory_resource
+    {
+    public:
+        explicit GeneralMemoryResource(MemoryTag tag = MemoryTag::Untagged) : m_Tag(tag) {}
+
+        MemoryTag GetTag() const { return m_Tag; }
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+        MemoryTag m_Tag;
+    };
+
     // ============================================================================
     // Scoped Stack Allocation Helper
     // ============================================================================
@@ -656,10 +1397,15 @@ namespace SM
          * @brief Initialize the memory manager with specified sizes
          * @param frameStackSize Size of per-frame stack allocator
          * @param persistentStackSize Size of persistent stack allocator
+         * @param stackReserveSize Address space each stack reserves and grows into on demand;
+         *                         the sizes above become the initial commits. 0 = fixed stacks.
          * @return true if initialization succeeded
+         *
+         * The growable frame stack decommits its spike pages on each clear.
          */
         bool Initialize(size_t frameStackSize = 4 * 1024 * 1024,
-                       size_t persistentStackSize = 16 * 1024 * 1024);
+                       size_t persistentStackSize = 16 * 1024 * 1024,
+                       size_t stackReserveSize = 0);
 
         /**
          * @brief Shutdown and release all memory
@@ -683,6 +1429,47 @@ namespace SM
          */
         void ClearFrameStack();
 
+        /**
+         * @brief Enable per-thread frame arenas
+         * @param bufferCount Frames in flight (match the renderer's FrameContext count)
+         * @param arenaSize Bytes per arena; each thread gets bufferCount of them
+         * @return true if the arenas were configured
+         */
+        bool InitializeFrameArenas(uint32_t bufferCount, size_t arenaSize);
+
+        /**
+         * @brief Switch every thread to its arena for a buffered frame
+         * @param frameIndex Buffered frame being recorded (e.g. the swap chain frame index)
+         *
+         * Resets each thread's arena for frameIndex. Call only once the GPU
+         * fence of the previous frame that used this index has completed.
+         */
+        void BeginFrameArenas(uint32_t frameIndex);
+
+        /**
+         * @brief Get the calling thread's arena for the current frame
+         * @return Arena, or nullptr if frame arenas are not initialized
+         *
+         * Every thread bump-allocates from its own arena, so no lock is shared
+         * between threads. Allocations stay valid until the same frame index
+         * comes round again, i.e. until the GPU has consumed that frame.
+         * A thread's arenas are created on first use and kept until Shutdown,
+         * so use this from long-lived threads (main thread, workers).
+         */
+        StackAllocator* GetThreadFrameArena();
+
+        /**
+         * @brief Get the number of buffered frames per thread (0 if disabled)
+         */
+        uint32_t GetFrameArenaBufferCount() const { return m_FrameArenaBufferCount; }
+
+        /**
+         * @brief Get the general allocator's memory resource for a subsystem
+         * @param tag Subsystem the container's memory is counted under
+         * @return Resource that lives for the whole program
+         */
+        std::pmr::memory_resource* GetMemoryResource(MemoryTag tag);
+
         /**
          * @brief Check if the memory manager is initialized
          * @return true if initialized
@@ -710,6 +1497,16 @@ namespace SM
         std::unique_ptr<StackAllocator> m_FrameStack;
         std::unique_ptr<StackAllocator> m_PersistentStack;
 
+        // Per-thread frame arenas, one per buffered frame
+        using ThreadFrameArenas = std::vector<std::unique_ptr<StackAllocator>>;
+
+        std::mutex m_FrameArenaMutex;                           // Guards registration and reset
+        std::vector<std::unique_ptr<ThreadFrameArenas>> m_ThreadFrameArenas;
+        uint32_t m_FrameArenaBufferCount = 0;
+        size_t m_FrameArenaSize = 0;
+        std::atomic<uint32_t> m_FrameArenaIndex{ 0 };
+        std::atomic<uint32_t> m_FrameArenaGeneration{ 0 };      // Invalidates threads' cached arena pointers
+
 #if defined(_DEBUG)
         MemoryStats m_Stats;
 #endif
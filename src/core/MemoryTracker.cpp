@@ -0,0 +1,356 @@
+#include "core/MemoryTracker.h"
+
+#include <algorithm>
+#include <bit>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <Windows.h>
+#include <DbgHelp.h>
+#endif
+
+namespace SM
+{
+    namespace
+    {
+        /// Allocations since this thread's last sample
+        constinit thread_local uint32_t t_SampleCounter = 0;
+
+        /// Set while capturing, so allocations made by the capture itself are not sampled
+        constinit thread_local bool t_InSample = false;
+
+        uint32_t CaptureStack(void** frames, uint32_t maxFrames)
+        {
+#ifdef _WIN32
+            // Skip CaptureStack, RecordSample and RecordAllocation
+            return RtlCaptureStackBackTrace(3, maxFrames, frames, nullptr);
+#else
+            (void)frames;
+            (void)maxFrames;
+            return 0;
+#endif
+        }
+
+        uint64_t HashSample(void* const* frames, uint32_t frameCount, MemoryTag tag)
+        {
+            // FNV-1a over the frame addresses and tag; never 0, which marks empty slots
+            uint64_t hash = 14695981039346656037ull ^ static_cast<uint64_t>(tag);
+            for (uint32_t i = 0; i < frameCount; ++i)
+            {
+                hash = (hash ^ reinterpret_cast<uintptr_t>(frames[i])) * 1099511628211ull;
+            }
+            return hash ? hash : 1;
+        }
+
+        size_t GetHistogramBucket(uint64_t count)
+        {
+            const size_t bucket = static_cast<size_t>(std::bit_width(count));
+            return std::min(bucket, MemoryTracker::HISTOGRAM_BUCKETS - 1);
+        }
+    }
+
+    MemoryTracker& MemoryTracker::Get()
+    {
+        // Constant-initialized, so usable from operator new before any constructor runs
+        static constinit MemoryTracker instance;
+        return instance;
+    }
+
+    // ============================================================================
+    // Recording
+    // ============================================================================
+
+    void MemoryTracker::RecordAllocation(MemoryTag tag, size_t bytes)
+    {
+        TagCounters& counters = m_Counters[static_cast<size_t>(tag)];
+        counters.Allocations.fetch_add(1, std::memory_order_relaxed);
+        counters.AllocatedBytes.fetch_add(bytes, std::memory_order_relaxed);
+        counters.LiveBytes.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+        m_FrameAllocations.fetch_add(1, std::memory_order_relaxed);
+
+        const uint32_t rate = m_SampleRate.load(std::memory_order_relaxed);
+        if (rate != 0 && ++t_SampleCounter >= rate && !t_InSample)
+        {
+            t_SampleCounter = 0;
+            RecordSample(tag, bytes);
+        }
+    }
+
+    void MemoryTracker::RecordFree(MemoryTag tag, size_t bytes)
+    {
+        TagCounters& counters = m_Counters[static_cast<size_t>(tag)];
+        counters.Frees.fetch_add(1, std::memory_order_relaxed);
+        counters.LiveBytes.fetch_sub(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+    }
+
+    void MemoryTracker::RecordSample(MemoryTag tag, size_t bytes)
+    {
+        t_InSample = true;
+
+        void* frames[AllocationSample::MAX_FRAMES];
+        const uint32_t frameCount = CaptureStack(frames, AllocationSample::MAX_FRAMES);
+        const uint64_t hash = HashSample(frames, frameCount, tag);
+
+        LockSamples();
+
+        // Linear probing; the table never shrinks until ResetSamples
+        size_t slot = static_cast<size_t>(hash % SAMPLE_CAPACITY);
+        bool recorded = false;
+        for (size_t probe = 0; probe < SAMPLE_CAPACITY; ++probe)
+        {
+            AllocationSample& sample = m_Samples[slot];
+            if (sample.Hash == 0)
+            {
+                sample.Hash = hash;
+                std::copy(frames, frames + frameCount, sample.Frames);
+                sample.FrameCount = frameCount;
+                sample.Tag = tag;
+            }
+
+            if (sample.Hash == hash)
+            {
+                sample.Count++;
+                sample.Bytes += bytes;
+                sample.LastFrame = m_FrameNumber;
+                recorded = true;
+                break;
+            }
+
+            slot = (slot + 1) % SAMPLE_CAPACITY;
+        }
+
+        UnlockSamples();
+
+        if (!recorded)
+        {
+            m_DroppedSamples.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        t_InSample = false;
+    }
+
+    void MemoryTracker::LockSamples() const
+    {
+        while (m_SampleLock.test_and_set(std::memory_order_acquire))
+        {
+            while (m_SampleLock.test(std::memory_order_relaxed))
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    // ============================================================================
+    // Frames
+    // ============================================================================
+
+    void MemoryTracker::BeginFrame()
+    {
+        const uint64_t count = m_FrameAllocations.exchange(0, std::memory_order_relaxed);
+
+        // The first call has no frame before it
+        if (m_FrameNumber > 0)
+        {
+            m_FrameHistory[m_FrameHistoryIndex] = static_cast<uint32_t>(std::min<uint64_t>(count, UINT32_MAX));
+            m_FrameHistoryIndex = (m_FrameHistoryIndex + 1) % FRAME_HISTORY;
+            m_Histogram[GetHistogramBucket(count)]++;
+        }
+        m_FrameNumber++;
+
+        const auto now = std::chrono::steady_clock::now();
+        const float elapsed = std::chrono::duration<float>(now - m_RateTime).count();
+        if (elapsed < RATE_INTERVAL)
+        {
+            return;
+        }
+
+        const bool hasPrevious = m_RateTime != std::chrono::steady_clock::time_point{};
+        for (size_t i = 0; i < MEMORY_TAG_COUNT; ++i)
+        {
+            const uint64_t allocations = m_Counters[i].Allocations.load(std::memory_order_relaxed);
+            const uint64_t bytes = m_Counters[i].AllocatedBytes.load(std::memory_order_relaxed);
+
+            if (hasPrevious)
+            {
+                m_AllocationsPerSecond[i] = static_cast<float>(allocations - m_RateAllocations[i]) / elapsed;
+                m_BytesPerSecond[i] = static_cast<float>(bytes - m_RateBytes[i]) / elapsed;
+            }
+
+            m_RateAllocations[i] = allocations;
+            m_RateBytes[i] = bytes;
+        }
+        m_RateTime = now;
+    }
+
+    void MemoryTracker::GetFrameHistory(std::array<float, FRAME_HISTORY>& outCounts) const
+    {
+        for (size_t i = 0; i < FRAME_HISTORY; ++i)
+        {
+            outCounts[i] = static_cast<float>(m_FrameHistory[(m_FrameHistoryIndex + i) % FRAME_HISTORY]);
+        }
+    }
+
+    // ============================================================================
+    // Queries
+    // ============================================================================
+
+    MemoryTagStats MemoryTracker::GetTagStats(MemoryTag tag) const
+    {
+        const size_t index = static_cast<size_t>(tag);
+        const TagCounters& counters = m_Counters[index];
+
+        MemoryTagStats stats;
+        stats.Allocations = counters.Allocations.load(std::memory_order_relaxed);
+        stats.Frees = counters.Frees.load(std::memory_order_relaxed);
+        stats.LiveBytes = counters.LiveBytes.load(std::memory_order_relaxed);
+        stats.AllocationsPerSecond = m_AllocationsPerSecond[index];
+        stats.BytesPerSecond = m_BytesPerSecond[index];
+        return stats;
+    }
+
+    void MemoryTracker::GetSamples(std::vector<AllocationSample>& outSamples, size_t maxCount) const
+    {
+        outSamples.clear();
+
+        // Copy under the lock, sort outside it: the vector may allocate through the tracked heap
+        std::vector<AllocationSample> samples;
+        samples.reserve(SAMPLE_CAPACITY);
+
+        t_InSample = true;
+        LockSamples();
+        for (const AllocationSample& sample : m_Samples)
+        {
+            if (sample.Hash != 0 && samples.size() < samples.capacity())
+            {
+                samples.push_back(sample);
+            }
+        }
+        UnlockSamples();
+        t_InSample = false;
+
+        std::sort(samples.begin(), samples.end(), [](const AllocationSample& a, const AllocationSample& b) {
+            return a.Bytes > b.Bytes;
+        });
+
+        samples.resize(std::min(samples.size(), maxCount));
+        outSamples = std::move(samples);
+    }
+
+    void MemoryTracker::ResetSamples()
+    {
+        LockSamples();
+        m_Samples.fill(AllocationSample{});
+        UnlockSamples();
+
+        m_DroppedSamples.store(0, std::memory_order_relaxed);
+        m_Histogram.fill(0);
+        m_FrameHistory.fill(0);
+    }
+
+    bool MemoryTracker::DumpToFile(const std::string& path) const
+    {
+        std::ofstream file(path);
+        if (!file)
+        {
+            std::cerr << "[MemoryTracker] Failed to open " << path << std::endl;
+            return false;
+        }
+
+        file << "=== Memory Tracker (frame " << m_FrameNumber << ") ===\n\n";
+
+        file << "Tag          Allocations      Frees       Live bytes    Allocs/s      Bytes/s\n";
+        for (size_t i = 0; i < MEMORY_TAG_COUNT; ++i)
+        {
+            const MemoryTagStats stats = GetTagStats(static_cast<MemoryTag>(i));
+            file << std::left << std::setw(10) << GetMemoryTagName(static_cast<MemoryTag>(i)) << std::right
+                 << std::setw(14) << stats.Allocations << std::setw(11) << stats.Frees
+                 << std::setw(17) << stats.LiveBytes << std::fixed << std::setprecision(1)
+                 << std::setw(12) << stats.AllocationsPerSecond << std::setw(13) << stats.BytesPerSecond << '\n';
+        }
+
+        file << "\nAllocations per frame (frames in bucket):\n";
+        for (size_t bucket = 0; bucket < HISTOGRAM_BUCKETS; ++bucket)
+        {
+            const uint32_t start = GetBucketStart(bucket);
+            file << "  " << std::setw(6) << start;
+            if (bucket + 1 < HISTOGRAM_BUCKETS)
+            {
+                file << " - " << std::setw(6) << (GetBucketStart(bucket + 1) > 0 ? GetBucketStart(bucket + 1) - 1 : 0);
+            }
+            else
+            {
+                file << " +       ";
+            }
+            file << ": " << m_Histogram[bucket] << '\n';
+        }
+
+        std::vector<AllocationSample> samples;
+        GetSamples(samples);
+
+        const uint32_t rate = GetSampleRate();
+        file << "\nSampled callstacks (1 in " << rate << " allocations per thread, heaviest first; "
+             << GetDroppedSamples() << " dropped):\n";
+
+#ifdef _WIN32
+        HANDLE process = GetCurrentProcess();
+        const bool symbols = SymInitialize(process, nullptr, TRUE) != FALSE;
+        if (symbols)
+        {
+            SymSetOptions(SymGetOptions() | SYMOPT_LOAD_LINES | SYMOPT_UNDNAME);
+        }
+#endif
+
+        for (const AllocationSample& sample : samples)
+        {
+            file << "\n[" << GetMemoryTagName(sample.Tag) << "] " << sample.Count << " samples, "
+                 << sample.Bytes << " bytes (~" << sample.Count * rate << " allocations), last frame "
+                 << sample.LastFrame << '\n';
+
+            for (uint32_t i = 0; i < sample.FrameCount; ++i)
+            {
+                file << "    0x" << std::hex << reinterpret_cast<uintptr_t>(sample.Frames[i]) << std::dec;
+
+#ifdef _WIN32
+                if (symbols)
+                {
+                    alignas(SYMBOL_INFO) char buffer[sizeof(SYMBOL_INFO) + MAX_SYM_NAME];
+                    SYMBOL_INFO* symbol = reinterpret_cast<SYMBOL_INFO*>(buffer);
+                    symbol->SizeOfStruct = sizeof(SYMBOL_INFO);
+                    symbol->MaxNameLen = MAX_SYM_NAME;
+
+                    const DWORD64 address = reinterpret_cast<DWORD64>(sample.Frames[i]);
+                    if (SymFromAddr(process, address, nullptr, symbol))
+                    {
+                        file << ' ' << symbol->Name;
+                    }
+
+                    IMAGEHLP_LINE64 line = {};
+                    line.SizeOfStruct = sizeof(line);
+                    DWORD displacement = 0;
+                    if (SymGetLineFromAddr64(process, address, &displacement, &line))
+                    {
+                        file << " (" << line.FileName << ':' << line.LineNumber << ')';
+                    }
+                }
+#endif
+                file << '\n';
+            }
+        }
+
+#ifdef _WIN32
+        if (symbols)
+        {
+            SymCleanup(process);
+        }
+#endif
+
+        return file.good();
+    }
+
+} // namespace SM
@@ -0,0 +1,224 @@
+#pragma once
+
+/**
+ * @file MemoryTracker.h
+ * @brief Shattered Moon Engine - Allocation tracking for finding hot-path allocations
+ *
+ * GeneralAllocator reports every allocation and free here. The tracker keeps
+ * per-MemoryTag counters of live bytes and allocation rates, samples the
+ * callstack of one allocation in SampleRate per thread, and records how many
+ * allocations each frame made in a history and a histogram. StatsPanel shows
+ * all three; ConsolePanel's "memdump" command writes them to a file with the
+ * sampled stacks symbolized.
+ *
+ * Only GeneralAllocator traffic is seen, so configure with
+ * SM_REPLACE_GLOBAL_NEW=ON to track STL containers and other operator new
+ * users too.
+ *
+ * Everything is constant-initialized and trivially destructible, and
+ * recording never allocates, so it is safe inside a replaced operator new
+ * and during static destruction.
+ */
+
+#include "core/Memory.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace SM
+{
+    // ============================================================================
+    // Tracking Data
+    // ============================================================================
+
+    /**
+     * @brief Counters of one MemoryTag, as read by GetTagStats
+     */
+    struct MemoryTagStats
+    {
+        uint64_t Allocations = 0;
+        uint64_t Frees = 0;
+        int64_t LiveBytes = 0;                  ///< Block sizes, so includes size-class rounding
+        float AllocationsPerSecond = 0.0f;      ///< Over the last RATE_INTERVAL
+        float BytesPerSecond = 0.0f;
+    };
+
+    /**
+     * @brief Allocations sampled with the same callstack and tag
+     */
+    struct AllocationSample
+    {
+        static constexpr uint32_t MAX_FRAMES = 16;
+
+        uint64_t Hash = 0;                      ///< Of the stack and tag; 0 marks an empty slot
+        void* Frames[MAX_FRAMES] = {};
+        uint32_t FrameCount = 0;
+        MemoryTag Tag = MemoryTag::Untagged;
+        uint64_t Count = 0;                     ///< Samples taken here (times SampleRate estimates the total)
+        uint64_t Bytes = 0;
+        uint64_t LastFrame = 0;
+    };
+
+    // ============================================================================
+    // Memory Tracker
+    // ============================================================================
+
+    /**
+     * @brief Collects allocation counters, sampled callstacks and per-frame counts
+     *
+     * Record* may be called from any thread. BeginFrame, GetFrameHistory and
+     * DumpToFile belong to the main thread.
+     */
+    class MemoryTracker
+    {
+    public:
+        static constexpr size_t FRAME_HISTORY = 240;                ///< Frames kept for the history plot
+        static constexpr size_t HISTOGRAM_BUCKETS = 16;             ///< 0, 1, 2-3, 4-7, ... 16384+
+        static constexpr size_t SAMPLE_CAPACITY = 1024;             ///< Distinct sampled stacks
+        static constexpr uint32_t DEFAULT_SAMPLE_RATE = 1024;
+        static constexpr float RATE_INTERVAL = 0.5f;                ///< Seconds between rate updates
+
+        constexpr MemoryTracker() = default;
+
+        // Non-copyable
+        MemoryTracker(const MemoryTracker&) = delete;
+        MemoryTracker& operator=(const MemoryTracker&) = delete;
+
+        /**
+         * @brief Get the singleton instance
+         */
+        static MemoryTracker& Get();
+
+        // ====================================================================
+        // Recording (any thread)
+        // ====================================================================
+
+        /**
+         * @brief Enable or disable recording (counters keep their values)
+         */
+        void SetEnabled(bool enabled) { m_Enabled.store(enabled, std::memory_order_relaxed); }
+        bool IsEnabled() const { return m_Enabled.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Sample the callstack of one allocation in rate per thread (0 = no sampling)
+         */
+        void SetSampleRate(uint32_t rate) { m_SampleRate.store(rate, std::memory_order_relaxed); }
+        uint32_t GetSampleRate() const { return m_SampleRate.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Count an allocation of bytes under tag
+         */
+        void RecordAllocation(MemoryTag tag, size_t bytes);
+
+        /**
+         * @brief Count a free of bytes under the tag they were allocated with
+         */
+        void RecordFree(MemoryTag tag, size_t bytes);
+
+        // ====================================================================
+        // Frames (main thread)
+        // ====================================================================
+
+        /**
+         * @brief Close the previous frame: file its allocation count and refresh the rates
+         */
+        void BeginFrame();
+
+        /**
+         * @brief Get the allocation count of the last frames, oldest first
+         */
+        void GetFrameHistory(std::array<float, FRAME_HISTORY>& outCounts) const;
+
+        /**
+         * @brief Get how many frames fell in each allocation-count bucket
+         */
+        const std::array<uint64_t, HISTOGRAM_BUCKETS>& GetHistogram() const { return m_Histogram; }
+
+        /**
+         * @brief Get the lowest allocation count of a histogram bucket
+         */
+        static uint32_t GetBucketStart(size_t bucket) { return bucket == 0 ? 0u : 1u << (bucket - 1); }
+
+        uint64_t GetFrameNumber() const { return m_FrameNumber; }
+
+        // ====================================================================
+        // Queries
+        // ====================================================================
+
+        /**
+         * @brief Get a tag's counters and the rates from the last interval
+         */
+        MemoryTagStats GetTagStats(MemoryTag tag) const;
+
+        /**
+         * @brief Copy the sampled stacks, heaviest (by sampled bytes) first
+         * @param outSamples Receives the samples
+         * @param maxCount Most samples to return
+         */
+        void GetSamples(std::vector<AllocationSample>& outSamples, size_t maxCount = SAMPLE_CAPACITY) const;
+
+        /**
+         * @brief Get the number of samples lost to a full sample table
+         */
+        uint64_t GetDroppedSamples() const { return m_DroppedSamples.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Forget the sampled stacks and the frame histogram
+         */
+        void ResetSamples();
+
+        /**
+         * @brief Write tag counters, the frame histogram and symbolized samples as text
+         * @param path Output file
+         * @return true if the file was written
+         */
+        bool DumpToFile(const std::string& path) const;
+
+    private:
+        struct TagCounters
+        {
+            std::atomic<uint64_t> Allocations{ 0 };
+            std::atomic<uint64_t> Frees{ 0 };
+            std::atomic<uint64_t> AllocatedBytes{ 0 };
+            std::atomic<int64_t> LiveBytes{ 0 };
+        };
+
+        /**
+         * @brief Capture the caller's stack into the sample table
+         */
+        void RecordSample(MemoryTag tag, size_t bytes);
+
+        void LockSamples() const;
+        void UnlockSamples() const { m_SampleLock.clear(std::memory_order_release); }
+
+    private:
+        std::atomic<bool> m_Enabled{ true };
+        std::atomic<uint32_t> m_SampleRate{ DEFAULT_SAMPLE_RATE };
+
+        std::array<TagCounters, MEMORY_TAG_COUNT> m_Counters;
+        std::atomic<uint64_t> m_FrameAllocations{ 0 };
+
+        // Sample table (open addressing on AllocationSample::Hash)
+        mutable std::atomic_flag m_SampleLock;
+        std::array<AllocationSample, SAMPLE_CAPACITY> m_Samples{};
+        std::atomic<uint64_t> m_DroppedSamples{ 0 };
+
+        // Frames (main thread)
+        uint64_t m_FrameNumber = 0;
+        std::array<uint32_t, FRAME_HISTORY> m_FrameHistory{};
+        size_t m_FrameHistoryIndex = 0;
+        std::array<uint64_t, HISTOGRAM_BUCKETS> m_Histogram{};
+
+        // Rates (main thread); counters as of the last rate update
+        std::chrono::steady_clock::time_point m_RateTime{};
+        std::array<uint64_t, MEMORY_TAG_COUNT> m_RateAllocations{};
+        std::array<uint64_t, MEMORY_TAG_COUNT> m_RateBytes{};
+        std::array<float, MEMORY_TAG_COUNT> m_AllocationsPerSecond{};
+        std::array<float, MEMORY_TAG_COUNT> m_BytesPerSecond{};
+    };
+
+} // namespace SM
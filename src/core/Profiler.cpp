@@ -0,0 +1,332 @@
+#include "core/Profiler.h"
+#include "core/FileSystem.h"
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+
+namespace SM
+{
+    namespace
+    {
+        /// The calling thread's ring, registered on its first event
+        thread_local void* t_ThreadBuffer = nullptr;
+
+        /// Open ProfileScopes on the calling thread
+        thread_local uint32_t t_Depth = 0;
+
+        /**
+         * @brief Append a string as a JSON string literal
+         */
+        void AppendJSONString(std::string& out, const char* text)
+        {
+            out += '"';
+            for (const char* c = text ? text : ""; *c; ++c)
+            {
+                switch (*c)
+                {
+                    case '"':  out += "\\\""; break;
+                    case '\\': out += "\\\\"; break;
+                    case '\n': out += "\\n"; break;
+                    case '\t': out += "\\t"; break;
+                    default:
+                        if (static_cast<unsigned char>(*c) >= 0x20)
+                        {
+                            out += *c;
+                        }
+                        break;
+                }
+            }
+            out += '"';
+        }
+
+        /**
+         * @brief Append one complete ("X") trace event
+         */
+        void AppendTraceEvent(std::string& out, const ProfileEvent& event, int64_t origin,
+                              uint32_t pid, uint32_t tid)
+        {
+            char buffer[128];
+            out += "{\"name\":";
+            AppendJSONString(out, event.Name);
+            snprintf(buffer, sizeof(buffer), ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%u,\"tid\":%u},\n",
+                     static_cast<double>(event.Start - origin) / 1000.0,
+                     static_cast<double>(event.End - event.Start) / 1000.0,
+                     pid, tid);
+            out += buffer;
+        }
+
+        /**
+         * @brief Append a process or thread name metadata event
+         */
+        void AppendNameEvent(std::string& out, const char* kind, uint32_t pid, uint32_t tid, const char* name)
+        {
+            char buffer[96];
+            snprintf(buffer, sizeof(buffer), "{\"name\":\"%s\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":",
+                     kind, pid, tid);
+            out += buffer;
+            AppendJSONString(out, name);
+            out += "}},\n";
+        }
+    }
+
+    // ============================================================================
+    // Profiler Implementation
+    // ============================================================================
+
+    Profiler& Profiler::Get()
+    {
+        static Profiler instance;
+        return instance;
+    }
+
+    Profiler::Profiler()
+    {
+        m_FrameStart = Now();
+    }
+
+    int64_t Profiler::Now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void Profiler::SetThreadName(const std::string& name)
+    {
+        ThreadBuffer& buffer = GetThreadBuffer();
+
+        std::lock_guard<std::mutex> lock(m_ThreadMutex);
+        buffer.Name = name;
+    }
+
+    void Profiler::Record(const char* name, int64_t start, int64_t end, uint32_t depth)
+    {
+        ThreadBuffer& buffer = GetThreadBuffer();
+
+        uint64_t write = buffer.WritePosition.load(std::memory_order_relaxed);
+        if (write - buffer.ReadPosition.load(std::memory_order_acquire) >= THREAD_CAPACITY)
+        {
+            m_DroppedCount.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        ProfileEvent& event = buffer.Events[write % THREAD_CAPACITY];
+        event.Name = name;
+        event.Start = start;
+        event.End = end;
+        event.Thread = buffer.Index;
+        event.Depth = depth;
+
+        buffer.WritePosition.store(write + 1, std::memory_order_release);
+    }
+
+    const char* Profiler::InternName(std::string_view name)
+    {
+        std::lock_guard<std::mutex> lock(m_NameMutex);
+        return m_Names.emplace(name).first->c_str();
+    }
+
+    // ============================================================================
+    // Frames
+    // ============================================================================
+
+    void Profiler::BeginFrame()
+    {
+        int64_t now = Now();
+
+        if (m_Paused)
+        {
+            // Keep the rings from filling up while the history is frozen
+            DrainThreads(nullptr);
+        }
+        else
+        {
+            ProfileFrame frame;
+            frame.FrameNumber = m_FrameNumber;
+            frame.Start = m_FrameStart;
+            frame.End = now;
+            DrainThreads(&frame);
+
+            m_Frames.push_back(std::move(frame));
+            while (m_Frames.size() > MAX_FRAMES)
+            {
+                m_Frames.pop_front();
+            }
+        }
+
+        m_FrameNumber++;
+        m_FrameStart = now;
+    }
+
+    void Profiler::AddGPUEvents(uint64_t frameNumber, std::vector<ProfileEvent>&& events)
+    {
+        // Results arrive a few frames late, so the frame is near the back
+        for (auto it = m_Frames.rbegin(); it != m_Frames.rend(); ++it)
+        {
+            if (it->FrameNumber == frameNumber)
+            {
+                it->GPUEvents = std::move(events);
+                return;
+            }
+            if (it->FrameNumber < frameNumber)
+            {
+                return;
+            }
+        }
+    }
+
+    // ============================================================================
+    // Queries
+    // ============================================================================
+
+    uint32_t Profiler::GetThreadCount() const
+    {
+        std::lock_guard<std::mutex> lock(m_ThreadMutex);
+        return static_cast<uint32_t>(m_Threads.size());
+    }
+
+    std::string Profiler::GetThreadName(uint32_t thread) const
+    {
+        if (thread == GPU_THREAD)
+        {
+            return "GPU";
+        }
+
+        std::lock_guard<std::mutex> lock(m_ThreadMutex);
+        return thread < m_Threads.size() ? m_Threads[thread]->Name : std::string();
+    }
+
+    // ============================================================================
+    // Export
+    // ============================================================================
+
+    bool Profiler::ExportChromeTrace(const std::string& path) const
+    {
+        if (m_Frames.empty())
+        {
+            std::cerr << "[Profiler] No frames to export" << std::endl;
+            return false;
+        }
+
+        // CPU threads are process 1, the GPU queue process 2
+        constexpr uint32_t CPU_PID = 1;
+        constexpr uint32_t GPU_PID = 2;
+
+        const int64_t origin = m_Frames.front().Start;
+        std::string json;
+        json.reserve(1024 * 1024);
+        json += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+        AppendNameEvent(json, "process_name", CPU_PID, 0, "CPU");
+        AppendNameEvent(json, "process_name", GPU_PID, 0, "GPU");
+        AppendNameEvent(json, "thread_name", GPU_PID, 0, "Direct Queue");
+
+        const uint32_t threadCount = GetThreadCount();
+        for (uint32_t thread = 0; thread < threadCount; ++thread)
+        {
+            AppendNameEvent(json, "thread_name", CPU_PID, thread, GetThreadName(thread).c_str());
+        }
+
+        for (const ProfileFrame& frame : m_Frames)
+        {
+            ProfileEvent frameEvent;
+            frameEvent.Name = "Frame";
+            frameEvent.Start = frame.Start;
+            frameEvent.End = frame.End;
+            AppendTraceEvent(json, frameEvent, origin, CPU_PID, threadCount);
+
+            for (const ProfileEvent& event : frame.CPUEvents)
+            {
+                AppendTraceEvent(json, event, origin, CPU_PID, event.Thread);
+            }
+            for (const ProfileEvent& event : frame.GPUEvents)
+            {
+                AppendTraceEvent(json, event, origin, GPU_PID, 0);
+            }
+        }
+
+        AppendNameEvent(json, "thread_name", CPU_PID, threadCount, "Frames");
+
+        // The last event carries no trailing comma
+        json.erase(json.size() - 2);
+        json += "\n]}\n";
+
+        if (!FileSystem::WriteTextFile(path, json))
+        {
+            std::cerr << "[Profiler] Failed to write trace: " << path << std::endl;
+            return false;
+        }
+
+        std::cout << "[Profiler] Exported " << m_Frames.size() << " frames to " << path << std::endl;
+        return true;
+    }
+
+    // ============================================================================
+    // Private Methods
+    // ============================================================================
+
+    Profiler::ThreadBuffer& Profiler::GetThreadBuffer()
+    {
+        if (t_ThreadBuffer)
+        {
+            return *static_cast<ThreadBuffer*>(t_ThreadBuffer);
+        }
+
+        auto buffer = std::make_unique<ThreadBuffer>();
+        buffer->Events.resize(THREAD_CAPACITY);
+
+        std::lock_guard<std::mutex> lock(m_ThreadMutex);
+        buffer->Index = static_cast<uint32_t>(m_Threads.size());
+        buffer->Name = "Thread " + std::to_string(buffer->Index);
+
+        t_ThreadBuffer = buffer.get();
+        m_Threads.push_back(std::move(buffer));
+        return *m_Threads.back();
+    }
+
+    void Profiler::DrainThreads(ProfileFrame* frame)
+    {
+        std::lock_guard<std::mutex> lock(m_ThreadMutex);
+
+        for (const std::unique_ptr<ThreadBuffer>& buffer : m_Threads)
+        {
+            uint64_t read = buffer->ReadPosition.load(std::memory_order_relaxed);
+            uint64_t write = buffer->WritePosition.load(std::memory_order_acquire);
+
+            if (frame)
+            {
+                for (uint64_t position = read; position < write; ++position)
+                {
+                    frame->CPUEvents.push_back(buffer->Events[position % THREAD_CAPACITY]);
+                }
+            }
+
+            buffer->ReadPosition.store(write, std::memory_order_release);
+        }
+    }
+
+    // ============================================================================
+    // ProfileScope Implementation
+    // ============================================================================
+
+    ProfileScope::ProfileScope(const char* name)
+        : m_Name(Profiler::Get().IsEnabled() ? name : nullptr)
+    {
+        if (m_Name)
+        {
+            t_Depth++;
+            m_Start = Profiler::Now();
+        }
+    }
+
+    ProfileScope::~ProfileScope()
+    {
+        if (m_Name)
+        {
+            int64_t end = Profiler::Now();
+            t_Depth--;
+            Profiler::Get().Record(m_Name, m_Start, end, t_Depth);
+        }
+    }
+
+} // namespace SM
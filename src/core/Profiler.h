@@ -0,0 +1,279 @@
+#pragma once
+
+/**
+ * @file Profiler.h
+ * @brief Shattered Moon Engine - Frame profiler with scoped CPU markers
+ *
+ * SM_PROFILE_SCOPE("Name") times the enclosing scope on any thread. Every
+ * thread writes its finished scopes into its own single-producer ring, so
+ * recording never takes a lock; the main thread drains all rings in
+ * Profiler::BeginFrame and files the events under the frame that just
+ * ended. GPU pass timings (see GPUProfiler) are attached to the same frames
+ * a few frames later, once their timestamp queries have been read back.
+ *
+ * Example usage:
+ * @code
+ *   void ChunkManager::Update(...)
+ *   {
+ *       SM_PROFILE_SCOPE("ChunkManager::Update");
+ *       ...
+ *   }
+ *
+ *   Profiler::Get().ExportChromeTrace("profile.json");  // open in chrome://tracing
+ * @endcode
+ *
+ * Each SM_PROFILE_SCOPE is also an SM_TRACE_SCOPE (see Trace.h), so ETW
+ * captures show the same markers.
+ *
+ * Configure with SM_ENABLE_PROFILER=OFF to compile the markers out; their
+ * trace scopes follow SM_ENABLE_TRACING.
+ */
+
+#include "core/Trace.h"
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace SM
+{
+    // ============================================================================
+    // Profile Data
+    // ============================================================================
+
+    /**
+     * @brief One timed scope
+     */
+    struct ProfileEvent
+    {
+        const char* Name = nullptr;     ///< Static storage (literal or Profiler::InternName)
+        int64_t Start = 0;              ///< Nanoseconds on Profiler::Now
+        int64_t End = 0;
+        uint32_t Thread = 0;            ///< Profiler thread index, or Profiler::GPU_THREAD
+        uint32_t Depth = 0;             ///< Nesting level within its thread
+    };
+
+    /**
+     * @brief Everything recorded between two Profiler::BeginFrame calls
+     */
+    struct ProfileFrame
+    {
+        uint64_t FrameNumber = 0;
+        int64_t Start = 0;
+        int64_t End = 0;
+        std::vector<ProfileEvent> CPUEvents;
+        std::vector<ProfileEvent> GPUEvents;    ///< Filled once the GPU results are read back
+    };
+
+    // ============================================================================
+    // Profiler
+    // ============================================================================
+
+    /**
+     * @brief Collects scoped markers from all threads into a frame history
+     *
+     * Recording is thread-safe and lock-free. BeginFrame, AddGPUEvents,
+     * GetFrames and ExportChromeTrace must be called from the main thread.
+     */
+    class Profiler
+    {
+    public:
+        static constexpr size_t MAX_FRAMES = 300;           ///< Frames kept for the timeline
+        static constexpr uint32_t THREAD_CAPACITY = 4096;   ///< Events a thread can record between drains
+        static constexpr uint32_t GPU_THREAD = ~0u;
+
+        /**
+         * @brief Get the singleton instance
+         */
+        static Profiler& Get();
+
+        /**
+         * @brief Current time in nanoseconds (steady clock)
+         */
+        static int64_t Now();
+
+        // Non-copyable
+        Profiler(const Profiler&) = delete;
+        Profiler& operator=(const Profiler&) = delete;
+
+        // ====================================================================
+        // Recording
+        // ====================================================================
+
+        /**
+         * @brief Enable or disable recording (markers still compile in)
+         */
+        void SetEnabled(bool enabled) { m_Enabled.store(enabled, std::memory_order_relaxed); }
+        bool IsEnabled() const { return m_Enabled.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Name the calling thread in the timeline and trace
+         */
+        void SetThreadName(const std::string& name);
+
+        /**
+         * @brief Record a finished scope on the calling thread
+         *
+         * Dropped (and counted) if the thread's ring is full.
+         */
+        void Record(const char* name, int64_t start, int64_t end, uint32_t depth);
+
+        /**
+         * @brief Get a pointer to a copy of a name that lives as long as the profiler
+         *
+         * For names built at runtime, such as render graph pass names.
+         * Takes a lock; cache the result where it is called often.
+         */
+        const char* InternName(std::string_view name);
+
+        // ====================================================================
+        // Frames (main thread)
+        // ====================================================================
+
+        /**
+         * @brief Close the current frame and start the next one
+         *
+         * Drains every thread's events into the frame that just ended. Call
+         * once at the top of the main loop.
+         */
+        void BeginFrame();
+
+        /**
+         * @brief Number of the frame being recorded
+         */
+        uint64_t GetFrameNumber() const { return m_FrameNumber; }
+
+        /**
+         * @brief Attach GPU timings to an earlier frame
+         * @param frameNumber Frame the work was recorded in
+         *
+         * Ignored if the frame has left the history or was never kept.
+         */
+        void AddGPUEvents(uint64_t frameNumber, std::vector<ProfileEvent>&& events);
+
+        /**
+         * @brief Stop adding frames to the history so it can be inspected
+         */
+        void SetPaused(bool paused) { m_Paused = paused; }
+        bool IsPaused() const { return m_Paused; }
+
+        /**
+         * @brief Get the recorded frames, oldest first
+         */
+        const std::deque<ProfileFrame>& GetFrames() const { return m_Frames; }
+
+        /**
+         * @brief Drop the frame history
+         */
+        void ClearFrames() { m_Frames.clear(); }
+
+        // ====================================================================
+        // Queries
+        // ====================================================================
+
+        uint32_t GetThreadCount() const;
+        std::string GetThreadName(uint32_t thread) const;
+
+        /**
+         * @brief Get the number of events lost to full thread rings
+         */
+        uint64_t GetDroppedCount() const { return m_DroppedCount.load(std::memory_order_relaxed); }
+
+        // ====================================================================
+        // Export
+        // ====================================================================
+
+        /**
+         * @brief Write the frame history as Chrome trace event JSON
+         * @param path Output file, viewable in chrome://tracing or Perfetto
+         * @return true if the file was written
+         */
+        bool ExportChromeTrace(const std::string& path) const;
+
+    private:
+        Profiler();
+        ~Profiler() = default;
+
+        /**
+         * @brief Single-producer ring owned by one thread, drained by the main thread
+         */
+        struct ThreadBuffer
+        {
+            std::vector<ProfileEvent> Events;
+            alignas(64) std::atomic<uint64_t> WritePosition{ 0 };   ///< Owner thread only
+            alignas(64) std::atomic<uint64_t> ReadPosition{ 0 };    ///< Main thread only
+            uint32_t Index = 0;
+            std::string Name;                                       ///< Guarded by m_ThreadMutex
+        };
+
+        /**
+         * @brief Get the calling thread's buffer, registering it on first use
+         */
+        ThreadBuffer& GetThreadBuffer();
+
+        /**
+         * @brief Move every thread's pending events into a frame (or discard them)
+         */
+        void DrainThreads(ProfileFrame* frame);
+
+    private:
+        std::atomic<bool> m_Enabled{ true };
+        std::atomic<uint64_t> m_DroppedCount{ 0 };
+
+        // Registered threads; buffers live as long as the profiler
+        mutable std::mutex m_ThreadMutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> m_Threads;
+
+        // Runtime names
+        std::mutex m_NameMutex;
+        std::unordered_set<std::string> m_Names;
+
+        // Frame history (main thread)
+        std::deque<ProfileFrame> m_Frames;
+        uint64_t m_FrameNumber = 0;
+        int64_t m_FrameStart = 0;
+        bool m_Paused = false;
+    };
+
+    // ============================================================================
+    // Scoped Marker
+    // ============================================================================
+
+    /**
+     * @brief Times its lifetime and records it on destruction
+     */
+    class ProfileScope
+    {
+    public:
+        explicit ProfileScope(const char* name);
+        ~ProfileScope();
+
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+
+    private:
+        const char* m_Name;     ///< nullptr when the profiler was disabled at construction
+        int64_t m_Start = 0;
+    };
+
+} // namespace SM
+
+#define SM_PROFILE_CONCAT_INNER(a, b) a##b
+#define SM_PROFILE_CONCAT(a, b) SM_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef SM_ENABLE_PROFILER
+    /// Time the enclosing scope; name must have static storage
+    #define SM_PROFILE_SCOPE(name) SM_TRACE_SCOPE(name); ::SM::ProfileScope SM_PROFILE_CONCAT(sm_ProfileScope_, __LINE__)(name)
+    #define SM_PROFILE_FUNCTION() SM_PROFILE_SCOPE(__FUNCTION__)
+    #define SM_PROFILE_THREAD(name) ::SM::Profiler::Get().SetThreadName(name)
+#else
+    #define SM_PROFILE_SCOPE(name) SM_TRACE_SCOPE(name)
+    #define SM_PROFILE_FUNCTION() ((void)0)
+    #define SM_PROFILE_THREAD(name) ((void)0)
+#endif
@@ -1,9 +1,12 @@
 #include "core/ResourceManager.h"
 #include "core/FileSystem.h"
 #include "core/AssetLoader.h"
+#include "core/AssetArchive.h"
+#include "core/Profiler.h"
 
 #include <iostream>
 #include <algorithm>
+#include <optional>
 
 namespace SM
 {
@@ -27,7 +30,8 @@ namespace SM
 
         // Mesh formats
         if (ext == ".obj" || ext == ".fbx" || ext == ".gltf" ||
-            ext == ".glb" || ext == ".dae" || ext == ".3ds")
+            ext == ".glb" || ext == ".dae" || ext == ".3ds" ||
+            ext == ".smmesh")
         {
             return ResourceType::Mesh;
         }
@@ -114,6 +118,12 @@ namespace SM
         }
 
         m_MaxAsyncLoads = maxAsyncLoads;
+        if (!m_FileQueue.Initialize(maxAsyncLoads))
+        {
+            std::cerr << "[ResourceManager] Failed to start the async file queue" << std::endl;
+            return false;
+        }
+
         m_IsInitialized = true;
 
 #if defined(_DEBUG)
@@ -136,14 +146,33 @@ namespace SM
         DebugPrintResources();
 #endif
 
-        // Wait for all async loads to complete
+        m_FileWatcher.Stop();
+
+        // Stop reads (queued ones are dropped) and let started decodes finish
+        m_FileQueue.Shutdown();
+        JobSystem::Get().Wait(m_DecodeJobs);
+
+        // Unload all resources
+        UnloadAll();
+
+        // Loads that finished after the last Update belong to no entry now
+        std::vector<CompletedLoad> completed;
         {
             std::lock_guard<std::mutex> lock(m_AsyncMutex);
-            m_PendingLoads.clear();
+            completed.swap(m_CompletedLoads);
+        }
+        for (CompletedLoad& load : completed)
+        {
+            ResourceEntry orphan;
+            orphan.Path = load.Path;
+            orphan.Data = load.Data;
+            UnloadResourceData(orphan);
         }
 
-        // Unload all resources
-        UnloadAll();
+        {
+            std::lock_guard<std::mutex> lock(m_ArchiveMutex);
+            m_Archives.clear();
+        }
 
         m_IsInitialized = false;
     }
@@ -155,63 +184,108 @@ namespace SM
             return;
         }
 
-        // Process completed async loads
-        std::lock_guard<std::mutex> lock(m_Mutex);
+        std::vector<CompletedLoad> completed;
+        {
+            std::lock_guard<std::mutex> asyncLock(m_AsyncMutex);
+            completed.swap(m_CompletedLoads);
+        }
 
-        for (auto& [id, entry] : m_Resources)
+        // Query budget providers before taking the lock; they may be slow (driver calls)
+        std::array<std::optional<size_t>, TYPE_COUNT> budgets;
+        for (size_t type = 0; type < TYPE_COUNT; ++type)
         {
-            if (entry->IsLoading && entry->LoadFuture.valid())
+            if (m_BudgetProviders[type])
             {
-                // Check if loading is complete (non-blocking)
-                auto status = entry->LoadFuture.wait_for(std::chrono::milliseconds(0));
-                if (status == std::future_status::ready)
+                budgets[type] = m_BudgetProviders[type]();
+            }
+        }
+
+        // Publish finished loads; callbacks run after the lock is dropped so
+        // they may call back into the manager
+        std::vector<std::pair<ResourceHandle, std::function<void(ResourceHandle)>>> callbacks;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            callbacks.swap(m_ReadyCallbacks);
+
+            for (CompletedLoad& load : completed)
+            {
+                auto it = m_Resources.find(load.ID);
+                if (it == m_Resources.end() || !it->second->IsLoading)
                 {
-                    bool success = entry->LoadFuture.get();
-                    entry->IsLoading = false;
-                    entry->IsLoaded = success;
-                    m_ActiveAsyncLoads--;
+                    // Released or cancelled while loading
+                    ResourceEntry orphan;
+                    orphan.Path = load.Path;
+                    orphan.Data = load.Data;
+                    UnloadResourceData(orphan);
+                    continue;
+                }
+
+                ResourceEntry& entry = *it->second;
+                entry.IsLoading = false;
+                entry.ReadRequest = AsyncFileQueue::INVALID_REQUEST;
+                m_ActiveAsyncLoads--;
+
+                ResourceHandle handle = entry.Handle;
+                if (load.Data)
+                {
+                    SetEntryData(entry, load.Data);
+                    entry.LastModified = static_cast<uint64_t>(FileSystem::GetLastWriteTime(entry.Path));
 
 #if defined(_DEBUG)
-                    if (success)
-                    {
-                        std::cout << "[ResourceManager] Async load complete: "
-                                  << entry->Path << std::endl;
-                    }
-                    else
-                    {
-                        std::cout << "[ResourceManager] Async load failed: "
-                                  << entry->Path << std::endl;
-                    }
+                    std::cout << "[ResourceManager] Async load complete: " << entry.Path << std::endl;
 #endif
                 }
-            }
-        }
+                else
+                {
+                    // Drop the entry so a later load can retry the path
+                    std::cerr << "[ResourceManager] Async load failed: " << entry.Path << std::endl;
+                    handle = ResourceHandle{};
+                }
 
-        // Start pending loads if we have capacity
-        if (m_ActiveAsyncLoads < m_MaxAsyncLoads)
-        {
-            std::lock_guard<std::mutex> asyncLock(m_AsyncMutex);
+                for (auto& callback : entry.PendingCallbacks)
+                {
+                    callbacks.emplace_back(handle, std::move(callback));
+                }
+                entry.PendingCallbacks.clear();
 
-            while (!m_PendingLoads.empty() && m_ActiveAsyncLoads < m_MaxAsyncLoads)
-            {
-                ResourceLoadRequest request = std::move(m_PendingLoads.back());
-                m_PendingLoads.pop_back();
+                if (!load.Data)
+                {
+                    m_PathToID.erase(entry.Path);
+                    m_Resources.erase(it);
+                }
+            }
 
-                m_ActiveAsyncLoads++;
-                ProcessAsyncLoad(std::move(request));
+            // Loads (and changed provider budgets) may have pushed a type over
+            for (size_t type = 0; type < TYPE_COUNT; ++type)
+            {
+                if (budgets[type])
+                {
+                    m_Budgets[type] = *budgets[type];
+                }
+                EvictCached(static_cast<ResourceType>(type), m_Budgets[type]);
             }
         }
 
+        for (auto& [handle, callback] : callbacks)
+        {
+            callback(handle);
+        }
+
         // Hot reload check (if enabled)
         if (m_HotReloadEnabled)
         {
-            static float hotReloadTimer = 0.0f;
-            hotReloadTimer += 0.016f; // Assume ~60fps
-
-            if (hotReloadTimer >= 1.0f) // Check once per second
+            if (m_FileWatcher.IsRunning())
             {
-                hotReloadTimer = 0.0f;
-                CheckForModifiedResources();
+                ProcessFileChanges();
+            }
+            else
+            {
+                auto now = std::chrono::steady_clock::now();
+                if (now - m_LastHotReloadPoll >= std::chrono::duration<double>(HOT_RELOAD_POLL_SECONDS))
+                {
+                    m_LastHotReloadPoll = now;
+                    CheckForModifiedResources();
+                }
             }
         }
     }
@@ -225,7 +299,7 @@ namespace SM
         if (it != m_PathToID.end())
         {
             auto& entry = m_Resources[it->second];
-            entry->RefCount++;
+            Retain(*entry);
 
 #if defined(_DEBUG)
             std::cout << "[ResourceManager] Resource already loaded (refcount="
@@ -257,10 +331,9 @@ namespace SM
         entry->Handle.Type = type;
         entry->Path = path;
         entry->Name = FileSystem::GetFilenameWithoutExtension(path);
-        entry->Data = data;
         entry->RefCount = 1;
         entry->LastModified = static_cast<uint64_t>(FileSystem::GetLastWriteTime(path));
-        entry->IsLoaded = true;
+        SetEntryData(*entry, data);
 
         ResourceHandle handle = entry->Handle;
 
@@ -276,38 +349,113 @@ namespace SM
         return handle;
     }
 
-    void ResourceManager::LoadResourceAsync(
+    ResourceHandle ResourceManager::LoadResourceAsync(
         const std::string& path,
         ResourceType type,
-        std::function<void(ResourceHandle)> callback)
+        std::function<void(ResourceHandle)> callback,
+        LoadPriority priority)
     {
-        // Check if already loaded
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        // Coalesce with a resource that is loaded or already loading
+        auto it = m_PathToID.find(path);
+        if (it != m_PathToID.end())
         {
-            std::lock_guard<std::mutex> lock(m_Mutex);
-            auto it = m_PathToID.find(path);
-            if (it != m_PathToID.end())
-            {
-                auto& entry = m_Resources[it->second];
-                entry->RefCount++;
+            ResourceEntry& entry = *m_Resources[it->second];
+            Retain(entry);
 
+            if (entry.IsLoading)
+            {
                 if (callback)
                 {
-                    callback(entry->Handle);
+                    entry.PendingCallbacks.push_back(std::move(callback));
+                }
+                if (priority > entry.Priority)
+                {
+                    entry.Priority = priority;
+                    m_FileQueue.SetPriority(entry.ReadRequest, priority);
                 }
-                return;
             }
+            else if (callback)
+            {
+                m_ReadyCallbacks.emplace_back(entry.Handle, std::move(callback));
+            }
+            return entry.Handle;
         }
 
-        // Add to pending loads
-        ResourceLoadRequest request;
-        request.Path = path;
-        request.Type = type;
-        request.Callback = callback;
+        // Determine type from extension if not specified
+        if (type == ResourceType::Unknown)
+        {
+            type = GetResourceTypeFromExtension(FileSystem::GetExtension(path));
+        }
 
+        auto entry = std::make_unique<ResourceEntry>();
+        entry->Handle.ID = GenerateResourceID();
+        entry->Handle.Type = type;
+        entry->Path = path;
+        entry->Name = FileSystem::GetFilenameWithoutExtension(path);
+        entry->RefCount = 1;
+        entry->IsLoading = true;
+        entry->Priority = priority;
+        if (callback)
         {
-            std::lock_guard<std::mutex> lock(m_AsyncMutex);
-            m_PendingLoads.push_back(std::move(request));
+            entry->PendingCallbacks.push_back(std::move(callback));
+        }
+
+        // Archive entries are already mapped and large raw files get mapped
+        // rather than read, so neither needs the read queue
+        IAssetLoader* loader = AssetLoaderRegistry::Get().FindLoader(path);
+        bool isRaw = !loader || loader == AssetLoaderRegistry::Get().GetRawLoader();
+        std::shared_ptr<AssetArchive> archive;
+        bool readFromPath = FindInArchives(path, archive) != nullptr ||
+            (isRaw && FileSystem::GetFileSize(path) >= RawAssetLoader::MAPPED_LOAD_THRESHOLD);
+
+        ResourceHandle handle = entry->Handle;
+        m_PathToID[path] = handle.ID;
+        ResourceEntry& added = *(m_Resources[handle.ID] = std::move(entry));
+        m_ActiveAsyncLoads++;
+
+        if (readFromPath)
+        {
+            SubmitDecode(handle.ID, path, type, {});
+        }
+        else
+        {
+            added.ReadRequest = m_FileQueue.Submit(path, priority,
+                [this, id = handle.ID, path, type](AsyncFileQueue::RequestID, bool success, std::vector<uint8_t>& bytes)
+                {
+                    if (success)
+                    {
+                        SubmitDecode(id, path, type, std::move(bytes));
+                    }
+                    else
+                    {
+                        PushCompletedLoad(id, path, nullptr);
+                    }
+                });
         }
+
+        return handle;
+    }
+
+    bool ResourceManager::CancelLoad(ResourceHandle handle)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        auto it = m_Resources.find(handle.ID);
+        if (it == m_Resources.end() || !it->second->IsLoading)
+        {
+            return false;
+        }
+
+#if defined(_DEBUG)
+        std::cout << "[ResourceManager] Cancelled load: " << it->second->Path << std::endl;
+#endif
+
+        AbortLoad(*it->second);
+        m_PathToID.erase(it->second->Path);
+        m_Resources.erase(it);
+        return true;
     }
 
     void* ResourceManager::GetResourceData(ResourceHandle handle)
@@ -378,7 +526,7 @@ namespace SM
         auto it = m_Resources.find(handle.ID);
         if (it != m_Resources.end())
         {
-            it->second->RefCount++;
+            Retain(*it->second);
         }
     }
 
@@ -387,26 +535,41 @@ namespace SM
         std::lock_guard<std::mutex> lock(m_Mutex);
 
         auto it = m_Resources.find(handle.ID);
-        if (it == m_Resources.end())
+        if (it == m_Resources.end() || it->second->IsCached)
         {
             return;
         }
 
-        if (it->second->RefCount > 0)
+        ResourceEntry& entry = *it->second;
+        if (entry.RefCount > 0)
         {
-            it->second->RefCount--;
+            entry.RefCount--;
         }
 
-        // Unload if no more references
-        if (it->second->RefCount == 0)
+        if (entry.RefCount != 0)
+        {
+            return;
+        }
+
+        // Budgeted types keep loaded resources around for reuse until evicted
+        size_t type = static_cast<size_t>(entry.Handle.Type);
+        if (entry.IsLoaded && type < TYPE_COUNT && m_Budgets[type] != 0)
         {
+            m_Caches[type].push_front(entry.Handle.ID);
+            entry.CachePosition = m_Caches[type].begin();
+            entry.IsCached = true;
+            EvictCached(entry.Handle.Type, m_Budgets[type]);
+            return;
+        }
+
+        // Unload if no more references
 #if defined(_DEBUG)
-            std::cout << "[ResourceManager] Releasing: " << it->second->Path << std::endl;
+        std::cout << "[ResourceManager] Releasing: " << entry.Path << std::endl;
 #endif
-            UnloadResourceData(*it->second);
-            m_PathToID.erase(it->second->Path);
-            m_Resources.erase(it);
-        }
+        AbortLoad(entry);
+        UnloadResourceData(entry);
+        m_PathToID.erase(entry.Path);
+        m_Resources.erase(it);
     }
 
     void ResourceManager::Unload(ResourceHandle handle)
@@ -423,6 +586,8 @@ namespace SM
         std::cout << "[ResourceManager] Force unloading: " << it->second->Path << std::endl;
 #endif
 
+        Uncache(*it->second);
+        AbortLoad(*it->second);
         UnloadResourceData(*it->second);
         m_PathToID.erase(it->second->Path);
         m_Resources.erase(it);
@@ -438,6 +603,8 @@ namespace SM
         {
             if (entry->Handle.Type == type)
             {
+                Uncache(*entry);
+                AbortLoad(*entry);
                 UnloadResourceData(*entry);
                 m_PathToID.erase(entry->Path);
                 toRemove.push_back(id);
@@ -461,17 +628,109 @@ namespace SM
 
         for (auto& [id, entry] : m_Resources)
         {
+            AbortLoad(*entry);
             UnloadResourceData(*entry);
         }
 
         m_Resources.clear();
         m_PathToID.clear();
+        for (auto& cache : m_Caches)
+        {
+            cache.clear();
+        }
 
 #if defined(_DEBUG)
         std::cout << "[ResourceManager] All resources unloaded" << std::endl;
 #endif
     }
 
+    void ResourceManager::SetHotReloadEnabled(bool enable)
+    {
+        m_HotReloadEnabled = enable;
+
+        if (!enable)
+        {
+            m_FileWatcher.Stop();
+        }
+        else if (FileWatcher::IsSupported() && !m_FileWatcher.IsRunning() && !m_FileWatcher.Start())
+        {
+            std::cout << "[ResourceManager] No watched directories, hot reload polls every "
+                      << HOT_RELOAD_POLL_SECONDS << "s" << std::endl;
+        }
+    }
+
+    bool ResourceManager::AddHotReloadDirectory(const std::string& directory)
+    {
+        if (!m_FileWatcher.AddDirectory(directory))
+        {
+            return false;
+        }
+
+        if (m_HotReloadEnabled && !m_FileWatcher.IsRunning())
+        {
+            m_FileWatcher.Start();
+        }
+        return true;
+    }
+
+    void ResourceManager::AddFileChangeListener(const std::string& extension, FileChangeListener listener)
+    {
+        std::string lowered = extension;
+        std::transform(lowered.begin(), lowered.end(), lowered.begin(), ::tolower);
+        m_FileChangeListeners.emplace_back(std::move(lowered), std::move(listener));
+    }
+
+    void ResourceManager::ProcessFileChanges()
+    {
+        // Lost events: fall back to one full scan
+        if (m_FileWatcher.ConsumeOverflow())
+        {
+            CheckForModifiedResources();
+        }
+
+        std::vector<std::string> changed;
+        if (m_FileWatcher.CollectChanges(changed, HOT_RELOAD_SETTLE_SECONDS) == 0)
+        {
+            return;
+        }
+
+        // Changes are rare, so matching them against every entry is fine
+        std::vector<ResourceHandle> toReload;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            for (const auto& [id, entry] : m_Resources)
+            {
+                if (entry->IsLoaded &&
+                    std::find(changed.begin(), changed.end(), FileWatcher::MakeKey(entry->Path)) != changed.end())
+                {
+                    toReload.push_back(entry->Handle);
+                }
+            }
+        }
+
+        for (ResourceHandle handle : toReload)
+        {
+            ReloadResource(handle);
+        }
+
+        for (const auto& [extension, listener] : m_FileChangeListeners)
+        {
+            std::vector<std::string> matching;
+            for (const std::string& path : changed)
+            {
+                if (FileSystem::GetExtension(path) == extension)
+                {
+                    matching.push_back(path);
+                }
+            }
+
+            if (!matching.empty())
+            {
+                listener(matching);
+            }
+        }
+    }
+
     uint32_t ResourceManager::CheckForModifiedResources()
     {
         std::lock_guard<std::mutex> lock(m_Mutex);
@@ -500,8 +759,7 @@ namespace SM
                 void* newData = LoadResourceData(entry->Path, entry->Handle.Type);
                 if (newData)
                 {
-                    entry->Data = newData;
-                    entry->IsLoaded = true;
+                    SetEntryData(*entry, newData);
                     entry->LastModified = currentModTime;
                     reloadCount++;
                 }
@@ -522,6 +780,10 @@ namespace SM
         }
 
         ResourceEntry& entry = *it->second;
+        if (entry.IsLoading)
+        {
+            return false;
+        }
 
         // Unload current data
         UnloadResourceData(entry);
@@ -530,8 +792,7 @@ namespace SM
         void* newData = LoadResourceData(entry.Path, entry.Handle.Type);
         if (newData)
         {
-            entry.Data = newData;
-            entry.IsLoaded = true;
+            SetEntryData(entry, newData);
             entry.LastModified =
                 static_cast<uint64_t>(FileSystem::GetLastWriteTime(entry.Path));
 
@@ -576,8 +837,7 @@ namespace SM
 
     size_t ResourceManager::GetPendingLoadCount() const
     {
-        std::lock_guard<std::mutex> lock(m_AsyncMutex);
-        return m_PendingLoads.size() + m_ActiveAsyncLoads.load();
+        return m_ActiveAsyncLoads.load();
     }
 
     bool ResourceManager::GetResourceInfo(
@@ -613,12 +873,120 @@ namespace SM
                       << " (Type=" << ResourceTypeToString(entry->Handle.Type)
                       << ", RefCount=" << entry->RefCount.load()
                       << ", Loaded=" << (entry->IsLoaded ? "Yes" : "No")
+                      << (entry->IsCached ? ", Cached" : "")
                       << ")" << std::endl;
         }
 
         std::cout << "=========================" << std::endl;
     }
 
+    // ============================================================================
+    // Memory Budgets
+    // ============================================================================
+
+    void ResourceManager::SetMemoryBudget(ResourceType type, size_t bytes)
+    {
+        size_t index = static_cast<size_t>(type);
+        if (index >= TYPE_COUNT)
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Budgets[index] = bytes;
+
+        // A zero budget turns caching off for the type: unload what it kept
+        EvictCached(type, bytes);
+    }
+
+    void ResourceManager::SetBudgetProvider(ResourceType type, BudgetProvider provider)
+    {
+        size_t index = static_cast<size_t>(type);
+        if (index < TYPE_COUNT)
+        {
+            m_BudgetProviders[index] = std::move(provider);
+        }
+    }
+
+    size_t ResourceManager::GetMemoryBudget(ResourceType type) const
+    {
+        size_t index = static_cast<size_t>(type);
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return index < TYPE_COUNT ? m_Budgets[index] : 0;
+    }
+
+    size_t ResourceManager::GetMemoryUsage(ResourceType type) const
+    {
+        size_t index = static_cast<size_t>(type);
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return index < TYPE_COUNT ? m_Usage[index] : 0;
+    }
+
+    size_t ResourceManager::GetCachedResourceCount() const
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        size_t count = 0;
+        for (const auto& cache : m_Caches)
+        {
+            count += cache.size();
+        }
+        return count;
+    }
+
+    size_t ResourceManager::TrimCache()
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        size_t count = 0;
+        for (size_t type = 0; type < TYPE_COUNT; ++type)
+        {
+            count += EvictCached(static_cast<ResourceType>(type), 0);
+        }
+        return count;
+    }
+
+    // ============================================================================
+    // Archives
+    // ============================================================================
+
+    bool ResourceManager::MountArchive(const std::string& archivePath, const std::string& mountPoint)
+    {
+        auto archive = std::make_shared<AssetArchive>();
+        if (!archive->Open(archivePath))
+        {
+            std::cerr << "[ResourceManager] Failed to mount archive: " << archivePath << std::endl;
+            return false;
+        }
+
+        std::string normalizedMount = AssetArchive::NormalizePath(mountPoint);
+        while (!normalizedMount.empty() && normalizedMount.back() == '/')
+        {
+            normalizedMount.pop_back();
+        }
+
+        std::cout << "[ResourceManager] Mounted " << archivePath << " (" << archive->GetEntryCount()
+                  << " assets)" << std::endl;
+
+        std::lock_guard<std::mutex> lock(m_ArchiveMutex);
+        m_Archives.push_back({ std::move(archive), std::move(normalizedMount) });
+        return true;
+    }
+
+    void ResourceManager::UnmountArchive(const std::string& archivePath)
+    {
+        std::lock_guard<std::mutex> lock(m_ArchiveMutex);
+        m_Archives.erase(std::remove_if(m_Archives.begin(), m_Archives.end(),
+            [&archivePath](const MountedArchive& mounted) { return mounted.Archive->GetPath() == archivePath; }),
+            m_Archives.end());
+    }
+
+    size_t ResourceManager::GetMountedArchiveCount() const
+    {
+        std::lock_guard<std::mutex> lock(m_ArchiveMutex);
+        return m_Archives.size();
+    }
+
     uint32_t ResourceManager::GenerateResourceID()
     {
         return m_NextResourceID++;
@@ -626,6 +994,8 @@ namespace SM
 
     void* ResourceManager::LoadResourceData(const std::string& path, ResourceType type)
     {
+        SM_PROFILE_SCOPE("ResourceManager::LoadResourceData");
+
         // Find appropriate loader
         IAssetLoader* loader = AssetLoaderRegistry::Get().FindLoader(path);
 
@@ -640,7 +1010,7 @@ namespace SM
         // Real implementation would have type-specific containers
         auto* data = new RawAssetData();
 
-        if (!loader->Load(path, data))
+        if (!LoadFromArchive(path, loader, data) && !loader->LoadMapped(path, data))
         {
             delete data;
             return nullptr;
@@ -649,6 +1019,110 @@ namespace SM
         return data;
     }
 
+    const ArchiveEntry* ResourceManager::FindInArchives(const std::string& path, std::shared_ptr<AssetArchive>& outArchive) const
+    {
+        std::lock_guard<std::mutex> lock(m_ArchiveMutex);
+        if (m_Archives.empty())
+        {
+            return nullptr;
+        }
+
+        std::string normalized = AssetArchive::NormalizePath(path);
+        for (auto it = m_Archives.rbegin(); it != m_Archives.rend(); ++it)
+        {
+            std::string_view relative = normalized;
+            if (!it->MountPoint.empty())
+            {
+                if (relative.size() <= it->MountPoint.size() ||
+                    relative.compare(0, it->MountPoint.size(), it->MountPoint) != 0 ||
+                    relative[it->MountPoint.size()] != '/')
+                {
+                    continue;
+                }
+                relative.remove_prefix(it->MountPoint.size() + 1);
+            }
+
+            if (const ArchiveEntry* entry = it->Archive->Find(relative))
+            {
+                outArchive = it->Archive;
+                return entry;
+            }
+        }
+
+        return nullptr;
+    }
+
+    bool ResourceManager::LoadFromArchive(const std::string& path, IAssetLoader* loader, void* data)
+    {
+        // The shared_ptr keeps the archive (and the entry) alive if it is unmounted meanwhile
+        std::shared_ptr<AssetArchive> archive;
+        const ArchiveEntry* entry = FindInArchives(path, archive);
+        if (!entry)
+        {
+            return false;
+        }
+
+        std::vector<uint8_t> bytes;
+        if (!archive->Read(*entry, bytes))
+        {
+            std::cerr << "[ResourceManager] Corrupt archive entry " << path
+                      << " in " << archive->GetPath() << std::endl;
+            return false;
+        }
+
+        // Raw data takes the decompressed buffer as is
+        if (loader == AssetLoaderRegistry::Get().GetRawLoader())
+        {
+            RawAssetData* rawData = static_cast<RawAssetData*>(data);
+            rawData->Clear();
+            rawData->Data = std::move(bytes);
+            rawData->SourcePath = path;
+            rawData->OriginalSize = rawData->Data.size();
+            return true;
+        }
+
+        return loader->LoadFromMemory(bytes, path, data);
+    }
+
+    void* ResourceManager::DecodeResourceData(const std::string& path, std::vector<uint8_t>& bytes)
+    {
+        SM_PROFILE_SCOPE("ResourceManager::DecodeResourceData");
+
+        IAssetLoader* loader = AssetLoaderRegistry::Get().FindLoader(path);
+        if (!loader)
+        {
+            loader = AssetLoaderRegistry::Get().GetRawLoader();
+        }
+
+        auto* data = new RawAssetData();
+        bool success;
+
+        if (loader == AssetLoaderRegistry::Get().GetRawLoader())
+        {
+            // Raw data takes the read buffer as is
+            data->Data = std::move(bytes);
+            data->SourcePath = path;
+            data->OriginalSize = data->Data.size();
+            success = true;
+        }
+        else if (loader->SupportsMemoryLoading())
+        {
+            success = loader->LoadFromMemory(bytes, path, data);
+        }
+        else
+        {
+            // Loader can only parse files; the read warmed the OS cache at least
+            success = loader->Load(path, data);
+        }
+
+        if (!success)
+        {
+            delete data;
+            return nullptr;
+        }
+        return data;
+    }
+
     void ResourceManager::UnloadResourceData(ResourceEntry& entry)
     {
         if (!entry.Data)
@@ -667,85 +1141,108 @@ namespace SM
         loader->Unload(entry.Data);
         delete static_cast<RawAssetData*>(entry.Data);
 
+        size_t type = static_cast<size_t>(entry.Handle.Type);
+        if (entry.IsLoaded && type < TYPE_COUNT)
+        {
+            m_Usage[type] -= entry.DataSize;
+        }
+
         entry.Data = nullptr;
         entry.IsLoaded = false;
         entry.DataSize = 0;
     }
 
-    void ResourceManager::ProcessAsyncLoad(ResourceLoadRequest request)
+    void ResourceManager::SetEntryData(ResourceEntry& entry, void* data)
     {
-        // Create entry for the resource
-        ResourceHandle handle;
+        entry.Data = data;
+        entry.DataSize = static_cast<RawAssetData*>(data)->GetBytes().size();
+        entry.IsLoaded = true;
+
+        size_t type = static_cast<size_t>(entry.Handle.Type);
+        if (type < TYPE_COUNT)
         {
-            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Usage[type] += entry.DataSize;
+        }
+    }
 
-            // Double-check it wasn't loaded while we were waiting
-            auto it = m_PathToID.find(request.Path);
-            if (it != m_PathToID.end())
-            {
-                handle = m_Resources[it->second]->Handle;
-                m_Resources[it->second]->RefCount++;
-                m_ActiveAsyncLoads--;
+    void ResourceManager::Retain(ResourceEntry& entry)
+    {
+        Uncache(entry);
+        entry.RefCount++;
+    }
 
-                if (request.Callback)
-                {
-                    request.Callback(handle);
-                }
-                return;
-            }
+    void ResourceManager::Uncache(ResourceEntry& entry)
+    {
+        if (entry.IsCached)
+        {
+            m_Caches[static_cast<size_t>(entry.Handle.Type)].erase(entry.CachePosition);
+            entry.IsCached = false;
+        }
+    }
 
-            // Determine type if not specified
-            if (request.Type == ResourceType::Unknown)
-            {
-                request.Type = GetResourceTypeFromExtension(
-                    FileSystem::GetExtension(request.Path)
-                );
-            }
+    size_t ResourceManager::EvictCached(ResourceType type, size_t targetBytes)
+    {
+        size_t index = static_cast<size_t>(type);
+        if (index >= TYPE_COUNT)
+        {
+            return 0;
+        }
 
-            // Create entry
-            auto entry = std::make_unique<ResourceEntry>();
-            entry->Handle.ID = GenerateResourceID();
-            entry->Handle.Type = request.Type;
-            entry->Path = request.Path;
-            entry->Name = FileSystem::GetFilenameWithoutExtension(request.Path);
-            entry->RefCount = 1;
-            entry->IsLoading = true;
+        size_t count = 0;
+        std::list<uint32_t>& cache = m_Caches[index];
+        while (!cache.empty() && (m_Usage[index] > targetBytes || targetBytes == 0))
+        {
+            auto it = m_Resources.find(cache.back());
+            cache.pop_back();
 
-            handle = entry->Handle;
+            ResourceEntry& entry = *it->second;
+            entry.IsCached = false;
 
-            // Start async load
-            entry->LoadFuture = std::async(std::launch::async,
-                [this, path = request.Path, type = request.Type, id = handle.ID]() -> bool
-                {
-                    void* data = LoadResourceData(path, type);
-                    if (data)
-                    {
-                        std::lock_guard<std::mutex> lock(m_Mutex);
-                        auto it = m_Resources.find(id);
-                        if (it != m_Resources.end())
-                        {
-                            it->second->Data = data;
-                            it->second->LastModified = static_cast<uint64_t>(
-                                FileSystem::GetLastWriteTime(path)
-                            );
-                        }
-                        return true;
-                    }
-                    return false;
-                }
-            );
+#if defined(_DEBUG)
+            std::cout << "[ResourceManager] Evicting: " << entry.Path << std::endl;
+#endif
+            UnloadResourceData(entry);
+            m_PathToID.erase(entry.Path);
+            m_Resources.erase(it);
+            ++count;
+        }
+        return count;
+    }
 
-            m_PathToID[request.Path] = handle.ID;
-            m_Resources[handle.ID] = std::move(entry);
+    void ResourceManager::AbortLoad(ResourceEntry& entry)
+    {
+        if (!entry.IsLoading)
+        {
+            return;
         }
 
-        // Store callback for later
-        if (request.Callback)
+        // A decode already running finishes into Update, which drops it
+        if (entry.ReadRequest != AsyncFileQueue::INVALID_REQUEST)
         {
-            // In a real implementation, we'd store this and call it when load completes
-            // For simplicity, we'll call it immediately with the pending handle
-            request.Callback(handle);
+            m_FileQueue.Cancel(entry.ReadRequest);
         }
+
+        entry.IsLoading = false;
+        entry.ReadRequest = AsyncFileQueue::INVALID_REQUEST;
+        entry.PendingCallbacks.clear();
+        m_ActiveAsyncLoads--;
+    }
+
+    void ResourceManager::SubmitDecode(uint32_t id, const std::string& path, ResourceType type, std::vector<uint8_t> bytes)
+    {
+        JobSystem::Get().Run(
+            [this, id, path, type, bytes = std::move(bytes)]() mutable
+            {
+                void* data = bytes.empty() ? LoadResourceData(path, type) : DecodeResourceData(path, bytes);
+                PushCompletedLoad(id, path, data);
+            },
+            &m_DecodeJobs);
+    }
+
+    void ResourceManager::PushCompletedLoad(uint32_t id, const std::string& path, void* data)
+    {
+        std::lock_guard<std::mutex> lock(m_AsyncMutex);
+        m_CompletedLoads.push_back({ id, path, data });
     }
 
 } // namespace SM
@@ -6,9 +6,12 @@
  *
  * Provides centralized management of game resources with:
  * - Reference counting for automatic resource lifetime management
- * - Asynchronous loading support using std::async
+ * - Per-type memory budgets with LRU eviction of unreferenced resources
+ * - Prioritized asynchronous loading: overlapped file reads (AsyncFileQueue)
+ *   with decoding on the job system
  * - Type-safe resource access through handles
- * - Hot-reloading capability for development
+ * - Hot-reloading driven by directory change notifications (FileWatcher)
+ * - Packed archives (.smpak) mounted over the loose asset directory
  */
 
 #include <cstdint>
@@ -17,14 +20,22 @@
 #include <unordered_map>
 #include <memory>
 #include <mutex>
-#include <future>
 #include <functional>
 #include <atomic>
+#include <array>
+#include <chrono>
+#include <list>
+
+#include "core/AsyncFileQueue.h"
+#include "core/FileWatcher.h"
+#include "core/JobSystem.h"
 
 namespace SM
 {
     // Forward declarations
     class IAssetLoader;
+    class AssetArchive;
+    struct ArchiveEntry;
 
     // ============================================================================
     // Resource Types
@@ -166,7 +177,11 @@ namespace SM
         uint64_t LastModified = 0;         // File modification time
         bool IsLoaded = false;             // Is data currently loaded
         bool IsLoading = false;            // Is currently being loaded async
-        std::future<bool> LoadFuture;      // Future for async loading
+        LoadPriority Priority = LoadPriority::Normal;   // Highest priority requested while loading
+        AsyncFileQueue::RequestID ReadRequest = AsyncFileQueue::INVALID_REQUEST; // File read, if queued
+        std::vector<std::function<void(ResourceHandle)>> PendingCallbacks; // Run when the load finishes
+        bool IsCached = false;             // Unreferenced, kept resident in its type's LRU
+        std::list<uint32_t>::iterator CachePosition;    // Position in the LRU while cached
 
         ResourceEntry() = default;
 
@@ -185,28 +200,17 @@ namespace SM
             , LastModified(other.LastModified)
             , IsLoaded(other.IsLoaded)
             , IsLoading(other.IsLoading)
-            , LoadFuture(std::move(other.LoadFuture))
+            , Priority(other.Priority)
+            , ReadRequest(other.ReadRequest)
+            , PendingCallbacks(std::move(other.PendingCallbacks))
+            , IsCached(other.IsCached)
+            , CachePosition(other.CachePosition)
         {
             other.Data = nullptr;
             other.IsLoaded = false;
         }
     };
 
-    // ============================================================================
-    // Load Request
-    // ============================================================================
-
-    /**
-     * @brief Request structure for async loading
-     */
-    struct ResourceLoadRequest
-    {
-        std::string Path;
-        ResourceType Type = ResourceType::Unknown;
-        std::function<void(ResourceHandle)> Callback;
-        bool HighPriority = false;
-    };
-
     // ============================================================================
     // Resource Manager
     // ============================================================================
@@ -228,10 +232,10 @@ namespace SM
      *   ResourceHandle tex = rm.Load<Texture>("textures/player.png");
      *   Texture* texData = rm.Get<Texture>(tex);
      *
-     *   // Async loading
+     *   // Async loading (callback runs in Update once the mesh is loaded)
      *   rm.LoadAsync<Mesh>("models/enemy.obj", [](ResourceHandle h) {
-     *       // Mesh is now loaded
-     *   });
+     *       // Mesh is now loaded (h is invalid if loading failed)
+     *   }, LoadPriority::High);
      *
      *   // Release when done
      *   rm.Release(tex);
@@ -252,7 +256,7 @@ namespace SM
 
         /**
          * @brief Initialize the resource manager
-         * @param maxAsyncLoads Maximum concurrent async load operations
+         * @param maxAsyncLoads Maximum file reads in flight at once
          * @return true if successful
          */
         bool Initialize(uint32_t maxAsyncLoads = 4);
@@ -263,8 +267,8 @@ namespace SM
         void Shutdown();
 
         /**
-         * @brief Update the resource manager (process async loads)
-         * Called once per frame.
+         * @brief Update the resource manager (finish async loads)
+         * Called once per frame. Async load callbacks run here.
          */
         void Update();
 
@@ -297,26 +301,75 @@ namespace SM
          * @tparam T Resource type
          * @param path Path to the resource file
          * @param callback Function to call when loading completes
+         * @param priority Start order relative to other queued loads
+         * @return Handle of the (loading) resource
          */
         template<typename T>
-        void LoadAsync(const std::string& path,
-                      std::function<void(ResourceHandle)> callback = nullptr)
+        ResourceHandle LoadAsync(const std::string& path,
+                                 std::function<void(ResourceHandle)> callback = nullptr,
+                                 LoadPriority priority = LoadPriority::Normal)
         {
-            LoadResourceAsync(path, GetResourceTypeForCppType<T>(), callback);
+            return LoadResourceAsync(path, GetResourceTypeForCppType<T>(), std::move(callback), priority);
         }
 
         /**
          * @brief Load a resource asynchronously by type
          * @param path Path to the resource file
          * @param type Resource type
-         * @param callback Function to call when loading completes
-         */
-        void LoadResourceAsync(
+         * @param callback Called from Update when loading completes, with an
+         *                 invalid handle if it failed
+         * @param priority Start order relative to other queued loads
+         * @return Handle of the (loading) resource, holding one reference
+         *
+         * Requests for a path that is already loading share the one load:
+         * the reference count and callback list grow, and the read moves up
+         * if the new priority is higher. Archive entries and large raw files
+         * (which are memory-mapped) skip the read queue and go straight to a
+         * decode job.
+         */
+        ResourceHandle LoadResourceAsync(
             const std::string& path,
             ResourceType type,
-            std::function<void(ResourceHandle)> callback = nullptr
+            std::function<void(ResourceHandle)> callback = nullptr,
+            LoadPriority priority = LoadPriority::Normal
         );
 
+        /**
+         * @brief Cancel an async load and drop the resource
+         * @param handle Handle returned by LoadResourceAsync
+         * @return true if the resource was still loading
+         *
+         * Drops every reference to the resource; pending callbacks never run.
+         */
+        bool CancelLoad(ResourceHandle handle);
+
+        // ====================================================================
+        // Archives
+        // ====================================================================
+
+        /**
+         * @brief Mount a packed asset archive
+         * @param archivePath Archive file (built with the assetpak tool)
+         * @param mountPoint Path prefix the archive's entries live under (e.g. "assets")
+         * @return true if the archive was opened
+         *
+         * Loads check mounted archives first, most recently mounted first,
+         * and fall back to loose files. Resources already loaded are not
+         * affected. Hot reload only watches loose files.
+         */
+        bool MountArchive(const std::string& archivePath, const std::string& mountPoint = "");
+
+        /**
+         * @brief Unmount a previously mounted archive
+         * @param archivePath Path passed to MountArchive
+         */
+        void UnmountArchive(const std::string& archivePath);
+
+        /**
+         * @brief Get the number of mounted archives
+         */
+        size_t GetMountedArchiveCount() const;
+
         // ====================================================================
         // Resource Access
         // ====================================================================
@@ -374,7 +427,8 @@ namespace SM
         /**
          * @brief Release a reference to a resource
          * @param handle Resource handle
-         * @note Resource is unloaded when ref count reaches 0
+         * @note Resource is unloaded when ref count reaches 0, or cached if its
+         *       type has a memory budget (see SetMemoryBudget)
          */
         void Release(ResourceHandle handle);
 
@@ -399,11 +453,28 @@ namespace SM
         // Hot Reloading
         // ====================================================================
 
+        /// Quiet time after the last write to a file before it is reloaded
+        static constexpr double HOT_RELOAD_SETTLE_SECONDS = 0.25;
+
+        /// Interval of the modification-time scan used without a file watcher
+        static constexpr double HOT_RELOAD_POLL_SECONDS = 1.0;
+
+        /**
+         * @brief Called from Update with the settled paths that changed
+         * @param paths FileWatcher::MakeKey paths with the listener's extension
+         */
+        using FileChangeListener = std::function<void(const std::vector<std::string>& paths)>;
+
         /**
          * @brief Enable or disable hot reloading
          * @param enable true to enable
+         *
+         * Starts a watcher on the hot reload directories, so Update only
+         * reloads resources whose files changed. Without a watcher backend
+         * (or directories) it falls back to scanning every loaded resource
+         * every HOT_RELOAD_POLL_SECONDS.
          */
-        void SetHotReloadEnabled(bool enable) { m_HotReloadEnabled = enable; }
+        void SetHotReloadEnabled(bool enable);
 
         /**
          * @brief Check if hot reloading is enabled
@@ -411,6 +482,20 @@ namespace SM
          */
         bool IsHotReloadEnabled() const { return m_HotReloadEnabled; }
 
+        /**
+         * @brief Watch a directory tree for edits
+         * @param directory Existing directory (e.g. "assets")
+         * @return false if the directory does not exist
+         */
+        bool AddHotReloadDirectory(const std::string& directory);
+
+        /**
+         * @brief Be told about changed files that are not resources (e.g. shaders)
+         * @param extension Extension including the dot (".hlsl"), case-insensitive
+         * @param listener Called at most once per Update with every changed path
+         */
+        void AddFileChangeListener(const std::string& extension, FileChangeListener listener);
+
         /**
          * @brief Check for modified resources and reload them
          * @return Number of resources reloaded
@@ -424,6 +509,57 @@ namespace SM
          */
         bool ReloadResource(ResourceHandle handle);
 
+        // ====================================================================
+        // Memory Budgets
+        // ====================================================================
+
+        /**
+         * @brief Supplies a budget each Update (e.g. from the video memory the OS grants)
+         * @return Budget in bytes, 0 for unlimited
+         */
+        using BudgetProvider = std::function<size_t()>;
+
+        /**
+         * @brief Set the memory budget of a resource type
+         * @param type Resource type
+         * @param bytes Budget in bytes; 0 (the default) disables caching for the type
+         *
+         * With a budget, releasing the last reference keeps the resource
+         * resident in an LRU instead of unloading it, and a later load of
+         * the path reuses it. Cached resources of the type are evicted,
+         * least recently released first, while the type's usage exceeds
+         * the budget. Referenced resources are never evicted.
+         */
+        void SetMemoryBudget(ResourceType type, size_t bytes);
+
+        /**
+         * @brief Re-read a type's budget from a callback every Update
+         * @param type Resource type
+         * @param provider Budget source, nullptr to keep the last value
+         */
+        void SetBudgetProvider(ResourceType type, BudgetProvider provider);
+
+        /**
+         * @brief Get the memory budget of a resource type (0 = unlimited, no caching)
+         */
+        size_t GetMemoryBudget(ResourceType type) const;
+
+        /**
+         * @brief Get the bytes held by loaded resources of a type (cached ones included)
+         */
+        size_t GetMemoryUsage(ResourceType type) const;
+
+        /**
+         * @brief Get the number of unreferenced resources kept for reuse
+         */
+        size_t GetCachedResourceCount() const;
+
+        /**
+         * @brief Evict every cached resource
+         * @return Number of resources evicted
+         */
+        size_t TrimCache();
+
         // ====================================================================
         // Statistics
         // ====================================================================
@@ -484,6 +620,29 @@ namespace SM
          */
         void* LoadResourceData(const std::string& path, ResourceType type);
 
+        /**
+         * @brief Load a resource from the first mounted archive containing it
+         * @param path Resource path as requested
+         * @param loader Loader chosen for the path
+         * @param data Container to fill
+         * @return false if no archive has the path (or it failed to parse)
+         */
+        bool LoadFromArchive(const std::string& path, IAssetLoader* loader, void* data);
+
+        /**
+         * @brief Find the archive entry a path resolves to
+         * @param path Resource path as requested
+         * @param outArchive Receives the archive holding the entry
+         * @return Entry, nullptr if no mounted archive has the path
+         */
+        const ArchiveEntry* FindInArchives(const std::string& path, std::shared_ptr<AssetArchive>& outArchive) const;
+
+        /**
+         * @brief Decode bytes read by the file queue
+         * @return Loaded data pointer, nullptr on failure
+         */
+        void* DecodeResourceData(const std::string& path, std::vector<uint8_t>& bytes);
+
         /**
          * @brief Internal unload implementation
          * @param entry Resource entry to unload
@@ -491,10 +650,48 @@ namespace SM
         void UnloadResourceData(ResourceEntry& entry);
 
         /**
-         * @brief Process a single async load
-         * @param request Load request
+         * @brief Stop the read of a loading entry (call before erasing it)
+         */
+        void AbortLoad(ResourceEntry& entry);
+
+        /**
+         * @brief Run a decode job for a resource; the result reaches Update
+         * @param bytes File contents, or empty to load from the path (archive or mapping)
+         */
+        void SubmitDecode(uint32_t id, const std::string& path, ResourceType type, std::vector<uint8_t> bytes);
+
+        /**
+         * @brief Hand a finished load to the next Update (any thread)
+         */
+        void PushCompletedLoad(uint32_t id, const std::string& path, void* data);
+
+        /**
+         * @brief Set an entry's loaded data and account for its size
+         */
+        void SetEntryData(ResourceEntry& entry, void* data);
+
+        /**
+         * @brief Take a reference, pulling the entry out of the LRU if it was cached
+         */
+        void Retain(ResourceEntry& entry);
+
+        /**
+         * @brief Remove an entry from its LRU (call before erasing a cached entry)
+         */
+        void Uncache(ResourceEntry& entry);
+
+        /**
+         * @brief Evict cached resources of a type, least recently released first
+         * @param targetBytes Stop once the type's usage is at most this; 0 evicts every cached entry
+         * @return Number of resources evicted
+         */
+        size_t EvictCached(ResourceType type, size_t targetBytes);
+
+        /**
+         * @brief Reload the resources whose files the watcher reported, and
+         *        notify file change listeners
          */
-        void ProcessAsyncLoad(ResourceLoadRequest request);
+        void ProcessFileChanges();
 
         /**
          * @brief Get resource type for C++ type (specialization needed)
@@ -518,13 +715,44 @@ namespace SM
         // ID generation
         std::atomic<uint32_t> m_NextResourceID{1};
 
-        // Async loading
-        std::vector<ResourceLoadRequest> m_PendingLoads;
-        std::atomic<uint32_t> m_ActiveAsyncLoads{0};
+        // Async loading: reads -> decode jobs -> m_CompletedLoads -> Update
+        struct CompletedLoad
+        {
+            uint32_t ID = 0;
+            std::string Path;
+            void* Data = nullptr;          // nullptr if the load failed
+        };
+        AsyncFileQueue m_FileQueue;
+        JobCounter m_DecodeJobs;
+        std::vector<CompletedLoad> m_CompletedLoads;
+        std::vector<std::pair<ResourceHandle, std::function<void(ResourceHandle)>>> m_ReadyCallbacks;
+        std::atomic<uint32_t> m_ActiveAsyncLoads{0};    // Entries still loading
+
+        // Memory budgets, per ResourceType; guarded by m_Mutex
+        static constexpr size_t TYPE_COUNT = static_cast<size_t>(ResourceType::Count);
+        std::array<size_t, TYPE_COUNT> m_Budgets{};
+        std::array<size_t, TYPE_COUNT> m_Usage{};
+        std::array<BudgetProvider, TYPE_COUNT> m_BudgetProviders;
+        std::array<std::list<uint32_t>, TYPE_COUNT> m_Caches;  // Cached IDs, most recently released first
+
+        // Hot reload
+        FileWatcher m_FileWatcher;
+        std::vector<std::pair<std::string, FileChangeListener>> m_FileChangeListeners;  // Lower-case extension
+        std::chrono::steady_clock::time_point m_LastHotReloadPoll;
+
+        // Mounted archives, searched back to front; shared so async loads
+        // keep an archive alive while it is unmounted
+        struct MountedArchive
+        {
+            std::shared_ptr<AssetArchive> Archive;
+            std::string MountPoint;         ///< Normalized, without trailing slash
+        };
+        std::vector<MountedArchive> m_Archives;
 
         // Thread safety
         mutable std::mutex m_Mutex;
         mutable std::mutex m_AsyncMutex;
+        mutable std::mutex m_ArchiveMutex;
     };
 
     // ============================================================================
@@ -0,0 +1,132 @@
+#include "core/Trace.h"
+
+#include <iostream>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <Windows.h>
+#include <evntprov.h>
+#include <TraceLoggingProvider.h>
+
+// "ShatteredMoon"; the GUID is the ETW name hash, so "*ShatteredMoon" enables it
+TRACELOGGING_DEFINE_PROVIDER(g_SMTraceProvider, "ShatteredMoon",
+    (0x706ced7f, 0x3370, 0x5fe2, 0xa3, 0xa4, 0xa7, 0xdc, 0x13, 0xcc, 0xa8, 0x47));
+#endif
+
+namespace SM
+{
+#ifdef _WIN32
+    static_assert(sizeof(GUID) == sizeof(uint64_t[2]), "Activity IDs are stored as two uint64_t");
+#endif
+
+    TraceProvider& TraceProvider::Get()
+    {
+        static TraceProvider instance;
+        return instance;
+    }
+
+    bool TraceProvider::Register()
+    {
+        if (m_Registered)
+        {
+            return true;
+        }
+
+#ifdef _WIN32
+        const HRESULT hr = TraceLoggingRegisterEx(g_SMTraceProvider, &TraceProvider::OnEnableChanged, this);
+        if (FAILED(hr))
+        {
+            std::cerr << "[Trace] Failed to register the ETW provider (0x" << std::hex << hr << std::dec << ")"
+                      << std::endl;
+            return false;
+        }
+
+        m_Registered = true;
+        m_Enabled.store(TraceLoggingProviderEnabled(g_SMTraceProvider, 0, 0), std::memory_order_relaxed);
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void TraceProvider::Unregister()
+    {
+        if (!m_Registered)
+        {
+            return;
+        }
+
+        m_Enabled.store(false, std::memory_order_relaxed);
+#ifdef _WIN32
+        TraceLoggingUnregister(g_SMTraceProvider);
+#endif
+        m_Registered = false;
+    }
+
+#ifdef _WIN32
+    void __stdcall TraceProvider::OnEnableChanged(const GUID* sourceId, unsigned long isEnabled, unsigned char level,
+                                                  unsigned long long matchAnyKeyword,
+                                                  unsigned long long matchAllKeyword,
+                                                  EVENT_FILTER_DESCRIPTOR* filterData, void* context)
+    {
+        (void)sourceId;
+        (void)isEnabled;
+        (void)level;
+        (void)matchAnyKeyword;
+        (void)matchAllKeyword;
+        (void)filterData;
+
+        // The provider state already reflects every session, including ones still listening
+        auto* provider = static_cast<TraceProvider*>(context);
+        provider->m_Enabled.store(TraceLoggingProviderEnabled(g_SMTraceProvider, 0, 0), std::memory_order_relaxed);
+    }
+#endif
+
+    // ============================================================================
+    // Events
+    // ============================================================================
+
+    void TraceProvider::WriteCounter(const char* name, uint64_t value)
+    {
+#ifdef _WIN32
+        TraceLoggingWrite(g_SMTraceProvider, "Counter",
+            TraceLoggingString(name, "Name"),
+            TraceLoggingUInt64(value, "Value"));
+#else
+        (void)name;
+        (void)value;
+#endif
+    }
+
+    void TraceProvider::WriteScopeStart(const char* name, uint64_t (&outActivity)[2])
+    {
+#ifdef _WIN32
+        // Process-local IDs: a counter, no system call
+        GUID* activity = reinterpret_cast<GUID*>(outActivity);
+        EventActivityIdControl(EVENT_ACTIVITY_CTRL_CREATE_ID, activity);
+
+        TraceLoggingWriteActivity(g_SMTraceProvider, "Scope", activity, nullptr,
+            TraceLoggingOpcode(WINEVENT_OPCODE_START),
+            TraceLoggingString(name, "Name"));
+#else
+        (void)name;
+        outActivity[0] = 0;
+        outActivity[1] = 0;
+#endif
+    }
+
+    void TraceProvider::WriteScopeStop(const char* name, const uint64_t (&activity)[2])
+    {
+#ifdef _WIN32
+        TraceLoggingWriteActivity(g_SMTraceProvider, "Scope", reinterpret_cast<const GUID*>(activity), nullptr,
+            TraceLoggingOpcode(WINEVENT_OPCODE_STOP),
+            TraceLoggingString(name, "Name"));
+#else
+        (void)name;
+        (void)activity;
+#endif
+    }
+
+} // namespace SM
@@ -0,0 +1,165 @@
+#pragma once
+
+/**
+ * @file Trace.h
+ * @brief Shattered Moon Engine - ETW events and counters for WPA and PIX
+ *
+ * Publishes the engine's structure to Windows Performance Analyzer and PIX
+ * timing captures through the "ShatteredMoon" TraceLogging provider.
+ * SM_TRACE_SCOPE("Name") writes a start/stop event pair sharing an activity
+ * ID around the enclosing scope, and SM_TRACE_COUNTER("Name", value) writes
+ * a named value (pending generations, visible chunks, ...). Every
+ * SM_PROFILE_SCOPE is also a trace scope, so captures show the same markers
+ * as the editor's profiler timeline. GPU markers for PIX are SM_GPU_EVENT in
+ * CommandList.h.
+ *
+ * Nothing is written unless a session has enabled the provider, so an idle
+ * provider costs one relaxed load per marker. The provider GUID is derived
+ * from its name, so sessions can enable it by name:
+ * @code
+ *   xperf -start SM -on *ShatteredMoon -f sm.etl
+ *   ...
+ *   xperf -stop SM       // open sm.etl in WPA: Generic Events, by Task Name / Name
+ * @endcode
+ *
+ * Configure with SM_ENABLE_TRACING=OFF (shipping builds) to compile the
+ * markers and counters out.
+ */
+
+#include <atomic>
+#include <cstdint>
+
+#ifdef _WIN32
+struct _GUID;
+struct _EVENT_FILTER_DESCRIPTOR;
+#endif
+
+namespace SM
+{
+    // ============================================================================
+    // Trace Provider
+    // ============================================================================
+
+    /**
+     * @brief The engine's ETW provider
+     *
+     * Register and Unregister belong to the main thread; everything else may
+     * be called from any thread. Without ETW (non-Windows) nothing is written.
+     */
+    class TraceProvider
+    {
+    public:
+        /**
+         * @brief Get the singleton instance
+         */
+        static TraceProvider& Get();
+
+        /**
+         * @brief Register the provider with ETW
+         * @return true if registered
+         */
+        bool Register();
+
+        /**
+         * @brief Unregister the provider (events are dropped afterwards)
+         */
+        void Unregister();
+
+        /**
+         * @brief Check if any trace session is listening
+         */
+        bool IsEnabled() const { return m_Enabled.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Write a named counter value
+         * @param name Counter name; must have static storage
+         */
+        void Counter(const char* name, uint64_t value)
+        {
+            if (IsEnabled())
+            {
+                WriteCounter(name, value);
+            }
+        }
+
+        /**
+         * @brief Write the start event of a scope
+         * @param outActivity Receives the activity ID to pass to WriteScopeStop
+         */
+        void WriteScopeStart(const char* name, uint64_t (&outActivity)[2]);
+
+        /**
+         * @brief Write the stop event of a scope
+         */
+        void WriteScopeStop(const char* name, const uint64_t (&activity)[2]);
+
+    private:
+        TraceProvider() = default;
+
+        void WriteCounter(const char* name, uint64_t value);
+
+#ifdef _WIN32
+        /**
+         * @brief ETW enable callback (PENABLECALLBACK); refreshes m_Enabled
+         */
+        static void __stdcall OnEnableChanged(const _GUID* sourceId, unsigned long isEnabled,
+                                              unsigned char level, unsigned long long matchAnyKeyword,
+                                              unsigned long long matchAllKeyword,
+                                              _EVENT_FILTER_DESCRIPTOR* filterData, void* context);
+#endif
+
+    private:
+        std::atomic<bool> m_Enabled{ false };
+        bool m_Registered = false;
+    };
+
+    // ============================================================================
+    // Scoped Event
+    // ============================================================================
+
+    /**
+     * @brief Writes a start event on construction and the stop event on destruction
+     */
+    class TraceScope
+    {
+    public:
+        explicit TraceScope(const char* name)
+        {
+            TraceProvider& provider = TraceProvider::Get();
+            if (provider.IsEnabled())
+            {
+                m_Name = name;
+                provider.WriteScopeStart(name, m_Activity);
+            }
+        }
+
+        ~TraceScope()
+        {
+            if (m_Name)
+            {
+                TraceProvider::Get().WriteScopeStop(m_Name, m_Activity);
+            }
+        }
+
+        TraceScope(const TraceScope&) = delete;
+        TraceScope& operator=(const TraceScope&) = delete;
+
+    private:
+        const char* m_Name = nullptr;   ///< nullptr when no session was listening at construction
+        uint64_t m_Activity[2];         ///< ETW activity ID (a GUID) pairing the two events
+    };
+
+} // namespace SM
+
+#define SM_TRACE_CONCAT_INNER(a, b) a##b
+#define SM_TRACE_CONCAT(a, b) SM_TRACE_CONCAT_INNER(a, b)
+
+#ifdef SM_ENABLE_TRACING
+    /// Write start/stop events around the enclosing scope; name must have static storage
+    #define SM_TRACE_SCOPE(name) ::SM::TraceScope SM_TRACE_CONCAT(sm_TraceScope_, __LINE__)(name)
+    /// Write a named counter value; name must have static storage
+    #define SM_TRACE_COUNTER(name, value) ::SM::TraceProvider::Get().Counter(name, static_cast<uint64_t>(value))
+#else
+    #define SM_TRACE_SCOPE(name) ((void)0)
+    #define SM_TRACE_COUNTER(name, value) ((void)0)
+#endif
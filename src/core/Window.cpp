@@ -1,6 +1,7 @@
 #include "core/Window.h"
 #include "gameplay/Input.h"
 
+#include <iostream>
 #include <stdexcept>
 #include <vector>
 #include <windowsx.h>  // For GET_X_LPARAM, GET_Y_LPARAM
@@ -31,38 +32,74 @@ namespace SM
         m_Fullscreen = config.fullscreen;
         m_Resizable = config.resizable;
 
-        // Register window class
-        if (!RegisterWindowClass())
+        if (config.messageThread)
         {
-            return false;
-        }
+            m_MessageThreadReady = false;
+            m_MessageThreadFailed = false;
+            m_MessageThread = std::thread(&Window::MessageThreadMain, this);
 
-        // Create window
-        if (!CreateMainWindow())
-        {
-            return false;
+            // The window belongs to the thread that creates it
+            while (!m_MessageThreadReady && !m_MessageThreadFailed)
+            {
+                std::this_thread::yield();
+            }
+
+            if (m_MessageThreadFailed)
+            {
+                m_MessageThread.join();
+                std::cerr << "[Window] Failed to create the window on its message thread" << std::endl;
+                return false;
+            }
+
+            // Shared input state lets this thread capture the mouse, show the
+            // cursor and read key state for the other thread's window
+            AttachThreadInput(GetCurrentThreadId(), m_MessageThreadId, TRUE);
         }
+        else
+        {
+            // Register window class
+            if (!RegisterWindowClass())
+            {
+                return false;
+            }
 
-        // Set window handle for input system
-        Input::Get().SetWindowHandle(m_Handle);
+            // Create window
+            if (!CreateMainWindow())
+            {
+                return false;
+            }
 
-        // Register for raw mouse input
-        RAWINPUTDEVICE rid;
-        rid.usUsagePage = 0x01;  // HID_USAGE_PAGE_GENERIC
-        rid.usUsage = 0x02;      // HID_USAGE_GENERIC_MOUSE
-        rid.dwFlags = 0;
-        rid.hwndTarget = m_Handle;
-        RegisterRawInputDevices(&rid, 1, sizeof(rid));
+            // Register for raw mouse input
+            RegisterRawMouse(m_Handle, 0);
 
-        // Show and update window
-        ShowWindow(m_Handle, SW_SHOW);
-        UpdateWindow(m_Handle);
+            // Show and update window
+            ShowWindow(m_Handle, SW_SHOW);
+            UpdateWindow(m_Handle);
+        }
+
+        // Set window handle for input system (Input is used on this thread either way)
+        Input::Get().SetWindowHandle(m_Handle);
 
         return true;
     }
 
     void Window::Shutdown()
     {
+        StopRawInputThread();
+
+        if (IsMessageThreadRunning())
+        {
+            // Only the owning thread may destroy the window; its WM_DESTROY ends the pump
+            if (m_Handle)
+            {
+                PostMessage(m_Handle, WM_CLOSE, 0, 0);
+            }
+            m_MessageThread.join();
+            m_MessageThreadId = 0;
+            m_Handle = nullptr;
+            return;
+        }
+
         if (m_Handle)
         {
             DestroyWindow(m_Handle);
@@ -161,6 +198,47 @@ namespace SM
 
     bool Window::ProcessMessages()
     {
+        if (IsMessageThreadRunning())
+        {
+            bool quit = false;
+            bool resized = false;
+
+            const uint32_t write = m_EventWrite.load(std::memory_order_acquire);
+            uint32_t read = m_EventRead.load(std::memory_order_relaxed);
+            for (; read != write; ++read)
+            {
+                const WindowEvent& event = m_Events[read & (EVENT_QUEUE_SIZE - 1)];
+                switch (event.Message)
+                {
+                case WM_DESTROY:
+                    quit = true;
+                    break;
+
+                case WM_SIZE:
+                    m_Width = LOWORD(event.LParam);
+                    m_Height = HIWORD(event.LParam);
+                    m_Minimized = (event.WParam == SIZE_MINIMIZED);
+                    resized = true;
+                    break;
+
+                default:
+                    DispatchInputMessage(event.Message, event.WParam, event.LParam);
+                    break;
+                }
+            }
+            m_EventRead.store(read, std::memory_order_release);
+
+            // A drag-resize queues many sizes; the swap chain only needs the last
+            if (resized && m_ResizeCallback && m_Width > 0 && m_Height > 0)
+            {
+                m_ResizeCallback(static_cast<uint32_t>(m_Width), static_cast<uint32_t>(m_Height));
+            }
+
+            return !quit;
+        }
+
+        PollRawInput();
+
         MSG msg = {};
         while (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE))
         {
@@ -176,6 +254,206 @@ namespace SM
         return true;
     }
 
+    void Window::PollRawInput()
+    {
+        // The message thread reads raw input as it arrives
+        if (IsRawInputThreadRunning() || IsMessageThreadRunning() || !m_Handle)
+        {
+            return;
+        }
+
+        // Everything read in one poll shares its timestamp
+        const int64_t timestamp = Input::GetTimestamp();
+        Input& input = Input::Get();
+
+        alignas(8) BYTE buffer[64 * sizeof(RAWINPUT)];
+        for (;;)
+        {
+            UINT size = sizeof(buffer);
+            UINT count = GetRawInputBuffer(reinterpret_cast<RAWINPUT*>(buffer), &size, sizeof(RAWINPUTHEADER));
+            if (count == 0 || count == static_cast<UINT>(-1))
+            {
+                break;
+            }
+
+            RAWINPUT* raw = reinterpret_cast<RAWINPUT*>(buffer);
+            for (UINT i = 0; i < count; ++i)
+            {
+                if (raw->header.dwType == RIM_TYPEMOUSE)
+                {
+                    input.PushRawMouseInput(raw->data.mouse.lLastX, raw->data.mouse.lLastY, timestamp);
+                }
+                raw = NEXTRAWINPUTBLOCK(raw);
+            }
+        }
+    }
+
+    bool Window::RegisterRawMouse(HWND target, DWORD flags)
+    {
+        RAWINPUTDEVICE rid;
+        rid.usUsagePage = 0x01;  // HID_USAGE_PAGE_GENERIC
+        rid.usUsage = 0x02;      // HID_USAGE_GENERIC_MOUSE
+        rid.dwFlags = flags;
+        rid.hwndTarget = target;
+        return RegisterRawInputDevices(&rid, 1, sizeof(rid)) == TRUE;
+    }
+
+    bool Window::StartRawInputThread()
+    {
+        if (IsRawInputThreadRunning())
+        {
+            return true;
+        }
+
+        m_RawInputThreadReady = false;
+        m_RawInputThreadFailed = false;
+        m_RawInputThread = std::thread(&Window::RawInputThreadMain, this);
+
+        // The thread registers its own window before anything else reads raw input
+        while (!m_RawInputThreadReady && !m_RawInputThreadFailed)
+        {
+            std::this_thread::yield();
+        }
+
+        if (m_RawInputThreadFailed)
+        {
+            m_RawInputThread.join();
+            std::cerr << "[Window] Failed to start raw input thread" << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    void Window::StopRawInputThread()
+    {
+        if (!IsRawInputThreadRunning())
+        {
+            return;
+        }
+
+        PostThreadMessage(m_RawInputThreadId, WM_QUIT, 0, 0);
+        m_RawInputThread.join();
+        m_RawInputThreadId = 0;
+
+        if (m_Handle)
+        {
+            RegisterRawMouse(m_Handle, 0);
+        }
+    }
+
+    void Window::RawInputThreadMain()
+    {
+        m_RawInputThreadId = GetCurrentThreadId();
+
+        WNDCLASSEXW wc = {};
+        wc.cbSize = sizeof(WNDCLASSEXW);
+        wc.lpfnWndProc = DefWindowProcW;
+        wc.hInstance = m_Instance;
+        wc.lpszClassName = RAW_INPUT_CLASS_NAME;
+        RegisterClassExW(&wc); // Fails harmlessly if already registered by an earlier start
+
+        HWND sink = CreateWindowExW(0, RAW_INPUT_CLASS_NAME, L"", 0, 0, 0, 0, 0,
+                                    HWND_MESSAGE, nullptr, m_Instance, nullptr);
+
+        // INPUTSINK: a message-only window is never in the foreground
+        if (!sink || !RegisterRawMouse(sink, RIDEV_INPUTSINK))
+        {
+            if (sink)
+            {
+                DestroyWindow(sink);
+            }
+            m_RawInputThreadFailed = true;
+            return;
+        }
+
+        m_RawInputThreadReady = true;
+
+        Input& input = Input::Get();
+        std::vector<BYTE> rawdata;
+
+        MSG msg = {};
+        while (GetMessageW(&msg, nullptr, 0, 0) > 0)
+        {
+            if (msg.message == WM_INPUT)
+            {
+                const int64_t timestamp = Input::GetTimestamp();
+
+                UINT size = 0;
+                GetRawInputData(reinterpret_cast<HRAWINPUT>(msg.lParam), RID_INPUT, nullptr, &size, sizeof(RAWINPUTHEADER));
+                if (size > 0)
+                {
+                    rawdata.resize(size);
+                    if (GetRawInputData(reinterpret_cast<HRAWINPUT>(msg.lParam), RID_INPUT, rawdata.data(), &size, sizeof(RAWINPUTHEADER)) == size)
+                    {
+                        RAWINPUT* raw = reinterpret_cast<RAWINPUT*>(rawdata.data());
+                        if (raw->header.dwType == RIM_TYPEMOUSE)
+                        {
+                            input.PushRawMouseInput(raw->data.mouse.lLastX, raw->data.mouse.lLastY, timestamp);
+                        }
+                    }
+                }
+            }
+
+            DispatchMessageW(&msg);
+        }
+
+        DestroyWindow(sink);
+    }
+
+    void Window::MessageThreadMain()
+    {
+        m_MessageThreadId = GetCurrentThreadId();
+
+        if (!RegisterWindowClass() || !CreateMainWindow())
+        {
+            m_MessageThreadFailed = true;
+            return;
+        }
+
+        RegisterRawMouse(m_Handle, 0);
+        ShowWindow(m_Handle, SW_SHOW);
+        UpdateWindow(m_Handle);
+
+        m_MessageThreadReady = true;
+
+        // Blocking is fine here: nothing else runs on this thread
+        MSG msg = {};
+        while (GetMessageW(&msg, nullptr, 0, 0) > 0)
+        {
+            TranslateMessage(&msg);
+            DispatchMessageW(&msg);
+        }
+    }
+
+    void Window::PushEvent(UINT msg, WPARAM wParam, LPARAM lParam)
+    {
+        const uint32_t write = m_EventWrite.load(std::memory_order_relaxed);
+        if (write - m_EventRead.load(std::memory_order_acquire) >= EVENT_QUEUE_SIZE)
+        {
+            // The engine has stalled for thousands of messages; never block the window
+            if (!m_EventOverflowReported)
+            {
+                m_EventOverflowReported = true;
+                std::cerr << "[Window] Message queue full, dropping input" << std::endl;
+            }
+            return;
+        }
+
+        WindowEvent& event = m_Events[write & (EVENT_QUEUE_SIZE - 1)];
+        event.Message = msg;
+        event.WParam = wParam;
+        event.LParam = lParam;
+        m_EventWrite.store(write + 1, std::memory_order_release);
+    }
+
+    bool Window::IsForwardedMessage(UINT msg)
+    {
+        return (msg >= WM_KEYFIRST && msg <= WM_KEYLAST) ||
+               (msg >= WM_MOUSEFIRST && msg <= WM_MOUSELAST) ||
+               msg == WM_MOUSELEAVE || msg == WM_SETFOCUS || msg == WM_KILLFOCUS;
+    }
+
     void Window::Clear(float r, float g, float b)
     {
         // Simple GDI clear for now - will be replaced by DX12
@@ -279,18 +557,29 @@ namespace SM
 
     LRESULT Window::HandleMessage(UINT msg, WPARAM wParam, LPARAM lParam)
     {
-        // Let ImGui process messages first
-        if (ImGui_ImplWin32_WndProcHandler(m_Handle, msg, wParam, lParam))
+        const bool messageThread = (GetCurrentThreadId() == m_MessageThreadId);
+
+        if (messageThread)
+        {
+            // Input is replayed on the engine thread, which owns Input and ImGui
+            if (IsForwardedMessage(msg))
+            {
+                PushEvent(msg, wParam, lParam);
+            }
+        }
+        else if (DispatchInputMessage(msg, wParam, lParam))
         {
+            // Let ImGui process messages first
             return true;
         }
 
-        // Get input system reference
-        Input& input = Input::Get();
-
         switch (msg)
         {
         case WM_DESTROY:
+            if (messageThread)
+            {
+                PushEvent(msg, wParam, lParam);
+            }
             PostQuitMessage(0);
             return 0;
 
@@ -300,6 +589,13 @@ namespace SM
 
         case WM_SIZE:
         {
+            if (messageThread)
+            {
+                // Applied with the callback at the engine's next frame
+                PushEvent(msg, wParam, lParam);
+                return 0;
+            }
+
             m_Width = LOWORD(lParam);
             m_Height = HIWORD(lParam);
             m_Minimized = (wParam == SIZE_MINIMIZED);
@@ -312,13 +608,9 @@ namespace SM
             return 0;
         }
 
-        // Keyboard input
         case WM_KEYDOWN:
         case WM_SYSKEYDOWN:
         {
-            // Forward to input system
-            input.ProcessKeyDown(static_cast<uint32_t>(wParam));
-
             // Handle special keys
             if (wParam == VK_F11)
             {
@@ -328,12 +620,79 @@ namespace SM
             break;
         }
 
+        // Raw input read here is stamped now, not when the engine next polls
+        case WM_INPUT:
+        {
+            if (!messageThread)
+            {
+                break;
+            }
+
+            UINT size = 0;
+            GetRawInputData(reinterpret_cast<HRAWINPUT>(lParam), RID_INPUT, nullptr, &size, sizeof(RAWINPUTHEADER));
+
+            alignas(8) BYTE rawdata[sizeof(RAWINPUT)];
+            if (size > 0 && size <= sizeof(rawdata) &&
+                GetRawInputData(reinterpret_cast<HRAWINPUT>(lParam), RID_INPUT, rawdata, &size, sizeof(RAWINPUTHEADER)) == size)
+            {
+                RAWINPUT* raw = reinterpret_cast<RAWINPUT*>(rawdata);
+                if (raw->header.dwType == RIM_TYPEMOUSE)
+                {
+                    Input::Get().PushRawMouseInput(raw->data.mouse.lLastX, raw->data.mouse.lLastY, Input::GetTimestamp());
+                }
+            }
+            break;
+        }
+
+        case WM_GETMINMAXINFO:
+        {
+            // Set minimum window size
+            MINMAXINFO* minMaxInfo = reinterpret_cast<MINMAXINFO*>(lParam);
+            minMaxInfo->ptMinTrackSize.x = 320;
+            minMaxInfo->ptMinTrackSize.y = 240;
+            return 0;
+        }
+
+        case WM_PAINT:
+        {
+            PAINTSTRUCT ps;
+            HDC hdc = BeginPaint(m_Handle, &ps);
+            // GDI painting is handled in Clear() for now
+            (void)hdc;
+            EndPaint(m_Handle, &ps);
+            return 0;
+        }
+
+        case WM_ERASEBKGND:
+            // Prevent flickering by handling background erase ourselves
+            return 1;
+        }
+
+        return DefWindowProc(m_Handle, msg, wParam, lParam);
+    }
+
+    bool Window::DispatchInputMessage(UINT msg, WPARAM wParam, LPARAM lParam)
+    {
+        if (ImGui_ImplWin32_WndProcHandler(m_Handle, msg, wParam, lParam))
+        {
+            return true;
+        }
+
+        // Get input system reference
+        Input& input = Input::Get();
+
+        switch (msg)
+        {
+        // Keyboard input
+        case WM_KEYDOWN:
+        case WM_SYSKEYDOWN:
+            input.ProcessKeyDown(static_cast<uint32_t>(wParam));
+            break;
+
         case WM_KEYUP:
         case WM_SYSKEYUP:
-        {
             input.ProcessKeyUp(static_cast<uint32_t>(wParam));
             break;
-        }
 
         // Mouse movement
         case WM_MOUSEMOVE:
@@ -417,32 +776,9 @@ namespace SM
             input.Reset();
             break;
         }
-
-        case WM_GETMINMAXINFO:
-        {
-            // Set minimum window size
-            MINMAXINFO* minMaxInfo = reinterpret_cast<MINMAXINFO*>(lParam);
-            minMaxInfo->ptMinTrackSize.x = 320;
-            minMaxInfo->ptMinTrackSize.y = 240;
-            return 0;
-        }
-
-        case WM_PAINT:
-        {
-            PAINTSTRUCT ps;
-            HDC hdc = BeginPaint(m_Handle, &ps);
-            // GDI painting is handled in Clear() for now
-            (void)hdc;
-            EndPaint(m_Handle, &ps);
-            return 0;
-        }
-
-        case WM_ERASEBKGND:
-            // Prevent flickering by handling background erase ourselves
-            return 1;
         }
 
-        return DefWindowProc(m_Handle, msg, wParam, lParam);
+        return false;
     }
 
 } // namespace SM
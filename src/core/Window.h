@@ -6,6 +6,11 @@
  *
  * Handles window creation, message processing, and basic rendering operations.
  * Also forwards input events to the Input system.
+ *
+ * With WindowConfig::messageThread the window lives on its own thread, so
+ * the modal move/size loop no longer stalls the engine. That thread only
+ * queues input and size messages; ProcessMessages replays them on the
+ * engine thread at the start of the next frame.
  */
 
 #ifndef WIN32_LEAN_AND_MEAN
@@ -13,8 +18,12 @@
 #endif
 
 #include <Windows.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <functional>
+#include <thread>
 
 namespace SM
 {
@@ -28,6 +37,7 @@ namespace SM
         int height = 720;
         bool fullscreen = false;
         bool resizable = true;
+        bool messageThread = false;     // Create and pump the window on a dedicated thread
     };
 
     /**
@@ -61,9 +71,48 @@ namespace SM
         /**
          * @brief Process window messages
          * @return false if WM_QUIT was received, true otherwise
+         *
+         * Drains buffered raw input first (see PollRawInput). With a message
+         * thread, replays the input it queued instead and reports only the
+         * last size change, so a drag-resize resizes the swap chain once.
          */
         bool ProcessMessages();
 
+        /**
+         * @brief Read all buffered raw mouse input into Input's event queue
+         *
+         * Uses GetRawInputBuffer, so a burst of high-rate mouse reports costs
+         * one call instead of one WM_INPUT dispatch each. Cheap enough to call
+         * again just before the camera is latched. Does nothing while the raw
+         * input thread runs.
+         */
+        void PollRawInput();
+
+        /**
+         * @brief Read raw mouse input on a dedicated thread
+         * @return true if the thread started
+         *
+         * The thread owns a message-only window that receives WM_INPUT as
+         * soon as it arrives, so events are stamped at read time instead of
+         * once per frame.
+         */
+        bool StartRawInputThread();
+
+        /**
+         * @brief Stop the raw input thread and route raw input back to the window
+         */
+        void StopRawInputThread();
+
+        /**
+         * @brief Check if the raw input thread is running
+         */
+        bool IsRawInputThreadRunning() const { return m_RawInputThread.joinable(); }
+
+        /**
+         * @brief Check if the window is pumped on its own message thread
+         */
+        bool IsMessageThreadRunning() const { return m_MessageThread.joinable(); }
+
         /**
          * @brief Clear the window with a solid color (GDI fallback)
          * @param r Red component (0.0 - 1.0)
@@ -145,6 +194,39 @@ namespace SM
          */
         LRESULT HandleMessage(UINT msg, WPARAM wParam, LPARAM lParam);
 
+        /**
+         * @brief Pass an input message to ImGui and the Input system (engine thread)
+         * @return true if ImGui consumed it
+         */
+        bool DispatchInputMessage(UINT msg, WPARAM wParam, LPARAM lParam);
+
+        /**
+         * @brief Check if a message is replayed on the engine thread in message thread mode
+         */
+        static bool IsForwardedMessage(UINT msg);
+
+        /**
+         * @brief Message thread body: creates the window, then pumps it
+         */
+        void MessageThreadMain();
+
+        /**
+         * @brief Queue a message for the engine thread (message thread only)
+         */
+        void PushEvent(UINT msg, WPARAM wParam, LPARAM lParam);
+
+        /**
+         * @brief Route raw mouse input to a window
+         * @param target Window that receives WM_INPUT
+         * @param flags RIDEV_* flags
+         */
+        static bool RegisterRawMouse(HWND target, DWORD flags);
+
+        /**
+         * @brief Raw input thread body
+         */
+        void RawInputThreadMain();
+
     private:
         // Window handle
         HWND m_Handle = nullptr;
@@ -168,6 +250,31 @@ namespace SM
 
         // Callbacks
         std::function<void(uint32_t, uint32_t)> m_ResizeCallback;
+
+        // Raw input thread
+        std::thread m_RawInputThread;
+        std::atomic<DWORD> m_RawInputThreadId{ 0 };
+        std::atomic<bool> m_RawInputThreadReady{ false };
+        std::atomic<bool> m_RawInputThreadFailed{ false };
+        static constexpr const wchar_t* RAW_INPUT_CLASS_NAME = L"ShatteredMoonRawInputClass";
+
+        // Message thread
+        struct WindowEvent
+        {
+            UINT Message = 0;
+            WPARAM WParam = 0;
+            LPARAM LParam = 0;
+        };
+
+        static constexpr uint32_t EVENT_QUEUE_SIZE = 4096;  // Power of two
+        std::thread m_MessageThread;
+        std::atomic<DWORD> m_MessageThreadId{ 0 };
+        std::atomic<bool> m_MessageThreadReady{ false };
+        std::atomic<bool> m_MessageThreadFailed{ false };
+        std::array<WindowEvent, EVENT_QUEUE_SIZE> m_Events;   // Single-producer single-consumer ring
+        std::atomic<uint32_t> m_EventRead{ 0 };     // Advanced by the engine thread
+        std::atomic<uint32_t> m_EventWrite{ 0 };    // Advanced by the message thread
+        bool m_EventOverflowReported = false;       // Message thread only
     };
 
 } // namespace SM
@@ -0,0 +1,712 @@
+#pragma once
+
+/**
+ * @file Archetype.h
+ * @brief Archetype (chunked SoA) component storage for Shattered Moon ECS
+ *
+ * Entities with identical signatures are grouped into an Archetype. Each
+ * archetype stores its entities in fixed-size blocks with one contiguous
+ * column per component type, so iterating several components at once walks
+ * memory in order instead of hashing into one array per type.
+ */
+
+#include "Entity.h"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace SM
+{
+    // ============================================================================
+    // Constants
+    // ============================================================================
+
+    /**
+     * @brief Target size of one archetype block in bytes
+     *
+     * Small enough to stay cache-resident while a block is processed.
+     * Rows wider than this get single-row blocks.
+     */
+    constexpr std::size_t ARCHETYPE_BLOCK_BYTES = 16 * 1024;
+
+    /**
+     * @brief Alignment of archetype block allocations (one cache line)
+     */
+    constexpr std::size_t ARCHETYPE_BLOCK_ALIGNMENT = 64;
+
+    // ============================================================================
+    // ComponentTypeInfo
+    // ============================================================================
+
+    /**
+     * @brief Type-erased description of a component type
+     *
+     * Lets archetype storage move and destroy components without knowing
+     * their static type.
+     */
+    struct ComponentTypeInfo
+    {
+        std::size_t Size = 0;
+        std::size_t Alignment = 0;
+        void (*MoveConstruct)(void* dst, void* src) = nullptr;
+        void (*Destroy)(void* ptr) = nullptr;
+
+        bool IsValid() const { return Size != 0; }
+
+        /**
+         * @brief Build the type info for a component type
+         * @tparam T The component type
+         */
+        template<typename T>
+        static ComponentTypeInfo Of()
+        {
+            static_assert(std::is_move_constructible_v<T>, "Components must be move constructible");
+
+            ComponentTypeInfo info;
+            info.Size = sizeof(T);
+            info.Alignment = alignof(T);
+            info.MoveConstruct = [](void* dst, void* src) {
+                new (dst) T(std::move(*static_cast<T*>(src)));
+            };
+            info.Destroy = [](void* ptr) {
+                static_cast<T*>(ptr)->~T();
+            };
+            return info;
+        }
+    };
+
+    using ComponentTypeInfoTable = std::array<ComponentTypeInfo, MAX_COMPONENTS>;
+
+    // ============================================================================
+    // Archetype Class
+    // ============================================================================
+
+    /**
+     * @brief Storage for all entities sharing one component signature
+     *
+     * Rows are packed: removing a row moves the last row into the hole, so
+     * every block except the last is always full.
+     *
+     * Block layout (per block):
+     * - EntityID column
+     * - One column per component type, each aligned for its type
+     */
+    class Archetype
+    {
+    public:
+        Archetype(const Signature& signature, const ComponentTypeInfoTable& typeInfos);
+        ~Archetype();
+
+        // Prevent copying (owns raw component memory)
+        Archetype(const Archetype&) = delete;
+        Archetype& operator=(const Archetype&) = delete;
+
+        /**
+         * @brief Get the signature shared by all entities in this archetype
+         */
+        const Signature& GetSignature() const { return m_Signature; }
+
+        /**
+         * @brief Get the number of entities stored
+         */
+        std::size_t Size() const { return m_Count; }
+
+        /**
+         * @brief Get the number of rows per block
+         */
+        std::size_t GetBlockCapacity() const { return m_BlockCapacity; }
+
+        /**
+         * @brief Get the number of allocated blocks
+         */
+        std::size_t GetBlockCount() const { return m_Blocks.size(); }
+
+        /**
+         * @brief Get the number of used rows in a block
+         */
+        std::size_t GetBlockEntityCount(std::size_t block) const
+        {
+            std::size_t first = block * m_BlockCapacity;
+            return (m_Count > first) ? std::min(m_BlockCapacity, m_Count - first) : 0;
+        }
+
+        /**
+         * @brief Get the entity column of a block
+         */
+        const EntityID* GetBlockEntities(std::size_t block) const
+        {
+            return reinterpret_cast<const EntityID*>(m_Blocks[block].get());
+        }
+
+        /**
+         * @brief Get a typed component column of a block
+         * @tparam T The component type (must match the column type)
+         * @param type Component type ID of the column
+         * @param block Block index
+         */
+        template<typename T>
+        T* GetBlockColumn(ComponentType type, std::size_t block)
+        {
+            assert(m_Signature.test(type) && "Archetype does not contain component");
+            return reinterpret_cast<T*>(m_Blocks[block].get() + m_ColumnOffsets[type]);
+        }
+
+        /**
+         * @brief Get the component memory for a row
+         * @param type Component type ID
+         * @param row Row index
+         */
+        void* GetComponent(ComponentType type, std::size_t row)
+        {
+            assert(m_Signature.test(type) && "Archetype does not contain component");
+            return RowAddress(type, row);
+        }
+
+        /**
+         * @brief Get the entity stored in a row
+         */
+        EntityID GetEntity(std::size_t row) const
+        {
+            return GetBlockEntities(row / m_BlockCapacity)[row % m_BlockCapacity];
+        }
+
+        /**
+         * @brief Append a row for an entity
+         * @param entity The entity that will own the row
+         * @return Row index; component memory is left unconstructed
+         */
+        std::size_t AllocateRow(EntityID entity);
+
+        /**
+         * @brief Append consecutive rows for many entities
+         * @param entities The entities that will own the rows, in order
+         * @param count Number of entities
+         * @return First row index; component memory is left unconstructed
+         */
+        std::size_t AllocateRows(const EntityID* entities, std::size_t count);
+
+        /**
+         * @brief Destroy all components in a row and compact
+         * @param row Row to remove
+         * @return Entity moved into the row, or INVALID_ENTITY if none moved
+         */
+        EntityID RemoveRow(std::size_t row);
+
+        /**
+         * @brief Move a row's components into another archetype and compact
+         * @param row Source row
+         * @param destination Archetype receiving the components
+         * @param destinationRow Row allocated in the destination
+         * @return Entity moved into the source row, or INVALID_ENTITY if none moved
+         *
+         * Components the destination does not store are destroyed.
+         */
+        EntityID MigrateRow(std::size_t row, Archetype& destination, std::size_t destinationRow);
+
+    private:
+        void* RowAddress(ComponentType type, std::size_t row)
+        {
+            std::uint8_t* block = m_Blocks[row / m_BlockCapacity].get();
+            return block + m_ColumnOffsets[type] + (row % m_BlockCapacity) * m_TypeInfos[type].Size;
+        }
+
+        EntityID& EntityAt(std::size_t row)
+        {
+            return reinterpret_cast<EntityID*>(m_Blocks[row / m_BlockCapacity].get())[row % m_BlockCapacity];
+        }
+
+        /**
+         * @brief Fill a destroyed row with the last row
+         * @return Entity moved into the row, or INVALID_ENTITY if none moved
+         */
+        EntityID CompactRow(std::size_t row);
+
+        struct BlockDeleter
+        {
+            void operator()(std::uint8_t* ptr) const
+            {
+                ::operator delete(ptr, std::align_val_t(ARCHETYPE_BLOCK_ALIGNMENT));
+            }
+        };
+
+        Signature m_Signature;
+        ComponentTypeInfoTable m_TypeInfos;
+        std::vector<ComponentType> m_Types;                     ///< Component types in signature order
+        std::array<std::size_t, MAX_COMPONENTS> m_ColumnOffsets{}; ///< Byte offset of each column in a block
+        std::size_t m_BlockCapacity = 1;
+        std::size_t m_BlockBytes = 0;
+
+        std::vector<std::unique_ptr<std::uint8_t[], BlockDeleter>> m_Blocks;
+        std::size_t m_Count = 0;
+    };
+
+    // ============================================================================
+    // ArchetypeStorage Class
+    // ============================================================================
+
+    /**
+     * @brief Component storage backend that groups entities by signature
+     *
+     * Moving an entity between archetypes (adding or removing a component)
+     * costs one move per component it owns; reads are two array lookups.
+     */
+    class ArchetypeStorage
+    {
+    public:
+        ArchetypeStorage() = default;
+        ~ArchetypeStorage() = default;
+
+        // Prevent copying
+        ArchetypeStorage(const ArchetypeStorage&) = delete;
+        ArchetypeStorage& operator=(const ArchetypeStorage&) = delete;
+
+        // Allow moving
+        ArchetypeStorage(ArchetypeStorage&&) = default;
+        ArchetypeStorage& operator=(ArchetypeStorage&&) = default;
+
+        /**
+         * @brief Register a component type
+         * @tparam T The component type
+         * @param type The component type ID
+         */
+        template<typename T>
+        void RegisterType(ComponentType type)
+        {
+            m_TypeInfos[type] = ComponentTypeInfo::Of<T>();
+        }
+
+        /**
+         * @brief Add a component, moving the entity to its new archetype
+         */
+        template<typename T>
+        void Add(EntityID entity, ComponentType type, T component);
+
+        /**
+         * @brief Place many component-less entities directly in one archetype
+         * @param entities Entities that own no components yet
+         * @param count Number of entities
+         * @param signature Archetype to place them in
+         * @param outFirstRow Receives the row of entities[0]; the rest follow in order
+         * @return The archetype; the caller constructs every component of the new rows
+         */
+        Archetype& AddEntities(const EntityID* entities, std::size_t count, const Signature& signature,
+                               std::size_t& outFirstRow);
+
+        /**
+         * @brief Remove a component, moving the entity to its new archetype
+         */
+        void Remove(EntityID entity, ComponentType type);
+
+        /**
+         * @brief Destroy all components of an entity
+         */
+        void EntityDestroyed(EntityID entity);
+
+        /**
+         * @brief Check if an entity has a component
+         */
+        bool Has(EntityID entity, ComponentType type) const
+        {
+            const Archetype* archetype = GetArchetypeOf(entity);
+            return archetype && archetype->GetSignature().test(type);
+        }
+
+        /**
+         * @brief Get a component, or nullptr if the entity lacks it
+         */
+        template<typename T>
+        T* TryGet(EntityID entity, ComponentType type) const
+        {
+            return static_cast<T*>(TryGetRaw(entity, type));
+        }
+
+        /**
+         * @brief Get a component's memory, or nullptr if the entity lacks it
+         */
+        void* TryGetRaw(EntityID entity, ComponentType type) const
+        {
+            if (!Has(entity, type))
+            {
+                return nullptr;
+            }
+            const EntityLocation& location = m_Locations[GetEntityIndex(entity)];
+            return location.Owner->GetComponent(type, location.Row);
+        }
+
+        /**
+         * @brief Iterate all entities that have every listed component
+         * @tparam Ts Component types, in the order passed to the callback
+         * @param types Component type IDs matching Ts
+         * @param func Callable invoked as func(EntityID, Ts&...)
+         *
+         * The callback must not add or remove components; that would move
+         * rows while the blocks are being walked.
+         */
+        template<typename... Ts, typename Func>
+        void ForEach(const std::array<ComponentType, sizeof...(Ts)>& types, Func&& func);
+
+        /**
+         * @brief Get the number of archetypes created so far
+         */
+        std::size_t GetArchetypeCount() const { return m_ArchetypeList.size(); }
+
+        /**
+         * @brief Get all archetypes (for debugging and statistics)
+         */
+        const std::vector<Archetype*>& GetArchetypes() const { return m_ArchetypeList; }
+
+        /**
+         * @brief Destroy all entities and archetypes
+         */
+        void Reset()
+        {
+            m_Locations.clear();
+            m_ArchetypeList.clear();
+            m_Archetypes.clear();
+        }
+
+    private:
+        struct EntityLocation
+        {
+            Archetype* Owner = nullptr;
+            std::size_t Row = 0;
+        };
+
+        const Archetype* GetArchetypeOf(EntityID entity) const
+        {
+            const std::uint32_t index = GetEntityIndex(entity);
+            if (index >= m_Locations.size() || !m_Locations[index].Owner)
+            {
+                return nullptr;
+            }
+
+            // A stale handle shares the slot index but not the stored ID
+            const EntityLocation& location = m_Locations[index];
+            return location.Owner->GetEntity(location.Row) == entity ? location.Owner : nullptr;
+        }
+
+        EntityLocation& GetLocation(EntityID entity)
+        {
+            const std::uint32_t index = GetEntityIndex(entity);
+            if (index >= m_Locations.size())
+            {
+                m_Locations.resize(static_cast<std::size_t>(index) + 1);
+            }
+            return m_Locations[index];
+        }
+
+        Archetype* GetOrCreateArchetype(const Signature& signature);
+
+        /**
+         * @brief Move an entity to the archetype for a new signature
+         * @return The entity's new location
+         */
+        EntityLocation& MoveEntity(EntityID entity, const Signature& newSignature);
+
+        template<typename... Ts, typename Func, std::size_t... Is>
+        void ForEachInArchetype(Archetype& archetype, const std::array<ComponentType, sizeof...(Ts)>& types,
+                                Func& func, std::index_sequence<Is...>);
+
+        ComponentTypeInfoTable m_TypeInfos;
+        std::vector<EntityLocation> m_Locations;   ///< Indexed by entity slot index
+        std::unordered_map<Signature, std::unique_ptr<Archetype>> m_Archetypes;
+        std::vector<Archetype*> m_ArchetypeList;  ///< Creation order, for iteration
+    };
+
+    // ============================================================================
+    // Archetype Implementation
+    // ============================================================================
+
+    inline Archetype::Archetype(const Signature& signature, const ComponentTypeInfoTable& typeInfos)
+        : m_Signature(signature)
+        , m_TypeInfos(typeInfos)
+    {
+        std::size_t rowBytes = sizeof(EntityID);
+        std::size_t alignmentSlack = 0;
+
+        for (std::size_t type = 0; type < MAX_COMPONENTS; ++type)
+        {
+            if (m_Signature.test(type))
+            {
+                assert(m_TypeInfos[type].IsValid() && "Component not registered before use");
+                m_Types.push_back(static_cast<ComponentType>(type));
+                rowBytes += m_TypeInfos[type].Size;
+                alignmentSlack += m_TypeInfos[type].Alignment;
+            }
+        }
+
+        if (ARCHETYPE_BLOCK_BYTES > alignmentSlack + rowBytes)
+        {
+            m_BlockCapacity = (ARCHETYPE_BLOCK_BYTES - alignmentSlack) / rowBytes;
+        }
+
+        // Lay out columns: entity IDs first, then each component column aligned
+        std::size_t offset = sizeof(EntityID) * m_BlockCapacity;
+        for (ComponentType type : m_Types)
+        {
+            const std::size_t alignment = m_TypeInfos[type].Alignment;
+            offset = (offset + alignment - 1) / alignment * alignment;
+            m_ColumnOffsets[type] = offset;
+            offset += m_TypeInfos[type].Size * m_BlockCapacity;
+        }
+
+        m_BlockBytes = offset;
+    }
+
+    inline Archetype::~Archetype()
+    {
+        for (std::size_t row = 0; row < m_Count; ++row)
+        {
+            for (ComponentType type : m_Types)
+            {
+                m_TypeInfos[type].Destroy(RowAddress(type, row));
+            }
+        }
+    }
+
+    inline std::size_t Archetype::AllocateRow(EntityID entity)
+    {
+        if (m_Count == m_Blocks.size() * m_BlockCapacity)
+        {
+            auto* memory = static_cast<std::uint8_t*>(
+                ::operator new(m_BlockBytes, std::align_val_t(ARCHETYPE_BLOCK_ALIGNMENT)));
+            m_Blocks.emplace_back(memory);
+        }
+
+        std::size_t row = m_Count++;
+        EntityAt(row) = entity;
+        return row;
+    }
+
+    inline std::size_t Archetype::AllocateRows(const EntityID* entities, std::size_t count)
+    {
+        const std::size_t firstRow = m_Count;
+        const std::size_t requiredBlocks = (m_Count + count + m_BlockCapacity - 1) / m_BlockCapacity;
+
+        m_Blocks.reserve(requiredBlocks);
+        while (m_Blocks.size() < requiredBlocks)
+        {
+            auto* memory = static_cast<std::uint8_t*>(
+                ::operator new(m_BlockBytes, std::align_val_t(ARCHETYPE_BLOCK_ALIGNMENT)));
+            m_Blocks.emplace_back(memory);
+        }
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            EntityAt(firstRow + i) = entities[i];
+        }
+
+        m_Count += count;
+        return firstRow;
+    }
+
+    inline EntityID Archetype::RemoveRow(std::size_t row)
+    {
+        assert(row < m_Count && "Row out of range");
+
+        for (ComponentType type : m_Types)
+        {
+            m_TypeInfos[type].Destroy(RowAddress(type, row));
+        }
+
+        return CompactRow(row);
+    }
+
+    inline EntityID Archetype::MigrateRow(std::size_t row, Archetype& destination, std::size_t destinationRow)
+    {
+        assert(row < m_Count && "Row out of range");
+
+        for (ComponentType type : m_Types)
+        {
+            void* source = RowAddress(type, row);
+            if (destination.m_Signature.test(type))
+            {
+                m_TypeInfos[type].MoveConstruct(destination.RowAddress(type, destinationRow), source);
+            }
+            m_TypeInfos[type].Destroy(source);
+        }
+
+        return CompactRow(row);
+    }
+
+    inline EntityID Archetype::CompactRow(std::size_t row)
+    {
+        std::size_t lastRow = m_Count - 1;
+        EntityID movedEntity = INVALID_ENTITY;
+
+        if (row != lastRow)
+        {
+            for (ComponentType type : m_Types)
+            {
+                void* last = RowAddress(type, lastRow);
+                m_TypeInfos[type].MoveConstruct(RowAddress(type, row), last);
+                m_TypeInfos[type].Destroy(last);
+            }
+
+            movedEntity = EntityAt(lastRow);
+            EntityAt(row) = movedEntity;
+        }
+
+        --m_Count;
+
+        // Keep at most one spare block to avoid thrashing at block boundaries
+        while (m_Blocks.size() > 1 && m_Count + 2 * m_BlockCapacity <= m_Blocks.size() * m_BlockCapacity)
+        {
+            m_Blocks.pop_back();
+        }
+
+        return movedEntity;
+    }
+
+    // ============================================================================
+    // ArchetypeStorage Implementation
+    // ============================================================================
+
+    template<typename T>
+    void ArchetypeStorage::Add(EntityID entity, ComponentType type, T component)
+    {
+        assert(m_TypeInfos[type].IsValid() && "Component not registered before use");
+        assert(!Has(entity, type) && "Component added to same entity more than once");
+
+        Signature signature = GetArchetypeOf(entity) ? GetArchetypeOf(entity)->GetSignature() : Signature();
+        signature.set(type, true);
+
+        EntityLocation& location = MoveEntity(entity, signature);
+        new (location.Owner->GetComponent(type, location.Row)) T(std::move(component));
+    }
+
+    inline Archetype& ArchetypeStorage::AddEntities(const EntityID* entities, std::size_t count,
+                                                    const Signature& signature, std::size_t& outFirstRow)
+    {
+        Archetype* archetype = GetOrCreateArchetype(signature);
+        outFirstRow = archetype->AllocateRows(entities, count);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            assert(!GetArchetypeOf(entities[i]) && "Entity already owns components");
+
+            EntityLocation& location = GetLocation(entities[i]);
+            location.Owner = archetype;
+            location.Row = outFirstRow + i;
+        }
+
+        return *archetype;
+    }
+
+    inline void ArchetypeStorage::Remove(EntityID entity, ComponentType type)
+    {
+        if (!Has(entity, type))
+        {
+            return; // Entity doesn't have this component
+        }
+
+        Signature signature = m_Locations[GetEntityIndex(entity)].Owner->GetSignature();
+        signature.set(type, false);
+
+        if (signature.none())
+        {
+            EntityDestroyed(entity);
+            return;
+        }
+
+        MoveEntity(entity, signature);
+    }
+
+    inline void ArchetypeStorage::EntityDestroyed(EntityID entity)
+    {
+        if (!GetArchetypeOf(entity))
+        {
+            return;
+        }
+
+        EntityLocation& location = m_Locations[GetEntityIndex(entity)];
+        EntityID moved = location.Owner->RemoveRow(location.Row);
+        if (moved != INVALID_ENTITY)
+        {
+            m_Locations[GetEntityIndex(moved)].Row = location.Row;
+        }
+
+        location = EntityLocation{};
+    }
+
+    inline Archetype* ArchetypeStorage::GetOrCreateArchetype(const Signature& signature)
+    {
+        auto it = m_Archetypes.find(signature);
+        if (it != m_Archetypes.end())
+        {
+            return it->second.get();
+        }
+
+        auto archetype = std::make_unique<Archetype>(signature, m_TypeInfos);
+        Archetype* rawPtr = archetype.get();
+        m_Archetypes.emplace(signature, std::move(archetype));
+        m_ArchetypeList.push_back(rawPtr);
+        return rawPtr;
+    }
+
+    inline ArchetypeStorage::EntityLocation& ArchetypeStorage::MoveEntity(EntityID entity, const Signature& newSignature)
+    {
+        EntityLocation& location = GetLocation(entity);
+        Archetype* destination = GetOrCreateArchetype(newSignature);
+        std::size_t destinationRow = destination->AllocateRow(entity);
+
+        if (location.Owner)
+        {
+            EntityID moved = location.Owner->MigrateRow(location.Row, *destination, destinationRow);
+            if (moved != INVALID_ENTITY)
+            {
+                m_Locations[GetEntityIndex(moved)].Row = location.Row;
+            }
+        }
+
+        location.Owner = destination;
+        location.Row = destinationRow;
+        return location;
+    }
+
+    template<typename... Ts, typename Func>
+    void ArchetypeStorage::ForEach(const std::array<ComponentType, sizeof...(Ts)>& types, Func&& func)
+    {
+        Signature required;
+        for (ComponentType type : types)
+        {
+            required.set(type, true);
+        }
+
+        for (Archetype* archetype : m_ArchetypeList)
+        {
+            if (archetype->Size() == 0 || (archetype->GetSignature() & required) != required)
+            {
+                continue;
+            }
+
+            ForEachInArchetype<Ts...>(*archetype, types, func, std::index_sequence_for<Ts...>{});
+        }
+    }
+
+    template<typename... Ts, typename Func, std::size_t... Is>
+    void ArchetypeStorage::ForEachInArchetype(Archetype& archetype, const std::array<ComponentType, sizeof...(Ts)>& types,
+                                              Func& func, std::index_sequence<Is...>)
+    {
+        for (std::size_t block = 0; block < archetype.GetBlockCount(); ++block)
+        {
+            const std::size_t count = archetype.GetBlockEntityCount(block);
+            const EntityID* entities = archetype.GetBlockEntities(block);
+            auto columns = std::make_tuple(archetype.GetBlockColumn<Ts>(types[Is], block)...);
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                func(entities[i], std::get<Is>(columns)[i]...);
+            }
+        }
+    }
+
+} // namespace SM
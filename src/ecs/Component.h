@@ -12,8 +12,12 @@
 
 #include <array>
 #include <unordered_map>
+#include <vector>
 #include <cassert>
+#include <cstring>
+#include <iterator>
 #include <optional>
+#include <type_traits>
 
 namespace SM
 {
@@ -51,6 +55,11 @@ namespace SM
          * @return The component count
          */
         virtual std::size_t Size() const = 0;
+
+        /**
+         * @brief Remove every component
+         */
+        virtual void Clear() = 0;
     };
 
     // ============================================================================
@@ -93,6 +102,36 @@ namespace SM
          */
         void InsertData(EntityID entity, T component);
 
+        /**
+         * @brief Add components to many entities, moving from an array
+         * @param entities Entities without this component
+         * @param count Number of entities
+         * @param components One component per entity (moved from)
+         */
+        void InsertBatch(const EntityID* entities, std::size_t count, T* components);
+
+        /**
+         * @brief Add a copy of one component to many entities
+         * @param entities Entities without this component
+         * @param count Number of entities
+         * @param component Value copied to every entity
+         */
+        void InsertCopies(const EntityID* entities, std::size_t count, const T& component);
+
+        /**
+         * @brief Reserve room for additional components
+         * @param additional Number of components about to be inserted
+         */
+        void Reserve(std::size_t additional);
+
+        /**
+         * @brief Add components to many entities from raw bytes (trivially copyable T only)
+         * @param entities Entities without this component
+         * @param count Number of entities
+         * @param bytes count * sizeof(T) bytes, any alignment
+         */
+        void InsertRaw(const EntityID* entities, std::size_t count, const void* bytes);
+
         /**
          * @brief Remove a component from an entity
          * @param entity The entity to remove the component from
@@ -146,6 +185,17 @@ namespace SM
          */
         std::size_t Size() const override { return m_Size; }
 
+        /**
+         * @brief Remove every component
+         */
+        void Clear() override
+        {
+            m_ComponentArray.clear();
+            m_EntityToIndex.clear();
+            m_IndexToEntity.clear();
+            m_Size = 0;
+        }
+
         /**
          * @brief Get raw access to the component array
          * @return Pointer to the first component
@@ -166,15 +216,20 @@ namespace SM
             return m_IndexToEntity[index];
         }
 
+        /**
+         * @brief Get the owner of every packed component (parallel to Data())
+         */
+        const EntityID* GetEntities() const { return m_IndexToEntity.data(); }
+
     private:
-        /** Packed array of components (contiguous memory) */
-        std::array<T, MAX_ENTITIES> m_ComponentArray;
+        /** Packed array of components (contiguous memory, grows on demand) */
+        std::vector<T> m_ComponentArray;
 
         /** Map from entity ID to array index (sparse array) */
         std::unordered_map<EntityID, std::size_t> m_EntityToIndex;
 
         /** Map from array index to entity ID (for swapping on removal) */
-        std::array<EntityID, MAX_ENTITIES> m_IndexToEntity;
+        std::vector<EntityID> m_IndexToEntity;
 
         /** Current number of valid entries */
         std::size_t m_Size = 0;
@@ -189,16 +244,79 @@ namespace SM
     {
         assert(m_EntityToIndex.find(entity) == m_EntityToIndex.end() &&
                "Component added to same entity more than once");
-        assert(m_Size < MAX_ENTITIES && "Component array full");
 
         // Put new entry at end of array
         std::size_t newIndex = m_Size;
         m_EntityToIndex[entity] = newIndex;
-        m_IndexToEntity[newIndex] = entity;
-        m_ComponentArray[newIndex] = std::move(component);
+        m_IndexToEntity.push_back(entity);
+        m_ComponentArray.push_back(std::move(component));
         ++m_Size;
     }
 
+    template<typename T>
+    void ComponentArray<T>::InsertBatch(const EntityID* entities, std::size_t count, T* components)
+    {
+        Reserve(count);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            assert(m_EntityToIndex.find(entities[i]) == m_EntityToIndex.end() &&
+                   "Component added to same entity more than once");
+            m_EntityToIndex.emplace(entities[i], m_Size + i);
+        }
+
+        m_IndexToEntity.insert(m_IndexToEntity.end(), entities, entities + count);
+        m_ComponentArray.insert(m_ComponentArray.end(),
+                                std::make_move_iterator(components),
+                                std::make_move_iterator(components + count));
+        m_Size += count;
+    }
+
+    template<typename T>
+    void ComponentArray<T>::InsertCopies(const EntityID* entities, std::size_t count, const T& component)
+    {
+        Reserve(count);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            assert(m_EntityToIndex.find(entities[i]) == m_EntityToIndex.end() &&
+                   "Component added to same entity more than once");
+            m_EntityToIndex.emplace(entities[i], m_Size + i);
+        }
+
+        m_IndexToEntity.insert(m_IndexToEntity.end(), entities, entities + count);
+        m_ComponentArray.insert(m_ComponentArray.end(), count, component);
+        m_Size += count;
+    }
+
+    template<typename T>
+    void ComponentArray<T>::InsertRaw(const EntityID* entities, std::size_t count, const void* bytes)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "InsertRaw needs a trivially copyable type");
+
+        Reserve(count);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            assert(m_EntityToIndex.find(entities[i]) == m_EntityToIndex.end() &&
+                   "Component added to same entity more than once");
+            m_EntityToIndex.emplace(entities[i], m_Size + i);
+        }
+
+        m_IndexToEntity.insert(m_IndexToEntity.end(), entities, entities + count);
+        m_ComponentArray.resize(m_Size + count);
+        std::memcpy(m_ComponentArray.data() + m_Size, bytes, count * sizeof(T));
+        m_Size += count;
+    }
+
+    template<typename T>
+    void ComponentArray<T>::Reserve(std::size_t additional)
+    {
+        m_EntityToIndex.reserve(m_Size + additional);
+        m_IndexToEntity.reserve(m_Size + additional);
+        m_ComponentArray.reserve(m_Size + additional);
+    }
+
     template<typename T>
     void ComponentArray<T>::RemoveData(EntityID entity)
     {
@@ -225,6 +343,8 @@ namespace SM
 
         // Remove the entity from the map and shrink
         m_EntityToIndex.erase(entity);
+        m_ComponentArray.pop_back();
+        m_IndexToEntity.pop_back();
         --m_Size;
     }
 
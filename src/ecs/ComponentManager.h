@@ -9,10 +9,14 @@
  */
 
 #include "Component.h"
+#include "Archetype.h"
+#include "ComponentSerializer.h"
+#include "components/Components.h"
 
+#include <array>
 #include <memory>
-#include <unordered_map>
-#include <typeindex>
+#include <typeinfo>
+#include <type_traits>
 #include <string>
 
 namespace SM
@@ -22,9 +26,10 @@ namespace SM
     // ============================================================================
 
     /**
-     * @brief Compile-time counter for generating unique component type IDs
+     * @brief Unique component type IDs
      *
-     * Each component type gets a unique ID at runtime, starting from 0.
+     * Types in RegisteredComponents use their list index, known at compile
+     * time. Any other type gets the next free ID after them on first use.
      */
     class ComponentTypeCounter
     {
@@ -37,12 +42,75 @@ namespace SM
         template<typename T>
         static ComponentType GetID()
         {
-            static ComponentType id = s_NextID++;
-            return id;
+            if constexpr (RegisteredComponents::Contains<T>)
+            {
+                return RegisteredComponents::IndexOf<T>();
+            }
+            else
+            {
+                static ComponentType id = s_NextID++;
+                assert(id < MAX_COMPONENTS && "Too many component types");
+                return id;
+            }
         }
 
     private:
-        static inline ComponentType s_NextID = 0;
+        static inline ComponentType s_NextID = static_cast<ComponentType>(RegisteredComponents::Size);
+    };
+
+    /**
+     * @brief Compile-time ID of a component in RegisteredComponents
+     */
+    template<typename T>
+    inline constexpr ComponentType STATIC_COMPONENT_TYPE = RegisteredComponents::IndexOf<T>();
+
+    // ============================================================================
+    // ComponentStorageMode
+    // ============================================================================
+
+    /**
+     * @brief Backend used to store component data
+     */
+    enum class ComponentStorageMode : std::uint8_t
+    {
+        Sparse,     ///< One packed ComponentArray<T> per component type
+        Archetype   ///< Entities grouped by signature in chunked SoA blocks
+    };
+
+    class ComponentManager;
+
+    // ============================================================================
+    // ComponentSnapshotOps
+    // ============================================================================
+
+    /**
+     * @brief Type-erased snapshot operations for one registered component type
+     *
+     * Built by RegisterComponent. A snapshot section is the component's
+     * owners followed by a payload: the packed array memcpy'd as one block
+     * for trivially copyable types, or ComponentSerializer<T>::Write per
+     * component otherwise.
+     */
+    struct ComponentSnapshotOps
+    {
+        const char* Name = nullptr;     ///< typeid(T).name(); stable for one compiler, not across
+        std::uint32_t Size = 0;         ///< sizeof(T)
+        bool Raw = false;               ///< Payload is raw bytes
+        bool Serializable = false;      ///< Raw, or has a ComponentSerializer
+
+        /// Write the owner count, owner IDs and payload of every stored component
+        void (*Save)(const ComponentManager& components, ComponentType type, SnapshotWriter& writer) = nullptr;
+
+        /// Store components for the owners from a payload; in Archetype mode the
+        /// entities must already be placed with their components constructed
+        bool (*Load)(ComponentManager& components, ComponentType type, const EntityID* entities,
+                     std::size_t count, SnapshotReader& payload) = nullptr;
+
+        /// Default-construct a component in raw archetype memory
+        void (*Construct)(void* memory) = nullptr;
+
+        template<typename T>
+        static ComponentSnapshotOps Of();
     };
 
     // ============================================================================
@@ -61,7 +129,15 @@ namespace SM
     class ComponentManager
     {
     public:
-        ComponentManager() = default;
+        /**
+         * @brief Construct a component manager
+         * @param storageMode Backend used for component data
+         */
+        explicit ComponentManager(ComponentStorageMode storageMode = ComponentStorageMode::Sparse)
+            : m_StorageMode(storageMode)
+        {
+        }
+
         ~ComponentManager() = default;
 
         // Prevent copying
@@ -99,6 +175,20 @@ namespace SM
         template<typename T>
         void AddComponent(EntityID entity, T component);
 
+        /**
+         * @brief Give many component-less entities the same set of component types
+         * @tparam Ts The component types (distinct)
+         * @param entities Entities that own no components yet
+         * @param count Number of entities
+         * @param components One array per type with count elements (moved from)
+         *
+         * Sparse mode appends to each ComponentArray in one go; Archetype
+         * mode places the entities straight into their final archetype
+         * instead of migrating them once per component.
+         */
+        template<typename... Ts>
+        void AddComponentBatch(const EntityID* entities, std::size_t count, Ts*... components);
+
         /**
          * @brief Remove a component from an entity
          * @tparam T The component type
@@ -158,10 +248,23 @@ namespace SM
          */
         void EntityDestroyed(EntityID entity);
 
+        /**
+         * @brief Get the active storage backend
+         */
+        ComponentStorageMode GetStorageMode() const { return m_StorageMode; }
+
+        /**
+         * @brief Get the archetype storage (only populated in Archetype mode)
+         */
+        ArchetypeStorage& GetArchetypeStorage() { return m_ArchetypeStorage; }
+        const ArchetypeStorage& GetArchetypeStorage() const { return m_ArchetypeStorage; }
+
         /**
          * @brief Get the component array for a specific type
          * @tparam T The component type
          * @return Pointer to the component array
+         *
+         * Only available in Sparse mode; Archetype mode has no per-type arrays.
          */
         template<typename T>
         ComponentArray<T>* GetComponentArray();
@@ -182,17 +285,40 @@ namespace SM
         template<typename T>
         bool IsComponentRegistered() const;
 
+        /**
+         * @brief Get the snapshot operations of a registered component type
+         * @return nullptr if the type is not registered
+         */
+        const ComponentSnapshotOps* GetSnapshotOps(ComponentType type) const
+        {
+            return m_SnapshotOps[type].Save ? &m_SnapshotOps[type] : nullptr;
+        }
+
+        /**
+         * @brief Remove every component but keep the registered types
+         */
+        void ClearData();
+
         /**
          * @brief Reset the component manager, clearing all data
          */
         void Reset();
 
     private:
-        /** Map from type index to component arrays */
-        std::unordered_map<std::type_index, std::shared_ptr<IComponentArray>> m_ComponentArrays;
+        /** Active storage backend */
+        ComponentStorageMode m_StorageMode = ComponentStorageMode::Sparse;
+
+        /** Archetype backend (used in Archetype mode) */
+        ArchetypeStorage m_ArchetypeStorage;
 
-        /** Map from type index to component type IDs */
-        std::unordered_map<std::type_index, ComponentType> m_ComponentTypes;
+        /** Component arrays, indexed by component type ID (used in Sparse mode) */
+        std::array<std::unique_ptr<IComponentArray>, MAX_COMPONENTS> m_ComponentArrays{};
+
+        /** Component type IDs registered with this manager */
+        Signature m_RegisteredTypes;
+
+        /** Snapshot operations, indexed by component type ID */
+        std::array<ComponentSnapshotOps, MAX_COMPONENTS> m_SnapshotOps{};
     };
 
     // ============================================================================
@@ -202,56 +328,122 @@ namespace SM
     template<typename T>
     void ComponentManager::RegisterComponent()
     {
-        std::type_index typeIndex = std::type_index(typeid(T));
+        const ComponentType type = ComponentTypeCounter::GetID<T>();
 
-        assert(m_ComponentArrays.find(typeIndex) == m_ComponentArrays.end() &&
-               "Component type already registered");
+        assert(!m_RegisteredTypes.test(type) && "Component type already registered");
 
-        // Store the component type ID
-        m_ComponentTypes[typeIndex] = ComponentTypeCounter::GetID<T>();
+        m_RegisteredTypes.set(type);
+        m_SnapshotOps[type] = ComponentSnapshotOps::Of<T>();
+
+        if (m_StorageMode == ComponentStorageMode::Archetype)
+        {
+            m_ArchetypeStorage.RegisterType<T>(type);
+            return;
+        }
 
         // Create a new component array
-        m_ComponentArrays[typeIndex] = std::make_shared<ComponentArray<T>>();
+        m_ComponentArrays[type] = std::make_unique<ComponentArray<T>>();
     }
 
     template<typename T>
     ComponentType ComponentManager::GetComponentType() const
     {
-        std::type_index typeIndex = std::type_index(typeid(T));
+        const ComponentType type = ComponentTypeCounter::GetID<T>();
+        assert(m_RegisteredTypes.test(type) && "Component not registered before use");
 
-        auto it = m_ComponentTypes.find(typeIndex);
-        assert(it != m_ComponentTypes.end() && "Component not registered before use");
-
-        return it->second;
+        return type;
     }
 
     template<typename T>
     void ComponentManager::AddComponent(EntityID entity, T component)
     {
+        if (m_StorageMode == ComponentStorageMode::Archetype)
+        {
+            m_ArchetypeStorage.Add<T>(entity, GetComponentType<T>(), std::move(component));
+            return;
+        }
+
         GetComponentArray<T>()->InsertData(entity, std::move(component));
     }
 
+    template<typename... Ts>
+    void ComponentManager::AddComponentBatch(const EntityID* entities, std::size_t count, Ts*... components)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        if (m_StorageMode == ComponentStorageMode::Archetype)
+        {
+            Signature signature;
+            (signature.set(GetComponentType<Ts>(), true), ...);
+
+            std::size_t firstRow = 0;
+            Archetype& archetype = m_ArchetypeStorage.AddEntities(entities, count, signature, firstRow);
+
+            auto construct = [&](ComponentType type, auto* source) {
+                using T = std::remove_pointer_t<decltype(source)>;
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    new (archetype.GetComponent(type, firstRow + i)) T(std::move(source[i]));
+                }
+            };
+            (construct(GetComponentType<Ts>(), components), ...);
+            return;
+        }
+
+        (GetComponentArray<Ts>()->InsertBatch(entities, count, components), ...);
+    }
+
     template<typename T>
     void ComponentManager::RemoveComponent(EntityID entity)
     {
+        if (m_StorageMode == ComponentStorageMode::Archetype)
+        {
+            m_ArchetypeStorage.Remove(entity, GetComponentType<T>());
+            return;
+        }
+
         GetComponentArray<T>()->RemoveData(entity);
     }
 
     template<typename T>
     T& ComponentManager::GetComponent(EntityID entity)
     {
+        if (m_StorageMode == ComponentStorageMode::Archetype)
+        {
+            T* component = m_ArchetypeStorage.TryGet<T>(entity, GetComponentType<T>());
+            assert(component && "Retrieving non-existent component");
+            return *component;
+        }
+
         return GetComponentArray<T>()->GetData(entity);
     }
 
     template<typename T>
     const T& ComponentManager::GetComponent(EntityID entity) const
     {
+        if (m_StorageMode == ComponentStorageMode::Archetype)
+        {
+            const T* component = m_ArchetypeStorage.TryGet<T>(entity, GetComponentType<T>());
+            assert(component && "Retrieving non-existent component");
+            return *component;
+        }
+
         return GetComponentArray<T>()->GetData(entity);
     }
 
     template<typename T>
     T* ComponentManager::TryGetComponent(EntityID entity)
     {
+        if (m_StorageMode == ComponentStorageMode::Archetype)
+        {
+            return IsComponentRegistered<T>()
+                ? m_ArchetypeStorage.TryGet<T>(entity, GetComponentType<T>())
+                : nullptr;
+        }
+
         auto* array = GetComponentArray<T>();
         return array ? array->TryGetData(entity) : nullptr;
     }
@@ -259,6 +451,13 @@ namespace SM
     template<typename T>
     const T* ComponentManager::TryGetComponent(EntityID entity) const
     {
+        if (m_StorageMode == ComponentStorageMode::Archetype)
+        {
+            return IsComponentRegistered<T>()
+                ? m_ArchetypeStorage.TryGet<T>(entity, GetComponentType<T>())
+                : nullptr;
+        }
+
         const auto* array = GetComponentArray<T>();
         return array ? array->TryGetData(entity) : nullptr;
     }
@@ -266,55 +465,232 @@ namespace SM
     template<typename T>
     bool ComponentManager::HasComponent(EntityID entity) const
     {
+        if (m_StorageMode == ComponentStorageMode::Archetype)
+        {
+            return IsComponentRegistered<T>() &&
+                   m_ArchetypeStorage.Has(entity, GetComponentType<T>());
+        }
+
         const auto* array = GetComponentArray<T>();
         return array && array->HasData(entity);
     }
 
     inline void ComponentManager::EntityDestroyed(EntityID entity)
     {
+        if (m_StorageMode == ComponentStorageMode::Archetype)
+        {
+            m_ArchetypeStorage.EntityDestroyed(entity);
+            return;
+        }
+
         // Notify each component array that an entity has been destroyed
-        for (auto& [typeIndex, componentArray] : m_ComponentArrays)
+        for (auto& componentArray : m_ComponentArrays)
         {
-            componentArray->EntityDestroyed(entity);
+            if (componentArray)
+            {
+                componentArray->EntityDestroyed(entity);
+            }
         }
     }
 
     template<typename T>
     ComponentArray<T>* ComponentManager::GetComponentArray()
     {
-        std::type_index typeIndex = std::type_index(typeid(T));
+        assert(m_StorageMode == ComponentStorageMode::Sparse &&
+               "Component arrays only exist in Sparse storage mode");
 
-        auto it = m_ComponentArrays.find(typeIndex);
-        assert(it != m_ComponentArrays.end() && "Component not registered before use");
+        IComponentArray* array = m_ComponentArrays[ComponentTypeCounter::GetID<T>()].get();
+        assert(array && "Component not registered before use");
 
-        return static_cast<ComponentArray<T>*>(it->second.get());
+        return static_cast<ComponentArray<T>*>(array);
     }
 
     template<typename T>
     const ComponentArray<T>* ComponentManager::GetComponentArray() const
     {
-        std::type_index typeIndex = std::type_index(typeid(T));
-
-        auto it = m_ComponentArrays.find(typeIndex);
-        if (it == m_ComponentArrays.end())
-        {
-            return nullptr;
-        }
-
-        return static_cast<const ComponentArray<T>*>(it->second.get());
+        return static_cast<const ComponentArray<T>*>(m_ComponentArrays[ComponentTypeCounter::GetID<T>()].get());
     }
 
     template<typename T>
     bool ComponentManager::IsComponentRegistered() const
     {
-        std::type_index typeIndex = std::type_index(typeid(T));
-        return m_ComponentArrays.find(typeIndex) != m_ComponentArrays.end();
+        return m_RegisteredTypes.test(ComponentTypeCounter::GetID<T>());
+    }
+
+    inline void ComponentManager::ClearData()
+    {
+        m_ArchetypeStorage.Reset();
+        for (auto& componentArray : m_ComponentArrays)
+        {
+            if (componentArray)
+            {
+                componentArray->Clear();
+            }
+        }
     }
 
     inline void ComponentManager::Reset()
     {
-        m_ComponentArrays.clear();
-        m_ComponentTypes.clear();
+        m_ArchetypeStorage.Reset();
+        for (auto& componentArray : m_ComponentArrays)
+        {
+            componentArray.reset();
+        }
+        m_RegisteredTypes.reset();
+        m_SnapshotOps = {};
+    }
+
+    // ============================================================================
+    // ComponentSnapshotOps Implementation
+    // ============================================================================
+
+    template<typename T>
+    ComponentSnapshotOps ComponentSnapshotOps::Of()
+    {
+        constexpr bool raw = std::is_trivially_copyable_v<T> && !HasComponentSerializer<T>;
+
+        ComponentSnapshotOps ops;
+        ops.Name = typeid(T).name();
+        ops.Size = static_cast<std::uint32_t>(sizeof(T));
+        ops.Raw = raw;
+        ops.Serializable = raw || HasComponentSerializer<T>;
+        ops.Construct = [](void* memory) { new (memory) T(); };
+
+        ops.Save = [](const ComponentManager& components, ComponentType type, SnapshotWriter& writer) {
+            auto writePayload = [&](const T* data, std::size_t count) {
+                if constexpr (raw)
+                {
+                    writer.Write(data, count * sizeof(T));
+                }
+                else if constexpr (HasComponentSerializer<T>)
+                {
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        ComponentSerializer<T>::Write(writer, data[i]);
+                    }
+                }
+            };
+
+            if (components.GetStorageMode() == ComponentStorageMode::Sparse)
+            {
+                const ComponentArray<T>* array = components.GetComponentArray<T>();
+                const std::size_t count = array->Size();
+
+                writer.WriteValue(static_cast<std::uint32_t>(count));
+                writer.Write(array->GetEntities(), count * sizeof(EntityID));
+
+                const std::size_t sizeOffset = writer.GetSize();
+                writer.WriteValue(std::uint64_t(0));
+                writePayload(array->Data(), count);
+                writer.Patch(sizeOffset, static_cast<std::uint64_t>(writer.GetSize() - sizeOffset - sizeof(std::uint64_t)));
+                return;
+            }
+
+            // Archetype mode: walk the columns block by block, owners first
+            const std::vector<Archetype*>& archetypes = components.GetArchetypeStorage().GetArchetypes();
+
+            std::size_t count = 0;
+            for (const Archetype* archetype : archetypes)
+            {
+                if (archetype->GetSignature().test(type))
+                {
+                    count += archetype->Size();
+                }
+            }
+
+            writer.WriteValue(static_cast<std::uint32_t>(count));
+            for (const Archetype* archetype : archetypes)
+            {
+                if (!archetype->GetSignature().test(type))
+                {
+                    continue;
+                }
+                for (std::size_t block = 0; block < archetype->GetBlockCount(); ++block)
+                {
+                    writer.Write(archetype->GetBlockEntities(block), archetype->GetBlockEntityCount(block) * sizeof(EntityID));
+                }
+            }
+
+            const std::size_t sizeOffset = writer.GetSize();
+            writer.WriteValue(std::uint64_t(0));
+            for (Archetype* archetype : archetypes)
+            {
+                if (!archetype->GetSignature().test(type))
+                {
+                    continue;
+                }
+                for (std::size_t block = 0; block < archetype->GetBlockCount(); ++block)
+                {
+                    writePayload(archetype->GetBlockColumn<T>(type, block), archetype->GetBlockEntityCount(block));
+                }
+            }
+            writer.Patch(sizeOffset, static_cast<std::uint64_t>(writer.GetSize() - sizeOffset - sizeof(std::uint64_t)));
+        };
+
+        ops.Load = [](ComponentManager& components, ComponentType type, const EntityID* entities,
+                      std::size_t count, SnapshotReader& payload) -> bool {
+            if (components.GetStorageMode() == ComponentStorageMode::Sparse)
+            {
+                ComponentArray<T>* array = components.GetComponentArray<T>();
+                if constexpr (raw)
+                {
+                    const std::uint8_t* bytes = payload.Skip(count * sizeof(T));
+                    if (!bytes)
+                    {
+                        return false;
+                    }
+                    array->InsertRaw(entities, count, bytes);
+                    return true;
+                }
+                else if constexpr (HasComponentSerializer<T>)
+                {
+                    array->Reserve(count);
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        T component{};
+                        if (!ComponentSerializer<T>::Read(payload, component))
+                        {
+                            return false;
+                        }
+                        array->InsertData(entities[i], std::move(component));
+                    }
+                    return true;
+                }
+                return false;
+            }
+
+            ArchetypeStorage& storage = components.GetArchetypeStorage();
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                void* memory = storage.TryGetRaw(entities[i], type);
+                if (!memory)
+                {
+                    return false;
+                }
+
+                if constexpr (raw)
+                {
+                    if (!payload.Read(memory, sizeof(T)))
+                    {
+                        return false;
+                    }
+                }
+                else if constexpr (HasComponentSerializer<T>)
+                {
+                    if (!ComponentSerializer<T>::Read(payload, *static_cast<T*>(memory)))
+                    {
+                        return false;
+                    }
+                }
+                else
+                {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        return ops;
     }
 
 } // namespace SM
@@ -0,0 +1,209 @@
+#pragma once
+
+/**
+ * @file ComponentSerializer.h
+ * @brief Byte streams and per-component serializer hooks for world snapshots
+ *
+ * Trivially copyable components are written to a snapshot as one raw block
+ * per component type. Other components need a ComponentSerializer<T>
+ * specialization that writes and reads their fields; specialize it next to
+ * the component's definition so every translation unit sees it.
+ */
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace SM
+{
+    // ============================================================================
+    // SnapshotWriter Class
+    // ============================================================================
+
+    /**
+     * @brief Append-only byte stream (native byte order)
+     */
+    class SnapshotWriter
+    {
+    public:
+        /**
+         * @brief Append raw bytes
+         */
+        void Write(const void* data, std::size_t size)
+        {
+            const auto* bytes = static_cast<const std::uint8_t*>(data);
+            m_Data.insert(m_Data.end(), bytes, bytes + size);
+        }
+
+        /**
+         * @brief Append a trivially copyable value
+         */
+        template<typename T>
+        void WriteValue(const T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "WriteValue needs a trivially copyable type");
+            Write(&value, sizeof(T));
+        }
+
+        /**
+         * @brief Append a length-prefixed string
+         */
+        void WriteString(const std::string& value)
+        {
+            WriteValue(static_cast<std::uint32_t>(value.size()));
+            Write(value.data(), value.size());
+        }
+
+        /**
+         * @brief Overwrite a previously written value (for sizes known only later)
+         * @param offset Byte offset returned by GetSize before the value was written
+         */
+        template<typename T>
+        void Patch(std::size_t offset, const T& value)
+        {
+            std::memcpy(m_Data.data() + offset, &value, sizeof(T));
+        }
+
+        /**
+         * @brief Reserve capacity for upcoming writes
+         */
+        void Reserve(std::size_t bytes) { m_Data.reserve(m_Data.size() + bytes); }
+
+        std::size_t GetSize() const { return m_Data.size(); }
+        const std::vector<std::uint8_t>& GetData() const { return m_Data; }
+        std::vector<std::uint8_t>& GetData() { return m_Data; }
+
+    private:
+        std::vector<std::uint8_t> m_Data;
+    };
+
+    // ============================================================================
+    // SnapshotReader Class
+    // ============================================================================
+
+    /**
+     * @brief Bounds-checked reader over a byte range (e.g. a mapped file)
+     *
+     * Reads past the end fail and latch an error flag instead of throwing,
+     * so a loader can read a whole record and check once.
+     */
+    class SnapshotReader
+    {
+    public:
+        SnapshotReader(const std::uint8_t* data, std::size_t size) : m_Data(data), m_Size(size) {}
+
+        /**
+         * @brief Copy bytes out of the stream
+         * @return false (and latch the error flag) if not enough bytes remain
+         */
+        bool Read(void* out, std::size_t size)
+        {
+            const std::uint8_t* bytes = Skip(size);
+            if (!bytes)
+            {
+                return false;
+            }
+            std::memcpy(out, bytes, size);
+            return true;
+        }
+
+        /**
+         * @brief Read a trivially copyable value
+         */
+        template<typename T>
+        bool ReadValue(T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "ReadValue needs a trivially copyable type");
+            return Read(&value, sizeof(T));
+        }
+
+        /**
+         * @brief Read a length-prefixed string
+         */
+        bool ReadString(std::string& value)
+        {
+            std::uint32_t length = 0;
+            if (!ReadValue(length))
+            {
+                return false;
+            }
+
+            const std::uint8_t* bytes = Skip(length);
+            if (!bytes)
+            {
+                return false;
+            }
+            value.assign(reinterpret_cast<const char*>(bytes), length);
+            return true;
+        }
+
+        /**
+         * @brief Advance past bytes without copying them
+         * @return Pointer to the skipped bytes (possibly unaligned), or nullptr on overrun
+         */
+        const std::uint8_t* Skip(std::size_t size)
+        {
+            if (m_Failed || size > m_Size - m_Offset)
+            {
+                m_Failed = true;
+                return nullptr;
+            }
+
+            const std::uint8_t* bytes = m_Data + m_Offset;
+            m_Offset += size;
+            return bytes;
+        }
+
+        bool HasFailed() const { return m_Failed; }
+        std::size_t GetOffset() const { return m_Offset; }
+        std::size_t GetRemaining() const { return m_Size - m_Offset; }
+
+    private:
+        const std::uint8_t* m_Data = nullptr;
+        std::size_t m_Size = 0;
+        std::size_t m_Offset = 0;
+        bool m_Failed = false;
+    };
+
+    // ============================================================================
+    // ComponentSerializer Trait
+    // ============================================================================
+
+    /**
+     * @brief Snapshot hook for a component type
+     *
+     * The primary template has no Write/Read: trivially copyable components
+     * are stored as raw bytes and other components are left out of
+     * snapshots. Specialize to give a component a typed serializer:
+     *
+     * @code
+     * template<>
+     * struct ComponentSerializer<MyComponent>
+     * {
+     *     static void Write(SnapshotWriter& writer, const MyComponent& component);
+     *     static bool Read(SnapshotReader& reader, MyComponent& component);
+     * };
+     * @endcode
+     *
+     * Read receives a default-constructed component.
+     */
+    template<typename T>
+    struct ComponentSerializer
+    {
+    };
+
+    /**
+     * @brief Check if a component type has a ComponentSerializer specialization
+     */
+    template<typename T>
+    concept HasComponentSerializer = requires(SnapshotWriter& writer, SnapshotReader& reader, const T& in, T& out)
+    {
+        ComponentSerializer<T>::Write(writer, in);
+        { ComponentSerializer<T>::Read(reader, out) } -> std::same_as<bool>;
+    };
+
+} // namespace SM
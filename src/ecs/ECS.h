@@ -9,10 +9,15 @@
 
 // Core ECS
 #include "Entity.h"
+#include "EntitySet.h"
 #include "Component.h"
+#include "Archetype.h"
 #include "ComponentManager.h"
 #include "System.h"
 #include "SystemManager.h"
+#include "Query.h"
+#include "EntityCommandBuffer.h"
+#include "EntityPrefab.h"
 #include "World.h"
 
 // Components
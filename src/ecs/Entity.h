@@ -6,13 +6,20 @@
  *
  * Entities are simple identifiers (IDs) that group components together.
  * The EntityManager handles creation, destruction, and lifecycle of entities.
+ *
+ * Entity IDs are generational handles: the low bits are a slot index and
+ * the high bits a version that is bumped whenever the slot is freed, so a
+ * stale ID never aliases a newer entity that reused the same slot.
  */
 
 #include <cstdint>
-#include <queue>
 #include <array>
 #include <bitset>
 #include <cassert>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
 
 namespace SM
 {
@@ -23,8 +30,8 @@ namespace SM
     /**
      * @brief Entity identifier type
      *
-     * Using uint32_t allows for over 4 billion entities, which is sufficient
-     * for most games while keeping memory usage reasonable.
+     * Packs a slot index (low ENTITY_INDEX_BITS) and a version (high bits)
+     * into 32 bits. Use GetEntityIndex/GetEntityVersion to unpack.
      */
     using EntityID = std::uint32_t;
 
@@ -35,10 +42,30 @@ namespace SM
      */
     using ComponentType = std::uint8_t;
 
+    /**
+     * @brief Number of bits used for the slot index in an EntityID
+     *
+     * 22 bits allow about 4 million live entities; the remaining 10 bits
+     * give 1024 generations per slot before the version wraps.
+     */
+    constexpr std::uint32_t ENTITY_INDEX_BITS = 22;
+    constexpr std::uint32_t ENTITY_VERSION_BITS = 32 - ENTITY_INDEX_BITS;
+    constexpr std::uint32_t ENTITY_INDEX_MASK = (1u << ENTITY_INDEX_BITS) - 1;
+    constexpr std::uint32_t ENTITY_VERSION_MASK = (1u << ENTITY_VERSION_BITS) - 1;
+
     /**
      * @brief Maximum number of entities that can exist simultaneously
+     *
+     * This is a ceiling on the index space, not a preallocated size:
+     * EntityManager storage grows in pages as entities are created.
+     * The all-ones index is reserved for INVALID_ENTITY.
+     */
+    constexpr EntityID MAX_ENTITIES = ENTITY_INDEX_MASK;
+
+    /**
+     * @brief Number of entity slots allocated at a time
      */
-    constexpr EntityID MAX_ENTITIES = 10000;
+    constexpr std::uint32_t ENTITY_PAGE_SIZE = 4096;
 
     /**
      * @brief Maximum number of unique component types
@@ -58,6 +85,56 @@ namespace SM
      */
     using Signature = std::bitset<MAX_COMPONENTS>;
 
+    /**
+     * @brief Compile-time list of component types
+     *
+     * A type's position in the list is its ComponentType, so IndexOf<T>()
+     * is a constant expression.
+     */
+    template<typename... Ts>
+    struct ComponentList
+    {
+        static constexpr std::size_t Size = sizeof...(Ts);
+
+        template<typename T>
+        static constexpr bool Contains = (std::is_same_v<T, Ts> || ...);
+
+        template<typename T>
+        static constexpr ComponentType IndexOf()
+        {
+            static_assert(Contains<T>, "Type is not in the component list");
+
+            // Counts the types before the first match
+            ComponentType index = 0;
+            (void)((std::is_same_v<T, Ts> ? false : (++index, true)) && ...);
+            return index;
+        }
+    };
+
+    /**
+     * @brief Get the slot index of an entity (use for dense/sparse arrays)
+     */
+    constexpr std::uint32_t GetEntityIndex(EntityID entity)
+    {
+        return entity & ENTITY_INDEX_MASK;
+    }
+
+    /**
+     * @brief Get the version of an entity
+     */
+    constexpr std::uint32_t GetEntityVersion(EntityID entity)
+    {
+        return entity >> ENTITY_INDEX_BITS;
+    }
+
+    /**
+     * @brief Build an entity ID from a slot index and version
+     */
+    constexpr EntityID MakeEntityID(std::uint32_t index, std::uint32_t version)
+    {
+        return ((version & ENTITY_VERSION_MASK) << ENTITY_INDEX_BITS) | (index & ENTITY_INDEX_MASK);
+    }
+
     // ============================================================================
     // EntityManager Class
     // ============================================================================
@@ -70,11 +147,15 @@ namespace SM
      * - Tracking which entities are alive
      * - Managing entity signatures (which components each entity has)
      * - Recycling destroyed entity IDs
+     *
+     * Slots live in fixed-size pages allocated on demand, and freed slots
+     * form an intrusive free list, so create and destroy are O(1) and memory
+     * follows the peak live count rather than MAX_ENTITIES.
      */
     class EntityManager
     {
     public:
-        EntityManager();
+        EntityManager() = default;
         ~EntityManager() = default;
 
         // Prevent copying
@@ -91,6 +172,15 @@ namespace SM
          */
         EntityID CreateEntity();
 
+        /**
+         * @brief Create many entities at once
+         * @param count Number of entities to create
+         * @param outEntities Receives the new IDs (at least count elements)
+         * @param signature Signature given to every new entity
+         * @return Number of entities created (less than count only when IDs run out)
+         */
+        std::uint32_t CreateEntities(std::uint32_t count, EntityID* outEntities, const Signature& signature = Signature());
+
         /**
          * @brief Destroy an entity and mark its ID for reuse
          * @param entity The entity to destroy
@@ -100,7 +190,7 @@ namespace SM
         /**
          * @brief Check if an entity is currently alive
          * @param entity The entity to check
-         * @return true if the entity exists and is alive
+         * @return true if the entity exists and its version is current
          */
         bool IsAlive(EntityID entity) const;
 
@@ -124,6 +214,66 @@ namespace SM
          */
         std::uint32_t GetLivingEntityCount() const { return m_LivingEntityCount; }
 
+        /**
+         * @brief Get the number of slots ever handed out (high-water mark)
+         */
+        std::uint32_t GetSlotCount() const { return m_SlotCount; }
+
+        /**
+         * @brief Invoke func(EntityID) for every living entity
+         *
+         * Walks slots up to the high-water mark. Destroying the visited
+         * entity from inside the callback is allowed.
+         */
+        template<typename Func>
+        void ForEachLivingEntity(Func&& func) const;
+
+        /**
+         * @brief Get every living entity, densely packed
+         *
+         * Creation order, except that destroying an entity moves the last
+         * one into its place. Invalidated by CreateEntity and DestroyEntity.
+         */
+        const std::vector<EntityID>& GetLivingEntities() const { return m_LiveEntities; }
+
+        /**
+         * @brief Get a counter bumped by every create, destroy and signature change
+         *
+         * Lets observers such as editor panels cache per-entity data and
+         * rebuild it only when the set of entities or their components changed.
+         */
+        std::uint64_t GetChangeVersion() const { return m_ChangeVersion; }
+
+        /**
+         * @brief Get the current version of a slot
+         * @param index Slot index below GetSlotCount()
+         */
+        std::uint32_t GetSlotVersion(std::uint32_t index) const
+        {
+            return PageOf(index).Versions[index % ENTITY_PAGE_SIZE];
+        }
+
+        /**
+         * @brief Check if a slot holds a living entity
+         * @param index Slot index below GetSlotCount()
+         */
+        bool IsSlotAlive(std::uint32_t index) const
+        {
+            return PageOf(index).Alive[index % ENTITY_PAGE_SIZE];
+        }
+
+        /**
+         * @brief Replace all entities with a saved slot table
+         * @param slotCount Number of slots to restore
+         * @param versions Version of each slot
+         * @param alive Non-zero for each slot that holds a living entity
+         *
+         * Living entities get back their exact IDs with empty signatures;
+         * dead slots go on the free list with their versions kept, so IDs
+         * that were stale when saved stay stale.
+         */
+        void RestoreSlots(std::uint32_t slotCount, const std::uint32_t* versions, const std::uint8_t* alive);
+
         /**
          * @brief Reset the EntityManager to initial state
          *
@@ -132,107 +282,255 @@ namespace SM
         void Reset();
 
     private:
-        /** Queue of available entity IDs for reuse */
-        std::queue<EntityID> m_AvailableEntities;
+        static constexpr std::uint32_t INVALID_INDEX = ENTITY_INDEX_MASK;
+
+        /** One page of entity slots */
+        struct EntityPage
+        {
+            std::array<Signature, ENTITY_PAGE_SIZE> Signatures;
+            std::array<std::uint32_t, ENTITY_PAGE_SIZE> Versions{};
+            std::array<std::uint32_t, ENTITY_PAGE_SIZE> NextFree{};
+            std::array<bool, ENTITY_PAGE_SIZE> Alive{};
+            std::array<std::uint32_t, ENTITY_PAGE_SIZE> LiveIndex{};   ///< Position in m_LiveEntities
+        };
 
-        /** Array tracking whether each entity ID is currently in use */
-        std::array<bool, MAX_ENTITIES> m_EntityAlive;
+        EntityPage& PageOf(std::uint32_t index) { return *m_Pages[index / ENTITY_PAGE_SIZE]; }
+        const EntityPage& PageOf(std::uint32_t index) const { return *m_Pages[index / ENTITY_PAGE_SIZE]; }
 
-        /** Array of component signatures indexed by entity ID */
-        std::array<Signature, MAX_ENTITIES> m_Signatures;
+        /** Allocated pages of slots */
+        std::vector<std::unique_ptr<EntityPage>> m_Pages;
+
+        /** Head of the free slot list (INVALID_INDEX when empty) */
+        std::uint32_t m_FreeHead = INVALID_INDEX;
+
+        /** Number of slots handed out so far */
+        std::uint32_t m_SlotCount = 0;
 
         /** Number of currently active entities */
         std::uint32_t m_LivingEntityCount = 0;
+
+        /** Living entities, densely packed */
+        std::vector<EntityID> m_LiveEntities;
+
+        /** Bumped on create, destroy and SetSignature */
+        std::uint64_t m_ChangeVersion = 0;
     };
 
     // ============================================================================
     // EntityManager Implementation (Inline)
     // ============================================================================
 
-    inline EntityManager::EntityManager()
+    inline EntityID EntityManager::CreateEntity()
     {
-        // Initialize the queue with all possible entity IDs
-        for (EntityID entity = 0; entity < MAX_ENTITIES; ++entity)
+        std::uint32_t index;
+
+        if (m_FreeHead != INVALID_INDEX)
         {
-            m_AvailableEntities.push(entity);
-            m_EntityAlive[entity] = false;
+            // Reuse the most recently freed slot
+            index = m_FreeHead;
+            m_FreeHead = PageOf(index).NextFree[index % ENTITY_PAGE_SIZE];
         }
-    }
-
-    inline EntityID EntityManager::CreateEntity()
-    {
-        if (m_LivingEntityCount >= MAX_ENTITIES)
+        else
         {
-            // No more entities available
-            return INVALID_ENTITY;
+            if (m_SlotCount >= MAX_ENTITIES)
+            {
+                // No more entities available
+                return INVALID_ENTITY;
+            }
+
+            index = m_SlotCount++;
+            if (index / ENTITY_PAGE_SIZE >= m_Pages.size())
+            {
+                m_Pages.push_back(std::make_unique<EntityPage>());
+            }
         }
 
-        // Get the next available ID from the queue
-        EntityID id = m_AvailableEntities.front();
-        m_AvailableEntities.pop();
-
         // Mark as alive and clear signature
-        m_EntityAlive[id] = true;
-        m_Signatures[id].reset();
+        EntityPage& page = PageOf(index);
+        const std::uint32_t slot = index % ENTITY_PAGE_SIZE;
+        page.Alive[slot] = true;
+        page.Signatures[slot].reset();
         ++m_LivingEntityCount;
 
-        return id;
+        const EntityID entity = MakeEntityID(index, page.Versions[slot]);
+        page.LiveIndex[slot] = static_cast<std::uint32_t>(m_LiveEntities.size());
+        m_LiveEntities.push_back(entity);
+        ++m_ChangeVersion;
+
+        return entity;
+    }
+
+    inline std::uint32_t EntityManager::CreateEntities(std::uint32_t count, EntityID* outEntities,
+                                                       const Signature& signature)
+    {
+        m_LiveEntities.reserve(m_LiveEntities.size() + count);
+
+        std::uint32_t created = 0;
+        for (; created < count; ++created)
+        {
+            std::uint32_t index;
+
+            if (m_FreeHead != INVALID_INDEX)
+            {
+                index = m_FreeHead;
+                m_FreeHead = PageOf(index).NextFree[index % ENTITY_PAGE_SIZE];
+            }
+            else
+            {
+                if (m_SlotCount >= MAX_ENTITIES)
+                {
+                    break;
+                }
+
+                index = m_SlotCount++;
+                if (index / ENTITY_PAGE_SIZE >= m_Pages.size())
+                {
+                    m_Pages.push_back(std::make_unique<EntityPage>());
+                }
+            }
+
+            EntityPage& page = PageOf(index);
+            const std::uint32_t slot = index % ENTITY_PAGE_SIZE;
+            page.Alive[slot] = true;
+            page.Signatures[slot] = signature;
+
+            const EntityID entity = MakeEntityID(index, page.Versions[slot]);
+            page.LiveIndex[slot] = static_cast<std::uint32_t>(m_LiveEntities.size());
+            m_LiveEntities.push_back(entity);
+            outEntities[created] = entity;
+        }
+
+        m_LivingEntityCount += created;
+        ++m_ChangeVersion;
+        return created;
     }
 
     inline void EntityManager::DestroyEntity(EntityID entity)
     {
-        if (entity >= MAX_ENTITIES || !m_EntityAlive[entity])
+        if (!IsAlive(entity))
         {
             return;
         }
 
-        // Reset signature and mark as dead
-        m_Signatures[entity].reset();
-        m_EntityAlive[entity] = false;
-
-        // Put the ID back in the available queue for reuse
-        m_AvailableEntities.push(entity);
+        const std::uint32_t index = GetEntityIndex(entity);
+        const std::uint32_t slot = index % ENTITY_PAGE_SIZE;
+        EntityPage& page = PageOf(index);
+
+        // Swap the last living entity into this one's place in the dense list
+        const std::uint32_t liveIndex = page.LiveIndex[slot];
+        const EntityID moved = m_LiveEntities.back();
+        m_LiveEntities[liveIndex] = moved;
+        PageOf(GetEntityIndex(moved)).LiveIndex[GetEntityIndex(moved) % ENTITY_PAGE_SIZE] = liveIndex;
+        m_LiveEntities.pop_back();
+        ++m_ChangeVersion;
+
+        // Reset signature, mark as dead and bump the version so old IDs go stale
+        page.Signatures[slot].reset();
+        page.Alive[slot] = false;
+        page.Versions[slot] = (page.Versions[slot] + 1) & ENTITY_VERSION_MASK;
+
+        // Push the slot onto the free list for reuse
+        page.NextFree[slot] = m_FreeHead;
+        m_FreeHead = index;
         --m_LivingEntityCount;
     }
 
     inline bool EntityManager::IsAlive(EntityID entity) const
     {
-        if (entity >= MAX_ENTITIES)
+        const std::uint32_t index = GetEntityIndex(entity);
+        if (entity == INVALID_ENTITY || index >= m_SlotCount)
         {
             return false;
         }
-        return m_EntityAlive[entity];
+
+        const EntityPage& page = PageOf(index);
+        const std::uint32_t slot = index % ENTITY_PAGE_SIZE;
+        return page.Alive[slot] && page.Versions[slot] == GetEntityVersion(entity);
     }
 
     inline void EntityManager::SetSignature(EntityID entity, Signature signature)
     {
-        assert(entity < MAX_ENTITIES && "Entity out of range");
-        assert(m_EntityAlive[entity] && "Cannot set signature of dead entity");
-        m_Signatures[entity] = signature;
+        assert(GetEntityIndex(entity) < m_SlotCount && "Entity out of range");
+        assert(IsAlive(entity) && "Cannot set signature of dead entity");
+        const std::uint32_t index = GetEntityIndex(entity);
+        PageOf(index).Signatures[index % ENTITY_PAGE_SIZE] = signature;
+        ++m_ChangeVersion;
     }
 
     inline Signature EntityManager::GetSignature(EntityID entity) const
     {
-        assert(entity < MAX_ENTITIES && "Entity out of range");
-        return m_Signatures[entity];
+        assert(GetEntityIndex(entity) < m_SlotCount && "Entity out of range");
+        const std::uint32_t index = GetEntityIndex(entity);
+        return PageOf(index).Signatures[index % ENTITY_PAGE_SIZE];
     }
 
-    inline void EntityManager::Reset()
+    template<typename Func>
+    void EntityManager::ForEachLivingEntity(Func&& func) const
     {
-        // Clear the queue and refill it
-        while (!m_AvailableEntities.empty())
+        for (std::uint32_t index = 0; index < m_SlotCount; ++index)
         {
-            m_AvailableEntities.pop();
+            const EntityPage& page = PageOf(index);
+            const std::uint32_t slot = index % ENTITY_PAGE_SIZE;
+            if (page.Alive[slot])
+            {
+                func(MakeEntityID(index, page.Versions[slot]));
+            }
         }
+    }
+
+    inline void EntityManager::RestoreSlots(std::uint32_t slotCount, const std::uint32_t* versions,
+                                            const std::uint8_t* alive)
+    {
+        Reset();
 
-        for (EntityID entity = 0; entity < MAX_ENTITIES; ++entity)
+        const std::size_t pageCount = (static_cast<std::size_t>(slotCount) + ENTITY_PAGE_SIZE - 1) / ENTITY_PAGE_SIZE;
+        m_Pages.reserve(pageCount);
+        for (std::size_t page = 0; page < pageCount; ++page)
         {
-            m_AvailableEntities.push(entity);
-            m_EntityAlive[entity] = false;
-            m_Signatures[entity].reset();
+            m_Pages.push_back(std::make_unique<EntityPage>());
         }
+        m_SlotCount = slotCount;
 
+        // Walk backwards so the free list hands out low slots first
+        for (std::uint32_t index = slotCount; index-- > 0;)
+        {
+            EntityPage& page = PageOf(index);
+            const std::uint32_t slot = index % ENTITY_PAGE_SIZE;
+            page.Versions[slot] = versions[index] & ENTITY_VERSION_MASK;
+
+            if (!alive[index])
+            {
+                page.NextFree[slot] = m_FreeHead;
+                m_FreeHead = index;
+            }
+        }
+
+        for (std::uint32_t index = 0; index < slotCount; ++index)
+        {
+            if (!alive[index])
+            {
+                continue;
+            }
+
+            EntityPage& page = PageOf(index);
+            const std::uint32_t slot = index % ENTITY_PAGE_SIZE;
+            page.Alive[slot] = true;
+            page.LiveIndex[slot] = static_cast<std::uint32_t>(m_LiveEntities.size());
+            m_LiveEntities.push_back(MakeEntityID(index, page.Versions[slot]));
+        }
+
+        m_LivingEntityCount = static_cast<std::uint32_t>(m_LiveEntities.size());
+        ++m_ChangeVersion;
+    }
+
+    inline void EntityManager::Reset()
+    {
+        m_Pages.clear();
+        m_FreeHead = INVALID_INDEX;
+        m_SlotCount = 0;
         m_LivingEntityCount = 0;
+        m_LiveEntities.clear();
+        ++m_ChangeVersion;
     }
 
 } // namespace SM
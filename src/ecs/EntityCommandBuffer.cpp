@@ -0,0 +1,210 @@
+#include "EntityCommandBuffer.h"
+
+#include <algorithm>
+
+namespace SM
+{
+    namespace
+    {
+        /// Last stream the current thread recorded into, keyed by buffer ID
+        struct StreamCache
+        {
+            std::uint64_t BufferID = 0;
+            void* Stream = nullptr;
+        };
+
+        thread_local StreamCache t_StreamCache;
+
+        std::atomic<std::uint64_t> s_NextBufferID{ 1 };
+    }
+
+    EntityCommandBuffer::EntityCommandBuffer()
+        : m_ID(s_NextBufferID.fetch_add(1, std::memory_order_relaxed))
+    {
+    }
+
+    EntityCommandBuffer::~EntityCommandBuffer()
+    {
+        DestroyPayloads();
+    }
+
+    PendingEntity EntityCommandBuffer::CreateEntity()
+    {
+        Stream& stream = GetStream();
+
+        Command command;
+        command.Type = CommandType::Create;
+        command.Target = stream.CreateCount;
+        stream.Commands.push_back(command);
+
+        return PendingEntity{ stream.Index, stream.CreateCount++ };
+    }
+
+    void EntityCommandBuffer::DestroyEntity(EntityID entity)
+    {
+        Command command;
+        command.Type = CommandType::Destroy;
+        command.Target = entity;
+        GetStream().Commands.push_back(command);
+    }
+
+    void EntityCommandBuffer::DestroyEntity(PendingEntity entity)
+    {
+        Command command;
+        command.Type = CommandType::Destroy;
+        command.IsPending = true;
+        command.PendingStream = entity.Stream;
+        command.Target = entity.Index;
+        GetStream().Commands.push_back(command);
+    }
+
+    EntityID EntityCommandBuffer::Resolve(PendingEntity entity) const
+    {
+        std::lock_guard<std::mutex> lock(m_StreamMutex);
+
+        if (entity.Stream >= m_Streams.size())
+        {
+            return INVALID_ENTITY;
+        }
+
+        const std::vector<EntityID>& created = m_Streams[entity.Stream]->Created;
+        return entity.Index < created.size() ? created[entity.Index] : INVALID_ENTITY;
+    }
+
+    bool EntityCommandBuffer::IsEmpty() const
+    {
+        return GetCommandCount() == 0;
+    }
+
+    std::size_t EntityCommandBuffer::GetCommandCount() const
+    {
+        std::lock_guard<std::mutex> lock(m_StreamMutex);
+
+        std::size_t count = 0;
+        for (const auto& stream : m_Streams)
+        {
+            count += stream->Commands.size();
+        }
+        return count;
+    }
+
+    void EntityCommandBuffer::Reset()
+    {
+        ClearCommands();
+
+        std::lock_guard<std::mutex> lock(m_StreamMutex);
+        for (auto& stream : m_Streams)
+        {
+            stream->Created.clear();
+        }
+    }
+
+    void EntityCommandBuffer::ClearCommands()
+    {
+        DestroyPayloads();
+
+        std::lock_guard<std::mutex> lock(m_StreamMutex);
+        for (auto& stream : m_Streams)
+        {
+            stream->Commands.clear();
+            stream->CreateCount = 0;
+            stream->BlockIndex = 0;
+            stream->BlockOffset = 0;
+        }
+    }
+
+    EntityCommandBuffer::Stream& EntityCommandBuffer::GetStream()
+    {
+        if (t_StreamCache.BufferID == m_ID)
+        {
+            return *static_cast<Stream*>(t_StreamCache.Stream);
+        }
+
+        std::lock_guard<std::mutex> lock(m_StreamMutex);
+
+        const std::thread::id self = std::this_thread::get_id();
+        Stream* stream = nullptr;
+        for (auto& candidate : m_Streams)
+        {
+            if (candidate->Owner == self)
+            {
+                stream = candidate.get();
+                break;
+            }
+        }
+
+        if (!stream)
+        {
+            m_Streams.push_back(std::make_unique<Stream>());
+            stream = m_Streams.back().get();
+            stream->Owner = self;
+            stream->Index = static_cast<std::uint32_t>(m_Streams.size() - 1);
+        }
+
+        // Streams live as long as the buffer, so the cached pointer stays valid
+        t_StreamCache.BufferID = m_ID;
+        t_StreamCache.Stream = stream;
+        return *stream;
+    }
+
+    void* EntityCommandBuffer::AllocatePayload(Stream& stream, std::size_t size, std::size_t alignment)
+    {
+        while (stream.BlockIndex < stream.Blocks.size())
+        {
+            PayloadBlock& block = stream.Blocks[stream.BlockIndex];
+            std::size_t offset = (stream.BlockOffset + alignment - 1) & ~(alignment - 1);
+            if (offset + size <= block.Size)
+            {
+                stream.BlockOffset = offset + size;
+                return block.Data.get() + offset;
+            }
+
+            // Retained blocks from earlier frames are reused before growing
+            ++stream.BlockIndex;
+            stream.BlockOffset = 0;
+        }
+
+        PayloadBlock block;
+        block.Size = std::max(PAYLOAD_BLOCK_SIZE, size);
+        block.Data = std::make_unique<std::byte[]>(block.Size);
+        stream.Blocks.push_back(std::move(block));
+
+        stream.BlockIndex = stream.Blocks.size() - 1;
+        stream.BlockOffset = size;
+        return stream.Blocks.back().Data.get();
+    }
+
+    void EntityCommandBuffer::DestroyPayloads()
+    {
+        std::lock_guard<std::mutex> lock(m_StreamMutex);
+
+        for (auto& stream : m_Streams)
+        {
+            for (Command& command : stream->Commands)
+            {
+                if (command.Payload)
+                {
+                    command.Ops->Destroy(command.Payload);
+                    command.Payload = nullptr;
+                }
+            }
+        }
+    }
+
+    EntityID EntityCommandBuffer::GetTarget(const Command& command) const
+    {
+        if (!command.IsPending)
+        {
+            return command.Target;
+        }
+
+        if (command.PendingStream >= m_Streams.size())
+        {
+            return INVALID_ENTITY;
+        }
+
+        const std::vector<EntityID>& created = m_Streams[command.PendingStream]->Created;
+        return command.Target < created.size() ? created[command.Target] : INVALID_ENTITY;
+    }
+
+} // namespace SM
@@ -0,0 +1,311 @@
+#pragma once
+
+/**
+ * @file EntityCommandBuffer.h
+ * @brief Deferred structural changes for Shattered Moon ECS
+ *
+ * World::CreateEntity, DestroyEntity, AddComponent and RemoveComponent
+ * update system and query membership on the spot, so they must not be
+ * called while systems run on worker threads. An EntityCommandBuffer
+ * records those changes instead - each thread into its own stream, without
+ * locking - and World::Playback applies them at a sync point, notifying
+ * systems and queries once per group of entities that share the same
+ * signature transition.
+ */
+
+#include "Entity.h"
+#include "ComponentManager.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace SM
+{
+    // Forward declaration
+    class World;
+
+    // ============================================================================
+    // PendingEntity
+    // ============================================================================
+
+    /**
+     * @brief Handle to an entity created through a command buffer
+     *
+     * The real EntityID does not exist until playback. A pending handle can
+     * be used in later commands of any stream of the same buffer, and
+     * resolved with EntityCommandBuffer::Resolve after playback.
+     */
+    struct PendingEntity
+    {
+        std::uint32_t Stream = 0;   ///< Stream that recorded the create
+        std::uint32_t Index = 0;    ///< Create number within that stream
+    };
+
+    // ============================================================================
+    // EntityCommandBuffer Class
+    // ============================================================================
+
+    /**
+     * @brief Per-thread recorder of entity and component changes
+     *
+     * Recording is safe from any number of threads at once; each thread
+     * appends to a stream it owns. Playback (World::Playback) and Reset must
+     * not overlap with recording. Streams are applied in the order threads
+     * first recorded into them, and each stream in recording order.
+     *
+     * Component values are moved into a per-stream arena, so T must be move
+     * constructible and no more aligned than operator new guarantees.
+     */
+    class EntityCommandBuffer
+    {
+    public:
+        EntityCommandBuffer();
+        ~EntityCommandBuffer();
+
+        // Prevent copying
+        EntityCommandBuffer(const EntityCommandBuffer&) = delete;
+        EntityCommandBuffer& operator=(const EntityCommandBuffer&) = delete;
+
+        // ====================================================================
+        // Recording
+        // ====================================================================
+
+        /**
+         * @brief Record the creation of an entity
+         * @return Handle usable in later commands and in Resolve
+         */
+        PendingEntity CreateEntity();
+
+        /**
+         * @brief Record the destruction of an entity
+         *
+         * Commands recorded later for the same entity are skipped.
+         */
+        void DestroyEntity(EntityID entity);
+        void DestroyEntity(PendingEntity entity);
+
+        /**
+         * @brief Record adding a component
+         * @tparam T The component type (must be registered by playback)
+         */
+        template<typename T>
+        void AddComponent(EntityID entity, T component);
+
+        template<typename T>
+        void AddComponent(PendingEntity entity, T component);
+
+        /**
+         * @brief Record removing a component
+         * @tparam T The component type
+         */
+        template<typename T>
+        void RemoveComponent(EntityID entity);
+
+        template<typename T>
+        void RemoveComponent(PendingEntity entity);
+
+        // ====================================================================
+        // State
+        // ====================================================================
+
+        /**
+         * @brief Get the entity a pending handle was created as
+         * @return The EntityID, or INVALID_ENTITY before playback or if creation failed
+         *
+         * Valid from playback until the next playback or Reset.
+         */
+        EntityID Resolve(PendingEntity entity) const;
+
+        /**
+         * @brief Check if no commands are recorded
+         */
+        bool IsEmpty() const;
+
+        /**
+         * @brief Get the number of recorded commands across all streams
+         */
+        std::size_t GetCommandCount() const;
+
+        /**
+         * @brief Drop all recorded commands and resolved entities
+         *
+         * Streams and their arenas are kept for reuse.
+         */
+        void Reset();
+
+    private:
+        friend class World;
+
+        enum class CommandType : std::uint8_t
+        {
+            Create,
+            Destroy,
+            AddComponent,
+            RemoveComponent
+        };
+
+        /**
+         * @brief Type-erased component operations for one component type
+         */
+        struct ComponentOps
+        {
+            ComponentType (*GetType)(const ComponentManager& components) = nullptr;
+            void (*Add)(ComponentManager& components, EntityID entity, void* payload) = nullptr;
+            void (*Remove)(ComponentManager& components, EntityID entity) = nullptr;
+            void (*Destroy)(void* payload) = nullptr;
+
+            template<typename T>
+            static const ComponentOps* Of();
+        };
+
+        struct Command
+        {
+            CommandType Type = CommandType::Create;
+            bool IsPending = false;             ///< Target is a PendingEntity, not an EntityID
+            std::uint32_t PendingStream = 0;
+            std::uint32_t Target = 0;           ///< EntityID, or create index in PendingStream
+            const ComponentOps* Ops = nullptr;
+            void* Payload = nullptr;            ///< Component value for AddComponent
+        };
+
+        struct PayloadBlock
+        {
+            std::unique_ptr<std::byte[]> Data;
+            std::size_t Size = 0;
+        };
+
+        /**
+         * @brief Commands recorded by one thread
+         */
+        struct Stream
+        {
+            std::thread::id Owner;
+            std::uint32_t Index = 0;            ///< Position in m_Streams
+            std::vector<Command> Commands;
+            std::uint32_t CreateCount = 0;
+            std::vector<EntityID> Created;      ///< Filled during playback
+
+            std::vector<PayloadBlock> Blocks;
+            std::size_t BlockIndex = 0;
+            std::size_t BlockOffset = 0;
+        };
+
+        static constexpr std::size_t PAYLOAD_BLOCK_SIZE = 16 * 1024;
+
+        /**
+         * @brief Get the calling thread's stream, creating it on first use
+         */
+        Stream& GetStream();
+
+        /**
+         * @brief Reserve aligned payload memory in a stream's arena
+         */
+        static void* AllocatePayload(Stream& stream, std::size_t size, std::size_t alignment);
+
+        /**
+         * @brief Drop recorded commands but keep resolved entities (after playback)
+         */
+        void ClearCommands();
+
+        /**
+         * @brief Destroy the component values held by AddComponent commands
+         */
+        void DestroyPayloads();
+
+        /**
+         * @brief Get the entity a command targets (INVALID_ENTITY if unresolved)
+         */
+        EntityID GetTarget(const Command& command) const;
+
+        template<typename T>
+        void RecordAdd(Command command, T&& component);
+
+    private:
+        std::uint64_t m_ID;                     ///< Distinguishes buffers in the thread-local stream cache
+        mutable std::mutex m_StreamMutex;
+        std::vector<std::unique_ptr<Stream>> m_Streams;
+    };
+
+    // ============================================================================
+    // EntityCommandBuffer Template Implementation
+    // ============================================================================
+
+    template<typename T>
+    const EntityCommandBuffer::ComponentOps* EntityCommandBuffer::ComponentOps::Of()
+    {
+        static const ComponentOps ops = {
+            [](const ComponentManager& components) { return components.GetComponentType<T>(); },
+            [](ComponentManager& components, EntityID entity, void* payload) {
+                components.AddComponent<T>(entity, std::move(*static_cast<T*>(payload)));
+            },
+            [](ComponentManager& components, EntityID entity) { components.RemoveComponent<T>(entity); },
+            [](void* payload) { static_cast<T*>(payload)->~T(); }
+        };
+        return &ops;
+    }
+
+    template<typename T>
+    void EntityCommandBuffer::RecordAdd(Command command, T&& component)
+    {
+        static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                      "Over-aligned components cannot be recorded");
+
+        Stream& stream = GetStream();
+        void* payload = AllocatePayload(stream, sizeof(T), alignof(T));
+        new (payload) T(std::move(component));
+
+        command.Type = CommandType::AddComponent;
+        command.Ops = ComponentOps::Of<T>();
+        command.Payload = payload;
+        stream.Commands.push_back(command);
+    }
+
+    template<typename T>
+    void EntityCommandBuffer::AddComponent(EntityID entity, T component)
+    {
+        Command command;
+        command.Target = entity;
+        RecordAdd<T>(command, std::move(component));
+    }
+
+    template<typename T>
+    void EntityCommandBuffer::AddComponent(PendingEntity entity, T component)
+    {
+        Command command;
+        command.IsPending = true;
+        command.PendingStream = entity.Stream;
+        command.Target = entity.Index;
+        RecordAdd<T>(command, std::move(component));
+    }
+
+    template<typename T>
+    void EntityCommandBuffer::RemoveComponent(EntityID entity)
+    {
+        Command command;
+        command.Type = CommandType::RemoveComponent;
+        command.Target = entity;
+        command.Ops = ComponentOps::Of<T>();
+        GetStream().Commands.push_back(command);
+    }
+
+    template<typename T>
+    void EntityCommandBuffer::RemoveComponent(PendingEntity entity)
+    {
+        Command command;
+        command.Type = CommandType::RemoveComponent;
+        command.IsPending = true;
+        command.PendingStream = entity.Stream;
+        command.Target = entity.Index;
+        command.Ops = ComponentOps::Of<T>();
+        GetStream().Commands.push_back(command);
+    }
+
+} // namespace SM
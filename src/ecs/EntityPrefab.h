@@ -0,0 +1,163 @@
+#pragma once
+
+/**
+ * @file EntityPrefab.h
+ * @brief Component template for bulk entity spawning in Shattered Moon ECS
+ *
+ * A prefab holds one value per component type. World::CreateEntities
+ * copies those values into any number of new entities in a single pass,
+ * which is how foliage and prop scattering create tens of thousands of
+ * entities at a time.
+ */
+
+#include "Entity.h"
+#include "ComponentManager.h"
+
+#include <memory>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+namespace SM
+{
+    // Forward declaration
+    class World;
+
+    // ============================================================================
+    // EntityPrefab Class
+    // ============================================================================
+
+    /**
+     * @brief Set of component values shared by entities spawned from it
+     *
+     * Usage example:
+     * @code
+     * EntityPrefab rock;
+     * rock.Add(TransformComponent{}).Add(MeshComponent{ PrimitiveMesh::Sphere });
+     *
+     * std::vector<EntityID> rocks = world.CreateEntities(50000, rock);
+     * @endcode
+     *
+     * Copies of a prefab share their component values, which are immutable
+     * once added (Add replaces a value rather than modifying it).
+     */
+    class EntityPrefab
+    {
+    public:
+        /**
+         * @brief Add a component value, replacing any value of the same type
+         * @tparam T The component type (must be copy constructible)
+         * @return *this, for chaining
+         */
+        template<typename T>
+        EntityPrefab& Add(T component);
+
+        /**
+         * @brief Check if the prefab has a component type
+         */
+        template<typename T>
+        bool Has() const;
+
+        /**
+         * @brief Get the number of component types in the prefab
+         */
+        std::size_t GetComponentCount() const { return m_Components.size(); }
+
+        /**
+         * @brief Build the signature of entities spawned from this prefab
+         * @param components Component manager the types are registered with
+         */
+        Signature GetSignature(const ComponentManager& components) const
+        {
+            Signature signature;
+            for (const Entry& entry : m_Components)
+            {
+                signature.set(entry.Ops->GetType(components), true);
+            }
+            return signature;
+        }
+
+    private:
+        friend class World;
+
+        /**
+         * @brief Type-erased operations for one component type
+         */
+        struct ComponentOps
+        {
+            ComponentType (*GetType)(const ComponentManager& components) = nullptr;
+
+            /// Sparse mode: append a copy of value for every entity
+            void (*InsertCopies)(ComponentManager& components, const EntityID* entities,
+                                 std::size_t count, const void* value) = nullptr;
+
+            /// Archetype mode: copy-construct value into unconstructed memory
+            void (*CopyConstruct)(void* destination, const void* value) = nullptr;
+
+            template<typename T>
+            static const ComponentOps* Of();
+        };
+
+        struct Entry
+        {
+            std::type_index Type;
+            std::shared_ptr<const void> Value;
+            const ComponentOps* Ops = nullptr;
+        };
+
+        std::vector<Entry> m_Components;
+    };
+
+    // ============================================================================
+    // EntityPrefab Template Implementation
+    // ============================================================================
+
+    template<typename T>
+    const EntityPrefab::ComponentOps* EntityPrefab::ComponentOps::Of()
+    {
+        static const ComponentOps ops = {
+            [](const ComponentManager& components) { return components.GetComponentType<T>(); },
+            [](ComponentManager& components, const EntityID* entities, std::size_t count, const void* value) {
+                components.GetComponentArray<T>()->InsertCopies(entities, count, *static_cast<const T*>(value));
+            },
+            [](void* destination, const void* value) {
+                new (destination) T(*static_cast<const T*>(value));
+            }
+        };
+        return &ops;
+    }
+
+    template<typename T>
+    EntityPrefab& EntityPrefab::Add(T component)
+    {
+        std::shared_ptr<const void> value = std::make_shared<const T>(std::move(component));
+
+        const std::type_index type = std::type_index(typeid(T));
+        for (Entry& entry : m_Components)
+        {
+            if (entry.Type == type)
+            {
+                entry.Value = std::move(value);
+                return *this;
+            }
+        }
+
+        m_Components.push_back(Entry{ type, std::move(value), ComponentOps::Of<T>() });
+        return *this;
+    }
+
+    template<typename T>
+    bool EntityPrefab::Has() const
+    {
+        const std::type_index type = std::type_index(typeid(T));
+        for (const Entry& entry : m_Components)
+        {
+            if (entry.Type == type)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+} // namespace SM
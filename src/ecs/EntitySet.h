@@ -0,0 +1,126 @@
+#pragma once
+
+/**
+ * @file EntitySet.h
+ * @brief Sparse-set container of entity IDs for Shattered Moon ECS
+ *
+ * Entities are kept packed in a dense array for contiguous iteration, and
+ * a sparse array indexed by entity slot maps each member to its dense
+ * position, giving O(1) insert, erase and lookup without per-element heap
+ * allocations.
+ */
+
+#include "Entity.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace SM
+{
+    // ============================================================================
+    // EntitySet Class
+    // ============================================================================
+
+    /**
+     * @brief Set of entities with O(1) insert/erase and packed iteration
+     *
+     * Iteration order is insertion order, except that erasing swaps the last
+     * member into the erased position. Iterators stay valid until the set is
+     * modified.
+     */
+    class EntitySet
+    {
+    public:
+        using const_iterator = std::vector<EntityID>::const_iterator;
+
+        /**
+         * @brief Add an entity (no-op if already a member)
+         * @return true if the entity was added
+         */
+        bool Insert(EntityID entity)
+        {
+            const std::uint32_t index = GetEntityIndex(entity);
+            if (index >= m_Sparse.size())
+            {
+                m_Sparse.resize(static_cast<std::size_t>(index) + 1, 0);
+            }
+
+            if (m_Sparse[index] != 0)
+            {
+                return false; // Already a member
+            }
+
+            m_Dense.push_back(entity);
+            m_Sparse[index] = static_cast<std::uint32_t>(m_Dense.size());
+            return true;
+        }
+
+        /**
+         * @brief Remove an entity (no-op if not a member)
+         * @return true if the entity was removed
+         */
+        bool Erase(EntityID entity)
+        {
+            if (!Contains(entity))
+            {
+                return false;
+            }
+
+            // Swap with the last entity to keep the array packed
+            const std::uint32_t index = GetEntityIndex(entity);
+            std::uint32_t position = m_Sparse[index] - 1;
+            EntityID last = m_Dense.back();
+            m_Dense[position] = last;
+            m_Sparse[GetEntityIndex(last)] = position + 1;
+
+            m_Dense.pop_back();
+            m_Sparse[index] = 0;
+            return true;
+        }
+
+        /**
+         * @brief Check if an entity is a member (stale IDs are not)
+         */
+        bool Contains(EntityID entity) const
+        {
+            const std::uint32_t index = GetEntityIndex(entity);
+            return index < m_Sparse.size() && m_Sparse[index] != 0
+                && m_Dense[m_Sparse[index] - 1] == entity;
+        }
+
+        /**
+         * @brief Remove all entities
+         */
+        void Clear()
+        {
+            m_Dense.clear();
+            m_Sparse.clear();
+        }
+
+        std::size_t Size() const { return m_Dense.size(); }
+        bool Empty() const { return m_Dense.empty(); }
+
+        EntityID operator[](std::size_t position) const { return m_Dense[position]; }
+
+        /**
+         * @brief Get the packed member array
+         */
+        const std::vector<EntityID>& GetDense() const { return m_Dense; }
+
+        // Range-for support
+        const_iterator begin() const { return m_Dense.begin(); }
+        const_iterator end() const { return m_Dense.end(); }
+
+        // std::set compatible spellings
+        std::size_t size() const { return m_Dense.size(); }
+        bool empty() const { return m_Dense.empty(); }
+
+    private:
+        /** Members, packed */
+        std::vector<EntityID> m_Dense;
+
+        /** Entity slot index -> dense position + 1 (0 = not a member) */
+        std::vector<std::uint32_t> m_Sparse;
+    };
+
+} // namespace SM
@@ -0,0 +1,185 @@
+#pragma once
+
+/**
+ * @file Query.h
+ * @brief Cached component queries for Shattered Moon ECS
+ *
+ * A Query keeps a dense list of every entity whose signature contains the
+ * query's components. The World updates all queries whenever an entity's
+ * signature changes, so iterating a query never scans dead or unrelated
+ * entity IDs.
+ */
+
+#include "Entity.h"
+#include "ComponentManager.h"
+#include "EntitySet.h"
+
+#include <utility>
+#include <vector>
+
+namespace SM
+{
+    // ============================================================================
+    // QueryBase Class
+    // ============================================================================
+
+    /**
+     * @brief Type-independent part of a query: signature and dense entity set
+     */
+    class QueryBase
+    {
+    public:
+        explicit QueryBase(const Signature& signature) : m_Signature(signature) {}
+        virtual ~QueryBase() = default;
+
+        // Prevent copying
+        QueryBase(const QueryBase&) = delete;
+        QueryBase& operator=(const QueryBase&) = delete;
+
+        /**
+         * @brief Get the required component signature
+         */
+        const Signature& GetSignature() const { return m_Signature; }
+
+        /**
+         * @brief Get all matching entities (packed, unordered)
+         */
+        const std::vector<EntityID>& GetEntities() const { return m_Entities.GetDense(); }
+
+        /**
+         * @brief Get the number of matching entities
+         */
+        std::size_t Size() const { return m_Entities.Size(); }
+
+        /**
+         * @brief Check if an entity currently matches
+         */
+        bool Contains(EntityID entity) const { return m_Entities.Contains(entity); }
+
+        /**
+         * @brief Re-evaluate membership after a signature change
+         * @param entity The entity whose signature changed
+         * @param entitySignature The entity's new signature
+         */
+        void EntitySignatureChanged(EntityID entity, const Signature& entitySignature)
+        {
+            if ((entitySignature & m_Signature) == m_Signature)
+            {
+                m_Entities.Insert(entity);
+            }
+            else
+            {
+                m_Entities.Erase(entity);
+            }
+        }
+
+        /**
+         * @brief Remove an entity that was destroyed
+         */
+        void EntityDestroyed(EntityID entity)
+        {
+            m_Entities.Erase(entity);
+        }
+
+        /**
+         * @brief Re-evaluate membership for a group with the same signature change
+         * @param entities Entities whose signature went from 'before' to 'after'
+         * @param count Number of entities
+         * @param before Signature before the change (empty for new entities)
+         * @param after Signature after the change
+         */
+        void EntitiesSignatureChanged(const EntityID* entities, std::size_t count,
+                                      const Signature& before, const Signature& after)
+        {
+            if ((after & m_Signature) == m_Signature)
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    m_Entities.Insert(entities[i]);
+                }
+            }
+            else if ((before & m_Signature) == m_Signature)
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    m_Entities.Erase(entities[i]);
+                }
+            }
+        }
+
+        /**
+         * @brief Remove a group of destroyed entities that shared a signature
+         */
+        void EntitiesDestroyed(const EntityID* entities, std::size_t count, const Signature& signature)
+        {
+            if ((signature & m_Signature) != m_Signature)
+            {
+                return;
+            }
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                m_Entities.Erase(entities[i]);
+            }
+        }
+
+    protected:
+        Signature m_Signature;
+        EntitySet m_Entities;
+    };
+
+    // ============================================================================
+    // Query<Ts...> Template
+    // ============================================================================
+
+    /**
+     * @brief Cached query over all entities that have every component in Ts
+     *
+     * Obtained from World::GetQuery and kept current by the World. Iterating
+     * calls the callable directly (no std::function), so it can be inlined.
+     *
+     * @tparam Ts The required component types
+     */
+    template<typename... Ts>
+    class Query : public QueryBase
+    {
+    public:
+        explicit Query(const ComponentManager& components)
+            : QueryBase(BuildSignature(components))
+        {
+        }
+
+        /**
+         * @brief Invoke func(EntityID, Ts&...) for every matching entity
+         * @param components Component storage owned by the same World
+         * @param func Callable to invoke
+         *
+         * The callable must not add or remove components or entities.
+         */
+        template<typename Func>
+        void ForEach(ComponentManager& components, Func&& func)
+        {
+            if (components.GetStorageMode() == ComponentStorageMode::Archetype)
+            {
+                // Archetype blocks are already packed per signature
+                components.GetArchetypeStorage().ForEach<Ts...>(
+                    { components.GetComponentType<Ts>()... }, func);
+                return;
+            }
+
+            for (EntityID entity : m_Entities)
+            {
+                func(entity, components.GetComponent<Ts>(entity)...);
+            }
+        }
+
+    private:
+        static Signature BuildSignature(const ComponentManager& components)
+        {
+            Signature signature;
+            (signature.set(components.GetComponentType<Ts>(), true), ...);
+            return signature;
+        }
+    };
+
+} // namespace SM
@@ -7,18 +7,54 @@
  * Systems contain the logic that operates on entities with specific
  * component signatures. Each system defines which components it requires
  * and processes entities that have all required components.
+ *
+ * Systems may also declare which component types they read and write.
+ * The SystemManager uses these sets to run non-conflicting systems on
+ * worker threads at the same time.
  */
 
 #include "Entity.h"
+#include "EntitySet.h"
+#include "core/JobSystem.h"
 
-#include <set>
+#include <algorithm>
 #include <string>
+#include <utility>
 
 namespace SM
 {
     // Forward declaration
     class World;
 
+    // ============================================================================
+    // SystemAccess
+    // ============================================================================
+
+    /**
+     * @brief Component types a system reads and writes during Update
+     *
+     * Systems that have not declared their access are Exclusive and never
+     * run alongside another system.
+     */
+    struct SystemAccess
+    {
+        Signature Reads;
+        Signature Writes;
+        bool Exclusive = true;
+
+        /**
+         * @brief Check if two systems must not run at the same time
+         */
+        bool ConflictsWith(const SystemAccess& other) const
+        {
+            if (Exclusive || other.Exclusive)
+            {
+                return true;
+            }
+            return (Writes & (other.Reads | other.Writes)).any() || (other.Writes & Reads).any();
+        }
+    };
+
     // ============================================================================
     // ISystem Interface
     // ============================================================================
@@ -93,11 +129,70 @@ namespace SM
          */
         void SetPriority(int priority) { m_Priority = priority; }
 
+        /**
+         * @brief Get the declared component access of this system
+         */
+        const SystemAccess& GetComponentAccess() const { return m_Access; }
+
+        /**
+         * @brief Declare which component types Update reads and writes
+         * @param reads Components only read (see World::MakeSignature)
+         * @param writes Components modified
+         *
+         * Call from Initialize. Once declared, the system may run in parallel
+         * with other systems whose access does not overlap. Update must then
+         * not create or destroy entities or add or remove components.
+         */
+        void SetComponentAccess(Signature reads, Signature writes)
+        {
+            m_Access.Reads = reads;
+            m_Access.Writes = writes;
+            m_Access.Exclusive = false;
+        }
+
+        /**
+         * @brief Let ParallelForEach use the job system (called by SystemManager)
+         */
+        void SetParallelEnabled(bool enabled) { m_ParallelEnabled = enabled; }
+
+        /**
+         * @brief Invoke func(EntityID) for every entity, split across workers
+         * @param func Callable to invoke; must be safe to run concurrently
+         * @param minBatchSize Smallest number of entities handed to one task
+         *
+         * Runs serially unless parallel updates are enabled and the job
+         * system has workers. Blocks until every
+         * entity has been processed.
+         */
+        template<typename Func>
+        void ParallelForEach(Func&& func, std::size_t minBatchSize = 64);
+
+        /**
+         * @brief Invoke func(EntityID) for every entity of an array, split across workers
+         * @param entities Entities to visit (e.g. a query's or a hierarchy level's)
+         * @param entityCount Number of entities
+         * @param func Callable to invoke; must be safe to run concurrently
+         * @param minBatchSize Smallest number of entities handed to one task
+         */
+        template<typename Func>
+        void ParallelForRange(const EntityID* entities, std::size_t entityCount, Func&& func,
+                              std::size_t minBatchSize = 64);
+
+        /**
+         * @brief Invoke func(const EntityID* batch, std::size_t count) per batch of an array
+         *
+         * Like ParallelForRange, but hands each task its whole slice so the
+         * callable can gather it into SoA streams for batch kernels.
+         */
+        template<typename Func>
+        void ParallelForBatches(const EntityID* entities, std::size_t entityCount, Func&& func,
+                                std::size_t minBatchSize = 64);
+
         /**
          * @brief Get the set of entities this system processes
-         * @return Set of entity IDs
+         * @return Packed set of entity IDs (unordered)
          */
-        const std::set<EntityID>& GetEntities() const { return m_Entities; }
+        const EntitySet& GetEntities() const { return m_Entities; }
 
         /**
          * @brief Called internally when an entity matches the system's signature
@@ -105,7 +200,7 @@ namespace SM
          */
         void OnEntityAdded(EntityID entity)
         {
-            m_Entities.insert(entity);
+            m_Entities.Insert(entity);
         }
 
         /**
@@ -114,20 +209,70 @@ namespace SM
          */
         void OnEntityRemoved(EntityID entity)
         {
-            m_Entities.erase(entity);
+            m_Entities.Erase(entity);
         }
 
     protected:
         /** Set of entities this system processes */
-        std::set<EntityID> m_Entities;
+        EntitySet m_Entities;
 
         /** Whether the system is currently enabled */
         bool m_Enabled = true;
 
         /** System priority (lower = earlier execution) */
         int m_Priority = 0;
+
+        /** Declared component access (Exclusive until declared) */
+        SystemAccess m_Access;
+
+        /** Whether ParallelForEach may split work across the job system */
+        bool m_ParallelEnabled = false;
     };
 
+    template<typename Func>
+    void ISystem::ParallelForEach(Func&& func, std::size_t minBatchSize)
+    {
+        ParallelForRange(m_Entities.GetDense().data(), m_Entities.size(), std::forward<Func>(func), minBatchSize);
+    }
+
+    template<typename Func>
+    void ISystem::ParallelForRange(const EntityID* entities, std::size_t entityCount, Func&& func,
+                                   std::size_t minBatchSize)
+    {
+        ParallelForBatches(entities, entityCount, [&func](const EntityID* batch, std::size_t count) {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                func(batch[i]);
+            }
+        }, minBatchSize);
+    }
+
+    template<typename Func>
+    void ISystem::ParallelForBatches(const EntityID* entities, std::size_t entityCount, Func&& func,
+                                     std::size_t minBatchSize)
+    {
+        minBatchSize = std::max<std::size_t>(1, minBatchSize);
+
+        JobSystem& jobs = JobSystem::Get();
+        if (!m_ParallelEnabled || !jobs.IsInitialized() || entityCount <= minBatchSize)
+        {
+            if (entityCount > 0)
+            {
+                func(entities, entityCount);
+            }
+            return;
+        }
+
+        // A few batches per thread so stealing can even out uneven work
+        const std::size_t threadCount = jobs.GetWorkerCount() + 1;
+        const std::size_t batchSize = std::max(minBatchSize, (entityCount + threadCount * 4 - 1) / (threadCount * 4));
+
+        jobs.ParallelFor(static_cast<std::uint32_t>(entityCount), static_cast<std::uint32_t>(batchSize),
+            [entities, &func](std::uint32_t begin, std::uint32_t end) {
+                func(entities + begin, static_cast<std::size_t>(end - begin));
+            });
+    }
+
     // ============================================================================
     // System CRTP Base
     // ============================================================================
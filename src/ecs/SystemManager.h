@@ -9,13 +9,18 @@
 
 #include "System.h"
 #include "Entity.h"
+#include "core/JobSystem.h"
+#include "core/Profiler.h"
 
+#include <cstdint>
+#include <iostream>
 #include <memory>
 #include <unordered_map>
 #include <vector>
 #include <typeindex>
 #include <algorithm>
 #include <cassert>
+#include <functional>
 
 namespace SM
 {
@@ -32,6 +37,7 @@ namespace SM
      * Responsibilities:
      * - Registering and storing systems
      * - Updating systems each frame in priority order
+     * - Optionally running non-conflicting systems on job system workers
      * - Notifying systems when entity signatures change
      * - Managing system lifecycle (init, update, shutdown)
      */
@@ -113,6 +119,28 @@ namespace SM
          */
         void EntityDestroyed(EntityID entity);
 
+        /**
+         * @brief Notify systems of many entities that made the same signature change
+         * @param entities Entities whose signature went from 'before' to 'after'
+         * @param count Number of entities
+         * @param before Signature before the change (empty for new entities)
+         * @param after Signature after the change
+         *
+         * Each system's signature is tested once for the whole group rather
+         * than once per entity, and systems matching neither signature are
+         * skipped.
+         */
+        void EntitiesSignatureChanged(const EntityID* entities, std::size_t count,
+                                      const Signature& before, const Signature& after);
+
+        /**
+         * @brief Notify systems of many destroyed entities that shared a signature
+         * @param entities The destroyed entities
+         * @param count Number of entities
+         * @param signature Signature the entities had when destroyed
+         */
+        void EntitiesDestroyed(const EntityID* entities, std::size_t count, const Signature& signature);
+
         /**
          * @brief Initialize all systems
          * @param world Reference to the ECS world
@@ -123,9 +151,29 @@ namespace SM
          * @brief Update all enabled systems in priority order
          * @param world Reference to the ECS world
          * @param deltaTime Time since last frame
+         *
+         * With parallel updates enabled, a job graph is built from the
+         * systems' declared access: a system waits only for earlier systems
+         * it conflicts with, and everything else runs concurrently.
          */
         void UpdateSystems(World& world, float deltaTime);
 
+        /**
+         * @brief Run systems in parallel on the job system
+         * @return false if the job system has no workers (updates stay serial)
+         */
+        bool EnableParallelUpdates();
+
+        /**
+         * @brief Go back to serial updates
+         */
+        void DisableParallelUpdates();
+
+        /**
+         * @brief Check if systems run on job system workers
+         */
+        bool IsParallelUpdateEnabled() const { return m_ParallelUpdates && JobSystem::Get().IsInitialized(); }
+
         /**
          * @brief Shutdown all systems
          * @param world Reference to the ECS world
@@ -163,6 +211,14 @@ namespace SM
 
         /** Flag indicating if systems are initialized */
         bool m_Initialized = false;
+
+        /** Whether systems run on the job system */
+        bool m_ParallelUpdates = false;
+
+        /** Per-frame schedule scratch, kept to reuse allocations */
+        std::vector<ISystem*> m_ScheduledSystems;
+        std::vector<Job*> m_ScheduleJobs;       // One per scheduled system, then relay jobs
+        std::vector<Job*> m_ScheduleTails;      // Job that a system's dependents attach to
     };
 
     // ============================================================================
@@ -188,6 +244,7 @@ namespace SM
 
         // Add to ordered list
         m_SystemOrder.push_back(rawPtr);
+        rawPtr->SetParallelEnabled(m_ParallelUpdates);
 
         // Initialize default signature from the system
         m_Signatures[typeIndex] = rawPtr->GetRequiredSignature();
@@ -300,6 +357,60 @@ namespace SM
         }
     }
 
+    inline void SystemManager::EntitiesSignatureChanged(const EntityID* entities, std::size_t count,
+                                                        const Signature& before, const Signature& after)
+    {
+        for (auto& [typeIndex, system] : m_Systems)
+        {
+            auto signatureIt = m_Signatures.find(typeIndex);
+            if (signatureIt == m_Signatures.end())
+            {
+                continue;
+            }
+
+            const Signature& systemSignature = signatureIt->second;
+            const bool matchedBefore = (before & systemSignature) == systemSignature;
+            const bool matchesAfter = (after & systemSignature) == systemSignature;
+
+            // Inserting is idempotent, so matching entities are always offered;
+            // this also covers new entities and systems with an empty signature
+            if (matchesAfter)
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    system->OnEntityAdded(entities[i]);
+                }
+            }
+            else if (matchedBefore)
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    system->OnEntityRemoved(entities[i]);
+                }
+            }
+        }
+    }
+
+    inline void SystemManager::EntitiesDestroyed(const EntityID* entities, std::size_t count,
+                                                 const Signature& signature)
+    {
+        // Only systems the signature matched can hold the entities
+        for (auto& [typeIndex, system] : m_Systems)
+        {
+            auto signatureIt = m_Signatures.find(typeIndex);
+            if (signatureIt != m_Signatures.end() &&
+                (signature & signatureIt->second) != signatureIt->second)
+            {
+                continue;
+            }
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                system->OnEntityRemoved(entities[i]);
+            }
+        }
+    }
+
     inline void SystemManager::InitializeSystems(World& world)
     {
         if (m_Initialized)
@@ -317,13 +428,112 @@ namespace SM
 
     inline void SystemManager::UpdateSystems(World& world, float deltaTime)
     {
+        if (!IsParallelUpdateEnabled())
+        {
+            for (auto* system : m_SystemOrder)
+            {
+                if (system->IsEnabled())
+                {
+                    SM_PROFILE_SCOPE(system->GetName());
+                    system->Update(world, deltaTime);
+                }
+            }
+            return;
+        }
+
+        // Build this frame's dependency graph from the enabled systems
+        m_ScheduledSystems.clear();
         for (auto* system : m_SystemOrder)
         {
             if (system->IsEnabled())
             {
+                m_ScheduledSystems.push_back(system);
+            }
+        }
+
+        const std::uint32_t systemCount = static_cast<std::uint32_t>(m_ScheduledSystems.size());
+        if (systemCount == 0)
+        {
+            return;
+        }
+
+        JobSystem& jobs = JobSystem::Get();
+        JobCounter counter;
+
+        m_ScheduleJobs.clear();
+        m_ScheduleTails.clear();
+        for (auto* system : m_ScheduledSystems)
+        {
+            Job* job = jobs.CreateJob([system, &world, deltaTime]() {
+                SM_PROFILE_SCOPE(system->GetName());
                 system->Update(world, deltaTime);
+            }, &counter);
+
+            m_ScheduleJobs.push_back(job);
+            m_ScheduleTails.push_back(job);
+        }
+
+        for (std::uint32_t i = 0; i < systemCount; ++i)
+        {
+            const SystemAccess& access = m_ScheduledSystems[i]->GetComponentAccess();
+
+            // Earlier (higher priority) conflicting systems must finish first
+            for (std::uint32_t j = 0; j < i; ++j)
+            {
+                if (!access.ConflictsWith(m_ScheduledSystems[j]->GetComponentAccess()))
+                {
+                    continue;
+                }
+
+                // A job holds a fixed number of dependents; chain an empty relay
+                // job into its last slot to fan out further
+                Job*& tail = m_ScheduleTails[j];
+                if (tail->ContinuationCount == Job::MAX_CONTINUATIONS - 1)
+                {
+                    Job* relay = jobs.CreateJob(nullptr, &counter);
+                    jobs.AddDependency(relay, tail);
+                    m_ScheduleJobs.push_back(relay);
+                    tail = relay;
+                }
+
+                jobs.AddDependency(m_ScheduleJobs[i], tail);
             }
         }
+
+        // Every edge is in place, so jobs may start (and be recycled) from here on
+        for (Job* job : m_ScheduleJobs)
+        {
+            jobs.Submit(job);
+        }
+
+        // The calling thread helps run systems until the whole graph is done
+        jobs.Wait(counter);
+    }
+
+    inline bool SystemManager::EnableParallelUpdates()
+    {
+        if (!JobSystem::Get().IsInitialized())
+        {
+            std::cerr << "[SystemManager] Cannot run systems in parallel: job system has no workers" << std::endl;
+            return false;
+        }
+
+        m_ParallelUpdates = true;
+        for (auto* system : m_SystemOrder)
+        {
+            system->SetParallelEnabled(true);
+        }
+
+        return true;
+    }
+
+    inline void SystemManager::DisableParallelUpdates()
+    {
+        m_ParallelUpdates = false;
+        for (auto* system : m_SystemOrder)
+        {
+            system->SetParallelEnabled(false);
+        }
     }
 
     inline void SystemManager::ShutdownSystems(World& world)
@@ -0,0 +1,240 @@
+#include "TransformBatch.h"
+
+#if defined(__AVX2__)
+    #define SM_TRANSFORM_SIMD_WIDTH 8
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define SM_TRANSFORM_SIMD_WIDTH 4
+    #include <emmintrin.h>
+#else
+    #define SM_TRANSFORM_SIMD_WIDTH 1
+#endif
+
+namespace SM
+{
+    namespace
+    {
+        // Minimal lane wrapper so each kernel is written once for every width
+
+#if SM_TRANSFORM_SIMD_WIDTH == 8
+        using VFloat = __m256;
+        inline VFloat Set1(float v) { return _mm256_set1_ps(v); }
+        inline VFloat Load(const float* p) { return _mm256_loadu_ps(p); }
+        inline void Store(float* p, VFloat v) { _mm256_storeu_ps(p, v); }
+        inline VFloat Add(VFloat a, VFloat b) { return _mm256_add_ps(a, b); }
+        inline VFloat Sub(VFloat a, VFloat b) { return _mm256_sub_ps(a, b); }
+        inline VFloat Mul(VFloat a, VFloat b) { return _mm256_mul_ps(a, b); }
+        /// Bit i set when lane i of a >= b
+        inline int CmpGeMask(VFloat a, VFloat b) { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_GE_OQ)); }
+#elif SM_TRANSFORM_SIMD_WIDTH == 4
+        using VFloat = __m128;
+        inline VFloat Set1(float v) { return _mm_set1_ps(v); }
+        inline VFloat Load(const float* p) { return _mm_loadu_ps(p); }
+        inline void Store(float* p, VFloat v) { _mm_storeu_ps(p, v); }
+        inline VFloat Add(VFloat a, VFloat b) { return _mm_add_ps(a, b); }
+        inline VFloat Sub(VFloat a, VFloat b) { return _mm_sub_ps(a, b); }
+        inline VFloat Mul(VFloat a, VFloat b) { return _mm_mul_ps(a, b); }
+        inline int CmpGeMask(VFloat a, VFloat b) { return _mm_movemask_ps(_mm_cmpge_ps(a, b)); }
+#else
+        using VFloat = float;
+        inline VFloat Set1(float v) { return v; }
+        inline VFloat Load(const float* p) { return *p; }
+        inline void Store(float* p, VFloat v) { *p = v; }
+        inline VFloat Add(VFloat a, VFloat b) { return a + b; }
+        inline VFloat Sub(VFloat a, VFloat b) { return a - b; }
+        inline VFloat Mul(VFloat a, VFloat b) { return a * b; }
+        inline int CmpGeMask(VFloat a, VFloat b) { return a >= b ? 1 : 0; }
+#endif
+
+        constexpr std::size_t Width = SM_TRANSFORM_SIMD_WIDTH;
+        constexpr int FullMask = (1 << Width) - 1;
+
+        /**
+         * @brief Load Width lanes starting at offset, zero-padding past count
+         *
+         * Only the tail iteration pays for the copy.
+         */
+        inline VFloat LoadTail(const float* stream, std::size_t offset, std::size_t count)
+        {
+            if (offset + Width <= count)
+            {
+                return Load(stream + offset);
+            }
+
+            float padded[Width] = {};
+            for (std::size_t lane = 0; offset + lane < count; ++lane)
+            {
+                padded[lane] = stream[offset + lane];
+            }
+            return Load(padded);
+        }
+
+        /**
+         * @brief Rotation matrix rows from quaternion lanes (XMMatrixRotationQuaternion layout)
+         */
+        struct RotationRows
+        {
+            VFloat M[3][3];
+        };
+
+        inline RotationRows BuildRotation(VFloat qx, VFloat qy, VFloat qz, VFloat qw)
+        {
+            const VFloat one = Set1(1.0f);
+            const VFloat two = Set1(2.0f);
+
+            VFloat x2 = Mul(qx, two), y2 = Mul(qy, two), z2 = Mul(qz, two);
+            VFloat xx = Mul(qx, x2), yy = Mul(qy, y2), zz = Mul(qz, z2);
+            VFloat xy = Mul(qx, y2), xz = Mul(qx, z2), yz = Mul(qy, z2);
+            VFloat wx = Mul(qw, x2), wy = Mul(qw, y2), wz = Mul(qw, z2);
+
+            RotationRows r;
+            r.M[0][0] = Sub(one, Add(yy, zz));
+            r.M[0][1] = Add(xy, wz);
+            r.M[0][2] = Sub(xz, wy);
+            r.M[1][0] = Sub(xy, wz);
+            r.M[1][1] = Sub(one, Add(xx, zz));
+            r.M[1][2] = Add(yz, wx);
+            r.M[2][0] = Add(xz, wy);
+            r.M[2][1] = Sub(yz, wx);
+            r.M[2][2] = Sub(one, Add(xx, yy));
+            return r;
+        }
+    }
+
+    namespace TransformBatch
+    {
+        int GetSIMDWidth()
+        {
+            return static_cast<int>(Width);
+        }
+
+        void ComposeTRS(const TransformStreams& transforms, DirectX::XMFLOAT4X4* outMatrices)
+        {
+            const std::size_t count = transforms.Size();
+
+            for (std::size_t i = 0; i < count; i += Width)
+            {
+                RotationRows r = BuildRotation(
+                    LoadTail(transforms.RotationX.data(), i, count),
+                    LoadTail(transforms.RotationY.data(), i, count),
+                    LoadTail(transforms.RotationZ.data(), i, count),
+                    LoadTail(transforms.RotationW.data(), i, count));
+
+                // Scale multiplies the rotation rows; translation becomes row 3
+                const VFloat scale[3] = {
+                    LoadTail(transforms.ScaleX.data(), i, count),
+                    LoadTail(transforms.ScaleY.data(), i, count),
+                    LoadTail(transforms.ScaleZ.data(), i, count)
+                };
+
+                // Transpose lanes back to one matrix per entity
+                float lanes[3][3][Width];
+                for (int row = 0; row < 3; ++row)
+                {
+                    for (int column = 0; column < 3; ++column)
+                    {
+                        Store(lanes[row][column], Mul(r.M[row][column], scale[row]));
+                    }
+                }
+
+                const std::size_t laneCount = count - i < Width ? count - i : Width;
+                for (std::size_t lane = 0; lane < laneCount; ++lane)
+                {
+                    const std::size_t index = i + lane;
+                    DirectX::XMFLOAT4X4& m = outMatrices[index];
+                    for (int row = 0; row < 3; ++row)
+                    {
+                        m.m[row][0] = lanes[row][0][lane];
+                        m.m[row][1] = lanes[row][1][lane];
+                        m.m[row][2] = lanes[row][2][lane];
+                        m.m[row][3] = 0.0f;
+                    }
+                    m.m[3][0] = transforms.PositionX[index];
+                    m.m[3][1] = transforms.PositionY[index];
+                    m.m[3][2] = transforms.PositionZ[index];
+                    m.m[3][3] = 1.0f;
+                }
+            }
+        }
+
+        void RotateDirections(const TransformStreams& transforms, float* x, float* y, float* z)
+        {
+            const std::size_t count = transforms.Size();
+            const VFloat two = Set1(2.0f);
+
+            for (std::size_t i = 0; i < count; i += Width)
+            {
+                VFloat qx = LoadTail(transforms.RotationX.data(), i, count);
+                VFloat qy = LoadTail(transforms.RotationY.data(), i, count);
+                VFloat qz = LoadTail(transforms.RotationZ.data(), i, count);
+                VFloat qw = LoadTail(transforms.RotationW.data(), i, count);
+                VFloat vx = LoadTail(x, i, count);
+                VFloat vy = LoadTail(y, i, count);
+                VFloat vz = LoadTail(z, i, count);
+
+                // v + w * t + q x t, with t = 2 * (q x v)
+                VFloat tx = Mul(two, Sub(Mul(qy, vz), Mul(qz, vy)));
+                VFloat ty = Mul(two, Sub(Mul(qz, vx), Mul(qx, vz)));
+                VFloat tz = Mul(two, Sub(Mul(qx, vy), Mul(qy, vx)));
+
+                VFloat rx = Add(Add(vx, Mul(qw, tx)), Sub(Mul(qy, tz), Mul(qz, ty)));
+                VFloat ry = Add(Add(vy, Mul(qw, ty)), Sub(Mul(qz, tx), Mul(qx, tz)));
+                VFloat rz = Add(Add(vz, Mul(qw, tz)), Sub(Mul(qx, ty), Mul(qy, tx)));
+
+                if (i + Width <= count)
+                {
+                    Store(x + i, rx);
+                    Store(y + i, ry);
+                    Store(z + i, rz);
+                    continue;
+                }
+
+                float lanes[3][Width];
+                Store(lanes[0], rx);
+                Store(lanes[1], ry);
+                Store(lanes[2], rz);
+                for (std::size_t lane = 0; i + lane < count; ++lane)
+                {
+                    x[i + lane] = lanes[0][lane];
+                    y[i + lane] = lanes[1][lane];
+                    z[i + lane] = lanes[2][lane];
+                }
+            }
+        }
+
+        std::size_t CullSpheres(const DirectX::XMFLOAT4* planes, int planeCount,
+                                const float* centerX, const float* centerY, const float* centerZ,
+                                const float* radius, std::size_t count, std::uint8_t* outVisible)
+        {
+            std::size_t visibleCount = 0;
+
+            for (std::size_t i = 0; i < count; i += Width)
+            {
+                VFloat cx = LoadTail(centerX, i, count);
+                VFloat cy = LoadTail(centerY, i, count);
+                VFloat cz = LoadTail(centerZ, i, count);
+                VFloat negRadius = Sub(Set1(0.0f), LoadTail(radius, i, count));
+
+                // Inside every plane: dot(n, c) + d >= -r
+                int inside = FullMask;
+                for (int p = 0; p < planeCount && inside != 0; ++p)
+                {
+                    const DirectX::XMFLOAT4& plane = planes[p];
+                    VFloat distance = Add(Add(Mul(cx, Set1(plane.x)), Mul(cy, Set1(plane.y))),
+                                          Add(Mul(cz, Set1(plane.z)), Set1(plane.w)));
+                    inside &= CmpGeMask(distance, negRadius);
+                }
+
+                for (std::size_t lane = 0; lane < Width && i + lane < count; ++lane)
+                {
+                    std::uint8_t visible = (inside >> lane) & 1;
+                    outVisible[i + lane] = visible;
+                    visibleCount += visible;
+                }
+            }
+
+            return visibleCount;
+        }
+    }
+
+} // namespace SM
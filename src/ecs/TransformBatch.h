@@ -0,0 +1,126 @@
+#pragma once
+
+/**
+ * @file TransformBatch.h
+ * @brief SoA transform streams and SIMD kernels that process them in bulk
+ *
+ * Vector3 and Quaternion are convenient per-entity types, but every helper
+ * on them converts through XMFLOAT3/XMFLOAT4 one entity at a time. Systems
+ * that touch many transforms per frame gather them into TransformStreams
+ * (one float array per component) and run the kernels below, which handle
+ * 8 entities per instruction with AVX2, 4 with SSE2 and fall back to
+ * scalar code elsewhere. Results match the per-entity helpers
+ * (TransformComponent::GetLocalMatrix, Quaternion::Rotate).
+ */
+
+#include "components/TransformComponent.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+#include <DirectXMath.h>
+
+namespace SM
+{
+    // ============================================================================
+    // TransformStreams
+    // ============================================================================
+
+    /**
+     * @brief Positions, rotations and scales stored as one array per component
+     *
+     * Reuse one instance across frames; Clear keeps the capacity.
+     */
+    struct TransformStreams
+    {
+        std::vector<float> PositionX, PositionY, PositionZ;
+        std::vector<float> RotationX, RotationY, RotationZ, RotationW;
+        std::vector<float> ScaleX, ScaleY, ScaleZ;
+
+        std::size_t Size() const { return PositionX.size(); }
+
+        void Clear()
+        {
+            ForEachStream([](std::vector<float>& stream) { stream.clear(); });
+        }
+
+        void Reserve(std::size_t count)
+        {
+            ForEachStream([count](std::vector<float>& stream) { stream.reserve(count); });
+        }
+
+        /**
+         * @brief Append one transform
+         */
+        void Push(const TransformComponent& transform)
+        {
+            PositionX.push_back(transform.Position.x);
+            PositionY.push_back(transform.Position.y);
+            PositionZ.push_back(transform.Position.z);
+            RotationX.push_back(transform.Rotation.x);
+            RotationY.push_back(transform.Rotation.y);
+            RotationZ.push_back(transform.Rotation.z);
+            RotationW.push_back(transform.Rotation.w);
+            ScaleX.push_back(transform.Scale.x);
+            ScaleY.push_back(transform.Scale.y);
+            ScaleZ.push_back(transform.Scale.z);
+        }
+
+    private:
+        template<typename Func>
+        void ForEachStream(Func&& func)
+        {
+            for (std::vector<float>* stream : { &PositionX, &PositionY, &PositionZ,
+                                                &RotationX, &RotationY, &RotationZ, &RotationW,
+                                                &ScaleX, &ScaleY, &ScaleZ })
+            {
+                func(*stream);
+            }
+        }
+    };
+
+    // ============================================================================
+    // Kernels
+    // ============================================================================
+
+    namespace TransformBatch
+    {
+        /**
+         * @brief Lanes processed per instruction by this build (8, 4 or 1)
+         */
+        int GetSIMDWidth();
+
+        /**
+         * @brief Build scale * rotation * translation matrices
+         * @param transforms Source streams
+         * @param outMatrices Receives transforms.Size() row-vector matrices
+         *
+         * Same layout as TransformComponent::GetLocalMatrix.
+         */
+        void ComposeTRS(const TransformStreams& transforms, DirectX::XMFLOAT4X4* outMatrices);
+
+        /**
+         * @brief Rotate one direction stream by each entity's rotation
+         * @param transforms Rotations to apply (positions and scales are ignored)
+         * @param x, y, z Directions, one per transform; rotated in place
+         *
+         * Same result as Quaternion::Rotate, e.g. for batched GetForward.
+         */
+        void RotateDirections(const TransformStreams& transforms, float* x, float* y, float* z);
+
+        /**
+         * @brief Test bounding spheres against a set of inward-facing planes
+         * @param planes Planes as (normal.xyz, distance), e.g. Frustum::GetPlane
+         * @param planeCount Number of planes
+         * @param centerX, centerY, centerZ, radius Sphere streams
+         * @param count Number of spheres
+         * @param outVisible Receives 1 for spheres at least partially inside, else 0
+         * @return Number of visible spheres
+         */
+        std::size_t CullSpheres(const DirectX::XMFLOAT4* planes, int planeCount,
+                                const float* centerX, const float* centerY, const float* centerZ,
+                                const float* radius, std::size_t count, std::uint8_t* outVisible);
+    }
+
+} // namespace SM
@@ -1,6 +1,9 @@
 #include "World.h"
 #include "components/Components.h"
 
+#include <algorithm>
+#include <unordered_map>
+
 namespace SM
 {
     EntityID World::CreateEntity(const std::string& name)
@@ -18,20 +21,263 @@ namespace SM
         return entity;
     }
 
-    EntityID World::FindEntityByName(const std::string& name) const
+    std::vector<EntityID> World::CreateEntities(std::uint32_t count, const EntityPrefab& prefab)
     {
-        if (!m_ComponentManager.IsComponentRegistered<TagComponent>())
+        const Signature signature = prefab.GetSignature(m_ComponentManager);
+
+        std::vector<EntityID> entities(count);
+        std::uint32_t created = m_EntityManager.CreateEntities(count, entities.data(), signature);
+        entities.resize(created);
+
+        if (entities.empty() || prefab.m_Components.empty())
         {
-            return INVALID_ENTITY;
+            return entities;
         }
 
-        for (EntityID entity = 0; entity < MAX_ENTITIES; ++entity)
+        if (m_ComponentManager.GetStorageMode() == ComponentStorageMode::Archetype)
         {
-            if (!m_EntityManager.IsAlive(entity))
+            std::size_t firstRow = 0;
+            Archetype& archetype = m_ComponentManager.GetArchetypeStorage().AddEntities(
+                entities.data(), entities.size(), signature, firstRow);
+
+            for (const EntityPrefab::Entry& entry : prefab.m_Components)
+            {
+                const ComponentType type = entry.Ops->GetType(m_ComponentManager);
+                for (std::size_t i = 0; i < entities.size(); ++i)
+                {
+                    entry.Ops->CopyConstruct(archetype.GetComponent(type, firstRow + i), entry.Value.get());
+                }
+            }
+        }
+        else
+        {
+            for (const EntityPrefab::Entry& entry : prefab.m_Components)
+            {
+                entry.Ops->InsertCopies(m_ComponentManager, entities.data(), entities.size(), entry.Value.get());
+            }
+        }
+
+        EntitiesCreated(entities.data(), entities.size(), signature);
+        return entities;
+    }
+
+    void World::Playback(EntityCommandBuffer& buffer)
+    {
+        using Command = EntityCommandBuffer::Command;
+        using CommandType = EntityCommandBuffer::CommandType;
+
+        static_assert(MAX_COMPONENTS <= 64, "Signatures are grouped by their 64-bit value");
+
+        if (buffer.IsEmpty())
+        {
+            return;
+        }
+
+        // One record per entity touched by the buffer
+        struct Change
+        {
+            EntityID Entity = INVALID_ENTITY;
+            Signature Before;           ///< Signature before playback (empty if created)
+            bool Created = false;
+            bool Destroyed = false;
+        };
+
+        std::vector<Change> changes;
+        std::unordered_map<EntityID, std::size_t> changeIndex;
+
+        auto touch = [&](EntityID entity, bool created) -> Change& {
+            auto [it, inserted] = changeIndex.try_emplace(entity, changes.size());
+            if (inserted)
+            {
+                Change change;
+                change.Entity = entity;
+                change.Created = created;
+                if (!created)
+                {
+                    change.Before = m_EntityManager.GetSignature(entity);
+                }
+                changes.push_back(change);
+            }
+            return changes[it->second];
+        };
+
+        // Create every pending entity first, so commands may reference
+        // entities created by any stream
+        for (auto& stream : buffer.m_Streams)
+        {
+            stream->Created.clear();
+            stream->Created.reserve(stream->CreateCount);
+
+            for (const Command& command : stream->Commands)
+            {
+                if (command.Type != CommandType::Create)
+                {
+                    continue;
+                }
+
+                EntityID entity = m_EntityManager.CreateEntity();
+                stream->Created.push_back(entity);
+                if (entity != INVALID_ENTITY)
+                {
+                    touch(entity, true);
+                }
+            }
+        }
+
+        // Apply component data and signatures without notifying anyone. Dead
+        // entities are destroyed in the entity manager only after systems and
+        // queries have dropped them, so no slot is reused mid-playback.
+        for (auto& stream : buffer.m_Streams)
+        {
+            for (const Command& command : stream->Commands)
+            {
+                if (command.Type == CommandType::Create)
+                {
+                    continue;
+                }
+
+                EntityID entity = buffer.GetTarget(command);
+                if (entity == INVALID_ENTITY || !m_EntityManager.IsAlive(entity))
+                {
+                    continue;
+                }
+
+                Change& change = touch(entity, false);
+                if (change.Destroyed)
+                {
+                    continue;
+                }
+
+                switch (command.Type)
+                {
+                case CommandType::Destroy:
+                    change.Destroyed = true;
+                    m_ComponentManager.EntityDestroyed(entity);
+                    break;
+
+                case CommandType::AddComponent:
+                {
+                    command.Ops->Add(m_ComponentManager, entity, command.Payload);
+                    Signature signature = m_EntityManager.GetSignature(entity);
+                    signature.set(command.Ops->GetType(m_ComponentManager), true);
+                    m_EntityManager.SetSignature(entity, signature);
+                    break;
+                }
+
+                case CommandType::RemoveComponent:
+                {
+                    command.Ops->Remove(m_ComponentManager, entity);
+                    Signature signature = m_EntityManager.GetSignature(entity);
+                    signature.set(command.Ops->GetType(m_ComponentManager), false);
+                    m_EntityManager.SetSignature(entity, signature);
+                    break;
+                }
+
+                default:
+                    break;
+                }
+            }
+        }
+
+        // Group entities by (kind, before, after) so each group is one
+        // notification pass over the systems and queries
+        struct Transition
+        {
+            std::uint64_t Before = 0;
+            std::uint64_t After = 0;
+            bool Destroyed = false;
+            EntityID Entity = INVALID_ENTITY;
+        };
+
+        std::vector<Transition> transitions;
+        std::vector<EntityID> destroyed;
+        transitions.reserve(changes.size());
+
+        for (const Change& change : changes)
+        {
+            if (change.Destroyed)
+            {
+                destroyed.push_back(change.Entity);
+
+                // Entities created in this playback were never in a system
+                if (!change.Created)
+                {
+                    transitions.push_back({ change.Before.to_ullong(), 0, true, change.Entity });
+                }
+                continue;
+            }
+
+            Signature after = m_EntityManager.GetSignature(change.Entity);
+
+            // CreateEntity alone does not notify; neither does a net no-op
+            if ((change.Created && after.none()) || (!change.Created && after == change.Before))
             {
                 continue;
             }
 
+            transitions.push_back({ change.Before.to_ullong(), after.to_ullong(), false, change.Entity });
+        }
+
+        std::sort(transitions.begin(), transitions.end(), [](const Transition& a, const Transition& b) {
+            if (a.Destroyed != b.Destroyed) return a.Destroyed < b.Destroyed;
+            if (a.Before != b.Before) return a.Before < b.Before;
+            return a.After < b.After;
+        });
+
+        std::vector<EntityID> group;
+        for (std::size_t begin = 0; begin < transitions.size();)
+        {
+            const Transition& first = transitions[begin];
+
+            group.clear();
+            std::size_t end = begin;
+            while (end < transitions.size() && transitions[end].Destroyed == first.Destroyed &&
+                   transitions[end].Before == first.Before && transitions[end].After == first.After)
+            {
+                group.push_back(transitions[end].Entity);
+                ++end;
+            }
+
+            const Signature before(first.Before);
+            const Signature after(first.After);
+            if (first.Destroyed)
+            {
+                m_SystemManager.EntitiesDestroyed(group.data(), group.size(), before);
+                for (QueryBase* query : m_QueryList)
+                {
+                    query->EntitiesDestroyed(group.data(), group.size(), before);
+                }
+            }
+            else
+            {
+                m_SystemManager.EntitiesSignatureChanged(group.data(), group.size(), before, after);
+                for (QueryBase* query : m_QueryList)
+                {
+                    query->EntitiesSignatureChanged(group.data(), group.size(), before, after);
+                }
+            }
+
+            begin = end;
+        }
+
+        for (EntityID entity : destroyed)
+        {
+            m_EntityManager.DestroyEntity(entity);
+        }
+
+        // Payloads were moved from; destroy them and keep the resolved IDs
+        buffer.ClearCommands();
+    }
+
+    EntityID World::FindEntityByName(const std::string& name) const
+    {
+        if (!m_ComponentManager.IsComponentRegistered<TagComponent>())
+        {
+            return INVALID_ENTITY;
+        }
+
+        for (EntityID entity : GetQuery<TagComponent>().GetEntities())
+        {
             const TagComponent* tag = m_ComponentManager.TryGetComponent<TagComponent>(entity);
             if (tag && tag->Name == name)
             {
@@ -51,13 +297,8 @@ namespace SM
             return result;
         }
 
-        for (EntityID entity = 0; entity < MAX_ENTITIES; ++entity)
+        for (EntityID entity : GetQuery<TagComponent>().GetEntities())
         {
-            if (!m_EntityManager.IsAlive(entity))
-            {
-                continue;
-            }
-
             const TagComponent* tagComp = m_ComponentManager.TryGetComponent<TagComponent>(entity);
             if (tagComp && tagComp->HasTag(tag))
             {
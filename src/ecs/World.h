@@ -13,9 +13,19 @@
 #include "ComponentManager.h"
 #include "System.h"
 #include "SystemManager.h"
+#include "Query.h"
+#include "EntityCommandBuffer.h"
+#include "EntityPrefab.h"
 
+#include <cassert>
+#include <cstdint>
 #include <memory>
 #include <functional>
+#include <span>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
 
 namespace SM
 {
@@ -51,7 +61,15 @@ namespace SM
     class World
     {
     public:
-        World();
+        /**
+         * @brief Construct a world
+         * @param storageMode Backend used for component data
+         *
+         * Archetype mode groups entities with the same signature into
+         * chunked SoA blocks, which makes multi-component ForEach walk
+         * memory in order. The component API is identical in both modes.
+         */
+        explicit World(ComponentStorageMode storageMode = ComponentStorageMode::Sparse);
         ~World();
 
         // Prevent copying
@@ -79,6 +97,30 @@ namespace SM
          */
         EntityID CreateEntity(const std::string& name);
 
+        /**
+         * @brief Create many entities with copies of a prefab's components
+         * @param count Number of entities to create
+         * @param prefab Component values given to every entity
+         * @return The new entities (fewer than count only if IDs run out)
+         *
+         * IDs are reserved in bulk, components are stored contiguously, and
+         * system and query membership is computed once for the whole batch.
+         */
+        std::vector<EntityID> CreateEntities(std::uint32_t count, const EntityPrefab& prefab);
+
+        /**
+         * @brief Create one entity per element, moving components from parallel arrays
+         * @tparam Ts The component types (distinct)
+         * @param components One span per type, all the same length (moved from)
+         * @return The new entities; entity i receives element i of every span
+         *
+         * @code
+         * world.SpawnBatch(std::span(transforms), std::span(meshes));
+         * @endcode
+         */
+        template<typename... Ts>
+        std::vector<EntityID> SpawnBatch(std::span<Ts>... components);
+
         /**
          * @brief Destroy an entity and all its components
          * @param entity The entity to destroy
@@ -98,6 +140,11 @@ namespace SM
          */
         std::uint32_t GetEntityCount() const;
 
+        /**
+         * @brief Get every living entity, densely packed (see EntityManager::GetLivingEntities)
+         */
+        const std::vector<EntityID>& GetLivingEntities() const { return m_EntityManager.GetLivingEntities(); }
+
         // ====================================================================
         // Component Operations
         // ====================================================================
@@ -178,6 +225,84 @@ namespace SM
         template<typename T>
         ComponentType GetComponentType() const;
 
+        /**
+         * @brief Build a signature containing the given component types
+         * @tparam Ts The component types
+         * @return Signature with one bit set per type
+         *
+         * Convenient for SetSystemSignature and ISystem::SetComponentAccess.
+         */
+        template<typename... Ts>
+        Signature MakeSignature() const;
+
+        // ====================================================================
+        // Deferred Structural Changes
+        // ====================================================================
+
+        /**
+         * @brief Get the world's own command buffer
+         *
+         * Systems running on worker threads record entity and component
+         * changes here instead of calling CreateEntity, AddComponent, etc.
+         * The buffer is played back at the end of Update.
+         */
+        EntityCommandBuffer& GetCommandBuffer() { return *m_CommandBuffer; }
+
+        /**
+         * @brief Apply and clear a command buffer
+         * @param buffer Buffer to play back (no thread may be recording into it)
+         *
+         * Component data is applied command by command; system and query
+         * membership is then updated once per group of entities sharing the
+         * same signature transition, so spawning or despawning many
+         * entities costs one pass over the systems per group.
+         */
+        void Playback(EntityCommandBuffer& buffer);
+
+        /**
+         * @brief Play back the world's own command buffer
+         */
+        void FlushCommands() { Playback(*m_CommandBuffer); }
+
+        // ====================================================================
+        // Snapshots
+        // ====================================================================
+
+        /**
+         * @brief Serialize all entities and components into a binary snapshot
+         * @param outData Receives the snapshot bytes
+         * @return true on success
+         *
+         * Trivially copyable components are written as one block per type;
+         * others use their ComponentSerializer<T>, and types with neither
+         * are left out. Systems and queries are not part of the snapshot.
+         */
+        bool SaveSnapshot(std::vector<std::uint8_t>& outData) const;
+
+        /**
+         * @brief Replace all entities and components with a snapshot
+         * @param data Snapshot bytes (may point into a mapped file)
+         * @param size Size in bytes
+         * @return true on success. A malformed snapshot is rejected before the
+         *         world changes; only a ComponentSerializer payload that fails to
+         *         decode leaves the world empty.
+         *
+         * Entities get back their saved IDs. Component types are matched by
+         * name, so they must be registered (in any order) before loading.
+         * Registered systems and cached queries are kept and repopulated.
+         */
+        bool LoadSnapshot(const std::uint8_t* data, std::size_t size);
+
+        /**
+         * @brief Write a snapshot to a file
+         */
+        bool SaveSnapshotToFile(const std::string& path) const;
+
+        /**
+         * @brief Load a snapshot by memory-mapping a file
+         */
+        bool LoadSnapshotFromFile(const std::string& path);
+
         // ====================================================================
         // System Operations
         // ====================================================================
@@ -242,12 +367,30 @@ namespace SM
         // ====================================================================
 
         /**
-         * @brief Iterate over all entities with specific components
+         * @brief Get the cached query for a set of components
          * @tparam Components The component types required
-         * @param callback Function called for each matching entity
+         * @return Query kept current as entity signatures change
+         *
+         * The query is created (and filled from existing entities) on first
+         * use; later calls return the same object. Components must be
+         * registered before their first query.
          */
         template<typename... Components>
-        void ForEach(std::function<void(EntityID, Components&...)> callback);
+        Query<Components...>& GetQuery();
+
+        template<typename... Components>
+        const Query<Components...>& GetQuery() const;
+
+        /**
+         * @brief Iterate over all entities with specific components
+         * @tparam Components The component types required
+         * @param callback Callable invoked as callback(EntityID, Components&...)
+         *
+         * Uses the cached query, so cost scales with the number of matching
+         * entities rather than MAX_ENTITIES.
+         */
+        template<typename... Components, typename Func>
+        void ForEach(Func&& callback);
 
         /**
          * @brief Get a view of entities with specific components
@@ -303,17 +446,48 @@ namespace SM
          */
         void UpdateEntitySignature(EntityID entity);
 
+        /**
+         * @brief Add freshly created entities that share a signature to systems and queries
+         */
+        void EntitiesCreated(const EntityID* entities, std::size_t count, const Signature& signature);
+
+        /**
+         * @brief Remove living entities from systems and queries, batched by signature
+         */
+        void NotifyAllEntitiesRemoved();
+
+        /**
+         * @brief Add living entities to systems and queries, batched by signature
+         */
+        void NotifyAllEntitiesAdded();
+
+        /**
+         * @brief Find or create a cached query (shared by const and non-const paths)
+         */
+        template<typename... Components>
+        Query<Components...>& GetOrCreateQuery() const;
+
         EntityManager m_EntityManager;
         ComponentManager m_ComponentManager;
         SystemManager m_SystemManager;
         bool m_SystemsInitialized = false;
+
+        // Cached queries are created lazily, including from const lookups
+        mutable std::unordered_map<std::type_index, std::unique_ptr<QueryBase>> m_Queries;
+        mutable std::vector<QueryBase*> m_QueryList;
+
+        /** Changes recorded by systems, played back after each Update */
+        std::unique_ptr<EntityCommandBuffer> m_CommandBuffer = std::make_unique<EntityCommandBuffer>();
     };
 
     // ============================================================================
     // World Implementation
     // ============================================================================
 
-    inline World::World() = default;
+    inline World::World(ComponentStorageMode storageMode)
+        : m_ComponentManager(storageMode)
+    {
+    }
 
     inline World::~World()
     {
@@ -335,8 +509,12 @@ namespace SM
             return;
         }
 
-        // Notify systems first
+        // Notify systems and queries first
         m_SystemManager.EntityDestroyed(entity);
+        for (QueryBase* query : m_QueryList)
+        {
+            query->EntityDestroyed(entity);
+        }
 
         // Then notify component manager to clean up component data
         m_ComponentManager.EntityDestroyed(entity);
@@ -367,6 +545,9 @@ namespace SM
     inline void World::Update(float deltaTime)
     {
         m_SystemManager.UpdateSystems(*this, deltaTime);
+
+        // All systems have finished; apply what they recorded
+        FlushCommands();
     }
 
     inline void World::ShutdownSystems()
@@ -382,6 +563,9 @@ namespace SM
     {
         ShutdownSystems();
         m_SystemManager.Reset();
+        m_QueryList.clear();
+        m_Queries.clear();
+        m_CommandBuffer->Reset();
         m_ComponentManager.Reset();
         m_EntityManager.Reset();
     }
@@ -390,6 +574,26 @@ namespace SM
     {
         Signature signature = m_EntityManager.GetSignature(entity);
         m_SystemManager.EntitySignatureChanged(entity, signature);
+
+        for (QueryBase* query : m_QueryList)
+        {
+            query->EntitySignatureChanged(entity, signature);
+        }
+    }
+
+    inline void World::EntitiesCreated(const EntityID* entities, std::size_t count, const Signature& signature)
+    {
+        // Like CreateEntity, an entity without components is not announced
+        if (count == 0 || signature.none())
+        {
+            return;
+        }
+
+        m_SystemManager.EntitiesSignatureChanged(entities, count, Signature(), signature);
+        for (QueryBase* query : m_QueryList)
+        {
+            query->EntitiesSignatureChanged(entities, count, Signature(), signature);
+        }
     }
 
     // Template implementations
@@ -410,8 +614,33 @@ namespace SM
         signature.set(m_ComponentManager.GetComponentType<T>(), true);
         m_EntityManager.SetSignature(entity, signature);
 
-        // Notify systems
-        m_SystemManager.EntitySignatureChanged(entity, signature);
+        // Notify systems and queries
+        UpdateEntitySignature(entity);
+    }
+
+    template<typename... Ts>
+    std::vector<EntityID> World::SpawnBatch(std::span<Ts>... components)
+    {
+        static_assert(sizeof...(Ts) > 0, "SpawnBatch needs at least one component type");
+
+        const std::size_t sizes[] = { components.size()... };
+        const std::size_t count = sizes[0];
+        for (std::size_t size : sizes)
+        {
+            assert(size == count && "SpawnBatch spans must have the same length");
+            (void)size;
+        }
+
+        Signature signature = MakeSignature<Ts...>();
+
+        std::vector<EntityID> entities(count);
+        std::uint32_t created = m_EntityManager.CreateEntities(static_cast<std::uint32_t>(count), entities.data(), signature);
+        entities.resize(created);
+
+        m_ComponentManager.AddComponentBatch<Ts...>(entities.data(), entities.size(), components.data()...);
+        EntitiesCreated(entities.data(), entities.size(), signature);
+
+        return entities;
     }
 
     template<typename T>
@@ -424,8 +653,8 @@ namespace SM
         signature.set(m_ComponentManager.GetComponentType<T>(), false);
         m_EntityManager.SetSignature(entity, signature);
 
-        // Notify systems
-        m_SystemManager.EntitySignatureChanged(entity, signature);
+        // Notify systems and queries
+        UpdateEntitySignature(entity);
     }
 
     template<typename T>
@@ -464,6 +693,14 @@ namespace SM
         return m_ComponentManager.GetComponentType<T>();
     }
 
+    template<typename... Ts>
+    Signature World::MakeSignature() const
+    {
+        Signature signature;
+        (signature.set(m_ComponentManager.GetComponentType<Ts>(), true), ...);
+        return signature;
+    }
+
     template<typename T, typename... Args>
     T* World::RegisterSystem(Args&&... args)
     {
@@ -483,48 +720,52 @@ namespace SM
     }
 
     template<typename... Components>
-    void World::ForEach(std::function<void(EntityID, Components&...)> callback)
+    Query<Components...>& World::GetOrCreateQuery() const
     {
-        // Get all entities and check if they have all required components
-        for (EntityID entity = 0; entity < MAX_ENTITIES; ++entity)
+        std::type_index typeIndex = std::type_index(typeid(Query<Components...>));
+
+        auto it = m_Queries.find(typeIndex);
+        if (it != m_Queries.end())
         {
-            if (!m_EntityManager.IsAlive(entity))
-            {
-                continue;
-            }
-
-            // Check if entity has all required components
-            bool hasAll = (m_ComponentManager.HasComponent<Components>(entity) && ...);
-
-            if (hasAll)
-            {
-                callback(entity, m_ComponentManager.GetComponent<Components>(entity)...);
-            }
+            return *static_cast<Query<Components...>*>(it->second.get());
         }
+
+        auto query = std::make_unique<Query<Components...>>(m_ComponentManager);
+        Query<Components...>* rawPtr = query.get();
+
+        // Fill from existing entities (one-time scan)
+        m_EntityManager.ForEachLivingEntity([&](EntityID entity) {
+            rawPtr->EntitySignatureChanged(entity, m_EntityManager.GetSignature(entity));
+        });
+
+        m_Queries[typeIndex] = std::move(query);
+        m_QueryList.push_back(rawPtr);
+
+        return *rawPtr;
     }
 
     template<typename... Components>
-    std::vector<EntityID> World::GetEntitiesWith() const
+    Query<Components...>& World::GetQuery()
     {
-        std::vector<EntityID> result;
+        return GetOrCreateQuery<Components...>();
+    }
 
-        for (EntityID entity = 0; entity < MAX_ENTITIES; ++entity)
-        {
-            if (!m_EntityManager.IsAlive(entity))
-            {
-                continue;
-            }
-
-            // Check if entity has all required components
-            bool hasAll = (m_ComponentManager.HasComponent<Components>(entity) && ...);
-
-            if (hasAll)
-            {
-                result.push_back(entity);
-            }
-        }
+    template<typename... Components>
+    const Query<Components...>& World::GetQuery() const
+    {
+        return GetOrCreateQuery<Components...>();
+    }
+
+    template<typename... Components, typename Func>
+    void World::ForEach(Func&& callback)
+    {
+        GetQuery<Components...>().ForEach(m_ComponentManager, callback);
+    }
 
-        return result;
+    template<typename... Components>
+    std::vector<EntityID> World::GetEntitiesWith() const
+    {
+        return GetQuery<Components...>().GetEntities();
     }
 
 } // namespace SM
@@ -0,0 +1,439 @@
+/**
+ * @file WorldSnapshot.cpp
+ * @brief Binary snapshots of World entities and components
+ *
+ * Layout (native byte order):
+ *
+ *   Header     magic "SMWS", version, slot count, living count, section count
+ *   Slots      u32 version[slots], u8 alive[slots], u64 signature[slots]
+ *   Sections   one per serializable component type:
+ *                name (u32 length + bytes), saved type ID (u8), sizeof (u32), raw (u8),
+ *                owner count (u32), owner IDs (u32 each),
+ *                payload size (u64), payload
+ *
+ * Signatures use the component type IDs of the saving process; sections map
+ * them to the loading process's IDs by name. Sections for unregistered or
+ * changed types are skipped and their bits cleared.
+ */
+
+#include "World.h"
+#include "core/FileSystem.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace SM
+{
+    namespace
+    {
+        constexpr std::uint32_t SNAPSHOT_MAGIC = 0x53574D53;   ///< "SMWS"
+        constexpr std::uint32_t SNAPSHOT_VERSION = 1;
+        constexpr ComponentType UNMAPPED_TYPE = 0xFF;
+
+        static_assert(MAX_COMPONENTS <= 64, "Snapshot signatures are stored as 64-bit masks");
+        static_assert(MAX_COMPONENTS < UNMAPPED_TYPE, "UNMAPPED_TYPE must not be a valid component type");
+
+        /**
+         * @brief Parsed component section of a snapshot being loaded
+         */
+        struct SnapshotSection
+        {
+            std::string Name;
+            ComponentType SavedType = 0;
+            ComponentType Type = UNMAPPED_TYPE;     ///< Type ID in this process
+            std::uint32_t Count = 0;
+            const std::uint8_t* Entities = nullptr; ///< Unaligned owner IDs
+            const std::uint8_t* Payload = nullptr;
+            std::uint64_t PayloadSize = 0;
+        };
+
+        /**
+         * @brief Invoke func(entities, count, signature) once per group of equal signatures
+         */
+        template<typename Func>
+        void ForEachSignatureGroup(const EntityManager& entityManager, Func&& func)
+        {
+            std::vector<std::pair<std::uint64_t, EntityID>> sorted;
+            sorted.reserve(entityManager.GetLivingEntityCount());
+            for (EntityID entity : entityManager.GetLivingEntities())
+            {
+                sorted.emplace_back(entityManager.GetSignature(entity).to_ullong(), entity);
+            }
+            std::sort(sorted.begin(), sorted.end());
+
+            std::vector<EntityID> group;
+            for (std::size_t begin = 0; begin < sorted.size();)
+            {
+                group.clear();
+                std::size_t end = begin;
+                while (end < sorted.size() && sorted[end].first == sorted[begin].first)
+                {
+                    group.push_back(sorted[end].second);
+                    ++end;
+                }
+
+                func(group.data(), group.size(), Signature(sorted[begin].first));
+                begin = end;
+            }
+        }
+    }
+
+    // ============================================================================
+    // Save
+    // ============================================================================
+
+    bool World::SaveSnapshot(std::vector<std::uint8_t>& outData) const
+    {
+        const std::uint32_t slotCount = m_EntityManager.GetSlotCount();
+
+        std::vector<std::uint32_t> versions(slotCount);
+        std::vector<std::uint8_t> alive(slotCount);
+        std::vector<std::uint64_t> signatures(slotCount, 0);
+        for (std::uint32_t index = 0; index < slotCount; ++index)
+        {
+            versions[index] = m_EntityManager.GetSlotVersion(index);
+            alive[index] = m_EntityManager.IsSlotAlive(index) ? 1 : 0;
+            if (alive[index])
+            {
+                signatures[index] = m_EntityManager.GetSignature(MakeEntityID(index, versions[index])).to_ullong();
+            }
+        }
+
+        SnapshotWriter writer;
+        writer.Reserve(static_cast<std::size_t>(slotCount) * 64);
+
+        writer.WriteValue(SNAPSHOT_MAGIC);
+        writer.WriteValue(SNAPSHOT_VERSION);
+        writer.WriteValue(slotCount);
+        writer.WriteValue(m_EntityManager.GetLivingEntityCount());
+        const std::size_t sectionCountOffset = writer.GetSize();
+        writer.WriteValue(std::uint32_t(0));
+
+        writer.Write(versions.data(), versions.size() * sizeof(std::uint32_t));
+        writer.Write(alive.data(), alive.size());
+        writer.Write(signatures.data(), signatures.size() * sizeof(std::uint64_t));
+
+        std::uint32_t sectionCount = 0;
+        for (std::size_t type = 0; type < MAX_COMPONENTS; ++type)
+        {
+            const ComponentSnapshotOps* ops = m_ComponentManager.GetSnapshotOps(static_cast<ComponentType>(type));
+            if (!ops)
+            {
+                continue;
+            }
+
+            if (!ops->Serializable)
+            {
+                std::cerr << "[World] Snapshot skips component " << ops->Name
+                          << " (not trivially copyable and no ComponentSerializer)" << std::endl;
+                continue;
+            }
+
+            writer.WriteString(ops->Name);
+            writer.WriteValue(static_cast<ComponentType>(type));
+            writer.WriteValue(ops->Size);
+            writer.WriteValue(static_cast<std::uint8_t>(ops->Raw ? 1 : 0));
+            ops->Save(m_ComponentManager, static_cast<ComponentType>(type), writer);
+            ++sectionCount;
+        }
+
+        writer.Patch(sectionCountOffset, sectionCount);
+        outData = std::move(writer.GetData());
+        return true;
+    }
+
+    bool World::SaveSnapshotToFile(const std::string& path) const
+    {
+        std::vector<std::uint8_t> data;
+        if (!SaveSnapshot(data))
+        {
+            return false;
+        }
+
+        if (!FileSystem::WriteFile(path, data))
+        {
+            std::cerr << "[World] Failed to write snapshot: " << path << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    // ============================================================================
+    // Load
+    // ============================================================================
+
+    bool World::LoadSnapshot(const std::uint8_t* data, std::size_t size)
+    {
+        SnapshotReader reader(data, size);
+
+        std::uint32_t magic = 0, version = 0, slotCount = 0, livingCount = 0, sectionCount = 0;
+        reader.ReadValue(magic);
+        reader.ReadValue(version);
+        reader.ReadValue(slotCount);
+        reader.ReadValue(livingCount);
+        reader.ReadValue(sectionCount);
+        if (reader.HasFailed() || magic != SNAPSHOT_MAGIC)
+        {
+            std::cerr << "[World] Not a world snapshot" << std::endl;
+            return false;
+        }
+        if (version != SNAPSHOT_VERSION)
+        {
+            std::cerr << "[World] Unsupported snapshot version " << version << std::endl;
+            return false;
+        }
+        if (slotCount > MAX_ENTITIES)
+        {
+            std::cerr << "[World] Snapshot has too many entity slots" << std::endl;
+            return false;
+        }
+
+        const std::uint8_t* versionBytes = reader.Skip(static_cast<std::size_t>(slotCount) * sizeof(std::uint32_t));
+        const std::uint8_t* alive = reader.Skip(slotCount);
+        const std::uint8_t* signatureBytes = reader.Skip(static_cast<std::size_t>(slotCount) * sizeof(std::uint64_t));
+
+        // Parse and validate every section before touching the world
+        std::vector<SnapshotSection> sections;
+        sections.reserve(std::min<std::uint32_t>(sectionCount, MAX_COMPONENTS));
+        std::array<ComponentType, MAX_COMPONENTS> remap;
+        remap.fill(UNMAPPED_TYPE);
+        Signature savedTypesSeen;
+        Signature typesSeen;
+
+        for (std::uint32_t i = 0; i < sectionCount && !reader.HasFailed(); ++i)
+        {
+            SnapshotSection section;
+            std::uint32_t elementSize = 0;
+            std::uint8_t raw = 0;
+
+            reader.ReadString(section.Name);
+            reader.ReadValue(section.SavedType);
+            reader.ReadValue(elementSize);
+            reader.ReadValue(raw);
+            reader.ReadValue(section.Count);
+            section.Entities = reader.Skip(static_cast<std::size_t>(section.Count) * sizeof(EntityID));
+            reader.ReadValue(section.PayloadSize);
+            section.Payload = reader.Skip(static_cast<std::size_t>(section.PayloadSize));
+
+            if (reader.HasFailed())
+            {
+                break;
+            }
+            if (section.SavedType >= MAX_COMPONENTS || savedTypesSeen.test(section.SavedType))
+            {
+                std::cerr << "[World] Snapshot has an invalid component section" << std::endl;
+                return false;
+            }
+            savedTypesSeen.set(section.SavedType, true);
+
+            for (std::size_t type = 0; type < MAX_COMPONENTS; ++type)
+            {
+                const ComponentSnapshotOps* ops = m_ComponentManager.GetSnapshotOps(static_cast<ComponentType>(type));
+                if (ops && section.Name == ops->Name)
+                {
+                    if (ops->Size == elementSize && ops->Raw == (raw != 0) && ops->Serializable)
+                    {
+                        section.Type = static_cast<ComponentType>(type);
+                    }
+                    break;
+                }
+            }
+
+            if (section.Type == UNMAPPED_TYPE || typesSeen.test(section.Type))
+            {
+                std::cerr << "[World] Snapshot component " << section.Name
+                          << " is not registered or has changed; skipped" << std::endl;
+                continue;
+            }
+            typesSeen.set(section.Type, true);
+
+            remap[section.SavedType] = section.Type;
+            sections.push_back(std::move(section));
+        }
+
+        if (reader.HasFailed())
+        {
+            std::cerr << "[World] Snapshot is truncated or corrupt" << std::endl;
+            return false;
+        }
+
+        std::vector<std::uint32_t> versions(slotCount);
+        std::memcpy(versions.data(), versionBytes, versions.size() * sizeof(std::uint32_t));
+
+        // Translate saved signatures into this process's type IDs
+        std::vector<Signature> signatures(slotCount);
+        std::array<std::uint32_t, MAX_COMPONENTS> ownerCounts{};
+        std::uint32_t aliveCount = 0;
+        for (std::uint32_t index = 0; index < slotCount; ++index)
+        {
+            if (!alive[index])
+            {
+                continue;
+            }
+            ++aliveCount;
+
+            std::uint64_t saved = 0;
+            std::memcpy(&saved, signatureBytes + static_cast<std::size_t>(index) * sizeof(std::uint64_t), sizeof(saved));
+            for (std::size_t bit = 0; bit < MAX_COMPONENTS; ++bit)
+            {
+                if ((saved >> bit) & 1 && remap[bit] != UNMAPPED_TYPE)
+                {
+                    signatures[index].set(remap[bit], true);
+                    ++ownerCounts[remap[bit]];
+                }
+            }
+        }
+
+        if (aliveCount != livingCount)
+        {
+            std::cerr << "[World] Snapshot entity table is inconsistent" << std::endl;
+            return false;
+        }
+
+        for (const SnapshotSection& section : sections)
+        {
+            if (ownerCounts[section.Type] != section.Count)
+            {
+                std::cerr << "[World] Snapshot section " << section.Name << " does not match the entity table" << std::endl;
+                return false;
+            }
+        }
+
+        // Every owner must be a distinct live entity carrying the section's type. With the
+        // counts above matching, that pairs each section one-to-one with its owners.
+        std::vector<bool> listed(slotCount);
+        for (const SnapshotSection& section : sections)
+        {
+            // Raw payloads are copied as-is, so their size is known up front
+            const ComponentSnapshotOps* ops = m_ComponentManager.GetSnapshotOps(section.Type);
+            if (ops->Raw && section.PayloadSize != static_cast<std::uint64_t>(section.Count) * ops->Size)
+            {
+                std::cerr << "[World] Snapshot section " << section.Name << " has a payload of the wrong size" << std::endl;
+                return false;
+            }
+
+            std::fill(listed.begin(), listed.end(), false);
+
+            for (std::uint32_t i = 0; i < section.Count; ++i)
+            {
+                EntityID owner = INVALID_ENTITY;
+                std::memcpy(&owner, section.Entities + static_cast<std::size_t>(i) * sizeof(EntityID), sizeof(owner));
+
+                const std::uint32_t index = GetEntityIndex(owner);
+                if (owner == INVALID_ENTITY || index >= slotCount || !alive[index] || listed[index] ||
+                    (versions[index] & ENTITY_VERSION_MASK) != GetEntityVersion(owner) ||
+                    !signatures[index].test(section.Type))
+                {
+                    std::cerr << "[World] Snapshot section " << section.Name << " lists an unknown owner" << std::endl;
+                    return false;
+                }
+                listed[index] = true;
+            }
+        }
+
+        // Swap the world's contents; only a payload that fails to decode can fail from here on
+        NotifyAllEntitiesRemoved();
+        m_CommandBuffer->Reset();
+        m_ComponentManager.ClearData();
+        m_EntityManager.RestoreSlots(slotCount, versions.data(), alive);
+
+        for (EntityID entity : m_EntityManager.GetLivingEntities())
+        {
+            m_EntityManager.SetSignature(entity, signatures[GetEntityIndex(entity)]);
+        }
+
+        if (m_ComponentManager.GetStorageMode() == ComponentStorageMode::Archetype)
+        {
+            // Place each signature group in its archetype and construct the
+            // components read through a serializer; raw ones are copied in as bytes
+            ForEachSignatureGroup(m_EntityManager, [&](const EntityID* entities, std::size_t count, const Signature& signature) {
+                if (signature.none())
+                {
+                    return;
+                }
+
+                std::size_t firstRow = 0;
+                Archetype& archetype = m_ComponentManager.GetArchetypeStorage().AddEntities(entities, count, signature, firstRow);
+                for (std::size_t type = 0; type < MAX_COMPONENTS; ++type)
+                {
+                    if (!signature.test(type))
+                    {
+                        continue;
+                    }
+
+                    const ComponentSnapshotOps* ops = m_ComponentManager.GetSnapshotOps(static_cast<ComponentType>(type));
+                    if (ops->Raw)
+                    {
+                        continue;
+                    }
+
+                    for (std::size_t row = 0; row < count; ++row)
+                    {
+                        ops->Construct(archetype.GetComponent(static_cast<ComponentType>(type), firstRow + row));
+                    }
+                }
+            });
+        }
+
+        // Systems and queries are already empty; leave the world empty too
+        auto abandonLoad = [this]() {
+            m_ComponentManager.ClearData();
+            m_EntityManager.Reset();
+        };
+
+        std::vector<EntityID> owners;
+        for (const SnapshotSection& section : sections)
+        {
+            owners.resize(section.Count);
+            std::memcpy(owners.data(), section.Entities, owners.size() * sizeof(EntityID));
+
+            SnapshotReader payload(section.Payload, static_cast<std::size_t>(section.PayloadSize));
+            const ComponentSnapshotOps* ops = m_ComponentManager.GetSnapshotOps(section.Type);
+            if (!ops->Load(m_ComponentManager, section.Type, owners.data(), owners.size(), payload))
+            {
+                std::cerr << "[World] Failed to read snapshot component " << section.Name << std::endl;
+                abandonLoad();
+                return false;
+            }
+        }
+
+        NotifyAllEntitiesAdded();
+        return true;
+    }
+
+    bool World::LoadSnapshotFromFile(const std::string& path)
+    {
+        MappedFile file = FileSystem::MapFile(path);
+        if (!file.IsOpen())
+        {
+            std::cerr << "[World] Failed to map snapshot: " << path << std::endl;
+            return false;
+        }
+
+        return LoadSnapshot(file.GetData(), file.GetSize());
+    }
+
+    // ============================================================================
+    // Membership Helpers
+    // ============================================================================
+
+    void World::NotifyAllEntitiesRemoved()
+    {
+        ForEachSignatureGroup(m_EntityManager, [&](const EntityID* entities, std::size_t count, const Signature& signature) {
+            m_SystemManager.EntitiesDestroyed(entities, count, signature);
+            for (QueryBase* query : m_QueryList)
+            {
+                query->EntitiesDestroyed(entities, count, signature);
+            }
+        });
+    }
+
+    void World::NotifyAllEntitiesAdded()
+    {
+        ForEachSignatureGroup(m_EntityManager, [&](const EntityID* entities, std::size_t count, const Signature& signature) {
+            EntitiesCreated(entities, count, signature);
+        });
+    }
+
+} // namespace SM
@@ -11,6 +11,11 @@
 #include "MeshComponent.h"
 #include "MaterialComponent.h"
 #include "TagComponent.h"
+#include "WorldMatrixComponent.h"
+#include "../ComponentSerializer.h"
+#include "../Entity.h"
+
+#include <cstdint>
 
 namespace SM
 {
@@ -153,4 +158,65 @@ namespace SM
         }
     };
 
+    // ============================================================================
+    // Registered Components
+    // ============================================================================
+
+    /**
+     * @brief Component types with compile-time IDs
+     *
+     * Each type's ComponentType is its index here, so ComponentManager
+     * reaches its array without any lookup. Types not listed (tests,
+     * tools) still work and get runtime IDs after these. Append new engine
+     * components at the end to keep existing IDs stable.
+     */
+    using RegisteredComponents = ComponentList<
+        TransformComponent,
+        WorldMatrixComponent,
+        MeshComponent,
+        MaterialComponent,
+        TagComponent,
+        VelocityComponent,
+        RigidbodyComponent,
+        BoxColliderComponent,
+        CameraComponent,
+        LightComponent,
+        AudioSourceComponent,
+        HierarchyComponent
+    >;
+
+    static_assert(RegisteredComponents::Size <= MAX_COMPONENTS, "Too many registered components");
+
+    // ============================================================================
+    // Snapshot Serializers
+    // ============================================================================
+
+    template<>
+    struct ComponentSerializer<HierarchyComponent>
+    {
+        static void Write(SnapshotWriter& writer, const HierarchyComponent& hierarchy)
+        {
+            writer.WriteValue(hierarchy.Parent);
+            writer.WriteValue(static_cast<std::uint32_t>(hierarchy.Children.size()));
+            writer.Write(hierarchy.Children.data(), hierarchy.Children.size() * sizeof(EntityID));
+        }
+
+        static bool Read(SnapshotReader& reader, HierarchyComponent& hierarchy)
+        {
+            std::uint32_t childCount = 0;
+            if (!reader.ReadValue(hierarchy.Parent) || !reader.ReadValue(childCount))
+            {
+                return false;
+            }
+
+            if (childCount > reader.GetRemaining() / sizeof(EntityID))
+            {
+                return false;
+            }
+
+            hierarchy.Children.resize(childCount);
+            return reader.Read(hierarchy.Children.data(), childCount * sizeof(EntityID));
+        }
+    };
+
 } // namespace SM
@@ -7,6 +7,8 @@
  * Contains material reference and rendering properties.
  */
 
+#include "../ComponentSerializer.h"
+
 #include <cstdint>
 #include <string>
 
@@ -199,4 +201,41 @@ namespace SM
         }
     }
 
+    // ============================================================================
+    // Snapshot Serializer
+    // ============================================================================
+
+    template<>
+    struct ComponentSerializer<MaterialComponent>
+    {
+        static void Write(SnapshotWriter& writer, const MaterialComponent& material)
+        {
+            writer.WriteValue(material.MaterialId);
+            writer.WriteValue(material.BaseColor);
+            writer.WriteValue(material.EmissiveColor);
+            writer.WriteValue(material.Metallic);
+            writer.WriteValue(material.Roughness);
+            writer.WriteValue(material.AmbientOcclusion);
+            writer.WriteValue(material.EmissiveIntensity);
+            writer.WriteValue(material.UseAlphaBlending);
+            writer.WriteValue(material.TwoSided);
+            writer.WriteString(material.DebugName);
+        }
+
+        static bool Read(SnapshotReader& reader, MaterialComponent& material)
+        {
+            reader.ReadValue(material.MaterialId);
+            reader.ReadValue(material.BaseColor);
+            reader.ReadValue(material.EmissiveColor);
+            reader.ReadValue(material.Metallic);
+            reader.ReadValue(material.Roughness);
+            reader.ReadValue(material.AmbientOcclusion);
+            reader.ReadValue(material.EmissiveIntensity);
+            reader.ReadValue(material.UseAlphaBlending);
+            reader.ReadValue(material.TwoSided);
+            reader.ReadString(material.DebugName);
+            return !reader.HasFailed();
+        }
+    };
+
 } // namespace SM
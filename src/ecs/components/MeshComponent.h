@@ -7,6 +7,8 @@
  * Contains mesh reference and rendering properties.
  */
 
+#include "../ComponentSerializer.h"
+
 #include <cstdint>
 #include <string>
 
@@ -49,6 +51,9 @@ namespace SM
         /** Render layer/pass (for sorting) */
         std::uint8_t RenderLayer = 0;
 
+        /** Object-space bounding sphere radius for culling (0 = the built-in primitive's) */
+        float BoundingRadius = 0.0f;
+
         /** Optional mesh name for debugging */
         std::string DebugName;
 
@@ -96,4 +101,35 @@ namespace SM
         constexpr MeshID Custom = 100;  // First ID for custom meshes
     }
 
+    // ============================================================================
+    // Snapshot Serializer
+    // ============================================================================
+
+    template<>
+    struct ComponentSerializer<MeshComponent>
+    {
+        static void Write(SnapshotWriter& writer, const MeshComponent& mesh)
+        {
+            writer.WriteValue(mesh.MeshId);
+            writer.WriteValue(mesh.CastShadows);
+            writer.WriteValue(mesh.ReceiveShadows);
+            writer.WriteValue(mesh.Visible);
+            writer.WriteValue(mesh.RenderLayer);
+            writer.WriteValue(mesh.BoundingRadius);
+            writer.WriteString(mesh.DebugName);
+        }
+
+        static bool Read(SnapshotReader& reader, MeshComponent& mesh)
+        {
+            reader.ReadValue(mesh.MeshId);
+            reader.ReadValue(mesh.CastShadows);
+            reader.ReadValue(mesh.ReceiveShadows);
+            reader.ReadValue(mesh.Visible);
+            reader.ReadValue(mesh.RenderLayer);
+            reader.ReadValue(mesh.BoundingRadius);
+            reader.ReadString(mesh.DebugName);
+            return !reader.HasFailed();
+        }
+    };
+
 } // namespace SM
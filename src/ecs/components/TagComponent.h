@@ -7,6 +7,9 @@
  * Provides a name and optional tags for entities.
  */
 
+#include "../ComponentSerializer.h"
+
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <algorithm>
@@ -155,4 +158,47 @@ namespace SM
         constexpr const char* UI = "UI";
     }
 
+    // ============================================================================
+    // Snapshot Serializer
+    // ============================================================================
+
+    template<>
+    struct ComponentSerializer<TagComponent>
+    {
+        static void Write(SnapshotWriter& writer, const TagComponent& tag)
+        {
+            writer.WriteString(tag.Name);
+            writer.WriteValue(static_cast<std::uint32_t>(tag.Tags.size()));
+            for (const std::string& value : tag.Tags)
+            {
+                writer.WriteString(value);
+            }
+        }
+
+        static bool Read(SnapshotReader& reader, TagComponent& tag)
+        {
+            std::uint32_t tagCount = 0;
+            if (!reader.ReadString(tag.Name) || !reader.ReadValue(tagCount))
+            {
+                return false;
+            }
+
+            // Every tag needs at least its length prefix
+            if (tagCount > reader.GetRemaining() / sizeof(std::uint32_t))
+            {
+                return false;
+            }
+
+            tag.Tags.resize(tagCount);
+            for (std::string& value : tag.Tags)
+            {
+                if (!reader.ReadString(value))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
 } // namespace SM
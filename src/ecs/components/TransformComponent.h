@@ -8,6 +8,7 @@
  */
 
 #include <cmath>
+#include <cstdint>
 #include <DirectXMath.h>
 
 namespace SM
@@ -221,6 +222,23 @@ namespace SM
             return euler;
         }
 
+        /**
+         * @brief Rotate a vector by this (unit) quaternion
+         */
+        Vector3 Rotate(const Vector3& v) const
+        {
+            // v + w * t + q x t, with t = 2 * (q x v)
+            Vector3 axis(x, y, z);
+            Vector3 t = Vector3::Cross(axis, v) * 2.0f;
+            return v + t * w + Vector3::Cross(axis, t);
+        }
+
+        DirectX::XMVECTOR ToXMVECTOR() const
+        {
+            DirectX::XMFLOAT4 f(x, y, z, w);
+            return DirectX::XMLoadFloat4(&f);
+        }
+
         Quaternion operator*(const Quaternion& other) const
         {
             return Quaternion(
@@ -243,6 +261,10 @@ namespace SM
      *
      * Contains position, rotation, and scale. This is typically one of the
      * most commonly used components in a game.
+     *
+     * Version is bumped by every mutator so TransformSystem only rebuilds
+     * the matrices of entities that changed. Call MarkDirty after writing
+     * Position, Rotation or Scale directly.
      */
     struct TransformComponent
     {
@@ -255,6 +277,9 @@ namespace SM
         /** Scale factors */
         Vector3 Scale = Vector3::One();
 
+        /** Change counter compared against WorldMatrixComponent::TransformVersion */
+        std::uint32_t Version = 0;
+
         TransformComponent() = default;
 
         TransformComponent(const Vector3& position)
@@ -289,6 +314,33 @@ namespace SM
         void SetEulerAngles(const Vector3& euler)
         {
             Rotation = Quaternion::FromEuler(euler);
+            MarkDirty();
+        }
+
+        void SetPosition(const Vector3& position)
+        {
+            Position = position;
+            MarkDirty();
+        }
+
+        void SetRotation(const Quaternion& rotation)
+        {
+            Rotation = rotation;
+            MarkDirty();
+        }
+
+        void SetScale(const Vector3& scale)
+        {
+            Scale = scale;
+            MarkDirty();
+        }
+
+        /**
+         * @brief Flag the transform as changed after a direct field write
+         */
+        void MarkDirty()
+        {
+            ++Version;
         }
 
         /**
@@ -296,9 +348,7 @@ namespace SM
          */
         Vector3 GetForward() const
         {
-            // Simplified - for full implementation, rotate Vector3::Forward by quaternion
-            float yaw = GetEulerAngles().y;
-            return Vector3(std::sin(yaw), 0.0f, std::cos(yaw));
+            return Rotation.Rotate(Vector3::Forward());
         }
 
         /**
@@ -306,8 +356,15 @@ namespace SM
          */
         Vector3 GetRight() const
         {
-            float yaw = GetEulerAngles().y;
-            return Vector3(std::cos(yaw), 0.0f, -std::sin(yaw));
+            return Rotation.Rotate(Vector3::Right());
+        }
+
+        /**
+         * @brief Get the up direction vector
+         */
+        Vector3 GetUp() const
+        {
+            return Rotation.Rotate(Vector3::Up());
         }
 
         /**
@@ -316,6 +373,17 @@ namespace SM
         void Translate(const Vector3& delta)
         {
             Position += delta;
+            MarkDirty();
+        }
+
+        /**
+         * @brief Build the local matrix (scale, then rotation, then translation)
+         */
+        DirectX::XMMATRIX GetLocalMatrix() const
+        {
+            return DirectX::XMMatrixScalingFromVector(Scale.ToXMVECTOR()) *
+                   DirectX::XMMatrixRotationQuaternion(Rotation.ToXMVECTOR()) *
+                   DirectX::XMMatrixTranslationFromVector(Position.ToXMVECTOR());
         }
     };
 
@@ -0,0 +1,63 @@
+#pragma once
+
+/**
+ * @file WorldMatrixComponent.h
+ * @brief Cached local and world matrices maintained by TransformSystem
+ *
+ * Kept apart from TransformComponent so systems that only consume matrices
+ * (rendering, culling) read a dense stream of them without touching the
+ * editable position/rotation/scale, and so the matrices land in their own
+ * column of the archetype storage.
+ */
+
+#include "../Entity.h"
+
+#include <cstdint>
+#include <DirectXMath.h>
+
+namespace SM
+{
+    /** TransformVersion of a matrix that was never built */
+    constexpr std::uint32_t INVALID_TRANSFORM_VERSION = 0xFFFFFFFFu;
+
+    // ============================================================================
+    // WorldMatrixComponent
+    // ============================================================================
+
+    /**
+     * @brief Matrices derived from an entity's TransformComponent and its parents
+     *
+     * Add alongside a TransformComponent. Matrices use the row-vector
+     * convention (object -> world) and are not transposed.
+     */
+    struct WorldMatrixComponent
+    {
+        /** Scale, rotation and translation of the entity's own transform */
+        DirectX::XMFLOAT4X4 Local;
+
+        /** Local composed with every parent's world matrix */
+        DirectX::XMFLOAT4X4 World;
+
+        /** TransformComponent::Version that Local was built from */
+        std::uint32_t TransformVersion = INVALID_TRANSFORM_VERSION;
+
+        /** Bumped whenever World changes; children compare it to ParentVersion */
+        std::uint32_t Version = 0;
+
+        /** Parent that World was composed with (INVALID_ENTITY for roots) */
+        EntityID Parent = INVALID_ENTITY;
+
+        /** Parent's Version when World was composed */
+        std::uint32_t ParentVersion = 0;
+
+        WorldMatrixComponent()
+        {
+            DirectX::XMStoreFloat4x4(&Local, DirectX::XMMatrixIdentity());
+            World = Local;
+        }
+
+        DirectX::XMMATRIX GetWorldMatrix() const { return DirectX::XMLoadFloat4x4(&World); }
+        DirectX::XMMATRIX GetLocalMatrix() const { return DirectX::XMLoadFloat4x4(&Local); }
+    };
+
+} // namespace SM
@@ -0,0 +1,256 @@
+#include "TransformSystem.h"
+#include "../World.h"
+#include "../TransformBatch.h"
+#include "../components/Components.h"
+
+#include <iostream>
+
+namespace SM
+{
+    namespace
+    {
+        /**
+         * @brief Per-thread gather buffers for UpdateRoots
+         */
+        struct RootScratch
+        {
+            std::vector<EntityID> Entities;
+            TransformStreams Transforms;
+            std::vector<DirectX::XMFLOAT4X4> Matrices;
+        };
+
+        thread_local RootScratch t_RootScratch;
+    }
+
+    void TransformSystem::Initialize(World& world)
+    {
+        // Create the queries now; Update may run on a worker thread
+        world.GetQuery<TransformComponent, WorldMatrixComponent>();
+        world.GetQuery<TransformComponent, WorldMatrixComponent, HierarchyComponent>();
+
+        SetComponentAccess(world.MakeSignature<TransformComponent, HierarchyComponent>(),
+                           world.MakeSignature<WorldMatrixComponent>());
+    }
+
+    void TransformSystem::Update(World& world, [[maybe_unused]] float deltaTime)
+    {
+        m_UpdatedCount.store(0, std::memory_order_relaxed);
+
+        BuildLevels(world);
+
+        // Roots first: everything without a parent, including plain static props
+        const std::vector<EntityID>& entities = world.GetQuery<TransformComponent, WorldMatrixComponent>().GetEntities();
+        m_EntityCount = static_cast<std::uint32_t>(entities.size());
+
+        ParallelForBatches(entities.data(), entities.size(), [this, &world](const EntityID* batch, std::size_t count) {
+            UpdateRoots(world, batch, count);
+        }, 256);
+
+        // Then each level, once every parent above it is current
+        for (const std::vector<EntityID>& level : m_Levels)
+        {
+            ParallelForRange(level.data(), level.size(), [this, &world](EntityID entity) {
+                UpdateEntity(world, entity, GetParent(world, entity));
+            }, 256);
+        }
+    }
+
+    TransformSystemStats TransformSystem::GetStats() const
+    {
+        TransformSystemStats stats;
+        stats.Entities = m_EntityCount;
+        stats.Updated = m_UpdatedCount.load(std::memory_order_relaxed);
+        stats.Levels = 1;
+        for (const std::vector<EntityID>& level : m_Levels)
+        {
+            stats.Levels += level.empty() ? 0 : 1;
+        }
+        return stats;
+    }
+
+    void TransformSystem::BuildLevels(World& world)
+    {
+        m_Depths.clear();
+        for (std::vector<EntityID>& level : m_Levels)
+        {
+            level.clear();
+        }
+
+        const auto& children = world.GetQuery<TransformComponent, WorldMatrixComponent, HierarchyComponent>();
+        for (EntityID entity : children.GetEntities())
+        {
+            ResolveDepth(world, entity);
+        }
+    }
+
+    std::uint32_t TransformSystem::ResolveDepth(World& world, EntityID entity)
+    {
+        // Walk up until an entity of known depth or a root
+        m_DepthChain.clear();
+        std::uint32_t depth = 0;
+        bool cut = false;
+
+        for (EntityID current = entity; ; )
+        {
+            auto it = m_Depths.find(current);
+            if (it != m_Depths.end())
+            {
+                depth = it->second + 1;
+                break;
+            }
+
+            m_DepthChain.push_back(current);
+            if (m_DepthChain.size() > MAX_HIERARCHY_DEPTH)
+            {
+                cut = true;
+                break;
+            }
+
+            EntityID parent = GetParent(world, current);
+            if (parent == INVALID_ENTITY)
+            {
+                break;
+            }
+            current = parent;
+        }
+
+        if (cut && !m_ReportedCycle)
+        {
+            std::cerr << "[TransformSystem] Hierarchy of entity " << entity << " is cyclic or deeper than "
+                      << MAX_HIERARCHY_DEPTH << " levels; treating it as a root" << std::endl;
+            m_ReportedCycle = true;
+        }
+
+        // Assign from the top of the chain down
+        for (auto it = m_DepthChain.rbegin(); it != m_DepthChain.rend(); ++it, ++depth)
+        {
+            if (cut || depth > MAX_HIERARCHY_DEPTH)
+            {
+                depth = 0;
+            }
+
+            m_Depths[*it] = depth;
+            if (depth > 0)
+            {
+                if (m_Levels.size() < depth)
+                {
+                    m_Levels.resize(depth);
+                }
+                m_Levels[depth - 1].push_back(*it);
+            }
+        }
+
+        return m_Depths[entity];
+    }
+
+    EntityID TransformSystem::GetParent(World& world, EntityID entity) const
+    {
+        if (!world.HasComponent<HierarchyComponent>(entity))
+        {
+            return INVALID_ENTITY;
+        }
+
+        EntityID parent = world.GetComponent<HierarchyComponent>(entity).Parent;
+        if (parent == INVALID_ENTITY || parent == entity || !world.IsAlive(parent) ||
+            !world.HasComponent<TransformComponent>(parent) || !world.HasComponent<WorldMatrixComponent>(parent))
+        {
+            return INVALID_ENTITY;
+        }
+
+        return parent;
+    }
+
+    void TransformSystem::UpdateRoots(World& world, const EntityID* entities, std::size_t count)
+    {
+        RootScratch& scratch = t_RootScratch;
+        scratch.Entities.clear();
+        scratch.Transforms.Clear();
+
+        std::uint32_t updated = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            EntityID entity = entities[i];
+            auto it = m_Depths.find(entity);
+            if (it != m_Depths.end() && it->second != 0)
+            {
+                continue;
+            }
+
+            const TransformComponent& transform = world.GetComponent<TransformComponent>(entity);
+            WorldMatrixComponent& matrices = world.GetComponent<WorldMatrixComponent>(entity);
+            if (matrices.TransformVersion != transform.Version)
+            {
+                scratch.Entities.push_back(entity);
+                scratch.Transforms.Push(transform);
+            }
+            else if (matrices.Parent != INVALID_ENTITY)
+            {
+                // Detached from its parent: the local matrix is the world matrix again
+                matrices.World = matrices.Local;
+                matrices.Parent = INVALID_ENTITY;
+                matrices.ParentVersion = 0;
+                ++matrices.Version;
+                ++updated;
+            }
+        }
+
+        if (!scratch.Entities.empty())
+        {
+            scratch.Matrices.resize(scratch.Entities.size());
+            TransformBatch::ComposeTRS(scratch.Transforms, scratch.Matrices.data());
+
+            for (std::size_t i = 0; i < scratch.Entities.size(); ++i)
+            {
+                EntityID entity = scratch.Entities[i];
+                WorldMatrixComponent& matrices = world.GetComponent<WorldMatrixComponent>(entity);
+                matrices.Local = scratch.Matrices[i];
+                matrices.World = scratch.Matrices[i];
+                matrices.TransformVersion = world.GetComponent<TransformComponent>(entity).Version;
+                matrices.Parent = INVALID_ENTITY;
+                matrices.ParentVersion = 0;
+                ++matrices.Version;
+            }
+            updated += static_cast<std::uint32_t>(scratch.Entities.size());
+        }
+
+        m_UpdatedCount.fetch_add(updated, std::memory_order_relaxed);
+    }
+
+    void TransformSystem::UpdateEntity(World& world, EntityID entity, EntityID parent)
+    {
+        const TransformComponent& transform = world.GetComponent<TransformComponent>(entity);
+        WorldMatrixComponent& matrices = world.GetComponent<WorldMatrixComponent>(entity);
+
+        bool localChanged = matrices.TransformVersion != transform.Version;
+        if (localChanged)
+        {
+            DirectX::XMStoreFloat4x4(&matrices.Local, transform.GetLocalMatrix());
+            matrices.TransformVersion = transform.Version;
+        }
+
+        const WorldMatrixComponent* parentMatrices =
+            parent != INVALID_ENTITY ? &world.GetComponent<WorldMatrixComponent>(parent) : nullptr;
+        std::uint32_t parentVersion = parentMatrices ? parentMatrices->Version : 0;
+
+        if (!localChanged && parent == matrices.Parent && parentVersion == matrices.ParentVersion)
+        {
+            return;
+        }
+
+        if (parentMatrices)
+        {
+            DirectX::XMStoreFloat4x4(&matrices.World,
+                DirectX::XMMatrixMultiply(matrices.GetLocalMatrix(), parentMatrices->GetWorldMatrix()));
+        }
+        else
+        {
+            matrices.World = matrices.Local;
+        }
+
+        matrices.Parent = parent;
+        matrices.ParentVersion = parentVersion;
+        ++matrices.Version;
+        m_UpdatedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+} // namespace SM
@@ -0,0 +1,100 @@
+#pragma once
+
+/**
+ * @file TransformSystem.h
+ * @brief Maintains cached matrices for transforms and parent/child hierarchies
+ *
+ * Every entity with a TransformComponent and a WorldMatrixComponent gets its
+ * local and world matrix rebuilt only when its transform's Version or its
+ * parent's world matrix changed; untouched entities cost a version compare.
+ * Hierarchies (HierarchyComponent::Parent) are processed level by level,
+ * parents before children, with each level split across the job system.
+ * Roots, which are most entities, are composed in SIMD batches.
+ */
+
+#include "../System.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace SM
+{
+    /**
+     * @brief Matrix updates of the last frame for display
+     */
+    struct TransformSystemStats
+    {
+        std::uint32_t Entities = 0;     ///< Entities with cached matrices
+        std::uint32_t Updated = 0;      ///< World matrices rebuilt this frame
+        std::uint32_t Levels = 0;       ///< Hierarchy levels, including the roots
+    };
+
+    /**
+     * @brief Rebuilds WorldMatrixComponent from TransformComponent and parents
+     *
+     * Runs before systems that read world matrices. Update only reads
+     * transforms and hierarchies and only writes world matrices, so it may
+     * run alongside systems with disjoint access.
+     */
+    class TransformSystem : public System<TransformSystem>
+    {
+    public:
+        static constexpr int PRIORITY = -100;                       ///< Earlier than matrix consumers
+        static constexpr std::uint32_t MAX_HIERARCHY_DEPTH = 64;    ///< Deeper (or cyclic) chains are cut here
+
+        TransformSystem() { SetPriority(PRIORITY); }
+
+        void Initialize(World& world) override;
+        void Update(World& world, float deltaTime) override;
+        const char* GetName() const override { return "TransformSystem"; }
+
+        /**
+         * @brief Get activity of the last Update
+         */
+        TransformSystemStats GetStats() const;
+
+    private:
+        /**
+         * @brief Sort entities with a parent into m_Levels by depth
+         */
+        void BuildLevels(World& world);
+
+        /**
+         * @brief Depth of an entity below its root (0 = root), memoized in m_Depths
+         */
+        std::uint32_t ResolveDepth(World& world, EntityID entity);
+
+        /**
+         * @brief Get the parent whose world matrix composes with this entity's
+         * @return INVALID_ENTITY if the entity is a root
+         */
+        EntityID GetParent(World& world, EntityID entity) const;
+
+        /**
+         * @brief Bring the matrices of the roots in a batch up to date
+         *
+         * Changed transforms are gathered into SoA streams and composed with
+         * TransformBatch::ComposeTRS; children in the batch are skipped.
+         */
+        void UpdateRoots(World& world, const EntityID* entities, std::size_t count);
+
+        /**
+         * @brief Bring one entity's matrices up to date
+         * @param parent Parent from GetParent; its matrices are already current
+         */
+        void UpdateEntity(World& world, EntityID entity, EntityID parent);
+
+    private:
+        std::vector<std::vector<EntityID>> m_Levels;        // m_Levels[d] = entities at depth d + 1
+        std::unordered_map<EntityID, std::uint32_t> m_Depths;
+        std::vector<EntityID> m_DepthChain;                 // Scratch for ResolveDepth
+
+        bool m_ReportedCycle = false;
+        std::uint32_t m_EntityCount = 0;
+        std::atomic<std::uint32_t> m_UpdatedCount{ 0 };
+    };
+
+} // namespace SM
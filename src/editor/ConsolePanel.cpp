@@ -1,14 +1,49 @@
 #include "editor/ConsolePanel.h"
+#include "core/MemoryTracker.h"
 
 #include <imgui.h>
 #include <cstdarg>
 #include <cstdio>
+#include <cctype>
+#include <cstring>
 #include <algorithm>
-#include <iomanip>
 #include <sstream>
 
 namespace SM
 {
+    namespace
+    {
+        static_assert((ConsolePanel::RING_CAPACITY & (ConsolePanel::RING_CAPACITY - 1)) == 0,
+                      "RING_CAPACITY must be a power of two");
+
+        /**
+         * @brief Case-insensitive substring test without allocating
+         * @param lowerNeedle Needle already in lower case
+         */
+        bool ContainsNoCase(const char* text, size_t length, const std::string& lowerNeedle)
+        {
+            if (lowerNeedle.size() > length)
+            {
+                return false;
+            }
+
+            for (size_t start = 0; start + lowerNeedle.size() <= length; ++start)
+            {
+                size_t i = 0;
+                while (i < lowerNeedle.size() &&
+                       std::tolower(static_cast<unsigned char>(text[start + i])) == lowerNeedle[i])
+                {
+                    ++i;
+                }
+                if (i == lowerNeedle.size())
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+    }
+
     ConsolePanel& ConsolePanel::Get()
     {
         static ConsolePanel instance;
@@ -16,9 +51,14 @@ namespace SM
     }
 
     ConsolePanel::ConsolePanel()
+        : m_StartTime(Clock::now())
     {
-        // Reserve space for logs
-        m_Logs.reserve(m_MaxEntries);
+        for (size_t i = 0; i < RING_CAPACITY; ++i)
+        {
+            m_Ring[i].Sequence.store(i, std::memory_order_relaxed);
+        }
+
+        m_History.resize(m_MaxEntries);
 
         // Add welcome message
         Log("Shattered Moon Console initialized", LogLevel::Info);
@@ -27,6 +67,9 @@ namespace SM
 
     void ConsolePanel::Draw()
     {
+        // Drain even while hidden so producers always find free slots
+        DrainRing();
+
         if (!m_Visible)
         {
             return;
@@ -68,11 +111,18 @@ namespace SM
                     {
                         // Copy all logs to clipboard
                         std::string allLogs;
-                        for (const auto& entry : m_Logs)
+                        char timestamp[32];
+                        for (uint64_t sequence = m_HistoryBegin; sequence < m_HistoryEnd; ++sequence)
                         {
-                            allLogs += "[" + FormatTimestamp(entry.Timestamp) + "] ";
-                            allLogs += "[" + std::string(GetLogLevelString(entry.Level)) + "] ";
-                            allLogs += entry.Message + "\n";
+                            const LogEntry& entry = GetHistoryEntry(sequence);
+                            FormatTimestamp(entry.Timestamp, timestamp, sizeof(timestamp));
+                            allLogs += "[";
+                            allLogs += timestamp;
+                            allLogs += "] [";
+                            allLogs += GetLogLevelString(entry.Level);
+                            allLogs += "] ";
+                            allLogs.append(entry.Message, entry.Length);
+                            allLogs += "\n";
                         }
                         ImGui::SetClipboardText(allLogs.c_str());
                     }
@@ -96,35 +146,134 @@ namespace SM
         ImGui::End();
     }
 
-    void ConsolePanel::Log(const std::string& message, LogLevel level)
+    void ConsolePanel::Log(std::string_view message, LogLevel level)
     {
-        std::lock_guard<std::mutex> lock(m_LogMutex);
+        if (level < m_MinLogLevel.load(std::memory_order_relaxed))
+        {
+            return;
+        }
 
-        // Check for duplicate message (collapse repeated messages)
-        if (!m_Logs.empty())
+        // Claim a slot: it is free when its sequence equals the write position
+        uint64_t position = m_WritePosition.load(std::memory_order_relaxed);
+        LogRecord* record = nullptr;
+        for (;;)
         {
-            LogEntry& last = m_Logs.back();
-            if (last.Message == message && last.Level == level)
+            record = &m_Ring[position & (RING_CAPACITY - 1)];
+            const uint64_t sequence = record->Sequence.load(std::memory_order_acquire);
+            const int64_t difference = static_cast<int64_t>(sequence) - static_cast<int64_t>(position);
+
+            if (difference == 0)
             {
-                last.Count++;
-                last.Timestamp = std::chrono::system_clock::now();
+                if (m_WritePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (difference < 0)
+            {
+                // Full: the UI thread has not drained a lap's worth yet
+                m_DroppedCount.fetch_add(1, std::memory_order_relaxed);
                 return;
             }
+            else
+            {
+                position = m_WritePosition.load(std::memory_order_relaxed);
+            }
         }
 
-        // Create new entry
-        LogEntry entry;
-        entry.Message = message;
+        LogEntry& entry = record->Entry;
+        entry.Timestamp = Clock::now() - m_StartTime;
         entry.Level = level;
-        entry.Timestamp = std::chrono::system_clock::now();
         entry.Count = 1;
+        entry.Length = static_cast<uint32_t>(std::min(message.size(), MAX_MESSAGE_LENGTH - 1));
+        std::memcpy(entry.Message, message.data(), entry.Length);
+        entry.Message[entry.Length] = '\0';
 
-        m_Logs.push_back(entry);
+        // Publish to the consumer
+        record->Sequence.store(position + 1, std::memory_order_release);
+    }
+
+    void ConsolePanel::LogFormat(LogLevel level, const char* format, ...)
+    {
+        char buffer[MAX_MESSAGE_LENGTH];
 
-        // Trim if over limit
-        if (m_MaxEntries > 0 && m_Logs.size() > m_MaxEntries)
+        va_list args;
+        va_start(args, format);
+        int length = vsnprintf(buffer, sizeof(buffer), format, args);
+        va_end(args);
+
+        if (length < 0)
         {
-            m_Logs.erase(m_Logs.begin(), m_Logs.begin() + (m_Logs.size() - m_MaxEntries));
+            return;
+        }
+
+        Log(std::string_view(buffer, std::min(static_cast<size_t>(length), sizeof(buffer) - 1)), level);
+    }
+
+    void ConsolePanel::Clear()
+    {
+        m_HistoryBegin = m_HistoryEnd;
+        m_VisibleRows.clear();
+        Log("Console cleared", LogLevel::Info);
+    }
+
+    void ConsolePanel::SetMaxEntries(size_t maxEntries)
+    {
+        m_MaxEntries = std::max<size_t>(maxEntries, 1);
+        m_History.assign(m_MaxEntries, LogEntry());
+        m_HistoryBegin = m_HistoryEnd;
+        m_VisibleRows.clear();
+    }
+
+    void ConsolePanel::DrainRing()
+    {
+        for (;;)
+        {
+            LogRecord& record = m_Ring[m_ReadPosition & (RING_CAPACITY - 1)];
+            if (record.Sequence.load(std::memory_order_acquire) != m_ReadPosition + 1)
+            {
+                break;
+            }
+
+            AddToHistory(record.Entry);
+
+            // Hand the slot back to producers for the next lap
+            record.Sequence.store(m_ReadPosition + RING_CAPACITY, std::memory_order_release);
+            ++m_ReadPosition;
+        }
+    }
+
+    void ConsolePanel::AddToHistory(const LogEntry& entry)
+    {
+        // Check for duplicate message (collapse repeated messages)
+        if (m_HistoryEnd > m_HistoryBegin)
+        {
+            LogEntry& last = GetHistoryEntry(m_HistoryEnd - 1);
+            if (last.Level == entry.Level && last.Length == entry.Length &&
+                std::memcmp(last.Message, entry.Message, entry.Length) == 0)
+            {
+                last.Count++;
+                last.Timestamp = entry.Timestamp;
+                return;
+            }
+        }
+
+        // Overwrite the oldest entry once the history is full
+        if (m_HistoryEnd - m_HistoryBegin == m_History.size())
+        {
+            ++m_HistoryBegin;
+            while (!m_VisibleRows.empty() && m_VisibleRows.front() < m_HistoryBegin)
+            {
+                m_VisibleRows.pop_front();
+            }
+        }
+
+        const uint64_t sequence = m_HistoryEnd++;
+        GetHistoryEntry(sequence) = entry;
+
+        if (PassesFilter(entry))
+        {
+            m_VisibleRows.push_back(sequence);
         }
 
         // Auto-scroll on new message
@@ -134,23 +283,33 @@ namespace SM
         }
     }
 
-    void ConsolePanel::LogFormat(LogLevel level, const char* format, ...)
+    bool ConsolePanel::PassesFilter(const LogEntry& entry) const
     {
-        char buffer[1024];
-
-        va_list args;
-        va_start(args, format);
-        vsnprintf(buffer, sizeof(buffer), format, args);
-        va_end(args);
+        bool showLevel = false;
+        switch (entry.Level)
+        {
+        case LogLevel::Trace:    showLevel = m_ShowTrace; break;
+        case LogLevel::Debug:    showLevel = m_ShowDebug; break;
+        case LogLevel::Info:     showLevel = m_ShowInfo; break;
+        case LogLevel::Warning:  showLevel = m_ShowWarning; break;
+        case LogLevel::Error:    showLevel = m_ShowError; break;
+        case LogLevel::Critical: showLevel = m_ShowCritical; break;
+        }
 
-        Log(buffer, level);
+        return showLevel &&
+               (m_FilterText.empty() || ContainsNoCase(entry.Message, entry.Length, m_FilterText));
     }
 
-    void ConsolePanel::Clear()
+    void ConsolePanel::RebuildVisibleRows()
     {
-        std::lock_guard<std::mutex> lock(m_LogMutex);
-        m_Logs.clear();
-        Log("Console cleared", LogLevel::Info);
+        m_VisibleRows.clear();
+        for (uint64_t sequence = m_HistoryBegin; sequence < m_HistoryEnd; ++sequence)
+        {
+            if (PassesFilter(GetHistoryEntry(sequence)))
+            {
+                m_VisibleRows.push_back(sequence);
+            }
+        }
     }
 
     ImVec4 ConsolePanel::GetLogLevelColor(LogLevel level)
@@ -188,33 +347,27 @@ namespace SM
         }
     }
 
-    std::string ConsolePanel::FormatTimestamp(const std::chrono::system_clock::time_point& time)
+    void ConsolePanel::FormatTimestamp(Clock::duration time, char* buffer, size_t bufferSize)
     {
-        auto timeT = std::chrono::system_clock::to_time_t(time);
-        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-            time.time_since_epoch()) % 1000;
-
-        std::tm tm;
-        localtime_s(&tm, &timeT);
+        const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(time).count();
 
-        std::ostringstream oss;
-        oss << std::setfill('0')
-            << std::setw(2) << tm.tm_hour << ":"
-            << std::setw(2) << tm.tm_min << ":"
-            << std::setw(2) << tm.tm_sec << "."
-            << std::setw(3) << ms.count();
-
-        return oss.str();
+        snprintf(buffer, bufferSize, "%02lld:%02lld:%02lld.%03lld",
+                 static_cast<long long>(ms / 3600000),
+                 static_cast<long long>((ms / 60000) % 60),
+                 static_cast<long long>((ms / 1000) % 60),
+                 static_cast<long long>(ms % 1000));
     }
 
     void ConsolePanel::DrawFilters()
     {
         // Filter text input
         ImGui::PushItemWidth(200);
+        bool filterChanged = false;
         if (ImGui::InputTextWithHint("##Filter", "Filter...", m_FilterBuffer, sizeof(m_FilterBuffer)))
         {
             m_FilterText = m_FilterBuffer;
             std::transform(m_FilterText.begin(), m_FilterText.end(), m_FilterText.begin(), ::tolower);
+            filterChanged = true;
         }
         ImGui::PopItemWidth();
 
@@ -249,8 +402,26 @@ namespace SM
 
         ImGui::PopStyleVar();
 
+        // Level toggles may also change from the menu bar
+        const uint32_t filterState = (m_ShowTrace ? 0x01u : 0u) | (m_ShowDebug ? 0x02u : 0u) |
+                                     (m_ShowInfo ? 0x04u : 0u) | (m_ShowWarning ? 0x08u : 0u) |
+                                     (m_ShowError ? 0x10u : 0u) | (m_ShowCritical ? 0x20u : 0u);
+        if (filterChanged || filterState != m_FilterState)
+        {
+            m_FilterState = filterState;
+            RebuildVisibleRows();
+        }
+
         ImGui::SameLine();
-        ImGui::TextDisabled("| %zu entries", m_Logs.size());
+        ImGui::TextDisabled("| %zu entries", GetLogCount());
+
+        const uint64_t dropped = GetDroppedCount();
+        if (dropped > 0)
+        {
+            ImGui::SameLine();
+            ImGui::TextColored(GetLogLevelColor(LogLevel::Warning), "(%llu dropped)",
+                               static_cast<unsigned long long>(dropped));
+        }
 
         ImGui::SameLine(ImGui::GetWindowWidth() - 60);
         if (ImGui::Button("Clear"))
@@ -266,59 +437,23 @@ namespace SM
 
         ImGui::BeginChild("LogScrollRegion", ImVec2(0, -footerHeight), false, ImGuiWindowFlags_HorizontalScrollbar);
 
-        // Use clipper for performance with many entries
+        // Only the rows in view are formatted and drawn
         ImGuiListClipper clipper;
-
-        // First, build filtered list
-        std::vector<size_t> filteredIndices;
-        for (size_t i = 0; i < m_Logs.size(); ++i)
-        {
-            const LogEntry& entry = m_Logs[i];
-
-            // Level filter
-            bool showLevel = false;
-            switch (entry.Level)
-            {
-            case LogLevel::Trace:    showLevel = m_ShowTrace; break;
-            case LogLevel::Debug:    showLevel = m_ShowDebug; break;
-            case LogLevel::Info:     showLevel = m_ShowInfo; break;
-            case LogLevel::Warning:  showLevel = m_ShowWarning; break;
-            case LogLevel::Error:    showLevel = m_ShowError; break;
-            case LogLevel::Critical: showLevel = m_ShowCritical; break;
-            }
-
-            if (!showLevel)
-            {
-                continue;
-            }
-
-            // Text filter
-            if (!m_FilterText.empty())
-            {
-                std::string lowerMessage = entry.Message;
-                std::transform(lowerMessage.begin(), lowerMessage.end(), lowerMessage.begin(), ::tolower);
-
-                if (lowerMessage.find(m_FilterText) == std::string::npos)
-                {
-                    continue;
-                }
-            }
-
-            filteredIndices.push_back(i);
-        }
-
-        // Draw filtered entries
-        clipper.Begin(static_cast<int>(filteredIndices.size()));
+        clipper.Begin(static_cast<int>(m_VisibleRows.size()));
         while (clipper.Step())
         {
             for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
             {
-                const LogEntry& entry = m_Logs[filteredIndices[row]];
+                const LogEntry& entry = GetHistoryEntry(m_VisibleRows[row]);
+
+                char timestamp[32];
+                FormatTimestamp(entry.Timestamp, timestamp, sizeof(timestamp));
 
+                ImGui::PushID(row);
                 ImGui::PushStyleColor(ImGuiCol_Text, GetLogLevelColor(entry.Level));
 
                 // Timestamp
-                ImGui::TextDisabled("[%s]", FormatTimestamp(entry.Timestamp).c_str());
+                ImGui::TextDisabled("[%s]", timestamp);
                 ImGui::SameLine();
 
                 // Level tag
@@ -328,11 +463,11 @@ namespace SM
                 // Message
                 if (entry.Count > 1)
                 {
-                    ImGui::Text("%s (x%d)", entry.Message.c_str(), entry.Count);
+                    ImGui::Text("%s (x%d)", entry.Message, entry.Count);
                 }
                 else
                 {
-                    ImGui::TextUnformatted(entry.Message.c_str());
+                    ImGui::TextUnformatted(entry.Message, entry.Message + entry.Length);
                 }
 
                 ImGui::PopStyleColor();
@@ -342,10 +477,11 @@ namespace SM
                 {
                     if (ImGui::MenuItem("Copy"))
                     {
-                        ImGui::SetClipboardText(entry.Message.c_str());
+                        ImGui::SetClipboardText(entry.Message);
                     }
                     ImGui::EndPopup();
                 }
+                ImGui::PopID();
             }
         }
 
@@ -436,8 +572,10 @@ namespace SM
     {
         Log("> " + command, LogLevel::Trace);
 
-        // Simple command parser
-        std::string cmd = command;
+        // Simple command parser: a lowercased name, then arguments as typed
+        std::istringstream arguments(command);
+        std::string cmd;
+        arguments >> cmd;
         std::transform(cmd.begin(), cmd.end(), cmd.begin(), ::tolower);
 
         if (cmd == "help")
@@ -447,6 +585,8 @@ namespace SM
             Log("  clear   - Clear the console", LogLevel::Info);
             Log("  version - Show engine version", LogLevel::Info);
             Log("  fps     - Show current FPS", LogLevel::Info);
+            Log("  memdump  - Write allocation stats and sampled stacks (memdump [file])", LogLevel::Info);
+            Log("  memtrack - Toggle allocation tracking (memtrack on|off|rate <n>)", LogLevel::Info);
         }
         else if (cmd == "clear")
         {
@@ -461,6 +601,45 @@ namespace SM
             // This would need to get FPS from engine
             Log("FPS display: Use Stats panel (F3)", LogLevel::Info);
         }
+        else if (cmd == "memdump")
+        {
+            std::string path;
+            if (!(arguments >> path))
+            {
+                path = "memory_dump.txt";
+            }
+
+            if (MemoryTracker::Get().DumpToFile(path))
+            {
+                Log("Memory dump written to " + path, LogLevel::Info);
+            }
+            else
+            {
+                Log("Failed to write " + path, LogLevel::Error);
+            }
+        }
+        else if (cmd == "memtrack")
+        {
+            MemoryTracker& tracker = MemoryTracker::Get();
+            std::string mode;
+            arguments >> mode;
+
+            if (mode == "on" || mode == "off")
+            {
+                tracker.SetEnabled(mode == "on");
+                Log(std::string("Allocation tracking ") + (mode == "on" ? "enabled" : "disabled"), LogLevel::Info);
+            }
+            else if (uint32_t rate = 0; mode == "rate" && (arguments >> rate))
+            {
+                tracker.SetSampleRate(rate);
+                LogFormat(LogLevel::Info, "Sampling 1 in %u allocations per thread", rate);
+            }
+            else
+            {
+                LogFormat(LogLevel::Info, "Allocation tracking %s, sampling 1 in %u",
+                          tracker.IsEnabled() ? "on" : "off", tracker.GetSampleRate());
+            }
+        }
         else
         {
             Log("Unknown command: " + command, LogLevel::Warning);
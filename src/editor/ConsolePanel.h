@@ -5,12 +5,21 @@
  * @brief Console/Log panel for the editor
  *
  * Provides a console window for viewing log messages and executing commands.
+ *
+ * Log may be called from any thread. Messages are copied into fixed-size
+ * records of a bounded multi-producer ring without locks or allocation;
+ * Draw drains the ring on the UI thread into a fixed-capacity history, so
+ * a burst of worker-thread logging never serializes on the console.
  */
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
 #include <string>
+#include <string_view>
 #include <vector>
-#include <chrono>
-#include <mutex>
 
 namespace SM
 {
@@ -31,6 +40,7 @@ namespace SM
      * @brief Console/Log panel singleton
      *
      * Features:
+     * - Lock-free logging from any thread (messages over MAX_MESSAGE_LENGTH are truncated)
      * - Log message display with filtering
      * - Color-coded log levels
      * - Auto-scroll option
@@ -40,6 +50,12 @@ namespace SM
     class ConsolePanel
     {
     public:
+        /// Bytes of text a record holds, including the terminator
+        static constexpr size_t MAX_MESSAGE_LENGTH = 232;
+
+        /// Records the ring holds between two Draw calls (power of two)
+        static constexpr size_t RING_CAPACITY = 4096;
+
         /**
          * @brief Get the singleton instance
          */
@@ -50,7 +66,9 @@ namespace SM
         ConsolePanel& operator=(const ConsolePanel&) = delete;
 
         /**
-         * @brief Draw the console panel using ImGui
+         * @brief Draw the console panel using ImGui (UI thread)
+         *
+         * Drains messages logged since the last call, even while hidden.
          */
         void Draw();
 
@@ -59,11 +77,13 @@ namespace SM
         // ====================================================================
 
         /**
-         * @brief Log a message
+         * @brief Log a message (any thread)
          * @param message Message text
          * @param level Log level (default: Info)
+         *
+         * Dropped, and counted, when the ring is full.
          */
-        void Log(const std::string& message, LogLevel level = LogLevel::Info);
+        void Log(std::string_view message, LogLevel level = LogLevel::Info);
 
         /**
          * @brief Log a formatted message
@@ -94,29 +114,34 @@ namespace SM
         void LogError(const std::string& message) { Log(message, LogLevel::Error); }
 
         /**
-         * @brief Clear all log messages
+         * @brief Clear all log messages (UI thread)
          */
         void Clear();
 
         /**
-         * @brief Get the number of logged messages
+         * @brief Get the number of messages in the history (UI thread)
+         */
+        size_t GetLogCount() const { return static_cast<size_t>(m_HistoryEnd - m_HistoryBegin); }
+
+        /**
+         * @brief Get the number of messages lost to a full ring
          */
-        size_t GetLogCount() const { return m_Logs.size(); }
+        uint64_t GetDroppedCount() const { return m_DroppedCount.load(std::memory_order_relaxed); }
 
         // ====================================================================
         // Filtering
         // ====================================================================
 
         /**
-         * @brief Set the minimum log level to display
-         * @param level Minimum level (lower levels will be hidden)
+         * @brief Set the minimum log level to record
+         * @param level Minimum level (lower levels are discarded when logged)
          */
-        void SetMinLogLevel(LogLevel level) { m_MinLogLevel = level; }
+        void SetMinLogLevel(LogLevel level) { m_MinLogLevel.store(level, std::memory_order_relaxed); }
 
         /**
          * @brief Get the minimum log level
          */
-        LogLevel GetMinLogLevel() const { return m_MinLogLevel; }
+        LogLevel GetMinLogLevel() const { return m_MinLogLevel.load(std::memory_order_relaxed); }
 
         // ====================================================================
         // Configuration
@@ -134,10 +159,10 @@ namespace SM
         bool IsAutoScrollEnabled() const { return m_AutoScroll; }
 
         /**
-         * @brief Set maximum number of log entries (oldest are removed)
-         * @param maxEntries Maximum entries (0 = unlimited)
+         * @brief Set the history size; the oldest entries are overwritten (UI thread)
+         * @param maxEntries Maximum entries (at least 1); clears the history
          */
-        void SetMaxEntries(size_t maxEntries) { m_MaxEntries = maxEntries; }
+        void SetMaxEntries(size_t maxEntries);
 
         // ====================================================================
         // Visibility
@@ -162,17 +187,51 @@ namespace SM
         ConsolePanel();
         ~ConsolePanel() = default;
 
+        using Clock = std::chrono::steady_clock;
+
         /**
-         * @brief Log entry structure
+         * @brief Log entry structure (ring record and history entry)
          */
         struct LogEntry
         {
-            std::string Message;
-            LogLevel Level;
-            std::chrono::system_clock::time_point Timestamp;
-            int Count; // For repeated messages
+            Clock::duration Timestamp{};        ///< Since the console was created
+            LogLevel Level = LogLevel::Info;
+            uint32_t Length = 0;
+            int Count = 1;                      ///< For repeated messages
+            char Message[MAX_MESSAGE_LENGTH] = {};
+        };
+
+        /**
+         * @brief Ring slot; Sequence tells producers and the consumer whose turn it is
+         */
+        struct LogRecord
+        {
+            std::atomic<uint64_t> Sequence{ 0 };
+            LogEntry Entry;
         };
 
+        /**
+         * @brief Move ring records into the history, collapsing repeats
+         */
+        void DrainRing();
+
+        /**
+         * @brief Append an entry to the history (UI thread)
+         */
+        void AddToHistory(const LogEntry& entry);
+
+        /**
+         * @brief Check an entry against the level and text filters
+         */
+        bool PassesFilter(const LogEntry& entry) const;
+
+        /**
+         * @brief Rebuild the visible rows after a filter change
+         */
+        void RebuildVisibleRows();
+
+        LogEntry& GetHistoryEntry(uint64_t sequence) { return m_History[sequence % m_History.size()]; }
+
         /**
          * @brief Get color for log level
          */
@@ -184,9 +243,9 @@ namespace SM
         static const char* GetLogLevelString(LogLevel level);
 
         /**
-         * @brief Format timestamp for display
+         * @brief Format a timestamp as hh:mm:ss.mmm into a small buffer
          */
-        static std::string FormatTimestamp(const std::chrono::system_clock::time_point& time);
+        static void FormatTimestamp(Clock::duration time, char* buffer, size_t bufferSize);
 
         /**
          * @brief Draw filter controls
@@ -209,15 +268,28 @@ namespace SM
         void ExecuteCommand(const std::string& command);
 
     private:
-        std::vector<LogEntry> m_Logs;
-        std::mutex m_LogMutex; // For thread-safe logging
+        // Producer ring (bounded MPSC, one sequence per slot)
+        std::array<LogRecord, RING_CAPACITY> m_Ring;
+        alignas(64) std::atomic<uint64_t> m_WritePosition{ 0 };
+        alignas(64) uint64_t m_ReadPosition = 0;            // UI thread only
+        std::atomic<uint64_t> m_DroppedCount{ 0 };
+        Clock::time_point m_StartTime;
+
+        // History ring (UI thread); entry n lives at m_History[n % size]
+        std::vector<LogEntry> m_History;
+        uint64_t m_HistoryBegin = 0;                        // Oldest entry
+        uint64_t m_HistoryEnd = 0;                          // One past the newest
+
+        // History sequences that pass the filters, oldest first
+        std::deque<uint64_t> m_VisibleRows;
+        uint32_t m_FilterState = 0;                         // Level toggles when m_VisibleRows was built
 
         bool m_Visible = true;
         bool m_AutoScroll = true;
         bool m_ScrollToBottom = false;
 
         // Filtering
-        LogLevel m_MinLogLevel = LogLevel::Trace;
+        std::atomic<LogLevel> m_MinLogLevel{ LogLevel::Trace };
         char m_FilterBuffer[128] = "";
         std::string m_FilterText;
 
@@ -61,6 +61,7 @@ namespace SM
         if (ImGui::InputTextWithHint("##Search", "Search...", m_SearchBuffer, sizeof(m_SearchBuffer)))
         {
             m_SearchFilter = m_SearchBuffer;
+            m_FilterDirty = true;
         }
         ImGui::PopItemWidth();
 
@@ -70,74 +71,128 @@ namespace SM
             m_ShowCreateDialog = true;
         }
 
-        ImGui::Separator();
+        // Play-mode snapshot: capture the world before playing, restore on stop
+        const float halfWidth = (ImGui::GetContentRegionAvail().x - ImGui::GetStyle().ItemSpacing.x) * 0.5f;
+        if (ImGui::Button("Snapshot", ImVec2(halfWidth, 0)))
+        {
+            world.SaveSnapshot(m_Snapshot);
+        }
+        ImGui::SameLine();
+        ImGui::BeginDisabled(m_Snapshot.empty());
+        if (ImGui::Button("Restore", ImVec2(-1, 0)))
+        {
+            if (world.LoadSnapshot(m_Snapshot.data(), m_Snapshot.size()) &&
+                m_SelectedEntity != INVALID_ENTITY && !world.IsAlive(m_SelectedEntity))
+            {
+                ClearSelection();
+                if (m_OnSelectionChanged)
+                {
+                    m_OnSelectionChanged(INVALID_ENTITY);
+                }
+            }
+            m_FilterDirty = true;
+        }
+        ImGui::EndDisabled();
 
-        // Entity list
-        ImGui::BeginChild("EntityListScroll");
+        ImGui::Separator();
 
-        for (EntityID entity = 0; entity < MAX_ENTITIES; ++entity)
+        const bool filtering = !m_SearchFilter.empty();
+        if (filtering)
         {
-            if (!world.IsAlive(entity))
+            if (m_FilterDirty || m_FilteredWorld != &world ||
+                m_FilteredVersion != world.GetEntityManager().GetChangeVersion())
             {
-                continue;
+                RebuildFilteredEntities(world);
             }
+            ImGui::TextDisabled("%zu matches", m_FilteredEntities.size());
+        }
 
-            std::string displayName = GetEntityDisplayName(world, entity);
+        const std::vector<EntityID>& entities = filtering ? m_FilteredEntities : world.GetLivingEntities();
 
-            // Apply search filter
-            if (!m_SearchFilter.empty())
-            {
-                std::string lowerName = displayName;
-                std::string lowerFilter = m_SearchFilter;
-                std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
-                std::transform(lowerFilter.begin(), lowerFilter.end(), lowerFilter.begin(), ::tolower);
+        // Destroying while iterating would shuffle the list being drawn
+        EntityID entityToDestroy = INVALID_ENTITY;
 
-                if (lowerName.find(lowerFilter) == std::string::npos)
-                {
-                    continue;
-                }
-            }
+        // Entity list
+        ImGui::BeginChild("EntityListScroll");
 
-            // Selectable item
-            bool isSelected = (m_SelectedEntity == entity);
-            if (ImGui::Selectable(displayName.c_str(), isSelected))
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(entities.size()));
+        while (clipper.Step())
+        {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
             {
-                EntityID oldSelection = m_SelectedEntity;
-                m_SelectedEntity = entity;
+                const EntityID entity = entities[row];
+                std::string displayName = GetEntityDisplayName(world, entity);
 
-                if (m_OnSelectionChanged && oldSelection != entity)
+                // Selectable item
+                bool isSelected = (m_SelectedEntity == entity);
+                if (ImGui::Selectable(displayName.c_str(), isSelected))
                 {
-                    m_OnSelectionChanged(entity);
-                }
-            }
+                    EntityID oldSelection = m_SelectedEntity;
+                    m_SelectedEntity = entity;
 
-            // Right-click context menu
-            if (ImGui::BeginPopupContextItem())
-            {
-                if (ImGui::MenuItem("Delete Entity"))
-                {
-                    if (m_SelectedEntity == entity)
+                    if (m_OnSelectionChanged && oldSelection != entity)
                     {
-                        m_SelectedEntity = INVALID_ENTITY;
+                        m_OnSelectionChanged(entity);
                     }
-                    world.DestroyEntity(entity);
                 }
-                if (ImGui::MenuItem("Duplicate"))
+
+                // Right-click context menu
+                if (ImGui::BeginPopupContextItem())
                 {
-                    // TODO: Implement entity duplication
+                    if (ImGui::MenuItem("Delete Entity"))
+                    {
+                        entityToDestroy = entity;
+                    }
+                    if (ImGui::MenuItem("Duplicate"))
+                    {
+                        // TODO: Implement entity duplication
+                    }
+                    ImGui::EndPopup();
                 }
-                ImGui::EndPopup();
             }
         }
+        clipper.End();
 
         ImGui::EndChild();
+
+        if (entityToDestroy != INVALID_ENTITY)
+        {
+            if (m_SelectedEntity == entityToDestroy)
+            {
+                m_SelectedEntity = INVALID_ENTITY;
+            }
+            world.DestroyEntity(entityToDestroy);
+        }
+    }
+
+    void ECSPanel::RebuildFilteredEntities(World& world)
+    {
+        std::string lowerFilter = m_SearchFilter;
+        std::transform(lowerFilter.begin(), lowerFilter.end(), lowerFilter.begin(), ::tolower);
+
+        m_FilteredEntities.clear();
+        for (EntityID entity : world.GetLivingEntities())
+        {
+            std::string lowerName = GetEntityDisplayName(world, entity);
+            std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
+
+            if (lowerName.find(lowerFilter) != std::string::npos)
+            {
+                m_FilteredEntities.push_back(entity);
+            }
+        }
+
+        m_FilteredWorld = &world;
+        m_FilteredVersion = world.GetEntityManager().GetChangeVersion();
+        m_FilterDirty = false;
     }
 
     void ECSPanel::DrawComponentInspector(World& world, EntityID entity)
     {
         std::string displayName = GetEntityDisplayName(world, entity);
         ImGui::Text("Entity: %s", displayName.c_str());
-        ImGui::Text("ID: %u", entity);
+        ImGui::Text("ID: %u (index %u, version %u)", entity, GetEntityIndex(entity), GetEntityVersion(entity));
         ImGui::Separator();
 
         // Delete button
@@ -172,6 +227,10 @@ namespace SM
             if (!world.HasComponent<TransformComponent>(entity) && ImGui::MenuItem("Transform"))
             {
                 world.AddComponent(entity, TransformComponent{});
+                if (!world.HasComponent<WorldMatrixComponent>(entity))
+                {
+                    world.AddComponent(entity, WorldMatrixComponent{});
+                }
             }
             if (!world.HasComponent<MeshComponent>(entity) && ImGui::MenuItem("Mesh"))
             {
@@ -212,14 +271,14 @@ namespace SM
             float pos[3] = { transform.Position.x, transform.Position.y, transform.Position.z };
             if (ImGui::DragFloat3("Position", pos, 0.1f))
             {
-                transform.Position = Vector3(pos[0], pos[1], pos[2]);
+                transform.SetPosition(Vector3(pos[0], pos[1], pos[2]));
             }
 
             // Scale
             float scale[3] = { transform.Scale.x, transform.Scale.y, transform.Scale.z };
             if (ImGui::DragFloat3("Scale", scale, 0.01f, 0.01f, 100.0f))
             {
-                transform.Scale = Vector3(scale[0], scale[1], scale[2]);
+                transform.SetScale(Vector3(scale[0], scale[1], scale[2]));
             }
 
             // Rotation (quaternion displayed as euler for editing)
@@ -324,6 +383,7 @@ namespace SM
             if (ImGui::InputText("Name", nameBuffer, sizeof(nameBuffer)))
             {
                 tag.Name = nameBuffer;
+                m_FilterDirty = true;
             }
 
             // Tag editing
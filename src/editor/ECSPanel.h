@@ -9,8 +9,10 @@
  */
 
 #include "ecs/Entity.h"
+#include <cstdint>
 #include <string>
 #include <functional>
+#include <vector>
 
 namespace SM
 {
@@ -98,9 +100,17 @@ namespace SM
     private:
         /**
          * @brief Draw the entity hierarchy/list panel
+         *
+         * Only the visible rows are drawn; without a search filter the rows
+         * come straight from World::GetLivingEntities.
          */
         void DrawEntityList(World& world);
 
+        /**
+         * @brief Recompute the entities matching the search filter
+         */
+        void RebuildFilteredEntities(World& world);
+
         /**
          * @brief Draw the component inspector panel
          */
@@ -161,6 +171,15 @@ namespace SM
         std::string m_SearchFilter;
         char m_SearchBuffer[128] = "";
 
+        // Search results, rebuilt when the filter, a name or the world's entities change
+        std::vector<EntityID> m_FilteredEntities;
+        const World* m_FilteredWorld = nullptr;
+        std::uint64_t m_FilteredVersion = 0;    ///< EntityManager change version the results match
+        bool m_FilterDirty = true;
+
+        // Play-mode snapshot taken with World::SaveSnapshot
+        std::vector<std::uint8_t> m_Snapshot;
+
         // Callbacks
         std::function<void(EntityID)> m_OnSelectionChanged;
     };
@@ -25,6 +25,12 @@ namespace SM
         // Apply custom theme
         ImGuiManager::Get().SetTheme(ImGuiTheme::ShatteredMoon);
 
+        // Noise preview textures live in the same shader-visible heap ImGui draws from
+        if (renderer)
+        {
+            m_PCGPanel.Initialize(renderer->GetCore());
+        }
+
         // Enable docking
         ImGuiIO& io = ImGui::GetIO();
         io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;
@@ -43,6 +49,7 @@ namespace SM
             return;
         }
 
+        m_PCGPanel.Shutdown();
         ImGuiManager::Get().Shutdown();
         m_Initialized = false;
     }
@@ -86,7 +93,7 @@ namespace SM
             m_CameraPanel.Draw(camera, fpsController, orbitController);
         }
 
-        m_PCGPanel.Draw(chunkManager);
+        m_PCGPanel.Draw(chunkManager, camera);
 
         if (world)
         {
@@ -95,6 +102,8 @@ namespace SM
 
         ConsolePanel::Get().Draw();
 
+        m_ProfilerPanel.Draw();
+
         // Show ImGui demo window if enabled
         if (m_ShowDemoWindow)
         {
@@ -125,6 +134,7 @@ namespace SM
             return;
         }
 
+        SM_GPU_EVENT(commandList, "Editor UI");
         ImGuiManager::Get().Render(commandList);
     }
 
@@ -241,6 +251,12 @@ namespace SM
                     ConsolePanel::Get().SetVisible(consoleVisible);
                 }
 
+                bool profilerVisible = m_ProfilerPanel.IsVisible();
+                if (ImGui::MenuItem("Profiler", nullptr, &profilerVisible))
+                {
+                    m_ProfilerPanel.SetVisible(profilerVisible);
+                }
+
                 ImGui::Separator();
 
                 if (ImGui::MenuItem("Show All Panels"))
@@ -250,6 +266,7 @@ namespace SM
                     m_PCGPanel.SetVisible(true);
                     m_ECSPanel.SetVisible(true);
                     ConsolePanel::Get().SetVisible(true);
+                    m_ProfilerPanel.SetVisible(true);
                 }
 
                 if (ImGui::MenuItem("Hide All Panels"))
@@ -259,6 +276,7 @@ namespace SM
                     m_PCGPanel.SetVisible(false);
                     m_ECSPanel.SetVisible(false);
                     ConsolePanel::Get().SetVisible(false);
+                    m_ProfilerPanel.SetVisible(false);
                 }
 
                 ImGui::Separator();
@@ -382,6 +400,7 @@ namespace SM
             ImGui::DockBuilderDockWindow("Terrain Generation (PCG)", dockLeft);
             ImGui::DockBuilderDockWindow("ECS Inspector", dockRight);
             ImGui::DockBuilderDockWindow("Console", dockBottom);
+            ImGui::DockBuilderDockWindow("Profiler", dockBottom);
 
             ImGui::DockBuilderFinish(dockspaceId);
         }
@@ -14,6 +14,7 @@
 #include "editor/PCGPanel.h"
 #include "editor/ECSPanel.h"
 #include "editor/ConsolePanel.h"
+#include "editor/ProfilerPanel.h"
 
 namespace SM
 {
@@ -155,6 +156,11 @@ namespace SM
          */
         ConsolePanel& GetConsolePanel() { return ConsolePanel::Get(); }
 
+        /**
+         * @brief Get the profiler panel
+         */
+        ProfilerPanel& GetProfilerPanel() { return m_ProfilerPanel; }
+
         // ====================================================================
         // Stats Update
         // ====================================================================
@@ -192,6 +198,7 @@ namespace SM
         CameraPanel m_CameraPanel;
         PCGPanel m_PCGPanel;
         ECSPanel m_ECSPanel;
+        ProfilerPanel m_ProfilerPanel;
 
         // Dialog states
         bool m_ShowAboutDialog = false;
@@ -91,7 +91,7 @@ namespace SM
 
         // Get descriptor handle for ImGui font texture
         // We use index 0 of the CBV/SRV/UAV heap for ImGui
-        // Note: Make sure this index is reserved in DX12Core
+        // DX12Core::CreateDescriptorHeaps reserves it before any other allocation
         D3D12_CPU_DESCRIPTOR_HANDLE cpuHandle = srvHeap->GetCPUDescriptorHandleForHeapStart();
         D3D12_GPU_DESCRIPTOR_HANDLE gpuHandle = srvHeap->GetGPUDescriptorHandleForHeapStart();
         m_FontTextureHeapIndex = 0; // Reserved for ImGui
@@ -1,10 +1,14 @@
 #include "editor/PCGPanel.h"
 #include "pcg/ChunkManager.h"
 #include "pcg/Noise.h"
+#include "gameplay/Camera.h"
+#include "renderer/UploadQueue.h"
 
 #include <imgui.h>
+#include <algorithm>
 #include <random>
 #include <chrono>
+#include <iostream>
 
 namespace SM
 {
@@ -17,7 +21,61 @@ namespace SM
         m_Settings.MaxHeight = 50.0f;
     }
 
-    void PCGPanel::Draw(PCG::ChunkManager* chunkManager)
+    PCGPanel::~PCGPanel()
+    {
+        Shutdown();
+    }
+
+    bool PCGPanel::Initialize(DX12Core* core)
+    {
+        if (!core)
+        {
+            return false;
+        }
+
+        TextureDesc desc;
+        desc.Width = PREVIEW_SIZE;
+        desc.Height = PREVIEW_SIZE;
+        desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+        desc.Usage = TextureUsage::ShaderResource;
+
+        for (Texture& texture : m_PreviewTextures)
+        {
+            if (!texture.Create(core, desc, "PCG Noise Preview"))
+            {
+                std::cerr << "[PCGPanel] Failed to create noise preview texture" << std::endl;
+                return false;
+            }
+        }
+
+        m_Core = core;
+        return true;
+    }
+
+    void PCGPanel::Shutdown()
+    {
+        // Running jobs see the bump and stop at their next row
+        m_PreviewState->Generation.fetch_add(1, std::memory_order_acq_rel);
+        JobSystem::Get().Wait(m_PreviewJobs);
+
+        if (m_Core)
+        {
+            for (Texture& texture : m_PreviewTextures)
+            {
+                if (texture.GetResource())
+                {
+                    m_Core->DeferRelease(texture.GetResource());
+                }
+                texture = Texture();
+            }
+            m_Core = nullptr;
+        }
+
+        m_HasPreviewImage = false;
+        m_HasPreviewRequest = false;
+    }
+
+    void PCGPanel::Draw(PCG::ChunkManager* chunkManager, const GameCamera* camera)
     {
         if (!m_Visible)
         {
@@ -35,6 +93,7 @@ namespace SM
             DrawFBMSettings();
             DrawTerrainSettings();
             DrawErosionSettings();
+            DrawSculptSettings();
             DrawPresets();
             DrawActions(chunkManager);
 
@@ -44,6 +103,8 @@ namespace SM
             }
         }
         ImGui::End();
+
+        UpdateSculpt(chunkManager, camera);
     }
 
     void PCGPanel::RegenerateTerrain()
@@ -238,12 +299,83 @@ namespace SM
             ImGui::SliderFloat("Gravity", &m_ErosionSettings.Gravity, 1.0f, 10.0f, "%.1f");
             ImGui::SliderInt("Erosion Radius", &m_ErosionSettings.ErosionRadius, 1, 8);
 
+            ImGui::Checkbox("Parallel", &m_ErosionSettings.Parallel);
+            ImGui::SetItemTooltip("Simulate droplets on all cores in tiled phases (deterministic)");
+
             ImGui::TextDisabled("(Erosion applied during chunk generation)");
 
             ImGui::Separator();
         }
     }
 
+    void PCGPanel::DrawSculptSettings()
+    {
+        if (ImGui::CollapsingHeader("Sculpting"))
+        {
+            ImGui::Checkbox("Enable Brush", &m_SculptEnabled);
+            ImGui::SetItemTooltip("Hold the left mouse button over the terrain to sculpt");
+
+            const char* modes[] = { "Raise", "Lower", "Flatten", "Crater" };
+            ImGui::Combo("Mode", &m_BrushMode, modes, IM_ARRAYSIZE(modes));
+
+            ImGui::SliderFloat("Radius", &m_BrushRadius, 1.0f, 64.0f, "%.1f");
+            ImGui::SliderFloat("Strength", &m_BrushStrength, 0.1f, 20.0f, "%.1f");
+            ImGui::SetItemTooltip("Height change per second at the centre (Flatten: blend per second)");
+            ImGui::SliderFloat("Falloff", &m_BrushFalloff, 0.0f, 1.0f, "%.2f");
+
+            ImGui::TextDisabled("Last stroke edited %u chunks", m_SculptedChunks);
+            ImGui::TextDisabled("(Edits show on chunk meshes, not the clipmap or GPU terrain)");
+
+            ImGui::Separator();
+        }
+    }
+
+    void PCGPanel::UpdateSculpt(PCG::ChunkManager* chunkManager, const GameCamera* camera)
+    {
+        const ImGuiIO& io = ImGui::GetIO();
+        if (!m_SculptEnabled || !chunkManager || !camera || !ImGui::IsMouseDown(ImGuiMouseButton_Left) ||
+            io.WantCaptureMouse || io.DisplaySize.x <= 0.0f || io.DisplaySize.y <= 0.0f)
+        {
+            m_SculptStroke = false;
+            return;
+        }
+
+        // Unproject the mouse to a point in front of the camera; aim from the camera through it
+        using namespace DirectX;
+        const float ndcX = 2.0f * io.MousePos.x / io.DisplaySize.x - 1.0f;
+        const float ndcY = 1.0f - 2.0f * io.MousePos.y / io.DisplaySize.y;
+        const XMMATRIX inverseViewProjection = XMMatrixInverse(
+            nullptr, XMMatrixMultiply(camera->GetViewMatrixXM(), camera->GetProjectionMatrixXM()));
+        const XMVECTOR target = XMVector3TransformCoord(XMVectorSet(ndcX, ndcY, 0.5f, 1.0f), inverseViewProjection);
+        const XMFLOAT3 origin = camera->GetPositionXM();
+
+        PCG::TerrainRay ray;
+        ray.Origin = origin;
+        XMStoreFloat3(&ray.Direction, XMVectorSubtract(target, XMLoadFloat3(&origin)));
+        ray.MaxDistance = SCULPT_MAX_DISTANCE;
+
+        const PCG::TerrainHit hit = chunkManager->Raycast(ray);
+        if (!hit.Hit)
+        {
+            return;
+        }
+
+        if (!m_SculptStroke)
+        {
+            m_SculptStroke = true;
+            m_FlattenHeight = hit.Position.y;
+        }
+
+        PCG::TerrainBrush brush;
+        brush.Center = XMFLOAT3(hit.Position.x, m_FlattenHeight, hit.Position.z);
+        brush.Radius = m_BrushRadius;
+        brush.Strength = m_BrushStrength * io.DeltaTime;
+        brush.Falloff = m_BrushFalloff;
+        brush.Mode = static_cast<PCG::TerrainBrushMode>(m_BrushMode);
+
+        m_SculptedChunks = chunkManager->ApplyBrush(brush);
+    }
+
     void PCGPanel::DrawPresets()
     {
         if (ImGui::CollapsingHeader("Presets"))
@@ -334,48 +466,184 @@ namespace SM
         }
     }
 
+    bool PCGPanel::PreviewRequest::operator==(const PreviewRequest& other) const
+    {
+        return Seed == other.Seed &&
+               Noise.Octaves == other.Noise.Octaves &&
+               Noise.Frequency == other.Noise.Frequency &&
+               Noise.Amplitude == other.Noise.Amplitude &&
+               Noise.Lacunarity == other.Noise.Lacunarity &&
+               Noise.Persistence == other.Noise.Persistence &&
+               Noise.Gain == other.Noise.Gain &&
+               Noise.Offset == other.Noise.Offset &&
+               ApplyDomainWarp == other.ApplyDomainWarp &&
+               WarpStrength == other.WarpStrength &&
+               Extent == other.Extent;
+    }
+
     void PCGPanel::DrawNoisePreview()
     {
         if (ImGui::CollapsingHeader("Noise Preview", ImGuiTreeNodeFlags_DefaultOpen))
         {
-            // Generate preview data
-            if (m_PreviewData.empty() || m_SettingsChanged)
+            ImGui::SliderFloat("Extent", &m_PreviewExtent, 64.0f, 16384.0f, "%.0f", ImGuiSliderFlags_Logarithmic);
+
+            if (!m_Core)
+            {
+                ImGui::TextDisabled("Preview unavailable (no renderer)");
+                return;
+            }
+
+            PreviewRequest request;
+            request.Seed = m_Settings.Seed;
+            request.Noise = m_Settings.Noise;
+            request.ApplyDomainWarp = m_Settings.ApplyDomainWarp;
+            request.WarpStrength = m_Settings.WarpStrength;
+            request.Extent = m_PreviewExtent;
+
+            // Slider drags restart generation; the editor frame never waits for it
+            if (!m_HasPreviewRequest || !(request == m_PreviewRequest))
+            {
+                RequestPreview(request);
+            }
+
+            UploadPreview();
+
+            if (m_HasPreviewImage)
+            {
+                const Texture& texture = m_PreviewTextures[m_PreviewTexture];
+                float side = std::min(ImGui::GetContentRegionAvail().x, static_cast<float>(PREVIEW_SIZE));
+                ImGui::Image(static_cast<ImTextureID>(texture.GetSRV().GPU.ptr), ImVec2(side, side));
+            }
+
+            const uint32_t shownSize = (PREVIEW_SIZE >> (PREVIEW_LEVELS - 1)) << m_PreviewLevel;
+            if (!m_HasPreviewImage)
             {
-                m_PreviewData.resize(m_PreviewSize * m_PreviewSize);
+                ImGui::TextDisabled("Generating...");
+            }
+            else if (m_PreviewLevel + 1 < PREVIEW_LEVELS)
+            {
+                ImGui::Text("Preview: %ux%u (refining...)", shownSize, shownSize);
+            }
+            else
+            {
+                ImGui::Text("Preview: %ux%u, %.0f units across", shownSize, shownSize, m_PreviewExtent);
+            }
+        }
+    }
+
+    void PCGPanel::RequestPreview(const PreviewRequest& request)
+    {
+        m_PreviewRequest = request;
+        m_HasPreviewRequest = true;
+
+        // Stale jobs stop at their next row, so at most one job does real work
+        const uint64_t generation = m_PreviewState->Generation.fetch_add(1, std::memory_order_acq_rel) + 1;
+
+        std::shared_ptr<PreviewState> state = m_PreviewState;
+        JobSystem::Get().Run(
+            [state, generation, request]()
+            {
+                GeneratePreview(state, generation, request);
+            },
+            &m_PreviewJobs);
+    }
 
-                PCG::PerlinNoise perlin(m_Settings.Seed);
-                PCG::FBM fbm(&perlin);
+    void PCGPanel::GeneratePreview(const std::shared_ptr<PreviewState>& state, uint64_t generation,
+                                   const PreviewRequest& request)
+    {
+        // Same noise as HeightmapGenerator, through the batched kernel
+        PCG::FBMKernel<PCG::PerlinNoise, PCG::FBMMode::Standard> kernel(request.Seed, request.Noise);
+
+        std::vector<float> row(PREVIEW_SIZE);
+        std::vector<uint8_t> pixels(PREVIEW_SIZE * PREVIEW_SIZE * 4);
+
+        // Coarse levels first; each one fills the whole image with blocks of its samples
+        for (uint32_t level = 0; level < PREVIEW_LEVELS; ++level)
+        {
+            const uint32_t size = (PREVIEW_SIZE >> (PREVIEW_LEVELS - 1)) << level;
+            const uint32_t block = PREVIEW_SIZE / size;
+            const float step = request.Extent / static_cast<float>(size);
+            const float origin = -0.5f * request.Extent;
 
-                for (int y = 0; y < m_PreviewSize; ++y)
+            for (uint32_t y = 0; y < size; ++y)
+            {
+                if (state->Generation.load(std::memory_order_acquire) != generation)
                 {
-                    for (int x = 0; x < m_PreviewSize; ++x)
-                    {
-                        float nx = static_cast<float>(x) / m_PreviewSize * 10.0f;
-                        float ny = static_cast<float>(y) / m_PreviewSize * 10.0f;
+                    return;
+                }
 
-                        float value = fbm.Sample(nx, ny, m_Settings.Noise);
-                        value = (value + 1.0f) * 0.5f; // Normalize to 0-1
+                const float rowY = origin + static_cast<float>(y) * step;
+                if (request.ApplyDomainWarp)
+                {
+                    kernel.WarpedSampleGrid(origin, rowY, step, static_cast<int>(size), 1,
+                                            request.WarpStrength, row.data());
+                }
+                else
+                {
+                    kernel.SampleGrid(origin, rowY, step, static_cast<int>(size), 1, row.data());
+                }
 
-                        m_PreviewData[y * m_PreviewSize + x] = value;
+                for (uint32_t x = 0; x < size; ++x)
+                {
+                    const float value = std::clamp((row[x] + 1.0f) * 0.5f, 0.0f, 1.0f);
+                    const uint8_t gray = static_cast<uint8_t>(value * 255.0f + 0.5f);
+
+                    for (uint32_t by = 0; by < block; ++by)
+                    {
+                        uint8_t* texel = &pixels[((y * block + by) * PREVIEW_SIZE + x * block) * 4];
+                        for (uint32_t bx = 0; bx < block; ++bx, texel += 4)
+                        {
+                            texel[0] = gray;
+                            texel[1] = gray;
+                            texel[2] = gray;
+                            texel[3] = 255;
+                        }
                     }
                 }
             }
 
-            // Draw preview as a grayscale image (using plot as approximation)
-            ImGui::Text("Preview Size: %dx%d", m_PreviewSize, m_PreviewSize);
+            std::lock_guard<std::mutex> lock(state->Mutex);
+            if (state->Generation.load(std::memory_order_acquire) != generation)
+            {
+                return;
+            }
+            state->Pixels = pixels;
+            state->PixelsGeneration = generation;
+            state->PixelsLevel = level;
+            state->PixelsDirty = true;
+        }
+    }
 
-            // Display as a histogram-style representation
-            // Note: For proper image preview, you'd need to create a DX12 texture
-            ImGui::PlotLines("##NoisePreview",
-                m_PreviewData.data(),
-                m_PreviewSize,
-                0, nullptr,
-                0.0f, 1.0f,
-                ImVec2(-1, 100));
+    void PCGPanel::UploadPreview()
+    {
+        std::lock_guard<std::mutex> lock(m_PreviewState->Mutex);
+        if (!m_PreviewState->PixelsDirty)
+        {
+            return;
+        }
+
+        // Ring of FRAME_BUFFER_COUNT + 1 textures: the one written was last shown by a finished frame
+        const uint32_t target = m_HasPreviewImage ? (m_PreviewTexture + 1) % PREVIEW_TEXTURE_COUNT : 0;
+        Texture& texture = m_PreviewTextures[target];
+
+        D3D12_SUBRESOURCE_DATA data = {};
+        data.pData = m_PreviewState->Pixels.data();
+        data.RowPitch = PREVIEW_SIZE * 4;
+        data.SlicePitch = data.RowPitch * PREVIEW_SIZE;
 
-            // Show center row values
-            ImGui::Text("Center row noise values (horizontal)");
+        UploadQueue& uploads = m_Core->GetUploadQueue();
+        uint64_t fence = uploads.UploadTexture(texture.GetResource(), 0, 1, &data);
+        if (fence == 0)
+        {
+            // Keep the pixels dirty and retry next frame
+            return;
         }
+        uploads.WaitOnQueue(m_Core->GetDirectQueue(), fence);
+
+        m_PreviewState->PixelsDirty = false;
+        m_PreviewTexture = target;
+        m_PreviewLevel = m_PreviewState->PixelsLevel;
+        m_HasPreviewImage = true;
     }
 
 } // namespace SM
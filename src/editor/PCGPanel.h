@@ -5,11 +5,20 @@
  * @brief PCG (Procedural Content Generation) parameter panel for the editor
  *
  * Provides UI for controlling terrain generation parameters including
- * noise settings, FBM settings, biome configuration, and erosion.
+ * noise settings, FBM settings, biome configuration, and erosion, and a
+ * sculpting brush for the loaded terrain.
  */
 
 #include "pcg/HeightmapGenerator.h"
 #include "pcg/FBM.h"
+#include "core/JobSystem.h"
+#include "renderer/Texture.h"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace PCG
 {
@@ -18,6 +27,8 @@ namespace PCG
 
 namespace SM
 {
+    class GameCamera;
+
     /**
      * @brief PCG parameter control panel
      *
@@ -27,18 +38,32 @@ namespace SM
      * - Terrain settings (height range, falloff)
      * - Biome configuration
      * - Erosion parameters
+     * - Sculpting the loaded terrain with the left mouse button
      */
     class PCGPanel
     {
     public:
         PCGPanel();
-        ~PCGPanel() = default;
+        ~PCGPanel();
+
+        /**
+         * @brief Create the noise preview textures
+         * @param core DX12 core the textures are created on
+         * @return true if successful (the panel works without a preview otherwise)
+         */
+        bool Initialize(DX12Core* core);
+
+        /**
+         * @brief Stop preview generation and release the preview textures
+         */
+        void Shutdown();
 
         /**
          * @brief Draw the PCG panel using ImGui
-         * @param chunkManager Reference to chunk manager for regeneration
+         * @param chunkManager Reference to chunk manager for regeneration and sculpting
+         * @param camera Camera the sculpting brush is aimed from (null disables sculpting)
          */
-        void Draw(PCG::ChunkManager* chunkManager);
+        void Draw(PCG::ChunkManager* chunkManager, const GameCamera* camera = nullptr);
 
         // ====================================================================
         // Settings access
@@ -125,6 +150,16 @@ namespace SM
          */
         void DrawErosionSettings();
 
+        /**
+         * @brief Draw sculpting brush settings section
+         */
+        void DrawSculptSettings();
+
+        /**
+         * @brief Apply the brush under the mouse while the left button is held outside ImGui windows
+         */
+        void UpdateSculpt(PCG::ChunkManager* chunkManager, const GameCamera* camera);
+
         /**
          * @brief Draw preset buttons
          */
@@ -140,6 +175,53 @@ namespace SM
          */
         void DrawNoisePreview();
 
+        /**
+         * @brief Noise inputs the preview was generated from
+         */
+        struct PreviewRequest
+        {
+            uint32_t Seed = 0;
+            PCG::FBMSettings Noise;
+            bool ApplyDomainWarp = false;
+            float WarpStrength = 0.0f;
+            float Extent = 0.0f;
+
+            bool operator==(const PreviewRequest& other) const;
+        };
+
+        /**
+         * @brief Preview generation shared with the worker job
+         *
+         * Outlives the panel while a job still runs. Each finished level
+         * replaces Pixels; a newer Generation tells running jobs to stop.
+         */
+        struct PreviewState
+        {
+            std::atomic<uint64_t> Generation{ 0 };
+
+            std::mutex Mutex;
+            std::vector<uint8_t> Pixels;    ///< PREVIEW_SIZE^2 RGBA, guarded by Mutex
+            uint64_t PixelsGeneration = 0;  ///< Generation Pixels were made for
+            uint32_t PixelsLevel = 0;       ///< Refinement level of Pixels (0 = coarsest)
+            bool PixelsDirty = false;       ///< Not uploaded yet
+        };
+
+        /**
+         * @brief Start generating the preview for the current settings
+         */
+        void RequestPreview(const PreviewRequest& request);
+
+        /**
+         * @brief Generate every refinement level on a worker thread
+         */
+        static void GeneratePreview(const std::shared_ptr<PreviewState>& state, uint64_t generation,
+                                    const PreviewRequest& request);
+
+        /**
+         * @brief Copy the newest finished level into the next preview texture
+         */
+        void UploadPreview();
+
     private:
         bool m_Visible = true;
 
@@ -152,15 +234,38 @@ namespace SM
         bool m_NeedRegeneration = false;
 
         // Preview
+        static constexpr uint32_t PREVIEW_SIZE = 256;           ///< Texels per side at full refinement
+        static constexpr uint32_t PREVIEW_LEVELS = 4;           ///< 32, 64, 128 then 256 samples per side
+        static constexpr uint32_t PREVIEW_TEXTURE_COUNT = FRAME_BUFFER_COUNT + 1; ///< Never overwrite one a frame in flight shows
+
         bool m_ShowPreview = false;
-        std::vector<float> m_PreviewData;
-        int m_PreviewSize = 64;
+        float m_PreviewExtent = 2048.0f;                        ///< World units across the preview
+        DX12Core* m_Core = nullptr;
+        std::array<Texture, PREVIEW_TEXTURE_COUNT> m_PreviewTextures;
+        uint32_t m_PreviewTexture = 0;                          ///< Texture shown
+        bool m_HasPreviewImage = false;
+        uint32_t m_PreviewLevel = 0;                            ///< Refinement level shown
+        PreviewRequest m_PreviewRequest;                        ///< Inputs of the running or finished generation
+        bool m_HasPreviewRequest = false;
+        std::shared_ptr<PreviewState> m_PreviewState = std::make_shared<PreviewState>();
+        JobCounter m_PreviewJobs;
 
         // UI state
         bool m_AutoRegenerate = false;
         float m_RegenerateTimer = 0.0f;
         static constexpr float REGENERATE_DELAY = 0.5f;
 
+        // Sculpting
+        static constexpr float SCULPT_MAX_DISTANCE = 2000.0f;  ///< Furthest terrain the brush reaches
+        bool m_SculptEnabled = false;
+        int m_BrushMode = 0;                                    ///< PCG::TerrainBrushMode
+        float m_BrushRadius = 8.0f;
+        float m_BrushStrength = 4.0f;                           ///< Per second (Flatten: blend per second)
+        float m_BrushFalloff = 0.5f;
+        bool m_SculptStroke = false;                            ///< Left button held since a hit
+        float m_FlattenHeight = 0.0f;                           ///< Height under the brush when the stroke began
+        uint32_t m_SculptedChunks = 0;                          ///< Chunks the last application edited
+
         // Chunk manager reference (for regeneration)
         PCG::ChunkManager* m_ChunkManager = nullptr;
     };
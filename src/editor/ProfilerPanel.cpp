@@ -0,0 +1,468 @@
+#include "editor/ProfilerPanel.h"
+#include "editor/ConsolePanel.h"
+#include "core/Profiler.h"
+
+#include <imgui.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+namespace SM
+{
+    namespace
+    {
+        constexpr float FRAME_GRAPH_HEIGHT = 60.0f;
+        constexpr float LANE_LABEL_HEIGHT = 18.0f;
+        constexpr float EVENT_HEIGHT = 18.0f;
+        constexpr float LANE_SPACING = 6.0f;
+        constexpr float MAX_ZOOM = 500.0f;
+
+        // Frame time bands (60 and 30 FPS)
+        constexpr float TARGET_FRAME_MS = 1000.0f / 60.0f;
+        constexpr float SLOW_FRAME_MS = 1000.0f / 30.0f;
+
+        double ToMilliseconds(int64_t nanoseconds)
+        {
+            return static_cast<double>(nanoseconds) / 1'000'000.0;
+        }
+
+        /**
+         * @brief Stable color per scope name
+         */
+        ImU32 GetEventColor(const char* name)
+        {
+            uint32_t hash = 2166136261u;
+            for (const char* c = name ? name : ""; *c; ++c)
+            {
+                hash = (hash ^ static_cast<uint8_t>(*c)) * 16777619u;
+            }
+
+            float hue = static_cast<float>(hash % 360) / 360.0f;
+            return ImColor::HSV(hue, 0.45f, 0.75f);
+        }
+
+        ImU32 GetFrameColor(float milliseconds)
+        {
+            if (milliseconds <= TARGET_FRAME_MS)
+            {
+                return IM_COL32(80, 190, 100, 255);
+            }
+            if (milliseconds <= SLOW_FRAME_MS)
+            {
+                return IM_COL32(220, 190, 60, 255);
+            }
+            return IM_COL32(220, 80, 70, 255);
+        }
+    }
+
+    // ============================================================================
+    // Drawing
+    // ============================================================================
+
+    void ProfilerPanel::Draw()
+    {
+        if (!m_Visible)
+        {
+            return;
+        }
+
+        ImGui::SetNextWindowSize(ImVec2(900, 420), ImGuiCond_FirstUseEver);
+
+        if (ImGui::Begin("Profiler", &m_Visible))
+        {
+            DrawToolbar();
+            DrawFrameGraph();
+
+            const ProfileFrame* frame = GetSelectedFrame();
+            if (frame)
+            {
+                ImGui::Text("Frame %llu: %.3f ms CPU, %zu scopes, %zu GPU zones",
+                    static_cast<unsigned long long>(frame->FrameNumber),
+                    ToMilliseconds(frame->End - frame->Start),
+                    frame->CPUEvents.size(), frame->GPUEvents.size());
+
+                DrawTimeline(*frame);
+                DrawScopeSummary(*frame);
+            }
+            else
+            {
+                ImGui::TextDisabled("No frames recorded");
+            }
+        }
+        ImGui::End();
+    }
+
+    void ProfilerPanel::DrawToolbar()
+    {
+        Profiler& profiler = Profiler::Get();
+
+        bool enabled = profiler.IsEnabled();
+        if (ImGui::Checkbox("Record", &enabled))
+        {
+            profiler.SetEnabled(enabled);
+        }
+
+        ImGui::SameLine();
+        bool paused = profiler.IsPaused();
+        if (ImGui::Checkbox("Pause", &paused))
+        {
+            profiler.SetPaused(paused);
+        }
+
+        ImGui::SameLine();
+        if (ImGui::Checkbox("Follow Latest", &m_FollowLatest) && !m_FollowLatest)
+        {
+            if (const ProfileFrame* frame = GetSelectedFrame())
+            {
+                m_SelectedFrame = frame->FrameNumber;
+            }
+        }
+
+        ImGui::SameLine();
+        if (ImGui::Button("Clear"))
+        {
+            profiler.ClearFrames();
+            m_FollowLatest = true;
+        }
+
+        ImGui::SameLine();
+        ImGui::PushItemWidth(180.0f);
+        ImGui::InputText("##ExportPath", m_ExportPath, sizeof(m_ExportPath));
+        ImGui::PopItemWidth();
+
+        ImGui::SameLine();
+        if (ImGui::Button("Export Trace"))
+        {
+            if (profiler.ExportChromeTrace(m_ExportPath))
+            {
+                ConsolePanel::Get().Log(std::string("Profiler trace written to ") + m_ExportPath, LogLevel::Info);
+            }
+            else
+            {
+                ConsolePanel::Get().Log(std::string("Failed to write profiler trace ") + m_ExportPath, LogLevel::Error);
+            }
+        }
+        ImGui::SetItemTooltip("Chrome trace JSON; open in chrome://tracing or ui.perfetto.dev");
+
+        uint64_t dropped = profiler.GetDroppedCount();
+        if (dropped > 0)
+        {
+            ImGui::SameLine();
+            ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.2f, 1.0f), "(%llu dropped)",
+                static_cast<unsigned long long>(dropped));
+        }
+    }
+
+    void ProfilerPanel::DrawFrameGraph()
+    {
+        const std::deque<ProfileFrame>& frames = Profiler::Get().GetFrames();
+
+        ImVec2 origin = ImGui::GetCursorScreenPos();
+        ImVec2 size(ImGui::GetContentRegionAvail().x, FRAME_GRAPH_HEIGHT);
+        if (size.x <= 0.0f)
+        {
+            return;
+        }
+
+        ImGui::InvisibleButton("FrameGraph", size);
+        bool hovered = ImGui::IsItemHovered();
+        bool clicked = ImGui::IsItemClicked();
+
+        ImDrawList* drawList = ImGui::GetWindowDrawList();
+        drawList->AddRectFilled(origin, ImVec2(origin.x + size.x, origin.y + size.y), IM_COL32(20, 20, 25, 255));
+
+        if (frames.empty())
+        {
+            return;
+        }
+
+        // Scale to the slowest frame, but never so tight that 60 FPS fills the graph
+        float maxMs = SLOW_FRAME_MS;
+        for (const ProfileFrame& frame : frames)
+        {
+            maxMs = std::max(maxMs, static_cast<float>(ToMilliseconds(frame.End - frame.Start)));
+        }
+
+        const float barWidth = size.x / static_cast<float>(Profiler::MAX_FRAMES);
+        const ProfileFrame* selected = GetSelectedFrame();
+
+        for (size_t i = 0; i < frames.size(); ++i)
+        {
+            const ProfileFrame& frame = frames[i];
+            float ms = static_cast<float>(ToMilliseconds(frame.End - frame.Start));
+            float height = std::max(1.0f, ms / maxMs * size.y);
+
+            ImVec2 min(origin.x + static_cast<float>(i) * barWidth, origin.y + size.y - height);
+            ImVec2 max(min.x + std::max(1.0f, barWidth - 1.0f), origin.y + size.y);
+
+            ImU32 color = (selected == &frame) ? IM_COL32(120, 170, 255, 255) : GetFrameColor(ms);
+            drawList->AddRectFilled(min, max, color);
+        }
+
+        // 60 FPS line
+        float targetY = origin.y + size.y - TARGET_FRAME_MS / maxMs * size.y;
+        drawList->AddLine(ImVec2(origin.x, targetY), ImVec2(origin.x + size.x, targetY), IM_COL32(255, 255, 255, 60));
+
+        if (hovered)
+        {
+            size_t index = static_cast<size_t>((ImGui::GetMousePos().x - origin.x) / barWidth);
+            if (index < frames.size())
+            {
+                const ProfileFrame& frame = frames[index];
+                ImGui::SetTooltip("Frame %llu\n%.3f ms",
+                    static_cast<unsigned long long>(frame.FrameNumber), ToMilliseconds(frame.End - frame.Start));
+
+                if (clicked)
+                {
+                    m_SelectedFrame = frame.FrameNumber;
+                    m_FollowLatest = false;
+                }
+            }
+        }
+    }
+
+    void ProfilerPanel::DrawTimeline(const ProfileFrame& frame)
+    {
+        // Lanes: CPU threads in registration order, then the GPU
+        struct Lane
+        {
+            uint32_t Thread;
+            uint32_t MaxDepth;
+        };
+        std::vector<Lane> lanes;
+
+        auto addToLane = [&lanes](const ProfileEvent& event) {
+            for (Lane& lane : lanes)
+            {
+                if (lane.Thread == event.Thread)
+                {
+                    lane.MaxDepth = std::max(lane.MaxDepth, event.Depth);
+                    return;
+                }
+            }
+            lanes.push_back({ event.Thread, event.Depth });
+        };
+
+        int64_t start = frame.Start;
+        int64_t end = frame.End;
+
+        for (const ProfileEvent& event : frame.CPUEvents)
+        {
+            addToLane(event);
+        }
+        for (const ProfileEvent& event : frame.GPUEvents)
+        {
+            addToLane(event);
+            start = std::min(start, event.Start);
+            end = std::max(end, event.End);
+        }
+
+        std::sort(lanes.begin(), lanes.end(), [](const Lane& a, const Lane& b) { return a.Thread < b.Thread; });
+
+        float timelineHeight = 0.0f;
+        for (const Lane& lane : lanes)
+        {
+            timelineHeight += LANE_LABEL_HEIGHT + (lane.MaxDepth + 1) * EVENT_HEIGHT + LANE_SPACING;
+        }
+
+        float childHeight = std::min(std::max(timelineHeight + 20.0f, 80.0f), 360.0f);
+        ImGui::BeginChild("Timeline", ImVec2(0, childHeight), true, ImGuiWindowFlags_HorizontalScrollbar);
+
+        // Ctrl + wheel zooms around the mouse
+        ImGuiIO& io = ImGui::GetIO();
+        float viewWidth = ImGui::GetContentRegionAvail().x;
+        if (ImGui::IsWindowHovered() && io.KeyCtrl && io.MouseWheel != 0.0f)
+        {
+            float oldZoom = m_Zoom;
+            m_Zoom = std::clamp(m_Zoom * (io.MouseWheel > 0.0f ? 1.25f : 0.8f), 1.0f, MAX_ZOOM);
+
+            float mouseOffset = io.MousePos.x - ImGui::GetWindowPos().x;
+            float anchor = (ImGui::GetScrollX() + mouseOffset) * (m_Zoom / oldZoom);
+            ImGui::SetScrollX(anchor - mouseOffset);
+        }
+
+        const float width = viewWidth * m_Zoom;
+        const double pixelsPerNs = width / static_cast<double>(std::max<int64_t>(end - start, 1));
+
+        ImDrawList* drawList = ImGui::GetWindowDrawList();
+        ImVec2 origin = ImGui::GetCursorScreenPos();
+        const float labelX = origin.x + ImGui::GetScrollX();
+
+        // Frame boundary markers
+        auto timeToX = [&](int64_t time) {
+            return origin.x + static_cast<float>(static_cast<double>(time - start) * pixelsPerNs);
+        };
+        drawList->AddLine(ImVec2(timeToX(frame.Start), origin.y), ImVec2(timeToX(frame.Start), origin.y + timelineHeight),
+                          IM_COL32(255, 255, 255, 50));
+        drawList->AddLine(ImVec2(timeToX(frame.End), origin.y), ImVec2(timeToX(frame.End), origin.y + timelineHeight),
+                          IM_COL32(255, 255, 255, 50));
+
+        const ProfileEvent* hoveredEvent = nullptr;
+        float laneY = origin.y;
+
+        for (const Lane& lane : lanes)
+        {
+            std::string label = Profiler::Get().GetThreadName(lane.Thread);
+            drawList->AddText(ImVec2(labelX + 4.0f, laneY + 2.0f), IM_COL32(200, 200, 200, 255), label.c_str());
+
+            const float eventsY = laneY + LANE_LABEL_HEIGHT;
+            const std::vector<ProfileEvent>& events =
+                (lane.Thread == Profiler::GPU_THREAD) ? frame.GPUEvents : frame.CPUEvents;
+
+            for (const ProfileEvent& event : events)
+            {
+                if (event.Thread != lane.Thread)
+                {
+                    continue;
+                }
+
+                ImVec2 min(timeToX(event.Start), eventsY + event.Depth * EVENT_HEIGHT);
+                ImVec2 max(std::max(timeToX(event.End), min.x + 1.0f), min.y + EVENT_HEIGHT - 1.0f);
+
+                drawList->AddRectFilled(min, max, GetEventColor(event.Name));
+
+                // Label when it fits
+                if (max.x - min.x > 20.0f && event.Name)
+                {
+                    drawList->PushClipRect(min, max, true);
+                    drawList->AddText(ImVec2(min.x + 3.0f, min.y + 2.0f), IM_COL32(20, 20, 20, 255), event.Name);
+                    drawList->PopClipRect();
+                }
+
+                if (ImGui::IsMouseHoveringRect(min, max))
+                {
+                    hoveredEvent = &event;
+                }
+            }
+
+            laneY = eventsY + (lane.MaxDepth + 1) * EVENT_HEIGHT + LANE_SPACING;
+        }
+
+        ImGui::Dummy(ImVec2(width, timelineHeight));
+
+        if (hoveredEvent && ImGui::IsWindowHovered())
+        {
+            ImGui::SetTooltip("%s\n%.3f ms (at +%.3f ms)",
+                hoveredEvent->Name ? hoveredEvent->Name : "?",
+                ToMilliseconds(hoveredEvent->End - hoveredEvent->Start),
+                ToMilliseconds(hoveredEvent->Start - frame.Start));
+        }
+
+        ImGui::EndChild();
+        ImGui::TextDisabled("Ctrl + mouse wheel to zoom (%.1fx)", m_Zoom);
+    }
+
+    void ProfilerPanel::DrawScopeSummary(const ProfileFrame& frame)
+    {
+        if (!ImGui::CollapsingHeader("Scopes", ImGuiTreeNodeFlags_DefaultOpen))
+        {
+            return;
+        }
+
+        m_Summary.clear();
+
+        auto accumulate = [this](const ProfileEvent& event, bool isGPU) {
+            std::string_view name = event.Name ? event.Name : "?";
+            double ms = ToMilliseconds(event.End - event.Start);
+
+            for (ScopeSummary& summary : m_Summary)
+            {
+                if (summary.IsGPU == isGPU && summary.Name == name)
+                {
+                    summary.Calls++;
+                    summary.TotalMs += ms;
+                    summary.MaxMs = std::max(summary.MaxMs, ms);
+                    return;
+                }
+            }
+            m_Summary.push_back({ name, isGPU, 1, ms, ms });
+        };
+
+        for (const ProfileEvent& event : frame.CPUEvents)
+        {
+            accumulate(event, false);
+        }
+        for (const ProfileEvent& event : frame.GPUEvents)
+        {
+            accumulate(event, true);
+        }
+
+        std::sort(m_Summary.begin(), m_Summary.end(), [](const ScopeSummary& a, const ScopeSummary& b) {
+            return a.TotalMs > b.TotalMs;
+        });
+
+        ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV |
+                                ImGuiTableFlags_ScrollY | ImGuiTableFlags_SizingStretchProp;
+
+        if (ImGui::BeginTable("ScopeTable", 5, flags, ImVec2(0, 200)))
+        {
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableSetupColumn("Scope", ImGuiTableColumnFlags_WidthStretch, 4.0f);
+            ImGui::TableSetupColumn("Timeline", ImGuiTableColumnFlags_WidthStretch, 1.0f);
+            ImGui::TableSetupColumn("Calls", ImGuiTableColumnFlags_WidthStretch, 1.0f);
+            ImGui::TableSetupColumn("Total (ms)", ImGuiTableColumnFlags_WidthStretch, 1.0f);
+            ImGui::TableSetupColumn("Max (ms)", ImGuiTableColumnFlags_WidthStretch, 1.0f);
+            ImGui::TableHeadersRow();
+
+            for (const ScopeSummary& summary : m_Summary)
+            {
+                ImGui::TableNextRow();
+
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(summary.Name.data(), summary.Name.data() + summary.Name.size());
+
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(summary.IsGPU ? "GPU" : "CPU");
+
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", summary.Calls);
+
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", summary.TotalMs);
+
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", summary.MaxMs);
+            }
+
+            ImGui::EndTable();
+        }
+    }
+
+    // ============================================================================
+    // Private Methods
+    // ============================================================================
+
+    const ProfileFrame* ProfilerPanel::GetSelectedFrame() const
+    {
+        const std::deque<ProfileFrame>& frames = Profiler::Get().GetFrames();
+        if (frames.empty())
+        {
+            return nullptr;
+        }
+
+        if (m_FollowLatest)
+        {
+            // GPU results trail the CPU by the frames in flight
+            size_t searched = 0;
+            for (auto it = frames.rbegin(); it != frames.rend() && searched < 8; ++it, ++searched)
+            {
+                if (!it->GPUEvents.empty())
+                {
+                    return &*it;
+                }
+            }
+            return &frames.back();
+        }
+
+        for (const ProfileFrame& frame : frames)
+        {
+            if (frame.FrameNumber == m_SelectedFrame)
+            {
+                return &frame;
+            }
+        }
+        return &frames.back();
+    }
+
+} // namespace SM
@@ -0,0 +1,104 @@
+#pragma once
+
+/**
+ * @file ProfilerPanel.h
+ * @brief Frame profiler timeline panel for the editor
+ *
+ * Shows the Profiler's frame history as a bar graph of frame times and the
+ * selected frame as a flame-style timeline: one lane per CPU thread with
+ * nested SM_PROFILE_SCOPE markers stacked by depth, plus a GPU lane with
+ * render graph pass timings.
+ */
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace SM
+{
+    struct ProfileFrame;
+
+    /**
+     * @brief Profiler timeline display panel
+     *
+     * Features:
+     * - Frame time history; click a bar to inspect that frame
+     * - Per-thread and GPU timelines (Ctrl + mouse wheel zooms)
+     * - Inclusive time per scope for the selected frame
+     * - Pause and Chrome trace export
+     */
+    class ProfilerPanel
+    {
+    public:
+        ProfilerPanel() = default;
+        ~ProfilerPanel() = default;
+
+        /**
+         * @brief Draw the profiler panel using ImGui
+         */
+        void Draw();
+
+        // ====================================================================
+        // Visibility
+        // ====================================================================
+
+        void SetVisible(bool visible) { m_Visible = visible; }
+        bool IsVisible() const { return m_Visible; }
+        void ToggleVisible() { m_Visible = !m_Visible; }
+
+    private:
+        /**
+         * @brief Inclusive time of one scope name within a frame
+         */
+        struct ScopeSummary
+        {
+            std::string_view Name;
+            bool IsGPU = false;
+            uint32_t Calls = 0;
+            double TotalMs = 0.0;
+            double MaxMs = 0.0;
+        };
+
+        /**
+         * @brief Draw pause, enable and export controls
+         */
+        void DrawToolbar();
+
+        /**
+         * @brief Draw frame time bars and handle frame selection
+         */
+        void DrawFrameGraph();
+
+        /**
+         * @brief Draw the lanes of one frame
+         */
+        void DrawTimeline(const ProfileFrame& frame);
+
+        /**
+         * @brief Draw the per-scope time table of one frame
+         */
+        void DrawScopeSummary(const ProfileFrame& frame);
+
+        /**
+         * @brief Find the frame to show (latest with GPU results while following)
+         */
+        const ProfileFrame* GetSelectedFrame() const;
+
+    private:
+        bool m_Visible = true;
+
+        // Selection
+        bool m_FollowLatest = true;
+        uint64_t m_SelectedFrame = 0;           ///< Profiler frame number when not following
+
+        // Timeline
+        float m_Zoom = 1.0f;
+
+        // Export
+        char m_ExportPath[256] = "profile.json";
+
+        // Scratch for DrawScopeSummary
+        std::vector<ScopeSummary> m_Summary;
+    };
+
+} // namespace SM
@@ -2,6 +2,7 @@
 #include "core/Engine.h"
 #include "renderer/Renderer.h"
 #include "pcg/ChunkManager.h"
+#include "core/JobSystem.h"
 
 #include <imgui.h>
 #include <algorithm>
@@ -46,12 +47,24 @@ namespace SM
             m_StatUpdateTimer = 0.0f;
             UpdateMemoryStats();
 
+            if (JobSystem::Get().IsInitialized())
+            {
+                JobSystem::Get().SampleWorkerStats(m_JobWorkerStats);
+            }
+
+            MemoryTracker::Get().GetSamples(m_AllocationSamples, TOP_ALLOCATION_SAMPLES);
+
             // Update terrain stats from chunk manager
             if (m_ChunkManager)
             {
                 m_ActiveChunks = static_cast<int>(m_ChunkManager->GetLoadedChunkCount());
                 m_PendingChunks = static_cast<int>(m_ChunkManager->GetPendingCount());
+                m_InFlightChunks = static_cast<int>(m_ChunkManager->GetInFlightCount());
                 m_VisibleChunks = static_cast<int>(m_ChunkManager->GetVisibleChunks().size());
+
+                const PCG::ChunkCullingStats& culling = m_ChunkManager->GetCullingStats();
+                m_FrustumCulledChunks = static_cast<int>(culling.FrustumCulled);
+                m_HorizonCulledChunks = static_cast<int>(culling.HorizonCulled);
             }
         }
     }
@@ -96,6 +109,7 @@ namespace SM
             }
 
             DrawRenderingSection();
+            DrawJobsSection();
 
             if (m_ShowTerrainStats)
             {
@@ -105,6 +119,7 @@ namespace SM
             if (m_ShowMemoryDetails)
             {
                 DrawMemorySection();
+                DrawAllocationsSection();
             }
             else
             {
@@ -206,6 +221,162 @@ namespace SM
                     FormatBytes(m_AvailablePhysicalMemory),
                     FormatBytes(m_TotalPhysicalMemory));
             }
+
+            // Pooled chunk geometry (FormatBytes reuses one buffer, so one call per line)
+            if (m_Renderer && m_Renderer->GetCore() && m_Renderer->GetCore()->GetGeometryPool().IsInitialized())
+            {
+                GPUBufferPoolStats pool = m_Renderer->GetCore()->GetGeometryPool().GetStats();
+
+                ImGui::Separator();
+                ImGui::Text("GPU Geometry Pool:");
+                ImGui::Text("  Pages: %u", pool.PageCount);
+                ImGui::Text("  Reserved: %s", FormatBytes(pool.ReservedBytes));
+                ImGui::Text("  Used: %s", FormatBytes(pool.UsedBytes));
+                ImGui::Text("  Pending Free: %s", FormatBytes(pool.PendingFreeBytes));
+                ImGui::Text("  Allocations: %u", pool.AllocationCount);
+                ImGui::Text("  Free Blocks: %u", pool.FreeBlockCount);
+                ImGui::Text("  Largest Free: %s", FormatBytes(pool.LargestFreeBlock));
+
+                if (pool.ReservedBytes > 0)
+                {
+                    ImGui::ProgressBar(static_cast<float>(pool.UsedBytes) / static_cast<float>(pool.ReservedBytes));
+                }
+            }
+
+            // Descriptor heap occupancy
+            if (m_Renderer && m_Renderer->GetCore() && m_Renderer->GetCore()->GetDevice())
+            {
+                DX12Core* core = m_Renderer->GetCore();
+
+                ImGui::Separator();
+                ImGui::Text("Descriptor Heaps:");
+                DrawDescriptorHeapStats("CBV/SRV/UAV", core->GetCBVSRVUAVHeap().GetStats());
+                DrawDescriptorHeapStats("RTV", core->GetRTVHeap().GetStats());
+                DrawDescriptorHeapStats("DSV", core->GetDSVHeap().GetStats());
+            }
+        }
+    }
+
+    void StatsPanel::DrawAllocationsSection()
+    {
+        if (!ImGui::CollapsingHeader("Allocations"))
+        {
+            return;
+        }
+
+        MemoryTracker& tracker = MemoryTracker::Get();
+
+        bool enabled = tracker.IsEnabled();
+        if (ImGui::Checkbox("Track", &enabled))
+        {
+            tracker.SetEnabled(enabled);
+        }
+        ImGui::SameLine();
+        int sampleRate = static_cast<int>(tracker.GetSampleRate());
+        ImGui::SetNextItemWidth(100.0f);
+        if (ImGui::InputInt("Sample 1 in", &sampleRate, 64, 1024))
+        {
+            tracker.SetSampleRate(static_cast<uint32_t>(std::max(sampleRate, 0)));
+        }
+
+        // Per-tag counters (FormatBytes reuses one buffer, so one call per cell)
+        if (ImGui::BeginTable("##MemoryTags", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp))
+        {
+            ImGui::TableSetupColumn("Tag");
+            ImGui::TableSetupColumn("Live");
+            ImGui::TableSetupColumn("Allocs/s");
+            ImGui::TableSetupColumn("Bytes/s");
+            ImGui::TableHeadersRow();
+
+            for (size_t i = 0; i < MEMORY_TAG_COUNT; ++i)
+            {
+                const MemoryTagStats stats = tracker.GetTagStats(static_cast<MemoryTag>(i));
+                if (stats.Allocations == 0)
+                {
+                    continue;
+                }
+
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(GetMemoryTagName(static_cast<MemoryTag>(i)));
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(FormatBytes(static_cast<size_t>(std::max<int64_t>(stats.LiveBytes, 0))));
+                ImGui::TableNextColumn();
+                ImGui::Text("%.0f", stats.AllocationsPerSecond);
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(FormatBytes(static_cast<size_t>(stats.BytesPerSecond)));
+            }
+            ImGui::EndTable();
+        }
+
+        // Allocations per frame, newest on the right
+        std::array<float, MemoryTracker::FRAME_HISTORY> history;
+        tracker.GetFrameHistory(history);
+        const float maxCount = *std::max_element(history.begin(), history.end());
+
+        char overlay[48];
+        snprintf(overlay, sizeof(overlay), "%.0f allocs last frame", history.back());
+        ImGui::PlotLines("##FrameAllocations", history.data(), static_cast<int>(history.size()), 0, overlay,
+                         0.0f, std::max(maxCount * 1.2f, 16.0f), ImVec2(-1, 50));
+
+        // Frames per allocation-count bucket
+        const auto& histogram = tracker.GetHistogram();
+        std::array<float, MemoryTracker::HISTOGRAM_BUCKETS> buckets;
+        float maxFrames = 1.0f;
+        for (size_t i = 0; i < buckets.size(); ++i)
+        {
+            buckets[i] = static_cast<float>(histogram[i]);
+            maxFrames = std::max(maxFrames, buckets[i]);
+        }
+        ImGui::PlotHistogram("##FrameAllocationHistogram", buckets.data(), static_cast<int>(buckets.size()), 0,
+                             "frames by allocs: 0, 1, 2-3, 4-7 ...", 0.0f, maxFrames, ImVec2(-1, 50));
+
+        // Heaviest sampled call sites; "memdump" in the console symbolizes them
+        if (!m_AllocationSamples.empty())
+        {
+            ImGui::Text("Top sampled stacks (1 in %u):", tracker.GetSampleRate());
+            for (const AllocationSample& sample : m_AllocationSamples)
+            {
+                ImGui::BulletText("[%s] %llu samples, %s", GetMemoryTagName(sample.Tag),
+                                  static_cast<unsigned long long>(sample.Count), FormatBytes(sample.Bytes));
+
+                if (ImGui::IsItemHovered() && sample.FrameCount > 0)
+                {
+                    ImGui::BeginTooltip();
+                    for (uint32_t i = 0; i < sample.FrameCount; ++i)
+                    {
+                        ImGui::Text("0x%llx", static_cast<unsigned long long>(reinterpret_cast<uintptr_t>(sample.Frames[i])));
+                    }
+                    ImGui::EndTooltip();
+                }
+            }
+        }
+
+        if (ImGui::Button("Reset Samples"))
+        {
+            tracker.ResetSamples();
+            m_AllocationSamples.clear();
+        }
+    }
+
+    void StatsPanel::DrawDescriptorHeapStats(const char* name, const DescriptorHeapStats& stats)
+    {
+        ImGui::Text("  %s: %u / %u (%u pending free)", name, stats.Used, stats.Capacity, stats.PendingFree);
+        ImGui::Text("    Allocations: %u | Free Blocks: %u | Largest Free: %u",
+            stats.AllocationCount, stats.FreeBlockCount, stats.LargestFreeBlock);
+
+        if (stats.StagingCapacity > 0)
+        {
+            ImGui::Text("    Staging: %u / %u per frame (peak %u)",
+                stats.StagingUsed, stats.StagingCapacity, stats.StagingPeak);
+        }
+
+        if (stats.Capacity > 0)
+        {
+            char overlay[32];
+            std::snprintf(overlay, sizeof(overlay), "%u / %u", stats.Used, stats.Capacity);
+            ImGui::ProgressBar(static_cast<float>(stats.Used + stats.PendingFree) / static_cast<float>(stats.Capacity),
+                ImVec2(-1, 0), overlay);
         }
     }
 
@@ -225,6 +396,74 @@ namespace SM
             {
                 ImGui::Text("Resolution: %dx%d", m_Renderer->GetWidth(), m_Renderer->GetHeight());
                 ImGui::Text("Aspect Ratio: %.2f", m_Renderer->GetAspectRatio());
+
+                DynamicResolutionConfig dynamicResolution = m_Renderer->GetDynamicResolution().GetConfig();
+                bool changed = ImGui::Checkbox("Dynamic Resolution", &dynamicResolution.Enabled);
+                if (dynamicResolution.Enabled)
+                {
+                    changed |= ImGui::SliderFloat("Target GPU (ms)", &dynamicResolution.TargetGPUTimeMs, 4.0f, 33.0f, "%.1f");
+                    ImGui::Text("Render Scale: %.0f%% (%ux%u), GPU %.2f ms",
+                                m_Renderer->GetDynamicResolution().GetScale() * 100.0f,
+                                m_Renderer->GetRenderWidth(), m_Renderer->GetRenderHeight(),
+                                m_Renderer->GetDynamicResolution().GetGPUTimeMs());
+                }
+                if (changed)
+                {
+                    m_Renderer->SetDynamicResolution(dynamicResolution);
+                }
+
+                const RenderGraphStats& graph = m_Renderer->GetRenderGraph().GetStats();
+                ImGui::Text("Passes: %u (%u culled)", graph.PassCount, graph.CulledPassCount);
+                ImGui::Text("Barriers: %u in %u batches (%u aliasing)",
+                            graph.TransitionCount + graph.AliasingBarrierCount, graph.BarrierBatchCount,
+                            graph.AliasingBarrierCount);
+                if (graph.TransientCount > 0)
+                {
+                    ImGui::Text("Transients: %u, %.1f / %.1f MB aliased", graph.TransientCount,
+                                static_cast<float>(graph.TransientHeapSize) / (1024.0f * 1024.0f),
+                                static_cast<float>(graph.TransientUnaliasedSize) / (1024.0f * 1024.0f));
+                }
+
+                ShaderCacheStats shaders = ShaderCache::Get().GetStats();
+                PipelineLibraryStats pipelines = m_Renderer->GetCore()->GetPipelineLibrary().GetStats();
+                ImGui::Text("Shaders: %u precompiled, %u cached, %u compiled",
+                            shaders.Precompiled, shaders.Hits, shaders.Misses);
+                ImGui::Text("PSOs: %u loaded, %u created", pipelines.Loaded, pipelines.Created);
+            }
+        }
+    }
+
+    void StatsPanel::DrawJobsSection()
+    {
+        if (m_JobWorkerStats.empty())
+        {
+            return;
+        }
+
+        if (ImGui::CollapsingHeader("Jobs"))
+        {
+            float totalUtilization = 0.0f;
+            for (const JobWorkerStats& worker : m_JobWorkerStats)
+            {
+                totalUtilization += worker.Utilization;
+            }
+            ImGui::Text("Workers: %d (%.0f%% busy)", static_cast<int>(m_JobWorkerStats.size()),
+                        totalUtilization * 100.0f / static_cast<float>(m_JobWorkerStats.size()));
+
+            for (size_t i = 0; i < m_JobWorkerStats.size(); ++i)
+            {
+                const JobWorkerStats& worker = m_JobWorkerStats[i];
+
+                char label[64];
+                snprintf(label, sizeof(label), "#%d  %.0f%%", static_cast<int>(i), worker.Utilization * 100.0f);
+                ImGui::ProgressBar(worker.Utilization, ImVec2(-1, 0), label);
+
+                if (ImGui::IsItemHovered())
+                {
+                    ImGui::SetTooltip("Jobs: %llu (stolen %llu)",
+                                      static_cast<unsigned long long>(worker.JobsExecuted),
+                                      static_cast<unsigned long long>(worker.JobsStolen));
+                }
             }
         }
     }
@@ -240,6 +479,41 @@ namespace SM
             if (m_ChunkManager)
             {
                 const auto& config = m_ChunkManager->GetConfig();
+                if (config.FrustumCulling)
+                {
+                    ImGui::Text("Frustum Culled: %d", m_FrustumCulledChunks);
+                }
+                if (config.HorizonCulling)
+                {
+                    ImGui::Text("Horizon Culled: %d", m_HorizonCulledChunks);
+                }
+                if (config.AsyncGeneration)
+                {
+                    ImGui::Text("In-Flight (Workers): %d", m_InFlightChunks);
+                }
+                if (config.StreamingBudgetMs > 0.0f)
+                {
+                    const PCG::StreamingSchedulerStats& streaming = m_ChunkManager->GetStreamingStats();
+                    ImGui::Text("Streaming: %.2f / %.2f ms (%.0f%% budget)", streaming.UsedMs, streaming.BudgetMs,
+                        streaming.BudgetScale * 100.0f);
+                    ImGui::Text("Cost: gen %.2f, cache %.2f, mesh %.2f ms",
+                        streaming.TaskCostMs[static_cast<size_t>(PCG::StreamingTask::Generate)],
+                        streaming.TaskCostMs[static_cast<size_t>(PCG::StreamingTask::CacheLoad)],
+                        streaming.TaskCostMs[static_cast<size_t>(PCG::StreamingTask::MeshBuild)]);
+                }
+                if (config.HeightLRUBudget > 0)
+                {
+                    const PCG::ChunkHeightLRUStats& lru = m_ChunkManager->GetHeightLRUStats();
+                    ImGui::Text("Height LRU Hit Rate: %.1f%% (%u / %u)", lru.GetHitRate() * 100.0f,
+                        lru.Hits, lru.Hits + lru.Misses);
+                    ImGui::Text("Height LRU: %u chunks, %s", lru.Entries, FormatBytes(lru.Bytes));
+                }
+                if (config.DiskCache)
+                {
+                    const PCG::ChunkCacheStats& cache = m_ChunkManager->GetDiskCacheStats();
+                    ImGui::Text("Disk Cache: %u hits, %u misses", cache.Hits, cache.Misses);
+                    ImGui::Text("Disk Cache Written: %s", FormatBytes(static_cast<size_t>(cache.BytesWritten)));
+                }
                 ImGui::Text("View Distance: %.0f", config.ViewDistance);
             }
         }
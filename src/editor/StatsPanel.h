@@ -8,15 +8,20 @@
  * memory usage, and rendering statistics.
  */
 
+#include "core/JobSystem.h"
+#include "core/MemoryTracker.h"
+
 #include <array>
 #include <cstdint>
 #include <chrono>
+#include <vector>
 
 namespace SM
 {
     // Forward declarations
     class Engine;
     class Renderer;
+    struct DescriptorHeapStats;
 
     namespace PCG
     {
@@ -32,6 +37,8 @@ namespace SM
      * - Memory usage
      * - Draw calls and triangle counts
      * - Chunk loading statistics
+     * - Job system worker utilization
+     * - General allocator traffic per subsystem (MemoryTracker)
      */
     class StatsPanel
     {
@@ -177,6 +184,16 @@ namespace SM
          */
         void DrawMemorySection();
 
+        /**
+         * @brief Draw one descriptor heap's occupancy (inside the memory section)
+         */
+        void DrawDescriptorHeapStats(const char* name, const DescriptorHeapStats& stats);
+
+        /**
+         * @brief Draw per-tag allocation counters, the per-frame history and top sampled stacks
+         */
+        void DrawAllocationsSection();
+
         /**
          * @brief Draw rendering section
          */
@@ -187,6 +204,11 @@ namespace SM
          */
         void DrawTerrainSection();
 
+        /**
+         * @brief Draw job system section
+         */
+        void DrawJobsSection();
+
         /**
          * @brief Draw FPS graph
          */
@@ -234,7 +256,17 @@ namespace SM
         // Terrain statistics
         int m_ActiveChunks = 0;
         int m_PendingChunks = 0;
+        int m_InFlightChunks = 0;
         int m_VisibleChunks = 0;
+        int m_FrustumCulledChunks = 0;
+        int m_HorizonCulledChunks = 0;
+
+        // Job system statistics (sampled every STAT_UPDATE_INTERVAL)
+        std::vector<JobWorkerStats> m_JobWorkerStats;
+
+        // Heaviest sampled allocation stacks (refreshed every STAT_UPDATE_INTERVAL)
+        static constexpr size_t TOP_ALLOCATION_SAMPLES = 8;
+        std::vector<AllocationSample> m_AllocationSamples;
 
         // FPS history for graph
         static constexpr size_t FPS_HISTORY_SIZE = 120;
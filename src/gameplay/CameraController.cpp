@@ -16,6 +16,11 @@ namespace SM
         : m_Camera(camera)
         , m_Velocity(0.0f, 0.0f, 0.0f)
     {
+        InputMapper& mapper = InputMapper::Get();
+        m_MoveForwardAxis = mapper.GetAxisHandle("MoveForward");
+        m_MoveRightAxis = mapper.GetAxisHandle("MoveRight");
+        m_MoveUpAxis = mapper.GetAxisHandle("MoveUp");
+        m_SprintAction = mapper.GetActionHandle("Sprint");
     }
 
     void FPSCameraController::Update(float deltaTime)
@@ -57,15 +62,37 @@ namespace SM
         }
     }
 
+    GameCamera FPSCameraController::GetLateLatchedCamera() const
+    {
+        GameCamera latched = m_Camera;
+
+        const Input& input = Input::Get();
+        if (input.IsMouseCaptured())
+        {
+            int deltaX = 0;
+            int deltaY = 0;
+            input.GetPendingMouseDelta(deltaX, deltaY);
+
+            // Same mapping as HandleMouseLook
+            if (deltaX != 0 || deltaY != 0)
+            {
+                latched.Rotate(-static_cast<float>(deltaY) * m_MouseSensitivity,
+                               static_cast<float>(deltaX) * m_MouseSensitivity);
+            }
+        }
+
+        return latched;
+    }
+
     void FPSCameraController::HandleMovement(float deltaTime)
     {
         InputMapper& mapper = InputMapper::Get();
         Input& input = Input::Get();
 
         // Get movement input
-        float moveForward = mapper.GetAxisValue("MoveForward");
-        float moveRight = mapper.GetAxisValue("MoveRight");
-        float moveUp = m_VerticalMovementEnabled ? mapper.GetAxisValue("MoveUp") : 0.0f;
+        float moveForward = mapper.GetAxisValue(m_MoveForwardAxis);
+        float moveRight = mapper.GetAxisValue(m_MoveRightAxis);
+        float moveUp = m_VerticalMovementEnabled ? mapper.GetAxisValue(m_MoveUpAxis) : 0.0f;
 
         // Calculate target velocity
         Vector3 targetVelocity(0.0f, 0.0f, 0.0f);
@@ -89,7 +116,7 @@ namespace SM
 
             // Calculate speed (with sprint modifier)
             float speed = m_MoveSpeed;
-            if (mapper.IsActionDown("Sprint") || input.IsKeyDown(KeyCode::Shift))
+            if (mapper.IsActionDown(m_SprintAction) || input.IsKeyDown(KeyCode::Shift))
             {
                 speed *= m_SprintMultiplier;
             }
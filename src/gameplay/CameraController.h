@@ -99,6 +99,20 @@ namespace SM
          */
         bool IsMouseCaptured() const { return Input::Get().IsMouseCaptured(); }
 
+        /**
+         * @brief Get the current (smoothed) movement velocity in units per second
+         */
+        const Vector3& GetVelocity() const { return m_Velocity; }
+
+        /**
+         * @brief Get the camera with mouse look read since Update applied
+         *
+         * Late latching: the rendered view picks up raw mouse motion that
+         * arrived after Update without touching the simulated camera. The
+         * next Update applies the same motion for real.
+         */
+        GameCamera GetLateLatchedCamera() const;
+
     private:
         /**
          * @brief Handle mouse look input
@@ -127,6 +141,12 @@ namespace SM
 
         // Options
         bool m_VerticalMovementEnabled = true;
+
+        // Mapped input, resolved once
+        AxisHandle m_MoveForwardAxis;
+        AxisHandle m_MoveRightAxis;
+        AxisHandle m_MoveUpAxis;
+        ActionHandle m_SprintAction;
     };
 
     /**
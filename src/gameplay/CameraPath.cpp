@@ -0,0 +1,81 @@
+#include "gameplay/CameraPath.h"
+#include "core/FileSystem.h"
+
+#include <cstring>
+#include <iostream>
+
+namespace SM
+{
+    float CameraPath::GetDuration() const
+    {
+        float duration = 0.0f;
+        for (const CameraPathSample& sample : m_Samples)
+        {
+            duration += sample.DeltaTime;
+        }
+        return duration;
+    }
+
+    bool CameraPath::Save(const std::string& path) const
+    {
+        FileHeader header;
+        header.Magic = PATH_MAGIC;
+        header.Version = PATH_VERSION;
+        header.SampleCount = static_cast<uint32_t>(m_Samples.size());
+        header.SampleSize = sizeof(CameraPathSample);
+
+        const size_t sampleBytes = m_Samples.size() * sizeof(CameraPathSample);
+        std::vector<uint8_t> data(sizeof(FileHeader) + sampleBytes);
+        std::memcpy(data.data(), &header, sizeof(FileHeader));
+        if (sampleBytes > 0)
+        {
+            std::memcpy(data.data() + sizeof(FileHeader), m_Samples.data(), sampleBytes);
+        }
+
+        if (!FileSystem::WriteFile(path, data))
+        {
+            std::cerr << "[CameraPath] Failed to write: " << path << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool CameraPath::Load(const std::string& path)
+    {
+        m_Samples.clear();
+
+        std::vector<uint8_t> data = FileSystem::ReadFile(path);
+        if (data.size() < sizeof(FileHeader))
+        {
+            std::cerr << "[CameraPath] Failed to read: " << path << std::endl;
+            return false;
+        }
+
+        FileHeader header;
+        std::memcpy(&header, data.data(), sizeof(FileHeader));
+
+        if (header.Magic != PATH_MAGIC || header.Version != PATH_VERSION ||
+            header.SampleSize != sizeof(CameraPathSample))
+        {
+            std::cerr << "[CameraPath] Unsupported camera path: " << path << std::endl;
+            return false;
+        }
+
+        const size_t sampleBytes = static_cast<size_t>(header.SampleCount) * sizeof(CameraPathSample);
+        if (data.size() - sizeof(FileHeader) < sampleBytes)
+        {
+            std::cerr << "[CameraPath] Truncated camera path: " << path << std::endl;
+            return false;
+        }
+
+        m_Samples.resize(header.SampleCount);
+        if (sampleBytes > 0)
+        {
+            std::memcpy(m_Samples.data(), data.data() + sizeof(FileHeader), sampleBytes);
+        }
+
+        return true;
+    }
+
+} // namespace SM
@@ -0,0 +1,84 @@
+#pragma once
+
+/**
+ * @file CameraPath.h
+ * @brief Recorded per-frame camera samples for terrain streaming replays
+ *
+ * A camera path stores exactly what the engine hands ChunkManager::Update
+ * each frame (position, view-projection and velocity) plus the frame's
+ * delta time, so a session flown with the camera controllers can be
+ * replayed headless against identical streaming workloads.
+ */
+
+#include <DirectXMath.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace SM
+{
+    /**
+     * @brief One frame of a camera path
+     */
+    struct CameraPathSample
+    {
+        float DeltaTime = 0.0f;                     ///< Frame time in seconds
+        DirectX::XMFLOAT3 Position = { 0.0f, 0.0f, 0.0f };
+        DirectX::XMFLOAT3 Velocity = { 0.0f, 0.0f, 0.0f }; ///< Units per second
+        DirectX::XMFLOAT4X4 ViewProjection = {};
+    };
+
+    /**
+     * @brief Sequence of camera samples with binary save/load
+     */
+    class CameraPath
+    {
+    public:
+        /**
+         * @brief Append a frame
+         */
+        void AddSample(const CameraPathSample& sample) { m_Samples.push_back(sample); }
+
+        /**
+         * @brief Remove all frames
+         */
+        void Clear() { m_Samples.clear(); }
+
+        const std::vector<CameraPathSample>& GetSamples() const { return m_Samples; }
+        size_t GetSampleCount() const { return m_Samples.size(); }
+        bool IsEmpty() const { return m_Samples.empty(); }
+
+        /**
+         * @brief Get the summed delta time of every frame in seconds
+         */
+        float GetDuration() const;
+
+        /**
+         * @brief Write the path to a .smcam file
+         * @return true on success
+         */
+        bool Save(const std::string& path) const;
+
+        /**
+         * @brief Replace the path with a .smcam file's contents
+         * @return true on success (the path is left empty on failure)
+         */
+        bool Load(const std::string& path);
+
+    private:
+        struct FileHeader
+        {
+            uint32_t Magic = 0;
+            uint32_t Version = 0;
+            uint32_t SampleCount = 0;
+            uint32_t SampleSize = 0;    ///< sizeof(CameraPathSample) when written
+        };
+
+        static constexpr uint32_t PATH_MAGIC = 0x4D434D53;     ///< "SMCM"
+        static constexpr uint32_t PATH_VERSION = 1;
+
+        std::vector<CameraPathSample> m_Samples;
+    };
+
+} // namespace SM
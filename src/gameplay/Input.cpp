@@ -1,10 +1,13 @@
 #include "gameplay/Input.h"
+#include "gameplay/InputAction.h"
 
 #ifndef WIN32_LEAN_AND_MEAN
 #define WIN32_LEAN_AND_MEAN
 #endif
 #include <Windows.h>
 
+#include <algorithm>
+
 namespace SM
 {
     Input::Input()
@@ -27,6 +30,26 @@ namespace SM
         m_PreviousKeyState = m_CurrentKeyState;
         m_PreviousMouseButtons = m_CurrentMouseButtons;
 
+        // Take everything queued since the last frame; the raw input thread keeps pushing
+        m_FrameEvents.clear();
+        {
+            std::lock_guard<std::mutex> lock(m_EventMutex);
+            m_FrameEvents.swap(m_PendingEvents);
+        }
+
+        // Events from different sources arrive slightly out of order
+        std::stable_sort(m_FrameEvents.begin(), m_FrameEvents.end(),
+            [](const InputEvent& a, const InputEvent& b) { return a.Timestamp < b.Timestamp; });
+
+        for (const InputEvent& event : m_FrameEvents)
+        {
+            if (event.Type == InputEventType::MouseMove)
+            {
+                m_RawMouseDeltaX += event.DeltaX;
+                m_RawMouseDeltaY += event.DeltaY;
+            }
+        }
+
         // Update mouse delta
         if (m_MouseCaptured)
         {
@@ -52,6 +75,9 @@ namespace SM
 
         // Update mouse capture if needed
         UpdateMouseCapture();
+
+        // Resolve every mapped action and axis once for the frame
+        InputMapper::Get().Update(*this);
     }
 
     void Input::Reset()
@@ -65,6 +91,9 @@ namespace SM
         m_MouseDeltaX = m_MouseDeltaY = 0;
         m_RawMouseDeltaX = m_RawMouseDeltaY = 0;
         m_MouseWheelDelta = 0.0f;
+
+        std::lock_guard<std::mutex> lock(m_EventMutex);
+        m_PendingEvents.clear();
     }
 
     void Input::ProcessKeyDown(uint32_t virtualKeyCode)
@@ -73,6 +102,14 @@ namespace SM
         if (key != KeyCode::Count)
         {
             m_CurrentKeyState[static_cast<size_t>(key)] = true;
+
+            InputEvent event;
+            event.Timestamp = GetTimestamp();
+            event.Type = InputEventType::KeyDown;
+            event.Key = key;
+
+            std::lock_guard<std::mutex> lock(m_EventMutex);
+            m_PendingEvents.push_back(event);
         }
     }
 
@@ -82,6 +119,14 @@ namespace SM
         if (key != KeyCode::Count)
         {
             m_CurrentKeyState[static_cast<size_t>(key)] = false;
+
+            InputEvent event;
+            event.Timestamp = GetTimestamp();
+            event.Type = InputEventType::KeyUp;
+            event.Key = key;
+
+            std::lock_guard<std::mutex> lock(m_EventMutex);
+            m_PendingEvents.push_back(event);
         }
     }
 
@@ -122,8 +167,53 @@ namespace SM
 
     void Input::ProcessRawMouseInput(int deltaX, int deltaY)
     {
-        m_RawMouseDeltaX += deltaX;
-        m_RawMouseDeltaY += deltaY;
+        PushRawMouseInput(deltaX, deltaY, GetTimestamp());
+    }
+
+    void Input::PushRawMouseInput(int deltaX, int deltaY, int64_t timestamp)
+    {
+        InputEvent event;
+        event.Timestamp = timestamp;
+        event.Type = InputEventType::MouseMove;
+        event.DeltaX = deltaX;
+        event.DeltaY = deltaY;
+
+        std::lock_guard<std::mutex> lock(m_EventMutex);
+        m_PendingEvents.push_back(event);
+    }
+
+    void Input::GetPendingMouseDelta(int& deltaX, int& deltaY) const
+    {
+        deltaX = 0;
+        deltaY = 0;
+
+        std::lock_guard<std::mutex> lock(m_EventMutex);
+        for (const InputEvent& event : m_PendingEvents)
+        {
+            if (event.Type == InputEventType::MouseMove)
+            {
+                deltaX += event.DeltaX;
+                deltaY += event.DeltaY;
+            }
+        }
+    }
+
+    int64_t Input::GetTimestamp()
+    {
+        LARGE_INTEGER counter;
+        QueryPerformanceCounter(&counter);
+        return counter.QuadPart;
+    }
+
+    int64_t Input::GetTimestampFrequency()
+    {
+        static const int64_t frequency = []()
+        {
+            LARGE_INTEGER value;
+            QueryPerformanceFrequency(&value);
+            return value.QuadPart;
+        }();
+        return frequency;
     }
 
     bool Input::IsKeyDown(KeyCode key) const
@@ -208,35 +298,10 @@ namespace SM
 
         m_MouseCaptured = capture;
 
-        if (m_WindowHandle)
+        // Other threads leave the Win32 side to ApplyPendingMouseCapture
+        if (std::this_thread::get_id() == m_WindowThread)
         {
-            HWND hwnd = static_cast<HWND>(m_WindowHandle);
-
-            if (capture)
-            {
-                // Capture mouse
-                SetCapture(hwnd);
-                ShowCursor(FALSE);
-
-                // Center cursor in window
-                RECT rect;
-                GetClientRect(hwnd, &rect);
-                POINT center = { (rect.right - rect.left) / 2, (rect.bottom - rect.top) / 2 };
-                ClientToScreen(hwnd, &center);
-                SetCursorPos(center.x, center.y);
-
-                // Update our stored position
-                m_MouseX = (rect.right - rect.left) / 2;
-                m_MouseY = (rect.bottom - rect.top) / 2;
-                m_PreviousMouseX = m_MouseX;
-                m_PreviousMouseY = m_MouseY;
-            }
-            else
-            {
-                // Release mouse
-                ReleaseCapture();
-                ShowCursor(TRUE);
-            }
+            ApplyMouseCapture();
         }
 
         // Reset deltas
@@ -246,6 +311,48 @@ namespace SM
         m_MouseDeltaY = 0;
     }
 
+    void Input::ApplyPendingMouseCapture()
+    {
+        ApplyMouseCapture();
+    }
+
+    void Input::ApplyMouseCapture()
+    {
+        if (!m_WindowHandle || m_CursorCaptured == m_MouseCaptured)
+        {
+            return;
+        }
+
+        m_CursorCaptured = m_MouseCaptured;
+        HWND hwnd = static_cast<HWND>(m_WindowHandle);
+
+        if (m_MouseCaptured)
+        {
+            // Capture mouse
+            SetCapture(hwnd);
+            ShowCursor(FALSE);
+
+            // Center cursor in window
+            RECT rect;
+            GetClientRect(hwnd, &rect);
+            POINT center = { (rect.right - rect.left) / 2, (rect.bottom - rect.top) / 2 };
+            ClientToScreen(hwnd, &center);
+            SetCursorPos(center.x, center.y);
+
+            // Update our stored position
+            m_MouseX = (rect.right - rect.left) / 2;
+            m_MouseY = (rect.bottom - rect.top) / 2;
+            m_PreviousMouseX = m_MouseX;
+            m_PreviousMouseY = m_MouseY;
+        }
+        else
+        {
+            // Release mouse
+            ReleaseCapture();
+            ShowCursor(TRUE);
+        }
+    }
+
     void Input::UpdateMouseCapture()
     {
         // Keep cursor centered when captured
@@ -9,7 +9,11 @@
  */
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace SM
 {
@@ -117,6 +121,28 @@ namespace SM
         Count = 5
     };
 
+    /**
+     * @brief Kind of a timestamped input event
+     */
+    enum class InputEventType : uint8_t
+    {
+        MouseMove,  ///< Raw relative motion (DeltaX, DeltaY)
+        KeyDown,    ///< Key
+        KeyUp       ///< Key
+    };
+
+    /**
+     * @brief One input event with the time it was read
+     */
+    struct InputEvent
+    {
+        int64_t Timestamp = 0;              ///< QueryPerformanceCounter ticks
+        InputEventType Type = InputEventType::MouseMove;
+        int DeltaX = 0;
+        int DeltaY = 0;
+        KeyCode Key = KeyCode::Count;
+    };
+
     /**
      * @brief Input system singleton class
      *
@@ -140,7 +166,8 @@ namespace SM
          * @brief Update input state at the start of each frame
          *
          * Must be called once per frame before checking input state.
-         * Copies current state to previous state and resets per-frame values.
+         * Copies current state to previous state, resets per-frame values
+         * and evaluates every InputMapper action and axis.
          */
         void Update();
 
@@ -194,6 +221,48 @@ namespace SM
          */
         void ProcessRawMouseInput(int deltaX, int deltaY);
 
+        /**
+         * @brief Queue raw mouse motion read at a known time
+         * @param deltaX Raw X movement
+         * @param deltaY Raw Y movement
+         * @param timestamp QueryPerformanceCounter ticks when it was read
+         *
+         * Thread-safe; the raw input thread calls this directly.
+         */
+        void PushRawMouseInput(int deltaX, int deltaY, int64_t timestamp);
+
+        // ====================================================================
+        // Timestamped events
+        // ====================================================================
+
+        /**
+         * @brief Get the events consumed by the last Update, oldest first
+         *
+         * Lets gameplay integrate motion at sub-frame times instead of
+         * treating the whole frame's input as one step.
+         */
+        const std::vector<InputEvent>& GetFrameEvents() const { return m_FrameEvents; }
+
+        /**
+         * @brief Sum the raw mouse motion queued since the last Update
+         * @param deltaX Receives the X movement
+         * @param deltaY Receives the Y movement
+         *
+         * Does not consume it: the next Update still applies the motion.
+         * Used to late-latch the rendered camera.
+         */
+        void GetPendingMouseDelta(int& deltaX, int& deltaY) const;
+
+        /**
+         * @brief Get the current QueryPerformanceCounter value
+         */
+        static int64_t GetTimestamp();
+
+        /**
+         * @brief Get QueryPerformanceCounter ticks per second
+         */
+        static int64_t GetTimestampFrequency();
+
         // ====================================================================
         // Keyboard state queries
         // ====================================================================
@@ -304,8 +373,23 @@ namespace SM
         /**
          * @brief Set the window handle for mouse capture operations
          * @param hwnd Window handle
+         *
+         * Call from the window's thread; capture changes requested on other
+         * threads wait for ApplyPendingMouseCapture there.
+         */
+        void SetWindowHandle(void* hwnd)
+        {
+            m_WindowHandle = hwnd;
+            m_WindowThread = std::this_thread::get_id();
+        }
+
+        /**
+         * @brief Apply a mouse capture change requested off the window's thread
+         *
+         * Win32 capture and cursor visibility belong to the thread that owns
+         * the window, so a simulation thread only records the request.
          */
-        void SetWindowHandle(void* hwnd) { m_WindowHandle = hwnd; }
+        void ApplyPendingMouseCapture();
 
         // ====================================================================
         // Utility
@@ -334,6 +418,11 @@ namespace SM
          */
         void UpdateMouseCapture();
 
+        /**
+         * @brief Bring the Win32 capture and cursor in line with m_MouseCaptured (window thread)
+         */
+        void ApplyMouseCapture();
+
     private:
         // Key states
         static constexpr size_t KEY_COUNT = static_cast<size_t>(KeyCode::Count);
@@ -362,7 +451,14 @@ namespace SM
 
         // Mouse capture
         bool m_MouseCaptured = false;
+        bool m_CursorCaptured = false;          ///< Win32 state, behind m_MouseCaptured until applied
         void* m_WindowHandle = nullptr;
+        std::thread::id m_WindowThread;
+
+        // Timestamped events; pending ones may be pushed from the raw input thread
+        mutable std::mutex m_EventMutex;
+        std::vector<InputEvent> m_PendingEvents;    ///< Guarded by m_EventMutex
+        std::vector<InputEvent> m_FrameEvents;
     };
 
 } // namespace SM
@@ -1,5 +1,7 @@
 #include "gameplay/InputAction.h"
 
+#include <algorithm>
+
 namespace SM
 {
     // ========================================================================
@@ -91,23 +93,90 @@ namespace SM
 
     void InputMapper::Clear()
     {
-        m_Actions.clear();
-        m_Axes.clear();
+        for (InputAction& action : m_Actions)
+        {
+            action.Bindings.clear();
+        }
+        for (InputAxis& axis : m_Axes)
+        {
+            axis.Bindings.clear();
+        }
+
+        std::fill(m_ActionStates.begin(), m_ActionStates.end(), uint8_t(0));
+        std::fill(m_AxisValues.begin(), m_AxisValues.end(), 0.0f);
+    }
+
+    void InputMapper::Update(const Input& input)
+    {
+        for (size_t i = 0; i < m_Actions.size(); ++i)
+        {
+            bool anyDown = false;
+            bool anyPressed = false;
+            bool anyReleased = false;
+
+            for (const auto& binding : m_Actions[i].Bindings)
+            {
+                anyDown |= input.IsKeyDown(binding.Key);
+                anyPressed |= input.IsKeyPressed(binding.Key);
+                anyReleased |= input.IsKeyReleased(binding.Key);
+            }
+
+            // Released only once every bound key is up, as InputAction::WasReleased
+            uint8_t state = 0;
+            if (anyDown) state |= ACTION_DOWN;
+            if (anyPressed) state |= ACTION_PRESSED;
+            if (anyReleased && !anyDown) state |= ACTION_RELEASED;
+            m_ActionStates[i] = state;
+        }
+
+        for (size_t i = 0; i < m_Axes.size(); ++i)
+        {
+            float value = 0.0f;
+            for (const auto& binding : m_Axes[i].Bindings)
+            {
+                if (input.IsKeyDown(binding.Key))
+                {
+                    value += binding.Scale;
+                }
+            }
+            m_AxisValues[i] = std::clamp(value, -1.0f, 1.0f);
+        }
+    }
+
+    uint32_t InputMapper::FindAction(const std::string& name) const
+    {
+        auto it = m_ActionIndices.find(name);
+        return it != m_ActionIndices.end() ? it->second : ActionHandle::INVALID_INDEX;
+    }
+
+    uint32_t InputMapper::FindAxis(const std::string& name) const
+    {
+        auto it = m_AxisIndices.find(name);
+        return it != m_AxisIndices.end() ? it->second : AxisHandle::INVALID_INDEX;
     }
 
     InputAction& InputMapper::CreateAction(const std::string& name)
     {
-        auto it = m_Actions.find(name);
-        if (it != m_Actions.end())
+        uint32_t index = FindAction(name);
+        if (index != ActionHandle::INVALID_INDEX)
         {
-            return it->second;
+            return m_Actions[index];
         }
 
-        InputAction& action = m_Actions[name];
+        m_ActionIndices.emplace(name, static_cast<uint32_t>(m_Actions.size()));
+        m_ActionStates.push_back(0);
+
+        InputAction& action = m_Actions.emplace_back();
         action.Name = name;
         return action;
     }
 
+    ActionHandle InputMapper::GetActionHandle(const std::string& name)
+    {
+        CreateAction(name);
+        return ActionHandle{ FindAction(name) };
+    }
+
     void InputMapper::BindAction(const std::string& actionName, KeyCode key)
     {
         InputAction& action = CreateAction(actionName);
@@ -134,13 +203,13 @@ namespace SM
 
     void InputMapper::UnbindAction(const std::string& actionName, KeyCode key)
     {
-        auto it = m_Actions.find(actionName);
-        if (it == m_Actions.end())
+        uint32_t index = FindAction(actionName);
+        if (index == ActionHandle::INVALID_INDEX)
         {
             return;
         }
 
-        auto& bindings = it->second.Bindings;
+        auto& bindings = m_Actions[index].Bindings;
         bindings.erase(
             std::remove_if(bindings.begin(), bindings.end(),
                 [key](const InputBinding& b) { return b.Key == key; }),
@@ -150,59 +219,61 @@ namespace SM
 
     void InputMapper::ClearAction(const std::string& actionName)
     {
-        auto it = m_Actions.find(actionName);
-        if (it != m_Actions.end())
+        uint32_t index = FindAction(actionName);
+        if (index != ActionHandle::INVALID_INDEX)
         {
-            it->second.Bindings.clear();
+            m_Actions[index].Bindings.clear();
         }
     }
 
     bool InputMapper::HasAction(const std::string& name) const
     {
-        return m_Actions.find(name) != m_Actions.end();
+        return FindAction(name) != ActionHandle::INVALID_INDEX;
     }
 
     const InputAction* InputMapper::GetAction(const std::string& name) const
     {
-        auto it = m_Actions.find(name);
-        if (it != m_Actions.end())
-        {
-            return &it->second;
-        }
-        return nullptr;
+        uint32_t index = FindAction(name);
+        return index != ActionHandle::INVALID_INDEX ? &m_Actions[index] : nullptr;
     }
 
     bool InputMapper::IsActionDown(const std::string& actionName) const
     {
-        const InputAction* action = GetAction(actionName);
-        return action ? action->IsActive() : false;
+        return IsActionDown(ActionHandle{ FindAction(actionName) });
     }
 
     bool InputMapper::IsActionPressed(const std::string& actionName) const
     {
-        const InputAction* action = GetAction(actionName);
-        return action ? action->WasPressed() : false;
+        return IsActionPressed(ActionHandle{ FindAction(actionName) });
     }
 
     bool InputMapper::IsActionReleased(const std::string& actionName) const
     {
-        const InputAction* action = GetAction(actionName);
-        return action ? action->WasReleased() : false;
+        return IsActionReleased(ActionHandle{ FindAction(actionName) });
     }
 
     InputAxis& InputMapper::CreateAxis(const std::string& name)
     {
-        auto it = m_Axes.find(name);
-        if (it != m_Axes.end())
+        uint32_t index = FindAxis(name);
+        if (index != AxisHandle::INVALID_INDEX)
         {
-            return it->second;
+            return m_Axes[index];
         }
 
-        InputAxis& axis = m_Axes[name];
+        m_AxisIndices.emplace(name, static_cast<uint32_t>(m_Axes.size()));
+        m_AxisValues.push_back(0.0f);
+
+        InputAxis& axis = m_Axes.emplace_back();
         axis.Name = name;
         return axis;
     }
 
+    AxisHandle InputMapper::GetAxisHandle(const std::string& name)
+    {
+        CreateAxis(name);
+        return AxisHandle{ FindAxis(name) };
+    }
+
     void InputMapper::BindAxis(const std::string& axisName, KeyCode key, float scale)
     {
         InputAxis& axis = CreateAxis(axisName);
@@ -228,13 +299,13 @@ namespace SM
 
     void InputMapper::UnbindAxis(const std::string& axisName, KeyCode key)
     {
-        auto it = m_Axes.find(axisName);
-        if (it == m_Axes.end())
+        uint32_t index = FindAxis(axisName);
+        if (index == AxisHandle::INVALID_INDEX)
         {
             return;
         }
 
-        auto& bindings = it->second.Bindings;
+        auto& bindings = m_Axes[index].Bindings;
         bindings.erase(
             std::remove_if(bindings.begin(), bindings.end(),
                 [key](const InputBinding& b) { return b.Key == key; }),
@@ -244,32 +315,27 @@ namespace SM
 
     void InputMapper::ClearAxis(const std::string& axisName)
     {
-        auto it = m_Axes.find(axisName);
-        if (it != m_Axes.end())
+        uint32_t index = FindAxis(axisName);
+        if (index != AxisHandle::INVALID_INDEX)
         {
-            it->second.Bindings.clear();
+            m_Axes[index].Bindings.clear();
         }
     }
 
     bool InputMapper::HasAxis(const std::string& name) const
     {
-        return m_Axes.find(name) != m_Axes.end();
+        return FindAxis(name) != AxisHandle::INVALID_INDEX;
     }
 
     const InputAxis* InputMapper::GetAxis(const std::string& name) const
     {
-        auto it = m_Axes.find(name);
-        if (it != m_Axes.end())
-        {
-            return &it->second;
-        }
-        return nullptr;
+        uint32_t index = FindAxis(name);
+        return index != AxisHandle::INVALID_INDEX ? &m_Axes[index] : nullptr;
     }
 
     float InputMapper::GetAxisValue(const std::string& axisName) const
     {
-        const InputAxis* axis = GetAxis(axisName);
-        return axis ? axis->GetValue() : 0.0f;
+        return GetAxisValue(AxisHandle{ FindAxis(axisName) });
     }
 
     void InputMapper::SetupDefaultBindings()
@@ -6,16 +6,45 @@
  *
  * Provides a higher-level abstraction over raw input, allowing
  * named actions and axes to be bound to multiple input keys.
+ *
+ * Names are interned into handles once; Input::Update evaluates every
+ * action and axis in one pass, so handle queries are plain array reads.
  */
 
 #include "gameplay/Input.h"
 
+#include <cstdint>
+#include <deque>
 #include <string>
 #include <vector>
 #include <unordered_map>
 
 namespace SM
 {
+    /**
+     * @brief Interned action name, resolved once with InputMapper::GetActionHandle
+     */
+    struct ActionHandle
+    {
+        static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+        uint32_t Index = INVALID_INDEX;
+
+        bool IsValid() const { return Index != INVALID_INDEX; }
+    };
+
+    /**
+     * @brief Interned axis name, resolved once with InputMapper::GetAxisHandle
+     */
+    struct AxisHandle
+    {
+        static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+        uint32_t Index = INVALID_INDEX;
+
+        bool IsValid() const { return Index != INVALID_INDEX; }
+    };
+
     /**
      * @brief Represents a single input binding
      */
@@ -88,9 +117,20 @@ namespace SM
 
         /**
          * @brief Clear all bindings
+         *
+         * Names stay interned, so handles resolved earlier remain valid
+         * and simply report no input until their names are bound again.
          */
         void Clear();
 
+        /**
+         * @brief Evaluate every action and axis against the current key state
+         * @param input Input state for this frame
+         *
+         * Called once per frame by Input::Update.
+         */
+        void Update(const Input& input);
+
         // ====================================================================
         // Action binding
         // ====================================================================
@@ -143,10 +183,34 @@ namespace SM
          */
         const InputAction* GetAction(const std::string& name) const;
 
+        /**
+         * @brief Intern an action name
+         * @param name Action name (created without bindings if missing)
+         * @return Handle valid for the mapper's lifetime
+         */
+        ActionHandle GetActionHandle(const std::string& name);
+
+        /**
+         * @brief Check if an action is currently pressed (any key down)
+         */
+        bool IsActionDown(ActionHandle action) const { return (GetActionState(action) & ACTION_DOWN) != 0; }
+
+        /**
+         * @brief Check if an action was just pressed this frame
+         */
+        bool IsActionPressed(ActionHandle action) const { return (GetActionState(action) & ACTION_PRESSED) != 0; }
+
+        /**
+         * @brief Check if an action was just released this frame
+         */
+        bool IsActionReleased(ActionHandle action) const { return (GetActionState(action) & ACTION_RELEASED) != 0; }
+
         /**
          * @brief Check if an action is currently pressed (any key down)
          * @param actionName Action name
          * @return true if action is active
+         *
+         * Hashes the name on every call; prefer the ActionHandle overload per frame.
          */
         bool IsActionDown(const std::string& actionName) const;
 
@@ -218,10 +282,28 @@ namespace SM
          */
         const InputAxis* GetAxis(const std::string& name) const;
 
+        /**
+         * @brief Intern an axis name
+         * @param name Axis name (created without bindings if missing)
+         * @return Handle valid for the mapper's lifetime
+         */
+        AxisHandle GetAxisHandle(const std::string& name);
+
+        /**
+         * @brief Get the value of an axis as of the last Update
+         * @return Axis value in range [-1, 1], 0 for an invalid handle
+         */
+        float GetAxisValue(AxisHandle axis) const
+        {
+            return axis.Index < m_AxisValues.size() ? m_AxisValues[axis.Index] : 0.0f;
+        }
+
         /**
          * @brief Get the current value of an axis
          * @param axisName Axis name
          * @return Axis value in range [-1, 1], 0 if axis not found
+         *
+         * Hashes the name on every call; prefer the AxisHandle overload per frame.
          */
         float GetAxisValue(const std::string& axisName) const;
 
@@ -245,23 +327,42 @@ namespace SM
 
         /**
          * @brief Get all actions
-         * @return Map of action names to actions
+         * @return Actions indexed by ActionHandle::Index
          */
-        const std::unordered_map<std::string, InputAction>& GetActions() const { return m_Actions; }
+        const std::deque<InputAction>& GetActions() const { return m_Actions; }
 
         /**
          * @brief Get all axes
-         * @return Map of axis names to axes
+         * @return Axes indexed by AxisHandle::Index
          */
-        const std::unordered_map<std::string, InputAxis>& GetAxes() const { return m_Axes; }
+        const std::deque<InputAxis>& GetAxes() const { return m_Axes; }
 
     private:
         InputMapper() = default;
         ~InputMapper() = default;
 
+        // Per-action state bits filled by Update
+        static constexpr uint8_t ACTION_DOWN = 0x01;
+        static constexpr uint8_t ACTION_PRESSED = 0x02;
+        static constexpr uint8_t ACTION_RELEASED = 0x04;
+
+        uint8_t GetActionState(ActionHandle action) const
+        {
+            return action.Index < m_ActionStates.size() ? m_ActionStates[action.Index] : 0;
+        }
+
+        uint32_t FindAction(const std::string& name) const;
+        uint32_t FindAxis(const std::string& name) const;
+
     private:
-        std::unordered_map<std::string, InputAction> m_Actions;
-        std::unordered_map<std::string, InputAxis> m_Axes;
+        // Deques keep references from CreateAction/CreateAxis stable
+        std::deque<InputAction> m_Actions;
+        std::deque<InputAxis> m_Axes;
+        std::unordered_map<std::string, uint32_t> m_ActionIndices;
+        std::unordered_map<std::string, uint32_t> m_AxisIndices;
+
+        std::vector<uint8_t> m_ActionStates;    ///< ACTION_* bits per action
+        std::vector<float> m_AxisValues;        ///< Clamped value per axis
     };
 
 } // namespace SM
@@ -3,6 +3,16 @@
  * @brief Shattered Moon - Application entry point
  *
  * Win32 application entry point that initializes and runs the engine.
+ *
+ * Command line:
+ *   --benchmark[=<frames>]       Run the scripted benchmark scene (default 1000 frames), vsync off
+ *   --benchmark-props=<count>    Instanced ECS props in the benchmark scene
+ *   --benchmark-view=<distance>  Terrain view distance in the benchmark scene
+ *   --benchmark-out=<file.csv>   Per-frame results (default benchmark.csv)
+ *   --input-thread               Read raw mouse input on a dedicated thread
+ *   --window-thread              Pump window messages on a dedicated thread
+ *   --sim-thread                 Tick input and ECS systems on a fixed-rate simulation thread
+ *   --sim-hz=<rate>              Simulation tick rate with --sim-thread (default 60)
  */
 
 #include "core/Engine.h"
@@ -13,6 +23,68 @@
 
 #include <Windows.h>
 
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+namespace
+{
+    /**
+     * @brief Apply command-line options to the engine configuration
+     */
+    void ParseCommandLine(const char* commandLine, SM::EngineConfig& config)
+    {
+        std::istringstream stream(commandLine ? commandLine : "");
+        std::string arg;
+
+        while (stream >> arg)
+        {
+            if (arg == "--benchmark")
+            {
+                config.benchmarkFrames = 1000;
+            }
+            else if (arg.rfind("--benchmark=", 0) == 0)
+            {
+                config.benchmarkFrames = static_cast<uint32_t>(std::strtoul(arg.c_str() + 12, nullptr, 10));
+            }
+            else if (arg.rfind("--benchmark-props=", 0) == 0)
+            {
+                config.benchmarkProps = static_cast<uint32_t>(std::strtoul(arg.c_str() + 18, nullptr, 10));
+            }
+            else if (arg.rfind("--benchmark-view=", 0) == 0)
+            {
+                config.benchmarkViewDistance = std::strtof(arg.c_str() + 17, nullptr);
+            }
+            else if (arg.rfind("--benchmark-out=", 0) == 0)
+            {
+                config.benchmarkOutput = arg.substr(16);
+            }
+            else if (arg == "--input-thread")
+            {
+                config.rawInputThread = true;
+            }
+            else if (arg == "--window-thread")
+            {
+                config.windowMessageThread = true;
+            }
+            else if (arg == "--sim-thread")
+            {
+                config.threadedSimulation = true;
+            }
+            else if (arg.rfind("--sim-hz=", 0) == 0)
+            {
+                config.simulationHz = std::strtof(arg.c_str() + 9, nullptr);
+            }
+        }
+
+        // Frame times must not be capped by the display
+        if (config.benchmarkFrames > 0)
+        {
+            config.vsync = false;
+        }
+    }
+}
+
 /**
  * @brief Win32 application entry point
  *
@@ -31,7 +103,6 @@ int WINAPI WinMain(
     // Suppress unused parameter warnings
     (void)hInstance;
     (void)hPrevInstance;
-    (void)lpCmdLine;
     (void)nCmdShow;
 
     // Enable memory leak detection in debug builds
@@ -46,18 +117,23 @@ int WINAPI WinMain(
     config.windowHeight = 720;
     config.vsync = true;
     config.fullscreen = false;
+    ParseCommandLine(lpCmdLine, config);
 
     // Get engine instance and initialize
     SM::Engine& engine = SM::Engine::Get();
 
     if (!engine.Initialize(config))
     {
-        MessageBoxW(
-            nullptr,
-            L"Failed to initialize engine!",
-            L"Shattered Moon - Error",
-            MB_OK | MB_ICONERROR
-        );
+        // Unattended benchmark runs must not block on a dialog
+        if (config.benchmarkFrames == 0)
+        {
+            MessageBoxW(
+                nullptr,
+                L"Failed to initialize engine!",
+                L"Shattered Moon - Error",
+                MB_OK | MB_ICONERROR
+            );
+        }
         return -1;
     }
 
@@ -1,6 +1,7 @@
 #include "Biome.h"
 #include "Noise.h"
 #include "FBM.h"
+#include "NoiseSIMD.h"
 #include <algorithm>
 #include <cmath>
 
@@ -10,9 +11,86 @@ namespace PCG {
     // BiomeMap Implementation
     // ============================================================================
 
+    namespace {
+
+        uint32_t PackColor(const float color[4])
+        {
+            uint32_t packed = 0;
+            for (int i = 0; i < 4; ++i) {
+                float c = std::clamp(color[i], 0.0f, 1.0f);
+                packed |= static_cast<uint32_t>(c * 255.0f + 0.5f) << (i * 8);
+            }
+            return packed;
+        }
+
+        /**
+         * @brief Sample FBM every step pixels and bilinearly upsample to width x height
+         */
+        void SampleClimateField(const FBM& fbm, const FBMSettings& settings, int width, int height, int step, float* out)
+        {
+            if (step <= 1) {
+                fbm.SampleGrid(0.0f, 0.0f, 1.0f, width, height, settings, out);
+                return;
+            }
+
+            // One sample past the last pixel, so every pixel lies inside a coarse cell
+            const int coarseWidth = (width - 1) / step + 2;
+            const int coarseHeight = (height - 1) / step + 2;
+            std::vector<float> coarse(static_cast<size_t>(coarseWidth) * coarseHeight);
+            fbm.SampleGrid(0.0f, 0.0f, static_cast<float>(step), coarseWidth, coarseHeight, settings, coarse.data());
+
+            const float invStep = 1.0f / static_cast<float>(step);
+            std::vector<float> column(coarseWidth);
+
+            for (int y = 0; y < height; ++y) {
+                // Blend the two coarse rows once, then only along the row
+                const int cy = y / step;
+                const float ty = static_cast<float>(y - cy * step) * invStep;
+                const float* top = coarse.data() + static_cast<size_t>(cy) * coarseWidth;
+                const float* bottom = top + coarseWidth;
+                for (int cx = 0; cx < coarseWidth; ++cx) {
+                    column[cx] = top[cx] + (bottom[cx] - top[cx]) * ty;
+                }
+
+                float* row = out + static_cast<size_t>(y) * width;
+                for (int x = 0; x < width; ++x) {
+                    const int cx = x / step;
+                    const float tx = static_cast<float>(x - cx * step) * invStep;
+                    row[x] = column[cx] + (column[cx + 1] - column[cx]) * tx;
+                }
+            }
+        }
+
+    } // anonymous namespace
+
     BiomeMap::BiomeMap()
     {
         InitializeDefaultBiomes();
+        RebuildLookup();
+    }
+
+    void BiomeMap::RebuildLookup()
+    {
+        for (size_t i = 0; i < m_BiomeData.size(); ++i) {
+            m_PackedColors[i] = PackColor(m_BiomeData[i].Color);
+        }
+
+        // Each cell holds the exact classification at its centre
+        const int resolution = LOOKUP_RESOLUTION;
+        const float cellSize = 1.0f / static_cast<float>(resolution);
+        m_Lookup.resize(static_cast<size_t>(resolution) * resolution * resolution);
+
+        size_t index = 0;
+        for (int h = 0; h < resolution; ++h) {
+            float height = (static_cast<float>(h) + 0.5f) * cellSize;
+            for (int m = 0; m < resolution; ++m) {
+                float moisture = (static_cast<float>(m) + 0.5f) * cellSize;
+                for (int t = 0; t < resolution; ++t) {
+                    float temperature = (static_cast<float>(t) + 0.5f) * cellSize;
+                    m_Lookup[index++] = GetBiomeExact(height, moisture, temperature);
+                }
+            }
+        }
     }
 
     void BiomeMap::InitializeDefaultBiomes()
@@ -296,7 +374,7 @@ namespace PCG {
         return BiomeType::Marsh;
     }
 
-    BiomeType BiomeMap::GetBiome(float height, float moisture, float temperature) const
+    BiomeType BiomeMap::GetBiomeExact(float height, float moisture, float temperature) const
     {
         // Find best matching biome
         BiomeType bestBiome = BiomeType::Plains;
@@ -319,6 +397,40 @@ namespace PCG {
         return bestBiome;
     }
 
+    void BiomeMap::ClassifyBatch(const float* heights, const float* moisture, const float* temperature,
+                                 size_t count, BiomeType* out) const
+    {
+        size_t i = 0;
+
+#if PCG_NOISE_SIMD
+        // Quantize a lane of points at once; the table reads stay scalar (byte gathers don't exist)
+        const SIMD::VFloat scale = SIMD::Set1(static_cast<float>(LOOKUP_RESOLUTION));
+        const SIMD::VFloat zero = SIMD::Set1(0.0f);
+        const SIMD::VFloat maxCell = SIMD::Set1(static_cast<float>(LOOKUP_RESOLUTION - 1));
+        const SIMD::VInt stride = SIMD::Set1(static_cast<int32_t>(LOOKUP_RESOLUTION));
+
+        // Max(x, 0) returns 0 for NaN lanes, matching GetLookupCell
+        auto cells = [&](const float* p) {
+            return SIMD::ToInt(SIMD::Min(SIMD::Max(SIMD::Mul(SIMD::Load(p), scale), zero), maxCell));
+        };
+
+        alignas(32) int32_t indices[SIMD::Width];
+        for (; i + SIMD::Width <= count; i += SIMD::Width) {
+            SIMD::VInt index = SIMD::Add(SIMD::Mul(cells(heights + i), stride), cells(moisture + i));
+            index = SIMD::Add(SIMD::Mul(index, stride), cells(temperature + i));
+            SIMD::Store(indices, index);
+
+            for (int lane = 0; lane < SIMD::Width; ++lane) {
+                out[i + lane] = m_Lookup[indices[lane]];
+            }
+        }
+#endif
+
+        for (; i < count; ++i) {
+            out[i] = GetBiome(heights[i], moisture[i], temperature[i]);
+        }
+    }
+
     const BiomeData& BiomeMap::GetBiomeData(BiomeType type) const
     {
         return m_BiomeData[static_cast<size_t>(type)];
@@ -347,7 +459,20 @@ namespace PCG {
 
     void BiomeMap::SetBiomeData(BiomeType type, const BiomeData& data)
     {
-        m_BiomeData[static_cast<size_t>(type)] = data;
+        BiomeData& current = m_BiomeData[static_cast<size_t>(type)];
+        bool rangesChanged = current.Type != data.Type ||
+                             current.MinHeight != data.MinHeight || current.MaxHeight != data.MaxHeight ||
+                             current.MinMoisture != data.MinMoisture || current.MaxMoisture != data.MaxMoisture ||
+                             current.MinTemperature != data.MinTemperature || current.MaxTemperature != data.MaxTemperature;
+
+        current = data;
+
+        // Presets mostly recolor; only a range change needs the table rebuilt
+        if (rangesChanged) {
+            RebuildLookup();
+        } else {
+            m_PackedColors[static_cast<size_t>(type)] = PackColor(current.Color);
+        }
     }
 
     // ============================================================================
@@ -367,18 +492,8 @@ namespace PCG {
         m_TemperatureMap = GenerateTemperatureMap(settings);
 
         std::vector<BiomeType> biomes(settings.Width * settings.Height);
-
-        for (int y = 0; y < settings.Height; ++y) {
-            for (int x = 0; x < settings.Width; ++x) {
-                int idx = y * settings.Width + x;
-
-                float height = heightmap[idx];
-                float moisture = m_MoistureMap[idx];
-                float temperature = m_TemperatureMap[idx];
-
-                biomes[idx] = biomeMap.GetBiome(height, moisture, temperature);
-            }
-        }
+        biomeMap.ClassifyBatch(heightmap.data(), m_MoistureMap.data(), m_TemperatureMap.data(),
+                               biomes.size(), biomes.data());
 
         return biomes;
     }
@@ -395,12 +510,11 @@ namespace PCG {
         fbmSettings.Octaves = settings.MoistureOctaves;
         fbmSettings.Persistence = 0.5f;
 
-        for (int y = 0; y < settings.Height; ++y) {
-            for (int x = 0; x < settings.Width; ++x) {
-                float value = fbm.Sample(static_cast<float>(x), static_cast<float>(y), fbmSettings);
-                // Remap from [-1, 1] to [0, 1]
-                moisture[y * settings.Width + x] = (value + 1.0f) * 0.5f;
-            }
+        SampleClimateField(fbm, fbmSettings, settings.Width, settings.Height, settings.ClimateStep, moisture.data());
+
+        // Remap from [-1, 1] to [0, 1]
+        for (float& value : moisture) {
+            value = (value + 1.0f) * 0.5f;
         }
 
         return moisture;
@@ -418,11 +532,12 @@ namespace PCG {
         fbmSettings.Octaves = settings.TemperatureOctaves;
         fbmSettings.Persistence = 0.4f;
 
+        // Base temperature from noise
+        SampleClimateField(fbm, fbmSettings, settings.Width, settings.Height, settings.ClimateStep, temperature.data());
+
         for (int y = 0; y < settings.Height; ++y) {
             for (int x = 0; x < settings.Width; ++x) {
-                // Base temperature from noise
-                float noiseValue = fbm.Sample(static_cast<float>(x), static_cast<float>(y), fbmSettings);
-                noiseValue = (noiseValue + 1.0f) * 0.5f;
+                float noiseValue = (temperature[y * settings.Width + x] + 1.0f) * 0.5f;
 
                 // Latitude influence (warmer at equator/center, colder at poles/edges)
                 float normalizedY = static_cast<float>(y) / settings.Height;
@@ -455,6 +570,18 @@ namespace PCG {
         return colors;
     }
 
+    std::vector<uint32_t> BiomeGenerator::GenerateColorMapRGBA8(const std::vector<BiomeType>& biomes,
+                                                                 const BiomeMap& biomeMap)
+    {
+        std::vector<uint32_t> colors(biomes.size());
+
+        for (size_t i = 0; i < biomes.size(); ++i) {
+            colors[i] = biomeMap.GetPackedColor(biomes[i]);
+        }
+
+        return colors;
+    }
+
     // ============================================================================
     // BiomePresets Implementation
     // ============================================================================
@@ -165,8 +165,32 @@ namespace PCG {
          * @param moisture Moisture level (0-1)
          * @param temperature Temperature level (0-1, 0=cold, 1=hot)
          * @return Biome type
+         *
+         * Reads the precomputed lookup table, so the result is that of the
+         * cell containing the point (cells are 1 / LOOKUP_RESOLUTION wide).
          */
-        BiomeType GetBiome(float height, float moisture, float temperature) const;
+        BiomeType GetBiome(float height, float moisture, float temperature) const
+        {
+            return m_Lookup[GetLookupIndex(height, moisture, temperature)];
+        }
+
+        /**
+         * @brief Get biome type by scoring every biome at the exact point
+         *
+         * Reference classification the lookup table is built from.
+         */
+        BiomeType GetBiomeExact(float height, float moisture, float temperature) const;
+
+        /**
+         * @brief Classify many points at once through the lookup table
+         * @param heights Normalized heights (0-1)
+         * @param moisture Moisture levels (0-1)
+         * @param temperature Temperature levels (0-1)
+         * @param count Number of points
+         * @param out Receives one biome per point
+         */
+        void ClassifyBatch(const float* heights, const float* moisture, const float* temperature,
+                           size_t count, BiomeType* out) const;
 
         /**
          * @brief Get the data for a biome type
@@ -184,8 +208,15 @@ namespace PCG {
          */
         void GetBiomeColor(float height, float& r, float& g, float& b, float& a) const;
 
+        /**
+         * @brief Get a biome's color packed as RGBA8 (R in the lowest byte)
+         */
+        uint32_t GetPackedColor(BiomeType type) const { return m_PackedColors[static_cast<size_t>(type)]; }
+
         /**
          * @brief Set custom biome data
+         *
+         * Rebuilds the classification lookup table.
          */
         void SetBiomeData(BiomeType type, const BiomeData& data);
 
@@ -199,11 +230,32 @@ namespace PCG {
          */
         float GetWaterLevel() const { return m_WaterLevel; }
 
+        /// Lookup table cells per axis; the default thresholds are multiples of 0.05, so 40 puts every range edge on a cell boundary
+        static constexpr int LOOKUP_RESOLUTION = 40;
+
     private:
         std::array<BiomeData, static_cast<size_t>(BiomeType::Count)> m_BiomeData;
+        std::array<uint32_t, static_cast<size_t>(BiomeType::Count)> m_PackedColors = {};
+        std::vector<BiomeType> m_Lookup;   ///< [height][moisture][temperature] -> biome
         float m_WaterLevel = 0.3f;
 
         void InitializeDefaultBiomes();
+        void RebuildLookup();
+
+        static int GetLookupCell(float value)
+        {
+            // Written so NaN lands in cell 0 and out-of-range values clamp
+            float scaled = value * static_cast<float>(LOOKUP_RESOLUTION);
+            if (!(scaled > 0.0f)) return 0;
+            return static_cast<int>(scaled < static_cast<float>(LOOKUP_RESOLUTION - 1) ? scaled : static_cast<float>(LOOKUP_RESOLUTION - 1));
+        }
+
+        static size_t GetLookupIndex(float height, float moisture, float temperature)
+        {
+            return (static_cast<size_t>(GetLookupCell(height)) * LOOKUP_RESOLUTION +
+                    static_cast<size_t>(GetLookupCell(moisture))) * LOOKUP_RESOLUTION +
+                   static_cast<size_t>(GetLookupCell(temperature));
+        }
     };
 
     /**
@@ -224,6 +276,10 @@ namespace PCG {
             float TemperatureFrequency = 0.01f;
             int TemperatureOctaves = 3;
             float TemperatureLatitudeInfluence = 0.5f;  // How much latitude affects temperature
+
+            // Climate varies slowly, so its noise can be sampled every ClimateStep
+            // pixels and bilinearly upsampled (1 = every pixel; 8 is ~50x cheaper)
+            int ClimateStep = 1;
         };
 
         BiomeGenerator();
@@ -240,12 +296,12 @@ namespace PCG {
                                         const BiomeMap& biomeMap);
 
         /**
-         * @brief Generate moisture map
+         * @brief Generate moisture map (noise sampled every ClimateStep pixels)
          */
         std::vector<float> GenerateMoistureMap(const Settings& settings);
 
         /**
-         * @brief Generate temperature map
+         * @brief Generate temperature map (noise sampled every ClimateStep pixels; latitude per pixel)
          */
         std::vector<float> GenerateTemperatureMap(const Settings& settings);
 
@@ -258,6 +314,15 @@ namespace PCG {
         std::vector<float> GenerateColorMap(const std::vector<BiomeType>& biomes,
                                             const BiomeMap& biomeMap);
 
+        /**
+         * @brief Generate a packed color map from biome data
+         * @param biomes Biome type array
+         * @param biomeMap Biome data source
+         * @return RGBA8 color per pixel (R in the lowest byte, matching R8G8B8A8_UNORM), 4x smaller than float RGBA
+         */
+        std::vector<uint32_t> GenerateColorMapRGBA8(const std::vector<BiomeType>& biomes,
+                                                    const BiomeMap& biomeMap);
+
     private:
         // Cached maps
         std::vector<float> m_MoistureMap;
@@ -1,11 +1,194 @@
 #include "pcg/Chunk.h"
+#include "pcg/NoiseSIMD.h"
 #include "renderer/DX12Core.h"
+#include "renderer/MeshOptimizer.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cmath>
 
 namespace PCG
 {
+    namespace
+    {
+        /// Source of Chunk::GetMeshRevision, shared by every chunk
+        std::atomic<uint64_t> s_NextMeshRevision{ 1 };
+
+        int16_t QuantizeSNorm16(float value)
+        {
+            value = std::clamp(value, -1.0f, 1.0f);
+            return static_cast<int16_t>(std::lround(value * 32767.0f));
+        }
+
+        /**
+         * @brief Octahedral-encode a unit normal around the +Y axis
+         *
+         * Must match DecodeOctahedralNormal in TerrainVertex.hlsl.
+         */
+        void EncodeOctahedralNormal(const DirectX::XMFLOAT3& normal, int16_t encoded[2])
+        {
+            float invL1 = 1.0f / (std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z));
+            float u = normal.x * invL1;
+            float v = normal.z * invL1;
+
+            // Fold the lower hemisphere over the diagonals
+            if (normal.y < 0.0f)
+            {
+                float foldedU = (1.0f - std::abs(v)) * (u >= 0.0f ? 1.0f : -1.0f);
+                float foldedV = (1.0f - std::abs(u)) * (v >= 0.0f ? 1.0f : -1.0f);
+                u = foldedU;
+                v = foldedV;
+            }
+
+            encoded[0] = QuantizeSNorm16(u);
+            encoded[1] = QuantizeSNorm16(v);
+        }
+
+        // ========================================================================
+        // Height Pyramid Helpers
+        // ========================================================================
+
+        static_assert(Chunk::SIZE == 1 << Chunk::PYRAMID_LEVELS, "Height pyramid must reduce the chunk to one node");
+
+        /// Index of the first node of a pyramid level (levels are stored coarsest first)
+        constexpr int PyramidOffset(int level)
+        {
+            return ((1 << (2 * (Chunk::PYRAMID_LEVELS - level))) - 1) / 3;
+        }
+
+        /// Spread the low 16 bits of v to the even bits
+        uint32_t SpreadBits(uint32_t v)
+        {
+            v &= 0x0000FFFFu;
+            v = (v | (v << 8)) & 0x00FF00FFu;
+            v = (v | (v << 4)) & 0x0F0F0F0Fu;
+            v = (v | (v << 2)) & 0x33333333u;
+            v = (v | (v << 1)) & 0x55555555u;
+            return v;
+        }
+
+        /// Morton index with X in the even bits, so child k of node i is 4i + (dx | dz << 1)
+        uint32_t MortonEncode(uint32_t x, uint32_t z)
+        {
+            return SpreadBits(x) | (SpreadBits(z) << 1);
+        }
+
+        /**
+         * @brief Ray prepared for slab tests, relative to a chunk's origin
+         */
+        struct LocalRay
+        {
+            float Origin[3];
+            float Direction[3];
+            float InvDirection[3];
+        };
+
+        /**
+         * @brief Slab-test one axis-aligned box
+         * @return true if the ray overlaps the box within [tMin, tMax]; tEnter receives the entry
+         */
+        bool IntersectBox(const LocalRay& ray, const float low[3], const float high[3],
+                          float tMin, float tMax, float& tEnter)
+        {
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                float t0 = (low[axis] - ray.Origin[axis]) * ray.InvDirection[axis];
+                float t1 = (high[axis] - ray.Origin[axis]) * ray.InvDirection[axis];
+                tMin = std::max(tMin, std::min(t0, t1));
+                tMax = std::min(tMax, std::max(t0, t1));
+            }
+            tEnter = tMin;
+            return tMin <= tMax;
+        }
+
+        /**
+         * @brief Slab-test the four children of a pyramid node at once
+         * @param x0 Local X of the parent's corner
+         * @param z0 Local Z of the parent's corner
+         * @param half World size of a child
+         * @param mins Min heights of the four children (Morton order)
+         * @param maxs Max heights of the four children
+         * @return Bit k set if child k is hit; tEnter[k] receives its entry distance
+         */
+        int IntersectChildBoxes(const LocalRay& ray, float x0, float z0, float half,
+                                const float* mins, const float* maxs,
+                                float tMin, float tMax, float tEnter[4])
+        {
+#if PCG_NOISE_SIMD
+            const __m128 lowX = _mm_add_ps(_mm_set1_ps(x0), _mm_setr_ps(0.0f, half, 0.0f, half));
+            const __m128 lowZ = _mm_add_ps(_mm_set1_ps(z0), _mm_setr_ps(0.0f, 0.0f, half, half));
+            const __m128 halfSize = _mm_set1_ps(half);
+
+            auto slab = [](__m128 low, __m128 high, float origin, float invDirection, __m128& nearT, __m128& farT) {
+                const __m128 o = _mm_set1_ps(origin);
+                const __m128 inv = _mm_set1_ps(invDirection);
+                const __m128 t0 = _mm_mul_ps(_mm_sub_ps(low, o), inv);
+                const __m128 t1 = _mm_mul_ps(_mm_sub_ps(high, o), inv);
+                nearT = _mm_max_ps(nearT, _mm_min_ps(t0, t1));
+                farT = _mm_min_ps(farT, _mm_max_ps(t0, t1));
+            };
+
+            __m128 nearT = _mm_set1_ps(tMin);
+            __m128 farT = _mm_set1_ps(tMax);
+            slab(lowX, _mm_add_ps(lowX, halfSize), ray.Origin[0], ray.InvDirection[0], nearT, farT);
+            slab(_mm_loadu_ps(mins), _mm_loadu_ps(maxs), ray.Origin[1], ray.InvDirection[1], nearT, farT);
+            slab(lowZ, _mm_add_ps(lowZ, halfSize), ray.Origin[2], ray.InvDirection[2], nearT, farT);
+
+            _mm_storeu_ps(tEnter, nearT);
+            return _mm_movemask_ps(_mm_cmple_ps(nearT, farT));
+#else
+            int mask = 0;
+            for (int k = 0; k < 4; ++k)
+            {
+                const float low[3] = { x0 + ((k & 1) ? half : 0.0f), mins[k], z0 + ((k & 2) ? half : 0.0f) };
+                const float high[3] = { low[0] + half, maxs[k], low[2] + half };
+                if (IntersectBox(ray, low, high, tMin, tMax, tEnter[k]))
+                {
+                    mask |= 1 << k;
+                }
+            }
+            return mask;
+#endif
+        }
+
+        /**
+         * @brief Moller-Trumbore ray/triangle test (both faces)
+         * @return true if hit; t receives the distance along the ray
+         */
+        bool IntersectTriangle(const LocalRay& ray, const float a[3], const float b[3], const float c[3], float& t)
+        {
+            const float e1[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+            const float e2[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+            const float* d = ray.Direction;
+
+            const float p[3] = { d[1] * e2[2] - d[2] * e2[1], d[2] * e2[0] - d[0] * e2[2], d[0] * e2[1] - d[1] * e2[0] };
+            const float det = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+            if (std::abs(det) < 1e-12f)
+            {
+                return false;
+            }
+
+            const float invDet = 1.0f / det;
+            const float s[3] = { ray.Origin[0] - a[0], ray.Origin[1] - a[1], ray.Origin[2] - a[2] };
+            const float u = (s[0] * p[0] + s[1] * p[1] + s[2] * p[2]) * invDet;
+            if (u < 0.0f || u > 1.0f)
+            {
+                return false;
+            }
+
+            const float q[3] = { s[1] * e1[2] - s[2] * e1[1], s[2] * e1[0] - s[0] * e1[2], s[0] * e1[1] - s[1] * e1[0] };
+            const float v = (d[0] * q[0] + d[1] * q[1] + d[2] * q[2]) * invDet;
+            if (v < 0.0f || u + v > 1.0f)
+            {
+                return false;
+            }
+
+            t = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) * invDet;
+            return true;
+        }
+    }
+
     Chunk::Chunk(ChunkCoord coord)
         : m_Coord(coord)
         , m_LOD(0)
@@ -24,6 +207,7 @@ namespace PCG
         // Allocate height data
         const int vertexCount = SIZE + 1;
         m_Heights.resize(vertexCount * vertexCount);
+        m_QuantizedHeights.clear();
 
         // Calculate world offset for this chunk
         float worldOffsetX = static_cast<float>(m_Coord.X) * GetWorldSize();
@@ -39,6 +223,13 @@ namespace PCG
         PerlinNoise baseNoise(settings.Seed);
         FBM fbm(&baseNoise);
 
+        // Without domain warping the whole grid is sampled in batches per octave
+        if (!settings.ApplyDomainWarp)
+        {
+            fbm.SampleGrid(worldOffsetX, worldOffsetZ, SCALE, vertexCount, vertexCount,
+                           settings.Noise, m_Heights.data());
+        }
+
         // Generate heights using FBM directly
         for (int z = 0; z <= SIZE; ++z)
         {
@@ -55,7 +246,7 @@ namespace PCG
                 }
                 else
                 {
-                    height = fbm.Sample(worldX, worldZ, settings.Noise);
+                    height = m_Heights[z * vertexCount + x];
                 }
 
                 // Remap from [-1, 1] to [0, 1]
@@ -68,6 +259,9 @@ namespace PCG
             }
         }
 
+        m_Apron.clear();
+        m_Edited = false;
+        ClearDirtyRegion();
         UpdateHeightBounds();
         m_NeedsRebuild = true;
     }
@@ -76,6 +270,7 @@ namespace PCG
     {
         const int vertexCount = SIZE + 1;
         m_Heights.resize(vertexCount * vertexCount);
+        m_QuantizedHeights.clear();
 
         float worldOffsetX = static_cast<float>(m_Coord.X) * GetWorldSize();
         float worldOffsetZ = static_cast<float>(m_Coord.Z) * GetWorldSize();
@@ -91,45 +286,463 @@ namespace PCG
             }
         }
 
+        m_Apron.clear();
+        m_Edited = false;
+        ClearDirtyRegion();
+        UpdateHeightBounds();
+        m_NeedsRebuild = true;
+    }
+
+    void Chunk::GenerateBatch(const std::function<void(float, float, float, int, float*)>& gridFunc)
+    {
+        const int vertexCount = SIZE + 1;
+        m_Heights.resize(vertexCount * vertexCount);
+        m_QuantizedHeights.clear();
+
+        float worldOffsetX = static_cast<float>(m_Coord.X) * GetWorldSize();
+        float worldOffsetZ = static_cast<float>(m_Coord.Z) * GetWorldSize();
+
+        gridFunc(worldOffsetX, worldOffsetZ, SCALE, vertexCount, m_Heights.data());
+
+        m_Apron.clear();
+        m_Edited = false;
+        ClearDirtyRegion();
         UpdateHeightBounds();
         m_NeedsRebuild = true;
     }
 
-    bool Chunk::BuildMesh(SM::DX12Core* core)
+    void Chunk::GenerateApron(const std::function<void(float, float, float, int, int, float*)>& stripFunc)
     {
-        if (!core || m_Heights.empty())
+        if (!IsGenerated())
+        {
+            return;
+        }
+
+        const int vertexCount = SIZE + 1;
+        m_Apron.resize(APRON_SAMPLE_COUNT);
+
+        const float worldOffsetX = static_cast<float>(m_Coord.X) * GetWorldSize();
+        const float worldOffsetZ = static_cast<float>(m_Coord.Z) * GetWorldSize();
+        const float pastEdge = static_cast<float>(vertexCount) * SCALE;
+
+        // One column past each X edge, one row past each Z edge
+        float* apron = m_Apron.data();
+        stripFunc(worldOffsetX - SCALE, worldOffsetZ, SCALE, 1, vertexCount, apron);
+        stripFunc(worldOffsetX + pastEdge, worldOffsetZ, SCALE, 1, vertexCount, apron + vertexCount);
+        stripFunc(worldOffsetX, worldOffsetZ - SCALE, SCALE, vertexCount, 1, apron + vertexCount * 2);
+        stripFunc(worldOffsetX, worldOffsetZ + pastEdge, SCALE, vertexCount, 1, apron + vertexCount * 3);
+
+        m_NeedsRebuild = true;
+    }
+
+    bool Chunk::SetHeightData(std::vector<float>&& heights, float minHeight, float maxHeight)
+    {
+        if (heights.size() != static_cast<size_t>(VERTEX_COUNT))
         {
             return false;
         }
 
-        // Calculate LOD step (1, 2, 4, 8, etc.)
-        int lodStep = 1 << m_LOD;
+        m_Heights = std::move(heights);
+        m_QuantizedHeights.clear();
+        m_Apron.clear();
+        m_MinHeight = minHeight;
+        m_MaxHeight = maxHeight;
+        m_Edited = false;
+        ClearDirtyRegion();
+        BuildHeightPyramid();
+        m_NeedsRebuild = true;
+        return true;
+    }
+
+    std::vector<float> Chunk::TakeHeightData()
+    {
+        std::vector<float> heights = std::move(m_Heights);
+        m_Heights.clear();
+        if (!m_QuantizedHeights.empty())
+        {
+            heights.resize(m_QuantizedHeights.size());
+            DecodeHeights(heights.data());
+            m_QuantizedHeights = std::vector<uint16_t>();
+        }
+        m_Biomes.clear();
+        m_Apron.clear();
+        UpdateHeightBounds();
+        return heights;
+    }
+
+    void Chunk::QuantizeHeights()
+    {
+        if (m_Heights.empty())
+        {
+            return;
+        }
+
+        // Same rounding as GenerateVertices, so rebuilt meshes get the same vertex heights
+        const float heightRange = m_MaxHeight - m_MinHeight;
+        const float heightScale = (heightRange > 0.0f) ? 65535.0f / heightRange : 0.0f;
 
-        // Generate mesh data
-        std::vector<SM::Vertex> vertices;
-        std::vector<uint32_t> indices;
+        m_QuantizedHeights.resize(m_Heights.size());
+        for (size_t i = 0; i < m_Heights.size(); ++i)
+        {
+            const float height = (m_Heights[i] - m_MinHeight) * heightScale;
+            m_QuantizedHeights[i] = static_cast<uint16_t>(std::clamp(height + 0.5f, 0.0f, 65535.0f));
+        }
 
-        GenerateVertices(vertices, lodStep);
-        GenerateIndices(indices, lodStep);
+        m_QuantizationStep = heightRange / 65535.0f;
+        m_Heights = std::vector<float>();
 
-        // Create mesh data structure
-        SM::MeshData meshData;
-        meshData.Vertices = std::move(vertices);
-        meshData.Indices = std::move(indices);
+        // Decoded heights may round past a node's bounds; rebuild so ray queries stay conservative
+        BuildHeightPyramid();
+    }
 
-        // Build GPU mesh
-        bool result = m_Mesh.Create(core, meshData);
-        if (result)
+    bool Chunk::SetBiomeData(std::vector<BiomeType>&& biomes)
+    {
+        if (biomes.size() != static_cast<size_t>(VERTEX_COUNT))
+        {
+            return false;
+        }
+
+        m_Biomes = std::move(biomes);
+        return true;
+    }
+
+    // ============================================================================
+    // Editing
+    // ============================================================================
+
+    bool Chunk::EditHeights(float minX, float minZ, float maxX, float maxZ, const HeightEditFunc& edit)
+    {
+        if (!IsGenerated() || !edit)
+        {
+            return false;
+        }
+
+        // Local sample range, reaching one step past the grid into the apron
+        const DirectX::XMFLOAT3 origin = GetWorldPosition();
+        const int x0 = std::max(static_cast<int>(std::ceil((minX - origin.x) / SCALE)), -1);
+        const int x1 = std::min(static_cast<int>(std::floor((maxX - origin.x) / SCALE)), SIZE + 1);
+        const int z0 = std::max(static_cast<int>(std::ceil((minZ - origin.z) / SCALE)), -1);
+        const int z1 = std::min(static_cast<int>(std::floor((maxZ - origin.z) / SCALE)), SIZE + 1);
+        if (x0 > x1 || z0 > z1)
+        {
+            return false;
+        }
+
+        if (IsQuantized())
+        {
+            m_Heights.resize(m_QuantizedHeights.size());
+            DecodeHeights(m_Heights.data());
+            m_QuantizedHeights = std::vector<uint16_t>();
+        }
+
+        bool changed = false;
+        auto apply = [&](float& height, int x, int z) {
+            const float edited = edit(origin.x + static_cast<float>(x) * SCALE,
+                                      origin.z + static_cast<float>(z) * SCALE, height);
+            if (edited != height)
+            {
+                height = edited;
+                changed = true;
+            }
+        };
+
+        const int vertexCount = SIZE + 1;
+        const int gridX0 = std::max(x0, 0);
+        const int gridX1 = std::min(x1, SIZE);
+        const int gridZ0 = std::max(z0, 0);
+        const int gridZ1 = std::min(z1, SIZE);
+
+        for (int z = gridZ0; z <= gridZ1; ++z)
+        {
+            for (int x = gridX0; x <= gridX1; ++x)
+            {
+                apply(m_Heights[z * vertexCount + x], x, z);
+            }
+        }
+
+        // Apron samples inside the rectangle, edges ordered as in GetApronHeight
+        if (HasApron())
+        {
+            for (int z = gridZ0; z <= gridZ1; ++z)
+            {
+                if (x0 < 0)
+                {
+                    apply(m_Apron[z], -1, z);
+                }
+                if (x1 > SIZE)
+                {
+                    apply(m_Apron[vertexCount + z], SIZE + 1, z);
+                }
+            }
+            for (int x = gridX0; x <= gridX1; ++x)
+            {
+                if (z0 < 0)
+                {
+                    apply(m_Apron[vertexCount * 2 + x], x, -1);
+                }
+                if (z1 > SIZE)
+                {
+                    apply(m_Apron[vertexCount * 3 + x], x, SIZE + 1);
+                }
+            }
+        }
+
+        if (!changed)
+        {
+            return false;
+        }
+
+        m_DirtyMinZ = std::min(m_DirtyMinZ, z0);
+        m_DirtyMaxZ = std::max(m_DirtyMaxZ, z1);
+        m_Edited = true;
+        UpdateHeightBounds();
+        return true;
+    }
+
+    bool Chunk::UpdateMeshRegion(SM::DX12Core* core)
+    {
+        if (!HasDirtyRegion())
+        {
+            return true;
+        }
+
+        // Only an idle mesh of the current LOD whose height range still holds the heights
+        const int meshLOD = m_Geomorph ? 0 : m_LOD;
+        if (!core || !m_Mesh.IsValid() || m_PendingMesh.IsValid() || m_MeshLOD != meshLOD ||
+            m_MinHeight < m_MeshMinHeight || m_MaxHeight > m_MeshMaxHeight)
+        {
+            return false;
+        }
+
+        const int lodStep = 1 << m_MeshLOD;
+        const int lodVertexCount = (SIZE / lodStep) + 1;
+
+        // One copy per run of affected rows
+        int row = 0;
+        while (row < lodVertexCount)
+        {
+            if (!IsRowAffectedByEdit(row * lodStep))
+            {
+                ++row;
+                continue;
+            }
+
+            int end = row + 1;
+            while (end < lodVertexCount && IsRowAffectedByEdit(end * lodStep))
+            {
+                ++end;
+            }
+
+            const int firstRow = row;
+            const int rowCount = end - row;
+            const bool uploaded = m_Mesh.UpdateVertices(
+                core,
+                static_cast<uint32_t>(firstRow * lodVertexCount),
+                static_cast<uint32_t>(rowCount * lodVertexCount),
+                [this, lodStep, firstRow, rowCount](void* destination) {
+                    GenerateVertices(static_cast<TerrainVertex*>(destination), lodStep, firstRow, rowCount,
+                                     m_MeshMinHeight, m_MeshMaxHeight);
+                });
+
+            if (!uploaded)
+            {
+                return false;
+            }
+            row = end;
+        }
+
+        ClearDirtyRegion();
+        m_MeshRevision = s_NextMeshRevision.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool Chunk::BuildMesh(SM::DX12Core* core, bool buildIndices)
+    {
+        if (!core || !IsGenerated())
+        {
+            return false;
+        }
+
+        // Calculate LOD step (1, 2, 4, 8, etc.); geomorphed meshes keep every vertex
+        const int meshLOD = m_Geomorph ? 0 : m_LOD;
+        int lodStep = 1 << meshLOD;
+        buildIndices = buildIndices && !m_Geomorph;
+
+        // Vertices are generated straight into upload memory; index lists are shared per LOD
+        const int lodVertexCount = (SIZE / lodStep) + 1;
+        const uint32_t vertexCount = static_cast<uint32_t>(lodVertexCount * lodVertexCount);
+        const std::vector<uint32_t>* indices = buildIndices ? &GetSharedLODIndices(meshLOD) : nullptr;
+
+        float meshMin = 0.0f;
+        float meshMax = 0.0f;
+        GetMeshHeightRange(meshMin, meshMax);
+
+        // Build GPU mesh (an unfinished earlier build is simply replaced)
+        SM::Mesh mesh;
+        if (!mesh.Create(
+            core,
+            vertexCount,
+            sizeof(TerrainVertex),
+            [this, lodStep, lodVertexCount, meshMin, meshMax](void* destination) {
+                GenerateVertices(static_cast<TerrainVertex*>(destination), lodStep, 0, lodVertexCount, meshMin, meshMax);
+            },
+            indices ? indices->data() : nullptr,
+            indices ? static_cast<uint32_t>(indices->size()) : 0))
+        {
+            return false;
+        }
+
+        m_PendingMesh = std::move(mesh);
+        m_PendingMeshLOD = meshLOD;
+        m_PendingMeshMinHeight = meshMin;
+        m_PendingMeshMaxHeight = meshMax;
+        m_NeedsRebuild = false;
+
+        // The new mesh holds every edit so far
+        ClearDirtyRegion();
+
+        // Upload-heap fallback meshes are usable immediately
+        PromotePendingMesh();
+        return true;
+    }
+
+    bool Chunk::BuildVertices(std::vector<TerrainVertex>& outVertices) const
+    {
+        if (!IsGenerated())
+        {
+            return false;
+        }
+
+        // Same LOD choice as BuildMesh
+        const int lodStep = 1 << (m_Geomorph ? 0 : m_LOD);
+        const int lodVertexCount = (SIZE / lodStep) + 1;
+
+        float meshMin = 0.0f;
+        float meshMax = 0.0f;
+        GetMeshHeightRange(meshMin, meshMax);
+
+        outVertices.resize(static_cast<size_t>(lodVertexCount * lodVertexCount));
+        GenerateVertices(outVertices.data(), lodStep, 0, lodVertexCount, meshMin, meshMax);
+        return true;
+    }
+
+    bool Chunk::PromotePendingMesh()
+    {
+        if (!m_PendingMesh.IsValid() || !m_PendingMesh.IsReady())
+        {
+            return false;
+        }
+
+        m_Mesh = std::move(m_PendingMesh);
+        m_PendingMesh = SM::Mesh();
+        m_MeshLOD = m_PendingMeshLOD;
+        m_MeshMinHeight = m_PendingMeshMinHeight;
+        m_MeshMaxHeight = m_PendingMeshMaxHeight;
+        m_MeshRevision = s_NextMeshRevision.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool Chunk::RebuildMesh(SM::DX12Core* core, bool buildIndices)
+    {
+        return BuildMesh(core, buildIndices);
+    }
+
+    void Chunk::GenerateLODIndices(std::vector<uint32_t>& indices, int lodStep)
+    {
+        const int lodVertexCount = (SIZE / lodStep) + 1;
+        const int quadCount = lodVertexCount - 1;
+
+        // Two triangles per quad, 3 indices per triangle
+        indices.reserve(quadCount * quadCount * 6);
+
+        for (int z = 0; z < quadCount; ++z)
         {
-            m_NeedsRebuild = false;
+            for (int x = 0; x < quadCount; ++x)
+            {
+                uint32_t topLeft = z * lodVertexCount + x;
+                uint32_t topRight = topLeft + 1;
+                uint32_t bottomLeft = (z + 1) * lodVertexCount + x;
+                uint32_t bottomRight = bottomLeft + 1;
+
+                // First triangle (top-left, bottom-left, bottom-right)
+                indices.push_back(topLeft);
+                indices.push_back(bottomLeft);
+                indices.push_back(bottomRight);
+
+                // Second triangle (top-left, bottom-right, top-right)
+                indices.push_back(topLeft);
+                indices.push_back(bottomRight);
+                indices.push_back(topRight);
+            }
         }
+    }
 
-        return result;
+    const std::vector<uint32_t>& Chunk::GetSharedLODIndices(int lod)
+    {
+        // Built once on first use (thread-safe static initialization), then read-only
+        static const std::array<std::vector<uint32_t>, MAX_LOD + 1> lodIndices = []()
+        {
+            std::array<std::vector<uint32_t>, MAX_LOD + 1> lists;
+            for (int level = 0; level <= MAX_LOD; ++level)
+            {
+                // Cache-ordered once; vertices stay a row-major grid
+                const uint32_t lodVertexCount = static_cast<uint32_t>(SIZE >> level) + 1;
+                GenerateLODIndices(lists[level], 1 << level);
+                SM::MeshOptimizer::OptimizeVertexCache(lists[level], lodVertexCount * lodVertexCount);
+            }
+            return lists;
+        }();
+
+        return lodIndices[std::clamp(lod, 0, MAX_LOD)];
     }
 
-    bool Chunk::RebuildMesh(SM::DX12Core* core)
+    void Chunk::GenerateStitchedIndices(std::vector<uint32_t>& indices, int lodStep, uint32_t stitchMask)
     {
-        return BuildMesh(core);
+        const int vertexCount = SIZE + 1;
+        const int coarseStep = lodStep * 2;
+        const int quadCount = SIZE / lodStep;
+
+        auto vertexIndex = [&](int x, int z) -> uint32_t
+        {
+            // Collapse odd vertices on stitched edges onto the coarser edge
+            if ((x == 0 && (stitchMask & STITCH_NEG_X)) || (x == SIZE && (stitchMask & STITCH_POS_X)))
+            {
+                z -= z % coarseStep;
+            }
+            if ((z == 0 && (stitchMask & STITCH_NEG_Z)) || (z == SIZE && (stitchMask & STITCH_POS_Z)))
+            {
+                x -= x % coarseStep;
+            }
+
+            return static_cast<uint32_t>(z * vertexCount + x);
+        };
+
+        indices.reserve(indices.size() + quadCount * quadCount * 6);
+
+        for (int qz = 0; qz < quadCount; ++qz)
+        {
+            for (int qx = 0; qx < quadCount; ++qx)
+            {
+                int x0 = qx * lodStep;
+                int z0 = qz * lodStep;
+                int x1 = x0 + lodStep;
+                int z1 = z0 + lodStep;
+
+                uint32_t topLeft = vertexIndex(x0, z0);
+                uint32_t topRight = vertexIndex(x1, z0);
+                uint32_t bottomLeft = vertexIndex(x0, z1);
+                uint32_t bottomRight = vertexIndex(x1, z1);
+
+                // Same diagonal as GenerateLODIndices (the geomorph targets assume it)
+                indices.push_back(topLeft);
+                indices.push_back(bottomLeft);
+                indices.push_back(bottomRight);
+
+                indices.push_back(topLeft);
+                indices.push_back(bottomRight);
+                indices.push_back(topRight);
+            }
+        }
     }
 
     // ============================================================================
@@ -144,12 +757,36 @@ namespace PCG
         }
 
         const int vertexCount = SIZE + 1;
-        return m_Heights[localZ * vertexCount + localX];
+        return LoadHeight(localZ * vertexCount + localX);
+    }
+
+    void Chunk::CopyHeights(std::vector<float>& outHeights) const
+    {
+        if (!m_QuantizedHeights.empty())
+        {
+            outHeights.resize(m_QuantizedHeights.size());
+            DecodeHeights(outHeights.data());
+        }
+        else
+        {
+            outHeights = m_Heights;
+        }
+    }
+
+    BiomeType Chunk::GetBiome(int localX, int localZ) const
+    {
+        if (m_Biomes.empty() || localX < 0 || localX > SIZE || localZ < 0 || localZ > SIZE)
+        {
+            return BiomeType::Count;
+        }
+
+        const int vertexCount = SIZE + 1;
+        return m_Biomes[localZ * vertexCount + localX];
     }
 
     float Chunk::GetHeightInterpolated(float localX, float localZ) const
     {
-        if (m_Heights.empty())
+        if (!IsGenerated())
         {
             return 0.0f;
         }
@@ -178,116 +815,345 @@ namespace PCG
         return h0 * (1.0f - fz) + h1 * fz;
     }
 
+    // ============================================================================
+    // Ray Queries
+    // ============================================================================
+
+    bool Chunk::Raycast(const TerrainRay& ray, float tMin, float tMax, TerrainHit& hit) const
+    {
+        if (m_PyramidMin.empty() || !(tMin <= tMax))
+        {
+            return false;
+        }
+
+        // Work relative to the chunk corner to keep precision far from the world origin
+        const DirectX::XMFLOAT3 corner = GetWorldPosition();
+        LocalRay local;
+        local.Origin[0] = ray.Origin.x - corner.x;
+        local.Origin[1] = ray.Origin.y;
+        local.Origin[2] = ray.Origin.z - corner.z;
+        local.Direction[0] = ray.Direction.x;
+        local.Direction[1] = ray.Direction.y;
+        local.Direction[2] = ray.Direction.z;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            // Axis-parallel rays get a huge but finite slope, so slab tests never produce NaN
+            const float d = local.Direction[axis];
+            local.InvDirection[axis] = 1.0f / (std::abs(d) > 1e-12f ? d : 1e-12f);
+        }
+
+        const float worldSize = GetWorldSize();
+        const float rootLow[3] = { 0.0f, m_PyramidMin[0], 0.0f };
+        const float rootHigh[3] = { worldSize, m_PyramidMax[0], worldSize };
+
+        float rootEnter = 0.0f;
+        if (!IntersectBox(local, rootLow, rootHigh, tMin, tMax, rootEnter))
+        {
+            return false;
+        }
+
+        struct Node
+        {
+            int Level;
+            uint32_t Index;     ///< Morton index within the level
+            int X;              ///< First quad covered, in vertex units
+            int Z;
+            float Enter;        ///< Distance at which the ray enters the node's bounds
+        };
+
+        // Depth-first, nearest child on top: at most three siblings wait per level
+        Node stack[PYRAMID_LEVELS * 3 + 1];
+        int stackSize = 0;
+        stack[stackSize++] = Node{ PYRAMID_LEVELS, 0, 0, 0, rootEnter };
+
+        const int vertexCount = SIZE + 1;
+        float bestT = tMax;
+        int bestQuad = -1;
+        bool bestUpper = false;     ///< Hit the (top-left, bottom-right, top-right) triangle
+
+        auto vertex = [&](int x, int z, float out[3]) {
+            out[0] = static_cast<float>(x) * SCALE;
+            out[1] = LoadHeight(z * vertexCount + x);
+            out[2] = static_cast<float>(z) * SCALE;
+        };
+
+        while (stackSize > 0)
+        {
+            const Node node = stack[--stackSize];
+            if (node.Enter > bestT)
+            {
+                continue;
+            }
+
+            if (node.Level == 1)
+            {
+                // Leaf: the 2x2 quads, split along the same diagonal as GenerateLODIndices
+                for (int quad = 0; quad < 4; ++quad)
+                {
+                    const int x = node.X + (quad & 1);
+                    const int z = node.Z + (quad >> 1);
+
+                    float p00[3], p10[3], p01[3], p11[3];
+                    vertex(x, z, p00);
+                    vertex(x + 1, z, p10);
+                    vertex(x, z + 1, p01);
+                    vertex(x + 1, z + 1, p11);
+
+                    float t = 0.0f;
+                    if (IntersectTriangle(local, p00, p01, p11, t) && t >= tMin && t <= bestT)
+                    {
+                        bestT = t;
+                        bestQuad = z * SIZE + x;
+                        bestUpper = false;
+                    }
+                    if (IntersectTriangle(local, p00, p11, p10, t) && t >= tMin && t <= bestT)
+                    {
+                        bestT = t;
+                        bestQuad = z * SIZE + x;
+                        bestUpper = true;
+                    }
+                }
+                continue;
+            }
+
+            const int childLevel = node.Level - 1;
+            const int childQuads = 1 << childLevel;
+            const uint32_t firstChild = node.Index * 4;
+            const float* mins = m_PyramidMin.data() + PyramidOffset(childLevel) + firstChild;
+            const float* maxs = m_PyramidMax.data() + PyramidOffset(childLevel) + firstChild;
+
+            float enter[4];
+            const int mask = IntersectChildBoxes(local,
+                                                 static_cast<float>(node.X) * SCALE,
+                                                 static_cast<float>(node.Z) * SCALE,
+                                                 static_cast<float>(childQuads) * SCALE,
+                                                 mins, maxs, tMin, bestT, enter);
+            if (mask == 0)
+            {
+                continue;
+            }
+
+            // Push hit children farthest first so the nearest is visited next
+            int order[4];
+            int hitCount = 0;
+            for (int k = 0; k < 4; ++k)
+            {
+                if (mask & (1 << k))
+                {
+                    int position = hitCount++;
+                    while (position > 0 && enter[order[position - 1]] < enter[k])
+                    {
+                        order[position] = order[position - 1];
+                        --position;
+                    }
+                    order[position] = k;
+                }
+            }
+
+            for (int i = 0; i < hitCount; ++i)
+            {
+                const int k = order[i];
+                stack[stackSize++] = Node{
+                    childLevel,
+                    firstChild + static_cast<uint32_t>(k),
+                    node.X + ((k & 1) ? childQuads : 0),
+                    node.Z + ((k & 2) ? childQuads : 0),
+                    enter[k]
+                };
+            }
+        }
+
+        if (bestQuad < 0)
+        {
+            return false;
+        }
+
+        // Face normal of the hit triangle, facing up
+        const int x = bestQuad % SIZE;
+        const int z = bestQuad / SIZE;
+        float a[3], b[3], c[3];
+        vertex(x, z, a);
+        if (bestUpper)
+        {
+            vertex(x + 1, z + 1, b);
+            vertex(x + 1, z, c);
+        }
+        else
+        {
+            vertex(x, z + 1, b);
+            vertex(x + 1, z + 1, c);
+        }
+
+        const float e1[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+        const float e2[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+        DirectX::XMFLOAT3 normal(e1[1] * e2[2] - e1[2] * e2[1],
+                                 e1[2] * e2[0] - e1[0] * e2[2],
+                                 e1[0] * e2[1] - e1[1] * e2[0]);
+        const float length = std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+        const float scale = (normal.y < 0.0f ? -1.0f : 1.0f) / length;
+
+        hit.Hit = true;
+        hit.Distance = bestT;
+        hit.Position = DirectX::XMFLOAT3(ray.Origin.x + ray.Direction.x * bestT,
+                                         ray.Origin.y + ray.Direction.y * bestT,
+                                         ray.Origin.z + ray.Direction.z * bestT);
+        hit.Normal = DirectX::XMFLOAT3(normal.x * scale, normal.y * scale, normal.z * scale);
+        hit.Chunk = m_Coord;
+        return true;
+    }
+
     // ============================================================================
     // LOD
     // ============================================================================
 
     void Chunk::SetLOD(int level)
     {
-        level = std::clamp(level, 0, 4); // Max LOD level is 4 (step size = 16)
+        level = std::clamp(level, 0, MAX_LOD);
 
         if (m_LOD != level)
         {
             m_LOD = level;
-            m_NeedsRebuild = true;
+
+            // Geomorphed meshes already hold every LOD
+            m_NeedsRebuild = m_NeedsRebuild || !m_Geomorph;
         }
     }
 
+    uint32_t Chunk::GetStitchMask() const
+    {
+        static constexpr uint32_t edgeBits[4] = { STITCH_NEG_X, STITCH_POS_X, STITCH_NEG_Z, STITCH_POS_Z };
+
+        uint32_t mask = 0;
+        for (int edge = 0; edge < 4; ++edge)
+        {
+            if (m_MorphState.EdgeLOD[edge] > m_LOD)
+            {
+                mask |= edgeBits[edge];
+            }
+        }
+
+        return mask;
+    }
+
     // ============================================================================
     // Private Methods
     // ============================================================================
 
-    void Chunk::GenerateVertices(std::vector<SM::Vertex>& vertices, int lodStep) const
+    void Chunk::GenerateVertices(TerrainVertex* vertices, int lodStep, int firstRow, int rowCount,
+                                 float minHeight, float maxHeight) const
     {
-        const int vertexCount = SIZE + 1;
-        const int lodVertexCount = (SIZE / lodStep) + 1;
-
-        vertices.reserve(lodVertexCount * lodVertexCount);
+        // Flat chunks quantize every height to minHeight
+        float heightRange = maxHeight - minHeight;
+        float heightScale = (heightRange > 0.0f) ? 65535.0f / heightRange : 0.0f;
 
-        float worldOffsetX = static_cast<float>(m_Coord.X) * GetWorldSize();
-        float worldOffsetZ = static_cast<float>(m_Coord.Z) * GetWorldSize();
-
-        // Calculate UV scale based on chunk size
-        float uvScale = 1.0f / static_cast<float>(SIZE);
-
-        for (int z = 0; z <= SIZE; z += lodStep)
+        const int lastZ = (firstRow + rowCount - 1) * lodStep;
+        for (int z = firstRow * lodStep; z <= lastZ; z += lodStep)
         {
             for (int x = 0; x <= SIZE; x += lodStep)
             {
-                float height = GetHeight(x, z);
+                TerrainVertex vertex = {};
+
+                float height = (GetHeight(x, z) - minHeight) * heightScale;
+                vertex.Height = static_cast<uint16_t>(std::clamp(height + 0.5f, 0.0f, 65535.0f));
 
-                // Calculate world position
-                DirectX::XMFLOAT3 position(
-                    worldOffsetX + static_cast<float>(x) * SCALE,
-                    height,
-                    worldOffsetZ + static_cast<float>(z) * SCALE
-                );
+                float morphHeight = (CalculateMorphHeight(x, z) - minHeight) * heightScale;
+                vertex.MorphHeight = static_cast<uint16_t>(std::clamp(morphHeight + 0.5f, 0.0f, 65535.0f));
 
-                // Calculate normal
                 DirectX::XMFLOAT3 normal = CalculateNormal(x, z);
+                EncodeOctahedralNormal(normal, vertex.Normal);
 
-                // Calculate UV coordinates
-                DirectX::XMFLOAT2 texCoord(
-                    static_cast<float>(x) * uvScale,
-                    static_cast<float>(z) * uvScale
-                );
+                // One whole-vertex store per vertex (destination may be write-combined)
+                *vertices++ = vertex;
+            }
+        }
+    }
 
-                // Calculate vertex color based on height and slope
-                DirectX::XMFLOAT4 color = CalculateVertexColor(height, normal);
+    void Chunk::GetMeshHeightRange(float& outMin, float& outMax) const
+    {
+        outMin = m_MinHeight;
+        outMax = m_MaxHeight;
 
-                vertices.emplace_back(position, normal, texCoord, color);
-            }
+        // At least a chunk's width, so flat edited chunks get room too
+        if (m_Edited)
+        {
+            const float headroom = std::max(m_MaxHeight - m_MinHeight, GetWorldSize()) * EDIT_HEIGHT_HEADROOM;
+            outMin -= headroom;
+            outMax += headroom;
         }
     }
 
-    void Chunk::GenerateIndices(std::vector<uint32_t>& indices, int lodStep) const
+    bool Chunk::IsRowAffectedByEdit(int z) const
     {
-        const int lodVertexCount = (SIZE / lodStep) + 1;
-        const int quadCount = lodVertexCount - 1;
+        // Heights and normals read the row and its neighbours
+        if (z >= m_DirtyMinZ - 1 && z <= m_DirtyMaxZ + 1)
+        {
+            return true;
+        }
 
-        // Two triangles per quad, 3 indices per triangle
-        indices.reserve(quadCount * quadCount * 6);
+        // Geomorph targets of rows at an odd multiple of their step read the
+        // rows one step away (see CalculateMorphHeight); other rows read only
+        // themselves
+        const int step = z & -z;
+        if (z == 0 || step >= SIZE)
+        {
+            return false;
+        }
 
-        for (int z = 0; z < quadCount; ++z)
+        const int below = z - step;
+        const int above = z + step;
+        return (below >= m_DirtyMinZ && below <= m_DirtyMaxZ) || (above >= m_DirtyMinZ && above <= m_DirtyMaxZ);
+    }
+
+    float Chunk::CalculateMorphHeight(int x, int z) const
+    {
+        // Finest grid step this vertex belongs to; it only morphs when drawn at that step
+        int step = 1;
+        while (step < SIZE && (x % (step * 2)) == 0 && (z % (step * 2)) == 0)
         {
-            for (int x = 0; x < quadCount; ++x)
-            {
-                uint32_t topLeft = z * lodVertexCount + x;
-                uint32_t topRight = topLeft + 1;
-                uint32_t bottomLeft = (z + 1) * lodVertexCount + x;
-                uint32_t bottomRight = bottomLeft + 1;
+            step *= 2;
+        }
 
-                // First triangle (top-left, bottom-left, bottom-right)
-                indices.push_back(topLeft);
-                indices.push_back(bottomLeft);
-                indices.push_back(bottomRight);
+        if (step >= SIZE)
+        {
+            return GetHeight(x, z);
+        }
 
-                // Second triangle (top-left, bottom-right, top-right)
-                indices.push_back(topLeft);
-                indices.push_back(bottomRight);
-                indices.push_back(topRight);
-            }
+        // Interpolate along the edge or diagonal of the cell one grid coarser
+        const int coarseStep = step * 2;
+        const bool oddX = (x % coarseStep) != 0;
+        const bool oddZ = (z % coarseStep) != 0;
+
+        if (oddX && oddZ)
+        {
+            return 0.5f * (GetHeight(x - step, z - step) + GetHeight(x + step, z + step));
         }
+        if (oddX)
+        {
+            return 0.5f * (GetHeight(x - step, z) + GetHeight(x + step, z));
+        }
+        return 0.5f * (GetHeight(x, z - step) + GetHeight(x, z + step));
     }
 
     DirectX::XMFLOAT3 Chunk::CalculateNormal(int x, int z) const
     {
-        // Get heights of neighboring vertices
-        float hL = GetHeight(x - 1, z);  // Left
-        float hR = GetHeight(x + 1, z);  // Right
-        float hD = GetHeight(x, z - 1);  // Down (closer in Z)
-        float hU = GetHeight(x, z + 1);  // Up (further in Z)
-
-        // Handle edge cases by using current height
-        if (x == 0) hL = GetHeight(x, z);
-        if (x == SIZE) hR = GetHeight(x, z);
-        if (z == 0) hD = GetHeight(x, z);
-        if (z == SIZE) hU = GetHeight(x, z);
-
-        // Calculate normal using central differences
-        float nx = (hL - hR) * 0.5f;
+        // Neighbouring heights, from the apron past the edges when there is one
+        const bool apron = HasApron();
+        const float hC = GetHeight(x, z);
+        const bool hasL = x > 0 || apron;
+        const bool hasR = x < SIZE || apron;
+        const bool hasD = z > 0 || apron;
+        const bool hasU = z < SIZE || apron;
+
+        float hL = hasL ? (x > 0 ? GetHeight(x - 1, z) : GetApronHeight(x - 1, z)) : hC;      // Left
+        float hR = hasR ? (x < SIZE ? GetHeight(x + 1, z) : GetApronHeight(x + 1, z)) : hC;   // Right
+        float hD = hasD ? (z > 0 ? GetHeight(x, z - 1) : GetApronHeight(x, z - 1)) : hC;      // Down (closer in Z)
+        float hU = hasU ? (z < SIZE ? GetHeight(x, z + 1) : GetApronHeight(x, z + 1)) : hC;   // Up (further in Z)
+
+        // Central differences span two steps; edges without an apron fall
+        // back to one-sided differences over a single step
+        float nx = (hL - hR) / static_cast<float>(hasL + hasR);
         float ny = SCALE; // This controls the "steepness" of the normal
-        float nz = (hD - hU) * 0.5f;
+        float nz = (hD - hU) / static_cast<float>(hasD + hasU);
 
         // Normalize
         float len = std::sqrt(nx * nx + ny * ny + nz * nz);
@@ -307,109 +1173,135 @@ namespace PCG
         return DirectX::XMFLOAT3(nx, ny, nz);
     }
 
-    DirectX::XMFLOAT4 Chunk::CalculateVertexColor(float height, const DirectX::XMFLOAT3& normal) const
-    {
-        // Normalize height to [0, 1] range based on chunk bounds
-        float heightRange = m_MaxHeight - m_MinHeight;
-        float normalizedHeight = (heightRange > 0.001f)
-            ? (height - m_MinHeight) / heightRange
-            : 0.5f;
-
-        // Calculate slope (0 = flat, 1 = vertical)
-        float slope = 1.0f - normal.y;
-
-        // Define terrain colors
-        // Deep water: dark blue
-        DirectX::XMFLOAT3 deepWater(0.05f, 0.1f, 0.3f);
-        // Shallow water: light blue
-        DirectX::XMFLOAT3 shallowWater(0.1f, 0.3f, 0.5f);
-        // Sand: tan
-        DirectX::XMFLOAT3 sand(0.76f, 0.70f, 0.50f);
-        // Grass: green
-        DirectX::XMFLOAT3 grass(0.2f, 0.5f, 0.15f);
-        // Rock: gray
-        DirectX::XMFLOAT3 rock(0.5f, 0.5f, 0.5f);
-        // Snow: white
-        DirectX::XMFLOAT3 snow(0.95f, 0.95f, 0.98f);
-
-        // Height thresholds
-        const float waterLevel = 0.2f;
-        const float sandLevel = 0.25f;
-        const float grassLevel = 0.6f;
-        const float rockLevel = 0.8f;
-
-        DirectX::XMFLOAT3 color;
-
-        if (normalizedHeight < waterLevel)
-        {
-            // Deep to shallow water
-            float t = normalizedHeight / waterLevel;
-            color.x = deepWater.x + t * (shallowWater.x - deepWater.x);
-            color.y = deepWater.y + t * (shallowWater.y - deepWater.y);
-            color.z = deepWater.z + t * (shallowWater.z - deepWater.z);
-        }
-        else if (normalizedHeight < sandLevel)
-        {
-            // Sand
-            float t = (normalizedHeight - waterLevel) / (sandLevel - waterLevel);
-            color.x = shallowWater.x + t * (sand.x - shallowWater.x);
-            color.y = shallowWater.y + t * (sand.y - shallowWater.y);
-            color.z = shallowWater.z + t * (sand.z - shallowWater.z);
-        }
-        else if (normalizedHeight < grassLevel)
-        {
-            // Grass (with slope-based rock blending)
-            float t = (normalizedHeight - sandLevel) / (grassLevel - sandLevel);
-            color.x = sand.x + t * (grass.x - sand.x);
-            color.y = sand.y + t * (grass.y - sand.y);
-            color.z = sand.z + t * (grass.z - sand.z);
-
-            // Blend with rock on steep slopes
-            if (slope > 0.3f)
-            {
-                float rockBlend = (slope - 0.3f) / 0.4f;
-                rockBlend = std::clamp(rockBlend, 0.0f, 1.0f);
-                color.x = color.x + rockBlend * (rock.x - color.x);
-                color.y = color.y + rockBlend * (rock.y - color.y);
-                color.z = color.z + rockBlend * (rock.z - color.z);
-            }
+    float Chunk::GetApronHeight(int x, int z) const
+    {
+        const int vertexCount = SIZE + 1;
+        if (x < 0)
+        {
+            return m_Apron[z];
         }
-        else if (normalizedHeight < rockLevel)
+        if (x > SIZE)
         {
-            // Rock
-            float t = (normalizedHeight - grassLevel) / (rockLevel - grassLevel);
-            color.x = grass.x + t * (rock.x - grass.x);
-            color.y = grass.y + t * (rock.y - grass.y);
-            color.z = grass.z + t * (rock.z - grass.z);
+            return m_Apron[vertexCount + z];
         }
-        else
+        if (z < 0)
         {
-            // Snow
-            float t = (normalizedHeight - rockLevel) / (1.0f - rockLevel);
-            color.x = rock.x + t * (snow.x - rock.x);
-            color.y = rock.y + t * (snow.y - rock.y);
-            color.z = rock.z + t * (snow.z - rock.z);
+            return m_Apron[vertexCount * 2 + x];
         }
+        return m_Apron[vertexCount * 3 + x];
+    }
 
-        return DirectX::XMFLOAT4(color.x, color.y, color.z, 1.0f);
+    void Chunk::DecodeHeights(float* outHeights) const
+    {
+        const uint16_t* source = m_QuantizedHeights.data();
+        const int count = static_cast<int>(m_QuantizedHeights.size());
+        int i = 0;
+
+#if PCG_NOISE_SIMD
+        // Eight heights per step: widen to 32 bits, convert, then min + q * step like LoadHeight
+#if PCG_NOISE_SIMD_AVX2
+        const __m256 base = _mm256_set1_ps(m_MinHeight);
+        const __m256 step = _mm256_set1_ps(m_QuantizationStep);
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m256i wide = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i)));
+            _mm256_storeu_ps(outHeights + i, _mm256_add_ps(base, _mm256_mul_ps(_mm256_cvtepi32_ps(wide), step)));
+        }
+#else
+        const __m128 base = _mm_set1_ps(m_MinHeight);
+        const __m128 step = _mm_set1_ps(m_QuantizationStep);
+        const __m128i zero = _mm_setzero_si128();
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+            const __m128 low = _mm_cvtepi32_ps(_mm_unpacklo_epi16(packed, zero));
+            const __m128 high = _mm_cvtepi32_ps(_mm_unpackhi_epi16(packed, zero));
+            _mm_storeu_ps(outHeights + i, _mm_add_ps(base, _mm_mul_ps(low, step)));
+            _mm_storeu_ps(outHeights + i + 4, _mm_add_ps(base, _mm_mul_ps(high, step)));
+        }
+#endif
+#endif
+
+        for (; i < count; ++i)
+        {
+            outHeights[i] = m_MinHeight + static_cast<float>(source[i]) * m_QuantizationStep;
+        }
     }
 
     void Chunk::UpdateHeightBounds()
     {
-        if (m_Heights.empty())
+        if (!IsGenerated())
         {
             m_MinHeight = 0.0f;
             m_MaxHeight = 0.0f;
             return;
         }
 
-        m_MinHeight = m_Heights[0];
-        m_MaxHeight = m_Heights[0];
+        BuildHeightPyramid();
+
+        // The pyramid's root spans the whole chunk
+        m_MinHeight = m_PyramidMin[0];
+        m_MaxHeight = m_PyramidMax[0];
+    }
+
+    void Chunk::BuildHeightPyramid()
+    {
+        if (!IsGenerated())
+        {
+            m_PyramidMin.clear();
+            m_PyramidMax.clear();
+            return;
+        }
+
+        m_PyramidMin.resize(PyramidOffset(0));
+        m_PyramidMax.resize(PyramidOffset(0));
+
+        // Level 1: each node spans 2x2 quads (3x3 vertices)
+        const int vertexCount = SIZE + 1;
+        const int leafSide = SIZE / 2;
+        float* leafMin = m_PyramidMin.data() + PyramidOffset(1);
+        float* leafMax = m_PyramidMax.data() + PyramidOffset(1);
 
-        for (float h : m_Heights)
+        for (int z = 0; z < leafSide; ++z)
         {
-            m_MinHeight = std::min(m_MinHeight, h);
-            m_MaxHeight = std::max(m_MaxHeight, h);
+            for (int x = 0; x < leafSide; ++x)
+            {
+                const int row = (z * 2) * vertexCount + x * 2;
+
+                float lo = LoadHeight(row);
+                float hi = lo;
+                for (int dz = 0; dz < 3; ++dz)
+                {
+                    for (int dx = 0; dx < 3; ++dx)
+                    {
+                        const float h = LoadHeight(row + dz * vertexCount + dx);
+                        lo = std::min(lo, h);
+                        hi = std::max(hi, h);
+                    }
+                }
+
+                const uint32_t index = MortonEncode(static_cast<uint32_t>(x), static_cast<uint32_t>(z));
+                leafMin[index] = lo;
+                leafMax[index] = hi;
+            }
+        }
+
+        // Coarser levels: each node reduces its four adjacent children
+        for (int level = 2; level <= PYRAMID_LEVELS; ++level)
+        {
+            const float* childMin = m_PyramidMin.data() + PyramidOffset(level - 1);
+            const float* childMax = m_PyramidMax.data() + PyramidOffset(level - 1);
+            float* nodeMin = m_PyramidMin.data() + PyramidOffset(level);
+            float* nodeMax = m_PyramidMax.data() + PyramidOffset(level);
+
+            const int nodeCount = 1 << (2 * (PYRAMID_LEVELS - level));
+            for (int i = 0; i < nodeCount; ++i)
+            {
+                const float* mins = childMin + i * 4;
+                const float* maxs = childMax + i * 4;
+                nodeMin[i] = std::min(std::min(mins[0], mins[1]), std::min(mins[2], mins[3]));
+                nodeMax[i] = std::max(std::max(maxs[0], maxs[1]), std::max(maxs[2], maxs[3]));
+            }
         }
     }
 
@@ -8,6 +8,7 @@
  * with height data and mesh generation capabilities.
  */
 
+#include "pcg/Biome.h"
 #include "pcg/HeightmapGenerator.h"
 #include "renderer/Mesh.h"
 
@@ -110,6 +111,60 @@ namespace PCG
         }
     };
 
+    /**
+     * @brief Compressed terrain vertex (8 bytes)
+     *
+     * Matches VS_INPUT in TerrainVertex.hlsl. X/Z are reconstructed from the
+     * vertex index within the chunk's LOD grid, and UV and color are derived
+     * in the shader, so only heights and normal are stored.
+     */
+    struct TerrainVertex
+    {
+        uint16_t Height;        ///< UNORM height between the mesh's min and max height
+        uint16_t MorphHeight;   ///< UNORM height of the next coarser grid's surface here (geomorph target)
+        int16_t Normal[2];      ///< Octahedral-encoded normal (SNORM, Y-up hemisphere)
+    };
+
+    static_assert(sizeof(TerrainVertex) == 8, "TerrainVertex must match VS_INPUT in TerrainVertex.hlsl");
+
+    /**
+     * @brief Per-chunk geomorph state, refreshed every update by the ChunkManager
+     *
+     * Edges are ordered -X, +X, -Z, +Z. Two chunks sharing an edge always
+     * agree on its LOD and morph factor, so border vertices match exactly.
+     */
+    struct ChunkMorphState
+    {
+        float MorphFactor = 0.0f;       ///< Blend of interior vertices toward the next LOD (0-1)
+        int EdgeLOD[4] = {};            ///< LOD the border vertices of each edge are drawn at
+        float EdgeMorph[4] = {};        ///< Morph factor of the border vertices of each edge
+    };
+
+    /**
+     * @brief Ray for terrain intersection queries
+     *
+     * Distances are measured in multiples of Direction, so they are world
+     * units when Direction is normalized (ChunkManager::Raycast normalizes it).
+     */
+    struct TerrainRay
+    {
+        DirectX::XMFLOAT3 Origin = { 0.0f, 0.0f, 0.0f };
+        DirectX::XMFLOAT3 Direction = { 0.0f, -1.0f, 0.0f };
+        float MaxDistance = 1000.0f;    ///< Hits beyond this are ignored
+    };
+
+    /**
+     * @brief Result of a terrain ray query
+     */
+    struct TerrainHit
+    {
+        bool Hit = false;
+        float Distance = 0.0f;                          ///< Along the ray, in units of its Direction
+        DirectX::XMFLOAT3 Position = { 0.0f, 0.0f, 0.0f };
+        DirectX::XMFLOAT3 Normal = { 0.0f, 1.0f, 0.0f };  ///< Unit normal of the hit triangle
+        ChunkCoord Chunk;                               ///< Chunk that was hit
+    };
+
     /**
      * @brief Terrain chunk containing height data and mesh
      *
@@ -125,6 +180,18 @@ namespace PCG
         static constexpr int SIZE = 32;          ///< Number of vertices per side (33x33 for 32x32 quads)
         static constexpr int VERTEX_COUNT = (SIZE + 1) * (SIZE + 1);
         static constexpr float SCALE = 1.0f;     ///< World units per vertex spacing
+        static constexpr int MAX_LOD = 4;        ///< Coarsest LOD level (step size = 16)
+        static constexpr int PYRAMID_LEVELS = 5; ///< Height pyramid levels above single quads (2^5 = SIZE)
+        static constexpr int APRON_SAMPLE_COUNT = 4 * (SIZE + 1); ///< Heights one step outside each edge (see GenerateApron)
+
+        // Stitch mask bits: edges whose neighbour is one LOD coarser
+        static constexpr uint32_t STITCH_NEG_X = 1u << 0;
+        static constexpr uint32_t STITCH_POS_X = 1u << 1;
+        static constexpr uint32_t STITCH_NEG_Z = 1u << 2;
+        static constexpr uint32_t STITCH_POS_Z = 1u << 3;
+        static constexpr uint32_t STITCH_VARIANT_COUNT = 16;
+
+        static constexpr float EDIT_HEIGHT_HEADROOM = 0.25f;  ///< Mesh height range padding after edits, as a fraction of the range
 
         /**
          * @brief Construct a chunk at the given coordinate
@@ -162,19 +229,190 @@ namespace PCG
          */
         void GenerateCustom(std::function<float(float, float)> heightFunc);
 
+        /**
+         * @brief Generate height data with a single batched grid call
+         * @param gridFunc Called once as gridFunc(originX, originZ, step, verticesPerSide, heights);
+         *                 must fill verticesPerSide^2 heights, row-major by Z
+         *
+         * heights[z * verticesPerSide + x] is the height at world position
+         * (originX + x * step, originZ + z * step), the same positions
+         * GenerateCustom passes to its height function.
+         */
+        void GenerateBatch(const std::function<void(float, float, float, int, float*)>& gridFunc);
+
+        /**
+         * @brief Sample the apron: one row of heights just outside each edge
+         * @param stripFunc Called once per edge as stripFunc(originX, originZ, step, width, height, heights);
+         *                  must fill width * height heights, row-major by Z, like GenerateBatch
+         *
+         * With an apron, edge normals use central differences like interior
+         * ones, so they agree with the neighbouring chunk's without reading
+         * it (exactly only when both sides sampled their heights the same way
+         * and neither is quantized). The apron belongs to the current
+         * heights: anything that replaces them drops it. Call after the
+         * heights are generated or adopted.
+         */
+        void GenerateApron(const std::function<void(float, float, float, int, int, float*)>& stripFunc);
+
+        /**
+         * @brief Adopt previously generated height data (e.g. from the chunk cache)
+         * @param heights VERTEX_COUNT heights, row-major by Z
+         * @param minHeight Minimum of heights
+         * @param maxHeight Maximum of heights
+         * @return false (leaving the chunk unchanged) if heights has the wrong size
+         */
+        bool SetHeightData(std::vector<float>&& heights, float minHeight, float maxHeight);
+
+        /**
+         * @brief Move the height grid out, leaving the chunk ungenerated
+         *
+         * The biome grid and apron are derived from the heights and are dropped with them.
+         */
+        std::vector<float> TakeHeightData();
+
+        /**
+         * @brief Replace the float height grid with 16-bit heights between the min and max height
+         *
+         * Halves the grid's memory. Heights decode to within
+         * (max - min) / 131070 of the originals, the extremes exactly, and
+         * the mesh (quantized to the same 16 bits) keeps its vertex heights.
+         * Queries decode on the fly. Generating or adopting new heights
+         * returns to float storage.
+         */
+        void QuantizeHeights();
+
+        /**
+         * @brief Check if the height grid is stored quantized
+         */
+        bool IsQuantized() const { return !m_QuantizedHeights.empty(); }
+
+        /**
+         * @brief Attach a biome grid classified from this chunk's heights
+         * @param biomes VERTEX_COUNT biome IDs, row-major by Z like the heights
+         * @return false (leaving the chunk unchanged) if biomes has the wrong size
+         */
+        bool SetBiomeData(std::vector<BiomeType>&& biomes);
+
+        // ====================================================================
+        // Editing
+        // ====================================================================
+
+        /**
+         * @brief Height edit: (worldX, worldZ, height) -> new height
+         */
+        using HeightEditFunc = std::function<float(float, float, float)>;
+
+        /**
+         * @brief Change the heights inside a world-space rectangle
+         * @param minX Rectangle min X (world units, inclusive)
+         * @param minZ Rectangle min Z
+         * @param maxX Rectangle max X (inclusive)
+         * @param maxZ Rectangle max Z
+         * @param edit Called once per grid and apron sample inside the rectangle
+         * @return true if any height changed
+         *
+         * Quantized heights return to float storage first. The apron holds
+         * the neighbours' edge heights, so an edit spanning chunks must be
+         * applied to each of them with the same function. The changed rows
+         * are remembered for UpdateMeshRegion, and meshes built after an
+         * edit keep EDIT_HEIGHT_HEADROOM around the height range so later
+         * edits usually fit without a rebuild.
+         */
+        bool EditHeights(float minX, float minZ, float maxX, float maxZ, const HeightEditFunc& edit);
+
+        /**
+         * @brief Check if edited heights have not reached the mesh yet
+         */
+        bool HasDirtyRegion() const { return m_DirtyMinZ <= m_DirtyMaxZ; }
+
+        /**
+         * @brief Forget the edited rows (e.g. after uploading them some other way)
+         */
+        void ClearDirtyRegion()
+        {
+            m_DirtyMinZ = SIZE + 2;
+            m_DirtyMaxZ = -2;
+        }
+
+        /**
+         * @brief Re-upload only the mesh vertex rows the edited heights affect
+         * @param core DX12 core for the copy queue
+         * @return false if the mesh cannot be patched in place: none built,
+         *         another still uploading, built at a different LOD, not on
+         *         the copy queue, or heights outside its quantization range.
+         *         Call BuildMesh then.
+         *
+         * Rows are those whose heights, normals or geomorph targets read an
+         * edited sample, uploaded as a few contiguous spans. The caller must
+         * make the direct queue wait on the mesh's upload fence before
+         * drawing it (see SM::Mesh::UpdateVertices). Bumps the mesh revision.
+         */
+        bool UpdateMeshRegion(SM::DX12Core* core);
+
         /**
          * @brief Build the GPU mesh from height data
          * @param core DX12 core for GPU resource creation
+         * @param buildIndices false to skip the index buffer and draw with a
+         *                     shared per-LOD one (see GenerateLODIndices)
          * @return true if mesh creation succeeded
+         *
+         * With geomorphing enabled the mesh is always built at full resolution
+         * without indices, whatever the current LOD.
+         *
+         * The new mesh uploads on the copy queue and replaces the current one
+         * in PromotePendingMesh once it is ready; until then the previous
+         * mesh (if any) keeps rendering.
          */
-        bool BuildMesh(SM::DX12Core* core);
+        bool BuildMesh(SM::DX12Core* core, bool buildIndices = true);
+
+        /**
+         * @brief Generate the vertices BuildMesh would upload, on the CPU only
+         * @param outVertices Receives the vertices of the current mesh LOD
+         * @return false if the chunk has no height data
+         *
+         * For tools and benchmarks; needs no device.
+         */
+        bool BuildVertices(std::vector<TerrainVertex>& outVertices) const;
 
         /**
          * @brief Rebuild mesh with current LOD level
          * @param core DX12 core for GPU resource creation
+         * @param buildIndices false to skip the index buffer
          * @return true if mesh recreation succeeded
          */
-        bool RebuildMesh(SM::DX12Core* core);
+        bool RebuildMesh(SM::DX12Core* core, bool buildIndices = true);
+
+        /**
+         * @brief Generate the index list for a chunk mesh at a LOD step
+         * @param indices Output index array
+         * @param lodStep Step size based on LOD level (1 << LOD)
+         *
+         * Topology depends only on the step, so every chunk at the same LOD
+         * can share one index buffer.
+         */
+        static void GenerateLODIndices(std::vector<uint32_t>& indices, int lodStep);
+
+        /**
+         * @brief Get the GenerateLODIndices list for a LOD level, built once and shared
+         * @param lod LOD level (clamped to 0-MAX_LOD)
+         *
+         * The same triangles, reordered for the post-transform vertex cache
+         * (SM::MeshOptimizer); Mesh::Create stores them as 16-bit indices.
+         */
+        static const std::vector<uint32_t>& GetSharedLODIndices(int lod);
+
+        /**
+         * @brief Generate a stitched index list over the full-resolution vertex grid
+         * @param indices Output index array
+         * @param lodStep Step size of the drawn LOD (1 << LOD)
+         * @param stitchMask STITCH_* bits of edges to match to a grid twice as coarse
+         *
+         * Odd vertices on stitched edges are collapsed onto their even
+         * neighbour, which removes T-junctions against the coarser chunk.
+         * The collapsed triangles become degenerate rather than removed, so
+         * every variant of a LOD has the same index count.
+         */
+        static void GenerateStitchedIndices(std::vector<uint32_t>& indices, int lodStep, uint32_t stitchMask);
 
         // ====================================================================
         // Accessors
@@ -211,13 +449,24 @@ namespace PCG
         /**
          * @brief Check if height data has been generated
          */
-        bool IsGenerated() const { return !m_Heights.empty(); }
+        bool IsGenerated() const { return !m_Heights.empty() || !m_QuantizedHeights.empty(); }
 
         /**
          * @brief Check if mesh has been built
          */
         bool HasMesh() const { return m_Mesh.IsValid(); }
 
+        /**
+         * @brief Check if a built mesh is still uploading
+         */
+        bool HasPendingMesh() const { return m_PendingMesh.IsValid(); }
+
+        /**
+         * @brief Swap in the pending mesh if its upload has finished
+         * @return true if the mesh was replaced
+         */
+        bool PromotePendingMesh();
+
         /**
          * @brief Get height at local coordinates
          * @param localX Local X (0 to SIZE)
@@ -234,6 +483,58 @@ namespace PCG
          */
         float GetHeightInterpolated(float localX, float localZ) const;
 
+        /**
+         * @brief Get the raw height grid (VERTEX_COUNT elements, row-major by Z)
+         *
+         * Empty once quantized; CopyHeights works either way.
+         */
+        const std::vector<float>& GetHeights() const { return m_Heights; }
+
+        /**
+         * @brief Copy the height grid as floats, decoding quantized heights
+         * @param outHeights Receives VERTEX_COUNT heights (empty if not generated)
+         */
+        void CopyHeights(std::vector<float>& outHeights) const;
+
+        /**
+         * @brief Get the CPU memory held by the height grid, float or quantized
+         */
+        size_t GetHeightBytes() const
+        {
+            return m_Heights.capacity() * sizeof(float) + m_QuantizedHeights.capacity() * sizeof(uint16_t);
+        }
+
+        /**
+         * @brief Check if an apron has been sampled for the current heights
+         */
+        bool HasApron() const { return !m_Apron.empty(); }
+
+        /**
+         * @brief Get the apron (APRON_SAMPLE_COUNT heights; empty if none)
+         *
+         * Edges in stitch order -X, +X, -Z, +Z, each SIZE + 1 samples along
+         * the edge (by Z for the X edges, by X for the Z edges).
+         */
+        const std::vector<float>& GetApronHeights() const { return m_Apron; }
+
+        /**
+         * @brief Check if a biome grid has been attached
+         */
+        bool HasBiomes() const { return !m_Biomes.empty(); }
+
+        /**
+         * @brief Get the biome grid (VERTEX_COUNT one-byte IDs, row-major by Z; empty if none)
+         */
+        const std::vector<BiomeType>& GetBiomes() const { return m_Biomes; }
+
+        /**
+         * @brief Get the biome at a vertex
+         * @param localX Local X (0 to SIZE)
+         * @param localZ Local Z (0 to SIZE)
+         * @return Biome type, or BiomeType::Count if out of bounds or no biome grid
+         */
+        BiomeType GetBiome(int localX, int localZ) const;
+
         /**
          * @brief Get the minimum height in this chunk
          */
@@ -244,6 +545,52 @@ namespace PCG
          */
         float GetMaxHeight() const { return m_MaxHeight; }
 
+        /**
+         * @brief Get the minimum height the current mesh was quantized against
+         */
+        float GetMeshMinHeight() const { return m_MeshMinHeight; }
+
+        /**
+         * @brief Get the maximum height the current mesh was quantized against
+         */
+        float GetMeshMaxHeight() const { return m_MeshMaxHeight; }
+
+        /**
+         * @brief Get the revision of the current mesh (0 = none)
+         *
+         * Taken from a process-wide counter whenever a mesh is promoted, so
+         * it also tells apart a new chunk that reuses an unloaded one's
+         * coordinate. Used to re-render cached shadow maps only where the
+         * terrain changed.
+         */
+        uint64_t GetMeshRevision() const { return m_MeshRevision; }
+
+        /**
+         * @brief Get the CPU memory held by the min/max height pyramid
+         */
+        size_t GetHeightPyramidBytes() const
+        {
+            return (m_PyramidMin.capacity() + m_PyramidMax.capacity()) * sizeof(float);
+        }
+
+        // ====================================================================
+        // Ray Queries
+        // ====================================================================
+
+        /**
+         * @brief Intersect a ray with this chunk's surface
+         * @param ray World-space ray
+         * @param tMin Start of the searched interval along the ray
+         * @param tMax End of the searched interval (e.g. the nearest hit so far)
+         * @param hit Receives the hit if one is found
+         * @return true if the ray hits the surface within [tMin, tMax]
+         *
+         * Tests the triangles of the full-resolution mesh (same diagonals as
+         * GenerateLODIndices), descending the min/max height pyramid so only
+         * nodes whose bounds the ray crosses are visited, nearest first.
+         */
+        bool Raycast(const TerrainRay& ray, float tMin, float tMax, TerrainHit& hit) const;
+
         // ====================================================================
         // LOD (Level of Detail)
         // ====================================================================
@@ -259,25 +606,81 @@ namespace PCG
          */
         int GetLOD() const { return m_LOD; }
 
+        /**
+         * @brief Get the LOD level the current mesh was built at
+         */
+        int GetMeshLOD() const { return m_MeshLOD; }
+
         /**
          * @brief Check if LOD changed since last mesh build
          */
         bool NeedsRebuild() const { return m_NeedsRebuild; }
 
+        // ====================================================================
+        // Geomorphing
+        // ====================================================================
+
+        /**
+         * @brief Build one full-resolution mesh and change LOD in the vertex shader
+         *
+         * LOD changes then only update the morph state instead of rebuilding
+         * the mesh. Takes effect at the next BuildMesh.
+         */
+        void SetGeomorphEnabled(bool enabled) { m_Geomorph = enabled; }
+
+        /**
+         * @brief Check if the current mesh can be drawn with stitched full-resolution indices
+         */
+        bool HasGeomorphMesh() const { return m_Geomorph && m_MeshLOD == 0 && m_Mesh.IsValid() && !m_Mesh.HasIndices(); }
+
+        /**
+         * @brief Set the morph factor and per-edge LODs for this frame
+         */
+        void SetMorphState(const ChunkMorphState& state) { m_MorphState = state; }
+
+        /**
+         * @brief Get the morph factor and per-edge LODs
+         */
+        const ChunkMorphState& GetMorphState() const { return m_MorphState; }
+
+        /**
+         * @brief Get the STITCH_* bits of edges drawn at a coarser LOD than the chunk
+         */
+        uint32_t GetStitchMask() const;
+
     private:
         /**
-         * @brief Generate vertex data from heights
-         * @param vertices Output vertex array
+         * @brief Generate compressed vertex data from heights
+         * @param vertices Receives rowCount * ((SIZE / lodStep) + 1) vertices, row-major by Z over the LOD grid
          * @param lodStep Step size based on LOD level
+         * @param firstRow First LOD grid row to generate
+         * @param rowCount Number of LOD grid rows
+         * @param minHeight Height quantized to 0
+         * @param maxHeight Height quantized to 65535
+         *
+         * Writes each vertex once, in order, so vertices may point at mapped
+         * upload memory.
          */
-        void GenerateVertices(std::vector<SM::Vertex>& vertices, int lodStep) const;
+        void GenerateVertices(TerrainVertex* vertices, int lodStep, int firstRow, int rowCount,
+                              float minHeight, float maxHeight) const;
 
         /**
-         * @brief Generate index data for the mesh
-         * @param indices Output index array
-         * @param lodStep Step size based on LOD level
+         * @brief Get the height range a new mesh is quantized against
+         *
+         * The chunk's own range, padded by EDIT_HEIGHT_HEADROOM once edited.
          */
-        void GenerateIndices(std::vector<uint32_t>& indices, int lodStep) const;
+        void GetMeshHeightRange(float& outMin, float& outMax) const;
+
+        /**
+         * @brief Calculate the geomorph target height of a vertex
+         * @param x Local X coordinate
+         * @param z Local Z coordinate
+         * @return Height of the next coarser grid's surface at the vertex
+         *
+         * Matches the diagonal used by GenerateLODIndices, so a fully
+         * morphed LOD is identical to the next LOD.
+         */
+        float CalculateMorphHeight(int x, int z) const;
 
         /**
          * @brief Calculate normal at a vertex position
@@ -288,28 +691,79 @@ namespace PCG
         DirectX::XMFLOAT3 CalculateNormal(int x, int z) const;
 
         /**
-         * @brief Calculate vertex color based on height and normal
-         * @param height Height value
-         * @param normal Normal vector
-         * @return Vertex color (RGBA)
+         * @brief Read a height grid sample, float or quantized
+         */
+        float LoadHeight(int index) const
+        {
+            return m_QuantizedHeights.empty()
+                ? m_Heights[index]
+                : m_MinHeight + static_cast<float>(m_QuantizedHeights[index]) * m_QuantizationStep;
+        }
+
+        /**
+         * @brief Decode the quantized grid into VERTEX_COUNT floats
+         */
+        void DecodeHeights(float* outHeights) const;
+
+        /**
+         * @brief Get a height one step past the grid from the apron
+         * @param x Local X (-1 to SIZE + 1)
+         * @param z Local Z (-1 to SIZE + 1); at most one of x and z may be outside the grid
+         */
+        float GetApronHeight(int x, int z) const;
+
+        /**
+         * @brief Check if a mesh row reads a height in the dirty rows
+         * @param z Local Z of the row (0 to SIZE)
          */
-        DirectX::XMFLOAT4 CalculateVertexColor(float height, const DirectX::XMFLOAT3& normal) const;
+        bool IsRowAffectedByEdit(int z) const;
 
         /**
-         * @brief Update min/max height values
+         * @brief Update min/max height values and the height pyramid
          */
         void UpdateHeightBounds();
 
+        /**
+         * @brief Rebuild the min/max height pyramid from the height grid
+         *
+         * Level 1 nodes cover 2x2 quads, each level above halves the
+         * resolution, and level PYRAMID_LEVELS is the whole chunk. Nodes are
+         * stored top-down with each level in Morton order, so the four
+         * children of a node are adjacent.
+         */
+        void BuildHeightPyramid();
+
     private:
         ChunkCoord m_Coord;                  ///< Grid coordinate of this chunk
         int m_LOD = 0;                       ///< Current LOD level
+        int m_MeshLOD = 0;                   ///< LOD level of the built mesh
+        int m_PendingMeshLOD = 0;            ///< LOD level of the uploading mesh
         bool m_NeedsRebuild = false;         ///< Whether mesh needs rebuilding
-
-        std::vector<float> m_Heights;        ///< Height data (SIZE+1)^2 elements
+        bool m_Geomorph = false;             ///< Full-resolution mesh, LOD chosen in the shader
+        ChunkMorphState m_MorphState;        ///< Geomorph state for the current LOD
+
+        std::vector<float> m_Heights;        ///< Height data (SIZE+1)^2 elements (empty when quantized)
+        std::vector<uint16_t> m_QuantizedHeights; ///< Heights as UNORM between m_MinHeight and m_MaxHeight (see QuantizeHeights)
+        float m_QuantizationStep = 0.0f;     ///< Height of one quantized unit
+        std::vector<BiomeType> m_Biomes;     ///< Biome per height sample (empty if not classified)
+        std::vector<float> m_Apron;          ///< Heights just outside each edge (empty if not sampled)
         float m_MinHeight = 0.0f;            ///< Minimum height in chunk
         float m_MaxHeight = 0.0f;            ///< Maximum height in chunk
+        std::vector<float> m_PyramidMin;     ///< Min height per pyramid node (see BuildHeightPyramid)
+        std::vector<float> m_PyramidMax;     ///< Max height per pyramid node
+
+        float m_MeshMinHeight = 0.0f;        ///< Height range the built mesh was quantized against
+        float m_MeshMaxHeight = 0.0f;
+        float m_PendingMeshMinHeight = 0.0f; ///< Height range of the uploading mesh
+        float m_PendingMeshMaxHeight = 0.0f;
+        uint64_t m_MeshRevision = 0;         ///< See GetMeshRevision
+
+        bool m_Edited = false;               ///< Heights changed by EditHeights since generation
+        int m_DirtyMinZ = SIZE + 2;          ///< Local Z rows edited since the last upload (-1 and SIZE + 1 are apron rows)
+        int m_DirtyMaxZ = -2;                ///< Below m_DirtyMinZ when clean
 
         SM::Mesh m_Mesh;                     ///< GPU mesh
+        SM::Mesh m_PendingMesh;              ///< Mesh whose upload is in flight
     };
 
 } // namespace PCG
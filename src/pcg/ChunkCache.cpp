@@ -0,0 +1,490 @@
+#include "pcg/ChunkCache.h"
+#include "core/Compression.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace PCG
+{
+    namespace
+    {
+        constexpr uint64_t FNV_OFFSET = 14695981039346656037ull;
+        constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+        template<typename T>
+        void HashValue(uint64_t& hash, const T& value)
+        {
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+            for (size_t i = 0; i < sizeof(T); ++i)
+            {
+                hash ^= bytes[i];
+                hash *= FNV_PRIME;
+            }
+        }
+
+        int FloorDiv(int value, int divisor)
+        {
+            int q = value / divisor;
+            return (value % divisor != 0 && value < 0) ? q - 1 : q;
+        }
+    }
+
+    ChunkCache::~ChunkCache()
+    {
+        Shutdown();
+    }
+
+    // ============================================================================
+    // Initialization
+    // ============================================================================
+
+    bool ChunkCache::Initialize(const std::string& rootPath, uint64_t settingsKey)
+    {
+        Shutdown();
+
+        char keyName[17];
+        std::snprintf(keyName, sizeof(keyName), "%016llx", static_cast<unsigned long long>(settingsKey));
+
+        std::string directory = SM::FileSystem::CombinePath(rootPath, keyName);
+        if (!SM::FileSystem::IsDirectory(directory) && !SM::FileSystem::CreateDirectory(directory))
+        {
+            std::cerr << "[ChunkCache] Failed to create cache directory: " << directory << std::endl;
+            return false;
+        }
+
+        m_Directory = directory;
+        m_SettingsKey = settingsKey;
+        m_Stats = ChunkCacheStats();
+
+        std::cout << "[ChunkCache] Using " << m_Directory << std::endl;
+        return true;
+    }
+
+    void ChunkCache::Shutdown()
+    {
+        if (!IsInitialized())
+        {
+            return;
+        }
+
+        Flush();
+        m_Regions.clear();
+        m_Directory.clear();
+        m_Stats.OpenRegions = 0;
+    }
+
+    uint64_t ChunkCache::ComputeSettingsKey(const HeightmapSettings& settings, uint32_t generatorId)
+    {
+        // Only fields CreateChunk reads; hashed one by one so struct padding never leaks in
+        uint64_t hash = FNV_OFFSET;
+        HashValue(hash, REGION_VERSION);
+        HashValue(hash, generatorId);
+        HashValue(hash, Chunk::SIZE);
+        HashValue(hash, Chunk::SCALE);
+        HashValue(hash, settings.Seed);
+        HashValue(hash, settings.Noise.Octaves);
+        HashValue(hash, settings.Noise.Frequency);
+        HashValue(hash, settings.Noise.Amplitude);
+        HashValue(hash, settings.Noise.Lacunarity);
+        HashValue(hash, settings.Noise.Persistence);
+        HashValue(hash, settings.Noise.Gain);
+        HashValue(hash, settings.Noise.Offset);
+        HashValue(hash, settings.MinHeight);
+        HashValue(hash, settings.MaxHeight);
+        HashValue(hash, settings.ApplyDomainWarp);
+        HashValue(hash, settings.WarpStrength);
+        return hash;
+    }
+
+    // ============================================================================
+    // Records
+    // ============================================================================
+
+    bool ChunkCache::Load(const ChunkCoord& coord, std::vector<float>& heights, float& minHeight, float& maxHeight,
+                          std::vector<uint8_t>* biomeIDs)
+    {
+        if (!IsInitialized())
+        {
+            return false;
+        }
+
+        Region& region = AcquireRegion(ToRegionCoord(coord));
+        const uint32_t index = ToRegionIndex(coord);
+
+        // A record stored but not flushed yet
+        for (const PendingRecord& record : region.Pending)
+        {
+            if (record.Index == index)
+            {
+                if (!DecodeRecord(record.Bytes.data(), record.Bytes.size(), heights, minHeight, maxHeight, biomeIDs))
+                {
+                    return false;
+                }
+
+                m_Stats.Hits++;
+                return true;
+            }
+        }
+
+        const RegionEntry& entry = region.Header.Entries[index];
+        if (!region.File.IsOpen() || entry.Offset == 0 ||
+            static_cast<uint64_t>(entry.Offset) + entry.Size > region.File.GetSize())
+        {
+            m_Stats.Misses++;
+            return false;
+        }
+
+        if (!DecodeRecord(region.File.GetData() + entry.Offset, entry.Size, heights, minHeight, maxHeight, biomeIDs))
+        {
+            std::cerr << "[ChunkCache] Corrupt record for chunk (" << coord.X << ", " << coord.Z << ")" << std::endl;
+            m_Stats.Misses++;
+            return false;
+        }
+
+        m_Stats.Hits++;
+        m_Stats.BytesRead += entry.Size;
+        return true;
+    }
+
+    bool ChunkCache::Contains(const ChunkCoord& coord)
+    {
+        if (!IsInitialized())
+        {
+            return false;
+        }
+
+        Region& region = AcquireRegion(ToRegionCoord(coord));
+        const uint32_t index = ToRegionIndex(coord);
+
+        if (region.Header.Entries[index].Offset != 0)
+        {
+            return true;
+        }
+
+        for (const PendingRecord& record : region.Pending)
+        {
+            if (record.Index == index)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void ChunkCache::Store(const ChunkCoord& coord, const std::vector<float>& heights, float minHeight, float maxHeight,
+                           const std::vector<uint8_t>* biomeIDs)
+    {
+        if (!IsInitialized() || heights.size() != static_cast<size_t>(Chunk::VERTEX_COUNT) || Contains(coord))
+        {
+            return;
+        }
+
+        if (biomeIDs && biomeIDs->size() != static_cast<size_t>(Chunk::VERTEX_COUNT))
+        {
+            biomeIDs = nullptr;
+        }
+
+        Region& region = AcquireRegion(ToRegionCoord(coord));
+
+        PendingRecord record;
+        record.Index = ToRegionIndex(coord);
+        EncodeRecord(heights, minHeight, maxHeight, biomeIDs, record.Bytes);
+        region.Pending.push_back(std::move(record));
+    }
+
+    void ChunkCache::Flush()
+    {
+        for (auto& pair : m_Regions)
+        {
+            FlushRegion(*pair.second);
+        }
+    }
+
+    // ============================================================================
+    // Regions
+    // ============================================================================
+
+    ChunkCoord ChunkCache::ToRegionCoord(const ChunkCoord& coord)
+    {
+        return ChunkCoord(FloorDiv(coord.X, REGION_SIZE), FloorDiv(coord.Z, REGION_SIZE));
+    }
+
+    uint32_t ChunkCache::ToRegionIndex(const ChunkCoord& coord)
+    {
+        const int localX = coord.X - FloorDiv(coord.X, REGION_SIZE) * REGION_SIZE;
+        const int localZ = coord.Z - FloorDiv(coord.Z, REGION_SIZE) * REGION_SIZE;
+        return static_cast<uint32_t>(localZ * REGION_SIZE + localX);
+    }
+
+    std::string ChunkCache::GetRegionPath(const ChunkCoord& regionCoord) const
+    {
+        char name[48];
+        std::snprintf(name, sizeof(name), "r.%d.%d.smr", regionCoord.X, regionCoord.Z);
+        return SM::FileSystem::CombinePath(m_Directory, name);
+    }
+
+    ChunkCache::Region& ChunkCache::AcquireRegion(const ChunkCoord& regionCoord)
+    {
+        auto it = m_Regions.find(regionCoord);
+        if (it != m_Regions.end())
+        {
+            it->second->LastUse = ++m_UseCounter;
+            return *it->second;
+        }
+
+        // Close the least recently used region to bound mapped address space
+        if (m_Regions.size() >= MAX_OPEN_REGIONS)
+        {
+            auto oldest = m_Regions.begin();
+            for (auto candidate = m_Regions.begin(); candidate != m_Regions.end(); ++candidate)
+            {
+                if (candidate->second->LastUse < oldest->second->LastUse)
+                {
+                    oldest = candidate;
+                }
+            }
+
+            FlushRegion(*oldest->second);
+            m_Regions.erase(oldest);
+        }
+
+        auto region = std::make_unique<Region>();
+        region->Coord = regionCoord;
+        region->LastUse = ++m_UseCounter;
+        OpenRegion(*region);
+
+        Region& result = *region;
+        m_Regions.emplace(regionCoord, std::move(region));
+        m_Stats.OpenRegions = static_cast<uint32_t>(m_Regions.size());
+        return result;
+    }
+
+    void ChunkCache::OpenRegion(Region& region)
+    {
+        region.File.Close();
+        region.Header = RegionHeader();
+        region.OnDisk = false;
+
+        std::string path = GetRegionPath(region.Coord);
+        if (!SM::FileSystem::FileExists(path) || !region.File.Open(path))
+        {
+            return;
+        }
+
+        if (region.File.GetSize() < sizeof(RegionHeader))
+        {
+            std::cerr << "[ChunkCache] Discarding truncated region file: " << path << std::endl;
+            region.File.Close();
+            return;
+        }
+
+        RegionHeader header;
+        std::memcpy(&header, region.File.GetData(), sizeof(RegionHeader));
+
+        if (header.Magic != REGION_MAGIC || header.Version != REGION_VERSION ||
+            header.SettingsKey != m_SettingsKey ||
+            header.RegionX != region.Coord.X || header.RegionZ != region.Coord.Z)
+        {
+            std::cerr << "[ChunkCache] Discarding mismatched region file: " << path << std::endl;
+            region.File.Close();
+            return;
+        }
+
+        region.Header = header;
+        region.OnDisk = true;
+    }
+
+    bool ChunkCache::FlushRegion(Region& region)
+    {
+        if (region.Pending.empty())
+        {
+            return true;
+        }
+
+        std::string path = GetRegionPath(region.Coord);
+
+        // The mapping must be gone before the file can grow
+        region.File.Close();
+
+        std::fstream file;
+        if (region.OnDisk)
+        {
+            file.open(path, std::ios::binary | std::ios::in | std::ios::out);
+        }
+        else
+        {
+            region.Header = RegionHeader();
+            region.Header.Magic = REGION_MAGIC;
+            region.Header.Version = REGION_VERSION;
+            region.Header.SettingsKey = m_SettingsKey;
+            region.Header.RegionX = region.Coord.X;
+            region.Header.RegionZ = region.Coord.Z;
+
+            file.open(path, std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(&region.Header), sizeof(RegionHeader));
+        }
+
+        if (!file)
+        {
+            std::cerr << "[ChunkCache] Failed to open region file for writing: " << path << std::endl;
+            region.Pending.clear();
+            OpenRegion(region);
+            return false;
+        }
+
+        // Append records, then publish them in the header
+        file.seekp(0, std::ios::end);
+        for (const PendingRecord& record : region.Pending)
+        {
+            RegionEntry& entry = region.Header.Entries[record.Index];
+            entry.Offset = static_cast<uint32_t>(file.tellp());
+            entry.Size = static_cast<uint32_t>(record.Bytes.size());
+            file.write(reinterpret_cast<const char*>(record.Bytes.data()), static_cast<std::streamsize>(record.Bytes.size()));
+
+            m_Stats.Stores++;
+            m_Stats.BytesWritten += record.Bytes.size();
+        }
+
+        file.seekp(0, std::ios::beg);
+        file.write(reinterpret_cast<const char*>(&region.Header), sizeof(RegionHeader));
+
+        bool success = static_cast<bool>(file);
+        file.close();
+        region.Pending.clear();
+
+        if (!success)
+        {
+            std::cerr << "[ChunkCache] Failed to write region file: " << path << std::endl;
+        }
+
+        OpenRegion(region);
+        return success;
+    }
+
+    // ============================================================================
+    // Encoding
+    // ============================================================================
+
+    void ChunkCache::EncodeRecord(const std::vector<float>& heights, float minHeight, float maxHeight,
+                                  const std::vector<uint8_t>* biomeIDs, std::vector<uint8_t>& bytes)
+    {
+        const int verticesPerSide = Chunk::SIZE + 1;
+        const size_t count = heights.size();
+
+        // XOR each sample against its left neighbour (the one above at row
+        // starts): smooth terrain leaves mostly-zero sign/exponent bytes
+        std::vector<uint32_t> residuals(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &heights[i], sizeof(bits));
+
+            uint32_t previous = 0;
+            const size_t x = i % verticesPerSide;
+            if (x > 0 || i >= static_cast<size_t>(verticesPerSide))
+            {
+                const size_t neighbour = x > 0 ? i - 1 : i - verticesPerSide;
+                std::memcpy(&previous, &heights[neighbour], sizeof(previous));
+            }
+
+            residuals[i] = bits ^ previous;
+        }
+
+        std::vector<uint8_t> shuffled(count * sizeof(uint32_t));
+        SM::Compression::ShuffleBytes(residuals.data(), count, sizeof(uint32_t), shuffled.data());
+
+        std::vector<uint8_t> heightBlock;
+        SM::Compression::CompressLZ4(shuffled.data(), shuffled.size(), heightBlock);
+
+        std::vector<uint8_t> biomeBlock;
+        if (biomeIDs)
+        {
+            SM::Compression::CompressLZ4(biomeIDs->data(), biomeIDs->size(), biomeBlock);
+        }
+
+        RecordHeader header;
+        header.VerticesPerSide = static_cast<uint32_t>(verticesPerSide);
+        header.Flags = biomeIDs ? RECORD_HAS_BIOMES : 0;
+        header.MinHeight = minHeight;
+        header.MaxHeight = maxHeight;
+        header.HeightBytes = static_cast<uint32_t>(heightBlock.size());
+        header.BiomeBytes = static_cast<uint32_t>(biomeBlock.size());
+
+        bytes.resize(sizeof(RecordHeader) + heightBlock.size() + biomeBlock.size());
+        std::memcpy(bytes.data(), &header, sizeof(RecordHeader));
+        std::memcpy(bytes.data() + sizeof(RecordHeader), heightBlock.data(), heightBlock.size());
+        if (!biomeBlock.empty())
+        {
+            std::memcpy(bytes.data() + sizeof(RecordHeader) + heightBlock.size(), biomeBlock.data(), biomeBlock.size());
+        }
+    }
+
+    bool ChunkCache::DecodeRecord(const uint8_t* data, size_t size, std::vector<float>& heights,
+                                  float& minHeight, float& maxHeight, std::vector<uint8_t>* biomeIDs)
+    {
+        if (size < sizeof(RecordHeader))
+        {
+            return false;
+        }
+
+        RecordHeader header;
+        std::memcpy(&header, data, sizeof(RecordHeader));
+
+        const int verticesPerSide = Chunk::SIZE + 1;
+        const size_t count = static_cast<size_t>(Chunk::VERTEX_COUNT);
+
+        if (header.VerticesPerSide != static_cast<uint32_t>(verticesPerSide) ||
+            sizeof(RecordHeader) + static_cast<uint64_t>(header.HeightBytes) + header.BiomeBytes > size)
+        {
+            return false;
+        }
+
+        const uint8_t* heightBlock = data + sizeof(RecordHeader);
+        m_Scratch.resize(count * sizeof(uint32_t));
+        if (!SM::Compression::DecompressLZ4(heightBlock, header.HeightBytes, m_Scratch.data(), m_Scratch.size()))
+        {
+            return false;
+        }
+
+        std::vector<uint32_t> residuals(count);
+        SM::Compression::UnshuffleBytes(m_Scratch.data(), count, sizeof(uint32_t), residuals.data());
+
+        // Undo the XOR in generation order so every neighbour is already restored
+        heights.resize(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            uint32_t previous = 0;
+            const size_t x = i % verticesPerSide;
+            if (x > 0 || i >= static_cast<size_t>(verticesPerSide))
+            {
+                const size_t neighbour = x > 0 ? i - 1 : i - verticesPerSide;
+                std::memcpy(&previous, &heights[neighbour], sizeof(previous));
+            }
+
+            uint32_t bits = residuals[i] ^ previous;
+            std::memcpy(&heights[i], &bits, sizeof(bits));
+        }
+
+        if (biomeIDs)
+        {
+            biomeIDs->clear();
+            if (header.Flags & RECORD_HAS_BIOMES)
+            {
+                biomeIDs->resize(count);
+                if (!SM::Compression::DecompressLZ4(heightBlock + header.HeightBytes, header.BiomeBytes,
+                        biomeIDs->data(), biomeIDs->size()))
+                {
+                    return false;
+                }
+            }
+        }
+
+        minHeight = header.MinHeight;
+        maxHeight = header.MaxHeight;
+        return true;
+    }
+
+} // namespace PCG
@@ -0,0 +1,206 @@
+#pragma once
+
+/**
+ * @file ChunkCache.h
+ * @brief Persistent on-disk cache of generated chunk heights
+ *
+ * Chunks are grouped into region files of REGION_SIZE x REGION_SIZE chunks
+ * under a directory named after the generation settings, so changing the
+ * seed or noise parameters never reads stale terrain. Region files are
+ * memory-mapped for reading; new records are appended in batches by Flush.
+ *
+ * Heights are stored losslessly (XOR against the neighbouring sample,
+ * byte-plane shuffled, LZ4 block compressed), so a cached chunk is
+ * bit-identical to a regenerated one and never seams against it.
+ */
+
+#include "pcg/Chunk.h"
+#include "pcg/HeightmapGenerator.h"
+#include "core/FileSystem.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace PCG
+{
+    /**
+     * @brief Cache activity counters
+     */
+    struct ChunkCacheStats
+    {
+        uint32_t Hits = 0;              ///< Chunks loaded from disk
+        uint32_t Misses = 0;            ///< Lookups that found no record
+        uint32_t Stores = 0;            ///< Chunks written to disk
+        uint64_t BytesRead = 0;         ///< Compressed record bytes decoded
+        uint64_t BytesWritten = 0;      ///< Compressed record bytes appended
+        uint32_t OpenRegions = 0;       ///< Region files currently mapped
+    };
+
+    /**
+     * @brief Region-file chunk height cache
+     *
+     * Not thread-safe; use from the thread that owns the ChunkManager.
+     */
+    class ChunkCache
+    {
+    public:
+        static constexpr int REGION_SIZE = 16;                         ///< Chunks per region side
+        static constexpr int REGION_CHUNKS = REGION_SIZE * REGION_SIZE;
+        static constexpr size_t MAX_OPEN_REGIONS = 16;                 ///< Mapped regions kept open
+
+        ChunkCache() = default;
+        ~ChunkCache();
+
+        // Prevent copying
+        ChunkCache(const ChunkCache&) = delete;
+        ChunkCache& operator=(const ChunkCache&) = delete;
+
+        // ====================================================================
+        // Initialization
+        // ====================================================================
+
+        /**
+         * @brief Open (or create) the cache for one set of generation settings
+         * @param rootPath Cache root directory
+         * @param settingsKey Key from ComputeSettingsKey
+         * @return true if the cache directory is usable
+         */
+        bool Initialize(const std::string& rootPath, uint64_t settingsKey);
+
+        /**
+         * @brief Flush pending records and close all regions
+         */
+        void Shutdown();
+
+        /**
+         * @brief Check if the cache is open
+         */
+        bool IsInitialized() const { return !m_Directory.empty(); }
+
+        /**
+         * @brief Hash every setting that affects chunk heights
+         * @param settings Terrain settings (including the seed)
+         * @param generatorId Distinguishes generators that may round differently (e.g. CPU vs GPU)
+         * @return 64-bit FNV-1a key
+         */
+        static uint64_t ComputeSettingsKey(const HeightmapSettings& settings, uint32_t generatorId);
+
+        // ====================================================================
+        // Records
+        // ====================================================================
+
+        /**
+         * @brief Load a cached chunk
+         * @param coord Chunk coordinate
+         * @param heights Receives Chunk::VERTEX_COUNT heights
+         * @param minHeight Receives the stored minimum height
+         * @param maxHeight Receives the stored maximum height
+         * @param biomeIDs Optional; receives per-vertex biome IDs, or is cleared if none were stored
+         * @return false on a miss or a corrupt record
+         */
+        bool Load(const ChunkCoord& coord, std::vector<float>& heights, float& minHeight, float& maxHeight,
+                  std::vector<uint8_t>* biomeIDs = nullptr);
+
+        /**
+         * @brief Check if a chunk has a record (written or pending)
+         */
+        bool Contains(const ChunkCoord& coord);
+
+        /**
+         * @brief Queue a chunk for writing (ignored if already cached)
+         * @param coord Chunk coordinate
+         * @param heights Chunk::VERTEX_COUNT heights
+         * @param minHeight Minimum height
+         * @param maxHeight Maximum height
+         * @param biomeIDs Optional per-vertex biome IDs (Chunk::VERTEX_COUNT entries)
+         */
+        void Store(const ChunkCoord& coord, const std::vector<float>& heights, float minHeight, float maxHeight,
+                   const std::vector<uint8_t>* biomeIDs = nullptr);
+
+        /**
+         * @brief Append every queued record to its region file
+         */
+        void Flush();
+
+        /**
+         * @brief Get cache activity counters
+         */
+        const ChunkCacheStats& GetStats() const { return m_Stats; }
+
+    private:
+        struct RegionEntry
+        {
+            uint32_t Offset = 0;    ///< Record offset in the file (0 = absent)
+            uint32_t Size = 0;      ///< Record size in bytes
+        };
+
+        struct RegionHeader
+        {
+            uint32_t Magic = 0;
+            uint32_t Version = 0;
+            uint64_t SettingsKey = 0;
+            int32_t RegionX = 0;
+            int32_t RegionZ = 0;
+            uint32_t Reserved[2] = {};
+            RegionEntry Entries[REGION_CHUNKS];
+        };
+
+        struct RecordHeader
+        {
+            uint32_t VerticesPerSide = 0;
+            uint32_t Flags = 0;             ///< RECORD_HAS_BIOMES
+            float MinHeight = 0.0f;
+            float MaxHeight = 0.0f;
+            uint32_t HeightBytes = 0;       ///< Compressed height block size
+            uint32_t BiomeBytes = 0;        ///< Compressed biome block size
+        };
+
+        struct PendingRecord
+        {
+            uint32_t Index = 0;
+            std::vector<uint8_t> Bytes;     ///< RecordHeader followed by the compressed blocks
+        };
+
+        struct Region
+        {
+            ChunkCoord Coord;
+            SM::MappedFile File;
+            RegionHeader Header;
+            bool OnDisk = false;            ///< File exists with a valid header
+            uint64_t LastUse = 0;
+            std::vector<PendingRecord> Pending;
+        };
+
+        static constexpr uint32_t REGION_MAGIC = 0x43524D53;   ///< "SMRC"
+        static constexpr uint32_t REGION_VERSION = 1;
+        static constexpr uint32_t RECORD_HAS_BIOMES = 1u << 0;
+
+        static ChunkCoord ToRegionCoord(const ChunkCoord& coord);
+        static uint32_t ToRegionIndex(const ChunkCoord& coord);
+
+        std::string GetRegionPath(const ChunkCoord& regionCoord) const;
+        Region& AcquireRegion(const ChunkCoord& regionCoord);
+        void OpenRegion(Region& region);
+        bool FlushRegion(Region& region);
+
+        static void EncodeRecord(const std::vector<float>& heights, float minHeight, float maxHeight,
+                                 const std::vector<uint8_t>* biomeIDs, std::vector<uint8_t>& bytes);
+        bool DecodeRecord(const uint8_t* data, size_t size, std::vector<float>& heights,
+                          float& minHeight, float& maxHeight, std::vector<uint8_t>* biomeIDs);
+
+    private:
+        std::string m_Directory;
+        uint64_t m_SettingsKey = 0;
+        uint64_t m_UseCounter = 0;
+
+        std::unordered_map<ChunkCoord, std::unique_ptr<Region>, ChunkHash> m_Regions;
+
+        std::vector<uint8_t> m_Scratch;     ///< Reused decode buffer
+
+        ChunkCacheStats m_Stats;
+    };
+
+} // namespace PCG
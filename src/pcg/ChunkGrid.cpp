@@ -0,0 +1,54 @@
+#include "pcg/ChunkGrid.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace PCG
+{
+    void ChunkGrid::Initialize(int radius)
+    {
+        m_Radius = std::max(radius, 0);
+        m_Side = static_cast<int>(std::bit_ceil(static_cast<unsigned>(2 * m_Radius + 1)));
+        m_Mask = m_Side - 1;
+
+        m_Slots.assign(static_cast<size_t>(m_Side) * static_cast<size_t>(m_Side), Slot());
+    }
+
+    void ChunkGrid::Rebuild(const ChunkCoord& centre, const ChunkMap& chunks)
+    {
+        Clear();
+        m_Centre = centre;
+
+        for (const auto& pair : chunks)
+        {
+            Insert(pair.first, pair.second.get());
+        }
+    }
+
+    void ChunkGrid::Insert(const ChunkCoord& coord, Chunk* chunk)
+    {
+        if (!InWindow(coord))
+        {
+            return;
+        }
+
+        Slot& slot = m_Slots[GetSlotIndex(coord)];
+        slot.Coord = coord;
+        slot.Pointer = chunk;
+    }
+
+    void ChunkGrid::Remove(const ChunkCoord& coord)
+    {
+        Slot& slot = m_Slots[GetSlotIndex(coord)];
+        if (slot.Coord == coord)
+        {
+            slot.Pointer = nullptr;
+        }
+    }
+
+    void ChunkGrid::Clear()
+    {
+        std::fill(m_Slots.begin(), m_Slots.end(), Slot());
+    }
+
+} // namespace PCG
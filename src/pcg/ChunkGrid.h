@@ -0,0 +1,116 @@
+#pragma once
+
+/**
+ * @file ChunkGrid.h
+ * @brief Toroidal 2D index of the loaded chunks around the camera
+ *
+ * A power-of-two square of slots wraps around the world: chunk (x, z) lives
+ * in slot (x & mask, z & mask). Lookups inside the window around the centre
+ * are a mask, a multiply and a tag compare, and vertically adjacent chunks
+ * are one row apart in memory. The grid does not own chunks; the chunk map
+ * does, and remains the fallback for chunks outside the window.
+ */
+
+#include "pcg/Chunk.h"
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace PCG
+{
+    /// Owning chunk storage indexed by ChunkGrid
+    using ChunkMap = std::unordered_map<ChunkCoord, std::unique_ptr<Chunk>, ChunkHash>;
+
+    /**
+     * @brief Camera-centred ring-buffer grid of chunk pointers
+     */
+    class ChunkGrid
+    {
+    public:
+        ChunkGrid() = default;
+
+        /**
+         * @brief Size the window
+         * @param radius Chunks on each side of the centre that must be indexed
+         *
+         * Clears every slot; call Rebuild afterwards.
+         */
+        void Initialize(int radius);
+
+        /**
+         * @brief Move the window and re-index every chunk inside it
+         * @param centre New centre chunk
+         * @param chunks Owning chunk map
+         *
+         * O(slots + chunks); only needed when the centre changes chunk.
+         */
+        void Rebuild(const ChunkCoord& centre, const ChunkMap& chunks);
+
+        /**
+         * @brief Check if a coordinate is inside the window (the grid is authoritative there)
+         */
+        bool InWindow(const ChunkCoord& coord) const
+        {
+            return m_Radius >= 0 &&
+                   coord.X >= m_Centre.X - m_Radius && coord.X <= m_Centre.X + m_Radius &&
+                   coord.Z >= m_Centre.Z - m_Radius && coord.Z <= m_Centre.Z + m_Radius;
+        }
+
+        /**
+         * @brief Get a chunk inside the window
+         * @return The chunk, or nullptr if not loaded; only meaningful when InWindow(coord)
+         */
+        Chunk* Find(const ChunkCoord& coord) const
+        {
+            const Slot& slot = m_Slots[GetSlotIndex(coord)];
+            return slot.Coord == coord ? slot.Pointer : nullptr;
+        }
+
+        /**
+         * @brief Index a newly loaded chunk (ignored outside the window)
+         */
+        void Insert(const ChunkCoord& coord, Chunk* chunk);
+
+        /**
+         * @brief Drop an unloaded chunk from the index
+         */
+        void Remove(const ChunkCoord& coord);
+
+        /**
+         * @brief Empty every slot
+         */
+        void Clear();
+
+        /**
+         * @brief Get the current window centre
+         */
+        const ChunkCoord& GetCentre() const { return m_Centre; }
+
+        /**
+         * @brief Get the window radius in chunks (-1 before Initialize)
+         */
+        int GetRadius() const { return m_Radius; }
+
+    private:
+        struct Slot
+        {
+            ChunkCoord Coord;           ///< Tag: which of the aliasing chunks is stored
+            Chunk* Pointer = nullptr;
+        };
+
+        size_t GetSlotIndex(const ChunkCoord& coord) const
+        {
+            // Two's-complement masking wraps negative coordinates correctly
+            return static_cast<size_t>(coord.Z & m_Mask) * m_Side + static_cast<size_t>(coord.X & m_Mask);
+        }
+
+    private:
+        std::vector<Slot> m_Slots = std::vector<Slot>(1);
+        ChunkCoord m_Centre;
+        int m_Radius = -1;
+        int m_Side = 1;     ///< Power of two >= 2 * radius + 1
+        int m_Mask = 0;
+    };
+
+} // namespace PCG
@@ -0,0 +1,100 @@
+#include "pcg/ChunkHeightLRU.h"
+
+#include <iterator>
+
+namespace PCG
+{
+    void ChunkHeightLRU::SetBudget(size_t budgetBytes)
+    {
+        m_Budget = budgetBytes;
+        EvictToBudget();
+    }
+
+    void ChunkHeightLRU::Insert(const ChunkCoord& coord, std::vector<float>&& heights, float minHeight, float maxHeight)
+    {
+        if (!IsEnabled() || heights.empty())
+        {
+            return;
+        }
+
+        auto existing = m_Lookup.find(coord);
+        if (existing != m_Lookup.end())
+        {
+            Erase(existing->second);
+        }
+
+        Entry entry;
+        entry.Coord = coord;
+        entry.Heights = std::move(heights);
+        entry.MinHeight = minHeight;
+        entry.MaxHeight = maxHeight;
+
+        m_Stats.Bytes += GetEntryBytes(entry);
+        m_Stats.Entries++;
+
+        m_Entries.push_front(std::move(entry));
+        m_Lookup[coord] = m_Entries.begin();
+
+        EvictToBudget();
+    }
+
+    bool ChunkHeightLRU::Take(const ChunkCoord& coord, std::vector<float>& heights, float& minHeight, float& maxHeight)
+    {
+        if (!IsEnabled())
+        {
+            return false;
+        }
+
+        auto it = m_Lookup.find(coord);
+        if (it == m_Lookup.end())
+        {
+            m_Stats.Misses++;
+            return false;
+        }
+
+        EntryList::iterator entry = it->second;
+        m_Stats.Bytes -= GetEntryBytes(*entry);
+        m_Stats.Entries--;
+
+        heights = std::move(entry->Heights);
+        minHeight = entry->MinHeight;
+        maxHeight = entry->MaxHeight;
+
+        m_Lookup.erase(it);
+        m_Entries.erase(entry);
+
+        m_Stats.Hits++;
+        return true;
+    }
+
+    void ChunkHeightLRU::Clear()
+    {
+        m_Entries.clear();
+        m_Lookup.clear();
+        m_Stats.Entries = 0;
+        m_Stats.Bytes = 0;
+    }
+
+    size_t ChunkHeightLRU::GetEntryBytes(const Entry& entry)
+    {
+        return sizeof(Entry) + entry.Heights.capacity() * sizeof(float);
+    }
+
+    void ChunkHeightLRU::Erase(EntryList::iterator it)
+    {
+        m_Stats.Bytes -= GetEntryBytes(*it);
+        m_Stats.Entries--;
+        m_Lookup.erase(it->Coord);
+        m_Entries.erase(it);
+    }
+
+    void ChunkHeightLRU::EvictToBudget()
+    {
+        while (!m_Entries.empty() && m_Stats.Bytes > m_Budget)
+        {
+            Erase(std::prev(m_Entries.end()));
+            m_Stats.Evictions++;
+        }
+    }
+
+} // namespace PCG
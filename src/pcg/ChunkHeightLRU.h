@@ -0,0 +1,125 @@
+#pragma once
+
+/**
+ * @file ChunkHeightLRU.h
+ * @brief Bounded in-memory cache of unloaded chunk heightfields
+ *
+ * Unloading a chunk drops its GPU mesh but parks its height grid here, so
+ * walking back over recently visited terrain rebuilds meshes without
+ * evaluating any noise. The least recently unloaded grids are evicted once
+ * the memory budget is exceeded.
+ */
+
+#include "pcg/Chunk.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace PCG
+{
+    /**
+     * @brief Height LRU counters
+     */
+    struct ChunkHeightLRUStats
+    {
+        uint32_t Hits = 0;          ///< Lookups that returned a heightfield
+        uint32_t Misses = 0;        ///< Lookups that found nothing
+        uint32_t Evictions = 0;     ///< Heightfields dropped to stay within budget
+        uint32_t Entries = 0;       ///< Heightfields currently held
+        size_t Bytes = 0;           ///< Memory held by those heightfields
+
+        /**
+         * @brief Fraction of lookups that hit (0 before the first lookup)
+         */
+        float GetHitRate() const
+        {
+            uint32_t lookups = Hits + Misses;
+            return lookups > 0 ? static_cast<float>(Hits) / static_cast<float>(lookups) : 0.0f;
+        }
+    };
+
+    /**
+     * @brief Least-recently-used store of chunk height grids
+     *
+     * Not thread-safe; use from the thread that owns the ChunkManager.
+     */
+    class ChunkHeightLRU
+    {
+    public:
+        ChunkHeightLRU() = default;
+
+        // Prevent copying
+        ChunkHeightLRU(const ChunkHeightLRU&) = delete;
+        ChunkHeightLRU& operator=(const ChunkHeightLRU&) = delete;
+
+        /**
+         * @brief Set the memory budget, evicting immediately if over it
+         * @param budgetBytes Maximum bytes of height data held (0 disables the cache)
+         */
+        void SetBudget(size_t budgetBytes);
+
+        /**
+         * @brief Get the memory budget in bytes
+         */
+        size_t GetBudget() const { return m_Budget; }
+
+        /**
+         * @brief Check if the cache can hold anything
+         */
+        bool IsEnabled() const { return m_Budget > 0; }
+
+        /**
+         * @brief Park a heightfield, replacing any older one for the same chunk
+         * @param coord Chunk coordinate
+         * @param heights Height grid (moved from)
+         * @param minHeight Minimum height
+         * @param maxHeight Maximum height
+         */
+        void Insert(const ChunkCoord& coord, std::vector<float>&& heights, float minHeight, float maxHeight);
+
+        /**
+         * @brief Remove and return a parked heightfield
+         * @param coord Chunk coordinate
+         * @param heights Receives the height grid on a hit
+         * @param minHeight Receives the minimum height on a hit
+         * @param maxHeight Receives the maximum height on a hit
+         * @return true on a hit
+         */
+        bool Take(const ChunkCoord& coord, std::vector<float>& heights, float& minHeight, float& maxHeight);
+
+        /**
+         * @brief Drop every heightfield (counters are kept)
+         */
+        void Clear();
+
+        /**
+         * @brief Get cache counters
+         */
+        const ChunkHeightLRUStats& GetStats() const { return m_Stats; }
+
+    private:
+        struct Entry
+        {
+            ChunkCoord Coord;
+            std::vector<float> Heights;
+            float MinHeight = 0.0f;
+            float MaxHeight = 0.0f;
+        };
+
+        using EntryList = std::list<Entry>;
+
+        static size_t GetEntryBytes(const Entry& entry);
+        void Erase(EntryList::iterator it);
+        void EvictToBudget();
+
+    private:
+        size_t m_Budget = 0;
+        EntryList m_Entries;    ///< Most recently inserted at the front
+        std::unordered_map<ChunkCoord, EntryList::iterator, ChunkHash> m_Lookup;
+        ChunkHeightLRUStats m_Stats;
+    };
+
+} // namespace PCG
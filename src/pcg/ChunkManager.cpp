@@ -1,34 +1,120 @@
 #include "pcg/ChunkManager.h"
 #include "renderer/DX12Core.h"
+#include "renderer/GPUHeightmapGenerator.h"
+#include "core/JobSystem.h"
+#include "core/Profiler.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <iostream>
+#include <limits>
 
 namespace PCG
 {
+    namespace
+    {
+        /**
+         * @brief Row span of a streaming disc at world row z (empty when minX > maxX)
+         */
+        void DiscRowSpan(const std::vector<int>& halfWidths, const ChunkCoord& centre, int z, int& minX, int& maxX)
+        {
+            const int radius = static_cast<int>(halfWidths.size() / 2);
+            const int dz = z - centre.Z;
+            const int halfWidth = (dz >= -radius && dz <= radius) ? halfWidths[dz + radius] : -1;
+            minX = centre.X - halfWidth;
+            maxX = centre.X + halfWidth;
+        }
+
+        /**
+         * @brief Visit the cells of [minA, maxA] outside [minB, maxB]
+         */
+        template<typename Visit>
+        void ForEachSpanDifference(int minA, int maxA, int minB, int maxB, Visit&& visit)
+        {
+            if (minB > maxB)
+            {
+                for (int x = minA; x <= maxA; ++x) visit(x);
+                return;
+            }
+            for (int x = minA; x <= std::min(maxA, minB - 1); ++x) visit(x);
+            for (int x = std::max(minA, maxB + 1); x <= maxA; ++x) visit(x);
+        }
+
+        /**
+         * @brief Row half-widths of a disc of chunks around the centre chunk (-1 = empty row)
+         */
+        void BuildDiscHalfWidths(float radiusInChunks, std::vector<int>& halfWidths)
+        {
+            const int radius = static_cast<int>(std::floor(radiusInChunks));
+
+            halfWidths.assign(static_cast<size_t>(2 * radius + 1), -1);
+            for (int dz = -radius; dz <= radius; ++dz)
+            {
+                float remaining = radiusInChunks * radiusInChunks - static_cast<float>(dz * dz);
+                halfWidths[dz + radius] = remaining >= 0.0f ? static_cast<int>(std::floor(std::sqrt(remaining))) : -1;
+            }
+        }
+
+        bool IsInDisc(const std::vector<int>& halfWidths, const ChunkCoord& centre, const ChunkCoord& coord)
+        {
+            int minX, maxX;
+            DiscRowSpan(halfWidths, centre, coord.Z, minX, maxX);
+            return coord.X >= minX && coord.X <= maxX;
+        }
+
+        /**
+         * @brief Visit the cells of the disc around a outside the disc around b (the whole disc when b is null)
+         */
+        template<typename Visit>
+        void ForEachDiscDifference(const std::vector<int>& halfWidths, const ChunkCoord& a, const ChunkCoord* b, Visit&& visit)
+        {
+            const int radius = static_cast<int>(halfWidths.size() / 2);
+            for (int z = a.Z - radius; z <= a.Z + radius; ++z)
+            {
+                int minA, maxA;
+                int minB = 0, maxB = -1;
+                DiscRowSpan(halfWidths, a, z, minA, maxA);
+                if (b)
+                {
+                    DiscRowSpan(halfWidths, *b, z, minB, maxB);
+                }
+
+                ForEachSpanDifference(minA, maxA, minB, maxB, [&](int x) { visit(ChunkCoord(x, z)); });
+            }
+        }
+    }
+
     ChunkManager::ChunkManager()
         : m_LastCameraChunk(INT_MAX, INT_MAX)
     {
     }
 
+    ChunkManager::~ChunkManager()
+    {
+        // Workers call back into CreateChunk, so stop them before members go away
+        m_WorkerPool.Stop();
+    }
+
     // ============================================================================
     // Initialization
     // ============================================================================
 
     bool ChunkManager::Initialize(SM::DX12Core* core, const ChunkManagerConfig& config)
     {
+        m_Core = core;
+        m_Config = config;
+
+        // Without a device chunks stream and generate as usual but never get a mesh
         if (!core)
         {
-            std::cerr << "[ChunkManager] Cannot initialize: DX12Core is null" << std::endl;
-            return false;
+            std::cout << "[ChunkManager] No DX12Core, running headless (no meshes)" << std::endl;
+            m_Config.GPUGeneration = false;
         }
 
-        m_Core = core;
-        m_Config = config;
-
         // Setup LOD system
         m_LOD.SetupDefault(config.ViewDistance, 5);
+        ResizeChunkGrid();
 
         // Initialize terrain settings if not set
         if (m_Config.TerrainSettings.Width == 0)
@@ -38,6 +124,76 @@ namespace PCG
             m_Config.TerrainSettings.MaxHeight = 50.0f;
         }
 
+        // Terrain FBM specialized for Perlin noise (shared by all workers; sampling is const)
+        m_TerrainKernel = std::make_unique<FBMPresets::TerrainKernel>(
+            m_Config.TerrainSettings.Seed, m_Config.TerrainSettings.Noise);
+
+        // Biome fields use the same noise and seeds as BiomeGenerator, offset from the terrain seed
+        if (m_Config.ChunkBiomes)
+        {
+            const BiomeGenerator::Settings& biome = m_Config.BiomeSettings;
+
+            FBMSettings moisture;
+            moisture.Frequency = biome.MoistureFrequency;
+            moisture.Octaves = biome.MoistureOctaves;
+            moisture.Persistence = 0.5f;
+            m_MoistureKernel = std::make_unique<FBMKernel<SimplexNoise, FBMMode::Standard>>(
+                m_Config.TerrainSettings.Seed + 100, moisture);
+
+            FBMSettings temperature;
+            temperature.Frequency = biome.TemperatureFrequency;
+            temperature.Octaves = biome.TemperatureOctaves;
+            temperature.Persistence = 0.4f;
+            m_TemperatureKernel = std::make_unique<FBMKernel<PerlinNoise, FBMMode::Standard>>(
+                m_Config.TerrainSettings.Seed + 200, temperature);
+        }
+
+        // Compute-shader height generation (falls back to the CPU kernel on failure)
+        if (m_Config.GPUGeneration)
+        {
+            m_GPUGenerator = std::make_unique<GPUHeightmapGenerator>();
+            const uint32_t verticesPerSide = static_cast<uint32_t>(Chunk::SIZE + 1);
+
+            if (!m_GPUGenerator->Initialize(core) ||
+                !m_GPUGenerator->ReserveScratchTexture(verticesPerSide, verticesPerSide))
+            {
+                std::cerr << "[ChunkManager] Failed to initialize GPU generation, using CPU generation" << std::endl;
+                m_GPUGenerator.reset();
+                m_Config.GPUGeneration = false;
+            }
+        }
+
+        // Main-thread streaming runs against a frame-time budget
+        m_Scheduler.Configure(m_Config.StreamingBudgetMs, m_Config.TargetFrameTimeMs);
+
+        // Recently unloaded heightfields stay in RAM up to the budget
+        m_HeightLRU.SetBudget(m_Config.HeightLRUBudget);
+
+        // Persistent height cache, keyed by everything that changes generated heights
+        if (m_Config.DiskCache)
+        {
+            uint64_t settingsKey = ChunkCache::ComputeSettingsKey(m_Config.TerrainSettings,
+                m_Config.GPUGeneration ? 1u : 0u);
+
+            if (!m_DiskCache.Initialize(m_Config.DiskCachePath, settingsKey))
+            {
+                std::cerr << "[ChunkManager] Failed to open disk cache, generating every chunk" << std::endl;
+                m_Config.DiskCache = false;
+            }
+        }
+
+        // Generate heights off the main thread on job system workers
+        if (m_Config.AsyncGeneration)
+        {
+            bool started = m_WorkerPool.Start([this](const ChunkCoord& coord) { return CreateChunk(coord); });
+
+            if (!started)
+            {
+                std::cerr << "[ChunkManager] Failed to start async generation, falling back to synchronous generation" << std::endl;
+                m_Config.AsyncGeneration = false;
+            }
+        }
+
         m_Initialized = true;
 
         std::cout << "[ChunkManager] Initialized with view distance: " << config.ViewDistance << std::endl;
@@ -47,12 +203,35 @@ namespace PCG
 
     void ChunkManager::Shutdown()
     {
+        // Stop workers first so no chunk is handed back during teardown
+        m_WorkerPool.Stop();
+        m_InFlight.clear();
+        m_CompletedJobs.clear();
+
+        m_GPUGenerator.reset();
+
+        // Persist everything still loaded before dropping it
+        for (const auto& pair : m_Chunks)
+        {
+            StoreCachedChunk(*pair.second);
+        }
+        m_DiskCache.Shutdown();
+
         // Clear all chunks
+        m_ChunkGrid.Clear();
         m_Chunks.clear();
+        m_HeightLRU.Clear();
 
         // Clear queues
-        while (!m_PendingGeneration.empty()) m_PendingGeneration.pop();
+        m_PendingGeneration.clear();
+        m_QueuedGeneration.clear();
+        m_StreamingRingValid = false;
         while (!m_PendingMeshBuild.empty()) m_PendingMeshBuild.pop();
+        m_PendingUploads.clear();
+        m_DirtyChunks.clear();
+
+        m_Observers.clear();
+        m_ObserverRefs.clear();
 
         m_VisibleChunks.clear();
         m_Initialized = false;
@@ -66,15 +245,54 @@ namespace PCG
     // ============================================================================
 
     void ChunkManager::Update(const DirectX::XMFLOAT3& cameraPosition)
+    {
+        m_HasFrustum = false;
+        m_CameraVelocity = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
+        UpdateChunks(cameraPosition);
+    }
+
+    void ChunkManager::Update(const DirectX::XMFLOAT3& cameraPosition, const DirectX::XMMATRIX& viewProjection)
+    {
+        Update(cameraPosition, viewProjection, DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f));
+    }
+
+    void ChunkManager::Update(const DirectX::XMFLOAT3& cameraPosition, const DirectX::XMMATRIX& viewProjection,
+                              const DirectX::XMFLOAT3& cameraVelocity)
+    {
+        m_Frustum = SM::Frustum(viewProjection);
+        m_HasFrustum = true;
+        m_CameraVelocity = cameraVelocity;
+        UpdateChunks(cameraPosition);
+    }
+
+    void ChunkManager::UpdateChunks(const DirectX::XMFLOAT3& cameraPosition)
     {
         if (!m_Initialized)
         {
             return;
         }
 
+        SM_PROFILE_SCOPE("ChunkManager::UpdateChunks");
+
+        m_LastCameraPosition = cameraPosition;
+        m_Scheduler.BeginFrame(m_LastFrameSeconds);
+
+        // Re-centre the lookup grid when the camera enters a new chunk
+        ChunkCoord cameraChunk = WorldToChunkCoord(cameraPosition.x, cameraPosition.z);
+        if (cameraChunk != m_ChunkGrid.GetCentre())
+        {
+            m_ChunkGrid.Rebuild(cameraChunk, m_Chunks);
+        }
+
         // Determine which chunks should be loaded
         DetermineVisibleChunks(cameraPosition);
 
+        // Queue and reference chunks around the other observers
+        UpdateObservers();
+
+        // Queue chunks the camera is heading towards
+        PrefetchAlongPath();
+
         // Process pending generations (limited per frame)
         ProcessPendingGenerations();
 
@@ -84,14 +302,20 @@ namespace PCG
         // Update LOD levels for existing chunks
         UpdateChunkLODs(cameraPosition);
 
+        // Upload the mesh rows edits have changed
+        ProcessDirtyChunks();
+
+        // Swap in meshes the copy queue has finished (the renderer submits the copies)
+        ProcessMeshUploads();
+
         // Unload chunks that are too far away
-        UnloadDistantChunks(cameraPosition);
+        UnloadDistantChunks();
 
         // Update visible chunks list for rendering
         UpdateVisibleChunksList();
 
         // Update last camera chunk
-        m_LastCameraChunk = WorldToChunkCoord(cameraPosition.x, cameraPosition.z);
+        m_LastCameraChunk = cameraChunk;
     }
 
     void ChunkManager::ForceLoadAround(const DirectX::XMFLOAT3& position, float radius)
@@ -112,235 +336,1331 @@ namespace PCG
                 ChunkCoord coord(centerChunk.X + x, centerChunk.Z + z);
 
                 // Check if already loaded
-                if (m_Chunks.find(coord) != m_Chunks.end())
+                if (GetChunk(coord))
                 {
                     continue;
                 }
 
-                // Create and generate immediately
-                auto chunk = CreateChunk(coord);
+                // Load from the disk cache or generate immediately
+                auto chunk = LoadCachedChunk(coord);
+                if (!chunk)
+                {
+                    chunk = CreateChunk(coord);
+                    m_GeneratedChunks++;
+                }
+
                 if (chunk)
                 {
-                    chunk->BuildMesh(m_Core);
-                    m_Chunks[coord] = std::move(chunk);
+                    BuildChunkMesh(coord, *chunk);
+                    AddChunk(coord, std::move(chunk));
                 }
             }
         }
 
+        // Callers expect the area to be drawable right away
+        if (m_Core)
+        {
+            m_Core->GetUploadQueue().WaitForIdle();
+            ProcessMeshUploads();
+        }
+
         UpdateVisibleChunksList();
     }
 
-    // ============================================================================
-    // Configuration
-    // ============================================================================
-
-    void ChunkManager::SetViewDistance(float distance)
+    uint32_t ChunkManager::BakeRegion(const ChunkCoord& first, const ChunkCoord& last)
     {
-        m_Config.ViewDistance = distance;
-        m_Config.UnloadDistance = distance * 1.2f; // 20% buffer
+        if (!m_Initialized || !m_DiskCache.IsInitialized())
+        {
+            std::cerr << "[ChunkManager] BakeRegion needs the disk cache" << std::endl;
+            return 0;
+        }
 
-        // Update LOD system
-        m_LOD.SetupDefault(distance, 5);
-    }
+        const int minX = std::min(first.X, last.X);
+        const int maxX = std::max(first.X, last.X);
+        const int minZ = std::min(first.Z, last.Z);
+        const int maxZ = std::max(first.Z, last.Z);
 
-    void ChunkManager::SetLODDistances(const std::vector<float>& distances)
-    {
-        m_LOD.SetDistances(distances);
-    }
+        constexpr int regionSize = ChunkCache::REGION_SIZE;
+        auto toRegion = [](int chunk) {
+            return chunk >= 0 ? chunk / regionSize : -((-chunk + regionSize - 1) / regionSize);
+        };
 
-    // ============================================================================
-    // Terrain Queries
-    // ============================================================================
+        SM::JobSystem& jobs = SM::JobSystem::Get();
+        std::vector<ChunkCoord> coords;
+        std::vector<std::unique_ptr<Chunk>> chunks;
+        uint32_t baked = 0;
 
-    float ChunkManager::GetHeightAt(float worldX, float worldZ) const
-    {
-        const Chunk* chunk = GetChunkAt(worldX, worldZ);
-        if (!chunk || !chunk->IsGenerated())
+        // One region per batch bounds memory and writes each region file once
+        for (int regionZ = toRegion(minZ); regionZ <= toRegion(maxZ); ++regionZ)
         {
-            return 0.0f;
-        }
+            for (int regionX = toRegion(minX); regionX <= toRegion(maxX); ++regionX)
+            {
+                coords.clear();
+                for (int z = std::max(minZ, regionZ * regionSize); z <= std::min(maxZ, regionZ * regionSize + regionSize - 1); ++z)
+                {
+                    for (int x = std::max(minX, regionX * regionSize); x <= std::min(maxX, regionX * regionSize + regionSize - 1); ++x)
+                    {
+                        ChunkCoord coord(x, z);
+                        if (!m_DiskCache.Contains(coord))
+                        {
+                            coords.push_back(coord);
+                        }
+                    }
+                }
 
-        // Convert to local coordinates
-        float chunkSize = Chunk::GetWorldSize();
-        float localX = std::fmod(worldX, chunkSize);
-        float localZ = std::fmod(worldZ, chunkSize);
+                if (coords.empty())
+                {
+                    continue;
+                }
+
+                // CreateChunk is worker-safe; the cache is not, so stores stay on this thread
+                chunks.clear();
+                chunks.resize(coords.size());
+                auto generate = [&](uint32_t begin, uint32_t end) {
+                    for (uint32_t i = begin; i < end; ++i)
+                    {
+                        chunks[i] = CreateChunk(coords[i]);
+                    }
+                };
+
+                const uint32_t count = static_cast<uint32_t>(coords.size());
+                if (jobs.IsInitialized())
+                {
+                    jobs.ParallelFor(count, 1, generate);
+                }
+                else
+                {
+                    generate(0, count);
+                }
 
-        // Handle negative coordinates
-        if (localX < 0.0f) localX += chunkSize;
-        if (localZ < 0.0f) localZ += chunkSize;
+                for (const auto& chunk : chunks)
+                {
+                    if (chunk && chunk->IsGenerated())
+                    {
+                        StoreCachedChunk(*chunk);
+                        m_GeneratedChunks++;
+                        baked++;
+                    }
+                }
 
-        // Convert to vertex coordinates
-        float vertexX = localX / Chunk::SCALE;
-        float vertexZ = localZ / Chunk::SCALE;
+                m_DiskCache.Flush();
+            }
+        }
 
-        return chunk->GetHeightInterpolated(vertexX, vertexZ);
+        return baked;
     }
 
-    Chunk* ChunkManager::GetChunkAt(float worldX, float worldZ)
+    // ============================================================================
+    // Observers
+    // ============================================================================
+
+    ChunkObserverId ChunkManager::AddObserver(const ChunkObserver& observer)
     {
-        ChunkCoord coord = WorldToChunkCoord(worldX, worldZ);
-        return GetChunk(coord);
+        const ChunkObserverId id = m_NextObserverId++;
+
+        ObserverState& state = m_Observers[id];
+        state.Observer = observer;
+        BuildObserverDiscs(state.Observer, state.WantHalfWidths, state.KeepHalfWidths);
+
+        return id;
     }
 
-    const Chunk* ChunkManager::GetChunkAt(float worldX, float worldZ) const
+    bool ChunkManager::SetObserver(ChunkObserverId id, const ChunkObserver& observer)
     {
-        ChunkCoord coord = WorldToChunkCoord(worldX, worldZ);
-        return GetChunk(coord);
+        auto it = m_Observers.find(id);
+        if (it == m_Observers.end())
+        {
+            return false;
+        }
+
+        // A new radius means new discs; drop the old ones and place the new ones next update
+        if (observer.Radius != it->second.Observer.Radius)
+        {
+            ReleaseObserver(id);
+            BuildObserverDiscs(observer, it->second.WantHalfWidths, it->second.KeepHalfWidths);
+        }
+
+        it->second.Observer = observer;
+        m_ObserversChanged = true;
+        return true;
     }
 
-    Chunk* ChunkManager::GetChunk(const ChunkCoord& coord)
+    bool ChunkManager::SetObserverPosition(ChunkObserverId id, const DirectX::XMFLOAT3& position)
     {
-        auto it = m_Chunks.find(coord);
-        if (it != m_Chunks.end())
+        auto it = m_Observers.find(id);
+        if (it == m_Observers.end())
         {
-            return it->second.get();
+            return false;
         }
-        return nullptr;
+
+        it->second.Observer.Position = position;
+        return true;
     }
 
-    const Chunk* ChunkManager::GetChunk(const ChunkCoord& coord) const
+    void ChunkManager::RemoveObserver(ChunkObserverId id)
     {
-        auto it = m_Chunks.find(coord);
-        if (it != m_Chunks.end())
+        if (m_Observers.find(id) == m_Observers.end())
         {
-            return it->second.get();
+            return;
         }
-        return nullptr;
+
+        ReleaseObserver(id);
+        m_Observers.erase(id);
+    }
+
+    uint32_t ChunkManager::GetObserverRefCount(const ChunkCoord& coord) const
+    {
+        auto it = m_ObserverRefs.find(coord);
+        return it != m_ObserverRefs.end() ? it->second : 0;
     }
 
     // ============================================================================
-    // Internal Methods
+    // Configuration
     // ============================================================================
 
-    ChunkCoord ChunkManager::WorldToChunkCoord(float worldX, float worldZ) const
+    void ChunkManager::SetViewDistance(float distance)
     {
-        float chunkSize = Chunk::GetWorldSize();
-
-        int x = static_cast<int>(std::floor(worldX / chunkSize));
-        int z = static_cast<int>(std::floor(worldZ / chunkSize));
+        m_Config.ViewDistance = distance;
+        m_Config.UnloadDistance = distance * 1.2f; // 20% buffer
 
-        return ChunkCoord(x, z);
-    }
+        // Update LOD system
+        m_LOD.SetupDefault(distance, 5);
 
-    float ChunkManager::CalculateChunkDistance(const ChunkCoord& coord, const DirectX::XMFLOAT3& cameraPos) const
-    {
-        DirectX::XMFLOAT3 chunkCenter = coord.ToWorldCenter(Chunk::GetWorldSize());
+        // The streaming disc changes size; rescan it in full next update
+        m_RingHalfWidths.clear();
+        m_StreamingRingValid = false;
 
-        float dx = chunkCenter.x - cameraPos.x;
-        float dz = chunkCenter.z - cameraPos.z;
+        // Observer discs default to the view distance and scale with the unload distance
+        for (auto& [id, state] : m_Observers)
+        {
+            ReleaseObserver(id);
+            BuildObserverDiscs(state.Observer, state.WantHalfWidths, state.KeepHalfWidths);
+        }
 
-        return std::sqrt(dx * dx + dz * dz);
+        // A longer unload distance needs a larger lookup window
+        ResizeChunkGrid();
+        m_ChunkGrid.Rebuild(m_ChunkGrid.GetCentre(), m_Chunks);
     }
 
-    void ChunkManager::DetermineVisibleChunks(const DirectX::XMFLOAT3& cameraPosition)
+    void ChunkManager::SetLODDistances(const std::vector<float>& distances)
     {
-        ChunkCoord centerChunk = WorldToChunkCoord(cameraPosition.x, cameraPosition.z);
+        m_LOD.SetDistances(distances);
+    }
 
-        // Calculate how many chunks we need in each direction
-        float chunkSize = Chunk::GetWorldSize();
-        int chunkRadius = static_cast<int>(std::ceil(m_Config.ViewDistance / chunkSize)) + 1;
+    // ============================================================================
+    // Terrain Queries
+    // ============================================================================
 
-        // Check all chunks in range
-        for (int z = -chunkRadius; z <= chunkRadius; ++z)
+    size_t ChunkManager::GetResidentChunkBytes() const
+    {
+        size_t bytes = 0;
+        for (const auto& pair : m_Chunks)
         {
-            for (int x = -chunkRadius; x <= chunkRadius; ++x)
-            {
-                ChunkCoord coord(centerChunk.X + x, centerChunk.Z + z);
-
-                // Calculate distance to chunk
-                float distance = CalculateChunkDistance(coord, cameraPosition);
-
-                // Skip chunks beyond view distance
-                if (distance > m_Config.ViewDistance)
-                {
-                    continue;
-                }
-
-                // Check if chunk needs to be loaded
-                if (m_Chunks.find(coord) == m_Chunks.end())
-                {
-                    QueueChunkGeneration(coord);
-                }
-            }
+            const Chunk& chunk = *pair.second;
+            bytes += sizeof(Chunk) +
+                     chunk.GetHeightBytes() +
+                     chunk.GetApronHeights().capacity() * sizeof(float) +
+                     chunk.GetHeightPyramidBytes() +
+                     chunk.GetBiomes().capacity() * sizeof(BiomeType);
         }
+        return bytes;
     }
 
-    void ChunkManager::QueueChunkGeneration(const ChunkCoord& coord)
+    float ChunkManager::GetHeightAt(float worldX, float worldZ) const
     {
-        // Check if already in queue (simple linear search for now)
-        // In a production system, use a set for O(1) lookup
-        std::queue<ChunkCoord> tempQueue = m_PendingGeneration;
-        while (!tempQueue.empty())
+        const Chunk* chunk = GetChunkAt(worldX, worldZ);
+        if (!chunk || !chunk->IsGenerated())
         {
-            if (tempQueue.front() == coord)
-            {
-                return; // Already queued
-            }
-            tempQueue.pop();
+            return 0.0f;
         }
 
-        m_PendingGeneration.push(coord);
+        return SampleChunkHeight(*chunk, worldX, worldZ);
     }
 
-    void ChunkManager::ProcessPendingGenerations()
+    void ChunkManager::GetHeightsAt(std::span<const DirectX::XMFLOAT2> positions, std::span<float> heights) const
     {
-        int generated = 0;
+        const size_t count = std::min(positions.size(), heights.size());
+
+        // Queries cluster spatially, so remember the last chunk looked up
+        ChunkCoord lastCoord(INT_MAX, INT_MAX);
+        const Chunk* lastChunk = nullptr;
 
-        while (!m_PendingGeneration.empty() && generated < m_Config.MaxChunksPerFrame)
+        for (size_t i = 0; i < count; ++i)
         {
-            ChunkCoord coord = m_PendingGeneration.front();
-            m_PendingGeneration.pop();
+            const DirectX::XMFLOAT2& position = positions[i];
+            ChunkCoord coord = WorldToChunkCoord(position.x, position.y);
 
-            // Skip if already loaded (might have been loaded by ForceLoadAround)
-            if (m_Chunks.find(coord) != m_Chunks.end())
+            if (coord != lastCoord)
             {
-                continue;
+                lastCoord = coord;
+                lastChunk = GetChunk(coord);
+                if (lastChunk && !lastChunk->IsGenerated())
+                {
+                    lastChunk = nullptr;
+                }
             }
 
-            // Create and generate chunk
-            auto chunk = CreateChunk(coord);
-            if (chunk)
-            {
-                m_Chunks[coord] = std::move(chunk);
-                m_PendingMeshBuild.push(coord);
-                generated++;
-            }
+            heights[i] = lastChunk ? SampleChunkHeight(*lastChunk, position.x, position.y) : 0.0f;
         }
     }
 
-    void ChunkManager::ProcessPendingMeshBuilds()
+    TerrainHit ChunkManager::Raycast(const TerrainRay& ray) const
     {
-        int built = 0;
+        TerrainHit hit;
 
-        while (!m_PendingMeshBuild.empty() && built < m_Config.MaxMeshBuildsPerFrame)
+        const DirectX::XMFLOAT3& d = ray.Direction;
+        const float length = std::sqrt(d.x * d.x + d.y * d.y + d.z * d.z);
+        if (!(length > 0.0f) || !(ray.MaxDistance > 0.0f) || m_ChunkGrid.GetRadius() < 0)
         {
-            ChunkCoord coord = m_PendingMeshBuild.front();
-            m_PendingMeshBuild.pop();
+            return hit;
+        }
 
-            auto it = m_Chunks.find(coord);
-            if (it != m_Chunks.end())
+        TerrainRay unitRay = ray;
+        unitRay.Direction = DirectX::XMFLOAT3(d.x / length, d.y / length, d.z / length);
+        const float dirX = unitRay.Direction.x;
+        const float dirZ = unitRay.Direction.z;
+
+        // Every loaded chunk is inside the grid window, so only walk the part of the ray over it
+        const float chunkSize = Chunk::GetWorldSize();
+        const ChunkCoord& centre = m_ChunkGrid.GetCentre();
+        const int radius = m_ChunkGrid.GetRadius();
+        const float windowLow[2] = { static_cast<float>(centre.X - radius) * chunkSize,
+                                     static_cast<float>(centre.Z - radius) * chunkSize };
+        const float windowHigh[2] = { static_cast<float>(centre.X + radius + 1) * chunkSize,
+                                      static_cast<float>(centre.Z + radius + 1) * chunkSize };
+        const float origin[2] = { ray.Origin.x, ray.Origin.z };
+        const float direction[2] = { dirX, dirZ };
+
+        float tStart = 0.0f;
+        float tEnd = ray.MaxDistance;
+        for (int axis = 0; axis < 2; ++axis)
+        {
+            if (direction[axis] == 0.0f)
             {
-                Chunk* chunk = it->second.get();
-                if (chunk && chunk->IsGenerated() && !chunk->HasMesh())
+                if (origin[axis] < windowLow[axis] || origin[axis] > windowHigh[axis])
                 {
-                    if (chunk->BuildMesh(m_Core))
-                    {
-                        built++;
-                    }
+                    return hit;
                 }
+                continue;
+            }
+
+            float t0 = (windowLow[axis] - origin[axis]) / direction[axis];
+            float t1 = (windowHigh[axis] - origin[axis]) / direction[axis];
+            tStart = std::max(tStart, std::min(t0, t1));
+            tEnd = std::min(tEnd, std::max(t0, t1));
+        }
+
+        if (tStart > tEnd)
+        {
+            return hit;
+        }
+
+        // 2D DDA over chunk cells, starting where the ray enters the window
+        ChunkCoord coord = WorldToChunkCoord(origin[0] + dirX * tStart, origin[1] + dirZ * tStart);
+        coord.X = std::clamp(coord.X, centre.X - radius, centre.X + radius);
+        coord.Z = std::clamp(coord.Z, centre.Z - radius, centre.Z + radius);
+
+        constexpr float NEVER = std::numeric_limits<float>::infinity();
+        const int stepX = dirX > 0.0f ? 1 : -1;
+        const int stepZ = dirZ > 0.0f ? 1 : -1;
+        const float deltaX = dirX != 0.0f ? chunkSize / std::abs(dirX) : NEVER;
+        const float deltaZ = dirZ != 0.0f ? chunkSize / std::abs(dirZ) : NEVER;
+        float nextX = dirX != 0.0f
+            ? (static_cast<float>(coord.X + (stepX > 0 ? 1 : 0)) * chunkSize - origin[0]) / dirX
+            : NEVER;
+        float nextZ = dirZ != 0.0f
+            ? (static_cast<float>(coord.Z + (stepZ > 0 ? 1 : 0)) * chunkSize - origin[1]) / dirZ
+            : NEVER;
+
+        float tEnter = tStart;
+        while (m_ChunkGrid.InWindow(coord))
+        {
+            const float tExit = std::min(std::min(nextX, nextZ), tEnd);
+
+            const Chunk* chunk = m_ChunkGrid.Find(coord);
+            if (chunk && chunk->IsGenerated() && chunk->Raycast(unitRay, tEnter, tExit, hit))
+            {
+                return hit;
+            }
+
+            if (tExit >= tEnd)
+            {
+                break;
+            }
+
+            tEnter = tExit;
+            if (nextX < nextZ)
+            {
+                coord.X += stepX;
+                nextX += deltaX;
+            }
+            else
+            {
+                coord.Z += stepZ;
+                nextZ += deltaZ;
+            }
+        }
+
+        return hit;
+    }
+
+    void ChunkManager::Raycast(std::span<const TerrainRay> rays, std::span<TerrainHit> hits) const
+    {
+        const size_t count = std::min(rays.size(), hits.size());
+
+        // Rays are independent and chunks are read-only here
+        constexpr uint32_t RAYS_PER_JOB = 64;
+        auto castRange = [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i)
+            {
+                hits[i] = Raycast(rays[i]);
+            }
+        };
+
+        SM::JobSystem& jobs = SM::JobSystem::Get();
+        if (jobs.IsInitialized() && count > RAYS_PER_JOB)
+        {
+            jobs.ParallelFor(static_cast<uint32_t>(count), RAYS_PER_JOB, castRange);
+        }
+        else
+        {
+            castRange(0, static_cast<uint32_t>(count));
+        }
+    }
+
+    BiomeType ChunkManager::GetBiomeAt(float worldX, float worldZ) const
+    {
+        const Chunk* chunk = GetChunkAt(worldX, worldZ);
+        if (!chunk)
+        {
+            return BiomeType::Count;
+        }
+
+        DirectX::XMFLOAT3 origin = chunk->GetWorldPosition();
+        int localX = static_cast<int>(std::lround((worldX - origin.x) / Chunk::SCALE));
+        int localZ = static_cast<int>(std::lround((worldZ - origin.z) / Chunk::SCALE));
+        return chunk->GetBiome(localX, localZ);
+    }
+
+    // ============================================================================
+    // Terrain Editing
+    // ============================================================================
+
+    uint32_t ChunkManager::ApplyBrush(const TerrainBrush& brush)
+    {
+        if (brush.Radius <= 0.0f)
+        {
+            return 0;
+        }
+
+        const float radius = brush.Radius;
+        const float inner = radius * (1.0f - std::clamp(brush.Falloff, 0.0f, 1.0f));
+        const DirectX::XMFLOAT3 center = brush.Center;
+
+        // Full strength inside the inner radius, smoothstep to zero at the edge
+        auto weight = [radius, inner](float distance) {
+            if (distance >= radius)
+            {
+                return 0.0f;
+            }
+            if (distance <= inner)
+            {
+                return 1.0f;
+            }
+            const float t = (radius - distance) / (radius - inner);
+            return t * t * (3.0f - 2.0f * t);
+        };
+
+        return DeformTerrain(
+            center.x - radius, center.z - radius, center.x + radius, center.z + radius,
+            [brush, center, radius, weight](float worldX, float worldZ, float height) {
+                const float dx = worldX - center.x;
+                const float dz = worldZ - center.z;
+                const float distance = std::sqrt(dx * dx + dz * dz);
+
+                switch (brush.Mode)
+                {
+                case TerrainBrushMode::Raise:
+                    return height + brush.Strength * weight(distance);
+                case TerrainBrushMode::Lower:
+                    return height - brush.Strength * weight(distance);
+                case TerrainBrushMode::Flatten:
+                    return height + (center.y - height) * std::clamp(brush.Strength, 0.0f, 1.0f) * weight(distance);
+                case TerrainBrushMode::Crater:
+                {
+                    // Parabolic bowl over the inner 70%, sine rim 30% as high over the rest
+                    const float r = distance / radius;
+                    if (r >= 1.0f)
+                    {
+                        return height;
+                    }
+                    if (r < 0.7f)
+                    {
+                        const float bowl = r / 0.7f;
+                        return height - brush.Strength * (1.0f - bowl * bowl);
+                    }
+                    return height + brush.Strength * 0.3f * std::sin(DirectX::XM_PI * (r - 0.7f) / 0.3f);
+                }
+                }
+                return height;
+            });
+    }
+
+    uint32_t ChunkManager::DeformTerrain(float minX, float minZ, float maxX, float maxZ,
+                                         const Chunk::HeightEditFunc& edit)
+    {
+        if (!m_Initialized || !edit || minX > maxX || minZ > maxZ)
+        {
+            return 0;
+        }
+
+        // One sample further on each side reaches the neighbours' aprons
+        const ChunkCoord first = WorldToChunkCoord(minX - Chunk::SCALE, minZ - Chunk::SCALE);
+        const ChunkCoord last = WorldToChunkCoord(maxX + Chunk::SCALE, maxZ + Chunk::SCALE);
+
+        uint32_t edited = 0;
+        for (int z = first.Z; z <= last.Z; ++z)
+        {
+            for (int x = first.X; x <= last.X; ++x)
+            {
+                const ChunkCoord coord(x, z);
+                Chunk* chunk = GetChunk(coord);
+                if (!chunk || !chunk->EditHeights(minX, minZ, maxX, maxZ, edit))
+                {
+                    continue;
+                }
+
+                if (std::find(m_DirtyChunks.begin(), m_DirtyChunks.end(), coord) == m_DirtyChunks.end())
+                {
+                    m_DirtyChunks.push_back(coord);
+                }
+                ++edited;
+            }
+        }
+
+        return edited;
+    }
+
+    Chunk* ChunkManager::GetChunkAt(float worldX, float worldZ)
+    {
+        ChunkCoord coord = WorldToChunkCoord(worldX, worldZ);
+        return GetChunk(coord);
+    }
+
+    const Chunk* ChunkManager::GetChunkAt(float worldX, float worldZ) const
+    {
+        ChunkCoord coord = WorldToChunkCoord(worldX, worldZ);
+        return GetChunk(coord);
+    }
+
+    Chunk* ChunkManager::GetChunk(const ChunkCoord& coord)
+    {
+        // Inside the window the grid is authoritative; beyond it fall back to the map
+        if (m_ChunkGrid.InWindow(coord))
+        {
+            return m_ChunkGrid.Find(coord);
+        }
+
+        auto it = m_Chunks.find(coord);
+        if (it != m_Chunks.end())
+        {
+            return it->second.get();
+        }
+        return nullptr;
+    }
+
+    const Chunk* ChunkManager::GetChunk(const ChunkCoord& coord) const
+    {
+        if (m_ChunkGrid.InWindow(coord))
+        {
+            return m_ChunkGrid.Find(coord);
+        }
+
+        auto it = m_Chunks.find(coord);
+        if (it != m_Chunks.end())
+        {
+            return it->second.get();
+        }
+        return nullptr;
+    }
+
+    // ============================================================================
+    // Internal Methods
+    // ============================================================================
+
+    float ChunkManager::SampleChunkHeight(const Chunk& chunk, float worldX, float worldZ)
+    {
+        // Convert to local vertex coordinates
+        DirectX::XMFLOAT3 origin = chunk.GetWorldPosition();
+        float vertexX = (worldX - origin.x) / Chunk::SCALE;
+        float vertexZ = (worldZ - origin.z) / Chunk::SCALE;
+
+        return chunk.GetHeightInterpolated(vertexX, vertexZ);
+    }
+
+    void ChunkManager::AddChunk(const ChunkCoord& coord, std::unique_ptr<Chunk> chunk)
+    {
+        // Apron and biomes are derived by now; cache the exact heights before they are rounded
+        if (m_Config.QuantizedHeights)
+        {
+            StoreCachedChunk(*chunk);
+            chunk->QuantizeHeights();
+        }
+
+        Chunk* pointer = chunk.get();
+        m_Chunks[coord] = std::move(chunk);
+        m_ChunkGrid.Insert(coord, pointer);
+    }
+
+    void ChunkManager::ResizeChunkGrid()
+    {
+        // Chunks load and unload by centre distance, so none survive beyond this radius
+        const int radius = static_cast<int>(std::ceil(m_Config.UnloadDistance / Chunk::GetWorldSize())) + 1;
+        if (radius != m_ChunkGrid.GetRadius())
+        {
+            m_ChunkGrid.Initialize(radius);
+        }
+    }
+
+    ChunkCoord ChunkManager::WorldToChunkCoord(float worldX, float worldZ) const
+    {
+        float chunkSize = Chunk::GetWorldSize();
+
+        int x = static_cast<int>(std::floor(worldX / chunkSize));
+        int z = static_cast<int>(std::floor(worldZ / chunkSize));
+
+        return ChunkCoord(x, z);
+    }
+
+    float ChunkManager::CalculateChunkDistance(const ChunkCoord& coord, const DirectX::XMFLOAT3& cameraPos) const
+    {
+        DirectX::XMFLOAT3 chunkCenter = coord.ToWorldCenter(Chunk::GetWorldSize());
+
+        float dx = chunkCenter.x - cameraPos.x;
+        float dz = chunkCenter.z - cameraPos.z;
+
+        return std::sqrt(dx * dx + dz * dz);
+    }
+
+    float ChunkManager::CalculateLODDistance(const ChunkCoord& coord, const DirectX::XMFLOAT3& cameraPosition) const
+    {
+        float distance = CalculateChunkDistance(coord, cameraPosition);
+
+        for (const auto& [id, state] : m_Observers)
+        {
+            if (state.Observer.AffectsLOD)
+            {
+                distance = std::min(distance, CalculateChunkDistance(coord, state.Observer.Position));
+            }
+        }
+
+        return distance;
+    }
+
+    void ChunkManager::DetermineVisibleChunks(const DirectX::XMFLOAT3& cameraPosition)
+    {
+        SM_PROFILE_SCOPE("ChunkManager::DetermineVisibleChunks");
+
+        ChunkCoord centerChunk = WorldToChunkCoord(cameraPosition.x, cameraPosition.z);
+
+        // View direction on the ground plane, from the frustum's near plane
+        DirectX::XMFLOAT2 forward = { 0.0f, 0.0f };
+        if (m_HasFrustum)
+        {
+            const DirectX::XMFLOAT4& nearPlane = m_Frustum.GetPlane(SM::Frustum::Near);
+            float length = std::sqrt(nearPlane.x * nearPlane.x + nearPlane.z * nearPlane.z);
+            if (length > 1e-4f)
+            {
+                forward = DirectX::XMFLOAT2(nearPlane.x / length, nearPlane.z / length);
+            }
+        }
+
+        const bool turned = forward.x * m_PriorityForward.x + forward.y * m_PriorityForward.y < 0.9f &&
+            (forward.x != 0.0f || forward.y != 0.0f);
+
+        if (m_StreamingRingValid && centerChunk == m_LastCameraChunk)
+        {
+            // Same disc; only re-sort the queue if the view swung by more than ~25 degrees
+            if (turned)
+            {
+                m_PriorityForward = forward;
+                ReprioritizePendingGenerations();
+            }
+            return;
+        }
+
+        if (m_RingHalfWidths.empty())
+        {
+            BuildStreamingRing();
+        }
+
+        const int radius = static_cast<int>(m_RingHalfWidths.size() / 2);
+        const bool incremental = m_StreamingRingValid;
+        const ChunkCoord previous = m_LastCameraChunk;
+
+        // A full rescan re-queues everything it wants (prefetch and observers included)
+        if (!incremental)
+        {
+            m_PendingGeneration.clear();
+            m_QueuedGeneration.clear();
+            m_LastPrefetchChunk = ChunkCoord(INT_MAX, INT_MAX);
+
+            for (auto& [id, state] : m_Observers)
+            {
+                state.Requeue = true;
+            }
+        }
+
+        // Entering strips: queue chunks not already loaded or generating
+        for (int z = centerChunk.Z - radius; z <= centerChunk.Z + radius; ++z)
+        {
+            int newMin, newMax;
+            int oldMin = 0, oldMax = -1;
+            DiscRowSpan(m_RingHalfWidths, centerChunk, z, newMin, newMax);
+            if (incremental)
+            {
+                DiscRowSpan(m_RingHalfWidths, previous, z, oldMin, oldMax);
+            }
+
+            ForEachSpanDifference(newMin, newMax, oldMin, oldMax, [&](int x) {
+                ChunkCoord coord(x, z);
+                if (!GetChunk(coord) && m_InFlight.find(coord) == m_InFlight.end())
+                {
+                    QueueChunkGeneration(coord);
+                }
+            });
+        }
+
+        // Leaving strips: drop queued chunks that are no longer wanted
+        if (incremental && !m_QueuedGeneration.empty())
+        {
+            for (int z = previous.Z - radius; z <= previous.Z + radius; ++z)
+            {
+                int oldMin, oldMax, newMin, newMax;
+                DiscRowSpan(m_RingHalfWidths, previous, z, oldMin, oldMax);
+                DiscRowSpan(m_RingHalfWidths, centerChunk, z, newMin, newMax);
+
+                ForEachSpanDifference(oldMin, oldMax, newMin, newMax, [&](int x) {
+                    ChunkCoord coord(x, z);
+                    if (!IsWantedByObserver(coord))
+                    {
+                        m_QueuedGeneration.erase(coord);
+                    }
+                });
+            }
+        }
+
+        m_StreamingRingValid = true;
+        m_PriorityForward = forward;
+        ReprioritizePendingGenerations();
+    }
+
+    void ChunkManager::BuildStreamingRing()
+    {
+        // Wanted chunks are measured from the camera chunk's centre. Keep them
+        // inside the unload distance from anywhere in that chunk, so a chunk
+        // is never loaded and then unloaded without the camera moving away.
+        const float chunkSize = Chunk::GetWorldSize();
+        const float halfDiagonal = chunkSize * 0.70710678f;
+        const float wantedDistance = std::max(0.0f,
+            std::min(m_Config.ViewDistance, m_Config.UnloadDistance - halfDiagonal));
+
+        BuildDiscHalfWidths(wantedDistance / chunkSize, m_RingHalfWidths);
+    }
+
+    void ChunkManager::BuildObserverDiscs(const ChunkObserver& observer, std::vector<int>& wantHalfWidths,
+                                          std::vector<int>& keepHalfWidths) const
+    {
+        // Same load/unload ratio as the camera's view and unload distances
+        const float chunkSize = Chunk::GetWorldSize();
+        const float wanted = observer.Radius > 0.0f ? observer.Radius : m_Config.ViewDistance;
+        const float kept = m_Config.ViewDistance > 0.0f
+            ? wanted * std::max(1.0f, m_Config.UnloadDistance / m_Config.ViewDistance)
+            : wanted;
+
+        BuildDiscHalfWidths(wanted / chunkSize, wantHalfWidths);
+        BuildDiscHalfWidths(kept / chunkSize, keepHalfWidths);
+    }
+
+    void ChunkManager::UpdateObservers()
+    {
+        SM_PROFILE_SCOPE("ChunkManager::UpdateObservers");
+
+        bool moved = false;
+
+        auto release = [this](const ChunkCoord& coord) {
+            auto it = m_ObserverRefs.find(coord);
+            if (it != m_ObserverRefs.end() && --it->second == 0)
+            {
+                m_ObserverRefs.erase(it);
+            }
+        };
+
+        for (auto& [id, state] : m_Observers)
+        {
+            const ChunkCoord centre = WorldToChunkCoord(state.Observer.Position.x, state.Observer.Position.z);
+            if (state.Placed && centre == state.Centre && !state.Requeue)
+            {
+                continue;
+            }
+
+            const ChunkCoord previous = state.Centre;
+            const ChunkCoord* from = state.Placed ? &previous : nullptr;
+            state.Centre = centre;
+
+            // References follow the kept disc; chunks in both discs keep theirs
+            ForEachDiscDifference(state.KeepHalfWidths, centre, from, [&](const ChunkCoord& coord) {
+                m_ObserverRefs[coord]++;
+            });
+            if (from)
+            {
+                ForEachDiscDifference(state.KeepHalfWidths, previous, &centre, release);
+            }
+
+            // Queue the entering strips (the whole disc after a rescan); chunks shared
+            // with the camera or another observer are already loaded or queued once
+            ForEachDiscDifference(state.WantHalfWidths, centre, state.Requeue ? nullptr : from, [&](const ChunkCoord& coord) {
+                if (!GetChunk(coord) && m_InFlight.find(coord) == m_InFlight.end())
+                {
+                    QueueChunkGeneration(coord);
+                }
+            });
+            if (from && !m_QueuedGeneration.empty())
+            {
+                const ChunkObserverId observerId = id;
+                ForEachDiscDifference(state.WantHalfWidths, previous, &centre, [&](const ChunkCoord& coord) {
+                    DropQueuedGeneration(coord, observerId);
+                });
+            }
+
+            state.Placed = true;
+            state.Requeue = false;
+            moved = true;
+        }
+
+        if (moved || m_ObserversChanged)
+        {
+            m_ObserversChanged = false;
+            ReprioritizePendingGenerations();
+        }
+    }
+
+    bool ChunkManager::IsWantedByObserver(const ChunkCoord& coord, ChunkObserverId exclude) const
+    {
+        for (const auto& [id, state] : m_Observers)
+        {
+            if (id != exclude && state.Placed && IsInDisc(state.WantHalfWidths, state.Centre, coord))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void ChunkManager::DropQueuedGeneration(const ChunkCoord& coord, ChunkObserverId exclude)
+    {
+        if (m_RingHalfWidths.empty())
+        {
+            // Camera disc is being rebuilt; its full rescan re-queues everything anyway
+            m_QueuedGeneration.erase(coord);
+            return;
+        }
+
+        if (m_StreamingRingValid &&
+            IsInDisc(m_RingHalfWidths, WorldToChunkCoord(m_LastCameraPosition.x, m_LastCameraPosition.z), coord))
+        {
+            return;
+        }
+
+        if (m_Prefetching && IsInDisc(m_RingHalfWidths, m_LastPrefetchChunk, coord))
+        {
+            return;
+        }
+
+        if (!IsWantedByObserver(coord, exclude))
+        {
+            m_QueuedGeneration.erase(coord);
+        }
+    }
+
+    void ChunkManager::ReleaseObserver(ChunkObserverId id)
+    {
+        ObserverState& state = m_Observers.at(id);
+        if (!state.Placed)
+        {
+            return;
+        }
+
+        ForEachDiscDifference(state.KeepHalfWidths, state.Centre, nullptr, [&](const ChunkCoord& coord) {
+            auto it = m_ObserverRefs.find(coord);
+            if (it != m_ObserverRefs.end() && --it->second == 0)
+            {
+                m_ObserverRefs.erase(it);
+            }
+        });
+
+        if (!m_QueuedGeneration.empty())
+        {
+            ForEachDiscDifference(state.WantHalfWidths, state.Centre, nullptr, [&](const ChunkCoord& coord) {
+                DropQueuedGeneration(coord, id);
+            });
+        }
+
+        state.Placed = false;
+        state.Requeue = true;
+        m_ObserversChanged = true;
+    }
+
+    void ChunkManager::QueueChunkGeneration(const ChunkCoord& coord)
+    {
+        if (!m_QueuedGeneration.insert(coord).second)
+        {
+            return; // Already queued
+        }
+
+        m_PendingGeneration.push_back({ coord, CalculateChunkPriority(coord) });
+        std::push_heap(m_PendingGeneration.begin(), m_PendingGeneration.end(), PendingGeneration::IsLater);
+    }
+
+    bool ChunkManager::PopPendingGeneration(ChunkCoord& coord)
+    {
+        while (!m_PendingGeneration.empty())
+        {
+            std::pop_heap(m_PendingGeneration.begin(), m_PendingGeneration.end(), PendingGeneration::IsLater);
+            coord = m_PendingGeneration.back().Coord;
+            m_PendingGeneration.pop_back();
+
+            // Entries dropped from the wanted set (or duplicates) are skipped lazily
+            if (m_QueuedGeneration.erase(coord) > 0)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void ChunkManager::ReprioritizePendingGenerations()
+    {
+        m_PendingGeneration.clear();
+        m_PendingGeneration.reserve(m_QueuedGeneration.size());
+
+        for (const ChunkCoord& coord : m_QueuedGeneration)
+        {
+            m_PendingGeneration.push_back({ coord, CalculateChunkPriority(coord) });
+        }
+
+        std::make_heap(m_PendingGeneration.begin(), m_PendingGeneration.end(), PendingGeneration::IsLater);
+    }
+
+    float ChunkManager::CalculateChunkPriority(const ChunkCoord& coord) const
+    {
+        DirectX::XMFLOAT3 centre = coord.ToWorldCenter(Chunk::GetWorldSize());
+        float dx = centre.x - m_LastCameraPosition.x;
+        float dz = centre.z - m_LastCameraPosition.z;
+        float distance = std::sqrt(dx * dx + dz * dz);
+
+        if (distance < 1e-4f)
+        {
+            return 0.0f;
+        }
+
+        // 1 straight ahead (or without a view direction), up to 1 + weight straight behind
+        float facing = (dx * m_PriorityForward.x + dz * m_PriorityForward.y) / distance;
+        if (m_PriorityForward.x == 0.0f && m_PriorityForward.y == 0.0f)
+        {
+            facing = 1.0f;
+        }
+
+        float priority = distance * (1.0f + m_Config.ViewDirectionPriority * 0.5f * (1.0f - facing));
+
+        // Chunks along the direction of travel look up to twice as close
+        if (m_Prefetching)
+        {
+            float travel = (dx * m_PriorityMotion.x + dz * m_PriorityMotion.y) / distance;
+            priority *= 1.0f - 0.5f * std::max(travel, 0.0f);
+        }
+
+        // A shared chunk goes as early as its most urgent observer asks
+        for (const auto& [id, state] : m_Observers)
+        {
+            if (state.Placed && IsInDisc(state.WantHalfWidths, state.Centre, coord))
+            {
+                float ox = centre.x - state.Observer.Position.x;
+                float oz = centre.z - state.Observer.Position.z;
+                priority = std::min(priority, std::sqrt(ox * ox + oz * oz) / std::max(state.Observer.Priority, 1e-3f));
+            }
+        }
+
+        return priority;
+    }
+
+    void ChunkManager::PrefetchAlongPath()
+    {
+        SM_PROFILE_SCOPE("ChunkManager::PrefetchAlongPath");
+
+        const float speed = std::sqrt(m_CameraVelocity.x * m_CameraVelocity.x + m_CameraVelocity.z * m_CameraVelocity.z);
+        const bool prefetch = m_Config.PredictivePrefetch && speed >= m_Config.PrefetchMinSpeed &&
+            m_Config.PrefetchSeconds > 0.0f && !m_RingHalfWidths.empty();
+
+        if (!prefetch)
+        {
+            if (m_Prefetching)
+            {
+                m_Prefetching = false;
+                m_PriorityMotion = DirectX::XMFLOAT2(0.0f, 0.0f);
+                ReprioritizePendingGenerations();
+            }
+            return;
+        }
+
+        const DirectX::XMFLOAT2 motion(m_CameraVelocity.x / speed, m_CameraVelocity.z / speed);
+        const bool wasPrefetching = m_Prefetching;
+        const bool steered = motion.x * m_PriorityMotion.x + motion.y * m_PriorityMotion.y < 0.9f;
+
+        // Horizontal projection only; chunks are a ground-plane grid
+        m_PrefetchPosition = DirectX::XMFLOAT3(
+            m_LastCameraPosition.x + m_CameraVelocity.x * m_Config.PrefetchSeconds,
+            m_LastCameraPosition.y,
+            m_LastCameraPosition.z + m_CameraVelocity.z * m_Config.PrefetchSeconds);
+        m_Prefetching = true;
+
+        if (!wasPrefetching || steered)
+        {
+            m_PriorityMotion = motion;
+            ReprioritizePendingGenerations();
+        }
+
+        const ChunkCoord cameraChunk = WorldToChunkCoord(m_LastCameraPosition.x, m_LastCameraPosition.z);
+        const ChunkCoord targetChunk = WorldToChunkCoord(m_PrefetchPosition.x, m_PrefetchPosition.z);
+        if (wasPrefetching && targetChunk == m_LastPrefetchChunk && cameraChunk == m_LastCameraChunk)
+        {
+            return;
+        }
+        m_LastPrefetchChunk = targetChunk;
+
+        // The projected disc minus the camera's own disc, which DetermineVisibleChunks covers
+        m_PrefetchCandidates.clear();
+        const int radius = static_cast<int>(m_RingHalfWidths.size() / 2);
+
+        for (int z = targetChunk.Z - radius; z <= targetChunk.Z + radius; ++z)
+        {
+            int aheadMin, aheadMax, ownMin, ownMax;
+            DiscRowSpan(m_RingHalfWidths, targetChunk, z, aheadMin, aheadMax);
+            DiscRowSpan(m_RingHalfWidths, cameraChunk, z, ownMin, ownMax);
+
+            ForEachSpanDifference(aheadMin, aheadMax, ownMin, ownMax, [&](int x) {
+                ChunkCoord coord(x, z);
+                if (!GetChunk(coord) && m_InFlight.find(coord) == m_InFlight.end() &&
+                    m_QueuedGeneration.find(coord) == m_QueuedGeneration.end())
+                {
+                    m_PrefetchCandidates.push_back({ coord, CalculateChunkDistance(coord, m_LastCameraPosition) });
+                }
+            });
+        }
+
+        // Nearest to the camera first, so the budget covers the next second of travel before the third
+        const size_t budget = static_cast<size_t>(std::max(0, m_Config.PrefetchBudget));
+        if (m_PrefetchCandidates.size() > budget)
+        {
+            std::nth_element(m_PrefetchCandidates.begin(), m_PrefetchCandidates.begin() + budget,
+                m_PrefetchCandidates.end(),
+                [](const PendingGeneration& a, const PendingGeneration& b) { return a.Priority < b.Priority; });
+            m_PrefetchCandidates.resize(budget);
+        }
+
+        for (const PendingGeneration& candidate : m_PrefetchCandidates)
+        {
+            QueueChunkGeneration(candidate.Coord);
+        }
+    }
+
+    bool ChunkManager::IsInStreamingRange(const ChunkCoord& coord) const
+    {
+        if (CalculateChunkDistance(coord, m_LastCameraPosition) <= m_Config.UnloadDistance)
+        {
+            return true;
+        }
+
+        // Any observer's reference keeps a chunk loaded for everyone
+        if (m_ObserverRefs.find(coord) != m_ObserverRefs.end())
+        {
+            return true;
+        }
+
+        // Prefetched chunks stay while the camera is still heading for them
+        return m_Prefetching && CalculateChunkDistance(coord, m_PrefetchPosition) <= m_Config.UnloadDistance;
+    }
+
+    void ChunkManager::ProcessPendingGenerations()
+    {
+        SM_PROFILE_SCOPE("ChunkManager::ProcessPendingGenerations");
+
+        if (m_Config.AsyncGeneration && m_WorkerPool.IsRunning())
+        {
+            CollectCompletedGenerations();
+            DispatchPendingGenerations();
+            return;
+        }
+
+        const bool budgeted = m_Config.StreamingBudgetMs > 0.0f;
+        int generated = 0;
+
+        ChunkCoord coord;
+        while ((budgeted ? m_Scheduler.CanAfford(StreamingTask::Generate) : generated < m_Config.MaxChunksPerFrame) &&
+               PopPendingGeneration(coord))
+        {
+            // Skip if already loaded (might have been loaded by ForceLoadAround)
+            if (GetChunk(coord))
+            {
+                continue;
+            }
+
+            // Cached chunks skip generation and do not count against its per-frame count
+            auto start = m_Scheduler.BeginTask();
+            auto chunk = LoadCachedChunk(coord);
+            if (chunk)
+            {
+                m_Scheduler.EndTask(StreamingTask::CacheLoad, start);
+                AddChunk(coord, std::move(chunk));
+                m_PendingMeshBuild.push(coord);
+                continue;
+            }
+
+            // Create and generate chunk
+            chunk = CreateChunk(coord);
+            m_Scheduler.EndTask(StreamingTask::Generate, start);
+            if (chunk)
+            {
+                AddChunk(coord, std::move(chunk));
+                m_PendingMeshBuild.push(coord);
+                m_GeneratedChunks++;
+                generated++;
+            }
+        }
+    }
+
+    void ChunkManager::DispatchPendingGenerations()
+    {
+        const size_t maxInFlight = static_cast<size_t>(std::max(1, m_Config.MaxInFlightGenerations));
+
+        const bool budgeted = m_Config.StreamingBudgetMs > 0.0f;
+
+        // Workers generate; only cache lookups cost main-thread time here
+        ChunkCoord coord;
+        while (m_InFlight.size() < maxInFlight &&
+               (!budgeted || m_Scheduler.CanAfford(StreamingTask::CacheLoad)) &&
+               PopPendingGeneration(coord))
+        {
+            // Skip if already loaded or already being generated
+            if (GetChunk(coord) ||
+                m_InFlight.find(coord) != m_InFlight.end())
+            {
+                continue;
+            }
+
+            // Skip chunks the camera has moved away from while they were queued
+            if (!IsInStreamingRange(coord))
+            {
+                continue;
+            }
+
+            // Cached chunks load on this thread without a worker round-trip
+            auto start = m_Scheduler.BeginTask();
+            auto chunk = LoadCachedChunk(coord);
+            m_Scheduler.EndTask(StreamingTask::CacheLoad, start);
+            if (chunk)
+            {
+                AddChunk(coord, std::move(chunk));
+                m_PendingMeshBuild.push(coord);
+                continue;
+            }
+
+            auto job = std::make_shared<ChunkGenerationJob>(coord);
+            m_InFlight.emplace(coord, job);
+            m_WorkerPool.Submit(std::move(job));
+        }
+    }
+
+    void ChunkManager::CollectCompletedGenerations()
+    {
+        m_CompletedJobs.clear();
+        m_WorkerPool.CollectCompleted(m_CompletedJobs);
+
+        for (auto& job : m_CompletedJobs)
+        {
+            // A cancelled coordinate may have been re-queued with a new job
+            auto it = m_InFlight.find(job->Coord);
+            if (it != m_InFlight.end() && it->second == job)
+            {
+                m_InFlight.erase(it);
+            }
+
+            if (job->Cancelled.load(std::memory_order_acquire) || !job->Result)
+            {
+                continue;
+            }
+
+            // Skip if loaded meanwhile (might have been loaded by ForceLoadAround)
+            if (GetChunk(job->Coord))
+            {
+                continue;
+            }
+
+            AddChunk(job->Coord, std::move(job->Result));
+            m_PendingMeshBuild.push(job->Coord);
+            m_GeneratedChunks++;
+        }
+
+        m_CompletedJobs.clear();
+    }
+
+    void ChunkManager::ProcessPendingMeshBuilds()
+    {
+        SM_PROFILE_SCOPE("ChunkManager::ProcessPendingMeshBuilds");
+
+        const bool budgeted = m_Config.StreamingBudgetMs > 0.0f;
+        int built = 0;
+
+        while (!m_PendingMeshBuild.empty() &&
+               (budgeted ? m_Scheduler.CanAfford(StreamingTask::MeshBuild) : built < m_Config.MaxMeshBuildsPerFrame))
+        {
+            ChunkCoord coord = m_PendingMeshBuild.front();
+            m_PendingMeshBuild.pop();
+
+            auto it = m_Chunks.find(coord);
+            if (it != m_Chunks.end())
+            {
+                Chunk* chunk = it->second.get();
+                if (chunk && chunk->IsGenerated() && !chunk->HasMesh() && !chunk->HasPendingMesh())
+                {
+                    auto start = m_Scheduler.BeginTask();
+                    bool success = BuildChunkMesh(coord, *chunk);
+                    m_Scheduler.EndTask(StreamingTask::MeshBuild, start);
+
+                    if (success)
+                    {
+                        built++;
+                    }
+                }
+            }
+        }
+    }
+
+    bool ChunkManager::BuildChunkMesh(const ChunkCoord& coord, Chunk& chunk)
+    {
+        bool wasPending = chunk.HasPendingMesh();
+
+        chunk.SetGeomorphEnabled(m_Config.GeomorphLOD);
+
+        // Headless: keep the CPU side of the build so streaming costs stay comparable
+        if (!m_Core)
+        {
+            return chunk.BuildVertices(m_HeadlessVertices);
+        }
+
+        if (!chunk.BuildMesh(m_Core, !m_Config.SharedLODIndices))
+        {
+            return false;
+        }
+
+        // A rebuild of an uploading mesh reuses its existing entry
+        if (chunk.HasPendingMesh() && !wasPending)
+        {
+            m_PendingUploads.push_back(coord);
+        }
+
+        return true;
+    }
+
+    void ChunkManager::ProcessDirtyChunks()
+    {
+        if (m_DirtyChunks.empty())
+        {
+            return;
+        }
+
+        SM_PROFILE_SCOPE("ChunkManager::ProcessDirtyChunks");
+
+        uint64_t patchFence = 0;
+        size_t kept = 0;
+        for (const ChunkCoord& coord : m_DirtyChunks)
+        {
+            Chunk* chunk = GetChunk(coord);
+            if (!chunk || !chunk->HasDirtyRegion())
+            {
+                continue;
+            }
+
+            // Patch the affected rows in place, else rebuild the whole mesh
+            if (m_Core && chunk->UpdateMeshRegion(m_Core))
+            {
+                patchFence = std::max(patchFence, chunk->GetMesh().GetUploadFence());
+                continue;
+            }
+
+            if (!BuildChunkMesh(coord, *chunk))
+            {
+                m_DirtyChunks[kept++] = coord;
+                continue;
+            }
+
+            // Headless builds upload nothing
+            if (!m_Core)
+            {
+                chunk->ClearDirtyRegion();
+            }
+        }
+
+        m_DirtyChunks.resize(kept);
+
+        // Patched meshes are drawn right away, so this frame's draws wait for the copies
+        if (patchFence != 0)
+        {
+            m_Core->GetUploadQueue().WaitOnQueue(m_Core->GetDirectQueue(), patchFence);
+        }
+    }
+
+    void ChunkManager::ProcessMeshUploads()
+    {
+        if (m_PendingUploads.empty() || !m_Core)
+        {
+            return;
+        }
+
+        SM_PROFILE_SCOPE("ChunkManager::ProcessMeshUploads");
+
+        size_t kept = 0;
+        for (const ChunkCoord& coord : m_PendingUploads)
+        {
+            auto it = m_Chunks.find(coord);
+            if (it == m_Chunks.end() || !it->second)
+            {
+                continue;
+            }
+
+            Chunk* chunk = it->second.get();
+            chunk->PromotePendingMesh();
+
+            if (chunk->HasPendingMesh())
+            {
+                m_PendingUploads[kept++] = coord;
             }
         }
+
+        m_PendingUploads.resize(kept);
     }
 
-    void ChunkManager::UnloadDistantChunks(const DirectX::XMFLOAT3& cameraPosition)
+    void ChunkManager::UnloadDistantChunks()
     {
+        SM_PROFILE_SCOPE("ChunkManager::UnloadDistantChunks");
+
         std::vector<ChunkCoord> toUnload;
 
         for (const auto& pair : m_Chunks)
         {
-            float distance = CalculateChunkDistance(pair.first, cameraPosition);
-
-            if (distance > m_Config.UnloadDistance)
+            if (!IsInStreamingRange(pair.first))
             {
                 toUnload.push_back(pair.first);
             }
@@ -348,12 +1668,53 @@ namespace PCG
 
         for (const ChunkCoord& coord : toUnload)
         {
-            m_Chunks.erase(coord);
+            auto it = m_Chunks.find(coord);
+            Chunk& chunk = *it->second;
+            StoreCachedChunk(chunk);
+
+            // The mesh goes with the chunk; the heights are kept for a quick return
+            if (m_HeightLRU.IsEnabled() && chunk.IsGenerated())
+            {
+                float minHeight = chunk.GetMinHeight();
+                float maxHeight = chunk.GetMaxHeight();
+                m_HeightLRU.Insert(coord, chunk.TakeHeightData(), minHeight, maxHeight);
+            }
+
+            m_ChunkGrid.Remove(coord);
+            m_Chunks.erase(it);
+        }
+
+        // One append per touched region file
+        if (!toUnload.empty())
+        {
+            m_DiskCache.Flush();
+        }
+
+        // Cancel worker jobs for chunks that went out of range before finishing
+        for (auto it = m_InFlight.begin(); it != m_InFlight.end();)
+        {
+            if (!IsInStreamingRange(it->first))
+            {
+                it->second->Cancelled.store(true, std::memory_order_release);
+                it = m_InFlight.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
         }
     }
 
     void ChunkManager::UpdateChunkLODs(const DirectX::XMFLOAT3& cameraPosition)
     {
+        SM_PROFILE_SCOPE("ChunkManager::UpdateChunkLODs");
+
+        if (m_Config.GeomorphLOD)
+        {
+            UpdateGeomorphLODs(cameraPosition);
+            return;
+        }
+
         for (auto& pair : m_Chunks)
         {
             Chunk* chunk = pair.second.get();
@@ -362,7 +1723,7 @@ namespace PCG
                 continue;
             }
 
-            float distance = CalculateChunkDistance(pair.first, cameraPosition);
+            float distance = CalculateLODDistance(pair.first, cameraPosition);
             int newLOD = m_LOD.GetLODLevel(distance);
 
             if (chunk->GetLOD() != newLOD)
@@ -370,58 +1731,468 @@ namespace PCG
                 chunk->SetLOD(newLOD);
 
                 // Rebuild mesh if LOD changed and chunk has mesh
-                if (chunk->NeedsRebuild() && chunk->HasMesh())
+                if (chunk->NeedsRebuild() && (chunk->HasMesh() || chunk->HasPendingMesh()))
+                {
+                    BuildChunkMesh(pair.first, *chunk);
+                }
+            }
+        }
+    }
+
+    void ChunkManager::UpdateGeomorphLODs(const DirectX::XMFLOAT3& cameraPosition)
+    {
+        // Neighbours in ChunkMorphState edge order: -X, +X, -Z, +Z
+        static constexpr int edgeOffsets[4][2] = { { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 } };
+
+        for (auto& pair : m_Chunks)
+        {
+            if (pair.second)
+            {
+                pair.second->SetLOD(m_LOD.GetLODLevel(CalculateLODDistance(pair.first, cameraPosition)));
+            }
+        }
+
+        // Refine chunks next to much finer ones; each pass settles one more LOD step
+        for (int pass = 0; pass < Chunk::MAX_LOD; ++pass)
+        {
+            bool changed = false;
+
+            for (auto& pair : m_Chunks)
+            {
+                Chunk* chunk = pair.second.get();
+                if (!chunk)
+                {
+                    continue;
+                }
+
+                int limit = chunk->GetLOD();
+                for (const auto& offset : edgeOffsets)
+                {
+                    const Chunk* neighbour = GetChunk(ChunkCoord(pair.first.X + offset[0], pair.first.Z + offset[1]));
+                    if (neighbour)
+                    {
+                        limit = std::min(limit, neighbour->GetLOD() + 1);
+                    }
+                }
+
+                if (limit != chunk->GetLOD())
+                {
+                    chunk->SetLOD(limit);
+                    changed = true;
+                }
+            }
+
+            if (!changed)
+            {
+                break;
+            }
+        }
+
+        // Interior morph follows the chunk's own distance; at 1 it matches the next LOD exactly
+        for (auto& pair : m_Chunks)
+        {
+            Chunk* chunk = pair.second.get();
+            if (!chunk)
+            {
+                continue;
+            }
+
+            ChunkMorphState state = chunk->GetMorphState();
+            state.MorphFactor = chunk->GetLOD() < Chunk::MAX_LOD
+                ? m_LOD.GetTransitionFactor(CalculateLODDistance(pair.first, cameraPosition), chunk->GetLOD())
+                : 0.0f;
+            chunk->SetMorphState(state);
+        }
+
+        // Each edge takes the coarser chunk's LOD and morph (the larger morph on equal LODs)
+        for (auto& pair : m_Chunks)
+        {
+            Chunk* chunk = pair.second.get();
+            if (!chunk)
+            {
+                continue;
+            }
+
+            ChunkMorphState state = chunk->GetMorphState();
+            for (int edge = 0; edge < 4; ++edge)
+            {
+                state.EdgeLOD[edge] = chunk->GetLOD();
+                state.EdgeMorph[edge] = state.MorphFactor;
+
+                const Chunk* neighbour = GetChunk(ChunkCoord(
+                    pair.first.X + edgeOffsets[edge][0], pair.first.Z + edgeOffsets[edge][1]));
+                if (!neighbour)
+                {
+                    continue;
+                }
+
+                const float neighbourMorph = neighbour->GetMorphState().MorphFactor;
+                if (neighbour->GetLOD() > chunk->GetLOD())
+                {
+                    state.EdgeLOD[edge] = neighbour->GetLOD();
+                    state.EdgeMorph[edge] = neighbourMorph;
+                }
+                else if (neighbour->GetLOD() == chunk->GetLOD())
                 {
-                    chunk->RebuildMesh(m_Core);
+                    state.EdgeMorph[edge] = std::max(state.MorphFactor, neighbourMorph);
                 }
             }
+
+            chunk->SetMorphState(state);
         }
     }
 
     void ChunkManager::UpdateVisibleChunksList()
     {
+        SM_PROFILE_SCOPE("ChunkManager::UpdateVisibleChunksList");
+
         m_VisibleChunks.clear();
         m_VisibleChunks.reserve(m_Chunks.size());
+        m_CullCandidates.clear();
+        m_CullingStats = ChunkCullingStats();
+
+        const bool frustumCulling = m_Config.FrustumCulling && m_HasFrustum;
 
         for (auto& pair : m_Chunks)
         {
             Chunk* chunk = pair.second.get();
-            if (chunk && chunk->HasMesh())
+            if (!chunk || !chunk->HasMesh())
+            {
+                continue;
+            }
+
+            m_CullingStats.Candidates++;
+
+            if (frustumCulling && !m_Frustum.Intersects(GetChunkBounds(*chunk)))
+            {
+                m_CullingStats.FrustumCulled++;
+                continue;
+            }
+
+            m_CullCandidates.push_back(chunk);
+        }
+
+        if (m_Config.HorizonCulling)
+        {
+            ApplyHorizonCulling(m_CullCandidates);
+        }
+        else
+        {
+            m_VisibleChunks.insert(m_VisibleChunks.end(), m_CullCandidates.begin(), m_CullCandidates.end());
+        }
+
+        m_CullingStats.Drawn = static_cast<uint32_t>(m_VisibleChunks.size());
+    }
+
+    void ChunkManager::ApplyHorizonCulling(const std::vector<Chunk*>& candidates)
+    {
+        constexpr int HORIZON_BINS = 256;
+        constexpr float PI = 3.14159265358979323846f;
+        constexpr float BIN_WIDTH = 2.0f * PI / static_cast<float>(HORIZON_BINS);
+
+        struct Occluder
+        {
+            Chunk* Target;
+            float NearDistance;   ///< Closest XZ distance from the camera
+            float FarDistance;    ///< Furthest XZ distance from the camera
+            float AngleMin;       ///< Azimuth span (radians, AngleMin <= AngleMax < AngleMin + PI)
+            float AngleMax;
+        };
+
+        const float camX = m_LastCameraPosition.x;
+        const float camY = m_LastCameraPosition.y;
+        const float camZ = m_LastCameraPosition.z;
+        const float chunkSize = Chunk::GetWorldSize();
+
+        // Chunks under the camera are always drawn and never occlude
+        std::vector<Occluder> occluders;
+        occluders.reserve(candidates.size());
+        for (Chunk* chunk : candidates)
+        {
+            DirectX::XMFLOAT3 origin = chunk->GetWorldPosition();
+            float minX = origin.x - camX;
+            float minZ = origin.z - camZ;
+            float maxX = minX + chunkSize;
+            float maxZ = minZ + chunkSize;
+
+            float nearX = std::max({ minX, -maxX, 0.0f });
+            float nearZ = std::max({ minZ, -maxZ, 0.0f });
+            float nearDistance = std::sqrt(nearX * nearX + nearZ * nearZ);
+            if (nearDistance <= 0.0f)
             {
                 m_VisibleChunks.push_back(chunk);
+                continue;
+            }
+
+            float farX = std::max(std::abs(minX), std::abs(maxX));
+            float farZ = std::max(std::abs(minZ), std::abs(maxZ));
+
+            // Camera is outside the footprint, so its corners span less than PI
+            float center = std::atan2(minZ + maxZ, minX + maxX);
+            float angleMin = 0.0f;
+            float angleMax = 0.0f;
+            const float cornersX[4] = { minX, maxX, minX, maxX };
+            const float cornersZ[4] = { minZ, minZ, maxZ, maxZ };
+            for (int corner = 0; corner < 4; ++corner)
+            {
+                float delta = std::atan2(cornersZ[corner], cornersX[corner]) - center;
+                if (delta > PI) delta -= 2.0f * PI;
+                if (delta < -PI) delta += 2.0f * PI;
+                angleMin = std::min(angleMin, delta);
+                angleMax = std::max(angleMax, delta);
+            }
+
+            occluders.push_back({ chunk, nearDistance, std::sqrt(farX * farX + farZ * farZ),
+                                  center + angleMin, center + angleMax });
+        }
+
+        // Front to back, so every occluder is seen before what it hides
+        std::sort(occluders.begin(), occluders.end(), [](const Occluder& a, const Occluder& b) {
+            return a.NearDistance < b.NearDistance;
+        });
+
+        m_Horizon.assign(HORIZON_BINS, -std::numeric_limits<float>::infinity());
+        auto bin = [](int index) { return ((index % HORIZON_BINS) + HORIZON_BINS) % HORIZON_BINS; };
+
+        // Occluders only raise the horizon once they lie entirely in front of
+        // the chunk being tested; pending ones are ordered by far distance
+        std::vector<size_t> pending;
+        auto farther = [&occluders](size_t a, size_t b) {
+            return occluders[a].FarDistance > occluders[b].FarDistance;
+        };
+
+        for (size_t i = 0; i < occluders.size(); ++i)
+        {
+            const Occluder& target = occluders[i];
+
+            while (!pending.empty() && occluders[pending.front()].FarDistance <= target.NearDistance)
+            {
+                const Occluder& occluder = occluders[pending.front()];
+                std::pop_heap(pending.begin(), pending.end(), farther);
+                pending.pop_back();
+
+                // Every ray in a fully covered bin crosses the footprint, whose
+                // terrain is at least MinHeight everywhere
+                float rise = occluder.Target->GetMinHeight() - camY;
+                float slope = rise / (rise >= 0.0f ? occluder.FarDistance : occluder.NearDistance);
+
+                int first = static_cast<int>(std::ceil(occluder.AngleMin / BIN_WIDTH));
+                int last = static_cast<int>(std::floor(occluder.AngleMax / BIN_WIDTH));
+                for (int b = first; b < last; ++b)
+                {
+                    float& horizon = m_Horizon[bin(b)];
+                    horizon = std::max(horizon, slope);
+                }
+            }
+
+            // Steepest slope to any point of the target
+            float rise = target.Target->GetMaxHeight() - camY;
+            float slope = rise / (rise >= 0.0f ? target.NearDistance : target.FarDistance);
+
+            bool occluded = true;
+            int first = static_cast<int>(std::floor(target.AngleMin / BIN_WIDTH));
+            int last = static_cast<int>(std::floor(target.AngleMax / BIN_WIDTH));
+            for (int b = first; b <= last && occluded; ++b)
+            {
+                occluded = m_Horizon[bin(b)] > slope;
+            }
+
+            if (occluded)
+            {
+                m_CullingStats.HorizonCulled++;
+            }
+            else
+            {
+                m_VisibleChunks.push_back(target.Target);
             }
+
+            // Hidden chunks still block what lies behind them
+            pending.push_back(i);
+            std::push_heap(pending.begin(), pending.end(), farther);
         }
     }
 
+    SM::BoundingBox ChunkManager::GetChunkBounds(const Chunk& chunk)
+    {
+        DirectX::XMFLOAT3 origin = chunk.GetWorldPosition();
+        float size = Chunk::GetWorldSize();
+
+        SM::BoundingBox box;
+        box.Min = DirectX::XMFLOAT3(origin.x, chunk.GetMinHeight(), origin.z);
+        box.Max = DirectX::XMFLOAT3(origin.x + size, chunk.GetMaxHeight(), origin.z + size);
+        return box;
+    }
+
     std::unique_ptr<Chunk> ChunkManager::CreateChunk(const ChunkCoord& coord)
     {
         auto chunk = std::make_unique<Chunk>(coord);
 
-        // Generate height data using a custom function based on settings
-        chunk->GenerateCustom([this](float worldX, float worldZ) -> float {
-            // Use FBM for terrain generation
-            static PerlinNoise noise(m_Config.TerrainSettings.Seed);
-            static FBM fbm(&noise);
+        // Generate the whole height grid in one batched call (one SIMD pass per octave)
+        const HeightmapSettings& terrain = m_Config.TerrainSettings;
 
-            float height;
-            if (m_Config.TerrainSettings.ApplyDomainWarp)
+        chunk->GenerateBatch([&](float originX, float originZ, float step, int verticesPerSide, float* heights) {
+            if (m_GPUGenerator)
             {
-                height = fbm.WarpedSample(worldX, worldZ,
-                    m_Config.TerrainSettings.Noise,
-                    m_Config.TerrainSettings.WarpStrength);
+                // Chunks tile an unbounded world, so (like the CPU path) skip the
+                // region-relative falloff and terracing
+                HeightmapSettings gpuSettings = terrain;
+                gpuSettings.ApplyFalloffMap = false;
+                gpuSettings.ApplyTerracing = false;
+
+                GPUHeightmapRegion region;
+                region.OriginX = originX;
+                region.OriginY = originZ;
+                region.Step = step;
+                region.Width = verticesPerSide;
+                region.Height = verticesPerSide;
+
+                if (m_GPUGenerator->GenerateHeights(gpuSettings, region, heights))
+                {
+                    return;
+                }
             }
-            else
+
+            SampleTerrainGrid(originX, originZ, step, verticesPerSide, verticesPerSide, heights);
+        });
+
+        GenerateChunkApron(*chunk);
+        GenerateChunkBiomes(*chunk);
+        return chunk;
+    }
+
+    void ChunkManager::GenerateChunkApron(Chunk& chunk) const
+    {
+        if (!m_Config.ChunkApron || !chunk.IsGenerated())
+        {
+            return;
+        }
+
+        // Same sampling as the CPU path of CreateChunk. The apron matches a
+        // neighbour's edge heights exactly only if that neighbour was generated
+        // on the CPU and is unquantized: GPU heights can differ slightly from
+        // the CPU kernel, and QuantizedHeights decodes each edge with its own
+        // chunk's range.
+        chunk.GenerateApron([this](float originX, float originZ, float step, int width, int height, float* heights) {
+            SampleTerrainGrid(originX, originZ, step, width, height, heights);
+        });
+    }
+
+    void ChunkManager::SampleTerrainGrid(float originX, float originZ, float step, int width, int height, float* heights) const
+    {
+        const HeightmapSettings& terrain = m_Config.TerrainSettings;
+        const FBMPresets::TerrainKernel& kernel = *m_TerrainKernel;
+
+        if (terrain.ApplyDomainWarp)
+        {
+            kernel.WarpedSampleGrid(originX, originZ, step, width, height, terrain.WarpStrength, heights);
+        }
+        else
+        {
+            kernel.SampleGrid(originX, originZ, step, width, height, heights);
+        }
+
+        // Remap from [-1, 1] to height range
+        const int count = width * height;
+        for (int i = 0; i < count; ++i)
+        {
+            float h = (heights[i] + 1.0f) * 0.5f;
+            heights[i] = terrain.MinHeight + h * (terrain.MaxHeight - terrain.MinHeight);
+        }
+    }
+
+    void ChunkManager::GenerateChunkBiomes(Chunk& chunk) const
+    {
+        if (!m_MoistureKernel || !m_TemperatureKernel || !chunk.IsGenerated())
+        {
+            return;
+        }
+
+        constexpr int vertexCount = Chunk::SIZE + 1;
+        constexpr int fieldCount = Chunk::SIZE / BIOME_FIELD_STEP + 1;
+        static_assert(Chunk::SIZE % BIOME_FIELD_STEP == 0, "Biome field samples must land on the chunk edges");
+
+        // Coarse fields on the same grid origin as the heights, so neighbouring chunks agree on their shared edge
+        DirectX::XMFLOAT3 origin = chunk.GetWorldPosition();
+        const float fieldStep = static_cast<float>(BIOME_FIELD_STEP) * Chunk::SCALE;
+
+        std::array<float, fieldCount * fieldCount> moistureField;
+        std::array<float, fieldCount * fieldCount> temperatureField;
+        m_MoistureKernel->SampleGrid(origin.x, origin.z, fieldStep, fieldCount, fieldCount, moistureField.data());
+        m_TemperatureKernel->SampleGrid(origin.x, origin.z, fieldStep, fieldCount, fieldCount, temperatureField.data());
+
+        // Biome rules expect heights normalized to the terrain's range
+        const HeightmapSettings& terrain = m_Config.TerrainSettings;
+        const float heightRange = terrain.MaxHeight - terrain.MinHeight;
+        const float invHeightRange = heightRange > 0.0f ? 1.0f / heightRange : 0.0f;
+
+        std::array<float, Chunk::VERTEX_COUNT> heights;
+        std::array<float, Chunk::VERTEX_COUNT> moisture;
+        std::array<float, Chunk::VERTEX_COUNT> temperature;
+        const std::vector<float>& chunkHeights = chunk.GetHeights();
+
+        for (int z = 0; z < vertexCount; ++z)
+        {
+            const int fz = std::min(z / BIOME_FIELD_STEP, fieldCount - 2);
+            const float tz = static_cast<float>(z - fz * BIOME_FIELD_STEP) / static_cast<float>(BIOME_FIELD_STEP);
+
+            for (int x = 0; x < vertexCount; ++x)
             {
-                height = fbm.Sample(worldX, worldZ, m_Config.TerrainSettings.Noise);
+                const int fx = std::min(x / BIOME_FIELD_STEP, fieldCount - 2);
+                const float tx = static_cast<float>(x - fx * BIOME_FIELD_STEP) / static_cast<float>(BIOME_FIELD_STEP);
+
+                auto bilinear = [&](const std::array<float, fieldCount * fieldCount>& field) {
+                    const size_t i = static_cast<size_t>(fz) * fieldCount + fx;
+                    float top = field[i] + (field[i + 1] - field[i]) * tx;
+                    float bottom = field[i + fieldCount] + (field[i + fieldCount + 1] - field[i + fieldCount]) * tx;
+
+                    // Remap from [-1, 1] to [0, 1]
+                    return std::clamp(((top + (bottom - top) * tz) + 1.0f) * 0.5f, 0.0f, 1.0f);
+                };
+
+                const size_t index = static_cast<size_t>(z) * vertexCount + x;
+                heights[index] = (chunkHeights[index] - terrain.MinHeight) * invHeightRange;
+                moisture[index] = bilinear(moistureField);
+                temperature[index] = bilinear(temperatureField);
             }
+        }
 
-            // Remap from [-1, 1] to height range
-            height = (height + 1.0f) * 0.5f;
-            return m_Config.TerrainSettings.MinHeight +
-                   height * (m_Config.TerrainSettings.MaxHeight - m_Config.TerrainSettings.MinHeight);
-        });
+        std::vector<BiomeType> biomes(Chunk::VERTEX_COUNT);
+        m_BiomeMap.ClassifyBatch(heights.data(), moisture.data(), temperature.data(), biomes.size(), biomes.data());
+        chunk.SetBiomeData(std::move(biomes));
+    }
+
+    std::unique_ptr<Chunk> ChunkManager::LoadCachedChunk(const ChunkCoord& coord)
+    {
+        std::vector<float> heights;
+        float minHeight = 0.0f;
+        float maxHeight = 0.0f;
+
+        // RAM first, then disk
+        if (!m_HeightLRU.Take(coord, heights, minHeight, maxHeight) &&
+            !m_DiskCache.Load(coord, heights, minHeight, maxHeight))
+        {
+            return nullptr;
+        }
+
+        auto chunk = std::make_unique<Chunk>(coord);
+        if (!chunk->SetHeightData(std::move(heights), minHeight, maxHeight))
+        {
+            return nullptr;
+        }
 
+        // Caches hold heights only; the apron and biomes are cheap to resample
+        GenerateChunkApron(*chunk);
+        GenerateChunkBiomes(*chunk);
         return chunk;
     }
 
+    void ChunkManager::StoreCachedChunk(const Chunk& chunk)
+    {
+        // Quantized chunks were stored before quantizing (see AddChunk)
+        if (m_DiskCache.IsInitialized() && chunk.IsGenerated() && !chunk.IsQuantized())
+        {
+            m_DiskCache.Store(chunk.GetCoord(), chunk.GetHeights(), chunk.GetMinHeight(), chunk.GetMaxHeight());
+        }
+    }
+
 } // namespace PCG
@@ -6,18 +6,31 @@
  *
  * Manages terrain chunks around the camera position, handling:
  * - Dynamic loading/unloading based on view distance
+ * - Extra observers (other players, split-screen views) sharing loaded chunks
  * - LOD level management
  * - Chunk generation and mesh building
+ * - Frustum and horizon culling of the visible list
  */
 
+#include "pcg/Biome.h"
 #include "pcg/Chunk.h"
 #include "pcg/TerrainLOD.h"
 #include "pcg/HeightmapGenerator.h"
+#include "pcg/FBM.h"
+#include "pcg/ChunkWorkerPool.h"
+#include "pcg/ChunkCache.h"
+#include "pcg/ChunkHeightLRU.h"
+#include "pcg/ChunkGrid.h"
+#include "pcg/StreamingScheduler.h"
+#include "renderer/Frustum.h"
 
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <memory>
 #include <queue>
+#include <span>
+#include <string>
 #include <DirectXMath.h>
 
 namespace SM
@@ -28,6 +41,8 @@ namespace SM
 
 namespace PCG
 {
+    class GPUHeightmapGenerator;
+
     /**
      * @brief Configuration for the chunk manager
      */
@@ -35,11 +50,82 @@ namespace PCG
     {
         float ViewDistance = 300.0f;       ///< Maximum view distance for chunks
         float UnloadDistance = 350.0f;     ///< Distance at which chunks are unloaded
-        int MaxChunksPerFrame = 2;         ///< Max chunks to generate per frame
-        int MaxMeshBuildsPerFrame = 4;     ///< Max mesh builds per frame
-        bool AsyncGeneration = false;       ///< Enable async chunk generation (future)
+        int MaxChunksPerFrame = 2;         ///< Max chunks to generate per frame (when StreamingBudgetMs is 0)
+        float ViewDirectionPriority = 1.0f; ///< Generation delay for chunks behind the camera (0 = nearest first only)
+        bool PredictivePrefetch = true;    ///< Queue chunks ahead of a moving camera (needs a velocity)
+        float PrefetchSeconds = 2.0f;      ///< How far ahead the camera is projected
+        float PrefetchMinSpeed = 5.0f;     ///< Slower cameras do not prefetch (units per second)
+        int PrefetchBudget = 64;           ///< Max chunks queued per prefetch pass
+        int MaxMeshBuildsPerFrame = 4;     ///< Max mesh builds per frame (when StreamingBudgetMs is 0)
+        float StreamingBudgetMs = 2.0f;    ///< Main-thread generation/mesh time per frame (0 = use the counts above)
+        float TargetFrameTimeMs = 1000.0f / 60.0f; ///< Streaming backs off while frames take longer (0 = never)
+        bool AsyncGeneration = false;      ///< Generate chunk heights on worker threads
+        int MaxInFlightGenerations = 32;   ///< Max chunks queued on or running in workers
+        bool GPUGeneration = false;        ///< Generate chunk heights in a compute shader (read back to CPU)
+        bool SharedLODIndices = false;     ///< Skip per-chunk index buffers (TerrainRenderer shares one per LOD)
+        bool GeomorphLOD = false;          ///< Build each mesh once at full resolution; morph and stitch LODs on the GPU
+        bool FrustumCulling = true;        ///< Drop chunks outside the view frustum (needs a view-projection)
+        bool HorizonCulling = false;       ///< Drop chunks hidden behind nearer terrain (coarse, conservative)
+        bool DiskCache = false;            ///< Persist generated heights and reload them instead of regenerating
+        std::string DiskCachePath = "cache/terrain"; ///< Root directory of the on-disk chunk cache
+        size_t HeightLRUBudget = 8 * 1024 * 1024;    ///< Bytes of unloaded heightfields kept in RAM (0 = off)
+        bool QuantizedHeights = false;     ///< Keep loaded chunks' heights as 16 bits between their min and max (half the RAM)
+        bool ChunkBiomes = true;           ///< Classify a biome per height sample while generating each chunk
+        bool ChunkApron = true;            ///< Sample one height past each chunk edge so edge normals match neighbours
 
         HeightmapSettings TerrainSettings; ///< Settings for terrain generation
+        BiomeGenerator::Settings BiomeSettings; ///< Moisture/temperature noise (Width, Height, latitude and ClimateStep are unused)
+    };
+
+    /**
+     * @brief A point chunks are streamed around besides the camera
+     *
+     * Observers share one chunk set: a chunk wanted by several is generated
+     * once and stays loaded while any of them keeps it in range.
+     */
+    struct ChunkObserver
+    {
+        DirectX::XMFLOAT3 Position = { 0.0f, 0.0f, 0.0f };
+        float Radius = 0.0f;               ///< Load radius in world units (0 = ViewDistance); unloads past Radius * UnloadDistance / ViewDistance
+        float Priority = 1.0f;             ///< Generation weight: distance is divided by it (the camera has 1)
+        bool AffectsLOD = true;            ///< Chunks near it get the LOD its distance asks for
+    };
+
+    using ChunkObserverId = uint32_t;
+    constexpr ChunkObserverId INVALID_CHUNK_OBSERVER = 0;
+
+    /**
+     * @brief Visible-list culling results from the last update
+     */
+    struct ChunkCullingStats
+    {
+        uint32_t Candidates = 0;      ///< Loaded chunks with a mesh
+        uint32_t FrustumCulled = 0;   ///< Rejected by the view frustum
+        uint32_t HorizonCulled = 0;   ///< Rejected by the terrain horizon
+        uint32_t Drawn = 0;           ///< Chunks left in the visible list
+    };
+
+    /**
+     * @brief How a TerrainBrush changes the heights it covers
+     */
+    enum class TerrainBrushMode : uint8_t
+    {
+        Raise,      ///< Add Strength at the centre, fading out with Falloff
+        Lower,      ///< Subtract Strength at the centre, fading out with Falloff
+        Flatten,    ///< Blend toward Center.y by Strength (0-1), fading out with Falloff
+        Crater      ///< Dig a bowl Strength deep with a raised rim (ignores Falloff)
+    };
+
+    /**
+     * @brief One application of a sculpting brush (see ChunkManager::ApplyBrush)
+     */
+    struct TerrainBrush
+    {
+        DirectX::XMFLOAT3 Center = { 0.0f, 0.0f, 0.0f }; ///< World position (Y is the Flatten target)
+        float Radius = 8.0f;               ///< World units
+        float Strength = 1.0f;             ///< Height change at the centre (Flatten: blend factor)
+        float Falloff = 0.5f;              ///< Outer fraction of the radius the effect fades over (0 = hard edge)
+        TerrainBrushMode Mode = TerrainBrushMode::Raise;
     };
 
     /**
@@ -55,7 +141,7 @@ namespace PCG
     {
     public:
         ChunkManager();
-        ~ChunkManager() = default;
+        ~ChunkManager();
 
         // Prevent copying
         ChunkManager(const ChunkManager&) = delete;
@@ -67,7 +153,8 @@ namespace PCG
 
         /**
          * @brief Initialize the chunk manager
-         * @param core DX12 core for GPU resource creation
+         * @param core DX12 core for GPU resource creation (null = headless:
+         *             chunks are generated and vertices built, but no meshes)
          * @param config Configuration settings
          * @return true if initialization succeeded
          */
@@ -94,6 +181,26 @@ namespace PCG
          */
         void Update(const DirectX::XMFLOAT3& cameraPosition);
 
+        /**
+         * @brief Update chunks and cull the visible list against a view
+         * @param cameraPosition Current camera position in world space
+         * @param viewProjection Camera view-projection matrix used for frustum culling
+         */
+        void Update(const DirectX::XMFLOAT3& cameraPosition, const DirectX::XMMATRIX& viewProjection);
+
+        /**
+         * @brief Update chunks, cull, and prefetch along the camera's path
+         * @param cameraPosition Current camera position in world space
+         * @param viewProjection Camera view-projection matrix used for frustum culling
+         * @param cameraVelocity Camera velocity in units per second
+         *
+         * With PredictivePrefetch the camera is projected PrefetchSeconds
+         * ahead; chunks around that point are queued (and kept loaded)
+         * early, and chunks along the direction of travel are generated first.
+         */
+        void Update(const DirectX::XMFLOAT3& cameraPosition, const DirectX::XMMATRIX& viewProjection,
+                    const DirectX::XMFLOAT3& cameraVelocity);
+
         /**
          * @brief Force immediate loading of chunks around a position
          * @param position World position
@@ -103,6 +210,66 @@ namespace PCG
          */
         void ForceLoadAround(const DirectX::XMFLOAT3& position, float radius);
 
+        /**
+         * @brief Generate a rectangle of chunks into the disk cache without loading them
+         * @param first One corner chunk (inclusive)
+         * @param last Opposite corner chunk (inclusive)
+         * @return Chunks generated and stored; chunks already cached are skipped
+         *
+         * Needs DiskCache. Works one cache region at a time: its chunks are
+         * generated across the job system's workers (on this thread if the
+         * job system is not running), then appended with one flush. The
+         * worldbake tool uses it to ship pre-generated spawn areas.
+         */
+        uint32_t BakeRegion(const ChunkCoord& first, const ChunkCoord& last);
+
+        /**
+         * @brief Report the previous frame's duration for streaming back-off
+         * @param seconds Frame time in seconds
+         */
+        void SetLastFrameTime(float seconds) { m_LastFrameSeconds = seconds; }
+
+        // ====================================================================
+        // Observers
+        // ====================================================================
+
+        /**
+         * @brief Stream chunks around another point as well as the camera
+         * @param observer Position, radius and priority
+         * @return Handle for SetObserver and RemoveObserver
+         *
+         * The camera passed to Update stays the primary observer. Chunks
+         * are queued on the next Update.
+         */
+        ChunkObserverId AddObserver(const ChunkObserver& observer);
+
+        /**
+         * @brief Replace an observer's settings
+         * @return false if id is not registered
+         */
+        bool SetObserver(ChunkObserverId id, const ChunkObserver& observer);
+
+        /**
+         * @brief Move an observer (the common per-frame call)
+         * @return false if id is not registered
+         */
+        bool SetObserverPosition(ChunkObserverId id, const DirectX::XMFLOAT3& position);
+
+        /**
+         * @brief Stop streaming around an observer
+         *
+         * Its chunks unload on the next Update unless the camera or another
+         * observer still keeps them.
+         */
+        void RemoveObserver(ChunkObserverId id);
+
+        size_t GetObserverCount() const { return m_Observers.size(); }
+
+        /**
+         * @brief Get how many registered observers (camera excluded) keep a chunk loaded
+         */
+        uint32_t GetObserverRefCount(const ChunkCoord& coord) const;
+
         // ====================================================================
         // Rendering
         // ====================================================================
@@ -113,15 +280,60 @@ namespace PCG
          */
         const std::vector<Chunk*>& GetVisibleChunks() const { return m_VisibleChunks; }
 
+        /**
+         * @brief Get culling results from the last visible-list update
+         */
+        const ChunkCullingStats& GetCullingStats() const { return m_CullingStats; }
+
+        /**
+         * @brief Get the world-space bounds of a chunk
+         */
+        static SM::BoundingBox GetChunkBounds(const Chunk& chunk);
+
         /**
          * @brief Get chunk count for debugging
          */
         size_t GetLoadedChunkCount() const { return m_Chunks.size(); }
 
+        /**
+         * @brief Get every loaded chunk, visible or not (e.g. shadow casters outside the view)
+         */
+        const ChunkMap& GetLoadedChunks() const { return m_Chunks; }
+
         /**
          * @brief Get pending generation count
          */
-        size_t GetPendingCount() const { return m_PendingGeneration.size(); }
+        size_t GetPendingCount() const { return m_QueuedGeneration.size(); }
+
+        /**
+         * @brief Get the number of chunks being generated on worker threads
+         */
+        size_t GetInFlightCount() const { return m_InFlight.size(); }
+
+        /**
+         * @brief Get the number of chunks generated since Initialize (cache loads excluded)
+         */
+        uint64_t GetGeneratedChunkCount() const { return m_GeneratedChunks; }
+
+        /**
+         * @brief Get the CPU memory held by loaded chunks' height grids, aprons, height pyramids and biome grids
+         */
+        size_t GetResidentChunkBytes() const;
+
+        /**
+         * @brief Get on-disk chunk cache counters (all zero unless DiskCache is enabled)
+         */
+        const ChunkCacheStats& GetDiskCacheStats() const { return m_DiskCache.GetStats(); }
+
+        /**
+         * @brief Get in-memory heightfield LRU counters
+         */
+        const ChunkHeightLRUStats& GetHeightLRUStats() const { return m_HeightLRU.GetStats(); }
+
+        /**
+         * @brief Get the streaming time budget and learned per-task costs
+         */
+        const StreamingSchedulerStats& GetStreamingStats() const { return m_Scheduler.GetStats(); }
 
         // ====================================================================
         // Configuration
@@ -161,6 +373,99 @@ namespace PCG
          */
         float GetHeightAt(float worldX, float worldZ) const;
 
+        /**
+         * @brief Get terrain heights at many world positions
+         * @param positions World (X, Z) positions
+         * @param heights Receives one height per position (0 where no chunk is loaded);
+         *                must be at least as long as positions
+         *
+         * Consecutive positions in the same chunk reuse its lookup, so sort
+         * or cluster queries spatially for best throughput.
+         */
+        void GetHeightsAt(std::span<const DirectX::XMFLOAT2> positions, std::span<float> heights) const;
+
+        /**
+         * @brief Sample terrain heights on a regular grid straight from the terrain kernel
+         * @param originX World X of the first sample
+         * @param originZ World Z of the first sample
+         * @param step World distance between samples
+         * @param width Samples along X
+         * @param height Samples along Z
+         * @param heights Receives width * height heights, row-major by Z
+         *
+         * Same sampling as CPU chunk generation, so the results match
+         * generated chunks wherever they exist, but the area need not be
+         * loaded (e.g. for renderers that look past the view distance).
+         * Safe to call from workers.
+         */
+        void SampleTerrainGrid(float originX, float originZ, float step, int width, int height, float* heights) const;
+
+        /**
+         * @brief Find where a ray first hits the loaded terrain
+         * @param ray World-space ray (Direction need not be normalized)
+         * @return The nearest hit within ray.MaxDistance world units; Hit is
+         *         false if the ray misses every loaded chunk
+         *
+         * Walks the chunks the ray crosses in order and descends each one's
+         * min/max height pyramid, so cost grows with the chunks crossed, not
+         * with the distance stepped. Unloaded chunks are transparent.
+         */
+        TerrainHit Raycast(const TerrainRay& ray) const;
+
+        /**
+         * @brief Find where many rays first hit the loaded terrain
+         * @param rays World-space rays
+         * @param hits Receives one result per ray; must be at least as long as rays
+         *
+         * Large batches are split across the job system's workers. Like the
+         * other terrain queries, must not overlap with Update.
+         */
+        void Raycast(std::span<const TerrainRay> rays, std::span<TerrainHit> hits) const;
+
+        // ====================================================================
+        // Terrain Editing
+        // ====================================================================
+
+        /**
+         * @brief Sculpt the loaded terrain with a brush
+         * @param brush Brush shape and position
+         * @return Number of chunks whose heights changed
+         */
+        uint32_t ApplyBrush(const TerrainBrush& brush);
+
+        /**
+         * @brief Change the loaded terrain's heights inside a world-space rectangle
+         * @param minX Rectangle min X (inclusive)
+         * @param minZ Rectangle min Z
+         * @param maxX Rectangle max X (inclusive)
+         * @param maxZ Rectangle max Z
+         * @param edit Called per height sample as edit(worldX, worldZ, height); must
+         *             depend only on its arguments, since samples on chunk edges and
+         *             in aprons are visited once per chunk holding them
+         * @return Number of chunks whose heights changed
+         *
+         * The next Update re-uploads only the mesh rows each edit reaches
+         * (Chunk::UpdateMeshRegion), rebuilding a chunk's mesh only when the
+         * edit leaves its height range or the mesh is still uploading.
+         * Unloaded chunks are not edited. Edited heights go to the height
+         * LRU and disk cache on unload like generated ones. Must not overlap
+         * with Update.
+         */
+        uint32_t DeformTerrain(float minX, float minZ, float maxX, float maxZ, const Chunk::HeightEditFunc& edit);
+
+        /**
+         * @brief Get the biome at world position (nearest height sample)
+         * @param worldX World X coordinate
+         * @param worldZ World Z coordinate
+         * @return Biome type, or BiomeType::Count if no classified chunk is loaded there
+         */
+        BiomeType GetBiomeAt(float worldX, float worldZ) const;
+
+        /**
+         * @brief Get the biome classifier (per-biome data such as ResourceDensity)
+         */
+        const BiomeMap& GetBiomeMap() const { return m_BiomeMap; }
+
         /**
          * @brief Get chunk at world position
          * @param worldX World X coordinate
@@ -188,6 +493,21 @@ namespace PCG
          */
         ChunkCoord WorldToChunkCoord(float worldX, float worldZ) const;
 
+        /**
+         * @brief Sample a chunk's interpolated height at a world position inside it
+         */
+        static float SampleChunkHeight(const Chunk& chunk, float worldX, float worldZ);
+
+        /**
+         * @brief Take ownership of a loaded chunk and index it
+         */
+        void AddChunk(const ChunkCoord& coord, std::unique_ptr<Chunk> chunk);
+
+        /**
+         * @brief Size the lookup grid to cover everything within the unload distance
+         */
+        void ResizeChunkGrid();
+
         /**
          * @brief Calculate distance from camera to chunk center
          */
@@ -195,44 +515,203 @@ namespace PCG
 
         /**
          * @brief Determine which chunks should be loaded
+         *
+         * The wanted set is a disc of chunks around the camera chunk. It is
+         * rescanned in full only when invalidated; on a chunk-boundary
+         * crossing only the strips entering and leaving the disc are visited.
          */
         void DetermineVisibleChunks(const DirectX::XMFLOAT3& cameraPosition);
 
         /**
-         * @brief Queue a chunk for generation
+         * @brief Compute the disc row half-widths for the current view distance
+         */
+        void BuildStreamingRing();
+
+        /**
+         * @brief Compute an observer's wanted and kept discs from its radius
+         */
+        void BuildObserverDiscs(const ChunkObserver& observer, std::vector<int>& wantHalfWidths,
+                                std::vector<int>& keepHalfWidths) const;
+
+        /**
+         * @brief Move observer references and queue observer discs
+         *
+         * Like the camera disc, only the strips an observer's discs enter and
+         * leave are visited when it crosses a chunk boundary. The kept disc
+         * holds a reference on each chunk; the wanted disc is queued.
+         */
+        void UpdateObservers();
+
+        /**
+         * @brief Check if a registered observer other than exclude wants a chunk generated
+         */
+        bool IsWantedByObserver(const ChunkCoord& coord, ChunkObserverId exclude = INVALID_CHUNK_OBSERVER) const;
+
+        /**
+         * @brief Drop a queued chunk unless the camera or another observer still wants it
+         */
+        void DropQueuedGeneration(const ChunkCoord& coord, ChunkObserverId exclude);
+
+        /**
+         * @brief Release an observer's references and queued chunks
+         */
+        void ReleaseObserver(ChunkObserverId id);
+
+        /**
+         * @brief Distance that picks a chunk's LOD: the nearest of the camera and LOD-affecting observers
+         */
+        float CalculateLODDistance(const ChunkCoord& coord, const DirectX::XMFLOAT3& cameraPosition) const;
+
+        /**
+         * @brief Queue a chunk for generation (no-op if already queued)
          */
         void QueueChunkGeneration(const ChunkCoord& coord);
 
+        /**
+         * @brief Pop the highest-priority queued chunk
+         * @return false if the queue is empty
+         */
+        bool PopPendingGeneration(ChunkCoord& coord);
+
+        /**
+         * @brief Recompute every queued chunk's priority after the camera moved or turned
+         */
+        void ReprioritizePendingGenerations();
+
+        /**
+         * @brief Generation priority of a chunk (lower is sooner)
+         *
+         * Distance to the camera, stretched by up to (1 + ViewDirectionPriority)
+         * for chunks behind the view direction and shrunk by up to half for
+         * chunks along the direction of travel while prefetching. Observers
+         * whose disc holds the chunk offer distance / Priority; the lowest wins.
+         */
+        float CalculateChunkPriority(const ChunkCoord& coord) const;
+
+        /**
+         * @brief Project the camera ahead and queue the disc around that point
+         *
+         * Runs only when the projected chunk changes; queues the part of its
+         * disc outside the camera's own disc, nearest first, up to PrefetchBudget.
+         */
+        void PrefetchAlongPath();
+
+        /**
+         * @brief Check if a chunk is close enough to the camera (or its projection) or kept by an observer to stay loaded
+         */
+        bool IsInStreamingRange(const ChunkCoord& coord) const;
+
         /**
          * @brief Process pending chunk generations
          */
         void ProcessPendingGenerations();
 
+        /**
+         * @brief Hand pending chunks to the job system (async mode)
+         */
+        void DispatchPendingGenerations();
+
+        /**
+         * @brief Move chunks finished by workers into the chunk map (async mode)
+         */
+        void CollectCompletedGenerations();
+
         /**
          * @brief Process pending mesh builds
          */
         void ProcessPendingMeshBuilds();
 
         /**
-         * @brief Unload chunks beyond unload distance
+         * @brief Build (or rebuild) a chunk's mesh and track its upload
          */
-        void UnloadDistantChunks(const DirectX::XMFLOAT3& cameraPosition);
+        bool BuildChunkMesh(const ChunkCoord& coord, Chunk& chunk);
+
+        /**
+         * @brief Upload the mesh rows of chunks edited since the last update
+         *
+         * Not budgeted: edits should show in the frame after they are made.
+         */
+        void ProcessDirtyChunks();
+
+        /**
+         * @brief Submit this frame's mesh uploads and swap in finished ones
+         *
+         * Never waits: meshes still on the copy queue are checked again next frame.
+         */
+        void ProcessMeshUploads();
+
+        /**
+         * @brief Unload chunks outside the streaming range (see IsInStreamingRange)
+         */
+        void UnloadDistantChunks();
 
         /**
          * @brief Update LOD levels for all chunks
          */
         void UpdateChunkLODs(const DirectX::XMFLOAT3& cameraPosition);
 
+        /**
+         * @brief Update LODs and morph state of geomorphed chunks
+         *
+         * Limits neighbouring chunks to one LOD apart so a single stitch
+         * level closes every edge, then resolves a shared LOD and morph
+         * factor for each edge.
+         */
+        void UpdateGeomorphLODs(const DirectX::XMFLOAT3& cameraPosition);
+
+        /**
+         * @brief Shared body of both Update overloads
+         */
+        void UpdateChunks(const DirectX::XMFLOAT3& cameraPosition);
+
         /**
          * @brief Update the visible chunks list
          */
         void UpdateVisibleChunksList();
 
+        /**
+         * @brief Move chunks not hidden behind nearer terrain into m_VisibleChunks
+         * @param candidates Frustum-visible chunks
+         *
+         * Keeps a per-azimuth horizon of the steepest slope guaranteed to be
+         * blocked by chunks already passed (using their minimum height) and
+         * drops chunks whose maximum height stays below it.
+         */
+        void ApplyHorizonCulling(const std::vector<Chunk*>& candidates);
+
         /**
          * @brief Create and generate a new chunk
          */
         std::unique_ptr<Chunk> CreateChunk(const ChunkCoord& coord);
 
+        /**
+         * @brief Create a chunk from previously generated heights
+         * @return The chunk, or nullptr if neither the height LRU nor the disk cache has it
+         */
+        std::unique_ptr<Chunk> LoadCachedChunk(const ChunkCoord& coord);
+
+        /**
+         * @brief Queue a chunk's heights for the disk cache (no-op if disabled or already cached)
+         */
+        void StoreCachedChunk(const Chunk& chunk);
+
+        /**
+         * @brief Classify a generated chunk's biome grid (no-op if ChunkBiomes is off)
+         *
+         * Moisture and temperature vary slowly, so they are sampled every
+         * BIOME_FIELD_STEP vertices and interpolated. Safe to call from workers.
+         */
+        void GenerateChunkBiomes(Chunk& chunk) const;
+
+        /**
+         * @brief Sample a generated chunk's apron from the terrain kernel (no-op if ChunkApron is off)
+         *
+         * Always sampled on the CPU, also for GPU-generated heights, so it
+         * matches neighbouring edges exactly only for CPU-generated,
+         * unquantized chunks. Safe to call from workers.
+         */
+        void GenerateChunkApron(Chunk& chunk) const;
+
     private:
         // Configuration
         ChunkManagerConfig m_Config;
@@ -243,19 +722,90 @@ namespace PCG
 
         // Terrain generation
         HeightmapGenerator m_Generator;
-
-        // Chunk storage
-        std::unordered_map<ChunkCoord, std::unique_ptr<Chunk>, ChunkHash> m_Chunks;
+        std::unique_ptr<FBMPresets::TerrainKernel> m_TerrainKernel;
+        std::unique_ptr<FBMKernel<SimplexNoise, FBMMode::Standard>> m_MoistureKernel; ///< Set when ChunkBiomes is enabled
+        std::unique_ptr<FBMKernel<PerlinNoise, FBMMode::Standard>> m_TemperatureKernel;
+        BiomeMap m_BiomeMap;
+        static constexpr int BIOME_FIELD_STEP = 4; ///< Vertices between moisture/temperature samples
+        std::unique_ptr<GPUHeightmapGenerator> m_GPUGenerator; ///< Set when GPUGeneration is enabled
+        ChunkCache m_DiskCache;                                ///< Open when DiskCache is enabled
+        ChunkHeightLRU m_HeightLRU;                            ///< Heightfields of recently unloaded chunks
+
+        // Chunk storage: the map owns every chunk; the grid indexes those near the camera
+        ChunkMap m_Chunks;
+        ChunkGrid m_ChunkGrid;
 
         // Generation queues
-        std::queue<ChunkCoord> m_PendingGeneration;  ///< Chunks waiting to be generated
+        struct PendingGeneration
+        {
+            ChunkCoord Coord;
+            float Priority = 0.0f;
+
+            /// Heap order: the lowest priority value is generated first
+            static bool IsLater(const PendingGeneration& a, const PendingGeneration& b) { return a.Priority > b.Priority; }
+        };
+
+        std::vector<PendingGeneration> m_PendingGeneration;         ///< Min-heap on Priority; may hold dequeued entries
+        std::unordered_set<ChunkCoord, ChunkHash> m_QueuedGeneration; ///< Chunks actually waiting to be generated
         std::queue<ChunkCoord> m_PendingMeshBuild;   ///< Chunks waiting for mesh build
+        std::vector<ChunkCoord> m_PendingUploads;    ///< Chunks whose new mesh is uploading
+        std::vector<ChunkCoord> m_DirtyChunks;       ///< Chunks edited since the last update
+
+        // Async generation
+        ChunkWorkerPool m_WorkerPool;
+        std::unordered_map<ChunkCoord, std::shared_ptr<ChunkGenerationJob>, ChunkHash> m_InFlight;
+        std::vector<std::shared_ptr<ChunkGenerationJob>> m_CompletedJobs; ///< Reused collection buffer
+        uint64_t m_GeneratedChunks = 0;
+
+        // Headless mesh builds (no DX12Core)
+        std::vector<TerrainVertex> m_HeadlessVertices;  ///< Reused vertex buffer, discarded after each build
 
         // Visible chunks (updated each frame)
         std::vector<Chunk*> m_VisibleChunks;
+        std::vector<Chunk*> m_CullCandidates;   ///< Reused frustum-pass buffer
+        std::vector<float> m_Horizon;           ///< Reused horizon slopes per azimuth bin
+
+        // Culling
+        SM::Frustum m_Frustum;
+        bool m_HasFrustum = false;              ///< Set by the view-projection Update overload
+        ChunkCullingStats m_CullingStats;
+
+        // Streaming disc
+        std::vector<int> m_RingHalfWidths;      ///< Per row dz in [-r, r]: chunks wanted on each side (-1 = none)
+        bool m_StreamingRingValid = false;      ///< m_LastCameraChunk's disc has been queued
+        DirectX::XMFLOAT2 m_PriorityForward = { 0.0f, 0.0f }; ///< View direction (XZ) the queue was sorted for
+
+        // Observers (the camera aside)
+        struct ObserverState
+        {
+            ChunkObserver Observer;
+            std::vector<int> WantHalfWidths;    ///< Disc queued for generation
+            std::vector<int> KeepHalfWidths;    ///< Disc referenced in m_ObserverRefs
+            ChunkCoord Centre;                  ///< Chunk both discs are placed around
+            bool Placed = false;                ///< Keep disc is referenced around Centre
+            bool Requeue = true;                ///< Queue the whole wanted disc next update
+        };
+
+        std::unordered_map<ChunkObserverId, ObserverState> m_Observers;
+        std::unordered_map<ChunkCoord, uint32_t, ChunkHash> m_ObserverRefs; ///< Observers keeping each chunk
+        ChunkObserverId m_NextObserverId = 1;
+        bool m_ObserversChanged = false;        ///< Priorities need recomputing
+
+        // Predictive prefetch
+        DirectX::XMFLOAT3 m_CameraVelocity = { 0.0f, 0.0f, 0.0f };
+        DirectX::XMFLOAT3 m_PrefetchPosition = { 0.0f, 0.0f, 0.0f }; ///< Projected camera position
+        bool m_Prefetching = false;                                  ///< m_PrefetchPosition is in use
+        ChunkCoord m_LastPrefetchChunk;
+        DirectX::XMFLOAT2 m_PriorityMotion = { 0.0f, 0.0f };         ///< Travel direction (XZ) the queue was sorted for
+        std::vector<PendingGeneration> m_PrefetchCandidates;         ///< Reused prefetch buffer
+
+        // Streaming time budget
+        StreamingScheduler m_Scheduler;
+        float m_LastFrameSeconds = 0.0f;
 
         // Camera tracking
         ChunkCoord m_LastCameraChunk;
+        DirectX::XMFLOAT3 m_LastCameraPosition = { 0.0f, 0.0f, 0.0f };
         bool m_Initialized = false;
     };
 
@@ -0,0 +1,108 @@
+#include "pcg/ChunkWorkerPool.h"
+#include "core/Memory.h"
+#include "core/Profiler.h"
+
+#include <iostream>
+
+namespace PCG
+{
+    ChunkWorkerPool::~ChunkWorkerPool()
+    {
+        Stop();
+    }
+
+    bool ChunkWorkerPool::Start(GenerateFunc generateFunc)
+    {
+        if (IsRunning())
+        {
+            return true;
+        }
+
+        if (!generateFunc)
+        {
+            std::cerr << "[ChunkWorkerPool] Cannot start: no generate function" << std::endl;
+            return false;
+        }
+
+        // Without workers every job would run inline on the main thread
+        if (!SM::JobSystem::Get().IsInitialized())
+        {
+            std::cerr << "[ChunkWorkerPool] Cannot start: job system has no workers" << std::endl;
+            return false;
+        }
+
+        m_GenerateFunc = std::move(generateFunc);
+        m_StopRequested = false;
+        m_Running = true;
+
+        return true;
+    }
+
+    void ChunkWorkerPool::Stop()
+    {
+        if (!IsRunning())
+        {
+            return;
+        }
+
+        // Jobs still queued finish without generating; the one running completes
+        m_StopRequested.store(true, std::memory_order_release);
+        if (SM::JobSystem::Get().IsInitialized())
+        {
+            SM::JobSystem::Get().Wait(m_Counter);
+        }
+        m_Counter.Pending = 0;  // Jobs discarded by a job system shutdown never finish
+        m_Running = false;
+        m_QueuedCount = 0;
+
+        std::lock_guard<std::mutex> lock(m_CompletedMutex);
+        m_Completed.clear();
+    }
+
+    void ChunkWorkerPool::Submit(std::shared_ptr<ChunkGenerationJob> job)
+    {
+        if (!job || !IsRunning())
+        {
+            return;
+        }
+
+        m_QueuedCount.fetch_add(1, std::memory_order_relaxed);
+        SM::JobSystem::Get().RunBackground([this, job = std::move(job)]() { Generate(job); }, &m_Counter);
+    }
+
+    void ChunkWorkerPool::CollectCompleted(std::vector<std::shared_ptr<ChunkGenerationJob>>& out)
+    {
+        std::lock_guard<std::mutex> lock(m_CompletedMutex);
+        if (m_Completed.empty())
+        {
+            return;
+        }
+
+        out.insert(out.end(),
+            std::make_move_iterator(m_Completed.begin()),
+            std::make_move_iterator(m_Completed.end()));
+        m_Completed.clear();
+    }
+
+    void ChunkWorkerPool::Generate(const std::shared_ptr<ChunkGenerationJob>& job)
+    {
+        m_QueuedCount.fetch_sub(1, std::memory_order_relaxed);
+
+        if (m_StopRequested.load(std::memory_order_acquire))
+        {
+            return;
+        }
+
+        // Chunks that went out of range while queued are not generated
+        if (!job->Cancelled.load(std::memory_order_acquire))
+        {
+            SM_PROFILE_SCOPE("GenerateChunk");
+            SM::ScopedMemoryTag memoryTag(SM::MemoryTag::PCG);
+            job->Result = m_GenerateFunc(job->Coord);
+        }
+
+        std::lock_guard<std::mutex> lock(m_CompletedMutex);
+        m_Completed.push_back(job);
+    }
+
+} // namespace PCG
@@ -0,0 +1,105 @@
+#pragma once
+
+/**
+ * @file ChunkWorkerPool.h
+ * @brief Off-main-thread chunk generation on the engine job system
+ *
+ * Each chunk coordinate becomes a background job on SM::JobSystem, which
+ * generates height data and hands the finished chunk back to the main
+ * thread, which then builds the GPU mesh. GPU work never happens on a worker.
+ */
+
+#include "core/JobSystem.h"
+#include "pcg/Chunk.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace PCG
+{
+    /**
+     * @brief A single chunk generation request
+     *
+     * Shared between the main thread and a worker. The main thread may set
+     * Cancelled at any time; workers skip cancelled jobs before generating,
+     * and the main thread discards cancelled results when collecting.
+     */
+    struct ChunkGenerationJob
+    {
+        ChunkCoord Coord;
+        std::atomic<bool> Cancelled{ false };
+        std::unique_ptr<Chunk> Result;
+
+        explicit ChunkGenerationJob(const ChunkCoord& coord) : Coord(coord) {}
+    };
+
+    /**
+     * @brief Runs chunk generation requests as job system background jobs
+     */
+    class ChunkWorkerPool
+    {
+    public:
+        /// Function run on a worker to create and generate a chunk
+        using GenerateFunc = std::function<std::unique_ptr<Chunk>(const ChunkCoord&)>;
+
+        ChunkWorkerPool() = default;
+        ~ChunkWorkerPool();
+
+        // Prevent copying
+        ChunkWorkerPool(const ChunkWorkerPool&) = delete;
+        ChunkWorkerPool& operator=(const ChunkWorkerPool&) = delete;
+
+        /**
+         * @brief Start accepting jobs
+         * @param generateFunc Function used to generate a chunk on a worker
+         * @return false if there is no generate function or the job system has no workers
+         */
+        bool Start(GenerateFunc generateFunc);
+
+        /**
+         * @brief Drop any queued jobs and stop accepting new ones
+         *
+         * Blocks until every submitted job has finished or been skipped.
+         */
+        void Stop();
+
+        /**
+         * @brief Queue a job for generation
+         */
+        void Submit(std::shared_ptr<ChunkGenerationJob> job);
+
+        /**
+         * @brief Move all finished jobs into the output list (main thread)
+         * @param out Receives finished jobs, including cancelled ones
+         */
+        void CollectCompleted(std::vector<std::shared_ptr<ChunkGenerationJob>>& out);
+
+        /**
+         * @brief Check if the pool accepts jobs
+         */
+        bool IsRunning() const { return m_Running; }
+
+        /**
+         * @brief Get the number of jobs waiting for a worker
+         */
+        size_t GetQueuedCount() const { return m_QueuedCount.load(std::memory_order_relaxed); }
+
+    private:
+        void Generate(const std::shared_ptr<ChunkGenerationJob>& job);
+
+    private:
+        GenerateFunc m_GenerateFunc;
+        bool m_Running = false;
+
+        SM::JobCounter m_Counter;                       // Submitted jobs not yet finished
+        std::atomic<size_t> m_QueuedCount{ 0 };
+        std::atomic<bool> m_StopRequested{ false };     // Queued jobs skip generation
+
+        std::mutex m_CompletedMutex;
+        std::vector<std::shared_ptr<ChunkGenerationJob>> m_Completed;
+    };
+
+} // namespace PCG
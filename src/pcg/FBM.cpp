@@ -84,6 +84,32 @@ namespace PCG {
         return sum / normalization;
     }
 
+    void FBM::SampleGrid(float originX, float originY, float step, int width, int height,
+                         const FBMSettings& settings, float* out) const
+    {
+        const size_t count = static_cast<size_t>(width) * static_cast<size_t>(height);
+        std::fill(out, out + count, 0.0f);
+        if (!m_BaseNoise) return;
+
+        std::vector<float> octave(count);
+        float frequency = settings.Frequency;
+        float amplitude = settings.Amplitude;
+        float normalization = CalculateNormalization(settings.Octaves, settings.Persistence);
+
+        for (int i = 0; i < settings.Octaves; ++i) {
+            m_BaseNoise->SampleGrid(originX, originY, step, width, height, octave.data(), frequency);
+            for (size_t j = 0; j < count; ++j) {
+                out[j] += octave[j] * amplitude;
+            }
+            frequency *= settings.Lacunarity;
+            amplitude *= settings.Persistence;
+        }
+
+        for (size_t j = 0; j < count; ++j) {
+            out[j] /= normalization;
+        }
+    }
+
     // ============================================================================
     // Ridged FBM
     // ============================================================================
@@ -295,4 +321,19 @@ namespace PCG {
         return std::make_unique<FBM>(std::move(noise));
     }
 
+    FBMPresets::TerrainKernel FBMPresets::CreateTerrainKernel(uint32_t seed)
+    {
+        return TerrainKernel(seed, FBMSettings::Terrain());
+    }
+
+    FBMPresets::CloudKernel FBMPresets::CreateCloudKernel(uint32_t seed)
+    {
+        return CloudKernel(seed, FBMSettings::Clouds());
+    }
+
+    FBMPresets::DetailKernel FBMPresets::CreateDetailKernel(uint32_t seed)
+    {
+        return DetailKernel(seed, FBMSettings());
+    }
+
 } // namespace PCG
@@ -12,10 +12,20 @@
  * - Ridged FBM: Creates ridge-like features (good for mountains)
  * - Turbulence: Uses absolute values for swirling patterns
  * - Billow: Smooth, cloud-like formations
+ *
+ * FBM works with any INoise at runtime. FBMKernel<NoiseT, Mode> is the
+ * specialized variant for hot paths: the noise type and mode are fixed at
+ * compile time and per-octave constants are computed once.
  */
 
 #include "Noise.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
 #include <memory>
+#include <type_traits>
+#include <vector>
 
 namespace PCG {
 
@@ -130,6 +140,24 @@ namespace PCG {
          */
         float Sample(float x, float y, float z, const FBMSettings& settings) const;
 
+        /**
+         * @brief Sample 2D FBM over a regular grid
+         *
+         * Issues one batched SampleGrid call per octave instead of a virtual
+         * call per point. out[row * width + col] equals
+         * Sample(originX + col * step, originY + row * step, settings).
+         *
+         * @param originX X coordinate of the first column
+         * @param originY Y coordinate of the first row
+         * @param step Spacing between grid points
+         * @param width Number of columns
+         * @param height Number of rows
+         * @param settings FBM parameters
+         * @param out Receives width * height values, row-major
+         */
+        void SampleGrid(float originX, float originY, float step, int width, int height,
+                        const FBMSettings& settings, float* out) const;
+
         // ====================================================================
         // Ridged FBM (Mountain-like features)
         // ====================================================================
@@ -229,8 +257,9 @@ namespace PCG {
                                 int warpIterations = 2, float warpStrength = 0.5f) const;
 
     private:
-        INoise* m_BaseNoise = nullptr;
+        // m_OwnedNoise must be declared first: m_BaseNoise is initialized from it
         std::unique_ptr<INoise> m_OwnedNoise;
+        INoise* m_BaseNoise = nullptr;
 
         /**
          * @brief Calculate weight normalization factor
@@ -241,6 +270,109 @@ namespace PCG {
         float CalculateNormalization(int octaves, float persistence) const;
     };
 
+    /**
+     * @brief Octave combination used by an FBMKernel
+     */
+    enum class FBMMode {
+        Standard,    ///< Same as FBM::Sample
+        Ridged,      ///< Same as FBM::Ridged
+        Turbulence,  ///< Same as FBM::Turbulence
+        Billow       ///< Same as FBM::Billow
+    };
+
+    /**
+     * @brief FBM specialized for one noise type and mode
+     *
+     * Noise calls are direct (non-virtual) calls on NoiseT, so the compiler
+     * can inline them across octaves where the noise code is visible, and
+     * octave frequencies, amplitudes and the normalization factor are
+     * computed once in SetSettings instead of on every sample. Batched grid
+     * and point sampling run each octave through NoiseT's SIMD batch path.
+     *
+     * Results equal the matching FBM method with the same settings.
+     * Sampling is const and safe to call from several threads at once.
+     *
+     * @tparam NoiseT Concrete noise type (PerlinNoise, SimplexNoise, ...)
+     * @tparam Mode How octaves are combined
+     */
+    template<typename NoiseT, FBMMode Mode>
+    class FBMKernel {
+    public:
+        static_assert(std::is_base_of_v<INoise, NoiseT>, "NoiseT must derive from INoise");
+
+        static constexpr int MAX_OCTAVES = 16; ///< Octaves beyond this are ignored
+
+        /**
+         * @brief Construct with a new noise generator
+         * @param seed Noise seed (0 = random)
+         * @param settings FBM parameters
+         */
+        explicit FBMKernel(uint32_t seed = 0, const FBMSettings& settings = FBMSettings());
+
+        /**
+         * @brief Construct from an existing noise generator (copied)
+         */
+        FBMKernel(const NoiseT& noise, const FBMSettings& settings);
+
+        /**
+         * @brief Apply new settings and recompute per-octave constants
+         */
+        void SetSettings(const FBMSettings& settings);
+
+        const FBMSettings& GetSettings() const { return m_Settings; }
+        NoiseT& GetNoise() { return m_Noise; }
+        const NoiseT& GetNoise() const { return m_Noise; }
+
+        /**
+         * @brief Sample a single point
+         */
+        float Sample(float x, float y) const;
+
+        /**
+         * @brief Sample a list of points
+         */
+        void SamplePoints(const float* xs, const float* ys, size_t count, float* out) const;
+
+        /**
+         * @brief Sample a regular grid
+         *
+         * out[row * width + col] equals Sample(originX + col * step, originY + row * step).
+         */
+        void SampleGrid(float originX, float originY, float step, int width, int height, float* out) const;
+
+        /**
+         * @brief Sample a single point with domain warping (as FBM::WarpedSample)
+         */
+        float WarpedSample(float x, float y, float warpStrength = 0.5f) const;
+
+        /**
+         * @brief Sample a regular grid with domain warping
+         *
+         * out[row * width + col] equals
+         * WarpedSample(originX + col * step, originY + row * step, warpStrength).
+         */
+        void WarpedSampleGrid(float originX, float originY, float step, int width, int height,
+                              float warpStrength, float* out) const;
+
+    private:
+        /// Fold one octave's noise value into the running sum
+        void Accumulate(float noise, int octave, float& sum, float& weight) const;
+
+        /// Map the summed octaves to the output range
+        float Finish(float sum) const;
+
+        /// Run every octave over a batch; sampleOctave(octave, noiseOut) fills raw noise
+        template<typename OctaveFunc>
+        void AccumulateBatch(size_t count, float* out, OctaveFunc&& sampleOctave) const;
+
+        NoiseT m_Noise;
+        FBMSettings m_Settings;
+        std::array<float, MAX_OCTAVES> m_Frequencies{};
+        std::array<float, MAX_OCTAVES> m_Amplitudes{};
+        int m_OctaveCount = 0;
+        float m_Normalization = 1.0f;
+    };
+
     /**
      * @brief Pre-configured FBM generators for common use cases
      */
@@ -263,6 +395,241 @@ namespace PCG {
          * @param seed Random seed
          */
         static std::unique_ptr<FBM> CreateDetailFBM(uint32_t seed = 0);
+
+        // Specialized kernels for the same presets
+        using TerrainKernel = FBMKernel<PerlinNoise, FBMMode::Standard>;
+        using CloudKernel = FBMKernel<SimplexNoise, FBMMode::Standard>;
+        using DetailKernel = FBMKernel<ValueNoise, FBMMode::Standard>;
+
+        /**
+         * @brief Create the terrain kernel (Perlin, FBMSettings::Terrain)
+         * @param seed Random seed
+         */
+        static TerrainKernel CreateTerrainKernel(uint32_t seed = 0);
+
+        /**
+         * @brief Create the cloud kernel (Simplex, FBMSettings::Clouds)
+         * @param seed Random seed
+         */
+        static CloudKernel CreateCloudKernel(uint32_t seed = 0);
+
+        /**
+         * @brief Create the detail kernel (Value noise, default FBMSettings)
+         * @param seed Random seed
+         */
+        static DetailKernel CreateDetailKernel(uint32_t seed = 0);
     };
 
+    // ============================================================================
+    // FBMKernel Implementation
+    // ============================================================================
+
+    namespace Detail {
+
+        /// Per-thread scratch buffers for batched FBM sampling
+        struct FBMScratch {
+            std::vector<float> Noise;
+            std::vector<float> Weights;
+            std::vector<float> ScaledX;
+            std::vector<float> ScaledY;
+            std::vector<float> BaseX;
+            std::vector<float> BaseY;
+            std::vector<float> WarpX;
+            std::vector<float> WarpY;
+            std::vector<float> WarpQ;
+        };
+
+        inline FBMScratch& GetFBMScratch() {
+            thread_local FBMScratch scratch;
+            return scratch;
+        }
+
+    } // namespace Detail
+
+    template<typename NoiseT, FBMMode Mode>
+    FBMKernel<NoiseT, Mode>::FBMKernel(uint32_t seed, const FBMSettings& settings)
+        : m_Noise(seed)
+    {
+        SetSettings(settings);
+    }
+
+    template<typename NoiseT, FBMMode Mode>
+    FBMKernel<NoiseT, Mode>::FBMKernel(const NoiseT& noise, const FBMSettings& settings)
+        : m_Noise(noise)
+    {
+        SetSettings(settings);
+    }
+
+    template<typename NoiseT, FBMMode Mode>
+    void FBMKernel<NoiseT, Mode>::SetSettings(const FBMSettings& settings)
+    {
+        m_Settings = settings;
+        m_OctaveCount = std::clamp(settings.Octaves, 0, MAX_OCTAVES);
+
+        // Same progression as the FBM octave loops, so results match exactly
+        float frequency = settings.Frequency;
+        float amplitude = settings.Amplitude;
+        float maxValue = 0.0f;
+        float normalizationAmplitude = 1.0f;
+
+        for (int i = 0; i < m_OctaveCount; ++i) {
+            m_Frequencies[i] = frequency;
+            m_Amplitudes[i] = amplitude;
+            maxValue += normalizationAmplitude;
+
+            frequency *= settings.Lacunarity;
+            amplitude *= settings.Persistence;
+            normalizationAmplitude *= settings.Persistence;
+        }
+
+        m_Normalization = maxValue;
+    }
+
+    template<typename NoiseT, FBMMode Mode>
+    void FBMKernel<NoiseT, Mode>::Accumulate(float noise, int octave, float& sum, float& weight) const
+    {
+        const float amplitude = m_Amplitudes[octave];
+
+        if constexpr (Mode == FBMMode::Standard) {
+            sum += noise * amplitude;
+        } else if constexpr (Mode == FBMMode::Ridged) {
+            noise = m_Settings.Offset - std::abs(noise);
+            noise *= noise;
+            noise *= weight;
+            sum += noise * amplitude;
+            weight = std::clamp(noise * m_Settings.Gain, 0.0f, 1.0f);
+        } else if constexpr (Mode == FBMMode::Turbulence) {
+            sum += std::abs(noise) * amplitude;
+        } else {
+            noise = std::abs(noise) * 2.0f - 1.0f;
+            sum += noise * amplitude;
+        }
+    }
+
+    template<typename NoiseT, FBMMode Mode>
+    float FBMKernel<NoiseT, Mode>::Finish(float sum) const
+    {
+        if constexpr (Mode == FBMMode::Ridged) {
+            return std::clamp(sum * 1.25f, 0.0f, 1.0f);
+        } else if constexpr (Mode == FBMMode::Billow) {
+            return (sum / m_Normalization + 1.0f) * 0.5f;
+        } else {
+            return sum / m_Normalization;
+        }
+    }
+
+    template<typename NoiseT, FBMMode Mode>
+    float FBMKernel<NoiseT, Mode>::Sample(float x, float y) const
+    {
+        float sum = 0.0f;
+        float weight = 1.0f;
+
+        for (int i = 0; i < m_OctaveCount; ++i) {
+            const float frequency = m_Frequencies[i];
+            Accumulate(m_Noise.NoiseT::Sample(x * frequency, y * frequency), i, sum, weight);
+        }
+
+        return Finish(sum);
+    }
+
+    template<typename NoiseT, FBMMode Mode>
+    template<typename OctaveFunc>
+    void FBMKernel<NoiseT, Mode>::AccumulateBatch(size_t count, float* out, OctaveFunc&& sampleOctave) const
+    {
+        Detail::FBMScratch& scratch = Detail::GetFBMScratch();
+        scratch.Noise.resize(count);
+
+        std::fill(out, out + count, 0.0f);
+        if constexpr (Mode == FBMMode::Ridged) {
+            scratch.Weights.assign(count, 1.0f);
+        }
+
+        float unusedWeight = 1.0f;
+        for (int i = 0; i < m_OctaveCount; ++i) {
+            sampleOctave(i, scratch.Noise.data());
+
+            for (size_t j = 0; j < count; ++j) {
+                float& weight = (Mode == FBMMode::Ridged) ? scratch.Weights[j] : unusedWeight;
+                Accumulate(scratch.Noise[j], i, out[j], weight);
+            }
+        }
+
+        for (size_t j = 0; j < count; ++j) {
+            out[j] = Finish(out[j]);
+        }
+    }
+
+    template<typename NoiseT, FBMMode Mode>
+    void FBMKernel<NoiseT, Mode>::SamplePoints(const float* xs, const float* ys, size_t count, float* out) const
+    {
+        Detail::FBMScratch& scratch = Detail::GetFBMScratch();
+        scratch.ScaledX.resize(count);
+        scratch.ScaledY.resize(count);
+
+        AccumulateBatch(count, out, [&](int octave, float* noise) {
+            const float frequency = m_Frequencies[octave];
+            for (size_t j = 0; j < count; ++j) {
+                scratch.ScaledX[j] = xs[j] * frequency;
+                scratch.ScaledY[j] = ys[j] * frequency;
+            }
+            m_Noise.NoiseT::SamplePoints(scratch.ScaledX.data(), scratch.ScaledY.data(), count, noise);
+        });
+    }
+
+    template<typename NoiseT, FBMMode Mode>
+    void FBMKernel<NoiseT, Mode>::SampleGrid(float originX, float originY, float step,
+                                             int width, int height, float* out) const
+    {
+        const size_t count = static_cast<size_t>(width) * static_cast<size_t>(height);
+
+        AccumulateBatch(count, out, [&](int octave, float* noise) {
+            m_Noise.NoiseT::SampleGrid(originX, originY, step, width, height, noise, m_Frequencies[octave]);
+        });
+    }
+
+    template<typename NoiseT, FBMMode Mode>
+    float FBMKernel<NoiseT, Mode>::WarpedSample(float x, float y, float warpStrength) const
+    {
+        // Calculate warp offsets using different coordinate offsets
+        float qx = Sample(x, y);
+        float qy = Sample(x + 5.2f, y + 1.3f);
+
+        return Sample(x + warpStrength * qx * 4.0f, y + warpStrength * qy * 4.0f);
+    }
+
+    template<typename NoiseT, FBMMode Mode>
+    void FBMKernel<NoiseT, Mode>::WarpedSampleGrid(float originX, float originY, float step,
+                                                   int width, int height, float warpStrength, float* out) const
+    {
+        const size_t count = static_cast<size_t>(width) * static_cast<size_t>(height);
+
+        Detail::FBMScratch& scratch = Detail::GetFBMScratch();
+        scratch.BaseX.resize(count);
+        scratch.BaseY.resize(count);
+        scratch.WarpX.resize(count);
+        scratch.WarpY.resize(count);
+        scratch.WarpQ.resize(count);
+
+        for (int row = 0; row < height; ++row) {
+            for (int col = 0; col < width; ++col) {
+                const size_t j = static_cast<size_t>(row) * width + col;
+                scratch.BaseX[j] = originX + static_cast<float>(col) * step;
+                scratch.BaseY[j] = originY + static_cast<float>(row) * step;
+                scratch.WarpX[j] = scratch.BaseX[j] + 5.2f;
+                scratch.WarpY[j] = scratch.BaseY[j] + 1.3f;
+            }
+        }
+
+        // qx into out, qy into WarpQ
+        SamplePoints(scratch.BaseX.data(), scratch.BaseY.data(), count, out);
+        SamplePoints(scratch.WarpX.data(), scratch.WarpY.data(), count, scratch.WarpQ.data());
+
+        for (size_t j = 0; j < count; ++j) {
+            scratch.WarpX[j] = scratch.BaseX[j] + warpStrength * out[j] * 4.0f;
+            scratch.WarpY[j] = scratch.BaseY[j] + warpStrength * scratch.WarpQ[j] * 4.0f;
+        }
+
+        SamplePoints(scratch.WarpX.data(), scratch.WarpY.data(), count, out);
+    }
+
 } // namespace PCG
@@ -0,0 +1,295 @@
+#include "pcg/FoliageScatter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace PCG
+{
+    namespace
+    {
+        uint32_t Mix(uint32_t h)
+        {
+            // Murmur3 finalizer
+            h ^= h >> 16;
+            h *= 0x85EBCA6Bu;
+            h ^= h >> 13;
+            h *= 0xC2B2AE35u;
+            h ^= h >> 16;
+            return h;
+        }
+
+        /**
+         * @brief Hash of one tile point in one chunk
+         */
+        uint32_t HashPoint(uint32_t seed, const ChunkCoord& coord, uint32_t layer, uint32_t point)
+        {
+            uint32_t h = Mix(seed ^ 0x9E3779B9u);
+            h = Mix(h ^ static_cast<uint32_t>(coord.X));
+            h = Mix(h ^ static_cast<uint32_t>(coord.Z) * 0x27D4EB2Fu);
+            return Mix(h ^ (layer << 24) ^ point);
+        }
+
+        /// [0, 1) from the top 24 bits (std distributions differ between standard libraries)
+        float ToUnit(uint32_t bits)
+        {
+            return static_cast<float>(bits >> 8) * (1.0f / 16777216.0f);
+        }
+
+        /// Shortest offset on a torus of the given size
+        float WrapDelta(float delta, float size)
+        {
+            if (delta > size * 0.5f)
+            {
+                return delta - size;
+            }
+            if (delta < -size * 0.5f)
+            {
+                return delta + size;
+            }
+            return delta;
+        }
+
+        struct RankedInstance
+        {
+            float Rank;
+            ScatterInstance Instance;
+        };
+    }
+
+    // ============================================================================
+    // Layers
+    // ============================================================================
+
+    void FoliageScatter::SetLayers(std::vector<ScatterLayer> layers, uint32_t seed)
+    {
+        m_Layers = std::move(layers);
+        m_Seed = seed;
+
+        m_Tiles.clear();
+        m_Tiles.reserve(m_Layers.size());
+        for (size_t i = 0; i < m_Layers.size(); ++i)
+        {
+            m_Tiles.push_back(BuildPoissonTile(m_Layers[i].Spacing, Mix(seed + static_cast<uint32_t>(i) * 0x632BE5ABu)));
+        }
+    }
+
+    void FoliageScatter::SetBiomeDensities(const BiomeMap& biomeMap)
+    {
+        for (size_t i = 0; i < m_BiomeDensity.size(); ++i)
+        {
+            const BiomeData& data = biomeMap.GetBiomeData(static_cast<BiomeType>(i));
+            m_BiomeDensity[i] = (data.IsWater || !data.IsPassable) ? 0.0f : std::max(data.ResourceDensity, 0.0f);
+        }
+        m_HasBiomeDensity = true;
+    }
+
+    std::vector<DirectX::XMFLOAT2> FoliageScatter::BuildPoissonTile(float spacing, uint32_t seed)
+    {
+        constexpr int ATTEMPTS = 30;
+        const float size = Chunk::GetWorldSize();
+        const float radius = std::clamp(spacing, size / 256.0f, size * 0.5f);
+        const float radiusSq = radius * radius;
+
+        // Cells no wider than radius / sqrt(2) hold at most one point each
+        const int gridSize = static_cast<int>(std::ceil(size / (radius * 0.70710678f)));
+        const float cellSize = size / static_cast<float>(gridSize);
+        std::vector<int> grid(static_cast<size_t>(gridSize) * gridSize, -1);
+
+        std::mt19937 rng(seed);
+        auto unit = [&rng]() { return ToUnit(static_cast<uint32_t>(rng())); };
+
+        auto cellOf = [&](float v) {
+            return std::min(static_cast<int>(v / cellSize), gridSize - 1);
+        };
+
+        std::vector<DirectX::XMFLOAT2> points;
+        std::vector<int> active;
+
+        auto addPoint = [&](float x, float z) {
+            grid[static_cast<size_t>(cellOf(z)) * gridSize + cellOf(x)] = static_cast<int>(points.size());
+            active.push_back(static_cast<int>(points.size()));
+            points.push_back({ x, z });
+        };
+
+        addPoint(unit() * size, unit() * size);
+
+        while (!active.empty())
+        {
+            const size_t activeIndex = static_cast<size_t>(rng() % active.size());
+            const DirectX::XMFLOAT2 origin = points[active[activeIndex]];
+
+            bool placed = false;
+            for (int attempt = 0; attempt < ATTEMPTS && !placed; ++attempt)
+            {
+                // Annulus [r, 2r) around the active point, wrapped onto the tile
+                const float angle = unit() * DirectX::XM_2PI;
+                const float distance = radius * (1.0f + unit());
+                float x = std::fmod(origin.x + std::cos(angle) * distance + size, size);
+                float z = std::fmod(origin.y + std::sin(angle) * distance + size, size);
+                x = std::min(std::max(x, 0.0f), std::nextafter(size, 0.0f));
+                z = std::min(std::max(z, 0.0f), std::nextafter(size, 0.0f));
+
+                const int cx = cellOf(x);
+                const int cz = cellOf(z);
+
+                bool clear = true;
+                for (int dz = -2; dz <= 2 && clear; ++dz)
+                {
+                    for (int dx = -2; dx <= 2 && clear; ++dx)
+                    {
+                        const int gx = (cx + dx + gridSize) % gridSize;
+                        const int gz = (cz + dz + gridSize) % gridSize;
+                        const int neighbor = grid[static_cast<size_t>(gz) * gridSize + gx];
+                        if (neighbor < 0)
+                        {
+                            continue;
+                        }
+
+                        const float ox = WrapDelta(points[neighbor].x - x, size);
+                        const float oz = WrapDelta(points[neighbor].y - z, size);
+                        clear = ox * ox + oz * oz >= radiusSq;
+                    }
+                }
+
+                if (clear && grid[static_cast<size_t>(cz) * gridSize + cx] < 0)
+                {
+                    addPoint(x, z);
+                    placed = true;
+                }
+            }
+
+            if (!placed)
+            {
+                active[activeIndex] = active.back();
+                active.pop_back();
+            }
+        }
+
+        return points;
+    }
+
+    // ============================================================================
+    // Placement
+    // ============================================================================
+
+    void FoliageScatter::ScatterChunk(const ChunkCoord& coord, std::span<const float> heights,
+                                      std::span<const BiomeType> biomes, ChunkScatter& out) const
+    {
+        constexpr int STRIDE = Chunk::SIZE + 1;
+
+        out.Coord = coord;
+        out.Instances.clear();
+        out.LayerOffsets.assign(1, 0);
+
+        if (heights.size() < static_cast<size_t>(Chunk::VERTEX_COUNT))
+        {
+            out.LayerOffsets.resize(m_Layers.size() + 1, 0);
+            return;
+        }
+
+        const bool filterBiomes = biomes.size() >= static_cast<size_t>(Chunk::VERTEX_COUNT);
+        const DirectX::XMFLOAT3 origin = coord.ToWorldPosition(Chunk::GetWorldSize());
+        const float invScale = 1.0f / Chunk::SCALE;
+
+        std::vector<RankedInstance> ranked;
+
+        for (uint32_t layerIndex = 0; layerIndex < m_Layers.size(); ++layerIndex)
+        {
+            const ScatterLayer& layer = m_Layers[layerIndex];
+            const std::vector<DirectX::XMFLOAT2>& tile = m_Tiles[layerIndex];
+            ranked.clear();
+
+            for (uint32_t pointIndex = 0; pointIndex < tile.size(); ++pointIndex)
+            {
+                const DirectX::XMFLOAT2 point = tile[pointIndex];
+                const float localX = point.x * invScale;
+                const float localZ = point.y * invScale;
+
+                float keep = layer.Density;
+                if (filterBiomes)
+                {
+                    const int nx = std::min(static_cast<int>(localX + 0.5f), Chunk::SIZE);
+                    const int nz = std::min(static_cast<int>(localZ + 0.5f), Chunk::SIZE);
+                    const BiomeType biome = biomes[nz * STRIDE + nx];
+                    if (biome >= BiomeType::Count || (layer.BiomeMask & ScatterLayer::BiomeBit(biome)) == 0)
+                    {
+                        continue;
+                    }
+                    if (m_HasBiomeDensity)
+                    {
+                        keep *= m_BiomeDensity[static_cast<size_t>(biome)];
+                    }
+                }
+
+                const uint32_t hash = HashPoint(m_Seed, coord, layerIndex, pointIndex);
+                const float rank = ToUnit(hash);
+                if (rank >= keep)
+                {
+                    continue;
+                }
+
+                // Height and gradient of the mesh triangle under the point
+                // (quads are split from (x, z) to (x + 1, z + 1))
+                const int cx = std::min(static_cast<int>(localX), Chunk::SIZE - 1);
+                const int cz = std::min(static_cast<int>(localZ), Chunk::SIZE - 1);
+                const float fx = localX - static_cast<float>(cx);
+                const float fz = localZ - static_cast<float>(cz);
+
+                const float h00 = heights[cz * STRIDE + cx];
+                const float h10 = heights[cz * STRIDE + cx + 1];
+                const float h01 = heights[(cz + 1) * STRIDE + cx];
+                const float h11 = heights[(cz + 1) * STRIDE + cx + 1];
+
+                float gradX, gradZ;
+                if (fx >= fz)
+                {
+                    gradX = h10 - h00;
+                    gradZ = h11 - h10;
+                }
+                else
+                {
+                    gradX = h11 - h01;
+                    gradZ = h01 - h00;
+                }
+                const float height = h00 + gradX * fx + gradZ * fz;
+
+                if (height < layer.MinHeight || height > layer.MaxHeight)
+                {
+                    continue;
+                }
+
+                const float slopeSq = (gradX * gradX + gradZ * gradZ) * invScale * invScale;
+                if (slopeSq > layer.MaxSlope * layer.MaxSlope)
+                {
+                    continue;
+                }
+
+                RankedInstance& placed = ranked.emplace_back();
+                placed.Instance.Scale = layer.MinScale + (layer.MaxScale - layer.MinScale) * ToUnit(Mix(hash ^ 0x2u));
+                placed.Instance.Yaw = ToUnit(Mix(hash ^ 0x1u)) * DirectX::XM_2PI;
+                placed.Instance.Position = {
+                    origin.x + point.x,
+                    height + layer.GroundOffset * layer.MeshScale.y * placed.Instance.Scale,
+                    origin.z + point.y
+                };
+                placed.Instance.PointIndex = pointIndex;
+
+                // Kept ranks are uniform in [0, keep); normalizing makes a
+                // prefix thin every biome of the chunk by the same fraction
+                placed.Rank = rank / keep;
+            }
+
+            std::sort(ranked.begin(), ranked.end(), [](const RankedInstance& a, const RankedInstance& b) {
+                return a.Rank < b.Rank;
+            });
+
+            for (const RankedInstance& placed : ranked)
+            {
+                out.Instances.push_back(placed.Instance);
+            }
+            out.LayerOffsets.push_back(static_cast<uint32_t>(out.Instances.size()));
+        }
+    }
+
+} // namespace PCG
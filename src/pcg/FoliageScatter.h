@@ -0,0 +1,147 @@
+#pragma once
+
+/**
+ * @file FoliageScatter.h
+ * @brief Deterministic biome-driven placement of foliage and props on terrain chunks
+ *
+ * Every scatter layer (trees, bushes, rocks, ...) owns one Poisson-disk
+ * tile the size of a chunk. The tile wraps toroidally, so repeating it on
+ * every chunk keeps the minimum spacing across chunk borders. Each chunk
+ * then thins the tile with hashed per-point ranks and filters the survivors
+ * by biome, height and slope. The result depends only on the seed, the
+ * chunk coordinate and its heights, so a chunk that is unloaded and later
+ * regenerated gets exactly the same placements.
+ */
+
+#include "Biome.h"
+#include "Chunk.h"
+
+#include <DirectXMath.h>
+#include <array>
+#include <cfloat>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace PCG
+{
+    /**
+     * @brief One kind of scattered object and where it may grow
+     */
+    struct ScatterLayer
+    {
+        std::string Name;
+        uint32_t MeshId = 0;                ///< Mesh to draw, interpreted by the renderer (e.g. SM::PrimitiveMesh)
+        uint32_t BiomeMask = ~0u;           ///< Bit per BiomeType the layer grows in (see BiomeBit)
+        float Spacing = 4.0f;               ///< Minimum distance between points of the layer (world units)
+        float Density = 0.5f;               ///< Fraction of points kept, scaled by the biome's ResourceDensity
+        float MinHeight = -FLT_MAX;         ///< Lowest terrain height (world units)
+        float MaxHeight = FLT_MAX;          ///< Highest terrain height (world units)
+        float MaxSlope = 0.6f;              ///< Steepest ground as rise over run (0.6 is about 31 degrees)
+        float MinScale = 0.8f;              ///< Random uniform scale range
+        float MaxScale = 1.2f;
+        DirectX::XMFLOAT3 MeshScale = { 1.0f, 1.0f, 1.0f };  ///< Scale of the mesh before the random scale
+        float GroundOffset = 0.5f;          ///< Pivot height above the ground, in multiples of MeshScale.y
+        DirectX::XMFLOAT4 Color = { 1.0f, 1.0f, 1.0f, 1.0f };
+        float FullDensityDistance = 64.0f;  ///< Every placed instance is drawn up to this distance
+        float DrawDistance = 192.0f;        ///< Drawn fraction falls linearly to zero at this distance
+
+        /**
+         * @brief Get the BiomeMask bit of a biome
+         */
+        static constexpr uint32_t BiomeBit(BiomeType type) { return 1u << static_cast<uint32_t>(type); }
+    };
+
+    /**
+     * @brief One placed object
+     */
+    struct ScatterInstance
+    {
+        DirectX::XMFLOAT3 Position;         ///< Pivot in world space
+        float Yaw = 0.0f;                   ///< Rotation about +Y (radians)
+        float Scale = 1.0f;                 ///< Random uniform scale (multiplies MeshScale)
+        uint32_t PointIndex = 0;            ///< Index in the layer's tile; stable across regeneration
+    };
+
+    /**
+     * @brief Placements of every layer in one chunk
+     *
+     * Instances are grouped by layer. Within a layer they are ordered by
+     * thinning rank, so drawing the first N is an evenly spread subset -
+     * which is how distance density LOD draws fewer instances far away.
+     */
+    struct ChunkScatter
+    {
+        ChunkCoord Coord;
+        std::vector<ScatterInstance> Instances;
+        std::vector<uint32_t> LayerOffsets;     ///< LayerCount + 1 entries; layer i is [LayerOffsets[i], LayerOffsets[i + 1])
+
+        uint32_t GetLayerCount(uint32_t layer) const { return LayerOffsets[layer + 1] - LayerOffsets[layer]; }
+    };
+
+    /**
+     * @brief Generates per-chunk scatter placements from a set of layers
+     *
+     * SetLayers builds the Poisson tiles (cost grows with chunk area over
+     * Spacing squared), after which ScatterChunk is const and may run on
+     * any number of job workers at once.
+     */
+    class FoliageScatter
+    {
+    public:
+        /**
+         * @brief Replace the layers and build their Poisson tiles
+         * @param layers Layers in draw order
+         * @param seed World seed (e.g. the terrain seed)
+         */
+        void SetLayers(std::vector<ScatterLayer> layers, uint32_t seed);
+
+        /**
+         * @brief Copy per-biome spawn densities (ResourceDensity, zero for water)
+         *
+         * Until called every biome has density 1.
+         */
+        void SetBiomeDensities(const BiomeMap& biomeMap);
+
+        /**
+         * @brief Place every layer on a chunk (thread-safe)
+         * @param coord Chunk coordinate
+         * @param heights Chunk height grid (Chunk::VERTEX_COUNT samples, row-major by Z)
+         * @param biomes Chunk biome grid of the same layout, or empty to skip biome filtering
+         * @param out Receives the placements (storage is reused)
+         */
+        void ScatterChunk(const ChunkCoord& coord, std::span<const float> heights,
+                          std::span<const BiomeType> biomes, ChunkScatter& out) const;
+
+        /**
+         * @brief Get the layers
+         */
+        const std::vector<ScatterLayer>& GetLayers() const { return m_Layers; }
+        uint32_t GetLayerCount() const { return static_cast<uint32_t>(m_Layers.size()); }
+
+        /**
+         * @brief Get the number of Poisson points in a layer's tile (placements per chunk before thinning)
+         */
+        size_t GetTilePointCount(uint32_t layer) const { return m_Tiles[layer].size(); }
+
+        /**
+         * @brief Get the seed passed to SetLayers
+         */
+        uint32_t GetSeed() const { return m_Seed; }
+
+    private:
+        /**
+         * @brief Build a toroidal Poisson-disk tile of one chunk (Bridson's algorithm)
+         */
+        static std::vector<DirectX::XMFLOAT2> BuildPoissonTile(float spacing, uint32_t seed);
+
+    private:
+        std::vector<ScatterLayer> m_Layers;
+        std::vector<std::vector<DirectX::XMFLOAT2>> m_Tiles;   ///< Chunk-local points per layer
+        std::array<float, static_cast<size_t>(BiomeType::Count)> m_BiomeDensity = {};
+        bool m_HasBiomeDensity = false;
+        uint32_t m_Seed = 0;
+    };
+
+} // namespace PCG
@@ -1,10 +1,78 @@
 #include "HeightmapGenerator.h"
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
 #include <random>
+#include <thread>
 
 namespace PCG {
 
+    namespace {
+
+        /// Rows per parallel task; small maps stay on the calling thread
+        constexpr int ROWS_PER_TASK = 16;
+
+        /**
+         * @brief Run rowFunc(y0, y1) over [0, rows) in blocks on several threads
+         *
+         * Each row is written by exactly one block and blocks only read shared
+         * input, so the result does not depend on the thread count or order.
+         */
+        template<typename RowFunc>
+        void ParallelForRows(int rows, int threadCount, RowFunc&& rowFunc)
+        {
+            const int blockCount = (rows + ROWS_PER_TASK - 1) / ROWS_PER_TASK;
+
+            unsigned int threads = threadCount > 0
+                ? static_cast<unsigned int>(threadCount)
+                : std::max(1u, std::thread::hardware_concurrency());
+            threads = std::min(threads, static_cast<unsigned int>(std::max(blockCount, 1)));
+
+            if (threads <= 1) {
+                if (rows > 0) rowFunc(0, rows);
+                return;
+            }
+
+            std::atomic<int> nextBlock{ 0 };
+            auto worker = [&]() {
+                for (int block = nextBlock.fetch_add(1); block < blockCount; block = nextBlock.fetch_add(1)) {
+                    int y0 = block * ROWS_PER_TASK;
+                    rowFunc(y0, std::min(y0 + ROWS_PER_TASK, rows));
+                }
+            };
+
+            std::vector<std::thread> helpers;
+            helpers.reserve(threads - 1);
+            for (unsigned int t = 1; t < threads; ++t) {
+                helpers.emplace_back(worker);
+            }
+            worker();
+            for (std::thread& helper : helpers) {
+                helper.join();
+            }
+        }
+
+        /// Square island falloff at a pixel (0 at edges, 1 at center)
+        float FalloffAt(int x, int y, int width, int height)
+        {
+            // Normalize to [-1, 1]
+            float nx = static_cast<float>(x) / width * 2.0f - 1.0f;
+            float ny = static_cast<float>(y) / height * 2.0f - 1.0f;
+
+            // Use max of abs values for square falloff
+            float value = std::max(std::abs(nx), std::abs(ny));
+
+            // Apply smoothstep for smoother transition
+            float a = 3.0f;
+            float b = 2.2f;
+            value = std::pow(value, a) / (std::pow(value, a) + std::pow(b - b * value, a));
+
+            return 1.0f - value;
+        }
+
+    } // anonymous namespace
+
     HeightmapGenerator::HeightmapGenerator()
     {
     }
@@ -33,54 +101,57 @@ namespace PCG {
         hillSettings.Frequency = settings.Noise.Frequency * 2.0f;
         hillSettings.Persistence = 0.4f;
 
-        // Generate heightmap
-        for (int y = 0; y < settings.Height; ++y) {
-            for (int x = 0; x < settings.Width; ++x) {
-                float nx = static_cast<float>(x);
-                float ny = static_cast<float>(y);
+        // Generate heightmap (FBM sampling is const, so row blocks run concurrently)
+        const FBM& baseFBM = *m_FBM;
+        ParallelForRows(settings.Height, m_ThreadCount, [&](int rowBegin, int rowEnd) {
+            for (int y = rowBegin; y < rowEnd; ++y) {
+                for (int x = 0; x < settings.Width; ++x) {
+                    float nx = static_cast<float>(x);
+                    float ny = static_cast<float>(y);
 
-                float baseValue;
+                    float baseValue;
 
-                if (settings.ApplyDomainWarp) {
-                    baseValue = m_FBM->WarpedSample(nx, ny, settings.Noise, settings.WarpStrength);
-                } else {
-                    baseValue = m_FBM->Sample(nx, ny, settings.Noise);
-                }
+                    if (settings.ApplyDomainWarp) {
+                        baseValue = baseFBM.WarpedSample(nx, ny, settings.Noise, settings.WarpStrength);
+                    } else {
+                        baseValue = baseFBM.Sample(nx, ny, settings.Noise);
+                    }
 
-                // Remap base value from [-1, 1] to [0, 1]
-                baseValue = (baseValue + 1.0f) * 0.5f;
-
-                // Add terrain type variation
-                float mountainValue = mountainFBM.Ridged(nx, ny, mountainSettings);
-                float hillValue = (hillFBM.Sample(nx, ny, hillSettings) + 1.0f) * 0.5f;
-                float plainValue = baseValue * 0.3f;
-
-                // Blend terrain types based on weights and base noise
-                float blendFactor = baseValue;
-
-                float finalHeight;
-                if (blendFactor > 0.7f) {
-                    // Mountain region
-                    float t = (blendFactor - 0.7f) / 0.3f;
-                    finalHeight = hillValue + t * (mountainValue - hillValue);
-                    finalHeight *= settings.MountainWeight + settings.HillWeight;
-                } else if (blendFactor > 0.3f) {
-                    // Hill region
-                    float t = (blendFactor - 0.3f) / 0.4f;
-                    finalHeight = plainValue + t * (hillValue - plainValue);
-                    finalHeight *= settings.HillWeight + settings.PlainWeight;
-                } else {
-                    // Plain/Ocean region
-                    float t = blendFactor / 0.3f;
-                    float oceanFloor = settings.OceanWeight * 0.2f;
-                    finalHeight = oceanFloor + t * (plainValue - oceanFloor);
-                    finalHeight *= settings.PlainWeight + settings.OceanWeight;
-                }
+                    // Remap base value from [-1, 1] to [0, 1]
+                    baseValue = (baseValue + 1.0f) * 0.5f;
+
+                    // Add terrain type variation
+                    float mountainValue = mountainFBM.Ridged(nx, ny, mountainSettings);
+                    float hillValue = (hillFBM.Sample(nx, ny, hillSettings) + 1.0f) * 0.5f;
+                    float plainValue = baseValue * 0.3f;
+
+                    // Blend terrain types based on weights and base noise
+                    float blendFactor = baseValue;
+
+                    float finalHeight;
+                    if (blendFactor > 0.7f) {
+                        // Mountain region
+                        float t = (blendFactor - 0.7f) / 0.3f;
+                        finalHeight = hillValue + t * (mountainValue - hillValue);
+                        finalHeight *= settings.MountainWeight + settings.HillWeight;
+                    } else if (blendFactor > 0.3f) {
+                        // Hill region
+                        float t = (blendFactor - 0.3f) / 0.4f;
+                        finalHeight = plainValue + t * (hillValue - plainValue);
+                        finalHeight *= settings.HillWeight + settings.PlainWeight;
+                    } else {
+                        // Plain/Ocean region
+                        float t = blendFactor / 0.3f;
+                        float oceanFloor = settings.OceanWeight * 0.2f;
+                        finalHeight = oceanFloor + t * (plainValue - oceanFloor);
+                        finalHeight *= settings.PlainWeight + settings.OceanWeight;
+                    }
 
-                // Store normalized [0, 1] value
-                heightmap[y * settings.Width + x] = std::clamp(finalHeight, 0.0f, 1.0f);
+                    // Store normalized [0, 1] value
+                    heightmap[y * settings.Width + x] = std::clamp(finalHeight, 0.0f, 1.0f);
+                }
             }
-        }
+        });
 
         // Apply post-processing
         if (settings.ApplyFalloffMap) {
@@ -102,14 +173,16 @@ namespace PCG {
     {
         std::vector<float> heightmap(settings.Width * settings.Height);
 
-        for (int y = 0; y < settings.Height; ++y) {
-            for (int x = 0; x < settings.Width; ++x) {
-                float nx = static_cast<float>(x);
-                float ny = static_cast<float>(y);
+        ParallelForRows(settings.Height, m_ThreadCount, [&](int rowBegin, int rowEnd) {
+            for (int y = rowBegin; y < rowEnd; ++y) {
+                for (int x = 0; x < settings.Width; ++x) {
+                    float nx = static_cast<float>(x);
+                    float ny = static_cast<float>(y);
 
-                heightmap[y * settings.Width + x] = noiseFunc(nx, ny);
+                    heightmap[y * settings.Width + x] = noiseFunc(nx, ny);
+                }
             }
-        }
+        });
 
         Normalize(heightmap);
 
@@ -126,56 +199,31 @@ namespace PCG {
     // Post-Processing: Erosion
     // ============================================================================
 
-    void HeightmapGenerator::InitErosionBrushes(int radius,
-                                                 std::vector<std::vector<int>>& brushIndices,
-                                                 std::vector<std::vector<float>>& brushWeights,
-                                                 int mapSize)
+    void HeightmapGenerator::InitErosionBrushes(int radius, int width,
+                                                 std::vector<int>& brushOffsets,
+                                                 std::vector<float>& brushWeights)
     {
-        brushIndices.resize(mapSize);
-        brushWeights.resize(mapSize);
-
-        std::vector<int> xOffsets;
-        std::vector<int> yOffsets;
-        std::vector<float> weights;
+        // One brush shared by every interior cell, stored as index offsets
+        brushOffsets.clear();
+        brushWeights.clear();
 
         float weightSum = 0;
         for (int y = -radius; y <= radius; ++y) {
             for (int x = -radius; x <= radius; ++x) {
                 float sqrDst = static_cast<float>(x * x + y * y);
                 if (sqrDst < radius * radius) {
-                    xOffsets.push_back(x);
-                    yOffsets.push_back(y);
+                    brushOffsets.push_back(y * width + x);
                     float weight = 1 - std::sqrt(sqrDst) / radius;
-                    weights.push_back(weight);
+                    brushWeights.push_back(weight);
                     weightSum += weight;
                 }
             }
         }
 
         // Normalize weights
-        for (float& w : weights) {
+        for (float& w : brushWeights) {
             w /= weightSum;
         }
-
-        int mapWidth = static_cast<int>(std::sqrt(mapSize));
-
-        for (int i = 0; i < mapSize; ++i) {
-            int centerX = i % mapWidth;
-            int centerY = i / mapWidth;
-
-            if (centerX < radius || centerX >= mapWidth - radius ||
-                centerY < radius || centerY >= mapWidth - radius) {
-                // Near edge, use smaller brush
-                brushIndices[i].push_back(i);
-                brushWeights[i].push_back(1.0f);
-            } else {
-                for (size_t j = 0; j < xOffsets.size(); ++j) {
-                    int idx = (centerY + yOffsets[j]) * mapWidth + (centerX + xOffsets[j]);
-                    brushIndices[i].push_back(idx);
-                    brushWeights[i].push_back(weights[j]);
-                }
-            }
-        }
     }
 
     float HeightmapGenerator::CalculateGradient(const std::vector<float>& heightmap,
@@ -206,111 +254,249 @@ namespace PCG {
                heightSW * (1 - x) * y + heightSE * x * y;
     }
 
-    void HeightmapGenerator::ApplyErosion(std::vector<float>& heightmap, int width, int height,
-                                           const ErosionSettings& settings)
+    void HeightmapGenerator::SimulateDroplet(std::vector<float>& heightmap, int width, int height,
+                                             const ErosionSettings& settings,
+                                             const std::vector<int>& brushOffsets,
+                                             const std::vector<float>& brushWeights,
+                                             float minX, float minY, float maxX, float maxY,
+                                             float posX, float posY) const
     {
-        int mapSize = width * height;
-
-        // Pre-compute erosion brush data
-        std::vector<std::vector<int>> erosionBrushIndices;
-        std::vector<std::vector<float>> erosionBrushWeights;
-        InitErosionBrushes(settings.ErosionRadius, erosionBrushIndices,
-                           erosionBrushWeights, mapSize);
-
-        std::mt19937 rng(12345);
-        std::uniform_real_distribution<float> dist(0.0f, 1.0f);
-
-        for (int iteration = 0; iteration < settings.Iterations; ++iteration) {
-            // Spawn droplet at random position
-            float posX = dist(rng) * (width - 2) + 1;
-            float posY = dist(rng) * (height - 2) + 1;
-            float dirX = 0;
-            float dirY = 0;
-            float speed = 1;
-            float water = 1;
-            float sediment = 0;
-
-            for (int lifetime = 0; lifetime < settings.MaxDropletLifetime; ++lifetime) {
-                int nodeX = static_cast<int>(posX);
-                int nodeY = static_cast<int>(posY);
-                int dropletIndex = nodeY * width + nodeX;
-
-                // Calculate droplet's offset inside cell
-                float cellOffsetX = posX - nodeX;
-                float cellOffsetY = posY - nodeY;
-
-                // Calculate gradient and height
-                float gradientX, gradientY;
-                float heightAtPos = CalculateGradient(heightmap, width, height,
-                                                       posX, posY, gradientX, gradientY);
-
-                // Update direction with inertia
-                dirX = dirX * settings.Inertia - gradientX * (1 - settings.Inertia);
-                dirY = dirY * settings.Inertia - gradientY * (1 - settings.Inertia);
-
-                // Normalize direction
-                float len = std::sqrt(dirX * dirX + dirY * dirY);
-                if (len > 0.0001f) {
-                    dirX /= len;
-                    dirY /= len;
-                }
+        const int radius = settings.ErosionRadius;
+
+        float dirX = 0;
+        float dirY = 0;
+        float speed = 1;
+        float water = 1;
+        float sediment = 0;
+
+        for (int lifetime = 0; lifetime < settings.MaxDropletLifetime; ++lifetime) {
+            int nodeX = static_cast<int>(posX);
+            int nodeY = static_cast<int>(posY);
+            int dropletIndex = nodeY * width + nodeX;
+
+            // Calculate droplet's offset inside cell
+            float cellOffsetX = posX - nodeX;
+            float cellOffsetY = posY - nodeY;
+
+            // Calculate gradient and height
+            float gradientX, gradientY;
+            float heightAtPos = CalculateGradient(heightmap, width, height,
+                                                   posX, posY, gradientX, gradientY);
+
+            // Update direction with inertia
+            dirX = dirX * settings.Inertia - gradientX * (1 - settings.Inertia);
+            dirY = dirY * settings.Inertia - gradientY * (1 - settings.Inertia);
+
+            // Normalize direction
+            float len = std::sqrt(dirX * dirX + dirY * dirY);
+            if (len > 0.0001f) {
+                dirX /= len;
+                dirY /= len;
+            }
 
-                // Move droplet
-                float newPosX = posX + dirX;
-                float newPosY = posY + dirY;
+            // Move droplet
+            float newPosX = posX + dirX;
+            float newPosY = posY + dirY;
 
-                // Check bounds
-                if (newPosX < 1 || newPosX >= width - 2 ||
-                    newPosY < 1 || newPosY >= height - 2) {
-                    break;
-                }
+            // Check bounds
+            if (newPosX < minX || newPosX >= maxX ||
+                newPosY < minY || newPosY >= maxY) {
+                break;
+            }
 
-                // Calculate new height
-                float newHeight = CalculateGradient(heightmap, width, height,
-                                                     newPosX, newPosY, gradientX, gradientY);
-                float deltaHeight = newHeight - heightAtPos;
-
-                // Calculate sediment capacity
-                float sedimentCapacity = std::max(-deltaHeight * speed * water *
-                                                   settings.SedimentCapacity,
-                                                   settings.MinSedimentCapacity);
-
-                // Deposit or erode
-                if (sediment > sedimentCapacity || deltaHeight > 0) {
-                    // Deposit sediment
-                    float amountToDeposit = (deltaHeight > 0) ? std::min(deltaHeight, sediment) :
-                                            (sediment - sedimentCapacity) * settings.DepositSpeed;
-                    sediment -= amountToDeposit;
-
-                    // Deposit to 4 nodes
-                    heightmap[dropletIndex] += amountToDeposit * (1 - cellOffsetX) * (1 - cellOffsetY);
-                    heightmap[dropletIndex + 1] += amountToDeposit * cellOffsetX * (1 - cellOffsetY);
-                    heightmap[dropletIndex + width] += amountToDeposit * (1 - cellOffsetX) * cellOffsetY;
-                    heightmap[dropletIndex + width + 1] += amountToDeposit * cellOffsetX * cellOffsetY;
+            // Calculate new height
+            float newHeight = CalculateGradient(heightmap, width, height,
+                                                 newPosX, newPosY, gradientX, gradientY);
+            float deltaHeight = newHeight - heightAtPos;
+
+            // Calculate sediment capacity
+            float sedimentCapacity = std::max(-deltaHeight * speed * water *
+                                               settings.SedimentCapacity,
+                                               settings.MinSedimentCapacity);
+
+            // Deposit or erode
+            if (sediment > sedimentCapacity || deltaHeight > 0) {
+                // Deposit sediment
+                float amountToDeposit = (deltaHeight > 0) ? std::min(deltaHeight, sediment) :
+                                        (sediment - sedimentCapacity) * settings.DepositSpeed;
+                sediment -= amountToDeposit;
+
+                // Deposit to 4 nodes
+                heightmap[dropletIndex] += amountToDeposit * (1 - cellOffsetX) * (1 - cellOffsetY);
+                heightmap[dropletIndex + 1] += amountToDeposit * cellOffsetX * (1 - cellOffsetY);
+                heightmap[dropletIndex + width] += amountToDeposit * (1 - cellOffsetX) * cellOffsetY;
+                heightmap[dropletIndex + width + 1] += amountToDeposit * cellOffsetX * cellOffsetY;
+            } else {
+                // Erode
+                float amountToErode = std::min((sedimentCapacity - sediment) * settings.ErodeSpeed,
+                                                -deltaHeight);
+
+                if (nodeX < radius || nodeX >= width - radius ||
+                    nodeY < radius || nodeY >= height - radius) {
+                    // Near edge, erode the droplet's node only
+                    float deltaSediment = std::min(heightmap[dropletIndex], amountToErode);
+                    heightmap[dropletIndex] -= deltaSediment;
+                    sediment += deltaSediment;
                 } else {
-                    // Erode
-                    float amountToErode = std::min((sedimentCapacity - sediment) * settings.ErodeSpeed,
-                                                    -deltaHeight);
-
                     // Use erosion brush
-                    const auto& brushIndices = erosionBrushIndices[dropletIndex];
-                    const auto& brushWeights = erosionBrushWeights[dropletIndex];
-
-                    for (size_t i = 0; i < brushIndices.size(); ++i) {
-                        int idx = brushIndices[i];
+                    for (size_t i = 0; i < brushOffsets.size(); ++i) {
+                        int idx = dropletIndex + brushOffsets[i];
                         float erodeAmount = amountToErode * brushWeights[i];
                         float deltaSediment = std::min(heightmap[idx], erodeAmount);
                         heightmap[idx] -= deltaSediment;
                         sediment += deltaSediment;
                     }
                 }
+            }
+
+            // Update speed and water
+            speed = std::sqrt(std::max(0.0f, speed * speed + deltaHeight * settings.Gravity));
+            water *= (1 - settings.EvaporateSpeed);
+
+            posX = newPosX;
+            posY = newPosY;
+        }
+    }
+
+    void HeightmapGenerator::ApplyErosion(std::vector<float>& heightmap, int width, int height,
+                                           const ErosionSettings& settings)
+    {
+        if (width < 4 || height < 4 || settings.Iterations <= 0) return;
+
+        // Pre-compute erosion brush data
+        std::vector<int> brushOffsets;
+        std::vector<float> brushWeights;
+        InitErosionBrushes(settings.ErosionRadius, width, brushOffsets, brushWeights);
+
+        const float minX = 1.0f;
+        const float minY = 1.0f;
+        const float maxX = static_cast<float>(width - 2);
+        const float maxY = static_cast<float>(height - 2);
+
+        if (!settings.Parallel) {
+            std::mt19937 rng(settings.Seed);
+            std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+            for (int iteration = 0; iteration < settings.Iterations; ++iteration) {
+                // Spawn droplet at random position
+                float posX = dist(rng) * (width - 2) + 1;
+                float posY = dist(rng) * (height - 2) + 1;
+
+                SimulateDroplet(heightmap, width, height, settings, brushOffsets, brushWeights,
+                                minX, minY, maxX, maxY, posX, posY);
+            }
+            return;
+        }
+
+        // Parallel: a droplet stays inside its tile, and touches at most
+        // max(radius, 2) cells beyond it. Tiles of one checkerboard colour are a
+        // whole tile apart, so with tiles wider than twice that reach, tiles of
+        // the same phase never share cells and can run concurrently.
+        const int reach = std::max(settings.ErosionRadius, 2);
+        const int tileSize = std::max(settings.TileSize, 2 * reach + 2);
+
+        // Several rounds with a half-tile grid shift, so tile borders do not
+        // leave straight seams where droplets were cut off
+        constexpr int ROUNDS = 4;
+
+        unsigned int threadCount = settings.ThreadCount > 0
+            ? static_cast<unsigned int>(settings.ThreadCount)
+            : std::max(1u, std::thread::hardware_concurrency());
+
+        struct ErosionTile {
+            int X0, Y0, X1, Y1;         ///< Node bounds (half-open), clipped to the map
+            int Index;                  ///< Stable tile index for seeding
+            int DropletCount;
+        };
+
+        std::vector<ErosionTile> tiles;
+
+        for (int round = 0; round < ROUNDS; ++round) {
+            const int shift = (round % 2) * (tileSize / 2);
+            const int tilesX = (width + shift + tileSize - 1) / tileSize;
+            const int tilesY = (height + shift + tileSize - 1) / tileSize;
+
+            // Spread this round's droplets over tiles by spawnable area
+            const int64_t roundDroplets = settings.Iterations / ROUNDS +
+                (round < settings.Iterations % ROUNDS ? 1 : 0);
+
+            tiles.clear();
+            int64_t totalArea = 0;
+            for (int ty = 0; ty < tilesY; ++ty) {
+                for (int tx = 0; tx < tilesX; ++tx) {
+                    ErosionTile tile;
+                    tile.X0 = std::max(tx * tileSize - shift, 1);
+                    tile.Y0 = std::max(ty * tileSize - shift, 1);
+                    tile.X1 = std::min((tx + 1) * tileSize - shift, width - 2);
+                    tile.Y1 = std::min((ty + 1) * tileSize - shift, height - 2);
+                    tile.Index = ty * tilesX + tx;
+                    tile.DropletCount = 0;
+                    if (tile.X1 > tile.X0 && tile.Y1 > tile.Y0) {
+                        totalArea += static_cast<int64_t>(tile.X1 - tile.X0) * (tile.Y1 - tile.Y0);
+                    }
+                    tiles.push_back(tile);
+                }
+            }
 
-                // Update speed and water
-                speed = std::sqrt(std::max(0.0f, speed * speed + deltaHeight * settings.Gravity));
-                water *= (1 - settings.EvaporateSpeed);
+            int64_t areaSoFar = 0;
+            for (ErosionTile& tile : tiles) {
+                if (tile.X1 <= tile.X0 || tile.Y1 <= tile.Y0 || totalArea == 0) continue;
+                int64_t start = roundDroplets * areaSoFar / totalArea;
+                areaSoFar += static_cast<int64_t>(tile.X1 - tile.X0) * (tile.Y1 - tile.Y0);
+                tile.DropletCount = static_cast<int>(roundDroplets * areaSoFar / totalArea - start);
+            }
 
-                posX = newPosX;
-                posY = newPosY;
+            for (int phase = 0; phase < 4; ++phase) {
+                // Tiles of this checkerboard colour
+                std::vector<const ErosionTile*> phaseTiles;
+                for (const ErosionTile& tile : tiles) {
+                    int tx = tile.Index % tilesX;
+                    int ty = tile.Index / tilesX;
+                    if ((tx % 2) + 2 * (ty % 2) == phase && tile.DropletCount > 0) {
+                        phaseTiles.push_back(&tile);
+                    }
+                }
+
+                std::atomic<size_t> nextTile{ 0 };
+                auto worker = [&]() {
+                    for (size_t i = nextTile.fetch_add(1); i < phaseTiles.size(); i = nextTile.fetch_add(1)) {
+                        const ErosionTile& tile = *phaseTiles[i];
+
+                        // Per-tile RNG: independent of which thread runs the tile
+                        std::seed_seq seq{ settings.Seed, static_cast<uint32_t>(round),
+                                           static_cast<uint32_t>(tile.Index) };
+                        std::mt19937 rng(seq);
+                        std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+                        const float x0 = static_cast<float>(tile.X0);
+                        const float y0 = static_cast<float>(tile.Y0);
+                        const float x1 = static_cast<float>(tile.X1);
+                        const float y1 = static_cast<float>(tile.Y1);
+
+                        for (int d = 0; d < tile.DropletCount; ++d) {
+                            float posX = x0 + dist(rng) * (x1 - x0);
+                            float posY = y0 + dist(rng) * (y1 - y0);
+                            if (posX >= x1) posX = std::nextafter(x1, x0);
+                            if (posY >= y1) posY = std::nextafter(y1, y0);
+
+                            SimulateDroplet(heightmap, width, height, settings, brushOffsets, brushWeights,
+                                            x0, y0, x1, y1, posX, posY);
+                        }
+                    }
+                };
+
+                const unsigned int helperCount = static_cast<unsigned int>(
+                    std::min<size_t>(threadCount, phaseTiles.size())) - (phaseTiles.empty() ? 0 : 1);
+
+                std::vector<std::thread> helpers;
+                helpers.reserve(helperCount);
+                for (unsigned int t = 0; t < helperCount; ++t) {
+                    helpers.emplace_back(worker);
+                }
+                worker();
+                for (std::thread& helper : helpers) {
+                    helper.join();
+                }
             }
         }
     }
@@ -358,23 +544,13 @@ namespace PCG {
     {
         std::vector<float> falloff(width * height);
 
-        for (int y = 0; y < height; ++y) {
-            for (int x = 0; x < width; ++x) {
-                // Normalize to [-1, 1]
-                float nx = static_cast<float>(x) / width * 2.0f - 1.0f;
-                float ny = static_cast<float>(y) / height * 2.0f - 1.0f;
-
-                // Use max of abs values for square falloff
-                float value = std::max(std::abs(nx), std::abs(ny));
-
-                // Apply smoothstep for smoother transition
-                float a = 3.0f;
-                float b = 2.2f;
-                value = std::pow(value, a) / (std::pow(value, a) + std::pow(b - b * value, a));
-
-                falloff[y * width + x] = 1.0f - value;
+        ParallelForRows(height, m_ThreadCount, [&](int rowBegin, int rowEnd) {
+            for (int y = rowBegin; y < rowEnd; ++y) {
+                for (int x = 0; x < width; ++x) {
+                    falloff[y * width + x] = FalloffAt(x, y, width, height);
+                }
             }
-        }
+        });
 
         return falloff;
     }
@@ -382,12 +558,15 @@ namespace PCG {
     void HeightmapGenerator::ApplyFalloff(std::vector<float>& heightmap, int width, int height,
                                            float falloffStrength)
     {
-        std::vector<float> falloff = GenerateFalloffMap(width, height);
-
-        for (size_t i = 0; i < heightmap.size(); ++i) {
-            float falloffValue = 1.0f - (1.0f - falloff[i]) * falloffStrength;
-            heightmap[i] *= falloffValue;
-        }
+        // Evaluated in place rather than through a temporary falloff map
+        ParallelForRows(height, m_ThreadCount, [&](int rowBegin, int rowEnd) {
+            for (int y = rowBegin; y < rowEnd; ++y) {
+                for (int x = 0; x < width; ++x) {
+                    float falloffValue = 1.0f - (1.0f - FalloffAt(x, y, width, height)) * falloffStrength;
+                    heightmap[y * width + x] *= falloffValue;
+                }
+            }
+        });
     }
 
     void HeightmapGenerator::ApplyRadialFalloff(std::vector<float>& heightmap, int width, int height,
@@ -428,29 +607,45 @@ namespace PCG {
 
     void HeightmapGenerator::Smooth(std::vector<float>& heightmap, int width, int height, int radius)
     {
+        // The box clipped to the map is a rectangle, so its mean is a
+        // horizontal mean followed by a vertical one: O(r) per pixel, not O(r^2)
         std::vector<float> temp(heightmap.size());
 
-        for (int y = 0; y < height; ++y) {
-            for (int x = 0; x < width; ++x) {
-                float sum = 0;
-                int count = 0;
-
-                for (int dy = -radius; dy <= radius; ++dy) {
-                    for (int dx = -radius; dx <= radius; ++dx) {
-                        int nx = x + dx;
-                        int ny = y + dy;
-                        if (nx >= 0 && nx < width && ny >= 0 && ny < height) {
-                            sum += heightmap[ny * width + nx];
-                            count++;
-                        }
+        ParallelForRows(height, m_ThreadCount, [&](int rowBegin, int rowEnd) {
+            for (int y = rowBegin; y < rowEnd; ++y) {
+                const float* row = heightmap.data() + static_cast<size_t>(y) * width;
+                for (int x = 0; x < width; ++x) {
+                    int x0 = std::max(x - radius, 0);
+                    int x1 = std::min(x + radius, width - 1);
+
+                    float sum = 0;
+                    for (int nx = x0; nx <= x1; ++nx) {
+                        sum += row[nx];
                     }
+                    temp[y * width + x] = sum / (x1 - x0 + 1);
                 }
-
-                temp[y * width + x] = sum / count;
             }
-        }
-
-        heightmap = std::move(temp);
+        });
+
+        ParallelForRows(height, m_ThreadCount, [&](int rowBegin, int rowEnd) {
+            for (int y = rowBegin; y < rowEnd; ++y) {
+                int y0 = std::max(y - radius, 0);
+                int y1 = std::min(y + radius, height - 1);
+                float invCount = 1.0f / (y1 - y0 + 1);
+
+                float* out = heightmap.data() + static_cast<size_t>(y) * width;
+                std::fill(out, out + width, 0.0f);
+                for (int ny = y0; ny <= y1; ++ny) {
+                    const float* row = temp.data() + static_cast<size_t>(ny) * width;
+                    for (int x = 0; x < width; ++x) {
+                        out[x] += row[x];
+                    }
+                }
+                for (int x = 0; x < width; ++x) {
+                    out[x] *= invCount;
+                }
+            }
+        });
     }
 
     // ============================================================================
@@ -460,36 +655,64 @@ namespace PCG {
     void HeightmapGenerator::ApplyThermalErosion(std::vector<float>& heightmap, int width, int height,
                                                   int iterations, float talusAngle)
     {
+        if (width < 3 || height < 3) return;
+
+        // Double-buffered: every cell's slump is decided from the previous
+        // iteration, then each cell gathers what its neighbours sent it.
+        // Neither pass writes a cell another row block reads, so rows run in parallel.
+        enum : uint8_t { NONE, UP, DOWN, LEFT, RIGHT };
+
+        const size_t cellCount = heightmap.size();
+        std::vector<float> next(cellCount);
+        std::vector<float> moved(cellCount, 0.0f);
+        std::vector<uint8_t> target(cellCount, NONE);
+
         for (int iter = 0; iter < iterations; ++iter) {
-            for (int y = 1; y < height - 1; ++y) {
-                for (int x = 1; x < width - 1; ++x) {
-                    float h = heightmap[y * width + x];
-                    float maxDiff = 0;
-                    int maxIdx = -1;
-
-                    // Check 4 neighbors
-                    int neighbors[4] = {
-                        (y - 1) * width + x,
-                        (y + 1) * width + x,
-                        y * width + (x - 1),
-                        y * width + (x + 1)
-                    };
-
-                    for (int i = 0; i < 4; ++i) {
-                        float diff = h - heightmap[neighbors[i]];
-                        if (diff > talusAngle && diff > maxDiff) {
-                            maxDiff = diff;
-                            maxIdx = neighbors[i];
+            // Pass 1: steepest lower neighbour of each interior cell
+            ParallelForRows(height - 2, m_ThreadCount, [&](int rowBegin, int rowEnd) {
+                for (int y = rowBegin + 1; y < rowEnd + 1; ++y) {
+                    for (int x = 1; x < width - 1; ++x) {
+                        const int idx = y * width + x;
+                        const float h = heightmap[idx];
+
+                        // Check 4 neighbors (same order and tie-breaking as before)
+                        const int neighbors[4] = { idx - width, idx + width, idx - 1, idx + 1 };
+                        const uint8_t directions[4] = { UP, DOWN, LEFT, RIGHT };
+
+                        float maxDiff = 0;
+                        uint8_t direction = NONE;
+                        for (int i = 0; i < 4; ++i) {
+                            float diff = h - heightmap[neighbors[i]];
+                            if (diff > talusAngle && diff > maxDiff) {
+                                maxDiff = diff;
+                                direction = directions[i];
+                            }
                         }
+
+                        target[idx] = direction;
+                        moved[idx] = direction != NONE ? (maxDiff - talusAngle) * 0.5f : 0.0f;
                     }
+                }
+            });
+
+            // Pass 2: new height = old - sent + received
+            ParallelForRows(height, m_ThreadCount, [&](int rowBegin, int rowEnd) {
+                for (int y = rowBegin; y < rowEnd; ++y) {
+                    for (int x = 0; x < width; ++x) {
+                        const int idx = y * width + x;
+                        float h = heightmap[idx] - moved[idx];
+
+                        if (y > 0 && target[idx - width] == DOWN) h += moved[idx - width];
+                        if (y < height - 1 && target[idx + width] == UP) h += moved[idx + width];
+                        if (x > 0 && target[idx - 1] == RIGHT) h += moved[idx - 1];
+                        if (x < width - 1 && target[idx + 1] == LEFT) h += moved[idx + 1];
 
-                    if (maxIdx >= 0) {
-                        float move = (maxDiff - talusAngle) * 0.5f;
-                        heightmap[y * width + x] -= move;
-                        heightmap[maxIdx] += move;
+                        next[idx] = h;
                     }
                 }
-            }
+            });
+
+            heightmap.swap(next);
         }
     }
 
@@ -503,31 +726,33 @@ namespace PCG {
     {
         std::vector<float> normals(width * height * 3);
 
-        for (int y = 0; y < height; ++y) {
-            for (int x = 0; x < width; ++x) {
-                // Get neighboring heights
-                float hL = (x > 0) ? heightmap[y * width + (x - 1)] : heightmap[y * width + x];
-                float hR = (x < width - 1) ? heightmap[y * width + (x + 1)] : heightmap[y * width + x];
-                float hD = (y > 0) ? heightmap[(y - 1) * width + x] : heightmap[y * width + x];
-                float hU = (y < height - 1) ? heightmap[(y + 1) * width + x] : heightmap[y * width + x];
-
-                // Calculate normal
-                float nx = (hL - hR) * heightScale;
-                float ny = 2.0f;
-                float nz = (hD - hU) * heightScale;
-
-                // Normalize
-                float len = std::sqrt(nx * nx + ny * ny + nz * nz);
-                nx /= len;
-                ny /= len;
-                nz /= len;
-
-                int idx = (y * width + x) * 3;
-                normals[idx] = nx;
-                normals[idx + 1] = ny;
-                normals[idx + 2] = nz;
+        ParallelForRows(height, m_ThreadCount, [&](int rowBegin, int rowEnd) {
+            for (int y = rowBegin; y < rowEnd; ++y) {
+                for (int x = 0; x < width; ++x) {
+                    // Get neighboring heights
+                    float hL = (x > 0) ? heightmap[y * width + (x - 1)] : heightmap[y * width + x];
+                    float hR = (x < width - 1) ? heightmap[y * width + (x + 1)] : heightmap[y * width + x];
+                    float hD = (y > 0) ? heightmap[(y - 1) * width + x] : heightmap[y * width + x];
+                    float hU = (y < height - 1) ? heightmap[(y + 1) * width + x] : heightmap[y * width + x];
+
+                    // Calculate normal
+                    float nx = (hL - hR) * heightScale;
+                    float ny = 2.0f;
+                    float nz = (hD - hU) * heightScale;
+
+                    // Normalize
+                    float len = std::sqrt(nx * nx + ny * ny + nz * nz);
+                    nx /= len;
+                    ny /= len;
+                    nz /= len;
+
+                    int idx = (y * width + x) * 3;
+                    normals[idx] = nx;
+                    normals[idx + 1] = ny;
+                    normals[idx + 2] = nz;
+                }
             }
-        }
+        });
 
         return normals;
     }
@@ -9,6 +9,7 @@
  */
 
 #include "FBM.h"
+#include <algorithm>
 #include <vector>
 #include <functional>
 
@@ -111,6 +112,12 @@ namespace PCG {
         float EvaporateSpeed = 0.01f; ///< Water evaporation rate
         float Gravity = 4.0f;         ///< Affects droplet speed on slopes
         int ErosionRadius = 3;        ///< Erosion brush radius
+        uint32_t Seed = 12345;        ///< Seed for droplet spawn positions
+
+        // Parallel simulation
+        bool Parallel = false;        ///< Simulate droplets on all cores in tiled phases
+        int TileSize = 64;            ///< Parallel tile edge in cells (raised to fit the brush)
+        int ThreadCount = 0;          ///< Parallel worker threads (0 = hardware concurrency)
     };
 
     /**
@@ -124,6 +131,20 @@ namespace PCG {
         HeightmapGenerator();
         ~HeightmapGenerator() = default;
 
+        /**
+         * @brief Set how many threads generation and per-pixel passes use
+         * @param count Thread count (0 = hardware concurrency, 1 = calling thread only)
+         *
+         * Work is split into row blocks that each write their own rows, so
+         * results are identical for every thread count.
+         */
+        void SetThreadCount(int count) { m_ThreadCount = std::max(count, 0); }
+
+        /**
+         * @brief Get the configured thread count (0 = hardware concurrency)
+         */
+        int GetThreadCount() const { return m_ThreadCount; }
+
         // ====================================================================
         // Generation
         // ====================================================================
@@ -138,7 +159,8 @@ namespace PCG {
         /**
          * @brief Generate heightmap using a custom noise function
          * @param settings Generation parameters
-         * @param noiseFunc Custom function (x, y) -> height
+         * @param noiseFunc Custom function (x, y) -> height; called concurrently
+         *                  from several threads unless the thread count is 1
          * @return Vector of height values
          */
         std::vector<float> GenerateCustom(const HeightmapSettings& settings,
@@ -154,6 +176,12 @@ namespace PCG {
          * @param width Map width
          * @param height Map height
          * @param settings Erosion parameters
+         *
+         * With settings.Parallel the map is split into tiles processed in four
+         * checkerboard phases, so concurrently simulated droplets never touch
+         * the same cells. Each tile has its own seeded RNG, so the result is
+         * the same from run to run and for any thread count (but differs from
+         * the serial result).
          */
         void ApplyErosion(std::vector<float>& heightmap, int width, int height,
                           const ErosionSettings& settings = ErosionSettings());
@@ -203,11 +231,14 @@ namespace PCG {
         void ApplyTerracing(std::vector<float>& heightmap, int levels);
 
         /**
-         * @brief Smooth the heightmap using gaussian blur
+         * @brief Smooth the heightmap with a box blur
          * @param heightmap Height data to modify (in-place)
          * @param width Map width
          * @param height Map height
          * @param radius Blur radius
+         *
+         * Runs as separable horizontal and vertical passes. The box is
+         * clipped at the map edges.
          */
         void Smooth(std::vector<float>& heightmap, int width, int height, int radius = 1);
 
@@ -218,6 +249,9 @@ namespace PCG {
          * @param height Map height
          * @param iterations Number of iterations
          * @param talusAngle Maximum stable slope angle
+         *
+         * Each iteration moves material based on the previous iteration's
+         * heights (double-buffered), so cells update independently of scan order.
          */
         void ApplyThermalErosion(std::vector<float>& heightmap, int width, int height,
                                   int iterations = 50, float talusAngle = 0.5f);
@@ -273,13 +307,21 @@ namespace PCG {
                              int x, int y) const;
 
     private:
+        int m_ThreadCount = 0;  ///< Threads for row-parallel passes (0 = hardware concurrency)
         std::unique_ptr<FBM> m_FBM;
         std::unique_ptr<INoise> m_BaseNoise;
 
-        // Helper for erosion
-        void InitErosionBrushes(int radius, std::vector<std::vector<int>>& brushIndices,
-                                std::vector<std::vector<float>>& brushWeights,
-                                int mapSize);
+        // Helpers for erosion
+        void InitErosionBrushes(int radius, int width,
+                                std::vector<int>& brushOffsets,
+                                std::vector<float>& brushWeights);
+
+        void SimulateDroplet(std::vector<float>& heightmap, int width, int height,
+                             const ErosionSettings& settings,
+                             const std::vector<int>& brushOffsets,
+                             const std::vector<float>& brushWeights,
+                             float minX, float minY, float maxX, float maxY,
+                             float posX, float posY) const;
 
         float CalculateGradient(const std::vector<float>& heightmap,
                                 int width, int height,
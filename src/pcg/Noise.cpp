@@ -1,10 +1,399 @@
 #include "Noise.h"
+#include "NoiseSIMD.h"
 #include <algorithm>
 #include <cmath>
 #include <numeric>
 
 namespace PCG {
 
+    // ============================================================================
+    // INoise Batch Sampling (scalar fallback)
+    // ============================================================================
+
+    void INoise::SampleGrid(float originX, float originY, float step, int width, int height,
+                            float* out, float frequency) const
+    {
+        for (int row = 0; row < height; ++row) {
+            const float y = (originY + static_cast<float>(row) * step) * frequency;
+            for (int col = 0; col < width; ++col) {
+                const float x = (originX + static_cast<float>(col) * step) * frequency;
+                out[static_cast<size_t>(row) * width + col] = Sample(x, y);
+            }
+        }
+    }
+
+    void INoise::SamplePoints(const float* xs, const float* ys, size_t count, float* out) const
+    {
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = Sample(xs[i], ys[i]);
+        }
+    }
+
+    // ============================================================================
+    // Worley Cell Search
+    // ============================================================================
+    //
+    // Cells are visited nearest first. For F1, a corner cell is skipped when the
+    // gap from the sample point to its nearest edge is no closer than the best
+    // distance so far. Feature points lie inside their cell and rounding is
+    // monotonic, so the gap never exceeds a computed distance and the pruned
+    // search returns exactly what the full one does. Face and edge cells are
+    // rarely skippable, and F2 rarely prunes anything, so neither is tested.
+
+    namespace {
+
+        struct WorleyCellOffset
+        {
+            int32_t X, Y, Z;
+        };
+
+        constexpr int32_t WorleyRing(const WorleyCellOffset& offset)
+        {
+            return (offset.X < 0 ? -offset.X : offset.X) + (offset.Y < 0 ? -offset.Y : offset.Y) +
+                   (offset.Z < 0 ? -offset.Z : offset.Z);
+        }
+
+        /// The 3x3 (Z = 0) or 3x3x3 neighbourhood, centre first, then faces, edges and corners
+        template <size_t Count>
+        constexpr std::array<WorleyCellOffset, Count> BuildWorleySearchOrder()
+        {
+            constexpr int32_t zRange = Count == 27 ? 1 : 0;
+            std::array<WorleyCellOffset, Count> order{};
+            size_t count = 0;
+            for (int32_t ring = 0; ring <= 3; ++ring) {
+                for (int32_t dz = -zRange; dz <= zRange; ++dz) {
+                    for (int32_t dy = -1; dy <= 1; ++dy) {
+                        for (int32_t dx = -1; dx <= 1; ++dx) {
+                            if (WorleyRing({ dx, dy, dz }) == ring) {
+                                order[count++] = { dx, dy, dz };
+                            }
+                        }
+                    }
+                }
+            }
+            return order;
+        }
+
+        constexpr std::array<WorleyCellOffset, 9> WORLEY_SEARCH_ORDER_2D = BuildWorleySearchOrder<9>();
+        constexpr std::array<WorleyCellOffset, 27> WORLEY_SEARCH_ORDER_3D = BuildWorleySearchOrder<27>();
+
+        template <WorleyNoise::DistanceFunction Func>
+        float WorleyDistance(float dx, float dy)
+        {
+            if constexpr (Func == WorleyNoise::DistanceFunction::Manhattan) {
+                return std::abs(dx) + std::abs(dy);
+            } else if constexpr (Func == WorleyNoise::DistanceFunction::Chebyshev) {
+                return std::max(std::abs(dx), std::abs(dy));
+            } else {
+                return std::sqrt(dx * dx + dy * dy);
+            }
+        }
+
+        template <WorleyNoise::DistanceFunction Func>
+        float WorleyDistance(float dx, float dy, float dz)
+        {
+            if constexpr (Func == WorleyNoise::DistanceFunction::Manhattan) {
+                return std::abs(dx) + std::abs(dy) + std::abs(dz);
+            } else if constexpr (Func == WorleyNoise::DistanceFunction::Chebyshev) {
+                return std::max(std::max(std::abs(dx), std::abs(dy)), std::abs(dz));
+            } else {
+                return std::sqrt(dx * dx + dy * dy + dz * dz);
+            }
+        }
+
+        /// Whether a cell is tested against the closest distance before it is visited
+        template <WorleyNoise::ReturnType Type>
+        constexpr bool ShouldPruneCell(const WorleyCellOffset& offset)
+        {
+            return Type == WorleyNoise::ReturnType::F1 && WorleyRing(offset) >= 2;
+        }
+
+        template <WorleyNoise::ReturnType Type>
+        float WorleyResult(float minDist1, float minDist2)
+        {
+            float result;
+            if constexpr (Type == WorleyNoise::ReturnType::F2) {
+                result = minDist2;
+            } else if constexpr (Type == WorleyNoise::ReturnType::F2MinusF1) {
+                result = minDist2 - minDist1;
+            } else if constexpr (Type == WorleyNoise::ReturnType::F1PlusF2) {
+                result = (minDist1 + minDist2) * 0.5f;
+            } else {
+                result = minDist1;
+            }
+
+            // Normalize to [0, 1] approximately
+            return std::min(1.0f, result);
+        }
+
+    } // namespace
+
+#if PCG_NOISE_SIMD
+    // ============================================================================
+    // SIMD Lane Kernels
+    // ============================================================================
+    //
+    // Each kernel evaluates SIMD::Width points of the matching scalar 2D
+    // Sample, using the same operations in the same order.
+
+    namespace {
+
+        using SIMD::VFloat;
+        using SIMD::VInt;
+
+        VFloat PerlinFade(VFloat t)
+        {
+            using namespace SIMD;
+            return Mul(Mul(Mul(t, t), t), Add(Mul(t, Sub(Mul(t, Set1(6.0f)), Set1(15.0f))), Set1(10.0f)));
+        }
+
+        /// Perlin Grad(hash, x, y, 0)
+        VFloat PerlinGrad2D(VInt hash, VFloat x, VFloat y)
+        {
+            using namespace SIMD;
+            VInt h = And(hash, Set1(15));
+            VFloat u = Select(AsFloat(CmpLt(h, Set1(8))), x, y);
+            VFloat vIfNotY = Select(AsFloat(Or(CmpEq(h, Set1(12)), CmpEq(h, Set1(14)))), x, Set1(0.0f));
+            VFloat v = Select(AsFloat(CmpLt(h, Set1(4))), y, vIfNotY);
+            return Add(FlipSign(u, ShiftLeft<31>(And(h, Set1(1)))),
+                       FlipSign(v, ShiftLeft<30>(And(h, Set1(2)))));
+        }
+
+        VFloat PerlinLanes2D(const int* perm, VFloat x, VFloat y)
+        {
+            using namespace SIMD;
+            const VInt one = Set1(1);
+            const VFloat oneF = Set1(1.0f);
+
+            VFloat floorX = Floor(x);
+            VFloat floorY = Floor(y);
+            VInt X = And(ToInt(floorX), Set1(255));
+            VInt Y = And(ToInt(floorY), Set1(255));
+
+            x = Sub(x, floorX);
+            y = Sub(y, floorY);
+
+            VFloat u = PerlinFade(x);
+            VFloat v = PerlinFade(y);
+
+            // z = 0 plane of the 3D lattice
+            VInt A = Add(Gather(perm, X), Y);
+            VInt AA = Gather(perm, A);
+            VInt AB = Gather(perm, Add(A, one));
+            VInt B = Add(Gather(perm, Add(X, one)), Y);
+            VInt BA = Gather(perm, B);
+            VInt BB = Gather(perm, Add(B, one));
+
+            VFloat xm1 = Sub(x, oneF);
+            VFloat ym1 = Sub(y, oneF);
+
+            return Lerp(
+                Lerp(PerlinGrad2D(Gather(perm, AA), x, y),
+                     PerlinGrad2D(Gather(perm, BA), xm1, y), u),
+                Lerp(PerlinGrad2D(Gather(perm, AB), x, ym1),
+                     PerlinGrad2D(Gather(perm, BB), xm1, ym1), u),
+                v);
+        }
+
+        VFloat SimplexCorner2D(const float* grad2, VInt gradientIndex, VFloat x, VFloat y)
+        {
+            using namespace SIMD;
+            VFloat t = Sub(Sub(Set1(0.5f), Mul(x, x)), Mul(y, y));
+            VFloat t2 = Mul(t, t);
+
+            VInt offset = Add(gradientIndex, gradientIndex);
+            VFloat dot = Add(Mul(Gather(grad2, offset), x), Mul(Gather(grad2, Add(offset, Set1(1))), y));
+
+            return Select(CmpLt(t, Set1(0.0f)), Set1(0.0f), Mul(Mul(t2, t2), dot));
+        }
+
+        VFloat SimplexLanes2D(const int* perm, const int* permMod12, const float* grad2,
+                              float f2, float g2, VFloat x, VFloat y)
+        {
+            using namespace SIMD;
+            const VInt one = Set1(1);
+
+            VFloat s = Mul(Add(x, y), Set1(f2));
+            VInt i = ToInt(Floor(Add(x, s)));
+            VInt j = ToInt(Floor(Add(y, s)));
+
+            VFloat t = Mul(ToFloat(Add(i, j)), Set1(g2));
+            VFloat x0 = Sub(x, Sub(ToFloat(i), t));
+            VFloat y0 = Sub(y, Sub(ToFloat(j), t));
+
+            // Lower triangle when x0 > y0
+            VInt i1 = And(AsInt(CmpGt(x0, y0)), one);
+            VInt j1 = Sub(one, i1);
+
+            VFloat x1 = Add(Sub(x0, ToFloat(i1)), Set1(g2));
+            VFloat y1 = Add(Sub(y0, ToFloat(j1)), Set1(g2));
+            VFloat x2 = Add(Sub(x0, Set1(1.0f)), Set1(2.0f * g2));
+            VFloat y2 = Add(Sub(y0, Set1(1.0f)), Set1(2.0f * g2));
+
+            VInt ii = And(i, Set1(255));
+            VInt jj = And(j, Set1(255));
+            VInt gi0 = Gather(permMod12, Add(ii, Gather(perm, jj)));
+            VInt gi1 = Gather(permMod12, Add(Add(ii, i1), Gather(perm, Add(jj, j1))));
+            VInt gi2 = Gather(permMod12, Add(Add(ii, one), Gather(perm, Add(jj, one))));
+
+            VFloat n0 = SimplexCorner2D(grad2, gi0, x0, y0);
+            VFloat n1 = SimplexCorner2D(grad2, gi1, x1, y1);
+            VFloat n2 = SimplexCorner2D(grad2, gi2, x2, y2);
+
+            return Mul(Set1(70.0f), Add(Add(n0, n1), n2));
+        }
+
+        VInt WorleyHash2D(VInt seed, VInt x, VInt yTerm)
+        {
+            using namespace SIMD;
+            VInt h = Xor(Xor(seed, Mul(x, Set1(374761393))), yTerm);
+            return Mul(Xor(h, ShiftRightLogical<13>(h)), Set1(1274126177));
+        }
+
+        template <WorleyNoise::DistanceFunction Func>
+        VFloat WorleyDistanceLanes(VFloat dx, VFloat dy)
+        {
+            using namespace SIMD;
+            if constexpr (Func == WorleyNoise::DistanceFunction::Manhattan) {
+                return Add(Abs(dx), Abs(dy));
+            } else if constexpr (Func == WorleyNoise::DistanceFunction::Chebyshev) {
+                return Max(Abs(dx), Abs(dy));
+            } else {
+                return Sqrt(Add(Mul(dx, dx), Mul(dy, dy)));
+            }
+        }
+
+        template <WorleyNoise::DistanceFunction Func, WorleyNoise::ReturnType Type>
+        VFloat WorleyLanes2D(uint32_t seed, VFloat x, VFloat y)
+        {
+            using namespace SIMD;
+            const VInt vSeed = Set1(static_cast<int32_t>(seed));
+            const VInt lowMask = Set1(0xFFFF);
+            const VInt one = Set1(1);
+            const VFloat cellScale = Set1(65535.0f);
+
+            VInt cellX = ToInt(Floor(x));
+            VInt cellY = ToInt(Floor(y));
+
+            // Gap from the point to the nearest edge of the -1, 0 and +1 column and row
+            const VFloat gapX[3] = { Sub(x, ToFloat(cellX)), Set1(0.0f), Sub(ToFloat(Add(cellX, one)), x) };
+            const VFloat gapY[3] = { Sub(y, ToFloat(cellY)), Set1(0.0f), Sub(ToFloat(Add(cellY, one)), y) };
+
+            VFloat minDist1 = Set1(99999.0f);
+            VFloat minDist2 = Set1(99999.0f);
+
+            for (const WorleyCellOffset& offset : WORLEY_SEARCH_ORDER_2D) {
+                // Skip the cell only when no lane can find a closer point in it; eight
+                // lanes rarely all clear a corner, so AVX2 visits every cell
+                if (Width <= 4 && ShouldPruneCell<Type>(offset)) {
+                    const VFloat bound = WorleyDistanceLanes<Func>(gapX[offset.X + 1], gapY[offset.Y + 1]);
+                    if (!AnyTrue(CmpLt(bound, minDist1))) {
+                        continue;
+                    }
+                }
+
+                VInt cx = Add(cellX, Set1(offset.X));
+                VInt cy = Add(cellY, Set1(offset.Y));
+                VInt h = WorleyHash2D(vSeed, cx, Mul(cy, Set1(668265263)));
+
+                VFloat px = Add(ToFloat(cx), Div(ToFloat(And(h, lowMask)), cellScale));
+                VFloat py = Add(ToFloat(cy), Div(ToFloat(And(ShiftRightLogical<16>(h), lowMask)), cellScale));
+                VFloat dist = WorleyDistanceLanes<Func>(Sub(x, px), Sub(y, py));
+
+                minDist2 = Select(CmpLt(dist, minDist1), minDist1, Min(minDist2, dist));
+                minDist1 = Min(minDist1, dist);
+            }
+
+            VFloat result;
+            if constexpr (Type == WorleyNoise::ReturnType::F2) {
+                result = minDist2;
+            } else if constexpr (Type == WorleyNoise::ReturnType::F2MinusF1) {
+                result = Sub(minDist2, minDist1);
+            } else if constexpr (Type == WorleyNoise::ReturnType::F1PlusF2) {
+                result = Mul(Add(minDist1, minDist2), Set1(0.5f));
+            } else {
+                result = minDist1;
+            }
+
+            return Min(result, Set1(1.0f));
+        }
+
+        /**
+         * @brief Call fn with the WorleyLanes2D instantiation for a distance function and return type
+         */
+        template <typename Fn>
+        void WithWorleyLanes(uint32_t seed, WorleyNoise::DistanceFunction distanceFunc,
+                             WorleyNoise::ReturnType returnType, Fn&& fn)
+        {
+            using DistanceFunction = WorleyNoise::DistanceFunction;
+            using ReturnType = WorleyNoise::ReturnType;
+
+            auto withType = [&]<DistanceFunction Func>() {
+                switch (returnType) {
+                    case ReturnType::F2:
+                        fn([seed](VFloat x, VFloat y) { return WorleyLanes2D<Func, ReturnType::F2>(seed, x, y); });
+                        break;
+                    case ReturnType::F2MinusF1:
+                        fn([seed](VFloat x, VFloat y) { return WorleyLanes2D<Func, ReturnType::F2MinusF1>(seed, x, y); });
+                        break;
+                    case ReturnType::F1PlusF2:
+                        fn([seed](VFloat x, VFloat y) { return WorleyLanes2D<Func, ReturnType::F1PlusF2>(seed, x, y); });
+                        break;
+                    default:
+                        fn([seed](VFloat x, VFloat y) { return WorleyLanes2D<Func, ReturnType::F1>(seed, x, y); });
+                }
+            };
+
+            switch (distanceFunc) {
+                case DistanceFunction::Manhattan:
+                    withType.template operator()<DistanceFunction::Manhattan>();
+                    break;
+                case DistanceFunction::Chebyshev:
+                    withType.template operator()<DistanceFunction::Chebyshev>();
+                    break;
+                default:
+                    withType.template operator()<DistanceFunction::Euclidean>();
+            }
+        }
+
+        VInt ValueHash2D(VInt x, VInt y)
+        {
+            using namespace SIMD;
+            VInt hash = Add(Mul(x, Set1(374761393)), Mul(y, Set1(668265263)));
+            hash = Mul(Xor(hash, ShiftRightArithmetic<13>(hash)), Set1(1274126177));
+            return And(hash, Set1(255));
+        }
+
+        VFloat ValueSmoothStep(VFloat t)
+        {
+            using namespace SIMD;
+            return Mul(Mul(t, t), Sub(Set1(3.0f), Mul(Set1(2.0f), t)));
+        }
+
+        VFloat ValueLanes2D(const float* randomValues, VFloat x, VFloat y)
+        {
+            using namespace SIMD;
+            const VInt one = Set1(1);
+
+            VInt xi = ToInt(Floor(x));
+            VInt yi = ToInt(Floor(y));
+
+            VFloat u = ValueSmoothStep(Sub(x, ToFloat(xi)));
+            VFloat v = ValueSmoothStep(Sub(y, ToFloat(yi)));
+
+            VInt xi1 = Add(xi, one);
+            VInt yi1 = Add(yi, one);
+            VFloat n00 = Gather(randomValues, ValueHash2D(xi, yi));
+            VFloat n10 = Gather(randomValues, ValueHash2D(xi1, yi));
+            VFloat n01 = Gather(randomValues, ValueHash2D(xi, yi1));
+            VFloat n11 = Gather(randomValues, ValueHash2D(xi1, yi1));
+
+            return Lerp(Lerp(n00, n10, u), Lerp(n01, n11, u), v);
+        }
+
+    } // namespace
+#endif // PCG_NOISE_SIMD
+
     // ============================================================================
     // Perlin Noise Implementation
     // ============================================================================
@@ -107,6 +496,31 @@ namespace PCG {
         return res;
     }
 
+    void PerlinNoise::SampleGrid(float originX, float originY, float step, int width, int height,
+                                 float* out, float frequency) const
+    {
+#if PCG_NOISE_SIMD
+        const int* perm = m_Permutation.data();
+        SIMD::SampleGrid(originX, originY, step, width, height, frequency, out,
+            [&](SIMD::VFloat x, SIMD::VFloat y) { return PerlinLanes2D(perm, x, y); },
+            [this](float x, float y) { return PerlinNoise::Sample(x, y); });
+#else
+        INoise::SampleGrid(originX, originY, step, width, height, out, frequency);
+#endif
+    }
+
+    void PerlinNoise::SamplePoints(const float* xs, const float* ys, size_t count, float* out) const
+    {
+#if PCG_NOISE_SIMD
+        const int* perm = m_Permutation.data();
+        SIMD::SamplePoints(xs, ys, count, out,
+            [&](SIMD::VFloat x, SIMD::VFloat y) { return PerlinLanes2D(perm, x, y); },
+            [this](float x, float y) { return PerlinNoise::Sample(x, y); });
+#else
+        INoise::SamplePoints(xs, ys, count, out);
+#endif
+    }
+
     // ============================================================================
     // Simplex Noise Implementation
     // ============================================================================
@@ -317,6 +731,35 @@ namespace PCG {
         return 32.0f * (n0 + n1 + n2 + n3);
     }
 
+    void SimplexNoise::SampleGrid(float originX, float originY, float step, int width, int height,
+                                  float* out, float frequency) const
+    {
+#if PCG_NOISE_SIMD
+        const int* perm = m_Permutation.data();
+        const int* permMod12 = m_PermMod12.data();
+        const float* grad2 = &s_Grad2[0][0];
+        SIMD::SampleGrid(originX, originY, step, width, height, frequency, out,
+            [&](SIMD::VFloat x, SIMD::VFloat y) { return SimplexLanes2D(perm, permMod12, grad2, F2, G2, x, y); },
+            [this](float x, float y) { return SimplexNoise::Sample(x, y); });
+#else
+        INoise::SampleGrid(originX, originY, step, width, height, out, frequency);
+#endif
+    }
+
+    void SimplexNoise::SamplePoints(const float* xs, const float* ys, size_t count, float* out) const
+    {
+#if PCG_NOISE_SIMD
+        const int* perm = m_Permutation.data();
+        const int* permMod12 = m_PermMod12.data();
+        const float* grad2 = &s_Grad2[0][0];
+        SIMD::SamplePoints(xs, ys, count, out,
+            [&](SIMD::VFloat x, SIMD::VFloat y) { return SimplexLanes2D(perm, permMod12, grad2, F2, G2, x, y); },
+            [this](float x, float y) { return SimplexNoise::Sample(x, y); });
+#else
+        INoise::SamplePoints(xs, ys, count, out);
+#endif
+    }
+
     // ============================================================================
     // Worley Noise Implementation
     // ============================================================================
@@ -324,6 +767,7 @@ namespace PCG {
     WorleyNoise::WorleyNoise(uint32_t seed)
         : m_Seed(seed == 0 ? std::random_device{}() : seed)
     {
+        SelectKernels();
     }
 
     void WorleyNoise::SetSeed(uint32_t seed)
@@ -331,6 +775,40 @@ namespace PCG {
         m_Seed = seed == 0 ? std::random_device{}() : seed;
     }
 
+    void WorleyNoise::SelectKernels()
+    {
+        auto selectType = [this]<DistanceFunction Func>() {
+            switch (m_ReturnType) {
+                case ReturnType::F2:
+                    m_Sample2D = &SampleKernel<Func, ReturnType::F2>;
+                    m_Sample3D = &SampleKernel<Func, ReturnType::F2>;
+                    break;
+                case ReturnType::F2MinusF1:
+                    m_Sample2D = &SampleKernel<Func, ReturnType::F2MinusF1>;
+                    m_Sample3D = &SampleKernel<Func, ReturnType::F2MinusF1>;
+                    break;
+                case ReturnType::F1PlusF2:
+                    m_Sample2D = &SampleKernel<Func, ReturnType::F1PlusF2>;
+                    m_Sample3D = &SampleKernel<Func, ReturnType::F1PlusF2>;
+                    break;
+                default:
+                    m_Sample2D = &SampleKernel<Func, ReturnType::F1>;
+                    m_Sample3D = &SampleKernel<Func, ReturnType::F1>;
+            }
+        };
+
+        switch (m_DistanceFunc) {
+            case DistanceFunction::Manhattan:
+                selectType.template operator()<DistanceFunction::Manhattan>();
+                break;
+            case DistanceFunction::Chebyshev:
+                selectType.template operator()<DistanceFunction::Chebyshev>();
+                break;
+            default:
+                selectType.template operator()<DistanceFunction::Euclidean>();
+        }
+    }
+
     uint32_t WorleyNoise::Hash(int32_t x, int32_t y) const
     {
         uint32_t h = m_Seed;
@@ -350,34 +828,6 @@ namespace PCG {
         return h;
     }
 
-    float WorleyNoise::Distance(float dx, float dy) const
-    {
-        switch (m_DistanceFunc) {
-            case DistanceFunction::Euclidean:
-                return std::sqrt(dx * dx + dy * dy);
-            case DistanceFunction::Manhattan:
-                return std::abs(dx) + std::abs(dy);
-            case DistanceFunction::Chebyshev:
-                return std::max(std::abs(dx), std::abs(dy));
-            default:
-                return std::sqrt(dx * dx + dy * dy);
-        }
-    }
-
-    float WorleyNoise::Distance(float dx, float dy, float dz) const
-    {
-        switch (m_DistanceFunc) {
-            case DistanceFunction::Euclidean:
-                return std::sqrt(dx * dx + dy * dy + dz * dz);
-            case DistanceFunction::Manhattan:
-                return std::abs(dx) + std::abs(dy) + std::abs(dz);
-            case DistanceFunction::Chebyshev:
-                return std::max({std::abs(dx), std::abs(dy), std::abs(dz)});
-            default:
-                return std::sqrt(dx * dx + dy * dy + dz * dz);
-        }
-    }
-
     void WorleyNoise::GetCellPoint(int32_t cellX, int32_t cellY, float& px, float& py) const
     {
         uint32_t h = Hash(cellX, cellY);
@@ -394,100 +844,110 @@ namespace PCG {
         pz = static_cast<float>(cellZ) + static_cast<float>((h >> 20) & 0x3FF) / 1023.0f;
     }
 
-    float WorleyNoise::Sample(float x, float y) const
+    template <WorleyNoise::DistanceFunction Func, WorleyNoise::ReturnType Type>
+    float WorleyNoise::SampleKernel(const WorleyNoise& noise, float x, float y)
     {
         int32_t cellX = static_cast<int32_t>(std::floor(x));
         int32_t cellY = static_cast<int32_t>(std::floor(y));
 
+        // Gap from the point to the nearest edge of the -1, 0 and +1 column and row
+        const float gapX[3] = { x - static_cast<float>(cellX), 0.0f, static_cast<float>(cellX + 1) - x };
+        const float gapY[3] = { y - static_cast<float>(cellY), 0.0f, static_cast<float>(cellY + 1) - y };
+
         float minDist1 = 99999.0f;
         float minDist2 = 99999.0f;
 
-        // Check 3x3 neighborhood
-        for (int32_t dy = -1; dy <= 1; ++dy) {
-            for (int32_t dx = -1; dx <= 1; ++dx) {
-                float px, py;
-                GetCellPoint(cellX + dx, cellY + dy, px, py);
+        for (const WorleyCellOffset& offset : WORLEY_SEARCH_ORDER_2D) {
+            if (ShouldPruneCell<Type>(offset) &&
+                WorleyDistance<Func>(gapX[offset.X + 1], gapY[offset.Y + 1]) >= minDist1) {
+                continue;
+            }
 
-                float dist = Distance(x - px, y - py);
+            float px, py;
+            noise.GetCellPoint(cellX + offset.X, cellY + offset.Y, px, py);
 
-                if (dist < minDist1) {
-                    minDist2 = minDist1;
-                    minDist1 = dist;
-                } else if (dist < minDist2) {
-                    minDist2 = dist;
-                }
-            }
-        }
+            float dist = WorleyDistance<Func>(x - px, y - py);
 
-        float result;
-        switch (m_ReturnType) {
-            case ReturnType::F1:
-                result = minDist1;
-                break;
-            case ReturnType::F2:
-                result = minDist2;
-                break;
-            case ReturnType::F2MinusF1:
-                result = minDist2 - minDist1;
-                break;
-            case ReturnType::F1PlusF2:
-                result = (minDist1 + minDist2) * 0.5f;
-                break;
-            default:
-                result = minDist1;
+            if (dist < minDist1) {
+                minDist2 = minDist1;
+                minDist1 = dist;
+            } else if (dist < minDist2) {
+                minDist2 = dist;
+            }
         }
 
-        // Normalize to [0, 1] approximately
-        return std::min(1.0f, result);
+        return WorleyResult<Type>(minDist1, minDist2);
     }
 
-    float WorleyNoise::Sample(float x, float y, float z) const
+    template <WorleyNoise::DistanceFunction Func, WorleyNoise::ReturnType Type>
+    float WorleyNoise::SampleKernel(const WorleyNoise& noise, float x, float y, float z)
     {
         int32_t cellX = static_cast<int32_t>(std::floor(x));
         int32_t cellY = static_cast<int32_t>(std::floor(y));
         int32_t cellZ = static_cast<int32_t>(std::floor(z));
 
+        const float gapX[3] = { x - static_cast<float>(cellX), 0.0f, static_cast<float>(cellX + 1) - x };
+        const float gapY[3] = { y - static_cast<float>(cellY), 0.0f, static_cast<float>(cellY + 1) - y };
+        const float gapZ[3] = { z - static_cast<float>(cellZ), 0.0f, static_cast<float>(cellZ + 1) - z };
+
         float minDist1 = 99999.0f;
         float minDist2 = 99999.0f;
 
-        // Check 3x3x3 neighborhood
-        for (int32_t dz = -1; dz <= 1; ++dz) {
-            for (int32_t dy = -1; dy <= 1; ++dy) {
-                for (int32_t dx = -1; dx <= 1; ++dx) {
-                    float px, py, pz;
-                    GetCellPoint(cellX + dx, cellY + dy, cellZ + dz, px, py, pz);
+        for (const WorleyCellOffset& offset : WORLEY_SEARCH_ORDER_3D) {
+            if (ShouldPruneCell<Type>(offset) &&
+                WorleyDistance<Func>(gapX[offset.X + 1], gapY[offset.Y + 1], gapZ[offset.Z + 1]) >= minDist1) {
+                continue;
+            }
 
-                    float dist = Distance(x - px, y - py, z - pz);
+            float px, py, pz;
+            noise.GetCellPoint(cellX + offset.X, cellY + offset.Y, cellZ + offset.Z, px, py, pz);
 
-                    if (dist < minDist1) {
-                        minDist2 = minDist1;
-                        minDist1 = dist;
-                    } else if (dist < minDist2) {
-                        minDist2 = dist;
-                    }
-                }
+            float dist = WorleyDistance<Func>(x - px, y - py, z - pz);
+
+            if (dist < minDist1) {
+                minDist2 = minDist1;
+                minDist1 = dist;
+            } else if (dist < minDist2) {
+                minDist2 = dist;
             }
         }
 
-        float result;
-        switch (m_ReturnType) {
-            case ReturnType::F1:
-                result = minDist1;
-                break;
-            case ReturnType::F2:
-                result = minDist2;
-                break;
-            case ReturnType::F2MinusF1:
-                result = minDist2 - minDist1;
-                break;
-            case ReturnType::F1PlusF2:
-                result = (minDist1 + minDist2) * 0.5f;
-                break;
-            default:
-                result = minDist1;
-        }
+        return WorleyResult<Type>(minDist1, minDist2);
+    }
 
-        return std::min(1.0f, result);
+    float WorleyNoise::Sample(float x, float y) const
+    {
+        return m_Sample2D(*this, x, y);
+    }
+
+    float WorleyNoise::Sample(float x, float y, float z) const
+    {
+        return m_Sample3D(*this, x, y, z);
+    }
+
+    void WorleyNoise::SampleGrid(float originX, float originY, float step, int width, int height,
+                                 float* out, float frequency) const
+    {
+#if PCG_NOISE_SIMD
+        WithWorleyLanes(m_Seed, m_DistanceFunc, m_ReturnType, [&](auto lanes) {
+            SIMD::SampleGrid(originX, originY, step, width, height, frequency, out, lanes,
+                [this](float x, float y) { return m_Sample2D(*this, x, y); });
+        });
+#else
+        INoise::SampleGrid(originX, originY, step, width, height, out, frequency);
+#endif
+    }
+
+    void WorleyNoise::SamplePoints(const float* xs, const float* ys, size_t count, float* out) const
+    {
+#if PCG_NOISE_SIMD
+        WithWorleyLanes(m_Seed, m_DistanceFunc, m_ReturnType, [&](auto lanes) {
+            SIMD::SamplePoints(xs, ys, count, out, lanes,
+                [this](float x, float y) { return m_Sample2D(*this, x, y); });
+        });
+#else
+        INoise::SamplePoints(xs, ys, count, out);
+#endif
     }
 
     // ============================================================================
@@ -592,6 +1052,31 @@ namespace PCG {
         return nxy0 + w * (nxy1 - nxy0);
     }
 
+    void ValueNoise::SampleGrid(float originX, float originY, float step, int width, int height,
+                                float* out, float frequency) const
+    {
+#if PCG_NOISE_SIMD
+        const float* randomValues = m_RandomValues.data();
+        SIMD::SampleGrid(originX, originY, step, width, height, frequency, out,
+            [&](SIMD::VFloat x, SIMD::VFloat y) { return ValueLanes2D(randomValues, x, y); },
+            [this](float x, float y) { return ValueNoise::Sample(x, y); });
+#else
+        INoise::SampleGrid(originX, originY, step, width, height, out, frequency);
+#endif
+    }
+
+    void ValueNoise::SamplePoints(const float* xs, const float* ys, size_t count, float* out) const
+    {
+#if PCG_NOISE_SIMD
+        const float* randomValues = m_RandomValues.data();
+        SIMD::SamplePoints(xs, ys, count, out,
+            [&](SIMD::VFloat x, SIMD::VFloat y) { return ValueLanes2D(randomValues, x, y); },
+            [this](float x, float y) { return ValueNoise::Sample(x, y); });
+#else
+        INoise::SamplePoints(xs, ys, count, out);
+#endif
+    }
+
     // ============================================================================
     // Noise Factory
     // ============================================================================
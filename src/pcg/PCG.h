@@ -9,6 +9,7 @@
  * - FBM (Fractal Brownian Motion)
  * - Heightmap generation
  * - Biome classification
+ * - Biome-driven foliage and prop scattering
  */
 
 #include "Noise.h"
@@ -18,6 +19,7 @@
 #include "Chunk.h"
 #include "TerrainLOD.h"
 #include "ChunkManager.h"
+#include "FoliageScatter.h"
 
 /**
  * @namespace PCG
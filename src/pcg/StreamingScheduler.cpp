@@ -0,0 +1,66 @@
+#include "pcg/StreamingScheduler.h"
+
+#include <algorithm>
+
+namespace PCG
+{
+    void StreamingScheduler::Configure(float budgetMs, float targetFrameMs)
+    {
+        m_BudgetMs = std::max(budgetMs, 0.0f);
+        m_TargetFrameMs = std::max(targetFrameMs, 0.0f);
+        m_Stats.BudgetScale = 1.0f;
+        m_Stats.BudgetMs = m_BudgetMs;
+    }
+
+    void StreamingScheduler::BeginFrame(float lastFrameSeconds)
+    {
+        // Back off multiplicatively while frames run long, recover additively
+        if (m_TargetFrameMs > 0.0f && lastFrameSeconds > 0.0f)
+        {
+            const float frameMs = lastFrameSeconds * 1000.0f;
+            m_SmoothedFrameMs = m_SmoothedFrameMs > 0.0f
+                ? m_SmoothedFrameMs + (frameMs - m_SmoothedFrameMs) * FRAME_SMOOTHING
+                : frameMs;
+
+            if (m_SmoothedFrameMs > m_TargetFrameMs)
+            {
+                m_Stats.BudgetScale = std::max(m_Stats.BudgetScale * BACKOFF_FACTOR, MIN_BUDGET_SCALE);
+            }
+            else
+            {
+                m_Stats.BudgetScale = std::min(m_Stats.BudgetScale + RECOVERY_STEP, 1.0f);
+            }
+        }
+
+        m_Stats.BudgetMs = m_BudgetMs * m_Stats.BudgetScale;
+        m_Stats.UsedMs = 0.0f;
+        m_Stats.TasksRun.fill(0);
+        m_TasksThisFrame = 0;
+    }
+
+    bool StreamingScheduler::CanAfford(StreamingTask task) const
+    {
+        if (m_TasksThisFrame == 0)
+        {
+            return true;
+        }
+
+        const float cost = m_Stats.TaskCostMs[static_cast<size_t>(task)];
+        return m_Stats.UsedMs + cost <= m_Stats.BudgetMs;
+    }
+
+    void StreamingScheduler::EndTask(StreamingTask task, Clock::time_point start)
+    {
+        const float elapsedMs = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+        const size_t index = static_cast<size_t>(task);
+
+        float& cost = m_Stats.TaskCostMs[index];
+        cost = m_HasCost[index] ? cost + (elapsedMs - cost) * COST_SMOOTHING : elapsedMs;
+        m_HasCost[index] = true;
+
+        m_Stats.UsedMs += elapsedMs;
+        m_Stats.TasksRun[index]++;
+        m_TasksThisFrame++;
+    }
+
+} // namespace PCG
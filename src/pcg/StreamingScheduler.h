@@ -0,0 +1,104 @@
+#pragma once
+
+/**
+ * @file StreamingScheduler.h
+ * @brief Per-frame time budget for main-thread chunk streaming work
+ *
+ * Instead of a fixed number of chunks per frame, streaming work runs until
+ * the frame's time budget would be exceeded. The cost of each kind of work
+ * is learned from high-resolution timings, and the budget shrinks while
+ * frames run over their target time and recovers once they are back under.
+ */
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace PCG
+{
+    /**
+     * @brief Kinds of main-thread streaming work with separately measured costs
+     */
+    enum class StreamingTask : uint32_t
+    {
+        Generate = 0,   ///< Height generation on the main thread (sync mode)
+        CacheLoad,      ///< Height LRU or disk cache lookup
+        MeshBuild,      ///< Vertex generation and GPU upload recording
+        Count
+    };
+
+    /**
+     * @brief Scheduler state for display
+     */
+    struct StreamingSchedulerStats
+    {
+        float BudgetMs = 0.0f;          ///< Budget for the current frame after back-off
+        float UsedMs = 0.0f;            ///< Time spent in the current (or last) frame
+        float BudgetScale = 1.0f;       ///< Back-off factor applied to the configured budget
+        std::array<float, static_cast<size_t>(StreamingTask::Count)> TaskCostMs = {}; ///< Learned cost per task
+        std::array<uint32_t, static_cast<size_t>(StreamingTask::Count)> TasksRun = {}; ///< Tasks run this frame
+    };
+
+    /**
+     * @brief Time-budgeted scheduler for streaming work on the main thread
+     */
+    class StreamingScheduler
+    {
+    public:
+        using Clock = std::chrono::high_resolution_clock;
+
+        /**
+         * @brief Configure the budget
+         * @param budgetMs Streaming time per frame in milliseconds
+         * @param targetFrameMs Frame time above which the budget backs off (0 = never)
+         */
+        void Configure(float budgetMs, float targetFrameMs);
+
+        /**
+         * @brief Start a frame's budget
+         * @param lastFrameSeconds Duration of the previous frame (0 if unknown)
+         */
+        void BeginFrame(float lastFrameSeconds);
+
+        /**
+         * @brief Check if a task is expected to fit in what is left of the budget
+         *
+         * The first task of every frame is always allowed so streaming
+         * never stalls completely; after that the learned cost must fit.
+         */
+        bool CanAfford(StreamingTask task) const;
+
+        /**
+         * @brief Start timing a task
+         */
+        Clock::time_point BeginTask() const { return Clock::now(); }
+
+        /**
+         * @brief Finish timing a task and fold its duration into the learned cost
+         * @param task Kind of work
+         * @param start Value returned by BeginTask
+         */
+        void EndTask(StreamingTask task, Clock::time_point start);
+
+        /**
+         * @brief Get scheduler state
+         */
+        const StreamingSchedulerStats& GetStats() const { return m_Stats; }
+
+    private:
+        static constexpr float COST_SMOOTHING = 0.1f;   ///< EMA weight of a new sample
+        static constexpr float FRAME_SMOOTHING = 0.2f;  ///< EMA weight of a new frame time
+        static constexpr float MIN_BUDGET_SCALE = 0.1f;
+        static constexpr float BACKOFF_FACTOR = 0.8f;   ///< Multiplicative decrease per frame over target
+        static constexpr float RECOVERY_STEP = 0.05f;   ///< Additive increase per frame under target
+
+    private:
+        float m_BudgetMs = 2.0f;
+        float m_TargetFrameMs = 0.0f;
+        float m_SmoothedFrameMs = 0.0f;
+        uint32_t m_TasksThisFrame = 0;
+        std::array<bool, static_cast<size_t>(StreamingTask::Count)> m_HasCost = {};
+        StreamingSchedulerStats m_Stats;
+    };
+
+} // namespace PCG
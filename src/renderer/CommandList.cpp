@@ -1,5 +1,7 @@
 #include "renderer/CommandList.h"
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <cassert>
 
@@ -123,7 +125,8 @@ namespace SM
     void CommandList::TransitionBarrier(
         ID3D12Resource* resource,
         D3D12_RESOURCE_STATES before,
-        D3D12_RESOURCE_STATES after)
+        D3D12_RESOURCE_STATES after,
+        uint32_t subresource)
     {
         if (before == after)
         {
@@ -141,7 +144,7 @@ namespace SM
         barrier.Transition.pResource = resource;
         barrier.Transition.StateBefore = before;
         barrier.Transition.StateAfter = after;
-        barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+        barrier.Transition.Subresource = subresource;
     }
 
     void CommandList::UAVBarrier(ID3D12Resource* resource)
@@ -276,6 +279,26 @@ namespace SM
         m_CommandList->SetGraphicsRootDescriptorTable(rootIndex, baseDescriptor);
     }
 
+    void CommandList::SetComputeRoot32BitConstants(uint32_t rootIndex, uint32_t num32BitValues, const void* data, uint32_t destOffset)
+    {
+        m_CommandList->SetComputeRoot32BitConstants(rootIndex, num32BitValues, data, destOffset);
+    }
+
+    void CommandList::SetComputeRootConstantBufferView(uint32_t rootIndex, D3D12_GPU_VIRTUAL_ADDRESS bufferLocation)
+    {
+        m_CommandList->SetComputeRootConstantBufferView(rootIndex, bufferLocation);
+    }
+
+    void CommandList::SetComputeRootShaderResourceView(uint32_t rootIndex, D3D12_GPU_VIRTUAL_ADDRESS bufferLocation)
+    {
+        m_CommandList->SetComputeRootShaderResourceView(rootIndex, bufferLocation);
+    }
+
+    void CommandList::SetComputeRootDescriptorTable(uint32_t rootIndex, D3D12_GPU_DESCRIPTOR_HANDLE baseDescriptor)
+    {
+        m_CommandList->SetComputeRootDescriptorTable(rootIndex, baseDescriptor);
+    }
+
     void CommandList::SetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY topology)
     {
         m_CommandList->IASetPrimitiveTopology(topology);
@@ -312,6 +335,12 @@ namespace SM
         m_CommandList->DrawInstanced(vertexCount, instanceCount, startVertex, startInstance);
     }
 
+    void CommandList::Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
+    {
+        FlushBarriers();
+        m_CommandList->Dispatch(groupCountX, groupCountY, groupCountZ);
+    }
+
     void CommandList::CopyBufferRegion(
         ID3D12Resource* dst,
         uint64_t dstOffset,
@@ -319,6 +348,7 @@ namespace SM
         uint64_t srcOffset,
         uint64_t numBytes)
     {
+        FlushBarriers();
         m_CommandList->CopyBufferRegion(dst, dstOffset, src, srcOffset, numBytes);
     }
 
@@ -330,12 +360,149 @@ namespace SM
         const D3D12_TEXTURE_COPY_LOCATION* src,
         const D3D12_BOX* srcBox)
     {
+        FlushBarriers();
         m_CommandList->CopyTextureRegion(dst, dstX, dstY, dstZ, src, srcBox);
     }
 
     void CommandList::CopyResource(ID3D12Resource* dst, ID3D12Resource* src)
     {
+        FlushBarriers();
         m_CommandList->CopyResource(dst, src);
     }
 
+    // ============================================================================
+    // Profiling
+    // ============================================================================
+
+    uint32_t CommandList::BeginProfileZone(const char* name)
+    {
+        // The query heap's timestamps are on the direct queue's clock
+        if (m_Type != CommandListType::Direct)
+        {
+            return GPUProfiler::INVALID_ZONE;
+        }
+
+        return m_Core->GetGPUProfiler().BeginZone(*this, name);
+    }
+
+    void CommandList::EndProfileZone(uint32_t zone)
+    {
+        if (m_Type != CommandListType::Direct)
+        {
+            return;
+        }
+
+        m_Core->GetGPUProfiler().EndZone(*this, zone);
+    }
+
+    void CommandList::BeginEvent(const char* name)
+    {
+        BeginGPUEvent(m_CommandList.Get(), name);
+    }
+
+    void CommandList::EndEvent()
+    {
+        EndGPUEvent(m_CommandList.Get());
+    }
+
+    // ============================================================================
+    // CommandListPool Implementation
+    // ============================================================================
+
+    bool CommandListPool::Initialize(DX12Core* core, uint32_t listCount)
+    {
+        assert(core != nullptr && "DX12Core cannot be null!");
+        Shutdown();
+
+        listCount = std::min(listCount, MAX_LISTS);
+        ID3D12Device* device = core->GetDevice();
+
+        for (uint32_t i = 0; i < listCount; ++i)
+        {
+            auto list = std::make_unique<CommandList>();
+            if (!list->Initialize(core, CommandListType::Direct))
+            {
+                Shutdown();
+                return false;
+            }
+            m_Lists.push_back(std::move(list));
+        }
+
+        for (auto& frameAllocators : m_Allocators)
+        {
+            frameAllocators.resize(listCount);
+            for (ComPtr<ID3D12CommandAllocator>& allocator : frameAllocators)
+            {
+                HRESULT hr = device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&allocator));
+                if (!CheckHResult(hr, "Failed to create pooled command allocator"))
+                {
+                    Shutdown();
+                    return false;
+                }
+            }
+        }
+
+        m_NextList = 0;
+        return true;
+    }
+
+    void CommandListPool::Shutdown()
+    {
+        m_Lists.clear();
+        for (auto& frameAllocators : m_Allocators)
+        {
+            frameAllocators.clear();
+        }
+        m_NextList = 0;
+    }
+
+    void CommandListPool::BeginFrame(uint32_t frameIndex)
+    {
+        m_FrameIndex = frameIndex % FRAME_BUFFER_COUNT;
+        m_NextList = 0;
+    }
+
+    CommandList* CommandListPool::Acquire()
+    {
+        if (m_NextList >= m_Lists.size())
+        {
+            return nullptr;
+        }
+
+        uint32_t index = m_NextList++;
+        CommandList* list = m_Lists[index].get();
+
+        // Begin resets the allocator; its last use was this frame index's previous, fenced frame
+        if (!list->Begin(m_Allocators[m_FrameIndex][index].Get()))
+        {
+            return nullptr;
+        }
+        return list;
+    }
+
+    // ============================================================================
+    // PIX Events
+    // ============================================================================
+
+    namespace
+    {
+        constexpr UINT PIX_EVENT_ANSI_VERSION = 1;     ///< BeginEvent metadata: null-terminated ANSI string
+    }
+
+    void BeginGPUEvent(ID3D12GraphicsCommandList* commandList, const char* name)
+    {
+        if (commandList && name)
+        {
+            commandList->BeginEvent(PIX_EVENT_ANSI_VERSION, name, static_cast<UINT>(std::strlen(name) + 1));
+        }
+    }
+
+    void EndGPUEvent(ID3D12GraphicsCommandList* commandList)
+    {
+        if (commandList)
+        {
+            commandList->EndEvent();
+        }
+    }
+
 } // namespace SM
@@ -8,10 +8,14 @@
  * with Begin/End pattern and common rendering operations.
  */
 
+#include "core/Trace.h"
 #include "renderer/DX12Core.h"
 
 #include <d3d12.h>
 #include <wrl/client.h>
+#include <array>
+#include <memory>
+#include <vector>
 
 namespace SM
 {
@@ -90,11 +94,13 @@ namespace SM
         // Resource Barriers
         /**
          * @brief Transition resource state
+         * @param subresource One subresource (e.g. a mip level), or all of them
          */
         void TransitionBarrier(
             ID3D12Resource* resource,
             D3D12_RESOURCE_STATES before,
-            D3D12_RESOURCE_STATES after
+            D3D12_RESOURCE_STATES after,
+            uint32_t subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES
         );
 
         /**
@@ -201,6 +207,26 @@ namespace SM
          */
         void SetGraphicsRootDescriptorTable(uint32_t rootIndex, D3D12_GPU_DESCRIPTOR_HANDLE baseDescriptor);
 
+        /**
+         * @brief Set compute root 32-bit constants
+         */
+        void SetComputeRoot32BitConstants(uint32_t rootIndex, uint32_t num32BitValues, const void* data, uint32_t destOffset = 0);
+
+        /**
+         * @brief Set compute root constant buffer view
+         */
+        void SetComputeRootConstantBufferView(uint32_t rootIndex, D3D12_GPU_VIRTUAL_ADDRESS bufferLocation);
+
+        /**
+         * @brief Set compute root shader resource view
+         */
+        void SetComputeRootShaderResourceView(uint32_t rootIndex, D3D12_GPU_VIRTUAL_ADDRESS bufferLocation);
+
+        /**
+         * @brief Set compute root descriptor table
+         */
+        void SetComputeRootDescriptorTable(uint32_t rootIndex, D3D12_GPU_DESCRIPTOR_HANDLE baseDescriptor);
+
         // Drawing
         /**
          * @brief Set primitive topology
@@ -238,6 +264,12 @@ namespace SM
             uint32_t startInstance = 0
         );
 
+        // Compute Commands
+        /**
+         * @brief Dispatch compute thread groups
+         */
+        void Dispatch(uint32_t groupCountX, uint32_t groupCountY = 1, uint32_t groupCountZ = 1);
+
         // Copy Operations
         /**
          * @brief Copy buffer region
@@ -267,6 +299,30 @@ namespace SM
          */
         void CopyResource(ID3D12Resource* dst, ID3D12Resource* src);
 
+        // Profiling
+        /**
+         * @brief Write the timestamp opening a GPU profile zone
+         * @param name Zone name shown in the profiler timeline
+         * @return Zone for EndProfileZone, GPUProfiler::INVALID_ZONE on copy lists
+         */
+        uint32_t BeginProfileZone(const char* name);
+
+        /**
+         * @brief Write the timestamp closing a GPU profile zone
+         * @note May be called on a later list of the same frame than BeginProfileZone
+         */
+        void EndProfileZone(uint32_t zone);
+
+        /**
+         * @brief Open a PIX event around the commands that follow (see BeginGPUEvent)
+         */
+        void BeginEvent(const char* name);
+
+        /**
+         * @brief Close the innermost PIX event
+         */
+        void EndEvent();
+
         // Accessors
         /**
          * @brief Get native command list
@@ -297,4 +353,110 @@ namespace SM
         uint32_t m_NumBarriers = 0;
     };
 
+    /**
+     * @brief Direct command lists with one allocator per list per buffered frame
+     *
+     * Lists are handed out in order during a frame, so the order of Acquire
+     * calls is the submission order. Each list records into its own
+     * allocator, which lets different threads record different lists at the
+     * same time. An allocator is only reset when its frame index comes round
+     * again, after DX12Core::BeginFrame has waited on that frame's fence.
+     */
+    class CommandListPool
+    {
+    public:
+        static constexpr uint32_t MAX_LISTS = 16;
+
+        CommandListPool() = default;
+
+        // Prevent copying
+        CommandListPool(const CommandListPool&) = delete;
+        CommandListPool& operator=(const CommandListPool&) = delete;
+
+        /**
+         * @brief Create the lists and their per-frame allocators
+         * @param core DX12 core reference
+         * @param listCount Lists available per frame (at most MAX_LISTS)
+         * @return true if successful
+         */
+        bool Initialize(DX12Core* core, uint32_t listCount);
+
+        /**
+         * @brief Release all lists and allocators
+         */
+        void Shutdown();
+
+        /**
+         * @brief Make every list available again for a frame
+         * @param frameIndex Frame index from DX12Core::BeginFrame
+         */
+        void BeginFrame(uint32_t frameIndex);
+
+        /**
+         * @brief Take the next list, already recording into this frame's allocator
+         * @return The list, or nullptr if all lists are in use this frame
+         *
+         * Call from the thread that owns the frame; the list itself can then
+         * be recorded on any one thread.
+         */
+        CommandList* Acquire();
+
+        /**
+         * @brief Get the number of lists not yet acquired this frame
+         */
+        uint32_t GetAvailableCount() const { return static_cast<uint32_t>(m_Lists.size()) - m_NextList; }
+
+    private:
+        std::vector<std::unique_ptr<CommandList>> m_Lists;
+        std::array<std::vector<ComPtr<ID3D12CommandAllocator>>, FRAME_BUFFER_COUNT> m_Allocators;
+        uint32_t m_FrameIndex = 0;
+        uint32_t m_NextList = 0;
+    };
+
+    // ============================================================================
+    // PIX Events
+    // ============================================================================
+
+    /**
+     * @brief Open a PIX event on a native list
+     *
+     * Encoded as PIX3's ANSI string event, which PIX and the D3D12 debug
+     * layers show as named regions without WinPixEventRuntime. Events nest
+     * and must be closed on the same list.
+     */
+    void BeginGPUEvent(ID3D12GraphicsCommandList* commandList, const char* name);
+
+    /**
+     * @brief Close the innermost PIX event on a native list
+     */
+    void EndGPUEvent(ID3D12GraphicsCommandList* commandList);
+
+    /**
+     * @brief Opens a PIX event for its lifetime
+     */
+    class GPUEventScope
+    {
+    public:
+        GPUEventScope(ID3D12GraphicsCommandList* commandList, const char* name)
+            : m_CommandList(commandList)
+        {
+            BeginGPUEvent(m_CommandList, name);
+        }
+
+        ~GPUEventScope() { EndGPUEvent(m_CommandList); }
+
+        GPUEventScope(const GPUEventScope&) = delete;
+        GPUEventScope& operator=(const GPUEventScope&) = delete;
+
+    private:
+        ID3D12GraphicsCommandList* m_CommandList;
+    };
+
 } // namespace SM
+
+#ifdef SM_ENABLE_TRACING
+    /// Wrap the enclosing scope's commands on a native list in a PIX event
+    #define SM_GPU_EVENT(commandList, name) ::SM::GPUEventScope SM_TRACE_CONCAT(sm_GPUEvent_, __LINE__)(commandList, name)
+#else
+    #define SM_GPU_EVENT(commandList, name) ((void)0)
+#endif
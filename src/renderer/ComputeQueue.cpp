@@ -0,0 +1,237 @@
+#include "renderer/ComputeQueue.h"
+#include "renderer/DX12Core.h"
+#include "renderer/CommandList.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace SM
+{
+    ComputeQueue::~ComputeQueue()
+    {
+        Shutdown();
+    }
+
+    // ============================================================================
+    // Initialization
+    // ============================================================================
+
+    bool ComputeQueue::Initialize(DX12Core* core)
+    {
+        if (IsInitialized())
+        {
+            return true;
+        }
+
+        if (!core || !core->GetComputeQueue())
+        {
+            std::cerr << "[ComputeQueue] Cannot initialize: no compute queue" << std::endl;
+            return false;
+        }
+
+        HRESULT hr = core->GetDevice()->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_Fence));
+        if (!CheckHResult(hr, "Failed to create compute fence"))
+        {
+            return false;
+        }
+
+        m_Core = core;
+        m_LastSubmitted = 0;
+        m_LastSynced = 0;
+
+        std::cout << "[ComputeQueue] Initialized" << std::endl;
+        return true;
+    }
+
+    void ComputeQueue::Shutdown()
+    {
+        if (IsInitialized())
+        {
+            WaitForIdle();
+        }
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Recording.clear();
+        m_InFlight.clear();
+        m_FreeAllocators.clear();
+        m_Fence.Reset();
+        m_Core = nullptr;
+    }
+
+    // ============================================================================
+    // Submission
+    // ============================================================================
+
+    bool ComputeQueue::Begin(CommandList& cmdList)
+    {
+        if (!IsInitialized() || cmdList.GetType() != CommandListType::Compute)
+        {
+            std::cerr << "[ComputeQueue] Begin needs a compute command list" << std::endl;
+            return false;
+        }
+
+        ComPtr<ID3D12CommandAllocator> allocator;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            RetireCompleted();
+
+            if (!m_FreeAllocators.empty())
+            {
+                allocator = m_FreeAllocators.back();
+                m_FreeAllocators.pop_back();
+            }
+        }
+
+        if (!allocator)
+        {
+            HRESULT hr = m_Core->GetDevice()->CreateCommandAllocator(
+                D3D12_COMMAND_LIST_TYPE_COMPUTE, IID_PPV_ARGS(&allocator));
+            if (!CheckHResult(hr, "Failed to create compute command allocator"))
+            {
+                return false;
+            }
+        }
+
+        // Resets the allocator; the GPU is done with it
+        if (!cmdList.Begin(allocator.Get()))
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_FreeAllocators.push_back(allocator);
+            return false;
+        }
+
+        Batch batch;
+        batch.Allocator = allocator;
+        batch.List = &cmdList;
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Recording.push_back(std::move(batch));
+        return true;
+    }
+
+    uint64_t ComputeQueue::Submit(CommandList& cmdList)
+    {
+        if (!IsInitialized())
+        {
+            return 0;
+        }
+
+        const bool closed = cmdList.End();
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        auto it = std::find_if(m_Recording.begin(), m_Recording.end(),
+            [&cmdList](const Batch& batch) { return batch.List == &cmdList; });
+        if (it == m_Recording.end())
+        {
+            std::cerr << "[ComputeQueue] Submit called without Begin" << std::endl;
+            return 0;
+        }
+
+        Batch batch = std::move(*it);
+        m_Recording.erase(it);
+
+        if (!closed)
+        {
+            m_FreeAllocators.push_back(batch.Allocator);
+            return 0;
+        }
+
+        // Execute and signal under the lock so fence values stay in submission order
+        ID3D12CommandList* lists[] = { cmdList.GetNative() };
+        m_Core->GetComputeQueue()->ExecuteCommandLists(1, lists);
+        m_Core->GetComputeQueue()->Signal(m_Fence.Get(), ++m_LastSubmitted);
+
+        batch.List = nullptr;
+        batch.FenceValue = m_LastSubmitted;
+        m_InFlight.push_back(std::move(batch));
+        return m_LastSubmitted;
+    }
+
+    void ComputeQueue::WaitOnQueue(ID3D12CommandQueue* queue, uint64_t fenceValue)
+    {
+        if (!IsInitialized() || !queue || IsComplete(fenceValue))
+        {
+            return;
+        }
+
+        queue->Wait(m_Fence.Get(), fenceValue);
+    }
+
+    void ComputeQueue::SyncQueue(ID3D12CommandQueue* queue)
+    {
+        if (!IsInitialized() || !queue)
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (m_LastSynced >= m_LastSubmitted)
+        {
+            return;
+        }
+
+        // Skip the GPU wait when the work already finished
+        if (m_Fence->GetCompletedValue() < m_LastSubmitted)
+        {
+            queue->Wait(m_Fence.Get(), m_LastSubmitted);
+        }
+
+        m_LastSynced = m_LastSubmitted;
+    }
+
+    bool ComputeQueue::IsComplete(uint64_t fenceValue) const
+    {
+        if (fenceValue == 0)
+        {
+            return true;
+        }
+
+        return m_Fence && m_Fence->GetCompletedValue() >= fenceValue;
+    }
+
+    void ComputeQueue::WaitForFence(uint64_t fenceValue)
+    {
+        if (!IsInitialized() || IsComplete(fenceValue))
+        {
+            return;
+        }
+
+        // A null event blocks inside the call, so concurrent waiters need no shared handle
+        m_Fence->SetEventOnCompletion(fenceValue, nullptr);
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        RetireCompleted();
+    }
+
+    void ComputeQueue::WaitForIdle()
+    {
+        WaitForFence(GetLastSubmitted());
+    }
+
+    uint64_t ComputeQueue::GetLastSubmitted() const
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_LastSubmitted;
+    }
+
+    // ============================================================================
+    // Private Methods
+    // ============================================================================
+
+    void ComputeQueue::RetireCompleted()
+    {
+        if (!m_Fence)
+        {
+            return;
+        }
+
+        uint64_t completed = m_Fence->GetCompletedValue();
+        while (!m_InFlight.empty() && m_InFlight.front().FenceValue <= completed)
+        {
+            m_FreeAllocators.push_back(m_InFlight.front().Allocator);
+            m_InFlight.pop_front();
+        }
+    }
+
+} // namespace SM
@@ -0,0 +1,156 @@
+#pragma once
+
+/**
+ * @file ComputeQueue.h
+ * @brief Asynchronous compute submissions with automatic cross-queue waits
+ *
+ * Standalone compute work (heightmap generation, mip chains) is recorded into
+ * COMPUTE command lists and submitted to DX12Core's compute queue, where it
+ * overlaps the graphics work already queued on the direct queue. Each
+ * submission returns a fence value. DX12Core makes the direct queue wait for
+ * the newest submission before its next command lists run, so results can
+ * be used on the direct queue without explicit synchronization.
+ */
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <Windows.h>
+#include <d3d12.h>
+#include <wrl/client.h>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace SM
+{
+    class DX12Core;
+    class CommandList;
+
+    /**
+     * @brief Compute-queue allocator ring and fence
+     *
+     * Thread-safe: chunk workers and the render thread may submit concurrently,
+     * but each CommandList must be recorded by one thread at a time.
+     */
+    class ComputeQueue
+    {
+    public:
+        ComputeQueue() = default;
+        ~ComputeQueue();
+
+        // Prevent copying
+        ComputeQueue(const ComputeQueue&) = delete;
+        ComputeQueue& operator=(const ComputeQueue&) = delete;
+
+        // ====================================================================
+        // Initialization
+        // ====================================================================
+
+        /**
+         * @brief Create the fence for the compute queue
+         * @param core DX12 core (device and compute queue)
+         * @return true if successful
+         */
+        bool Initialize(DX12Core* core);
+
+        /**
+         * @brief Wait for outstanding work and release all resources
+         */
+        void Shutdown();
+
+        /**
+         * @brief Check if the queue is ready for submissions
+         */
+        bool IsInitialized() const { return m_Fence != nullptr; }
+
+        // ====================================================================
+        // Submission
+        // ====================================================================
+
+        /**
+         * @brief Start recording onto an allocator from the ring
+         * @param cmdList List created with CommandListType::Compute
+         * @return true if the list is recording
+         *
+         * Allocators are reused once the compute fence passes their last submission.
+         */
+        bool Begin(CommandList& cmdList);
+
+        /**
+         * @brief Close a list started with Begin and execute it on the compute queue
+         * @param cmdList Recording list
+         * @return Fence value that completes with the work (0 on failure)
+         */
+        uint64_t Submit(CommandList& cmdList);
+
+        /**
+         * @brief Make another queue wait on the GPU for a fence value
+         * @param queue Queue whose later submissions depend on the work
+         * @param fenceValue Value returned by Submit
+         *
+         * The CPU never blocks.
+         */
+        void WaitOnQueue(ID3D12CommandQueue* queue, uint64_t fenceValue);
+
+        /**
+         * @brief Make a queue wait for every submission it has not waited on yet
+         *
+         * Called by DX12Core before direct-queue submissions and signals; a
+         * no-op when no compute work was submitted since the last call.
+         */
+        void SyncQueue(ID3D12CommandQueue* queue);
+
+        /**
+         * @brief Check if the work for a fence value has finished
+         */
+        bool IsComplete(uint64_t fenceValue) const;
+
+        /**
+         * @brief Block until a fence value completes
+         *
+         * Waits on the compute queue only; several threads may wait at once.
+         */
+        void WaitForFence(uint64_t fenceValue);
+
+        /**
+         * @brief Wait for every submission
+         */
+        void WaitForIdle();
+
+        /**
+         * @brief Get the fence value of the newest submission (0 if none)
+         */
+        uint64_t GetLastSubmitted() const;
+
+    private:
+        /**
+         * @brief An allocator and the submission that last used it
+         */
+        struct Batch
+        {
+            Microsoft::WRL::ComPtr<ID3D12CommandAllocator> Allocator;
+            const CommandList* List = nullptr;  ///< Recording list (Begin to Submit)
+            uint64_t FenceValue = 0;
+        };
+
+        void RetireCompleted();
+
+    private:
+        DX12Core* m_Core = nullptr;
+        mutable std::mutex m_Mutex;
+
+        // Allocator ring
+        std::vector<Batch> m_Recording;     ///< Allocators handed out by Begin, not yet submitted
+        std::deque<Batch> m_InFlight;
+        std::vector<Microsoft::WRL::ComPtr<ID3D12CommandAllocator>> m_FreeAllocators;
+
+        // Synchronization
+        Microsoft::WRL::ComPtr<ID3D12Fence> m_Fence;
+        uint64_t m_LastSubmitted = 0;       ///< Newest signalled value
+        uint64_t m_LastSynced = 0;          ///< Newest value the direct queue waits on
+    };
+
+} // namespace SM
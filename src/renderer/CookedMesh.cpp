@@ -0,0 +1,370 @@
+#include "renderer/CookedMesh.h"
+#include "renderer/MeshOptimizer.h"
+#include "renderer/UploadQueue.h"
+#include "core/FileSystem.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+namespace SM
+{
+    namespace
+    {
+        size_t AlignUp(size_t value)
+        {
+            return (value + COOKED_MESH_ALIGNMENT - 1) & ~static_cast<size_t>(COOKED_MESH_ALIGNMENT - 1);
+        }
+
+        /**
+         * @brief Append a section at the next aligned offset
+         * @return Offset of the section
+         */
+        uint64_t AppendSection(std::vector<uint8_t>& bytes, const void* data, size_t size)
+        {
+            const size_t offset = AlignUp(bytes.size());
+            bytes.resize(offset + size, 0);
+            if (size > 0)
+            {
+                std::memcpy(bytes.data() + offset, data, size);
+            }
+            return offset;
+        }
+
+        bool SectionInBounds(uint64_t offset, uint64_t count, uint64_t elementSize, size_t fileSize)
+        {
+            if (count == 0)
+            {
+                return true;
+            }
+            if (offset % COOKED_MESH_ALIGNMENT != 0 || offset > fileSize)
+            {
+                return false;
+            }
+            return count <= (fileSize - offset) / elementSize;
+        }
+
+        /**
+         * @brief Sphere around a meshlet's vertices, centred on their bounding box
+         */
+        void MeshletBounds(const MeshData& data, const uint32_t* vertices, uint32_t count, CookedMeshlet& meshlet)
+        {
+            DirectX::XMVECTOR minimum = DirectX::XMVectorReplicate(std::numeric_limits<float>::max());
+            DirectX::XMVECTOR maximum = DirectX::XMVectorNegate(minimum);
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                const DirectX::XMVECTOR p = DirectX::XMLoadFloat3(&data.Vertices[vertices[i]].Position);
+                minimum = DirectX::XMVectorMin(minimum, p);
+                maximum = DirectX::XMVectorMax(maximum, p);
+            }
+
+            const DirectX::XMVECTOR center = DirectX::XMVectorScale(DirectX::XMVectorAdd(minimum, maximum), 0.5f);
+            float radiusSq = 0.0f;
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                const DirectX::XMVECTOR p = DirectX::XMLoadFloat3(&data.Vertices[vertices[i]].Position);
+                radiusSq = std::max(radiusSq, DirectX::XMVectorGetX(
+                    DirectX::XMVector3LengthSq(DirectX::XMVectorSubtract(p, center))));
+            }
+
+            DirectX::XMStoreFloat3(&meshlet.Center, center);
+            meshlet.Radius = std::sqrt(radiusSq);
+        }
+    }
+
+    // ============================================================================
+    // Cooking
+    // ============================================================================
+
+    bool CookedMesh::Cook(const MeshData& data, uint32_t lodCount, std::vector<uint8_t>& outBytes)
+    {
+        outBytes.clear();
+        if (data.Indices.size() < 3 || data.Vertices.empty() ||
+            *std::max_element(data.Indices.begin(), data.Indices.end()) >= data.GetVertexCount())
+        {
+            return false;
+        }
+
+        // Level 0 in cache and fetch order, without vertices no triangle uses
+        MeshData mesh = data;
+        mesh.Indices.resize(mesh.Indices.size() - mesh.Indices.size() % 3);
+        MeshOptimizer::OptimizeVertexCache(mesh.Indices, mesh.GetVertexCount());
+        const uint32_t referenced = MeshOptimizer::OptimizeVertexFetch(mesh.Vertices.data(), mesh.GetVertexCount(),
+            sizeof(Vertex), mesh.Indices.data(), mesh.Indices.size());
+        mesh.Vertices.resize(referenced);
+
+        const uint32_t vertexCount = mesh.GetVertexCount();
+        std::vector<std::vector<uint32_t>> coarser;
+        std::vector<float> errors;
+        MeshOptimizer::GenerateLODIndices(mesh.Indices, &mesh.Vertices[0].Position.x, vertexCount, sizeof(Vertex),
+                                          std::clamp(lodCount, 1u, MAX_LODS) - 1, coarser, &errors);
+
+        // Every level's indices and meshlets, level 0 first
+        std::vector<uint32_t> indices = mesh.Indices;
+        std::vector<CookedMeshLOD> lods;
+        std::vector<MeshOptimizer::Meshlet> meshlets;
+        std::vector<uint32_t> meshletVertices;
+        std::vector<uint32_t> meshletTriangles;
+
+        for (size_t level = 0; level <= coarser.size(); ++level)
+        {
+            const std::vector<uint32_t>& levelIndices = (level == 0) ? mesh.Indices : coarser[level - 1];
+
+            CookedMeshLOD& lod = lods.emplace_back();
+            lod.FirstIndex = static_cast<uint32_t>(level == 0 ? 0 : indices.size());
+            lod.IndexCount = static_cast<uint32_t>(levelIndices.size());
+            lod.FirstMeshlet = static_cast<uint32_t>(meshlets.size());
+            lod.MeshletCount = static_cast<uint32_t>(MeshOptimizer::BuildMeshlets(levelIndices.data(), levelIndices.size(),
+                vertexCount, meshlets, meshletVertices, meshletTriangles));
+            lod.Error = (level == 0) ? 0.0f : errors[level - 1];
+
+            if (level > 0)
+            {
+                indices.insert(indices.end(), levelIndices.begin(), levelIndices.end());
+            }
+        }
+
+        std::vector<CookedMeshlet> cookedMeshlets(meshlets.size());
+        for (size_t i = 0; i < meshlets.size(); ++i)
+        {
+            CookedMeshlet& cooked = cookedMeshlets[i];
+            cooked.VertexOffset = meshlets[i].VertexOffset;
+            cooked.TriangleOffset = meshlets[i].TriangleOffset;
+            cooked.VertexCount = meshlets[i].VertexCount;
+            cooked.TriangleCount = meshlets[i].TriangleCount;
+            MeshletBounds(mesh, meshletVertices.data() + cooked.VertexOffset, cooked.VertexCount, cooked);
+        }
+
+        CookedMeshHeader header;
+        header.VertexCount = vertexCount;
+        header.VertexStride = sizeof(Vertex);
+        header.IndexCount = static_cast<uint32_t>(indices.size());
+        header.IndexSize = MeshOptimizer::CanUse16BitIndices(vertexCount) ? sizeof(uint16_t) : sizeof(uint32_t);
+        header.LODCount = static_cast<uint32_t>(lods.size());
+        header.MeshletCount = static_cast<uint32_t>(cookedMeshlets.size());
+        header.MeshletVertexCount = static_cast<uint32_t>(meshletVertices.size());
+        header.MeshletTriangleCount = static_cast<uint32_t>(meshletTriangles.size());
+
+        DirectX::XMVECTOR boundsMin = DirectX::XMVectorReplicate(std::numeric_limits<float>::max());
+        DirectX::XMVECTOR boundsMax = DirectX::XMVectorNegate(boundsMin);
+        for (const Vertex& vertex : mesh.Vertices)
+        {
+            const DirectX::XMVECTOR p = DirectX::XMLoadFloat3(&vertex.Position);
+            boundsMin = DirectX::XMVectorMin(boundsMin, p);
+            boundsMax = DirectX::XMVectorMax(boundsMax, p);
+        }
+        DirectX::XMStoreFloat3(&header.BoundsMin, boundsMin);
+        DirectX::XMStoreFloat3(&header.BoundsMax, boundsMax);
+        DirectX::XMStoreFloat3(&header.BoundsCenter, DirectX::XMVectorScale(DirectX::XMVectorAdd(boundsMin, boundsMax), 0.5f));
+        header.BoundsRadius = 0.5f * DirectX::XMVectorGetX(DirectX::XMVector3Length(DirectX::XMVectorSubtract(boundsMax, boundsMin)));
+
+        // Sections follow the header in file order; the header is patched in last
+        outBytes.resize(sizeof(CookedMeshHeader));
+        header.VertexOffset = AppendSection(outBytes, mesh.Vertices.data(), mesh.Vertices.size() * sizeof(Vertex));
+        if (header.IndexSize == sizeof(uint16_t))
+        {
+            std::vector<uint16_t> narrowIndices;
+            MeshOptimizer::ConvertTo16BitIndices(indices.data(), indices.size(), narrowIndices);
+            header.IndexOffset = AppendSection(outBytes, narrowIndices.data(), narrowIndices.size() * sizeof(uint16_t));
+        }
+        else
+        {
+            header.IndexOffset = AppendSection(outBytes, indices.data(), indices.size() * sizeof(uint32_t));
+        }
+        header.LODOffset = AppendSection(outBytes, lods.data(), lods.size() * sizeof(CookedMeshLOD));
+        header.MeshletOffset = AppendSection(outBytes, cookedMeshlets.data(), cookedMeshlets.size() * sizeof(CookedMeshlet));
+        header.MeshletVertexOffset = AppendSection(outBytes, meshletVertices.data(), meshletVertices.size() * sizeof(uint32_t));
+        header.MeshletTriangleOffset = AppendSection(outBytes, meshletTriangles.data(), meshletTriangles.size() * sizeof(uint32_t));
+
+        std::memcpy(outBytes.data(), &header, sizeof(header));
+        return true;
+    }
+
+    bool CookedMesh::Validate(std::span<const uint8_t> bytes, std::string* outError)
+    {
+        auto fail = [outError](const char* reason) {
+            if (outError)
+            {
+                *outError = reason;
+            }
+            return false;
+        };
+
+        if (bytes.size() < sizeof(CookedMeshHeader))
+        {
+            return fail("File is smaller than the header");
+        }
+
+        CookedMeshHeader header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        if (header.Magic != COOKED_MESH_MAGIC)
+        {
+            return fail("Not a cooked mesh");
+        }
+        if (header.Version != COOKED_MESH_VERSION)
+        {
+            return fail("Unsupported cooked mesh version");
+        }
+        if (header.VertexStride != sizeof(Vertex) || header.VertexCount == 0)
+        {
+            return fail("Unexpected vertex layout");
+        }
+        if ((header.IndexSize != sizeof(uint16_t) && header.IndexSize != sizeof(uint32_t)) || header.LODCount == 0)
+        {
+            return fail("Unexpected index layout");
+        }
+
+        const size_t size = bytes.size();
+        if (!SectionInBounds(header.VertexOffset, header.VertexCount, header.VertexStride, size) ||
+            !SectionInBounds(header.IndexOffset, header.IndexCount, header.IndexSize, size) ||
+            !SectionInBounds(header.LODOffset, header.LODCount, sizeof(CookedMeshLOD), size) ||
+            !SectionInBounds(header.MeshletOffset, header.MeshletCount, sizeof(CookedMeshlet), size) ||
+            !SectionInBounds(header.MeshletVertexOffset, header.MeshletVertexCount, sizeof(uint32_t), size) ||
+            !SectionInBounds(header.MeshletTriangleOffset, header.MeshletTriangleCount, sizeof(uint32_t), size))
+        {
+            return fail("Section out of bounds (truncated file?)");
+        }
+
+        // Level ranges are what draws trust, so check them too
+        const CookedMeshLOD* lods = reinterpret_cast<const CookedMeshLOD*>(bytes.data() + header.LODOffset);
+        for (uint32_t i = 0; i < header.LODCount; ++i)
+        {
+            if (lods[i].FirstIndex > header.IndexCount || lods[i].IndexCount > header.IndexCount - lods[i].FirstIndex ||
+                lods[i].FirstMeshlet > header.MeshletCount || lods[i].MeshletCount > header.MeshletCount - lods[i].FirstMeshlet)
+            {
+                return fail("Level of detail out of range");
+            }
+        }
+
+        return true;
+    }
+
+    // ============================================================================
+    // Loading
+    // ============================================================================
+
+    bool CookedMesh::Load(DX12Core* core, const std::string& path)
+    {
+        MappedFile file = FileSystem::MapFile(path);
+        if (!file.IsOpen())
+        {
+            std::cerr << "[CookedMesh] Failed to map " << path << std::endl;
+            return false;
+        }
+
+        return Load(core, file.GetBytes(), path);
+    }
+
+    bool CookedMesh::Load(DX12Core* core, std::span<const uint8_t> bytes, const std::string& name)
+    {
+        Unload();
+
+        std::string error;
+        if (!core || !Validate(bytes, &error))
+        {
+            std::cerr << "[CookedMesh] " << name << ": " << error << std::endl;
+            return false;
+        }
+
+        CookedMeshHeader header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        const uint8_t* base = bytes.data();
+
+        // Both streams go from the source bytes into staging memory in one copy each
+        const uint8_t* vertices = base + header.VertexOffset;
+        const size_t vertexBytes = static_cast<size_t>(header.VertexCount) * header.VertexStride;
+        const uint8_t* indices = base + header.IndexOffset;
+        const size_t indexBytes = static_cast<size_t>(header.IndexCount) * header.IndexSize;
+
+        if (!m_Mesh.Create(core, header.VertexCount, header.VertexStride,
+                [vertices, vertexBytes](void* destination) { std::memcpy(destination, vertices, vertexBytes); },
+                header.IndexCount, header.IndexSize == sizeof(uint32_t),
+                [indices, indexBytes](void* destination) { std::memcpy(destination, indices, indexBytes); }))
+        {
+            std::cerr << "[CookedMesh] " << name << ": Failed to create geometry buffers" << std::endl;
+            Unload();
+            return false;
+        }
+
+        const CookedMeshLOD* lods = reinterpret_cast<const CookedMeshLOD*>(base + header.LODOffset);
+        m_LODs.assign(lods, lods + header.LODCount);
+        m_BoundsCenter = header.BoundsCenter;
+        m_BoundsRadius = header.BoundsRadius;
+
+        if (header.MeshletCount > 0)
+        {
+            UploadQueue& uploads = core->GetUploadQueue();
+            m_UploadQueue = uploads.IsInitialized() ? &uploads : nullptr;
+
+            bool uploaded =
+                UploadSection(core, m_Meshlets, base + header.MeshletOffset, header.MeshletCount * sizeof(CookedMeshlet)) &&
+                UploadSection(core, m_MeshletVertices, base + header.MeshletVertexOffset,
+                              header.MeshletVertexCount * sizeof(uint32_t)) &&
+                UploadSection(core, m_MeshletTriangles, base + header.MeshletTriangleOffset,
+                              header.MeshletTriangleCount * sizeof(uint32_t));
+
+            if (!uploaded)
+            {
+                std::cerr << "[CookedMesh] " << name << ": Failed to create meshlet buffers" << std::endl;
+                Unload();
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void CookedMesh::Unload()
+    {
+        m_Mesh = Mesh();
+        m_LODs.clear();
+        m_Meshlets = GPUBuffer();
+        m_MeshletVertices = GPUBuffer();
+        m_MeshletTriangles = GPUBuffer();
+        m_BoundsCenter = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
+        m_BoundsRadius = 0.0f;
+        m_UploadQueue = nullptr;
+        m_UploadFence = 0;
+    }
+
+    bool CookedMesh::IsReady() const
+    {
+        return m_Mesh.IsReady() && (!m_UploadQueue || m_UploadQueue->IsComplete(m_UploadFence));
+    }
+
+    // ============================================================================
+    // Private Methods
+    // ============================================================================
+
+    bool CookedMesh::UploadSection(DX12Core* core, GPUBuffer& buffer, const uint8_t* data, size_t size)
+    {
+        if (size == 0)
+        {
+            return true;
+        }
+
+        if (m_UploadQueue)
+        {
+            if (!buffer.Initialize(core, size, GPUBufferUsage::Pooled))
+            {
+                return false;
+            }
+
+            // Fence values only grow, so the last section's covers the others
+            m_UploadFence = m_UploadQueue->UploadBuffer(buffer.GetResource(), buffer.GetOffset(), data, size);
+            if (m_UploadFence == 0)
+            {
+                return false;
+            }
+        }
+        else if (!buffer.Initialize(core, size, GPUBufferUsage::Upload, data))
+        {
+            return false;
+        }
+
+        return buffer.CreateBindlessView();
+    }
+
+} // namespace SM
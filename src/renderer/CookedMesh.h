@@ -0,0 +1,224 @@
+#pragma once
+
+/**
+ * @file CookedMesh.h
+ * @brief Cooked .smmesh meshes: GPU-ready streams loaded without parsing
+ *
+ * The meshcook tool turns source meshes into .smmesh files whose sections
+ * are already in the layout the GPU reads. Layout (sections 16-byte aligned):
+ *
+ *   CookedMeshHeader
+ *   Vertex[VertexCount]                    cache- and fetch-ordered
+ *   uint16_t or uint32_t[IndexCount]       every level, level 0 first
+ *   CookedMeshLOD[LODCount]
+ *   CookedMeshlet[MeshletCount]            every level's meshlets
+ *   uint32_t[MeshletVertexCount]           vertex indices per meshlet
+ *   uint32_t[MeshletTriangleCount]         local indices, a | b << 8 | c << 16
+ *
+ * All levels index the one vertex buffer, so a level is just an index
+ * range. Loading maps the file and stages each section straight from the
+ * mapping into the copy-queue ring, with no MeshData or other CPU copy.
+ */
+
+#include "renderer/GPUBuffer.h"
+#include "renderer/Mesh.h"
+
+#include <DirectXMath.h>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace SM
+{
+    // ============================================================================
+    // On-disk Format
+    // ============================================================================
+
+    constexpr uint32_t COOKED_MESH_MAGIC = 0x534D4D53;     ///< "SMMS"
+    constexpr uint32_t COOKED_MESH_VERSION = 1;
+    constexpr uint32_t COOKED_MESH_ALIGNMENT = 16;
+
+    struct CookedMeshHeader
+    {
+        uint32_t Magic = COOKED_MESH_MAGIC;
+        uint32_t Version = COOKED_MESH_VERSION;
+        uint32_t VertexCount = 0;
+        uint32_t VertexStride = 0;          ///< sizeof(Vertex) in version 1
+        uint32_t IndexCount = 0;            ///< All levels together
+        uint32_t IndexSize = 0;             ///< 2 or 4 bytes
+        uint32_t LODCount = 0;              ///< At least 1
+        uint32_t MeshletCount = 0;
+        uint32_t MeshletVertexCount = 0;
+        uint32_t MeshletTriangleCount = 0;
+        DirectX::XMFLOAT3 BoundsMin;
+        DirectX::XMFLOAT3 BoundsMax;
+        DirectX::XMFLOAT3 BoundsCenter;     ///< Bounding sphere for culling
+        float BoundsRadius = 0.0f;
+        uint64_t VertexOffset = 0;          ///< Byte offsets of the sections
+        uint64_t IndexOffset = 0;
+        uint64_t LODOffset = 0;
+        uint64_t MeshletOffset = 0;
+        uint64_t MeshletVertexOffset = 0;
+        uint64_t MeshletTriangleOffset = 0;
+    };
+
+    static_assert(sizeof(CookedMeshHeader) == 136, "CookedMeshHeader layout is part of the .smmesh format");
+
+    struct CookedMeshLOD
+    {
+        uint32_t FirstIndex = 0;
+        uint32_t IndexCount = 0;
+        uint32_t FirstMeshlet = 0;
+        uint32_t MeshletCount = 0;
+        float Error = 0.0f;                 ///< Simplification error relative to the mesh's extent
+        uint32_t Reserved[3] = {};
+    };
+
+    static_assert(sizeof(CookedMeshLOD) == 32, "CookedMeshLOD layout is part of the .smmesh format");
+
+    /**
+     * @brief Meshlet with its culling sphere, as a mesh shader reads it
+     */
+    struct CookedMeshlet
+    {
+        uint32_t VertexOffset = 0;          ///< Into the meshlet vertex section
+        uint32_t TriangleOffset = 0;        ///< Into the meshlet triangle section
+        uint32_t VertexCount = 0;
+        uint32_t TriangleCount = 0;
+        DirectX::XMFLOAT3 Center;
+        float Radius = 0.0f;
+    };
+
+    static_assert(sizeof(CookedMeshlet) == 32, "CookedMeshlet layout is part of the .smmesh format");
+
+    // ============================================================================
+    // CookedMesh
+    // ============================================================================
+
+    /**
+     * @brief GPU-resident cooked mesh: geometry, level ranges and meshlets
+     *
+     * Like Mesh, the buffers come from the geometry pool through the core's
+     * UploadQueue; draw only once IsReady() reports the copies finished.
+     */
+    class CookedMesh
+    {
+    public:
+        /// Most levels Cook writes, level 0 included
+        static constexpr uint32_t MAX_LODS = 8;
+
+        CookedMesh() = default;
+
+        // Prevent copying
+        CookedMesh(const CookedMesh&) = delete;
+        CookedMesh& operator=(const CookedMesh&) = delete;
+
+        // ====================================================================
+        // Cooking
+        // ====================================================================
+
+        /**
+         * @brief Cook mesh data into .smmesh bytes
+         * @param data Source mesh (optimized here, need not be beforehand)
+         * @param lodCount Levels to aim for, level 0 included (clamped to MAX_LODS)
+         * @param outBytes Receives the file contents
+         * @return false if the mesh has no triangles
+         *
+         * Device-independent; the meshcook tool calls it offline.
+         */
+        static bool Cook(const MeshData& data, uint32_t lodCount, std::vector<uint8_t>& outBytes);
+
+        /**
+         * @brief Check that bytes hold a well-formed .smmesh
+         * @param bytes File contents
+         * @param outError Optional reason for a failure
+         * @return true if the header and every section are in bounds
+         */
+        static bool Validate(std::span<const uint8_t> bytes, std::string* outError = nullptr);
+
+        // ====================================================================
+        // Loading
+        // ====================================================================
+
+        /**
+         * @brief Map a .smmesh file and upload it
+         * @param core DX12 core (device and upload queue)
+         * @param path File path
+         * @return true if the uploads were recorded
+         *
+         * The mapping is released before returning: uploads are staged
+         * immediately and go out with the frame's UploadQueue::SubmitFrame.
+         */
+        bool Load(DX12Core* core, const std::string& path);
+
+        /**
+         * @brief Upload .smmesh bytes already in memory (e.g. a mapped file or archive read)
+         * @param core DX12 core (device and upload queue)
+         * @param bytes File contents; only read during the call
+         * @param name Name for diagnostics
+         * @return true if the uploads were recorded
+         */
+        bool Load(DX12Core* core, std::span<const uint8_t> bytes, const std::string& name);
+
+        /**
+         * @brief Release the GPU buffers
+         */
+        void Unload();
+
+        bool IsValid() const { return m_Mesh.IsValid(); }
+
+        /**
+         * @brief Check if every buffer has finished uploading
+         */
+        bool IsReady() const;
+
+        // ====================================================================
+        // Accessors
+        // ====================================================================
+
+        /**
+         * @brief Get the geometry (index buffer holds every level; see GetLOD)
+         */
+        const Mesh& GetMesh() const { return m_Mesh; }
+
+        uint32_t GetLODCount() const { return static_cast<uint32_t>(m_LODs.size()); }
+
+        /**
+         * @brief Get a level's index and meshlet ranges (clamped to the coarsest level)
+         */
+        const CookedMeshLOD& GetLOD(uint32_t lod) const { return m_LODs[lod < m_LODs.size() ? lod : m_LODs.size() - 1]; }
+
+        const DirectX::XMFLOAT3& GetBoundsCenter() const { return m_BoundsCenter; }
+        float GetBoundsRadius() const { return m_BoundsRadius; }
+
+        /**
+         * @brief Get the bindless raw views of the meshlet sections (INVALID_BINDLESS_INDEX without meshlets)
+         */
+        uint32_t GetMeshletBufferIndex() const { return m_Meshlets.GetBindlessIndex(); }
+        uint32_t GetMeshletVertexBufferIndex() const { return m_MeshletVertices.GetBindlessIndex(); }
+        uint32_t GetMeshletTriangleBufferIndex() const { return m_MeshletTriangles.GetBindlessIndex(); }
+
+    private:
+        /**
+         * @brief Create a pooled buffer for a section and stage it from the source bytes
+         */
+        bool UploadSection(DX12Core* core, GPUBuffer& buffer, const uint8_t* data, size_t size);
+
+    private:
+        Mesh m_Mesh;
+        std::vector<CookedMeshLOD> m_LODs;
+
+        GPUBuffer m_Meshlets;
+        GPUBuffer m_MeshletVertices;
+        GPUBuffer m_MeshletTriangles;
+
+        DirectX::XMFLOAT3 m_BoundsCenter = { 0.0f, 0.0f, 0.0f };
+        float m_BoundsRadius = 0.0f;
+
+        // Meshlet uploads (the mesh tracks its own)
+        UploadQueue* m_UploadQueue = nullptr;
+        uint64_t m_UploadFence = 0;
+    };
+
+} // namespace SM
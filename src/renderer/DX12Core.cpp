@@ -1,5 +1,8 @@
 #include "renderer/DX12Core.h"
+#include "renderer/MipGenerator.h"
+#include "core/FileSystem.h"
 
+#include <algorithm>
 #include <iostream>
 #include <vector>
 #include <cassert>
@@ -39,19 +42,23 @@ namespace SM
     // ============================================================================
 
     bool DescriptorHeap::Initialize(
-        ID3D12Device* device,
+        DX12Core* core,
         D3D12_DESCRIPTOR_HEAP_TYPE type,
         uint32_t numDescriptors,
-        bool shaderVisible)
+        bool shaderVisible,
+        uint32_t stagingPerFrame)
     {
+        ID3D12Device* device = core->GetDevice();
+
+        m_Core = core;
         m_Type = type;
         m_NumDescriptors = numDescriptors;
         m_ShaderVisible = shaderVisible;
-        m_CurrentIndex = 0;
+        m_StagingPerFrame = stagingPerFrame;
 
         D3D12_DESCRIPTOR_HEAP_DESC desc = {};
         desc.Type = type;
-        desc.NumDescriptors = numDescriptors;
+        desc.NumDescriptors = numDescriptors + stagingPerFrame * FRAME_BUFFER_COUNT;
         desc.Flags = shaderVisible ? D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE
                                    : D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
         desc.NodeMask = 0;
@@ -70,49 +77,149 @@ namespace SM
             m_GPUStart = m_Heap->GetGPUDescriptorHandleForHeapStart();
         }
 
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Allocator.Initialize(numDescriptors);
+        m_BlockAtIndex.assign(numDescriptors, TLSFAllocator::INVALID);
+        m_DeferredFrees.clear();
+        m_UsedCount = 0;
+        m_PendingFreeCount = 0;
+        m_AllocationCount = 0;
+        m_StagingFrame = 0;
+        m_StagingCursor = 0;
+        m_StagingPeak = 0;
+
         return true;
     }
 
-    DescriptorHandle DescriptorHeap::Allocate()
+    void DescriptorHeap::Shutdown()
     {
-        assert(m_CurrentIndex < m_NumDescriptors && "Descriptor heap is full!");
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_DeferredFrees.clear();
+        m_BlockAtIndex.clear();
+        m_Heap.Reset();
+        m_Core = nullptr;
+    }
 
-        DescriptorHandle handle;
-        handle.HeapIndex = m_CurrentIndex;
-        handle.CPU.ptr = m_CPUStart.ptr + (m_CurrentIndex * m_DescriptorSize);
+    DescriptorHandle DescriptorHeap::AllocateRange(uint32_t count)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
 
-        if (m_ShaderVisible)
+        uint32_t offset = 0;
+        uint32_t block = m_Heap ? m_Allocator.Allocate(count, offset) : TLSFAllocator::INVALID;
+        if (block == TLSFAllocator::INVALID)
         {
-            handle.GPU.ptr = m_GPUStart.ptr + (m_CurrentIndex * m_DescriptorSize);
+            std::cerr << "[DX12] Descriptor heap full (" << count << " requested, "
+                      << m_UsedCount << "/" << m_NumDescriptors << " used, "
+                      << m_PendingFreeCount << " pending free)" << std::endl;
+            assert(false && "Descriptor heap is full!");
+            return DescriptorHandle();
         }
 
-        m_CurrentIndex++;
-        return handle;
+        m_BlockAtIndex[offset] = block;
+        m_UsedCount += count;
+        m_AllocationCount++;
+
+        return GetHandle(offset);
     }
 
     void DescriptorHeap::Free(const DescriptorHandle& handle)
     {
-        // Simple implementation - doesn't actually reclaim space
-        // For production, implement a free list
-        (void)handle;
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        if (!m_Heap || !handle.IsValid() || handle.HeapIndex >= m_NumDescriptors)
+        {
+            return;
+        }
+
+        uint32_t block = m_BlockAtIndex[handle.HeapIndex];
+        if (block == TLSFAllocator::INVALID)
+        {
+            return;     // Not the start of a live range (double free or GetHandle result)
+        }
+        m_BlockAtIndex[handle.HeapIndex] = TLSFAllocator::INVALID;
+
+        DeferredFree deferred;
+        deferred.Block = block;
+        deferred.Count = m_Allocator.GetBlockSize(block);
+        deferred.FenceValue = m_Core->GetNextFenceValue();
+        m_DeferredFrees.push_back(deferred);
+
+        m_UsedCount -= deferred.Count;
+        m_PendingFreeCount += deferred.Count;
+        m_AllocationCount--;
+    }
+
+    void DescriptorHeap::ProcessDeferredFrees(uint64_t completedFenceValue)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        while (!m_DeferredFrees.empty() && m_DeferredFrees.front().FenceValue <= completedFenceValue)
+        {
+            const DeferredFree& deferred = m_DeferredFrees.front();
+            m_Allocator.Free(deferred.Block);
+            m_PendingFreeCount -= deferred.Count;
+            m_DeferredFrees.pop_front();
+        }
+    }
+
+    void DescriptorHeap::BeginFrame(uint32_t frameIndex)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_StagingFrame = frameIndex % FRAME_BUFFER_COUNT;
+        m_StagingCursor = 0;
+    }
+
+    DescriptorHandle DescriptorHeap::AllocateTransient(uint32_t count)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        if (!m_Heap || count == 0 || m_StagingCursor + count > m_StagingPerFrame)
+        {
+            std::cerr << "[DX12] Descriptor staging region exhausted (" << count << " requested, "
+                      << m_StagingCursor << "/" << m_StagingPerFrame << " used this frame)" << std::endl;
+            return DescriptorHandle();
+        }
+
+        uint32_t index = m_NumDescriptors + m_StagingFrame * m_StagingPerFrame + m_StagingCursor;
+        m_StagingCursor += count;
+        m_StagingPeak = std::max(m_StagingPeak, m_StagingCursor);
+
+        return GetHandle(index);
     }
 
     DescriptorHandle DescriptorHeap::GetHandle(uint32_t index) const
     {
-        assert(index < m_NumDescriptors);
+        assert(index < m_NumDescriptors + m_StagingPerFrame * FRAME_BUFFER_COUNT);
 
         DescriptorHandle handle;
         handle.HeapIndex = index;
-        handle.CPU.ptr = m_CPUStart.ptr + (index * m_DescriptorSize);
+        handle.CPU.ptr = m_CPUStart.ptr + (static_cast<SIZE_T>(index) * m_DescriptorSize);
 
         if (m_ShaderVisible)
         {
-            handle.GPU.ptr = m_GPUStart.ptr + (index * m_DescriptorSize);
+            handle.GPU.ptr = m_GPUStart.ptr + (static_cast<UINT64>(index) * m_DescriptorSize);
         }
 
         return handle;
     }
 
+    DescriptorHeapStats DescriptorHeap::GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        DescriptorHeapStats stats;
+        stats.Capacity = m_NumDescriptors;
+        stats.Used = m_UsedCount;
+        stats.PendingFree = m_PendingFreeCount;
+        stats.AllocationCount = m_AllocationCount;
+        stats.FreeBlockCount = m_Allocator.GetFreeBlockCount();
+        stats.LargestFreeBlock = m_Allocator.GetLargestFreeBlock();
+        stats.StagingCapacity = m_StagingPerFrame;
+        stats.StagingUsed = m_StagingCursor;
+        stats.StagingPeak = m_StagingPeak;
+        return stats;
+    }
+
     // ============================================================================
     // DX12Core Implementation
     // ============================================================================
@@ -122,12 +229,13 @@ namespace SM
         Shutdown();
     }
 
-    bool DX12Core::Initialize(HWND hwnd, uint32_t width, uint32_t height, bool vsync)
+    bool DX12Core::Initialize(HWND hwnd, uint32_t width, uint32_t height, bool vsync, uint32_t framesInFlight)
     {
         m_Hwnd = hwnd;
         m_Width = width;
         m_Height = height;
         m_VSyncEnabled = vsync;
+        m_FramesInFlight = std::clamp(framesInFlight, 2u, FRAME_BUFFER_COUNT);
 
         std::cout << "[DX12] Initializing DirectX 12..." << std::endl;
 
@@ -188,18 +296,84 @@ namespace SM
             return false;
         }
 
+        if (!m_ComputeSubmitter.Initialize(this))
+        {
+            return false;
+        }
+
+        // Create the copy-queue uploader (meshes fall back to upload-heap buffers without it)
+        if (!m_UploadQueue.Initialize(this, 32 * 1024 * 1024))
+        {
+            std::cerr << "[DX12] Failed to create upload queue, using upload-heap geometry" << std::endl;
+        }
+
+        // Pooled geometry falls back to committed buffers without it
+        if (!m_GeometryPool.Initialize(this, 16 * 1024 * 1024))
+        {
+            std::cerr << "[DX12] Failed to create geometry pool, using committed geometry buffers" << std::endl;
+        }
+
+        // Profile zones are skipped without it
+        if (!m_GPUProfiler.Initialize(this))
+        {
+            std::cerr << "[DX12] Failed to create GPU profiler, GPU pass timings disabled" << std::endl;
+        }
+
+        // Both caches are optional; without them every launch compiles and builds from scratch
+        ShaderCache::Get().Initialize(SHADER_CACHE_PATH);
+        m_PipelineLibrary.Initialize(m_Device.Get(), PIPELINE_LIBRARY_PATH);
+
+        // Offline DXIL needs SM 6.0; older devices keep compiling with FXC
+        D3D12_FEATURE_DATA_SHADER_MODEL shaderModel = { D3D_SHADER_MODEL_6_0 };
+        if (SUCCEEDED(m_Device->CheckFeatureSupport(D3D12_FEATURE_SHADER_MODEL, &shaderModel, sizeof(shaderModel))) &&
+            shaderModel.HighestShaderModel >= D3D_SHADER_MODEL_6_0 &&
+            FileSystem::IsDirectory(PRECOMPILED_SHADER_PATH))
+        {
+            ShaderCache::Get().SetPrecompiledDirectory(PRECOMPILED_SHADER_PATH);
+            std::cout << "[DX12] Using precompiled shaders from " << PRECOMPILED_SHADER_PATH << std::endl;
+        }
+
+        D3D12_FEATURE_DATA_D3D12_OPTIONS7 options7 = {};
+        m_MeshShadersSupported =
+            SUCCEEDED(m_Device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS7, &options7, sizeof(options7))) &&
+            options7.MeshShaderTier != D3D12_MESH_SHADER_TIER_NOT_SUPPORTED;
+
+        // Tier 2 adds the screen-space shading rate image; 4x rates are an optional extra
+        D3D12_FEATURE_DATA_D3D12_OPTIONS6 options6 = {};
+        if (SUCCEEDED(m_Device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS6, &options6, sizeof(options6))) &&
+            options6.VariableShadingRateTier >= D3D12_VARIABLE_SHADING_RATE_TIER_2)
+        {
+            m_ShadingRateImageTileSize = options6.ShadingRateImageTileSize;
+            m_AdditionalShadingRatesSupported = options6.AdditionalShadingRatesSupported != FALSE;
+        }
+
         std::cout << "[DX12] DirectX 12 initialized successfully!" << std::endl;
         std::cout << "[DX12] Resolution: " << m_Width << "x" << m_Height << std::endl;
         std::cout << "[DX12] V-Sync: " << (m_VSyncEnabled ? "Enabled" : "Disabled") << std::endl;
+        std::cout << "[DX12] Frames in flight: " << m_FramesInFlight << std::endl;
         std::cout << "[DX12] Tearing Support: " << (m_TearingSupported ? "Yes" : "No") << std::endl;
+        std::cout << "[DX12] Mesh Shaders: " << (m_MeshShadersSupported ? "Yes" : "No") << std::endl;
+        std::cout << "[DX12] Shading Rate Image: " << (IsShadingRateImageSupported() ? "Yes" : "No") << std::endl;
 
         return true;
     }
 
     void DX12Core::Shutdown()
     {
+        if (!m_Device)
+        {
+            return;
+        }
+
         // Wait for GPU to finish all work
         WaitForGPU();
+        m_DeferredReleases.clear();
+        m_MipGenerator.reset();
+        m_GPUProfiler.Shutdown();
+        m_ComputeSubmitter.Shutdown();
+        m_UploadQueue.Shutdown();
+        m_GeometryPool.Shutdown();
+        m_PipelineLibrary.Shutdown();
 
         // Close fence event
         if (m_FenceEvent)
@@ -208,17 +382,35 @@ namespace SM
             m_FenceEvent = nullptr;
         }
 
+        if (m_FrameLatencyWaitable)
+        {
+            CloseHandle(m_FrameLatencyWaitable);
+            m_FrameLatencyWaitable = nullptr;
+        }
+
         // Release resources in reverse order
         m_Fence.Reset();
 
         for (auto& frame : m_FrameContexts)
         {
             frame.CommandAllocator.Reset();
-            frame.BackBuffer.Reset();
+        }
+
+        for (auto& backBuffer : m_BackBuffers)
+        {
+            backBuffer.Reset();
         }
 
         m_DepthBuffer.Reset();
+        m_DSVHandle = DescriptorHandle();
+        m_DepthSRVHandle = DescriptorHandle();
+
+        m_CBVSRVUAVHeap.Shutdown();
+        m_DSVHeap.Shutdown();
+        m_RTVHeap.Shutdown();
+
         m_SwapChain.Reset();
+        m_ComputeQueue.Reset();
         m_CopyQueue.Reset();
         m_DirectQueue.Reset();
         m_Device.Reset();
@@ -244,19 +436,30 @@ namespace SM
             return;
         }
 
-        if (width == m_Width && height == m_Height)
+        m_PendingWidth = width;
+        m_PendingHeight = height;
+        m_ResizePending = (width != m_Width || height != m_Height);
+    }
+
+    void DX12Core::ApplyPendingResize()
+    {
+        if (!m_ResizePending)
         {
             return;
         }
+        m_ResizePending = false;
 
-        // Wait for GPU to finish
-        WaitForGPU();
+        uint32_t width = m_PendingWidth;
+        uint32_t height = m_PendingHeight;
+
+        // ResizeBuffers needs the back buffers idle; the last frame's fence
+        // covers them without signaling again
+        WaitForFence(m_FenceValue);
 
         // Release back buffer references
-        for (auto& frame : m_FrameContexts)
+        for (auto& backBuffer : m_BackBuffers)
         {
-            frame.BackBuffer.Reset();
-            frame.FenceValue = m_FenceValue;
+            backBuffer.Reset();
         }
 
         // Release depth buffer
@@ -281,22 +484,18 @@ namespace SM
 
         m_Width = width;
         m_Height = height;
-        m_CurrentFrameIndex = m_SwapChain->GetCurrentBackBufferIndex();
+        m_BackBufferIndex = m_SwapChain->GetCurrentBackBufferIndex();
 
         // Recreate back buffer views
         for (uint32_t i = 0; i < FRAME_BUFFER_COUNT; ++i)
         {
-            hr = m_SwapChain->GetBuffer(i, IID_PPV_ARGS(&m_FrameContexts[i].BackBuffer));
+            hr = m_SwapChain->GetBuffer(i, IID_PPV_ARGS(&m_BackBuffers[i]));
             if (!CheckHResult(hr, "Failed to get back buffer"))
             {
                 return;
             }
 
-            m_Device->CreateRenderTargetView(
-                m_FrameContexts[i].BackBuffer.Get(),
-                nullptr,
-                m_FrameContexts[i].RTVHandle.CPU
-            );
+            m_Device->CreateRenderTargetView(m_BackBuffers[i].Get(), nullptr, m_BackBufferRTVs[i].CPU);
         }
 
         // Recreate depth buffer
@@ -307,13 +506,35 @@ namespace SM
 
     uint32_t DX12Core::BeginFrame()
     {
+        ApplyPendingResize();
+
+        // Block until the swap chain can queue another frame; this bounds
+        // latency to m_FramesInFlight instead of stalling inside Present
+        if (m_FrameLatencyWaitable)
+        {
+            WaitForSingleObjectEx(m_FrameLatencyWaitable, 1000, TRUE);
+        }
+
         // Wait if this frame's resources are still in use
         auto& frame = m_FrameContexts[m_CurrentFrameIndex];
         WaitForFence(frame.FenceValue);
 
+        // Recycle pooled geometry and deferred objects the GPU has finished with
+        uint64_t completedFenceValue = m_Fence->GetCompletedValue();
+        m_GeometryPool.ProcessDeferredFrees(completedFenceValue);
+        m_RTVHeap.ProcessDeferredFrees(completedFenceValue);
+        m_DSVHeap.ProcessDeferredFrees(completedFenceValue);
+        m_CBVSRVUAVHeap.ProcessDeferredFrees(completedFenceValue);
+        m_CBVSRVUAVHeap.BeginFrame(m_CurrentFrameIndex);
+        ProcessDeferredReleases(completedFenceValue);
+
+        // This frame's previous timestamps have landed in the readback buffer
+        m_GPUProfiler.BeginFrame(m_CurrentFrameIndex);
+
         // Reset command allocator
         frame.CommandAllocator->Reset();
 
+        m_BackBufferIndex = m_SwapChain->GetCurrentBackBufferIndex();
         return m_CurrentFrameIndex;
     }
 
@@ -346,6 +567,45 @@ namespace SM
         WaitForFence(fenceValue);
     }
 
+    bool DX12Core::QueryVideoMemory(DXGI_QUERY_VIDEO_MEMORY_INFO& outInfo) const
+    {
+        return m_Adapter &&
+               SUCCEEDED(m_Adapter->QueryVideoMemoryInfo(0, DXGI_MEMORY_SEGMENT_GROUP_LOCAL, &outInfo));
+    }
+
+    MipGenerator& DX12Core::GetMipGenerator()
+    {
+        if (!m_MipGenerator)
+        {
+            m_MipGenerator = std::make_unique<MipGenerator>();
+        }
+
+        // Retried on later calls if the shader failed to compile
+        m_MipGenerator->Initialize(this);
+        return *m_MipGenerator;
+    }
+
+    void DX12Core::DeferRelease(ComPtr<ID3D12Pageable> object)
+    {
+        if (!object)
+        {
+            return;
+        }
+
+        DeferredRelease deferred;
+        deferred.Object = std::move(object);
+        deferred.FenceValue = GetNextFenceValue();
+        m_DeferredReleases.push_back(std::move(deferred));
+    }
+
+    void DX12Core::ProcessDeferredReleases(uint64_t completedFenceValue)
+    {
+        while (!m_DeferredReleases.empty() && m_DeferredReleases.front().FenceValue <= completedFenceValue)
+        {
+            m_DeferredReleases.pop_front();
+        }
+    }
+
     void DX12Core::WaitForFence(uint64_t fenceValue)
     {
         if (m_Fence->GetCompletedValue() < fenceValue)
@@ -357,11 +617,15 @@ namespace SM
 
     void DX12Core::ExecuteCommandLists(uint32_t numLists, ID3D12CommandList* const* ppCommandLists)
     {
+        // Async compute results submitted so far are visible to these lists
+        m_ComputeSubmitter.SyncQueue(m_DirectQueue.Get());
         m_DirectQueue->ExecuteCommandLists(numLists, ppCommandLists);
     }
 
     uint64_t DX12Core::Signal()
     {
+        // Frame fences (and deferred releases keyed on them) cover compute work too
+        m_ComputeSubmitter.SyncQueue(m_DirectQueue.Get());
         m_FenceValue++;
         m_DirectQueue->Signal(m_Fence.Get(), m_FenceValue);
         return m_FenceValue;
@@ -553,7 +817,15 @@ namespace SM
             return false;
         }
 
-        std::cout << "[DX12] Created command queues (Direct + Copy)" << std::endl;
+        // Compute command queue (async heightmap and mip generation)
+        queueDesc.Type = D3D12_COMMAND_LIST_TYPE_COMPUTE;
+        hr = m_Device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&m_ComputeQueue));
+        if (!CheckHResult(hr, "Failed to create compute command queue"))
+        {
+            return false;
+        }
+
+        std::cout << "[DX12] Created command queues (Direct + Copy + Compute)" << std::endl;
         return true;
     }
 
@@ -571,7 +843,11 @@ namespace SM
         swapChainDesc.Scaling = DXGI_SCALING_STRETCH;
         swapChainDesc.SwapEffect = DXGI_SWAP_EFFECT_FLIP_DISCARD;
         swapChainDesc.AlphaMode = DXGI_ALPHA_MODE_UNSPECIFIED;
-        swapChainDesc.Flags = m_TearingSupported ? DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING : 0;
+        swapChainDesc.Flags = DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT;
+        if (m_TearingSupported)
+        {
+            swapChainDesc.Flags |= DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING;
+        }
 
         ComPtr<IDXGISwapChain1> swapChain1;
         HRESULT hr = m_Factory->CreateSwapChainForHwnd(
@@ -597,7 +873,15 @@ namespace SM
             return false;
         }
 
-        m_CurrentFrameIndex = m_SwapChain->GetCurrentBackBufferIndex();
+        // Frames queued for presentation never exceed the frames in flight
+        hr = m_SwapChain->SetMaximumFrameLatency(m_FramesInFlight);
+        if (CheckHResult(hr, "Failed to set maximum frame latency"))
+        {
+            m_FrameLatencyWaitable = m_SwapChain->GetFrameLatencyWaitableObject();
+        }
+
+        m_BackBufferIndex = m_SwapChain->GetCurrentBackBufferIndex();
+        m_CurrentFrameIndex = 0;
 
         std::cout << "[DX12] Created swap chain (" << FRAME_BUFFER_COUNT << " buffers, "
                   << m_Width << "x" << m_Height << ")" << std::endl;
@@ -608,23 +892,29 @@ namespace SM
     bool DX12Core::CreateDescriptorHeaps()
     {
         // RTV heap for back buffers
-        if (!m_RTVHeap.Initialize(m_Device.Get(), D3D12_DESCRIPTOR_HEAP_TYPE_RTV, FRAME_BUFFER_COUNT + 16, false))
+        if (!m_RTVHeap.Initialize(this, D3D12_DESCRIPTOR_HEAP_TYPE_RTV, FRAME_BUFFER_COUNT + 16, false))
         {
             return false;
         }
 
-        // DSV heap
-        if (!m_DSVHeap.Initialize(m_Device.Get(), D3D12_DESCRIPTOR_HEAP_TYPE_DSV, 4, false))
+        // DSV heap (main depth buffer plus render graph transients)
+        if (!m_DSVHeap.Initialize(this, D3D12_DESCRIPTOR_HEAP_TYPE_DSV, 16, false))
         {
             return false;
         }
 
-        // CBV/SRV/UAV heap (shader visible)
-        if (!m_CBVSRVUAVHeap.Initialize(m_Device.Get(), D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, 4096, true))
+        // CBV/SRV/UAV heap (shader visible), with per-frame staging for transient tables
+        if (!m_CBVSRVUAVHeap.Initialize(this, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, 4096, true,
+                                        STAGING_DESCRIPTORS_PER_FRAME))
         {
             return false;
         }
 
+        // ImGuiManager binds the heap start as its font SRV, so claim slot 0 before anyone else
+        DescriptorHandle imguiFont = m_CBVSRVUAVHeap.Allocate();
+        assert(imguiFont.HeapIndex == 0);
+        (void)imguiFont;
+
         std::cout << "[DX12] Created descriptor heaps (RTV, DSV, CBV/SRV/UAV)" << std::endl;
         return true;
     }
@@ -633,21 +923,24 @@ namespace SM
     {
         for (uint32_t i = 0; i < FRAME_BUFFER_COUNT; ++i)
         {
-            auto& frame = m_FrameContexts[i];
-
             // Get back buffer
-            HRESULT hr = m_SwapChain->GetBuffer(i, IID_PPV_ARGS(&frame.BackBuffer));
+            HRESULT hr = m_SwapChain->GetBuffer(i, IID_PPV_ARGS(&m_BackBuffers[i]));
             if (!CheckHResult(hr, "Failed to get back buffer"))
             {
                 return false;
             }
 
             // Create RTV
-            frame.RTVHandle = m_RTVHeap.Allocate();
-            m_Device->CreateRenderTargetView(frame.BackBuffer.Get(), nullptr, frame.RTVHandle.CPU);
+            m_BackBufferRTVs[i] = m_RTVHeap.Allocate();
+            m_Device->CreateRenderTargetView(m_BackBuffers[i].Get(), nullptr, m_BackBufferRTVs[i].CPU);
+        }
+
+        for (uint32_t i = 0; i < FRAME_BUFFER_COUNT; ++i)
+        {
+            auto& frame = m_FrameContexts[i];
 
             // Create command allocator
-            hr = m_Device->CreateCommandAllocator(
+            HRESULT hr = m_Device->CreateCommandAllocator(
                 D3D12_COMMAND_LIST_TYPE_DIRECT,
                 IID_PPV_ARGS(&frame.CommandAllocator)
             );
@@ -660,7 +953,8 @@ namespace SM
             frame.FenceValue = 0;
         }
 
-        std::cout << "[DX12] Created frame resources (" << FRAME_BUFFER_COUNT << " frames)" << std::endl;
+        std::cout << "[DX12] Created frame resources (" << FRAME_BUFFER_COUNT << " back buffers, "
+                  << m_FramesInFlight << " frames in flight)" << std::endl;
         return true;
     }
 
@@ -673,7 +967,8 @@ namespace SM
         depthDesc.Height = m_Height;
         depthDesc.DepthOrArraySize = 1;
         depthDesc.MipLevels = 1;
-        depthDesc.Format = m_DepthFormat;
+        // Typeless storage lets compute passes (Hi-Z) read depth through an SRV
+        depthDesc.Format = (m_DepthFormat == DXGI_FORMAT_D32_FLOAT) ? DXGI_FORMAT_R32_TYPELESS : m_DepthFormat;
         depthDesc.SampleDesc.Count = 1;
         depthDesc.SampleDesc.Quality = 0;
         depthDesc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
@@ -701,8 +996,11 @@ namespace SM
             return false;
         }
 
-        // Create DSV
-        m_DSVHandle = m_DSVHeap.Allocate();
+        // Create DSV (the slot is reused when the depth buffer is recreated on resize)
+        if (!m_DSVHandle.IsValid())
+        {
+            m_DSVHandle = m_DSVHeap.Allocate();
+        }
 
         D3D12_DEPTH_STENCIL_VIEW_DESC dsvDesc = {};
         dsvDesc.Format = m_DepthFormat;
@@ -712,6 +1010,23 @@ namespace SM
 
         m_Device->CreateDepthStencilView(m_DepthBuffer.Get(), &dsvDesc, m_DSVHandle.CPU);
 
+        // Create SRV for shader reads of depth
+        if (depthDesc.Format == DXGI_FORMAT_R32_TYPELESS)
+        {
+            if (!m_DepthSRVHandle.IsValid())
+            {
+                m_DepthSRVHandle = m_CBVSRVUAVHeap.Allocate();
+            }
+
+            D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+            srvDesc.Format = DXGI_FORMAT_R32_FLOAT;
+            srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+            srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+            srvDesc.Texture2D.MipLevels = 1;
+
+            m_Device->CreateShaderResourceView(m_DepthBuffer.Get(), &srvDesc, m_DepthSRVHandle.CPU);
+        }
+
         std::cout << "[DX12] Created depth buffer (" << m_Width << "x" << m_Height << ")" << std::endl;
         return true;
     }
@@ -739,14 +1054,11 @@ namespace SM
 
     void DX12Core::MoveToNextFrame()
     {
-        // Schedule signal for current frame
-        uint64_t currentFenceValue = m_FenceValue;
-        m_DirectQueue->Signal(m_Fence.Get(), currentFenceValue);
-        m_FrameContexts[m_CurrentFrameIndex].FenceValue = currentFenceValue;
-        m_FenceValue++;
+        // The frame's resources are free again once the GPU passes this value
+        m_FrameContexts[m_CurrentFrameIndex].FenceValue = Signal();
 
-        // Move to next frame
-        m_CurrentFrameIndex = m_SwapChain->GetCurrentBackBufferIndex();
+        // Frame indices cycle independently of the swap chain's buffers
+        m_CurrentFrameIndex = (m_CurrentFrameIndex + 1) % m_FramesInFlight;
     }
 
 } // namespace SM
@@ -18,7 +18,17 @@
 #include <wrl/client.h>
 #include <cstdint>
 #include <array>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
+
+#include "renderer/UploadQueue.h"
+#include "renderer/ComputeQueue.h"
+#include "renderer/GPUProfiler.h"
+#include "renderer/GPUBufferPool.h"
+#include "renderer/PipelineCache.h"
 
 // Link DirectX libraries
 #pragma comment(lib, "d3d12.lib")
@@ -32,12 +42,37 @@ namespace SM
 
     // Forward declarations
     class CommandList;
+    class DX12Core;
+    class MipGenerator;
 
     /**
-     * @brief Number of frames to buffer (triple buffering)
+     * @brief Number of swap chain buffers (triple buffering)
+     *
+     * Also the upper bound on frames in flight: per-frame arrays are sized by
+     * this and indexed by DX12Core::GetCurrentFrameIndex.
      */
     constexpr uint32_t FRAME_BUFFER_COUNT = 3;
 
+    /// Transient CBV/SRV/UAV descriptors each frame can allocate (DescriptorHeap::AllocateTransient)
+    constexpr uint32_t STAGING_DESCRIPTORS_PER_FRAME = 256;
+
+    /**
+     * @brief Bindless index of a resource without a shader-visible view
+     *
+     * Valid bindless indices are slots in the CBV/SRV/UAV heap; shaders see
+     * them through the table added by RootSignature::AddBindlessTable.
+     */
+    constexpr uint32_t INVALID_BINDLESS_INDEX = UINT32_MAX;
+
+    /// Directory of the compiled shader cache (relative to the working directory)
+    constexpr const char* SHADER_CACHE_PATH = "cache/shaders";
+
+    /// File of the persisted pipeline library
+    constexpr const char* PIPELINE_LIBRARY_PATH = "cache/pipelines.bin";
+
+    /// Directory of the SM 6.0 bytecode built by the ShatteredMoonShaders target
+    constexpr const char* PRECOMPILED_SHADER_PATH = "shaders/compiled";
+
     /**
      * @brief Descriptor heap types supported
      */
@@ -61,7 +96,35 @@ namespace SM
     };
 
     /**
-     * @brief Descriptor heap wrapper with allocation tracking
+     * @brief Descriptor heap statistics, in descriptors
+     */
+    struct DescriptorHeapStats
+    {
+        uint32_t Capacity = 0;              ///< Persistent descriptors
+        uint32_t Used = 0;                  ///< In live persistent allocations
+        uint32_t PendingFree = 0;           ///< Freed, waiting on a frame fence
+        uint32_t AllocationCount = 0;
+        uint32_t FreeBlockCount = 0;        ///< Fragmentation indicator
+        uint32_t LargestFreeBlock = 0;      ///< Largest range AllocateRange can return
+        uint32_t StagingCapacity = 0;       ///< Transient descriptors per frame
+        uint32_t StagingUsed = 0;           ///< Transient descriptors used by the current frame
+        uint32_t StagingPeak = 0;           ///< Most transient descriptors any frame has used
+    };
+
+    /**
+     * @brief Descriptor heap with a persistent range allocator and per-frame staging
+     *
+     * The heap is split in two:
+     * - [0, Capacity) holds persistent descriptors. Ranges come from a
+     *   TLSFAllocator and Free is deferred until the direct queue has retired
+     *   every frame recorded so far, so a slot is never rewritten while a
+     *   frame in flight can still read it.
+     * - After that, one linear region per frame index holds transient tables.
+     *   AllocateTransient bumps a cursor that BeginFrame resets once the
+     *   frame's previous use has retired.
+     *
+     * Allocation and free are serialized internally; ProcessDeferredFrees and
+     * BeginFrame are called by DX12Core::BeginFrame.
      */
     class DescriptorHeap
     {
@@ -71,31 +134,67 @@ namespace SM
 
         /**
          * @brief Initialize the descriptor heap
-         * @param device D3D12 device
+         * @param core DX12 core (device and frame fence)
          * @param type Heap type
-         * @param numDescriptors Maximum number of descriptors
+         * @param numDescriptors Number of persistent descriptors
          * @param shaderVisible Whether the heap is shader visible
+         * @param stagingPerFrame Transient descriptors reserved for each frame index
          * @return true if successful
          */
         bool Initialize(
-            ID3D12Device* device,
+            DX12Core* core,
             D3D12_DESCRIPTOR_HEAP_TYPE type,
             uint32_t numDescriptors,
-            bool shaderVisible = false
+            bool shaderVisible = false,
+            uint32_t stagingPerFrame = 0
         );
 
         /**
-         * @brief Allocate a descriptor from the heap
-         * @return Descriptor handle
+         * @brief Release the heap; later frees are ignored (the GPU must be idle)
          */
-        DescriptorHandle Allocate();
+        void Shutdown();
 
         /**
-         * @brief Free a descriptor (simple implementation - marks as available)
-         * @param handle Handle to free
+         * @brief Allocate one persistent descriptor
+         * @return Descriptor handle, invalid if the heap is full
+         */
+        DescriptorHandle Allocate() { return AllocateRange(1); }
+
+        /**
+         * @brief Allocate contiguous persistent descriptors
+         * @param count Number of descriptors
+         * @return Handle of the first descriptor, invalid if no range fits
+         */
+        DescriptorHandle AllocateRange(uint32_t count);
+
+        /**
+         * @brief Free a handle returned by Allocate or AllocateRange
+         *
+         * Releases the whole range. The slots are reused only after the direct
+         * queue passes every frame recorded so far; ProcessDeferredFrees
+         * performs the release. Invalid and transient handles are ignored.
          */
         void Free(const DescriptorHandle& handle);
 
+        /**
+         * @brief Release deferred frees whose fence has completed
+         * @param completedFenceValue Last completed direct-queue fence value
+         */
+        void ProcessDeferredFrees(uint64_t completedFenceValue);
+
+        /**
+         * @brief Start a frame's staging region
+         * @param frameIndex Frame index whose previous work has completed
+         */
+        void BeginFrame(uint32_t frameIndex);
+
+        /**
+         * @brief Allocate contiguous descriptors valid for the current frame only
+         * @param count Number of descriptors
+         * @return Handle of the first descriptor, invalid if the frame's region is exhausted
+         */
+        DescriptorHandle AllocateTransient(uint32_t count);
+
         /**
          * @brief Get the native heap
          */
@@ -111,26 +210,55 @@ namespace SM
          */
         uint32_t GetDescriptorSize() const { return m_DescriptorSize; }
 
+        /**
+         * @brief Get occupancy statistics
+         */
+        DescriptorHeapStats GetStats() const;
+
+    private:
+        struct DeferredFree
+        {
+            uint32_t Block = TLSFAllocator::INVALID;
+            uint32_t Count = 0;
+            uint64_t FenceValue = 0;
+        };
+
     private:
+        DX12Core* m_Core = nullptr;
         ComPtr<ID3D12DescriptorHeap> m_Heap;
         D3D12_DESCRIPTOR_HEAP_TYPE m_Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
         D3D12_CPU_DESCRIPTOR_HANDLE m_CPUStart = {};
         D3D12_GPU_DESCRIPTOR_HANDLE m_GPUStart = {};
         uint32_t m_DescriptorSize = 0;
-        uint32_t m_NumDescriptors = 0;
-        uint32_t m_CurrentIndex = 0;
+        uint32_t m_NumDescriptors = 0;              ///< Persistent capacity
         bool m_ShaderVisible = false;
+
+        // Persistent range allocator
+        mutable std::mutex m_Mutex;
+        TLSFAllocator m_Allocator;
+        std::vector<uint32_t> m_BlockAtIndex;       ///< TLSF block of the range starting at each index
+        std::deque<DeferredFree> m_DeferredFrees;   ///< Ordered by fence value
+        uint32_t m_UsedCount = 0;
+        uint32_t m_PendingFreeCount = 0;
+        uint32_t m_AllocationCount = 0;
+
+        // Per-frame staging regions, after the persistent range
+        uint32_t m_StagingPerFrame = 0;
+        uint32_t m_StagingFrame = 0;
+        uint32_t m_StagingCursor = 0;
+        uint32_t m_StagingPeak = 0;
     };
 
     /**
-     * @brief Frame resources for each buffered frame
+     * @brief Resources for one frame in flight
+     *
+     * Indexed by frame, not by swap chain buffer; the back buffer a frame
+     * draws into is whichever the swap chain hands out.
      */
     struct FrameContext
     {
         ComPtr<ID3D12CommandAllocator> CommandAllocator;
-        ComPtr<ID3D12Resource> BackBuffer;
-        DescriptorHandle RTVHandle;
-        uint64_t FenceValue = 0;
+        uint64_t FenceValue = 0;        ///< Signaled when the GPU finishes this frame's work
     };
 
     /**
@@ -155,9 +283,11 @@ namespace SM
          * @param width Window width
          * @param height Window height
          * @param vsync Enable vertical sync
+         * @param framesInFlight Frames the CPU may run ahead of the GPU (2 to FRAME_BUFFER_COUNT)
          * @return true if successful
          */
-        bool Initialize(HWND hwnd, uint32_t width, uint32_t height, bool vsync = true);
+        bool Initialize(HWND hwnd, uint32_t width, uint32_t height, bool vsync = true,
+                        uint32_t framesInFlight = FRAME_BUFFER_COUNT);
 
         /**
          * @brief Shutdown and release all resources
@@ -165,15 +295,22 @@ namespace SM
         void Shutdown();
 
         /**
-         * @brief Resize the swap chain
+         * @brief Request a swap chain resize
          * @param width New width
          * @param height New height
+         *
+         * Applied at the next BeginFrame, so a burst of resize messages while
+         * the window is dragged costs a single ResizeBuffers.
          */
         void Resize(uint32_t width, uint32_t height);
 
         /**
          * @brief Begin a new frame
          * @return Current frame index
+         *
+         * Waits on the swap chain's frame-latency object, then on the fence of
+         * the frame that last used this frame index, and releases deferred
+         * objects the GPU has finished with.
          */
         uint32_t BeginFrame();
 
@@ -184,9 +321,18 @@ namespace SM
 
         /**
          * @brief Wait for GPU to finish all work
+         *
+         * Only for shutdown and rare reallocations; use DeferRelease to drop
+         * resources still referenced by frames in flight.
          */
         void WaitForGPU();
 
+        /**
+         * @brief Release an object once every frame recorded so far has retired
+         * @param object Resource, heap or other device child to keep alive until then
+         */
+        void DeferRelease(ComPtr<ID3D12Pageable> object);
+
         /**
          * @brief Wait for a specific fence value
          * @param fenceValue Value to wait for
@@ -206,22 +352,92 @@ namespace SM
          */
         uint64_t Signal();
 
+        /**
+         * @brief Get a direct-queue fence value that will be reached only after all work recorded so far
+         *
+         * Conservative: covers both the frame fence signaled by EndFrame and
+         * an intervening Signal() call.
+         */
+        uint64_t GetNextFenceValue() const { return m_FenceValue + 1; }
+
+        /**
+         * @brief Get the direct-queue frame fence and the last value signaled on it
+         *
+         * Work submitted before the last Signal() completes by that value, so
+         * another queue may wait on it without waiting for work still being
+         * recorded.
+         */
+        ID3D12Fence* GetFence() const { return m_Fence.Get(); }
+        uint64_t GetLastSignaledFenceValue() const { return m_FenceValue; }
+
+        /**
+         * @brief Query the video memory budget the OS grants this process
+         * @param outInfo Receives Budget and CurrentUsage of the local (VRAM) segment
+         * @return false if the adapter could not be queried
+         *
+         * The budget changes as other applications come and go.
+         */
+        bool QueryVideoMemory(DXGI_QUERY_VIDEO_MEMORY_INFO& outInfo) const;
+
         // Accessors
         ID3D12Device* GetDevice() const { return m_Device.Get(); }
         ID3D12CommandQueue* GetDirectQueue() const { return m_DirectQueue.Get(); }
         ID3D12CommandQueue* GetCopyQueue() const { return m_CopyQueue.Get(); }
+        ID3D12CommandQueue* GetComputeQueue() const { return m_ComputeQueue.Get(); }
+
+        /**
+         * @brief Get the copy-queue uploader for DEFAULT-heap buffers
+         */
+        UploadQueue& GetUploadQueue() { return m_UploadQueue; }
+
+        /**
+         * @brief Get the async compute submitter
+         *
+         * The direct queue waits for its newest submission before each
+         * ExecuteCommandLists and Signal.
+         */
+        ComputeQueue& GetComputeSubmitter() { return m_ComputeSubmitter; }
+
+        /**
+         * @brief Get the compute mip generator (initialized on first use)
+         */
+        MipGenerator& GetMipGenerator();
+
+        /**
+         * @brief Get the direct queue's pass timer (see CommandList::BeginProfileZone)
+         */
+        GPUProfiler& GetGPUProfiler() { return m_GPUProfiler; }
+
+        /**
+         * @brief Get the sub-allocator for pooled vertex/index buffers
+         */
+        GPUBufferPool& GetGeometryPool() { return m_GeometryPool; }
+        const GPUBufferPool& GetGeometryPool() const { return m_GeometryPool; }
+
+        /**
+         * @brief Get the persisted PSO library (not initialized if unsupported)
+         */
+        PipelineLibrary& GetPipelineLibrary() { return m_PipelineLibrary; }
+        const PipelineLibrary& GetPipelineLibrary() const { return m_PipelineLibrary; }
         IDXGISwapChain4* GetSwapChain() const { return m_SwapChain.Get(); }
 
         uint32_t GetCurrentFrameIndex() const { return m_CurrentFrameIndex; }
+        uint32_t GetFramesInFlight() const { return m_FramesInFlight; }
         FrameContext& GetCurrentFrame() { return m_FrameContexts[m_CurrentFrameIndex]; }
         const FrameContext& GetCurrentFrame() const { return m_FrameContexts[m_CurrentFrameIndex]; }
 
-        ID3D12Resource* GetCurrentBackBuffer() const { return m_FrameContexts[m_CurrentFrameIndex].BackBuffer.Get(); }
-        D3D12_CPU_DESCRIPTOR_HANDLE GetCurrentRTV() const { return m_FrameContexts[m_CurrentFrameIndex].RTVHandle.CPU; }
+        ID3D12Resource* GetCurrentBackBuffer() const { return m_BackBuffers[m_BackBufferIndex].Get(); }
+        D3D12_CPU_DESCRIPTOR_HANDLE GetCurrentRTV() const { return m_BackBufferRTVs[m_BackBufferIndex].CPU; }
 
         ID3D12Resource* GetDepthBuffer() const { return m_DepthBuffer.Get(); }
         D3D12_CPU_DESCRIPTOR_HANDLE GetDSV() const { return m_DSVHandle.CPU; }
 
+        /**
+         * @brief Get the depth buffer SRV (R32_FLOAT), invalid if the format has no readable view
+         * @note The depth buffer must be in a shader-resource state while this is bound
+         */
+        const DescriptorHandle& GetDepthSRV() const { return m_DepthSRVHandle; }
+
         DescriptorHeap& GetRTVHeap() { return m_RTVHeap; }
         DescriptorHeap& GetDSVHeap() { return m_DSVHeap; }
         DescriptorHeap& GetCBVSRVUAVHeap() { return m_CBVSRVUAVHeap; }
@@ -241,6 +457,22 @@ namespace SM
          */
         bool IsTearingSupported() const { return m_TearingSupported; }
 
+        /**
+         * @brief Check if the device supports amplification and mesh shaders
+         */
+        bool AreMeshShadersSupported() const { return m_MeshShadersSupported; }
+
+        /**
+         * @brief Check if the device supports tier 2 variable rate shading (screen-space rate images)
+         */
+        bool IsShadingRateImageSupported() const { return m_ShadingRateImageTileSize != 0; }
+
+        /// Screen pixels per side covered by one shading rate image texel (0 without tier 2)
+        uint32_t GetShadingRateImageTileSize() const { return m_ShadingRateImageTileSize; }
+
+        /// Check if the 2x4, 4x2 and 4x4 shading rates are supported
+        bool AreAdditionalShadingRatesSupported() const { return m_AdditionalShadingRatesSupported; }
+
     private:
         /**
          * @brief Enable debug layer (Debug builds only)
@@ -293,10 +525,20 @@ namespace SM
         bool CreateSyncObjects();
 
         /**
-         * @brief Move to the next frame
+         * @brief Signal the finished frame's fence and move to the next frame index
          */
         void MoveToNextFrame();
 
+        /**
+         * @brief Resize the swap chain if a resize was requested since the last frame
+         */
+        void ApplyPendingResize();
+
+        /**
+         * @brief Drop deferred objects whose frame has retired
+         */
+        void ProcessDeferredReleases(uint64_t completedFenceValue);
+
     private:
         // Window
         HWND m_Hwnd = nullptr;
@@ -313,16 +555,38 @@ namespace SM
         // Command Queues
         ComPtr<ID3D12CommandQueue> m_DirectQueue;
         ComPtr<ID3D12CommandQueue> m_CopyQueue;
+        ComPtr<ID3D12CommandQueue> m_ComputeQueue;
+        UploadQueue m_UploadQueue;
+        ComputeQueue m_ComputeSubmitter;
+        std::unique_ptr<MipGenerator> m_MipGenerator;
+        GPUProfiler m_GPUProfiler;
+        GPUBufferPool m_GeometryPool;
+        PipelineLibrary m_PipelineLibrary;
 
         // Swap Chain
         ComPtr<IDXGISwapChain4> m_SwapChain;
         DXGI_FORMAT m_BackBufferFormat = DXGI_FORMAT_R8G8B8A8_UNORM;
         bool m_VSyncEnabled = true;
         bool m_TearingSupported = false;
+        bool m_MeshShadersSupported = false;
+        uint32_t m_ShadingRateImageTileSize = 0;
+        bool m_AdditionalShadingRatesSupported = false;
+        HANDLE m_FrameLatencyWaitable = nullptr;    // Signaled when the swap chain can queue another frame
+
+        // Back buffers, indexed by the swap chain's current buffer
+        std::array<ComPtr<ID3D12Resource>, FRAME_BUFFER_COUNT> m_BackBuffers;
+        std::array<DescriptorHandle, FRAME_BUFFER_COUNT> m_BackBufferRTVs;
+        uint32_t m_BackBufferIndex = 0;
+
+        // Resize requested by the window, applied at the next BeginFrame
+        bool m_ResizePending = false;
+        uint32_t m_PendingWidth = 0;
+        uint32_t m_PendingHeight = 0;
 
         // Depth Buffer
         ComPtr<ID3D12Resource> m_DepthBuffer;
         DescriptorHandle m_DSVHandle;
+        DescriptorHandle m_DepthSRVHandle;
         DXGI_FORMAT m_DepthFormat = DXGI_FORMAT_D32_FLOAT;
 
         // Descriptor Heaps
@@ -330,15 +594,24 @@ namespace SM
         DescriptorHeap m_DSVHeap;
         DescriptorHeap m_CBVSRVUAVHeap;
 
-        // Frame Resources
+        // Frame Resources (the first m_FramesInFlight are used)
         std::array<FrameContext, FRAME_BUFFER_COUNT> m_FrameContexts;
         uint32_t m_CurrentFrameIndex = 0;
+        uint32_t m_FramesInFlight = FRAME_BUFFER_COUNT;
 
         // Synchronization
         ComPtr<ID3D12Fence> m_Fence;
         uint64_t m_FenceValue = 0;
         HANDLE m_FenceEvent = nullptr;
 
+        /// Objects kept alive until the direct queue passes FenceValue
+        struct DeferredRelease
+        {
+            ComPtr<ID3D12Pageable> Object;
+            uint64_t FenceValue = 0;
+        };
+        std::deque<DeferredRelease> m_DeferredReleases;     // Ordered by fence value
+
         // Debug
         ComPtr<ID3D12Debug1> m_DebugController;
     };
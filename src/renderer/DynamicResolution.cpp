@@ -0,0 +1,339 @@
+#include "renderer/DynamicResolution.h"
+#include "renderer/CommandList.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace SM
+{
+    namespace
+    {
+        // Root parameter slots
+        constexpr uint32_t ROOT_CONSTANTS = 0;
+        constexpr uint32_t ROOT_SCENE = 1;
+
+        /// Scale steps smaller than this are ignored so the viewport does not jitter
+        constexpr float MIN_SCALE_STEP = 0.02f;
+
+        /// Share of the remaining error corrected per sample, over and under budget
+        constexpr float DECREASE_RATE = 0.5f;
+        constexpr float INCREASE_RATE = 0.1f;
+    }
+
+    DynamicResolution::~DynamicResolution()
+    {
+        Shutdown();
+    }
+
+    // ============================================================================
+    // Initialization
+    // ============================================================================
+
+    bool DynamicResolution::Initialize(DX12Core* core)
+    {
+        if (IsInitialized())
+        {
+            return true;
+        }
+
+        if (!core)
+        {
+            std::cerr << "[DynamicResolution] Cannot initialize: DX12Core is null" << std::endl;
+            return false;
+        }
+
+        if (!CompileShaderFromFile(L"shaders/Upscale.hlsl", "FullscreenVS", "vs_5_1", m_VertexShader) ||
+            !CompileShaderFromFile(L"shaders/Upscale.hlsl", "UpscalePS", "ps_5_1", m_PixelShader))
+        {
+            std::cerr << "[DynamicResolution] Failed to compile upscale shaders!" << std::endl;
+            return false;
+        }
+
+        // Root signature:
+        // 0: Constants - UV scale and clamp (b0)
+        // 1: Table - Scene target SRV (t0)
+        // s0: Linear clamp sampler
+        StaticSamplerConfig linearClamp;
+        linearClamp.Filter = D3D12_FILTER_MIN_MAG_MIP_LINEAR;
+        linearClamp.AddressU = D3D12_TEXTURE_ADDRESS_MODE_CLAMP;
+        linearClamp.AddressV = D3D12_TEXTURE_ADDRESS_MODE_CLAMP;
+        linearClamp.AddressW = D3D12_TEXTURE_ADDRESS_MODE_CLAMP;
+        linearClamp.ShaderRegister = 0;
+        linearClamp.Visibility = ShaderVisibility::Pixel;
+
+        bool built = m_RootSignature
+            .Begin(RootSignatureFlags::None)
+            .AddConstants(4, 0, 0, ShaderVisibility::Pixel)
+            .AddSRVTable(1, 0)
+            .AddStaticSampler(linearClamp)
+            .Build(core);
+
+        if (!built)
+        {
+            std::cerr << "[DynamicResolution] Failed to create root signature!" << std::endl;
+            return false;
+        }
+
+        built = m_UpscalePSO
+            .Begin()
+            .SetRootSignature(m_RootSignature)
+            .SetVertexShader(m_VertexShader)
+            .SetPixelShader(m_PixelShader)
+            .SetRasterizer(FillMode::Solid, CullMode::None)
+            .DisableDepth()
+            .SetRenderTargetFormat(core->GetBackBufferFormat())
+            .Build(core);
+
+        if (!built)
+        {
+            std::cerr << "[DynamicResolution] Failed to create upscale pipeline state!" << std::endl;
+            return false;
+        }
+
+        HRESULT hr = core->GetDirectQueue()->GetTimestampFrequency(&m_TimestampFrequency);
+        if (!CheckHResult(hr, "Failed to get timestamp frequency") || m_TimestampFrequency == 0)
+        {
+            return false;
+        }
+
+        const uint32_t queryCount = core->GetFramesInFlight() * 2;
+
+        D3D12_QUERY_HEAP_DESC heapDesc = {};
+        heapDesc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+        heapDesc.Count = queryCount;
+
+        hr = core->GetDevice()->CreateQueryHeap(&heapDesc, IID_PPV_ARGS(&m_QueryHeap));
+        if (!CheckHResult(hr, "Failed to create frame timing query heap"))
+        {
+            return false;
+        }
+
+        D3D12_HEAP_PROPERTIES heapProps = {};
+        heapProps.Type = D3D12_HEAP_TYPE_READBACK;
+
+        D3D12_RESOURCE_DESC desc = {};
+        desc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+        desc.Width = static_cast<uint64_t>(queryCount) * sizeof(uint64_t);
+        desc.Height = 1;
+        desc.DepthOrArraySize = 1;
+        desc.MipLevels = 1;
+        desc.Format = DXGI_FORMAT_UNKNOWN;
+        desc.SampleDesc.Count = 1;
+        desc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+        hr = core->GetDevice()->CreateCommittedResource(
+            &heapProps,
+            D3D12_HEAP_FLAG_NONE,
+            &desc,
+            D3D12_RESOURCE_STATE_COPY_DEST,
+            nullptr,
+            IID_PPV_ARGS(&m_ReadbackBuffer)
+        );
+        if (!CheckHResult(hr, "Failed to create frame timing readback buffer"))
+        {
+            m_QueryHeap.Reset();
+            return false;
+        }
+
+        m_SlotPending.assign(core->GetFramesInFlight(), false);
+        m_Core = core;
+
+        std::cout << "[DynamicResolution] Initialized" << std::endl;
+        return true;
+    }
+
+    void DynamicResolution::Shutdown()
+    {
+        m_SceneTarget = Texture();
+        m_TargetState = D3D12_RESOURCE_STATE_COMMON;
+        m_ReadbackBuffer.Reset();
+        m_QueryHeap.Reset();
+        m_SlotPending.clear();
+        m_Active = false;
+        m_Core = nullptr;
+    }
+
+    void DynamicResolution::SetConfig(const DynamicResolutionConfig& config)
+    {
+        m_Config = config;
+        m_Config.MinScale = std::clamp(m_Config.MinScale, 0.25f, 1.0f);
+        m_Config.MaxScale = std::clamp(m_Config.MaxScale, m_Config.MinScale, 1.0f);
+        m_Config.TargetGPUTimeMs = std::max(m_Config.TargetGPUTimeMs, 1.0f);
+        m_Config.Headroom = std::clamp(m_Config.Headroom, 0.5f, 1.0f);
+
+        // Timings taken at another setting would steer the new one
+        std::fill(m_SlotPending.begin(), m_SlotPending.end(), false);
+        m_Scale = m_Config.Enabled ? std::clamp(m_Scale, m_Config.MinScale, m_Config.MaxScale) : 1.0f;
+    }
+
+    // ============================================================================
+    // Frame
+    // ============================================================================
+
+    bool DynamicResolution::BeginFrame(CommandList& list, uint32_t frameIndex)
+    {
+        m_Active = false;
+        if (!IsInitialized() || !m_Config.Enabled || frameIndex >= m_SlotPending.size())
+        {
+            return false;
+        }
+
+        m_CurrentSlot = frameIndex;
+
+        // The frame fence covers the resolve recorded when this slot was last used
+        if (m_SlotPending[m_CurrentSlot])
+        {
+            const uint32_t first = m_CurrentSlot * 2;
+            D3D12_RANGE readRange = { first * sizeof(uint64_t), (first + 2) * sizeof(uint64_t) };
+            void* mapped = nullptr;
+
+            if (SUCCEEDED(m_ReadbackBuffer->Map(0, &readRange, &mapped)))
+            {
+                const uint64_t* timestamps = static_cast<const uint64_t*>(mapped) + first;
+                const uint64_t ticks = timestamps[1] >= timestamps[0] ? timestamps[1] - timestamps[0] : 0;
+
+                D3D12_RANGE writeRange = { 0, 0 };
+                m_ReadbackBuffer->Unmap(0, &writeRange);
+
+                m_GPUTimeMs = static_cast<float>(static_cast<double>(ticks) * 1000.0 /
+                                                 static_cast<double>(m_TimestampFrequency));
+                UpdateScale(m_GPUTimeMs);
+            }
+
+            m_SlotPending[m_CurrentSlot] = false;
+        }
+
+        const uint32_t outputWidth = m_Core->GetWidth();
+        const uint32_t outputHeight = m_Core->GetHeight();
+        if (!EnsureTarget(outputWidth, outputHeight))
+        {
+            return false;
+        }
+
+        // Even sizes keep the 2x2 Hi-Z footprint aligned with the rendered edge
+        m_RenderWidth = std::clamp(static_cast<uint32_t>(outputWidth * m_Scale) & ~1u, std::min(outputWidth, 8u), outputWidth);
+        m_RenderHeight = std::clamp(static_cast<uint32_t>(outputHeight * m_Scale) & ~1u, std::min(outputHeight, 8u), outputHeight);
+
+        list.GetNative()->EndQuery(m_QueryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, m_CurrentSlot * 2);
+        m_Active = true;
+        return true;
+    }
+
+    void DynamicResolution::EndFrame(CommandList& list)
+    {
+        if (!m_Active)
+        {
+            return;
+        }
+
+        const uint32_t first = m_CurrentSlot * 2;
+        list.GetNative()->EndQuery(m_QueryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, first + 1);
+        list.GetNative()->ResolveQueryData(m_QueryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP,
+            first, 2, m_ReadbackBuffer.Get(), static_cast<uint64_t>(first) * sizeof(uint64_t));
+
+        m_SlotPending[m_CurrentSlot] = true;
+    }
+
+    void DynamicResolution::Upscale(CommandList& list, D3D12_CPU_DESCRIPTOR_HANDLE rtv, uint32_t width, uint32_t height)
+    {
+        if (!m_Active)
+        {
+            return;
+        }
+
+        const float targetWidth = static_cast<float>(m_SceneTarget.GetWidth());
+        const float targetHeight = static_cast<float>(m_SceneTarget.GetHeight());
+
+        // UV scale, then the last texel center inside the rendered region
+        float constants[4] = {
+            static_cast<float>(m_RenderWidth) / targetWidth,
+            static_cast<float>(m_RenderHeight) / targetHeight,
+            (static_cast<float>(m_RenderWidth) - 0.5f) / targetWidth,
+            (static_cast<float>(m_RenderHeight) - 0.5f) / targetHeight
+        };
+
+        list.SetRenderTargets(1, &rtv, nullptr);
+        list.SetViewport(width, height);
+        list.SetScissorRect(width, height);
+
+        ID3D12DescriptorHeap* heaps[] = { m_Core->GetCBVSRVUAVHeap().GetHeap() };
+        list.SetDescriptorHeaps(1, heaps);
+        list.SetPipelineState(m_UpscalePSO.GetNative());
+        list.SetGraphicsRootSignature(m_RootSignature.GetNative());
+        list.SetGraphicsRoot32BitConstants(ROOT_CONSTANTS, 4, constants);
+        list.SetGraphicsRootDescriptorTable(ROOT_SCENE, m_SceneTarget.GetSRV().GPU);
+        list.SetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+        list.Draw(3);
+    }
+
+    RGResourceHandle DynamicResolution::ImportSceneTarget(RenderGraph& graph)
+    {
+        RGResourceHandle handle = graph.ImportTexture(
+            "SceneColor",
+            m_SceneTarget.GetResource(),
+            m_TargetState,
+            D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE,
+            m_SceneTarget.GetRTV().CPU
+        );
+
+        m_TargetState = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+        return handle;
+    }
+
+    // ============================================================================
+    // Private Methods
+    // ============================================================================
+
+    bool DynamicResolution::EnsureTarget(uint32_t width, uint32_t height)
+    {
+        if (m_SceneTarget.IsValid() && m_SceneTarget.GetWidth() >= width && m_SceneTarget.GetHeight() >= height)
+        {
+            return true;
+        }
+
+        // Only when the window outgrows every earlier size; the resize that
+        // caused it has already drained the queue, so the wait is short
+        uint32_t newWidth = width;
+        uint32_t newHeight = height;
+        if (m_SceneTarget.IsValid())
+        {
+            newWidth = std::max(newWidth, m_SceneTarget.GetWidth());
+            newHeight = std::max(newHeight, m_SceneTarget.GetHeight());
+            m_Core->WaitForGPU();
+        }
+
+        m_SceneTarget = Texture();
+        if (!m_SceneTarget.CreateRenderTarget(m_Core, newWidth, newHeight, m_Core->GetBackBufferFormat(),
+                                              "DynamicResolutionTarget"))
+        {
+            std::cerr << "[DynamicResolution] Failed to create scene target!" << std::endl;
+            return false;
+        }
+
+        m_TargetState = D3D12_RESOURCE_STATE_RENDER_TARGET;
+        return true;
+    }
+
+    void DynamicResolution::UpdateScale(float gpuTimeMs)
+    {
+        if (gpuTimeMs <= 0.0f)
+        {
+            return;
+        }
+
+        // GPU time follows the pixel count, which goes with the square of the scale
+        const float budget = m_Config.TargetGPUTimeMs * m_Config.Headroom;
+        const float ideal = m_Scale * std::sqrt(budget / gpuTimeMs);
+
+        // Back off quickly when over budget, recover slowly to avoid oscillating
+        const float rate = (ideal < m_Scale) ? DECREASE_RATE : INCREASE_RATE;
+        const float next = std::clamp(m_Scale + (ideal - m_Scale) * rate, m_Config.MinScale, m_Config.MaxScale);
+
+        if (std::fabs(next - m_Scale) >= MIN_SCALE_STEP || next == m_Config.MinScale || next == m_Config.MaxScale)
+        {
+            m_Scale = next;
+        }
+    }
+
+} // namespace SM
@@ -0,0 +1,172 @@
+#pragma once
+
+/**
+ * @file DynamicResolution.h
+ * @brief GPU-time driven render scale with a bilinear upscale to the back buffer
+ *
+ * Two timestamp queries bracket every frame on the direct queue. Once a
+ * frame slot's fence has been waited on again, its GPU time adjusts the
+ * render scale towards the target. The scene is drawn into the top-left
+ * corner of one offscreen target at the scaled viewport and then stretched
+ * onto the back buffer (shaders/Upscale.hlsl), so UI drawn afterwards stays
+ * at native resolution. The target only grows. Scale changes and window
+ * shrinks just move the viewport, so no memory is reallocated.
+ */
+
+#include "renderer/DX12Core.h"
+#include "renderer/RootSignature.h"
+#include "renderer/PipelineState.h"
+#include "renderer/RenderGraph.h"
+#include "renderer/Texture.h"
+
+#include <vector>
+
+namespace SM
+{
+    class CommandList;
+
+    /**
+     * @brief Dynamic resolution settings
+     */
+    struct DynamicResolutionConfig
+    {
+        bool Enabled = false;
+        float TargetGPUTimeMs = 16.0f;  ///< Frame time on the direct queue to aim for
+        float MinScale = 0.5f;          ///< Lowest per-axis render scale
+        float MaxScale = 1.0f;          ///< Highest per-axis render scale
+        float Headroom = 0.9f;          ///< Share of the target aimed at, leaving room for spikes
+    };
+
+    /**
+     * @brief Render scale controller and the scene target it sizes
+     *
+     * Owned by the Renderer. Not thread-safe; call from the render thread.
+     */
+    class DynamicResolution
+    {
+    public:
+        DynamicResolution() = default;
+        ~DynamicResolution();
+
+        // Prevent copying
+        DynamicResolution(const DynamicResolution&) = delete;
+        DynamicResolution& operator=(const DynamicResolution&) = delete;
+
+        /**
+         * @brief Compile the upscale shaders and create the timestamp queries
+         * @param core DX12 core (direct queue and frames in flight)
+         * @return true if successful
+         */
+        bool Initialize(DX12Core* core);
+
+        /**
+         * @brief Release the target, queries and pipeline
+         */
+        void Shutdown();
+
+        bool IsInitialized() const { return m_Core != nullptr; }
+
+        /**
+         * @brief Replace the settings; disabling returns to full resolution
+         */
+        void SetConfig(const DynamicResolutionConfig& config);
+        const DynamicResolutionConfig& GetConfig() const { return m_Config; }
+
+        /**
+         * @brief Check if the scene renders through the scaled target this frame
+         */
+        bool IsActive() const { return m_Active; }
+
+        // ====================================================================
+        // Frame
+        // ====================================================================
+
+        /**
+         * @brief Read back this slot's last timing, update the scale and start timing
+         * @param list First direct list of the frame
+         * @param frameIndex DX12Core frame index, whose fence has been waited on
+         * @return false if the scaled target is unavailable (render at full size)
+         */
+        bool BeginFrame(CommandList& list, uint32_t frameIndex);
+
+        /**
+         * @brief Write the frame's end timestamp and resolve both queries
+         * @param list Last direct list of the frame
+         */
+        void EndFrame(CommandList& list);
+
+        /**
+         * @brief Stretch the rendered region onto a render target
+         * @param list List with the scene target in PIXEL_SHADER_RESOURCE and the destination in RENDER_TARGET
+         * @param rtv Destination view (the back buffer)
+         * @param width Destination width
+         * @param height Destination height
+         *
+         * Leaves the destination bound with a full-size viewport and scissor.
+         * Changes the pipeline state and graphics root signature.
+         */
+        void Upscale(CommandList& list, D3D12_CPU_DESCRIPTOR_HANDLE rtv, uint32_t width, uint32_t height);
+
+        // ====================================================================
+        // Accessors
+        // ====================================================================
+
+        /**
+         * @brief Import the scene target into a frame's graph
+         *
+         * The graph leaves it in PIXEL_SHADER_RESOURCE at the end of the frame.
+         */
+        RGResourceHandle ImportSceneTarget(RenderGraph& graph);
+
+        /// Scene target (valid while active)
+        Texture& GetSceneTarget() { return m_SceneTarget; }
+
+        /// Viewport the scene is rendered at this frame
+        uint32_t GetRenderWidth() const { return m_RenderWidth; }
+        uint32_t GetRenderHeight() const { return m_RenderHeight; }
+
+        /// Current per-axis render scale
+        float GetScale() const { return m_Scale; }
+
+        /// Most recent measured frame GPU time (0 until the first readback)
+        float GetGPUTimeMs() const { return m_GPUTimeMs; }
+
+    private:
+        /**
+         * @brief Grow the scene target to cover an output size
+         */
+        bool EnsureTarget(uint32_t width, uint32_t height);
+
+        /**
+         * @brief Move the scale towards the target from one GPU time sample
+         */
+        void UpdateScale(float gpuTimeMs);
+
+    private:
+        DX12Core* m_Core = nullptr;
+        DynamicResolutionConfig m_Config;
+        bool m_Active = false;
+
+        // Upscale pipeline
+        ShaderBytecode m_VertexShader;
+        ShaderBytecode m_PixelShader;
+        RootSignature m_RootSignature;
+        GraphicsPipelineState m_UpscalePSO;
+
+        // Scene target; reallocated only when the output outgrows it
+        Texture m_SceneTarget;
+        D3D12_RESOURCE_STATES m_TargetState = D3D12_RESOURCE_STATE_COMMON;
+        uint32_t m_RenderWidth = 0;
+        uint32_t m_RenderHeight = 0;
+        float m_Scale = 1.0f;
+
+        // Frame timing: begin and end timestamp per frame slot
+        ComPtr<ID3D12QueryHeap> m_QueryHeap;
+        ComPtr<ID3D12Resource> m_ReadbackBuffer;
+        std::vector<bool> m_SlotPending;            ///< Slot holds a resolved, unread timing
+        uint32_t m_CurrentSlot = 0;
+        uint64_t m_TimestampFrequency = 0;
+        float m_GPUTimeMs = 0.0f;
+    };
+
+} // namespace SM
@@ -0,0 +1,544 @@
+#include "renderer/FoliageRenderer.h"
+#include "renderer/Renderer.h"
+#include "core/JobSystem.h"
+#include "core/Profiler.h"
+#include "pcg/Chunk.h"
+#include "pcg/ChunkManager.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace PCG
+{
+    namespace
+    {
+        /// Horizontal distance from a point to a chunk's footprint
+        float DistanceToChunk(const ChunkCoord& coord, const DirectX::XMFLOAT3& position)
+        {
+            const float size = Chunk::GetWorldSize();
+            const DirectX::XMFLOAT3 origin = coord.ToWorldPosition(size);
+            const float dx = std::max({ origin.x - position.x, 0.0f, position.x - (origin.x + size) });
+            const float dz = std::max({ origin.z - position.z, 0.0f, position.z - (origin.z + size) });
+            return std::sqrt(dx * dx + dz * dz);
+        }
+    }
+
+    FoliageRenderer::FoliageRenderer() = default;
+
+    FoliageRenderer::~FoliageRenderer()
+    {
+        Shutdown();
+    }
+
+    // ============================================================================
+    // Initialization
+    // ============================================================================
+
+    bool FoliageRenderer::Initialize(SM::Renderer& renderer)
+    {
+        if (m_Initialized)
+        {
+            return true;
+        }
+
+        m_Renderer = &renderer;
+        m_Core = renderer.GetCore();
+        m_Initialized = true;
+
+        std::cout << "[FoliageRenderer] Foliage renderer initialized." << std::endl;
+        return true;
+    }
+
+    void FoliageRenderer::Shutdown()
+    {
+        if (!m_Initialized)
+        {
+            return;
+        }
+
+        Clear();
+
+        m_Initialized = false;
+        m_Renderer = nullptr;
+        m_Core = nullptr;
+
+        std::cout << "[FoliageRenderer] Shutdown complete" << std::endl;
+    }
+
+    // ============================================================================
+    // Configuration
+    // ============================================================================
+
+    void FoliageRenderer::SetLayers(std::vector<ScatterLayer> layers, uint32_t seed)
+    {
+        // Jobs read the layers while they run
+        Clear();
+        m_Scatter.SetLayers(std::move(layers), seed);
+    }
+
+    void FoliageRenderer::SetBiomeDensities(const BiomeMap& biomeMap)
+    {
+        Clear();
+        m_Scatter.SetBiomeDensities(biomeMap);
+    }
+
+    void FoliageRenderer::Clear()
+    {
+        CancelJobs();
+
+        for (auto& [coord, entry] : m_Chunks)
+        {
+            ReleaseBuffer(entry.Buffer);
+            ReleaseBuffer(entry.PendingBuffer);
+        }
+        m_Chunks.clear();
+
+        m_Stats = FoliageStats();
+    }
+
+    void FoliageRenderer::CancelJobs()
+    {
+        SM::JobSystem& jobs = SM::JobSystem::Get();
+        for (const std::unique_ptr<ScatterJob>& job : m_Jobs)
+        {
+            if (!job->Counter->IsDone())
+            {
+                jobs.Wait(*job->Counter);
+            }
+        }
+        m_Jobs.clear();
+    }
+
+    // ============================================================================
+    // Per-Frame
+    // ============================================================================
+
+    void FoliageRenderer::Update(const ChunkManager& chunks, const DirectX::XMFLOAT3& cameraPosition)
+    {
+        if (!m_Initialized || m_Scatter.GetLayerCount() == 0)
+        {
+            return;
+        }
+
+        SM_PROFILE_SCOPE("FoliageRenderer::Update");
+
+        float maxDrawDistance = 0.0f;
+        for (const ScatterLayer& layer : m_Scatter.GetLayers())
+        {
+            maxDrawDistance = std::max(maxDrawDistance, layer.DrawDistance);
+        }
+        maxDrawDistance *= m_Config.DistanceScale;
+
+        // Chunks are scattered within draw distance and kept a little beyond it
+        const float scatterDistance = maxDrawDistance;
+        const float releaseDistance = maxDrawDistance + Chunk::GetWorldSize() * 2.0f;
+
+        // Drop placements of chunks that unloaded, were replaced or fell far behind
+        for (auto it = m_Chunks.begin(); it != m_Chunks.end();)
+        {
+            const Chunk* chunk = chunks.GetChunk(it->first);
+            if (chunk != it->second.Source || !chunk->IsGenerated() ||
+                DistanceToChunk(it->first, cameraPosition) > releaseDistance)
+            {
+                ReleaseBuffer(it->second.Buffer);
+                ReleaseBuffer(it->second.PendingBuffer);
+                it = m_Chunks.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        // Collect finished jobs whose chunk is still the one they were scattered for
+        std::vector<SM::MeshInstanceData> instances;
+        for (auto it = m_Jobs.begin(); it != m_Jobs.end();)
+        {
+            ScatterJob& job = **it;
+            if (!job.Counter->IsDone())
+            {
+                ++it;
+                continue;
+            }
+
+            const ChunkCoord coord = job.Result.Coord;
+            if (chunks.GetChunk(coord) == job.Source)
+            {
+                ChunkEntry& entry = m_Chunks[coord];
+                entry.Source = job.Source;
+                entry.Scatter = std::move(job.Result);
+
+                if (RemoveExtracted(entry.Scatter))
+                {
+                    BuildInstanceData(m_Scatter, entry.Scatter, instances);
+                    UploadInstances(entry, instances);
+                }
+                else
+                {
+                    UploadInstances(entry, job.Instances);
+                }
+            }
+
+            it = m_Jobs.erase(it);
+        }
+
+        PromotePendingBuffers();
+
+        // Scatter the nearest visible chunks that have no placements yet
+        std::vector<std::pair<float, const Chunk*>> candidates;
+        for (const Chunk* chunk : chunks.GetVisibleChunks())
+        {
+            const ChunkCoord coord = chunk->GetCoord();
+            if (!chunk->IsGenerated() || m_Chunks.count(coord) != 0)
+            {
+                continue;
+            }
+
+            const float distance = DistanceToChunk(coord, cameraPosition);
+            if (distance > scatterDistance)
+            {
+                continue;
+            }
+
+            const bool queued = std::any_of(m_Jobs.begin(), m_Jobs.end(), [&](const std::unique_ptr<ScatterJob>& job) {
+                return job->Result.Coord == coord;
+            });
+            if (!queued)
+            {
+                candidates.emplace_back(distance, chunk);
+            }
+        }
+
+        std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        SM::JobSystem& jobs = SM::JobSystem::Get();
+        const bool async = jobs.IsInitialized();
+
+        for (const auto& [distance, chunk] : candidates)
+        {
+            if (m_Jobs.size() >= m_Config.MaxJobsInFlight)
+            {
+                break;
+            }
+
+            auto job = std::make_unique<ScatterJob>();
+            job->Source = chunk;
+            chunk->CopyHeights(job->Heights);
+            job->Biomes = chunk->GetBiomes();
+            job->Result.Coord = chunk->GetCoord();
+            job->Counter = std::make_unique<SM::JobCounter>();
+
+            ScatterJob* work = job.get();
+            auto scatter = [this, work]() {
+                m_Scatter.ScatterChunk(work->Result.Coord, work->Heights, work->Biomes, work->Result);
+                BuildInstanceData(m_Scatter, work->Result, work->Instances);
+            };
+
+            if (async)
+            {
+                jobs.Run(scatter, job->Counter.get());
+            }
+            else
+            {
+                scatter();
+            }
+
+            m_Jobs.push_back(std::move(job));
+        }
+
+        m_Stats.ResidentChunks = static_cast<uint32_t>(m_Chunks.size());
+        m_Stats.PendingChunks = static_cast<uint32_t>(m_Jobs.size());
+        m_Stats.ResidentInstances = 0;
+        m_Stats.GPUBytes = 0;
+        for (const auto& [coord, entry] : m_Chunks)
+        {
+            m_Stats.ResidentInstances += static_cast<uint32_t>(entry.Scatter.Instances.size());
+            m_Stats.GPUBytes += entry.Buffer ? entry.Buffer->GetSize() : 0;
+            m_Stats.GPUBytes += entry.PendingBuffer ? entry.PendingBuffer->GetSize() : 0;
+        }
+    }
+
+    void FoliageRenderer::Render(const ChunkManager& chunks, const DirectX::XMFLOAT3& cameraPosition)
+    {
+        m_Stats.DrawnInstances = 0;
+        m_Stats.DrawCalls = 0;
+
+        if (!m_Initialized || m_Chunks.empty())
+        {
+            return;
+        }
+
+        SM_PROFILE_SCOPE("FoliageRenderer::Render");
+
+        const std::vector<Chunk*>& visible = chunks.GetVisibleChunks();
+
+        // Distance to each visible chunk with uploaded instances, computed once for every layer
+        std::vector<std::pair<const ChunkEntry*, float>> drawable;
+        drawable.reserve(visible.size());
+        for (const Chunk* chunk : visible)
+        {
+            auto it = m_Chunks.find(chunk->GetCoord());
+            if (it != m_Chunks.end() && it->second.Buffer)
+            {
+                drawable.emplace_back(&it->second, DistanceToChunk(it->first, cameraPosition));
+            }
+        }
+
+        std::vector<SM::GPUInstanceRange> ranges;
+        ranges.reserve(drawable.size());
+
+        const std::vector<ScatterLayer>& layers = m_Scatter.GetLayers();
+        for (uint32_t layerIndex = 0; layerIndex < layers.size(); ++layerIndex)
+        {
+            const ScatterLayer& layer = layers[layerIndex];
+            const SM::Mesh* mesh = m_Renderer->GetPrimitiveMesh(layer.MeshId);
+            if (!mesh)
+            {
+                continue;
+            }
+
+            const float fullDistance = layer.FullDensityDistance * m_Config.DistanceScale;
+            const float drawDistance = std::max(layer.DrawDistance * m_Config.DistanceScale, fullDistance + 0.001f);
+
+            ranges.clear();
+            for (const auto& [entry, distance] : drawable)
+            {
+                if (distance >= drawDistance)
+                {
+                    continue;
+                }
+
+                const uint32_t first = entry->BufferOffsets[layerIndex];
+                const uint32_t count = entry->BufferOffsets[layerIndex + 1] - first;
+
+                // Instances are rank-ordered, so a prefix is an even thinning of the chunk
+                float fraction = std::clamp((drawDistance - distance) / (drawDistance - fullDistance), 0.0f, 1.0f);
+                fraction = std::min(fraction * m_Config.DensityScale, 1.0f);
+                const uint32_t drawn = static_cast<uint32_t>(std::ceil(static_cast<float>(count) * fraction));
+                if (drawn == 0)
+                {
+                    continue;
+                }
+
+                SM::GPUInstanceRange& range = ranges.emplace_back();
+                range.InstanceAddress = entry->Buffer->GetGPUAddress() + first * sizeof(SM::MeshInstanceData);
+                range.InstanceCount = drawn;
+                m_Stats.DrawnInstances += drawn;
+            }
+
+            if (ranges.empty())
+            {
+                continue;
+            }
+
+            const SM::MaterialData material = SM::CreateColoredMaterial(
+                layer.Color.x, layer.Color.y, layer.Color.z, layer.Color.w);
+            m_Renderer->DrawMeshInstancesIndirect(*mesh, material, ranges.data(), static_cast<uint32_t>(ranges.size()));
+            m_Stats.DrawCalls++;
+        }
+    }
+
+    // ============================================================================
+    // Interaction
+    // ============================================================================
+
+    bool FoliageRenderer::ExtractInstance(const DirectX::XMFLOAT3& position, float radius, FoliagePick& pick)
+    {
+        ChunkEntry* bestEntry = nullptr;
+        uint32_t bestLayer = 0;
+        uint32_t bestIndex = 0;
+        float bestDistanceSq = radius * radius;
+
+        for (auto& [coord, entry] : m_Chunks)
+        {
+            if (DistanceToChunk(coord, position) > radius)
+            {
+                continue;
+            }
+
+            const ChunkScatter& scatter = entry.Scatter;
+            for (uint32_t layer = 0; layer + 1 < scatter.LayerOffsets.size(); ++layer)
+            {
+                for (uint32_t i = scatter.LayerOffsets[layer]; i < scatter.LayerOffsets[layer + 1]; ++i)
+                {
+                    const DirectX::XMFLOAT3& p = scatter.Instances[i].Position;
+                    const float dx = p.x - position.x;
+                    const float dz = p.z - position.z;
+                    const float distanceSq = dx * dx + dz * dz;
+                    if (distanceSq <= bestDistanceSq)
+                    {
+                        bestDistanceSq = distanceSq;
+                        bestEntry = &entry;
+                        bestLayer = layer;
+                        bestIndex = i;
+                    }
+                }
+            }
+        }
+
+        if (!bestEntry)
+        {
+            return false;
+        }
+
+        ChunkScatter& scatter = bestEntry->Scatter;
+        pick.Chunk = scatter.Coord;
+        pick.Layer = bestLayer;
+        pick.Instance = scatter.Instances[bestIndex];
+
+        m_Extracted.insert(MakeExtractKey(scatter.Coord, bestLayer, pick.Instance.PointIndex));
+        RemoveExtracted(scatter);
+
+        std::vector<SM::MeshInstanceData> instances;
+        BuildInstanceData(m_Scatter, scatter, instances);
+        UploadInstances(*bestEntry, instances);
+
+        return true;
+    }
+
+    void FoliageRenderer::RestoreExtractedInstances()
+    {
+        m_Extracted.clear();
+    }
+
+    // ============================================================================
+    // Instance Buffers
+    // ============================================================================
+
+    void FoliageRenderer::BuildInstanceData(const FoliageScatter& scatter, const ChunkScatter& placements,
+                                            std::vector<SM::MeshInstanceData>& instances)
+    {
+        instances.clear();
+        instances.reserve(placements.Instances.size());
+
+        const std::vector<ScatterLayer>& layers = scatter.GetLayers();
+        for (uint32_t layer = 0; layer + 1 < placements.LayerOffsets.size(); ++layer)
+        {
+            const DirectX::XMFLOAT3& meshScale = layers[layer].MeshScale;
+            for (uint32_t i = placements.LayerOffsets[layer]; i < placements.LayerOffsets[layer + 1]; ++i)
+            {
+                const ScatterInstance& instance = placements.Instances[i];
+                const DirectX::XMMATRIX world =
+                    DirectX::XMMatrixScaling(meshScale.x * instance.Scale, meshScale.y * instance.Scale,
+                                             meshScale.z * instance.Scale) *
+                    DirectX::XMMatrixRotationY(instance.Yaw) *
+                    DirectX::XMMatrixTranslation(instance.Position.x, instance.Position.y, instance.Position.z);
+                instances.push_back(SM::MeshInstanceData::FromMatrix(world));
+            }
+        }
+    }
+
+    bool FoliageRenderer::RemoveExtracted(ChunkScatter& placements) const
+    {
+        if (m_Extracted.empty())
+        {
+            return false;
+        }
+
+        bool removed = false;
+        uint32_t write = 0;
+        uint32_t read = 0;
+        for (uint32_t layer = 0; layer + 1 < placements.LayerOffsets.size(); ++layer)
+        {
+            const uint32_t end = placements.LayerOffsets[layer + 1];
+            placements.LayerOffsets[layer] = write;
+            for (; read < end; ++read)
+            {
+                const ScatterInstance& instance = placements.Instances[read];
+                if (m_Extracted.count(MakeExtractKey(placements.Coord, layer, instance.PointIndex)) != 0)
+                {
+                    removed = true;
+                    continue;
+                }
+                placements.Instances[write++] = instance;
+            }
+        }
+
+        placements.LayerOffsets.back() = write;
+        placements.Instances.resize(write);
+        return removed;
+    }
+
+    void FoliageRenderer::UploadInstances(ChunkEntry& entry, const std::vector<SM::MeshInstanceData>& instances)
+    {
+        // A replacement that is still uploading is superseded
+        ReleaseBuffer(entry.PendingBuffer);
+        entry.PendingFence = 0;
+
+        if (instances.empty())
+        {
+            ReleaseBuffer(entry.Buffer);
+            entry.BufferOffsets = entry.Scatter.LayerOffsets;
+            return;
+        }
+
+        const size_t bytes = instances.size() * sizeof(SM::MeshInstanceData);
+        auto buffer = std::make_unique<SM::GPUBuffer>();
+
+        // Same path as chunk meshes: pooled DEFAULT-heap ranges through the copy queue when available
+        SM::UploadQueue& uploads = m_Core->GetUploadQueue();
+        if (uploads.IsInitialized())
+        {
+            if (!buffer->Initialize(m_Core, bytes, SM::GPUBufferUsage::Pooled))
+            {
+                std::cerr << "[FoliageRenderer] Failed to allocate instance buffer!" << std::endl;
+                return;
+            }
+
+            entry.PendingFence = uploads.UploadBuffer(buffer->GetResource(), buffer->GetOffset(), instances.data(), bytes);
+            if (entry.PendingFence == 0)
+            {
+                std::cerr << "[FoliageRenderer] Failed to upload instance buffer!" << std::endl;
+                return;
+            }
+        }
+        else if (!buffer->Initialize(m_Core, bytes, SM::GPUBufferUsage::Upload, instances.data()))
+        {
+            std::cerr << "[FoliageRenderer] Failed to create instance buffer!" << std::endl;
+            return;
+        }
+
+        entry.PendingBuffer = std::move(buffer);
+    }
+
+    void FoliageRenderer::PromotePendingBuffers()
+    {
+        SM::UploadQueue& uploads = m_Core->GetUploadQueue();
+        for (auto& [coord, entry] : m_Chunks)
+        {
+            if (entry.PendingBuffer && (entry.PendingFence == 0 || uploads.IsComplete(entry.PendingFence)))
+            {
+                ReleaseBuffer(entry.Buffer);
+                entry.Buffer = std::move(entry.PendingBuffer);
+                entry.BufferOffsets = entry.Scatter.LayerOffsets;
+                entry.PendingFence = 0;
+            }
+        }
+    }
+
+    void FoliageRenderer::ReleaseBuffer(std::unique_ptr<SM::GPUBuffer>& buffer)
+    {
+        if (!buffer)
+        {
+            return;
+        }
+
+        // Pooled ranges are freed behind a fence; standalone buffers need the same grace
+        if (!buffer->IsPooled() && buffer->GetResource())
+        {
+            m_Core->DeferRelease(buffer->GetResource());
+        }
+        buffer.reset();
+    }
+
+    uint64_t FoliageRenderer::MakeExtractKey(const ChunkCoord& coord, uint32_t layer, uint32_t pointIndex)
+    {
+        // 20 bits per chunk axis (about +-16M world units), 8 for the layer, 16 for the point
+        return (static_cast<uint64_t>(static_cast<uint32_t>(coord.X) & 0xFFFFFu) << 44) |
+               (static_cast<uint64_t>(static_cast<uint32_t>(coord.Z) & 0xFFFFFu) << 24) |
+               (static_cast<uint64_t>(layer & 0xFFu) << 16) |
+               static_cast<uint64_t>(pointIndex & 0xFFFFu);
+    }
+
+} // namespace PCG
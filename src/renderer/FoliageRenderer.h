@@ -0,0 +1,257 @@
+#pragma once
+
+/**
+ * @file FoliageRenderer.h
+ * @brief Streaming and GPU-instanced drawing of scattered foliage and props
+ *
+ * Placements come from FoliageScatter, computed on job workers for chunks
+ * as they come into range. Each chunk's instance transforms live in one GPU
+ * buffer (grouped by layer), and every layer is drawn with a single
+ * ExecuteIndirect over the visible chunks. Distance LOD draws a shrinking
+ * prefix of each chunk's rank-ordered instances. Buffers are released when
+ * their chunk unloads; no ECS entities exist for scattered objects unless
+ * one is taken out with ExtractInstance.
+ */
+
+#include "pcg/FoliageScatter.h"
+
+#include <DirectXMath.h>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace SM
+{
+    class Renderer;
+    class DX12Core;
+    class GPUBuffer;
+    struct JobCounter;
+    struct MeshInstanceData;
+}
+
+namespace PCG
+{
+    class ChunkManager;
+
+    /**
+     * @brief Foliage streaming and LOD configuration
+     */
+    struct FoliageRenderConfig
+    {
+        float DensityScale = 1.0f;        ///< Multiplies the drawn fraction of every layer (quality setting)
+        float DistanceScale = 1.0f;       ///< Multiplies every layer's FullDensityDistance and DrawDistance
+        uint32_t MaxJobsInFlight = 8;     ///< Chunks scattered on workers at once (per frame without workers)
+    };
+
+    /**
+     * @brief Foliage statistics for display
+     */
+    struct FoliageStats
+    {
+        uint32_t ResidentChunks = 0;      ///< Chunks with placements (uploaded or uploading)
+        uint32_t PendingChunks = 0;       ///< Chunks being scattered on workers
+        uint32_t ResidentInstances = 0;   ///< Instances in resident chunks
+        uint32_t DrawnInstances = 0;      ///< Instances drawn last frame after distance LOD
+        uint32_t DrawCalls = 0;           ///< ExecuteIndirect calls last frame (at most one per layer)
+        size_t GPUBytes = 0;              ///< Instance buffer memory
+    };
+
+    /**
+     * @brief A scattered instance taken out of the foliage (see ExtractInstance)
+     */
+    struct FoliagePick
+    {
+        ChunkCoord Chunk;
+        uint32_t Layer = 0;
+        ScatterInstance Instance;
+    };
+
+    /**
+     * @brief Per-chunk instance buffers and indirect drawing for FoliageScatter layers
+     *
+     * Call Update and Render once per frame inside the scene pass, after the
+     * ChunkManager has updated (Render uses its visible chunk list, so
+     * foliage is culled per chunk along with the terrain).
+     */
+    class FoliageRenderer
+    {
+    public:
+        FoliageRenderer();
+        ~FoliageRenderer();
+
+        // Prevent copying
+        FoliageRenderer(const FoliageRenderer&) = delete;
+        FoliageRenderer& operator=(const FoliageRenderer&) = delete;
+
+        // ====================================================================
+        // Initialization
+        // ====================================================================
+
+        /**
+         * @brief Initialize the foliage renderer
+         * @param renderer Main renderer reference
+         * @return true if initialization succeeded
+         */
+        bool Initialize(SM::Renderer& renderer);
+
+        /**
+         * @brief Wait for scatter jobs and release all buffers
+         */
+        void Shutdown();
+
+        /**
+         * @brief Check if renderer is initialized
+         */
+        bool IsInitialized() const { return m_Initialized; }
+
+        // ====================================================================
+        // Configuration
+        // ====================================================================
+
+        /**
+         * @brief Replace the scatter layers (drops every resident chunk)
+         * @param layers Layers to scatter; MeshId is an SM::PrimitiveMesh ID
+         * @param seed World seed
+         */
+        void SetLayers(std::vector<ScatterLayer> layers, uint32_t seed);
+
+        /**
+         * @brief Take per-biome densities from a biome map (drops every resident chunk)
+         */
+        void SetBiomeDensities(const BiomeMap& biomeMap);
+
+        /**
+         * @brief Get the scatter layers and placement generator
+         */
+        const FoliageScatter& GetScatter() const { return m_Scatter; }
+
+        void SetConfig(const FoliageRenderConfig& config) { m_Config = config; }
+        const FoliageRenderConfig& GetConfig() const { return m_Config; }
+
+        // ====================================================================
+        // Per-Frame
+        // ====================================================================
+
+        /**
+         * @brief Stream placements: drop unloaded chunks, scatter new ones, upload finished ones
+         * @param chunks Terrain chunk manager
+         * @param cameraPosition Camera position (nearer chunks are scattered first)
+         */
+        void Update(const ChunkManager& chunks, const DirectX::XMFLOAT3& cameraPosition);
+
+        /**
+         * @brief Draw every layer over the visible chunks with one ExecuteIndirect per layer
+         * @param chunks Terrain chunk manager (its visible list selects the chunks)
+         * @param cameraPosition Camera position for distance LOD
+         */
+        void Render(const ChunkManager& chunks, const DirectX::XMFLOAT3& cameraPosition);
+
+        /**
+         * @brief Drop every resident chunk (they are scattered again as needed)
+         */
+        void Clear();
+
+        // ====================================================================
+        // Interaction
+        // ====================================================================
+
+        /**
+         * @brief Remove the nearest scattered instance so gameplay can replace it with an entity
+         * @param position World position to search around (XZ distance)
+         * @param radius Search radius
+         * @param pick Receives the removed instance
+         * @return true if an instance was found
+         *
+         * The instance stays removed when its chunk is unloaded and scattered
+         * again, until RestoreExtractedInstances.
+         */
+        bool ExtractInstance(const DirectX::XMFLOAT3& position, float radius, FoliagePick& pick);
+
+        /**
+         * @brief Bring back every extracted instance (on resident chunks after they are rescattered)
+         */
+        void RestoreExtractedInstances();
+
+        /**
+         * @brief Get statistics for the last frame
+         */
+        const FoliageStats& GetStats() const { return m_Stats; }
+
+    private:
+        /**
+         * @brief Placements and GPU instances of one chunk
+         */
+        struct ChunkEntry
+        {
+            const Chunk* Source = nullptr;                  ///< Chunk the placements were made for
+            ChunkScatter Scatter;                           ///< Current placements (authoritative)
+            std::unique_ptr<SM::GPUBuffer> Buffer;          ///< Drawn instances
+            std::vector<uint32_t> BufferOffsets;            ///< Layer offsets matching Buffer
+            std::unique_ptr<SM::GPUBuffer> PendingBuffer;   ///< Replacement still uploading
+            uint64_t PendingFence = 0;
+        };
+
+        /**
+         * @brief A chunk being scattered on a worker
+         */
+        struct ScatterJob
+        {
+            const Chunk* Source = nullptr;
+            std::vector<float> Heights;                     ///< Copies: the chunk may unload meanwhile
+            std::vector<BiomeType> Biomes;
+            ChunkScatter Result;
+            std::vector<SM::MeshInstanceData> Instances;
+            std::unique_ptr<SM::JobCounter> Counter;
+        };
+
+        /**
+         * @brief Build instance transforms for placements
+         */
+        static void BuildInstanceData(const FoliageScatter& scatter, const ChunkScatter& placements,
+                                      std::vector<SM::MeshInstanceData>& instances);
+
+        /**
+         * @brief Remove extracted instances from placements
+         * @return true if any were removed
+         */
+        bool RemoveExtracted(ChunkScatter& placements) const;
+
+        /**
+         * @brief Upload instances into a new buffer that replaces the chunk's when ready
+         */
+        void UploadInstances(ChunkEntry& entry, const std::vector<SM::MeshInstanceData>& instances);
+
+        /**
+         * @brief Swap in pending buffers whose upload has finished
+         */
+        void PromotePendingBuffers();
+
+        /**
+         * @brief Release a buffer once the GPU is done with it
+         */
+        void ReleaseBuffer(std::unique_ptr<SM::GPUBuffer>& buffer);
+
+        /**
+         * @brief Wait for every scatter job and discard the results
+         */
+        void CancelJobs();
+
+        static uint64_t MakeExtractKey(const ChunkCoord& coord, uint32_t layer, uint32_t pointIndex);
+
+    private:
+        bool m_Initialized = false;
+        SM::Renderer* m_Renderer = nullptr;
+        SM::DX12Core* m_Core = nullptr;
+
+        FoliageScatter m_Scatter;
+        FoliageRenderConfig m_Config;
+        FoliageStats m_Stats;
+
+        std::unordered_map<ChunkCoord, ChunkEntry, ChunkHash> m_Chunks;
+        std::vector<std::unique_ptr<ScatterJob>> m_Jobs;
+        std::unordered_set<uint64_t> m_Extracted;          ///< Keys of instances taken out by ExtractInstance
+    };
+
+} // namespace PCG
@@ -0,0 +1,115 @@
+#pragma once
+
+/**
+ * @file Frustum.h
+ * @brief View frustum extraction and bounding box tests
+ *
+ * Planes are extracted from a row-vector view-projection matrix
+ * (clip = v * M, as built by Camera) with D3D clip depth [0, w].
+ */
+
+#include <DirectXMath.h>
+
+#include <cmath>
+
+namespace SM
+{
+    /**
+     * @brief Axis-aligned bounding box in world space
+     */
+    struct BoundingBox
+    {
+        DirectX::XMFLOAT3 Min = { 0.0f, 0.0f, 0.0f };
+        DirectX::XMFLOAT3 Max = { 0.0f, 0.0f, 0.0f };
+    };
+
+    /**
+     * @brief View frustum as six inward-facing planes
+     */
+    class Frustum
+    {
+    public:
+        enum PlaneIndex { Left = 0, Right, Bottom, Top, Near, Far, PlaneCount };
+
+        Frustum() = default;
+
+        /**
+         * @brief Build the frustum from a view-projection matrix
+         */
+        explicit Frustum(const DirectX::XMMATRIX& viewProjection)
+        {
+            DirectX::XMFLOAT4X4 m;
+            DirectX::XMStoreFloat4x4(&m, viewProjection);
+            ExtractPlanes(m);
+        }
+
+        /**
+         * @brief Extract planes from a stored view-projection matrix
+         * @param m Row-vector view-projection matrix
+         */
+        void ExtractPlanes(const DirectX::XMFLOAT4X4& m)
+        {
+            // Clip component j is (x, y, z, 1) dotted with column j;
+            // each plane is column 3 (w) plus or minus another column
+            auto combine = [&m](int j, float sign) {
+                return DirectX::XMFLOAT4(
+                    m.m[0][3] + sign * m.m[0][j],
+                    m.m[1][3] + sign * m.m[1][j],
+                    m.m[2][3] + sign * m.m[2][j],
+                    m.m[3][3] + sign * m.m[3][j]);
+            };
+
+            m_Planes[Left] = combine(0, 1.0f);      // w + x >= 0
+            m_Planes[Right] = combine(0, -1.0f);    // w - x >= 0
+            m_Planes[Bottom] = combine(1, 1.0f);    // w + y >= 0
+            m_Planes[Top] = combine(1, -1.0f);      // w - y >= 0
+            m_Planes[Near] = DirectX::XMFLOAT4(     // z >= 0
+                m.m[0][2], m.m[1][2], m.m[2][2], m.m[3][2]);
+            m_Planes[Far] = combine(2, -1.0f);      // w - z >= 0
+
+            for (DirectX::XMFLOAT4& plane : m_Planes)
+            {
+                float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+                if (length > 0.0f)
+                {
+                    plane.x /= length;
+                    plane.y /= length;
+                    plane.z /= length;
+                    plane.w /= length;
+                }
+            }
+        }
+
+        /**
+         * @brief Check if a box is at least partially inside the frustum
+         *
+         * Conservative: boxes near frustum corners may be reported visible.
+         */
+        bool Intersects(const BoundingBox& box) const
+        {
+            for (const DirectX::XMFLOAT4& plane : m_Planes)
+            {
+                // Corner furthest along the plane normal
+                float x = plane.x >= 0.0f ? box.Max.x : box.Min.x;
+                float y = plane.y >= 0.0f ? box.Max.y : box.Min.y;
+                float z = plane.z >= 0.0f ? box.Max.z : box.Min.z;
+
+                if (plane.x * x + plane.y * y + plane.z * z + plane.w < 0.0f)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        /**
+         * @brief Get a plane as (normal.xyz, distance)
+         */
+        const DirectX::XMFLOAT4& GetPlane(int index) const { return m_Planes[index]; }
+
+    private:
+        DirectX::XMFLOAT4 m_Planes[PlaneCount] = {};
+    };
+
+} // namespace SM
@@ -10,6 +10,79 @@ namespace SM
     // GPUBuffer Implementation
     // ============================================================================
 
+    GPUBuffer::~GPUBuffer()
+    {
+        ReleasePoolAllocation();
+        ReleaseBindlessView();
+    }
+
+    GPUBuffer::GPUBuffer(GPUBuffer&& other) noexcept
+        : m_Core(other.m_Core)
+        , m_Resource(std::move(other.m_Resource))
+        , m_UploadFence(other.m_UploadFence)
+        , m_Size(other.m_Size)
+        , m_Usage(other.m_Usage)
+        , m_MappedData(other.m_MappedData)
+        , m_Pool(other.m_Pool)
+        , m_Allocation(other.m_Allocation)
+        , m_Offset(other.m_Offset)
+        , m_SRVHandle(other.m_SRVHandle)
+    {
+        other.m_MappedData = nullptr;
+        other.m_Pool = nullptr;
+        other.m_Allocation = GPUBufferAllocation();
+        other.m_Offset = 0;
+        other.m_SRVHandle = DescriptorHandle();
+    }
+
+    GPUBuffer& GPUBuffer::operator=(GPUBuffer&& other) noexcept
+    {
+        if (this != &other)
+        {
+            ReleasePoolAllocation();
+            ReleaseBindlessView();
+
+            m_Core = other.m_Core;
+            m_Resource = std::move(other.m_Resource);
+            m_UploadFence = other.m_UploadFence;
+            m_Size = other.m_Size;
+            m_Usage = other.m_Usage;
+            m_MappedData = other.m_MappedData;
+            m_Pool = other.m_Pool;
+            m_Allocation = other.m_Allocation;
+            m_Offset = other.m_Offset;
+            m_SRVHandle = other.m_SRVHandle;
+
+            other.m_MappedData = nullptr;
+            other.m_Pool = nullptr;
+            other.m_Allocation = GPUBufferAllocation();
+            other.m_Offset = 0;
+            other.m_SRVHandle = DescriptorHandle();
+        }
+
+        return *this;
+    }
+
+    void GPUBuffer::ReleasePoolAllocation()
+    {
+        if (m_Pool)
+        {
+            m_Pool->Free(m_Allocation);
+            m_Pool = nullptr;
+            m_Allocation = GPUBufferAllocation();
+            m_Offset = 0;
+        }
+    }
+
+    void GPUBuffer::ReleaseBindlessView()
+    {
+        if (m_Core && m_SRVHandle.IsValid())
+        {
+            m_Core->GetCBVSRVUAVHeap().Free(m_SRVHandle);
+        }
+        m_SRVHandle = DescriptorHandle();
+    }
+
     bool GPUBuffer::Initialize(
         DX12Core* core,
         size_t size,
@@ -19,10 +92,54 @@ namespace SM
         assert(core != nullptr && "DX12Core cannot be null!");
         assert(size > 0 && "Buffer size must be greater than 0!");
 
+        ReleasePoolAllocation();
+        m_Resource.Reset();
+        m_UploadFence = 0;
+
+        // GPU-only buffers get their initial data through the copy queue
+        UploadQueue& uploads = core->GetUploadQueue();
+        const bool gpuOnly = (usage == GPUBufferUsage::Default || usage == GPUBufferUsage::Pooled);
+        if (gpuOnly && initialData && !uploads.IsInitialized())
+        {
+            usage = GPUBufferUsage::Upload;
+        }
+
         m_Core = core;
         m_Size = size;
         m_Usage = usage;
 
+        if (usage == GPUBufferUsage::Pooled)
+        {
+            GPUBufferPool& pool = core->GetGeometryPool();
+            if (pool.Allocate(size, m_Allocation))
+            {
+                // Hold a reference so the page outlives the pool's own teardown
+                m_Resource = m_Allocation.Resource;
+                m_Offset = m_Allocation.Offset;
+                m_Pool = &pool;
+
+                if (initialData)
+                {
+                    m_UploadFence = uploads.UploadBuffer(m_Resource.Get(), m_Offset, initialData, size);
+                    if (m_UploadFence == 0)
+                    {
+                        std::cerr << "[GPUBuffer] Failed to upload initial data!" << std::endl;
+                        return false;
+                    }
+                }
+
+                if (m_SRVHandle.IsValid())
+                {
+                    CreateBindlessView();
+                }
+                return true;
+            }
+
+            // Too large for a page, or no room for a new one
+            m_Usage = GPUBufferUsage::Default;
+            usage = GPUBufferUsage::Default;
+        }
+
         ID3D12Device* device = core->GetDevice();
 
         D3D12_HEAP_PROPERTIES heapProps = {};
@@ -40,6 +157,7 @@ namespace SM
                 initialState = D3D12_RESOURCE_STATE_COPY_DEST;
                 break;
 
+            case GPUBufferUsage::UnorderedAccess:
             case GPUBufferUsage::Default:
             default:
                 heapProps.Type = D3D12_HEAP_TYPE_DEFAULT;
@@ -58,7 +176,9 @@ namespace SM
         resourceDesc.SampleDesc.Count = 1;
         resourceDesc.SampleDesc.Quality = 0;
         resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
-        resourceDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
+        resourceDesc.Flags = (usage == GPUBufferUsage::UnorderedAccess)
+            ? D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS
+            : D3D12_RESOURCE_FLAG_NONE;
 
         HRESULT hr = device->CreateCommittedResource(
             &heapProps,
@@ -74,32 +194,15 @@ namespace SM
             return false;
         }
 
-        // For Default usage, create upload buffer for staging
+        // Staged in the shared ring and copied with the frame's other uploads
         if (usage == GPUBufferUsage::Default && initialData)
         {
-            D3D12_HEAP_PROPERTIES uploadHeapProps = {};
-            uploadHeapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
-
-            hr = device->CreateCommittedResource(
-                &uploadHeapProps,
-                D3D12_HEAP_FLAG_NONE,
-                &resourceDesc,
-                D3D12_RESOURCE_STATE_GENERIC_READ,
-                nullptr,
-                IID_PPV_ARGS(&m_UploadResource)
-            );
-
-            if (!CheckHResult(hr, "Failed to create upload buffer"))
+            m_UploadFence = uploads.UploadBuffer(m_Resource.Get(), 0, initialData, size);
+            if (m_UploadFence == 0)
             {
+                std::cerr << "[GPUBuffer] Failed to upload initial data!" << std::endl;
                 return false;
             }
-
-            // Copy data to upload buffer
-            void* mapped = nullptr;
-            D3D12_RANGE readRange = { 0, 0 };
-            m_UploadResource->Map(0, &readRange, &mapped);
-            std::memcpy(mapped, initialData, size);
-            m_UploadResource->Unmap(0, nullptr);
         }
         else if (usage == GPUBufferUsage::Upload && initialData)
         {
@@ -107,6 +210,11 @@ namespace SM
             Update(initialData, size, 0);
         }
 
+        if (m_SRVHandle.IsValid())
+        {
+            CreateBindlessView();
+        }
+
         return true;
     }
 
@@ -128,7 +236,8 @@ namespace SM
 
     void* GPUBuffer::Map()
     {
-        assert(m_Usage != GPUBufferUsage::Default && "Cannot map Default buffers!");
+        assert((m_Usage == GPUBufferUsage::Upload || m_Usage == GPUBufferUsage::Readback) &&
+               "Can only map Upload and Readback buffers!");
 
         if (m_MappedData)
         {
@@ -167,7 +276,33 @@ namespace SM
 
     D3D12_GPU_VIRTUAL_ADDRESS GPUBuffer::GetGPUAddress() const
     {
-        return m_Resource ? m_Resource->GetGPUVirtualAddress() : 0;
+        return m_Resource ? m_Resource->GetGPUVirtualAddress() + m_Offset : 0;
+    }
+
+    bool GPUBuffer::CreateBindlessView()
+    {
+        if (!m_Resource || !m_Core)
+        {
+            return false;
+        }
+
+        assert(m_Size % 4 == 0 && m_Offset % 4 == 0 && "Raw views address 32-bit elements!");
+
+        if (!m_SRVHandle.IsValid())
+        {
+            m_SRVHandle = m_Core->GetCBVSRVUAVHeap().Allocate();
+        }
+
+        D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+        srvDesc.Format = DXGI_FORMAT_R32_TYPELESS;
+        srvDesc.ViewDimension = D3D12_SRV_DIMENSION_BUFFER;
+        srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+        srvDesc.Buffer.FirstElement = m_Offset / 4;
+        srvDesc.Buffer.NumElements = static_cast<UINT>(m_Size / 4);
+        srvDesc.Buffer.Flags = D3D12_BUFFER_SRV_FLAG_RAW;
+
+        m_Core->GetDevice()->CreateShaderResourceView(m_Resource.Get(), &srvDesc, m_SRVHandle.CPU);
+        return true;
     }
 
     // ============================================================================
@@ -340,20 +475,22 @@ namespace SM
 
     D3D12_GPU_VIRTUAL_ADDRESS UploadHeap::Allocate(size_t size, size_t alignment)
     {
-        // Align current offset
-        size_t alignedOffset = AlignSize(m_CurrentOffset, alignment);
-
-        // Check if allocation fits
-        if (alignedOffset + size > m_Size)
+        // Bump the offset with a CAS so parallel command recording can share the heap
+        size_t currentOffset = m_CurrentOffset.load(std::memory_order_relaxed);
+        size_t alignedOffset = 0;
+        do
         {
-            std::cerr << "[DX12] Upload heap out of memory!" << std::endl;
-            return 0;
-        }
+            alignedOffset = AlignSize(currentOffset, alignment);
 
-        D3D12_GPU_VIRTUAL_ADDRESS address = m_GPUBaseAddress + alignedOffset;
-        m_CurrentOffset = alignedOffset + size;
+            // Check if allocation fits
+            if (alignedOffset + size > m_Size)
+            {
+                std::cerr << "[DX12] Upload heap out of memory!" << std::endl;
+                return 0;
+            }
+        } while (!m_CurrentOffset.compare_exchange_weak(currentOffset, alignedOffset + size, std::memory_order_relaxed));
 
-        return address;
+        return m_GPUBaseAddress + alignedOffset;
     }
 
     void* UploadHeap::GetCPUPointer(D3D12_GPU_VIRTUAL_ADDRESS gpuAddress) const
@@ -370,4 +507,72 @@ namespace SM
         m_CurrentOffset = 0;
     }
 
+    // ============================================================================
+    // FrameConstantAllocator Implementation
+    // ============================================================================
+
+    bool FrameConstantAllocator::Initialize(DX12Core* core, size_t sizePerFrame)
+    {
+        for (UploadHeap& heap : m_Heaps)
+        {
+            if (!heap.Initialize(core, sizePerFrame))
+            {
+                Shutdown();
+                return false;
+            }
+        }
+
+        m_FrameIndex = 0;
+        return true;
+    }
+
+    void FrameConstantAllocator::Shutdown()
+    {
+        for (UploadHeap& heap : m_Heaps)
+        {
+            heap.Shutdown();
+        }
+    }
+
+    void FrameConstantAllocator::BeginFrame(uint32_t frameIndex)
+    {
+        assert(frameIndex < FRAME_BUFFER_COUNT && "Frame index out of range!");
+
+        m_FrameIndex = frameIndex;
+        m_Heaps[m_FrameIndex].Reset();
+    }
+
+    D3D12_GPU_VIRTUAL_ADDRESS FrameConstantAllocator::Allocate(const void* data, size_t size)
+    {
+        UploadHeap& heap = m_Heaps[m_FrameIndex];
+
+        D3D12_GPU_VIRTUAL_ADDRESS address = heap.Allocate(
+            AlignSize(size, CONSTANT_BUFFER_ALIGNMENT), CONSTANT_BUFFER_ALIGNMENT);
+        if (address == 0)
+        {
+            return 0;
+        }
+
+        std::memcpy(heap.GetCPUPointer(address), data, size);
+        return address;
+    }
+
+    FrameAllocation FrameConstantAllocator::AllocateTransient(size_t size, size_t alignment)
+    {
+        UploadHeap& heap = m_Heaps[m_FrameIndex];
+
+        FrameAllocation allocation;
+        D3D12_GPU_VIRTUAL_ADDRESS address = heap.Allocate(size, alignment);
+        if (address == 0)
+        {
+            return allocation;
+        }
+
+        allocation.CPUPointer = heap.GetCPUPointer(address);
+        allocation.GPUAddress = address;
+        allocation.Resource = heap.GetResource();
+        allocation.Offset = address - heap.GetResource()->GetGPUVirtualAddress();
+        return allocation;
+    }
+
 } // namespace SM
@@ -12,6 +12,8 @@
 
 #include <d3d12.h>
 #include <wrl/client.h>
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <memory>
 
@@ -42,27 +44,31 @@ namespace SM
     {
         Default,    // GPU-only, requires upload via copy queue
         Upload,     // CPU-writable, GPU-readable (for dynamic data)
-        Readback    // GPU-writable, CPU-readable (for queries)
+        Readback,   // GPU-writable, CPU-readable (for queries)
+        UnorderedAccess, // GPU-only, writable from compute shaders (UAV)
+        Pooled      // GPU-only range sub-allocated from the core's geometry pool (falls back to Default)
     };
 
     /**
      * @brief Base GPU Buffer class
      *
-     * Manages a D3D12 buffer resource with optional upload heap.
+     * Manages a D3D12 buffer resource with optional upload heap. Pooled
+     * buffers share a page resource with other buffers and start at
+     * GetOffset() within it.
      */
     class GPUBuffer
     {
     public:
         GPUBuffer() = default;
-        virtual ~GPUBuffer() = default;
+        virtual ~GPUBuffer();
 
         // Prevent copying
         GPUBuffer(const GPUBuffer&) = delete;
         GPUBuffer& operator=(const GPUBuffer&) = delete;
 
         // Allow moving
-        GPUBuffer(GPUBuffer&&) noexcept = default;
-        GPUBuffer& operator=(GPUBuffer&&) noexcept = default;
+        GPUBuffer(GPUBuffer&& other) noexcept;
+        GPUBuffer& operator=(GPUBuffer&& other) noexcept;
 
         /**
          * @brief Initialize the buffer
@@ -71,6 +77,11 @@ namespace SM
          * @param usage Buffer usage
          * @param initialData Initial data to upload (optional)
          * @return true if successful
+         *
+         * Initial data for Default and Pooled buffers is recorded on the
+         * core's upload queue and goes out with the frame's copy submission;
+         * the buffer is usable once GetUploadFence() completes. Without an
+         * upload queue such buffers fall back to Upload usage.
          */
         bool Initialize(
             DX12Core* core,
@@ -104,14 +115,25 @@ namespace SM
         D3D12_GPU_VIRTUAL_ADDRESS GetGPUAddress() const;
 
         /**
-         * @brief Get the D3D12 resource
+         * @brief Get the D3D12 resource (the shared page for pooled buffers)
          */
         ID3D12Resource* GetResource() const { return m_Resource.Get(); }
 
         /**
-         * @brief Get the upload resource (for staging)
+         * @brief Get the byte offset of this buffer within GetResource()
          */
-        ID3D12Resource* GetUploadResource() const { return m_UploadResource.Get(); }
+        uint64_t GetOffset() const { return m_Offset; }
+
+        /**
+         * @brief Check if the buffer was sub-allocated from the geometry pool
+         */
+        bool IsPooled() const { return m_Pool != nullptr; }
+
+        /**
+         * @brief Get the upload-queue fence value of the initial data copy
+         * @return Fence value, or 0 if nothing is pending (see UploadQueue::IsComplete)
+         */
+        uint64_t GetUploadFence() const { return m_UploadFence; }
 
         /**
          * @brief Get buffer size
@@ -128,14 +150,52 @@ namespace SM
          */
         bool IsValid() const { return m_Resource != nullptr; }
 
+        /**
+         * @brief Create a raw (ByteAddressBuffer) SRV in the bindless heap
+         * @return true if the view exists
+         *
+         * Opt-in, since most vertex and index buffers are never read through
+         * a descriptor. The view is rewritten in place when the buffer is
+         * re-initialized, so the index stays valid. The size must be a
+         * multiple of 4 bytes.
+         */
+        bool CreateBindlessView();
+
+        /**
+         * @brief Get the buffer's index into the bindless buffer array
+         * @return Heap index, or INVALID_BINDLESS_INDEX before CreateBindlessView
+         */
+        uint32_t GetBindlessIndex() const
+        {
+            return m_SRVHandle.IsValid() ? m_SRVHandle.HeapIndex : INVALID_BINDLESS_INDEX;
+        }
+
+    protected:
+        /**
+         * @brief Return a pooled range to its pool (deferred until the GPU is done)
+         */
+        void ReleasePoolAllocation();
+
+        /**
+         * @brief Return the bindless view's descriptor to the heap (deferred past frames in flight)
+         */
+        void ReleaseBindlessView();
+
     protected:
         DX12Core* m_Core = nullptr;
         ComPtr<ID3D12Resource> m_Resource;
-        ComPtr<ID3D12Resource> m_UploadResource;  // For Default usage staging
+        uint64_t m_UploadFence = 0;               // Initial data copy on the upload queue
 
         size_t m_Size = 0;
         GPUBufferUsage m_Usage = GPUBufferUsage::Default;
         void* m_MappedData = nullptr;
+
+        // Pooled usage
+        GPUBufferPool* m_Pool = nullptr;
+        GPUBufferAllocation m_Allocation;
+        uint64_t m_Offset = 0;
+
+        DescriptorHandle m_SRVHandle;   // Bindless raw view (optional)
     };
 
     /**
@@ -286,7 +346,8 @@ namespace SM
      * @brief Upload Heap Manager
      *
      * Ring buffer for efficient dynamic upload allocations.
-     * Used for per-frame constant buffer updates.
+     * Used for per-frame constant buffer updates. Allocate is lock-free and
+     * may be called from several recording threads at once.
      */
     class UploadHeap
     {
@@ -340,7 +401,7 @@ namespace SM
         /**
          * @brief Get used size
          */
-        size_t GetUsedSize() const { return m_CurrentOffset; }
+        size_t GetUsedSize() const { return m_CurrentOffset.load(std::memory_order_relaxed); }
 
     private:
         DX12Core* m_Core = nullptr;
@@ -348,10 +409,105 @@ namespace SM
 
         void* m_MappedData = nullptr;
         size_t m_Size = 0;
-        size_t m_CurrentOffset = 0;
+        std::atomic<size_t> m_CurrentOffset{ 0 };
         D3D12_GPU_VIRTUAL_ADDRESS m_GPUBaseAddress = 0;
     };
 
+    /**
+     * @brief Transient block carved out of a FrameConstantAllocator ring
+     */
+    struct FrameAllocation
+    {
+        void* CPUPointer = nullptr;                 ///< Persistently mapped write pointer
+        D3D12_GPU_VIRTUAL_ADDRESS GPUAddress = 0;   ///< Address for root CBV/SRV binding
+        ID3D12Resource* Resource = nullptr;         ///< Backing upload resource
+        uint64_t Offset = 0;                        ///< Byte offset into Resource
+
+        bool IsValid() const { return CPUPointer != nullptr; }
+    };
+
+    /**
+     * @brief Per-frame linear allocator for dynamic constants
+     *
+     * Owns one UploadHeap ring per buffered frame. BeginFrame rewinds the ring
+     * of the frame about to be recorded, which is safe once DX12Core::BeginFrame
+     * has waited on that frame's fence. Every draw can then get its own
+     * constants without stalling or re-mapping; allocations stay valid until
+     * the same frame index is recorded again. Allocate may be called from
+     * parallel recording threads between BeginFrame calls.
+     */
+    class FrameConstantAllocator
+    {
+    public:
+        FrameConstantAllocator() = default;
+        ~FrameConstantAllocator() = default;
+
+        // Prevent copying
+        FrameConstantAllocator(const FrameConstantAllocator&) = delete;
+        FrameConstantAllocator& operator=(const FrameConstantAllocator&) = delete;
+
+        /**
+         * @brief Create one upload ring per buffered frame
+         * @param core DX12 core reference
+         * @param sizePerFrame Ring size in bytes for each frame
+         * @return true if successful
+         */
+        bool Initialize(DX12Core* core, size_t sizePerFrame);
+
+        /**
+         * @brief Shutdown and release resources
+         */
+        void Shutdown();
+
+        /**
+         * @brief Select and rewind the ring for a frame
+         * @param frameIndex Frame index from DX12Core::BeginFrame
+         */
+        void BeginFrame(uint32_t frameIndex);
+
+        /**
+         * @brief Copy constants into the current frame's ring
+         * @param data Source data
+         * @param size Data size in bytes
+         * @return GPU address for a root CBV, or 0 if the ring is full
+         */
+        D3D12_GPU_VIRTUAL_ADDRESS Allocate(const void* data, size_t size);
+
+        /**
+         * @brief Copy a constant struct into the current frame's ring
+         */
+        template<typename T>
+        D3D12_GPU_VIRTUAL_ADDRESS Push(const T& data)
+        {
+            return Allocate(&data, sizeof(T));
+        }
+
+        /**
+         * @brief Reserve uninitialized space in the current frame's ring
+         * @param size Allocation size in bytes
+         * @param alignment Required alignment (default 256 for CBV)
+         * @return Allocation (invalid if the ring is full)
+         *
+         * For per-frame structured buffers and indirect arguments that are
+         * filled in place rather than copied from a single struct.
+         */
+        FrameAllocation AllocateTransient(size_t size, size_t alignment = 256);
+
+        /**
+         * @brief Get bytes used in the current frame's ring
+         */
+        size_t GetUsedSize() const { return m_Heaps[m_FrameIndex].GetUsedSize(); }
+
+        /**
+         * @brief Check if the rings were created
+         */
+        bool IsValid() const { return m_Heaps[0].GetResource() != nullptr; }
+
+    private:
+        std::array<UploadHeap, FRAME_BUFFER_COUNT> m_Heaps;
+        uint32_t m_FrameIndex = 0;
+    };
+
     /**
      * @brief Align size to specified alignment
      * @param size Original size
@@ -0,0 +1,446 @@
+#include "renderer/GPUBufferPool.h"
+#include "renderer/DX12Core.h"
+
+#include <algorithm>
+#include <bit>
+#include <iostream>
+
+namespace SM
+{
+    // ============================================================================
+    // TLSFAllocator Implementation
+    // ============================================================================
+
+    void TLSFAllocator::Initialize(uint32_t capacity)
+    {
+        m_Blocks.clear();
+        m_UnusedBlocks.clear();
+        for (auto& heads : m_FreeHeads)
+        {
+            heads.fill(INVALID);
+        }
+        m_SLBitmaps.fill(0);
+        m_FLBitmap = 0;
+        m_Capacity = capacity;
+        m_FreeBlockCount = 0;
+
+        if (capacity == 0)
+        {
+            return;
+        }
+
+        uint32_t block = NewBlock();
+        m_Blocks[block].Offset = 0;
+        m_Blocks[block].Size = capacity;
+        InsertFree(block);
+    }
+
+    uint32_t TLSFAllocator::Allocate(uint32_t size, uint32_t& offset)
+    {
+        if (size == 0 || size > m_Capacity)
+        {
+            return INVALID;
+        }
+
+        uint32_t block = FindSuitable(size);
+        if (block == INVALID)
+        {
+            return INVALID;
+        }
+
+        RemoveFree(block);
+
+        // Split off the tail as a new free block
+        if (m_Blocks[block].Size > size)
+        {
+            uint32_t rest = NewBlock();
+            Block& head = m_Blocks[block];
+            Block& tail = m_Blocks[rest];
+
+            tail.Offset = head.Offset + size;
+            tail.Size = head.Size - size;
+            tail.PrevPhysical = block;
+            tail.NextPhysical = head.NextPhysical;
+            if (tail.NextPhysical != INVALID)
+            {
+                m_Blocks[tail.NextPhysical].PrevPhysical = rest;
+            }
+
+            head.NextPhysical = rest;
+            head.Size = size;
+            InsertFree(rest);
+        }
+
+        offset = m_Blocks[block].Offset;
+        return block;
+    }
+
+    void TLSFAllocator::Free(uint32_t block)
+    {
+        if (block >= m_Blocks.size() || m_Blocks[block].IsFree)
+        {
+            return;
+        }
+
+        // Merge with the following block
+        uint32_t next = m_Blocks[block].NextPhysical;
+        if (next != INVALID && m_Blocks[next].IsFree)
+        {
+            RemoveFree(next);
+            m_Blocks[block].Size += m_Blocks[next].Size;
+            m_Blocks[block].NextPhysical = m_Blocks[next].NextPhysical;
+            if (m_Blocks[block].NextPhysical != INVALID)
+            {
+                m_Blocks[m_Blocks[block].NextPhysical].PrevPhysical = block;
+            }
+            ReleaseBlock(next);
+        }
+
+        // Merge into the preceding block
+        uint32_t prev = m_Blocks[block].PrevPhysical;
+        if (prev != INVALID && m_Blocks[prev].IsFree)
+        {
+            RemoveFree(prev);
+            m_Blocks[prev].Size += m_Blocks[block].Size;
+            m_Blocks[prev].NextPhysical = m_Blocks[block].NextPhysical;
+            if (m_Blocks[prev].NextPhysical != INVALID)
+            {
+                m_Blocks[m_Blocks[prev].NextPhysical].PrevPhysical = prev;
+            }
+            ReleaseBlock(block);
+            block = prev;
+        }
+
+        InsertFree(block);
+    }
+
+    uint32_t TLSFAllocator::GetLargestFreeBlock() const
+    {
+        if (m_FLBitmap == 0)
+        {
+            return 0;
+        }
+
+        // Only the highest non-empty class can hold the largest block
+        uint32_t fl = 31 - std::countl_zero(m_FLBitmap);
+        uint32_t sl = 31 - std::countl_zero(m_SLBitmaps[fl]);
+
+        uint32_t largest = 0;
+        for (uint32_t block = m_FreeHeads[fl][sl]; block != INVALID; block = m_Blocks[block].NextFree)
+        {
+            largest = std::max(largest, m_Blocks[block].Size);
+        }
+
+        return largest;
+    }
+
+    void TLSFAllocator::Mapping(uint32_t size, uint32_t& fl, uint32_t& sl)
+    {
+        if (size < SL_COUNT)
+        {
+            // Small sizes map linearly into the first class
+            fl = 0;
+            sl = size;
+        }
+        else
+        {
+            uint32_t log2 = static_cast<uint32_t>(std::bit_width(size)) - 1;
+            sl = (size >> (log2 - SL_LOG2)) - SL_COUNT;
+            fl = log2 - SL_LOG2 + 1;
+        }
+    }
+
+    uint32_t TLSFAllocator::FindSuitable(uint32_t size) const
+    {
+        // Round up to the next class boundary so any block in the class fits
+        if (size >= SL_COUNT)
+        {
+            uint32_t log2 = static_cast<uint32_t>(std::bit_width(size)) - 1;
+            size += (1u << (log2 - SL_LOG2)) - 1;
+        }
+
+        uint32_t fl = 0;
+        uint32_t sl = 0;
+        Mapping(size, fl, sl);
+
+        uint32_t slMap = m_SLBitmaps[fl] & (~0u << sl);
+        if (slMap == 0)
+        {
+            uint32_t flMap = (fl + 1 < 32) ? (m_FLBitmap & (~0u << (fl + 1))) : 0;
+            if (flMap == 0)
+            {
+                return INVALID;
+            }
+
+            fl = static_cast<uint32_t>(std::countr_zero(flMap));
+            slMap = m_SLBitmaps[fl];
+        }
+
+        sl = static_cast<uint32_t>(std::countr_zero(slMap));
+        return m_FreeHeads[fl][sl];
+    }
+
+    void TLSFAllocator::InsertFree(uint32_t block)
+    {
+        uint32_t fl = 0;
+        uint32_t sl = 0;
+        Mapping(m_Blocks[block].Size, fl, sl);
+
+        uint32_t head = m_FreeHeads[fl][sl];
+        m_Blocks[block].PrevFree = INVALID;
+        m_Blocks[block].NextFree = head;
+        m_Blocks[block].IsFree = true;
+        if (head != INVALID)
+        {
+            m_Blocks[head].PrevFree = block;
+        }
+
+        m_FreeHeads[fl][sl] = block;
+        m_SLBitmaps[fl] |= 1u << sl;
+        m_FLBitmap |= 1u << fl;
+        m_FreeBlockCount++;
+    }
+
+    void TLSFAllocator::RemoveFree(uint32_t block)
+    {
+        uint32_t fl = 0;
+        uint32_t sl = 0;
+        Mapping(m_Blocks[block].Size, fl, sl);
+
+        Block& b = m_Blocks[block];
+        if (b.PrevFree != INVALID)
+        {
+            m_Blocks[b.PrevFree].NextFree = b.NextFree;
+        }
+        if (b.NextFree != INVALID)
+        {
+            m_Blocks[b.NextFree].PrevFree = b.PrevFree;
+        }
+
+        if (m_FreeHeads[fl][sl] == block)
+        {
+            m_FreeHeads[fl][sl] = b.NextFree;
+            if (b.NextFree == INVALID)
+            {
+                m_SLBitmaps[fl] &= ~(1u << sl);
+                if (m_SLBitmaps[fl] == 0)
+                {
+                    m_FLBitmap &= ~(1u << fl);
+                }
+            }
+        }
+
+        b.PrevFree = INVALID;
+        b.NextFree = INVALID;
+        b.IsFree = false;
+        m_FreeBlockCount--;
+    }
+
+    uint32_t TLSFAllocator::NewBlock()
+    {
+        if (!m_UnusedBlocks.empty())
+        {
+            uint32_t block = m_UnusedBlocks.back();
+            m_UnusedBlocks.pop_back();
+            return block;
+        }
+
+        m_Blocks.emplace_back();
+        return static_cast<uint32_t>(m_Blocks.size() - 1);
+    }
+
+    void TLSFAllocator::ReleaseBlock(uint32_t block)
+    {
+        m_Blocks[block] = Block();
+        m_UnusedBlocks.push_back(block);
+    }
+
+    // ============================================================================
+    // GPUBufferPool Implementation
+    // ============================================================================
+
+    GPUBufferPool::~GPUBufferPool()
+    {
+        Shutdown();
+    }
+
+    bool GPUBufferPool::Initialize(DX12Core* core, uint64_t pageSize)
+    {
+        if (IsInitialized())
+        {
+            return true;
+        }
+
+        pageSize = (pageSize + ALLOCATION_GRANULARITY - 1) & ~(ALLOCATION_GRANULARITY - 1);
+        if (!core || pageSize == 0 || pageSize / ALLOCATION_GRANULARITY > UINT32_MAX)
+        {
+            std::cerr << "[GPUBufferPool] Invalid page size" << std::endl;
+            return false;
+        }
+
+        m_Core = core;
+        m_PageSize = pageSize;
+
+        if (!AddPage())
+        {
+            m_Core = nullptr;
+            return false;
+        }
+
+        std::cout << "[GPUBufferPool] Initialized (" << (pageSize / (1024 * 1024)) << " MB pages)" << std::endl;
+        return true;
+    }
+
+    void GPUBufferPool::Shutdown()
+    {
+        m_DeferredFrees.clear();
+        m_Pages.clear();
+        m_UsedBytes = 0;
+        m_PendingFreeBytes = 0;
+        m_AllocationCount = 0;
+        m_PageSize = 0;
+        m_Core = nullptr;
+    }
+
+    bool GPUBufferPool::Allocate(uint64_t size, GPUBufferAllocation& allocation)
+    {
+        allocation = GPUBufferAllocation();
+
+        if (!IsInitialized() || size == 0 || size > m_PageSize)
+        {
+            return false;
+        }
+
+        uint32_t units = static_cast<uint32_t>((size + ALLOCATION_GRANULARITY - 1) / ALLOCATION_GRANULARITY);
+
+        uint32_t page = 0;
+        uint32_t offset = 0;
+        uint32_t block = TLSFAllocator::INVALID;
+
+        for (; page < m_Pages.size(); ++page)
+        {
+            block = m_Pages[page].Allocator.Allocate(units, offset);
+            if (block != TLSFAllocator::INVALID)
+            {
+                break;
+            }
+        }
+
+        // Every page is full or too fragmented
+        if (block == TLSFAllocator::INVALID)
+        {
+            if (!AddPage())
+            {
+                return false;
+            }
+
+            page = static_cast<uint32_t>(m_Pages.size() - 1);
+            block = m_Pages[page].Allocator.Allocate(units, offset);
+            if (block == TLSFAllocator::INVALID)
+            {
+                return false;
+            }
+        }
+
+        allocation.Resource = m_Pages[page].Resource.Get();
+        allocation.Offset = static_cast<uint64_t>(offset) * ALLOCATION_GRANULARITY;
+        allocation.Size = static_cast<uint64_t>(units) * ALLOCATION_GRANULARITY;
+        allocation.Page = page;
+        allocation.Block = block;
+
+        m_UsedBytes += allocation.Size;
+        m_AllocationCount++;
+        return true;
+    }
+
+    void GPUBufferPool::Free(const GPUBufferAllocation& allocation)
+    {
+        if (!IsInitialized() || !allocation.IsValid() || allocation.Page >= m_Pages.size())
+        {
+            return;
+        }
+
+        DeferredFree deferred;
+        deferred.Page = allocation.Page;
+        deferred.Block = allocation.Block;
+        deferred.Size = allocation.Size;
+        deferred.FenceValue = m_Core->GetNextFenceValue();
+        m_DeferredFrees.push_back(deferred);
+
+        m_UsedBytes -= allocation.Size;
+        m_PendingFreeBytes += allocation.Size;
+        m_AllocationCount--;
+    }
+
+    void GPUBufferPool::ProcessDeferredFrees(uint64_t completedFenceValue)
+    {
+        while (!m_DeferredFrees.empty() && m_DeferredFrees.front().FenceValue <= completedFenceValue)
+        {
+            const DeferredFree& deferred = m_DeferredFrees.front();
+            m_Pages[deferred.Page].Allocator.Free(deferred.Block);
+            m_PendingFreeBytes -= deferred.Size;
+            m_DeferredFrees.pop_front();
+        }
+    }
+
+    GPUBufferPoolStats GPUBufferPool::GetStats() const
+    {
+        GPUBufferPoolStats stats;
+        stats.PageCount = static_cast<uint32_t>(m_Pages.size());
+        stats.ReservedBytes = m_PageSize * m_Pages.size();
+        stats.UsedBytes = m_UsedBytes;
+        stats.PendingFreeBytes = m_PendingFreeBytes;
+        stats.AllocationCount = m_AllocationCount;
+
+        for (const Page& page : m_Pages)
+        {
+            stats.FreeBlockCount += page.Allocator.GetFreeBlockCount();
+            stats.LargestFreeBlock = std::max(stats.LargestFreeBlock,
+                static_cast<uint64_t>(page.Allocator.GetLargestFreeBlock()) * ALLOCATION_GRANULARITY);
+        }
+
+        return stats;
+    }
+
+    bool GPUBufferPool::AddPage()
+    {
+        D3D12_HEAP_PROPERTIES heapProps = {};
+        heapProps.Type = D3D12_HEAP_TYPE_DEFAULT;
+
+        D3D12_RESOURCE_DESC desc = {};
+        desc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+        desc.Width = m_PageSize;
+        desc.Height = 1;
+        desc.DepthOrArraySize = 1;
+        desc.MipLevels = 1;
+        desc.Format = DXGI_FORMAT_UNKNOWN;
+        desc.SampleDesc.Count = 1;
+        desc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+        Page page;
+        HRESULT hr = m_Core->GetDevice()->CreateCommittedResource(
+            &heapProps,
+            D3D12_HEAP_FLAG_NONE,
+            &desc,
+            D3D12_RESOURCE_STATE_COMMON,
+            nullptr,
+            IID_PPV_ARGS(&page.Resource)
+        );
+
+        if (!CheckHResult(hr, "Failed to create GPU buffer pool page"))
+        {
+            return false;
+        }
+
+        page.Allocator.Initialize(static_cast<uint32_t>(m_PageSize / ALLOCATION_GRANULARITY));
+        m_Pages.push_back(std::move(page));
+
+        if (m_Pages.size() > 1)
+        {
+            std::cout << "[GPUBufferPool] Added page " << m_Pages.size() << std::endl;
+        }
+
+        return true;
+    }
+
+} // namespace SM
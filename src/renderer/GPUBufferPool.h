@@ -0,0 +1,246 @@
+#pragma once
+
+/**
+ * @file GPUBufferPool.h
+ * @brief Sub-allocation of small GPU buffers from large DEFAULT-heap pages
+ *
+ * Streaming geometry creates and frees many small buffers. Instead of a
+ * committed resource per buffer, the pool carves byte ranges out of a few
+ * large page buffers with a TLSF (two-level segregated fit) allocator, and
+ * defers frees until the direct queue has finished the frame that last
+ * could have read them.
+ */
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <Windows.h>
+#include <d3d12.h>
+#include <wrl/client.h>
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace SM
+{
+    class DX12Core;
+
+    /**
+     * @brief O(1) offset allocator using two-level segregated fit
+     *
+     * Manages offsets only; sizes and offsets are in caller-defined units.
+     * Free blocks are binned by size class (power of two, split into 16
+     * linear sub-classes) and adjacent free blocks are merged on release.
+     */
+    class TLSFAllocator
+    {
+    public:
+        static constexpr uint32_t INVALID = UINT32_MAX;
+
+        /**
+         * @brief Reset to a single free block covering [0, capacity)
+         */
+        void Initialize(uint32_t capacity);
+
+        /**
+         * @brief Allocate a range
+         * @param size Size in units (> 0)
+         * @param offset Receives the range start
+         * @return Block handle for Free, or INVALID if no block fits
+         */
+        uint32_t Allocate(uint32_t size, uint32_t& offset);
+
+        /**
+         * @brief Release a range returned by Allocate
+         */
+        void Free(uint32_t block);
+
+        /**
+         * @brief Get the size of an allocated block in units
+         */
+        uint32_t GetBlockSize(uint32_t block) const { return m_Blocks[block].Size; }
+
+        /**
+         * @brief Get the total capacity in units
+         */
+        uint32_t GetCapacity() const { return m_Capacity; }
+
+        /**
+         * @brief Get the number of free blocks (fragmentation indicator)
+         */
+        uint32_t GetFreeBlockCount() const { return m_FreeBlockCount; }
+
+        /**
+         * @brief Get the size of the largest free block in units
+         */
+        uint32_t GetLargestFreeBlock() const;
+
+    private:
+        static constexpr uint32_t SL_LOG2 = 4;                  ///< 16 sub-classes per power of two
+        static constexpr uint32_t SL_COUNT = 1u << SL_LOG2;
+        static constexpr uint32_t FL_COUNT = 32 - SL_LOG2 + 1;
+
+        struct Block
+        {
+            uint32_t Offset = 0;
+            uint32_t Size = 0;
+            uint32_t PrevPhysical = INVALID;    ///< Neighbour ending at Offset
+            uint32_t NextPhysical = INVALID;    ///< Neighbour starting at Offset + Size
+            uint32_t PrevFree = INVALID;
+            uint32_t NextFree = INVALID;
+            bool IsFree = false;
+        };
+
+        static void Mapping(uint32_t size, uint32_t& fl, uint32_t& sl);
+        uint32_t FindSuitable(uint32_t size) const;
+        void InsertFree(uint32_t block);
+        void RemoveFree(uint32_t block);
+        uint32_t NewBlock();
+        void ReleaseBlock(uint32_t block);
+
+    private:
+        std::vector<Block> m_Blocks;
+        std::vector<uint32_t> m_UnusedBlocks;
+        std::array<std::array<uint32_t, SL_COUNT>, FL_COUNT> m_FreeHeads = {};
+        std::array<uint32_t, FL_COUNT> m_SLBitmaps = {};
+        uint32_t m_FLBitmap = 0;
+        uint32_t m_Capacity = 0;
+        uint32_t m_FreeBlockCount = 0;
+    };
+
+    /**
+     * @brief A range sub-allocated from a GPUBufferPool page
+     */
+    struct GPUBufferAllocation
+    {
+        ID3D12Resource* Resource = nullptr;     ///< Page buffer holding the range
+        uint64_t Offset = 0;                    ///< Byte offset into Resource
+        uint64_t Size = 0;                      ///< Bytes reserved (rounded up to the pool granularity)
+        uint32_t Page = 0;
+        uint32_t Block = TLSFAllocator::INVALID;
+
+        bool IsValid() const { return Resource != nullptr; }
+    };
+
+    /**
+     * @brief Allocator statistics
+     */
+    struct GPUBufferPoolStats
+    {
+        uint32_t PageCount = 0;
+        uint64_t ReservedBytes = 0;         ///< Total size of all pages
+        uint64_t UsedBytes = 0;             ///< Bytes in live allocations
+        uint64_t PendingFreeBytes = 0;      ///< Bytes waiting on a frame fence
+        uint32_t AllocationCount = 0;
+        uint32_t FreeBlockCount = 0;        ///< Across all pages
+        uint64_t LargestFreeBlock = 0;      ///< Largest single range that can be allocated
+    };
+
+    /**
+     * @brief Pool of DEFAULT-heap page buffers for vertex/index data
+     *
+     * Pages are committed buffers rather than heaps of placed resources:
+     * placed buffers need 64 KB alignment, larger than a typical chunk mesh,
+     * while views over one buffer can start at any 256-byte offset. Buffers
+     * allow simultaneous access from several queues, so copy-queue uploads
+     * into one range may overlap direct-queue reads of another.
+     *
+     * Not thread-safe; allocate and free from the render thread.
+     */
+    class GPUBufferPool
+    {
+    public:
+        static constexpr uint64_t ALLOCATION_GRANULARITY = 256;
+
+        GPUBufferPool() = default;
+        ~GPUBufferPool();
+
+        // Prevent copying
+        GPUBufferPool(const GPUBufferPool&) = delete;
+        GPUBufferPool& operator=(const GPUBufferPool&) = delete;
+
+        // ====================================================================
+        // Initialization
+        // ====================================================================
+
+        /**
+         * @brief Set up the pool and create its first page
+         * @param core DX12 core (device and frame fence)
+         * @param pageSize Size of each page buffer in bytes
+         * @return true if successful
+         */
+        bool Initialize(DX12Core* core, uint64_t pageSize);
+
+        /**
+         * @brief Release all pages (the GPU must be idle)
+         */
+        void Shutdown();
+
+        /**
+         * @brief Check if the pool can allocate
+         */
+        bool IsInitialized() const { return m_Core != nullptr; }
+
+        // ====================================================================
+        // Allocation
+        // ====================================================================
+
+        /**
+         * @brief Sub-allocate a range (256-byte aligned)
+         * @param size Size in bytes
+         * @param allocation Receives the range
+         * @return false if size exceeds the page size or a new page could not be created
+         */
+        bool Allocate(uint64_t size, GPUBufferAllocation& allocation);
+
+        /**
+         * @brief Release a range once the GPU can no longer be reading it
+         *
+         * The range is reused only after the direct queue passes every frame
+         * recorded so far; ProcessDeferredFrees performs the release.
+         */
+        void Free(const GPUBufferAllocation& allocation);
+
+        /**
+         * @brief Release deferred frees whose fence has completed
+         * @param completedFenceValue Last completed direct-queue fence value
+         */
+        void ProcessDeferredFrees(uint64_t completedFenceValue);
+
+        /**
+         * @brief Get allocator statistics
+         */
+        GPUBufferPoolStats GetStats() const;
+
+    private:
+        struct Page
+        {
+            Microsoft::WRL::ComPtr<ID3D12Resource> Resource;
+            TLSFAllocator Allocator;
+        };
+
+        struct DeferredFree
+        {
+            uint32_t Page = 0;
+            uint32_t Block = TLSFAllocator::INVALID;
+            uint64_t Size = 0;
+            uint64_t FenceValue = 0;
+        };
+
+        bool AddPage();
+
+    private:
+        DX12Core* m_Core = nullptr;
+        uint64_t m_PageSize = 0;
+
+        std::vector<Page> m_Pages;
+        std::deque<DeferredFree> m_DeferredFrees;   ///< Ordered by fence value
+
+        uint64_t m_UsedBytes = 0;
+        uint64_t m_PendingFreeBytes = 0;
+        uint32_t m_AllocationCount = 0;
+    };
+
+} // namespace SM
@@ -0,0 +1,416 @@
+#include "renderer/GPUHeightmapGenerator.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace PCG
+{
+    namespace
+    {
+        /// Must match [numthreads] in HeightmapCompute.hlsl
+        constexpr uint32_t THREAD_GROUP_SIZE = 8;
+
+        /// Must match HEIGHTMAP_FLAG_* in HeightmapCompute.hlsl
+        constexpr uint32_t FLAG_DOMAIN_WARP = 0x1;
+        constexpr uint32_t FLAG_FALLOFF = 0x2;
+        constexpr uint32_t FLAG_TERRACING = 0x4;
+
+        // Root parameter slots
+        constexpr uint32_t ROOT_CONSTANTS = 0;
+        constexpr uint32_t ROOT_PERMUTATION = 1;
+        constexpr uint32_t ROOT_OUTPUT = 2;
+    }
+
+    GPUHeightmapGenerator::~GPUHeightmapGenerator()
+    {
+        Shutdown();
+    }
+
+    // ============================================================================
+    // Initialization
+    // ============================================================================
+
+    bool GPUHeightmapGenerator::Initialize(SM::DX12Core* core)
+    {
+        if (m_Initialized)
+        {
+            return true;
+        }
+
+        if (!core)
+        {
+            std::cerr << "[GPUHeightmapGenerator] Cannot initialize: DX12Core is null" << std::endl;
+            return false;
+        }
+
+        m_Core = core;
+
+        if (!SM::CompileShaderFromFile(L"shaders/HeightmapCompute.hlsl", "main", "cs_5_1", m_ComputeShader))
+        {
+            std::cerr << "[GPUHeightmapGenerator] Failed to compile heightmap compute shader!" << std::endl;
+            return false;
+        }
+
+        // Root signature:
+        // 0: Constants - Generation parameters (b0)
+        // 1: SRV - Permutation table (t0)
+        // 2: Table - Output heightmap UAV (u0)
+        SM::DescriptorRange outputRange;
+        outputRange.Type = D3D12_DESCRIPTOR_RANGE_TYPE_UAV;
+        outputRange.NumDescriptors = 1;
+        outputRange.BaseShaderRegister = 0;
+
+        bool built = m_RootSignature
+            .Begin(SM::RootSignatureFlags::None)
+            .AddConstants(sizeof(GPUHeightmapConstants) / sizeof(uint32_t), 0)
+            .AddSRV(0)
+            .AddDescriptorTable({ outputRange })
+            .Build(m_Core);
+
+        if (!built)
+        {
+            std::cerr << "[GPUHeightmapGenerator] Failed to create root signature!" << std::endl;
+            return false;
+        }
+
+        built = m_PipelineState
+            .Begin()
+            .SetRootSignature(m_RootSignature)
+            .SetComputeShader(m_ComputeShader)
+            .Build(m_Core);
+
+        if (!built)
+        {
+            std::cerr << "[GPUHeightmapGenerator] Failed to create pipeline state!" << std::endl;
+            return false;
+        }
+
+        if (!m_CommandList.Initialize(m_Core, SM::CommandListType::Compute))
+        {
+            std::cerr << "[GPUHeightmapGenerator] Failed to create command list!" << std::endl;
+            return false;
+        }
+
+        m_FenceValue = 0;
+        m_Initialized = true;
+
+        std::cout << "[GPUHeightmapGenerator] Initialized" << std::endl;
+        return true;
+    }
+
+    void GPUHeightmapGenerator::Shutdown()
+    {
+        if (!m_Initialized)
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_SubmitMutex);
+
+        WaitForCompletion();
+
+        m_FenceValue = 0;
+        m_ReadbackBuffer.reset();
+        m_ScratchTexture = SM::Texture();
+        m_PermutationBuffers.clear();
+
+        m_Initialized = false;
+        m_Core = nullptr;
+    }
+
+    bool GPUHeightmapGenerator::ReserveScratchTexture(uint32_t width, uint32_t height)
+    {
+        if (!m_Initialized)
+        {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(m_SubmitMutex);
+
+        if (m_ScratchTexture.IsValid() &&
+            m_ScratchTexture.GetWidth() >= width && m_ScratchTexture.GetHeight() >= height)
+        {
+            return true;
+        }
+
+        m_ScratchTexture = SM::Texture();
+        return CreateHeightmapTexture(width, height, m_ScratchTexture);
+    }
+
+    bool GPUHeightmapGenerator::CreateHeightmapTexture(uint32_t width, uint32_t height, SM::Texture& texture) const
+    {
+        if (!m_Core)
+        {
+            return false;
+        }
+
+        SM::TextureDesc desc;
+        desc.Width = width;
+        desc.Height = height;
+        desc.Format = DXGI_FORMAT_R32_FLOAT;
+        desc.Usage = SM::TextureUsage::ShaderResource | SM::TextureUsage::UnorderedAccess;
+
+        return texture.Create(m_Core, desc, "Heightmap");
+    }
+
+    // ============================================================================
+    // Generation
+    // ============================================================================
+
+    bool GPUHeightmapGenerator::Dispatch(SM::CommandList& cmdList, const HeightmapSettings& settings,
+                                         const GPUHeightmapRegion& region, SM::Texture& target)
+    {
+        if (!m_Initialized || !target.IsValid())
+        {
+            return false;
+        }
+
+        GPUHeightmapRegion resolved = ResolveRegion(settings, region);
+        if (resolved.Width <= 0 || resolved.Height <= 0 ||
+            static_cast<uint32_t>(resolved.Width) > target.GetWidth() ||
+            static_cast<uint32_t>(resolved.Height) > target.GetHeight())
+        {
+            std::cerr << "[GPUHeightmapGenerator] Region does not fit the target texture" << std::endl;
+            return false;
+        }
+
+        SM::GPUBuffer* permutation = GetPermutationBuffer(settings.Seed);
+        if (!permutation)
+        {
+            return false;
+        }
+
+        const FBMSettings& noise = settings.Noise;
+
+        // Same normalization as FBM::CalculateNormalization
+        float normalization = 0.0f;
+        float octaveAmplitude = 1.0f;
+        for (int i = 0; i < noise.Octaves; ++i)
+        {
+            normalization += octaveAmplitude;
+            octaveAmplitude *= noise.Persistence;
+        }
+
+        GPUHeightmapConstants constants = {};
+        constants.OriginX = resolved.OriginX;
+        constants.OriginY = resolved.OriginY;
+        constants.Step = resolved.Step;
+        constants.WarpStrength = settings.WarpStrength;
+        constants.Width = static_cast<uint32_t>(resolved.Width);
+        constants.Height = static_cast<uint32_t>(resolved.Height);
+        constants.Octaves = static_cast<uint32_t>(std::max(noise.Octaves, 0));
+        constants.Flags = (settings.ApplyDomainWarp ? FLAG_DOMAIN_WARP : 0u)
+                        | (settings.ApplyFalloffMap ? FLAG_FALLOFF : 0u)
+                        | (settings.ApplyTerracing && settings.TerraceCount > 0 ? FLAG_TERRACING : 0u);
+        constants.Frequency = noise.Frequency;
+        constants.Amplitude = noise.Amplitude;
+        constants.Lacunarity = noise.Lacunarity;
+        constants.Persistence = noise.Persistence;
+        constants.Normalization = normalization > 0.0f ? normalization : 1.0f;
+        constants.MinHeight = settings.MinHeight;
+        constants.MaxHeight = settings.MaxHeight;
+        constants.TerraceCount = static_cast<uint32_t>(std::max(settings.TerraceCount, 0));
+
+        ID3D12DescriptorHeap* heaps[] = { m_Core->GetCBVSRVUAVHeap().GetHeap() };
+
+        cmdList.TransitionBarrier(target.GetResource(),
+            D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+
+        cmdList.SetDescriptorHeaps(1, heaps);
+        cmdList.SetComputeRootSignature(m_RootSignature.GetNative());
+        cmdList.SetPipelineState(m_PipelineState.GetNative());
+        cmdList.SetComputeRoot32BitConstants(ROOT_CONSTANTS,
+            sizeof(GPUHeightmapConstants) / sizeof(uint32_t), &constants);
+        cmdList.SetComputeRootShaderResourceView(ROOT_PERMUTATION, permutation->GetGPUAddress());
+        cmdList.SetComputeRootDescriptorTable(ROOT_OUTPUT, target.GetUAV().GPU);
+
+        cmdList.Dispatch(
+            (constants.Width + THREAD_GROUP_SIZE - 1) / THREAD_GROUP_SIZE,
+            (constants.Height + THREAD_GROUP_SIZE - 1) / THREAD_GROUP_SIZE);
+
+        cmdList.TransitionBarrier(target.GetResource(),
+            D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COMMON);
+
+        return true;
+    }
+
+    bool GPUHeightmapGenerator::Generate(const HeightmapSettings& settings, const GPUHeightmapRegion& region,
+                                         SM::Texture& target, std::vector<float>* readback)
+    {
+        if (!m_Initialized)
+        {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(m_SubmitMutex);
+
+        float* heights = nullptr;
+        if (readback)
+        {
+            GPUHeightmapRegion resolved = ResolveRegion(settings, region);
+            readback->resize(static_cast<size_t>(std::max(resolved.Width, 0)) *
+                             static_cast<size_t>(std::max(resolved.Height, 0)));
+            heights = readback->data();
+        }
+
+        return SubmitAndWait(settings, region, target, heights);
+    }
+
+    bool GPUHeightmapGenerator::GenerateHeights(const HeightmapSettings& settings, const GPUHeightmapRegion& region,
+                                                float* heights)
+    {
+        if (!m_Initialized || !heights)
+        {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(m_SubmitMutex);
+
+        if (!m_ScratchTexture.IsValid())
+        {
+            std::cerr << "[GPUHeightmapGenerator] GenerateHeights called before ReserveScratchTexture" << std::endl;
+            return false;
+        }
+
+        return SubmitAndWait(settings, region, m_ScratchTexture, heights);
+    }
+
+    // ============================================================================
+    // Private Methods
+    // ============================================================================
+
+    SM::GPUBuffer* GPUHeightmapGenerator::GetPermutationBuffer(uint32_t seed)
+    {
+        auto it = m_PermutationBuffers.find(seed);
+        if (it != m_PermutationBuffers.end())
+        {
+            return it->second.get();
+        }
+
+        // Build the table exactly as PerlinNoise does for this seed
+        PerlinNoise noise(seed);
+        const std::array<int, 512>& table = noise.GetPermutation();
+
+        auto buffer = std::make_unique<SM::GPUBuffer>();
+        if (!buffer->Initialize(m_Core, sizeof(int) * table.size(), SM::GPUBufferUsage::Upload, table.data()))
+        {
+            std::cerr << "[GPUHeightmapGenerator] Failed to create permutation buffer!" << std::endl;
+            return nullptr;
+        }
+
+        SM::GPUBuffer* result = buffer.get();
+        m_PermutationBuffers[seed] = std::move(buffer);
+        return result;
+    }
+
+    bool GPUHeightmapGenerator::SubmitAndWait(const HeightmapSettings& settings, const GPUHeightmapRegion& region,
+                                              SM::Texture& target, float* heights)
+    {
+        GPUHeightmapRegion resolved = ResolveRegion(settings, region);
+        SM::ComputeQueue& compute = m_Core->GetComputeSubmitter();
+
+        if (!compute.Begin(m_CommandList))
+        {
+            return false;
+        }
+
+        // A failed recording is still submitted so its allocator returns to the ring
+        if (!Dispatch(m_CommandList, settings, resolved, target))
+        {
+            compute.Submit(m_CommandList);
+            return false;
+        }
+
+        D3D12_PLACED_SUBRESOURCE_FOOTPRINT footprint = {};
+        if (heights)
+        {
+            D3D12_RESOURCE_DESC textureDesc = target.GetResource()->GetDesc();
+            textureDesc.Width = static_cast<UINT64>(resolved.Width);
+            textureDesc.Height = static_cast<UINT>(resolved.Height);
+
+            UINT64 totalBytes = 0;
+            m_Core->GetDevice()->GetCopyableFootprints(&textureDesc, 0, 1, 0, &footprint, nullptr, nullptr, &totalBytes);
+
+            if (!m_ReadbackBuffer || m_ReadbackBuffer->GetSize() < totalBytes)
+            {
+                m_ReadbackBuffer = std::make_unique<SM::GPUBuffer>();
+                if (!m_ReadbackBuffer->Initialize(m_Core, static_cast<size_t>(totalBytes), SM::GPUBufferUsage::Readback))
+                {
+                    std::cerr << "[GPUHeightmapGenerator] Failed to create readback buffer!" << std::endl;
+                    m_ReadbackBuffer.reset();
+                    compute.Submit(m_CommandList);
+                    return false;
+                }
+            }
+
+            D3D12_TEXTURE_COPY_LOCATION dst = {};
+            dst.pResource = m_ReadbackBuffer->GetResource();
+            dst.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+            dst.PlacedFootprint = footprint;
+
+            D3D12_TEXTURE_COPY_LOCATION src = {};
+            src.pResource = target.GetResource();
+            src.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+            src.SubresourceIndex = 0;
+
+            D3D12_BOX srcBox = { 0, 0, 0, static_cast<UINT>(resolved.Width), static_cast<UINT>(resolved.Height), 1 };
+
+            m_CommandList.TransitionBarrier(target.GetResource(),
+                D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_STATE_COPY_SOURCE);
+            m_CommandList.FlushBarriers();
+            m_CommandList.CopyTextureRegion(&dst, 0, 0, 0, &src, &srcBox);
+            m_CommandList.TransitionBarrier(target.GetResource(),
+                D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_COMMON);
+        }
+
+        // Overlaps the frames queued on the direct queue; only this thread waits
+        m_FenceValue = compute.Submit(m_CommandList);
+        if (m_FenceValue == 0)
+        {
+            return false;
+        }
+
+        WaitForCompletion();
+
+        if (heights)
+        {
+            const uint8_t* mapped = static_cast<const uint8_t*>(m_ReadbackBuffer->Map());
+            if (!mapped)
+            {
+                return false;
+            }
+
+            // Rows are padded to D3D12_TEXTURE_DATA_PITCH_ALIGNMENT
+            const size_t rowBytes = sizeof(float) * static_cast<size_t>(resolved.Width);
+            for (int y = 0; y < resolved.Height; ++y)
+            {
+                std::memcpy(heights + static_cast<size_t>(y) * resolved.Width,
+                            mapped + footprint.Offset + static_cast<size_t>(y) * footprint.Footprint.RowPitch,
+                            rowBytes);
+            }
+
+            m_ReadbackBuffer->Unmap();
+        }
+
+        return true;
+    }
+
+    void GPUHeightmapGenerator::WaitForCompletion()
+    {
+        if (m_Core)
+        {
+            m_Core->GetComputeSubmitter().WaitForFence(m_FenceValue);
+        }
+    }
+
+    GPUHeightmapRegion GPUHeightmapGenerator::ResolveRegion(const HeightmapSettings& settings,
+                                                            const GPUHeightmapRegion& region)
+    {
+        GPUHeightmapRegion resolved = region;
+        if (resolved.Width <= 0) resolved.Width = settings.Width;
+        if (resolved.Height <= 0) resolved.Height = settings.Height;
+        return resolved;
+    }
+
+} // namespace PCG
@@ -0,0 +1,202 @@
+#pragma once
+
+/**
+ * @file GPUHeightmapGenerator.h
+ * @brief Compute-shader heightmap generation for terrain chunks
+ *
+ * Evaluates the FBM, domain warp, falloff and terracing steps described by
+ * HeightmapSettings in shaders/HeightmapCompute.hlsl and writes the result
+ * to an R32_FLOAT texture. Heights can be read back to the CPU so chunk
+ * height queries and collision keep working.
+ */
+
+#include "renderer/DX12Core.h"
+#include "renderer/CommandList.h"
+#include "renderer/RootSignature.h"
+#include "renderer/PipelineState.h"
+#include "renderer/GPUBuffer.h"
+#include "renderer/Texture.h"
+#include "pcg/HeightmapGenerator.h"
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace PCG
+{
+    /**
+     * @brief Area of noise space covered by one heightmap dispatch
+     *
+     * Texel (x, y) samples the noise at (OriginX + x * Step, OriginY + y * Step),
+     * the same convention as INoise::SampleGrid.
+     */
+    struct GPUHeightmapRegion
+    {
+        float OriginX = 0.0f;   ///< Sample-space X of texel (0, 0)
+        float OriginY = 0.0f;   ///< Sample-space Y of texel (0, 0)
+        float Step = 1.0f;      ///< Sample-space distance between texels
+        int Width = 0;          ///< Texels per row (0 = settings.Width)
+        int Height = 0;         ///< Number of rows (0 = settings.Height)
+    };
+
+    /**
+     * @brief Root constants consumed by HeightmapCompute.hlsl (b0)
+     */
+    struct GPUHeightmapConstants
+    {
+        float OriginX;
+        float OriginY;
+        float Step;
+        float WarpStrength;
+        uint32_t Width;
+        uint32_t Height;
+        uint32_t Octaves;
+        uint32_t Flags;
+        float Frequency;
+        float Amplitude;
+        float Lacunarity;
+        float Persistence;
+        float Normalization;
+        float MinHeight;
+        float MaxHeight;
+        uint32_t TerraceCount;
+    };
+
+    /**
+     * @brief Generates terrain heightmaps with a compute shader
+     *
+     * Dispatch records into a caller's command list. Generate and
+     * GenerateHeights submit on the async compute queue and wait for
+     * completion; they are safe to call from chunk worker threads (calls are
+     * serialized). Frames keep running on the direct queue meanwhile.
+     */
+    class GPUHeightmapGenerator
+    {
+    public:
+        GPUHeightmapGenerator() = default;
+        ~GPUHeightmapGenerator();
+
+        // Prevent copying
+        GPUHeightmapGenerator(const GPUHeightmapGenerator&) = delete;
+        GPUHeightmapGenerator& operator=(const GPUHeightmapGenerator&) = delete;
+
+        // ====================================================================
+        // Initialization
+        // ====================================================================
+
+        /**
+         * @brief Compile the shader and create pipeline objects
+         * @param core DX12 core for device and queue access
+         * @return true if initialization succeeded
+         */
+        bool Initialize(SM::DX12Core* core);
+
+        /**
+         * @brief Wait for outstanding work and release all resources
+         */
+        void Shutdown();
+
+        /**
+         * @brief Check if generator is initialized
+         */
+        bool IsInitialized() const { return m_Initialized; }
+
+        /**
+         * @brief Create the scratch texture used by GenerateHeights
+         *
+         * Call from the render thread before generating from worker threads,
+         * since texture creation allocates shared descriptors.
+         */
+        bool ReserveScratchTexture(uint32_t width, uint32_t height);
+
+        /**
+         * @brief Create a heightmap texture the shader can write
+         * @param width Width in texels
+         * @param height Height in texels
+         * @param texture Output R32_FLOAT texture (SRV + UAV)
+         * @return true if successful
+         */
+        bool CreateHeightmapTexture(uint32_t width, uint32_t height, SM::Texture& texture) const;
+
+        // ====================================================================
+        // Generation
+        // ====================================================================
+
+        /**
+         * @brief Record a heightmap dispatch into a command list
+         * @param cmdList Recording command list (Direct or Compute)
+         * @param settings Generation parameters
+         * @param region Area of noise space to generate
+         * @param target Texture from CreateHeightmapTexture, in the COMMON state
+         * @return true if the dispatch was recorded
+         *
+         * The target is returned to the COMMON state after the dispatch.
+         */
+        bool Dispatch(SM::CommandList& cmdList, const HeightmapSettings& settings,
+                      const GPUHeightmapRegion& region, SM::Texture& target);
+
+        /**
+         * @brief Generate into a texture and wait for the GPU
+         * @param settings Generation parameters
+         * @param region Area of noise space to generate
+         * @param target Texture from CreateHeightmapTexture, in the COMMON state
+         * @param readback Optional output for the heights (row-major)
+         * @return true if successful
+         */
+        bool Generate(const HeightmapSettings& settings, const GPUHeightmapRegion& region,
+                      SM::Texture& target, std::vector<float>* readback = nullptr);
+
+        /**
+         * @brief Generate heights into CPU memory using the scratch texture
+         * @param settings Generation parameters
+         * @param region Area of noise space to generate
+         * @param heights Output array of region Width * Height floats (row-major)
+         * @return true if successful
+         */
+        bool GenerateHeights(const HeightmapSettings& settings, const GPUHeightmapRegion& region,
+                             float* heights);
+
+    private:
+        /**
+         * @brief Get (or create) the permutation table buffer for a seed
+         */
+        SM::GPUBuffer* GetPermutationBuffer(uint32_t seed);
+
+        /**
+         * @brief Record, submit and wait; optionally read the heights back
+         */
+        bool SubmitAndWait(const HeightmapSettings& settings, const GPUHeightmapRegion& region,
+                           SM::Texture& target, float* heights);
+
+        /**
+         * @brief Block until the compute queue has finished this generator's last submission
+         */
+        void WaitForCompletion();
+
+        static GPUHeightmapRegion ResolveRegion(const HeightmapSettings& settings,
+                                                const GPUHeightmapRegion& region);
+
+    private:
+        bool m_Initialized = false;
+        SM::DX12Core* m_Core = nullptr;
+
+        // Pipeline
+        SM::ShaderBytecode m_ComputeShader;
+        SM::RootSignature m_RootSignature;
+        SM::ComputePipelineState m_PipelineState;
+
+        // Standalone submission on the compute queue
+        SM::CommandList m_CommandList;
+        uint64_t m_FenceValue = 0;  ///< ComputeQueue value of the last submission
+        std::mutex m_SubmitMutex;
+
+        // Seed -> doubled permutation table (upload heap, 512 ints)
+        std::unordered_map<uint32_t, std::unique_ptr<SM::GPUBuffer>> m_PermutationBuffers;
+
+        // Scratch texture and readback staging for GenerateHeights
+        SM::Texture m_ScratchTexture;
+        std::unique_ptr<SM::GPUBuffer> m_ReadbackBuffer;
+    };
+
+} // namespace PCG
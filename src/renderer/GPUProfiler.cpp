@@ -0,0 +1,273 @@
+#include "renderer/GPUProfiler.h"
+#include "renderer/DX12Core.h"
+#include "renderer/CommandList.h"
+#include "core/Profiler.h"
+
+#include <iostream>
+
+namespace SM
+{
+    namespace
+    {
+        /// Frames between clock recalibrations (the two clocks drift slowly)
+        constexpr uint32_t CALIBRATION_INTERVAL = 300;
+    }
+
+    GPUProfiler::~GPUProfiler()
+    {
+        Shutdown();
+    }
+
+    // ============================================================================
+    // Initialization
+    // ============================================================================
+
+    bool GPUProfiler::Initialize(DX12Core* core)
+    {
+        if (!core)
+        {
+            std::cerr << "[GPUProfiler] Cannot initialize: DX12Core is null" << std::endl;
+            return false;
+        }
+
+        ID3D12Device* device = core->GetDevice();
+        const uint32_t slotCount = core->GetFramesInFlight();
+        const uint32_t queryCount = slotCount * MAX_ZONES_PER_FRAME * 2;
+
+        HRESULT hr = core->GetDirectQueue()->GetTimestampFrequency(&m_TimestampFrequency);
+        if (!CheckHResult(hr, "Failed to get timestamp frequency") || m_TimestampFrequency == 0)
+        {
+            return false;
+        }
+
+        D3D12_QUERY_HEAP_DESC heapDesc = {};
+        heapDesc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+        heapDesc.Count = queryCount;
+
+        hr = device->CreateQueryHeap(&heapDesc, IID_PPV_ARGS(&m_QueryHeap));
+        if (!CheckHResult(hr, "Failed to create timestamp query heap"))
+        {
+            return false;
+        }
+
+        D3D12_HEAP_PROPERTIES heapProps = {};
+        heapProps.Type = D3D12_HEAP_TYPE_READBACK;
+
+        D3D12_RESOURCE_DESC desc = {};
+        desc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+        desc.Width = static_cast<uint64_t>(queryCount) * sizeof(uint64_t);
+        desc.Height = 1;
+        desc.DepthOrArraySize = 1;
+        desc.MipLevels = 1;
+        desc.Format = DXGI_FORMAT_UNKNOWN;
+        desc.SampleDesc.Count = 1;
+        desc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+        hr = device->CreateCommittedResource(
+            &heapProps,
+            D3D12_HEAP_FLAG_NONE,
+            &desc,
+            D3D12_RESOURCE_STATE_COPY_DEST,
+            nullptr,
+            IID_PPV_ARGS(&m_ReadbackBuffer)
+        );
+        if (!CheckHResult(hr, "Failed to create timestamp readback buffer"))
+        {
+            m_QueryHeap.Reset();
+            return false;
+        }
+
+        m_Slots.assign(slotCount, FrameSlot());
+        for (FrameSlot& slot : m_Slots)
+        {
+            slot.Zones.reserve(MAX_ZONES_PER_FRAME);
+        }
+
+        m_Core = core;
+        Calibrate();
+        return true;
+    }
+
+    void GPUProfiler::Shutdown()
+    {
+        m_Slots.clear();
+        m_ReadbackBuffer.Reset();
+        m_QueryHeap.Reset();
+        m_Core = nullptr;
+    }
+
+    // ============================================================================
+    // Frame
+    // ============================================================================
+
+    void GPUProfiler::BeginFrame(uint32_t frameIndex)
+    {
+        if (!m_Core || frameIndex >= m_Slots.size())
+        {
+            return;
+        }
+
+        if (++m_FramesSinceCalibration >= CALIBRATION_INTERVAL)
+        {
+            Calibrate();
+        }
+
+        m_CurrentSlot = frameIndex;
+        FrameSlot& slot = m_Slots[m_CurrentSlot];
+
+        // The frame fence covers the resolve recorded when this slot was last used
+        if (slot.Resolved && !slot.Zones.empty())
+        {
+            const uint32_t first = GetQueryIndex(0, false);
+            const uint32_t count = static_cast<uint32_t>(slot.Zones.size()) * 2;
+
+            D3D12_RANGE readRange = { first * sizeof(uint64_t), (first + count) * sizeof(uint64_t) };
+            void* mapped = nullptr;
+
+            if (SUCCEEDED(m_ReadbackBuffer->Map(0, &readRange, &mapped)))
+            {
+                const uint64_t* timestamps = static_cast<const uint64_t*>(mapped) + first;
+                const double nanosecondsPerTick = 1e9 / static_cast<double>(m_TimestampFrequency);
+
+                std::vector<ProfileEvent> events;
+                events.reserve(slot.Zones.size());
+
+                for (size_t i = 0; i < slot.Zones.size(); ++i)
+                {
+                    uint64_t begin = timestamps[i * 2];
+                    uint64_t end = timestamps[i * 2 + 1];
+
+                    ProfileEvent event;
+                    event.Name = slot.Zones[i].Name;
+                    event.Start = m_CPUBase + static_cast<int64_t>(
+                        static_cast<double>(static_cast<int64_t>(begin - m_GPUBase)) * nanosecondsPerTick);
+                    event.End = event.Start + static_cast<int64_t>(
+                        static_cast<double>(end >= begin ? end - begin : 0) * nanosecondsPerTick);
+                    event.Thread = Profiler::GPU_THREAD;
+                    event.Depth = slot.Zones[i].Depth;
+                    events.push_back(event);
+                }
+
+                D3D12_RANGE writeRange = { 0, 0 };
+                m_ReadbackBuffer->Unmap(0, &writeRange);
+
+                Profiler::Get().AddGPUEvents(slot.FrameNumber, std::move(events));
+            }
+        }
+
+        slot.Zones.clear();
+        slot.Resolved = false;
+        slot.FrameNumber = Profiler::Get().GetFrameNumber();
+        m_Depth = 0;
+    }
+
+    void GPUProfiler::EndFrame(CommandList& list)
+    {
+        if (!m_Core || m_Slots.empty())
+        {
+            return;
+        }
+
+        FrameSlot& slot = m_Slots[m_CurrentSlot];
+        if (slot.Zones.empty())
+        {
+            return;
+        }
+
+        // Every query in the resolved range must have been written
+        for (uint32_t zone = 0; zone < slot.Zones.size(); ++zone)
+        {
+            if (!slot.Zones[zone].Ended)
+            {
+                EndZone(list, zone);
+            }
+        }
+
+        const uint32_t first = GetQueryIndex(0, false);
+        const uint32_t count = static_cast<uint32_t>(slot.Zones.size()) * 2;
+
+        list.GetNative()->ResolveQueryData(m_QueryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP,
+            first, count, m_ReadbackBuffer.Get(), static_cast<uint64_t>(first) * sizeof(uint64_t));
+        slot.Resolved = true;
+    }
+
+    // ============================================================================
+    // Zones
+    // ============================================================================
+
+    uint32_t GPUProfiler::BeginZone(CommandList& list, const char* name)
+    {
+        if (!m_Core || m_Slots.empty() || !Profiler::Get().IsEnabled())
+        {
+            return INVALID_ZONE;
+        }
+
+        FrameSlot& slot = m_Slots[m_CurrentSlot];
+        if (slot.Zones.size() >= MAX_ZONES_PER_FRAME)
+        {
+            return INVALID_ZONE;
+        }
+
+        const uint32_t zone = static_cast<uint32_t>(slot.Zones.size());
+
+        Zone entry;
+        entry.Name = Profiler::Get().InternName(name);
+        entry.Depth = m_Depth++;
+        slot.Zones.push_back(entry);
+
+        list.GetNative()->EndQuery(m_QueryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, GetQueryIndex(zone, false));
+        return zone;
+    }
+
+    void GPUProfiler::EndZone(CommandList& list, uint32_t zone)
+    {
+        if (!m_Core || m_Slots.empty() || zone == INVALID_ZONE)
+        {
+            return;
+        }
+
+        FrameSlot& slot = m_Slots[m_CurrentSlot];
+        if (zone >= slot.Zones.size() || slot.Zones[zone].Ended)
+        {
+            return;
+        }
+
+        slot.Zones[zone].Ended = true;
+        if (m_Depth > 0)
+        {
+            m_Depth--;
+        }
+
+        list.GetNative()->EndQuery(m_QueryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, GetQueryIndex(zone, true));
+    }
+
+    // ============================================================================
+    // Private Methods
+    // ============================================================================
+
+    void GPUProfiler::Calibrate()
+    {
+        uint64_t gpuTimestamp = 0;
+        uint64_t cpuTimestamp = 0;
+        if (FAILED(m_Core->GetDirectQueue()->GetClockCalibration(&gpuTimestamp, &cpuTimestamp)))
+        {
+            return;
+        }
+
+        // The calibration's CPU time is a QueryPerformanceCounter value; carry
+        // it over to Profiler::Now by measuring both clocks at once
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER counter;
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&counter);
+        const int64_t now = Profiler::Now();
+
+        const double elapsed = static_cast<double>(counter.QuadPart - static_cast<int64_t>(cpuTimestamp)) /
+                               static_cast<double>(frequency.QuadPart);
+
+        m_GPUBase = gpuTimestamp;
+        m_CPUBase = now - static_cast<int64_t>(elapsed * 1e9);
+        m_FramesSinceCalibration = 0;
+    }
+
+} // namespace SM
@@ -0,0 +1,138 @@
+#pragma once
+
+/**
+ * @file GPUProfiler.h
+ * @brief GPU pass timing with timestamp queries
+ *
+ * Zones write a timestamp query at their start and end on the direct queue.
+ * At the end of the frame the frame's queries are resolved into a readback
+ * buffer; when DX12Core::BeginFrame has waited on that frame's fence again
+ * (FramesInFlight frames later) the results are converted to the CPU
+ * profiler's clock and attached to the frame they were recorded in, see
+ * Profiler::AddGPUEvents.
+ */
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <Windows.h>
+#include <d3d12.h>
+#include <wrl/client.h>
+#include <cstdint>
+#include <vector>
+
+namespace SM
+{
+    using Microsoft::WRL::ComPtr;
+
+    class DX12Core;
+    class CommandList;
+
+    /**
+     * @brief Timestamp query ring for the direct queue
+     *
+     * Zones are recorded through CommandList::BeginProfileZone and
+     * EndProfileZone. Not thread-safe; record zones on the render thread.
+     */
+    class GPUProfiler
+    {
+    public:
+        static constexpr uint32_t MAX_ZONES_PER_FRAME = 256;
+        static constexpr uint32_t INVALID_ZONE = ~0u;
+
+        GPUProfiler() = default;
+        ~GPUProfiler();
+
+        // Prevent copying
+        GPUProfiler(const GPUProfiler&) = delete;
+        GPUProfiler& operator=(const GPUProfiler&) = delete;
+
+        /**
+         * @brief Create the query heap and readback buffer
+         * @param core DX12 core (direct queue and frames in flight)
+         * @return true if successful
+         */
+        bool Initialize(DX12Core* core);
+        void Shutdown();
+
+        bool IsInitialized() const { return m_Core != nullptr; }
+
+        // ====================================================================
+        // Frame
+        // ====================================================================
+
+        /**
+         * @brief Publish the results of this frame slot's last use and start recording
+         * @param frameIndex DX12Core frame index, whose fence has been waited on
+         */
+        void BeginFrame(uint32_t frameIndex);
+
+        /**
+         * @brief Resolve the frame's queries into the readback buffer
+         * @param list Last direct list of the frame
+         *
+         * Zones still open are closed first.
+         */
+        void EndFrame(CommandList& list);
+
+        // ====================================================================
+        // Zones
+        // ====================================================================
+
+        /**
+         * @brief Write a start timestamp
+         * @param name Zone name; copied through Profiler::InternName
+         * @return Zone for EndZone, or INVALID_ZONE when the frame is full or profiling is off
+         */
+        uint32_t BeginZone(CommandList& list, const char* name);
+
+        /**
+         * @brief Write a zone's end timestamp
+         * @param list Any direct list of the frame submitted after the one BeginZone used
+         */
+        void EndZone(CommandList& list, uint32_t zone);
+
+    private:
+        struct Zone
+        {
+            const char* Name = nullptr;
+            uint32_t Depth = 0;
+            bool Ended = false;
+        };
+
+        struct FrameSlot
+        {
+            std::vector<Zone> Zones;
+            uint64_t FrameNumber = 0;   ///< Profiler frame the zones were recorded in
+            bool Resolved = false;
+        };
+
+        /**
+         * @brief Map the queue's timestamp clock onto Profiler::Now
+         */
+        void Calibrate();
+
+        uint32_t GetQueryIndex(uint32_t zone, bool end) const
+        {
+            return (m_CurrentSlot * MAX_ZONES_PER_FRAME + zone) * 2 + (end ? 1 : 0);
+        }
+
+    private:
+        DX12Core* m_Core = nullptr;
+
+        ComPtr<ID3D12QueryHeap> m_QueryHeap;
+        ComPtr<ID3D12Resource> m_ReadbackBuffer;    ///< One uint64 per query
+
+        std::vector<FrameSlot> m_Slots;             ///< One per frame in flight
+        uint32_t m_CurrentSlot = 0;
+        uint32_t m_Depth = 0;                       ///< Open zones this frame
+
+        // Clock mapping: cpu = CPUBase + (gpu - GPUBase) / frequency
+        uint64_t m_TimestampFrequency = 0;
+        uint64_t m_GPUBase = 0;
+        int64_t m_CPUBase = 0;
+        uint32_t m_FramesSinceCalibration = 0;
+    };
+
+} // namespace SM
@@ -0,0 +1,336 @@
+#include "renderer/HiZPyramid.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace SM
+{
+    namespace
+    {
+        /// Must match [numthreads] in HiZ.hlsl
+        constexpr uint32_t GROUP_SIZE = 8;
+
+        constexpr DXGI_FORMAT PYRAMID_FORMAT = DXGI_FORMAT_R32G32_FLOAT;
+
+        // Root parameter slots
+        constexpr uint32_t ROOT_CONSTANTS = 0;
+        constexpr uint32_t ROOT_DEPTH = 1;
+        constexpr uint32_t ROOT_SOURCE = 2;
+        constexpr uint32_t ROOT_DEST = 3;
+
+        D3D12_RESOURCE_BARRIER Transition(ID3D12Resource* resource, D3D12_RESOURCE_STATES before,
+                                          D3D12_RESOURCE_STATES after,
+                                          UINT subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES)
+        {
+            D3D12_RESOURCE_BARRIER barrier = {};
+            barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+            barrier.Transition.pResource = resource;
+            barrier.Transition.StateBefore = before;
+            barrier.Transition.StateAfter = after;
+            barrier.Transition.Subresource = subresource;
+            return barrier;
+        }
+
+        uint32_t NextPowerOfTwo(uint32_t value)
+        {
+            uint32_t result = 1;
+            while (result < value)
+            {
+                result <<= 1;
+            }
+            return result;
+        }
+    }
+
+    HiZPyramid::~HiZPyramid()
+    {
+        Shutdown();
+    }
+
+    // ============================================================================
+    // Initialization
+    // ============================================================================
+
+    bool HiZPyramid::Initialize(DX12Core* core)
+    {
+        if (m_Initialized)
+        {
+            return true;
+        }
+
+        if (!core)
+        {
+            std::cerr << "[HiZPyramid] Cannot initialize: DX12Core is null" << std::endl;
+            return false;
+        }
+
+        m_Core = core;
+
+        if (!m_Core->GetDepthSRV().IsValid())
+        {
+            std::cerr << "[HiZPyramid] Depth buffer has no shader-readable view!" << std::endl;
+            return false;
+        }
+
+        if (!CompileShaderFromFile(L"shaders/HiZ.hlsl", "DownsampleDepthCS", "cs_5_1", m_DownsampleDepthShader) ||
+            !CompileShaderFromFile(L"shaders/HiZ.hlsl", "DownsampleHiZCS", "cs_5_1", m_DownsampleHiZShader))
+        {
+            std::cerr << "[HiZPyramid] Failed to compile Hi-Z shaders!" << std::endl;
+            return false;
+        }
+
+        // Root signature:
+        // 0: Constants - Source/destination sizes (b0)
+        // 1: Table - Depth buffer SRV (t0)
+        // 2: Table - Source level SRV (t1)
+        // 3: Table - Destination level UAV (u0)
+        DescriptorRange depthRange;
+        depthRange.Type = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
+        depthRange.NumDescriptors = 1;
+        depthRange.BaseShaderRegister = 0;
+
+        DescriptorRange sourceRange;
+        sourceRange.Type = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
+        sourceRange.NumDescriptors = 1;
+        sourceRange.BaseShaderRegister = 1;
+
+        DescriptorRange destRange;
+        destRange.Type = D3D12_DESCRIPTOR_RANGE_TYPE_UAV;
+        destRange.NumDescriptors = 1;
+        destRange.BaseShaderRegister = 0;
+
+        bool built = m_RootSignature
+            .Begin(RootSignatureFlags::None)
+            .AddConstants(4, 0)
+            .AddDescriptorTable({ depthRange })
+            .AddDescriptorTable({ sourceRange })
+            .AddDescriptorTable({ destRange })
+            .Build(m_Core);
+
+        if (!built)
+        {
+            std::cerr << "[HiZPyramid] Failed to create root signature!" << std::endl;
+            return false;
+        }
+
+        built = m_DownsampleDepthPSO.Begin().SetRootSignature(m_RootSignature).SetComputeShader(m_DownsampleDepthShader).Build(m_Core)
+             && m_DownsampleHiZPSO.Begin().SetRootSignature(m_RootSignature).SetComputeShader(m_DownsampleHiZShader).Build(m_Core);
+
+        if (!built)
+        {
+            std::cerr << "[HiZPyramid] Failed to create pipeline states!" << std::endl;
+            return false;
+        }
+
+        // Consumers bind the SRV unconditionally, so keep a null view for before the first build
+        m_NullSRV = m_Core->GetCBVSRVUAVHeap().Allocate();
+        if (!m_NullSRV.IsValid())
+        {
+            std::cerr << "[HiZPyramid] Failed to allocate null SRV!" << std::endl;
+            return false;
+        }
+
+        D3D12_SHADER_RESOURCE_VIEW_DESC nullDesc = {};
+        nullDesc.Format = PYRAMID_FORMAT;
+        nullDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+        nullDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+        nullDesc.Texture2D.MipLevels = 1;
+        m_Core->GetDevice()->CreateShaderResourceView(nullptr, &nullDesc, m_NullSRV.CPU);
+
+        m_Initialized = true;
+
+        std::cout << "[HiZPyramid] Initialized" << std::endl;
+        return true;
+    }
+
+    void HiZPyramid::Shutdown()
+    {
+        if (!m_Initialized)
+        {
+            return;
+        }
+
+        m_Texture = Texture();
+
+        DescriptorHeap& heap = m_Core->GetCBVSRVUAVHeap();
+        for (const DescriptorHandle& srv : m_MipSRVs)
+        {
+            heap.Free(srv);
+        }
+        for (const DescriptorHandle& uav : m_MipUAVs)
+        {
+            heap.Free(uav);
+        }
+        heap.Free(m_NullSRV);
+
+        m_MipSRVs.clear();
+        m_MipUAVs.clear();
+        m_NullSRV = DescriptorHandle();
+        m_MipCount = 0;
+        m_BufferWidth = 0;
+        m_BufferHeight = 0;
+        m_DepthWidth = 0;
+        m_DepthHeight = 0;
+        m_Valid = false;
+
+        m_Initialized = false;
+        m_Core = nullptr;
+    }
+
+    // ============================================================================
+    // Per-Frame
+    // ============================================================================
+
+    void HiZPyramid::Build(ID3D12GraphicsCommandList* cmdList, const DirectX::XMMATRIX& viewProjection,
+                           uint32_t renderWidth, uint32_t renderHeight)
+    {
+        if (!m_Initialized || !cmdList)
+        {
+            return;
+        }
+
+        if (!EnsureTexture(m_Core->GetWidth(), m_Core->GetHeight()))
+        {
+            m_Valid = false;
+            return;
+        }
+
+        ID3D12Resource* depth = m_Core->GetDepthBuffer();
+        ID3D12Resource* pyramid = m_Texture.GetResource();
+
+        D3D12_RESOURCE_BARRIER barriers[2] = {
+            Transition(depth, D3D12_RESOURCE_STATE_DEPTH_WRITE, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE),
+            Transition(pyramid, m_State, D3D12_RESOURCE_STATE_UNORDERED_ACCESS)
+        };
+        cmdList->ResourceBarrier(2, barriers);
+
+        ID3D12DescriptorHeap* heaps[] = { m_Core->GetCBVSRVUAVHeap().GetHeap() };
+        cmdList->SetDescriptorHeaps(1, heaps);
+        cmdList->SetComputeRootSignature(m_RootSignature.GetNative());
+        cmdList->SetComputeRootDescriptorTable(ROOT_DEPTH, m_Core->GetDepthSRV().GPU);
+
+        // Mip 0 keeps its full size; texels past the viewport clamp to its edge
+        m_DepthWidth = (renderWidth > 0) ? std::min(renderWidth, m_BufferWidth) : m_BufferWidth;
+        m_DepthHeight = (renderHeight > 0) ? std::min(renderHeight, m_BufferHeight) : m_BufferHeight;
+
+        uint32_t sourceWidth = m_DepthWidth;
+        uint32_t sourceHeight = m_DepthHeight;
+
+        for (uint32_t mip = 0; mip < m_MipCount; ++mip)
+        {
+            uint32_t constants[4] = {
+                sourceWidth,
+                sourceHeight,
+                std::max(m_Texture.GetWidth() >> mip, 1u),
+                std::max(m_Texture.GetHeight() >> mip, 1u)
+            };
+
+            // Mip 0 reads the depth buffer; later mips read the level above, already readable
+            cmdList->SetPipelineState(mip == 0 ? m_DownsampleDepthPSO.GetNative() : m_DownsampleHiZPSO.GetNative());
+            cmdList->SetComputeRoot32BitConstants(ROOT_CONSTANTS, 4, constants, 0);
+            cmdList->SetComputeRootDescriptorTable(ROOT_SOURCE, m_MipSRVs[mip == 0 ? 0 : mip - 1].GPU);
+            cmdList->SetComputeRootDescriptorTable(ROOT_DEST, m_MipUAVs[mip].GPU);
+
+            cmdList->Dispatch(
+                (constants[2] + GROUP_SIZE - 1) / GROUP_SIZE,
+                (constants[3] + GROUP_SIZE - 1) / GROUP_SIZE,
+                1);
+
+            D3D12_RESOURCE_BARRIER finished = Transition(pyramid,
+                D3D12_RESOURCE_STATE_UNORDERED_ACCESS, READ_STATE, mip);
+            cmdList->ResourceBarrier(1, &finished);
+
+            sourceWidth = constants[2];
+            sourceHeight = constants[3];
+        }
+
+        barriers[0] = Transition(depth, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_DEPTH_WRITE);
+        cmdList->ResourceBarrier(1, barriers);
+        m_State = READ_STATE;
+
+        DirectX::XMStoreFloat4x4(&m_ViewProjection, viewProjection);
+        m_Valid = true;
+    }
+
+    void HiZPyramid::SetViewProjection(const DirectX::XMMATRIX& viewProjection)
+    {
+        DirectX::XMStoreFloat4x4(&m_ViewProjection, viewProjection);
+    }
+
+    // ============================================================================
+    // Private Methods
+    // ============================================================================
+
+    bool HiZPyramid::EnsureTexture(uint32_t depthWidth, uint32_t depthHeight)
+    {
+        if (m_Texture.IsValid() && m_BufferWidth == depthWidth && m_BufferHeight == depthHeight)
+        {
+            return true;
+        }
+
+        // The mip views below are rewritten in place, so frames in flight must
+        // be done with them; this follows a resize, which has already drained
+        // the queue, so the wait is short
+        if (m_Texture.IsValid())
+        {
+            m_Core->WaitForGPU();
+        }
+
+        // Power-of-two mips halve exactly, so texel (x, y) of mip k always covers
+        // depth pixels [x, x + 1] << (k + 1) and every mip stays in bounds
+        TextureDesc desc;
+        desc.Width = NextPowerOfTwo((depthWidth + 1) / 2);
+        desc.Height = NextPowerOfTwo((depthHeight + 1) / 2);
+        desc.Format = PYRAMID_FORMAT;
+        desc.Usage = TextureUsage::ShaderResource | TextureUsage::UnorderedAccess;
+
+        // Full chain down to 1x1
+        desc.MipLevels = 1;
+        for (uint32_t size = std::max(desc.Width, desc.Height); size > 1 && desc.MipLevels < MAX_MIPS; size /= 2)
+        {
+            desc.MipLevels++;
+        }
+
+        m_Texture = Texture();
+        m_MipCount = 0;
+        m_Valid = false;
+        if (!m_Texture.Create(m_Core, desc, "HiZPyramid"))
+        {
+            std::cerr << "[HiZPyramid] Failed to create Hi-Z texture!" << std::endl;
+            return false;
+        }
+
+        // One SRV and one UAV per level; descriptor slots are allocated once and rewritten on resize
+        DescriptorHeap& heap = m_Core->GetCBVSRVUAVHeap();
+        while (m_MipUAVs.size() < desc.MipLevels)
+        {
+            m_MipSRVs.push_back(heap.Allocate());
+            m_MipUAVs.push_back(heap.Allocate());
+        }
+
+        ID3D12Device* device = m_Core->GetDevice();
+        for (uint32_t mip = 0; mip < desc.MipLevels; ++mip)
+        {
+            D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+            srvDesc.Format = desc.Format;
+            srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+            srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+            srvDesc.Texture2D.MostDetailedMip = mip;
+            srvDesc.Texture2D.MipLevels = 1;
+            device->CreateShaderResourceView(m_Texture.GetResource(), &srvDesc, m_MipSRVs[mip].CPU);
+
+            D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+            uavDesc.Format = desc.Format;
+            uavDesc.ViewDimension = D3D12_UAV_DIMENSION_TEXTURE2D;
+            uavDesc.Texture2D.MipSlice = mip;
+            device->CreateUnorderedAccessView(m_Texture.GetResource(), nullptr, &uavDesc, m_MipUAVs[mip].CPU);
+        }
+
+        m_MipCount = desc.MipLevels;
+        m_BufferWidth = depthWidth;
+        m_BufferHeight = depthHeight;
+        m_State = D3D12_RESOURCE_STATE_COMMON;
+        return true;
+    }
+
+} // namespace SM
@@ -0,0 +1,142 @@
+#pragma once
+
+/**
+ * @file HiZPyramid.h
+ * @brief Min/max hierarchical depth pyramid built from the main depth buffer
+ *
+ * A compute pass (shaders/HiZ.hlsl) reduces DX12Core's depth buffer into a
+ * power-of-two R32G32 mip chain holding the nearest and farthest depth under
+ * every texel. The Renderer owns one pyramid and rebuilds it once per frame,
+ * after the depth pre-pass when one ran (current-frame occluders) or at the
+ * end of the scene pass otherwise (previous-frame occluders). Consumers
+ * re-project their bounds with GetViewProjection, so both cases test the same way.
+ */
+
+#include "renderer/DX12Core.h"
+#include "renderer/RootSignature.h"
+#include "renderer/PipelineState.h"
+#include "renderer/Texture.h"
+
+#include <DirectXMath.h>
+#include <vector>
+
+namespace SM
+{
+    /**
+     * @brief Hierarchical depth service for culling shaders and screen-space effects
+     *
+     * Texel (x, y) of mip k covers depth pixels [x, x + 1] << (k + 1). Between
+     * builds the texture stays readable by every shader stage, so consumers
+     * bind GetSRV without barriers.
+     */
+    class HiZPyramid
+    {
+    public:
+        /// Mip UAV slots kept for the pyramid (enough for a 65536 x 65536 depth buffer)
+        static constexpr uint32_t MAX_MIPS = 16;
+
+        /// Resource state the pyramid is left in after Build
+        static constexpr D3D12_RESOURCE_STATES READ_STATE =
+            D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+
+        HiZPyramid() = default;
+        ~HiZPyramid();
+
+        // Prevent copying
+        HiZPyramid(const HiZPyramid&) = delete;
+        HiZPyramid& operator=(const HiZPyramid&) = delete;
+
+        /**
+         * @brief Compile the shaders and create the pipelines
+         * @param core DX12 core; its depth buffer must have a shader-readable view
+         * @return true if successful
+         */
+        bool Initialize(DX12Core* core);
+
+        /**
+         * @brief Release the pyramid and its views
+         */
+        void Shutdown();
+
+        bool IsInitialized() const { return m_Initialized; }
+
+        /**
+         * @brief Rebuild the pyramid from the current depth buffer
+         * @param cmdList List with the depth buffer in DEPTH_WRITE; it is returned to DEPTH_WRITE
+         * @param viewProjection View-projection the depth was rendered with
+         * @param renderWidth Width of the viewport the depth was rendered at (0 = whole buffer)
+         * @param renderHeight Height of that viewport (0 = whole buffer)
+         *
+         * Only the top-left renderWidth x renderHeight pixels are reduced, so
+         * a dynamic-resolution viewport never reallocates the pyramid.
+         * (Re)creates the texture when the depth buffer was resized. Changes
+         * the pipeline state and compute root signature.
+         */
+        void Build(ID3D12GraphicsCommandList* cmdList, const DirectX::XMMATRIX& viewProjection,
+                   uint32_t renderWidth = 0, uint32_t renderHeight = 0);
+
+        /**
+         * @brief Mark the contents stale (e.g. after a camera cut)
+         */
+        void Invalidate() { m_Valid = false; }
+
+        /**
+         * @brief Replace the view-projection of the last build (late-latched cameras)
+         */
+        void SetViewProjection(const DirectX::XMMATRIX& viewProjection);
+
+        /**
+         * @brief Check if the pyramid holds a finished build
+         */
+        bool IsValid() const { return m_Valid; }
+
+        /**
+         * @brief Get the SRV of the whole chain (Texture2D<float2>: nearest, farthest)
+         *
+         * Always a valid descriptor; a null view before the first build.
+         */
+        const DescriptorHandle& GetSRV() const { return m_Texture.IsValid() ? m_Texture.GetSRV() : m_NullSRV; }
+
+        uint32_t GetMipCount() const { return m_MipCount; }
+
+        /// Depth viewport size the pyramid was built from (NDC maps onto [0, size))
+        uint32_t GetDepthWidth() const { return m_DepthWidth; }
+        uint32_t GetDepthHeight() const { return m_DepthHeight; }
+
+        /// View-projection of the last build
+        DirectX::XMMATRIX GetViewProjection() const { return DirectX::XMLoadFloat4x4(&m_ViewProjection); }
+
+    private:
+        /**
+         * @brief (Re)create the texture and per-mip views for a depth buffer size
+         */
+        bool EnsureTexture(uint32_t depthWidth, uint32_t depthHeight);
+
+    private:
+        bool m_Initialized = false;
+        DX12Core* m_Core = nullptr;
+
+        // Pipelines
+        ShaderBytecode m_DownsampleDepthShader;
+        ShaderBytecode m_DownsampleHiZShader;
+        RootSignature m_RootSignature;
+        ComputePipelineState m_DownsampleDepthPSO;
+        ComputePipelineState m_DownsampleHiZPSO;
+
+        // Pyramid (mip 0 is half the depth buffer size rounded up to a power of two)
+        Texture m_Texture;
+        std::vector<DescriptorHandle> m_MipSRVs;    ///< Source view of each level; reused across resizes
+        std::vector<DescriptorHandle> m_MipUAVs;    ///< Destination view of each level
+        DescriptorHandle m_NullSRV;
+        uint32_t m_MipCount = 0;
+        uint32_t m_BufferWidth = 0;                 ///< Depth buffer size the texture was sized for
+        uint32_t m_BufferHeight = 0;
+        uint32_t m_DepthWidth = 0;                  ///< Viewport of the last build
+        uint32_t m_DepthHeight = 0;
+        D3D12_RESOURCE_STATES m_State = D3D12_RESOURCE_STATE_COMMON;
+        bool m_Valid = false;
+
+        DirectX::XMFLOAT4X4 m_ViewProjection = {};
+    };
+
+} // namespace SM
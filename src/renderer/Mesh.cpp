@@ -1,6 +1,8 @@
 #include "renderer/Mesh.h"
+#include "renderer/MeshOptimizer.h"
 
 #include <cmath>
+#include <cstring>
 #include <unordered_map>
 
 namespace SM
@@ -16,43 +18,39 @@ namespace SM
             return;
         }
 
-        // Reset normals
-        for (auto& v : Vertices)
+        // Packed positions and accumulators stay in SIMD registers' layout, so
+        // the triangle loop does aligned loads and stores instead of the
+        // unaligned XMFLOAT3 round trips through the 48-byte vertices
+        const size_t vertexCount = Vertices.size();
+        std::vector<DirectX::XMVECTOR> positions(vertexCount);
+        std::vector<DirectX::XMVECTOR> normals(vertexCount, DirectX::XMVectorZero());
+        for (size_t i = 0; i < vertexCount; ++i)
         {
-            v.Normal = DirectX::XMFLOAT3(0, 0, 0);
+            positions[i] = DirectX::XMLoadFloat3(&Vertices[i].Position);
         }
 
-        // Calculate face normals and accumulate
-        for (size_t i = 0; i < Indices.size(); i += 3)
+        // Unnormalized cross products weight each face by its area
+        const size_t indexCount = Indices.size() - Indices.size() % 3;
+        for (size_t i = 0; i < indexCount; i += 3)
         {
-            uint32_t i0 = Indices[i];
-            uint32_t i1 = Indices[i + 1];
-            uint32_t i2 = Indices[i + 2];
-
-            DirectX::XMVECTOR v0 = DirectX::XMLoadFloat3(&Vertices[i0].Position);
-            DirectX::XMVECTOR v1 = DirectX::XMLoadFloat3(&Vertices[i1].Position);
-            DirectX::XMVECTOR v2 = DirectX::XMLoadFloat3(&Vertices[i2].Position);
-
-            DirectX::XMVECTOR e0 = DirectX::XMVectorSubtract(v1, v0);
-            DirectX::XMVECTOR e1 = DirectX::XMVectorSubtract(v2, v0);
-            DirectX::XMVECTOR normal = DirectX::XMVector3Cross(e0, e1);
-
-            // Accumulate to each vertex
-            DirectX::XMVECTOR n0 = DirectX::XMLoadFloat3(&Vertices[i0].Normal);
-            DirectX::XMVECTOR n1 = DirectX::XMLoadFloat3(&Vertices[i1].Normal);
-            DirectX::XMVECTOR n2 = DirectX::XMLoadFloat3(&Vertices[i2].Normal);
-
-            DirectX::XMStoreFloat3(&Vertices[i0].Normal, DirectX::XMVectorAdd(n0, normal));
-            DirectX::XMStoreFloat3(&Vertices[i1].Normal, DirectX::XMVectorAdd(n1, normal));
-            DirectX::XMStoreFloat3(&Vertices[i2].Normal, DirectX::XMVectorAdd(n2, normal));
+            const uint32_t i0 = Indices[i];
+            const uint32_t i1 = Indices[i + 1];
+            const uint32_t i2 = Indices[i + 2];
+
+            const DirectX::XMVECTOR v0 = positions[i0];
+            const DirectX::XMVECTOR normal = DirectX::XMVector3Cross(
+                DirectX::XMVectorSubtract(positions[i1], v0),
+                DirectX::XMVectorSubtract(positions[i2], v0));
+
+            normals[i0] = DirectX::XMVectorAdd(normals[i0], normal);
+            normals[i1] = DirectX::XMVectorAdd(normals[i1], normal);
+            normals[i2] = DirectX::XMVectorAdd(normals[i2], normal);
         }
 
         // Normalize
-        for (auto& v : Vertices)
+        for (size_t i = 0; i < vertexCount; ++i)
         {
-            DirectX::XMVECTOR n = DirectX::XMLoadFloat3(&v.Normal);
-            n = DirectX::XMVector3Normalize(n);
-            DirectX::XMStoreFloat3(&v.Normal, n);
+            DirectX::XMStoreFloat3(&Vertices[i].Normal, DirectX::XMVector3Normalize(normals[i]));
         }
     }
 
@@ -72,31 +70,184 @@ namespace SM
             return false;
         }
 
-        // Create vertex buffer
-        if (!m_VertexBuffer.Initialize(
+        return Create(
             core,
+            data.Vertices.data(),
             data.GetVertexCount(),
             sizeof(Vertex),
-            GPUBufferUsage::Upload,
-            data.Vertices.data()))
+            data.Indices.empty() ? nullptr : data.Indices.data(),
+            data.GetIndexCount());
+    }
+
+    bool Mesh::Create(DX12Core* core, const void* vertices, uint32_t vertexCount, uint32_t vertexStride,
+                      const uint32_t* indices, uint32_t indexCount)
+    {
+        if (!vertices)
+        {
+            return false;
+        }
+
+        const size_t vertexBytes = static_cast<size_t>(vertexCount) * vertexStride;
+        return Create(core, vertexCount, vertexStride,
+            [vertices, vertexBytes](void* destination) { std::memcpy(destination, vertices, vertexBytes); },
+            indices, indexCount);
+    }
+
+    bool Mesh::Create(DX12Core* core, uint32_t vertexCount, uint32_t vertexStride,
+                      const std::function<void(void*)>& writeVertices,
+                      const uint32_t* indices, uint32_t indexCount)
+    {
+        if (!writeVertices || vertexCount == 0 || vertexStride == 0)
+        {
+            return false;
+        }
+
+        // Stage through the copy queue into pooled DEFAULT-heap ranges when available
+        UploadQueue& uploads = core->GetUploadQueue();
+        const bool useCopyQueue = uploads.IsInitialized();
+        const GPUBufferUsage usage = useCopyQueue ? GPUBufferUsage::Pooled : GPUBufferUsage::Upload;
+
+        m_UploadQueue = useCopyQueue ? &uploads : nullptr;
+        m_UploadFence = 0;
+
+        // Create vertex buffer
+        if (!m_VertexBuffer.Initialize(core, vertexCount, vertexStride, usage))
         {
             return false;
         }
 
-        // Create index buffer (if indices exist)
-        if (!data.Indices.empty())
+        const size_t vertexBytes = static_cast<size_t>(vertexCount) * vertexStride;
+        if (useCopyQueue)
         {
+            m_UploadFence = uploads.UploadBuffer(
+                m_VertexBuffer.GetResource(), m_VertexBuffer.GetOffset(), vertexBytes, writeVertices);
+
+            if (m_UploadFence == 0)
+            {
+                return false;
+            }
+        }
+        else
+        {
+            // Upload-heap buffers are CPU-visible, so fill the buffer itself
+            void* mapped = m_VertexBuffer.Map();
+            if (!mapped)
+            {
+                return false;
+            }
+
+            writeVertices(mapped);
+            m_VertexBuffer.Unmap();
+        }
+
+        // Create index buffer (if indices exist), halved to 16 bits when the vertices allow
+        if (indices && indexCount > 0)
+        {
+            const bool use32Bit = !MeshOptimizer::CanUse16BitIndices(vertexCount);
+            std::vector<uint16_t> narrowIndices;
+            if (!use32Bit)
+            {
+                MeshOptimizer::ConvertTo16BitIndices(indices, indexCount, narrowIndices);
+            }
+
+            const void* indexData = use32Bit ? static_cast<const void*>(indices) : narrowIndices.data();
+            const size_t indexBytes = static_cast<size_t>(indexCount) * (use32Bit ? sizeof(uint32_t) : sizeof(uint16_t));
+
             if (!m_IndexBuffer.Initialize(
                 core,
-                data.GetIndexCount(),
-                true,  // 32-bit indices
-                GPUBufferUsage::Upload,
-                data.Indices.data()))
+                indexCount,
+                use32Bit,
+                usage,
+                useCopyQueue ? nullptr : indexData))
             {
                 return false;
             }
+
+            if (useCopyQueue)
+            {
+                // Fence values only grow, so this one also covers the vertices
+                m_UploadFence = uploads.UploadBuffer(
+                    m_IndexBuffer.GetResource(), m_IndexBuffer.GetOffset(), indexData, indexBytes);
+
+                if (m_UploadFence == 0)
+                {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    bool Mesh::Create(DX12Core* core, uint32_t vertexCount, uint32_t vertexStride,
+                      const std::function<void(void*)>& writeVertices,
+                      uint32_t indexCount, bool use32BitIndices,
+                      const std::function<void(void*)>& writeIndices)
+    {
+        if (!Create(core, vertexCount, vertexStride, writeVertices))
+        {
+            return false;
+        }
+
+        if (!writeIndices || indexCount == 0)
+        {
+            return true;
+        }
+
+        const bool useCopyQueue = m_UploadQueue != nullptr;
+        if (!m_IndexBuffer.Initialize(
+            core,
+            indexCount,
+            use32BitIndices,
+            useCopyQueue ? GPUBufferUsage::Pooled : GPUBufferUsage::Upload))
+        {
+            return false;
+        }
+
+        const size_t indexBytes = static_cast<size_t>(indexCount) * (use32BitIndices ? sizeof(uint32_t) : sizeof(uint16_t));
+        if (useCopyQueue)
+        {
+            m_UploadFence = m_UploadQueue->UploadBuffer(
+                m_IndexBuffer.GetResource(), m_IndexBuffer.GetOffset(), indexBytes, writeIndices);
+            return m_UploadFence != 0;
+        }
+
+        void* mapped = m_IndexBuffer.Map();
+        if (!mapped)
+        {
+            return false;
+        }
+
+        writeIndices(mapped);
+        m_IndexBuffer.Unmap();
+        return true;
+    }
+
+    bool Mesh::UpdateVertices(DX12Core* core, uint32_t firstVertex, uint32_t vertexCount,
+                              const std::function<void(void*)>& writeVertices)
+    {
+        // Upload-heap buffers may still be read by frames in flight, so they are not patched
+        if (!core || !m_UploadQueue || !writeVertices || vertexCount == 0 ||
+            firstVertex > GetVertexCount() || vertexCount > GetVertexCount() - firstVertex)
+        {
+            return false;
+        }
+
+        m_UploadQueue->WaitForQueue(core->GetFence(), core->GetLastSignaledFenceValue());
+
+        const uint64_t stride = m_VertexBuffer.GetView().StrideInBytes;
+        const uint64_t fence = m_UploadQueue->UploadBuffer(
+            m_VertexBuffer.GetResource(),
+            m_VertexBuffer.GetOffset() + firstVertex * stride,
+            static_cast<size_t>(vertexCount * stride),
+            writeVertices);
+
+        if (fence == 0)
+        {
+            return false;
         }
 
+        m_UploadFence = fence;
         return true;
     }
 
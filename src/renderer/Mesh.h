@@ -13,6 +13,7 @@
 
 #include <vector>
 #include <cstdint>
+#include <functional>
 #include <DirectXMath.h>
 
 namespace SM
@@ -110,6 +111,9 @@ namespace SM
 
         /**
          * @brief Calculate normals (for meshes without normals)
+         *
+         * Area-weighted face normals are accumulated in SIMD registers over
+         * a packed position copy, then normalized per vertex.
          */
         void CalculateNormals();
 
@@ -122,7 +126,9 @@ namespace SM
     /**
      * @brief GPU Mesh resource
      *
-     * Contains vertex and index buffers on the GPU.
+     * Contains vertex and index buffers on the GPU. Buffers live in the
+     * DEFAULT heap and are filled through the core's UploadQueue; the mesh
+     * may only be drawn once IsReady() reports the copy finished.
      */
     class Mesh
     {
@@ -143,14 +149,101 @@ namespace SM
          * @param core DX12 core reference
          * @param data Mesh data
          * @return true if successful
+         *
+         * Records copy-queue uploads without submitting them; they go out on
+         * the frame's UploadQueue::SubmitFrame. Falls back to upload-heap buffers if
+         * the core has no upload queue.
          */
         bool Create(DX12Core* core, const MeshData& data);
 
+        /**
+         * @brief Create mesh from raw vertex data in any layout
+         * @param core DX12 core reference
+         * @param vertices Vertex data (vertexCount * vertexStride bytes)
+         * @param vertexCount Number of vertices
+         * @param vertexStride Size of one vertex in bytes
+         * @param indices 32-bit indices (may be null; uploaded as 16-bit when vertexCount allows)
+         * @param indexCount Number of indices
+         * @return true if successful
+         *
+         * Uploads like Create(core, MeshData); the caller supplies a pipeline
+         * whose input layout matches the vertex format.
+         */
+        bool Create(DX12Core* core, const void* vertices, uint32_t vertexCount, uint32_t vertexStride,
+                    const uint32_t* indices = nullptr, uint32_t indexCount = 0);
+
+        /**
+         * @brief Create mesh with vertices generated straight into upload memory
+         * @param core DX12 core reference
+         * @param vertexCount Number of vertices
+         * @param vertexStride Size of one vertex in bytes
+         * @param writeVertices Called once with vertexCount * vertexStride bytes of
+         *                      write-combined memory to fill (write sequentially, never read)
+         * @param indices 32-bit indices (may be null; uploaded as 16-bit when vertexCount allows)
+         * @param indexCount Number of indices
+         * @return true if successful
+         *
+         * The vertices go into the upload queue's staging ring, or into the
+         * upload-heap buffer itself on the fallback path, without a CPU copy.
+         */
+        bool Create(DX12Core* core, uint32_t vertexCount, uint32_t vertexStride,
+                    const std::function<void(void*)>& writeVertices,
+                    const uint32_t* indices = nullptr, uint32_t indexCount = 0);
+
+        /**
+         * @brief Create mesh with both streams written straight into upload memory
+         * @param core DX12 core reference
+         * @param vertexCount Number of vertices
+         * @param vertexStride Size of one vertex in bytes
+         * @param writeVertices Fills vertexCount * vertexStride bytes (write-combined)
+         * @param indexCount Number of indices
+         * @param use32BitIndices Index width of the data writeIndices produces
+         * @param writeIndices Fills indexCount indices of that width (write-combined)
+         * @return true if successful
+         *
+         * For data already in GPU layout, such as a mapped cooked mesh: neither
+         * stream is copied or narrowed on the CPU.
+         */
+        bool Create(DX12Core* core, uint32_t vertexCount, uint32_t vertexStride,
+                    const std::function<void(void*)>& writeVertices,
+                    uint32_t indexCount, bool use32BitIndices,
+                    const std::function<void(void*)>& writeIndices);
+
+        /**
+         * @brief Overwrite a range of vertices in place through the copy queue
+         * @param core DX12 core reference
+         * @param firstVertex First vertex to replace
+         * @param vertexCount Number of vertices to replace
+         * @param writeVertices Fills vertexCount * stride bytes (write-combined)
+         * @return false if the range is out of bounds or the mesh was not
+         *         created through the copy queue (rebuild it instead)
+         *
+         * The copy waits for direct-queue work already submitted, so frames in
+         * flight keep drawing the old vertices. Later frames must not draw
+         * the mesh before the copy: make the direct queue wait on
+         * GetUploadFence() (UploadQueue::WaitOnQueue) first.
+         */
+        bool UpdateVertices(DX12Core* core, uint32_t firstVertex, uint32_t vertexCount,
+                            const std::function<void(void*)>& writeVertices);
+
         /**
          * @brief Check if mesh is valid
          */
         bool IsValid() const { return m_VertexBuffer.IsValid(); }
 
+        /**
+         * @brief Check if the mesh's buffers have finished uploading
+         */
+        bool IsReady() const
+        {
+            return IsValid() && (!m_UploadQueue || m_UploadQueue->IsComplete(m_UploadFence));
+        }
+
+        /**
+         * @brief Get the upload fence value (0 if no upload was needed)
+         */
+        uint64_t GetUploadFence() const { return m_UploadFence; }
+
         /**
          * @brief Get vertex buffer view
          */
@@ -185,6 +278,10 @@ namespace SM
     private:
         VertexBuffer m_VertexBuffer;
         IndexBuffer m_IndexBuffer;
+
+        // Copy-queue upload tracking
+        UploadQueue* m_UploadQueue = nullptr;
+        uint64_t m_UploadFence = 0;
     };
 
     // ============================================================================
@@ -0,0 +1,781 @@
+#include "renderer/MeshOptimizer.h"
+#include "renderer/Mesh.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace SM
+{
+    namespace MeshOptimizer
+    {
+        namespace
+        {
+            // Forsyth's scoring constants
+            constexpr float CACHE_DECAY_POWER = 1.5f;
+            constexpr float LAST_TRIANGLE_SCORE = 0.75f;
+            constexpr float VALENCE_BOOST_SCALE = 2.0f;
+            constexpr float VALENCE_BOOST_POWER = 0.5f;
+
+            constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+            /**
+             * @brief Score of a vertex from its cache position (-1 if not cached) and unemitted triangles
+             */
+            float VertexScore(int32_t cachePosition, uint32_t remainingTriangles)
+            {
+                if (remainingTriangles == 0)
+                {
+                    return -1.0f;
+                }
+
+                float score = 0.0f;
+                if (cachePosition >= 0)
+                {
+                    // The last triangle's vertices score alike, so strips do not zig-zag
+                    if (cachePosition < 3)
+                    {
+                        score = LAST_TRIANGLE_SCORE;
+                    }
+                    else
+                    {
+                        const float scale = 1.0f / static_cast<float>(VERTEX_CACHE_SIZE - 3);
+                        score = std::pow(1.0f - static_cast<float>(cachePosition - 3) * scale, CACHE_DECAY_POWER);
+                    }
+                }
+
+                // Vertices with few triangles left are finished first, leaving no stragglers
+                score += VALENCE_BOOST_SCALE * std::pow(static_cast<float>(remainingTriangles), -VALENCE_BOOST_POWER);
+                return score;
+            }
+
+            bool IndicesInRange(const uint32_t* indices, size_t indexCount, uint32_t vertexCount)
+            {
+                return std::all_of(indices, indices + indexCount,
+                    [vertexCount](uint32_t index) { return index < vertexCount; });
+            }
+
+            // Edge collapse passes before Simplify gives up on reaching its target
+            constexpr uint32_t MAX_SIMPLIFY_PASSES = 64;
+
+            // A level must keep at most this share of its predecessor's indices
+            constexpr float LOD_MIN_REDUCTION = 5.0f / 6.0f;
+
+            /**
+             * @brief Symmetric 4x4 error quadric, weighted by triangle area
+             */
+            struct Quadric
+            {
+                double A00 = 0.0, A01 = 0.0, A02 = 0.0, A03 = 0.0;
+                double A11 = 0.0, A12 = 0.0, A13 = 0.0;
+                double A22 = 0.0, A23 = 0.0;
+                double A33 = 0.0;
+                double Weight = 0.0;
+
+                void AddPlane(double a, double b, double c, double d, double weight)
+                {
+                    A00 += weight * a * a; A01 += weight * a * b; A02 += weight * a * c; A03 += weight * a * d;
+                    A11 += weight * b * b; A12 += weight * b * c; A13 += weight * b * d;
+                    A22 += weight * c * c; A23 += weight * c * d;
+                    A33 += weight * d * d;
+                    Weight += weight;
+                }
+
+                void Add(const Quadric& other)
+                {
+                    A00 += other.A00; A01 += other.A01; A02 += other.A02; A03 += other.A03;
+                    A11 += other.A11; A12 += other.A12; A13 += other.A13;
+                    A22 += other.A22; A23 += other.A23;
+                    A33 += other.A33;
+                    Weight += other.Weight;
+                }
+
+                /// Area-weighted mean squared distance of a point to the accumulated planes
+                double Evaluate(const double* p) const
+                {
+                    const double x = p[0], y = p[1], z = p[2];
+                    double error = A00 * x * x + A11 * y * y + A22 * z * z +
+                                   2.0 * (A01 * x * y + A02 * x * z + A12 * y * z + A03 * x + A13 * y + A23 * z) + A33;
+                    return Weight > 0.0 ? std::abs(error) / Weight : 0.0;
+                }
+            };
+
+            struct Collapse
+            {
+                uint32_t From;
+                uint32_t To;
+                double Error;
+            };
+
+            void Cross(const double* u, const double* v, double* out)
+            {
+                out[0] = u[1] * v[2] - u[2] * v[1];
+                out[1] = u[2] * v[0] - u[0] * v[2];
+                out[2] = u[0] * v[1] - u[1] * v[0];
+            }
+
+            void TriangleNormal(const double* a, const double* b, const double* c, double* out)
+            {
+                const double e0[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+                const double e1[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+                Cross(e0, e1, out);
+            }
+        }
+
+        // ============================================================================
+        // Index Width
+        // ============================================================================
+
+        void ConvertTo16BitIndices(const uint32_t* indices, size_t indexCount, std::vector<uint16_t>& outIndices)
+        {
+            outIndices.resize(indexCount);
+            for (size_t i = 0; i < indexCount; ++i)
+            {
+                outIndices[i] = static_cast<uint16_t>(indices[i]);
+            }
+        }
+
+        // ============================================================================
+        // Vertex Cache
+        // ============================================================================
+
+        void OptimizeVertexCache(uint32_t* indices, size_t indexCount, uint32_t vertexCount)
+        {
+            const size_t triangleCount = indexCount / 3;
+            if (!indices || triangleCount < 2 || vertexCount == 0 || !IndicesInRange(indices, indexCount, vertexCount))
+            {
+                return;
+            }
+
+            // Unemitted triangles of every vertex, packed per vertex (a degenerate
+            // triangle is listed once per corner it occupies)
+            std::vector<uint32_t> remaining(vertexCount, 0);
+            for (size_t i = 0; i < triangleCount * 3; ++i)
+            {
+                remaining[indices[i]]++;
+            }
+
+            std::vector<uint32_t> offsets(static_cast<size_t>(vertexCount) + 1, 0);
+            for (uint32_t v = 0; v < vertexCount; ++v)
+            {
+                offsets[v + 1] = offsets[v] + remaining[v];
+            }
+
+            std::vector<uint32_t> adjacency(triangleCount * 3);
+            std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+            for (size_t t = 0; t < triangleCount; ++t)
+            {
+                for (size_t k = 0; k < 3; ++k)
+                {
+                    adjacency[fill[indices[t * 3 + k]]++] = static_cast<uint32_t>(t);
+                }
+            }
+
+            std::vector<int32_t> cachePositions(vertexCount, -1);
+            std::vector<float> vertexScores(vertexCount);
+            for (uint32_t v = 0; v < vertexCount; ++v)
+            {
+                vertexScores[v] = VertexScore(-1, remaining[v]);
+            }
+
+            std::vector<float> triangleScores(triangleCount);
+            for (size_t t = 0; t < triangleCount; ++t)
+            {
+                triangleScores[t] = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] +
+                                    vertexScores[indices[t * 3 + 2]];
+            }
+
+            std::vector<uint8_t> emitted(triangleCount, 0);
+            std::vector<uint32_t> output;
+            output.reserve(triangleCount * 3);
+
+            // LRU cache, plus room for the three vertices pushed in by each triangle
+            std::array<uint32_t, VERTEX_CACHE_SIZE + 3> cache = {};
+            std::array<uint32_t, VERTEX_CACHE_SIZE + 3> nextCache = {};
+            size_t cacheCount = 0;
+
+            size_t scanCursor = 0;
+            size_t best = INVALID_INDEX;
+
+            for (size_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount)
+            {
+                if (best == INVALID_INDEX)
+                {
+                    // Nothing connected to the cache is left: continue from the first unused triangle
+                    while (emitted[scanCursor])
+                    {
+                        scanCursor++;
+                    }
+                    best = scanCursor;
+                }
+
+                const size_t triangle = best;
+                const uint32_t* corners = indices + triangle * 3;
+                emitted[triangle] = 1;
+
+                // Emit, retire the triangle from its vertices and put them at the front of the cache
+                size_t nextCount = 0;
+                for (size_t k = 0; k < 3; ++k)
+                {
+                    const uint32_t v = corners[k];
+                    output.push_back(v);
+
+                    uint32_t* list = adjacency.data() + offsets[v];
+                    for (uint32_t j = 0; j < remaining[v]; ++j)
+                    {
+                        if (list[j] == triangle)
+                        {
+                            list[j] = list[remaining[v] - 1];
+                            break;
+                        }
+                    }
+                    remaining[v]--;
+
+                    if (std::find(nextCache.begin(), nextCache.begin() + nextCount, v) == nextCache.begin() + nextCount)
+                    {
+                        nextCache[nextCount++] = v;
+                    }
+                }
+
+                const size_t triangleVertices = nextCount;
+                for (size_t i = 0; i < cacheCount; ++i)
+                {
+                    const uint32_t v = cache[i];
+                    if (std::find(nextCache.begin(), nextCache.begin() + triangleVertices, v) ==
+                        nextCache.begin() + triangleVertices)
+                    {
+                        nextCache[nextCount++] = v;
+                    }
+                }
+
+                // Rescore every vertex that moved, including those pushed out of the cache
+                for (size_t i = 0; i < nextCount; ++i)
+                {
+                    const uint32_t v = nextCache[i];
+                    const int32_t position = (i < VERTEX_CACHE_SIZE) ? static_cast<int32_t>(i) : -1;
+                    cachePositions[v] = position;
+
+                    const float score = VertexScore(position, remaining[v]);
+                    const float delta = score - vertexScores[v];
+                    vertexScores[v] = score;
+
+                    const uint32_t* list = adjacency.data() + offsets[v];
+                    for (uint32_t j = 0; j < remaining[v]; ++j)
+                    {
+                        triangleScores[list[j]] += delta;
+                    }
+                }
+
+                cacheCount = std::min<size_t>(nextCount, VERTEX_CACHE_SIZE);
+                std::copy(nextCache.begin(), nextCache.begin() + cacheCount, cache.begin());
+
+                // The next triangle is the best one touching the cache
+                best = INVALID_INDEX;
+                float bestScore = -std::numeric_limits<float>::max();
+                for (size_t i = 0; i < cacheCount; ++i)
+                {
+                    const uint32_t v = cache[i];
+                    const uint32_t* list = adjacency.data() + offsets[v];
+                    for (uint32_t j = 0; j < remaining[v]; ++j)
+                    {
+                        if (triangleScores[list[j]] > bestScore)
+                        {
+                            bestScore = triangleScores[list[j]];
+                            best = list[j];
+                        }
+                    }
+                }
+            }
+
+            std::memcpy(indices, output.data(), output.size() * sizeof(uint32_t));
+        }
+
+        // ============================================================================
+        // Vertex Fetch
+        // ============================================================================
+
+        uint32_t OptimizeVertexFetch(void* vertices, uint32_t vertexCount, uint32_t vertexStride,
+                                     uint32_t* indices, size_t indexCount)
+        {
+            if (!vertices || !indices || vertexCount == 0 || vertexStride == 0 ||
+                !IndicesInRange(indices, indexCount, vertexCount))
+            {
+                return vertexCount;
+            }
+
+            std::vector<uint32_t> remap(vertexCount, INVALID_INDEX);
+            uint32_t next = 0;
+            for (size_t i = 0; i < indexCount; ++i)
+            {
+                uint32_t& mapped = remap[indices[i]];
+                if (mapped == INVALID_INDEX)
+                {
+                    mapped = next++;
+                }
+                indices[i] = mapped;
+            }
+
+            // Unreferenced vertices keep their relative order behind the used ones
+            const uint32_t referenced = next;
+            for (uint32_t& mapped : remap)
+            {
+                if (mapped == INVALID_INDEX)
+                {
+                    mapped = next++;
+                }
+            }
+
+            const size_t vertexBytes = static_cast<size_t>(vertexCount) * vertexStride;
+            std::vector<uint8_t> reordered(vertexBytes);
+            const uint8_t* source = static_cast<const uint8_t*>(vertices);
+            for (uint32_t v = 0; v < vertexCount; ++v)
+            {
+                std::memcpy(reordered.data() + static_cast<size_t>(remap[v]) * vertexStride,
+                            source + static_cast<size_t>(v) * vertexStride, vertexStride);
+            }
+
+            std::memcpy(vertices, reordered.data(), vertexBytes);
+            return referenced;
+        }
+
+        void Optimize(MeshData& data)
+        {
+            if (data.Indices.empty())
+            {
+                return;
+            }
+
+            OptimizeVertexCache(data.Indices, data.GetVertexCount());
+            OptimizeVertexFetch(data.Vertices.data(), data.GetVertexCount(), sizeof(Vertex),
+                                data.Indices.data(), data.Indices.size());
+        }
+
+        // ============================================================================
+        // Simplification
+        // ============================================================================
+
+        float Simplify(const uint32_t* indices, size_t indexCount, const float* positions, uint32_t vertexCount,
+                       uint32_t positionStride, size_t targetIndexCount, float targetError,
+                       std::vector<uint32_t>& outIndices)
+        {
+            const size_t triangleCount = indexCount / 3;
+            outIndices.assign(indices, indices + triangleCount * 3);
+            if (!indices || !positions || vertexCount == 0 || positionStride < 3 * sizeof(float) ||
+                outIndices.size() <= targetIndexCount || !IndicesInRange(indices, triangleCount * 3, vertexCount))
+            {
+                return 0.0f;
+            }
+
+            // Positions in double precision; errors are measured against the largest extent
+            std::vector<double> points(static_cast<size_t>(vertexCount) * 3);
+            double boundsMin[3] = { std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+                                    std::numeric_limits<double>::max() };
+            double boundsMax[3] = { -boundsMin[0], -boundsMin[1], -boundsMin[2] };
+            const uint8_t* source = reinterpret_cast<const uint8_t*>(positions);
+            for (uint32_t v = 0; v < vertexCount; ++v)
+            {
+                float p[3];
+                std::memcpy(p, source + static_cast<size_t>(v) * positionStride, sizeof(p));
+                for (int k = 0; k < 3; ++k)
+                {
+                    points[v * 3 + k] = p[k];
+                    boundsMin[k] = std::min(boundsMin[k], static_cast<double>(p[k]));
+                    boundsMax[k] = std::max(boundsMax[k], static_cast<double>(p[k]));
+                }
+            }
+
+            const double extent = std::max({ boundsMax[0] - boundsMin[0], boundsMax[1] - boundsMin[1],
+                                             boundsMax[2] - boundsMin[2] });
+            if (extent <= 0.0)
+            {
+                return 0.0f;
+            }
+            const double errorLimit = static_cast<double>(targetError) * extent * static_cast<double>(targetError) * extent;
+
+            // Weld vertices by position: each gets the lowest ID sharing its position
+            std::vector<uint32_t> sorted(vertexCount);
+            for (uint32_t v = 0; v < vertexCount; ++v)
+            {
+                sorted[v] = v;
+            }
+            auto samePosition = [&points](uint32_t a, uint32_t b) {
+                return points[a * 3] == points[b * 3] && points[a * 3 + 1] == points[b * 3 + 1] &&
+                       points[a * 3 + 2] == points[b * 3 + 2];
+            };
+            std::sort(sorted.begin(), sorted.end(), [&points](uint32_t a, uint32_t b) {
+                return std::lexicographical_compare(&points[a * 3], &points[a * 3] + 3, &points[b * 3], &points[b * 3] + 3);
+            });
+
+            // Seams: a position owned by several vertices must not move, or its attributes tear apart
+            std::vector<uint32_t> welded(vertexCount);
+            std::vector<uint8_t> locked(vertexCount, 0);
+            for (size_t begin = 0; begin < sorted.size();)
+            {
+                size_t end = begin + 1;
+                while (end < sorted.size() && samePosition(sorted[begin], sorted[end]))
+                {
+                    end++;
+                }
+
+                const uint32_t canonical = *std::min_element(sorted.begin() + begin, sorted.begin() + end);
+                for (size_t i = begin; i < end; ++i)
+                {
+                    welded[sorted[i]] = canonical;
+                    locked[sorted[i]] = (end - begin > 1) ? 1 : 0;
+                }
+                begin = end;
+            }
+
+            // Borders: a welded edge without its reverse
+            std::vector<uint64_t> edges;
+            edges.reserve(triangleCount * 3);
+            for (size_t t = 0; t < triangleCount; ++t)
+            {
+                for (size_t k = 0; k < 3; ++k)
+                {
+                    const uint64_t a = welded[outIndices[t * 3 + k]];
+                    const uint64_t b = welded[outIndices[t * 3 + (k + 1) % 3]];
+                    edges.push_back((a << 32) | b);
+                }
+            }
+            std::sort(edges.begin(), edges.end());
+
+            for (size_t t = 0; t < triangleCount; ++t)
+            {
+                for (size_t k = 0; k < 3; ++k)
+                {
+                    const uint32_t a = outIndices[t * 3 + k];
+                    const uint32_t b = outIndices[t * 3 + (k + 1) % 3];
+                    const uint64_t reverse = (static_cast<uint64_t>(welded[b]) << 32) | welded[a];
+                    if (!std::binary_search(edges.begin(), edges.end(), reverse))
+                    {
+                        locked[a] = 1;
+                        locked[b] = 1;
+                    }
+                }
+            }
+
+            // Every vertex starts with the planes of the triangles around it
+            std::vector<Quadric> quadrics(vertexCount);
+            for (size_t t = 0; t < triangleCount; ++t)
+            {
+                const uint32_t* corners = outIndices.data() + t * 3;
+                double normal[3];
+                TriangleNormal(&points[corners[0] * 3], &points[corners[1] * 3], &points[corners[2] * 3], normal);
+                const double length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+                if (length <= 0.0)
+                {
+                    continue;
+                }
+
+                const double a = normal[0] / length, b = normal[1] / length, c = normal[2] / length;
+                const double* p = &points[corners[0] * 3];
+                const double d = -(a * p[0] + b * p[1] + c * p[2]);
+                for (size_t k = 0; k < 3; ++k)
+                {
+                    quadrics[corners[k]].AddPlane(a, b, c, d, length * 0.5);
+                }
+            }
+
+            std::vector<uint32_t> offsets(static_cast<size_t>(vertexCount) + 1);
+            std::vector<uint32_t> adjacency;
+            std::vector<Collapse> collapses;
+            std::vector<uint32_t> remap(vertexCount);
+            std::vector<uint8_t> touched(vertexCount);
+            double worstError = 0.0;
+
+            for (uint32_t pass = 0; pass < MAX_SIMPLIFY_PASSES && outIndices.size() > targetIndexCount; ++pass)
+            {
+                const size_t currentTriangles = outIndices.size() / 3;
+
+                // Triangles around every vertex
+                std::fill(offsets.begin(), offsets.end(), 0);
+                for (uint32_t index : outIndices)
+                {
+                    offsets[index + 1]++;
+                }
+                for (uint32_t v = 0; v < vertexCount; ++v)
+                {
+                    offsets[v + 1] += offsets[v];
+                }
+                adjacency.resize(outIndices.size());
+                std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+                for (size_t t = 0; t < currentTriangles; ++t)
+                {
+                    for (size_t k = 0; k < 3; ++k)
+                    {
+                        adjacency[fill[outIndices[t * 3 + k]]++] = static_cast<uint32_t>(t);
+                    }
+                }
+
+                // Both directions of every edge, cheapest first
+                collapses.clear();
+                for (size_t t = 0; t < currentTriangles; ++t)
+                {
+                    for (size_t k = 0; k < 3; ++k)
+                    {
+                        const uint32_t from = outIndices[t * 3 + k];
+                        const uint32_t to = outIndices[t * 3 + (k + 1) % 3];
+                        if (locked[from] || from == to)
+                        {
+                            continue;
+                        }
+
+                        Quadric merged = quadrics[from];
+                        merged.Add(quadrics[to]);
+                        collapses.push_back({ from, to, merged.Evaluate(&points[to * 3]) });
+                    }
+                }
+                std::sort(collapses.begin(), collapses.end(),
+                    [](const Collapse& a, const Collapse& b) { return a.Error < b.Error; });
+
+                // Collapse as many independent edges as the target allows
+                for (uint32_t v = 0; v < vertexCount; ++v)
+                {
+                    remap[v] = v;
+                }
+                std::fill(touched.begin(), touched.end(), 0);
+
+                size_t removedTriangles = 0;
+                const size_t surplusTriangles = currentTriangles - targetIndexCount / 3;
+                for (const Collapse& collapse : collapses)
+                {
+                    if (collapse.Error > errorLimit || removedTriangles >= surplusTriangles)
+                    {
+                        break;
+                    }
+                    if (touched[collapse.From] || touched[collapse.To])
+                    {
+                        continue;
+                    }
+
+                    // Reject collapses that turn a surviving triangle over
+                    bool flips = false;
+                    size_t removes = 0;
+                    for (uint32_t j = offsets[collapse.From]; j < offsets[collapse.From + 1] && !flips; ++j)
+                    {
+                        const uint32_t* corners = outIndices.data() + static_cast<size_t>(adjacency[j]) * 3;
+                        if (corners[0] == collapse.To || corners[1] == collapse.To || corners[2] == collapse.To)
+                        {
+                            removes++;
+                            continue;
+                        }
+
+                        const double* moved[3];
+                        for (size_t k = 0; k < 3; ++k)
+                        {
+                            moved[k] = &points[(corners[k] == collapse.From ? collapse.To : corners[k]) * 3];
+                        }
+
+                        double before[3], after[3];
+                        TriangleNormal(&points[corners[0] * 3], &points[corners[1] * 3], &points[corners[2] * 3], before);
+                        TriangleNormal(moved[0], moved[1], moved[2], after);
+                        flips = before[0] * after[0] + before[1] * after[1] + before[2] * after[2] <= 0.0;
+                    }
+                    if (flips)
+                    {
+                        continue;
+                    }
+
+                    // The triangles around From change shape, so none of their vertices move again this pass
+                    for (uint32_t j = offsets[collapse.From]; j < offsets[collapse.From + 1]; ++j)
+                    {
+                        const uint32_t* corners = outIndices.data() + static_cast<size_t>(adjacency[j]) * 3;
+                        touched[corners[0]] = touched[corners[1]] = touched[corners[2]] = 1;
+                    }
+
+                    remap[collapse.From] = collapse.To;
+                    quadrics[collapse.To].Add(quadrics[collapse.From]);
+                    worstError = std::max(worstError, collapse.Error);
+                    removedTriangles += removes;
+                }
+
+                if (removedTriangles == 0)
+                {
+                    break;
+                }
+
+                // Apply the pass and drop the triangles that collapsed to lines
+                size_t write = 0;
+                for (size_t t = 0; t < currentTriangles; ++t)
+                {
+                    const uint32_t a = remap[outIndices[t * 3]];
+                    const uint32_t b = remap[outIndices[t * 3 + 1]];
+                    const uint32_t c = remap[outIndices[t * 3 + 2]];
+                    if (a != b && b != c && a != c)
+                    {
+                        outIndices[write++] = a;
+                        outIndices[write++] = b;
+                        outIndices[write++] = c;
+                    }
+                }
+                outIndices.resize(write);
+            }
+
+            return static_cast<float>(std::sqrt(worstError) / extent);
+        }
+
+        void GenerateLODs(const MeshData& data, uint32_t maxLODs, std::vector<MeshData>& outLODs)
+        {
+            outLODs.clear();
+            if (data.Indices.empty() || data.Vertices.empty())
+            {
+                return;
+            }
+
+            std::vector<std::vector<uint32_t>> levels;
+            GenerateLODIndices(data.Indices, &data.Vertices[0].Position.x, data.GetVertexCount(), sizeof(Vertex),
+                               maxLODs, levels);
+
+            // Keep only the vertices each level still uses
+            for (std::vector<uint32_t>& indices : levels)
+            {
+                MeshData& level = outLODs.emplace_back();
+                level.Vertices = data.Vertices;
+                level.Indices = std::move(indices);
+                const uint32_t referenced = OptimizeVertexFetch(level.Vertices.data(), level.GetVertexCount(),
+                                                                sizeof(Vertex), level.Indices.data(), level.Indices.size());
+                level.Vertices.resize(referenced);
+            }
+        }
+
+        void GenerateLODIndices(const std::vector<uint32_t>& indices, const float* positions, uint32_t vertexCount,
+                                uint32_t positionStride, uint32_t maxLODs,
+                                std::vector<std::vector<uint32_t>>& outLevels, std::vector<float>* outErrors)
+        {
+            outLevels.clear();
+            if (outErrors)
+            {
+                outErrors->clear();
+            }
+
+            // Each level simplifies the previous one, so levels nest and later passes start smaller
+            const std::vector<uint32_t>* previous = &indices;
+            float targetError = LOD_BASE_ERROR;
+            for (uint32_t lod = 1; lod <= maxLODs; ++lod, targetError *= 2.0f)
+            {
+                const size_t targetIndexCount = (previous->size() / 6) * 3;
+                std::vector<uint32_t> simplified;
+                const float error = Simplify(previous->data(), previous->size(), positions, vertexCount,
+                                             positionStride, targetIndexCount, targetError, simplified);
+
+                if (simplified.empty() ||
+                    static_cast<float>(simplified.size()) > static_cast<float>(previous->size()) * LOD_MIN_REDUCTION)
+                {
+                    break;
+                }
+
+                OptimizeVertexCache(simplified, vertexCount);
+                outLevels.push_back(std::move(simplified));
+                if (outErrors)
+                {
+                    outErrors->push_back(error);
+                }
+                previous = &outLevels.back();
+            }
+        }
+
+        // ============================================================================
+        // Meshlets
+        // ============================================================================
+
+        size_t BuildMeshlets(const uint32_t* indices, size_t indexCount, uint32_t vertexCount,
+                             std::vector<Meshlet>& outMeshlets, std::vector<uint32_t>& outVertices,
+                             std::vector<uint32_t>& outTriangles)
+        {
+            const size_t triangleCount = indexCount / 3;
+            if (!indices || triangleCount == 0 || !IndicesInRange(indices, triangleCount * 3, vertexCount))
+            {
+                return 0;
+            }
+
+            // Local index of every vertex in the open meshlet, valid while its stamp matches
+            std::vector<uint8_t> localIndex(vertexCount, 0);
+            std::vector<uint32_t> stamp(vertexCount, 0);
+            uint32_t currentStamp = 1;
+
+            const size_t firstMeshlet = outMeshlets.size();
+            Meshlet meshlet;
+            meshlet.VertexOffset = static_cast<uint32_t>(outVertices.size());
+            meshlet.TriangleOffset = static_cast<uint32_t>(outTriangles.size());
+
+            for (size_t t = 0; t < triangleCount; ++t)
+            {
+                const uint32_t* corners = indices + t * 3;
+                uint32_t newVertices = 0;
+                for (size_t k = 0; k < 3; ++k)
+                {
+                    const bool repeated = (k > 0 && corners[k] == corners[0]) || (k > 1 && corners[k] == corners[1]);
+                    newVertices += (stamp[corners[k]] != currentStamp && !repeated) ? 1 : 0;
+                }
+
+                // Close the meshlet when this triangle no longer fits
+                if (meshlet.VertexCount + newVertices > MESHLET_MAX_VERTICES ||
+                    meshlet.TriangleCount == MESHLET_MAX_TRIANGLES)
+                {
+                    outMeshlets.push_back(meshlet);
+                    meshlet = Meshlet();
+                    meshlet.VertexOffset = static_cast<uint32_t>(outVertices.size());
+                    meshlet.TriangleOffset = static_cast<uint32_t>(outTriangles.size());
+                    currentStamp++;
+                }
+
+                uint32_t packed = 0;
+                for (size_t k = 0; k < 3; ++k)
+                {
+                    const uint32_t v = corners[k];
+                    if (stamp[v] != currentStamp)
+                    {
+                        stamp[v] = currentStamp;
+                        localIndex[v] = static_cast<uint8_t>(meshlet.VertexCount++);
+                        outVertices.push_back(v);
+                    }
+                    packed |= static_cast<uint32_t>(localIndex[v]) << (k * 8);
+                }
+
+                outTriangles.push_back(packed);
+                meshlet.TriangleCount++;
+            }
+
+            outMeshlets.push_back(meshlet);
+            return outMeshlets.size() - firstMeshlet;
+        }
+
+        // ============================================================================
+        // Analysis
+        // ============================================================================
+
+        float AnalyzeVertexCache(const uint32_t* indices, size_t indexCount, uint32_t vertexCount, uint32_t cacheSize)
+        {
+            const size_t triangleCount = indexCount / 3;
+            if (!indices || triangleCount == 0 || cacheSize == 0)
+            {
+                return 0.0f;
+            }
+
+            // FIFO: a vertex stays cached until cacheSize misses have happened since it entered
+            std::vector<uint64_t> insertedAt(vertexCount, 0);
+            uint64_t misses = 0;
+            for (size_t i = 0; i < triangleCount * 3; ++i)
+            {
+                const uint32_t v = indices[i];
+                if (v >= vertexCount)
+                {
+                    continue;
+                }
+
+                if (insertedAt[v] == 0 || misses - insertedAt[v] >= cacheSize)
+                {
+                    misses++;
+                    insertedAt[v] = misses;
+                }
+            }
+
+            return static_cast<float>(misses) / static_cast<float>(triangleCount);
+        }
+
+    } // namespace MeshOptimizer
+
+} // namespace SM
@@ -0,0 +1,170 @@
+#pragma once
+
+/**
+ * @file MeshOptimizer.h
+ * @brief CPU mesh processing before upload: vertex cache order, fetch order, index width and LODs
+ *
+ * Triangle lists are reordered for the post-transform vertex cache with Tom
+ * Forsyth's linear-speed algorithm, then vertices are renumbered in first-use
+ * order so vertex fetch walks memory forwards. Index buffers narrow to 16
+ * bits whenever the vertex count allows (Mesh::Create does this itself).
+ * Coarser levels of detail come from quadric error edge collapses (Garland
+ * and Heckbert), and meshlets for mesh shaders from a greedy split of the
+ * cache-ordered list. Everything here is device-independent and safe to run on
+ * job workers or in an offline cook step.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SM
+{
+    struct MeshData;
+
+    namespace MeshOptimizer
+    {
+        /// Entries of the simulated LRU cache used for scoring
+        constexpr uint32_t VERTEX_CACHE_SIZE = 32;
+
+        /// Meshlet limits (the common mesh shader output sizes; local indices fit 8 bits)
+        constexpr uint32_t MESHLET_MAX_VERTICES = 64;
+        constexpr uint32_t MESHLET_MAX_TRIANGLES = 124;
+
+        /**
+         * @brief A run of triangles with at most MESHLET_MAX_VERTICES unique vertices
+         */
+        struct Meshlet
+        {
+            uint32_t VertexOffset = 0;      ///< First entry in the meshlet vertex list
+            uint32_t TriangleOffset = 0;    ///< First entry in the packed triangle list
+            uint32_t VertexCount = 0;
+            uint32_t TriangleCount = 0;
+        };
+
+        /**
+         * @brief Check if every index of a mesh fits a 16-bit index buffer
+         *
+         * 0xFFFF is left unused so the buffer stays valid as a strip with cuts.
+         */
+        inline bool CanUse16BitIndices(uint32_t vertexCount) { return vertexCount <= 0xFFFFu; }
+
+        /**
+         * @brief Narrow indices to 16 bits (check CanUse16BitIndices first)
+         */
+        void ConvertTo16BitIndices(const uint32_t* indices, size_t indexCount, std::vector<uint16_t>& outIndices);
+
+        /**
+         * @brief Reorder triangles for the post-transform vertex cache
+         * @param indices Triangle list, rewritten in place
+         * @param indexCount Number of indices (a multiple of 3)
+         * @param vertexCount Number of vertices the indices refer to
+         *
+         * Only triangle order changes; every triangle keeps its winding and
+         * vertices are not touched, so grids read as heightfields stay valid.
+         * Degenerate triangles are kept. Lists with an out-of-range index are
+         * left unchanged.
+         */
+        void OptimizeVertexCache(uint32_t* indices, size_t indexCount, uint32_t vertexCount);
+
+        inline void OptimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertexCount)
+        {
+            OptimizeVertexCache(indices.data(), indices.size(), vertexCount);
+        }
+
+        /**
+         * @brief Renumber vertices in the order the indices first use them
+         * @param vertices Vertex data in any layout, reordered in place
+         * @param vertexCount Number of vertices
+         * @param vertexStride Size of one vertex in bytes
+         * @param indices Indices, remapped in place
+         * @param indexCount Number of indices
+         * @return Number of referenced vertices; unreferenced ones move to the end
+         *
+         * Run after OptimizeVertexCache. Lists with an out-of-range index are
+         * left unchanged and return vertexCount.
+         */
+        uint32_t OptimizeVertexFetch(void* vertices, uint32_t vertexCount, uint32_t vertexStride,
+                                     uint32_t* indices, size_t indexCount);
+
+        /**
+         * @brief Run the vertex cache and vertex fetch passes on mesh data
+         */
+        void Optimize(MeshData& data);
+
+        /**
+         * @brief Collapse edges in order of quadric error until a target triangle count
+         * @param indices Triangle list to simplify
+         * @param indexCount Number of indices (a multiple of 3)
+         * @param positions First vertex position (three floats)
+         * @param vertexCount Number of vertices the indices refer to
+         * @param positionStride Bytes between consecutive positions
+         * @param targetIndexCount Index count to stop at
+         * @param targetError Largest collapse error to accept, relative to the mesh's extent
+         * @param outIndices Simplified list over the same vertices
+         * @return Error of the worst collapse made, relative to the extent
+         *
+         * Each collapse moves a vertex onto a neighbour, so no vertex is
+         * created or changed and outIndices indexes the original buffer.
+         * Vertices on open borders or attribute seams (a position shared by
+         * several vertices, as on UV or normal splits) never move, which keeps
+         * silhouettes and texture mapping intact but bounds how far flat-shaded
+         * meshes reduce. Collapses that would flip a triangle are skipped.
+         */
+        float Simplify(const uint32_t* indices, size_t indexCount, const float* positions, uint32_t vertexCount,
+                       uint32_t positionStride, size_t targetIndexCount, float targetError,
+                       std::vector<uint32_t>& outIndices);
+
+        /**
+         * @brief Build coarser levels of detail for mesh data
+         * @param data Level 0, already optimized
+         * @param maxLODs Most levels to add after level 0
+         * @param outLODs Levels 1 and up, each with compacted, optimized vertices
+         *
+         * Each level aims at half the triangles of the previous one and may
+         * err twice as much, since it is drawn at half the screen size. The
+         * chain ends early once a level would save less than a sixth of its
+         * predecessor.
+         */
+        void GenerateLODs(const MeshData& data, uint32_t maxLODs, std::vector<MeshData>& outLODs);
+
+        /**
+         * @brief Build coarser index lists over the same vertices, as GenerateLODs does
+         * @param outLevels Levels 1 and up, each cache-ordered
+         * @param outErrors Optional relative error of each level
+         *
+         * For formats that keep every level in one index buffer over one
+         * vertex buffer.
+         */
+        void GenerateLODIndices(const std::vector<uint32_t>& indices, const float* positions, uint32_t vertexCount,
+                                uint32_t positionStride, uint32_t maxLODs,
+                                std::vector<std::vector<uint32_t>>& outLevels, std::vector<float>* outErrors = nullptr);
+
+        /**
+         * @brief Split a triangle list into meshlets in list order
+         * @param indices Triangle list, ideally cache-ordered so meshlets stay compact
+         * @param indexCount Number of indices (a multiple of 3)
+         * @param vertexCount Number of vertices the indices refer to
+         * @param outMeshlets Appended meshlets; offsets continue from the output lists' sizes
+         * @param outVertices Appended vertex indices, VertexCount per meshlet
+         * @param outTriangles Appended triangles, local indices packed as a | b << 8 | c << 16
+         * @return Number of meshlets appended
+         */
+        size_t BuildMeshlets(const uint32_t* indices, size_t indexCount, uint32_t vertexCount,
+                             std::vector<Meshlet>& outMeshlets, std::vector<uint32_t>& outVertices,
+                             std::vector<uint32_t>& outTriangles);
+
+        /// Relative error GenerateLODs accepts for level 1 (1% of the mesh's extent)
+        constexpr float LOD_BASE_ERROR = 0.01f;
+
+        /**
+         * @brief Average cache misses per triangle (ACMR) of a list on a FIFO cache
+         * @param cacheSize FIFO entries to simulate (16 approximates current GPUs)
+         * @return Between 0.5 (ideal for a large grid) and 3.0 (no reuse)
+         */
+        float AnalyzeVertexCache(const uint32_t* indices, size_t indexCount, uint32_t vertexCount,
+                                 uint32_t cacheSize = 16);
+
+    } // namespace MeshOptimizer
+
+} // namespace SM
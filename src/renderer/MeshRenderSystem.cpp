@@ -0,0 +1,467 @@
+#include "renderer/MeshRenderSystem.h"
+#include "renderer/Frustum.h"
+#include "ecs/TransformBatch.h"
+#include "ecs/World.h"
+#include "ecs/components/TransformComponent.h"
+#include "ecs/components/WorldMatrixComponent.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace SM
+{
+    void MeshRenderSystem::Initialize(World& world)
+    {
+        // Create the query now; Update may run on a worker thread
+        world.GetQuery<TransformComponent, MeshComponent, MaterialComponent>();
+
+        SetComponentAccess(world.MakeSignature<TransformComponent, WorldMatrixComponent, MeshComponent, MaterialComponent>(),
+                           Signature());
+    }
+
+    void MeshRenderSystem::Update(World& world, [[maybe_unused]] float deltaTime)
+    {
+        // In snapshot mode m_Keys belongs to the render thread
+        std::vector<DrawKey>& keys = m_SnapshotMode ? m_TickKeys : m_Keys;
+        keys.clear();
+        if (!m_SnapshotMode)
+        {
+            m_PrepassBatches = false;
+            m_LODsSelected = false;
+        }
+        world.ForEach<TransformComponent, MeshComponent, MaterialComponent>(
+            [&keys, &world](EntityID entity, TransformComponent& transform, MeshComponent& mesh, MaterialComponent& material) {
+                if (!mesh.Visible || !mesh.IsValid())
+                {
+                    return;
+                }
+
+                // Cached by TransformSystem (with parents applied) when present
+                DirectX::XMMATRIX worldMatrix = world.HasComponent<WorldMatrixComponent>(entity)
+                    ? world.GetComponent<WorldMatrixComponent>(entity).GetWorldMatrix()
+                    : transform.GetLocalMatrix();
+
+                DrawKey& key = keys.emplace_back();
+                key.Mesh = mesh.MeshId;
+                key.Material = material.MaterialId;
+                key.Entity = entity;
+                key.MaterialConstants = ToMaterialData(material);
+                key.Instance = MeshInstanceData::FromMatrix(worldMatrix);
+
+                // Sphere radius grows with the largest axis scale of the matrix
+                DirectX::XMFLOAT4X4 m;
+                DirectX::XMStoreFloat4x4(&m, worldMatrix);
+                float radius = GetBoundingRadius(mesh);
+                if (radius >= 0.0f)
+                {
+                    float maxScaleSq = 0.0f;
+                    for (int row = 0; row < 3; ++row)
+                    {
+                        maxScaleSq = std::max(maxScaleSq,
+                            m.m[row][0] * m.m[row][0] + m.m[row][1] * m.m[row][1] + m.m[row][2] * m.m[row][2]);
+                    }
+                    radius *= std::sqrt(maxScaleSq);
+                }
+                else
+                {
+                    // Unknown extent: always passes the cull
+                    radius = std::numeric_limits<float>::infinity();
+                }
+                key.Sphere = DirectX::XMFLOAT4(m.m[3][0], m.m[3][1], m.m[3][2], radius);
+            });
+
+        // Inline material properties break batches too, so equal IDs with
+        // different constants are ordered bytewise to keep them adjacent
+        std::sort(keys.begin(), keys.end(), [](const DrawKey& a, const DrawKey& b) {
+            if (a.Mesh != b.Mesh)
+            {
+                return a.Mesh < b.Mesh;
+            }
+            if (a.Material != b.Material)
+            {
+                return a.Material < b.Material;
+            }
+            return std::memcmp(&a.MaterialConstants, &b.MaterialConstants, sizeof(MaterialData)) < 0;
+        });
+
+        if (m_SnapshotMode)
+        {
+            // Entities new this tick start where they are; destroyed ones drop out of the map
+            for (DrawKey& key : keys)
+            {
+                auto found = m_LastTickInstances.find(key.Entity);
+                key.Previous = (found != m_LastTickInstances.end()) ? found->second : key.Instance;
+            }
+            m_LastTickInstances.clear();
+            for (const DrawKey& key : keys)
+            {
+                m_LastTickInstances[key.Entity] = key.Instance;
+            }
+            return;
+        }
+
+        UpdateSpheres();
+    }
+
+    void MeshRenderSystem::UpdateSpheres()
+    {
+        m_SphereX.resize(m_Keys.size());
+        m_SphereY.resize(m_Keys.size());
+        m_SphereZ.resize(m_Keys.size());
+        m_SphereRadius.resize(m_Keys.size());
+        for (size_t i = 0; i < m_Keys.size(); ++i)
+        {
+            const DirectX::XMFLOAT4& sphere = m_Keys[i].Sphere;
+            m_SphereX[i] = sphere.x;
+            m_SphereY[i] = sphere.y;
+            m_SphereZ[i] = sphere.z;
+            m_SphereRadius[i] = sphere.w;
+        }
+    }
+
+    void MeshRenderSystem::Render(Renderer& renderer)
+    {
+        // The depth pre-pass already culled against the same camera
+        if (m_PrepassBatches)
+        {
+            m_PrepassBatches = false;
+
+            m_Stats.Instances = static_cast<uint32_t>(m_PrepassVisible);
+            m_Stats.Culled = static_cast<uint32_t>(m_Keys.size() - m_PrepassVisible);
+            m_Stats.Batches = static_cast<uint32_t>(m_Batches.size());
+            UpdateTriangleStats();
+
+            if (!m_Batches.empty())
+            {
+                renderer.DrawMeshBatches(m_Batches, m_Instances);
+            }
+            return;
+        }
+
+        const Camera& camera = renderer.GetCamera();
+        Frustum frustum(DirectX::XMMatrixMultiply(camera.GetViewMatrix(),
+                                                  camera.GetProjectionMatrix(renderer.GetAspectRatio())));
+        DirectX::XMFLOAT4 planes[Frustum::PlaneCount];
+        for (int p = 0; p < Frustum::PlaneCount; ++p)
+        {
+            planes[p] = frustum.GetPlane(p);
+        }
+
+        const size_t visibleCount = BuildBatches(renderer, planes, Frustum::PlaneCount);
+
+        m_Stats.Instances = static_cast<uint32_t>(visibleCount);
+        m_Stats.Culled = static_cast<uint32_t>(m_Keys.size() - visibleCount);
+        m_Stats.Batches = static_cast<uint32_t>(m_Batches.size());
+        UpdateTriangleStats();
+
+        if (!m_Batches.empty())
+        {
+            renderer.DrawMeshBatches(m_Batches, m_Instances);
+        }
+    }
+
+    uint32_t MeshRenderSystem::RenderDepthPrepass(Renderer& renderer)
+    {
+        const Camera& camera = renderer.GetCamera();
+        Frustum frustum(DirectX::XMMatrixMultiply(camera.GetViewMatrix(),
+                                                  camera.GetProjectionMatrix(renderer.GetAspectRatio())));
+        DirectX::XMFLOAT4 planes[Frustum::PlaneCount];
+        for (int p = 0; p < Frustum::PlaneCount; ++p)
+        {
+            planes[p] = frustum.GetPlane(p);
+        }
+
+        m_PrepassVisible = BuildBatches(renderer, planes, Frustum::PlaneCount);
+        m_PrepassBatches = true;
+
+        if (!m_Batches.empty())
+        {
+            renderer.DrawMeshBatchesPrepass(m_Batches, m_Instances);
+        }
+        return static_cast<uint32_t>(m_PrepassVisible);
+    }
+
+    uint32_t MeshRenderSystem::RenderShadowCasters(Renderer& renderer, const DirectX::XMMATRIX& lightViewProjection)
+    {
+        // Replaces the batches, so a following Render culls again
+        m_PrepassBatches = false;
+
+        // No near plane: casters between the light and the cascade still shadow it
+        Frustum frustum(lightViewProjection);
+        DirectX::XMFLOAT4 planes[Frustum::PlaneCount - 1];
+        int planeCount = 0;
+        for (int p = 0; p < Frustum::PlaneCount; ++p)
+        {
+            if (p != Frustum::Near)
+            {
+                planes[planeCount++] = frustum.GetPlane(p);
+            }
+        }
+
+        const size_t casterCount = BuildBatches(renderer, planes, planeCount);
+        if (!m_Batches.empty())
+        {
+            renderer.DrawMeshBatchesDepth(m_Batches, m_Instances, lightViewProjection);
+        }
+        return static_cast<uint32_t>(casterCount);
+    }
+
+    size_t MeshRenderSystem::BuildBatches(Renderer& renderer, const DirectX::XMFLOAT4* planes, int planeCount)
+    {
+        m_Instances.clear();
+        m_Batches.clear();
+        m_BatchMeshes.clear();
+        m_BatchLODs.clear();
+
+        SelectLODs(renderer);
+
+        m_Visible.resize(m_Keys.size());
+        size_t visibleCount = TransformBatch::CullSpheres(planes, planeCount,
+            m_SphereX.data(), m_SphereY.data(), m_SphereZ.data(), m_SphereRadius.data(),
+            m_Keys.size(), m_Visible.data());
+
+        // Ordered keys are grouped, so runs of equal keys among the survivors form the batches
+        const DrawKey* previous = nullptr;
+        for (uint32_t i : m_Order)
+        {
+            if (!m_Visible[i])
+            {
+                continue;
+            }
+
+            const DrawKey& key = m_Keys[i];
+            bool startsBatch = !previous ||
+                key.Mesh != previous->Mesh ||
+                key.LOD != previous->LOD ||
+                key.Material != previous->Material ||
+                std::memcmp(&key.MaterialConstants, &previous->MaterialConstants, sizeof(MaterialData)) != 0;
+
+            if (startsBatch)
+            {
+                MeshBatch& batch = m_Batches.emplace_back();
+                batch.Material = key.MaterialConstants;
+                batch.FirstInstance = static_cast<uint32_t>(m_Instances.size());
+                m_BatchMeshes.push_back(key.Mesh);
+                m_BatchLODs.push_back(key.LOD);
+            }
+
+            m_Instances.push_back(m_SnapshotMode ? GetInstance(key) : key.Instance);
+            m_Batches.back().InstanceCount++;
+            previous = &key;
+        }
+
+        for (size_t i = 0; i < m_Batches.size(); ++i)
+        {
+            m_Batches[i].MeshPtr = renderer.GetPrimitiveMesh(m_BatchMeshes[i], m_BatchLODs[i]);
+        }
+
+        return visibleCount;
+    }
+
+    void MeshRenderSystem::SetSnapshotMode(bool enabled)
+    {
+        m_SnapshotMode = enabled;
+        m_TickKeys.clear();
+        m_LastTickInstances.clear();
+
+        std::lock_guard<std::mutex> lock(m_SnapshotMutex);
+        m_PublishedKeys.clear();
+        m_SnapshotPublished = false;
+    }
+
+    void MeshRenderSystem::PublishSnapshot()
+    {
+        std::lock_guard<std::mutex> lock(m_SnapshotMutex);
+        m_TickKeys.swap(m_PublishedKeys);
+        m_SnapshotPublished = true;
+    }
+
+    void MeshRenderSystem::TakeSnapshot()
+    {
+        std::lock_guard<std::mutex> lock(m_SnapshotMutex);
+        if (m_SnapshotPublished)
+        {
+            m_Keys.swap(m_PublishedKeys);
+            m_SnapshotPublished = false;
+        }
+    }
+
+    void MeshRenderSystem::InterpolateSnapshot(float alpha)
+    {
+        m_SnapshotAlpha = std::clamp(alpha, 0.0f, 1.0f);
+        m_PrepassBatches = false;
+        m_LODsSelected = false;
+
+        // Culling and level selection use the interpolated centers; the translation is the rows' w
+        for (DrawKey& key : m_Keys)
+        {
+            const MeshInstanceData& from = key.Previous;
+            const MeshInstanceData& to = key.Instance;
+            key.Sphere.x = from.WorldRows[0].w + (to.WorldRows[0].w - from.WorldRows[0].w) * m_SnapshotAlpha;
+            key.Sphere.y = from.WorldRows[1].w + (to.WorldRows[1].w - from.WorldRows[1].w) * m_SnapshotAlpha;
+            key.Sphere.z = from.WorldRows[2].w + (to.WorldRows[2].w - from.WorldRows[2].w) * m_SnapshotAlpha;
+        }
+        UpdateSpheres();
+    }
+
+    MeshInstanceData MeshRenderSystem::GetInstance(const DrawKey& key) const
+    {
+        // A tick apart, blending the affine rows is indistinguishable from
+        // interpolating rotation and scale separately
+        MeshInstanceData instance;
+        for (int row = 0; row < 3; ++row)
+        {
+            DirectX::XMVECTOR from = DirectX::XMLoadFloat4(&key.Previous.WorldRows[row]);
+            DirectX::XMVECTOR to = DirectX::XMLoadFloat4(&key.Instance.WorldRows[row]);
+            DirectX::XMStoreFloat4(&instance.WorldRows[row], DirectX::XMVectorLerp(from, to, m_SnapshotAlpha));
+        }
+        return instance;
+    }
+
+    void MeshRenderSystem::SelectLODs(Renderer& renderer)
+    {
+        if (m_LODsSelected)
+        {
+            return;
+        }
+        m_LODsSelected = true;
+
+        // Projected radius over half the screen height is radius * cot(fov / 2) / distance
+        const Camera& camera = renderer.GetCamera();
+        const DirectX::XMVECTOR eye = DirectX::XMLoadFloat3(&camera.Position);
+        const float projectionScale = m_LODBias / std::tan(camera.FieldOfView * 0.5f);
+
+        // Entries of destroyed entities only cost memory, so they go once they outnumber the live ones
+        if (m_EntityLODs.size() > m_Keys.size() * 2)
+        {
+            m_EntityLODs.clear();
+        }
+
+        uint32_t usedLODs = 1;
+        for (size_t begin = 0; begin < m_Keys.size();)
+        {
+            const MeshID mesh = m_Keys[begin].Mesh;
+            const uint32_t lodCount = renderer.GetPrimitiveLODCount(mesh);
+            usedLODs = std::max(usedLODs, lodCount);
+
+            size_t end = begin;
+            for (; end < m_Keys.size() && m_Keys[end].Mesh == mesh; ++end)
+            {
+                DrawKey& key = m_Keys[end];
+                if (lodCount <= 1 || std::isinf(key.Sphere.w))
+                {
+                    key.LOD = 0;
+                    continue;
+                }
+
+                const DirectX::XMVECTOR center = DirectX::XMLoadFloat4(&key.Sphere);
+                const float distance = std::max(DirectX::XMVectorGetX(DirectX::XMVector3Length(
+                    DirectX::XMVectorSubtract(center, eye))), camera.NearPlane);
+                const float screenSize = key.Sphere.w * projectionScale / distance;
+
+                auto found = m_EntityLODs.find(key.Entity);
+                const uint32_t previousLOD = (found != m_EntityLODs.end()) ? found->second : 0;
+                key.LOD = SelectLOD(previousLOD, screenSize, lodCount);
+                m_EntityLODs[key.Entity] = key.LOD;
+            }
+            begin = end;
+        }
+
+        // Keys are sorted by mesh; within each mesh, gather level by level, keeping material order
+        m_Order.clear();
+        m_Order.reserve(m_Keys.size());
+        for (size_t begin = 0; begin < m_Keys.size();)
+        {
+            size_t end = begin;
+            while (end < m_Keys.size() && m_Keys[end].Mesh == m_Keys[begin].Mesh)
+            {
+                end++;
+            }
+
+            for (uint32_t lod = 0; lod < usedLODs; ++lod)
+            {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    if (m_Keys[i].LOD == lod)
+                    {
+                        m_Order.push_back(static_cast<uint32_t>(i));
+                    }
+                }
+            }
+            begin = end;
+        }
+    }
+
+    uint32_t MeshRenderSystem::SelectLOD(uint32_t previous, float screenSize, uint32_t lodCount)
+    {
+        uint32_t lod = std::min(previous, lodCount - 1);
+
+        // Coarsen only once clearly below a threshold, refine only once clearly above it
+        while (lod + 1 < lodCount && screenSize < LOD_SCREEN_SIZES[lod] * (1.0f - LOD_HYSTERESIS))
+        {
+            lod++;
+        }
+        while (lod > 0 && screenSize > LOD_SCREEN_SIZES[lod - 1] * (1.0f + LOD_HYSTERESIS))
+        {
+            lod--;
+        }
+        return lod;
+    }
+
+    void MeshRenderSystem::UpdateTriangleStats()
+    {
+        m_Stats.Triangles = 0;
+        m_Stats.Reduced = 0;
+        for (size_t i = 0; i < m_Batches.size(); ++i)
+        {
+            const MeshBatch& batch = m_Batches[i];
+            if (batch.MeshPtr)
+            {
+                const uint32_t primitives = batch.MeshPtr->HasIndices()
+                    ? batch.MeshPtr->GetIndexCount() : batch.MeshPtr->GetVertexCount();
+                m_Stats.Triangles += primitives / 3 * batch.InstanceCount;
+            }
+            if (m_BatchLODs[i] > 0)
+            {
+                m_Stats.Reduced += batch.InstanceCount;
+            }
+        }
+    }
+
+    MaterialData MeshRenderSystem::ToMaterialData(const MaterialComponent& material)
+    {
+        MaterialData data = CreateDefaultMaterial();
+        data.BaseColor = DirectX::XMFLOAT4(material.BaseColor.r, material.BaseColor.g,
+                                           material.BaseColor.b, material.BaseColor.a);
+        data.EmissiveColor = DirectX::XMFLOAT4(material.EmissiveColor.r, material.EmissiveColor.g,
+                                               material.EmissiveColor.b, material.EmissiveColor.a);
+        data.Metallic = material.Metallic;
+        data.Roughness = material.Roughness;
+        data.AmbientOcclusion = material.AmbientOcclusion;
+        data.EmissiveIntensity = material.EmissiveIntensity;
+        return data;
+    }
+
+    float MeshRenderSystem::GetBoundingRadius(const MeshComponent& mesh)
+    {
+        if (mesh.BoundingRadius > 0.0f)
+        {
+            return mesh.BoundingRadius;
+        }
+
+        // Sizes the Renderer builds its primitives with
+        switch (mesh.MeshId)
+        {
+            case PrimitiveMesh::Cube:     return 0.8661f;   // Half-diagonal of a unit cube
+            case PrimitiveMesh::Sphere:   return 0.5f;
+            case PrimitiveMesh::Plane:    return 7.0711f;   // 10 x 10
+            case PrimitiveMesh::Cylinder: return 0.7072f;   // Radius 0.5, height 1
+            case PrimitiveMesh::Cone:     return 0.7072f;
+            case PrimitiveMesh::Quad:     return 0.7072f;
+            default:                      return -1.0f;
+        }
+    }
+
+} // namespace SM
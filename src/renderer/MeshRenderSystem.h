@@ -0,0 +1,232 @@
+#pragma once
+
+/**
+ * @file MeshRenderSystem.h
+ * @brief ECS system that draws mesh entities as instanced batches
+ *
+ * Gathers every entity with a TransformComponent, MeshComponent and
+ * MaterialComponent, sorts them by mesh and material and draws each run
+ * of equal keys with a single DrawIndexedInstanced. Transforms go to the
+ * GPU in one per-frame structured buffer instead of one constant buffer
+ * (plus a CPU matrix inverse) per entity. World matrices come from
+ * WorldMatrixComponent when the entity has one. Bounding spheres are
+ * frustum-culled against the render camera in SIMD batches before the
+ * batches are built. Each entity draws the level of detail of its mesh
+ * that suits its projected size, so distant props cost few triangles.
+ *
+ * In snapshot mode Update runs on the simulation thread and publishes
+ * each tick's keys; the render thread draws the latest snapshot with
+ * transforms placed between the last two ticks.
+ */
+
+#include "ecs/System.h"
+#include "ecs/components/MaterialComponent.h"
+#include "ecs/components/MeshComponent.h"
+#include "renderer/Renderer.h"
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace SM
+{
+    /**
+     * @brief Batching activity of the last gathered frame
+     */
+    struct MeshRenderStats
+    {
+        uint32_t Instances = 0;     ///< Visible entities drawn
+        uint32_t Culled = 0;        ///< Entities outside the view frustum
+        uint32_t Batches = 0;       ///< Draw calls the visible entities were merged into
+        uint32_t Triangles = 0;     ///< Triangles of all drawn instances at their chosen level of detail
+        uint32_t Reduced = 0;       ///< Visible entities drawn with a coarser level than 0
+    };
+
+    /**
+     * @brief Builds instanced mesh batches from ECS entities
+     *
+     * Update only reads components, so it may run alongside other systems;
+     * Render uploads and draws the result inside the frame's scene pass.
+     */
+    class MeshRenderSystem : public System<MeshRenderSystem>
+    {
+    public:
+        static constexpr int PRIORITY = 100;    ///< After TransformSystem
+
+        MeshRenderSystem() { SetPriority(PRIORITY); }
+
+        void Initialize(World& world) override;
+        void Update(World& world, float deltaTime) override;
+        const char* GetName() const override { return "MeshRenderSystem"; }
+
+        /**
+         * @brief Cull the entities gathered by the last Update and draw them
+         * @param renderer Renderer inside BeginFrame/EndFrame
+         *
+         * Culls against the renderer's camera. Mesh IDs are resolved through
+         * Renderer::GetPrimitiveMesh; entities with an unknown mesh are skipped.
+         */
+        void Render(Renderer& renderer);
+
+        /**
+         * @brief Cull the gathered entities and draw them into the main depth buffer only
+         * @param renderer Renderer inside BeginFrame/EndFrame
+         * @return Number of entities drawn
+         *
+         * The batches are kept for the Render that follows in the same frame,
+         * which then skips culling and shades only the visible surface.
+         */
+        uint32_t RenderDepthPrepass(Renderer& renderer);
+
+        /**
+         * @brief Draw the entities gathered by the last Update into a shadow map
+         * @param renderer Renderer with the shadow map's depth target bound
+         * @param lightViewProjection Light view-projection of the shadow map
+         * @return Number of casters drawn
+         *
+         * Culls against the light's volume without its near plane. Does not
+         * change GetStats.
+         */
+        uint32_t RenderShadowCasters(Renderer& renderer, const DirectX::XMMATRIX& lightViewProjection);
+
+        /**
+         * @brief Get culling and batching activity of the last Render
+         */
+        const MeshRenderStats& GetStats() const { return m_Stats; }
+
+        /**
+         * @brief Scale the projected size levels of detail are picked by
+         * @param bias Above 1 keeps detail further away, below 1 drops it sooner
+         */
+        void SetLODBias(float bias) { m_LODBias = bias; m_LODsSelected = false; }
+        float GetLODBias() const { return m_LODBias; }
+
+        /// Projected radius, as a share of half the screen height, below which level k + 1 is used
+        static constexpr float LOD_SCREEN_SIZES[Renderer::MAX_PRIMITIVE_LODS - 1] = { 0.2f, 0.1f, 0.05f };
+
+        /// Share of a threshold an entity must pass beyond it before its level changes again
+        static constexpr float LOD_HYSTERESIS = 0.15f;
+
+        // ====================================================================
+        // Snapshots (threaded simulation)
+        // ====================================================================
+
+        /**
+         * @brief Keep Update's keys for PublishSnapshot instead of drawing them directly
+         * @param enabled true when Update runs on a simulation thread
+         */
+        void SetSnapshotMode(bool enabled);
+        bool IsSnapshotMode() const { return m_SnapshotMode; }
+
+        /**
+         * @brief Hand the keys of the last Update to the render thread (simulation thread)
+         *
+         * Each key carries its entity's transform from the tick before, so
+         * the render thread can interpolate without looking up the ECS.
+         */
+        void PublishSnapshot();
+
+        /**
+         * @brief Take the latest published keys if there are new ones (render thread)
+         */
+        void TakeSnapshot();
+
+        /**
+         * @brief Place the snapshot's instances between their last two ticks (render thread)
+         * @param alpha 0 draws the previous tick, 1 the latest
+         *
+         * Call every frame before Render, even without a new tick, so
+         * instances move smoothly.
+         */
+        void InterpolateSnapshot(float alpha);
+
+    private:
+        /**
+         * @brief One visible entity, ordered by mesh then material
+         */
+        struct DrawKey
+        {
+            MeshID Mesh = INVALID_MESH_ID;
+            MaterialID Material = INVALID_MATERIAL_ID;
+            EntityID Entity = INVALID_ENTITY;
+            uint32_t LOD = 0;               ///< Chosen by SelectLODs
+            MaterialData MaterialConstants;
+            MeshInstanceData Instance;      ///< Latest tick's transform in snapshot mode
+            MeshInstanceData Previous;      ///< Tick before's transform (snapshot mode only)
+            DirectX::XMFLOAT4 Sphere;       ///< World-space center and radius
+        };
+
+        /**
+         * @brief Rebuild the SoA sphere copy from the key spheres
+         */
+        void UpdateSpheres();
+
+        /**
+         * @brief Transform of a key at the snapshot's alpha
+         */
+        MeshInstanceData GetInstance(const DrawKey& key) const;
+
+        /**
+         * @brief Cull the gathered keys against planes and rebuild the batches from the survivors
+         * @return Number of visible keys
+         */
+        size_t BuildBatches(Renderer& renderer, const DirectX::XMFLOAT4* planes, int planeCount);
+
+        /**
+         * @brief Pick every key's level of detail from the render camera, once per Update
+         *
+         * Shadow passes reuse the camera's choice. Fills m_Order with the keys
+         * grouped by mesh, then level, then their sorted material order.
+         */
+        void SelectLODs(Renderer& renderer);
+
+        /**
+         * @brief Level for a projected size, moving from the entity's last level with hysteresis
+         */
+        static uint32_t SelectLOD(uint32_t previous, float screenSize, uint32_t lodCount);
+
+        /**
+         * @brief Fill the triangle and level counts of m_Stats from the current batches
+         */
+        void UpdateTriangleStats();
+
+        /**
+         * @brief Convert a component's inline properties to shader constants
+         */
+        static MaterialData ToMaterialData(const MaterialComponent& material);
+
+        /**
+         * @brief Object-space bounding radius of a mesh component
+         * @return Negative when unknown (custom mesh without BoundingRadius)
+         */
+        static float GetBoundingRadius(const MeshComponent& mesh);
+
+    private:
+        std::vector<DrawKey> m_Keys;                    // Sorted by Update (or taken from a snapshot), reused every frame
+        std::vector<float> m_SphereX, m_SphereY, m_SphereZ, m_SphereRadius;   // SoA copy of the key spheres
+        std::vector<uint8_t> m_Visible;
+        std::vector<MeshInstanceData> m_Instances;      // Grouped by batch
+        std::vector<MeshBatch> m_Batches;
+        std::vector<MeshID> m_BatchMeshes;              // Mesh ID of each batch, resolved in Render
+        std::vector<uint32_t> m_BatchLODs;              // Level of detail of each batch
+        std::vector<uint32_t> m_Order;                  // Key indices grouped by mesh and level
+        std::unordered_map<EntityID, uint32_t> m_EntityLODs;   // Last level per entity, for hysteresis
+        float m_LODBias = 1.0f;
+        bool m_LODsSelected = false;                    // m_Order and key LODs match the current keys
+        size_t m_PrepassVisible = 0;                    // Keys culled by RenderDepthPrepass
+        bool m_PrepassBatches = false;                  // m_Batches hold the pre-pass result
+        MeshRenderStats m_Stats;
+
+        // Snapshot mode: Update fills m_TickKeys, PublishSnapshot swaps them into
+        // m_PublishedKeys and TakeSnapshot swaps those into m_Keys
+        bool m_SnapshotMode = false;
+        std::vector<DrawKey> m_TickKeys;                // Simulation thread only
+        std::vector<DrawKey> m_PublishedKeys;           // Guarded by m_SnapshotMutex
+        std::unordered_map<EntityID, MeshInstanceData> m_LastTickInstances;  // Simulation thread only
+        std::mutex m_SnapshotMutex;
+        bool m_SnapshotPublished = false;               // Guarded by m_SnapshotMutex
+        float m_SnapshotAlpha = 1.0f;                   // Between Previous (0) and Instance (1)
+    };
+
+} // namespace SM
@@ -0,0 +1,271 @@
+#include "renderer/MipGenerator.h"
+#include "renderer/Texture.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace SM
+{
+    namespace
+    {
+        /// Must match [numthreads] in GenerateMips.hlsl
+        constexpr uint32_t THREAD_GROUP_SIZE = 8;
+
+        // Root parameter slots
+        constexpr uint32_t ROOT_CONSTANTS = 0;
+        constexpr uint32_t ROOT_SOURCE = 1;
+        constexpr uint32_t ROOT_DEST = 2;
+    }
+
+    MipGenerator::~MipGenerator()
+    {
+        Shutdown();
+    }
+
+    // ============================================================================
+    // Initialization
+    // ============================================================================
+
+    bool MipGenerator::Initialize(DX12Core* core)
+    {
+        if (m_Initialized)
+        {
+            return true;
+        }
+
+        if (!core)
+        {
+            std::cerr << "[MipGenerator] Cannot initialize: DX12Core is null" << std::endl;
+            return false;
+        }
+
+        m_Core = core;
+
+        if (!CompileShaderFromFile(L"shaders/GenerateMips.hlsl", "main", "cs_5_1", m_ComputeShader))
+        {
+            std::cerr << "[MipGenerator] Failed to compile mip generation shader!" << std::endl;
+            return false;
+        }
+
+        // Root signature:
+        // 0: Constants - Level sizes (b0)
+        // 1: Table - Source level SRV (t0)
+        // 2: Table - Destination level UAV (u0)
+        DescriptorRange sourceRange;
+        sourceRange.Type = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
+        sourceRange.NumDescriptors = 1;
+        sourceRange.BaseShaderRegister = 0;
+
+        DescriptorRange destRange;
+        destRange.Type = D3D12_DESCRIPTOR_RANGE_TYPE_UAV;
+        destRange.NumDescriptors = 1;
+        destRange.BaseShaderRegister = 0;
+
+        bool built = m_RootSignature
+            .Begin(RootSignatureFlags::None)
+            .AddConstants(sizeof(MipConstants) / sizeof(uint32_t), 0)
+            .AddDescriptorTable({ sourceRange })
+            .AddDescriptorTable({ destRange })
+            .Build(m_Core);
+
+        if (!built)
+        {
+            std::cerr << "[MipGenerator] Failed to create root signature!" << std::endl;
+            return false;
+        }
+
+        built = m_PipelineState
+            .Begin()
+            .SetRootSignature(m_RootSignature)
+            .SetComputeShader(m_ComputeShader)
+            .Build(m_Core);
+
+        if (!built)
+        {
+            std::cerr << "[MipGenerator] Failed to create pipeline state!" << std::endl;
+            return false;
+        }
+
+        if (!m_CommandList.Initialize(m_Core, CommandListType::Compute))
+        {
+            std::cerr << "[MipGenerator] Failed to create command list!" << std::endl;
+            return false;
+        }
+
+        DescriptorHeap& heap = m_Core->GetCBVSRVUAVHeap();
+        for (uint32_t i = 0; i < MAX_MIP_LEVELS - 1; ++i)
+        {
+            m_SourceViews[i] = heap.Allocate();
+            m_DestViews[i] = heap.Allocate();
+        }
+
+        m_FenceValue = 0;
+        m_Initialized = true;
+
+        std::cout << "[MipGenerator] Initialized" << std::endl;
+        return true;
+    }
+
+    void MipGenerator::Shutdown()
+    {
+        if (!m_Initialized)
+        {
+            return;
+        }
+
+        WaitForCompletion();
+
+        DescriptorHeap& heap = m_Core->GetCBVSRVUAVHeap();
+        for (uint32_t i = 0; i < MAX_MIP_LEVELS - 1; ++i)
+        {
+            heap.Free(m_SourceViews[i]);
+            heap.Free(m_DestViews[i]);
+        }
+
+        m_FenceValue = 0;
+        m_Initialized = false;
+        m_Core = nullptr;
+    }
+
+    bool MipGenerator::SupportsFormat(DXGI_FORMAT format)
+    {
+        // Typed UAV stores every D3D12 device supports
+        switch (format)
+        {
+            case DXGI_FORMAT_R32G32B32A32_FLOAT:
+            case DXGI_FORMAT_R16G16B16A16_FLOAT:
+            case DXGI_FORMAT_R16G16B16A16_UNORM:
+            case DXGI_FORMAT_R8G8B8A8_UNORM:
+            case DXGI_FORMAT_R10G10B10A2_UNORM:
+            case DXGI_FORMAT_R32G32_FLOAT:
+            case DXGI_FORMAT_R16G16_FLOAT:
+            case DXGI_FORMAT_R32_FLOAT:
+            case DXGI_FORMAT_R16_FLOAT:
+            case DXGI_FORMAT_R8_UNORM:
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    uint32_t MipGenerator::GetMipCount(uint32_t width, uint32_t height)
+    {
+        uint32_t count = 1;
+        for (uint32_t size = std::max(width, height); size > 1; size >>= 1)
+        {
+            ++count;
+        }
+        return count;
+    }
+
+    // ============================================================================
+    // Generation
+    // ============================================================================
+
+    bool MipGenerator::Generate(Texture& texture, uint64_t uploadFence)
+    {
+        if (!m_Initialized || !texture.IsValid())
+        {
+            return false;
+        }
+
+        const TextureDesc& desc = texture.GetDesc();
+        if (desc.MipLevels < 2)
+        {
+            return true;
+        }
+
+        if (desc.Type != TextureType::Texture2D || desc.DepthOrArraySize != 1 || desc.MipLevels > MAX_MIP_LEVELS ||
+            (desc.Usage & TextureUsage::UnorderedAccess) != TextureUsage::UnorderedAccess ||
+            !SupportsFormat(desc.Format))
+        {
+            std::cerr << "[MipGenerator] Texture cannot have its mips generated" << std::endl;
+            return false;
+        }
+
+        // The previous submission still reads the views about to be rewritten
+        WaitForCompletion();
+
+        ComputeQueue& compute = m_Core->GetComputeSubmitter();
+        m_Core->GetUploadQueue().WaitOnQueue(m_Core->GetComputeQueue(), uploadFence);
+
+        if (!compute.Begin(m_CommandList))
+        {
+            return false;
+        }
+
+        ID3D12Device* device = m_Core->GetDevice();
+        ID3D12Resource* resource = texture.GetResource();
+        ID3D12DescriptorHeap* heaps[] = { m_Core->GetCBVSRVUAVHeap().GetHeap() };
+
+        m_CommandList.SetDescriptorHeaps(1, heaps);
+        m_CommandList.SetComputeRootSignature(m_RootSignature.GetNative());
+        m_CommandList.SetPipelineState(m_PipelineState.GetNative());
+
+        m_CommandList.TransitionBarrier(resource,
+            D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+
+        for (uint32_t mip = 1; mip < desc.MipLevels; ++mip)
+        {
+            const uint32_t source = mip - 1;
+
+            D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+            srvDesc.Format = desc.Format;
+            srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+            srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+            srvDesc.Texture2D.MostDetailedMip = source;
+            srvDesc.Texture2D.MipLevels = 1;
+            device->CreateShaderResourceView(resource, &srvDesc, m_SourceViews[source].CPU);
+
+            D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+            uavDesc.Format = desc.Format;
+            uavDesc.ViewDimension = D3D12_UAV_DIMENSION_TEXTURE2D;
+            uavDesc.Texture2D.MipSlice = mip;
+            device->CreateUnorderedAccessView(resource, nullptr, &uavDesc, m_DestViews[source].CPU);
+
+            MipConstants constants = {};
+            constants.SourceWidth = std::max(1u, desc.Width >> source);
+            constants.SourceHeight = std::max(1u, desc.Height >> source);
+            constants.DestWidth = std::max(1u, desc.Width >> mip);
+            constants.DestHeight = std::max(1u, desc.Height >> mip);
+
+            // The level above is finished; read it as a shader resource
+            m_CommandList.TransitionBarrier(resource,
+                D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE, source);
+
+            m_CommandList.SetComputeRoot32BitConstants(ROOT_CONSTANTS,
+                sizeof(MipConstants) / sizeof(uint32_t), &constants);
+            m_CommandList.SetComputeRootDescriptorTable(ROOT_SOURCE, m_SourceViews[source].GPU);
+            m_CommandList.SetComputeRootDescriptorTable(ROOT_DEST, m_DestViews[source].GPU);
+
+            m_CommandList.Dispatch(
+                (constants.DestWidth + THREAD_GROUP_SIZE - 1) / THREAD_GROUP_SIZE,
+                (constants.DestHeight + THREAD_GROUP_SIZE - 1) / THREAD_GROUP_SIZE);
+        }
+
+        // Every level is now a shader resource; hand the texture back in COMMON
+        m_CommandList.TransitionBarrier(resource,
+            D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE,
+            desc.MipLevels - 1);
+        m_CommandList.TransitionBarrier(resource,
+            D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_COMMON);
+
+        // The direct queue waits for it before its next submission
+        m_FenceValue = compute.Submit(m_CommandList);
+        return m_FenceValue != 0;
+    }
+
+    // ============================================================================
+    // Private Methods
+    // ============================================================================
+
+    void MipGenerator::WaitForCompletion()
+    {
+        if (m_Core)
+        {
+            m_Core->GetComputeSubmitter().WaitForFence(m_FenceValue);
+        }
+    }
+
+} // namespace SM
@@ -0,0 +1,116 @@
+#pragma once
+
+/**
+ * @file MipGenerator.h
+ * @brief Compute-shader mip chain generation
+ *
+ * Fills mips 1..N-1 of a texture from level 0 with shaders/GenerateMips.hlsl,
+ * one dispatch per level. Used for images that arrive without a baked mip
+ * chain (WIC-decoded files); shipping DDS textures carry their own mips.
+ */
+
+#include "renderer/DX12Core.h"
+#include "renderer/CommandList.h"
+#include "renderer/RootSignature.h"
+#include "renderer/PipelineState.h"
+
+#include <array>
+
+namespace SM
+{
+    class Texture;
+
+    /**
+     * @brief Root constants consumed by GenerateMips.hlsl (b0)
+     */
+    struct MipConstants
+    {
+        uint32_t SourceWidth;
+        uint32_t SourceHeight;
+        uint32_t DestWidth;
+        uint32_t DestHeight;
+    };
+
+    /**
+     * @brief Builds mip chains on the async compute queue
+     *
+     * Work is submitted on the generator's own command list and overlaps the
+     * frames already queued for graphics, so the CPU never waits for it; the
+     * next Generate only waits if the previous one is still executing. Not
+     * thread-safe; call from the render thread.
+     */
+    class MipGenerator
+    {
+    public:
+        /// Levels of a 16384 texture; descriptors are preallocated for this many
+        static constexpr uint32_t MAX_MIP_LEVELS = 15;
+
+        MipGenerator() = default;
+        ~MipGenerator();
+
+        // Prevent copying
+        MipGenerator(const MipGenerator&) = delete;
+        MipGenerator& operator=(const MipGenerator&) = delete;
+
+        /**
+         * @brief Compile the shader and create the pipeline (no-op if initialized)
+         * @param core DX12 core
+         * @return true if successful
+         */
+        bool Initialize(DX12Core* core);
+
+        /**
+         * @brief Wait for outstanding work and release resources
+         */
+        void Shutdown();
+
+        bool IsInitialized() const { return m_Initialized; }
+
+        /**
+         * @brief Check if mips of a format can be written through a typed UAV
+         *
+         * sRGB and block-compressed formats cannot.
+         */
+        static bool SupportsFormat(DXGI_FORMAT format);
+
+        /**
+         * @brief Get the full mip count of a 2D texture
+         */
+        static uint32_t GetMipCount(uint32_t width, uint32_t height);
+
+        /**
+         * @brief Generate mips 1..N-1 of a texture from level 0
+         * @param texture 2D texture with UnorderedAccess usage in the COMMON state
+         * @param uploadFence UploadQueue fence of level 0's copy (0 if already resident)
+         * @return true if the work was submitted
+         *
+         * The compute queue waits on the copy queue and the direct queue on
+         * the compute queue, both on the GPU. The texture is left in COMMON.
+         */
+        bool Generate(Texture& texture, uint64_t uploadFence = 0);
+
+    private:
+        /**
+         * @brief Block until the previous submission has finished
+         */
+        void WaitForCompletion();
+
+    private:
+        bool m_Initialized = false;
+        DX12Core* m_Core = nullptr;
+
+        // Pipeline
+        ShaderBytecode m_ComputeShader;
+        RootSignature m_RootSignature;
+        ComputePipelineState m_PipelineState;
+
+        // Per-level SRV (source) and UAV (destination), rewritten each Generate
+        std::array<DescriptorHandle, MAX_MIP_LEVELS - 1> m_SourceViews;
+        std::array<DescriptorHandle, MAX_MIP_LEVELS - 1> m_DestViews;
+
+        // Standalone submission on the compute queue
+        CommandList m_CommandList;
+        uint64_t m_FenceValue = 0;  ///< ComputeQueue value of the last Generate
+    };
+
+} // namespace SM
@@ -0,0 +1,555 @@
+#include "renderer/PipelineCache.h"
+#include "renderer/DX12Core.h"
+#include "core/FileSystem.h"
+
+#include <cstring>
+#include <iostream>
+#include <string_view>
+
+namespace SM
+{
+    namespace
+    {
+        constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+        template<typename T>
+        void HashValue(uint64_t& hash, const T& value)
+        {
+            hash = HashBytes(&value, sizeof(T), hash);
+        }
+
+        template<typename... T>
+        void HashValues(uint64_t& hash, const T&... values)
+        {
+            (HashValue(hash, values), ...);
+        }
+
+        void HashString(uint64_t& hash, const char* text)
+        {
+            std::string_view view = text ? text : "";
+            HashValue(hash, static_cast<uint32_t>(view.size()));
+            hash = HashBytes(view.data(), view.size(), hash);
+        }
+
+        void HashShader(uint64_t& hash, const D3D12_SHADER_BYTECODE& shader)
+        {
+            HashValue(hash, static_cast<uint64_t>(shader.BytecodeLength));
+            hash = HashBytes(shader.pShaderBytecode, shader.BytecodeLength, hash);
+        }
+
+        // Structs are hashed field by field; their padding is not guaranteed to be zeroed
+        void HashBlend(uint64_t& hash, const D3D12_BLEND_DESC& blend)
+        {
+            HashValues(hash, blend.AlphaToCoverageEnable, blend.IndependentBlendEnable);
+            for (const D3D12_RENDER_TARGET_BLEND_DESC& rt : blend.RenderTarget)
+            {
+                HashValues(hash, rt.BlendEnable, rt.LogicOpEnable, rt.SrcBlend, rt.DestBlend, rt.BlendOp,
+                           rt.SrcBlendAlpha, rt.DestBlendAlpha, rt.BlendOpAlpha, rt.LogicOp,
+                           rt.RenderTargetWriteMask);
+            }
+        }
+
+        void HashRasterizer(uint64_t& hash, const D3D12_RASTERIZER_DESC& raster)
+        {
+            HashValues(hash, raster.FillMode, raster.CullMode, raster.FrontCounterClockwise, raster.DepthBias,
+                       raster.DepthBiasClamp, raster.SlopeScaledDepthBias, raster.DepthClipEnable,
+                       raster.MultisampleEnable, raster.AntialiasedLineEnable, raster.ForcedSampleCount,
+                       raster.ConservativeRaster);
+        }
+
+        void HashStencilOp(uint64_t& hash, const D3D12_DEPTH_STENCILOP_DESC& op)
+        {
+            HashValues(hash, op.StencilFailOp, op.StencilDepthFailOp, op.StencilPassOp, op.StencilFunc);
+        }
+
+        void HashDepthStencil(uint64_t& hash, const D3D12_DEPTH_STENCIL_DESC& depth)
+        {
+            HashValues(hash, depth.DepthEnable, depth.DepthWriteMask, depth.DepthFunc, depth.StencilEnable,
+                       depth.StencilReadMask, depth.StencilWriteMask);
+            HashStencilOp(hash, depth.FrontFace);
+            HashStencilOp(hash, depth.BackFace);
+        }
+
+        std::string ToHex(uint64_t value)
+        {
+            static const char digits[] = "0123456789abcdef";
+            std::string text(16, '0');
+            for (int i = 15; i >= 0; --i)
+            {
+                text[i] = digits[value & 0xF];
+                value >>= 4;
+            }
+            return text;
+        }
+
+        template<typename T>
+        void Append(std::vector<uint8_t>& out, const T& value)
+        {
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+            out.insert(out.end(), bytes, bytes + sizeof(T));
+        }
+
+        template<typename T>
+        bool Read(const std::vector<uint8_t>& data, size_t& offset, T& value)
+        {
+            if (offset + sizeof(T) > data.size())
+            {
+                return false;
+            }
+            std::memcpy(&value, data.data() + offset, sizeof(T));
+            offset += sizeof(T);
+            return true;
+        }
+    }
+
+    // ============================================================================
+    // Hashing
+    // ============================================================================
+
+    uint64_t HashBytes(const void* data, size_t size, uint64_t hash)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= FNV_PRIME;
+        }
+        return hash;
+    }
+
+    uint64_t HashPipelineDesc(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, uint64_t rootSignatureHash)
+    {
+        uint64_t hash = CACHE_HASH_SEED;
+        HashValue(hash, rootSignatureHash);
+
+        HashShader(hash, desc.VS);
+        HashShader(hash, desc.PS);
+        HashShader(hash, desc.DS);
+        HashShader(hash, desc.HS);
+        HashShader(hash, desc.GS);
+
+        HashBlend(hash, desc.BlendState);
+        HashValue(hash, desc.SampleMask);
+        HashRasterizer(hash, desc.RasterizerState);
+        HashDepthStencil(hash, desc.DepthStencilState);
+
+        HashValue(hash, desc.InputLayout.NumElements);
+        for (UINT i = 0; i < desc.InputLayout.NumElements; ++i)
+        {
+            const D3D12_INPUT_ELEMENT_DESC& element = desc.InputLayout.pInputElementDescs[i];
+            HashString(hash, element.SemanticName);
+            HashValues(hash, element.SemanticIndex, element.Format, element.InputSlot, element.AlignedByteOffset,
+                       element.InputSlotClass, element.InstanceDataStepRate);
+        }
+
+        HashValues(hash, desc.IBStripCutValue, desc.PrimitiveTopologyType, desc.NumRenderTargets);
+        for (UINT i = 0; i < desc.NumRenderTargets; ++i)
+        {
+            HashValue(hash, desc.RTVFormats[i]);
+        }
+        HashValues(hash, desc.DSVFormat, desc.SampleDesc.Count, desc.SampleDesc.Quality, desc.NodeMask, desc.Flags);
+
+        return hash;
+    }
+
+    uint64_t HashPipelineDesc(const D3D12_COMPUTE_PIPELINE_STATE_DESC& desc, uint64_t rootSignatureHash)
+    {
+        uint64_t hash = CACHE_HASH_SEED;
+        HashValue(hash, rootSignatureHash);
+        HashShader(hash, desc.CS);
+        HashValues(hash, desc.NodeMask, desc.Flags);
+        return hash;
+    }
+
+    // ============================================================================
+    // ShaderIncludeHandler Implementation
+    // ============================================================================
+
+    ShaderIncludeHandler::ShaderIncludeHandler(std::string rootDirectory)
+        : m_RootDirectory(std::move(rootDirectory))
+    {
+    }
+
+    HRESULT __stdcall ShaderIncludeHandler::Open(
+        D3D_INCLUDE_TYPE includeType,
+        LPCSTR fileName,
+        LPCVOID parentData,
+        LPCVOID* data,
+        UINT* bytes)
+    {
+        (void)includeType;
+
+        std::string directory = m_RootDirectory;
+        auto parent = m_Directories.find(parentData);
+        if (parent != m_Directories.end())
+        {
+            directory = parent->second;
+        }
+
+        std::string path = FileSystem::CombinePath(directory, fileName);
+        std::vector<uint8_t> contents = FileSystem::ReadFile(path);
+        if (contents.empty())
+        {
+            return E_FAIL;
+        }
+
+        m_Dependencies.push_back({ path, HashBytes(contents.data(), contents.size()) });
+
+        m_Files.push_back(std::move(contents));
+        const std::vector<uint8_t>& file = m_Files.back();
+        m_Directories[file.data()] = FileSystem::GetDirectory(path);
+
+        *data = file.data();
+        *bytes = static_cast<UINT>(file.size());
+        return S_OK;
+    }
+
+    HRESULT __stdcall ShaderIncludeHandler::Close(LPCVOID data)
+    {
+        // Contents stay alive until the handler is destroyed
+        (void)data;
+        return S_OK;
+    }
+
+    // ============================================================================
+    // ShaderCache Implementation
+    // ============================================================================
+
+    ShaderCache& ShaderCache::Get()
+    {
+        static ShaderCache instance;
+        return instance;
+    }
+
+    bool ShaderCache::Initialize(const std::string& directory)
+    {
+        FileSystem::CreateDirectory(directory);
+        if (!FileSystem::IsDirectory(directory))
+        {
+            std::cerr << "[ShaderCache] Cannot use cache directory: " << directory << std::endl;
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Directory = directory;
+        return true;
+    }
+
+    void ShaderCache::SetPrecompiledDirectory(const std::string& directory)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_PrecompiledDirectory = directory;
+    }
+
+    std::string ShaderCache::GetPrecompiledName(
+        const std::string& filename,
+        const char* entryPoint,
+        const D3D_SHADER_MACRO* defines)
+    {
+        std::string name = FileSystem::GetFilenameWithoutExtension(filename) + "_" + entryPoint;
+        for (const D3D_SHADER_MACRO* define = defines; define && define->Name; ++define)
+        {
+            name += "_";
+            name += define->Name;
+            name += define->Definition ? define->Definition : "";
+        }
+        return name + ".cso";
+    }
+
+    bool ShaderCache::LoadPrecompiled(
+        const std::string& filename,
+        const char* entryPoint,
+        const D3D_SHADER_MACRO* defines,
+        ComPtr<ID3DBlob>& bytecode)
+    {
+        if (m_PrecompiledDirectory.empty())
+        {
+            return false;
+        }
+
+        std::string path = FileSystem::CombinePath(m_PrecompiledDirectory, GetPrecompiledName(filename, entryPoint, defines));
+        if (!FileSystem::FileExists(path))
+        {
+            return false;
+        }
+
+        // A source edited since the last build compiles at runtime instead
+        if (FileSystem::GetLastWriteTime(path) < FileSystem::GetLastWriteTime(filename))
+        {
+            return false;
+        }
+
+        // Copied once, from the mapped file straight into the blob
+        MappedFile file = FileSystem::MapFile(path);
+        if (!file.IsOpen() || FAILED(D3DCreateBlob(file.GetSize(), &bytecode)))
+        {
+            return false;
+        }
+
+        std::memcpy(bytecode->GetBufferPointer(), file.GetData(), file.GetSize());
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stats.Precompiled++;
+        return true;
+    }
+
+    uint64_t ShaderCache::ComputeKey(
+        const std::string& filename,
+        const char* entryPoint,
+        const char* target,
+        UINT flags,
+        const D3D_SHADER_MACRO* defines)
+    {
+        uint64_t hash = CACHE_HASH_SEED;
+        HashValue(hash, ENTRY_VERSION);
+        HashString(hash, filename.c_str());
+        HashString(hash, entryPoint);
+        HashString(hash, target);
+        HashValue(hash, flags);
+
+        for (const D3D_SHADER_MACRO* define = defines; define && define->Name; ++define)
+        {
+            HashString(hash, define->Name);
+            HashString(hash, define->Definition);
+        }
+
+        return hash;
+    }
+
+    std::string ShaderCache::GetEntryPath(uint64_t key) const
+    {
+        return FileSystem::CombinePath(m_Directory, ToHex(key) + ".shader");
+    }
+
+    bool ShaderCache::Load(uint64_t key, ComPtr<ID3DBlob>& bytecode)
+    {
+        std::vector<uint8_t> data = FileSystem::ReadFile(GetEntryPath(key));
+
+        size_t offset = 0;
+        EntryHeader header;
+        bool valid = !data.empty() && Read(data, offset, header) &&
+                     header.Magic == ENTRY_MAGIC && header.Version == ENTRY_VERSION && header.Key == key;
+
+        // Every source must still hash the same
+        bool stale = false;
+        for (uint32_t i = 0; valid && i < header.DependencyCount; ++i)
+        {
+            uint64_t contentHash = 0;
+            uint32_t pathLength = 0;
+            valid = Read(data, offset, contentHash) && Read(data, offset, pathLength) &&
+                    offset + pathLength <= data.size();
+            if (!valid)
+            {
+                break;
+            }
+
+            std::string path(reinterpret_cast<const char*>(data.data() + offset), pathLength);
+            offset += pathLength;
+
+            std::vector<uint8_t> contents = FileSystem::ReadFile(path);
+            if (contents.empty() || HashBytes(contents.data(), contents.size()) != contentHash)
+            {
+                stale = true;
+                valid = false;
+            }
+        }
+
+        valid = valid && header.BytecodeSize > 0 && offset + header.BytecodeSize <= data.size() &&
+                SUCCEEDED(D3DCreateBlob(header.BytecodeSize, &bytecode));
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (!valid)
+        {
+            m_Stats.Misses++;
+            m_Stats.Stale += stale ? 1 : 0;
+            return false;
+        }
+
+        std::memcpy(bytecode->GetBufferPointer(), data.data() + offset, header.BytecodeSize);
+        m_Stats.Hits++;
+        return true;
+    }
+
+    void ShaderCache::Store(uint64_t key, const std::vector<ShaderDependency>& dependencies, ID3DBlob* bytecode)
+    {
+        if (!bytecode)
+        {
+            return;
+        }
+
+        EntryHeader header;
+        header.Magic = ENTRY_MAGIC;
+        header.Version = ENTRY_VERSION;
+        header.Key = key;
+        header.DependencyCount = static_cast<uint32_t>(dependencies.size());
+        header.BytecodeSize = static_cast<uint32_t>(bytecode->GetBufferSize());
+
+        std::vector<uint8_t> data;
+        Append(data, header);
+        for (const ShaderDependency& dependency : dependencies)
+        {
+            Append(data, dependency.ContentHash);
+            Append(data, static_cast<uint32_t>(dependency.Path.size()));
+            data.insert(data.end(), dependency.Path.begin(), dependency.Path.end());
+        }
+
+        const uint8_t* code = static_cast<const uint8_t*>(bytecode->GetBufferPointer());
+        data.insert(data.end(), code, code + bytecode->GetBufferSize());
+
+        if (!FileSystem::WriteFile(GetEntryPath(key), data))
+        {
+            std::cerr << "[ShaderCache] Failed to write cache entry " << ToHex(key) << std::endl;
+        }
+    }
+
+    ShaderCacheStats ShaderCache::GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_Stats;
+    }
+
+    // ============================================================================
+    // PipelineLibrary Implementation
+    // ============================================================================
+
+    bool PipelineLibrary::Initialize(ID3D12Device* device, const std::string& path)
+    {
+        m_Path = path;
+        m_Dirty = false;
+
+        if (FAILED(device->QueryInterface(IID_PPV_ARGS(&m_Device))))
+        {
+            std::cerr << "[PipelineLibrary] ID3D12Device1 not available, PSOs will not be cached" << std::endl;
+            return false;
+        }
+
+        m_LibraryData = FileSystem::ReadFile(path);
+        if (!m_LibraryData.empty())
+        {
+            HRESULT hr = m_Device->CreatePipelineLibrary(m_LibraryData.data(), m_LibraryData.size(),
+                                                         IID_PPV_ARGS(&m_Library));
+            if (SUCCEEDED(hr))
+            {
+                std::cout << "[PipelineLibrary] Loaded " << path << " (" << m_LibraryData.size() << " bytes)" << std::endl;
+                return true;
+            }
+
+            // Written by another driver or adapter; start over and replace it on save
+            std::cout << "[PipelineLibrary] Discarding incompatible library " << path << std::endl;
+            m_LibraryData.clear();
+            m_Dirty = true;
+        }
+
+        HRESULT hr = m_Device->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&m_Library));
+        if (FAILED(hr))
+        {
+            // Some tools and drivers report DXGI_ERROR_UNSUPPORTED
+            std::cerr << "[PipelineLibrary] Pipeline libraries unsupported, PSOs will not be cached" << std::endl;
+            m_Device.Reset();
+            return false;
+        }
+
+        return true;
+    }
+
+    void PipelineLibrary::Shutdown()
+    {
+        Save();
+
+        m_Library.Reset();
+        m_LibraryData.clear();
+        m_Device.Reset();
+    }
+
+    bool PipelineLibrary::Save()
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (!m_Library || !m_Dirty)
+        {
+            return true;
+        }
+
+        std::vector<uint8_t> data(m_Library->GetSerializedSize());
+        if (!CheckHResult(m_Library->Serialize(data.data(), data.size()), "Failed to serialize pipeline library"))
+        {
+            return false;
+        }
+
+        FileSystem::CreateDirectory(FileSystem::GetDirectory(m_Path));
+        if (!FileSystem::WriteFile(m_Path, data))
+        {
+            std::cerr << "[PipelineLibrary] Failed to write " << m_Path << std::endl;
+            return false;
+        }
+
+        m_Dirty = false;
+        return true;
+    }
+
+    std::wstring PipelineLibrary::GetPipelineName(wchar_t kind, uint64_t key)
+    {
+        std::string hex = ToHex(key);
+        return kind + std::wstring(hex.begin(), hex.end());
+    }
+
+    void PipelineLibrary::StorePipeline(const std::wstring& name, ID3D12PipelineState* pso)
+    {
+        // Fails only if the name is taken, which needs a hash collision; the PSO is fine either way
+        if (SUCCEEDED(m_Library->StorePipeline(name.c_str(), pso)))
+        {
+            m_Dirty = true;
+        }
+        m_Stats.Created++;
+    }
+
+    HRESULT PipelineLibrary::CreateGraphicsPipeline(
+        uint64_t key,
+        const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc,
+        ComPtr<ID3D12PipelineState>& pso)
+    {
+        std::wstring name = GetPipelineName(L'G', key);
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        if (SUCCEEDED(m_Library->LoadGraphicsPipeline(name.c_str(), &desc, IID_PPV_ARGS(&pso))))
+        {
+            m_Stats.Loaded++;
+            return S_OK;
+        }
+
+        HRESULT hr = m_Device->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(&pso));
+        if (SUCCEEDED(hr))
+        {
+            StorePipeline(name, pso.Get());
+        }
+        return hr;
+    }
+
+    HRESULT PipelineLibrary::CreateComputePipeline(
+        uint64_t key,
+        const D3D12_COMPUTE_PIPELINE_STATE_DESC& desc,
+        ComPtr<ID3D12PipelineState>& pso)
+    {
+        std::wstring name = GetPipelineName(L'C', key);
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        if (SUCCEEDED(m_Library->LoadComputePipeline(name.c_str(), &desc, IID_PPV_ARGS(&pso))))
+        {
+            m_Stats.Loaded++;
+            return S_OK;
+        }
+
+        HRESULT hr = m_Device->CreateComputePipelineState(&desc, IID_PPV_ARGS(&pso));
+        if (SUCCEEDED(hr))
+        {
+            StorePipeline(name, pso.Get());
+        }
+        return hr;
+    }
+
+    PipelineLibraryStats PipelineLibrary::GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_Stats;
+    }
+
+} // namespace SM
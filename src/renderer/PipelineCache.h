@@ -0,0 +1,316 @@
+#pragma once
+
+/**
+ * @file PipelineCache.h
+ * @brief Persistent caches for compiled shaders and pipeline state objects
+ *
+ * ShaderCache keeps FXC bytecode on disk, keyed by source file, entry point,
+ * target, compile flags and defines. An entry is only reused while the
+ * source file and every file it includes still hash the same, so editing a
+ * shader recompiles it on the next launch. Ahead of that cache it can serve
+ * DXIL compiled offline by the ShatteredMoonShaders build target.
+ *
+ * PipelineLibrary wraps an ID3D12PipelineLibrary persisted to one file.
+ * PSOs are stored under a name hashed from their full description, so a
+ * changed state or shader misses and is added rather than loaded stale.
+ */
+
+#include <d3d12.h>
+#include <d3dcompiler.h>
+#include <wrl/client.h>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace SM
+{
+    using Microsoft::WRL::ComPtr;
+
+    // ============================================================================
+    // Hashing
+    // ============================================================================
+
+    constexpr uint64_t CACHE_HASH_SEED = 14695981039346656037ull;  ///< FNV-1a offset basis
+
+    /**
+     * @brief 64-bit FNV-1a over a byte range
+     * @param data Bytes to hash
+     * @param size Number of bytes
+     * @param hash Running hash to continue from
+     */
+    uint64_t HashBytes(const void* data, size_t size, uint64_t hash = CACHE_HASH_SEED);
+
+    /**
+     * @brief Hash everything in a graphics PSO description that affects the result
+     * @param desc Description with shaders and input layout set
+     * @param rootSignatureHash RootSignature::GetHash of desc.pRootSignature
+     *
+     * Pointers are followed (shader bytecode, semantic names), never hashed.
+     */
+    uint64_t HashPipelineDesc(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, uint64_t rootSignatureHash);
+
+    /**
+     * @brief Hash a compute PSO description
+     */
+    uint64_t HashPipelineDesc(const D3D12_COMPUTE_PIPELINE_STATE_DESC& desc, uint64_t rootSignatureHash);
+
+    // ============================================================================
+    // Shader Cache
+    // ============================================================================
+
+    /**
+     * @brief A file that contributed to a compiled shader
+     */
+    struct ShaderDependency
+    {
+        std::string Path;
+        uint64_t ContentHash = 0;
+    };
+
+    /**
+     * @brief Include handler that resolves like D3D_COMPILE_STANDARD_FILE_INCLUDE
+     *        and records every file it opens
+     *
+     * Includes resolve relative to the including file's directory.
+     */
+    class ShaderIncludeHandler : public ID3DInclude
+    {
+    public:
+        /**
+         * @param rootDirectory Directory of the file being compiled
+         */
+        explicit ShaderIncludeHandler(std::string rootDirectory);
+
+        HRESULT __stdcall Open(D3D_INCLUDE_TYPE includeType, LPCSTR fileName, LPCVOID parentData,
+                               LPCVOID* data, UINT* bytes) override;
+        HRESULT __stdcall Close(LPCVOID data) override;
+
+        /**
+         * @brief Get the files opened so far
+         */
+        const std::vector<ShaderDependency>& GetDependencies() const { return m_Dependencies; }
+
+    private:
+        std::string m_RootDirectory;
+        std::deque<std::vector<uint8_t>> m_Files;                   // Kept alive until compilation ends
+        std::unordered_map<const void*, std::string> m_Directories; // File contents -> its directory
+        std::vector<ShaderDependency> m_Dependencies;
+    };
+
+    /**
+     * @brief Shader cache activity for display
+     */
+    struct ShaderCacheStats
+    {
+        uint32_t Hits = 0;      ///< Shaders loaded from disk
+        uint32_t Misses = 0;    ///< Shaders compiled (no entry, or a stale one)
+        uint32_t Stale = 0;     ///< Of the misses, entries whose sources had changed
+        uint32_t Precompiled = 0; ///< Shaders loaded from offline-compiled DXIL
+    };
+
+    /**
+     * @brief On-disk cache of compiled shader bytecode
+     *
+     * Used by CompileShaderFromFile once initialized. Thread-safe.
+     */
+    class ShaderCache
+    {
+    public:
+        static constexpr uint32_t ENTRY_MAGIC = 0x43534D53;    ///< "SMSC"
+        static constexpr uint32_t ENTRY_VERSION = 1;
+
+        /**
+         * @brief Get the singleton instance
+         */
+        static ShaderCache& Get();
+
+        // Non-copyable
+        ShaderCache(const ShaderCache&) = delete;
+        ShaderCache& operator=(const ShaderCache&) = delete;
+
+        /**
+         * @brief Enable the cache
+         * @param directory Directory holding one file per compiled shader
+         * @return true if the directory is usable
+         */
+        bool Initialize(const std::string& directory);
+
+        /**
+         * @brief Check if the cache is enabled
+         */
+        bool IsInitialized() const { return !m_Directory.empty(); }
+
+        /**
+         * @brief Serve offline-compiled bytecode before the cache and the compiler
+         * @param directory Directory of the build's .cso files
+         *
+         * Only enable this on devices that support the offline target's
+         * shader model (6.0).
+         */
+        void SetPrecompiledDirectory(const std::string& directory);
+
+        /**
+         * @brief Get the file name the offline build gives one compilation
+         * @return "<stem>_<entry>" followed by "_<NAME><value>" per define, plus ".cso"
+         *
+         * Defines must be passed in the order the build lists them.
+         */
+        static std::string GetPrecompiledName(const std::string& filename, const char* entryPoint,
+                                              const D3D_SHADER_MACRO* defines);
+
+        /**
+         * @brief Load offline-compiled bytecode if it exists and is not older than its source
+         * @return true on a hit
+         */
+        bool LoadPrecompiled(const std::string& filename, const char* entryPoint, const D3D_SHADER_MACRO* defines,
+                             ComPtr<ID3DBlob>& bytecode);
+
+        /**
+         * @brief Compute the key of one compilation
+         */
+        static uint64_t ComputeKey(const std::string& filename, const char* entryPoint, const char* target,
+                                   UINT flags, const D3D_SHADER_MACRO* defines);
+
+        /**
+         * @brief Load bytecode if an entry exists and its sources are unchanged
+         * @param key Key from ComputeKey
+         * @param bytecode Receives the bytecode on a hit
+         * @return true on a hit
+         */
+        bool Load(uint64_t key, ComPtr<ID3DBlob>& bytecode);
+
+        /**
+         * @brief Write an entry for freshly compiled bytecode
+         * @param key Key from ComputeKey
+         * @param dependencies The source file followed by everything it included
+         * @param bytecode Compiled shader
+         */
+        void Store(uint64_t key, const std::vector<ShaderDependency>& dependencies, ID3DBlob* bytecode);
+
+        /**
+         * @brief Get cache activity since startup
+         */
+        ShaderCacheStats GetStats() const;
+
+    private:
+        ShaderCache() = default;
+
+        std::string GetEntryPath(uint64_t key) const;
+
+        struct EntryHeader
+        {
+            uint32_t Magic = 0;
+            uint32_t Version = 0;
+            uint64_t Key = 0;
+            uint32_t DependencyCount = 0;
+            uint32_t BytecodeSize = 0;
+        };
+
+    private:
+        std::string m_Directory;
+        std::string m_PrecompiledDirectory;
+        mutable std::mutex m_Mutex;
+        ShaderCacheStats m_Stats;
+    };
+
+    // ============================================================================
+    // Pipeline Library
+    // ============================================================================
+
+    /**
+     * @brief Pipeline library activity for display
+     */
+    struct PipelineLibraryStats
+    {
+        uint32_t Loaded = 0;    ///< PSOs loaded from the library
+        uint32_t Created = 0;   ///< PSOs created from scratch and added
+    };
+
+    /**
+     * @brief ID3D12PipelineLibrary persisted to disk
+     *
+     * Owned by DX12Core and used by the pipeline state builders. A library
+     * written by a different driver or adapter is discarded and rebuilt.
+     * Thread-safe.
+     */
+    class PipelineLibrary
+    {
+    public:
+        PipelineLibrary() = default;
+        ~PipelineLibrary() = default;
+
+        // Non-copyable
+        PipelineLibrary(const PipelineLibrary&) = delete;
+        PipelineLibrary& operator=(const PipelineLibrary&) = delete;
+
+        /**
+         * @brief Open the library file, or start an empty library
+         * @param device D3D12 device (needs ID3D12Device1)
+         * @param path Library file
+         * @return true if the library is usable
+         */
+        bool Initialize(ID3D12Device* device, const std::string& path);
+
+        /**
+         * @brief Save if anything was added, then release the library
+         */
+        void Shutdown();
+
+        /**
+         * @brief Write the library to disk if anything was added since the last save
+         * @return false if writing failed
+         */
+        bool Save();
+
+        /**
+         * @brief Check if the library is usable
+         */
+        bool IsInitialized() const { return m_Library != nullptr; }
+
+        /**
+         * @brief Load a graphics PSO, or create and add it
+         * @param key HashPipelineDesc of desc
+         * @param desc Full description
+         * @param pso Receives the pipeline state
+         * @return Result of the load, or of the creation on a miss
+         */
+        HRESULT CreateGraphicsPipeline(uint64_t key, const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc,
+                                       ComPtr<ID3D12PipelineState>& pso);
+
+        /**
+         * @brief Load a compute PSO, or create and add it
+         */
+        HRESULT CreateComputePipeline(uint64_t key, const D3D12_COMPUTE_PIPELINE_STATE_DESC& desc,
+                                      ComPtr<ID3D12PipelineState>& pso);
+
+        /**
+         * @brief Get library activity since startup
+         */
+        PipelineLibraryStats GetStats() const;
+
+    private:
+        /**
+         * @brief Library name of a PSO ('G'raphics or 'C'ompute, then the key in hex)
+         */
+        static std::wstring GetPipelineName(wchar_t kind, uint64_t key);
+
+        /**
+         * @brief Add a newly created PSO under its name
+         */
+        void StorePipeline(const std::wstring& name, ID3D12PipelineState* pso);
+
+    private:
+        ComPtr<ID3D12Device1> m_Device;
+        ComPtr<ID3D12PipelineLibrary> m_Library;
+        std::vector<uint8_t> m_LibraryData;     // Backs m_Library; must outlive it
+        std::string m_Path;
+        bool m_Dirty = false;
+
+        mutable std::mutex m_Mutex;
+        PipelineLibraryStats m_Stats;
+    };
+
+} // namespace SM
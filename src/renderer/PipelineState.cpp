@@ -1,5 +1,6 @@
 #include "renderer/PipelineState.h"
 #include "renderer/RootSignature.h"
+#include "core/FileSystem.h"
 
 #include <iostream>
 #include <fstream>
@@ -15,7 +16,8 @@ namespace SM
         const std::wstring& filename,
         const char* entryPoint,
         const char* target,
-        ShaderBytecode& bytecode)
+        ShaderBytecode& bytecode,
+        const D3D_SHADER_MACRO* defines)
     {
         UINT compileFlags = 0;
 
@@ -25,11 +27,41 @@ namespace SM
         compileFlags = D3DCOMPILE_OPTIMIZATION_LEVEL3;
 #endif
 
+        std::string path = FileSystem::WStringToString(filename);
+
+        ShaderCache& cache = ShaderCache::Get();
+        if (cache.LoadPrecompiled(path, entryPoint, defines, bytecode.Blob))
+        {
+            return true;
+        }
+
+        uint64_t cacheKey = 0;
+        if (cache.IsInitialized())
+        {
+            cacheKey = ShaderCache::ComputeKey(path, entryPoint, target, compileFlags, defines);
+            if (cache.Load(cacheKey, bytecode.Blob))
+            {
+                return true;
+            }
+        }
+
+        // Read the source ourselves so the cache hashes exactly what was compiled
+        std::vector<uint8_t> source = FileSystem::ReadFile(filename);
+        if (source.empty())
+        {
+            std::cerr << "[DX12] Failed to open shader file: " << path << std::endl;
+            return false;
+        }
+
+        ShaderIncludeHandler includeHandler(FileSystem::GetDirectory(path));
+
         ComPtr<ID3DBlob> error;
-        HRESULT hr = D3DCompileFromFile(
-            filename.c_str(),
-            nullptr,
-            D3D_COMPILE_STANDARD_FILE_INCLUDE,
+        HRESULT hr = D3DCompile(
+            source.data(),
+            source.size(),
+            path.c_str(),
+            defines,
+            &includeHandler,
             entryPoint,
             target,
             compileFlags,
@@ -45,13 +77,18 @@ namespace SM
                 std::cerr << "[DX12] Shader compilation failed: "
                           << static_cast<const char*>(error->GetBufferPointer()) << std::endl;
             }
-            else
-            {
-                std::cerr << "[DX12] Failed to open shader file!" << std::endl;
-            }
             return false;
         }
 
+        if (cache.IsInitialized())
+        {
+            std::vector<ShaderDependency> dependencies;
+            dependencies.push_back({ path, HashBytes(source.data(), source.size()) });
+            dependencies.insert(dependencies.end(), includeHandler.GetDependencies().begin(),
+                                includeHandler.GetDependencies().end());
+            cache.Store(cacheKey, dependencies, bytecode.Blob.Get());
+        }
+
         return true;
     }
 
@@ -128,11 +165,45 @@ namespace SM
     // GraphicsPipelineState Implementation
     // ============================================================================
 
+    namespace
+    {
+        /**
+         * @brief One pipeline state stream subobject (type tag followed by its value)
+         */
+        template <D3D12_PIPELINE_STATE_SUBOBJECT_TYPE Type, typename T>
+        struct alignas(void*) StreamSubobject
+        {
+            D3D12_PIPELINE_STATE_SUBOBJECT_TYPE SubobjectType = Type;
+            T Value = {};
+        };
+
+        /**
+         * @brief Stream layout of a mesh pipeline
+         */
+        struct MeshPipelineStream
+        {
+            StreamSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_ROOT_SIGNATURE, ID3D12RootSignature*> RootSignature;
+            StreamSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_AS, D3D12_SHADER_BYTECODE> AS;
+            StreamSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_MS, D3D12_SHADER_BYTECODE> MS;
+            StreamSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_PS, D3D12_SHADER_BYTECODE> PS;
+            StreamSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_BLEND, D3D12_BLEND_DESC> Blend;
+            StreamSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_SAMPLE_MASK, UINT> SampleMask;
+            StreamSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_RASTERIZER, D3D12_RASTERIZER_DESC> Rasterizer;
+            StreamSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DEPTH_STENCIL, D3D12_DEPTH_STENCIL_DESC> DepthStencil;
+            StreamSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_PRIMITIVE_TOPOLOGY, D3D12_PRIMITIVE_TOPOLOGY_TYPE> Topology;
+            StreamSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_RENDER_TARGET_FORMATS, D3D12_RT_FORMAT_ARRAY> RenderTargets;
+            StreamSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DEPTH_STENCIL_FORMAT, DXGI_FORMAT> DepthStencilFormat;
+            StreamSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_SAMPLE_DESC, DXGI_SAMPLE_DESC> SampleDesc;
+        };
+    }
+
     GraphicsPipelineState& GraphicsPipelineState::Begin()
     {
         m_PipelineState.Reset();
         m_InputElements.clear();
         m_SemanticNames.clear();
+        m_AmplificationShader = {};
+        m_MeshShader = {};
 
         // Initialize with defaults
         m_Desc = {};
@@ -195,12 +266,15 @@ namespace SM
     GraphicsPipelineState& GraphicsPipelineState::SetRootSignature(ID3D12RootSignature* rootSignature)
     {
         m_Desc.pRootSignature = rootSignature;
+        m_RootSignatureHash = 0;
         return *this;
     }
 
     GraphicsPipelineState& GraphicsPipelineState::SetRootSignature(const RootSignature& rootSignature)
     {
-        return SetRootSignature(rootSignature.GetNative());
+        m_Desc.pRootSignature = rootSignature.GetNative();
+        m_RootSignatureHash = rootSignature.GetHash();
+        return *this;
     }
 
     GraphicsPipelineState& GraphicsPipelineState::SetVertexShader(const ShaderBytecode& bytecode)
@@ -233,6 +307,18 @@ namespace SM
         return *this;
     }
 
+    GraphicsPipelineState& GraphicsPipelineState::SetAmplificationShader(const ShaderBytecode& bytecode)
+    {
+        m_AmplificationShader = bytecode.GetBytecode();
+        return *this;
+    }
+
+    GraphicsPipelineState& GraphicsPipelineState::SetMeshShader(const ShaderBytecode& bytecode)
+    {
+        m_MeshShader = bytecode.GetBytecode();
+        return *this;
+    }
+
     GraphicsPipelineState& GraphicsPipelineState::AddInputElement(
         const char* semanticName,
         uint32_t semanticIndex,
@@ -449,13 +535,31 @@ namespace SM
     {
         assert(core != nullptr && "DX12Core cannot be null!");
 
+        if (m_MeshShader.pShaderBytecode)
+        {
+            return BuildMeshPipeline(core);
+        }
+
+        // Semantic strings may have moved as elements were added; re-point them
+        for (size_t i = 0; i < m_InputElements.size(); ++i)
+        {
+            m_InputElements[i].SemanticName = m_SemanticNames[i].c_str();
+        }
+
         // Set input layout
         m_Desc.InputLayout.NumElements = static_cast<UINT>(m_InputElements.size());
         m_Desc.InputLayout.pInputElementDescs = m_InputElements.empty() ? nullptr : m_InputElements.data();
 
-        ID3D12Device* device = core->GetDevice();
-
-        HRESULT hr = device->CreateGraphicsPipelineState(&m_Desc, IID_PPV_ARGS(&m_PipelineState));
+        HRESULT hr;
+        PipelineLibrary& library = core->GetPipelineLibrary();
+        if (library.IsInitialized() && m_RootSignatureHash != 0)
+        {
+            hr = library.CreateGraphicsPipeline(HashPipelineDesc(m_Desc, m_RootSignatureHash), m_Desc, m_PipelineState);
+        }
+        else
+        {
+            hr = core->GetDevice()->CreateGraphicsPipelineState(&m_Desc, IID_PPV_ARGS(&m_PipelineState));
+        }
 
         if (!CheckHResult(hr, "Failed to create graphics pipeline state"))
         {
@@ -465,9 +569,104 @@ namespace SM
         return true;
     }
 
+    bool GraphicsPipelineState::BuildMeshPipeline(DX12Core* core)
+    {
+        ComPtr<ID3D12Device2> device2;
+        if (FAILED(core->GetDevice()->QueryInterface(IID_PPV_ARGS(&device2))))
+        {
+            std::cerr << "[DX12] Mesh pipelines require ID3D12Device2" << std::endl;
+            return false;
+        }
+
+        MeshPipelineStream stream;
+        stream.RootSignature.Value = m_Desc.pRootSignature;
+        stream.AS.Value = m_AmplificationShader;
+        stream.MS.Value = m_MeshShader;
+        stream.PS.Value = m_Desc.PS;
+        stream.Blend.Value = m_Desc.BlendState;
+        stream.SampleMask.Value = m_Desc.SampleMask;
+        stream.Rasterizer.Value = m_Desc.RasterizerState;
+        stream.DepthStencil.Value = m_Desc.DepthStencilState;
+        stream.Topology.Value = m_Desc.PrimitiveTopologyType;
+        stream.RenderTargets.Value.NumRenderTargets = m_Desc.NumRenderTargets;
+        for (uint32_t i = 0; i < 8; ++i)
+        {
+            stream.RenderTargets.Value.RTFormats[i] = m_Desc.RTVFormats[i];
+        }
+        stream.DepthStencilFormat.Value = m_Desc.DSVFormat;
+        stream.SampleDesc.Value = m_Desc.SampleDesc;
+
+        D3D12_PIPELINE_STATE_STREAM_DESC streamDesc = {};
+        streamDesc.SizeInBytes = sizeof(stream);
+        streamDesc.pPipelineStateSubobjectStream = &stream;
+
+        HRESULT hr = device2->CreatePipelineState(&streamDesc, IID_PPV_ARGS(&m_PipelineState));
+        return CheckHResult(hr, "Failed to create mesh pipeline state");
+    }
+
+    // ============================================================================
+    // ComputePipelineState Implementation
+    // ============================================================================
+
+    ComputePipelineState& ComputePipelineState::Begin()
+    {
+        m_PipelineState.Reset();
+        m_Desc = {};
+        m_Desc.NodeMask = 0;
+        m_Desc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
+        return *this;
+    }
+
+    ComputePipelineState& ComputePipelineState::SetRootSignature(ID3D12RootSignature* rootSignature)
+    {
+        m_Desc.pRootSignature = rootSignature;
+        m_RootSignatureHash = 0;
+        return *this;
+    }
+
+    ComputePipelineState& ComputePipelineState::SetRootSignature(const RootSignature& rootSignature)
+    {
+        m_Desc.pRootSignature = rootSignature.GetNative();
+        m_RootSignatureHash = rootSignature.GetHash();
+        return *this;
+    }
+
+    ComputePipelineState& ComputePipelineState::SetComputeShader(const ShaderBytecode& bytecode)
+    {
+        m_Desc.CS = bytecode.GetBytecode();
+        return *this;
+    }
+
+    bool ComputePipelineState::Build(DX12Core* core)
+    {
+        assert(core != nullptr && "DX12Core cannot be null!");
+
+        HRESULT hr;
+        PipelineLibrary& library = core->GetPipelineLibrary();
+        if (library.IsInitialized() && m_RootSignatureHash != 0)
+        {
+            hr = library.CreateComputePipeline(HashPipelineDesc(m_Desc, m_RootSignatureHash), m_Desc, m_PipelineState);
+        }
+        else
+        {
+            hr = core->GetDevice()->CreateComputePipelineState(&m_Desc, IID_PPV_ARGS(&m_PipelineState));
+        }
+
+        if (!CheckHResult(hr, "Failed to create compute pipeline state"))
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    // ============================================================================
+    // Helper Functions
+    // ============================================================================
+
     bool CreateBasicPipelineState(
         DX12Core* core,
-        ID3D12RootSignature* rootSignature,
+        const RootSignature& rootSignature,
         const ShaderBytecode& vs,
         const ShaderBytecode& ps,
         GraphicsPipelineState& pso)
@@ -480,7 +679,8 @@ namespace SM
             .SetStandardInputLayout()
             .SetRasterizer(FillMode::Solid, CullMode::Back)
             .SetBlendMode(BlendMode::Opaque)
-            .SetDepthStencil(true, true, DepthFunc::Less)
+            // LESS_EQUAL so surfaces already laid down by a depth pre-pass still shade
+            .SetDepthStencil(true, true, DepthFunc::LessEqual)
             .SetRenderTargetFormat(core->GetBackBufferFormat())
             .SetDepthStencilFormat(core->GetDepthFormat())
             .Build(core);
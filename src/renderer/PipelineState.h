@@ -4,8 +4,8 @@
  * @file PipelineState.h
  * @brief DirectX 12 Pipeline State Object builder
  *
- * Provides a fluent interface for building graphics pipeline state objects
- * with proper defaults and common configurations.
+ * Provides a fluent interface for building graphics and compute pipeline
+ * state objects with proper defaults and common configurations.
  */
 
 #include "renderer/DX12Core.h"
@@ -45,13 +45,19 @@ namespace SM
      * @param entryPoint Entry point function name
      * @param target Shader target (e.g., "vs_5_1", "ps_5_1")
      * @param bytecode Output shader bytecode
+     * @param defines Null-terminated macro list (optional)
      * @return true if successful
+     *
+     * Prefers offline-compiled DXIL when the ShaderCache has a precompiled
+     * directory, then the ShaderCache's FXC entries, so unchanged shaders
+     * load their bytecode instead of compiling.
      */
     bool CompileShaderFromFile(
         const std::wstring& filename,
         const char* entryPoint,
         const char* target,
-        ShaderBytecode& bytecode
+        ShaderBytecode& bytecode,
+        const D3D_SHADER_MACRO* defines = nullptr
     );
 
     /**
@@ -210,6 +216,23 @@ namespace SM
          */
         GraphicsPipelineState& SetDomainShader(const ShaderBytecode& bytecode);
 
+        /**
+         * @brief Set amplification shader (optional, mesh pipelines only)
+         * @param bytecode Compiled amplification shader (SM 6.5)
+         * @return Reference to this builder
+         */
+        GraphicsPipelineState& SetAmplificationShader(const ShaderBytecode& bytecode);
+
+        /**
+         * @brief Set mesh shader, making this a mesh pipeline
+         * @param bytecode Compiled mesh shader (SM 6.5)
+         * @return Reference to this builder
+         *
+         * Mesh pipelines ignore the vertex, hull, domain and geometry shaders
+         * and the input layout. Check DX12Core::AreMeshShadersSupported first.
+         */
+        GraphicsPipelineState& SetMeshShader(const ShaderBytecode& bytecode);
+
         /**
          * @brief Add input element to the input layout
          * @param semanticName Semantic name (e.g., "POSITION")
@@ -351,6 +374,12 @@ namespace SM
          * @brief Build and finalize the pipeline state
          * @param core DX12 core reference
          * @return true if successful
+         *
+         * Loads from the core's pipeline library when the root signature was
+         * set from a RootSignature wrapper; raw signatures cannot be
+         * identified across runs and always build from scratch. Mesh
+         * pipelines are built from a pipeline state stream and always build
+         * from scratch.
          */
         bool Build(DX12Core* core);
 
@@ -364,15 +393,95 @@ namespace SM
          */
         bool IsValid() const { return m_PipelineState != nullptr; }
 
+    private:
+        /**
+         * @brief Build a mesh pipeline from the shared state in m_Desc
+         */
+        bool BuildMeshPipeline(DX12Core* core);
+
     private:
         ComPtr<ID3D12PipelineState> m_PipelineState;
         D3D12_GRAPHICS_PIPELINE_STATE_DESC m_Desc = {};
+        uint64_t m_RootSignatureHash = 0;   // 0 = unknown, bypasses the pipeline library
+
+        // Mesh pipeline stages (no slot in the graphics desc)
+        D3D12_SHADER_BYTECODE m_AmplificationShader = {};
+        D3D12_SHADER_BYTECODE m_MeshShader = {};
 
         // Store input elements (must persist until Build)
         std::vector<D3D12_INPUT_ELEMENT_DESC> m_InputElements;
         std::vector<std::string> m_SemanticNames;  // Store names to keep pointers valid
     };
 
+    /**
+     * @brief Compute Pipeline State builder
+     *
+     * Provides a fluent interface for building D3D12 compute PSOs.
+     */
+    class ComputePipelineState
+    {
+    public:
+        ComputePipelineState() = default;
+        ~ComputePipelineState() = default;
+
+        // Prevent copying
+        ComputePipelineState(const ComputePipelineState&) = delete;
+        ComputePipelineState& operator=(const ComputePipelineState&) = delete;
+
+        // Allow moving
+        ComputePipelineState(ComputePipelineState&&) noexcept = default;
+        ComputePipelineState& operator=(ComputePipelineState&&) noexcept = default;
+
+        /**
+         * @brief Begin building a new pipeline state
+         * @return Reference to this builder
+         */
+        ComputePipelineState& Begin();
+
+        /**
+         * @brief Set root signature
+         * @param rootSignature Root signature to use
+         * @return Reference to this builder
+         */
+        ComputePipelineState& SetRootSignature(ID3D12RootSignature* rootSignature);
+
+        /**
+         * @brief Set root signature from wrapper
+         */
+        ComputePipelineState& SetRootSignature(const RootSignature& rootSignature);
+
+        /**
+         * @brief Set compute shader
+         * @param bytecode Shader bytecode
+         * @return Reference to this builder
+         */
+        ComputePipelineState& SetComputeShader(const ShaderBytecode& bytecode);
+
+        /**
+         * @brief Build and finalize the pipeline state
+         * @param core DX12 core reference
+         * @return true if successful
+         *
+         * Uses the pipeline library like GraphicsPipelineState::Build.
+         */
+        bool Build(DX12Core* core);
+
+        /**
+         * @brief Get the native pipeline state object
+         */
+        ID3D12PipelineState* GetNative() const { return m_PipelineState.Get(); }
+
+        /**
+         * @brief Check if PSO is valid
+         */
+        bool IsValid() const { return m_PipelineState != nullptr; }
+
+    private:
+        ComPtr<ID3D12PipelineState> m_PipelineState;
+        D3D12_COMPUTE_PIPELINE_STATE_DESC m_Desc = {};
+        uint64_t m_RootSignatureHash = 0;   // 0 = unknown, bypasses the pipeline library
+    };
+
     /**
      * @brief Create a basic opaque pipeline state
      * @param core DX12 core reference
@@ -384,7 +493,7 @@ namespace SM
      */
     bool CreateBasicPipelineState(
         DX12Core* core,
-        ID3D12RootSignature* rootSignature,
+        const RootSignature& rootSignature,
         const ShaderBytecode& vs,
         const ShaderBytecode& ps,
         GraphicsPipelineState& pso
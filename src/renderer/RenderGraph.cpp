@@ -0,0 +1,839 @@
+#include "renderer/RenderGraph.h"
+#include "renderer/CommandList.h"
+#include "renderer/Renderer.h"
+#include "core/Profiler.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <iostream>
+
+namespace SM
+{
+    namespace
+    {
+        /// Descriptor slots are allocated once per physical texture and never returned
+        constexpr uint32_t MAX_TRANSIENT_TEXTURES = 12;
+
+        uint64_t AlignOffset(uint64_t offset, uint64_t alignment)
+        {
+            return (offset + alignment - 1) & ~(alignment - 1);
+        }
+
+        bool IsWriteState(D3D12_RESOURCE_STATES state)
+        {
+            constexpr D3D12_RESOURCE_STATES WRITE_STATES =
+                D3D12_RESOURCE_STATE_RENDER_TARGET |
+                D3D12_RESOURCE_STATE_UNORDERED_ACCESS |
+                D3D12_RESOURCE_STATE_DEPTH_WRITE |
+                D3D12_RESOURCE_STATE_STREAM_OUT |
+                D3D12_RESOURCE_STATE_COPY_DEST |
+                D3D12_RESOURCE_STATE_RESOLVE_DEST;
+            return (state & WRITE_STATES) != 0;
+        }
+    }
+
+    // ============================================================================
+    // RGTextureDesc Implementation
+    // ============================================================================
+
+    RGTextureDesc RGTextureDesc::RenderTarget(uint32_t width, uint32_t height, DXGI_FORMAT format)
+    {
+        RGTextureDesc desc;
+        desc.Width = width;
+        desc.Height = height;
+        desc.Format = format;
+        desc.Flags = D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
+        desc.ClearValue.Format = format;
+        return desc;
+    }
+
+    RGTextureDesc RGTextureDesc::DepthStencil(uint32_t width, uint32_t height, DXGI_FORMAT format)
+    {
+        RGTextureDesc desc;
+        desc.Width = width;
+        desc.Height = height;
+        desc.Format = format;
+        desc.Flags = D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
+        desc.ClearValue.Format = format;
+        desc.ClearValue.DepthStencil.Depth = 1.0f;
+        desc.ClearValue.DepthStencil.Stencil = 0;
+        return desc;
+    }
+
+    bool RGTextureDesc::operator==(const RGTextureDesc& other) const
+    {
+        return Width == other.Width &&
+               Height == other.Height &&
+               Format == other.Format &&
+               Flags == other.Flags &&
+               std::memcmp(&ClearValue, &other.ClearValue, sizeof(ClearValue)) == 0;
+    }
+
+    // ============================================================================
+    // RenderGraphBuilder Implementation
+    // ============================================================================
+
+    RGResourceHandle RenderGraphBuilder::CreateTexture(const std::string& name, const RGTextureDesc& desc)
+    {
+        return m_Graph.CreateTransient(name, desc);
+    }
+
+    RGResourceHandle RenderGraphBuilder::Read(RGResourceHandle handle, D3D12_RESOURCE_STATES state)
+    {
+        m_Graph.AddAccess(m_PassIndex, handle, state, false);
+        return handle;
+    }
+
+    RGResourceHandle RenderGraphBuilder::Write(RGResourceHandle handle, D3D12_RESOURCE_STATES state)
+    {
+        m_Graph.AddAccess(m_PassIndex, handle, state, true);
+        return handle;
+    }
+
+    void RenderGraphBuilder::SetSideEffect()
+    {
+        m_Graph.m_Passes[m_PassIndex].HasSideEffect = true;
+    }
+
+    // ============================================================================
+    // RenderGraph Implementation
+    // ============================================================================
+
+    bool RenderGraph::Initialize(DX12Core* core)
+    {
+        assert(core != nullptr && "DX12Core cannot be null!");
+        m_Core = core;
+        Reset();
+        return true;
+    }
+
+    void RenderGraph::Shutdown()
+    {
+        // Frames in flight may still use the transients; the core drops them when they retire
+        if (m_Core)
+        {
+            for (PhysicalTexture& physical : m_Physical)
+            {
+                m_Core->DeferRelease(physical.Native);
+            }
+            m_Core->DeferRelease(m_TransientHeap);
+        }
+
+        Reset();
+        m_Physical.clear();
+        ReleaseViews();
+        m_TransientHeap.Reset();
+        m_TransientHeapSize = 0;
+        m_Core = nullptr;
+    }
+
+    void RenderGraph::Reset()
+    {
+        m_Passes.clear();
+        m_Resources.clear();
+        m_Compiled = false;
+    }
+
+    RGResourceHandle RenderGraph::ImportTexture(
+        const std::string& name,
+        ID3D12Resource* resource,
+        D3D12_RESOURCE_STATES currentState,
+        D3D12_RESOURCE_STATES finalState,
+        D3D12_CPU_DESCRIPTOR_HANDLE rtv,
+        D3D12_CPU_DESCRIPTOR_HANDLE dsv)
+    {
+        Resource imported;
+        imported.Name = name;
+        imported.IsImported = true;
+        imported.Native = resource;
+        imported.InitialState = currentState;
+        imported.FinalState = finalState;
+        imported.RTV = rtv;
+        imported.DSV = dsv;
+
+        RGResourceHandle handle;
+        handle.Index = static_cast<uint32_t>(m_Resources.size());
+        m_Resources.push_back(std::move(imported));
+        return handle;
+    }
+
+    RGResourceHandle RenderGraph::CreateTransient(const std::string& name, const RGTextureDesc& desc)
+    {
+        Resource transient;
+        transient.Name = name;
+        transient.Desc = desc;
+        transient.Desc.ClearValue.Format = desc.Format;
+
+        RGResourceHandle handle;
+        handle.Index = static_cast<uint32_t>(m_Resources.size());
+        m_Resources.push_back(std::move(transient));
+        return handle;
+    }
+
+    void RenderGraph::AddPass(const std::string& name, const SetupFunc& setup, ExecuteFunc execute)
+    {
+        Pass pass;
+        pass.Name = name;
+        pass.Execute = std::move(execute);
+
+        uint32_t passIndex = static_cast<uint32_t>(m_Passes.size());
+        m_Passes.push_back(std::move(pass));
+        m_Compiled = false;
+
+        if (setup)
+        {
+            RenderGraphBuilder builder(*this, passIndex);
+            setup(builder);
+        }
+    }
+
+    void RenderGraph::AddAccess(uint32_t passIndex, RGResourceHandle handle, D3D12_RESOURCE_STATES state, bool isWrite)
+    {
+        if (!handle.IsValid() || handle.Index >= m_Resources.size())
+        {
+            std::cerr << "[RenderGraph] Pass '" << m_Passes[passIndex].Name << "' used an invalid resource handle!" << std::endl;
+            return;
+        }
+
+        if (isWrite != IsWriteState(state))
+        {
+            std::cerr << "[RenderGraph] Pass '" << m_Passes[passIndex].Name << "' declared "
+                      << (isWrite ? "a write" : "a read") << " of '" << m_Resources[handle.Index].Name
+                      << "' with a " << (isWrite ? "read" : "write") << " state" << std::endl;
+        }
+
+        // One access per resource and pass: reads combine, a write decides the state
+        std::vector<Access>& accesses = m_Passes[passIndex].Accesses;
+        for (Access& access : accesses)
+        {
+            if (access.Resource != handle.Index)
+            {
+                continue;
+            }
+
+            if (isWrite)
+            {
+                access.State = state;
+                access.IsWrite = true;
+            }
+            else if (!access.IsWrite)
+            {
+                access.State |= state;
+            }
+            return;
+        }
+
+        Access access;
+        access.Resource = handle.Index;
+        access.State = state;
+        access.IsWrite = isWrite;
+        accesses.push_back(access);
+    }
+
+    bool RenderGraph::Compile()
+    {
+        m_FrameStats = RenderGraphStats();
+        m_FrameStats.PassCount = static_cast<uint32_t>(m_Passes.size());
+
+        CullPasses();
+        MergeReadStates();
+
+        if (!PlaceTransients())
+        {
+            return false;
+        }
+
+        // States at the start of the frame
+        for (Resource& resource : m_Resources)
+        {
+            resource.LastAccessWasWrite = false;
+            if (resource.IsImported)
+            {
+                resource.State = resource.InitialState;
+            }
+            else if (resource.Physical != RGResourceHandle::INVALID)
+            {
+                resource.State = m_Physical[resource.Physical].State;
+            }
+        }
+
+        m_Compiled = true;
+        return true;
+    }
+
+    void RenderGraph::CullPasses()
+    {
+        // Walk backwards; a pass is live if something later needs what it writes
+        std::vector<bool> needed(m_Resources.size(), false);
+
+        for (size_t i = m_Passes.size(); i-- > 0;)
+        {
+            Pass& pass = m_Passes[i];
+            bool live = pass.HasSideEffect;
+
+            for (const Access& access : pass.Accesses)
+            {
+                if (access.IsWrite && (m_Resources[access.Resource].IsImported || needed[access.Resource]))
+                {
+                    live = true;
+                }
+            }
+
+            pass.IsLive = live;
+            if (!live)
+            {
+                m_FrameStats.CulledPassCount++;
+                continue;
+            }
+
+            // Earlier writers of everything read here must run too
+            for (const Access& access : pass.Accesses)
+            {
+                if (!access.IsWrite)
+                {
+                    needed[access.Resource] = true;
+                }
+            }
+        }
+
+        // Lifetimes of transients over the live passes
+        for (Resource& resource : m_Resources)
+        {
+            resource.FirstPass = RGResourceHandle::INVALID;
+            resource.LastPass = 0;
+        }
+
+        for (uint32_t i = 0; i < m_Passes.size(); ++i)
+        {
+            if (!m_Passes[i].IsLive)
+            {
+                continue;
+            }
+
+            for (const Access& access : m_Passes[i].Accesses)
+            {
+                Resource& resource = m_Resources[access.Resource];
+                if (resource.FirstPass == RGResourceHandle::INVALID)
+                {
+                    resource.FirstPass = i;
+                }
+                resource.LastPass = i;
+            }
+        }
+    }
+
+    void RenderGraph::MergeReadStates()
+    {
+        // Passes that read a resource back to back share one combined read
+        // state, so the resource transitions once for the whole run
+        std::vector<std::vector<Access*>> runs(m_Resources.size());
+
+        auto flushRun = [](std::vector<Access*>& run) {
+            if (run.size() > 1)
+            {
+                D3D12_RESOURCE_STATES combined = D3D12_RESOURCE_STATE_COMMON;
+                for (const Access* access : run)
+                {
+                    combined |= access->State;
+                }
+                for (Access* access : run)
+                {
+                    access->State = combined;
+                }
+            }
+            run.clear();
+        };
+
+        for (Pass& pass : m_Passes)
+        {
+            if (!pass.IsLive)
+            {
+                continue;
+            }
+
+            for (Access& access : pass.Accesses)
+            {
+                std::vector<Access*>& run = runs[access.Resource];
+                if (access.IsWrite)
+                {
+                    flushRun(run);
+                }
+                else
+                {
+                    run.push_back(&access);
+                }
+            }
+        }
+
+        for (std::vector<Access*>& run : runs)
+        {
+            flushRun(run);
+        }
+    }
+
+    bool RenderGraph::PlaceTransients()
+    {
+        // Transients used by live passes, in creation order
+        std::vector<uint32_t> transients;
+        for (uint32_t i = 0; i < m_Resources.size(); ++i)
+        {
+            Resource& resource = m_Resources[i];
+            resource.Physical = RGResourceHandle::INVALID;
+            if (!resource.IsImported && resource.FirstPass != RGResourceHandle::INVALID)
+            {
+                transients.push_back(i);
+            }
+        }
+
+        if (transients.empty())
+        {
+            return true;
+        }
+
+        if (transients.size() > MAX_TRANSIENT_TEXTURES)
+        {
+            std::cerr << "[RenderGraph] Too many transient textures (" << transients.size()
+                      << ", max " << MAX_TRANSIENT_TEXTURES << ")" << std::endl;
+            return false;
+        }
+
+        ID3D12Device* device = m_Core->GetDevice();
+
+        std::vector<PhysicalTexture> layout(transients.size());
+        for (size_t i = 0; i < transients.size(); ++i)
+        {
+            D3D12_RESOURCE_DESC desc = ToResourceDesc(m_Resources[transients[i]].Desc);
+            D3D12_RESOURCE_ALLOCATION_INFO info = device->GetResourceAllocationInfo(0, 1, &desc);
+
+            layout[i].Desc = m_Resources[transients[i]].Desc;
+            layout[i].Size = info.SizeInBytes;
+            m_FrameStats.TransientUnaliasedSize += info.SizeInBytes;
+        }
+
+        // Largest first; each texture takes the lowest offset that does not
+        // collide with a placed texture whose lifetime overlaps its own
+        std::vector<uint32_t> order(transients.size());
+        for (uint32_t i = 0; i < order.size(); ++i)
+        {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(), [&layout](uint32_t a, uint32_t b) {
+            return layout[a].Size > layout[b].Size;
+        });
+
+        std::vector<uint32_t> placed;
+        std::vector<uint32_t> conflicts;
+        uint64_t heapSize = 0;
+
+        for (uint32_t index : order)
+        {
+            const Resource& resource = m_Resources[transients[index]];
+
+            conflicts.clear();
+            for (uint32_t other : placed)
+            {
+                const Resource& otherResource = m_Resources[transients[other]];
+                if (resource.FirstPass <= otherResource.LastPass && otherResource.FirstPass <= resource.LastPass)
+                {
+                    conflicts.push_back(other);
+                }
+            }
+            std::sort(conflicts.begin(), conflicts.end(), [&layout](uint32_t a, uint32_t b) {
+                return layout[a].Offset < layout[b].Offset;
+            });
+
+            uint64_t offset = 0;
+            for (uint32_t other : conflicts)
+            {
+                if (offset + layout[index].Size <= layout[other].Offset)
+                {
+                    break;
+                }
+                offset = std::max(offset, AlignOffset(layout[other].Offset + layout[other].Size,
+                                                      D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT));
+            }
+
+            layout[index].Offset = offset;
+            heapSize = std::max(heapSize, offset + layout[index].Size);
+            placed.push_back(index);
+        }
+
+        // Textures sharing memory need an aliasing barrier and a discard on first use
+        for (size_t a = 0; a < layout.size(); ++a)
+        {
+            for (size_t b = a + 1; b < layout.size(); ++b)
+            {
+                if (layout[a].Offset < layout[b].Offset + layout[b].Size &&
+                    layout[b].Offset < layout[a].Offset + layout[a].Size)
+                {
+                    layout[a].IsAliased = true;
+                    layout[b].IsAliased = true;
+                }
+            }
+        }
+
+        m_FrameStats.TransientCount = static_cast<uint32_t>(transients.size());
+        m_FrameStats.TransientHeapSize = std::max(heapSize, m_TransientHeapSize);
+
+        // Keep last frame's textures if the layout is unchanged
+        bool unchanged = layout.size() == m_Physical.size() && heapSize <= m_TransientHeapSize;
+        for (size_t i = 0; unchanged && i < layout.size(); ++i)
+        {
+            unchanged = layout[i].Desc == m_Physical[i].Desc && layout[i].Offset == m_Physical[i].Offset;
+        }
+
+        if (!unchanged && !CreatePhysicalTextures(layout, heapSize))
+        {
+            return false;
+        }
+
+        for (size_t i = 0; i < transients.size(); ++i)
+        {
+            m_Resources[transients[i]].Physical = static_cast<uint32_t>(i);
+        }
+        return true;
+    }
+
+    bool RenderGraph::CreatePhysicalTextures(const std::vector<PhysicalTexture>& layout, uint64_t heapSize)
+    {
+        ID3D12Device* device = m_Core->GetDevice();
+
+        // Earlier frames may still be using the old textures (resize, new passes);
+        // keep them alive until those frames retire instead of waiting
+        for (PhysicalTexture& physical : m_Physical)
+        {
+            m_Core->DeferRelease(physical.Native);
+        }
+        m_Physical.clear();
+
+        if (heapSize > m_TransientHeapSize)
+        {
+            m_Core->DeferRelease(m_TransientHeap);
+            m_TransientHeap.Reset();
+            m_TransientHeapSize = 0;
+
+            D3D12_HEAP_DESC heapDesc = {};
+            heapDesc.SizeInBytes = AlignOffset(heapSize, D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT);
+            heapDesc.Properties.Type = D3D12_HEAP_TYPE_DEFAULT;
+            heapDesc.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+            heapDesc.Flags = D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES;
+
+            HRESULT hr = device->CreateHeap(&heapDesc, IID_PPV_ARGS(&m_TransientHeap));
+            if (!CheckHResult(hr, "Failed to create transient render target heap"))
+            {
+                return false;
+            }
+
+            m_TransientHeapSize = heapDesc.SizeInBytes;
+            std::cout << "[RenderGraph] Transient heap: " << (m_TransientHeapSize / 1024) << " KB" << std::endl;
+        }
+
+        m_Physical = layout;
+        for (uint32_t i = 0; i < m_Physical.size(); ++i)
+        {
+            PhysicalTexture& physical = m_Physical[i];
+            D3D12_RESOURCE_DESC desc = ToResourceDesc(physical.Desc);
+
+            physical.State = physical.Desc.IsDepth() ? D3D12_RESOURCE_STATE_DEPTH_WRITE : D3D12_RESOURCE_STATE_RENDER_TARGET;
+            physical.IsNew = true;
+
+            HRESULT hr = device->CreatePlacedResource(
+                m_TransientHeap.Get(),
+                physical.Offset,
+                &desc,
+                physical.State,
+                &physical.Desc.ClearValue,
+                IID_PPV_ARGS(&physical.Native)
+            );
+
+            if (!CheckHResult(hr, "Failed to create transient texture"))
+            {
+                m_Physical.clear();
+                return false;
+            }
+
+            CreateViews(i);
+        }
+
+        return true;
+    }
+
+    void RenderGraph::CreateViews(uint32_t physicalIndex)
+    {
+        ID3D12Device* device = m_Core->GetDevice();
+        const PhysicalTexture& physical = m_Physical[physicalIndex];
+
+        if (m_PhysicalViews.size() <= physicalIndex)
+        {
+            m_PhysicalViews.resize(physicalIndex + 1);
+        }
+        PhysicalViews& views = m_PhysicalViews[physicalIndex];
+
+        if (physical.Desc.IsDepth())
+        {
+            if (!views.DSV.IsValid())
+            {
+                views.DSV = m_Core->GetDSVHeap().Allocate();
+            }
+
+            D3D12_DEPTH_STENCIL_VIEW_DESC dsvDesc = {};
+            dsvDesc.Format = physical.Desc.Format;
+            dsvDesc.ViewDimension = D3D12_DSV_DIMENSION_TEXTURE2D;
+            device->CreateDepthStencilView(physical.Native.Get(), &dsvDesc, views.DSV.CPU);
+
+            // Only D32 is stored typeless, matching the main depth buffer
+            if (physical.Desc.Format != DXGI_FORMAT_D32_FLOAT)
+            {
+                return;
+            }
+        }
+        else
+        {
+            if (!views.RTV.IsValid())
+            {
+                views.RTV = m_Core->GetRTVHeap().Allocate();
+            }
+            device->CreateRenderTargetView(physical.Native.Get(), nullptr, views.RTV.CPU);
+        }
+
+        // Frames in flight may still read the old SRV; its slot is only
+        // reused once they retire, so the new view goes into a fresh one
+        DescriptorHeap& heap = m_Core->GetCBVSRVUAVHeap();
+        heap.Free(views.SRV);
+        views.SRV = heap.Allocate();
+        const DescriptorHandle& srv = views.SRV;
+
+        D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+        srvDesc.Format = physical.Desc.IsDepth() ? DXGI_FORMAT_R32_FLOAT : physical.Desc.Format;
+        srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+        srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+        srvDesc.Texture2D.MipLevels = 1;
+        device->CreateShaderResourceView(physical.Native.Get(), &srvDesc, srv.CPU);
+    }
+
+    void RenderGraph::ReleaseViews()
+    {
+        if (m_Core)
+        {
+            for (const PhysicalViews& views : m_PhysicalViews)
+            {
+                m_Core->GetRTVHeap().Free(views.RTV);
+                m_Core->GetDSVHeap().Free(views.DSV);
+                m_Core->GetCBVSRVUAVHeap().Free(views.SRV);
+            }
+        }
+        m_PhysicalViews.clear();
+    }
+
+    void RenderGraph::Execute(Renderer& renderer)
+    {
+        SM_PROFILE_SCOPE("RenderGraph::Execute");
+
+        if (!m_Compiled && !Compile())
+        {
+            std::cerr << "[RenderGraph] Compile failed, skipping frame passes" << std::endl;
+            return;
+        }
+
+        for (uint32_t i = 0; i < m_Passes.size(); ++i)
+        {
+            Pass& pass = m_Passes[i];
+            if (!pass.IsLive)
+            {
+                continue;
+            }
+
+            // Timed on both timelines, barriers included
+            const char* passName = Profiler::Get().InternName(pass.Name);
+            SM_PROFILE_SCOPE(passName);
+
+            CommandList& list = renderer.GetCommandListWrapper();
+            uint32_t zone = list.BeginProfileZone(passName);
+            uint32_t barriers = 0;
+
+            for (const Access& access : pass.Accesses)
+            {
+                Resource& resource = m_Resources[access.Resource];
+                ID3D12Resource* native = GetResource({ access.Resource });
+                if (!native)
+                {
+                    continue;
+                }
+
+                // Another transient may have used this memory since the last frame
+                if (!resource.IsImported && resource.FirstPass == i && NeedsInitialization(resource))
+                {
+                    list.AliasingBarrier(nullptr, native);
+                    m_FrameStats.AliasingBarrierCount++;
+                    barriers++;
+                }
+
+                if (resource.State != access.State)
+                {
+                    list.TransitionBarrier(native, resource.State, access.State);
+                    m_FrameStats.TransitionCount++;
+                    barriers++;
+                }
+                else if (access.State == D3D12_RESOURCE_STATE_UNORDERED_ACCESS && resource.LastAccessWasWrite)
+                {
+                    list.UAVBarrier(native);
+                    barriers++;
+                }
+
+                resource.State = access.State;
+                resource.LastAccessWasWrite = access.IsWrite;
+            }
+
+            // All of the pass's barriers in one call
+            if (barriers > 0)
+            {
+                list.FlushBarriers();
+                m_FrameStats.BarrierBatchCount++;
+            }
+
+            // Aliased memory holds another texture's data; discard before first use
+            for (const Access& access : pass.Accesses)
+            {
+                const Resource& resource = m_Resources[access.Resource];
+                if (!resource.IsImported && resource.FirstPass == i && NeedsInitialization(resource) &&
+                    (access.State == D3D12_RESOURCE_STATE_RENDER_TARGET || access.State == D3D12_RESOURCE_STATE_DEPTH_WRITE))
+                {
+                    list.GetNative()->DiscardResource(m_Physical[resource.Physical].Native.Get(), nullptr);
+                }
+            }
+
+            if (pass.Execute)
+            {
+                pass.Execute(list, *this);
+            }
+
+            // RecordParallel may have moved the frame onto another list
+            renderer.GetCommandListWrapper().EndProfileZone(zone);
+        }
+
+        // Hand imported resources back in the state their owners expect
+        CommandList& list = renderer.GetCommandListWrapper();
+        uint32_t barriers = 0;
+
+        for (Resource& resource : m_Resources)
+        {
+            if (resource.IsImported)
+            {
+                if (resource.Native && resource.State != resource.FinalState)
+                {
+                    list.TransitionBarrier(resource.Native, resource.State, resource.FinalState);
+                    m_FrameStats.TransitionCount++;
+                    barriers++;
+                }
+                resource.State = resource.FinalState;
+            }
+            else if (resource.Physical != RGResourceHandle::INVALID)
+            {
+                m_Physical[resource.Physical].State = resource.State;
+                m_Physical[resource.Physical].IsNew = false;
+            }
+        }
+
+        if (barriers > 0)
+        {
+            list.FlushBarriers();
+            m_FrameStats.BarrierBatchCount++;
+        }
+
+        m_Stats = m_FrameStats;
+    }
+
+    ID3D12Resource* RenderGraph::GetResource(RGResourceHandle handle) const
+    {
+        if (!handle.IsValid() || handle.Index >= m_Resources.size())
+        {
+            return nullptr;
+        }
+
+        const Resource& resource = m_Resources[handle.Index];
+        if (resource.IsImported)
+        {
+            return resource.Native;
+        }
+        return resource.Physical != RGResourceHandle::INVALID ? m_Physical[resource.Physical].Native.Get() : nullptr;
+    }
+
+    D3D12_CPU_DESCRIPTOR_HANDLE RenderGraph::GetRTV(RGResourceHandle handle) const
+    {
+        if (!handle.IsValid() || handle.Index >= m_Resources.size())
+        {
+            return {};
+        }
+
+        const Resource& resource = m_Resources[handle.Index];
+        if (resource.IsImported)
+        {
+            return resource.RTV;
+        }
+        return resource.Physical != RGResourceHandle::INVALID ? m_PhysicalViews[resource.Physical].RTV.CPU
+                                                              : D3D12_CPU_DESCRIPTOR_HANDLE{};
+    }
+
+    D3D12_CPU_DESCRIPTOR_HANDLE RenderGraph::GetDSV(RGResourceHandle handle) const
+    {
+        if (!handle.IsValid() || handle.Index >= m_Resources.size())
+        {
+            return {};
+        }
+
+        const Resource& resource = m_Resources[handle.Index];
+        if (resource.IsImported)
+        {
+            return resource.DSV;
+        }
+        return resource.Physical != RGResourceHandle::INVALID ? m_PhysicalViews[resource.Physical].DSV.CPU
+                                                              : D3D12_CPU_DESCRIPTOR_HANDLE{};
+    }
+
+    DescriptorHandle RenderGraph::GetSRV(RGResourceHandle handle) const
+    {
+        if (!handle.IsValid() || handle.Index >= m_Resources.size())
+        {
+            return {};
+        }
+
+        const Resource& resource = m_Resources[handle.Index];
+        if (resource.IsImported || resource.Physical == RGResourceHandle::INVALID)
+        {
+            return {};
+        }
+        return m_PhysicalViews[resource.Physical].SRV;
+    }
+
+    const RGTextureDesc& RenderGraph::GetTextureDesc(RGResourceHandle handle) const
+    {
+        assert(handle.IsValid() && handle.Index < m_Resources.size());
+        return m_Resources[handle.Index].Desc;
+    }
+
+    bool RenderGraph::NeedsInitialization(const Resource& resource) const
+    {
+        const PhysicalTexture& physical = m_Physical[resource.Physical];
+        return physical.IsAliased || physical.IsNew;
+    }
+
+    D3D12_RESOURCE_DESC RenderGraph::ToResourceDesc(const RGTextureDesc& desc)
+    {
+        D3D12_RESOURCE_DESC resourceDesc = {};
+        resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+        resourceDesc.Alignment = 0;
+        resourceDesc.Width = desc.Width;
+        resourceDesc.Height = desc.Height;
+        resourceDesc.DepthOrArraySize = 1;
+        resourceDesc.MipLevels = 1;
+        // Typeless D32 storage so later passes can sample it, like the main depth buffer
+        resourceDesc.Format = (desc.Format == DXGI_FORMAT_D32_FLOAT) ? DXGI_FORMAT_R32_TYPELESS : desc.Format;
+        resourceDesc.SampleDesc.Count = 1;
+        resourceDesc.SampleDesc.Quality = 0;
+        resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
+        resourceDesc.Flags = desc.Flags;
+        return resourceDesc;
+    }
+
+} // namespace SM
@@ -0,0 +1,384 @@
+#pragma once
+
+/**
+ * @file RenderGraph.h
+ * @brief Shattered Moon Engine - Frame render graph
+ *
+ * Passes are added every frame together with the resources they read and
+ * write. Compile then:
+ * - culls passes whose results nothing consumes,
+ * - works out the resource transitions between passes, merging consecutive
+ *   reads into one combined read state, and batches each pass's barriers
+ *   into a single ResourceBarrier call,
+ * - places transient render targets whose lifetimes do not overlap at the
+ *   same offset of a shared heap, with aliasing barriers on first use.
+ *
+ * Example usage:
+ * @code
+ *   RenderGraph& graph = renderer.GetRenderGraph();
+ *
+ *   RGResourceHandle shadowMap;
+ *   graph.AddPass("Shadows",
+ *       [&](RenderGraphBuilder& builder) {
+ *           shadowMap = builder.CreateTexture("ShadowMap", RGTextureDesc::DepthStencil(2048, 2048));
+ *           builder.Write(shadowMap, D3D12_RESOURCE_STATE_DEPTH_WRITE);
+ *       },
+ *       [&](CommandList& list, const RenderGraph& graph) { ... });
+ *
+ *   graph.AddPass("Scene",
+ *       [&](RenderGraphBuilder& builder) {
+ *           builder.Read(shadowMap, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+ *           builder.Write(renderer.GetBackBufferHandle(), D3D12_RESOURCE_STATE_RENDER_TARGET);
+ *       },
+ *       [&](CommandList& list, const RenderGraph& graph) { ... });
+ * @endcode
+ */
+
+#include "renderer/DX12Core.h"
+
+#include <d3d12.h>
+#include <wrl/client.h>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace SM
+{
+    // Forward declarations
+    class CommandList;
+    class Renderer;
+    class RenderGraph;
+
+    // ============================================================================
+    // Resource Types
+    // ============================================================================
+
+    /**
+     * @brief Handle to a graph resource, valid until the next Reset
+     */
+    struct RGResourceHandle
+    {
+        static constexpr uint32_t INVALID = ~0u;
+
+        uint32_t Index = INVALID;
+
+        bool IsValid() const { return Index != INVALID; }
+    };
+
+    /**
+     * @brief Description of a transient 2D texture owned by the graph
+     *
+     * Transient textures must be render targets or depth buffers; they live
+     * in a heap restricted to RT/DS textures.
+     */
+    struct RGTextureDesc
+    {
+        uint32_t Width = 0;
+        uint32_t Height = 0;
+        DXGI_FORMAT Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+        D3D12_RESOURCE_FLAGS Flags = D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
+        D3D12_CLEAR_VALUE ClearValue = {};      ///< Optimized clear value (Format is filled in)
+
+        /**
+         * @brief Create a color render target description
+         */
+        static RGTextureDesc RenderTarget(uint32_t width, uint32_t height,
+                                          DXGI_FORMAT format = DXGI_FORMAT_R8G8B8A8_UNORM);
+
+        /**
+         * @brief Create a depth buffer description (D32 can also be read through an SRV)
+         */
+        static RGTextureDesc DepthStencil(uint32_t width, uint32_t height,
+                                          DXGI_FORMAT format = DXGI_FORMAT_D32_FLOAT);
+
+        bool IsDepth() const { return (Flags & D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL) != 0; }
+
+        bool operator==(const RGTextureDesc& other) const;
+        bool operator!=(const RGTextureDesc& other) const { return !(*this == other); }
+    };
+
+    /**
+     * @brief Compile and execution results of the last frame, for display
+     */
+    struct RenderGraphStats
+    {
+        uint32_t PassCount = 0;             ///< Passes added this frame
+        uint32_t CulledPassCount = 0;       ///< Of those, passes whose output was unused
+        uint32_t BarrierBatchCount = 0;     ///< ResourceBarrier calls issued by the graph
+        uint32_t TransitionCount = 0;       ///< Transition barriers issued
+        uint32_t AliasingBarrierCount = 0;  ///< Aliasing barriers issued
+        uint32_t TransientCount = 0;        ///< Transient textures used by live passes
+        uint64_t TransientHeapSize = 0;     ///< Bytes of the shared transient heap
+        uint64_t TransientUnaliasedSize = 0;///< Bytes the transients would need without aliasing
+    };
+
+    // ============================================================================
+    // Render Graph Builder
+    // ============================================================================
+
+    /**
+     * @brief Declares a pass's resources during AddPass setup
+     */
+    class RenderGraphBuilder
+    {
+    public:
+        /**
+         * @brief Create a transient texture that lives only while passes use it
+         * @param name Debug name
+         * @param desc Texture description
+         * @return Handle to the texture
+         */
+        RGResourceHandle CreateTexture(const std::string& name, const RGTextureDesc& desc);
+
+        /**
+         * @brief Declare that the pass reads a resource
+         * @param handle Resource to read
+         * @param state Read state the pass needs (e.g. PIXEL_SHADER_RESOURCE)
+         * @return The same handle, for chaining
+         */
+        RGResourceHandle Read(RGResourceHandle handle, D3D12_RESOURCE_STATES state);
+
+        /**
+         * @brief Declare that the pass writes a resource
+         * @param handle Resource to write
+         * @param state Write state the pass needs (e.g. RENDER_TARGET, DEPTH_WRITE)
+         * @return The same handle, for chaining
+         */
+        RGResourceHandle Write(RGResourceHandle handle, D3D12_RESOURCE_STATES state);
+
+        /**
+         * @brief Keep the pass even if nothing reads what it writes
+         */
+        void SetSideEffect();
+
+    private:
+        friend class RenderGraph;
+
+        RenderGraphBuilder(RenderGraph& graph, uint32_t passIndex)
+            : m_Graph(graph)
+            , m_PassIndex(passIndex)
+        {
+        }
+
+        RenderGraph& m_Graph;
+        uint32_t m_PassIndex;
+    };
+
+    // ============================================================================
+    // Render Graph
+    // ============================================================================
+
+    /**
+     * @brief Per-frame graph of render passes and the resources between them
+     *
+     * Owned by the Renderer, which resets it and imports the back buffer and
+     * depth buffer in BeginFrame, then compiles and executes it in EndFrame.
+     * Passes run in the order they were added.
+     */
+    class RenderGraph
+    {
+    public:
+        using SetupFunc = std::function<void(RenderGraphBuilder& builder)>;
+        using ExecuteFunc = std::function<void(CommandList& list, const RenderGraph& graph)>;
+
+        RenderGraph() = default;
+        ~RenderGraph() = default;
+
+        // Prevent copying
+        RenderGraph(const RenderGraph&) = delete;
+        RenderGraph& operator=(const RenderGraph&) = delete;
+
+        /**
+         * @brief Initialize the graph
+         * @param core DX12 core reference
+         * @return true if successful
+         */
+        bool Initialize(DX12Core* core);
+
+        /**
+         * @brief Release the transient heap and resources once frames in flight retire
+         */
+        void Shutdown();
+
+        /**
+         * @brief Clear all passes and resources for a new frame
+         */
+        void Reset();
+
+        /**
+         * @brief Bring an externally owned texture into the graph
+         * @param name Debug name
+         * @param resource Resource to track
+         * @param currentState State the resource is in when the graph starts
+         * @param finalState State to leave it in when the graph ends
+         * @param rtv Render target view (optional)
+         * @param dsv Depth stencil view (optional)
+         * @return Handle to the resource
+         *
+         * Passes that write imported resources are never culled.
+         */
+        RGResourceHandle ImportTexture(
+            const std::string& name,
+            ID3D12Resource* resource,
+            D3D12_RESOURCE_STATES currentState,
+            D3D12_RESOURCE_STATES finalState,
+            D3D12_CPU_DESCRIPTOR_HANDLE rtv = {},
+            D3D12_CPU_DESCRIPTOR_HANDLE dsv = {}
+        );
+
+        /**
+         * @brief Add a pass
+         * @param name Debug name
+         * @param setup Declares resources; runs immediately
+         * @param execute Records the pass; runs during Execute if the pass is kept
+         */
+        void AddPass(const std::string& name, const SetupFunc& setup, ExecuteFunc execute);
+
+        /**
+         * @brief Cull passes, plan barriers and place transient textures
+         * @return false if transient textures could not be created
+         */
+        bool Compile();
+
+        /**
+         * @brief Record every live pass with its barriers
+         * @param renderer Renderer whose current command list receives the passes
+         *
+         * The list is fetched again before every pass, so passes may switch
+         * the renderer to a new list (Renderer::RecordParallel). Imported
+         * resources are left in their final state.
+         */
+        void Execute(Renderer& renderer);
+
+        // ====================================================================
+        // Resource Access (valid inside pass execution)
+        // ====================================================================
+
+        /**
+         * @brief Get the native resource behind a handle
+         */
+        ID3D12Resource* GetResource(RGResourceHandle handle) const;
+
+        /**
+         * @brief Get a render target view (zero handle if the resource has none)
+         */
+        D3D12_CPU_DESCRIPTOR_HANDLE GetRTV(RGResourceHandle handle) const;
+
+        /**
+         * @brief Get a depth stencil view (zero handle if the resource has none)
+         */
+        D3D12_CPU_DESCRIPTOR_HANDLE GetDSV(RGResourceHandle handle) const;
+
+        /**
+         * @brief Get a shader-visible SRV of a transient texture (invalid if it has none)
+         */
+        DescriptorHandle GetSRV(RGResourceHandle handle) const;
+
+        /**
+         * @brief Get the description of a transient texture
+         */
+        const RGTextureDesc& GetTextureDesc(RGResourceHandle handle) const;
+
+        /**
+         * @brief Get the last frame's statistics
+         */
+        const RenderGraphStats& GetStats() const { return m_Stats; }
+
+    private:
+        friend class RenderGraphBuilder;
+
+        struct Access
+        {
+            uint32_t Resource = 0;
+            D3D12_RESOURCE_STATES State = D3D12_RESOURCE_STATE_COMMON;
+            bool IsWrite = false;
+        };
+
+        struct Pass
+        {
+            std::string Name;
+            ExecuteFunc Execute;
+            std::vector<Access> Accesses;
+            bool HasSideEffect = false;
+            bool IsLive = false;
+        };
+
+        struct Resource
+        {
+            std::string Name;
+            bool IsImported = false;
+
+            // Imported
+            ID3D12Resource* Native = nullptr;
+            D3D12_RESOURCE_STATES InitialState = D3D12_RESOURCE_STATE_COMMON;
+            D3D12_RESOURCE_STATES FinalState = D3D12_RESOURCE_STATE_COMMON;
+            D3D12_CPU_DESCRIPTOR_HANDLE RTV = {};
+            D3D12_CPU_DESCRIPTOR_HANDLE DSV = {};
+
+            // Transient
+            RGTextureDesc Desc;
+            uint32_t Physical = RGResourceHandle::INVALID;   ///< Index into m_Physical
+            uint32_t FirstPass = RGResourceHandle::INVALID;  ///< First live pass using it
+            uint32_t LastPass = 0;                           ///< Last live pass using it
+
+            // Execution
+            D3D12_RESOURCE_STATES State = D3D12_RESOURCE_STATE_COMMON;
+            bool LastAccessWasWrite = false;
+        };
+
+        /// A placed texture in the transient heap; kept across frames while the layout is unchanged
+        struct PhysicalTexture
+        {
+            RGTextureDesc Desc;
+            uint64_t Offset = 0;
+            uint64_t Size = 0;
+            ComPtr<ID3D12Resource> Native;
+            D3D12_RESOURCE_STATES State = D3D12_RESOURCE_STATE_COMMON;  ///< Carried between frames
+            bool IsAliased = false;          ///< Shares memory with another transient
+            bool IsNew = false;              ///< Placed since the last frame, possibly over retired textures
+        };
+
+        /// Descriptors for one physical slot, returned to the heaps on Shutdown
+        struct PhysicalViews
+        {
+            DescriptorHandle RTV;       // CPU-only; consumed when recorded, safe to rewrite
+            DescriptorHandle DSV;
+            DescriptorHandle SRV;       // Shader-visible; replaced, never rewritten, on recreation
+        };
+
+        void ReleaseViews();
+
+        void AddAccess(uint32_t passIndex, RGResourceHandle handle, D3D12_RESOURCE_STATES state, bool isWrite);
+        RGResourceHandle CreateTransient(const std::string& name, const RGTextureDesc& desc);
+
+        void CullPasses();
+        void MergeReadStates();
+        bool PlaceTransients();
+        bool CreatePhysicalTextures(const std::vector<PhysicalTexture>& layout, uint64_t heapSize);
+        void CreateViews(uint32_t physicalIndex);
+
+        /// Memory may hold another texture's data: aliasing barrier and discard on first use
+        bool NeedsInitialization(const Resource& resource) const;
+
+        static D3D12_RESOURCE_DESC ToResourceDesc(const RGTextureDesc& desc);
+
+    private:
+        DX12Core* m_Core = nullptr;
+
+        std::vector<Pass> m_Passes;
+        std::vector<Resource> m_Resources;
+        bool m_Compiled = false;
+
+        // Transient heap (recreated only when the layout changes)
+        ComPtr<ID3D12Heap> m_TransientHeap;
+        uint64_t m_TransientHeapSize = 0;
+        std::vector<PhysicalTexture> m_Physical;
+        std::vector<PhysicalViews> m_PhysicalViews;
+
+        RenderGraphStats m_FrameStats;      // Filled by Compile and Execute
+        RenderGraphStats m_Stats;           // Published when Execute finishes
+    };
+
+} // namespace SM
@@ -1,5 +1,9 @@
 #include "renderer/Renderer.h"
+#include "renderer/MeshOptimizer.h"
+#include "core/JobSystem.h"
+#include "core/Profiler.h"
 
+#include <algorithm>
 #include <iostream>
 #include <cstring>
 
@@ -10,12 +14,12 @@ namespace SM
         Shutdown();
     }
 
-    bool Renderer::Initialize(HWND hwnd, uint32_t width, uint32_t height, bool vsync)
+    bool Renderer::Initialize(HWND hwnd, uint32_t width, uint32_t height, bool vsync, uint32_t framesInFlight)
     {
         std::cout << "[Renderer] Initializing DirectX 12 renderer..." << std::endl;
 
         // Initialize DX12 core
-        if (!m_Core.Initialize(hwnd, width, height, vsync))
+        if (!m_Core.Initialize(hwnd, width, height, vsync, framesInFlight))
         {
             std::cerr << "[Renderer] Failed to initialize DX12 core!" << std::endl;
             return false;
@@ -28,6 +32,37 @@ namespace SM
             return false;
         }
 
+        // Pooled lists for recording on job workers
+        if (!m_ListPool.Initialize(&m_Core, PARALLEL_LIST_COUNT))
+        {
+            std::cerr << "[Renderer] Failed to initialize command list pool!" << std::endl;
+            return false;
+        }
+
+        if (!m_RenderGraph.Initialize(&m_Core))
+        {
+            std::cerr << "[Renderer] Failed to initialize render graph!" << std::endl;
+            return false;
+        }
+
+        if (!m_TextureStreamer.Initialize(&m_Core))
+        {
+            std::cerr << "[Renderer] Failed to initialize texture streamer!" << std::endl;
+            return false;
+        }
+
+        // Occlusion culling and screen-space effects do without it if it fails
+        if (!m_HiZ.Initialize(&m_Core))
+        {
+            std::cerr << "[Renderer] Failed to initialize Hi-Z pyramid, continuing without it" << std::endl;
+        }
+
+        // Scenes render at full resolution without it
+        if (!m_DynamicResolution.Initialize(&m_Core))
+        {
+            std::cerr << "[Renderer] Failed to initialize dynamic resolution, continuing without it" << std::endl;
+        }
+
         // Create shaders
         if (!CreateShaders())
         {
@@ -49,6 +84,13 @@ namespace SM
             return false;
         }
 
+        // Create indirect instancing signature
+        if (!CreateIndirectSignature())
+        {
+            std::cerr << "[Renderer] Failed to create indirect command signature!" << std::endl;
+            return false;
+        }
+
         // Create constant buffers
         if (!CreateConstantBuffers())
         {
@@ -63,6 +105,9 @@ namespace SM
             return false;
         }
 
+        // Primitives are drawn from the first frame; finish their copies now
+        m_Core.GetUploadQueue().WaitForIdle();
+
         // Create default textures
         if (!CreateDefaultTextures())
         {
@@ -101,11 +146,18 @@ namespace SM
         m_CylinderMesh.reset();
         m_ConeMesh.reset();
         m_QuadMesh.reset();
+        for (auto& levels : m_PrimitiveLODs)
+        {
+            levels.clear();
+        }
+        m_InstancedCommandSignature.Reset();
 
-        m_UploadHeap.reset();
-        m_MaterialCB.reset();
-        m_PerObjectCB.reset();
-        m_PerFrameCB.reset();
+        m_TextureStreamer.Shutdown();
+        m_HiZ.Shutdown();
+        m_DynamicResolution.Shutdown();
+        m_FrameConstants.Shutdown();
+        m_ListPool.Shutdown();
+        m_RenderGraph.Shutdown();
 
         // Shutdown DX12 core
         m_Core.Shutdown();
@@ -131,6 +183,8 @@ namespace SM
             return;
         }
 
+        SM_PROFILE_SCOPE("Renderer::BeginFrame");
+
         // Begin frame in core (wait for previous frame to finish)
         m_Core.BeginFrame();
 
@@ -139,39 +193,51 @@ namespace SM
 
         // Reset and begin command list
         m_CommandList.Begin(frame.CommandAllocator.Get());
-
-        // Transition back buffer to render target
-        m_CommandList.TransitionBarrier(
+        m_CurrentList = &m_CommandList;
+        m_FrameLists.clear();
+        m_FrameCBAddress = 0;
+        m_FrameCBMapped = nullptr;
+        m_HiZBuilt = false;
+
+        // Pooled allocators of this frame index were fenced above as well
+        m_ListPool.BeginFrame(m_Core.GetCurrentFrameIndex());
+
+        // Passes transition the back buffer out of PRESENT; the graph puts it back
+        m_RenderGraph.Reset();
+        m_BackBufferHandle = m_RenderGraph.ImportTexture(
+            "BackBuffer",
             m_Core.GetCurrentBackBuffer(),
             D3D12_RESOURCE_STATE_PRESENT,
-            D3D12_RESOURCE_STATE_RENDER_TARGET
+            D3D12_RESOURCE_STATE_PRESENT,
+            m_Core.GetCurrentRTV()
+        );
+        m_DepthHandle = m_RenderGraph.ImportTexture(
+            "Depth",
+            m_Core.GetDepthBuffer(),
+            D3D12_RESOURCE_STATE_DEPTH_WRITE,
+            D3D12_RESOURCE_STATE_DEPTH_WRITE,
+            {},
+            m_Core.GetDSV()
         );
-        m_CommandList.FlushBarriers();
-
-        // Set render target
-        D3D12_CPU_DESCRIPTOR_HANDLE rtv = m_Core.GetCurrentRTV();
-        D3D12_CPU_DESCRIPTOR_HANDLE dsv = m_Core.GetDSV();
-        m_CommandList.SetRenderTargets(1, &rtv, &dsv);
-
-        // Set viewport and scissor
-        SetViewport(m_Core.GetWidth(), m_Core.GetHeight());
 
-        // Set pipeline state
-        m_CommandList.SetPipelineState(m_OpaquePSO.GetNative());
-        m_CommandList.SetGraphicsRootSignature(m_RootSignature.GetNative());
+        // Scene passes draw into the scaled target when dynamic resolution is on;
+        // its timing starts here, so the first list measures the whole frame
+        m_SceneColorHandle = m_BackBufferHandle;
+        m_SceneRTV = m_Core.GetCurrentRTV();
+        if (m_DynamicResolution.BeginFrame(m_CommandList, m_Core.GetCurrentFrameIndex()))
+        {
+            m_SceneColorHandle = m_DynamicResolution.ImportSceneTarget(m_RenderGraph);
+            m_SceneRTV = m_DynamicResolution.GetSceneTarget().GetRTV().CPU;
+        }
 
-        // Set descriptor heaps
-        ID3D12DescriptorHeap* heaps[] = { m_Core.GetCBVSRVUAVHeap().GetHeap() };
-        m_CommandList.SetDescriptorHeaps(1, heaps);
+        // Render targets, viewport, pipeline, heaps and topology
+        BindFrameState(m_CommandList);
 
-        // Set primitive topology
-        m_CommandList.SetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+        // Swap streamed textures before anything samples them
+        m_TextureStreamer.Update(m_CommandList);
 
-        // Reset upload heap for this frame
-        if (m_UploadHeap)
-        {
-            m_UploadHeap->Reset();
-        }
+        // Rewind this frame's constant ring (its previous use was fenced above)
+        m_FrameConstants.BeginFrame(m_Core.GetCurrentFrameIndex());
 
         m_FrameStarted = true;
     }
@@ -183,23 +249,36 @@ namespace SM
             return;
         }
 
-        // Transition back buffer to present
-        m_CommandList.TransitionBarrier(
-            m_Core.GetCurrentBackBuffer(),
-            D3D12_RESOURCE_STATE_RENDER_TARGET,
-            D3D12_RESOURCE_STATE_PRESENT
-        );
-        m_CommandList.FlushBarriers();
+        // Compile and record the frame's passes; leaves the back buffer in PRESENT
+        m_RenderGraph.Execute(*this);
 
-        // Close and execute command list
-        m_CommandList.End();
-        m_CommandList.Execute();
+        // Timestamps written by every list of the frame go to the readback buffer
+        m_DynamicResolution.EndFrame(*m_CurrentList);
+        m_Core.GetGPUProfiler().EndFrame(*m_CurrentList);
 
+        // Close the last list and submit the whole frame in recording order
+        CloseCurrentList();
+
+        // Last chance to move the frame to a newer camera pose
+        if (m_PreSubmitCallback)
+        {
+            m_PreSubmitCallback();
+        }
+
+        // Every upload recorded since the last frame goes out as one copy submission,
+        // ahead of the direct queue so the copies overlap the frame's rendering
+        m_Core.GetUploadQueue().SubmitFrame();
+
+        m_Core.ExecuteCommandLists(static_cast<uint32_t>(m_FrameLists.size()), m_FrameLists.data());
+        m_FrameLists.clear();
+
+        m_CurrentList = &m_CommandList;
         m_FrameStarted = false;
     }
 
     void Renderer::Present()
     {
+        SM_PROFILE_SCOPE("Renderer::Present");
         m_Core.EndFrame();
     }
 
@@ -207,17 +286,25 @@ namespace SM
     {
         float clearColor[4] = { r, g, b, a };
 
-        D3D12_CPU_DESCRIPTOR_HANDLE rtv = m_Core.GetCurrentRTV();
-        m_CommandList.ClearRenderTarget(rtv, clearColor);
+        if (m_DynamicResolution.IsActive())
+        {
+            // Only the rendered corner of the scaled target is ever sampled
+            D3D12_RECT rect = { 0, 0, static_cast<LONG>(GetRenderWidth()), static_cast<LONG>(GetRenderHeight()) };
+            m_CurrentList->GetNative()->ClearRenderTargetView(m_SceneRTV, clearColor, 1, &rect);
+        }
+        else
+        {
+            m_CurrentList->ClearRenderTarget(m_SceneRTV, clearColor);
+        }
 
         D3D12_CPU_DESCRIPTOR_HANDLE dsv = m_Core.GetDSV();
-        m_CommandList.ClearDepthStencil(dsv, 1.0f, 0);
+        m_CurrentList->ClearDepthStencil(dsv, 1.0f, 0);
     }
 
     void Renderer::SetViewport(uint32_t width, uint32_t height)
     {
-        m_CommandList.SetViewport(width, height);
-        m_CommandList.SetScissorRect(width, height);
+        m_CurrentList->SetViewport(width, height);
+        m_CurrentList->SetScissorRect(width, height);
     }
 
     void Renderer::SetCamera(const Camera& camera)
@@ -239,19 +326,430 @@ namespace SM
         m_FrameData.CameraPosition = m_Camera.Position;
         m_FrameData.Time = totalTime;
 
-        // Update constant buffer
-        m_PerFrameCB->Update(&m_FrameData, sizeof(PerFrameData));
+        // Allocate from this frame's ring and bind to root signature slot 0
+        FrameAllocation allocation = m_FrameConstants.AllocateTransient(sizeof(PerFrameData));
+        m_FrameCBAddress = allocation.GPUAddress;
+        m_FrameCBMapped = allocation.CPUPointer;
+        if (m_FrameCBAddress != 0)
+        {
+            std::memcpy(m_FrameCBMapped, &m_FrameData, sizeof(PerFrameData));
+            m_CurrentList->SetGraphicsRootConstantBufferView(0, m_FrameCBAddress);
+        }
+    }
+
+    void Renderer::LateLatchCamera(const Camera& camera)
+    {
+        m_Camera = camera;
+
+        if (!m_FrameCBMapped)
+        {
+            return;
+        }
 
-        // Bind to root signature slot 0
-        m_CommandList.SetGraphicsRootConstantBufferView(0, m_PerFrameCB->GetGPUAddress());
+        DirectX::XMMATRIX view = m_Camera.GetViewMatrix();
+        DirectX::XMMATRIX proj = m_Camera.GetProjectionMatrix(m_Core.GetAspectRatio());
+        DirectX::XMMATRIX viewProj = DirectX::XMMatrixMultiply(view, proj);
+
+        DirectX::XMStoreFloat4x4(&m_FrameData.View, DirectX::XMMatrixTranspose(view));
+        DirectX::XMStoreFloat4x4(&m_FrameData.Projection, DirectX::XMMatrixTranspose(proj));
+        DirectX::XMStoreFloat4x4(&m_FrameData.ViewProjection, DirectX::XMMatrixTranspose(viewProj));
+        m_FrameData.CameraPosition = m_Camera.Position;
+
+        // The pyramid was built from depth that will now be drawn with the latched pose
+        if (m_HiZBuilt)
+        {
+            m_HiZ.SetViewProjection(viewProj);
+        }
+
+        // Write-combined upload memory: one sequential copy, no reads
+        std::memcpy(m_FrameCBMapped, &m_FrameData, sizeof(PerFrameData));
     }
 
     void Renderer::DrawMesh(
         const Mesh& mesh,
         const MaterialData& material,
-        const DirectX::XMMATRIX& worldMatrix)
+        const DirectX::XMMATRIX& worldMatrix,
+        uint32_t baseTextureIndex)
+    {
+        RecordMeshDraw(*m_CurrentList, mesh, material, worldMatrix, baseTextureIndex);
+    }
+
+    void Renderer::DrawMesh(const Mesh& mesh, const DirectX::XMMATRIX& worldMatrix)
+    {
+        DrawMesh(mesh, m_DefaultMaterial, worldMatrix);
+    }
+
+    void Renderer::DrawRenderItems(const std::vector<RenderItem>& items)
     {
-        if (!mesh.IsValid())
+        RecordParallel(static_cast<uint32_t>(items.size()), [this, &items](CommandList& list, uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i)
+            {
+                const RenderItem& item = items[i];
+                if (item.MeshPtr)
+                {
+                    RecordMeshDraw(list, *item.MeshPtr, item.Material, DirectX::XMLoadFloat4x4(&item.WorldMatrix),
+                                   item.BaseTextureIndex);
+                }
+            }
+        });
+    }
+
+    void Renderer::DrawMeshBatches(const std::vector<MeshBatch>& batches, const std::vector<MeshInstanceData>& instances)
+    {
+        if (!m_FrameStarted || batches.empty() || instances.empty())
+        {
+            return;
+        }
+
+        // Every instance of the frame in one block; batches bind their range of it
+        const size_t instanceBytes = instances.size() * sizeof(MeshInstanceData);
+        FrameAllocation allocation = m_FrameConstants.AllocateTransient(instanceBytes);
+        if (!allocation.IsValid())
+        {
+            return;
+        }
+        std::memcpy(allocation.CPUPointer, instances.data(), instanceBytes);
+
+        CommandList& list = *m_CurrentList;
+        list.SetPipelineState(m_InstancedPSO.GetNative());
+
+        for (const MeshBatch& batch : batches)
+        {
+            if (!batch.MeshPtr || !batch.MeshPtr->IsReady() || batch.InstanceCount == 0 ||
+                batch.FirstInstance + batch.InstanceCount > instances.size())
+            {
+                continue;
+            }
+
+            D3D12_GPU_VIRTUAL_ADDRESS materialCB = m_FrameConstants.Push(batch.Material);
+            if (materialCB == 0)
+            {
+                break;
+            }
+
+            // SV_InstanceID starts at zero regardless of StartInstanceLocation,
+            // so the batch's range is selected by offsetting the view instead
+            list.SetGraphicsRootShaderResourceView(ROOT_INSTANCE_BUFFER,
+                allocation.GPUAddress + batch.FirstInstance * sizeof(MeshInstanceData));
+            list.SetGraphicsRootConstantBufferView(2, materialCB);
+
+            uint32_t baseTextureIndex = batch.BaseTextureIndex;
+            if (baseTextureIndex == INVALID_BINDLESS_INDEX && m_WhiteTexture)
+            {
+                baseTextureIndex = m_WhiteTexture->GetBindlessIndex();
+            }
+            list.SetGraphicsRoot32BitConstants(ROOT_DRAW_CONSTANTS, 1, &baseTextureIndex);
+
+            const Mesh& mesh = *batch.MeshPtr;
+            const D3D12_VERTEX_BUFFER_VIEW& vbv = mesh.GetVertexBufferView();
+            list.SetVertexBuffers(0, 1, &vbv);
+
+            if (mesh.HasIndices())
+            {
+                const D3D12_INDEX_BUFFER_VIEW& ibv = mesh.GetIndexBufferView();
+                list.SetIndexBuffer(&ibv);
+                list.DrawIndexed(mesh.GetIndexCount(), batch.InstanceCount);
+            }
+            else
+            {
+                list.Draw(mesh.GetVertexCount(), batch.InstanceCount);
+            }
+        }
+
+        // Later draws expect the frame's base pipeline
+        list.SetPipelineState(m_OpaquePSO.GetNative());
+    }
+
+    void Renderer::DrawMeshBatchesDepth(const std::vector<MeshBatch>& batches, const std::vector<MeshInstanceData>& instances,
+                                        const DirectX::XMMATRIX& viewProjection)
+    {
+        if (!m_FrameStarted || batches.empty() || instances.empty() || !m_InstancedDepthPSO.IsValid())
+        {
+            return;
+        }
+
+        const size_t instanceBytes = instances.size() * sizeof(MeshInstanceData);
+        FrameAllocation allocation = m_FrameConstants.AllocateTransient(instanceBytes);
+        if (!allocation.IsValid())
+        {
+            return;
+        }
+        std::memcpy(allocation.CPUPointer, instances.data(), instanceBytes);
+
+        // InstancedVS only reads ViewProjection, so the light's replaces the camera's
+        PerFrameData frameData = m_FrameData;
+        DirectX::XMStoreFloat4x4(&frameData.ViewProjection, DirectX::XMMatrixTranspose(viewProjection));
+        D3D12_GPU_VIRTUAL_ADDRESS frameCB = m_FrameConstants.Push(frameData);
+        if (frameCB == 0)
+        {
+            return;
+        }
+
+        CommandList& list = *m_CurrentList;
+        list.SetPipelineState(m_InstancedDepthPSO.GetNative());
+        list.SetGraphicsRootSignature(m_RootSignature.GetNative());
+        list.SetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+        list.SetGraphicsRootConstantBufferView(0, frameCB);
+
+        RecordDepthBatches(list, batches, instances.size(), allocation.GPUAddress);
+    }
+
+    void Renderer::DrawMeshBatchesPrepass(const std::vector<MeshBatch>& batches, const std::vector<MeshInstanceData>& instances)
+    {
+        if (!m_FrameStarted || batches.empty() || instances.empty() || !m_InstancedPrepassPSO.IsValid())
+        {
+            return;
+        }
+
+        const size_t instanceBytes = instances.size() * sizeof(MeshInstanceData);
+        FrameAllocation allocation = m_FrameConstants.AllocateTransient(instanceBytes);
+        if (!allocation.IsValid())
+        {
+            return;
+        }
+        std::memcpy(allocation.CPUPointer, instances.data(), instanceBytes);
+
+        // The frame's camera constants are already bound (and late-latched with the color pass)
+        CommandList& list = *m_CurrentList;
+        list.SetPipelineState(m_InstancedPrepassPSO.GetNative());
+
+        RecordDepthBatches(list, batches, instances.size(), allocation.GPUAddress);
+
+        // Later draws expect the frame's base pipeline
+        list.SetPipelineState(m_OpaquePSO.GetNative());
+    }
+
+    void Renderer::RecordDepthBatches(CommandList& list, const std::vector<MeshBatch>& batches, size_t instanceCount,
+                                      D3D12_GPU_VIRTUAL_ADDRESS instances)
+    {
+        for (const MeshBatch& batch : batches)
+        {
+            if (!batch.MeshPtr || !batch.MeshPtr->IsReady() || batch.InstanceCount == 0 ||
+                batch.FirstInstance + batch.InstanceCount > instanceCount)
+            {
+                continue;
+            }
+
+            list.SetGraphicsRootShaderResourceView(ROOT_INSTANCE_BUFFER,
+                instances + batch.FirstInstance * sizeof(MeshInstanceData));
+
+            const Mesh& mesh = *batch.MeshPtr;
+            const D3D12_VERTEX_BUFFER_VIEW& vbv = mesh.GetVertexBufferView();
+            list.SetVertexBuffers(0, 1, &vbv);
+
+            if (mesh.HasIndices())
+            {
+                const D3D12_INDEX_BUFFER_VIEW& ibv = mesh.GetIndexBufferView();
+                list.SetIndexBuffer(&ibv);
+                list.DrawIndexed(mesh.GetIndexCount(), batch.InstanceCount);
+            }
+            else
+            {
+                list.Draw(mesh.GetVertexCount(), batch.InstanceCount);
+            }
+        }
+    }
+
+    void Renderer::DrawMeshInstancesIndirect(const Mesh& mesh, const MaterialData& material,
+                                             const GPUInstanceRange* ranges, uint32_t rangeCount)
+    {
+        if (!m_FrameStarted || !m_InstancedCommandSignature || !mesh.IsReady() || !mesh.HasIndices() ||
+            !ranges || rangeCount == 0)
+        {
+            return;
+        }
+
+        FrameAllocation commands = m_FrameConstants.AllocateTransient(
+            rangeCount * sizeof(InstancedIndirectCommand), sizeof(InstancedIndirectCommand::InstanceBuffer));
+        D3D12_GPU_VIRTUAL_ADDRESS materialCB = m_FrameConstants.Push(material);
+        if (!commands.IsValid() || materialCB == 0)
+        {
+            return;
+        }
+
+        auto* commandData = static_cast<InstancedIndirectCommand*>(commands.CPUPointer);
+        uint32_t commandCount = 0;
+        for (uint32_t i = 0; i < rangeCount; ++i)
+        {
+            if (ranges[i].InstanceAddress == 0 || ranges[i].InstanceCount == 0)
+            {
+                continue;
+            }
+
+            InstancedIndirectCommand& command = commandData[commandCount++];
+            command.InstanceBuffer = ranges[i].InstanceAddress;
+            command.Draw.IndexCountPerInstance = mesh.GetIndexCount();
+            command.Draw.InstanceCount = ranges[i].InstanceCount;
+            command.Draw.StartIndexLocation = 0;
+            command.Draw.BaseVertexLocation = 0;
+            command.Draw.StartInstanceLocation = 0;
+        }
+
+        if (commandCount == 0)
+        {
+            return;
+        }
+
+        CommandList& list = *m_CurrentList;
+
+        // Passes with their own root signature (terrain) may have run before this
+        BindFrameState(list);
+        list.SetPipelineState(m_InstancedPSO.GetNative());
+        list.SetGraphicsRootConstantBufferView(2, materialCB);
+
+        uint32_t baseTextureIndex = m_WhiteTexture ? m_WhiteTexture->GetBindlessIndex() : 0;
+        list.SetGraphicsRoot32BitConstants(ROOT_DRAW_CONSTANTS, 1, &baseTextureIndex);
+
+        const D3D12_VERTEX_BUFFER_VIEW& vbv = mesh.GetVertexBufferView();
+        const D3D12_INDEX_BUFFER_VIEW& ibv = mesh.GetIndexBufferView();
+        list.SetVertexBuffers(0, 1, &vbv);
+        list.SetIndexBuffer(&ibv);
+
+        list.GetNative()->ExecuteIndirect(
+            m_InstancedCommandSignature.Get(),
+            commandCount,
+            commands.Resource,
+            commands.Offset,
+            nullptr,
+            0
+        );
+
+        // Later draws expect the frame's base pipeline
+        list.SetPipelineState(m_OpaquePSO.GetNative());
+    }
+
+    void Renderer::RecordParallel(uint32_t itemCount, const RecordRangeFunc& record, uint32_t minItemsPerList)
+    {
+        if (!m_FrameStarted || itemCount == 0)
+        {
+            return;
+        }
+
+        // One list per worker plus the calling thread, leaving a pooled list to continue on
+        JobSystem& jobs = JobSystem::Get();
+        uint32_t listCount = 1;
+        if (jobs.IsInitialized() && m_ListPool.GetAvailableCount() > 2)
+        {
+            listCount = std::min({
+                itemCount / std::max(minItemsPerList, 1u),
+                jobs.GetWorkerCount() + 1,
+                m_ListPool.GetAvailableCount() - 1
+            });
+        }
+
+        if (listCount <= 1)
+        {
+            record(*m_CurrentList, 0, itemCount);
+            return;
+        }
+
+        // Everything recorded so far runs before the parallel lists
+        CloseCurrentList();
+
+        std::array<CommandList*, CommandListPool::MAX_LISTS> lists = {};
+        for (uint32_t i = 0; i < listCount; ++i)
+        {
+            lists[i] = m_ListPool.Acquire();
+        }
+
+        const uint32_t itemsPerList = (itemCount + listCount - 1) / listCount;
+        jobs.ParallelFor(listCount, 1, [&](uint32_t first, uint32_t last) {
+            for (uint32_t i = first; i < last; ++i)
+            {
+                CommandList& list = *lists[i];
+                BindFrameState(list);
+
+                uint32_t begin = i * itemsPerList;
+                uint32_t end = std::min(itemCount, begin + itemsPerList);
+                if (begin < end)
+                {
+                    record(list, begin, end);
+                }
+                list.End();
+            }
+        });
+
+        for (uint32_t i = 0; i < listCount; ++i)
+        {
+            m_FrameLists.push_back(lists[i]->GetNative());
+        }
+
+        // Continue the frame on a fresh list
+        m_CurrentList = m_ListPool.Acquire();
+        BindFrameState(*m_CurrentList);
+    }
+
+    void Renderer::RebindFrameState()
+    {
+        if (m_FrameStarted)
+        {
+            BindFrameState(*m_CurrentList);
+        }
+    }
+
+    void Renderer::BuildHiZ(const DirectX::XMMATRIX& viewProjection)
+    {
+        if (!m_FrameStarted || !m_HiZ.IsInitialized())
+        {
+            return;
+        }
+
+        m_HiZ.Build(m_CurrentList->GetNative(), viewProjection, GetRenderWidth(), GetRenderHeight());
+        m_HiZBuilt = m_HiZ.IsValid();
+
+        // The downsample dispatches replaced the pipeline
+        BindFrameState(*m_CurrentList);
+    }
+
+    void Renderer::UpscaleSceneColor()
+    {
+        if (!m_FrameStarted || !m_DynamicResolution.IsActive())
+        {
+            return;
+        }
+
+        m_DynamicResolution.Upscale(*m_CurrentList, m_Core.GetCurrentRTV(), m_Core.GetWidth(), m_Core.GetHeight());
+    }
+
+    void Renderer::BindFrameState(CommandList& list)
+    {
+        D3D12_CPU_DESCRIPTOR_HANDLE dsv = m_Core.GetDSV();
+        list.SetRenderTargets(1, &m_SceneRTV, &dsv);
+
+        list.SetViewport(GetRenderWidth(), GetRenderHeight());
+        list.SetScissorRect(GetRenderWidth(), GetRenderHeight());
+
+        list.SetPipelineState(m_OpaquePSO.GetNative());
+        list.SetGraphicsRootSignature(m_RootSignature.GetNative());
+
+        // One table over the whole heap; draws select textures by index
+        DescriptorHeap& heap = m_Core.GetCBVSRVUAVHeap();
+        ID3D12DescriptorHeap* heaps[] = { heap.GetHeap() };
+        list.SetDescriptorHeaps(1, heaps);
+        list.SetGraphicsRootDescriptorTable(ROOT_BINDLESS_TABLE, heap.GetHandle(0).GPU);
+
+        list.SetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+        if (m_FrameCBAddress != 0)
+        {
+            list.SetGraphicsRootConstantBufferView(0, m_FrameCBAddress);
+        }
+    }
+
+    void Renderer::CloseCurrentList()
+    {
+        m_CurrentList->End();
+        m_FrameLists.push_back(m_CurrentList->GetNative());
+    }
+
+    void Renderer::RecordMeshDraw(
+        CommandList& list,
+        const Mesh& mesh,
+        const MaterialData& material,
+        const DirectX::XMMATRIX& worldMatrix,
+        uint32_t baseTextureIndex)
+    {
+        if (!mesh.IsReady())
         {
             return;
         }
@@ -265,45 +763,44 @@ namespace SM
         );
         DirectX::XMStoreFloat4x4(&objectData.WorldInverseTranspose, DirectX::XMMatrixTranspose(worldInvTranspose));
 
-        m_PerObjectCB->Update(&objectData, sizeof(PerObjectData));
-
-        // Update material constant buffer
-        m_MaterialCB->Update(&material, sizeof(MaterialData));
+        // Each draw gets its own constants; the ring lives until this frame's fence
+        D3D12_GPU_VIRTUAL_ADDRESS objectCB = m_FrameConstants.Push(objectData);
+        D3D12_GPU_VIRTUAL_ADDRESS materialCB = m_FrameConstants.Push(material);
+        if (objectCB == 0 || materialCB == 0)
+        {
+            return;
+        }
 
         // Bind constant buffers
-        m_CommandList.SetGraphicsRootConstantBufferView(1, m_PerObjectCB->GetGPUAddress());
-        m_CommandList.SetGraphicsRootConstantBufferView(2, m_MaterialCB->GetGPUAddress());
+        list.SetGraphicsRootConstantBufferView(1, objectCB);
+        list.SetGraphicsRootConstantBufferView(2, materialCB);
 
-        // Bind default texture
-        if (m_WhiteTexture && m_WhiteTexture->GetSRV().IsValid())
+        // Texture is a bindless index; fall back to white so sampling stays defined
+        if (baseTextureIndex == INVALID_BINDLESS_INDEX && m_WhiteTexture)
         {
-            m_CommandList.SetGraphicsRootDescriptorTable(3, m_WhiteTexture->GetSRV().GPU);
+            baseTextureIndex = m_WhiteTexture->GetBindlessIndex();
         }
+        list.SetGraphicsRoot32BitConstants(ROOT_DRAW_CONSTANTS, 1, &baseTextureIndex);
 
         // Set vertex and index buffers
         const D3D12_VERTEX_BUFFER_VIEW& vbv = mesh.GetVertexBufferView();
-        m_CommandList.SetVertexBuffers(0, 1, &vbv);
+        list.SetVertexBuffers(0, 1, &vbv);
 
         if (mesh.HasIndices())
         {
             const D3D12_INDEX_BUFFER_VIEW& ibv = mesh.GetIndexBufferView();
-            m_CommandList.SetIndexBuffer(&ibv);
+            list.SetIndexBuffer(&ibv);
 
             // Draw indexed
-            m_CommandList.DrawIndexed(mesh.GetIndexCount());
+            list.DrawIndexed(mesh.GetIndexCount());
         }
         else
         {
             // Draw non-indexed
-            m_CommandList.Draw(mesh.GetVertexCount());
+            list.Draw(mesh.GetVertexCount());
         }
     }
 
-    void Renderer::DrawMesh(const Mesh& mesh, const DirectX::XMMATRIX& worldMatrix)
-    {
-        DrawMesh(mesh, m_DefaultMaterial, worldMatrix);
-    }
-
     Mesh* Renderer::GetPrimitiveMesh(uint32_t type)
     {
         switch (type)
@@ -318,6 +815,22 @@ namespace SM
         }
     }
 
+    Mesh* Renderer::GetPrimitiveMesh(uint32_t type, uint32_t lod)
+    {
+        if (lod == 0 || type >= m_PrimitiveLODs.size() || m_PrimitiveLODs[type].empty())
+        {
+            return GetPrimitiveMesh(type);
+        }
+
+        const auto& levels = m_PrimitiveLODs[type];
+        return levels[std::min<size_t>(lod, levels.size()) - 1].get();
+    }
+
+    uint32_t Renderer::GetPrimitiveLODCount(uint32_t type) const
+    {
+        return type < m_PrimitiveLODs.size() ? static_cast<uint32_t>(m_PrimitiveLODs[type].size()) + 1 : 1;
+    }
+
     bool Renderer::CreateShaders()
     {
         std::cout << "[Renderer] Compiling shaders..." << std::endl;
@@ -329,6 +842,13 @@ namespace SM
             return false;
         }
 
+        // Instanced variant reading transforms from a structured buffer
+        if (!CompileShaderFromFile(L"shaders/BasicVertex.hlsl", "InstancedVS", "vs_5_1", m_InstancedVertexShader))
+        {
+            std::cerr << "[Renderer] Failed to compile instanced vertex shader!" << std::endl;
+            return false;
+        }
+
         // Compile pixel shader
         if (!CompileShaderFromFile(L"shaders/BasicPixel.hlsl", "main", "ps_5_1", m_PixelShader))
         {
@@ -340,6 +860,34 @@ namespace SM
         return true;
     }
 
+    bool Renderer::ReloadShaders()
+    {
+        // Keep the current shaders if the edited ones do not compile
+        ShaderBytecode vertexShader = m_VertexShader;
+        ShaderBytecode instancedVertexShader = m_InstancedVertexShader;
+        ShaderBytecode pixelShader = m_PixelShader;
+
+        if (!CreateShaders())
+        {
+            m_VertexShader = vertexShader;
+            m_InstancedVertexShader = instancedVertexShader;
+            m_PixelShader = pixelShader;
+            return false;
+        }
+
+        // Frames in flight may still reference the current PSOs
+        for (GraphicsPipelineState* pso : { &m_OpaquePSO, &m_InstancedPSO, &m_InstancedDepthPSO, &m_InstancedPrepassPSO,
+                                            &m_WireframePSO })
+        {
+            if (pso->GetNative())
+            {
+                m_Core.DeferRelease(pso->GetNative());
+            }
+        }
+
+        return CreatePipelineStates();
+    }
+
     bool Renderer::CreateRootSignature()
     {
         std::cout << "[Renderer] Creating root signature..." << std::endl;
@@ -358,16 +906,63 @@ namespace SM
         std::cout << "[Renderer] Creating pipeline states..." << std::endl;
 
         // Create opaque PSO
-        if (!CreateBasicPipelineState(&m_Core, m_RootSignature.GetNative(),
+        if (!CreateBasicPipelineState(&m_Core, m_RootSignature,
                                        m_VertexShader, m_PixelShader, m_OpaquePSO))
         {
             return false;
         }
 
+        // Create instanced PSO (same state, transforms from the instance buffer)
+        if (!CreateBasicPipelineState(&m_Core, m_RootSignature,
+                                       m_InstancedVertexShader, m_PixelShader, m_InstancedPSO))
+        {
+            return false;
+        }
+
+        // Shadow caster PSO: depth only, biased against acne, and unclipped so
+        // casters in front of a cascade's box still land on its near plane
+        m_InstancedDepthPSO
+            .Begin()
+            .SetRootSignature(m_RootSignature)
+            .SetVertexShader(m_InstancedVertexShader)
+            .SetStandardInputLayout()
+            .SetRasterizer(FillMode::Solid, CullMode::Back)
+            .SetDepthClip(false)
+            .SetDepthBias(64, 0.0f, 2.0f)
+            .SetBlendMode(BlendMode::Opaque)
+            .SetDepthStencil(true, true, DepthFunc::Less)
+            .SetDepthStencilFormat(DXGI_FORMAT_D32_FLOAT)
+            .Build(&m_Core);
+
+        if (!m_InstancedDepthPSO.IsValid())
+        {
+            std::cerr << "[Renderer] Failed to create instanced depth PSO!" << std::endl;
+            return false;
+        }
+
+        // Depth pre-pass PSO: the instanced vertex shader unchanged, so the
+        // color pass reproduces the same depth and passes its LESS_EQUAL test
+        m_InstancedPrepassPSO
+            .Begin()
+            .SetRootSignature(m_RootSignature)
+            .SetVertexShader(m_InstancedVertexShader)
+            .SetStandardInputLayout()
+            .SetRasterizer(FillMode::Solid, CullMode::Back)
+            .SetBlendMode(BlendMode::Opaque)
+            .SetDepthStencil(true, true, DepthFunc::Less)
+            .SetDepthStencilFormat(m_Core.GetDepthFormat())
+            .Build(&m_Core);
+
+        if (!m_InstancedPrepassPSO.IsValid())
+        {
+            std::cerr << "[Renderer] Failed to create instanced pre-pass PSO!" << std::endl;
+            return false;
+        }
+
         // Create wireframe PSO
         m_WireframePSO
             .Begin()
-            .SetRootSignature(m_RootSignature.GetNative())
+            .SetRootSignature(m_RootSignature)
             .SetVertexShader(m_VertexShader)
             .SetPixelShader(m_PixelShader)
             .SetStandardInputLayout()
@@ -382,31 +977,35 @@ namespace SM
         return true;
     }
 
-    bool Renderer::CreateConstantBuffers()
+    bool Renderer::CreateIndirectSignature()
     {
-        std::cout << "[Renderer] Creating constant buffers..." << std::endl;
-
-        m_PerFrameCB = std::make_unique<ConstantBuffer>();
-        if (!m_PerFrameCB->Initialize(&m_Core, sizeof(PerFrameData)))
-        {
-            return false;
-        }
+        // Command layout must match InstancedIndirectCommand
+        D3D12_INDIRECT_ARGUMENT_DESC arguments[2] = {};
+        arguments[0].Type = D3D12_INDIRECT_ARGUMENT_TYPE_SHADER_RESOURCE_VIEW;
+        arguments[0].ShaderResourceView.RootParameterIndex = ROOT_INSTANCE_BUFFER;
+        arguments[1].Type = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED;
+
+        D3D12_COMMAND_SIGNATURE_DESC signatureDesc = {};
+        signatureDesc.ByteStride = sizeof(InstancedIndirectCommand);
+        signatureDesc.NumArgumentDescs = 2;
+        signatureDesc.pArgumentDescs = arguments;
+
+        // Root signature is required because the commands write a root SRV
+        HRESULT hr = m_Core.GetDevice()->CreateCommandSignature(
+            &signatureDesc,
+            m_RootSignature.GetNative(),
+            IID_PPV_ARGS(&m_InstancedCommandSignature)
+        );
 
-        m_PerObjectCB = std::make_unique<ConstantBuffer>();
-        if (!m_PerObjectCB->Initialize(&m_Core, sizeof(PerObjectData)))
-        {
-            return false;
-        }
+        return SUCCEEDED(hr);
+    }
 
-        m_MaterialCB = std::make_unique<ConstantBuffer>();
-        if (!m_MaterialCB->Initialize(&m_Core, sizeof(MaterialData)))
-        {
-            return false;
-        }
+    bool Renderer::CreateConstantBuffers()
+    {
+        std::cout << "[Renderer] Creating constant buffers..." << std::endl;
 
-        // Create upload heap for dynamic allocations (2MB)
-        m_UploadHeap = std::make_unique<UploadHeap>();
-        if (!m_UploadHeap->Initialize(&m_Core, 2 * 1024 * 1024))
+        // One 2MB ring per buffered frame (~8K 256-byte constant blocks each)
+        if (!m_FrameConstants.Initialize(&m_Core, 2 * 1024 * 1024))
         {
             return false;
         }
@@ -419,58 +1018,110 @@ namespace SM
     {
         std::cout << "[Renderer] Creating primitive meshes..." << std::endl;
 
+        // Every primitive is cache- and fetch-ordered before upload, then
+        // simplified into the levels MeshRenderSystem picks by screen size
+
         // Cube
         m_CubeMesh = std::make_unique<Mesh>();
         MeshData cubeData = MeshGenerator::CreateCube(1.0f);
+        MeshOptimizer::Optimize(cubeData);
         if (!m_CubeMesh->Create(&m_Core, cubeData))
         {
             return false;
         }
+        if (!CreatePrimitiveLODs(1, cubeData))
+        {
+            return false;
+        }
 
         // Sphere
         m_SphereMesh = std::make_unique<Mesh>();
         MeshData sphereData = MeshGenerator::CreateSphere(0.5f, 32, 16);
+        MeshOptimizer::Optimize(sphereData);
         if (!m_SphereMesh->Create(&m_Core, sphereData))
         {
             return false;
         }
+        if (!CreatePrimitiveLODs(2, sphereData))
+        {
+            return false;
+        }
 
         // Plane
         m_PlaneMesh = std::make_unique<Mesh>();
         MeshData planeData = MeshGenerator::CreatePlane(10.0f, 10.0f, 10, 10);
+        MeshOptimizer::Optimize(planeData);
         if (!m_PlaneMesh->Create(&m_Core, planeData))
         {
             return false;
         }
+        if (!CreatePrimitiveLODs(3, planeData))
+        {
+            return false;
+        }
 
         // Cylinder
         m_CylinderMesh = std::make_unique<Mesh>();
         MeshData cylinderData = MeshGenerator::CreateCylinder(0.5f, 1.0f, 32, true);
+        MeshOptimizer::Optimize(cylinderData);
         if (!m_CylinderMesh->Create(&m_Core, cylinderData))
         {
             return false;
         }
+        if (!CreatePrimitiveLODs(4, cylinderData))
+        {
+            return false;
+        }
 
         // Cone
         m_ConeMesh = std::make_unique<Mesh>();
         MeshData coneData = MeshGenerator::CreateCone(0.5f, 1.0f, 32, true);
+        MeshOptimizer::Optimize(coneData);
         if (!m_ConeMesh->Create(&m_Core, coneData))
         {
             return false;
         }
+        if (!CreatePrimitiveLODs(5, coneData))
+        {
+            return false;
+        }
 
         // Quad
         m_QuadMesh = std::make_unique<Mesh>();
         MeshData quadData = MeshGenerator::CreateQuad(1.0f, 1.0f);
+        MeshOptimizer::Optimize(quadData);
         if (!m_QuadMesh->Create(&m_Core, quadData))
         {
             return false;
         }
+        if (!CreatePrimitiveLODs(6, quadData))
+        {
+            return false;
+        }
 
         std::cout << "[Renderer] Primitive meshes created." << std::endl;
         return true;
     }
 
+    bool Renderer::CreatePrimitiveLODs(uint32_t type, const MeshData& data)
+    {
+        std::vector<MeshData> levels;
+        MeshOptimizer::GenerateLODs(data, MAX_PRIMITIVE_LODS - 1, levels);
+
+        auto& meshes = m_PrimitiveLODs[type];
+        meshes.clear();
+        for (const MeshData& level : levels)
+        {
+            auto mesh = std::make_unique<Mesh>();
+            if (!mesh->Create(&m_Core, level))
+            {
+                return false;
+            }
+            meshes.push_back(std::move(mesh));
+        }
+        return true;
+    }
+
     bool Renderer::CreateDefaultTextures()
     {
         std::cout << "[Renderer] Creating default textures..." << std::endl;
@@ -11,13 +11,20 @@
 #include "renderer/DX12Core.h"
 #include "renderer/CommandList.h"
 #include "renderer/GPUBuffer.h"
+#include "renderer/DynamicResolution.h"
+#include "renderer/HiZPyramid.h"
 #include "renderer/RootSignature.h"
 #include "renderer/PipelineState.h"
+#include "renderer/RenderGraph.h"
 #include "renderer/Mesh.h"
 #include "renderer/Texture.h"
+#include "renderer/TextureStreamer.h"
 
 #include <DirectXMath.h>
+#include <array>
+#include <functional>
 #include <memory>
+#include <vector>
 #include <string>
 #include <unordered_map>
 
@@ -47,6 +54,30 @@ namespace SM
         DirectX::XMFLOAT4X4 WorldInverseTranspose;
     };
 
+    /**
+     * @brief One instance of an instanced draw (matches MeshInstance in BasicVertex.hlsl)
+     *
+     * The normal matrix is derived in the shader, so only the transform is stored.
+     */
+    struct MeshInstanceData
+    {
+        DirectX::XMFLOAT4 WorldRows[3];     ///< First three rows of the transposed world matrix
+
+        /**
+         * @brief Build from a world matrix (row-vector convention, affine)
+         */
+        static MeshInstanceData FromMatrix(DirectX::FXMMATRIX world)
+        {
+            DirectX::XMMATRIX transposed = DirectX::XMMatrixTranspose(world);
+
+            MeshInstanceData instance;
+            DirectX::XMStoreFloat4(&instance.WorldRows[0], transposed.r[0]);
+            DirectX::XMStoreFloat4(&instance.WorldRows[1], transposed.r[1]);
+            DirectX::XMStoreFloat4(&instance.WorldRows[2], transposed.r[2]);
+            return instance;
+        }
+    };
+
     /**
      * @brief Material constant buffer data
      */
@@ -103,6 +134,40 @@ namespace SM
         Mesh* MeshPtr = nullptr;
         DirectX::XMFLOAT4X4 WorldMatrix;
         MaterialData Material;
+        uint32_t BaseTextureIndex = INVALID_BINDLESS_INDEX;    ///< Texture::GetBindlessIndex, or the white texture
+    };
+
+    /**
+     * @brief Instances sharing a mesh and material, drawn with one call
+     */
+    struct MeshBatch
+    {
+        const Mesh* MeshPtr = nullptr;
+        MaterialData Material;
+        uint32_t BaseTextureIndex = INVALID_BINDLESS_INDEX;    ///< Texture::GetBindlessIndex, or the white texture
+        uint32_t FirstInstance = 0;                             ///< Offset into the instance array
+        uint32_t InstanceCount = 0;
+    };
+
+    /**
+     * @brief Instances already resident in a GPU buffer, for DrawMeshInstancesIndirect
+     */
+    struct GPUInstanceRange
+    {
+        D3D12_GPU_VIRTUAL_ADDRESS InstanceAddress = 0;  ///< First MeshInstanceData of the range
+        uint32_t InstanceCount = 0;
+    };
+
+    /**
+     * @brief One ExecuteIndirect command of an instanced draw
+     *
+     * Layout must match the command signature built in CreateIndirectSignature:
+     * instance buffer root SRV (t0), indexed draw.
+     */
+    struct InstancedIndirectCommand
+    {
+        D3D12_GPU_VIRTUAL_ADDRESS InstanceBuffer;
+        D3D12_DRAW_INDEXED_ARGUMENTS Draw;
     };
 
     /**
@@ -127,9 +192,11 @@ namespace SM
          * @param width Window width
          * @param height Window height
          * @param vsync Enable vertical sync
+         * @param framesInFlight Frames the CPU may run ahead of the GPU (2-3)
          * @return true if successful
          */
-        bool Initialize(HWND hwnd, uint32_t width, uint32_t height, bool vsync = true);
+        bool Initialize(HWND hwnd, uint32_t width, uint32_t height, bool vsync = true,
+                        uint32_t framesInFlight = FRAME_BUFFER_COUNT);
 
         /**
          * @brief Shutdown and release all resources
@@ -145,14 +212,23 @@ namespace SM
 
         /**
          * @brief Begin a new frame
+         *
+         * Resets the render graph and imports the back buffer and depth
+         * buffer; add the frame's passes before EndFrame.
          */
         void BeginFrame();
 
         /**
-         * @brief End the current frame
+         * @brief Compile and record the frame's render graph, then submit it
          */
         void EndFrame();
 
+        /**
+         * @brief Recompile the shaders and rebuild the PSOs (hot reload)
+         * @return false if a shader failed to compile; the old PSOs stay in use
+         */
+        bool ReloadShaders();
+
         /**
          * @brief Present the frame to the screen
          */
@@ -186,16 +262,37 @@ namespace SM
          */
         void UpdateFrameConstants(float totalTime);
 
+        /**
+         * @brief Rewrite this frame's camera constants with a newer pose
+         * @param camera Camera sampled from the latest input
+         *
+         * The constants sit in the upload ring and the GPU reads them only
+         * once the frame is submitted, so overwriting them in place moves
+         * every draw already recorded to the new pose. Call from the
+         * pre-submit callback; does nothing before UpdateFrameConstants.
+         */
+        void LateLatchCamera(const Camera& camera);
+
+        /// Runs in EndFrame after recording, immediately before ExecuteCommandLists
+        using PreSubmitCallback = std::function<void()>;
+
+        /**
+         * @brief Set the callback run just before the frame is submitted
+         */
+        void SetPreSubmitCallback(PreSubmitCallback callback) { m_PreSubmitCallback = std::move(callback); }
+
         /**
          * @brief Draw a mesh with a material and transform
          * @param mesh Mesh to draw
          * @param material Material data
          * @param worldMatrix World transform matrix
+         * @param baseTextureIndex Bindless index of the base texture (invalid = white)
          */
         void DrawMesh(
             const Mesh& mesh,
             const MaterialData& material,
-            const DirectX::XMMATRIX& worldMatrix
+            const DirectX::XMMATRIX& worldMatrix,
+            uint32_t baseTextureIndex = INVALID_BINDLESS_INDEX
         );
 
         /**
@@ -205,12 +302,144 @@ namespace SM
          */
         void DrawMesh(const Mesh& mesh, const DirectX::XMMATRIX& worldMatrix);
 
+        /**
+         * @brief Draw a batch of render items, recording on job workers when large
+         * @param items Items to draw, in submission order
+         */
+        void DrawRenderItems(const std::vector<RenderItem>& items);
+
+        /**
+         * @brief Draw batches of instances, one DrawIndexedInstanced per batch
+         * @param batches Batches referencing ranges of instances
+         * @param instances Transforms of every batch, uploaded once to the frame ring
+         */
+        void DrawMeshBatches(const std::vector<MeshBatch>& batches, const std::vector<MeshInstanceData>& instances);
+
+        /**
+         * @brief Draw batches of instances into the bound depth target only (shadow casters)
+         * @param batches Batches referencing ranges of instances
+         * @param instances Transforms of every batch
+         * @param viewProjection Light view-projection the instances are drawn with
+         *
+         * Uses a depth-only pipeline with slope-scaled bias and depth clip off;
+         * the caller's depth target, viewport and scissor are kept. Call
+         * RebindFrameState before drawing to the frame's targets again.
+         */
+        void DrawMeshBatchesDepth(const std::vector<MeshBatch>& batches, const std::vector<MeshInstanceData>& instances,
+                                  const DirectX::XMMATRIX& viewProjection);
+
+        /**
+         * @brief Draw batches of instances into the main depth buffer only (depth pre-pass)
+         * @param batches Batches referencing ranges of instances
+         * @param instances Transforms of every batch
+         *
+         * Uses the frame's camera constants, so the depth matches the later
+         * DrawMeshBatches of the same batches exactly; the color pipelines
+         * test LESS_EQUAL and only shade the visible surface. Leaves the
+         * frame's base pipeline bound.
+         */
+        void DrawMeshBatchesPrepass(const std::vector<MeshBatch>& batches, const std::vector<MeshInstanceData>& instances);
+
+        /**
+         * @brief Draw ranges of GPU-resident instances of one mesh with a single ExecuteIndirect
+         * @param mesh Indexed mesh to draw
+         * @param material Material shared by every range
+         * @param ranges Instance buffers (e.g. one per terrain chunk) and their counts
+         * @param rangeCount Number of ranges
+         *
+         * The instance buffers must be in a shader-readable state; only the
+         * small argument buffer is written to the frame ring.
+         */
+        void DrawMeshInstancesIndirect(const Mesh& mesh, const MaterialData& material,
+                                       const GPUInstanceRange* ranges, uint32_t rangeCount);
+
+        /// Records items [begin, end) into a list that is in the frame's base state
+        using RecordRangeFunc = std::function<void(CommandList& list, uint32_t begin, uint32_t end)>;
+
+        /**
+         * @brief Record a range of items across job workers
+         * @param itemCount Number of items (chunks, render items) to split
+         * @param record Called once per range, possibly on a worker thread
+         * @param minItemsPerList Ranges are at least this long; smaller batches record inline
+         *
+         * Closes the current list, records one pooled list per range in
+         * parallel and continues the frame on a fresh list. Every list is
+         * given the frame's render targets, viewport, basic pipeline,
+         * descriptor heaps and frame constants before record runs, and all of
+         * them are submitted in order by one ExecuteCommandLists at EndFrame.
+         * record must only touch its own list and thread-safe state.
+         */
+        void RecordParallel(uint32_t itemCount, const RecordRangeFunc& record, uint32_t minItemsPerList = 64);
+
+        /**
+         * @brief Restore the frame's render targets, viewport, pipeline and constants on the current list
+         *
+         * For passes that drew into their own targets (e.g. shadow maps) in
+         * the middle of the frame.
+         */
+        void RebindFrameState();
+
+        /**
+         * @brief Rebuild the Hi-Z pyramid from the main depth buffer
+         * @param viewProjection View-projection the depth was rendered with
+         *
+         * Call at most once per frame, inside a pass that writes the depth
+         * buffer: after the depth pre-pass when one ran, at the end of the
+         * scene otherwise. Restores the frame state afterwards.
+         */
+        void BuildHiZ(const DirectX::XMMATRIX& viewProjection);
+
+        // ====================================================================
+        // Dynamic Resolution
+        // ====================================================================
+
+        /**
+         * @brief Configure dynamic resolution; takes effect at the next BeginFrame
+         *
+         * While enabled, scene passes draw into GetSceneColorHandle at
+         * GetRenderWidth x GetRenderHeight, and an upscale pass
+         * (UpscaleSceneColor) must copy the result to the back buffer before
+         * native-resolution UI.
+         */
+        void SetDynamicResolution(const DynamicResolutionConfig& config) { m_DynamicResolution.SetConfig(config); }
+
+        const DynamicResolution& GetDynamicResolution() const { return m_DynamicResolution; }
+
+        /**
+         * @brief Check if this frame renders the scene at a scaled resolution
+         */
+        bool IsDynamicResolutionActive() const { return m_DynamicResolution.IsActive(); }
+
+        /**
+         * @brief Stretch the scaled scene onto the back buffer
+         *
+         * Record in a pass that reads GetSceneColorHandle as a pixel shader
+         * resource and writes the back buffer. Leaves the back buffer bound
+         * at full size.
+         */
+        void UpscaleSceneColor();
+
+        /**
+         * @brief Check if the Hi-Z pyramid was rebuilt during the current frame
+         */
+        bool IsHiZBuilt() const { return m_HiZBuilt; }
+
+        /**
+         * @brief Get the Hi-Z pyramid (readable by every shader stage between builds)
+         */
+        HiZPyramid& GetHiZ() { return m_HiZ; }
+        const HiZPyramid& GetHiZ() const { return m_HiZ; }
+
         // Accessors
         DX12Core* GetCore() { return &m_Core; }
         const DX12Core* GetCore() const { return &m_Core; }
 
         uint32_t GetWidth() const { return m_Core.GetWidth(); }
         uint32_t GetHeight() const { return m_Core.GetHeight(); }
+
+        /// Viewport size of the scene this frame (the output size unless dynamic resolution is active)
+        uint32_t GetRenderWidth() const { return m_DynamicResolution.IsActive() ? m_DynamicResolution.GetRenderWidth() : m_Core.GetWidth(); }
+        uint32_t GetRenderHeight() const { return m_DynamicResolution.IsActive() ? m_DynamicResolution.GetRenderHeight() : m_Core.GetHeight(); }
         float GetAspectRatio() const { return m_Core.GetAspectRatio(); }
 
         Camera& GetCamera() { return m_Camera; }
@@ -223,6 +452,22 @@ namespace SM
          */
         Mesh* GetPrimitiveMesh(uint32_t type);
 
+        /**
+         * @brief Get a level of detail of a primitive mesh
+         * @param type Primitive type (Cube, Sphere, etc.)
+         * @param lod 0 for the full mesh; clamped to the coarsest level built
+         * @return Pointer to mesh, nullptr if invalid
+         */
+        Mesh* GetPrimitiveMesh(uint32_t type, uint32_t lod);
+
+        /**
+         * @brief Get the number of levels of detail of a primitive mesh (1 if none were generated)
+         */
+        uint32_t GetPrimitiveLODCount(uint32_t type) const;
+
+        /// Most levels of detail generated per primitive, level 0 included
+        static constexpr uint32_t MAX_PRIMITIVE_LODS = 4;
+
         /**
          * @brief Check if renderer is initialized
          */
@@ -231,15 +476,52 @@ namespace SM
         /**
          * @brief Get the native command list for external rendering
          * @return Native DX12 command list, nullptr if not recording
-         * @note Only valid between BeginFrame and EndFrame
+         * @note Only valid between BeginFrame and EndFrame; changes after RecordParallel
          */
-        ID3D12GraphicsCommandList* GetCommandList() const { return m_CommandList.GetNative(); }
+        ID3D12GraphicsCommandList* GetCommandList() const { return m_CurrentList->GetNative(); }
 
         /**
          * @brief Get the command list wrapper
-         * @return Reference to command list wrapper
+         * @return Reference to the list currently being recorded
+         */
+        CommandList& GetCommandListWrapper() { return *m_CurrentList; }
+
+        /**
+         * @brief Get the per-frame constant allocator
+         * @return Allocator for per-draw constants, rewound every BeginFrame
+         * @note Only valid between BeginFrame and EndFrame
+         */
+        FrameConstantAllocator& GetFrameConstants() { return m_FrameConstants; }
+
+        /**
+         * @brief Get the frame's render graph
+         * @note Add passes between BeginFrame and EndFrame
+         */
+        RenderGraph& GetRenderGraph() { return m_RenderGraph; }
+        const RenderGraph& GetRenderGraph() const { return m_RenderGraph; }
+
+        /**
+         * @brief Get the mip streamer; updated at BeginFrame before any pass
          */
-        CommandList& GetCommandListWrapper() { return m_CommandList; }
+        TextureStreamer& GetTextureStreamer() { return m_TextureStreamer; }
+        const TextureStreamer& GetTextureStreamer() const { return m_TextureStreamer; }
+
+        /**
+         * @brief Get the current back buffer in this frame's graph (left in PRESENT)
+         */
+        RGResourceHandle GetBackBufferHandle() const { return m_BackBufferHandle; }
+
+        /**
+         * @brief Get the main depth buffer in this frame's graph (left in DEPTH_WRITE)
+         */
+        RGResourceHandle GetDepthHandle() const { return m_DepthHandle; }
+
+        /**
+         * @brief Get the target scene passes draw into this frame
+         *
+         * The dynamic resolution target while it is active, else the back buffer.
+         */
+        RGResourceHandle GetSceneColorHandle() const { return m_SceneColorHandle; }
 
     private:
         /**
@@ -257,6 +539,11 @@ namespace SM
          */
         bool CreatePipelineStates();
 
+        /**
+         * @brief Create the command signature of DrawMeshInstancesIndirect
+         */
+        bool CreateIndirectSignature();
+
         /**
          * @brief Create constant buffers
          */
@@ -267,39 +554,99 @@ namespace SM
          */
         bool CreatePrimitiveMeshes();
 
+        /**
+         * @brief Simplify a primitive's optimized data into its coarser levels of detail
+         */
+        bool CreatePrimitiveLODs(uint32_t type, const MeshData& data);
+
         /**
          * @brief Create default textures
          */
         bool CreateDefaultTextures();
 
+        /**
+         * @brief Put a freshly begun list into the frame's base state
+         */
+        void BindFrameState(CommandList& list);
+
+        /**
+         * @brief Record depth-only draws of batches whose instances are at a GPU address
+         *
+         * The pipeline and frame constants must already be bound.
+         */
+        void RecordDepthBatches(CommandList& list, const std::vector<MeshBatch>& batches, size_t instanceCount,
+                                D3D12_GPU_VIRTUAL_ADDRESS instances);
+
+        /**
+         * @brief Record one mesh draw into a list (thread-safe for distinct lists)
+         */
+        void RecordMeshDraw(CommandList& list, const Mesh& mesh, const MaterialData& material,
+                            const DirectX::XMMATRIX& worldMatrix, uint32_t baseTextureIndex);
+
+        /**
+         * @brief Close the current list and queue it for this frame's submission
+         */
+        void CloseCurrentList();
+
     private:
         // Initialization state
         bool m_Initialized = false;
 
+        // Basic root signature slots (see CreateBasicRootSignature)
+        static constexpr uint32_t ROOT_DRAW_CONSTANTS = 3;
+        static constexpr uint32_t ROOT_BINDLESS_TABLE = 4;
+        static constexpr uint32_t ROOT_INSTANCE_BUFFER = 5;
+
         // Core DX12 resources
         DX12Core m_Core;
-        CommandList m_CommandList;
+        CommandList m_CommandList;              // First list of every frame (FrameContext allocator)
+        CommandList* m_CurrentList = &m_CommandList;
+
+        // Extra lists for parallel recording and the segments that follow them
+        static constexpr uint32_t PARALLEL_LIST_COUNT = 16;
+        CommandListPool m_ListPool;
+        std::vector<ID3D12CommandList*> m_FrameLists;   // Closed lists in submission order
+
+        // Frame passes and their barriers
+        RenderGraph m_RenderGraph;
+        RGResourceHandle m_BackBufferHandle;
+        RGResourceHandle m_DepthHandle;
+        RGResourceHandle m_SceneColorHandle;
+        D3D12_CPU_DESCRIPTOR_HANDLE m_SceneRTV = {};    // Bound by BindFrameState
+
+        // Render scale from GPU frame time, and the scaled scene target
+        DynamicResolution m_DynamicResolution;
+
+        // Mip residency of streamed textures
+        TextureStreamer m_TextureStreamer;
+
+        // Hierarchical depth of the main depth buffer
+        HiZPyramid m_HiZ;
+        bool m_HiZBuilt = false;                        // Built since BeginFrame
 
         // Shaders
         ShaderBytecode m_VertexShader;
+        ShaderBytecode m_InstancedVertexShader;
         ShaderBytecode m_PixelShader;
 
         // Pipeline resources
         RootSignature m_RootSignature;
         GraphicsPipelineState m_OpaquePSO;
+        GraphicsPipelineState m_InstancedPSO;
+        GraphicsPipelineState m_InstancedDepthPSO;   // Shadow casters: no pixel shader, biased depth
+        GraphicsPipelineState m_InstancedPrepassPSO; // Depth pre-pass: no pixel shader, main depth format
         GraphicsPipelineState m_WireframePSO;
+        ComPtr<ID3D12CommandSignature> m_InstancedCommandSignature;
 
-        // Constant buffers
-        std::unique_ptr<ConstantBuffer> m_PerFrameCB;
-        std::unique_ptr<ConstantBuffer> m_PerObjectCB;
-        std::unique_ptr<ConstantBuffer> m_MaterialCB;
-
-        // Upload heap for dynamic allocations
-        std::unique_ptr<UploadHeap> m_UploadHeap;
+        // Per-frame rings for frame, object and material constants
+        FrameConstantAllocator m_FrameConstants;
 
         // Camera
         Camera m_Camera;
         PerFrameData m_FrameData;
+        D3D12_GPU_VIRTUAL_ADDRESS m_FrameCBAddress = 0;  // Rebound on every list of the frame
+        void* m_FrameCBMapped = nullptr;                 // Ring copy of m_FrameData, for late latching
+        PreSubmitCallback m_PreSubmitCallback;
 
         // Primitive meshes
         std::unique_ptr<Mesh> m_CubeMesh;
@@ -308,6 +655,7 @@ namespace SM
         std::unique_ptr<Mesh> m_CylinderMesh;
         std::unique_ptr<Mesh> m_ConeMesh;
         std::unique_ptr<Mesh> m_QuadMesh;
+        std::array<std::vector<std::unique_ptr<Mesh>>, 7> m_PrimitiveLODs;    // Levels 1+, indexed by primitive type
 
         // Default textures
         std::unique_ptr<Texture> m_WhiteTexture;
@@ -2,6 +2,7 @@
 
 #include <iostream>
 #include <cassert>
+#include <climits>
 
 namespace SM
 {
@@ -9,6 +10,7 @@ namespace SM
     {
         // Reset state
         m_RootSignature.Reset();
+        m_Hash = 0;
         m_Parameters.clear();
         m_StaticSamplers.clear();
         m_DescriptorRanges.clear();
@@ -98,7 +100,7 @@ namespace SM
             d3dRange.NumDescriptors = range.NumDescriptors;
             d3dRange.BaseShaderRegister = range.BaseShaderRegister;
             d3dRange.RegisterSpace = range.RegisterSpace;
-            d3dRange.Flags = D3D12_DESCRIPTOR_RANGE_FLAG_NONE;
+            d3dRange.Flags = range.Flags;
             d3dRange.OffsetInDescriptorsFromTableStart = range.OffsetInDescriptorsFromTableStart;
 
             d3dRanges.push_back(d3dRange);
@@ -131,6 +133,24 @@ namespace SM
         return AddDescriptorTable({ range }, visibility);
     }
 
+    RootSignature& RootSignature::AddBindlessTable(ShaderVisibility visibility)
+    {
+        // Overlapping ranges over the same heap; the shader picks the view
+        // type by which array it indexes
+        DescriptorRange textures;
+        textures.Type = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
+        textures.NumDescriptors = UINT_MAX;
+        textures.BaseShaderRegister = 0;
+        textures.RegisterSpace = BINDLESS_TEXTURE_SPACE;
+        textures.OffsetInDescriptorsFromTableStart = 0;
+        textures.Flags = D3D12_DESCRIPTOR_RANGE_FLAG_DESCRIPTORS_VOLATILE;
+
+        DescriptorRange buffers = textures;
+        buffers.RegisterSpace = BINDLESS_BUFFER_SPACE;
+
+        return AddDescriptorTable({ textures, buffers }, visibility);
+    }
+
     RootSignature& RootSignature::AddCBVTable(
         uint32_t numDescriptors,
         uint32_t baseRegister,
@@ -263,6 +283,7 @@ namespace SM
             return false;
         }
 
+        m_Hash = HashBytes(signature->GetBufferPointer(), signature->GetBufferSize());
         return true;
     }
 
@@ -270,14 +291,18 @@ namespace SM
     {
         return rootSignature
             .Begin(RootSignatureFlags::AllowInputAssemblerInputLayout)
-            // b0 - Per-frame constants (View, Projection)
-            .AddCBV(0, 0, ShaderVisibility::Vertex)
+            // b0 - Per-frame constants (View, Projection, camera position)
+            .AddCBV(0, 0, ShaderVisibility::All)
             // b1 - Per-object constants (World matrix)
             .AddCBV(1, 0, ShaderVisibility::Vertex)
             // b2 - Material constants
             .AddCBV(2, 0, ShaderVisibility::Pixel)
-            // t0 - Texture (optional)
-            .AddSRVTable(1, 0, 0, ShaderVisibility::Pixel)
+            // b3 - Draw constants (bindless texture index)
+            .AddConstants(1, 3, 0, ShaderVisibility::Pixel)
+            // t0, space1/space2 - Bindless heap
+            .AddBindlessTable(ShaderVisibility::Pixel)
+            // t0 - Instance transforms (instanced draws only)
+            .AddSRV(0, 0, ShaderVisibility::Vertex)
             // s0 - Linear sampler
             .AddLinearSampler(0, ShaderVisibility::Pixel)
             .Build(core);
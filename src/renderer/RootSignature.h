@@ -78,8 +78,15 @@ namespace SM
         uint32_t BaseShaderRegister = 0;
         uint32_t RegisterSpace = 0;
         uint32_t OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
+        D3D12_DESCRIPTOR_RANGE_FLAGS Flags = D3D12_DESCRIPTOR_RANGE_FLAG_NONE;
     };
 
+    /// Register space of the bindless Texture2D array (t0, space1)
+    constexpr uint32_t BINDLESS_TEXTURE_SPACE = 1;
+
+    /// Register space of the bindless ByteAddressBuffer array (t0, space2)
+    constexpr uint32_t BINDLESS_BUFFER_SPACE = 2;
+
     /**
      * @brief Static sampler configuration
      */
@@ -206,6 +213,25 @@ namespace SM
             ShaderVisibility visibility = ShaderVisibility::Pixel
         );
 
+        /**
+         * @brief Add the bindless table covering the whole CBV/SRV/UAV heap
+         * @param visibility Shader visibility
+         * @return Reference to this builder
+         *
+         * Declares unbounded SRV ranges at t0 in BINDLESS_TEXTURE_SPACE and
+         * BINDLESS_BUFFER_SPACE, both starting at the table base. Bind the
+         * table to the heap start once per command list; a resource's heap
+         * index (Texture::GetBindlessIndex, GPUBuffer::GetBindlessIndex) then
+         * indexes the matching array directly:
+         * @code
+         *   Texture2D<float4> g_Textures[] : register(t0, space1);
+         *   ByteAddressBuffer g_Buffers[]  : register(t0, space2);
+         * @endcode
+         * The ranges are descriptor-volatile, so unused slots may hold any
+         * view type or nothing at all.
+         */
+        RootSignature& AddBindlessTable(ShaderVisibility visibility = ShaderVisibility::All);
+
         /**
          * @brief Add CBV descriptor table (convenience)
          * @param numDescriptors Number of CBVs
@@ -296,8 +322,16 @@ namespace SM
          */
         uint32_t GetParameterCount() const { return static_cast<uint32_t>(m_Parameters.size()); }
 
+        /**
+         * @brief Get a hash of the serialized signature (0 before Build)
+         *
+         * Identifies the signature across runs for the pipeline library.
+         */
+        uint64_t GetHash() const { return m_Hash; }
+
     private:
         ComPtr<ID3D12RootSignature> m_RootSignature;
+        uint64_t m_Hash = 0;
 
         D3D12_ROOT_SIGNATURE_FLAGS m_Flags = D3D12_ROOT_SIGNATURE_FLAG_NONE;
         std::vector<D3D12_ROOT_PARAMETER1> m_Parameters;
@@ -309,6 +343,11 @@ namespace SM
 
     /**
      * @brief Create a basic root signature for simple rendering
+     *
+     * Slots: 0 per-frame CBV (b0), 1 per-object CBV (b1), 2 material CBV
+     * (b2), 3 draw root constants (b3), 4 bindless table, 5 instance
+     * buffer SRV (t0).
+     *
      * @param core DX12 core reference
      * @param rootSignature Output root signature
      * @return true if successful
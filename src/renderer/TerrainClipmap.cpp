@@ -0,0 +1,435 @@
+#include "renderer/TerrainClipmap.h"
+#include "pcg/ChunkManager.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+namespace PCG
+{
+    namespace
+    {
+        /// Index variants: the full grid, then the hole at each (0|1, 0|1) offset
+        constexpr uint32_t VARIANT_COUNT = 5;
+
+        /// Smallest grid that leaves room for the morph band between nested levels
+        constexpr uint32_t MIN_GRID_SIZE = 32;
+
+        D3D12_RESOURCE_BARRIER Transition(ID3D12Resource* resource,
+                                          D3D12_RESOURCE_STATES before, D3D12_RESOURCE_STATES after)
+        {
+            D3D12_RESOURCE_BARRIER barrier = {};
+            barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+            barrier.Transition.pResource = resource;
+            barrier.Transition.StateBefore = before;
+            barrier.Transition.StateAfter = after;
+            barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+            return barrier;
+        }
+    }
+
+    TerrainClipmap::~TerrainClipmap()
+    {
+        Shutdown();
+    }
+
+    // ============================================================================
+    // Initialization
+    // ============================================================================
+
+    bool TerrainClipmap::Initialize(SM::DX12Core* core, uint32_t levelCount, uint32_t gridSize, float baseSpacing)
+    {
+        Shutdown();
+
+        if (!core || levelCount == 0 || baseSpacing <= 0.0f)
+        {
+            std::cerr << "[TerrainClipmap] Invalid clipmap parameters" << std::endl;
+            return false;
+        }
+
+        m_Core = core;
+
+        // Levels are centred on even vertices and holes start a quarter in,
+        // so the grid must split into quarters
+        m_GridSize = (std::max(gridSize, MIN_GRID_SIZE) + 3) & ~3u;
+        m_RingSize = m_GridSize + 3;
+        m_MorphWidth = static_cast<float>(m_GridSize) / 10.0f;
+
+        m_Levels.assign(levelCount, Level());
+        for (uint32_t i = 0; i < levelCount; ++i)
+        {
+            m_Levels[i].Step = baseSpacing * static_cast<float>(1u << i);
+        }
+
+        const size_t ringTexels = static_cast<size_t>(m_RingSize) * m_RingSize;
+        m_Heights.assign(ringTexels * levelCount, 0.0f);
+
+        // Full grid for the finest level, then every hole placement
+        std::vector<uint32_t> indices;
+        for (uint32_t variant = 0; variant < VARIANT_COUNT; ++variant)
+        {
+            m_IndexStarts[variant] = static_cast<uint32_t>(indices.size());
+
+            if (variant == 0)
+            {
+                GenerateRingIndices(indices, m_GridSize, -1, -1);
+            }
+            else
+            {
+                const int quarter = static_cast<int>(m_GridSize / 4);
+                GenerateRingIndices(indices, m_GridSize,
+                    quarter + static_cast<int>((variant - 1) & 1), quarter + static_cast<int>((variant - 1) >> 1));
+            }
+
+            m_IndexCounts[variant] = static_cast<uint32_t>(indices.size()) - m_IndexStarts[variant];
+        }
+
+        m_IndexBuffer = std::make_unique<SM::IndexBuffer>();
+        if (!m_IndexBuffer->Initialize(
+            m_Core,
+            static_cast<uint32_t>(indices.size()),
+            true,  // 32-bit indices
+            SM::GPUBufferUsage::Upload,
+            indices.data()))
+        {
+            std::cerr << "[TerrainClipmap] Failed to create ring index buffer!" << std::endl;
+            m_IndexBuffer.reset();
+            return false;
+        }
+
+        m_HeightBuffer = std::make_unique<SM::GPUBuffer>();
+        if (!m_HeightBuffer->Initialize(m_Core, m_Heights.size() * sizeof(float), SM::GPUBufferUsage::Default))
+        {
+            std::cerr << "[TerrainClipmap] Failed to create height buffer!" << std::endl;
+            m_HeightBuffer.reset();
+            m_IndexBuffer.reset();
+            return false;
+        }
+        m_HeightState = D3D12_RESOURCE_STATE_COMMON;
+
+        m_Stats = ClipmapStats();
+        m_Stats.Levels = levelCount;
+        m_Stats.GPUBytes = m_HeightBuffer->GetSize() + indices.size() * sizeof(uint32_t);
+
+        m_Initialized = true;
+        return true;
+    }
+
+    void TerrainClipmap::Shutdown()
+    {
+        if (!m_Initialized)
+        {
+            return;
+        }
+
+        // Frames in flight may still read the rings and indices
+        if (m_HeightBuffer && m_HeightBuffer->GetResource())
+        {
+            m_Core->DeferRelease(m_HeightBuffer->GetResource());
+        }
+        if (m_IndexBuffer && m_IndexBuffer->GetResource())
+        {
+            m_Core->DeferRelease(m_IndexBuffer->GetResource());
+        }
+
+        m_HeightBuffer.reset();
+        m_IndexBuffer.reset();
+        m_Levels.clear();
+        m_Heights.clear();
+        m_Scratch.clear();
+        m_Stats = ClipmapStats();
+
+        m_Initialized = false;
+        m_Core = nullptr;
+    }
+
+    void TerrainClipmap::GenerateRingIndices(std::vector<uint32_t>& indices, uint32_t gridSize, int holeX, int holeZ)
+    {
+        const uint32_t verticesPerSide = gridSize + 1;
+        const int holeSize = static_cast<int>(gridSize / 2);
+
+        for (uint32_t z = 0; z < gridSize; ++z)
+        {
+            for (uint32_t x = 0; x < gridSize; ++x)
+            {
+                // The finer level covers the hole
+                if (holeX >= 0 &&
+                    static_cast<int>(x) >= holeX && static_cast<int>(x) < holeX + holeSize &&
+                    static_cast<int>(z) >= holeZ && static_cast<int>(z) < holeZ + holeSize)
+                {
+                    continue;
+                }
+
+                uint32_t topLeft = z * verticesPerSide + x;
+                uint32_t topRight = topLeft + 1;
+                uint32_t bottomLeft = (z + 1) * verticesPerSide + x;
+                uint32_t bottomRight = bottomLeft + 1;
+
+                // Same split and winding as chunk meshes (Chunk::GenerateLODIndices)
+                indices.push_back(topLeft);
+                indices.push_back(bottomLeft);
+                indices.push_back(bottomRight);
+
+                indices.push_back(topLeft);
+                indices.push_back(bottomRight);
+                indices.push_back(topRight);
+            }
+        }
+    }
+
+    // ============================================================================
+    // Height Rings
+    // ============================================================================
+
+    void TerrainClipmap::Update(const ChunkManager& chunks, const DirectX::XMFLOAT3& cameraPosition)
+    {
+        m_Stats.SampledHeights = 0;
+        if (!m_Initialized)
+        {
+            return;
+        }
+
+        m_Camera = DirectX::XMFLOAT2(cameraPosition.x, cameraPosition.z);
+
+        const int halfGrid = static_cast<int>(m_GridSize / 2);
+        const int ringSize = static_cast<int>(m_RingSize);
+
+        for (uint32_t i = 0; i < m_Levels.size(); ++i)
+        {
+            Level& level = m_Levels[i];
+
+            // Centre on an even vertex so the level's corners lie on its parent's grid
+            const float doubleStep = level.Step * 2.0f;
+            const int originX = static_cast<int>(std::floor(cameraPosition.x / doubleStep)) * 2 - halfGrid;
+            const int originZ = static_cast<int>(std::floor(cameraPosition.z / doubleStep)) * 2 - halfGrid;
+
+            if (level.Valid && originX == level.OriginX && originZ == level.OriginZ)
+            {
+                continue;
+            }
+
+            // The ring holds one border texel on each side for central-difference normals
+            const int newX = originX - 1;
+            const int newZ = originZ - 1;
+            const int oldX = level.OriginX - 1;
+            const int oldZ = level.OriginZ - 1;
+
+            if (!level.Valid || std::abs(newX - oldX) >= ringSize || std::abs(newZ - oldZ) >= ringSize)
+            {
+                SampleRegion(chunks, i, newX, newZ, ringSize, ringSize);
+            }
+            else
+            {
+                // Columns that scrolled in, over the whole new window
+                if (newX < oldX)
+                {
+                    SampleRegion(chunks, i, newX, newZ, oldX - newX, ringSize);
+                }
+                else if (newX > oldX)
+                {
+                    SampleRegion(chunks, i, oldX + ringSize, newZ, newX - oldX, ringSize);
+                }
+
+                // Rows that scrolled in, over the columns that were kept
+                const int keptX = std::max(newX, oldX);
+                const int keptWidth = std::min(newX, oldX) + ringSize - keptX;
+                if (newZ < oldZ)
+                {
+                    SampleRegion(chunks, i, keptX, newZ, keptWidth, oldZ - newZ);
+                }
+                else if (newZ > oldZ)
+                {
+                    SampleRegion(chunks, i, keptX, oldZ + ringSize, keptWidth, newZ - oldZ);
+                }
+            }
+
+            level.OriginX = originX;
+            level.OriginZ = originZ;
+            level.Valid = true;
+            level.Dirty = true;
+        }
+    }
+
+    void TerrainClipmap::Invalidate()
+    {
+        for (Level& level : m_Levels)
+        {
+            level.Valid = false;
+        }
+    }
+
+    void TerrainClipmap::SampleRegion(const ChunkManager& chunks, uint32_t level, int x0, int z0, int width, int height)
+    {
+        if (width <= 0 || height <= 0)
+        {
+            return;
+        }
+
+        const float step = m_Levels[level].Step;
+        m_Scratch.resize(static_cast<size_t>(width) * height);
+        chunks.SampleTerrainGrid(static_cast<float>(x0) * step, static_cast<float>(z0) * step, step,
+                                 width, height, m_Scratch.data());
+
+        float* ring = m_Heights.data() + static_cast<size_t>(level) * m_RingSize * m_RingSize;
+        for (int z = 0; z < height; ++z)
+        {
+            float* row = ring + static_cast<size_t>(Wrap(z0 + z)) * m_RingSize;
+            const float* source = m_Scratch.data() + static_cast<size_t>(z) * width;
+            for (int x = 0; x < width; ++x)
+            {
+                row[Wrap(x0 + x)] = source[x];
+            }
+        }
+
+        m_Stats.SampledHeights += static_cast<uint32_t>(width * height);
+    }
+
+    uint32_t TerrainClipmap::Wrap(int index) const
+    {
+        const int ringSize = static_cast<int>(m_RingSize);
+        return static_cast<uint32_t>(((index % ringSize) + ringSize) % ringSize);
+    }
+
+    const float* TerrainClipmap::GetRingHeights(uint32_t level) const
+    {
+        return m_Heights.data() + static_cast<size_t>(level) * m_RingSize * m_RingSize;
+    }
+
+    // ============================================================================
+    // Rendering
+    // ============================================================================
+
+    uint32_t TerrainClipmap::GetVariant(uint32_t level) const
+    {
+        if (level == 0)
+        {
+            return 0;
+        }
+
+        // The finer level starts a quarter in, or one vertex further
+        const Level& finer = m_Levels[level - 1];
+        const Level& coarse = m_Levels[level];
+        const int quarter = static_cast<int>(m_GridSize / 4);
+        const int dx = std::clamp(finer.OriginX / 2 - coarse.OriginX - quarter, 0, 1);
+        const int dz = std::clamp(finer.OriginZ / 2 - coarse.OriginZ - quarter, 0, 1);
+        return 1 + static_cast<uint32_t>(dx + dz * 2);
+    }
+
+    float TerrainClipmap::GetCoverage() const
+    {
+        if (m_Levels.empty())
+        {
+            return 0.0f;
+        }
+
+        // The camera sits up to two vertices off the centre
+        return static_cast<float>(m_GridSize / 2 - 2) * m_Levels.back().Step;
+    }
+
+    uint32_t TerrainClipmap::Record(ID3D12GraphicsCommandList* cmdList, SM::FrameConstantAllocator& frameConstants,
+                                    uint32_t levelRootParameter, uint32_t heightRootParameter,
+                                    float textureScale, float minHeight, float maxHeight)
+    {
+        m_Stats.UploadedLevels = 0;
+        m_Stats.Triangles = 0;
+
+        if (!m_Initialized || !cmdList)
+        {
+            return 0;
+        }
+
+        // Re-upload whole rings that changed; only the scrolled-in texels were resampled
+        const size_t ringBytes = static_cast<size_t>(m_RingSize) * m_RingSize * sizeof(float);
+        ID3D12Resource* heightResource = m_HeightBuffer->GetResource();
+
+        for (uint32_t i = 0; i < m_Levels.size(); ++i)
+        {
+            Level& level = m_Levels[i];
+            if (!level.Dirty)
+            {
+                continue;
+            }
+
+            SM::FrameAllocation staging = frameConstants.AllocateTransient(ringBytes, sizeof(float));
+            if (!staging.IsValid())
+            {
+                break;
+            }
+            std::memcpy(staging.CPUPointer, GetRingHeights(i), ringBytes);
+
+            if (m_HeightState != D3D12_RESOURCE_STATE_COPY_DEST)
+            {
+                D3D12_RESOURCE_BARRIER barrier = Transition(heightResource, m_HeightState, D3D12_RESOURCE_STATE_COPY_DEST);
+                cmdList->ResourceBarrier(1, &barrier);
+                m_HeightState = D3D12_RESOURCE_STATE_COPY_DEST;
+            }
+
+            cmdList->CopyBufferRegion(heightResource, i * ringBytes, staging.Resource, staging.Offset, ringBytes);
+            level.Dirty = false;
+            m_Stats.UploadedLevels++;
+        }
+
+        if (m_HeightState != D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE)
+        {
+            D3D12_RESOURCE_BARRIER barrier = Transition(heightResource, m_HeightState, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+            cmdList->ResourceBarrier(1, &barrier);
+            m_HeightState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
+        }
+
+        cmdList->SetGraphicsRootShaderResourceView(heightRootParameter, m_HeightBuffer->GetGPUAddress());
+
+        D3D12_INDEX_BUFFER_VIEW ibv = m_IndexBuffer->GetView();
+        cmdList->IASetIndexBuffer(&ibv);
+
+        // Finest first, so nearer terrain fills the depth buffer early
+        uint32_t draws = 0;
+        for (uint32_t i = 0; i < m_Levels.size(); ++i)
+        {
+            const Level& level = m_Levels[i];
+            if (!level.Valid)
+            {
+                continue;
+            }
+
+            const bool hasParent = i + 1 < m_Levels.size();
+
+            ClipmapLevelData data = {};
+            data.GridOrigin = DirectX::XMFLOAT2(static_cast<float>(level.OriginX) * level.Step,
+                                                static_cast<float>(level.OriginZ) * level.Step);
+            data.GridStep = level.Step;
+            data.MorphWidth = m_MorphWidth;
+            data.CameraGrid = DirectX::XMFLOAT2(m_Camera.x / level.Step - static_cast<float>(level.OriginX),
+                                                m_Camera.y / level.Step - static_cast<float>(level.OriginZ));
+            data.RingSize = m_RingSize;
+            data.GridSize = m_GridSize;
+            data.RingOffset[0] = Wrap(level.OriginX);
+            data.RingOffset[1] = Wrap(level.OriginZ);
+            data.ParentRingOffset[0] = Wrap(level.OriginX / 2);
+            data.ParentRingOffset[1] = Wrap(level.OriginZ / 2);
+            data.HeightOffset = static_cast<uint32_t>(i * ringBytes);
+            data.ParentHeightOffset = hasParent ? static_cast<uint32_t>((i + 1) * ringBytes) : 0;
+            data.HasParent = hasParent ? 1u : 0u;
+            data.TextureScale = textureScale;
+            data.MinHeight = minHeight;
+            data.MaxHeight = maxHeight;
+
+            D3D12_GPU_VIRTUAL_ADDRESS levelCB = frameConstants.Push(data);
+            if (levelCB == 0)
+            {
+                break;
+            }
+
+            const uint32_t variant = GetVariant(i);
+            cmdList->SetGraphicsRootConstantBufferView(levelRootParameter, levelCB);
+            cmdList->DrawIndexedInstanced(m_IndexCounts[variant], 1, m_IndexStarts[variant], 0, 0);
+
+            m_Stats.Triangles += m_IndexCounts[variant] / 3;
+            draws++;
+        }
+
+        return draws;
+    }
+
+} // namespace PCG
@@ -0,0 +1,206 @@
+#pragma once
+
+/**
+ * @file TerrainClipmap.h
+ * @brief Geometry clipmap terrain: nested camera-centred grids over toroidal height rings
+ *
+ * An alternative to drawing ChunkManager's per-chunk meshes. A fixed set of
+ * nested square grids (levels), each twice as coarse as the one inside it,
+ * follows the camera; every level is one indexed draw of a shared ring
+ * topology, with vertex positions rebuilt from SV_VertexID and heights read
+ * from that level's ring in one raw height buffer (shaders/TerrainClipmap.hlsl).
+ *
+ * Rings are addressed toroidally: when a level moves, only the rows and
+ * columns that scrolled into view are sampled (ChunkManager::SampleTerrainGrid)
+ * and the level's ring is re-uploaded. Vertex memory and draw count are
+ * constant, and grid density is uniform in screen space. Vertices near a
+ * level's outer edge blend toward the next coarser level, so adjacent levels
+ * meet without cracks.
+ */
+
+#include "renderer/DX12Core.h"
+#include "renderer/GPUBuffer.h"
+
+#include <DirectXMath.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace PCG
+{
+    class ChunkManager;
+
+    /**
+     * @brief Per-level clipmap constants (ClipmapLevel in TerrainClipmap.hlsl, b3)
+     */
+    struct ClipmapLevelData
+    {
+        DirectX::XMFLOAT2 GridOrigin;       ///< World XZ of grid vertex (0, 0)
+        float GridStep;                     ///< World distance between grid vertices
+        float MorphWidth;                   ///< Grid units over which vertices blend into the parent level
+        DirectX::XMFLOAT2 CameraGrid;       ///< Camera XZ in grid units from GridOrigin
+        uint32_t RingSize;                  ///< Ring texels per side
+        uint32_t GridSize;                  ///< Grid quads per side
+        uint32_t RingOffset[2];             ///< Ring texel of grid vertex (0, 0)
+        uint32_t ParentRingOffset[2];       ///< Parent ring texel of grid vertex (0, 0)
+        uint32_t HeightOffset;              ///< Byte offset of the level's ring in the height buffer
+        uint32_t ParentHeightOffset;        ///< Byte offset of the parent level's ring
+        uint32_t HasParent;                 ///< 0 for the coarsest level (no morphing)
+        float TextureScale;
+        float MinHeight;                    ///< Height range mapped to the color ramp
+        float MaxHeight;
+        float Padding[2];
+    };
+
+    static_assert(sizeof(ClipmapLevelData) % 16 == 0, "ClipmapLevelData must match ClipmapLevel in TerrainClipmap.hlsl");
+
+    /**
+     * @brief Clipmap statistics
+     */
+    struct ClipmapStats
+    {
+        uint32_t Levels = 0;
+        uint32_t SampledHeights = 0;        ///< Heights sampled by the last Update
+        uint32_t UploadedLevels = 0;        ///< Rings uploaded by the last Record
+        uint32_t Triangles = 0;             ///< Triangles drawn by the last Record
+        size_t GPUBytes = 0;                ///< Height and index buffer memory
+    };
+
+    /**
+     * @brief Nested ring grids and toroidal height rings for geometry clipmap terrain
+     *
+     * Per frame: Update() recentres the levels and samples newly exposed
+     * heights, then Record() uploads changed rings and draws every level.
+     * Owned and driven by TerrainRenderer (see TerrainRenderConfig::EnableClipmap).
+     */
+    class TerrainClipmap
+    {
+    public:
+        TerrainClipmap() = default;
+        ~TerrainClipmap();
+
+        // Prevent copying
+        TerrainClipmap(const TerrainClipmap&) = delete;
+        TerrainClipmap& operator=(const TerrainClipmap&) = delete;
+
+        /**
+         * @brief Create the ring index buffer and the height buffer
+         * @param core DX12 core reference
+         * @param levelCount Nested levels (each doubles the covered distance)
+         * @param gridSize Quads per level side (rounded up to a multiple of 4)
+         * @param baseSpacing World distance between finest-level vertices
+         * @return true if successful
+         */
+        bool Initialize(SM::DX12Core* core, uint32_t levelCount, uint32_t gridSize, float baseSpacing);
+
+        /**
+         * @brief Release the buffers (deferred until the GPU is done with them)
+         */
+        void Shutdown();
+
+        /**
+         * @brief Check if the clipmap was created
+         */
+        bool IsInitialized() const { return m_Initialized; }
+
+        /**
+         * @brief Recentre every level on the camera and sample the heights that scrolled in
+         * @param chunks Height source
+         * @param cameraPosition Camera position (only X and Z are used)
+         */
+        void Update(const ChunkManager& chunks, const DirectX::XMFLOAT3& cameraPosition);
+
+        /**
+         * @brief Drop every ring so the next Update resamples all heights (e.g. after terrain settings change)
+         */
+        void Invalidate();
+
+        /**
+         * @brief Upload changed rings and draw every level, finest first
+         * @param cmdList List with the clipmap pipeline, root signature and per-frame constants bound
+         * @param frameConstants This frame's ring for uploads and per-level constants
+         * @param levelRootParameter Root CBV slot of ClipmapLevel (b3)
+         * @param heightRootParameter Root SRV slot of the height buffer (t1)
+         * @param textureScale Texture UV tiling
+         * @param minHeight Height mapped to the bottom of the color ramp
+         * @param maxHeight Height mapped to the top of the color ramp
+         * @return Number of draws recorded
+         */
+        uint32_t Record(ID3D12GraphicsCommandList* cmdList, SM::FrameConstantAllocator& frameConstants,
+                        uint32_t levelRootParameter, uint32_t heightRootParameter,
+                        float textureScale, float minHeight, float maxHeight);
+
+        /**
+         * @brief Get the world distance from the camera to the edge of the coarsest level
+         */
+        float GetCoverage() const;
+
+        uint32_t GetLevelCount() const { return static_cast<uint32_t>(m_Levels.size()); }
+        uint32_t GetGridSize() const { return m_GridSize; }
+        const ClipmapStats& GetStats() const { return m_Stats; }
+
+        /**
+         * @brief Build the indices of one level grid, optionally with the finer level's hole cut out
+         * @param indices Receives (appends) the indices; vertices are row-major by Z over (gridSize + 1)^2
+         * @param gridSize Quads per side (multiple of 4)
+         * @param holeX First hole quad along X (gridSize / 4 or one more), or negative for no hole
+         * @param holeZ First hole quad along Z
+         */
+        static void GenerateRingIndices(std::vector<uint32_t>& indices, uint32_t gridSize, int holeX, int holeZ);
+
+        /**
+         * @brief Get the heights of a level's ring (RingSize^2, toroidally addressed)
+         */
+        const float* GetRingHeights(uint32_t level) const;
+
+    private:
+        /**
+         * @brief CPU state of one level
+         */
+        struct Level
+        {
+            float Step = 1.0f;              ///< World distance between vertices
+            int OriginX = 0;                ///< Sample index of grid vertex (0, 0), in Step units
+            int OriginZ = 0;
+            bool Valid = false;             ///< Ring holds the window around the origin
+            bool Dirty = false;             ///< Ring changed since its last upload
+        };
+
+        /**
+         * @brief Sample a window-relative rectangle of sample indices into a level's ring
+         */
+        void SampleRegion(const ChunkManager& chunks, uint32_t level, int x0, int z0, int width, int height);
+
+        /**
+         * @brief Ring texel of a sample index
+         */
+        uint32_t Wrap(int index) const;
+
+        /**
+         * @brief Index variant for a level: 0 is the full grid, 1-4 have a hole at offsets (0|1, 0|1)
+         */
+        uint32_t GetVariant(uint32_t level) const;
+
+    private:
+        bool m_Initialized = false;
+        SM::DX12Core* m_Core = nullptr;
+
+        uint32_t m_GridSize = 0;            ///< Quads per level side
+        uint32_t m_RingSize = 0;            ///< Texels per ring side (one border texel for normals)
+        float m_MorphWidth = 0.0f;
+
+        std::vector<Level> m_Levels;
+        std::vector<float> m_Heights;       ///< Every ring back to back, finest first
+        std::vector<float> m_Scratch;       ///< Sampled rectangle before it is scattered into a ring
+        DirectX::XMFLOAT2 m_Camera = { 0.0f, 0.0f };
+
+        std::unique_ptr<SM::GPUBuffer> m_HeightBuffer;
+        D3D12_RESOURCE_STATES m_HeightState = D3D12_RESOURCE_STATE_COMMON;
+        std::unique_ptr<SM::IndexBuffer> m_IndexBuffer;
+        uint32_t m_IndexStarts[5] = {};     ///< First index of each variant
+        uint32_t m_IndexCounts[5] = {};
+
+        ClipmapStats m_Stats;
+    };
+
+} // namespace PCG
@@ -0,0 +1,495 @@
+#include "renderer/TerrainFarField.h"
+#include "core/JobSystem.h"
+#include "pcg/ChunkManager.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+namespace PCG
+{
+    namespace
+    {
+        /// Ring vertices farther than this inside the chunk radius are dropped
+        /// (covers the camera's offset from the snapped ring centre)
+        constexpr float INNER_MARGIN = 1.5f;
+
+        D3D12_RESOURCE_BARRIER Transition(ID3D12Resource* resource,
+                                          D3D12_RESOURCE_STATES before, D3D12_RESOURCE_STATES after)
+        {
+            D3D12_RESOURCE_BARRIER barrier = {};
+            barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+            barrier.Transition.pResource = resource;
+            barrier.Transition.StateBefore = before;
+            barrier.Transition.StateAfter = after;
+            barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+            return barrier;
+        }
+    }
+
+    TerrainFarField::~TerrainFarField()
+    {
+        Shutdown();
+    }
+
+    // ============================================================================
+    // Initialization
+    // ============================================================================
+
+    bool TerrainFarField::Initialize(SM::DX12Core* core, float distance, float spacing)
+    {
+        Shutdown();
+
+        if (!core || distance <= 0.0f || spacing <= 0.0f)
+        {
+            std::cerr << "[TerrainFarField] Invalid far-field parameters" << std::endl;
+            return false;
+        }
+
+        m_Core = core;
+        m_Distance = distance;
+        m_Spacing = spacing;
+
+        // Even, so the ring centre lands on a vertex
+        m_GridSize = (static_cast<uint32_t>(std::ceil(2.0f * distance / spacing)) + 1) & ~1u;
+        m_Heights.assign(static_cast<size_t>(m_GridSize + 3) * (m_GridSize + 3), 0.0f);
+
+        m_HeightBuffer = std::make_unique<SM::GPUBuffer>();
+        if (!m_HeightBuffer->Initialize(m_Core, m_Heights.size() * sizeof(float), SM::GPUBufferUsage::Default))
+        {
+            std::cerr << "[TerrainFarField] Failed to create height buffer!" << std::endl;
+            m_HeightBuffer.reset();
+            return false;
+        }
+        m_HeightState = D3D12_RESOURCE_STATE_COMMON;
+
+        m_InnerRadius = -1.0f;
+        m_OriginX = -1;
+        m_OriginZ = -1;
+        m_HasRing = false;
+        m_Dirty = false;
+        m_Stats = FarFieldStats();
+
+        m_Initialized = true;
+        return true;
+    }
+
+    void TerrainFarField::Shutdown()
+    {
+        if (!m_Initialized)
+        {
+            return;
+        }
+
+        // Workers sample through the ChunkManager; finish before it can go away
+        CancelJobs();
+
+        // Frames in flight may still read the heights and indices
+        if (m_HeightBuffer && m_HeightBuffer->GetResource())
+        {
+            m_Core->DeferRelease(m_HeightBuffer->GetResource());
+        }
+        if (m_IndexBuffer && m_IndexBuffer->GetResource())
+        {
+            m_Core->DeferRelease(m_IndexBuffer->GetResource());
+        }
+
+        m_HeightBuffer.reset();
+        m_IndexBuffer.reset();
+        m_Regions.clear();
+        m_Heights.clear();
+        m_HasRing = false;
+        m_Stats = FarFieldStats();
+
+        m_Initialized = false;
+        m_Core = nullptr;
+    }
+
+    void TerrainFarField::GenerateRingIndices(std::vector<uint32_t>& indices, uint32_t gridSize,
+                                              float innerRadius, float outerRadius)
+    {
+        const uint32_t verticesPerSide = gridSize + 1;
+        const float centre = static_cast<float>(gridSize) * 0.5f;
+        const float innerSq = innerRadius > 0.0f ? innerRadius * innerRadius : -1.0f;
+        const float outerSq = outerRadius * outerRadius;
+
+        for (uint32_t z = 0; z < gridSize; ++z)
+        {
+            for (uint32_t x = 0; x < gridSize; ++x)
+            {
+                // Squared distance of the quad's nearest and farthest corners
+                float nearSq = 0.0f;
+                float farSq = 0.0f;
+                for (const uint32_t axis : { x, z })
+                {
+                    const float a = static_cast<float>(axis) - centre;
+                    const float b = a + 1.0f;
+                    const float lo = (a <= 0.0f && b >= 0.0f) ? 0.0f : std::min(std::abs(a), std::abs(b));
+                    const float hi = std::max(std::abs(a), std::abs(b));
+                    nearSq += lo * lo;
+                    farSq += hi * hi;
+                }
+
+                // Streamed chunks cover the inside; nothing is drawn past the far edge
+                if (farSq < innerSq || nearSq > outerSq)
+                {
+                    continue;
+                }
+
+                uint32_t topLeft = z * verticesPerSide + x;
+                uint32_t topRight = topLeft + 1;
+                uint32_t bottomLeft = (z + 1) * verticesPerSide + x;
+                uint32_t bottomRight = bottomLeft + 1;
+
+                // Same split and winding as chunk meshes (Chunk::GenerateLODIndices)
+                indices.push_back(topLeft);
+                indices.push_back(bottomLeft);
+                indices.push_back(bottomRight);
+
+                indices.push_back(topLeft);
+                indices.push_back(bottomRight);
+                indices.push_back(topRight);
+            }
+        }
+    }
+
+    bool TerrainFarField::BuildIndices(float innerRadius)
+    {
+        if (m_IndexBuffer && m_IndexBuffer->GetResource())
+        {
+            m_Core->DeferRelease(m_IndexBuffer->GetResource());
+        }
+        m_IndexBuffer.reset();
+        m_Stats.Triangles = 0;
+        m_Stats.GPUBytes = m_HeightBuffer->GetSize();
+
+        std::vector<uint32_t> indices;
+        GenerateRingIndices(indices, m_GridSize, innerRadius / m_Spacing - INNER_MARGIN,
+                            static_cast<float>(m_GridSize) * 0.5f);
+        if (indices.empty())
+        {
+            // Chunks already reach past the far edge
+            return true;
+        }
+
+        m_IndexBuffer = std::make_unique<SM::IndexBuffer>();
+        if (!m_IndexBuffer->Initialize(
+            m_Core,
+            static_cast<uint32_t>(indices.size()),
+            true,  // 32-bit indices
+            SM::GPUBufferUsage::Upload,
+            indices.data()))
+        {
+            std::cerr << "[TerrainFarField] Failed to create ring index buffer!" << std::endl;
+            m_IndexBuffer.reset();
+            return false;
+        }
+
+        m_Stats.Triangles = static_cast<uint32_t>(indices.size() / 3);
+        m_Stats.GPUBytes = m_HeightBuffer->GetSize() + indices.size() * sizeof(uint32_t);
+        return true;
+    }
+
+    // ============================================================================
+    // Regions
+    // ============================================================================
+
+    int TerrainFarField::FloorDiv(int value, int divisor)
+    {
+        const int quotient = value / divisor;
+        return (value % divisor != 0 && (value < 0) != (divisor < 0)) ? quotient - 1 : quotient;
+    }
+
+    void TerrainFarField::Update(const ChunkManager& chunks, const DirectX::XMFLOAT3& cameraPosition, float innerRadius)
+    {
+        if (!m_Initialized)
+        {
+            return;
+        }
+
+        CollectJobs();
+
+        innerRadius = std::max(innerRadius, 0.0f);
+        if (innerRadius != m_InnerRadius)
+        {
+            BuildIndices(innerRadius);
+            m_InnerRadius = innerRadius;
+        }
+
+        // Snap to whole cells so the ring only changes when the camera crosses one
+        const int halfGrid = static_cast<int>(m_GridSize / 2);
+        const int originX = static_cast<int>(std::floor(cameraPosition.x / m_Spacing)) - halfGrid;
+        const int originZ = static_cast<int>(std::floor(cameraPosition.z / m_Spacing)) - halfGrid;
+
+        if (!m_HasRing || originX != m_OriginX || originZ != m_OriginZ)
+        {
+            // Keep drawing the previous ring until every region under the new one is ready
+            const int last = static_cast<int>(m_GridSize) + 1;
+            if (RequestRegions(chunks, originX - 1, originZ - 1, originX + last, originZ + last))
+            {
+                BuildRing(originX, originZ);
+            }
+        }
+
+        EvictRegions(cameraPosition);
+
+        m_Stats.Regions = static_cast<uint32_t>(m_Regions.size());
+        m_Stats.PendingRegions = static_cast<uint32_t>(m_Jobs.size());
+        m_Stats.RegionBytes = m_Regions.size() * REGION_SAMPLES * REGION_SAMPLES * sizeof(float);
+    }
+
+    void TerrainFarField::Clear()
+    {
+        CancelJobs();
+        m_Regions.clear();
+        m_HasRing = false;
+    }
+
+    bool TerrainFarField::RequestRegions(const ChunkManager& chunks, int minX, int minZ, int maxX, int maxZ)
+    {
+        const int regionMinX = FloorDiv(minX, REGION_SAMPLES);
+        const int regionMinZ = FloorDiv(minZ, REGION_SAMPLES);
+        const int regionMaxX = FloorDiv(maxX, REGION_SAMPLES);
+        const int regionMaxZ = FloorDiv(maxZ, REGION_SAMPLES);
+
+        // Missing regions, nearest to the ring centre first
+        const float centreX = static_cast<float>(minX + maxX) * 0.5f / REGION_SAMPLES - 0.5f;
+        const float centreZ = static_cast<float>(minZ + maxZ) * 0.5f / REGION_SAMPLES - 0.5f;
+
+        std::vector<std::pair<float, ChunkCoord>> missing;
+        for (int z = regionMinZ; z <= regionMaxZ; ++z)
+        {
+            for (int x = regionMinX; x <= regionMaxX; ++x)
+            {
+                const ChunkCoord region(x, z);
+                if (m_Regions.count(region) != 0)
+                {
+                    continue;
+                }
+
+                const float dx = static_cast<float>(x) - centreX;
+                const float dz = static_cast<float>(z) - centreZ;
+                missing.emplace_back(dx * dx + dz * dz, region);
+            }
+        }
+
+        if (missing.empty())
+        {
+            return true;
+        }
+
+        std::sort(missing.begin(), missing.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        SM::JobSystem& jobs = SM::JobSystem::Get();
+        const bool async = jobs.IsInitialized();
+        const float regionSize = static_cast<float>(REGION_SAMPLES) * m_Spacing;
+
+        for (const auto& [distance, region] : missing)
+        {
+            if (m_Jobs.size() >= m_MaxJobsInFlight)
+            {
+                break;
+            }
+
+            const bool queued = std::any_of(m_Jobs.begin(), m_Jobs.end(), [&](const std::unique_ptr<RegionJob>& job) {
+                return job->Region == region;
+            });
+            if (queued)
+            {
+                continue;
+            }
+
+            auto job = std::make_unique<RegionJob>();
+            job->Region = region;
+            job->Heights.resize(static_cast<size_t>(REGION_SAMPLES) * REGION_SAMPLES);
+            job->Counter = std::make_unique<SM::JobCounter>();
+
+            RegionJob* work = job.get();
+            const float step = m_Spacing;
+            auto sample = [&chunks, work, regionSize, step]() {
+                chunks.SampleTerrainGrid(static_cast<float>(work->Region.X) * regionSize,
+                                         static_cast<float>(work->Region.Z) * regionSize,
+                                         step, REGION_SAMPLES, REGION_SAMPLES, work->Heights.data());
+            };
+
+            if (async)
+            {
+                jobs.Run(sample, job->Counter.get());
+            }
+            else
+            {
+                sample();
+            }
+
+            m_Jobs.push_back(std::move(job));
+        }
+
+        // Synchronous sampling finishes in place
+        CollectJobs();
+
+        return std::all_of(missing.begin(), missing.end(), [this](const auto& entry) {
+            return m_Regions.count(entry.second) != 0;
+        });
+    }
+
+    void TerrainFarField::CollectJobs()
+    {
+        for (auto it = m_Jobs.begin(); it != m_Jobs.end();)
+        {
+            RegionJob& job = **it;
+            if (!job.Counter->IsDone())
+            {
+                ++it;
+                continue;
+            }
+
+            m_Regions[job.Region] = std::move(job.Heights);
+            it = m_Jobs.erase(it);
+        }
+    }
+
+    void TerrainFarField::CancelJobs()
+    {
+        SM::JobSystem& jobs = SM::JobSystem::Get();
+        for (const std::unique_ptr<RegionJob>& job : m_Jobs)
+        {
+            if (!job->Counter->IsDone())
+            {
+                jobs.Wait(*job->Counter);
+            }
+        }
+        m_Jobs.clear();
+    }
+
+    void TerrainFarField::BuildRing(int originX, int originZ)
+    {
+        const int ringSize = static_cast<int>(m_GridSize) + 3;
+
+        for (int z = 0; z < ringSize; ++z)
+        {
+            const int sampleZ = originZ - 1 + z;
+            const int regionZ = FloorDiv(sampleZ, REGION_SAMPLES);
+            const int localZ = sampleZ - regionZ * REGION_SAMPLES;
+
+            float* row = m_Heights.data() + static_cast<size_t>(z) * ringSize;
+            const std::vector<float>* region = nullptr;
+            int regionX = 0;
+
+            for (int x = 0; x < ringSize; ++x)
+            {
+                const int sampleX = originX - 1 + x;
+                const int currentRegionX = FloorDiv(sampleX, REGION_SAMPLES);
+                if (!region || currentRegionX != regionX)
+                {
+                    regionX = currentRegionX;
+                    region = &m_Regions.at(ChunkCoord(regionX, regionZ));
+                }
+
+                const int localX = sampleX - regionX * REGION_SAMPLES;
+                row[x] = (*region)[static_cast<size_t>(localZ) * REGION_SAMPLES + localX];
+            }
+        }
+
+        m_OriginX = originX;
+        m_OriginZ = originZ;
+        m_HasRing = true;
+        m_Dirty = true;
+        m_Stats.Rebuilds++;
+    }
+
+    void TerrainFarField::EvictRegions(const DirectX::XMFLOAT3& cameraPosition)
+    {
+        const float regionSize = static_cast<float>(REGION_SAMPLES) * m_Spacing;
+        const float keepDistance = m_Distance + regionSize * 2.0f;
+
+        for (auto it = m_Regions.begin(); it != m_Regions.end();)
+        {
+            const float dx = (static_cast<float>(it->first.X) + 0.5f) * regionSize - cameraPosition.x;
+            const float dz = (static_cast<float>(it->first.Z) + 0.5f) * regionSize - cameraPosition.z;
+            if (dx * dx + dz * dz > keepDistance * keepDistance)
+            {
+                it = m_Regions.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    // ============================================================================
+    // Rendering
+    // ============================================================================
+
+    uint32_t TerrainFarField::Record(ID3D12GraphicsCommandList* cmdList, SM::FrameConstantAllocator& frameConstants,
+                                     uint32_t constantsRootParameter, uint32_t heightRootParameter,
+                                     float textureScale, float minHeight, float maxHeight, float sink)
+    {
+        if (!m_Initialized || !cmdList || !m_HasRing || !m_IndexBuffer)
+        {
+            return 0;
+        }
+
+        ID3D12Resource* heightResource = m_HeightBuffer->GetResource();
+
+        if (m_Dirty)
+        {
+            const size_t bytes = m_Heights.size() * sizeof(float);
+            SM::FrameAllocation staging = frameConstants.AllocateTransient(bytes, sizeof(float));
+            if (staging.IsValid())
+            {
+                std::memcpy(staging.CPUPointer, m_Heights.data(), bytes);
+
+                if (m_HeightState != D3D12_RESOURCE_STATE_COPY_DEST)
+                {
+                    D3D12_RESOURCE_BARRIER barrier = Transition(heightResource, m_HeightState, D3D12_RESOURCE_STATE_COPY_DEST);
+                    cmdList->ResourceBarrier(1, &barrier);
+                    m_HeightState = D3D12_RESOURCE_STATE_COPY_DEST;
+                }
+
+                cmdList->CopyBufferRegion(heightResource, 0, staging.Resource, staging.Offset, bytes);
+                m_Dirty = false;
+            }
+        }
+
+        if (m_HeightState != D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE)
+        {
+            D3D12_RESOURCE_BARRIER barrier = Transition(heightResource, m_HeightState, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+            cmdList->ResourceBarrier(1, &barrier);
+            m_HeightState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
+        }
+
+        // The buffer still holds the previous ring, which no longer matches the origin
+        if (m_Dirty)
+        {
+            return 0;
+        }
+
+        FarFieldData data = {};
+        data.GridOrigin = DirectX::XMFLOAT2(static_cast<float>(m_OriginX) * m_Spacing,
+                                            static_cast<float>(m_OriginZ) * m_Spacing);
+        data.GridStep = m_Spacing;
+        data.GridSize = m_GridSize;
+        data.Sink = sink;
+        data.TextureScale = textureScale;
+        data.MinHeight = minHeight;
+        data.MaxHeight = maxHeight;
+
+        D3D12_GPU_VIRTUAL_ADDRESS constantsCB = frameConstants.Push(data);
+        if (constantsCB == 0)
+        {
+            return 0;
+        }
+
+        cmdList->SetGraphicsRootConstantBufferView(constantsRootParameter, constantsCB);
+        cmdList->SetGraphicsRootShaderResourceView(heightRootParameter, m_HeightBuffer->GetGPUAddress());
+
+        D3D12_INDEX_BUFFER_VIEW ibv = m_IndexBuffer->GetView();
+        cmdList->IASetIndexBuffer(&ibv);
+        cmdList->DrawIndexedInstanced(m_Stats.Triangles * 3, 1, 0, 0, 0);
+
+        return 1;
+    }
+
+} // namespace PCG
@@ -0,0 +1,233 @@
+#pragma once
+
+/**
+ * @file TerrainFarField.h
+ * @brief Low-resolution horizon terrain beyond the chunk view distance
+ *
+ * The world is divided into square regions whose coarse heightmaps are
+ * sampled once, on job workers, from the same terrain settings as the
+ * chunks (ChunkManager::SampleTerrainGrid) and then kept in memory. A single
+ * camera-centred ring grid with the chunk radius cut out takes its vertex
+ * heights from those regions and is drawn in one call
+ * (shaders/TerrainFarField.hlsl). It is rebuilt and re-uploaded only when
+ * the camera crosses a grid cell, so a static camera costs one draw. The
+ * ring is lowered slightly so streamed chunks win where the two overlap,
+ * and it fades out with the regular terrain fog.
+ */
+
+#include "renderer/DX12Core.h"
+#include "renderer/GPUBuffer.h"
+#include "pcg/Chunk.h"
+
+#include <DirectXMath.h>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace SM
+{
+    struct JobCounter;
+}
+
+namespace PCG
+{
+    class ChunkManager;
+
+    /**
+     * @brief Far-field draw constants (FarField in TerrainFarField.hlsl, b3)
+     */
+    struct FarFieldData
+    {
+        DirectX::XMFLOAT2 GridOrigin;       ///< World XZ of grid vertex (0, 0)
+        float GridStep;                     ///< World distance between grid vertices
+        uint32_t GridSize;                  ///< Grid quads per side
+        float Sink;                         ///< Downward offset so nearer chunks win the overlap
+        float TextureScale;
+        float MinHeight;                    ///< Height range mapped to the color ramp
+        float MaxHeight;
+    };
+
+    static_assert(sizeof(FarFieldData) % 16 == 0, "FarFieldData must match FarField in TerrainFarField.hlsl");
+
+    /**
+     * @brief Far-field statistics
+     */
+    struct FarFieldStats
+    {
+        uint32_t Regions = 0;               ///< Region heightmaps in memory
+        uint32_t PendingRegions = 0;        ///< Regions being sampled on workers
+        uint32_t Triangles = 0;             ///< Triangles in the ring mesh
+        uint32_t Rebuilds = 0;              ///< Ring height rebuilds since Initialize
+        size_t RegionBytes = 0;             ///< CPU memory of the region heightmaps
+        size_t GPUBytes = 0;                ///< Height and index buffer memory
+    };
+
+    /**
+     * @brief Region heightmap cache and ring mesh for the terrain horizon
+     *
+     * Per frame: Update() requests missing regions and rebuilds the ring
+     * heights once every region under it is ready, then Record() uploads
+     * changed heights and draws the ring. Owned and driven by
+     * TerrainRenderer (see TerrainRenderConfig::EnableFarField).
+     */
+    class TerrainFarField
+    {
+    public:
+        static constexpr int REGION_SAMPLES = 64;  ///< Samples per region side
+
+        TerrainFarField() = default;
+        ~TerrainFarField();
+
+        // Prevent copying
+        TerrainFarField(const TerrainFarField&) = delete;
+        TerrainFarField& operator=(const TerrainFarField&) = delete;
+
+        /**
+         * @brief Create the height buffer
+         * @param core DX12 core reference
+         * @param distance Radius of the ring's outer edge (keep within the camera far plane)
+         * @param spacing World distance between ring vertices and region samples
+         * @return true if successful
+         */
+        bool Initialize(SM::DX12Core* core, float distance, float spacing);
+
+        /**
+         * @brief Wait for region jobs and release the buffers (deferred until the GPU is done)
+         */
+        void Shutdown();
+
+        /**
+         * @brief Check if the far field was created
+         */
+        bool IsInitialized() const { return m_Initialized; }
+
+        /**
+         * @brief Request regions around the camera and rebuild the ring when it moved a cell
+         * @param chunks Height source
+         * @param cameraPosition Camera position (only X and Z are used)
+         * @param innerRadius Distance up to which nearer terrain is always drawn (the ring's hole)
+         */
+        void Update(const ChunkManager& chunks, const DirectX::XMFLOAT3& cameraPosition, float innerRadius);
+
+        /**
+         * @brief Drop every region so heights are sampled again (e.g. after terrain settings change)
+         */
+        void Clear();
+
+        /**
+         * @brief Upload changed ring heights and draw the ring
+         * @param cmdList List with the far-field pipeline, root signature and per-frame constants bound
+         * @param frameConstants This frame's ring for uploads and draw constants
+         * @param constantsRootParameter Root CBV slot of FarField (b3)
+         * @param heightRootParameter Root SRV slot of the height buffer (t1)
+         * @param textureScale Texture UV tiling
+         * @param minHeight Height mapped to the bottom of the color ramp
+         * @param maxHeight Height mapped to the top of the color ramp
+         * @param sink Downward offset of the ring
+         * @return Number of draws recorded (0 until the first ring is built)
+         */
+        uint32_t Record(ID3D12GraphicsCommandList* cmdList, SM::FrameConstantAllocator& frameConstants,
+                        uint32_t constantsRootParameter, uint32_t heightRootParameter,
+                        float textureScale, float minHeight, float maxHeight, float sink);
+
+        /**
+         * @brief Get the ring's inner radius (where chunk terrain hands over)
+         */
+        float GetInnerRadius() const { return m_InnerRadius; }
+
+        float GetDistance() const { return m_Distance; }
+        float GetSpacing() const { return m_Spacing; }
+        const FarFieldStats& GetStats() const { return m_Stats; }
+
+        /**
+         * @brief Get the ring heights ((GridSize + 3)^2, one border vertex per side for normals)
+         */
+        const std::vector<float>& GetRingHeights() const { return m_Heights; }
+
+        /**
+         * @brief Get the grid index of ring vertex (0, 0) (-1 before the first build)
+         */
+        int GetRingOriginX() const { return m_OriginX; }
+        int GetRingOriginZ() const { return m_OriginZ; }
+        uint32_t GetGridSize() const { return m_GridSize; }
+
+        /**
+         * @brief Build the ring indices: a (gridSize + 1)^2 vertex grid without the quads
+         *        inside innerRadius or outside outerRadius (radii in grid steps from the centre)
+         */
+        static void GenerateRingIndices(std::vector<uint32_t>& indices, uint32_t gridSize,
+                                        float innerRadius, float outerRadius);
+
+    private:
+        /**
+         * @brief A region heightmap being sampled on a worker
+         */
+        struct RegionJob
+        {
+            ChunkCoord Region;
+            std::vector<float> Heights;
+            std::unique_ptr<SM::JobCounter> Counter;
+        };
+
+        /**
+         * @brief Rebuild the index buffer for a new inner radius
+         * @return false if the buffer could not be created (nothing is drawn)
+         */
+        bool BuildIndices(float innerRadius);
+
+        /**
+         * @brief Start sampling missing regions over a grid index range
+         * @return true if every region in the range is ready
+         */
+        bool RequestRegions(const ChunkManager& chunks, int minX, int minZ, int maxX, int maxZ);
+
+        /**
+         * @brief Move finished jobs into the region cache
+         */
+        void CollectJobs();
+
+        /**
+         * @brief Wait for every region job and discard the results
+         */
+        void CancelJobs();
+
+        /**
+         * @brief Fill the ring heights from the region cache
+         */
+        void BuildRing(int originX, int originZ);
+
+        /**
+         * @brief Drop regions far outside the ring
+         */
+        void EvictRegions(const DirectX::XMFLOAT3& cameraPosition);
+
+        static int FloorDiv(int value, int divisor);
+
+    private:
+        bool m_Initialized = false;
+        SM::DX12Core* m_Core = nullptr;
+
+        float m_Distance = 0.0f;
+        float m_Spacing = 1.0f;
+        float m_InnerRadius = -1.0f;
+        uint32_t m_GridSize = 0;            ///< Quads per ring side
+        uint32_t m_MaxJobsInFlight = 8;
+
+        std::unordered_map<ChunkCoord, std::vector<float>, ChunkHash> m_Regions;
+        std::vector<std::unique_ptr<RegionJob>> m_Jobs;
+
+        std::vector<float> m_Heights;       ///< Ring heights with a one-vertex border
+        int m_OriginX = -1;                 ///< Grid index of ring vertex (0, 0)
+        int m_OriginZ = -1;
+        bool m_HasRing = false;
+        bool m_Dirty = false;
+
+        std::unique_ptr<SM::GPUBuffer> m_HeightBuffer;
+        D3D12_RESOURCE_STATES m_HeightState = D3D12_RESOURCE_STATE_COMMON;
+        std::unique_ptr<SM::IndexBuffer> m_IndexBuffer;
+
+        FarFieldStats m_Stats;
+    };
+
+} // namespace PCG
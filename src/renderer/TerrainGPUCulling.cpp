@@ -0,0 +1,312 @@
+#include "renderer/TerrainGPUCulling.h"
+#include "renderer/Frustum.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace PCG
+{
+    namespace
+    {
+        /// Must match [numthreads] in TerrainCull.hlsl
+        constexpr uint32_t CULL_GROUP_SIZE = 64;
+
+        // Cull root parameter slots
+        constexpr uint32_t CULL_ROOT_CONSTANTS = 0;
+        constexpr uint32_t CULL_ROOT_RECORDS = 1;
+        constexpr uint32_t CULL_ROOT_COMMANDS = 2;
+        constexpr uint32_t CULL_ROOT_COUNT = 3;
+        constexpr uint32_t CULL_ROOT_HIZ = 4;
+
+        D3D12_RESOURCE_BARRIER Transition(ID3D12Resource* resource,
+                                          D3D12_RESOURCE_STATES before, D3D12_RESOURCE_STATES after)
+        {
+            D3D12_RESOURCE_BARRIER barrier = {};
+            barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+            barrier.Transition.pResource = resource;
+            barrier.Transition.StateBefore = before;
+            barrier.Transition.StateAfter = after;
+            barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+            return barrier;
+        }
+    }
+
+    TerrainGPUCulling::~TerrainGPUCulling()
+    {
+        Shutdown();
+    }
+
+    // ============================================================================
+    // Initialization
+    // ============================================================================
+
+    bool TerrainGPUCulling::Initialize(SM::DX12Core* core, ID3D12RootSignature* drawRootSignature,
+                                       uint32_t chunkIndexParameter)
+    {
+        if (m_Initialized)
+        {
+            return true;
+        }
+
+        if (!core || !drawRootSignature)
+        {
+            std::cerr << "[TerrainGPUCulling] Cannot initialize: DX12Core or root signature is null" << std::endl;
+            return false;
+        }
+
+        m_Core = core;
+
+        if (!CreatePipelines(drawRootSignature, chunkIndexParameter))
+        {
+            return false;
+        }
+
+        const uint32_t zero = 0;
+        m_CountBuffer = std::make_unique<SM::GPUBuffer>();
+        m_CountReset = std::make_unique<SM::GPUBuffer>();
+        if (!m_CountBuffer->Initialize(m_Core, sizeof(uint32_t), SM::GPUBufferUsage::UnorderedAccess) ||
+            !m_CountReset->Initialize(m_Core, sizeof(uint32_t), SM::GPUBufferUsage::Upload, &zero))
+        {
+            std::cerr << "[TerrainGPUCulling] Failed to create draw count buffers!" << std::endl;
+            return false;
+        }
+
+        m_CountState = D3D12_RESOURCE_STATE_COMMON;
+        m_Initialized = true;
+
+        std::cout << "[TerrainGPUCulling] Initialized" << std::endl;
+        return true;
+    }
+
+    void TerrainGPUCulling::Shutdown()
+    {
+        if (!m_Initialized)
+        {
+            return;
+        }
+
+        m_CommandSignature.Reset();
+        m_CommandBuffer.reset();
+        m_CountBuffer.reset();
+        m_CountReset.reset();
+        m_CommandCapacity = 0;
+        m_DrawCapacity = 0;
+
+        m_Initialized = false;
+        m_Core = nullptr;
+    }
+
+    // ============================================================================
+    // Per-Frame
+    // ============================================================================
+
+    bool TerrainGPUCulling::Cull(ID3D12GraphicsCommandList* cmdList, SM::FrameConstantAllocator& frameConstants,
+                                 D3D12_GPU_VIRTUAL_ADDRESS records, uint32_t recordCount,
+                                 const DirectX::XMMATRIX& viewProjection, const SM::HiZPyramid& hiZ)
+    {
+        m_DrawCapacity = 0;
+
+        if (!m_Initialized || !cmdList || records == 0 || recordCount == 0)
+        {
+            return false;
+        }
+
+        if (!EnsureCommandCapacity(recordCount))
+        {
+            return false;
+        }
+
+        TerrainCullConstants constants = {};
+        SM::Frustum frustum(viewProjection);
+        for (int i = 0; i < SM::Frustum::PlaneCount; ++i)
+        {
+            constants.FrustumPlanes[i] = frustum.GetPlane(i);
+        }
+
+        DirectX::XMStoreFloat4x4(&constants.PrevViewProjection, DirectX::XMMatrixTranspose(hiZ.GetViewProjection()));
+        constants.RecordCount = recordCount;
+        constants.HiZEnabled = (m_OcclusionEnabled && hiZ.IsValid()) ? 1u : 0u;
+        constants.DepthWidth = hiZ.GetDepthWidth();
+        constants.DepthHeight = hiZ.GetDepthHeight();
+        constants.HiZMipCount = hiZ.GetMipCount();
+
+        D3D12_GPU_VIRTUAL_ADDRESS constantsCB = frameConstants.Push(constants);
+        if (constantsCB == 0)
+        {
+            return false;
+        }
+
+        // Reset the draw count, then let the shader append survivors
+        TransitionBuffers(cmdList, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_DEST);
+        cmdList->CopyBufferRegion(m_CountBuffer->GetResource(), 0, m_CountReset->GetResource(), 0, sizeof(uint32_t));
+        TransitionBuffers(cmdList, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+
+        ID3D12DescriptorHeap* heaps[] = { m_Core->GetCBVSRVUAVHeap().GetHeap() };
+        cmdList->SetDescriptorHeaps(1, heaps);
+        cmdList->SetComputeRootSignature(m_CullRootSignature.GetNative());
+        cmdList->SetPipelineState(m_CullPSO.GetNative());
+        cmdList->SetComputeRootConstantBufferView(CULL_ROOT_CONSTANTS, constantsCB);
+        cmdList->SetComputeRootShaderResourceView(CULL_ROOT_RECORDS, records);
+        cmdList->SetComputeRootUnorderedAccessView(CULL_ROOT_COMMANDS, m_CommandBuffer->GetGPUAddress());
+        cmdList->SetComputeRootUnorderedAccessView(CULL_ROOT_COUNT, m_CountBuffer->GetGPUAddress());
+        cmdList->SetComputeRootDescriptorTable(CULL_ROOT_HIZ, hiZ.GetSRV().GPU);
+
+        cmdList->Dispatch((recordCount + CULL_GROUP_SIZE - 1) / CULL_GROUP_SIZE, 1, 1);
+
+        TransitionBuffers(cmdList, D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT, D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT);
+
+        m_DrawCapacity = recordCount;
+        return true;
+    }
+
+    void TerrainGPUCulling::Draw(ID3D12GraphicsCommandList* cmdList)
+    {
+        if (!m_Initialized || !cmdList || m_DrawCapacity == 0)
+        {
+            return;
+        }
+
+        // The GPU-written count caps the draw; unused commands are never read
+        cmdList->ExecuteIndirect(
+            m_CommandSignature.Get(),
+            m_DrawCapacity,
+            m_CommandBuffer->GetResource(),
+            0,
+            m_CountBuffer->GetResource(),
+            0
+        );
+    }
+
+    // ============================================================================
+    // Private Methods
+    // ============================================================================
+
+    bool TerrainGPUCulling::CreatePipelines(ID3D12RootSignature* drawRootSignature, uint32_t chunkIndexParameter)
+    {
+        if (!SM::CompileShaderFromFile(L"shaders/TerrainCull.hlsl", "CullCS", "cs_5_1", m_CullShader))
+        {
+            std::cerr << "[TerrainGPUCulling] Failed to compile culling shaders!" << std::endl;
+            return false;
+        }
+
+        // Cull root signature:
+        // 0: CBV - Culling constants (b0)
+        // 1: SRV - Chunk records (t0)
+        // 2: UAV - Compacted draw commands (u0)
+        // 3: UAV - Draw count (u1)
+        // 4: Table - Hi-Z SRV (t1)
+        SM::DescriptorRange hiZRange;
+        hiZRange.Type = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
+        hiZRange.NumDescriptors = 1;
+        hiZRange.BaseShaderRegister = 1;
+
+        bool built = m_CullRootSignature
+            .Begin(SM::RootSignatureFlags::None)
+            .AddCBV(0)
+            .AddSRV(0)
+            .AddUAV(0)
+            .AddUAV(1)
+            .AddDescriptorTable({ hiZRange })
+            .Build(m_Core);
+
+        if (!built)
+        {
+            std::cerr << "[TerrainGPUCulling] Failed to create cull root signature!" << std::endl;
+            return false;
+        }
+
+        built = m_CullPSO.Begin().SetRootSignature(m_CullRootSignature).SetComputeShader(m_CullShader).Build(m_Core);
+
+        if (!built)
+        {
+            std::cerr << "[TerrainGPUCulling] Failed to create pipeline states!" << std::endl;
+            return false;
+        }
+
+        // Command layout must match TerrainGPUDrawCommand
+        D3D12_INDIRECT_ARGUMENT_DESC arguments[4] = {};
+        arguments[0].Type = D3D12_INDIRECT_ARGUMENT_TYPE_VERTEX_BUFFER_VIEW;
+        arguments[0].VertexBuffer.Slot = 0;
+        arguments[1].Type = D3D12_INDIRECT_ARGUMENT_TYPE_INDEX_BUFFER_VIEW;
+        arguments[2].Type = D3D12_INDIRECT_ARGUMENT_TYPE_CONSTANT;
+        arguments[2].Constant.RootParameterIndex = chunkIndexParameter;
+        arguments[2].Constant.DestOffsetIn32BitValues = 0;
+        arguments[2].Constant.Num32BitValuesToSet = 1;
+        arguments[3].Type = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED;
+
+        D3D12_COMMAND_SIGNATURE_DESC signatureDesc = {};
+        signatureDesc.ByteStride = sizeof(TerrainGPUDrawCommand);
+        signatureDesc.NumArgumentDescs = 4;
+        signatureDesc.pArgumentDescs = arguments;
+
+        HRESULT hr = m_Core->GetDevice()->CreateCommandSignature(
+            &signatureDesc,
+            drawRootSignature,
+            IID_PPV_ARGS(&m_CommandSignature)
+        );
+
+        if (FAILED(hr))
+        {
+            std::cerr << "[TerrainGPUCulling] Failed to create command signature!" << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool TerrainGPUCulling::EnsureCommandCapacity(uint32_t capacity)
+    {
+        if (m_CommandBuffer && m_CommandCapacity >= capacity)
+        {
+            return true;
+        }
+
+        // Earlier frames may still be drawing from the old buffer (bound as a root UAV)
+        if (m_CommandBuffer)
+        {
+            m_Core->DeferRelease(m_CommandBuffer->GetResource());
+        }
+
+        uint32_t newCapacity = std::max(capacity, m_CommandCapacity * 2);
+
+        m_CommandBuffer = std::make_unique<SM::GPUBuffer>();
+        if (!m_CommandBuffer->Initialize(m_Core, sizeof(TerrainGPUDrawCommand) * newCapacity,
+                                         SM::GPUBufferUsage::UnorderedAccess))
+        {
+            std::cerr << "[TerrainGPUCulling] Failed to create draw command buffer!" << std::endl;
+            m_CommandBuffer.reset();
+            m_CommandCapacity = 0;
+            return false;
+        }
+
+        m_CommandCapacity = newCapacity;
+        m_CommandState = D3D12_RESOURCE_STATE_COMMON;
+        return true;
+    }
+
+    void TerrainGPUCulling::TransitionBuffers(ID3D12GraphicsCommandList* cmdList,
+                                              D3D12_RESOURCE_STATES argumentState,
+                                              D3D12_RESOURCE_STATES countState)
+    {
+        D3D12_RESOURCE_BARRIER barriers[2];
+        UINT count = 0;
+
+        if (m_CommandState != argumentState)
+        {
+            barriers[count++] = Transition(m_CommandBuffer->GetResource(), m_CommandState, argumentState);
+            m_CommandState = argumentState;
+        }
+
+        if (m_CountState != countState)
+        {
+            barriers[count++] = Transition(m_CountBuffer->GetResource(), m_CountState, countState);
+            m_CountState = countState;
+        }
+
+        if (count > 0)
+        {
+            cmdList->ResourceBarrier(count, barriers);
+        }
+    }
+
+} // namespace PCG
@@ -0,0 +1,187 @@
+#pragma once
+
+/**
+ * @file TerrainGPUCulling.h
+ * @brief GPU-driven terrain chunk culling with Hi-Z occlusion
+ *
+ * Chunk bounds and draw arguments are uploaded once per frame; a compute
+ * pass (shaders/TerrainCull.hlsl) tests them against the view frustum and
+ * the renderer's Hi-Z depth pyramid (SM::HiZPyramid) and compacts the
+ * survivors into an ExecuteIndirect argument buffer with a GPU-written draw count.
+ */
+
+#include "renderer/DX12Core.h"
+#include "renderer/RootSignature.h"
+#include "renderer/PipelineState.h"
+#include "renderer/GPUBuffer.h"
+#include "renderer/HiZPyramid.h"
+
+#include <DirectXMath.h>
+#include <memory>
+#include <vector>
+
+namespace PCG
+{
+    /**
+     * @brief One culled ExecuteIndirect command for a terrain chunk
+     *
+     * Layout must match the command signature built by TerrainGPUCulling and
+     * DrawCommand in TerrainCull.hlsl: vertex buffer view, index buffer view,
+     * chunk index root constant, indexed draw.
+     */
+    struct TerrainGPUDrawCommand
+    {
+        D3D12_VERTEX_BUFFER_VIEW VertexBuffer;
+        D3D12_INDEX_BUFFER_VIEW IndexBuffer;
+        uint32_t ChunkIndex;
+        D3D12_DRAW_INDEXED_ARGUMENTS Draw;
+    };
+
+    /**
+     * @brief Culling input for one chunk (ChunkRecord in TerrainCull.hlsl)
+     */
+    struct TerrainCullRecord
+    {
+        DirectX::XMFLOAT3 BoundsMin;
+        uint32_t Padding0;
+        DirectX::XMFLOAT3 BoundsMax;
+        uint32_t Padding1;
+        TerrainGPUDrawCommand Command;
+    };
+
+    /**
+     * @brief Culling constants (CullConstants in TerrainCull.hlsl, b0)
+     */
+    struct TerrainCullConstants
+    {
+        DirectX::XMFLOAT4 FrustumPlanes[6];
+        DirectX::XMFLOAT4X4 PrevViewProjection;    ///< Transposed for HLSL
+        uint32_t RecordCount;
+        uint32_t HiZEnabled;
+        uint32_t DepthWidth;
+        uint32_t DepthHeight;
+        uint32_t HiZMipCount;
+        uint32_t Padding[3];
+    };
+
+    static_assert(sizeof(TerrainGPUDrawCommand) == 56, "TerrainGPUDrawCommand must match DrawCommand in TerrainCull.hlsl");
+    static_assert(sizeof(TerrainCullRecord) == 88, "TerrainCullRecord must match ChunkRecord in TerrainCull.hlsl");
+
+    /**
+     * @brief Compute-shader chunk culling feeding ExecuteIndirect
+     *
+     * Per frame, between the terrain pass setup and its draws:
+     * 1. Cull() dispatches the culling shader over this frame's records
+     * 2. Draw() issues one ExecuteIndirect with the GPU-written count
+     *
+     * Occlusion uses whatever the pyramid last held, re-projected with the
+     * view-projection it was built with: this frame's depth pre-pass when
+     * one ran, otherwise last frame's depth, in which case newly exposed
+     * terrain can appear one frame late.
+     */
+    class TerrainGPUCulling
+    {
+    public:
+        TerrainGPUCulling() = default;
+        ~TerrainGPUCulling();
+
+        // Prevent copying
+        TerrainGPUCulling(const TerrainGPUCulling&) = delete;
+        TerrainGPUCulling& operator=(const TerrainGPUCulling&) = delete;
+
+        // ====================================================================
+        // Initialization
+        // ====================================================================
+
+        /**
+         * @brief Compile shaders and create pipeline objects
+         * @param core DX12 core for device access
+         * @param drawRootSignature Root signature the indirect draws use
+         * @param chunkIndexParameter Root parameter that receives the chunk index constant
+         * @return true if initialization succeeded
+         */
+        bool Initialize(SM::DX12Core* core, ID3D12RootSignature* drawRootSignature, uint32_t chunkIndexParameter);
+
+        /**
+         * @brief Release all resources
+         */
+        void Shutdown();
+
+        /**
+         * @brief Check if culling is initialized
+         */
+        bool IsInitialized() const { return m_Initialized; }
+
+        // ====================================================================
+        // Per-Frame
+        // ====================================================================
+
+        /**
+         * @brief Record the culling dispatch
+         * @param cmdList Recording command list
+         * @param frameConstants Per-frame ring for the culling constants
+         * @param records GPU address of recordCount TerrainCullRecords
+         * @param recordCount Number of records
+         * @param viewProjection Current view-projection matrix
+         * @param hiZ Occluder depth; unused while occlusion is disabled or the pyramid is not valid
+         * @return true if the dispatch was recorded and Draw may be called
+         *
+         * Changes the pipeline state; the caller must rebind its graphics state.
+         */
+        bool Cull(ID3D12GraphicsCommandList* cmdList, SM::FrameConstantAllocator& frameConstants,
+                  D3D12_GPU_VIRTUAL_ADDRESS records, uint32_t recordCount,
+                  const DirectX::XMMATRIX& viewProjection, const SM::HiZPyramid& hiZ);
+
+        /**
+         * @brief Draw the chunks that survived the last Cull
+         *
+         * Graphics pipeline, root signature and per-frame bindings must already be set.
+         */
+        void Draw(ID3D12GraphicsCommandList* cmdList);
+
+        /**
+         * @brief Enable/disable the Hi-Z occlusion test (frustum test always runs)
+         */
+        void SetOcclusionEnabled(bool enabled) { m_OcclusionEnabled = enabled; }
+
+        /**
+         * @brief Check if the Hi-Z occlusion test is enabled
+         */
+        bool IsOcclusionEnabled() const { return m_OcclusionEnabled; }
+
+    private:
+        /**
+         * @brief Compile shaders and build root signatures and pipelines
+         */
+        bool CreatePipelines(ID3D12RootSignature* drawRootSignature, uint32_t chunkIndexParameter);
+
+        /**
+         * @brief Grow the argument buffer to hold at least capacity commands
+         */
+        bool EnsureCommandCapacity(uint32_t capacity);
+
+        void TransitionBuffers(ID3D12GraphicsCommandList* cmdList, D3D12_RESOURCE_STATES argumentState,
+                               D3D12_RESOURCE_STATES countState);
+
+    private:
+        bool m_Initialized = false;
+        SM::DX12Core* m_Core = nullptr;
+        bool m_OcclusionEnabled = true;
+
+        // Pipelines
+        SM::ShaderBytecode m_CullShader;
+        SM::RootSignature m_CullRootSignature;
+        SM::ComputePipelineState m_CullPSO;
+        Microsoft::WRL::ComPtr<ID3D12CommandSignature> m_CommandSignature;
+
+        // Compacted draw arguments and GPU-written draw count
+        std::unique_ptr<SM::GPUBuffer> m_CommandBuffer;
+        std::unique_ptr<SM::GPUBuffer> m_CountBuffer;
+        std::unique_ptr<SM::GPUBuffer> m_CountReset;    ///< Upload buffer holding a zero count
+        uint32_t m_CommandCapacity = 0;
+        uint32_t m_DrawCapacity = 0;                     ///< Max count for the pending Draw
+        D3D12_RESOURCE_STATES m_CommandState = D3D12_RESOURCE_STATE_COMMON;
+        D3D12_RESOURCE_STATES m_CountState = D3D12_RESOURCE_STATE_COMMON;
+    };
+
+} // namespace PCG
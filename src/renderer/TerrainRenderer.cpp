@@ -1,12 +1,64 @@
 #include "renderer/TerrainRenderer.h"
+#include "renderer/TerrainGPUCulling.h"
+#include "renderer/TerrainClipmap.h"
+#include "renderer/TerrainFarField.h"
+#include "renderer/TerrainShadingRate.h"
+#include "renderer/MeshOptimizer.h"
 #include "renderer/Renderer.h"
+#include "renderer/Frustum.h"
 #include "pcg/Chunk.h"
 #include "pcg/ChunkManager.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
 #include <iostream>
 
 namespace PCG
 {
+    namespace
+    {
+        // Root parameter slots
+        constexpr uint32_t ROOT_PER_FRAME = 0;
+        constexpr uint32_t ROOT_PER_CHUNK = 1;
+        constexpr uint32_t ROOT_CHUNK_INDEX = 2;
+        constexpr uint32_t ROOT_CHUNK_INSTANCES = 3;
+        constexpr uint32_t ROOT_HEIGHTFIELD = 4;
+        constexpr uint32_t ROOT_GRID_CONSTANTS = 5;
+        constexpr uint32_t ROOT_SHADOW_CONSTANTS = 6;
+        constexpr uint32_t ROOT_SHADOW_MAPS = 7;
+
+        constexpr const char* TERRAIN_MESH_SHADER_PATH = "shaders/TerrainMesh.hlsl";
+
+        /// Patches per chunk side; must match PatchesPerSide in TerrainTessellation.hlsl
+        constexpr uint32_t TESSELLATION_PATCHES_PER_SIDE = 4;
+
+        /// PIX event per indirect LOD batch
+        constexpr std::array<const char*, Chunk::MAX_LOD + 1> LOD_EVENT_NAMES =
+        {
+            "LOD 0", "LOD 1", "LOD 2", "LOD 3", "LOD 4"
+        };
+
+        /**
+         * @brief Permutation defines for a configuration
+         *
+         * Same order as the permutations in CMakeLists.txt, so precompiled
+         * names match. Null-terminated; entry 1 is the geomorph toggle, which
+         * pixel shaders do not use.
+         */
+        std::array<D3D_SHADER_MACRO, 3> GetPermutationDefines(const TerrainRenderConfig& config)
+        {
+            return { {
+                { "TERRAIN_FOG", config.EnableFog ? "1" : "0" },
+                { "TERRAIN_GEOMORPH", config.EnableGeomorph ? "1" : "0" },
+                { nullptr, nullptr }
+            } };
+        }
+    }
+
     TerrainRenderer::TerrainRenderer()
     {
         // Initialize default light direction (normalized)
@@ -62,13 +114,93 @@ namespace PCG
             return false;
         }
 
-        // Create constant buffers
-        if (!CreateConstantBuffers())
+        // Create shared index buffers and indirect command signature
+        if (!CreateIndirectResources())
+        {
+            std::cerr << "[TerrainRenderer] Failed to create indirect draw resources!" << std::endl;
+            return false;
+        }
+
+        // GPU culling is optional; fall back to CPU-culled submission without it
+        m_GPUCulling = std::make_unique<TerrainGPUCulling>();
+        if (!m_GPUCulling->Initialize(m_Core, m_RootSignature.GetNative(), ROOT_CHUNK_INDEX))
+        {
+            std::cerr << "[TerrainRenderer] GPU culling unavailable, using CPU culling" << std::endl;
+            m_GPUCulling.reset();
+        }
+
+        // Mesh shaders are optional too; chunks keep the vertex shader paths without them
+        if (!CreateMeshletPipeline())
+        {
+            std::cout << "[TerrainRenderer] Mesh shader path unavailable, using vertex shaders" << std::endl;
+        }
+
+        if (!CreateTessellationPipeline())
         {
-            std::cerr << "[TerrainRenderer] Failed to create constant buffers!" << std::endl;
+            std::cerr << "[TerrainRenderer] Tessellation path unavailable" << std::endl;
+        }
+
+        if (!CreateClipmapPipeline())
+        {
+            std::cerr << "[TerrainRenderer] Clipmap path unavailable" << std::endl;
+        }
+        else if (m_Config.EnableClipmap)
+        {
+            CreateClipmap();
+        }
+
+        if (!CreateFarFieldPipeline())
+        {
+            std::cerr << "[TerrainRenderer] Far-field path unavailable" << std::endl;
+        }
+        else if (m_Config.EnableFarField)
+        {
+            CreateFarField();
+        }
+
+        // Every terrain pixel shader samples the shadow table; without shadows it holds null maps
+        m_NullShadowSRVs = m_Core->GetCBVSRVUAVHeap().AllocateRange(2);
+        if (!m_NullShadowSRVs.IsValid())
+        {
+            std::cerr << "[TerrainRenderer] Out of descriptors for the shadow map table!" << std::endl;
             return false;
         }
 
+        for (uint32_t i = 0; i < 2; ++i)
+        {
+            D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+            srvDesc.Format = DXGI_FORMAT_R32_FLOAT;
+            srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2DARRAY;
+            srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+            srvDesc.Texture2DArray.MipLevels = 1;
+            srvDesc.Texture2DArray.ArraySize = 1;
+            m_Core->GetDevice()->CreateShaderResourceView(nullptr, &srvDesc,
+                m_Core->GetCBVSRVUAVHeap().GetHandle(m_NullShadowSRVs.HeapIndex + i).CPU);
+        }
+        m_ShadowSRVTable = m_NullShadowSRVs.GPU;
+
+        if (!CreateShadowPipeline())
+        {
+            std::cerr << "[TerrainRenderer] Shadow path unavailable" << std::endl;
+        }
+        else if (m_Config.EnableShadows)
+        {
+            CreateShadowMaps();
+        }
+
+        if (!CreateDepthPrepassPipeline())
+        {
+            std::cerr << "[TerrainRenderer] Depth pre-pass unavailable" << std::endl;
+        }
+
+        // Variable rate shading needs tier 2 support; terrain shades at full rate without it
+        m_ShadingRate = std::make_unique<TerrainShadingRate>();
+        if (!m_ShadingRate->Initialize(m_Core))
+        {
+            std::cout << "[TerrainRenderer] Variable rate shading unavailable, shading at full rate" << std::endl;
+            m_ShadingRate.reset();
+        }
+
         m_Initialized = true;
         std::cout << "[TerrainRenderer] Terrain renderer initialized successfully!" << std::endl;
 
@@ -82,8 +214,25 @@ namespace PCG
             return;
         }
 
-        m_PerFrameCB.reset();
-        m_PerChunkCB.reset();
+        m_FrameCBAddress = 0;
+        m_FrameCBMapped = nullptr;
+        m_GPUCulling.reset();
+        m_Clipmap.reset();
+        m_FarField.reset();
+        m_ShadowMaps.reset();
+        m_ShadingRate.reset();
+        m_ShadingRateActive = false;
+        m_Core->GetCBVSRVUAVHeap().Free(m_NullShadowSRVs);
+        m_NullShadowSRVs = SM::DescriptorHandle();
+        m_ShadowCBAddress = 0;
+        m_ShadowSRVTable = {};
+        m_CommandSignature.Reset();
+        m_LODIndexBuffers.clear();
+        m_LODBatches.clear();
+        m_StitchedIndexBuffer.reset();
+        m_StitchedIndexCounts.clear();
+        m_StitchedIndexStarts.clear();
+        m_GeomorphBatch.clear();
 
         m_Initialized = false;
         m_Renderer = nullptr;
@@ -115,7 +264,35 @@ namespace PCG
 
     void TerrainRenderer::SetFogEnabled(bool enabled)
     {
+        if (m_Config.EnableFog == enabled)
+        {
+            return;
+        }
+
         m_Config.EnableFog = enabled;
+        if (m_Initialized)
+        {
+            RebuildShaderPermutation();
+        }
+    }
+
+    void TerrainRenderer::SetGeomorphEnabled(bool enabled)
+    {
+        if (m_Config.EnableGeomorph == enabled)
+        {
+            return;
+        }
+
+        m_Config.EnableGeomorph = enabled;
+        if (m_Initialized)
+        {
+            RebuildShaderPermutation();
+        }
+    }
+
+    bool TerrainRenderer::ReloadShaders()
+    {
+        return m_Initialized && RebuildShaderPermutation();
     }
 
     void TerrainRenderer::SetWireframe(bool enabled)
@@ -123,6 +300,85 @@ namespace PCG
         m_Config.EnableWireframe = enabled;
     }
 
+    void TerrainRenderer::SetIndirectDraw(bool enabled)
+    {
+        m_Config.EnableIndirectDraw = enabled;
+    }
+
+    void TerrainRenderer::SetMeshShaders(bool enabled)
+    {
+        m_Config.EnableMeshShaders = enabled;
+    }
+
+    void TerrainRenderer::SetTessellation(bool enabled, float edgePixels)
+    {
+        m_Config.EnableTessellation = enabled;
+        m_Config.TessellationEdgePixels = edgePixels;
+    }
+
+    void TerrainRenderer::SetClipmap(bool enabled, uint32_t levels, uint32_t gridSize)
+    {
+        const bool layoutChanged = levels != m_Config.ClipmapLevels || gridSize != m_Config.ClipmapGridSize;
+
+        m_Config.EnableClipmap = enabled;
+        m_Config.ClipmapLevels = levels;
+        m_Config.ClipmapGridSize = gridSize;
+
+        if (m_Initialized && enabled && IsClipmapAvailable() && (!m_Clipmap || layoutChanged))
+        {
+            CreateClipmap();
+        }
+    }
+
+    void TerrainRenderer::SetFarField(bool enabled, float distance, float spacing)
+    {
+        const bool layoutChanged = distance != m_Config.FarFieldDistance || spacing != m_Config.FarFieldSpacing;
+
+        m_Config.EnableFarField = enabled;
+        m_Config.FarFieldDistance = distance;
+        m_Config.FarFieldSpacing = spacing;
+
+        if (m_Initialized && enabled && IsFarFieldAvailable() && (!m_FarField || layoutChanged))
+        {
+            CreateFarField();
+        }
+    }
+
+    void TerrainRenderer::SetShadows(bool enabled, uint32_t cascades, uint32_t mapSize)
+    {
+        const bool layoutChanged = cascades != m_Config.ShadowCascades || mapSize != m_Config.ShadowMapSize;
+
+        m_Config.EnableShadows = enabled;
+        m_Config.ShadowCascades = cascades;
+        m_Config.ShadowMapSize = mapSize;
+
+        if (m_Initialized && enabled && IsShadowAvailable() && (!m_ShadowMaps || layoutChanged))
+        {
+            CreateShadowMaps();
+        }
+    }
+
+    void TerrainRenderer::SetLightDirection(const DirectX::XMFLOAT3& direction)
+    {
+        DirectX::XMStoreFloat3(&m_LightDirection, DirectX::XMVector3Normalize(DirectX::XMLoadFloat3(&direction)));
+    }
+
+    void TerrainRenderer::SetDynamicShadowCasters(TerrainShadowMaps::DrawDynamicFunc drawDynamic)
+    {
+        m_DynamicShadowCasters = std::move(drawDynamic);
+    }
+
+    void TerrainRenderer::SetDepthPrepassCasters(DepthPrepassFunc drawCasters)
+    {
+        m_DepthPrepassCasters = std::move(drawCasters);
+    }
+
+    void TerrainRenderer::SetGPUCulling(bool enabled, bool occlusion)
+    {
+        m_Config.EnableGPUCulling = enabled;
+        m_Config.EnableOcclusionCulling = occlusion;
+    }
+
     // ============================================================================
     // Rendering
     // ============================================================================
@@ -141,6 +397,11 @@ namespace PCG
             return;
         }
 
+        BindTerrainPass(cmdList);
+    }
+
+    void TerrainRenderer::BindTerrainPass(ID3D12GraphicsCommandList* cmdList) const
+    {
         // Set pipeline state
         if (m_Config.EnableWireframe)
         {
@@ -153,36 +414,157 @@ namespace PCG
 
         // Set root signature
         cmdList->SetGraphicsRootSignature(m_RootSignature.GetNative());
+        BindShadowSampling(cmdList);
 
         // Set primitive topology
         cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+        // Every list of the pass reads the same image; chunk draws may raise the base rate
+        if (m_ShadingRateActive)
+        {
+            Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList5> vrsList;
+            if (SUCCEEDED(cmdList->QueryInterface(IID_PPV_ARGS(&vrsList))))
+            {
+                vrsList->RSSetShadingRateImage(m_ShadingRate->GetImage());
+            }
+            SetBaseShadingRate(cmdList, D3D12_SHADING_RATE_1X1);
+        }
+    }
+
+    void TerrainRenderer::PrepareShadingRate(const DirectX::XMFLOAT3& cameraPosition)
+    {
+        m_ShadingRateActive = false;
+
+        if (!m_Config.EnableVariableRateShading || !m_ShadingRate || m_Config.EnableWireframe)
+        {
+            return;
+        }
+
+        ID3D12GraphicsCommandList* cmdList = m_Renderer->GetCommandList();
+        if (!cmdList)
+        {
+            return;
+        }
+
+        TerrainShadingRateParams params;
+        params.CameraPosition = cameraPosition;
+        params.FogStart = m_FrameData.FogStart;
+        params.FogEnd = m_FrameData.FogEnd;
+        params.FogThreshold = m_Config.VRSFogThreshold;
+        params.HeavyFogThreshold = m_Config.VRSHeavyFogThreshold;
+        params.FarDistance = m_Config.VRSFarDistance;
+
+        // The Hi-Z holds this frame's pre-pass depth, or last frame's depth without one
+        m_ShadingRateActive = m_ShadingRate->Build(cmdList, m_Renderer->GetFrameConstants(),
+                                                   m_Renderer->GetHiZ(), params);
+    }
+
+    void TerrainRenderer::SetBaseShadingRate(ID3D12GraphicsCommandList* cmdList, D3D12_SHADING_RATE rate) const
+    {
+        if (!m_ShadingRateActive)
+        {
+            return;
+        }
+
+        Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList5> vrsList;
+        if (FAILED(cmdList->QueryInterface(IID_PPV_ARGS(&vrsList))))
+        {
+            return;
+        }
+
+        // No per-primitive rates; the coarser of the base rate and the image wins
+        const D3D12_SHADING_RATE_COMBINER combiners[D3D12_RS_SET_SHADING_RATE_COMBINER_COUNT] = {
+            D3D12_SHADING_RATE_COMBINER_PASSTHROUGH,
+            D3D12_SHADING_RATE_COMBINER_MAX
+        };
+        vrsList->RSSetShadingRate(rate, combiners);
+    }
+
+    void TerrainRenderer::BindShadowSampling(ID3D12GraphicsCommandList* cmdList) const
+    {
+        if (m_ShadowCBAddress != 0)
+        {
+            cmdList->SetGraphicsRootConstantBufferView(ROOT_SHADOW_CONSTANTS, m_ShadowCBAddress);
+        }
+        cmdList->SetGraphicsRootDescriptorTable(ROOT_SHADOW_MAPS, m_ShadowSRVTable);
     }
 
     void TerrainRenderer::EndTerrainPass()
     {
-        // Currently nothing special to do
+        if (!m_ShadingRateActive)
+        {
+            return;
+        }
+
+        // Meshes and UI drawn after the terrain shade at full rate
+        ID3D12GraphicsCommandList* cmdList = m_Renderer->GetCommandList();
+        Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList5> vrsList;
+        if (cmdList && SUCCEEDED(cmdList->QueryInterface(IID_PPV_ARGS(&vrsList))))
+        {
+            vrsList->RSSetShadingRate(D3D12_SHADING_RATE_1X1, nullptr);
+            vrsList->RSSetShadingRateImage(nullptr);
+        }
+
+        m_ShadingRateActive = false;
     }
 
     void TerrainRenderer::UpdateFrameConstants(const DirectX::XMMATRIX& viewProjection,
                                                 const DirectX::XMFLOAT3& cameraPosition,
                                                 float time)
     {
-        // Store view-projection matrix (transposed for HLSL)
-        DirectX::XMStoreFloat4x4(&m_FrameData.ViewProjection, DirectX::XMMatrixTranspose(viewProjection));
+        SetCameraConstants(viewProjection, cameraPosition);
 
-        m_FrameData.CameraPosition = cameraPosition;
         m_FrameData.HeightScale = m_Config.HeightScale;
         m_FrameData.LightDirection = m_LightDirection;
         m_FrameData.Time = time;
         m_FrameData.FogColor = m_Config.FogColor;
         m_FrameData.FogStart = m_Config.EnableFog ? m_Config.FogStart : 999999.0f;
         m_FrameData.FogEnd = m_Config.EnableFog ? m_Config.FogEnd : 999999.0f;
+        m_FrameData.MeshletCullDistance = m_Config.MeshletCullDistance > 0.0f ? m_Config.MeshletCullDistance : 999999.0f;
+
+        // Allocate from the renderer's ring for this frame
+        SM::FrameAllocation allocation = m_Renderer->GetFrameConstants().AllocateTransient(sizeof(TerrainPerFrameData));
+        m_FrameCBAddress = allocation.GPUAddress;
+        m_FrameCBMapped = allocation.CPUPointer;
+        if (m_FrameCBMapped)
+        {
+            std::memcpy(m_FrameCBMapped, &m_FrameData, sizeof(TerrainPerFrameData));
+        }
+
+        // Unshadowed until RenderShadows records this frame's cascades
+        const ShadowCascadeData noShadows = {};
+        m_ShadowCBAddress = m_Renderer->GetFrameConstants().Push(noShadows);
+        m_ShadowSRVTable = m_NullShadowSRVs.GPU;
+    }
 
-        // Update constant buffer
-        if (m_PerFrameCB)
+    void TerrainRenderer::LateLatchFrameConstants(const DirectX::XMMATRIX& viewProjection,
+                                                  const DirectX::XMFLOAT3& cameraPosition)
+    {
+        if (!m_FrameCBMapped)
         {
-            m_PerFrameCB->Update(&m_FrameData, sizeof(TerrainPerFrameData));
+            return;
         }
+
+        SetCameraConstants(viewProjection, cameraPosition);
+        std::memcpy(m_FrameCBMapped, &m_FrameData, sizeof(TerrainPerFrameData));
+    }
+
+    void TerrainRenderer::SetCameraConstants(const DirectX::XMMATRIX& viewProjection,
+                                             const DirectX::XMFLOAT3& cameraPosition)
+    {
+        // Store view-projection matrix (transposed for HLSL)
+        DirectX::XMStoreFloat4x4(&m_FrameData.ViewProjection, DirectX::XMMatrixTranspose(viewProjection));
+        m_FrameData.CameraPosition = cameraPosition;
+
+        // Vertical projection scale, recovered from the view-projection's Y column
+        // (the view rotation is orthonormal, so the column's length is proj._22)
+        float projectionY = std::sqrt(
+            DirectX::XMVectorGetY(viewProjection.r[0]) * DirectX::XMVectorGetY(viewProjection.r[0]) +
+            DirectX::XMVectorGetY(viewProjection.r[1]) * DirectX::XMVectorGetY(viewProjection.r[1]) +
+            DirectX::XMVectorGetY(viewProjection.r[2]) * DirectX::XMVectorGetY(viewProjection.r[2]));
+        // Edge lengths are measured in rendered pixels, so a lower dynamic resolution tessellates less
+        m_FrameData.TessellationScale = 0.5f * static_cast<float>(m_Renderer->GetRenderHeight()) * projectionY /
+                                        std::max(m_Config.TessellationEdgePixels, 1.0f);
     }
 
     void TerrainRenderer::RenderChunk(const Chunk& chunk, const DirectX::XMMATRIX& viewProjection)
@@ -198,23 +580,40 @@ namespace PCG
             return;
         }
 
-        // Update per-chunk constants
-        TerrainPerChunkData chunkData;
+        // One draw per recorded chunk
+        uint32_t recorded = 0;
+        RecordChunk(cmdList, chunk, recorded, m_RenderedTriangleCount);
+        m_RenderedChunkCount += recorded;
+        m_DrawCallCount += recorded;
+    }
 
-        // Identity world matrix (chunks are already in world space)
-        DirectX::XMStoreFloat4x4(&chunkData.World, DirectX::XMMatrixIdentity());
+    void TerrainRenderer::RecordChunk(ID3D12GraphicsCommandList* cmdList, const Chunk& chunk,
+                                      uint32_t& chunkCount, uint32_t& triangleCount) const
+    {
+        // Coarse LODs are far or small on screen; the image can still coarsen further
+        SetBaseShadingRate(cmdList, chunk.GetLOD() >= m_Config.VRSCoarseLOD ? D3D12_SHADING_RATE_2X2
+                                                                             : D3D12_SHADING_RATE_1X1);
+        RecordChunk(cmdList, chunk, m_FrameCBAddress, chunkCount, triangleCount);
+    }
 
-        DirectX::XMFLOAT3 worldPos = chunk.GetWorldPosition();
-        chunkData.ChunkOffset = DirectX::XMFLOAT2(worldPos.x, worldPos.z);
-        chunkData.TextureScale = m_Config.TextureScale;
-        chunkData.MinHeight = chunk.GetMinHeight();
-        chunkData.MaxHeight = chunk.GetMaxHeight();
+    void TerrainRenderer::RecordChunk(ID3D12GraphicsCommandList* cmdList, const Chunk& chunk,
+                                      D3D12_GPU_VIRTUAL_ADDRESS frameCB,
+                                      uint32_t& chunkCount, uint32_t& triangleCount) const
+    {
+        // Update per-chunk constants
+        TerrainPerChunkData chunkData;
+        FillChunkData(chunk, chunkData);
 
-        m_PerChunkCB->Update(&chunkData, sizeof(TerrainPerChunkData));
+        // Every chunk gets its own slice so earlier draws keep their constants
+        D3D12_GPU_VIRTUAL_ADDRESS chunkCB = m_Renderer->GetFrameConstants().Push(chunkData);
+        if (chunkCB == 0 || frameCB == 0)
+        {
+            return;
+        }
 
         // Bind constant buffers
-        cmdList->SetGraphicsRootConstantBufferView(0, m_PerFrameCB->GetGPUAddress());
-        cmdList->SetGraphicsRootConstantBufferView(1, m_PerChunkCB->GetGPUAddress());
+        cmdList->SetGraphicsRootConstantBufferView(ROOT_PER_FRAME, frameCB);
+        cmdList->SetGraphicsRootConstantBufferView(ROOT_PER_CHUNK, chunkCB);
 
         // Get mesh and render
         const SM::Mesh& mesh = chunk.GetMesh();
@@ -224,118 +623,892 @@ namespace PCG
         cmdList->IASetVertexBuffers(0, 1, &vbv);
 
         // Set index buffer and draw
-        if (mesh.HasIndices())
+        const SM::IndexBuffer* sharedIndices = nullptr;
+        if (!mesh.HasIndices() && chunk.GetMeshLOD() < static_cast<int>(m_LODIndexBuffers.size()))
+        {
+            sharedIndices = m_LODIndexBuffers[chunk.GetMeshLOD()].get();
+        }
+
+        uint32_t stitchedStart = 0;
+        uint32_t stitchedCount = 0;
+
+        if (GetStitchedIndexRange(chunk, stitchedStart, stitchedCount))
+        {
+            // Full-resolution mesh drawn at the chunk's LOD, stitched to coarser neighbours
+            D3D12_INDEX_BUFFER_VIEW ibv = m_StitchedIndexBuffer->GetView();
+            cmdList->IASetIndexBuffer(&ibv);
+            cmdList->DrawIndexedInstanced(stitchedCount, 1, stitchedStart, 0, 0);
+
+            triangleCount += stitchedCount / 3;
+        }
+        else if (mesh.HasIndices())
         {
             D3D12_INDEX_BUFFER_VIEW ibv = mesh.GetIndexBufferView();
             cmdList->IASetIndexBuffer(&ibv);
             cmdList->DrawIndexedInstanced(mesh.GetIndexCount(), 1, 0, 0, 0);
 
             // Update statistics
-            m_RenderedTriangleCount += mesh.GetIndexCount() / 3;
+            triangleCount += mesh.GetIndexCount() / 3;
+        }
+        else if (sharedIndices)
+        {
+            // Chunk was built without indices; all chunks at this LOD share them
+            D3D12_INDEX_BUFFER_VIEW ibv = sharedIndices->GetView();
+            cmdList->IASetIndexBuffer(&ibv);
+            cmdList->DrawIndexedInstanced(sharedIndices->GetIndexCount(), 1, 0, 0, 0);
+
+            triangleCount += sharedIndices->GetIndexCount() / 3;
         }
         else
         {
             cmdList->DrawInstanced(mesh.GetVertexCount(), 1, 0, 0);
-            m_RenderedTriangleCount += mesh.GetVertexCount() / 3;
+            triangleCount += mesh.GetVertexCount() / 3;
         }
 
-        m_RenderedChunkCount++;
+        chunkCount++;
     }
 
-    void TerrainRenderer::RenderTerrain(ChunkManager& chunkManager,
-                                         const DirectX::XMMATRIX& viewProjection,
-                                         const DirectX::XMFLOAT3& cameraPosition)
+    void TerrainRenderer::RenderChunksIndirect(const std::vector<Chunk*>& chunks)
     {
-        if (!m_Initialized)
+        if (!m_Initialized || !m_CommandSignature || m_FrameCBAddress == 0)
         {
             return;
         }
 
-        // Reset statistics
-        ResetStats();
+        ID3D12GraphicsCommandList* cmdList = m_Renderer->GetCommandList();
+        if (!cmdList)
+        {
+            return;
+        }
 
-        // Update frame constants
-        UpdateFrameConstants(viewProjection, cameraPosition, 0.0f);
+        SM_GPU_EVENT(cmdList, "Terrain Indirect");
 
-        // Begin terrain pass
-        BeginTerrainPass();
+        // Bucket chunks by the LOD their vertex buffer was built at; geomorphed
+        // chunks pick their range of the stitched buffer per command instead
+        m_LODBatches.resize(m_LODIndexBuffers.size());
+        for (auto& batch : m_LODBatches)
+        {
+            batch.clear();
+        }
+        m_GeomorphBatch.clear();
 
-        // Render all visible chunks
-        const auto& visibleChunks = chunkManager.GetVisibleChunks();
-        for (Chunk* chunk : visibleChunks)
+        uint32_t chunkCount = 0;
+        for (const Chunk* chunk : chunks)
         {
-            if (chunk && chunk->HasMesh())
+            if (!chunk || !chunk->HasMesh())
             {
-                RenderChunk(*chunk, viewProjection);
+                continue;
             }
-        }
 
-        // End terrain pass
-        EndTerrainPass();
-    }
+            if (chunk->HasGeomorphMesh() && m_StitchedIndexBuffer)
+            {
+                m_GeomorphBatch.push_back(chunk);
+                chunkCount++;
+            }
+            else if (chunk->GetMeshLOD() < static_cast<int>(m_LODBatches.size()))
+            {
+                m_LODBatches[chunk->GetMeshLOD()].push_back(chunk);
+                chunkCount++;
+            }
+        }
 
-    void TerrainRenderer::ResetStats()
-    {
-        m_RenderedChunkCount = 0;
-        m_RenderedTriangleCount = 0;
-    }
+        if (chunkCount == 0)
+        {
+            return;
+        }
 
-    // ============================================================================
-    // Private Methods
-    // ============================================================================
+        // Per-chunk constants and draw arguments live in this frame's ring
+        SM::FrameConstantAllocator& frameConstants = m_Renderer->GetFrameConstants();
+        SM::FrameAllocation instances = frameConstants.AllocateTransient(chunkCount * sizeof(TerrainPerChunkData));
+        SM::FrameAllocation commands = frameConstants.AllocateTransient(chunkCount * sizeof(TerrainIndirectCommand));
+        if (!instances.IsValid() || !commands.IsValid())
+        {
+            return;
+        }
 
-    bool TerrainRenderer::CreateShaders()
-    {
-        std::cout << "[TerrainRenderer] Compiling terrain shaders..." << std::endl;
+        auto* instanceData = static_cast<TerrainPerChunkData*>(instances.CPUPointer);
+        auto* commandData = static_cast<TerrainIndirectCommand*>(commands.CPUPointer);
 
-        // Compile terrain vertex shader
-        if (!SM::CompileShaderFromFile(L"shaders/TerrainVertex.hlsl", "main", "vs_5_1", m_VertexShader))
+        // Switch to the vertex shader that reads ChunkInstances
+        if (m_Config.EnableWireframe)
         {
-            std::cerr << "[TerrainRenderer] Failed to compile terrain vertex shader!" << std::endl;
-            return false;
+            cmdList->SetPipelineState(m_IndirectWireframePSO.GetNative());
         }
-
-        // Compile terrain pixel shader
-        if (!SM::CompileShaderFromFile(L"shaders/TerrainPixel.hlsl", "main", "ps_5_1", m_PixelShader))
+        else
         {
-            std::cerr << "[TerrainRenderer] Failed to compile terrain pixel shader!" << std::endl;
-            return false;
+            cmdList->SetPipelineState(m_IndirectPSO.GetNative());
         }
 
-        std::cout << "[TerrainRenderer] Terrain shaders compiled successfully." << std::endl;
-        return true;
-    }
+        cmdList->SetGraphicsRootConstantBufferView(ROOT_PER_FRAME, m_FrameCBAddress);
+        cmdList->SetGraphicsRootShaderResourceView(ROOT_CHUNK_INSTANCES, instances.GPUAddress);
 
-    bool TerrainRenderer::CreateRootSignature()
+        uint32_t chunkIndex = 0;
+        for (size_t lod = 0; lod < m_LODBatches.size(); ++lod)
+        {
+            const auto& batch = m_LODBatches[lod];
+            if (batch.empty())
+            {
+                continue;
+            }
+
+            SM_GPU_EVENT(cmdList, LOD_EVENT_NAMES[lod]);
+
+            const SM::IndexBuffer& indices = *m_LODIndexBuffers[lod];
+            const uint32_t firstCommand = chunkIndex;
+
+            for (const Chunk* chunk : batch)
+            {
+                FillChunkData(*chunk, instanceData[chunkIndex]);
+
+                TerrainIndirectCommand& command = commandData[chunkIndex];
+                command.VertexBuffer = chunk->GetMesh().GetVertexBufferView();
+                command.ChunkIndex = chunkIndex;
+                command.Draw.IndexCountPerInstance = indices.GetIndexCount();
+                command.Draw.InstanceCount = 1;
+                command.Draw.StartIndexLocation = 0;
+                command.Draw.BaseVertexLocation = 0;
+                command.Draw.StartInstanceLocation = 0;
+
+                chunkIndex++;
+            }
+
+            // One call for every visible chunk at this LOD
+            D3D12_INDEX_BUFFER_VIEW ibv = indices.GetView();
+            cmdList->IASetIndexBuffer(&ibv);
+            cmdList->ExecuteIndirect(
+                m_CommandSignature.Get(),
+                static_cast<UINT>(batch.size()),
+                commands.Resource,
+                commands.Offset + firstCommand * sizeof(TerrainIndirectCommand),
+                nullptr,
+                0
+            );
+
+            m_RenderedChunkCount += static_cast<uint32_t>(batch.size());
+            m_RenderedTriangleCount += static_cast<uint32_t>(batch.size()) * (indices.GetIndexCount() / 3);
+            m_DrawCallCount++;
+        }
+
+        // One call for every geomorphed chunk, whatever its LOD and stitching
+        if (!m_GeomorphBatch.empty())
+        {
+            SM_GPU_EVENT(cmdList, "Geomorphed");
+
+            const uint32_t firstCommand = chunkIndex;
+
+            for (const Chunk* chunk : m_GeomorphBatch)
+            {
+                uint32_t startIndex = 0;
+                uint32_t indexCount = 0;
+                GetStitchedIndexRange(*chunk, startIndex, indexCount);
+
+                FillChunkData(*chunk, instanceData[chunkIndex]);
+
+                TerrainIndirectCommand& command = commandData[chunkIndex];
+                command.VertexBuffer = chunk->GetMesh().GetVertexBufferView();
+                command.ChunkIndex = chunkIndex;
+                command.Draw.IndexCountPerInstance = indexCount;
+                command.Draw.InstanceCount = 1;
+                command.Draw.StartIndexLocation = startIndex;
+                command.Draw.BaseVertexLocation = 0;
+                command.Draw.StartInstanceLocation = 0;
+
+                m_RenderedTriangleCount += indexCount / 3;
+                chunkIndex++;
+            }
+
+            D3D12_INDEX_BUFFER_VIEW ibv = m_StitchedIndexBuffer->GetView();
+            cmdList->IASetIndexBuffer(&ibv);
+            cmdList->ExecuteIndirect(
+                m_CommandSignature.Get(),
+                static_cast<UINT>(m_GeomorphBatch.size()),
+                commands.Resource,
+                commands.Offset + firstCommand * sizeof(TerrainIndirectCommand),
+                nullptr,
+                0
+            );
+
+            m_RenderedChunkCount += static_cast<uint32_t>(m_GeomorphBatch.size());
+            m_DrawCallCount++;
+        }
+
+        // Restore the per-chunk pipeline for later RenderChunk calls
+        BeginTerrainPass();
+    }
+
+    void TerrainRenderer::RenderChunksGPUCulled(const std::vector<Chunk*>& chunks,
+                                                const DirectX::XMMATRIX& viewProjection)
+    {
+        if (!m_Initialized || !m_GPUCulling || m_FrameCBAddress == 0)
+        {
+            return;
+        }
+
+        ID3D12GraphicsCommandList* cmdList = m_Renderer->GetCommandList();
+        if (!cmdList)
+        {
+            return;
+        }
+
+        SM_GPU_EVENT(cmdList, "Terrain GPU Culled");
+
+        uint32_t chunkCount = 0;
+        for (const Chunk* chunk : chunks)
+        {
+            if (chunk && chunk->HasMesh())
+            {
+                chunkCount++;
+            }
+        }
+
+        if (chunkCount == 0)
+        {
+            return;
+        }
+
+        // Per-chunk constants and culling records live in this frame's ring
+        SM::FrameConstantAllocator& frameConstants = m_Renderer->GetFrameConstants();
+        SM::FrameAllocation instances = frameConstants.AllocateTransient(chunkCount * sizeof(TerrainPerChunkData));
+        SM::FrameAllocation records = frameConstants.AllocateTransient(chunkCount * sizeof(TerrainCullRecord));
+        if (!instances.IsValid() || !records.IsValid())
+        {
+            return;
+        }
+
+        auto* instanceData = static_cast<TerrainPerChunkData*>(instances.CPUPointer);
+        auto* recordData = static_cast<TerrainCullRecord*>(records.CPUPointer);
+
+        uint32_t recordCount = 0;
+        for (const Chunk* chunk : chunks)
+        {
+            if (!chunk || !chunk->HasMesh())
+            {
+                continue;
+            }
+
+            const SM::Mesh& mesh = chunk->GetMesh();
+            TerrainCullRecord& record = recordData[recordCount];
+
+            // Each command binds its own index buffer, so all LODs share one call
+            uint32_t indexCount = 0;
+            uint32_t startIndex = 0;
+            if (GetStitchedIndexRange(*chunk, startIndex, indexCount))
+            {
+                record.Command.IndexBuffer = m_StitchedIndexBuffer->GetView();
+            }
+            else if (mesh.HasIndices())
+            {
+                record.Command.IndexBuffer = mesh.GetIndexBufferView();
+                indexCount = mesh.GetIndexCount();
+            }
+            else if (chunk->GetMeshLOD() < static_cast<int>(m_LODIndexBuffers.size()))
+            {
+                const SM::IndexBuffer& indices = *m_LODIndexBuffers[chunk->GetMeshLOD()];
+                record.Command.IndexBuffer = indices.GetView();
+                indexCount = indices.GetIndexCount();
+            }
+            else
+            {
+                continue;
+            }
+
+            SM::BoundingBox bounds = ChunkManager::GetChunkBounds(*chunk);
+            record.BoundsMin = bounds.Min;
+            record.Padding0 = 0;
+            record.BoundsMax = bounds.Max;
+            record.Padding1 = 0;
+
+            record.Command.VertexBuffer = mesh.GetVertexBufferView();
+            record.Command.ChunkIndex = recordCount;
+            record.Command.Draw.IndexCountPerInstance = indexCount;
+            record.Command.Draw.InstanceCount = 1;
+            record.Command.Draw.StartIndexLocation = startIndex;
+            record.Command.Draw.BaseVertexLocation = 0;
+            record.Command.Draw.StartInstanceLocation = 0;
+
+            FillChunkData(*chunk, instanceData[recordCount]);
+
+            m_RenderedTriangleCount += indexCount / 3;
+            recordCount++;
+        }
+
+        m_GPUCulling->SetOcclusionEnabled(m_Config.EnableOcclusionCulling);
+        if (!m_GPUCulling->Cull(cmdList, frameConstants, records.GPUAddress, recordCount, viewProjection,
+                                m_Renderer->GetHiZ()))
+        {
+            BeginTerrainPass();
+            return;
+        }
+
+        // The culling dispatch replaced the pipeline; bind the indirect draw state
+        cmdList->SetPipelineState(m_Config.EnableWireframe ? m_IndirectWireframePSO.GetNative() : m_IndirectPSO.GetNative());
+        cmdList->SetGraphicsRootSignature(m_RootSignature.GetNative());
+        BindShadowSampling(cmdList);
+        cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+        cmdList->SetGraphicsRootConstantBufferView(ROOT_PER_FRAME, m_FrameCBAddress);
+        cmdList->SetGraphicsRootShaderResourceView(ROOT_CHUNK_INSTANCES, instances.GPUAddress);
+
+        m_GPUCulling->Draw(cmdList);
+        m_RenderedChunkCount += recordCount;
+        m_DrawCallCount++;
+
+        // Restore the per-chunk pipeline for later RenderChunk calls
+        BeginTerrainPass();
+    }
+
+    void TerrainRenderer::RenderChunksMeshlets(const std::vector<Chunk*>& chunks)
+    {
+        if (!m_Initialized || !IsMeshShaderPathAvailable() || m_FrameCBAddress == 0)
+        {
+            return;
+        }
+
+        ID3D12GraphicsCommandList* cmdList = m_Renderer->GetCommandList();
+        if (!cmdList)
+        {
+            return;
+        }
+
+        SM_GPU_EVENT(cmdList, "Terrain Meshlets");
+
+        Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList6> meshList;
+        if (FAILED(cmdList->QueryInterface(IID_PPV_ARGS(&meshList))))
+        {
+            return;
+        }
+
+        cmdList->SetPipelineState(m_Config.EnableWireframe ? m_MeshletWireframePSO.GetNative() : m_MeshletPSO.GetNative());
+        cmdList->SetGraphicsRootSignature(m_RootSignature.GetNative());
+        BindShadowSampling(cmdList);
+        cmdList->SetGraphicsRootConstantBufferView(ROOT_PER_FRAME, m_FrameCBAddress);
+
+        SM::FrameConstantAllocator& frameConstants = m_Renderer->GetFrameConstants();
+        for (const Chunk* chunk : chunks)
+        {
+            if (!chunk || !chunk->HasMesh())
+            {
+                continue;
+            }
+
+            TerrainPerChunkData chunkData;
+            FillChunkData(*chunk, chunkData);
+
+            D3D12_GPU_VIRTUAL_ADDRESS chunkCB = frameConstants.Push(chunkData);
+            if (chunkCB == 0)
+            {
+                break;
+            }
+
+            // Vertex buffers live in COMMON (promoted) or GENERIC_READ, both readable as an SRV
+            cmdList->SetGraphicsRootConstantBufferView(ROOT_PER_CHUNK, chunkCB);
+            cmdList->SetGraphicsRootShaderResourceView(ROOT_HEIGHTFIELD, chunk->GetMesh().GetVertexBufferView().BufferLocation);
+
+            // One amplification group launches the chunk's visible meshlets
+            meshList->DispatchMesh(1, 1, 1);
+
+            const uint32_t quadsPerSide = Chunk::SIZE / chunkData.DrawStep;
+            m_RenderedChunkCount++;
+            m_DrawCallCount++;
+            m_RenderedTriangleCount += quadsPerSide * quadsPerSide * 2;
+        }
+
+        // Restore the per-chunk pipeline for later RenderChunk calls
+        BeginTerrainPass();
+    }
+
+    void TerrainRenderer::RenderChunksTessellated(const std::vector<Chunk*>& chunks)
+    {
+        if (!m_Initialized || !IsTessellationAvailable() || m_FrameCBAddress == 0)
+        {
+            return;
+        }
+
+        ID3D12GraphicsCommandList* cmdList = m_Renderer->GetCommandList();
+        if (!cmdList)
+        {
+            return;
+        }
+
+        SM_GPU_EVENT(cmdList, "Terrain Tessellated");
+
+        cmdList->SetPipelineState(m_Config.EnableWireframe ? m_TessellationWireframePSO.GetNative() : m_TessellationPSO.GetNative());
+        cmdList->SetGraphicsRootSignature(m_RootSignature.GetNative());
+        BindShadowSampling(cmdList);
+        cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_4_CONTROL_POINT_PATCHLIST);
+        cmdList->SetGraphicsRootConstantBufferView(ROOT_PER_FRAME, m_FrameCBAddress);
+
+        constexpr uint32_t patchCount = TESSELLATION_PATCHES_PER_SIDE * TESSELLATION_PATCHES_PER_SIDE;
+
+        SM::FrameConstantAllocator& frameConstants = m_Renderer->GetFrameConstants();
+        for (const Chunk* chunk : chunks)
+        {
+            if (!chunk || !chunk->HasMesh())
+            {
+                continue;
+            }
+
+            TerrainPerChunkData chunkData;
+            FillChunkData(*chunk, chunkData);
+
+            D3D12_GPU_VIRTUAL_ADDRESS chunkCB = frameConstants.Push(chunkData);
+            if (chunkCB == 0)
+            {
+                break;
+            }
+
+            cmdList->SetGraphicsRootConstantBufferView(ROOT_PER_CHUNK, chunkCB);
+            cmdList->SetGraphicsRootShaderResourceView(ROOT_HEIGHTFIELD, chunk->GetMesh().GetVertexBufferView().BufferLocation);
+
+            // Control points come from SV_VertexID
+            cmdList->DrawInstanced(patchCount * 4, 1, 0, 0);
+
+            m_RenderedChunkCount++;
+            m_DrawCallCount++;
+            m_RenderedTriangleCount += patchCount * 2;
+        }
+
+        // Restore the per-chunk pipeline for later RenderChunk calls
+        BeginTerrainPass();
+    }
+
+    void TerrainRenderer::RenderClipmap(const ChunkManager& chunkManager, const DirectX::XMFLOAT3& cameraPosition)
+    {
+        if (!m_Initialized || !m_Clipmap || !IsClipmapAvailable() || m_FrameCBAddress == 0)
+        {
+            return;
+        }
+
+        ID3D12GraphicsCommandList* cmdList = m_Renderer->GetCommandList();
+        if (!cmdList)
+        {
+            return;
+        }
+
+        SM_GPU_EVENT(cmdList, "Terrain Clipmap");
+
+        // Only the rows and columns that scrolled into a level are sampled
+        m_Clipmap->Update(chunkManager, cameraPosition);
+
+        cmdList->SetPipelineState(m_Config.EnableWireframe ? m_ClipmapWireframePSO.GetNative() : m_ClipmapPSO.GetNative());
+        cmdList->SetGraphicsRootSignature(m_RootSignature.GetNative());
+        BindShadowSampling(cmdList);
+        cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+        cmdList->SetGraphicsRootConstantBufferView(ROOT_PER_FRAME, m_FrameCBAddress);
+
+        const HeightmapSettings& terrain = chunkManager.GetConfig().TerrainSettings;
+        m_DrawCallCount += m_Clipmap->Record(cmdList, m_Renderer->GetFrameConstants(),
+            ROOT_GRID_CONSTANTS, ROOT_HEIGHTFIELD, m_Config.TextureScale, terrain.MinHeight, terrain.MaxHeight);
+        m_RenderedTriangleCount += m_Clipmap->GetStats().Triangles;
+
+        // Restore the per-chunk pipeline for later RenderChunk calls
+        BeginTerrainPass();
+    }
+
+    void TerrainRenderer::RenderFarField(const ChunkManager& chunkManager, const DirectX::XMFLOAT3& cameraPosition)
+    {
+        if (!m_Initialized || !m_FarField || !IsFarFieldAvailable() || m_FrameCBAddress == 0)
+        {
+            return;
+        }
+
+        ID3D12GraphicsCommandList* cmdList = m_Renderer->GetCommandList();
+        if (!cmdList)
+        {
+            return;
+        }
+
+        SM_GPU_EVENT(cmdList, "Terrain Far Field");
+
+        // The ring starts where nearer terrain is guaranteed: the clipmap's
+        // edge, or the farthest point every loaded chunk still covers
+        float innerRadius = 0.0f;
+        if (m_Config.EnableClipmap && m_Clipmap && IsClipmapAvailable())
+        {
+            innerRadius = m_Clipmap->GetCoverage();
+        }
+        else
+        {
+            const float halfDiagonal = Chunk::GetWorldSize() * 0.70710678f;
+            innerRadius = chunkManager.GetConfig().ViewDistance - halfDiagonal;
+        }
+
+        m_FarField->Update(chunkManager, cameraPosition, innerRadius);
+
+        cmdList->SetPipelineState(m_Config.EnableWireframe ? m_FarFieldWireframePSO.GetNative() : m_FarFieldPSO.GetNative());
+        cmdList->SetGraphicsRootSignature(m_RootSignature.GetNative());
+        BindShadowSampling(cmdList);
+        cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+        cmdList->SetGraphicsRootConstantBufferView(ROOT_PER_FRAME, m_FrameCBAddress);
+
+        const HeightmapSettings& terrain = chunkManager.GetConfig().TerrainSettings;
+        const uint32_t draws = m_FarField->Record(cmdList, m_Renderer->GetFrameConstants(),
+            ROOT_GRID_CONSTANTS, ROOT_HEIGHTFIELD, m_Config.TextureScale, terrain.MinHeight, terrain.MaxHeight,
+            m_Config.FarFieldSink);
+        m_DrawCallCount += draws;
+        m_RenderedTriangleCount += draws > 0 ? m_FarField->GetStats().Triangles : 0;
+
+        // Restore the per-chunk pipeline for later RenderChunk calls
+        BeginTerrainPass();
+    }
+
+    void TerrainRenderer::RenderShadows(const ChunkManager& chunkManager, const DirectX::XMMATRIX& viewProjection,
+                                        const DirectX::XMFLOAT3& cameraPosition)
+    {
+        if (!m_Initialized || !m_ShadowMaps || !IsShadowAvailable() || m_FrameCBAddress == 0)
+        {
+            return;
+        }
+
+        ID3D12GraphicsCommandList* cmdList = m_Renderer->GetCommandList();
+        if (!cmdList)
+        {
+            return;
+        }
+
+        SM_GPU_EVENT(cmdList, "Terrain Shadows");
+
+        m_ShadowMaps->Update(chunkManager, viewProjection, cameraPosition, m_LightDirection,
+                             m_Config.ShadowDistance, m_Config.ShadowLightThreshold);
+
+        m_DrawCallCount += m_ShadowMaps->Record(cmdList,
+            [this](ID3D12GraphicsCommandList* list, const DirectX::XMMATRIX& lightViewProjection,
+                   std::span<const Chunk* const> chunks) {
+                return RecordShadowChunks(list, lightViewProjection, chunks);
+            },
+            m_DynamicShadowCasters);
+
+        D3D12_GPU_VIRTUAL_ADDRESS shadowCB = m_Renderer->GetFrameConstants().Push(m_ShadowMaps->GetConstants());
+        if (shadowCB != 0)
+        {
+            m_ShadowCBAddress = shadowCB;
+            m_ShadowSRVTable = m_ShadowMaps->GetSRVTable();
+        }
+
+        // Back to the frame's render targets, viewport and pipeline
+        m_Renderer->RebindFrameState();
+    }
+
+    void TerrainRenderer::RenderDepthPrepass(const std::vector<Chunk*>& chunks, const DirectX::XMMATRIX& viewProjection)
+    {
+        if (!m_Initialized || !IsDepthPrepassAvailable() || m_FrameCBAddress == 0)
+        {
+            return;
+        }
+
+        ID3D12GraphicsCommandList* cmdList = m_Renderer->GetCommandList();
+        if (!cmdList)
+        {
+            return;
+        }
+
+        SM_GPU_EVENT(cmdList, "Terrain Depth Prepass");
+
+        // The GPU-culled path hands over every loaded chunk; keep the pre-pass to the frustum
+        SM::Frustum frustum(viewProjection);
+        m_PrepassBatch.clear();
+        for (const Chunk* chunk : chunks)
+        {
+            if (chunk && chunk->HasMesh() && frustum.Intersects(ChunkManager::GetChunkBounds(*chunk)))
+            {
+                m_PrepassBatch.push_back(chunk);
+            }
+        }
+
+        cmdList->SetPipelineState(m_DepthPrepassPSO.GetNative());
+        cmdList->SetGraphicsRootSignature(m_RootSignature.GetNative());
+        cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+        uint32_t draws = 0;
+        uint32_t triangles = 0;
+        for (const Chunk* chunk : m_PrepassBatch)
+        {
+            RecordChunk(cmdList, *chunk, m_FrameCBAddress, draws, triangles);
+        }
+
+        m_DrawCallCount += draws;
+        m_RenderedTriangleCount += triangles;
+
+        // Extra occluders draw through the renderer's own pipeline
+        m_Renderer->RebindFrameState();
+        if (m_DepthPrepassCasters)
+        {
+            m_DepthPrepassCasters();
+        }
+
+        // Current-frame occluders for the culling that follows; restores the frame state
+        m_Renderer->BuildHiZ(viewProjection);
+    }
+
+    bool TerrainRenderer::UsesDepthPrepass() const
+    {
+        // Mirrors the path selection in RenderTerrain: only chunk meshes are covered
+        if (!m_Config.EnableDepthPrepass || m_Config.EnableWireframe || !IsDepthPrepassAvailable())
+        {
+            return false;
+        }
+
+        if ((m_Config.EnableClipmap && m_Clipmap && IsClipmapAvailable()) ||
+            (m_Config.EnableTessellation && IsTessellationAvailable()) ||
+            (m_Config.EnableMeshShaders && IsMeshShaderPathAvailable()))
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    uint32_t TerrainRenderer::RecordShadowChunks(ID3D12GraphicsCommandList* cmdList,
+                                                 const DirectX::XMMATRIX& lightViewProjection,
+                                                 std::span<const Chunk* const> chunks)
+    {
+        // Chunks decode exactly as in the camera pass, seen from the light
+        TerrainPerFrameData frameData = m_FrameData;
+        DirectX::XMStoreFloat4x4(&frameData.ViewProjection, DirectX::XMMatrixTranspose(lightViewProjection));
+        D3D12_GPU_VIRTUAL_ADDRESS frameCB = m_Renderer->GetFrameConstants().Push(frameData);
+        if (frameCB == 0)
+        {
+            return 0;
+        }
+
+        cmdList->SetPipelineState(m_ShadowPSO.GetNative());
+        cmdList->SetGraphicsRootSignature(m_RootSignature.GetNative());
+        cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+        uint32_t draws = 0;
+        uint32_t triangles = 0;
+        for (const Chunk* chunk : chunks)
+        {
+            RecordChunk(cmdList, *chunk, frameCB, draws, triangles);
+        }
+
+        m_RenderedTriangleCount += triangles;
+        return draws;
+    }
+
+    void TerrainRenderer::RenderTerrain(ChunkManager& chunkManager,
+                                         const DirectX::XMMATRIX& viewProjection,
+                                         const DirectX::XMFLOAT3& cameraPosition)
+    {
+        if (!m_Initialized)
+        {
+            return;
+        }
+
+        // Reset statistics
+        ResetStats();
+
+        // Update frame constants
+        UpdateFrameConstants(viewProjection, cameraPosition, 0.0f);
+
+        // Shadow maps first; they replace the render targets until restored
+        if (m_Config.EnableShadows && m_ShadowMaps && IsShadowAvailable())
+        {
+            RenderShadows(chunkManager, viewProjection, cameraPosition);
+        }
+
+        const auto& visibleChunks = chunkManager.GetVisibleChunks();
+
+        // Depth first, so the color pass below shades each pixel once
+        if (UsesDepthPrepass())
+        {
+            RenderDepthPrepass(visibleChunks, viewProjection);
+        }
+
+        // Coarse shading for fogged and distant tiles, from the depth available now
+        PrepareShadingRate(cameraPosition);
+
+        // Begin terrain pass
+        BeginTerrainPass();
+
+        // Render all visible chunks
+        if (m_Config.EnableClipmap && m_Clipmap && IsClipmapAvailable())
+        {
+            RenderClipmap(chunkManager, cameraPosition);
+        }
+        else if (m_Config.EnableTessellation && IsTessellationAvailable())
+        {
+            RenderChunksTessellated(visibleChunks);
+        }
+        else if (m_Config.EnableMeshShaders && IsMeshShaderPathAvailable())
+        {
+            RenderChunksMeshlets(visibleChunks);
+        }
+        else if (m_Config.EnableGPUCulling && m_GPUCulling)
+        {
+            RenderChunksGPUCulled(visibleChunks, viewProjection);
+        }
+        else if (m_Config.EnableIndirectDraw)
+        {
+            RenderChunksIndirect(visibleChunks);
+        }
+        else if (m_Config.EnableParallelRecording)
+        {
+            m_ParallelBatch.clear();
+            for (Chunk* chunk : visibleChunks)
+            {
+                if (chunk && chunk->HasMesh())
+                {
+                    m_ParallelBatch.push_back(chunk);
+                }
+            }
+
+            // Each range counts locally and folds its totals in once
+            std::atomic<uint32_t> chunkTotal{ 0 };
+            std::atomic<uint32_t> triangleTotal{ 0 };
+            m_Renderer->RecordParallel(static_cast<uint32_t>(m_ParallelBatch.size()),
+                [this, &chunkTotal, &triangleTotal](SM::CommandList& list, uint32_t begin, uint32_t end) {
+                    ID3D12GraphicsCommandList* cmdList = list.GetNative();
+                    SM_GPU_EVENT(cmdList, "Terrain Parallel");
+                    BindTerrainPass(cmdList);
+
+                    uint32_t chunks = 0;
+                    uint32_t triangles = 0;
+                    for (uint32_t i = begin; i < end; ++i)
+                    {
+                        RecordChunk(cmdList, *m_ParallelBatch[i], chunks, triangles);
+                    }
+
+                    chunkTotal.fetch_add(chunks, std::memory_order_relaxed);
+                    triangleTotal.fetch_add(triangles, std::memory_order_relaxed);
+                },
+                m_Config.ParallelMinChunksPerList);
+
+            m_RenderedChunkCount += chunkTotal.load(std::memory_order_relaxed);
+            m_DrawCallCount += chunkTotal.load(std::memory_order_relaxed);
+            m_RenderedTriangleCount += triangleTotal.load(std::memory_order_relaxed);
+
+            // Later draws continue on a fresh list in the renderer's base state
+            BeginTerrainPass();
+        }
+        else
+        {
+            SM_GPU_EVENT(m_Renderer->GetCommandList(), "Terrain Chunks");
+            for (Chunk* chunk : visibleChunks)
+            {
+                if (chunk && chunk->HasMesh())
+                {
+                    RenderChunk(*chunk, viewProjection);
+                }
+            }
+        }
+
+        // The horizon ring goes last so nearer terrain fills the depth buffer first
+        if (m_Config.EnableFarField && m_FarField && IsFarFieldAvailable())
+        {
+            RenderFarField(chunkManager, cameraPosition);
+        }
+
+        // End terrain pass
+        EndTerrainPass();
+    }
+
+    void TerrainRenderer::ResetStats()
+    {
+        m_RenderedChunkCount = 0;
+        m_RenderedTriangleCount = 0;
+        m_DrawCallCount = 0;
+    }
+
+    // ============================================================================
+    // Private Methods
+    // ============================================================================
+
+    bool TerrainRenderer::CreateShaders()
+    {
+        std::cout << "[TerrainRenderer] Compiling terrain shaders..." << std::endl;
+
+        const std::array<D3D_SHADER_MACRO, 3> defines = GetPermutationDefines(m_Config);
+
+        // The pixel shader has no geomorph permutation
+        const D3D_SHADER_MACRO pixelDefines[] =
+        {
+            defines[0],
+            { nullptr, nullptr }
+        };
+
+        // Compile terrain vertex shader
+        if (!SM::CompileShaderFromFile(L"shaders/TerrainVertex.hlsl", "main", "vs_5_1", m_VertexShader, defines.data()))
+        {
+            std::cerr << "[TerrainRenderer] Failed to compile terrain vertex shader!" << std::endl;
+            return false;
+        }
+
+        // Compile indirect-draw variant (per-chunk data from a structured buffer)
+        if (!SM::CompileShaderFromFile(L"shaders/TerrainVertex.hlsl", "IndirectVS", "vs_5_1", m_IndirectVertexShader, defines.data()))
+        {
+            std::cerr << "[TerrainRenderer] Failed to compile terrain indirect vertex shader!" << std::endl;
+            return false;
+        }
+
+        // Compile terrain pixel shader
+        if (!SM::CompileShaderFromFile(L"shaders/TerrainPixel.hlsl", "main", "ps_5_1", m_PixelShader, pixelDefines))
+        {
+            std::cerr << "[TerrainRenderer] Failed to compile terrain pixel shader!" << std::endl;
+            return false;
+        }
+
+        std::cout << "[TerrainRenderer] Terrain shaders compiled successfully." << std::endl;
+        return true;
+    }
+
+    bool TerrainRenderer::RebuildShaderPermutation()
+    {
+        // Frames in flight may still reference the current PSOs
+        for (SM::GraphicsPipelineState* pso : { &m_TerrainPSO, &m_WireframePSO, &m_IndirectPSO, &m_IndirectWireframePSO,
+                                               &m_MeshletPSO, &m_MeshletWireframePSO,
+                                               &m_TessellationPSO, &m_TessellationWireframePSO,
+                                               &m_ClipmapPSO, &m_ClipmapWireframePSO,
+                                               &m_FarFieldPSO, &m_FarFieldWireframePSO, &m_ShadowPSO, &m_DepthPrepassPSO })
+        {
+            if (pso->GetNative())
+            {
+                m_Core->DeferRelease(pso->GetNative());
+            }
+        }
+
+        if (!CreateShaders() || !CreatePipelineState())
+        {
+            std::cerr << "[TerrainRenderer] Failed to rebuild terrain shader permutation!" << std::endl;
+            return false;
+        }
+
+        CreateMeshletPipeline();
+        CreateTessellationPipeline();
+        CreateClipmapPipeline();
+        CreateFarFieldPipeline();
+        CreateShadowPipeline();
+        CreateDepthPrepassPipeline();
+        return true;
+    }
+
+    bool TerrainRenderer::CreateRootSignature()
     {
         std::cout << "[TerrainRenderer] Creating terrain root signature..." << std::endl;
 
         // Terrain root signature:
         // 0: CBV - Per-frame constants (b0)
         // 1: CBV - Per-chunk constants (b1)
+        // 2: Constants - Chunk index for indirect draws (b2)
+        // 3: SRV - Per-chunk instance data for indirect draws (t0)
+        // 4: SRV - Chunk vertex data read as a heightfield by mesh shaders (t1),
+        //          or the clipmap height rings and far-field heights
+        // 5: CBV - Clipmap level or far-field constants (b3)
+        // 6: CBV - Shadow cascade constants (b4)
+        // 7: Table - Static and dynamic shadow map arrays (t2-t3), with a comparison sampler (s0)
+        bool success = m_RootSignature
+            .Begin()
+            .AddCBV(0)
+            .AddCBV(1)
+            .AddConstants(1, 2)
+            .AddSRV(0)
+            .AddSRV(1)
+            .AddCBV(3)
+            .AddCBV(4, 0, SM::ShaderVisibility::Pixel)
+            .AddSRVTable(2, 2)
+            .AddShadowSampler(0)
+            .Build(m_Core);
 
-        D3D12_ROOT_PARAMETER rootParams[2] = {};
-
-        // Per-frame CBV at register b0
-        rootParams[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
-        rootParams[0].Descriptor.ShaderRegister = 0;
-        rootParams[0].Descriptor.RegisterSpace = 0;
-        rootParams[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
-
-        // Per-chunk CBV at register b1
-        rootParams[1].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
-        rootParams[1].Descriptor.ShaderRegister = 1;
-        rootParams[1].Descriptor.RegisterSpace = 0;
-        rootParams[1].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
-
-        D3D12_ROOT_SIGNATURE_DESC rsDesc = {};
-        rsDesc.NumParameters = 2;
-        rsDesc.pParameters = rootParams;
-        rsDesc.NumStaticSamplers = 0;
-        rsDesc.pStaticSamplers = nullptr;
-        rsDesc.Flags = D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT;
-
-        if (!m_RootSignature.Create(m_Core, rsDesc))
+        if (!success)
         {
             std::cerr << "[TerrainRenderer] Failed to create root signature!" << std::endl;
             return false;
@@ -349,16 +1522,22 @@ namespace PCG
     {
         std::cout << "[TerrainRenderer] Creating terrain pipeline states..." << std::endl;
 
+        // All terrain PSOs read the compressed TerrainVertex: quantized height,
+        // geomorph target height and octahedral normal, with X/Z rebuilt from SV_VertexID.
+        // The solid chunk PSOs test LESS_EQUAL so they shade over the depth pre-pass
+
         // Create solid fill PSO
         m_TerrainPSO
             .Begin()
-            .SetRootSignature(m_RootSignature.GetNative())
+            .SetRootSignature(m_RootSignature)
             .SetVertexShader(m_VertexShader)
             .SetPixelShader(m_PixelShader)
-            .SetStandardInputLayout()
+            .AddInputElement("HEIGHT", 0, DXGI_FORMAT_R16_UNORM, 0, offsetof(TerrainVertex, Height))
+            .AddInputElement("HEIGHT", 1, DXGI_FORMAT_R16_UNORM, 0, offsetof(TerrainVertex, MorphHeight))
+            .AddInputElement(SM::SemanticName::Normal, 0, DXGI_FORMAT_R16G16_SNORM, 0, offsetof(TerrainVertex, Normal))
             .SetRasterizer(SM::FillMode::Solid, SM::CullMode::Back)
             .SetBlendMode(SM::BlendMode::Opaque)
-            .SetDepthStencil(true, true, SM::DepthFunc::Less)
+            .SetDepthStencil(true, true, SM::DepthFunc::LessEqual)
             .SetRenderTargetFormat(m_Core->GetBackBufferFormat())
             .SetDepthStencilFormat(m_Core->GetDepthFormat())
             .Build(m_Core);
@@ -372,10 +1551,12 @@ namespace PCG
         // Create wireframe PSO
         m_WireframePSO
             .Begin()
-            .SetRootSignature(m_RootSignature.GetNative())
+            .SetRootSignature(m_RootSignature)
             .SetVertexShader(m_VertexShader)
             .SetPixelShader(m_PixelShader)
-            .SetStandardInputLayout()
+            .AddInputElement("HEIGHT", 0, DXGI_FORMAT_R16_UNORM, 0, offsetof(TerrainVertex, Height))
+            .AddInputElement("HEIGHT", 1, DXGI_FORMAT_R16_UNORM, 0, offsetof(TerrainVertex, MorphHeight))
+            .AddInputElement(SM::SemanticName::Normal, 0, DXGI_FORMAT_R16G16_SNORM, 0, offsetof(TerrainVertex, Normal))
             .SetRasterizer(SM::FillMode::Wireframe, SM::CullMode::None)
             .SetBlendMode(SM::BlendMode::Opaque)
             .SetDepthStencil(true, true, SM::DepthFunc::Less)
@@ -389,31 +1570,508 @@ namespace PCG
             return false;
         }
 
+        // Indirect variants differ only in the vertex shader
+        m_IndirectPSO
+            .Begin()
+            .SetRootSignature(m_RootSignature)
+            .SetVertexShader(m_IndirectVertexShader)
+            .SetPixelShader(m_PixelShader)
+            .AddInputElement("HEIGHT", 0, DXGI_FORMAT_R16_UNORM, 0, offsetof(TerrainVertex, Height))
+            .AddInputElement("HEIGHT", 1, DXGI_FORMAT_R16_UNORM, 0, offsetof(TerrainVertex, MorphHeight))
+            .AddInputElement(SM::SemanticName::Normal, 0, DXGI_FORMAT_R16G16_SNORM, 0, offsetof(TerrainVertex, Normal))
+            .SetRasterizer(SM::FillMode::Solid, SM::CullMode::Back)
+            .SetBlendMode(SM::BlendMode::Opaque)
+            .SetDepthStencil(true, true, SM::DepthFunc::LessEqual)
+            .SetRenderTargetFormat(m_Core->GetBackBufferFormat())
+            .SetDepthStencilFormat(m_Core->GetDepthFormat())
+            .Build(m_Core);
+
+        m_IndirectWireframePSO
+            .Begin()
+            .SetRootSignature(m_RootSignature)
+            .SetVertexShader(m_IndirectVertexShader)
+            .SetPixelShader(m_PixelShader)
+            .AddInputElement("HEIGHT", 0, DXGI_FORMAT_R16_UNORM, 0, offsetof(TerrainVertex, Height))
+            .AddInputElement("HEIGHT", 1, DXGI_FORMAT_R16_UNORM, 0, offsetof(TerrainVertex, MorphHeight))
+            .AddInputElement(SM::SemanticName::Normal, 0, DXGI_FORMAT_R16G16_SNORM, 0, offsetof(TerrainVertex, Normal))
+            .SetRasterizer(SM::FillMode::Wireframe, SM::CullMode::None)
+            .SetBlendMode(SM::BlendMode::Opaque)
+            .SetDepthStencil(true, true, SM::DepthFunc::Less)
+            .SetRenderTargetFormat(m_Core->GetBackBufferFormat())
+            .SetDepthStencilFormat(m_Core->GetDepthFormat())
+            .Build(m_Core);
+
+        if (!m_IndirectPSO.GetNative() || !m_IndirectWireframePSO.GetNative())
+        {
+            std::cerr << "[TerrainRenderer] Failed to create indirect PSOs!" << std::endl;
+            return false;
+        }
+
         std::cout << "[TerrainRenderer] Terrain pipeline states created." << std::endl;
         return true;
     }
 
-    bool TerrainRenderer::CreateConstantBuffers()
+    bool TerrainRenderer::CreateTessellationPipeline()
+    {
+        m_TessellationPSO.Begin();
+        m_TessellationWireframePSO.Begin();
+
+        // The domain shader computes the fog factor; the hull shader has no permutations
+        const std::array<D3D_SHADER_MACRO, 3> defines = GetPermutationDefines(m_Config);
+        const D3D_SHADER_MACRO domainDefines[] = { defines[0], { nullptr, nullptr } };
+
+        if (!SM::CompileShaderFromFile(L"shaders/TerrainTessellation.hlsl", "PatchVS", "vs_5_1", m_PatchVertexShader) ||
+            !SM::CompileShaderFromFile(L"shaders/TerrainTessellation.hlsl", "PatchHS", "hs_5_1", m_PatchHullShader) ||
+            !SM::CompileShaderFromFile(L"shaders/TerrainTessellation.hlsl", "PatchDS", "ds_5_1", m_PatchDomainShader, domainDefines))
+        {
+            return false;
+        }
+
+        SM::GraphicsPipelineState* psos[] = { &m_TessellationPSO, &m_TessellationWireframePSO };
+        for (SM::GraphicsPipelineState* pso : psos)
+        {
+            // Patches are viewed from above and the tessellator fixes the
+            // winding, so the solid PSO does not cull by facing
+            const bool wireframe = pso == &m_TessellationWireframePSO;
+            pso->Begin()
+                .SetRootSignature(m_RootSignature)
+                .SetVertexShader(m_PatchVertexShader)
+                .SetHullShader(m_PatchHullShader)
+                .SetDomainShader(m_PatchDomainShader)
+                .SetPixelShader(m_PixelShader)
+                .SetRasterizer(wireframe ? SM::FillMode::Wireframe : SM::FillMode::Solid, SM::CullMode::None)
+                .SetBlendMode(SM::BlendMode::Opaque)
+                .SetDepthStencil(true, true, SM::DepthFunc::Less)
+                .SetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY_TYPE_PATCH)
+                .SetRenderTargetFormat(m_Core->GetBackBufferFormat())
+                .SetDepthStencilFormat(m_Core->GetDepthFormat())
+                .Build(m_Core);
+        }
+
+        if (!m_TessellationPSO.IsValid() || !m_TessellationWireframePSO.IsValid())
+        {
+            std::cerr << "[TerrainRenderer] Failed to create tessellation PSOs!" << std::endl;
+            m_TessellationPSO.Begin();
+            m_TessellationWireframePSO.Begin();
+            return false;
+        }
+
+        return true;
+    }
+
+    bool TerrainRenderer::CreateClipmapPipeline()
+    {
+        m_ClipmapPSO.Begin();
+        m_ClipmapWireframePSO.Begin();
+
+        const std::array<D3D_SHADER_MACRO, 3> defines = GetPermutationDefines(m_Config);
+        const D3D_SHADER_MACRO vertexDefines[] = { defines[0], { nullptr, nullptr } };
+
+        if (!SM::CompileShaderFromFile(L"shaders/TerrainClipmap.hlsl", "ClipmapVS", "vs_5_1", m_ClipmapVertexShader, vertexDefines))
+        {
+            return false;
+        }
+
+        // No input layout: grid positions come from SV_VertexID, heights from the rings
+        SM::GraphicsPipelineState* psos[] = { &m_ClipmapPSO, &m_ClipmapWireframePSO };
+        for (SM::GraphicsPipelineState* pso : psos)
+        {
+            const bool wireframe = pso == &m_ClipmapWireframePSO;
+            pso->Begin()
+                .SetRootSignature(m_RootSignature)
+                .SetVertexShader(m_ClipmapVertexShader)
+                .SetPixelShader(m_PixelShader)
+                .SetRasterizer(wireframe ? SM::FillMode::Wireframe : SM::FillMode::Solid,
+                               wireframe ? SM::CullMode::None : SM::CullMode::Back)
+                .SetBlendMode(SM::BlendMode::Opaque)
+                .SetDepthStencil(true, true, SM::DepthFunc::Less)
+                .SetRenderTargetFormat(m_Core->GetBackBufferFormat())
+                .SetDepthStencilFormat(m_Core->GetDepthFormat())
+                .Build(m_Core);
+        }
+
+        if (!m_ClipmapPSO.IsValid() || !m_ClipmapWireframePSO.IsValid())
+        {
+            std::cerr << "[TerrainRenderer] Failed to create clipmap PSOs!" << std::endl;
+            m_ClipmapPSO.Begin();
+            m_ClipmapWireframePSO.Begin();
+            return false;
+        }
+
+        return true;
+    }
+
+    bool TerrainRenderer::CreateClipmap()
+    {
+        if (!m_Clipmap)
+        {
+            m_Clipmap = std::make_unique<TerrainClipmap>();
+        }
+
+        if (!m_Clipmap->Initialize(m_Core, m_Config.ClipmapLevels, m_Config.ClipmapGridSize, Chunk::SCALE))
+        {
+            std::cerr << "[TerrainRenderer] Failed to create clipmap!" << std::endl;
+            m_Clipmap.reset();
+            return false;
+        }
+
+        std::cout << "[TerrainRenderer] Clipmap created: " << m_Clipmap->GetLevelCount() << " levels of "
+                  << m_Clipmap->GetGridSize() << " quads, " << m_Clipmap->GetCoverage() << " units" << std::endl;
+        return true;
+    }
+
+    bool TerrainRenderer::CreateFarFieldPipeline()
+    {
+        m_FarFieldPSO.Begin();
+        m_FarFieldWireframePSO.Begin();
+
+        const std::array<D3D_SHADER_MACRO, 3> defines = GetPermutationDefines(m_Config);
+        const D3D_SHADER_MACRO vertexDefines[] = { defines[0], { nullptr, nullptr } };
+
+        if (!SM::CompileShaderFromFile(L"shaders/TerrainFarField.hlsl", "FarFieldVS", "vs_5_1", m_FarFieldVertexShader, vertexDefines))
+        {
+            return false;
+        }
+
+        // No input layout: grid positions come from SV_VertexID, heights from the ring
+        SM::GraphicsPipelineState* psos[] = { &m_FarFieldPSO, &m_FarFieldWireframePSO };
+        for (SM::GraphicsPipelineState* pso : psos)
+        {
+            const bool wireframe = pso == &m_FarFieldWireframePSO;
+            pso->Begin()
+                .SetRootSignature(m_RootSignature)
+                .SetVertexShader(m_FarFieldVertexShader)
+                .SetPixelShader(m_PixelShader)
+                .SetRasterizer(wireframe ? SM::FillMode::Wireframe : SM::FillMode::Solid,
+                               wireframe ? SM::CullMode::None : SM::CullMode::Back)
+                .SetBlendMode(SM::BlendMode::Opaque)
+                .SetDepthStencil(true, true, SM::DepthFunc::Less)
+                .SetRenderTargetFormat(m_Core->GetBackBufferFormat())
+                .SetDepthStencilFormat(m_Core->GetDepthFormat())
+                .Build(m_Core);
+        }
+
+        if (!m_FarFieldPSO.IsValid() || !m_FarFieldWireframePSO.IsValid())
+        {
+            std::cerr << "[TerrainRenderer] Failed to create far-field PSOs!" << std::endl;
+            m_FarFieldPSO.Begin();
+            m_FarFieldWireframePSO.Begin();
+            return false;
+        }
+
+        return true;
+    }
+
+    bool TerrainRenderer::CreateFarField()
+    {
+        if (!m_FarField)
+        {
+            m_FarField = std::make_unique<TerrainFarField>();
+        }
+
+        if (!m_FarField->Initialize(m_Core, m_Config.FarFieldDistance, m_Config.FarFieldSpacing))
+        {
+            std::cerr << "[TerrainRenderer] Failed to create far field!" << std::endl;
+            m_FarField.reset();
+            return false;
+        }
+
+        std::cout << "[TerrainRenderer] Far field created: " << m_FarField->GetGridSize() << " quads per side, "
+                  << m_FarField->GetDistance() << " units" << std::endl;
+        return true;
+    }
+
+    bool TerrainRenderer::CreateShadowPipeline()
+    {
+        m_ShadowPSO.Begin();
+
+        // Only the vertex decoding matters for depth, so only the geomorph define
+        const std::array<D3D_SHADER_MACRO, 3> defines = GetPermutationDefines(m_Config);
+        const D3D_SHADER_MACRO vertexDefines[] = { defines[1], { nullptr, nullptr } };
+
+        if (!SM::CompileShaderFromFile(L"shaders/TerrainVertex.hlsl", "DepthOnlyVS", "vs_5_1", m_DepthOnlyVertexShader, vertexDefines))
+        {
+            return false;
+        }
+
+        // No pixel shader or render target. Depth clip is off so casters in
+        // front of a cascade's box clamp onto its near plane instead of vanishing
+        m_ShadowPSO
+            .Begin()
+            .SetRootSignature(m_RootSignature)
+            .SetVertexShader(m_DepthOnlyVertexShader)
+            .AddInputElement("HEIGHT", 0, DXGI_FORMAT_R16_UNORM, 0, offsetof(TerrainVertex, Height))
+            .AddInputElement("HEIGHT", 1, DXGI_FORMAT_R16_UNORM, 0, offsetof(TerrainVertex, MorphHeight))
+            .AddInputElement(SM::SemanticName::Normal, 0, DXGI_FORMAT_R16G16_SNORM, 0, offsetof(TerrainVertex, Normal))
+            .SetRasterizer(SM::FillMode::Solid, SM::CullMode::Back)
+            .SetDepthClip(false)
+            .SetDepthBias(64, 0.0f, 2.0f)
+            .SetBlendMode(SM::BlendMode::Opaque)
+            .SetDepthStencil(true, true, SM::DepthFunc::Less)
+            .SetDepthStencilFormat(TerrainShadowMaps::DEPTH_FORMAT)
+            .Build(m_Core);
+
+        if (!m_ShadowPSO.IsValid())
+        {
+            std::cerr << "[TerrainRenderer] Failed to create shadow PSO!" << std::endl;
+            m_ShadowPSO.Begin();
+            return false;
+        }
+
+        return true;
+    }
+
+    bool TerrainRenderer::CreateDepthPrepassPipeline()
+    {
+        m_DepthPrepassPSO.Begin();
+
+        // Shares the shadow pass's vertex shader; no bias and normal clipping
+        // so the solid PSOs' LESS_EQUAL test matches the depth exactly
+        if (!m_DepthOnlyVertexShader.IsValid())
+        {
+            return false;
+        }
+
+        m_DepthPrepassPSO
+            .Begin()
+            .SetRootSignature(m_RootSignature)
+            .SetVertexShader(m_DepthOnlyVertexShader)
+            .AddInputElement("HEIGHT", 0, DXGI_FORMAT_R16_UNORM, 0, offsetof(TerrainVertex, Height))
+            .AddInputElement("HEIGHT", 1, DXGI_FORMAT_R16_UNORM, 0, offsetof(TerrainVertex, MorphHeight))
+            .AddInputElement(SM::SemanticName::Normal, 0, DXGI_FORMAT_R16G16_SNORM, 0, offsetof(TerrainVertex, Normal))
+            .SetRasterizer(SM::FillMode::Solid, SM::CullMode::Back)
+            .SetBlendMode(SM::BlendMode::Opaque)
+            .SetDepthStencil(true, true, SM::DepthFunc::Less)
+            .SetDepthStencilFormat(m_Core->GetDepthFormat())
+            .Build(m_Core);
+
+        if (!m_DepthPrepassPSO.IsValid())
+        {
+            std::cerr << "[TerrainRenderer] Failed to create depth pre-pass PSO!" << std::endl;
+            m_DepthPrepassPSO.Begin();
+            return false;
+        }
+
+        return true;
+    }
+
+    bool TerrainRenderer::CreateShadowMaps()
+    {
+        if (!m_ShadowMaps)
+        {
+            m_ShadowMaps = std::make_unique<TerrainShadowMaps>();
+        }
+
+        if (!m_ShadowMaps->Initialize(m_Core, m_Config.ShadowCascades, m_Config.ShadowMapSize))
+        {
+            std::cerr << "[TerrainRenderer] Failed to create shadow maps!" << std::endl;
+            m_ShadowMaps.reset();
+            return false;
+        }
+
+        std::cout << "[TerrainRenderer] Shadow maps created: " << m_ShadowMaps->GetCascadeCount() << " cascades of "
+                  << m_ShadowMaps->GetResolution() << "^2" << std::endl;
+        return true;
+    }
+
+    bool TerrainRenderer::CreateMeshletPipeline()
     {
-        std::cout << "[TerrainRenderer] Creating terrain constant buffers..." << std::endl;
+        m_MeshletPSO.Begin();
+        m_MeshletWireframePSO.Begin();
 
-        // Per-frame constant buffer
-        m_PerFrameCB = std::make_unique<SM::ConstantBuffer>();
-        if (!m_PerFrameCB->Initialize(m_Core, sizeof(TerrainPerFrameData)))
+        if (!m_Core->AreMeshShadersSupported())
         {
-            std::cerr << "[TerrainRenderer] Failed to create per-frame CB!" << std::endl;
             return false;
         }
 
-        // Per-chunk constant buffer
-        m_PerChunkCB = std::make_unique<SM::ConstantBuffer>();
-        if (!m_PerChunkCB->Initialize(m_Core, sizeof(TerrainPerChunkData)))
+        // SM 6.5 shaders only exist precompiled; FXC cannot build them at runtime
+        const std::array<D3D_SHADER_MACRO, 3> defines = GetPermutationDefines(m_Config);
+        const D3D_SHADER_MACRO pixelDefines[] = { defines[0], { nullptr, nullptr } };
+
+        SM::ShaderCache& cache = SM::ShaderCache::Get();
+        if (!cache.LoadPrecompiled(TERRAIN_MESH_SHADER_PATH, "MeshletAS", nullptr, m_MeshletAmplificationShader.Blob) ||
+            !cache.LoadPrecompiled(TERRAIN_MESH_SHADER_PATH, "MeshletMS", defines.data(), m_MeshletMeshShader.Blob) ||
+            !cache.LoadPrecompiled("shaders/TerrainPixel.hlsl", "main", pixelDefines, m_MeshletPixelShader.Blob))
+        {
+            return false;
+        }
+
+        SM::GraphicsPipelineState* psos[] = { &m_MeshletPSO, &m_MeshletWireframePSO };
+        for (SM::GraphicsPipelineState* pso : psos)
+        {
+            const bool wireframe = pso == &m_MeshletWireframePSO;
+            pso->Begin()
+                .SetRootSignature(m_RootSignature)
+                .SetAmplificationShader(m_MeshletAmplificationShader)
+                .SetMeshShader(m_MeshletMeshShader)
+                .SetPixelShader(m_MeshletPixelShader)
+                .SetRasterizer(wireframe ? SM::FillMode::Wireframe : SM::FillMode::Solid,
+                               wireframe ? SM::CullMode::None : SM::CullMode::Back)
+                .SetBlendMode(SM::BlendMode::Opaque)
+                .SetDepthStencil(true, true, SM::DepthFunc::Less)
+                .SetRenderTargetFormat(m_Core->GetBackBufferFormat())
+                .SetDepthStencilFormat(m_Core->GetDepthFormat())
+                .Build(m_Core);
+        }
+
+        if (!m_MeshletPSO.IsValid() || !m_MeshletWireframePSO.IsValid())
+        {
+            std::cerr << "[TerrainRenderer] Failed to create meshlet PSOs!" << std::endl;
+            m_MeshletPSO.Begin();
+            m_MeshletWireframePSO.Begin();
+            return false;
+        }
+
+        std::cout << "[TerrainRenderer] Mesh shader terrain path enabled." << std::endl;
+        return true;
+    }
+
+    bool TerrainRenderer::CreateIndirectResources()
+    {
+        std::cout << "[TerrainRenderer] Creating indirect draw resources..." << std::endl;
+
+        // Every template indexes at most the full-resolution grid (33x33), so 16 bits suffice
+        constexpr uint32_t GRID_VERTEX_COUNT = (Chunk::SIZE + 1) * (Chunk::SIZE + 1);
+        static_assert(GRID_VERTEX_COUNT <= 0xFFFF, "Chunk index templates must fit 16-bit indices");
+        std::vector<uint16_t> narrowIndices;
+
+        // One index buffer per LOD; topology depends only on the LOD step (already cache-ordered)
+        m_LODIndexBuffers.clear();
+        for (int lod = 0; lod <= Chunk::MAX_LOD; ++lod)
+        {
+            const std::vector<uint32_t>& indices = Chunk::GetSharedLODIndices(lod);
+            SM::MeshOptimizer::ConvertTo16BitIndices(indices.data(), indices.size(), narrowIndices);
+
+            auto indexBuffer = std::make_unique<SM::IndexBuffer>();
+            if (!indexBuffer->Initialize(
+                m_Core,
+                static_cast<uint32_t>(narrowIndices.size()),
+                false,  // 16-bit indices
+                SM::GPUBufferUsage::Upload,
+                narrowIndices.data()))
+            {
+                std::cerr << "[TerrainRenderer] Failed to create LOD " << lod << " index buffer!" << std::endl;
+                return false;
+            }
+
+            m_LODIndexBuffers.push_back(std::move(indexBuffer));
+        }
+
+        // Stitched variants for geomorphed chunks, packed LOD-major then by stitch mask
+        std::vector<uint32_t> stitchedIndices;
+        m_StitchedIndexCounts.clear();
+        m_StitchedIndexStarts.clear();
+        for (int lod = 0; lod <= Chunk::MAX_LOD; ++lod)
+        {
+            m_StitchedIndexStarts.push_back(static_cast<uint32_t>(stitchedIndices.size()));
+
+            for (uint32_t mask = 0; mask < Chunk::STITCH_VARIANT_COUNT; ++mask)
+            {
+                // Each variant is drawn as its own range, so each is cache-ordered on its own
+                const size_t variantStart = stitchedIndices.size();
+                Chunk::GenerateStitchedIndices(stitchedIndices, 1 << lod, mask);
+                SM::MeshOptimizer::OptimizeVertexCache(stitchedIndices.data() + variantStart,
+                                                       stitchedIndices.size() - variantStart, GRID_VERTEX_COUNT);
+            }
+
+            m_StitchedIndexCounts.push_back(
+                (static_cast<uint32_t>(stitchedIndices.size()) - m_StitchedIndexStarts.back()) / Chunk::STITCH_VARIANT_COUNT);
+        }
+
+        SM::MeshOptimizer::ConvertTo16BitIndices(stitchedIndices.data(), stitchedIndices.size(), narrowIndices);
+
+        m_StitchedIndexBuffer = std::make_unique<SM::IndexBuffer>();
+        if (!m_StitchedIndexBuffer->Initialize(
+            m_Core,
+            static_cast<uint32_t>(narrowIndices.size()),
+            false,  // 16-bit indices
+            SM::GPUBufferUsage::Upload,
+            narrowIndices.data()))
+        {
+            std::cerr << "[TerrainRenderer] Failed to create stitched index buffer!" << std::endl;
+            return false;
+        }
+
+        // Command layout must match TerrainIndirectCommand
+        D3D12_INDIRECT_ARGUMENT_DESC arguments[3] = {};
+        arguments[0].Type = D3D12_INDIRECT_ARGUMENT_TYPE_VERTEX_BUFFER_VIEW;
+        arguments[0].VertexBuffer.Slot = 0;
+        arguments[1].Type = D3D12_INDIRECT_ARGUMENT_TYPE_CONSTANT;
+        arguments[1].Constant.RootParameterIndex = ROOT_CHUNK_INDEX;
+        arguments[1].Constant.DestOffsetIn32BitValues = 0;
+        arguments[1].Constant.Num32BitValuesToSet = 1;
+        arguments[2].Type = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED;
+
+        D3D12_COMMAND_SIGNATURE_DESC signatureDesc = {};
+        signatureDesc.ByteStride = sizeof(TerrainIndirectCommand);
+        signatureDesc.NumArgumentDescs = 3;
+        signatureDesc.pArgumentDescs = arguments;
+
+        // Root signature is required because the commands write a root constant
+        HRESULT hr = m_Core->GetDevice()->CreateCommandSignature(
+            &signatureDesc,
+            m_RootSignature.GetNative(),
+            IID_PPV_ARGS(&m_CommandSignature)
+        );
+
+        if (FAILED(hr))
+        {
+            std::cerr << "[TerrainRenderer] Failed to create command signature!" << std::endl;
+            return false;
+        }
+
+        std::cout << "[TerrainRenderer] Indirect draw resources created." << std::endl;
+        return true;
+    }
+
+    void TerrainRenderer::FillChunkData(const Chunk& chunk, TerrainPerChunkData& chunkData) const
+    {
+        // Identity world matrix (chunks are already in world space)
+        DirectX::XMStoreFloat4x4(&chunkData.World, DirectX::XMMatrixIdentity());
+
+        DirectX::XMFLOAT3 worldPos = chunk.GetWorldPosition();
+        chunkData.ChunkOffset = DirectX::XMFLOAT2(worldPos.x, worldPos.z);
+        chunkData.TextureScale = m_Config.TextureScale;
+
+        // Vertex heights are quantized against the range the mesh was built with
+        chunkData.MinHeight = chunk.GetMeshMinHeight();
+        chunkData.MaxHeight = chunk.GetMeshMaxHeight();
+        chunkData.LODStep = 1u << chunk.GetMeshLOD();
+
+        if (chunk.HasGeomorphMesh())
+        {
+            const ChunkMorphState& morph = chunk.GetMorphState();
+            chunkData.DrawStep = 1u << chunk.GetLOD();
+            chunkData.MorphFactor = morph.MorphFactor;
+            for (int edge = 0; edge < 4; ++edge)
+            {
+                chunkData.EdgeStep[edge] = 1u << morph.EdgeLOD[edge];
+                chunkData.EdgeMorph[edge] = morph.EdgeMorph[edge];
+            }
+        }
+        else
+        {
+            // Drawn at the built grid with no morphing
+            chunkData.DrawStep = chunkData.LODStep;
+            chunkData.MorphFactor = 0.0f;
+            for (int edge = 0; edge < 4; ++edge)
+            {
+                chunkData.EdgeStep[edge] = chunkData.LODStep;
+                chunkData.EdgeMorph[edge] = 0.0f;
+            }
+        }
+    }
+
+    bool TerrainRenderer::GetStitchedIndexRange(const Chunk& chunk, uint32_t& startIndex, uint32_t& indexCount) const
+    {
+        const int lod = chunk.GetLOD();
+        if (!chunk.HasGeomorphMesh() || !m_StitchedIndexBuffer || lod >= static_cast<int>(m_StitchedIndexCounts.size()))
         {
-            std::cerr << "[TerrainRenderer] Failed to create per-chunk CB!" << std::endl;
             return false;
         }
 
-        std::cout << "[TerrainRenderer] Terrain constant buffers created." << std::endl;
+        indexCount = m_StitchedIndexCounts[lod];
+        startIndex = m_StitchedIndexStarts[lod] + chunk.GetStitchMask() * indexCount;
         return true;
     }
 
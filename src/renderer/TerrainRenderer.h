@@ -8,15 +8,27 @@
  * - Terrain-specific shaders
  * - Height-based texture blending
  * - LOD-aware rendering
+ * - Optional ExecuteIndirect submission with shared per-LOD index buffers
+ * - Optional GPU-driven culling (frustum + Hi-Z) feeding ExecuteIndirect
+ * - Geomorphed LODs with edge stitching for full-resolution chunk meshes
+ * - Amplification/mesh shader path with per-meshlet culling on supporting hardware
+ * - Optional hardware tessellation of fixed patch grids displaced by the heightfield
+ * - Optional geometry clipmap mode drawing nested camera-centred grids instead of chunk meshes
+ * - Optional far-field horizon ring beyond the chunk view distance
+ * - Optional cascaded sun shadows with cached static terrain depth
+ * - Tier 2 variable rate shading: coarse rates in fog, far away and on coarse chunk LODs
  */
 
 #include "renderer/DX12Core.h"
 #include "renderer/RootSignature.h"
 #include "renderer/PipelineState.h"
 #include "renderer/GPUBuffer.h"
+#include "renderer/TerrainShadowMaps.h"
 
 #include <DirectXMath.h>
+#include <functional>
 #include <memory>
+#include <vector>
 
 namespace SM
 {
@@ -28,6 +40,10 @@ namespace PCG
 {
     class Chunk;
     class ChunkManager;
+    class TerrainGPUCulling;
+    class TerrainClipmap;
+    class TerrainFarField;
+    class TerrainShadingRate;
 
     /**
      * @brief Per-frame terrain constant buffer
@@ -42,7 +58,8 @@ namespace PCG
         DirectX::XMFLOAT4 FogColor;
         float FogStart;
         float FogEnd;
-        float Padding[2];
+        float MeshletCullDistance;        ///< Meshlets farther than this are culled (mesh shader path)
+        float TessellationScale;          ///< Edge length to segments at distance 1 (tessellation path)
     };
 
     /**
@@ -55,7 +72,24 @@ namespace PCG
         float TextureScale;
         float MinHeight;
         float MaxHeight;
-        float Padding[3];
+        uint32_t LODStep;                 ///< Grid step of the mesh, for vertex X/Z reconstruction
+        uint32_t DrawStep;                ///< Grid step being drawn (equals LODStep unless geomorphed)
+        float MorphFactor;                ///< Interior blend toward the grid twice as coarse
+        uint32_t EdgeStep[4];             ///< Drawn grid step of border vertices (-X, +X, -Z, +Z)
+        float EdgeMorph[4];               ///< Morph factor of border vertices
+    };
+
+    /**
+     * @brief One ExecuteIndirect command for a terrain chunk
+     *
+     * Layout must match the command signature built in CreateIndirectResources:
+     * vertex buffer view, chunk index root constant (b2), indexed draw.
+     */
+    struct TerrainIndirectCommand
+    {
+        D3D12_VERTEX_BUFFER_VIEW VertexBuffer;
+        uint32_t ChunkIndex;
+        D3D12_DRAW_INDEXED_ARGUMENTS Draw;
     };
 
     /**
@@ -65,11 +99,39 @@ namespace PCG
     {
         float HeightScale = 50.0f;        ///< World-space height multiplier
         float TextureScale = 10.0f;       ///< Texture UV tiling
-        bool EnableFog = true;            ///< Enable distance fog
+        bool EnableFog = true;            ///< Enable distance fog (shader permutation)
         float FogStart = 100.0f;          ///< Distance where fog starts
         float FogEnd = 500.0f;            ///< Distance where fog is fully opaque
         DirectX::XMFLOAT4 FogColor = { 0.6f, 0.7f, 0.8f, 1.0f }; ///< Fog color
         bool EnableWireframe = false;     ///< Render in wireframe mode
+        bool EnableGeomorph = true;       ///< Blend LOD heights toward the coarser level (shader permutation)
+        bool EnableIndirectDraw = false;  ///< Submit chunks with one ExecuteIndirect per LOD
+        bool EnableGPUCulling = false;    ///< Cull chunks in a compute pass (set ChunkManager FrustumCulling off)
+        bool EnableOcclusionCulling = true; ///< Test GPU-culled chunks against the renderer's Hi-Z
+        bool EnableDepthPrepass = false;  ///< Lay down chunk depth before shading and build the Hi-Z from it
+        bool EnableParallelRecording = true; ///< Record per-chunk draws on job workers
+        uint32_t ParallelMinChunksPerList = 64; ///< Chunks per worker list before splitting pays off
+        bool EnableMeshShaders = true;    ///< Draw meshlets with mesh shaders when the device and build allow
+        float MeshletCullDistance = 0.0f; ///< Cull meshlets beyond this distance (0 = never)
+        bool EnableTessellation = false;  ///< Tessellate patch grids on the GPU (pair with ChunkManager GeomorphLOD)
+        float TessellationEdgePixels = 16.0f; ///< Target screen-space length of tessellated edges
+        bool EnableClipmap = false;       ///< Draw a geometry clipmap instead of chunk meshes (takes priority)
+        uint32_t ClipmapLevels = 6;       ///< Nested clipmap levels (each doubles the covered distance)
+        uint32_t ClipmapGridSize = 64;    ///< Quads per clipmap level side (multiple of 4, at least 32)
+        bool EnableFarField = false;      ///< Draw a coarse horizon ring beyond the chunk view distance
+        float FarFieldDistance = 950.0f;  ///< Outer radius of the ring (keep inside the camera far plane)
+        float FarFieldSpacing = 16.0f;    ///< World distance between ring vertices
+        float FarFieldSink = 2.0f;        ///< How far the ring is lowered below the true surface
+        bool EnableShadows = false;       ///< Cast sun shadows from terrain and dynamic casters onto terrain
+        uint32_t ShadowCascades = 4;      ///< Shadow cascades (1 - TerrainShadowMaps::MAX_CASCADES)
+        uint32_t ShadowMapSize = 2048;    ///< Width and height of each cascade's maps
+        float ShadowDistance = 300.0f;    ///< View depth where the last cascade ends
+        float ShadowLightThreshold = 2.0f; ///< Light rotation in degrees before the cached depth is redrawn
+        bool EnableVariableRateShading = true; ///< Coarsen shading in fog and far away (needs tier 2 VRS)
+        float VRSFogThreshold = 0.5f;     ///< Fog factor from which screen tiles shade at 2x2
+        float VRSHeavyFogThreshold = 0.85f; ///< Fog factor from which screen tiles shade at 4x4 (2x2 without 4x4 support)
+        float VRSFarDistance = 600.0f;    ///< Distance from which screen tiles shade at 2x2
+        int VRSCoarseLOD = 3;             ///< Chunks at this LOD or coarser draw at 2x2 (per-chunk paths)
     };
 
     /**
@@ -138,14 +200,195 @@ namespace PCG
 
         /**
          * @brief Enable/disable fog
+         *
+         * Switches shader permutation, so changing it after initialization
+         * rebuilds the terrain PSOs.
          */
         void SetFogEnabled(bool enabled);
 
+        /**
+         * @brief Enable/disable LOD geomorphing (rebuilds the terrain PSOs like SetFogEnabled)
+         */
+        void SetGeomorphEnabled(bool enabled);
+
+        /**
+         * @brief Recompile the terrain shaders and PSOs after their sources changed (hot reload)
+         */
+        bool ReloadShaders();
+
         /**
          * @brief Enable/disable wireframe rendering
          */
         void SetWireframe(bool enabled);
 
+        /**
+         * @brief Enable/disable ExecuteIndirect chunk submission
+         */
+        void SetIndirectDraw(bool enabled);
+
+        /**
+         * @brief Enable/disable GPU-driven culling
+         * @param enabled Cull and draw chunks from a compute pass
+         * @param occlusion Also test chunks against the renderer's Hi-Z pyramid
+         */
+        void SetGPUCulling(bool enabled, bool occlusion = true);
+
+        /**
+         * @brief Enable/disable the mesh shader path (ignored where unavailable)
+         */
+        void SetMeshShaders(bool enabled);
+
+        /**
+         * @brief Enable/disable hardware tessellation (takes priority over the other paths)
+         * @param enabled Draw chunks as tessellated patch grids
+         * @param edgePixels Target screen-space edge length of the tessellated triangles
+         */
+        void SetTessellation(bool enabled, float edgePixels = 16.0f);
+
+        /**
+         * @brief Enable/disable the geometry clipmap (takes priority over every chunk path)
+         * @param enabled Draw nested camera-centred grids instead of chunk meshes
+         * @param levels Nested levels (the finest level covers gridSize vertices)
+         * @param gridSize Quads per level side
+         *
+         * Chunks are still streamed for height queries, culling and foliage;
+         * only their meshes are no longer drawn. Changing the level layout
+         * recreates the clipmap and resamples every height.
+         */
+        void SetClipmap(bool enabled, uint32_t levels = 6, uint32_t gridSize = 64);
+
+        /**
+         * @brief Check if the clipmap pipelines were created successfully
+         */
+        bool IsClipmapAvailable() const { return m_ClipmapPSO.IsValid(); }
+
+        /**
+         * @brief Get the clipmap (null until first enabled)
+         */
+        const TerrainClipmap* GetClipmap() const { return m_Clipmap.get(); }
+
+        /**
+         * @brief Enable/disable the far-field horizon ring (drawn after any terrain path)
+         * @param enabled Draw coarse terrain from the chunk (or clipmap) edge out to distance
+         * @param distance Outer radius of the ring
+         * @param spacing World distance between ring vertices
+         *
+         * Region heightmaps are sampled once on job workers and cached, so
+         * the ring costs one draw per frame. Set the fog end near distance
+         * (SetFog) so the ring's edge fades out. Changing distance or
+         * spacing recreates the far field and resamples every region.
+         */
+        void SetFarField(bool enabled, float distance = 950.0f, float spacing = 16.0f);
+
+        /**
+         * @brief Check if the far-field pipelines were created successfully
+         */
+        bool IsFarFieldAvailable() const { return m_FarFieldPSO.IsValid(); }
+
+        /**
+         * @brief Get the far field (null until first enabled)
+         */
+        const TerrainFarField* GetFarField() const { return m_FarField.get(); }
+
+        /**
+         * @brief Enable/disable cascaded sun shadows on the terrain
+         * @param enabled Render shadow maps before the terrain and sample them in its pixel shader
+         * @param cascades Number of cascades
+         * @param mapSize Width and height of each cascade's maps
+         *
+         * Static terrain depth is cached across frames; only chunks that
+         * streamed in, unloaded or rebuilt their mesh are redrawn, unless
+         * the camera leaves a cascade's box or the light turns past
+         * ShadowLightThreshold. Changing the cascade count or size
+         * recreates the maps.
+         */
+        void SetShadows(bool enabled, uint32_t cascades = 4, uint32_t mapSize = 2048);
+
+        /**
+         * @brief Set the sun direction (the direction light travels)
+         */
+        void SetLightDirection(const DirectX::XMFLOAT3& direction);
+
+        /**
+         * @brief Set the callback that draws dynamic casters (e.g. ECS meshes) into each cascade
+         *
+         * Called once per cascade and frame with the renderer's depth-only
+         * state left to the callback; see TerrainShadowMaps::DrawDynamicFunc.
+         */
+        void SetDynamicShadowCasters(TerrainShadowMaps::DrawDynamicFunc drawDynamic);
+
+        /**
+         * @brief Draws extra opaque geometry (e.g. ECS meshes) into the depth pre-pass
+         * @return Number of objects drawn
+         *
+         * Runs with the renderer's frame state bound and must leave it bound.
+         */
+        using DepthPrepassFunc = std::function<uint32_t()>;
+
+        /**
+         * @brief Enable/disable the depth pre-pass
+         *
+         * Chunk meshes (and the SetDepthPrepassCasters geometry) are drawn
+         * depth-only first, the renderer's Hi-Z is built from that depth, and
+         * the color pass then shades each pixel once under a LESS_EQUAL test.
+         * Only the chunk-mesh paths use it; clipmap, tessellation, mesh
+         * shader and wireframe rendering skip it.
+         */
+        void SetDepthPrepass(bool enabled) { m_Config.EnableDepthPrepass = enabled; }
+
+        /**
+         * @brief Set the callback that draws extra opaque geometry into the depth pre-pass
+         */
+        void SetDepthPrepassCasters(DepthPrepassFunc drawCasters);
+
+        /**
+         * @brief Check if the depth pre-pass pipeline was created successfully
+         */
+        bool IsDepthPrepassAvailable() const { return m_DepthPrepassPSO.IsValid(); }
+
+        /**
+         * @brief Enable/disable variable rate shading of the terrain pass
+         *
+         * A shading rate image built from the renderer's Hi-Z coarsens
+         * fogged and distant screen tiles for every terrain path; chunks
+         * drawn one at a time also coarsen from VRSCoarseLOD on. Meshes and
+         * UI drawn after the terrain pass keep full rate.
+         */
+        void SetVariableRateShading(bool enabled) { m_Config.EnableVariableRateShading = enabled; }
+
+        /**
+         * @brief Check if the device supports tier 2 variable rate shading and its pipeline was created
+         */
+        bool IsVariableRateShadingAvailable() const { return m_ShadingRate != nullptr; }
+
+        /**
+         * @brief Check if the shadow pipeline was created successfully
+         */
+        bool IsShadowAvailable() const { return m_ShadowPSO.IsValid(); }
+
+        /**
+         * @brief Get the shadow maps (null until first enabled)
+         */
+        const TerrainShadowMaps* GetShadowMaps() const { return m_ShadowMaps.get(); }
+
+        /**
+         * @brief Check if the tessellation pipelines were created successfully
+         */
+        bool IsTessellationAvailable() const { return m_TessellationPSO.IsValid(); }
+
+        /**
+         * @brief Check if the mesh shader path was created successfully
+         *
+         * Needs device mesh shader support and the offline-built TerrainMesh
+         * shaders; the vertex shader paths are used otherwise.
+         */
+        bool IsMeshShaderPathAvailable() const { return m_MeshletPSO.IsValid(); }
+
+        /**
+         * @brief Check if the GPU culling pass was created successfully
+         */
+        bool IsGPUCullingAvailable() const { return m_GPUCulling != nullptr; }
+
         /**
          * @brief Get current configuration
          */
@@ -159,9 +402,109 @@ namespace PCG
          * @brief Render a single terrain chunk
          * @param chunk Chunk to render
          * @param viewProjection View-projection matrix
+         *
+         * Chunks built without their own index buffer use the shared one for
+         * their mesh LOD.
          */
         void RenderChunk(const Chunk& chunk, const DirectX::XMMATRIX& viewProjection);
 
+        /**
+         * @brief Render chunks with one ExecuteIndirect call per LOD level
+         * @param chunks Chunks to render (null or mesh-less entries are skipped)
+         *
+         * Per-chunk constants go into a structured buffer indexed by a root
+         * constant, and every chunk draws with the shared index buffer for
+         * its mesh LOD. Call between BeginTerrainPass and EndTerrainPass.
+         */
+        void RenderChunksIndirect(const std::vector<Chunk*>& chunks);
+
+        /**
+         * @brief Cull chunks on the GPU and draw the survivors with one ExecuteIndirect
+         * @param chunks Candidate chunks (null or mesh-less entries are skipped)
+         * @param viewProjection View-projection matrix
+         *
+         * Uploads bounds and draw arguments for every candidate, culls them
+         * against the frustum and the renderer's Hi-Z in a compute pass
+         * (this frame's pre-pass depth, or last frame's), then draws with a
+         * GPU-written count. Chunk and triangle statistics count submitted candidates.
+         * Call between BeginTerrainPass and EndTerrainPass.
+         */
+        void RenderChunksGPUCulled(const std::vector<Chunk*>& chunks, const DirectX::XMMATRIX& viewProjection);
+
+        /**
+         * @brief Render chunks as meshlets with amplification and mesh shaders
+         * @param chunks Chunks to render (null or mesh-less entries are skipped)
+         *
+         * One amplification group per chunk culls its meshlets by frustum,
+         * normal cone and distance; the mesh shader builds the survivors from
+         * the chunk's vertex data read as a heightfield, without index
+         * buffers. Triangle statistics count meshlets before culling. Call
+         * between BeginTerrainPass and EndTerrainPass.
+         */
+        void RenderChunksMeshlets(const std::vector<Chunk*>& chunks);
+
+        /**
+         * @brief Render chunks as hardware-tessellated patch grids
+         * @param chunks Chunks to render (null or mesh-less entries are skipped)
+         *
+         * Every chunk draws the same patch grid without vertex or index
+         * buffers; the hull shader sets detail from screen-space edge length,
+         * capped by the chunk's LOD, and the domain shader displaces by the
+         * chunk's heightfield. The chunk's mesh is only read, never rebuilt
+         * for LOD. Triangle statistics count untessellated patches. Call
+         * between BeginTerrainPass and EndTerrainPass.
+         */
+        void RenderChunksTessellated(const std::vector<Chunk*>& chunks);
+
+        /**
+         * @brief Render the terrain as a geometry clipmap around the camera
+         * @param chunkManager Height source (chunk meshes are not used)
+         * @param cameraPosition Camera world position the levels follow
+         *
+         * Samples heights that scrolled into each level, uploads changed
+         * levels and draws one indexed grid per level. Triangle statistics
+         * count every level; the chunk count stays zero. Call between
+         * BeginTerrainPass and EndTerrainPass.
+         */
+        void RenderClipmap(const ChunkManager& chunkManager, const DirectX::XMFLOAT3& cameraPosition);
+
+        /**
+         * @brief Render the far-field horizon ring beyond the nearer terrain
+         * @param chunkManager Height source; its view distance (or the clipmap's coverage) sets the ring's hole
+         * @param cameraPosition Camera world position the ring follows
+         *
+         * Requests missing region heightmaps, rebuilds the ring when the
+         * camera crossed a grid cell and draws it in one call. Triangle and
+         * draw statistics include the ring. Call between BeginTerrainPass and
+         * EndTerrainPass, after the nearer terrain.
+         */
+        void RenderFarField(const ChunkManager& chunkManager, const DirectX::XMFLOAT3& cameraPosition);
+
+        /**
+         * @brief Update and record the shadow cascades for this frame
+         * @param chunkManager Source of the static casters (every loaded chunk)
+         * @param viewProjection Camera view-projection the cascades are fitted to
+         * @param cameraPosition Camera world position
+         *
+         * Redraws the cached static depth where it changed, then the
+         * dynamic casters, and restores the renderer's frame state. Draw
+         * and triangle statistics include the static shadow draws. Call
+         * after UpdateFrameConstants and before BeginTerrainPass.
+         */
+        void RenderShadows(const ChunkManager& chunkManager, const DirectX::XMMATRIX& viewProjection,
+                           const DirectX::XMFLOAT3& cameraPosition);
+
+        /**
+         * @brief Draw chunk depth and the pre-pass casters, then build the renderer's Hi-Z
+         * @param chunks Candidate chunks (tested against the view frustum here)
+         * @param viewProjection Camera view-projection
+         *
+         * Uses this frame's camera constants, so late latching moves it with
+         * the color pass. Draw and triangle statistics include the pre-pass.
+         * Call after UpdateFrameConstants and before BeginTerrainPass.
+         */
+        void RenderDepthPrepass(const std::vector<Chunk*>& chunks, const DirectX::XMMATRIX& viewProjection);
+
         /**
          * @brief Render all terrain from chunk manager
          * @param chunkManager ChunkManager containing terrain data
@@ -195,6 +538,18 @@ namespace PCG
                                   const DirectX::XMFLOAT3& cameraPosition,
                                   float time);
 
+        /**
+         * @brief Rewrite this frame's camera constants with a newer pose
+         * @param viewProjection Latest view-projection matrix
+         * @param cameraPosition Latest camera position
+         *
+         * Only valid between this frame's UpdateFrameConstants and its
+         * submission (see Renderer::LateLatchCamera). Chunks were culled
+         * against the earlier pose.
+         */
+        void LateLatchFrameConstants(const DirectX::XMMATRIX& viewProjection,
+                                     const DirectX::XMFLOAT3& cameraPosition);
+
         // ====================================================================
         // Statistics
         // ====================================================================
@@ -209,6 +564,11 @@ namespace PCG
          */
         uint32_t GetRenderedTriangleCount() const { return m_RenderedTriangleCount; }
 
+        /**
+         * @brief Get draw, mesh dispatch and ExecuteIndirect calls recorded last frame
+         */
+        uint32_t GetDrawCallCount() const { return m_DrawCallCount; }
+
         /**
          * @brief Reset rendering statistics
          */
@@ -216,10 +576,20 @@ namespace PCG
 
     private:
         /**
-         * @brief Create terrain shaders
+         * @brief Store the camera-dependent fields of m_FrameData
+         */
+        void SetCameraConstants(const DirectX::XMMATRIX& viewProjection, const DirectX::XMFLOAT3& cameraPosition);
+
+        /**
+         * @brief Create terrain shaders for the configured permutation
          */
         bool CreateShaders();
 
+        /**
+         * @brief Recompile the shaders and PSOs after a permutation toggle
+         */
+        bool RebuildShaderPermutation();
+
         /**
          * @brief Create terrain root signature
          */
@@ -231,9 +601,120 @@ namespace PCG
         bool CreatePipelineState();
 
         /**
-         * @brief Create constant buffers
+         * @brief Load the mesh shaders and create the meshlet PSOs
+         * @return false if the mesh shader path is unavailable (not an error)
+         */
+        bool CreateMeshletPipeline();
+
+        /**
+         * @brief Compile the patch shaders and create the tessellation PSOs
+         * @return false if the tessellation path is unavailable
+         */
+        bool CreateTessellationPipeline();
+
+        /**
+         * @brief Compile the clipmap vertex shader and create the clipmap PSOs
+         * @return false if the clipmap path is unavailable
+         */
+        bool CreateClipmapPipeline();
+
+        /**
+         * @brief Create the clipmap for the configured level layout
          */
-        bool CreateConstantBuffers();
+        bool CreateClipmap();
+
+        /**
+         * @brief Compile the far-field vertex shader and create the far-field PSOs
+         * @return false if the far-field path is unavailable
+         */
+        bool CreateFarFieldPipeline();
+
+        /**
+         * @brief Create the far field for the configured distance and spacing
+         */
+        bool CreateFarField();
+
+        /**
+         * @brief Compile the depth-only vertex shader and create the shadow PSO
+         * @return false if shadows are unavailable
+         */
+        bool CreateShadowPipeline();
+
+        /**
+         * @brief Build the depth pre-pass pipeline (needs the depth-only vertex shader)
+         */
+        bool CreateDepthPrepassPipeline();
+
+        /**
+         * @brief Check if this frame's configuration draws chunk meshes the pre-pass can cover
+         */
+        bool UsesDepthPrepass() const;
+
+        /**
+         * @brief Create the shadow maps for the configured cascades and size
+         */
+        bool CreateShadowMaps();
+
+        /**
+         * @brief Draw static chunks into the bound shadow map slice
+         * @return Number of draws recorded
+         */
+        uint32_t RecordShadowChunks(ID3D12GraphicsCommandList* cmdList, const DirectX::XMMATRIX& lightViewProjection,
+                                    std::span<const Chunk* const> chunks);
+
+        /**
+         * @brief Bind this frame's cascade constants and shadow map table (null maps when shadows are off)
+         */
+        void BindShadowSampling(ID3D12GraphicsCommandList* cmdList) const;
+
+        /**
+         * @brief Create shared LOD index buffers and the indirect command signature
+         */
+        bool CreateIndirectResources();
+
+        /**
+         * @brief Fill per-chunk constants for a chunk
+         */
+        void FillChunkData(const Chunk& chunk, TerrainPerChunkData& chunkData) const;
+
+        /**
+         * @brief Set the terrain pipeline, root signature, topology and shading rate image on a list
+         */
+        void BindTerrainPass(ID3D12GraphicsCommandList* cmdList) const;
+
+        /**
+         * @brief Build this frame's shading rate image if variable rate shading is on
+         *
+         * Call before BeginTerrainPass; EndTerrainPass returns to full rate.
+         */
+        void PrepareShadingRate(const DirectX::XMFLOAT3& cameraPosition);
+
+        /**
+         * @brief Set the per-draw base shading rate on a list (no-op without a shading rate image)
+         */
+        void SetBaseShadingRate(ID3D12GraphicsCommandList* cmdList, D3D12_SHADING_RATE rate) const;
+
+        /**
+         * @brief Record one chunk draw into a list
+         * @param cmdList List to record into (any thread; one list per thread)
+         * @param chunk Chunk with a mesh
+         * @param chunkCount Incremented when the chunk was drawn
+         * @param triangleCount Receives the drawn triangles
+         */
+        void RecordChunk(ID3D12GraphicsCommandList* cmdList, const Chunk& chunk,
+                         uint32_t& chunkCount, uint32_t& triangleCount) const;
+
+        /**
+         * @brief Record one chunk draw with given per-frame constants (e.g. a shadow cascade's)
+         */
+        void RecordChunk(ID3D12GraphicsCommandList* cmdList, const Chunk& chunk, D3D12_GPU_VIRTUAL_ADDRESS frameCB,
+                         uint32_t& chunkCount, uint32_t& triangleCount) const;
+
+        /**
+         * @brief Find a geomorphed chunk's range in the stitched index buffer
+         * @return false if the chunk has no geomorphed mesh
+         */
+        bool GetStitchedIndexRange(const Chunk& chunk, uint32_t& startIndex, uint32_t& indexCount) const;
 
     private:
         // Initialization state
@@ -248,25 +729,82 @@ namespace PCG
 
         // Shaders
         SM::ShaderBytecode m_VertexShader;
+        SM::ShaderBytecode m_IndirectVertexShader;
         SM::ShaderBytecode m_PixelShader;
+        SM::ShaderBytecode m_MeshletAmplificationShader;
+        SM::ShaderBytecode m_MeshletMeshShader;
+        SM::ShaderBytecode m_MeshletPixelShader;     ///< Always DXIL, which mesh pipelines require
+        SM::ShaderBytecode m_PatchVertexShader;
+        SM::ShaderBytecode m_PatchHullShader;
+        SM::ShaderBytecode m_PatchDomainShader;
+        SM::ShaderBytecode m_ClipmapVertexShader;
+        SM::ShaderBytecode m_FarFieldVertexShader;
+        SM::ShaderBytecode m_DepthOnlyVertexShader;  ///< Shadow maps and the depth pre-pass
 
         // Pipeline resources
         SM::RootSignature m_RootSignature;
         SM::GraphicsPipelineState m_TerrainPSO;
         SM::GraphicsPipelineState m_WireframePSO;
-
-        // Constant buffers
-        std::unique_ptr<SM::ConstantBuffer> m_PerFrameCB;
-        std::unique_ptr<SM::ConstantBuffer> m_PerChunkCB;
-
-        // Frame data
+        SM::GraphicsPipelineState m_IndirectPSO;
+        SM::GraphicsPipelineState m_IndirectWireframePSO;
+        SM::GraphicsPipelineState m_MeshletPSO;      ///< Invalid without mesh shader support
+        SM::GraphicsPipelineState m_MeshletWireframePSO;
+        SM::GraphicsPipelineState m_TessellationPSO;
+        SM::GraphicsPipelineState m_TessellationWireframePSO;
+        SM::GraphicsPipelineState m_ClipmapPSO;
+        SM::GraphicsPipelineState m_ClipmapWireframePSO;
+        SM::GraphicsPipelineState m_FarFieldPSO;
+        SM::GraphicsPipelineState m_FarFieldWireframePSO;
+        SM::GraphicsPipelineState m_ShadowPSO;       ///< Depth only, no pixel shader
+        SM::GraphicsPipelineState m_DepthPrepassPSO; ///< Depth only into the main depth buffer
+
+        // Indirect drawing
+        std::vector<std::unique_ptr<SM::IndexBuffer>> m_LODIndexBuffers; ///< Indexed by mesh LOD
+        Microsoft::WRL::ComPtr<ID3D12CommandSignature> m_CommandSignature;
+        std::vector<std::vector<const Chunk*>> m_LODBatches;             ///< Reused per-frame buckets
+
+        // Geomorphing: every (LOD, stitch mask) variant over the full-resolution grid in one buffer
+        std::unique_ptr<SM::IndexBuffer> m_StitchedIndexBuffer;
+        std::vector<uint32_t> m_StitchedIndexCounts;                     ///< Indices per variant, by LOD
+        std::vector<uint32_t> m_StitchedIndexStarts;                     ///< First index of mask 0, by LOD
+        std::vector<const Chunk*> m_GeomorphBatch;                       ///< Reused per-frame bucket
+        std::vector<const Chunk*> m_ParallelBatch;                       ///< Drawable chunks split across lists
+
+        // GPU-driven culling (null if its pipelines could not be created)
+        std::unique_ptr<TerrainGPUCulling> m_GPUCulling;
+
+        // Geometry clipmap (created when first enabled)
+        std::unique_ptr<TerrainClipmap> m_Clipmap;
+
+        // Far-field horizon ring (created when first enabled)
+        std::unique_ptr<TerrainFarField> m_FarField;
+
+        // Cascaded shadow maps (created when first enabled)
+        std::unique_ptr<TerrainShadowMaps> m_ShadowMaps;
+        TerrainShadowMaps::DrawDynamicFunc m_DynamicShadowCasters;
+        SM::DescriptorHandle m_NullShadowSRVs;      ///< Bound in place of the maps while shadows are off
+        D3D12_GPU_VIRTUAL_ADDRESS m_ShadowCBAddress = 0;    ///< This frame's ShadowCascadeData
+        D3D12_GPU_DESCRIPTOR_HANDLE m_ShadowSRVTable = {};  ///< This frame's maps, or m_NullShadowSRVs
+
+        // Variable rate shading (null without tier 2 support)
+        std::unique_ptr<TerrainShadingRate> m_ShadingRate;
+        bool m_ShadingRateActive = false;   ///< Image built for this frame's terrain pass and bound
+
+        // Depth pre-pass
+        DepthPrepassFunc m_DepthPrepassCasters;
+        std::vector<const Chunk*> m_PrepassBatch;                        ///< Reused per-frame bucket
+
+        // Frame data (constants live in the renderer's per-frame ring)
         TerrainPerFrameData m_FrameData;
+        D3D12_GPU_VIRTUAL_ADDRESS m_FrameCBAddress = 0;
+        void* m_FrameCBMapped = nullptr;    ///< Ring copy of m_FrameData, for late latching
 
         // Statistics
         uint32_t m_RenderedChunkCount = 0;
         uint32_t m_RenderedTriangleCount = 0;
+        uint32_t m_DrawCallCount = 0;
 
-        // Light direction (could be made configurable)
+        // Sun direction (SetLightDirection)
         DirectX::XMFLOAT3 m_LightDirection = { 0.5f, -0.8f, 0.3f };
     };
 
@@ -0,0 +1,231 @@
+#include "renderer/TerrainShadingRate.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace PCG
+{
+    namespace
+    {
+        /// Must match [numthreads] in TerrainShadingRate.hlsl
+        constexpr uint32_t GROUP_SIZE = 8;
+
+        // Root parameter slots
+        constexpr uint32_t ROOT_CONSTANTS = 0;
+        constexpr uint32_t ROOT_HIZ = 1;
+        constexpr uint32_t ROOT_IMAGE = 2;
+
+        D3D12_RESOURCE_BARRIER Transition(ID3D12Resource* resource,
+                                          D3D12_RESOURCE_STATES before, D3D12_RESOURCE_STATES after)
+        {
+            D3D12_RESOURCE_BARRIER barrier = {};
+            barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+            barrier.Transition.pResource = resource;
+            barrier.Transition.StateBefore = before;
+            barrier.Transition.StateAfter = after;
+            barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+            return barrier;
+        }
+    }
+
+    TerrainShadingRate::~TerrainShadingRate()
+    {
+        Shutdown();
+    }
+
+    // ============================================================================
+    // Initialization
+    // ============================================================================
+
+    bool TerrainShadingRate::Initialize(SM::DX12Core* core)
+    {
+        if (m_Initialized)
+        {
+            return true;
+        }
+
+        if (!core || !core->IsShadingRateImageSupported())
+        {
+            return false;
+        }
+
+        m_Core = core;
+
+        // Hi-Z texel (x, y) of mip k covers 2^(k + 1) pixels per side; tiles are 8, 16 or 32
+        m_TileSize = m_Core->GetShadingRateImageTileSize();
+        m_HiZMip = 0;
+        while ((2u << m_HiZMip) < m_TileSize)
+        {
+            m_HiZMip++;
+        }
+
+        m_CoarsestRate = m_Core->AreAdditionalShadingRatesSupported() ? D3D12_SHADING_RATE_4X4 : D3D12_SHADING_RATE_2X2;
+
+        if (!SM::CompileShaderFromFile(L"shaders/TerrainShadingRate.hlsl", "BuildShadingRateCS", "cs_5_1", m_BuildShader))
+        {
+            std::cerr << "[TerrainShadingRate] Failed to compile shading rate shader!" << std::endl;
+            return false;
+        }
+
+        // Root signature:
+        // 0: CBV - Build constants (b0)
+        // 1: Table - Hi-Z SRV (t0)
+        // 2: Table - Shading rate image UAV (u0)
+        SM::DescriptorRange hiZRange;
+        hiZRange.Type = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
+        hiZRange.NumDescriptors = 1;
+        hiZRange.BaseShaderRegister = 0;
+
+        SM::DescriptorRange imageRange;
+        imageRange.Type = D3D12_DESCRIPTOR_RANGE_TYPE_UAV;
+        imageRange.NumDescriptors = 1;
+        imageRange.BaseShaderRegister = 0;
+
+        bool built = m_RootSignature
+            .Begin(SM::RootSignatureFlags::None)
+            .AddCBV(0)
+            .AddDescriptorTable({ hiZRange })
+            .AddDescriptorTable({ imageRange })
+            .Build(m_Core);
+
+        if (!built)
+        {
+            std::cerr << "[TerrainShadingRate] Failed to create root signature!" << std::endl;
+            return false;
+        }
+
+        if (!m_BuildPSO.Begin().SetRootSignature(m_RootSignature).SetComputeShader(m_BuildShader).Build(m_Core))
+        {
+            std::cerr << "[TerrainShadingRate] Failed to create pipeline state!" << std::endl;
+            return false;
+        }
+
+        m_Initialized = true;
+
+        std::cout << "[TerrainShadingRate] Initialized (" << m_TileSize << "px tiles, coarsest "
+                  << (m_CoarsestRate == D3D12_SHADING_RATE_4X4 ? "4x4" : "2x2") << ")" << std::endl;
+        return true;
+    }
+
+    void TerrainShadingRate::Shutdown()
+    {
+        if (!m_Initialized)
+        {
+            return;
+        }
+
+        m_Image = SM::Texture();
+        m_BufferWidth = 0;
+        m_BufferHeight = 0;
+        m_State = D3D12_RESOURCE_STATE_COMMON;
+
+        m_Initialized = false;
+        m_Core = nullptr;
+    }
+
+    // ============================================================================
+    // Per-Frame
+    // ============================================================================
+
+    bool TerrainShadingRate::Build(ID3D12GraphicsCommandList* cmdList, SM::FrameConstantAllocator& frameConstants,
+                                   const SM::HiZPyramid& hiZ, const TerrainShadingRateParams& params)
+    {
+        if (!m_Initialized || !cmdList || !hiZ.IsValid() || hiZ.GetMipCount() <= m_HiZMip)
+        {
+            return false;
+        }
+
+        if (!EnsureImage(m_Core->GetWidth(), m_Core->GetHeight()))
+        {
+            return false;
+        }
+
+        TerrainShadingRateConstants constants = {};
+        DirectX::XMMATRIX invViewProjection = DirectX::XMMatrixInverse(nullptr, hiZ.GetViewProjection());
+        DirectX::XMStoreFloat4x4(&constants.InvViewProjection, DirectX::XMMatrixTranspose(invViewProjection));
+        constants.CameraPosition = params.CameraPosition;
+        constants.FarDistance = params.FarDistance;
+        constants.FogStart = params.FogStart;
+        constants.FogEnd = params.FogEnd;
+        constants.FogThreshold = params.FogThreshold;
+        constants.HeavyFogThreshold = params.HeavyFogThreshold;
+        constants.DepthWidth = hiZ.GetDepthWidth();
+        constants.DepthHeight = hiZ.GetDepthHeight();
+        constants.ImageWidth = m_Image.GetWidth();
+        constants.ImageHeight = m_Image.GetHeight();
+        constants.TileSize = m_TileSize;
+        constants.HiZMip = m_HiZMip;
+        constants.CoarsestRate = static_cast<uint32_t>(m_CoarsestRate);
+
+        D3D12_GPU_VIRTUAL_ADDRESS constantsCB = frameConstants.Push(constants);
+        if (constantsCB == 0)
+        {
+            return false;
+        }
+
+        ID3D12Resource* image = m_Image.GetResource();
+        if (m_State != D3D12_RESOURCE_STATE_UNORDERED_ACCESS)
+        {
+            D3D12_RESOURCE_BARRIER barrier = Transition(image, m_State, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+            cmdList->ResourceBarrier(1, &barrier);
+        }
+
+        ID3D12DescriptorHeap* heaps[] = { m_Core->GetCBVSRVUAVHeap().GetHeap() };
+        cmdList->SetDescriptorHeaps(1, heaps);
+        cmdList->SetComputeRootSignature(m_RootSignature.GetNative());
+        cmdList->SetPipelineState(m_BuildPSO.GetNative());
+        cmdList->SetComputeRootConstantBufferView(ROOT_CONSTANTS, constantsCB);
+        cmdList->SetComputeRootDescriptorTable(ROOT_HIZ, hiZ.GetSRV().GPU);
+        cmdList->SetComputeRootDescriptorTable(ROOT_IMAGE, m_Image.GetUAV().GPU);
+
+        cmdList->Dispatch(
+            (constants.ImageWidth + GROUP_SIZE - 1) / GROUP_SIZE,
+            (constants.ImageHeight + GROUP_SIZE - 1) / GROUP_SIZE,
+            1);
+
+        D3D12_RESOURCE_BARRIER barrier = Transition(image,
+            D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_SHADING_RATE_SOURCE);
+        cmdList->ResourceBarrier(1, &barrier);
+        m_State = D3D12_RESOURCE_STATE_SHADING_RATE_SOURCE;
+
+        return true;
+    }
+
+    // ============================================================================
+    // Private Methods
+    // ============================================================================
+
+    bool TerrainShadingRate::EnsureImage(uint32_t depthWidth, uint32_t depthHeight)
+    {
+        if (m_Image.IsValid() && m_BufferWidth == depthWidth && m_BufferHeight == depthHeight)
+        {
+            return true;
+        }
+
+        // Frames in flight may still read the old image; this follows a resize,
+        // which has already drained the queue, so the wait is short
+        if (m_Image.IsValid())
+        {
+            m_Core->WaitForGPU();
+        }
+
+        SM::TextureDesc desc;
+        desc.Width = (depthWidth + m_TileSize - 1) / m_TileSize;
+        desc.Height = (depthHeight + m_TileSize - 1) / m_TileSize;
+        desc.Format = DXGI_FORMAT_R8_UINT;
+        desc.Usage = SM::TextureUsage::UnorderedAccess;
+
+        m_Image = SM::Texture();
+        if (!m_Image.Create(m_Core, desc, "TerrainShadingRateImage"))
+        {
+            std::cerr << "[TerrainShadingRate] Failed to create shading rate image!" << std::endl;
+            return false;
+        }
+
+        m_BufferWidth = depthWidth;
+        m_BufferHeight = depthHeight;
+        m_State = D3D12_RESOURCE_STATE_COMMON;
+        return true;
+    }
+
+} // namespace PCG
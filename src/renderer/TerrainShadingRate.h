@@ -0,0 +1,151 @@
+#pragma once
+
+/**
+ * @file TerrainShadingRate.h
+ * @brief Tier 2 variable rate shading image for the terrain pass
+ *
+ * A compute pass (shaders/TerrainShadingRate.hlsl) turns the renderer's
+ * Hi-Z pyramid (SM::HiZPyramid) into an R8_UINT image holding one shading
+ * rate per hardware tile. Tiles deep in fog or past a far distance shade
+ * coarsely, so the terrain pixel shader runs once per 2x2 or 4x4 pixels
+ * where the fog hides the detail anyway.
+ */
+
+#include "renderer/DX12Core.h"
+#include "renderer/RootSignature.h"
+#include "renderer/PipelineState.h"
+#include "renderer/GPUBuffer.h"
+#include "renderer/HiZPyramid.h"
+#include "renderer/Texture.h"
+
+#include <DirectXMath.h>
+
+namespace PCG
+{
+    /**
+     * @brief Build constants (ShadingRateConstants in TerrainShadingRate.hlsl, b0)
+     */
+    struct TerrainShadingRateConstants
+    {
+        DirectX::XMFLOAT4X4 InvViewProjection;     ///< Transposed for HLSL
+        DirectX::XMFLOAT3 CameraPosition;
+        float FarDistance;
+        float FogStart;
+        float FogEnd;
+        float FogThreshold;
+        float HeavyFogThreshold;
+        uint32_t DepthWidth;
+        uint32_t DepthHeight;
+        uint32_t ImageWidth;
+        uint32_t ImageHeight;
+        uint32_t TileSize;
+        uint32_t HiZMip;
+        uint32_t CoarsestRate;
+        uint32_t Padding;
+    };
+
+    static_assert(sizeof(TerrainShadingRateConstants) == 128,
+                  "TerrainShadingRateConstants must match ShadingRateConstants in TerrainShadingRate.hlsl");
+
+    /**
+     * @brief Inputs for one shading rate image build
+     */
+    struct TerrainShadingRateParams
+    {
+        DirectX::XMFLOAT3 CameraPosition = { 0.0f, 0.0f, 0.0f };
+        float FogStart = 0.0f;              ///< Fog range of the terrain shaders
+        float FogEnd = 1.0f;
+        float FogThreshold = 0.5f;          ///< Fog factor from which tiles shade at 2x2
+        float HeavyFogThreshold = 0.85f;    ///< Fog factor from which tiles shade at the coarsest rate
+        float FarDistance = 600.0f;         ///< Distance from which tiles shade at 2x2
+    };
+
+    /**
+     * @brief Shading rate image built from depth and fog
+     *
+     * Built once per frame before the terrain draws, from whatever the Hi-Z
+     * pyramid last held: this frame's depth pre-pass when one ran, otherwise
+     * last frame's depth, in which case rates trail fast camera motion by a
+     * frame. Tiles only ever coarsen where the nearest depth under them is
+     * far or fogged, so a stale image costs quality at silhouettes only.
+     */
+    class TerrainShadingRate
+    {
+    public:
+        TerrainShadingRate() = default;
+        ~TerrainShadingRate();
+
+        // Prevent copying
+        TerrainShadingRate(const TerrainShadingRate&) = delete;
+        TerrainShadingRate& operator=(const TerrainShadingRate&) = delete;
+
+        // ====================================================================
+        // Initialization
+        // ====================================================================
+
+        /**
+         * @brief Compile the shader and create the pipeline
+         * @param core DX12 core for device access
+         * @return false if the device lacks tier 2 variable rate shading or creation failed
+         */
+        bool Initialize(SM::DX12Core* core);
+
+        /**
+         * @brief Release all resources
+         */
+        void Shutdown();
+
+        bool IsInitialized() const { return m_Initialized; }
+
+        // ====================================================================
+        // Per-Frame
+        // ====================================================================
+
+        /**
+         * @brief Record the image build and leave it in SHADING_RATE_SOURCE
+         * @param cmdList Recording command list
+         * @param frameConstants Per-frame ring for the build constants
+         * @param hiZ Depth source; nothing is built while it is not valid
+         * @param params Camera, fog and thresholds
+         * @return true if the image holds this frame's rates and may be bound
+         *
+         * (Re)creates the image when the depth buffer was resized. Changes the
+         * pipeline state and compute root signature.
+         */
+        bool Build(ID3D12GraphicsCommandList* cmdList, SM::FrameConstantAllocator& frameConstants,
+                   const SM::HiZPyramid& hiZ, const TerrainShadingRateParams& params);
+
+        /**
+         * @brief Get the image for RSSetShadingRateImage (null until the first build)
+         */
+        ID3D12Resource* GetImage() const { return m_Image.GetResource(); }
+
+        /// Rate used for the most distant, most fogged tiles and coarse chunks
+        D3D12_SHADING_RATE GetCoarsestRate() const { return m_CoarsestRate; }
+
+    private:
+        /**
+         * @brief (Re)create the image for a depth buffer size
+         */
+        bool EnsureImage(uint32_t depthWidth, uint32_t depthHeight);
+
+    private:
+        bool m_Initialized = false;
+        SM::DX12Core* m_Core = nullptr;
+
+        // Pipeline
+        SM::ShaderBytecode m_BuildShader;
+        SM::RootSignature m_RootSignature;
+        SM::ComputePipelineState m_BuildPSO;
+
+        // Image (one texel per tile of the depth buffer)
+        SM::Texture m_Image;
+        uint32_t m_TileSize = 0;
+        uint32_t m_HiZMip = 0;
+        uint32_t m_BufferWidth = 0;                 ///< Depth buffer size the image was sized for
+        uint32_t m_BufferHeight = 0;
+        D3D12_SHADING_RATE m_CoarsestRate = D3D12_SHADING_RATE_2X2;
+        D3D12_RESOURCE_STATES m_State = D3D12_RESOURCE_STATE_COMMON;
+    };
+
+} // namespace PCG
@@ -0,0 +1,644 @@
+#include "renderer/TerrainShadowMaps.h"
+#include "pcg/ChunkManager.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <iostream>
+
+namespace PCG
+{
+    namespace
+    {
+        /// Blend between logarithmic (1) and uniform (0) cascade splits
+        constexpr float SPLIT_LAMBDA = 0.75f;
+
+        /// Extra box size around a cascade's frustum slice; the camera can move this far before a redraw
+        constexpr float CASCADE_MARGIN = 0.25f;
+
+        /// Slice radii are rounded up to this, so turning the camera never resizes a cascade
+        constexpr float RADIUS_QUANTUM = 0.25f;
+
+        /// Receiver offset along the normal, in shadow texels
+        constexpr float NORMAL_OFFSET_TEXELS = 1.5f;
+
+        D3D12_RESOURCE_BARRIER Transition(ID3D12Resource* resource,
+                                          D3D12_RESOURCE_STATES before, D3D12_RESOURCE_STATES after)
+        {
+            D3D12_RESOURCE_BARRIER barrier = {};
+            barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+            barrier.Transition.pResource = resource;
+            barrier.Transition.StateBefore = before;
+            barrier.Transition.StateAfter = after;
+            barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+            return barrier;
+        }
+
+        bool IsEmpty(const D3D12_RECT& rect)
+        {
+            return rect.left >= rect.right || rect.top >= rect.bottom;
+        }
+
+        bool Overlaps(const D3D12_RECT& a, const D3D12_RECT& b)
+        {
+            return a.left < b.right && b.left < a.right && a.top < b.bottom && b.top < a.bottom;
+        }
+
+        D3D12_RECT Union(const D3D12_RECT& a, const D3D12_RECT& b)
+        {
+            return { std::min(a.left, b.left), std::min(a.top, b.top),
+                     std::max(a.right, b.right), std::max(a.bottom, b.bottom) };
+        }
+    }
+
+    TerrainShadowMaps::~TerrainShadowMaps()
+    {
+        Shutdown();
+    }
+
+    // ============================================================================
+    // Initialization
+    // ============================================================================
+
+    bool TerrainShadowMaps::Initialize(SM::DX12Core* core, uint32_t cascadeCount, uint32_t resolution)
+    {
+        Shutdown();
+
+        if (!core || resolution == 0)
+        {
+            std::cerr << "[TerrainShadowMaps] Invalid shadow map parameters" << std::endl;
+            return false;
+        }
+
+        m_Core = core;
+        m_CascadeCount = std::clamp(cascadeCount, 1u, MAX_CASCADES);
+        m_Resolution = resolution;
+
+        // Typeless so the same slices are depth targets and R32_FLOAT shader resources
+        D3D12_RESOURCE_DESC desc = {};
+        desc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+        desc.Width = m_Resolution;
+        desc.Height = m_Resolution;
+        desc.DepthOrArraySize = static_cast<UINT16>(m_CascadeCount);
+        desc.MipLevels = 1;
+        desc.Format = DXGI_FORMAT_R32_TYPELESS;
+        desc.SampleDesc.Count = 1;
+        desc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
+        desc.Flags = D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
+
+        D3D12_HEAP_PROPERTIES heapProps = {};
+        heapProps.Type = D3D12_HEAP_TYPE_DEFAULT;
+
+        D3D12_CLEAR_VALUE clearValue = {};
+        clearValue.Format = DEPTH_FORMAT;
+        clearValue.DepthStencil.Depth = 1.0f;
+
+        for (Microsoft::WRL::ComPtr<ID3D12Resource>* maps : { &m_StaticMaps, &m_DynamicMaps })
+        {
+            HRESULT hr = m_Core->GetDevice()->CreateCommittedResource(
+                &heapProps, D3D12_HEAP_FLAG_NONE, &desc, D3D12_RESOURCE_STATE_DEPTH_WRITE,
+                &clearValue, IID_PPV_ARGS(maps->GetAddressOf()));
+            if (FAILED(hr))
+            {
+                std::cerr << "[TerrainShadowMaps] Failed to create shadow map array!" << std::endl;
+                Shutdown();
+                return false;
+            }
+        }
+
+        m_StaticMaps->SetName(L"TerrainShadowStatic");
+        m_DynamicMaps->SetName(L"TerrainShadowDynamic");
+        m_StaticState = D3D12_RESOURCE_STATE_DEPTH_WRITE;
+        m_DynamicState = D3D12_RESOURCE_STATE_DEPTH_WRITE;
+
+        m_DSVs = m_Core->GetDSVHeap().AllocateRange(m_CascadeCount * 2);
+        m_SRVs = m_Core->GetCBVSRVUAVHeap().AllocateRange(2);
+        if (!m_DSVs.IsValid() || !m_SRVs.IsValid())
+        {
+            std::cerr << "[TerrainShadowMaps] Out of descriptors for the shadow maps!" << std::endl;
+            Shutdown();
+            return false;
+        }
+
+        CreateViews();
+
+        for (Cascade& cascade : m_Cascades)
+        {
+            cascade = Cascade();
+        }
+        m_HasLight = false;
+        m_Casters.clear();
+        m_Frame = 0;
+
+        // Neither array has been cleared yet
+        m_DynamicMask = (1u << m_CascadeCount) - 1;
+
+        m_Constants = {};
+        m_Stats = ShadowMapStats();
+        m_Stats.Cascades = m_CascadeCount;
+        m_Stats.GPUBytes = 2ull * m_CascadeCount * m_Resolution * m_Resolution * sizeof(float);
+
+        m_Initialized = true;
+        return true;
+    }
+
+    void TerrainShadowMaps::Shutdown()
+    {
+        // Frames in flight may still sample the maps
+        if (m_Core)
+        {
+            if (m_StaticMaps)
+            {
+                m_Core->DeferRelease(m_StaticMaps);
+            }
+            if (m_DynamicMaps)
+            {
+                m_Core->DeferRelease(m_DynamicMaps);
+            }
+
+            m_Core->GetDSVHeap().Free(m_DSVs);
+            m_Core->GetCBVSRVUAVHeap().Free(m_SRVs);
+        }
+
+        m_StaticMaps.Reset();
+        m_DynamicMaps.Reset();
+        m_DSVs = SM::DescriptorHandle();
+        m_SRVs = SM::DescriptorHandle();
+
+        m_Casters.clear();
+        m_DirtyBounds.clear();
+        m_Passes.clear();
+        m_PassChunks.clear();
+        m_Constants = {};
+        m_Initialized = false;
+    }
+
+    void TerrainShadowMaps::CreateViews()
+    {
+        ID3D12Device* device = m_Core->GetDevice();
+
+        for (uint32_t i = 0; i < m_CascadeCount * 2; ++i)
+        {
+            D3D12_DEPTH_STENCIL_VIEW_DESC dsvDesc = {};
+            dsvDesc.Format = DEPTH_FORMAT;
+            dsvDesc.ViewDimension = D3D12_DSV_DIMENSION_TEXTURE2DARRAY;
+            dsvDesc.Texture2DArray.FirstArraySlice = i % m_CascadeCount;
+            dsvDesc.Texture2DArray.ArraySize = 1;
+
+            ID3D12Resource* maps = i < m_CascadeCount ? m_StaticMaps.Get() : m_DynamicMaps.Get();
+            device->CreateDepthStencilView(maps, &dsvDesc, m_Core->GetDSVHeap().GetHandle(m_DSVs.HeapIndex + i).CPU);
+        }
+
+        for (uint32_t i = 0; i < 2; ++i)
+        {
+            D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+            srvDesc.Format = DXGI_FORMAT_R32_FLOAT;
+            srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2DARRAY;
+            srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+            srvDesc.Texture2DArray.MipLevels = 1;
+            srvDesc.Texture2DArray.ArraySize = m_CascadeCount;
+
+            ID3D12Resource* maps = i == 0 ? m_StaticMaps.Get() : m_DynamicMaps.Get();
+            device->CreateShaderResourceView(maps, &srvDesc,
+                m_Core->GetCBVSRVUAVHeap().GetHandle(m_SRVs.HeapIndex + i).CPU);
+        }
+    }
+
+    // ============================================================================
+    // Update
+    // ============================================================================
+
+    void TerrainShadowMaps::ComputeSplitDepths(float nearDepth, float farDepth, uint32_t cascadeCount, float* splits)
+    {
+        nearDepth = std::max(nearDepth, 0.01f);
+        farDepth = std::max(farDepth, nearDepth);
+
+        for (uint32_t i = 1; i <= cascadeCount; ++i)
+        {
+            const float fraction = static_cast<float>(i) / static_cast<float>(cascadeCount);
+            const float logSplit = nearDepth * std::pow(farDepth / nearDepth, fraction);
+            const float uniformSplit = nearDepth + (farDepth - nearDepth) * fraction;
+            splits[i - 1] = SPLIT_LAMBDA * logSplit + (1.0f - SPLIT_LAMBDA) * uniformSplit;
+        }
+    }
+
+    void TerrainShadowMaps::Invalidate()
+    {
+        for (Cascade& cascade : m_Cascades)
+        {
+            cascade.Valid = false;
+        }
+    }
+
+    void TerrainShadowMaps::Update(const ChunkManager& chunks, const DirectX::XMMATRIX& viewProjection,
+                                   const DirectX::XMFLOAT3& cameraPosition, const DirectX::XMFLOAT3& lightDirection,
+                                   float distance, float lightThresholdDegrees)
+    {
+        using namespace DirectX;
+
+        if (!m_Initialized)
+        {
+            return;
+        }
+
+        m_Passes.clear();
+        m_PassChunks.clear();
+        m_DirtyBounds.clear();
+        m_Stats.FullRedraws = 0;
+        m_Stats.DirtyRegions = 0;
+        ++m_Frame;
+
+        // The cache is kept until the light turns past the threshold
+        XMVECTOR light = XMVector3Normalize(XMLoadFloat3(&lightDirection));
+        const float threshold = std::cos(XMConvertToRadians(lightThresholdDegrees));
+        const bool lightChanged = !m_HasLight ||
+            XMVectorGetX(XMVector3Dot(light, XMLoadFloat3(&m_LightDirection))) < threshold;
+
+        if (lightChanged)
+        {
+            if (m_HasLight)
+            {
+                m_Stats.LightRebuilds++;
+            }
+
+            XMStoreFloat3(&m_LightDirection, light);
+            m_HasLight = true;
+
+            XMVECTOR up = std::fabs(m_LightDirection.y) > 0.99f ? XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f)
+                                                                : XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+            XMStoreFloat4x4(&m_LightView, XMMatrixLookToLH(XMVectorZero(), light, up));
+            Invalidate();
+        }
+
+        UpdateCasters(chunks, lightChanged);
+
+        // Camera frustum corners, and view depth along the frustum's axis
+        static const float CORNERS[4][2] = { { -1.0f, -1.0f }, { 1.0f, -1.0f }, { -1.0f, 1.0f }, { 1.0f, 1.0f } };
+
+        XMMATRIX inverse = XMMatrixInverse(nullptr, viewProjection);
+        XMVECTOR nearCorners[4];
+        XMVECTOR farCorners[4];
+        XMVECTOR nearCenter = XMVectorZero();
+        XMVECTOR farCenter = XMVectorZero();
+        for (int i = 0; i < 4; ++i)
+        {
+            nearCorners[i] = XMVector3TransformCoord(XMVectorSet(CORNERS[i][0], CORNERS[i][1], 0.0f, 1.0f), inverse);
+            farCorners[i] = XMVector3TransformCoord(XMVectorSet(CORNERS[i][0], CORNERS[i][1], 1.0f, 1.0f), inverse);
+            nearCenter = XMVectorAdd(nearCenter, XMVectorScale(nearCorners[i], 0.25f));
+            farCenter = XMVectorAdd(farCenter, XMVectorScale(farCorners[i], 0.25f));
+        }
+
+        XMVECTOR eye = XMLoadFloat3(&cameraPosition);
+        XMVECTOR forward = XMVector3Normalize(XMVectorSubtract(farCenter, nearCenter));
+        const float nearDepth = XMVectorGetX(XMVector3Dot(XMVectorSubtract(nearCenter, eye), forward));
+        const float farDepth = XMVectorGetX(XMVector3Dot(XMVectorSubtract(farCenter, eye), forward));
+        if (farDepth <= nearDepth)
+        {
+            return;
+        }
+
+        float splits[MAX_CASCADES] = {};
+        ComputeSplitDepths(nearDepth, std::min(distance, farDepth), m_CascadeCount, splits);
+
+        XMMATRIX lightView = XMLoadFloat4x4(&m_LightView);
+        float sliceStart = nearDepth;
+
+        for (uint32_t c = 0; c < m_CascadeCount; ++c)
+        {
+            Cascade& cascade = m_Cascades[c];
+
+            // Bounding sphere of this cascade's slice of the frustum
+            const float t0 = (sliceStart - nearDepth) / (farDepth - nearDepth);
+            const float t1 = (splits[c] - nearDepth) / (farDepth - nearDepth);
+            XMVECTOR corners[8];
+            XMVECTOR center = XMVectorZero();
+            for (int i = 0; i < 4; ++i)
+            {
+                corners[i] = XMVectorLerp(nearCorners[i], farCorners[i], t0);
+                corners[i + 4] = XMVectorLerp(nearCorners[i], farCorners[i], t1);
+                center = XMVectorAdd(center, XMVectorAdd(corners[i], corners[i + 4]));
+            }
+            center = XMVectorScale(center, 0.125f);
+
+            float radius = 0.0f;
+            for (const XMVECTOR& corner : corners)
+            {
+                radius = std::max(radius, XMVectorGetX(XMVector3Length(XMVectorSubtract(corner, center))));
+            }
+            radius = std::ceil(radius / RADIUS_QUANTUM) * RADIUS_QUANTUM;
+            const float halfSize = radius * (1.0f + CASCADE_MARGIN);
+
+            // Keep the box (and its cached depth) while the slice still fits inside it
+            XMFLOAT3 lightCenter;
+            XMStoreFloat3(&lightCenter, XMVector3Transform(center, lightView));
+
+            const bool fits = cascade.Valid && cascade.HalfSize == halfSize &&
+                std::max(std::fabs(lightCenter.x - cascade.CenterX), std::fabs(lightCenter.y - cascade.CenterY)) + radius <= halfSize &&
+                std::fabs(lightCenter.z - cascade.CenterZ) + radius <= halfSize;
+
+            if (!fits)
+            {
+                // Snapped to whole texels so static depth does not shimmer between redraws
+                const float texel = 2.0f * halfSize / static_cast<float>(m_Resolution);
+                cascade.CenterX = std::floor(lightCenter.x / texel + 0.5f) * texel;
+                cascade.CenterY = std::floor(lightCenter.y / texel + 0.5f) * texel;
+                cascade.CenterZ = lightCenter.z;
+                cascade.HalfSize = halfSize;
+                cascade.Valid = false;
+
+                // Casters nearer than the box are clamped onto its near plane (depth clip is off)
+                XMMATRIX projection = XMMatrixOrthographicOffCenterLH(
+                    cascade.CenterX - halfSize, cascade.CenterX + halfSize,
+                    cascade.CenterY - halfSize, cascade.CenterY + halfSize,
+                    cascade.CenterZ - halfSize, cascade.CenterZ + halfSize);
+                XMStoreFloat4x4(&cascade.ViewProjection, XMMatrixMultiply(lightView, projection));
+            }
+
+            cascade.SplitDepth = splits[c];
+            sliceStart = splits[c];
+        }
+
+        // Static work: whole cascades whose box moved, else the changed footprints
+        std::vector<D3D12_RECT> rects;
+        for (uint32_t c = 0; c < m_CascadeCount; ++c)
+        {
+            Cascade& cascade = m_Cascades[c];
+            const LONG size = static_cast<LONG>(m_Resolution);
+
+            if (!cascade.Valid)
+            {
+                AddPass(c, { 0, 0, size, size });
+                cascade.Valid = true;
+                m_Stats.FullRedraws++;
+                continue;
+            }
+
+            rects.clear();
+            for (const XMFLOAT4& bounds : m_DirtyBounds)
+            {
+                D3D12_RECT rect = ToTexels(cascade, bounds);
+                if (IsEmpty(rect))
+                {
+                    continue;
+                }
+
+                // Grow an overlapping rectangle rather than drawing the same casters twice
+                auto overlapping = std::find_if(rects.begin(), rects.end(),
+                    [&rect](const D3D12_RECT& other) { return Overlaps(rect, other); });
+                if (overlapping != rects.end())
+                {
+                    *overlapping = Union(*overlapping, rect);
+                }
+                else
+                {
+                    rects.push_back(rect);
+                }
+            }
+
+            if (rects.size() > MAX_DIRTY_REGIONS)
+            {
+                D3D12_RECT merged = rects[0];
+                for (const D3D12_RECT& rect : rects)
+                {
+                    merged = Union(merged, rect);
+                }
+                rects.assign(1, merged);
+            }
+
+            for (const D3D12_RECT& rect : rects)
+            {
+                AddPass(c, rect);
+                m_Stats.DirtyRegions++;
+            }
+        }
+
+        // Lookup constants
+        float* splitDepths = &m_Constants.SplitDepths.x;
+        float* normalOffsets = &m_Constants.NormalOffsets.x;
+        for (uint32_t c = 0; c < MAX_CASCADES; ++c)
+        {
+            const Cascade& cascade = m_Cascades[std::min(c, m_CascadeCount - 1)];
+            XMStoreFloat4x4(&m_Constants.ViewProjection[c], XMMatrixTranspose(XMLoadFloat4x4(&cascade.ViewProjection)));
+            splitDepths[c] = cascade.SplitDepth;
+            normalOffsets[c] = NORMAL_OFFSET_TEXELS * 2.0f * cascade.HalfSize / static_cast<float>(m_Resolution);
+        }
+        XMStoreFloat3(&m_Constants.CameraForward, forward);
+        m_Constants.CascadeCount = m_CascadeCount;
+        m_Constants.TexelSize = 1.0f / static_cast<float>(m_Resolution);
+    }
+
+    void TerrainShadowMaps::UpdateCasters(const ChunkManager& chunks, bool lightChanged)
+    {
+        for (const auto& [coord, chunk] : chunks.GetLoadedChunks())
+        {
+            if (!chunk || !chunk->HasMesh())
+            {
+                continue;
+            }
+
+            auto [it, inserted] = m_Casters.try_emplace(coord);
+            Caster& caster = it->second;
+
+            const uint64_t revision = chunk->GetMeshRevision();
+            if (inserted || caster.Revision != revision)
+            {
+                // Both the old and the new surface may have cast into the cache
+                if (!inserted)
+                {
+                    m_DirtyBounds.push_back(caster.LightBounds);
+                }
+
+                caster.LightBounds = GetLightBounds(*chunk);
+                caster.Revision = revision;
+                m_DirtyBounds.push_back(caster.LightBounds);
+            }
+            else if (lightChanged)
+            {
+                caster.LightBounds = GetLightBounds(*chunk);
+            }
+
+            caster.Source = chunk.get();
+            caster.Frame = m_Frame;
+        }
+
+        // Unloaded (or mesh-less) chunks leave their footprint behind
+        for (auto it = m_Casters.begin(); it != m_Casters.end();)
+        {
+            if (it->second.Frame != m_Frame)
+            {
+                m_DirtyBounds.push_back(it->second.LightBounds);
+                it = m_Casters.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        m_Stats.Casters = static_cast<uint32_t>(m_Casters.size());
+    }
+
+    DirectX::XMFLOAT4 TerrainShadowMaps::GetLightBounds(const Chunk& chunk) const
+    {
+        using namespace DirectX;
+
+        const SM::BoundingBox box = ChunkManager::GetChunkBounds(chunk);
+        XMMATRIX lightView = XMLoadFloat4x4(&m_LightView);
+
+        XMFLOAT4 bounds = { FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX };
+        for (int i = 0; i < 8; ++i)
+        {
+            XMVECTOR corner = XMVectorSet(
+                (i & 1) ? box.Max.x : box.Min.x,
+                (i & 2) ? box.Max.y : box.Min.y,
+                (i & 4) ? box.Max.z : box.Min.z,
+                1.0f);
+
+            XMFLOAT3 light;
+            XMStoreFloat3(&light, XMVector3Transform(corner, lightView));
+            bounds.x = std::min(bounds.x, light.x);
+            bounds.y = std::min(bounds.y, light.y);
+            bounds.z = std::max(bounds.z, light.x);
+            bounds.w = std::max(bounds.w, light.y);
+        }
+
+        return bounds;
+    }
+
+    D3D12_RECT TerrainShadowMaps::ToTexels(const Cascade& cascade, const DirectX::XMFLOAT4& bounds) const
+    {
+        // Texel rows run top-down while light-space Y runs up; one texel of
+        // padding covers rasterization at the footprint's edge
+        const float size = static_cast<float>(m_Resolution);
+        const float scale = size / (2.0f * cascade.HalfSize);
+        const float left = cascade.CenterX - cascade.HalfSize;
+        const float top = cascade.CenterY + cascade.HalfSize;
+
+        auto toTexel = [size](float value) {
+            return static_cast<LONG>(std::clamp(value, 0.0f, size));
+        };
+
+        D3D12_RECT rect;
+        rect.left = toTexel(std::floor((bounds.x - left) * scale) - 1.0f);
+        rect.right = toTexel(std::ceil((bounds.z - left) * scale) + 1.0f);
+        rect.top = toTexel(std::floor((top - bounds.w) * scale) - 1.0f);
+        rect.bottom = toTexel(std::ceil((top - bounds.y) * scale) + 1.0f);
+
+        if (IsEmpty(rect))
+        {
+            return { 0, 0, 0, 0 };
+        }
+        return rect;
+    }
+
+    void TerrainShadowMaps::AddPass(uint32_t cascadeIndex, const D3D12_RECT& rect)
+    {
+        Pass pass;
+        pass.Cascade = cascadeIndex;
+        pass.Rect = rect;
+        pass.FirstChunk = static_cast<uint32_t>(m_PassChunks.size());
+
+        const Cascade& cascade = m_Cascades[cascadeIndex];
+        for (const auto& [coord, caster] : m_Casters)
+        {
+            if (Overlaps(ToTexels(cascade, caster.LightBounds), rect))
+            {
+                m_PassChunks.push_back(caster.Source);
+            }
+        }
+
+        // Passes without casters still clear what an unloaded chunk left behind
+        pass.ChunkCount = static_cast<uint32_t>(m_PassChunks.size()) - pass.FirstChunk;
+        m_Passes.push_back(pass);
+    }
+
+    // ============================================================================
+    // Recording
+    // ============================================================================
+
+    void TerrainShadowMaps::TransitionMaps(ID3D12GraphicsCommandList* cmdList, ID3D12Resource* resource,
+                                           D3D12_RESOURCE_STATES& state, D3D12_RESOURCE_STATES after)
+    {
+        if (state != after)
+        {
+            D3D12_RESOURCE_BARRIER barrier = Transition(resource, state, after);
+            cmdList->ResourceBarrier(1, &barrier);
+            state = after;
+        }
+    }
+
+    uint32_t TerrainShadowMaps::Record(ID3D12GraphicsCommandList* cmdList, const DrawChunksFunc& drawChunks,
+                                       const DrawDynamicFunc& drawDynamic)
+    {
+        if (!m_Initialized || !cmdList)
+        {
+            return 0;
+        }
+
+        SM::DescriptorHeap& dsvHeap = m_Core->GetDSVHeap();
+        const LONG size = static_cast<LONG>(m_Resolution);
+        const D3D12_VIEWPORT viewport = { 0.0f, 0.0f, static_cast<float>(m_Resolution), static_cast<float>(m_Resolution), 0.0f, 1.0f };
+        const D3D12_RECT fullRect = { 0, 0, size, size };
+
+        // Static cache: clear and redraw only the queued rectangles
+        uint32_t draws = 0;
+        if (!m_Passes.empty())
+        {
+            TransitionMaps(cmdList, m_StaticMaps.Get(), m_StaticState, D3D12_RESOURCE_STATE_DEPTH_WRITE);
+            cmdList->RSSetViewports(1, &viewport);
+
+            for (const Pass& pass : m_Passes)
+            {
+                D3D12_CPU_DESCRIPTOR_HANDLE dsv = dsvHeap.GetHandle(m_DSVs.HeapIndex + pass.Cascade).CPU;
+                cmdList->OMSetRenderTargets(0, nullptr, FALSE, &dsv);
+                cmdList->RSSetScissorRects(1, &pass.Rect);
+                cmdList->ClearDepthStencilView(dsv, D3D12_CLEAR_FLAG_DEPTH, 1.0f, 0, 1, &pass.Rect);
+
+                if (pass.ChunkCount > 0 && drawChunks)
+                {
+                    draws += drawChunks(cmdList, DirectX::XMLoadFloat4x4(&m_Cascades[pass.Cascade].ViewProjection),
+                        std::span<const Chunk* const>(m_PassChunks.data() + pass.FirstChunk, pass.ChunkCount));
+                }
+            }
+
+            m_Passes.clear();
+        }
+
+        // Dynamic slices: cleared only if they hold last frame's casters
+        uint32_t dynamicMask = 0;
+        m_Stats.DynamicCasters = 0;
+        if (drawDynamic || m_DynamicMask != 0)
+        {
+            TransitionMaps(cmdList, m_DynamicMaps.Get(), m_DynamicState, D3D12_RESOURCE_STATE_DEPTH_WRITE);
+            cmdList->RSSetViewports(1, &viewport);
+
+            for (uint32_t c = 0; c < m_CascadeCount; ++c)
+            {
+                D3D12_CPU_DESCRIPTOR_HANDLE dsv = dsvHeap.GetHandle(m_DSVs.HeapIndex + m_CascadeCount + c).CPU;
+                cmdList->OMSetRenderTargets(0, nullptr, FALSE, &dsv);
+                cmdList->RSSetScissorRects(1, &fullRect);
+
+                if (m_DynamicMask & (1u << c))
+                {
+                    cmdList->ClearDepthStencilView(dsv, D3D12_CLEAR_FLAG_DEPTH, 1.0f, 0, 0, nullptr);
+                }
+
+                const uint32_t casters = drawDynamic ? drawDynamic(DirectX::XMLoadFloat4x4(&m_Cascades[c].ViewProjection)) : 0;
+                if (casters > 0)
+                {
+                    dynamicMask |= 1u << c;
+                    m_Stats.DynamicCasters += casters;
+                }
+            }
+        }
+
+        m_DynamicMask = dynamicMask;
+        m_Constants.DynamicCascadeMask = dynamicMask;
+        m_Stats.StaticDraws = draws;
+
+        TransitionMaps(cmdList, m_StaticMaps.Get(), m_StaticState, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+        TransitionMaps(cmdList, m_DynamicMaps.Get(), m_DynamicState, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+        return draws;
+    }
+
+} // namespace PCG
@@ -0,0 +1,273 @@
+#pragma once
+
+/**
+ * @file TerrainShadowMaps.h
+ * @brief Cascaded sun shadow maps with cached static terrain depth
+ *
+ * Each cascade keeps two depth slices. The static slice holds terrain
+ * depth and survives across frames: a cascade's light-space box only moves
+ * when the camera's part of the view frustum leaves it, and then the
+ * whole slice is re-rendered. Otherwise only the footprints of chunks that
+ * streamed in, unloaded or rebuilt their mesh (Chunk::GetMeshRevision) are
+ * cleared and redrawn under a scissor. Moving the light past a threshold
+ * rebuilds every cascade. The dynamic slice is cleared and redrawn each
+ * frame by a caller-supplied callback (ECS meshes), and only for cascades
+ * that had or get casters. TerrainPixel.hlsl takes the nearer depth of the
+ * two slices, so dynamic casters are composited over the cache at lookup.
+ */
+
+#include "renderer/DX12Core.h"
+#include "pcg/Chunk.h"
+
+#include <DirectXMath.h>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace PCG
+{
+    class ChunkManager;
+
+    /**
+     * @brief Cascade constants for shadow lookups (ShadowCascades in TerrainPixel.hlsl, b4)
+     */
+    struct ShadowCascadeData
+    {
+        DirectX::XMFLOAT4X4 ViewProjection[4];  ///< World to shadow map, per cascade (transposed)
+        DirectX::XMFLOAT4 SplitDepths;          ///< View depth where each cascade ends
+        DirectX::XMFLOAT4 NormalOffsets;        ///< Receiver offset along the normal, per cascade
+        DirectX::XMFLOAT3 CameraForward;        ///< View direction the split depths are measured along
+        uint32_t CascadeCount;                  ///< 0 disables shadowing
+        float TexelSize;                        ///< 1 / map resolution
+        uint32_t DynamicCascadeMask;            ///< Cascades whose dynamic slice holds casters
+        float Padding[2];
+    };
+
+    static_assert(sizeof(ShadowCascadeData) % 16 == 0, "ShadowCascadeData must match ShadowCascades in TerrainPixel.hlsl");
+
+    /**
+     * @brief Shadow map statistics (per-frame counts are from the last Update/Record)
+     */
+    struct ShadowMapStats
+    {
+        uint32_t Cascades = 0;
+        uint32_t Casters = 0;               ///< Chunks tracked in the static cache
+        uint32_t FullRedraws = 0;           ///< Cascades re-rendered from scratch last frame
+        uint32_t DirtyRegions = 0;          ///< Scissored partial re-renders last frame
+        uint32_t StaticDraws = 0;           ///< Chunk draws into the static slices last frame
+        uint32_t DynamicCasters = 0;        ///< Dynamic casters drawn last frame (all cascades)
+        uint32_t LightRebuilds = 0;         ///< Full rebuilds caused by light movement since Initialize
+        size_t GPUBytes = 0;
+    };
+
+    /**
+     * @brief Cached cascaded shadow maps for the terrain sun light
+     *
+     * Per frame: Update() fits the cascades to the camera and collects
+     * static re-render work, then Record() draws it and the dynamic casters
+     * and leaves both arrays readable by pixel shaders. Owned and driven by
+     * TerrainRenderer (see TerrainRenderConfig::EnableShadows).
+     */
+    class TerrainShadowMaps
+    {
+    public:
+        static constexpr uint32_t MAX_CASCADES = 4;
+        static constexpr DXGI_FORMAT DEPTH_FORMAT = DXGI_FORMAT_D32_FLOAT;
+
+        /// Partial re-renders per cascade and frame before they are merged into one
+        static constexpr uint32_t MAX_DIRTY_REGIONS = 8;
+
+        /**
+         * @brief Draws static terrain chunks into the bound depth slice
+         * @return Number of draws recorded
+         *
+         * The depth target, viewport and scissor are already set and must
+         * be kept; the pipeline, root signature and constants are the
+         * callback's own.
+         */
+        using DrawChunksFunc = std::function<uint32_t(ID3D12GraphicsCommandList* cmdList,
+                                                      const DirectX::XMMATRIX& lightViewProjection,
+                                                      std::span<const Chunk* const> chunks)>;
+
+        /**
+         * @brief Draws dynamic casters into the bound depth slice (same contract as DrawChunksFunc)
+         * @return Number of casters drawn; 0 lets the cascade skip its dynamic slice
+         */
+        using DrawDynamicFunc = std::function<uint32_t(const DirectX::XMMATRIX& lightViewProjection)>;
+
+        TerrainShadowMaps() = default;
+        ~TerrainShadowMaps();
+
+        // Prevent copying
+        TerrainShadowMaps(const TerrainShadowMaps&) = delete;
+        TerrainShadowMaps& operator=(const TerrainShadowMaps&) = delete;
+
+        /**
+         * @brief Create the depth arrays and their views
+         * @param core DX12 core reference
+         * @param cascadeCount Cascades (clamped to 1 - MAX_CASCADES)
+         * @param resolution Width and height of every slice
+         * @return true if successful
+         */
+        bool Initialize(SM::DX12Core* core, uint32_t cascadeCount, uint32_t resolution);
+
+        /**
+         * @brief Release the arrays and views (deferred until the GPU is done)
+         */
+        void Shutdown();
+
+        /**
+         * @brief Check if the shadow maps were created
+         */
+        bool IsInitialized() const { return m_Initialized; }
+
+        /**
+         * @brief Fit the cascades to the camera and collect static re-render work
+         * @param chunks Source of the static casters (every loaded chunk with a mesh)
+         * @param viewProjection Camera view-projection matrix
+         * @param cameraPosition Camera world position
+         * @param lightDirection Direction the light travels
+         * @param distance View depth the last cascade ends at (clamped to the far plane)
+         * @param lightThresholdDegrees Light rotation that invalidates the cache
+         */
+        void Update(const ChunkManager& chunks, const DirectX::XMMATRIX& viewProjection,
+                    const DirectX::XMFLOAT3& cameraPosition, const DirectX::XMFLOAT3& lightDirection,
+                    float distance, float lightThresholdDegrees);
+
+        /**
+         * @brief Drop the cached depth so every cascade is redrawn (e.g. after terrain settings change)
+         */
+        void Invalidate();
+
+        /**
+         * @brief Draw the collected static work and the dynamic casters
+         * @param cmdList List to record into; its render targets, viewport and scissor are replaced
+         * @param drawChunks Static terrain draw callback
+         * @param drawDynamic Dynamic caster callback (may be empty)
+         * @return Number of static draws recorded
+         */
+        uint32_t Record(ID3D12GraphicsCommandList* cmdList, const DrawChunksFunc& drawChunks,
+                        const DrawDynamicFunc& drawDynamic);
+
+        /**
+         * @brief Get this frame's cascade constants
+         */
+        const ShadowCascadeData& GetConstants() const { return m_Constants; }
+
+        /**
+         * @brief Get the SRV table: the static array (t2), then the dynamic array (t3)
+         */
+        D3D12_GPU_DESCRIPTOR_HANDLE GetSRVTable() const { return m_SRVs.GPU; }
+
+        uint32_t GetCascadeCount() const { return m_CascadeCount; }
+        uint32_t GetResolution() const { return m_Resolution; }
+        const ShadowMapStats& GetStats() const { return m_Stats; }
+
+        /**
+         * @brief Split a view depth range into cascades (blend of logarithmic and uniform splits)
+         * @param splits Receives the end depth of each cascade
+         */
+        static void ComputeSplitDepths(float nearDepth, float farDepth, uint32_t cascadeCount,
+                                       float* splits);
+
+    private:
+        /**
+         * @brief One cascade's light-space box
+         */
+        struct Cascade
+        {
+            float CenterX = 0.0f;           ///< Light-space centre, snapped to texels
+            float CenterY = 0.0f;
+            float CenterZ = 0.0f;
+            float HalfSize = 0.0f;          ///< Half the box side and depth
+            float SplitDepth = 0.0f;        ///< View depth the cascade ends at
+            bool Valid = false;             ///< Static slice matches the box
+            DirectX::XMFLOAT4X4 ViewProjection;
+        };
+
+        /**
+         * @brief A static caster drawn into the cache
+         */
+        struct Caster
+        {
+            const Chunk* Source = nullptr;  ///< Valid from Update to Record of the same frame
+            uint64_t Revision = 0;          ///< Chunk::GetMeshRevision when last drawn
+            DirectX::XMFLOAT4 LightBounds;  ///< Light-space X/Y footprint (min x, min y, max x, max y)
+            uint32_t Frame = 0;             ///< Last Update that saw the chunk
+        };
+
+        /**
+         * @brief A scissored static re-render of one cascade
+         */
+        struct Pass
+        {
+            uint32_t Cascade = 0;
+            D3D12_RECT Rect = {};
+            uint32_t FirstChunk = 0;        ///< Range in m_PassChunks
+            uint32_t ChunkCount = 0;
+        };
+
+        /**
+         * @brief Light-space X/Y footprint of a chunk's bounds under the cached light
+         */
+        DirectX::XMFLOAT4 GetLightBounds(const Chunk& chunk) const;
+
+        /**
+         * @brief Texel rectangle of a light-space footprint in a cascade (empty if outside)
+         */
+        D3D12_RECT ToTexels(const Cascade& cascade, const DirectX::XMFLOAT4& bounds) const;
+
+        /**
+         * @brief Track streamed, rebuilt and unloaded chunks, collecting their old and new footprints
+         */
+        void UpdateCasters(const ChunkManager& chunks, bool lightChanged);
+
+        /**
+         * @brief Queue a re-render of a cascade rectangle with every caster that overlaps it
+         */
+        void AddPass(uint32_t cascadeIndex, const D3D12_RECT& rect);
+
+        /**
+         * @brief Create the depth-stencil views and SRVs of both arrays
+         */
+        void CreateViews();
+
+        void TransitionMaps(ID3D12GraphicsCommandList* cmdList, ID3D12Resource* resource,
+                            D3D12_RESOURCE_STATES& state, D3D12_RESOURCE_STATES after);
+
+    private:
+        bool m_Initialized = false;
+        SM::DX12Core* m_Core = nullptr;
+
+        uint32_t m_CascadeCount = 0;
+        uint32_t m_Resolution = 0;
+        Cascade m_Cascades[MAX_CASCADES];
+
+        // Light orientation the cache was rendered with
+        bool m_HasLight = false;
+        DirectX::XMFLOAT3 m_LightDirection = { 0.0f, -1.0f, 0.0f };
+        DirectX::XMFLOAT4X4 m_LightView;
+
+        // Static casters and this frame's work
+        std::unordered_map<ChunkCoord, Caster, ChunkHash> m_Casters;
+        uint32_t m_Frame = 0;
+        std::vector<DirectX::XMFLOAT4> m_DirtyBounds;   ///< Light-space footprints that changed
+        std::vector<Pass> m_Passes;
+        std::vector<const Chunk*> m_PassChunks;
+
+        // Depth arrays, one slice per cascade
+        Microsoft::WRL::ComPtr<ID3D12Resource> m_StaticMaps;
+        Microsoft::WRL::ComPtr<ID3D12Resource> m_DynamicMaps;
+        D3D12_RESOURCE_STATES m_StaticState = D3D12_RESOURCE_STATE_DEPTH_WRITE;
+        D3D12_RESOURCE_STATES m_DynamicState = D3D12_RESOURCE_STATE_DEPTH_WRITE;
+        SM::DescriptorHandle m_DSVs;                    ///< Static slices, then dynamic slices
+        SM::DescriptorHandle m_SRVs;                    ///< Static array, then dynamic array
+        uint32_t m_DynamicMask = 0;                     ///< Dynamic slices that are not cleared
+
+        ShadowCascadeData m_Constants = {};
+        ShadowMapStats m_Stats;
+    };
+
+} // namespace PCG
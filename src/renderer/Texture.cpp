@@ -1,10 +1,71 @@
 #include "renderer/Texture.h"
+#include "renderer/TextureLoader.h"
+#include "renderer/MipGenerator.h"
 
 #include <iostream>
 #include <cassert>
 
 namespace SM
 {
+    Texture::~Texture()
+    {
+        ReleaseViews();
+    }
+
+    Texture::Texture(Texture&& other) noexcept
+        : m_Core(other.m_Core)
+        , m_Resource(std::move(other.m_Resource))
+        , m_Desc(other.m_Desc)
+        , m_SRVHandle(other.m_SRVHandle)
+        , m_RTVHandle(other.m_RTVHandle)
+        , m_DSVHandle(other.m_DSVHandle)
+        , m_UAVHandle(other.m_UAVHandle)
+    {
+        other.m_SRVHandle = DescriptorHandle();
+        other.m_RTVHandle = DescriptorHandle();
+        other.m_DSVHandle = DescriptorHandle();
+        other.m_UAVHandle = DescriptorHandle();
+    }
+
+    Texture& Texture::operator=(Texture&& other) noexcept
+    {
+        if (this != &other)
+        {
+            ReleaseViews();
+
+            m_Core = other.m_Core;
+            m_Resource = std::move(other.m_Resource);
+            m_Desc = other.m_Desc;
+            m_SRVHandle = other.m_SRVHandle;
+            m_RTVHandle = other.m_RTVHandle;
+            m_DSVHandle = other.m_DSVHandle;
+            m_UAVHandle = other.m_UAVHandle;
+
+            other.m_SRVHandle = DescriptorHandle();
+            other.m_RTVHandle = DescriptorHandle();
+            other.m_DSVHandle = DescriptorHandle();
+            other.m_UAVHandle = DescriptorHandle();
+        }
+
+        return *this;
+    }
+
+    void Texture::ReleaseViews()
+    {
+        if (m_Core)
+        {
+            m_Core->GetCBVSRVUAVHeap().Free(m_SRVHandle);
+            m_Core->GetRTVHeap().Free(m_RTVHandle);
+            m_Core->GetDSVHeap().Free(m_DSVHandle);
+            m_Core->GetCBVSRVUAVHeap().Free(m_UAVHandle);
+        }
+
+        m_SRVHandle = DescriptorHandle();
+        m_RTVHandle = DescriptorHandle();
+        m_DSVHandle = DescriptorHandle();
+        m_UAVHandle = DescriptorHandle();
+    }
+
     bool Texture::Create(DX12Core* core, const TextureDesc& desc, const char* debugName)
     {
         assert(core != nullptr && "DX12Core cannot be null!");
@@ -97,15 +158,55 @@ namespace SM
 
     bool Texture::LoadFromFile(DX12Core* core, const std::string& filename, bool generateMips)
     {
-        (void)core;
-        (void)filename;
-        (void)generateMips;
-
-        // TODO: Implement texture loading from file
-        // This would use WIC or stb_image to load the texture data
-        // and upload it to the GPU
-        std::cerr << "[DX12] Texture::LoadFromFile not yet implemented!" << std::endl;
-        return false;
+        assert(core != nullptr && "DX12Core cannot be null!");
+
+        TextureImage image;
+        if (!LoadTextureImage(filename, image))
+        {
+            return false;
+        }
+
+        // Files without a baked chain get theirs built on the GPU
+        const bool buildMips = generateMips && image.MipLevels == 1 && MipGenerator::SupportsFormat(image.Format) &&
+                               (image.Width > 1 || image.Height > 1);
+
+        TextureDesc desc;
+        desc.Width = image.Width;
+        desc.Height = image.Height;
+        desc.Format = image.Format;
+        desc.MipLevels = buildMips ? MipGenerator::GetMipCount(image.Width, image.Height) : image.MipLevels;
+        desc.Usage = buildMips ? (TextureUsage::ShaderResource | TextureUsage::UnorderedAccess)
+                               : TextureUsage::ShaderResource;
+
+        if (!Create(core, desc, filename.c_str()))
+        {
+            return false;
+        }
+
+        UploadQueue& uploads = core->GetUploadQueue();
+        uint64_t uploadFence = uploads.UploadTexture(m_Resource.Get(), 0, image.MipLevels, image.Mips.data());
+        if (uploadFence == 0)
+        {
+            std::cerr << "[DX12] Failed to upload texture: " << filename << std::endl;
+            m_Resource.Reset();
+            return false;
+        }
+
+        if (buildMips)
+        {
+            MipGenerator& mipGenerator = core->GetMipGenerator();
+            if (!mipGenerator.IsInitialized() || !mipGenerator.Generate(*this, uploadFence))
+            {
+                std::cerr << "[DX12] Failed to generate mips for texture: " << filename << std::endl;
+                m_Resource.Reset();
+                return false;
+            }
+            return true;
+        }
+
+        // Frames submitted from now on wait for the copy on the GPU
+        uploads.WaitOnQueue(core->GetDirectQueue(), uploadFence);
+        return true;
     }
 
     bool Texture::CreateRenderTarget(
@@ -172,7 +273,11 @@ namespace SM
         // Create SRV if shader resource
         if ((static_cast<uint32_t>(m_Desc.Usage) & static_cast<uint32_t>(TextureUsage::ShaderResource)) != 0)
         {
-            m_SRVHandle = m_Core->GetCBVSRVUAVHeap().Allocate();
+            // Views are rewritten in place on recreation so the bindless index persists
+            if (!m_SRVHandle.IsValid())
+            {
+                m_SRVHandle = m_Core->GetCBVSRVUAVHeap().Allocate();
+            }
 
             D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
             srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
@@ -247,7 +352,10 @@ namespace SM
         // Create RTV if render target
         if ((static_cast<uint32_t>(m_Desc.Usage) & static_cast<uint32_t>(TextureUsage::RenderTarget)) != 0)
         {
-            m_RTVHandle = m_Core->GetRTVHeap().Allocate();
+            if (!m_RTVHandle.IsValid())
+            {
+                m_RTVHandle = m_Core->GetRTVHeap().Allocate();
+            }
 
             D3D12_RENDER_TARGET_VIEW_DESC rtvDesc = {};
             rtvDesc.Format = m_Desc.Format;
@@ -268,7 +376,10 @@ namespace SM
         // Create DSV if depth stencil
         if ((static_cast<uint32_t>(m_Desc.Usage) & static_cast<uint32_t>(TextureUsage::DepthStencil)) != 0)
         {
-            m_DSVHandle = m_Core->GetDSVHeap().Allocate();
+            if (!m_DSVHandle.IsValid())
+            {
+                m_DSVHandle = m_Core->GetDSVHeap().Allocate();
+            }
 
             D3D12_DEPTH_STENCIL_VIEW_DESC dsvDesc = {};
             dsvDesc.Format = m_Desc.Format;
@@ -290,7 +401,10 @@ namespace SM
         // Create UAV if unordered access
         if ((static_cast<uint32_t>(m_Desc.Usage) & static_cast<uint32_t>(TextureUsage::UnorderedAccess)) != 0)
         {
-            m_UAVHandle = m_Core->GetCBVSRVUAVHeap().Allocate();
+            if (!m_UAVHandle.IsValid())
+            {
+                m_UAVHandle = m_Core->GetCBVSRVUAVHeap().Allocate();
+            }
 
             D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
             uavDesc.Format = m_Desc.Format;
@@ -4,8 +4,8 @@
  * @file Texture.h
  * @brief Texture resource interface for DirectX 12
  *
- * Provides texture loading, creation, and management.
- * This is a basic interface for future expansion.
+ * Provides texture loading, creation, and management. Large textures
+ * that should not be fully resident use TextureStreamer instead.
  */
 
 #include "renderer/DX12Core.h"
@@ -80,15 +80,15 @@ namespace SM
     {
     public:
         Texture() = default;
-        ~Texture() = default;
+        ~Texture();
 
         // Prevent copying
         Texture(const Texture&) = delete;
         Texture& operator=(const Texture&) = delete;
 
-        // Allow moving
-        Texture(Texture&&) noexcept = default;
-        Texture& operator=(Texture&&) noexcept = default;
+        // Allow moving (the views move with the resource)
+        Texture(Texture&& other) noexcept;
+        Texture& operator=(Texture&& other) noexcept;
 
         /**
          * @brief Create texture from descriptor
@@ -100,11 +100,14 @@ namespace SM
         bool Create(DX12Core* core, const TextureDesc& desc, const char* debugName = nullptr);
 
         /**
-         * @brief Create texture from file (future implementation)
+         * @brief Create texture from file
          * @param core DX12 core reference
-         * @param filename Path to texture file
-         * @param generateMips Generate mip maps
+         * @param filename DDS file, or any image format WIC decodes
+         * @param generateMips Build the mip chain on the GPU if the file has none
          * @return true if successful
+         *
+         * DDS files keep their baked mips and block compression. The upload
+         * runs on the copy queue; the direct queue waits for it on the GPU.
          */
         bool LoadFromFile(DX12Core* core, const std::string& filename, bool generateMips = true);
 
@@ -159,6 +162,17 @@ namespace SM
          */
         const DescriptorHandle& GetSRV() const { return m_SRVHandle; }
 
+        /**
+         * @brief Get the SRV's index into the bindless texture array
+         * @return Heap index, or INVALID_BINDLESS_INDEX without ShaderResource usage
+         *
+         * Stays the same across Resize, so materials may keep it.
+         */
+        uint32_t GetBindlessIndex() const
+        {
+            return m_SRVHandle.IsValid() ? m_SRVHandle.HeapIndex : INVALID_BINDLESS_INDEX;
+        }
+
         /**
          * @brief Get RTV handle (if render target)
          */
@@ -221,6 +235,11 @@ namespace SM
          */
         void CreateViews();
 
+        /**
+         * @brief Return the view descriptors to their heaps (deferred past frames in flight)
+         */
+        void ReleaseViews();
+
         /**
          * @brief Get D3D12 resource flags from texture usage
          */
@@ -0,0 +1,404 @@
+#include "renderer/TextureLoader.h"
+#include "renderer/Texture.h"
+#include "core/FileSystem.h"
+
+#include <wincodec.h>
+#include <wrl/client.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <iostream>
+
+namespace SM
+{
+    namespace
+    {
+        // ========================================================================
+        // DDS File Layout
+        // ========================================================================
+
+        constexpr uint32_t MakeFourCC(char a, char b, char c, char d)
+        {
+            return static_cast<uint32_t>(static_cast<uint8_t>(a)) |
+                   (static_cast<uint32_t>(static_cast<uint8_t>(b)) << 8) |
+                   (static_cast<uint32_t>(static_cast<uint8_t>(c)) << 16) |
+                   (static_cast<uint32_t>(static_cast<uint8_t>(d)) << 24);
+        }
+
+        constexpr uint32_t DDS_MAGIC = MakeFourCC('D', 'D', 'S', ' ');
+
+        constexpr uint32_t DDSD_MIPMAPCOUNT = 0x20000;
+        constexpr uint32_t DDPF_ALPHAPIXELS = 0x1;
+        constexpr uint32_t DDPF_FOURCC = 0x4;
+        constexpr uint32_t DDPF_RGB = 0x40;
+        constexpr uint32_t DDPF_LUMINANCE = 0x20000;
+        constexpr uint32_t DDSCAPS2_CUBEMAP = 0x200;
+        constexpr uint32_t DDSCAPS2_VOLUME = 0x200000;
+
+        constexpr uint32_t DX10_DIMENSION_TEXTURE2D = 3;
+        constexpr uint32_t DX10_MISC_TEXTURECUBE = 0x4;
+
+        struct DDSPixelFormat
+        {
+            uint32_t Size;
+            uint32_t Flags;
+            uint32_t FourCC;
+            uint32_t RGBBitCount;
+            uint32_t RBitMask;
+            uint32_t GBitMask;
+            uint32_t BBitMask;
+            uint32_t ABitMask;
+        };
+
+        struct DDSHeader
+        {
+            uint32_t Size;
+            uint32_t Flags;
+            uint32_t Height;
+            uint32_t Width;
+            uint32_t PitchOrLinearSize;
+            uint32_t Depth;
+            uint32_t MipMapCount;
+            uint32_t Reserved1[11];
+            DDSPixelFormat PixelFormat;
+            uint32_t Caps;
+            uint32_t Caps2;
+            uint32_t Caps3;
+            uint32_t Caps4;
+            uint32_t Reserved2;
+        };
+
+        struct DDSHeaderDX10
+        {
+            uint32_t Format;            // DXGI_FORMAT
+            uint32_t ResourceDimension;
+            uint32_t MiscFlag;
+            uint32_t ArraySize;
+            uint32_t MiscFlags2;
+        };
+
+        static_assert(sizeof(DDSHeader) == 124, "DDS header layout mismatch");
+        static_assert(sizeof(DDSHeaderDX10) == 20, "DDS DX10 header layout mismatch");
+
+        /**
+         * @brief Map a legacy (pre-DX10) pixel format to DXGI
+         */
+        DXGI_FORMAT GetLegacyFormat(const DDSPixelFormat& pf)
+        {
+            if (pf.Flags & DDPF_FOURCC)
+            {
+                switch (pf.FourCC)
+                {
+                    case MakeFourCC('D', 'X', 'T', '1'): return DXGI_FORMAT_BC1_UNORM;
+                    case MakeFourCC('D', 'X', 'T', '2'):
+                    case MakeFourCC('D', 'X', 'T', '3'): return DXGI_FORMAT_BC2_UNORM;
+                    case MakeFourCC('D', 'X', 'T', '4'):
+                    case MakeFourCC('D', 'X', 'T', '5'): return DXGI_FORMAT_BC3_UNORM;
+                    case MakeFourCC('A', 'T', 'I', '1'):
+                    case MakeFourCC('B', 'C', '4', 'U'): return DXGI_FORMAT_BC4_UNORM;
+                    case MakeFourCC('B', 'C', '4', 'S'): return DXGI_FORMAT_BC4_SNORM;
+                    case MakeFourCC('A', 'T', 'I', '2'):
+                    case MakeFourCC('B', 'C', '5', 'U'): return DXGI_FORMAT_BC5_UNORM;
+                    case MakeFourCC('B', 'C', '5', 'S'): return DXGI_FORMAT_BC5_SNORM;
+
+                    // D3DFORMAT values stored as FourCC
+                    case 36:  return DXGI_FORMAT_R16G16B16A16_UNORM;
+                    case 111: return DXGI_FORMAT_R16_FLOAT;
+                    case 112: return DXGI_FORMAT_R16G16_FLOAT;
+                    case 113: return DXGI_FORMAT_R16G16B16A16_FLOAT;
+                    case 114: return DXGI_FORMAT_R32_FLOAT;
+                    case 115: return DXGI_FORMAT_R32G32_FLOAT;
+                    case 116: return DXGI_FORMAT_R32G32B32A32_FLOAT;
+
+                    default: return DXGI_FORMAT_UNKNOWN;
+                }
+            }
+
+            if ((pf.Flags & DDPF_RGB) && pf.RGBBitCount == 32)
+            {
+                if (pf.RBitMask == 0x000000FF && pf.GBitMask == 0x0000FF00 && pf.BBitMask == 0x00FF0000)
+                {
+                    return DXGI_FORMAT_R8G8B8A8_UNORM;
+                }
+                if (pf.RBitMask == 0x00FF0000 && pf.GBitMask == 0x0000FF00 && pf.BBitMask == 0x000000FF)
+                {
+                    return (pf.Flags & DDPF_ALPHAPIXELS) ? DXGI_FORMAT_B8G8R8A8_UNORM : DXGI_FORMAT_B8G8R8X8_UNORM;
+                }
+            }
+
+            if ((pf.Flags & DDPF_LUMINANCE) && pf.RGBBitCount == 8)
+            {
+                return DXGI_FORMAT_R8_UNORM;
+            }
+
+            return DXGI_FORMAT_UNKNOWN;
+        }
+
+        uint32_t GetBlockBytes(DXGI_FORMAT format)
+        {
+            switch (format)
+            {
+                case DXGI_FORMAT_BC1_TYPELESS:
+                case DXGI_FORMAT_BC1_UNORM:
+                case DXGI_FORMAT_BC1_UNORM_SRGB:
+                case DXGI_FORMAT_BC4_TYPELESS:
+                case DXGI_FORMAT_BC4_UNORM:
+                case DXGI_FORMAT_BC4_SNORM:
+                    return 8;
+
+                default:
+                    return 16;
+            }
+        }
+
+        std::string ToLower(std::string text)
+        {
+            std::transform(text.begin(), text.end(), text.begin(),
+                [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            return text;
+        }
+    }
+
+    // ============================================================================
+    // Format Helpers
+    // ============================================================================
+
+    bool IsBlockCompressed(DXGI_FORMAT format)
+    {
+        return (format >= DXGI_FORMAT_BC1_TYPELESS && format <= DXGI_FORMAT_BC5_SNORM) ||
+               (format >= DXGI_FORMAT_BC6H_TYPELESS && format <= DXGI_FORMAT_BC7_UNORM_SRGB);
+    }
+
+    bool GetSurfaceLayout(DXGI_FORMAT format, uint32_t width, uint32_t height,
+                          size_t& outRowPitch, uint32_t& outRowCount)
+    {
+        if (IsBlockCompressed(format))
+        {
+            outRowPitch = static_cast<size_t>(std::max(1u, (width + 3) / 4)) * GetBlockBytes(format);
+            outRowCount = std::max(1u, (height + 3) / 4);
+            return true;
+        }
+
+        uint32_t bytesPerPixel = GetFormatBytesPerPixel(format);
+        if (bytesPerPixel == 0)
+        {
+            // Formats missing from the table but common in DDS files
+            if (format == DXGI_FORMAT_B8G8R8X8_UNORM)
+            {
+                bytesPerPixel = 4;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        outRowPitch = static_cast<size_t>(width) * bytesPerPixel;
+        outRowCount = height;
+        return true;
+    }
+
+    // ============================================================================
+    // DDS
+    // ============================================================================
+
+    bool ParseDDS(std::span<const uint8_t> bytes, TextureImage& outImage)
+    {
+        if (bytes.size() < sizeof(uint32_t) + sizeof(DDSHeader))
+        {
+            std::cerr << "[TextureLoader] DDS file too small" << std::endl;
+            return false;
+        }
+
+        uint32_t magic = 0;
+        std::memcpy(&magic, bytes.data(), sizeof(magic));
+
+        DDSHeader header = {};
+        std::memcpy(&header, bytes.data() + sizeof(magic), sizeof(header));
+
+        if (magic != DDS_MAGIC || header.Size != sizeof(DDSHeader) ||
+            header.PixelFormat.Size != sizeof(DDSPixelFormat))
+        {
+            std::cerr << "[TextureLoader] Not a DDS file" << std::endl;
+            return false;
+        }
+
+        size_t offset = sizeof(magic) + sizeof(header);
+        DXGI_FORMAT format = DXGI_FORMAT_UNKNOWN;
+
+        if ((header.PixelFormat.Flags & DDPF_FOURCC) && header.PixelFormat.FourCC == MakeFourCC('D', 'X', '1', '0'))
+        {
+            DDSHeaderDX10 dx10 = {};
+            if (bytes.size() < offset + sizeof(dx10))
+            {
+                std::cerr << "[TextureLoader] DDS DX10 header truncated" << std::endl;
+                return false;
+            }
+            std::memcpy(&dx10, bytes.data() + offset, sizeof(dx10));
+            offset += sizeof(dx10);
+
+            if (dx10.ResourceDimension != DX10_DIMENSION_TEXTURE2D || (dx10.MiscFlag & DX10_MISC_TEXTURECUBE) ||
+                dx10.ArraySize > 1)
+            {
+                std::cerr << "[TextureLoader] Only single 2D DDS textures are supported" << std::endl;
+                return false;
+            }
+            format = static_cast<DXGI_FORMAT>(dx10.Format);
+        }
+        else
+        {
+            if (header.Caps2 & (DDSCAPS2_CUBEMAP | DDSCAPS2_VOLUME))
+            {
+                std::cerr << "[TextureLoader] Only single 2D DDS textures are supported" << std::endl;
+                return false;
+            }
+            format = GetLegacyFormat(header.PixelFormat);
+        }
+
+        if (format == DXGI_FORMAT_UNKNOWN || header.Width == 0 || header.Height == 0)
+        {
+            std::cerr << "[TextureLoader] Unsupported DDS pixel format" << std::endl;
+            return false;
+        }
+
+        uint32_t mipLevels = (header.Flags & DDSD_MIPMAPCOUNT) ? std::max(1u, header.MipMapCount) : 1u;
+
+        TextureImage image;
+        image.Width = header.Width;
+        image.Height = header.Height;
+        image.MipLevels = mipLevels;
+        image.Format = format;
+        image.Mips.reserve(mipLevels);
+
+        for (uint32_t mip = 0; mip < mipLevels; ++mip)
+        {
+            size_t rowPitch = 0;
+            uint32_t rowCount = 0;
+            if (!GetSurfaceLayout(format, std::max(1u, image.Width >> mip), std::max(1u, image.Height >> mip),
+                                  rowPitch, rowCount))
+            {
+                std::cerr << "[TextureLoader] Unsupported DDS pixel format" << std::endl;
+                return false;
+            }
+
+            size_t slicePitch = rowPitch * rowCount;
+            if (offset + slicePitch > bytes.size())
+            {
+                std::cerr << "[TextureLoader] DDS mip chain truncated" << std::endl;
+                return false;
+            }
+
+            D3D12_SUBRESOURCE_DATA data = {};
+            data.pData = bytes.data() + offset;
+            data.RowPitch = static_cast<LONG_PTR>(rowPitch);
+            data.SlicePitch = static_cast<LONG_PTR>(slicePitch);
+            image.Mips.push_back(data);
+
+            offset += slicePitch;
+        }
+
+        outImage = std::move(image);
+        return true;
+    }
+
+    // ============================================================================
+    // WIC
+    // ============================================================================
+
+    bool DecodeImage(std::span<const uint8_t> bytes, TextureImage& outImage)
+    {
+        using Microsoft::WRL::ComPtr;
+
+        // WIC needs COM on the calling thread; keep whatever model it already has
+        HRESULT comResult = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+        const bool uninitialize = SUCCEEDED(comResult);
+
+        bool decoded = false;
+        {
+            ComPtr<IWICImagingFactory> factory;
+            ComPtr<IWICStream> stream;
+            ComPtr<IWICBitmapDecoder> decoder;
+            ComPtr<IWICBitmapFrameDecode> frame;
+            ComPtr<IWICFormatConverter> converter;
+            UINT width = 0;
+            UINT height = 0;
+
+            HRESULT hr = CoCreateInstance(CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(&factory));
+            if (SUCCEEDED(hr)) hr = factory->CreateStream(&stream);
+            if (SUCCEEDED(hr)) hr = stream->InitializeFromMemory(const_cast<BYTE*>(bytes.data()), static_cast<DWORD>(bytes.size()));
+            if (SUCCEEDED(hr)) hr = factory->CreateDecoderFromStream(stream.Get(), nullptr, WICDecodeMetadataCacheOnDemand, &decoder);
+            if (SUCCEEDED(hr)) hr = decoder->GetFrame(0, &frame);
+            if (SUCCEEDED(hr)) hr = frame->GetSize(&width, &height);
+            if (SUCCEEDED(hr)) hr = factory->CreateFormatConverter(&converter);
+            if (SUCCEEDED(hr))
+            {
+                hr = converter->Initialize(frame.Get(), GUID_WICPixelFormat32bppRGBA, WICBitmapDitherTypeNone,
+                                           nullptr, 0.0, WICBitmapPaletteTypeCustom);
+            }
+
+            if (SUCCEEDED(hr) && width > 0 && height > 0)
+            {
+                TextureImage image;
+                image.Width = width;
+                image.Height = height;
+                image.MipLevels = 1;
+                image.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+                image.Storage.resize(static_cast<size_t>(width) * height * 4);
+
+                hr = converter->CopyPixels(nullptr, width * 4, static_cast<UINT>(image.Storage.size()),
+                                           image.Storage.data());
+                if (SUCCEEDED(hr))
+                {
+                    D3D12_SUBRESOURCE_DATA data = {};
+                    data.pData = image.Storage.data();
+                    data.RowPitch = static_cast<LONG_PTR>(width) * 4;
+                    data.SlicePitch = static_cast<LONG_PTR>(image.Storage.size());
+                    image.Mips.push_back(data);
+
+                    outImage = std::move(image);
+                    decoded = true;
+                }
+            }
+        }
+
+        if (uninitialize)
+        {
+            CoUninitialize();
+        }
+
+        if (!decoded)
+        {
+            std::cerr << "[TextureLoader] Failed to decode image" << std::endl;
+        }
+        return decoded;
+    }
+
+    bool LoadTextureImage(const std::string& path, TextureImage& outImage)
+    {
+        std::vector<uint8_t> bytes = FileSystem::ReadFile(path);
+        if (bytes.empty())
+        {
+            std::cerr << "[TextureLoader] Failed to read " << path << std::endl;
+            return false;
+        }
+
+        if (ToLower(FileSystem::GetExtension(path)) != ".dds")
+        {
+            return DecodeImage(bytes, outImage);
+        }
+
+        // Parse in place, then hand the file bytes to the image
+        TextureImage image;
+        if (!ParseDDS(bytes, image))
+        {
+            std::cerr << "[TextureLoader] Failed to load " << path << std::endl;
+            return false;
+        }
+        image.Storage = std::move(bytes);
+
+        outImage = std::move(image);
+        return true;
+    }
+
+} // namespace SM
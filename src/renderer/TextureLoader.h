@@ -0,0 +1,88 @@
+#pragma once
+
+/**
+ * @file TextureLoader.h
+ * @brief Texture file parsing (DDS) and image decoding (WIC)
+ *
+ * DDS files are the shipping format: block-compressed (BC1-BC7) or plain
+ * formats with the full mip chain baked offline, parsed in place without
+ * copying pixel data. Other image formats (png, jpg, bmp, tga via WIC
+ * codecs) decode to a single RGBA8 level; Texture::LoadFromFile builds
+ * their mips on the GPU.
+ */
+
+#include <d3d12.h>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace SM
+{
+    /**
+     * @brief A 2D image with its mip levels, ready for UploadQueue::UploadTexture
+     */
+    struct TextureImage
+    {
+        uint32_t Width = 0;
+        uint32_t Height = 0;
+        uint32_t MipLevels = 0;
+        DXGI_FORMAT Format = DXGI_FORMAT_UNKNOWN;
+
+        /// One entry per mip, level 0 first; point into Storage or the parsed buffer
+        std::vector<D3D12_SUBRESOURCE_DATA> Mips;
+
+        /// Bytes owned by the image (moving the image keeps Mips valid)
+        std::vector<uint8_t> Storage;
+
+        /**
+         * @brief Get the size of a mip level in bytes
+         */
+        size_t GetMipSize(uint32_t mip) const
+        {
+            return mip < Mips.size() ? static_cast<size_t>(Mips[mip].SlicePitch) : 0;
+        }
+    };
+
+    /**
+     * @brief Parse a DDS file held in memory
+     * @param bytes Whole file; must outlive the image, whose Mips point into it
+     * @param outImage Receives the header information and mip views
+     * @return false for malformed files and cube, volume or array textures
+     */
+    bool ParseDDS(std::span<const uint8_t> bytes, TextureImage& outImage);
+
+    /**
+     * @brief Decode an image file with WIC into one RGBA8 level
+     * @param bytes Encoded file contents
+     * @param outImage Receives the pixels in Storage
+     * @return false if no installed codec can decode the data
+     */
+    bool DecodeImage(std::span<const uint8_t> bytes, TextureImage& outImage);
+
+    /**
+     * @brief Read and parse or decode a texture file by extension
+     * @param path .dds, or any format WIC decodes
+     * @param outImage Receives an image that owns its data
+     * @return true if successful
+     */
+    bool LoadTextureImage(const std::string& path, TextureImage& outImage);
+
+    /**
+     * @brief Check if a format is block compressed (BC1-BC7)
+     */
+    bool IsBlockCompressed(DXGI_FORMAT format);
+
+    /**
+     * @brief Get the row pitch and row count of one mip level
+     * @param format Texel format (plain or block compressed)
+     * @param width Level width in texels
+     * @param height Level height in texels
+     * @param outRowPitch Bytes per row (per row of 4x4 blocks when compressed)
+     * @param outRowCount Rows (block rows when compressed)
+     * @return false if the format's size is unknown
+     */
+    bool GetSurfaceLayout(DXGI_FORMAT format, uint32_t width, uint32_t height,
+                          size_t& outRowPitch, uint32_t& outRowCount);
+
+} // namespace SM
@@ -0,0 +1,402 @@
+#include "renderer/TextureStreamer.h"
+#include "renderer/CommandList.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace SM
+{
+    TextureStreamer::~TextureStreamer()
+    {
+        Shutdown();
+    }
+
+    bool TextureStreamer::Initialize(DX12Core* core, const TextureStreamerConfig& config)
+    {
+        if (!core)
+        {
+            std::cerr << "[TextureStreamer] Cannot initialize: DX12Core is null" << std::endl;
+            return false;
+        }
+
+        m_Core = core;
+        m_Config = config;
+        m_Config.TailSize = std::max(1u, m_Config.TailSize);
+        m_FrameIndex = 0;
+        m_ResidentBytes = 0;
+        return true;
+    }
+
+    void TextureStreamer::Shutdown()
+    {
+        if (!m_Core)
+        {
+            return;
+        }
+
+        while (!m_Textures.empty())
+        {
+            Unregister(m_Textures.begin()->first);
+        }
+
+        m_Core = nullptr;
+    }
+
+    // ============================================================================
+    // Registration
+    // ============================================================================
+
+    StreamedTextureID TextureStreamer::Register(const std::string& path)
+    {
+        if (!m_Core)
+        {
+            return INVALID_STREAMED_TEXTURE;
+        }
+
+        StreamedTexture texture;
+        texture.Path = path;
+        texture.File = FileSystem::MapFile(path);
+        if (!texture.File.IsOpen() || !ParseDDS(texture.File.GetBytes(), texture.Image))
+        {
+            std::cerr << "[TextureStreamer] Cannot stream " << path << std::endl;
+            return INVALID_STREAMED_TEXTURE;
+        }
+
+        const TextureImage& image = texture.Image;
+        if (!IsValidTopMip(image, 0))
+        {
+            std::cerr << "[TextureStreamer] Block-compressed texture size is not a multiple of 4: " << path << std::endl;
+            return INVALID_STREAMED_TEXTURE;
+        }
+
+        // The tail starts at the first level no larger than TailSize
+        uint32_t tailMip = 0;
+        while (tailMip + 1 < image.MipLevels &&
+               std::max(image.Width >> tailMip, image.Height >> tailMip) > m_Config.TailSize)
+        {
+            ++tailMip;
+        }
+        while (tailMip > 0 && !IsValidTopMip(image, tailMip))
+        {
+            --tailMip;
+        }
+        texture.TailMip = tailMip;
+
+        DescriptorHeap& heap = m_Core->GetCBVSRVUAVHeap();
+        texture.Views[0] = heap.Allocate();
+        texture.Views[1] = heap.Allocate();
+
+        if (!BeginResidencyChange(texture, tailMip))
+        {
+            heap.Free(texture.Views[0]);
+            heap.Free(texture.Views[1]);
+            return INVALID_STREAMED_TEXTURE;
+        }
+
+        StreamedTextureID id = m_NextID++;
+        m_Textures.emplace(id, std::move(texture));
+        return id;
+    }
+
+    void TextureStreamer::Unregister(StreamedTextureID id)
+    {
+        auto it = m_Textures.find(id);
+        if (it == m_Textures.end())
+        {
+            return;
+        }
+
+        StreamedTexture& texture = it->second;
+
+        // Frames in flight may still sample the texture
+        if (texture.Resource)
+        {
+            m_Core->DeferRelease(texture.Resource);
+        }
+        if (texture.PendingResource)
+        {
+            m_Core->DeferRelease(texture.PendingResource);
+        }
+
+        DescriptorHeap& heap = m_Core->GetCBVSRVUAVHeap();
+        heap.Free(texture.Views[0]);
+        heap.Free(texture.Views[1]);
+
+        m_ResidentBytes -= texture.ResidentBytes;
+        m_Textures.erase(it);
+    }
+
+    // ============================================================================
+    // Feedback
+    // ============================================================================
+
+    void TextureStreamer::RequestScreenSize(StreamedTextureID id, float pixels)
+    {
+        auto it = m_Textures.find(id);
+        if (it == m_Textures.end() || !(pixels > 0.0f))
+        {
+            return;
+        }
+
+        StreamedTexture& texture = it->second;
+        const float texels = static_cast<float>(std::max(texture.Image.Width, texture.Image.Height));
+        const float level = std::log2(texels / pixels) + m_Config.MipBias;
+
+        uint32_t mip = level > 0.0f ? static_cast<uint32_t>(std::min(level, 31.0f)) : 0u;
+        mip = std::min(mip, texture.TailMip);
+        texture.RequestedMip = std::min(texture.RequestedMip, mip);
+    }
+
+    void TextureStreamer::RequestDistance(StreamedTextureID id, float distance, float worldSize,
+                                          float viewportHeight, float fovY)
+    {
+        // World size projected at this distance, in pixels
+        const float viewHeight = 2.0f * std::max(distance, 0.001f) * std::tan(fovY * 0.5f);
+        RequestScreenSize(id, worldSize / viewHeight * viewportHeight);
+    }
+
+    void TextureStreamer::Update(CommandList& cmdList)
+    {
+        if (!m_Core)
+        {
+            return;
+        }
+
+        ++m_FrameIndex;
+
+        UploadQueue& uploads = m_Core->GetUploadQueue();
+
+        // Pick residency changes: drops start right away, loads wait for the budget
+        std::vector<std::pair<uint32_t, StreamedTexture*>> loads;  // (missing levels, texture)
+        for (auto& [id, texture] : m_Textures)
+        {
+            const uint32_t wanted = std::min(texture.RequestedMip, texture.TailMip);
+            texture.RequestedMip = UINT32_MAX;
+
+            if (texture.PendingResource || !texture.Resource)
+            {
+                continue;
+            }
+
+            if (wanted <= texture.ResidentMip)
+            {
+                texture.LastNeededFrame = m_FrameIndex;
+            }
+
+            if (wanted < texture.ResidentMip)
+            {
+                loads.emplace_back(texture.ResidentMip - wanted, &texture);
+            }
+            else if (wanted > texture.ResidentMip &&
+                     m_FrameIndex - texture.LastNeededFrame >= m_Config.EvictDelayFrames)
+            {
+                uint32_t target = wanted;
+                while (target < texture.TailMip && !IsValidTopMip(texture.Image, target))
+                {
+                    ++target;
+                }
+                BeginResidencyChange(texture, target);
+            }
+        }
+
+        // Biggest shortfall first; one level per texture per frame keeps refinement progressive
+        std::sort(loads.begin(), loads.end(),
+            [](const auto& a, const auto& b) { return a.first > b.first; });
+
+        size_t budget = m_Config.UploadBudgetPerFrame;
+        bool uploaded = false;
+        for (auto& [missing, texture] : loads)
+        {
+            uint32_t target = texture->ResidentMip - 1;
+            while (target > 0 && !IsValidTopMip(texture->Image, target))
+            {
+                --target;
+            }
+
+            // A level larger than the whole budget still goes when it is first
+            const size_t bytes = GetLevelBytes(*texture, target, texture->ResidentMip);
+            if (bytes > budget && uploaded)
+            {
+                break;
+            }
+
+            if (BeginResidencyChange(*texture, target))
+            {
+                budget -= std::min(bytes, budget);
+                uploaded = true;
+            }
+        }
+
+        // Swap in textures whose levels have landed. A view slot is rewritten
+        // only once every frame that could read it has retired.
+        const uint64_t framesInFlight = m_Core->GetFramesInFlight();
+        for (auto& [id, texture] : m_Textures)
+        {
+            if (texture.PendingResource && uploads.IsComplete(texture.PendingFence) &&
+                (!texture.HasView || m_FrameIndex - texture.LastSwapFrame >= framesInFlight))
+            {
+                CompleteResidencyChange(cmdList, texture);
+            }
+        }
+    }
+
+    // ============================================================================
+    // Queries
+    // ============================================================================
+
+    uint32_t TextureStreamer::GetBindlessIndex(StreamedTextureID id) const
+    {
+        auto it = m_Textures.find(id);
+        if (it == m_Textures.end() || !it->second.HasView)
+        {
+            return INVALID_BINDLESS_INDEX;
+        }
+
+        return it->second.Views[it->second.ActiveView].HeapIndex;
+    }
+
+    uint32_t TextureStreamer::GetResidentMip(StreamedTextureID id) const
+    {
+        auto it = m_Textures.find(id);
+        return it != m_Textures.end() ? it->second.ResidentMip : UINT32_MAX;
+    }
+
+    // ============================================================================
+    // Private Methods
+    // ============================================================================
+
+    bool TextureStreamer::IsValidTopMip(const TextureImage& image, uint32_t mip)
+    {
+        if (!IsBlockCompressed(image.Format))
+        {
+            return true;
+        }
+
+        const uint32_t width = std::max(1u, image.Width >> mip);
+        const uint32_t height = std::max(1u, image.Height >> mip);
+        return (width % 4) == 0 && (height % 4) == 0;
+    }
+
+    bool TextureStreamer::BeginResidencyChange(StreamedTexture& texture, uint32_t targetMip)
+    {
+        const TextureImage& image = texture.Image;
+
+        D3D12_RESOURCE_DESC desc = {};
+        desc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+        desc.Width = std::max(1u, image.Width >> targetMip);
+        desc.Height = std::max(1u, image.Height >> targetMip);
+        desc.DepthOrArraySize = 1;
+        desc.MipLevels = static_cast<UINT16>(image.MipLevels - targetMip);
+        desc.Format = image.Format;
+        desc.SampleDesc.Count = 1;
+        desc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
+
+        D3D12_HEAP_PROPERTIES heapProps = {};
+        heapProps.Type = D3D12_HEAP_TYPE_DEFAULT;
+
+        ComPtr<ID3D12Resource> resource;
+        HRESULT hr = m_Core->GetDevice()->CreateCommittedResource(
+            &heapProps,
+            D3D12_HEAP_FLAG_NONE,
+            &desc,
+            D3D12_RESOURCE_STATE_COMMON,
+            nullptr,
+            IID_PPV_ARGS(&resource)
+        );
+
+        if (!CheckHResult(hr, "Failed to create streamed texture"))
+        {
+            return false;
+        }
+
+        // Levels the current texture lacks come from the file
+        const uint32_t uploadEnd = texture.Resource ? std::min(texture.ResidentMip, image.MipLevels) : image.MipLevels;
+        uint64_t fence = 0;
+        if (uploadEnd > targetMip)
+        {
+            fence = m_Core->GetUploadQueue().UploadTexture(resource.Get(), 0, uploadEnd - targetMip,
+                                                           &image.Mips[targetMip]);
+            if (fence == 0)
+            {
+                std::cerr << "[TextureStreamer] Failed to stage " << texture.Path << std::endl;
+                return false;
+            }
+        }
+
+        texture.PendingResource = resource;
+        texture.PendingMip = targetMip;
+        texture.PendingFence = fence;
+        return true;
+    }
+
+    void TextureStreamer::CompleteResidencyChange(CommandList& cmdList, StreamedTexture& texture)
+    {
+        const uint32_t mipLevels = texture.Image.MipLevels;
+        const uint32_t newMip = texture.PendingMip;
+        ID3D12Resource* destination = texture.PendingResource.Get();
+
+        if (texture.Resource)
+        {
+            ID3D12Resource* source = texture.Resource.Get();
+
+            cmdList.TransitionBarrier(source, D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_STATE_COPY_SOURCE);
+            cmdList.TransitionBarrier(destination, D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_STATE_COPY_DEST);
+
+            for (uint32_t mip = std::max(newMip, texture.ResidentMip); mip < mipLevels; ++mip)
+            {
+                D3D12_TEXTURE_COPY_LOCATION dst = {};
+                dst.pResource = destination;
+                dst.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+                dst.SubresourceIndex = mip - newMip;
+
+                D3D12_TEXTURE_COPY_LOCATION src = {};
+                src.pResource = source;
+                src.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+                src.SubresourceIndex = mip - texture.ResidentMip;
+
+                cmdList.CopyTextureRegion(&dst, 0, 0, 0, &src);
+            }
+
+            // Back to COMMON so passes promote it like any other texture
+            cmdList.TransitionBarrier(destination, D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_COMMON);
+            cmdList.TransitionBarrier(source, D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_COMMON);
+
+            m_Core->DeferRelease(texture.Resource);
+        }
+
+        const uint32_t view = texture.HasView ? 1 - texture.ActiveView : 0;
+
+        D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+        srvDesc.Format = texture.Image.Format;
+        srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+        srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+        srvDesc.Texture2D.MipLevels = mipLevels - newMip;
+        m_Core->GetDevice()->CreateShaderResourceView(destination, &srvDesc, texture.Views[view].CPU);
+
+        m_ResidentBytes -= texture.ResidentBytes;
+        texture.ResidentBytes = GetLevelBytes(texture, newMip, mipLevels);
+        m_ResidentBytes += texture.ResidentBytes;
+
+        texture.Resource = std::move(texture.PendingResource);
+        texture.ResidentMip = newMip;
+        texture.ActiveView = view;
+        texture.HasView = true;
+        texture.LastSwapFrame = m_FrameIndex;
+        texture.LastNeededFrame = m_FrameIndex;
+        texture.PendingMip = UINT32_MAX;
+        texture.PendingFence = 0;
+    }
+
+    size_t TextureStreamer::GetLevelBytes(const StreamedTexture& texture, uint32_t firstMip, uint32_t endMip) const
+    {
+        size_t bytes = 0;
+        for (uint32_t mip = firstMip; mip < endMip && mip < texture.Image.MipLevels; ++mip)
+        {
+            bytes += texture.Image.GetMipSize(mip);
+        }
+        return bytes;
+    }
+
+} // namespace SM
@@ -0,0 +1,209 @@
+#pragma once
+
+/**
+ * @file TextureStreamer.h
+ * @brief Mip residency streaming for large DDS textures
+ *
+ * A streamed texture starts with only its mip tail resident (levels no
+ * larger than TextureStreamerConfig::TailSize). Each frame, callers report
+ * how large the texture appears on screen; Update moves residency one level
+ * at a time toward the level that covers that size, within a per-frame
+ * upload budget, and drops levels that have gone unneeded for a while.
+ *
+ * Changing residency allocates a committed texture holding the new level
+ * range. New levels come from the memory-mapped file through the copy
+ * queue, kept levels are copied from the old texture on the direct queue,
+ * and the old texture goes through DX12Core::DeferRelease. Each streamed
+ * texture alternates between two SRVs so frames in flight keep a valid
+ * view: re-read GetBindlessIndex every frame rather than caching it.
+ */
+
+#include "renderer/DX12Core.h"
+#include "renderer/TextureLoader.h"
+#include "core/FileSystem.h"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace SM
+{
+    class CommandList;
+
+    using StreamedTextureID = uint32_t;
+    constexpr StreamedTextureID INVALID_STREAMED_TEXTURE = 0;
+
+    /**
+     * @brief Streaming limits
+     */
+    struct TextureStreamerConfig
+    {
+        uint32_t TailSize = 128;                            ///< Levels this size or smaller are always resident
+        size_t UploadBudgetPerFrame = 16 * 1024 * 1024;     ///< New level bytes staged per Update
+        uint32_t EvictDelayFrames = 120;                    ///< Frames a level goes unneeded before it is dropped
+        float MipBias = 0.0f;                               ///< Added to the wanted level (positive saves memory)
+    };
+
+    /**
+     * @brief Streams mip levels of registered textures in and out
+     *
+     * Example usage:
+     * @code
+     *   StreamedTextureID albedo = streamer.Register("assets/textures/rock_albedo.dds");
+     *
+     *   // Per frame, for each visible user of the texture
+     *   streamer.RequestDistance(albedo, distance, 4.0f, viewportHeight, fovY);
+     *   material.AlbedoIndex = streamer.GetBindlessIndex(albedo);
+     * @endcode
+     *
+     * Not thread-safe; call from the render thread.
+     */
+    class TextureStreamer
+    {
+    public:
+        TextureStreamer() = default;
+        ~TextureStreamer();
+
+        // Prevent copying
+        TextureStreamer(const TextureStreamer&) = delete;
+        TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+        bool Initialize(DX12Core* core, const TextureStreamerConfig& config = TextureStreamerConfig());
+        void Shutdown();
+
+        bool IsInitialized() const { return m_Core != nullptr; }
+
+        // ====================================================================
+        // Registration
+        // ====================================================================
+
+        /**
+         * @brief Start streaming a DDS texture with a baked mip chain
+         * @param path DDS file; stays mapped while registered
+         * @return ID, or INVALID_STREAMED_TEXTURE if the file cannot be streamed
+         *
+         * The mip tail is uploaded right away; GetBindlessIndex is invalid
+         * until it lands (a frame or two).
+         */
+        StreamedTextureID Register(const std::string& path);
+
+        /**
+         * @brief Stop streaming a texture and release its memory
+         */
+        void Unregister(StreamedTextureID id);
+
+        // ====================================================================
+        // Feedback
+        // ====================================================================
+
+        /**
+         * @brief Report how large a texture appears this frame
+         * @param id Streamed texture
+         * @param pixels Screen pixels its full width spans (largest over its users)
+         *
+         * The wanted level is log2(texture size / pixels) plus MipBias.
+         * Several requests per frame keep the most detailed one.
+         */
+        void RequestScreenSize(StreamedTextureID id, float pixels);
+
+        /**
+         * @brief Report a user of the texture by distance
+         * @param id Streamed texture
+         * @param distance Camera distance to the surface
+         * @param worldSize World units one repeat of the texture covers
+         * @param viewportHeight Viewport height in pixels
+         * @param fovY Vertical field of view in radians
+         */
+        void RequestDistance(StreamedTextureID id, float distance, float worldSize,
+                             float viewportHeight, float fovY);
+
+        /**
+         * @brief Finish landed uploads and start new residency changes
+         * @param cmdList Direct command list recorded before any pass samples textures
+         *
+         * Call once per frame. Clears this frame's requests.
+         */
+        void Update(CommandList& cmdList);
+
+        // ====================================================================
+        // Queries
+        // ====================================================================
+
+        /**
+         * @brief Get the current SRV's bindless index
+         * @return Heap index, or INVALID_BINDLESS_INDEX while nothing is resident
+         */
+        uint32_t GetBindlessIndex(StreamedTextureID id) const;
+
+        /**
+         * @brief Get the most detailed resident level (UINT32_MAX while nothing is resident)
+         */
+        uint32_t GetResidentMip(StreamedTextureID id) const;
+
+        /**
+         * @brief Get the bytes of level data resident across all textures
+         */
+        size_t GetResidentBytes() const { return m_ResidentBytes; }
+
+        size_t GetTextureCount() const { return m_Textures.size(); }
+
+    private:
+        struct StreamedTexture
+        {
+            std::string Path;
+            MappedFile File;
+            TextureImage Image;                         ///< Mips point into File
+            uint32_t TailMip = 0;                       ///< First level of the permanent tail
+
+            // Resident levels [ResidentMip, MipLevels)
+            ComPtr<ID3D12Resource> Resource;
+            uint32_t ResidentMip = UINT32_MAX;
+            size_t ResidentBytes = 0;
+
+            // Double-buffered views; the inactive one is rewritten on the next swap
+            std::array<DescriptorHandle, 2> Views;
+            uint32_t ActiveView = 0;
+            bool HasView = false;
+            uint64_t LastSwapFrame = 0;
+
+            // Feedback
+            uint32_t RequestedMip = UINT32_MAX;         ///< Most detailed level asked for this frame
+            uint64_t LastNeededFrame = 0;               ///< Last frame the top resident level was wanted
+
+            // Residency change in progress
+            ComPtr<ID3D12Resource> PendingResource;
+            uint32_t PendingMip = UINT32_MAX;
+            uint64_t PendingFence = 0;                  ///< UploadQueue fence of the new levels
+        };
+
+        /**
+         * @brief Check if a level can be the top of a texture (BC needs multiples of 4)
+         */
+        static bool IsValidTopMip(const TextureImage& image, uint32_t mip);
+
+        /**
+         * @brief Allocate the texture for a new level range and upload the missing levels
+         * @return false if the texture could not be created or staged
+         */
+        bool BeginResidencyChange(StreamedTexture& texture, uint32_t targetMip);
+
+        /**
+         * @brief Copy kept levels, swap to the new texture and publish its view
+         */
+        void CompleteResidencyChange(CommandList& cmdList, StreamedTexture& texture);
+
+        size_t GetLevelBytes(const StreamedTexture& texture, uint32_t firstMip, uint32_t endMip) const;
+
+    private:
+        DX12Core* m_Core = nullptr;
+        TextureStreamerConfig m_Config;
+
+        std::unordered_map<StreamedTextureID, StreamedTexture> m_Textures;
+        StreamedTextureID m_NextID = 1;
+
+        uint64_t m_FrameIndex = 0;                      ///< Counts Update calls
+        size_t m_ResidentBytes = 0;
+    };
+
+} // namespace SM
@@ -0,0 +1,578 @@
+#include "renderer/UploadQueue.h"
+#include "renderer/DX12Core.h"
+#include "renderer/GPUBuffer.h"
+#include "core/Profiler.h"
+
+#include <cstring>
+#include <iostream>
+
+namespace SM
+{
+    namespace
+    {
+        /// Buffer staging offsets are kept 16-byte aligned for vertex data;
+        /// textures use D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT
+        constexpr size_t STAGING_ALIGNMENT = 16;
+
+        ComPtr<ID3D12Resource> CreateUploadBuffer(ID3D12Device* device, size_t size)
+        {
+            D3D12_HEAP_PROPERTIES heapProps = {};
+            heapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
+
+            D3D12_RESOURCE_DESC desc = {};
+            desc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+            desc.Width = size;
+            desc.Height = 1;
+            desc.DepthOrArraySize = 1;
+            desc.MipLevels = 1;
+            desc.Format = DXGI_FORMAT_UNKNOWN;
+            desc.SampleDesc.Count = 1;
+            desc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+            ComPtr<ID3D12Resource> buffer;
+            HRESULT hr = device->CreateCommittedResource(
+                &heapProps,
+                D3D12_HEAP_FLAG_NONE,
+                &desc,
+                D3D12_RESOURCE_STATE_GENERIC_READ,
+                nullptr,
+                IID_PPV_ARGS(&buffer)
+            );
+
+            return SUCCEEDED(hr) ? buffer : nullptr;
+        }
+    }
+
+    UploadQueue::~UploadQueue()
+    {
+        Shutdown();
+    }
+
+    // ============================================================================
+    // Initialization
+    // ============================================================================
+
+    bool UploadQueue::Initialize(DX12Core* core, size_t stagingSize)
+    {
+        if (IsInitialized())
+        {
+            return true;
+        }
+
+        if (!core || !core->GetCopyQueue() || stagingSize == 0)
+        {
+            std::cerr << "[UploadQueue] Cannot initialize: no copy queue" << std::endl;
+            return false;
+        }
+
+        m_Core = core;
+        ID3D12Device* device = core->GetDevice();
+
+        m_Staging = CreateUploadBuffer(device, stagingSize);
+        if (!m_Staging)
+        {
+            std::cerr << "[UploadQueue] Failed to create staging ring!" << std::endl;
+            return false;
+        }
+
+        D3D12_RANGE readRange = { 0, 0 };
+        void* mapped = nullptr;
+        if (!CheckHResult(m_Staging->Map(0, &readRange, &mapped), "Failed to map staging ring"))
+        {
+            m_Staging.Reset();
+            return false;
+        }
+
+        m_StagingCPU = static_cast<uint8_t*>(mapped);
+        m_StagingSize = stagingSize;
+        m_Head = 0;
+        m_Tail = 0;
+
+        // The list is reset onto a free allocator whenever a batch starts
+        ComPtr<ID3D12CommandAllocator> allocator;
+        HRESULT hr = device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COPY, IID_PPV_ARGS(&allocator));
+        if (!CheckHResult(hr, "Failed to create copy command allocator"))
+        {
+            return false;
+        }
+
+        hr = device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_COPY, allocator.Get(), nullptr,
+                                       IID_PPV_ARGS(&m_CommandList));
+        if (!CheckHResult(hr, "Failed to create copy command list"))
+        {
+            return false;
+        }
+
+        m_CommandList->Close();
+        m_FreeAllocators.push_back(allocator);
+
+        m_FenceEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+        if (!m_FenceEvent)
+        {
+            std::cerr << "[UploadQueue] Failed to create fence event!" << std::endl;
+            return false;
+        }
+
+        hr = device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_Fence));
+        if (!CheckHResult(hr, "Failed to create upload fence"))
+        {
+            return false;
+        }
+
+        m_NextFenceValue = 1;
+
+        std::cout << "[UploadQueue] Initialized (" << (stagingSize / (1024 * 1024)) << " MB staging)" << std::endl;
+        return true;
+    }
+
+    void UploadQueue::Shutdown()
+    {
+        if (IsInitialized())
+        {
+            WaitForIdle();
+        }
+
+        if (m_FenceEvent)
+        {
+            CloseHandle(m_FenceEvent);
+            m_FenceEvent = nullptr;
+        }
+
+        if (m_Staging && m_StagingCPU)
+        {
+            m_Staging->Unmap(0, nullptr);
+        }
+
+        m_InFlight.clear();
+        m_Recording = Batch();
+        m_RecordingHasStaging = false;
+        m_FreeAllocators.clear();
+        m_CommandList.Reset();
+        m_Staging.Reset();
+        m_StagingCPU = nullptr;
+        m_StagingSize = 0;
+        m_Head = 0;
+        m_Tail = 0;
+        m_Fence.Reset();
+        m_WaitedFence = nullptr;
+        m_WaitedFenceValue = 0;
+        m_UploadedBytes = 0;
+        m_SubmissionCount = 0;
+        m_Core = nullptr;
+    }
+
+    // ============================================================================
+    // Uploads
+    // ============================================================================
+
+    uint64_t UploadQueue::UploadBuffer(ID3D12Resource* destination, uint64_t destinationOffset,
+                                       const void* data, size_t size)
+    {
+        if (!data)
+        {
+            return 0;
+        }
+
+        return UploadBuffer(destination, destinationOffset, size,
+            [data, size](void* mapped) { std::memcpy(mapped, data, size); });
+    }
+
+    uint64_t UploadQueue::UploadBuffer(ID3D12Resource* destination, uint64_t destinationOffset,
+                                       size_t size, const std::function<void(void*)>& write)
+    {
+        if (!IsInitialized() || !destination || !write || size == 0)
+        {
+            return 0;
+        }
+
+        ID3D12Resource* source = nullptr;
+        size_t sourceOffset = 0;
+        uint8_t* mapped = AcquireStaging(size, STAGING_ALIGNMENT, source, sourceOffset);
+        if (!mapped)
+        {
+            return 0;
+        }
+
+        write(mapped);
+
+        m_CommandList->CopyBufferRegion(destination, destinationOffset, source, sourceOffset, size);
+        m_Recording.Resources.push_back(destination);
+        m_UploadedBytes += size;
+
+        return m_NextFenceValue;
+    }
+
+    uint64_t UploadQueue::UploadTexture(ID3D12Resource* destination, uint32_t firstSubresource, uint32_t count,
+                                        const D3D12_SUBRESOURCE_DATA* data)
+    {
+        if (!IsInitialized() || !destination || !data || count == 0)
+        {
+            return 0;
+        }
+
+        D3D12_RESOURCE_DESC desc = destination->GetDesc();
+        std::vector<D3D12_PLACED_SUBRESOURCE_FOOTPRINT> layouts(count);
+        std::vector<UINT> rowCounts(count);
+        std::vector<UINT64> rowSizes(count);
+        UINT64 totalSize = 0;
+        m_Core->GetDevice()->GetCopyableFootprints(&desc, firstSubresource, count, 0,
+                                                   layouts.data(), rowCounts.data(), rowSizes.data(), &totalSize);
+        if (totalSize == 0 || totalSize == UINT64_MAX)
+        {
+            std::cerr << "[UploadQueue] Invalid texture subresource range" << std::endl;
+            return 0;
+        }
+
+        ID3D12Resource* source = nullptr;
+        size_t sourceOffset = 0;
+        uint8_t* mapped = AcquireStaging(static_cast<size_t>(totalSize), D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT,
+                                         source, sourceOffset);
+        if (!mapped)
+        {
+            return 0;
+        }
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const D3D12_SUBRESOURCE_FOOTPRINT& footprint = layouts[i].Footprint;
+            const size_t stagedSlicePitch = static_cast<size_t>(footprint.RowPitch) * rowCounts[i];
+            const auto* sourceRows = static_cast<const uint8_t*>(data[i].pData);
+            uint8_t* stagedRows = mapped + layouts[i].Offset;
+
+            // Sequential writes only: staging memory is write-combined
+            for (uint32_t slice = 0; slice < footprint.Depth; ++slice)
+            {
+                for (uint32_t row = 0; row < rowCounts[i]; ++row)
+                {
+                    std::memcpy(stagedRows + slice * stagedSlicePitch + row * footprint.RowPitch,
+                                sourceRows + slice * data[i].SlicePitch + row * data[i].RowPitch,
+                                static_cast<size_t>(rowSizes[i]));
+                }
+            }
+
+            D3D12_TEXTURE_COPY_LOCATION dst = {};
+            dst.pResource = destination;
+            dst.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+            dst.SubresourceIndex = firstSubresource + i;
+
+            D3D12_TEXTURE_COPY_LOCATION src = {};
+            src.pResource = source;
+            src.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+            src.PlacedFootprint = layouts[i];
+            src.PlacedFootprint.Offset += sourceOffset;
+
+            m_CommandList->CopyTextureRegion(&dst, 0, 0, 0, &src, nullptr);
+        }
+
+        m_Recording.Resources.push_back(destination);
+        m_UploadedBytes += totalSize;
+        return m_NextFenceValue;
+    }
+
+    void UploadQueue::WaitOnQueue(ID3D12CommandQueue* queue, uint64_t fenceValue)
+    {
+        if (!IsInitialized() || !queue || IsComplete(fenceValue))
+        {
+            return;
+        }
+
+        // The value belongs to the batch still being recorded
+        if (fenceValue >= m_NextFenceValue)
+        {
+            Flush();
+        }
+
+        queue->Wait(m_Fence.Get(), fenceValue);
+    }
+
+    void UploadQueue::WaitForQueue(ID3D12Fence* fence, uint64_t fenceValue)
+    {
+        if (!IsInitialized() || !fence || fence->GetCompletedValue() >= fenceValue)
+        {
+            return;
+        }
+
+        // Later copy-queue submissions are ordered after an earlier wait
+        if (fence == m_WaitedFence && fenceValue <= m_WaitedFenceValue)
+        {
+            return;
+        }
+
+        // Copies already recorded do not depend on the other queue
+        Flush();
+        m_Core->GetCopyQueue()->Wait(fence, fenceValue);
+        m_WaitedFence = fence;
+        m_WaitedFenceValue = fenceValue;
+    }
+
+    void UploadQueue::Flush()
+    {
+        if (!m_Recording.Allocator)
+        {
+            return;
+        }
+
+        if (!CheckHResult(m_CommandList->Close(), "Failed to close copy command list"))
+        {
+            return;
+        }
+
+        ID3D12CommandList* lists[] = { m_CommandList.Get() };
+        m_Core->GetCopyQueue()->ExecuteCommandLists(1, lists);
+        m_Core->GetCopyQueue()->Signal(m_Fence.Get(), m_NextFenceValue);
+
+        m_Recording.FenceValue = m_NextFenceValue;
+        m_Recording.StagingEnd = m_Head;
+        m_Recording.HasStaging = m_RecordingHasStaging;
+        m_InFlight.push_back(std::move(m_Recording));
+
+        m_Recording = Batch();
+        m_RecordingHasStaging = false;
+        m_NextFenceValue++;
+        m_SubmissionCount++;
+    }
+
+    void UploadQueue::SubmitFrame()
+    {
+        SM_PROFILE_SCOPE("UploadQueue::SubmitFrame");
+
+        Flush();
+
+        // Reclaim ring space and allocators from batches finished since the last frame
+        RetireCompleted();
+    }
+
+    bool UploadQueue::IsComplete(uint64_t fenceValue) const
+    {
+        if (fenceValue == 0)
+        {
+            return true;
+        }
+
+        return m_Fence && m_Fence->GetCompletedValue() >= fenceValue;
+    }
+
+    void UploadQueue::WaitForFence(uint64_t fenceValue)
+    {
+        if (!IsInitialized() || IsComplete(fenceValue))
+        {
+            return;
+        }
+
+        // The value belongs to the batch still being recorded
+        if (fenceValue >= m_NextFenceValue)
+        {
+            Flush();
+        }
+
+        if (m_Fence->GetCompletedValue() < fenceValue)
+        {
+            m_Fence->SetEventOnCompletion(fenceValue, m_FenceEvent);
+            WaitForSingleObject(m_FenceEvent, INFINITE);
+        }
+
+        RetireCompleted();
+    }
+
+    void UploadQueue::WaitForIdle()
+    {
+        Flush();
+
+        if (!m_InFlight.empty())
+        {
+            WaitForFence(m_InFlight.back().FenceValue);
+        }
+    }
+
+    size_t UploadQueue::GetStagingInUse() const
+    {
+        if (!HasLiveStaging())
+        {
+            return 0;
+        }
+
+        return (m_Head > m_Tail) ? (m_Head - m_Tail) : (m_StagingSize - m_Tail + m_Head);
+    }
+
+    // ============================================================================
+    // Private Methods
+    // ============================================================================
+
+    bool UploadQueue::BeginRecording()
+    {
+        if (m_Recording.Allocator)
+        {
+            return true;
+        }
+
+        RetireCompleted();
+
+        ComPtr<ID3D12CommandAllocator> allocator;
+        if (!m_FreeAllocators.empty())
+        {
+            allocator = m_FreeAllocators.back();
+            m_FreeAllocators.pop_back();
+            allocator->Reset();
+        }
+        else
+        {
+            HRESULT hr = m_Core->GetDevice()->CreateCommandAllocator(
+                D3D12_COMMAND_LIST_TYPE_COPY, IID_PPV_ARGS(&allocator));
+            if (!CheckHResult(hr, "Failed to create copy command allocator"))
+            {
+                return false;
+            }
+        }
+
+        if (!CheckHResult(m_CommandList->Reset(allocator.Get(), nullptr), "Failed to reset copy command list"))
+        {
+            m_FreeAllocators.push_back(allocator);
+            return false;
+        }
+
+        m_Recording.Allocator = allocator;
+        return true;
+    }
+
+    uint8_t* UploadQueue::AcquireStaging(size_t size, size_t alignment, ID3D12Resource*& outResource, size_t& outOffset)
+    {
+        // Oversize uploads get a dedicated staging buffer so the ring never has to drain
+        if (size > m_StagingSize / 2)
+        {
+            ComPtr<ID3D12Resource> staging = CreateUploadBuffer(m_Core->GetDevice(), size);
+            void* mapped = nullptr;
+            D3D12_RANGE readRange = { 0, 0 };
+            if (!staging || FAILED(staging->Map(0, &readRange, &mapped)))
+            {
+                std::cerr << "[UploadQueue] Failed to create staging buffer (" << size << " bytes)" << std::endl;
+                return nullptr;
+            }
+
+            if (!BeginRecording())
+            {
+                return nullptr;
+            }
+
+            // Stays mapped; the batch releases it once the copy completes
+            m_Recording.Resources.push_back(staging);
+            outResource = staging.Get();
+            outOffset = 0;
+            return static_cast<uint8_t*>(mapped);
+        }
+
+        // May flush and wait for older batches on the copy queue
+        if (!AllocateStaging(size, alignment, outOffset) || !BeginRecording())
+        {
+            return nullptr;
+        }
+
+        m_RecordingHasStaging = true;
+        outResource = m_Staging.Get();
+        return m_StagingCPU + outOffset;
+    }
+
+    bool UploadQueue::AllocateStaging(size_t size, size_t alignment, size_t& offset)
+    {
+        RetireCompleted();
+
+        while (!TryAllocateStaging(size, alignment, offset))
+        {
+            if (!m_InFlight.empty())
+            {
+                // Ring is full: wait for the oldest batch (copy queue only)
+                WaitForFence(m_InFlight.front().FenceValue);
+            }
+            else if (m_RecordingHasStaging)
+            {
+                // Everything live is in the open batch; submit it so it can retire
+                Flush();
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool UploadQueue::TryAllocateStaging(size_t size, size_t alignment, size_t& offset)
+    {
+        const bool live = HasLiveStaging();
+        if (!live)
+        {
+            m_Head = 0;
+            m_Tail = 0;
+        }
+
+        size_t start = AlignSize(m_Head, alignment);
+
+        if (!live || m_Head > m_Tail)
+        {
+            // Free space is [head, end) and [0, tail)
+            if (start + size <= m_StagingSize)
+            {
+                offset = start;
+            }
+            else if (size < m_Tail)
+            {
+                offset = 0;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        else
+        {
+            // Wrapped: free space is [head, tail); stay strictly below tail
+            if (start + size < m_Tail)
+            {
+                offset = start;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        m_Head = offset + size;
+        return true;
+    }
+
+    void UploadQueue::RetireCompleted()
+    {
+        if (!m_Fence)
+        {
+            return;
+        }
+
+        uint64_t completed = m_Fence->GetCompletedValue();
+        while (!m_InFlight.empty() && m_InFlight.front().FenceValue <= completed)
+        {
+            Batch& batch = m_InFlight.front();
+            m_Tail = batch.StagingEnd;
+            m_FreeAllocators.push_back(batch.Allocator);
+            m_InFlight.pop_front();
+        }
+    }
+
+    bool UploadQueue::HasLiveStaging() const
+    {
+        if (m_RecordingHasStaging)
+        {
+            return true;
+        }
+
+        for (const Batch& batch : m_InFlight)
+        {
+            if (batch.HasStaging)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+} // namespace SM
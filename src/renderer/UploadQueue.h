@@ -0,0 +1,249 @@
+#pragma once
+
+/**
+ * @file UploadQueue.h
+ * @brief Asynchronous buffer and texture uploads on the copy queue
+ *
+ * Data is staged in a persistently mapped ring of upload-heap memory and
+ * copied into DEFAULT-heap buffers and textures by command lists submitted
+ * to the copy queue. Each upload returns a fence value; the destination may be used on
+ * the direct queue once IsComplete() reports that value, so callers never
+ * stall the direct queue waiting for geometry.
+ *
+ * Every producer (chunk meshes, foliage instances, streamed textures,
+ * buffer initial data) records into the same open batch, and the renderer
+ * submits it once per frame with SubmitFrame(). A batch is only submitted
+ * early when something has to wait on it (WaitOnQueue, WaitForFence) or
+ * the ring runs out of room.
+ */
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <Windows.h>
+#include <d3d12.h>
+#include <wrl/client.h>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <vector>
+
+namespace SM
+{
+    class DX12Core;
+
+    /**
+     * @brief Copy-queue upload ring
+     *
+     * Copies recorded by UploadBuffer and UploadTexture are batched into one command list and
+     * submitted by SubmitFrame (or Flush when a dependency needs them sooner). Copy-queue
+     * destinations use implicit state promotion and decay, so a batch records no barriers.
+     * Not thread-safe; call from the render thread.
+     */
+    class UploadQueue
+    {
+    public:
+        UploadQueue() = default;
+        ~UploadQueue();
+
+        // Prevent copying
+        UploadQueue(const UploadQueue&) = delete;
+        UploadQueue& operator=(const UploadQueue&) = delete;
+
+        // ====================================================================
+        // Initialization
+        // ====================================================================
+
+        /**
+         * @brief Create the staging ring, copy command list and fence
+         * @param core DX12 core (device and copy queue)
+         * @param stagingSize Staging ring size in bytes
+         * @return true if successful
+         */
+        bool Initialize(DX12Core* core, size_t stagingSize);
+
+        /**
+         * @brief Wait for outstanding copies and release all resources
+         */
+        void Shutdown();
+
+        /**
+         * @brief Check if the queue is ready for uploads
+         */
+        bool IsInitialized() const { return m_Fence != nullptr; }
+
+        // ====================================================================
+        // Uploads
+        // ====================================================================
+
+        /**
+         * @brief Stage data and record a copy into a buffer
+         * @param destination DEFAULT-heap buffer in the COMMON state
+         * @param destinationOffset Byte offset in the destination
+         * @param data Source data
+         * @param size Number of bytes
+         * @return Fence value that completes with the copy (0 on failure)
+         *
+         * The destination is kept alive until the copy completes. It returns
+         * to the COMMON state afterwards and is promoted implicitly on first use.
+         */
+        uint64_t UploadBuffer(ID3D12Resource* destination, uint64_t destinationOffset,
+                              const void* data, size_t size);
+
+        /**
+         * @brief Stage data written in place and record a copy into a buffer
+         * @param destination DEFAULT-heap buffer in the COMMON state
+         * @param destinationOffset Byte offset in the destination
+         * @param size Number of bytes
+         * @param write Called once with size bytes of mapped staging memory to fill
+         * @return Fence value that completes with the copy (0 on failure)
+         *
+         * Lets producers generate straight into the staging ring instead of
+         * building a CPU copy first. Staging memory is write-combined: write
+         * it sequentially and never read it back.
+         */
+        uint64_t UploadBuffer(ID3D12Resource* destination, uint64_t destinationOffset,
+                              size_t size, const std::function<void(void*)>& write);
+
+        /**
+         * @brief Stage subresources and record copies into a texture
+         * @param destination DEFAULT-heap texture in the COMMON state
+         * @param firstSubresource First destination subresource (mip + array slice * mips)
+         * @param count Number of consecutive subresources
+         * @param data One tightly or loosely packed image per subresource
+         * @return Fence value that completes with the copies (0 on failure)
+         *
+         * Rows are repacked to the copy footprint's 256-byte pitch while
+         * staging. Like buffers, the texture decays to COMMON afterwards.
+         */
+        uint64_t UploadTexture(ID3D12Resource* destination, uint32_t firstSubresource, uint32_t count,
+                               const D3D12_SUBRESOURCE_DATA* data);
+
+        /**
+         * @brief Make another queue wait on the GPU for a fence value
+         * @param queue Queue whose later submissions depend on the copies
+         * @param fenceValue Value returned by an upload
+         *
+         * Submits the value first if it is still recording. The CPU never blocks.
+         */
+        void WaitOnQueue(ID3D12CommandQueue* queue, uint64_t fenceValue);
+
+        /**
+         * @brief Make copies recorded from now on wait on the GPU for another queue's fence
+         * @param fence Fence signaled by the other queue
+         * @param fenceValue Value the copies must wait for (must already be signaled or submitted)
+         *
+         * For overwriting a buffer that earlier direct-queue work may still
+         * read. Copies recorded before the call are submitted first, so they
+         * do not wait too. The CPU never blocks.
+         */
+        void WaitForQueue(ID3D12Fence* fence, uint64_t fenceValue);
+
+        /**
+         * @brief Submit recorded copies to the copy queue
+         *
+         * Producers should leave this to SubmitFrame; each call is one more
+         * ExecuteCommandLists and fence signal.
+         */
+        void Flush();
+
+        /**
+         * @brief Submit the frame's copies as one command list
+         *
+         * Called by the renderer once per frame, after every pass has
+         * recorded its uploads and before the frame's direct-queue work is
+         * submitted, so the copies overlap it.
+         */
+        void SubmitFrame();
+
+        /**
+         * @brief Check if the copies for a fence value have finished
+         */
+        bool IsComplete(uint64_t fenceValue) const;
+
+        /**
+         * @brief Block until a fence value completes (submits it first if needed)
+         *
+         * Waits on the copy queue only.
+         */
+        void WaitForFence(uint64_t fenceValue);
+
+        /**
+         * @brief Submit and wait for every recorded copy
+         */
+        void WaitForIdle();
+
+        /**
+         * @brief Get the staging bytes currently in use
+         */
+        size_t GetStagingInUse() const;
+
+        /**
+         * @brief Get the bytes staged for upload since Initialize
+         */
+        uint64_t GetUploadedBytes() const { return m_UploadedBytes; }
+
+        /**
+         * @brief Get the copy command lists submitted since Initialize
+         */
+        uint64_t GetSubmissionCount() const { return m_SubmissionCount; }
+
+    private:
+        /**
+         * @brief A submitted group of copies and the memory it keeps alive
+         */
+        struct Batch
+        {
+            Microsoft::WRL::ComPtr<ID3D12CommandAllocator> Allocator;
+            uint64_t FenceValue = 0;
+            size_t StagingEnd = 0;                                      ///< Ring head after this batch
+            bool HasStaging = false;                                    ///< Uses ring memory
+            std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> Resources; ///< Destinations and oversize staging
+        };
+
+        bool BeginRecording();
+
+        /**
+         * @brief Get staging memory for an upload, ring or dedicated
+         * @param outResource Staging resource the copy reads from
+         * @param outOffset Offset of the data in outResource
+         * @return Mapped pointer to fill, or nullptr on failure
+         */
+        uint8_t* AcquireStaging(size_t size, size_t alignment, ID3D12Resource*& outResource, size_t& outOffset);
+
+        bool AllocateStaging(size_t size, size_t alignment, size_t& offset);
+        bool TryAllocateStaging(size_t size, size_t alignment, size_t& offset);
+        void RetireCompleted();
+        bool HasLiveStaging() const;
+
+    private:
+        DX12Core* m_Core = nullptr;
+
+        // Staging ring (persistently mapped)
+        Microsoft::WRL::ComPtr<ID3D12Resource> m_Staging;
+        uint8_t* m_StagingCPU = nullptr;
+        size_t m_StagingSize = 0;
+        size_t m_Head = 0;                  ///< Next free byte
+        size_t m_Tail = 0;                  ///< Start of the oldest in-flight data
+
+        // Recording
+        Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> m_CommandList;
+        Batch m_Recording;                  ///< Batch being recorded (Allocator null when idle)
+        bool m_RecordingHasStaging = false;
+        std::deque<Batch> m_InFlight;
+        std::vector<Microsoft::WRL::ComPtr<ID3D12CommandAllocator>> m_FreeAllocators;
+
+        // Synchronization
+        Microsoft::WRL::ComPtr<ID3D12Fence> m_Fence;
+        uint64_t m_NextFenceValue = 1;      ///< Value the recording batch will signal
+        HANDLE m_FenceEvent = nullptr;
+        ID3D12Fence* m_WaitedFence = nullptr; ///< Last fence the copy queue was made to wait on (see WaitForQueue)
+        uint64_t m_WaitedFenceValue = 0;
+
+        // Statistics
+        uint64_t m_UploadedBytes = 0;
+        uint64_t m_SubmissionCount = 0;
+    };
+
+} // namespace SM
@@ -0,0 +1,423 @@
+/**
+ * @file CoreBenchmarks.cpp
+ * @brief ECS iteration, object pool and mesh processing kernels
+ */
+
+#include "core/Memory.h"
+#include "ecs/ECS.h"
+#include "renderer/Mesh.h"
+#include "renderer/MeshOptimizer.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+namespace
+{
+    // ========================================================================
+    // ECS
+    // ========================================================================
+
+    /// Args: entity count, storage mode (0 = Sparse, 1 = Archetype)
+    void BM_World_ForEach(benchmark::State& state)
+    {
+        const int64_t entityCount = state.range(0);
+        const auto mode = state.range(1) != 0 ? SM::ComponentStorageMode::Archetype : SM::ComponentStorageMode::Sparse;
+
+        SM::World world(mode);
+        world.RegisterComponent<SM::TransformComponent>();
+        world.RegisterComponent<SM::VelocityComponent>();
+
+        // Every fourth entity has no velocity, so the query has something to skip
+        int64_t matching = 0;
+        for (int64_t i = 0; i < entityCount; ++i)
+        {
+            SM::EntityID entity = world.CreateEntity();
+            world.AddComponent(entity, SM::TransformComponent{});
+            if (i % 4 != 0)
+            {
+                float v = static_cast<float>(i % 17);
+                world.AddComponent(entity, SM::VelocityComponent{ SM::Vector3(v, 0.5f, -v) });
+                matching++;
+            }
+        }
+
+        constexpr float DELTA_TIME = 1.0f / 60.0f;
+
+        for (auto _ : state)
+        {
+            world.ForEach<SM::TransformComponent, SM::VelocityComponent>(
+                [](SM::EntityID, SM::TransformComponent& transform, SM::VelocityComponent& velocity) {
+                    transform.Position.x += velocity.Linear.x * DELTA_TIME;
+                    transform.Position.y += velocity.Linear.y * DELTA_TIME;
+                    transform.Position.z += velocity.Linear.z * DELTA_TIME;
+                });
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * matching);
+    }
+    BENCHMARK(BM_World_ForEach)
+        ->ArgNames({ "entities", "archetype" })
+        ->ArgsProduct({ { 1 << 12, 1 << 16 }, { 0, 1 } });
+
+    /// Args: entity count. Per-entity lookups, the access pattern of scripts and editor code
+    void BM_World_GetComponent(benchmark::State& state)
+    {
+        const int64_t entityCount = state.range(0);
+
+        SM::World world;
+        world.RegisterComponent<SM::TransformComponent>();
+        world.RegisterComponent<SM::VelocityComponent>();
+
+        std::vector<SM::EntityID> entities;
+        entities.reserve(static_cast<size_t>(entityCount));
+        for (int64_t i = 0; i < entityCount; ++i)
+        {
+            SM::EntityID entity = world.CreateEntity();
+            world.AddComponent(entity, SM::TransformComponent{});
+            world.AddComponent(entity, SM::VelocityComponent{ SM::Vector3(1.0f, 0.0f, 0.0f) });
+            entities.push_back(entity);
+        }
+
+        for (auto _ : state)
+        {
+            for (SM::EntityID entity : entities)
+            {
+                SM::TransformComponent& transform = world.GetComponent<SM::TransformComponent>(entity);
+                const SM::VelocityComponent& velocity = world.GetComponent<SM::VelocityComponent>(entity);
+                transform.Position.x += velocity.Linear.x;
+            }
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * entityCount);
+    }
+    BENCHMARK(BM_World_GetComponent)->ArgName("entities")->Arg(1 << 12)->Arg(1 << 16);
+
+    /// Args: entity count, path (0 = immediate World calls, 1 = EntityCommandBuffer, 2 = prefab)
+    void BM_World_SpawnDespawn(benchmark::State& state)
+    {
+        const int64_t entityCount = state.range(0);
+        const int64_t path = state.range(1);
+
+        SM::World world;
+        world.RegisterComponent<SM::TransformComponent>();
+        world.RegisterComponent<SM::VelocityComponent>();
+
+        std::vector<SM::EntityID> entities;
+        std::vector<SM::PendingEntity> pending;
+        entities.reserve(static_cast<size_t>(entityCount));
+        pending.reserve(static_cast<size_t>(entityCount));
+
+        SM::EntityPrefab prefab;
+        prefab.Add(SM::TransformComponent{}).Add(SM::VelocityComponent{});
+
+        for (auto _ : state)
+        {
+            entities.clear();
+
+            if (path == 2)
+            {
+                entities = world.CreateEntities(static_cast<uint32_t>(entityCount), prefab);
+
+                SM::EntityCommandBuffer& commands = world.GetCommandBuffer();
+                for (SM::EntityID entity : entities)
+                {
+                    commands.DestroyEntity(entity);
+                }
+                world.FlushCommands();
+            }
+            else if (path == 1)
+            {
+                SM::EntityCommandBuffer& commands = world.GetCommandBuffer();
+
+                pending.clear();
+                for (int64_t i = 0; i < entityCount; ++i)
+                {
+                    SM::PendingEntity entity = commands.CreateEntity();
+                    commands.AddComponent(entity, SM::TransformComponent{});
+                    commands.AddComponent(entity, SM::VelocityComponent{});
+                    pending.push_back(entity);
+                }
+                world.FlushCommands();
+
+                for (const SM::PendingEntity& entity : pending)
+                {
+                    commands.DestroyEntity(commands.Resolve(entity));
+                }
+                world.FlushCommands();
+            }
+            else
+            {
+                for (int64_t i = 0; i < entityCount; ++i)
+                {
+                    SM::EntityID entity = world.CreateEntity();
+                    world.AddComponent(entity, SM::TransformComponent{});
+                    world.AddComponent(entity, SM::VelocityComponent{});
+                    entities.push_back(entity);
+                }
+
+                for (SM::EntityID entity : entities)
+                {
+                    world.DestroyEntity(entity);
+                }
+            }
+
+            benchmark::DoNotOptimize(world.GetEntityCount());
+        }
+
+        state.SetItemsProcessed(state.iterations() * entityCount);
+    }
+    BENCHMARK(BM_World_SpawnDespawn)
+        ->ArgNames({ "entities", "path" })
+        ->ArgsProduct({ { 1 << 12, 1 << 16 }, { 0, 1, 2 } });
+
+    /// Args: entity count, storage mode (0 = Sparse, 1 = Archetype)
+    void BM_World_SnapshotRoundTrip(benchmark::State& state)
+    {
+        const int64_t entityCount = state.range(0);
+        const auto mode = state.range(1) != 0 ? SM::ComponentStorageMode::Archetype : SM::ComponentStorageMode::Sparse;
+
+        SM::World world(mode);
+        world.RegisterComponent<SM::TransformComponent>();
+        world.RegisterComponent<SM::VelocityComponent>();
+        world.RegisterComponent<SM::TagComponent>();
+
+        // Raw blocks for transform and velocity, the typed serializer for tags
+        for (int64_t i = 0; i < entityCount; ++i)
+        {
+            SM::EntityID entity = world.CreateEntity();
+            world.AddComponent(entity, SM::TransformComponent{});
+            world.AddComponent(entity, SM::VelocityComponent{});
+            if (i % 8 == 0)
+            {
+                world.AddComponent(entity, SM::TagComponent("Entity"));
+            }
+        }
+
+        std::vector<uint8_t> snapshot;
+        for (auto _ : state)
+        {
+            world.SaveSnapshot(snapshot);
+            world.LoadSnapshot(snapshot.data(), snapshot.size());
+            benchmark::DoNotOptimize(world.GetEntityCount());
+        }
+
+        state.SetItemsProcessed(state.iterations() * entityCount);
+        state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(snapshot.size()));
+    }
+    BENCHMARK(BM_World_SnapshotRoundTrip)
+        ->ArgNames({ "entities", "archetype" })
+        ->ArgsProduct({ { 1 << 12, 100000 }, { 0, 1 } })
+        ->Unit(benchmark::kMillisecond);
+
+    // ========================================================================
+    // Memory
+    // ========================================================================
+
+    struct BenchParticle
+    {
+        float Position[3] = {};
+        float Velocity[3] = {};
+        float Age = 0.0f;
+        float Lifetime = 1.0f;
+    };
+
+    /// Args: objects acquired and released per iteration
+    void BM_ObjectPool_Acquire(benchmark::State& state)
+    {
+        const size_t count = static_cast<size_t>(state.range(0));
+
+        SM::ObjectPool<BenchParticle> pool(count);
+        std::vector<BenchParticle*> acquired;
+        acquired.reserve(count);
+
+        for (auto _ : state)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                acquired.push_back(pool.Acquire());
+            }
+
+            // Timed too: pausing the timer per iteration would cost more than the releases
+            for (BenchParticle* particle : acquired)
+            {
+                pool.Release(particle);
+            }
+            acquired.clear();
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+    }
+    BENCHMARK(BM_ObjectPool_Acquire)->Arg(256)->Arg(4096);
+
+    /// Args: allocation size in bytes; 256 blocks are held live per iteration
+    void BM_GeneralAllocator_AllocFree(benchmark::State& state)
+    {
+        constexpr size_t LIVE_COUNT = 256;
+        const size_t size = static_cast<size_t>(state.range(0));
+
+        std::vector<void*> blocks(LIVE_COUNT);
+        for (auto _ : state)
+        {
+            for (void*& block : blocks)
+            {
+                block = SM::GeneralAllocator::Allocate(size);
+            }
+            benchmark::DoNotOptimize(blocks.data());
+            for (void* block : blocks)
+            {
+                SM::GeneralAllocator::Free(block);
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(LIVE_COUNT));
+    }
+    BENCHMARK(BM_GeneralAllocator_AllocFree)->ArgName("bytes")->Arg(32)->Arg(512)->Arg(4096)->ThreadRange(1, 4);
+
+    /// Args: alignment in bytes (SPAN_SIZE and above place the header below the data)
+    void BM_GeneralAllocator_AlignedLarge(benchmark::State& state)
+    {
+        const size_t alignment = static_cast<size_t>(state.range(0));
+        constexpr size_t SIZE = 100 * 1024;
+
+        for (auto _ : state)
+        {
+            void* block = SM::GeneralAllocator::Allocate(SIZE, alignment, SM::MemoryTag::Renderer);
+            if (!block || reinterpret_cast<uintptr_t>(block) % alignment != 0 ||
+                SM::GeneralAllocator::GetUsableSize(block) < SIZE ||
+                SM::GeneralAllocator::GetTag(block) != SM::MemoryTag::Renderer)
+            {
+                state.SkipWithError("Aligned large allocation is misplaced or lost its header");
+                SM::GeneralAllocator::Free(block);
+                break;
+            }
+            benchmark::DoNotOptimize(block);
+            SM::GeneralAllocator::Free(block);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_GeneralAllocator_AlignedLarge)
+        ->ArgName("alignment")
+        ->Arg(4096)
+        ->Arg(static_cast<int64_t>(SM::GeneralAllocator::SPAN_SIZE))
+        ->Arg(static_cast<int64_t>(SM::GeneralAllocator::SPAN_SIZE * 4));
+
+    /// Same pattern through the default operator new, for comparison
+    void BM_OperatorNew_AllocFree(benchmark::State& state)
+    {
+        constexpr size_t LIVE_COUNT = 256;
+        const size_t size = static_cast<size_t>(state.range(0));
+
+        std::vector<void*> blocks(LIVE_COUNT);
+        for (auto _ : state)
+        {
+            for (void*& block : blocks)
+            {
+                block = ::operator new(size);
+            }
+            benchmark::DoNotOptimize(blocks.data());
+            for (void* block : blocks)
+            {
+                ::operator delete(block);
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(LIVE_COUNT));
+    }
+    BENCHMARK(BM_OperatorNew_AllocFree)->ArgName("bytes")->Arg(32)->Arg(512)->Arg(4096)->ThreadRange(1, 4);
+
+    // ========================================================================
+    // Mesh Processing
+    // ========================================================================
+
+    /// Args: grid quads per side (32 = a terrain chunk at LOD 0)
+    void BM_MeshOptimizer_VertexCache(benchmark::State& state)
+    {
+        const uint32_t quads = static_cast<uint32_t>(state.range(0));
+        const SM::MeshData grid = SM::MeshGenerator::CreatePlane(1.0f, 1.0f, quads, quads);
+        const float before = SM::MeshOptimizer::AnalyzeVertexCache(
+            grid.Indices.data(), grid.Indices.size(), grid.GetVertexCount());
+
+        std::vector<uint32_t> indices;
+        for (auto _ : state)
+        {
+            indices = grid.Indices;
+            SM::MeshOptimizer::OptimizeVertexCache(indices, grid.GetVertexCount());
+            benchmark::DoNotOptimize(indices.data());
+        }
+
+        state.counters["acmr_before"] = before;
+        state.counters["acmr_after"] = SM::MeshOptimizer::AnalyzeVertexCache(
+            indices.data(), indices.size(), grid.GetVertexCount());
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(grid.Indices.size() / 3));
+    }
+    BENCHMARK(BM_MeshOptimizer_VertexCache)->ArgName("quads")->Arg(32)->Arg(128);
+
+    /// Args: sphere slices (stacks are half)
+    void BM_MeshOptimizer_GenerateLODs(benchmark::State& state)
+    {
+        const uint32_t slices = static_cast<uint32_t>(state.range(0));
+        SM::MeshData sphere = SM::MeshGenerator::CreateSphere(1.0f, slices, slices / 2);
+        SM::MeshOptimizer::Optimize(sphere);
+
+        std::vector<SM::MeshData> lods;
+        for (auto _ : state)
+        {
+            SM::MeshOptimizer::GenerateLODs(sphere, 3, lods);
+            benchmark::DoNotOptimize(lods.data());
+        }
+
+        state.counters["levels"] = static_cast<double>(lods.size());
+        state.counters["coarsest_triangles"] = lods.empty()
+            ? static_cast<double>(sphere.GetIndexCount() / 3) : static_cast<double>(lods.back().GetIndexCount() / 3);
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(sphere.GetIndexCount() / 3));
+    }
+    BENCHMARK(BM_MeshOptimizer_GenerateLODs)->ArgName("slices")->Arg(32)->Arg(256);
+
+    /// Args: grid quads per side
+    void BM_MeshOptimizer_BuildMeshlets(benchmark::State& state)
+    {
+        const uint32_t quads = static_cast<uint32_t>(state.range(0));
+        SM::MeshData grid = SM::MeshGenerator::CreatePlane(1.0f, 1.0f, quads, quads);
+        SM::MeshOptimizer::Optimize(grid);
+
+        std::vector<SM::MeshOptimizer::Meshlet> meshlets;
+        std::vector<uint32_t> vertices;
+        std::vector<uint32_t> triangles;
+        for (auto _ : state)
+        {
+            meshlets.clear();
+            vertices.clear();
+            triangles.clear();
+            SM::MeshOptimizer::BuildMeshlets(grid.Indices.data(), grid.Indices.size(), grid.GetVertexCount(),
+                                             meshlets, vertices, triangles);
+            benchmark::DoNotOptimize(meshlets.data());
+        }
+
+        state.counters["meshlets"] = static_cast<double>(meshlets.size());
+        state.counters["vertices_per_meshlet"] = meshlets.empty() ? 0.0
+            : static_cast<double>(vertices.size()) / static_cast<double>(meshlets.size());
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(grid.Indices.size() / 3));
+    }
+    BENCHMARK(BM_MeshOptimizer_BuildMeshlets)->ArgName("quads")->Arg(32)->Arg(128);
+
+    /// Args: sphere slices (stacks are half)
+    void BM_MeshData_CalculateNormals(benchmark::State& state)
+    {
+        const uint32_t slices = static_cast<uint32_t>(state.range(0));
+        SM::MeshData sphere = SM::MeshGenerator::CreateSphere(1.0f, slices, slices / 2);
+
+        for (auto _ : state)
+        {
+            sphere.CalculateNormals();
+            benchmark::DoNotOptimize(sphere.Vertices.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(sphere.GetIndexCount() / 3));
+    }
+    BENCHMARK(BM_MeshData_CalculateNormals)->ArgName("slices")->Arg(32)->Arg(256);
+
+} // namespace
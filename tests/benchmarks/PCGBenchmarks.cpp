@@ -0,0 +1,400 @@
+/**
+ * @file PCGBenchmarks.cpp
+ * @brief Noise, biome climate, chunk generation, chunk vertex, terrain raycast, foliage scatter and erosion kernels
+ */
+
+#include "pcg/Biome.h"
+#include "pcg/Chunk.h"
+#include "pcg/FBM.h"
+#include "pcg/FoliageScatter.h"
+#include "pcg/HeightmapGenerator.h"
+#include "pcg/Noise.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+    constexpr uint32_t BENCH_SEED = 1337;
+
+    // ========================================================================
+    // Noise
+    // ========================================================================
+
+    void BM_PerlinNoise_Sample(benchmark::State& state)
+    {
+        PCG::PerlinNoise noise(BENCH_SEED);
+        const int64_t samples = state.range(0);
+
+        for (auto _ : state)
+        {
+            float sum = 0.0f;
+            for (int64_t i = 0; i < samples; ++i)
+            {
+                sum += noise.Sample(static_cast<float>(i) * 0.37f, static_cast<float>(i) * 0.11f);
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+
+        state.SetItemsProcessed(state.iterations() * samples);
+    }
+    BENCHMARK(BM_PerlinNoise_Sample)->Arg(1 << 10)->Arg(1 << 14);
+
+    /// Args: return type (0 = F1, 2 = F2 - F1), 3D (0/1)
+    void BM_WorleyNoise_Sample(benchmark::State& state)
+    {
+        PCG::WorleyNoise noise(BENCH_SEED);
+        noise.SetReturnType(static_cast<PCG::WorleyNoise::ReturnType>(state.range(0)));
+        const bool volume = state.range(1) != 0;
+
+        constexpr int SAMPLES = 4096;
+
+        for (auto _ : state)
+        {
+            float sum = 0.0f;
+            for (int i = 0; i < SAMPLES; ++i)
+            {
+                const float x = static_cast<float>(i) * 0.37f;
+                const float y = static_cast<float>(i) * 0.11f;
+                sum += volume ? noise.Sample(x, y, static_cast<float>(i) * 0.23f) : noise.Sample(x, y);
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+
+        state.SetItemsProcessed(state.iterations() * SAMPLES);
+    }
+    BENCHMARK(BM_WorleyNoise_Sample)->ArgNames({ "type", "3d" })->ArgsProduct({ { 0, 2 }, { 0, 1 } });
+
+    /// Args: return type (0 = F1, 2 = F2 - F1)
+    void BM_WorleyNoise_SampleGrid(benchmark::State& state)
+    {
+        PCG::WorleyNoise noise(BENCH_SEED);
+        noise.SetReturnType(static_cast<PCG::WorleyNoise::ReturnType>(state.range(0)));
+
+        constexpr int SIZE = 256;
+        std::vector<float> grid(SIZE * SIZE);
+
+        for (auto _ : state)
+        {
+            noise.SampleGrid(0.0f, 0.0f, 1.0f, SIZE, SIZE, grid.data(), 0.05f);
+            benchmark::DoNotOptimize(grid.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * SIZE * SIZE);
+    }
+    BENCHMARK(BM_WorleyNoise_SampleGrid)->ArgName("type")->Arg(0)->Arg(2);
+
+    void BM_FBM_Sample(benchmark::State& state)
+    {
+        PCG::PerlinNoise noise(BENCH_SEED);
+        PCG::FBM fbm(&noise);
+
+        PCG::FBMSettings settings;
+        settings.Octaves = static_cast<int>(state.range(0));
+        settings.Frequency = 0.01f;
+
+        constexpr int SAMPLES = 4096;
+
+        for (auto _ : state)
+        {
+            float sum = 0.0f;
+            for (int i = 0; i < SAMPLES; ++i)
+            {
+                sum += fbm.Sample(static_cast<float>(i) * 0.37f, static_cast<float>(i) * 0.11f, settings);
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+
+        state.SetItemsProcessed(state.iterations() * SAMPLES);
+    }
+    BENCHMARK(BM_FBM_Sample)->Arg(4)->Arg(8);
+
+    // ========================================================================
+    // Chunks
+    // ========================================================================
+
+    /// Args: domain warp (0/1)
+    void BM_Chunk_Generate(benchmark::State& state)
+    {
+        PCG::HeightmapGenerator generator;
+
+        PCG::HeightmapSettings settings;
+        settings.Seed = BENCH_SEED;
+        settings.ApplyDomainWarp = state.range(0) != 0;
+
+        PCG::Chunk chunk(PCG::ChunkCoord(3, -2));
+
+        for (auto _ : state)
+        {
+            chunk.Generate(generator, settings);
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * PCG::Chunk::VERTEX_COUNT);
+    }
+    BENCHMARK(BM_Chunk_Generate)->ArgName("warp")->Arg(0)->Arg(1);
+
+    /// Args: LOD level
+    void BM_Chunk_BuildVertices(benchmark::State& state)
+    {
+        PCG::HeightmapGenerator generator;
+
+        PCG::HeightmapSettings settings;
+        settings.Seed = BENCH_SEED;
+
+        PCG::Chunk chunk(PCG::ChunkCoord(3, -2));
+        chunk.Generate(generator, settings);
+        chunk.SetLOD(static_cast<int>(state.range(0)));
+
+        std::vector<PCG::TerrainVertex> vertices;
+
+        for (auto _ : state)
+        {
+            chunk.BuildVertices(vertices);
+            benchmark::DoNotOptimize(vertices.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(vertices.size()));
+    }
+    BENCHMARK(BM_Chunk_BuildVertices)->ArgName("lod")->DenseRange(0, PCG::Chunk::MAX_LOD);
+
+    /// Args: quantized heights (0/1)
+    void BM_Chunk_HeightQueries(benchmark::State& state)
+    {
+        PCG::HeightmapGenerator generator;
+
+        PCG::HeightmapSettings settings;
+        settings.Seed = BENCH_SEED;
+
+        PCG::Chunk chunk(PCG::ChunkCoord(3, -2));
+        chunk.Generate(generator, settings);
+        if (state.range(0))
+        {
+            chunk.QuantizeHeights();
+        }
+
+        // Off-grid points, so every query interpolates four samples
+        constexpr int QUERY_SIDE = 32;
+        float sum = 0.0f;
+        for (auto _ : state)
+        {
+            for (int z = 0; z < QUERY_SIDE; ++z)
+            {
+                for (int x = 0; x < QUERY_SIDE; ++x)
+                {
+                    sum += chunk.GetHeightInterpolated(static_cast<float>(x) + 0.37f, static_cast<float>(z) + 0.61f);
+                }
+            }
+        }
+
+        benchmark::DoNotOptimize(sum);
+        state.SetItemsProcessed(state.iterations() * QUERY_SIDE * QUERY_SIDE);
+        state.counters["bytes"] = static_cast<double>(chunk.GetHeightBytes());
+    }
+    BENCHMARK(BM_Chunk_HeightQueries)->ArgName("quantized")->Arg(0)->Arg(1);
+
+    /// Args: quantized heights (0/1)
+    void BM_Chunk_CopyHeights(benchmark::State& state)
+    {
+        PCG::HeightmapGenerator generator;
+
+        PCG::HeightmapSettings settings;
+        settings.Seed = BENCH_SEED;
+
+        PCG::Chunk chunk(PCG::ChunkCoord(3, -2));
+        chunk.Generate(generator, settings);
+        if (state.range(0))
+        {
+            chunk.QuantizeHeights();
+        }
+
+        std::vector<float> heights;
+        for (auto _ : state)
+        {
+            chunk.CopyHeights(heights);
+            benchmark::DoNotOptimize(heights.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * PCG::Chunk::VERTEX_COUNT);
+    }
+    BENCHMARK(BM_Chunk_CopyHeights)->ArgName("quantized")->Arg(0)->Arg(1);
+
+    /// Args: brush radius in samples (one dab per iteration, alternately raising and lowering)
+    void BM_Chunk_EditHeights(benchmark::State& state)
+    {
+        PCG::HeightmapGenerator generator;
+
+        PCG::HeightmapSettings settings;
+        settings.Seed = BENCH_SEED;
+
+        PCG::Chunk chunk(PCG::ChunkCoord(0, 0));
+        chunk.Generate(generator, settings);
+
+        const float radius = static_cast<float>(state.range(0));
+        const float centre = PCG::Chunk::GetWorldSize() * 0.5f;
+        float delta = 0.25f;
+
+        for (auto _ : state)
+        {
+            chunk.EditHeights(centre - radius, centre - radius, centre + radius, centre + radius,
+                              [centre, radius, delta](float x, float z, float height) {
+                                  const float dx = x - centre;
+                                  const float dz = z - centre;
+                                  const float falloff = std::max(0.0f, 1.0f - std::sqrt(dx * dx + dz * dz) / radius);
+                                  return height + delta * falloff;
+                              });
+            chunk.ClearDirtyRegion();
+            delta = -delta;
+        }
+
+        const int side = 2 * static_cast<int>(state.range(0)) + 1;
+        state.SetItemsProcessed(state.iterations() * side * side);
+    }
+    BENCHMARK(BM_Chunk_EditHeights)->ArgName("radius")->Arg(2)->Arg(8);
+
+    /// Args: ray pitch below the horizon in degrees (shallow rays cross more of the chunk)
+    void BM_Chunk_Raycast(benchmark::State& state)
+    {
+        PCG::HeightmapGenerator generator;
+
+        PCG::HeightmapSettings settings;
+        settings.Seed = BENCH_SEED;
+
+        PCG::Chunk chunk(PCG::ChunkCoord(3, -2));
+        chunk.Generate(generator, settings);
+
+        // A fan of rays from above one corner, swept across the chunk
+        constexpr int RAY_COUNT = 256;
+        const DirectX::XMFLOAT3 corner = chunk.GetWorldPosition();
+        const float pitch = static_cast<float>(state.range(0)) * 3.14159265f / 180.0f;
+
+        std::vector<PCG::TerrainRay> rays(RAY_COUNT);
+        for (int i = 0; i < RAY_COUNT; ++i)
+        {
+            const float yaw = 0.5f * 3.14159265f * (static_cast<float>(i) + 0.5f) / RAY_COUNT;
+            rays[i].Origin = DirectX::XMFLOAT3(corner.x, chunk.GetMaxHeight() + 1.0f, corner.z);
+            rays[i].Direction = DirectX::XMFLOAT3(std::cos(pitch) * std::cos(yaw), -std::sin(pitch),
+                                                  std::cos(pitch) * std::sin(yaw));
+        }
+
+        int64_t hitCount = 0;
+        for (auto _ : state)
+        {
+            for (const PCG::TerrainRay& ray : rays)
+            {
+                PCG::TerrainHit hit;
+                hitCount += chunk.Raycast(ray, 0.0f, ray.MaxDistance, hit) ? 1 : 0;
+            }
+        }
+
+        benchmark::DoNotOptimize(hitCount);
+        state.SetItemsProcessed(state.iterations() * RAY_COUNT);
+    }
+    BENCHMARK(BM_Chunk_Raycast)->ArgName("pitch")->Arg(5)->Arg(30)->Arg(80);
+
+    /// Args: layer spacing in tenths of a world unit
+    void BM_FoliageScatter_Chunk(benchmark::State& state)
+    {
+        PCG::HeightmapGenerator generator;
+
+        PCG::HeightmapSettings settings;
+        settings.Seed = BENCH_SEED;
+
+        PCG::Chunk chunk(PCG::ChunkCoord(3, -2));
+        chunk.Generate(generator, settings);
+
+        // Every point passes the biome test, so the rank, height and slope filters do the thinning
+        const std::vector<PCG::BiomeType> biomes(PCG::Chunk::VERTEX_COUNT, PCG::BiomeType::Forest);
+
+        PCG::ScatterLayer layer;
+        layer.Spacing = static_cast<float>(state.range(0)) * 0.1f;
+        layer.Density = 0.6f;
+
+        PCG::FoliageScatter scatter;
+        scatter.SetLayers({ layer }, BENCH_SEED);
+
+        PCG::ChunkScatter placements;
+        for (auto _ : state)
+        {
+            scatter.ScatterChunk(chunk.GetCoord(), chunk.GetHeights(), biomes, placements);
+            benchmark::DoNotOptimize(placements.Instances.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(scatter.GetTilePointCount(0)));
+        state.counters["placed"] = static_cast<double>(placements.Instances.size());
+    }
+    BENCHMARK(BM_FoliageScatter_Chunk)->ArgName("spacing")->Arg(10)->Arg(40);
+
+    // ========================================================================
+    // Biomes
+    // ========================================================================
+
+    /// Args: climate step in pixels (1 = every pixel)
+    void BM_BiomeGenerator_ClimateMaps(benchmark::State& state)
+    {
+        PCG::BiomeGenerator::Settings settings;
+        settings.Width = 512;
+        settings.Height = 512;
+        settings.Seed = BENCH_SEED;
+        settings.ClimateStep = static_cast<int>(state.range(0));
+
+        PCG::BiomeGenerator generator;
+        for (auto _ : state)
+        {
+            std::vector<float> moisture = generator.GenerateMoistureMap(settings);
+            std::vector<float> temperature = generator.GenerateTemperatureMap(settings);
+            benchmark::DoNotOptimize(moisture.data());
+            benchmark::DoNotOptimize(temperature.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * settings.Width * settings.Height);
+    }
+    BENCHMARK(BM_BiomeGenerator_ClimateMaps)->ArgName("step")->Arg(1)->Arg(4)->Arg(8);
+
+    // ========================================================================
+    // Erosion
+    // ========================================================================
+
+    /// Args: map size, parallel (0/1); droplets scale with the map area
+    void BM_HeightmapGenerator_ApplyErosion(benchmark::State& state)
+    {
+        const int size = static_cast<int>(state.range(0));
+
+        PCG::HeightmapGenerator generator;
+
+        PCG::HeightmapSettings settings;
+        settings.Seed = BENCH_SEED;
+        settings.Width = size;
+        settings.Height = size;
+        const std::vector<float> source = generator.Generate(settings);
+
+        PCG::ErosionSettings erosion;
+        erosion.Seed = BENCH_SEED;
+        erosion.Iterations = size * size / 4;
+        erosion.Parallel = state.range(1) != 0;
+
+        std::vector<float> heightmap;
+
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            heightmap = source;
+            state.ResumeTiming();
+
+            generator.ApplyErosion(heightmap, size, size, erosion);
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * erosion.Iterations);
+    }
+    BENCHMARK(BM_HeightmapGenerator_ApplyErosion)
+        ->ArgNames({ "size", "parallel" })
+        ->Args({ 128, 0 })
+        ->Args({ 256, 0 })
+        ->Args({ 256, 1 })
+        ->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,419 @@
+/**
+ * @file StreamingReplay.cpp
+ * @brief Headless terrain-streaming replay benchmark
+ *
+ * Replays a camera path recorded in the engine (F9, see Engine::
+ * ToggleCameraPathRecording) through ChunkManager::Update with no DX12
+ * device: chunks are generated and their vertices built, but nothing is
+ * uploaded. Without --path a built-in 60 second flight is replayed. The
+ * chunk manager is configured like the engine's, so runs before and after a
+ * change to streaming scheduling, caching or noise kernels see identical
+ * camera input.
+ *
+ * Frames replay back to back with the recorded delta times reported to the
+ * scheduler. Async generation and the streaming time budget both depend on
+ * the machine's timing; use --sync --budget=0 for identical work per frame.
+ *
+ * Reports (console and StreamingReplay-<commit>.json):
+ * - Generation throughput (chunks per second of replay wall time)
+ * - Generation queue depth and chunks in flight (mean and max)
+ * - p50/p95/p99/max of per-frame ChunkManager::Update time
+ * - Peak resident chunk memory (height and biome grids)
+ * - Chunks missing at view: inside the view distance and frustum but not generated
+ *
+ * Usage:
+ *   StreamingReplay [--path=<file.smcam>] [--sync] [--budget=<ms>] [--frames=<n>] [--out=<file>]
+ */
+
+#include "core/FileSystem.h"
+#include "gameplay/CameraPath.h"
+#include "pcg/ChunkManager.h"
+#include "renderer/Frustum.h"
+
+#include <DirectXMath.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef SM_BENCH_COMMIT
+#define SM_BENCH_COMMIT "unknown"
+#endif
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct ReplayOptions
+    {
+        std::string PathFile;           ///< Empty = built-in flight
+        std::string OutputFile;
+        bool Async = true;
+        float BudgetMs = -1.0f;         ///< < 0 = ChunkManagerConfig default
+        size_t MaxFrames = 0;           ///< 0 = whole path
+    };
+
+    struct ReplayResults
+    {
+        size_t Frames = 0;
+        double ReplaySeconds = 0.0;     ///< Wall time of the whole replay
+        double SimulatedSeconds = 0.0;  ///< Summed recorded delta times
+        uint64_t Generated = 0;
+
+        std::vector<double> UpdateMs;
+
+        double MeanQueued = 0.0;
+        size_t MaxQueued = 0;
+        double MeanInFlight = 0.0;
+        size_t MaxInFlight = 0;
+
+        size_t PeakResidentBytes = 0;
+        size_t PeakLoadedChunks = 0;
+
+        uint64_t MissingTotal = 0;      ///< Summed over frames
+        uint32_t MissingMax = 0;
+        size_t FramesWithMissing = 0;
+    };
+
+    // ========================================================================
+    // Camera paths
+    // ========================================================================
+
+    /**
+     * @brief Build the default flight: a wide figure-eight at sprint speed, 60 Hz
+     */
+    SM::CameraPath BuildDefaultPath()
+    {
+        constexpr int FRAMES = 3600;
+        constexpr float DELTA_TIME = 1.0f / 60.0f;
+        constexpr float RADIUS = 600.0f;
+        constexpr float ALTITUDE = 60.0f;
+        constexpr float SPEED = 20.0f;  ///< FPSCameraController move speed with sprint
+
+        const float period = 2.0f * 3.14159265358979323846f * RADIUS / SPEED;
+        const DirectX::XMMATRIX proj = DirectX::XMMatrixPerspectiveFovLH(
+            DirectX::XMConvertToRadians(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+
+        auto positionAt = [&](float t) {
+            float phase = 2.0f * 3.14159265358979323846f * t / period;
+            return DirectX::XMFLOAT3(RADIUS * std::sin(phase), ALTITUDE, RADIUS * std::sin(phase) * std::cos(phase));
+        };
+
+        SM::CameraPath path;
+        for (int i = 0; i < FRAMES; ++i)
+        {
+            float t = static_cast<float>(i) * DELTA_TIME;
+            DirectX::XMFLOAT3 position = positionAt(t);
+            DirectX::XMFLOAT3 next = positionAt(t + DELTA_TIME);
+
+            SM::CameraPathSample sample;
+            sample.DeltaTime = DELTA_TIME;
+            sample.Position = position;
+            sample.Velocity = DirectX::XMFLOAT3(
+                (next.x - position.x) / DELTA_TIME, 0.0f, (next.z - position.z) / DELTA_TIME);
+
+            // Look along the direction of travel, pitched slightly down
+            float dx = next.x - position.x;
+            float dz = next.z - position.z;
+            float horizontal = std::sqrt(dx * dx + dz * dz);
+            DirectX::XMVECTOR eye = DirectX::XMLoadFloat3(&position);
+            DirectX::XMVECTOR forward = DirectX::XMVector3Normalize(
+                DirectX::XMVectorSet(dx, -0.15f * horizontal, dz, 0.0f));
+            DirectX::XMMATRIX view = DirectX::XMMatrixLookToLH(eye, forward, DirectX::XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+            DirectX::XMStoreFloat4x4(&sample.ViewProjection, DirectX::XMMatrixMultiply(view, proj));
+
+            path.AddSample(sample);
+        }
+
+        return path;
+    }
+
+    // ========================================================================
+    // Measurement
+    // ========================================================================
+
+    /**
+     * @brief Count chunks within the view distance and frustum that are not generated
+     *
+     * Missing chunks have no height range yet, so each is tested as a column
+     * spanning the terrain's full height range.
+     */
+    uint32_t CountMissingAtView(const PCG::ChunkManager& manager, const SM::CameraPathSample& sample)
+    {
+        const PCG::ChunkManagerConfig& config = manager.GetConfig();
+        const float chunkSize = PCG::Chunk::GetWorldSize();
+        const float viewDistance = config.ViewDistance;
+        const SM::Frustum frustum(DirectX::XMLoadFloat4x4(&sample.ViewProjection));
+
+        const int centerX = static_cast<int>(std::floor(sample.Position.x / chunkSize));
+        const int centerZ = static_cast<int>(std::floor(sample.Position.z / chunkSize));
+        const int radius = static_cast<int>(std::ceil(viewDistance / chunkSize));
+
+        uint32_t missing = 0;
+        for (int z = centerZ - radius; z <= centerZ + radius; ++z)
+        {
+            for (int x = centerX - radius; x <= centerX + radius; ++x)
+            {
+                PCG::ChunkCoord coord(x, z);
+                DirectX::XMFLOAT3 center = coord.ToWorldCenter(chunkSize);
+                float dx = center.x - sample.Position.x;
+                float dz = center.z - sample.Position.z;
+                if (dx * dx + dz * dz > viewDistance * viewDistance)
+                {
+                    continue;
+                }
+
+                DirectX::XMFLOAT3 origin = coord.ToWorldPosition(chunkSize);
+                SM::BoundingBox bounds;
+                bounds.Min = DirectX::XMFLOAT3(origin.x, config.TerrainSettings.MinHeight, origin.z);
+                bounds.Max = DirectX::XMFLOAT3(origin.x + chunkSize, config.TerrainSettings.MaxHeight, origin.z + chunkSize);
+                if (!frustum.Intersects(bounds))
+                {
+                    continue;
+                }
+
+                const PCG::Chunk* chunk = manager.GetChunk(coord);
+                if (!chunk || !chunk->IsGenerated())
+                {
+                    missing++;
+                }
+            }
+        }
+
+        return missing;
+    }
+
+    double Percentile(const std::vector<double>& sorted, double percentile)
+    {
+        if (sorted.empty())
+        {
+            return 0.0;
+        }
+
+        // Nearest rank
+        size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0 * static_cast<double>(sorted.size())));
+        return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+    }
+
+    // ========================================================================
+    // Replay
+    // ========================================================================
+
+    PCG::ChunkManagerConfig BuildConfig(const ReplayOptions& options)
+    {
+        // Matches Engine::InitializeTerrain
+        PCG::ChunkManagerConfig config;
+        config.ViewDistance = 200.0f;
+        config.UnloadDistance = 250.0f;
+        config.MaxChunksPerFrame = 2;
+        config.MaxMeshBuildsPerFrame = 4;
+        config.AsyncGeneration = options.Async;
+
+        config.TerrainSettings.Seed = 42;
+        config.TerrainSettings.Width = PCG::Chunk::SIZE;
+        config.TerrainSettings.Height = PCG::Chunk::SIZE;
+        config.TerrainSettings.MinHeight = 0.0f;
+        config.TerrainSettings.MaxHeight = 50.0f;
+        config.TerrainSettings.Noise = PCG::FBMSettings::Terrain();
+        config.TerrainSettings.Noise.Frequency = 0.01f;
+        config.TerrainSettings.ApplyDomainWarp = true;
+        config.TerrainSettings.WarpStrength = 0.2f;
+
+        if (options.BudgetMs >= 0.0f)
+        {
+            config.StreamingBudgetMs = options.BudgetMs;
+        }
+
+        return config;
+    }
+
+    bool Replay(const SM::CameraPath& path, const ReplayOptions& options, ReplayResults& results)
+    {
+        PCG::ChunkManager manager;
+        if (!manager.Initialize(nullptr, BuildConfig(options)))
+        {
+            std::cerr << "[StreamingReplay] Failed to initialize chunk manager" << std::endl;
+            return false;
+        }
+
+        const std::vector<SM::CameraPathSample>& samples = path.GetSamples();
+        const size_t frames = options.MaxFrames > 0 ? std::min(options.MaxFrames, samples.size()) : samples.size();
+        results.UpdateMs.reserve(frames);
+
+        auto replayStart = Clock::now();
+
+        for (size_t i = 0; i < frames; ++i)
+        {
+            const SM::CameraPathSample& sample = samples[i];
+
+            manager.SetLastFrameTime(sample.DeltaTime);
+
+            auto start = Clock::now();
+            manager.Update(sample.Position, DirectX::XMLoadFloat4x4(&sample.ViewProjection), sample.Velocity);
+            auto end = Clock::now();
+
+            results.UpdateMs.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+            results.SimulatedSeconds += sample.DeltaTime;
+
+            size_t queued = manager.GetPendingCount();
+            size_t inFlight = manager.GetInFlightCount();
+            results.MeanQueued += static_cast<double>(queued);
+            results.MaxQueued = std::max(results.MaxQueued, queued);
+            results.MeanInFlight += static_cast<double>(inFlight);
+            results.MaxInFlight = std::max(results.MaxInFlight, inFlight);
+
+            results.PeakResidentBytes = std::max(results.PeakResidentBytes, manager.GetResidentChunkBytes());
+            results.PeakLoadedChunks = std::max(results.PeakLoadedChunks, manager.GetLoadedChunkCount());
+
+            uint32_t missing = CountMissingAtView(manager, sample);
+            results.MissingTotal += missing;
+            results.MissingMax = std::max(results.MissingMax, missing);
+            if (missing > 0)
+            {
+                results.FramesWithMissing++;
+            }
+        }
+
+        results.ReplaySeconds = std::chrono::duration<double>(Clock::now() - replayStart).count();
+        results.Frames = frames;
+        results.Generated = manager.GetGeneratedChunkCount();
+
+        if (frames > 0)
+        {
+            results.MeanQueued /= static_cast<double>(frames);
+            results.MeanInFlight /= static_cast<double>(frames);
+        }
+
+        manager.Shutdown();
+        return true;
+    }
+
+    // ========================================================================
+    // Report
+    // ========================================================================
+
+    std::string BuildReport(const ReplayOptions& options, const ReplayResults& results)
+    {
+        std::vector<double> sorted = results.UpdateMs;
+        std::sort(sorted.begin(), sorted.end());
+
+        double totalMs = 0.0;
+        for (double ms : sorted)
+        {
+            totalMs += ms;
+        }
+
+        const double frames = static_cast<double>(std::max<size_t>(results.Frames, 1));
+        const double throughput = results.ReplaySeconds > 0.0
+            ? static_cast<double>(results.Generated) / results.ReplaySeconds : 0.0;
+
+        std::ostringstream json;
+        json << std::fixed << std::setprecision(4);
+        json << "{\n";
+        json << "  \"context\": {\n";
+        json << "    \"commit\": \"" << SM_BENCH_COMMIT << "\",\n";
+        json << "    \"path\": \"" << (options.PathFile.empty() ? "builtin" : options.PathFile) << "\",\n";
+        json << "    \"async\": " << (options.Async ? "true" : "false") << ",\n";
+        json << "    \"budget_ms\": " << options.BudgetMs << "\n";
+        json << "  },\n";
+        json << "  \"frames\": " << results.Frames << ",\n";
+        json << "  \"replay_seconds\": " << results.ReplaySeconds << ",\n";
+        json << "  \"simulated_seconds\": " << results.SimulatedSeconds << ",\n";
+        json << "  \"generation\": { \"chunks\": " << results.Generated
+             << ", \"chunks_per_second\": " << throughput << " },\n";
+        json << "  \"update_ms\": { \"mean\": " << totalMs / frames
+             << ", \"p50\": " << Percentile(sorted, 50.0)
+             << ", \"p95\": " << Percentile(sorted, 95.0)
+             << ", \"p99\": " << Percentile(sorted, 99.0)
+             << ", \"max\": " << (sorted.empty() ? 0.0 : sorted.back()) << " },\n";
+        json << "  \"queue\": { \"mean_queued\": " << results.MeanQueued
+             << ", \"max_queued\": " << results.MaxQueued
+             << ", \"mean_in_flight\": " << results.MeanInFlight
+             << ", \"max_in_flight\": " << results.MaxInFlight << " },\n";
+        json << "  \"memory\": { \"peak_resident_bytes\": " << results.PeakResidentBytes
+             << ", \"peak_loaded_chunks\": " << results.PeakLoadedChunks << " },\n";
+        json << "  \"missing_at_view\": { \"mean\": " << static_cast<double>(results.MissingTotal) / frames
+             << ", \"max\": " << results.MissingMax
+             << ", \"frames_with_missing\": " << results.FramesWithMissing << " }\n";
+        json << "}\n";
+        return json.str();
+    }
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    ReplayOptions options;
+    options.OutputFile = std::string("StreamingReplay-") + SM_BENCH_COMMIT + ".json";
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* arg = argv[i];
+        if (std::strncmp(arg, "--path=", 7) == 0)
+        {
+            options.PathFile = arg + 7;
+        }
+        else if (std::strncmp(arg, "--out=", 6) == 0)
+        {
+            options.OutputFile = arg + 6;
+        }
+        else if (std::strncmp(arg, "--budget=", 9) == 0)
+        {
+            options.BudgetMs = std::strtof(arg + 9, nullptr);
+        }
+        else if (std::strncmp(arg, "--frames=", 9) == 0)
+        {
+            options.MaxFrames = static_cast<size_t>(std::strtoull(arg + 9, nullptr, 10));
+        }
+        else if (std::strcmp(arg, "--sync") == 0)
+        {
+            options.Async = false;
+        }
+        else
+        {
+            std::cerr << "Usage: StreamingReplay [--path=<file.smcam>] [--sync] [--budget=<ms>] "
+                         "[--frames=<n>] [--out=<file>]" << std::endl;
+            return 1;
+        }
+    }
+
+    SM::CameraPath path;
+    if (options.PathFile.empty())
+    {
+        path = BuildDefaultPath();
+    }
+    else if (!path.Load(options.PathFile))
+    {
+        return 1;
+    }
+
+    if (path.IsEmpty())
+    {
+        std::cerr << "[StreamingReplay] Camera path has no frames" << std::endl;
+        return 1;
+    }
+
+    ReplayResults results;
+    if (!Replay(path, options, results))
+    {
+        return 1;
+    }
+
+    std::string report = BuildReport(options, results);
+    std::cout << report;
+
+    if (!SM::FileSystem::WriteTextFile(options.OutputFile, report))
+    {
+        std::cerr << "[StreamingReplay] Failed to write " << options.OutputFile << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,57 @@
+/**
+ * @file main.cpp
+ * @brief Entry point for the ShatteredMoonBench benchmark suite
+ *
+ * Runs the PCG, ECS and memory kernels headless (no window or DX12 device)
+ * with fixed seeds. Unless --benchmark_out is given, results are also
+ * written as JSON to ShatteredMoonBench-<commit>.json in the working
+ * directory, with the commit recorded in the report's context, so runs can
+ * be collected and compared per commit.
+ *
+ * Usage:
+ *   ShatteredMoonBench [--benchmark_filter=<regex>] [--benchmark_out=<file>]
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifndef SM_BENCH_COMMIT
+#define SM_BENCH_COMMIT "unknown"
+#endif
+
+int main(int argc, char** argv)
+{
+    std::vector<char*> args(argv, argv + argc);
+
+    bool hasOutput = false;
+    for (char* arg : args)
+    {
+        if (std::strncmp(arg, "--benchmark_out=", 16) == 0)
+        {
+            hasOutput = true;
+        }
+    }
+
+    std::string outputArg = std::string("--benchmark_out=ShatteredMoonBench-") + SM_BENCH_COMMIT + ".json";
+    std::string formatArg = "--benchmark_out_format=json";
+    if (!hasOutput)
+    {
+        args.push_back(outputArg.data());
+        args.push_back(formatArg.data());
+    }
+
+    int count = static_cast<int>(args.size());
+    benchmark::Initialize(&count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(count, args.data()))
+    {
+        return 1;
+    }
+
+    benchmark::AddCustomContext("commit", SM_BENCH_COMMIT);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
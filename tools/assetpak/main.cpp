@@ -0,0 +1,51 @@
+/**
+ * @file main.cpp
+ * @brief Entry point for the assetpak archive builder
+ *
+ * Packs every file below a directory into one .smpak archive that
+ * ResourceManager::MountArchive can serve assets from.
+ *
+ * Usage:
+ *   assetpak <input directory> <output archive>
+ */
+
+#include "core/AssetArchive.h"
+#include "core/FileSystem.h"
+
+#include <chrono>
+#include <iostream>
+
+int main(int argc, char** argv)
+{
+    if (argc != 3)
+    {
+        std::cerr << "Usage: assetpak <input directory> <output archive>" << std::endl;
+        return 1;
+    }
+
+    const std::string inputDirectory = argv[1];
+    const std::string outputPath = argv[2];
+
+    if (!SM::FileSystem::IsDirectory(inputDirectory))
+    {
+        std::cerr << "[assetpak] Not a directory: " << inputDirectory << std::endl;
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    SM::AssetArchiveWriter writer;
+    size_t fileCount = writer.AddDirectory(inputDirectory);
+
+    std::string error;
+    if (!writer.Write(outputPath, &error))
+    {
+        std::cerr << "[assetpak] " << error << std::endl;
+        return 1;
+    }
+
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "[assetpak] Packed " << fileCount << " files into " << outputPath << " ("
+              << SM::FileSystem::GetFileSize(outputPath) << " bytes, " << elapsed << " ms)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,201 @@
+/**
+ * @file main.cpp
+ * @brief Entry point for the meshcook offline mesh cooker
+ *
+ * Reads a Wavefront OBJ mesh and writes a .smmesh file (CookedMesh) with
+ * cache-ordered streams, levels of detail and meshlets, ready for
+ * CookedMesh::Load to upload without parsing.
+ *
+ * Usage:
+ *   meshcook <input.obj> <output.smmesh> [lod count]
+ */
+
+#include "renderer/CookedMesh.h"
+#include "core/FileSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <tuple>
+
+namespace
+{
+    constexpr uint32_t DEFAULT_LOD_COUNT = 4;
+
+    /**
+     * @brief Resolve an OBJ index (1-based, or negative from the end) to 0-based
+     * @return -1 when absent or out of range
+     */
+    int ResolveIndex(const std::string& token, size_t count)
+    {
+        if (token.empty())
+        {
+            return -1;
+        }
+
+        const long index = std::strtol(token.c_str(), nullptr, 10);
+        const long resolved = index < 0 ? static_cast<long>(count) + index : index - 1;
+        return (resolved >= 0 && resolved < static_cast<long>(count)) ? static_cast<int>(resolved) : -1;
+    }
+
+    /**
+     * @brief Load positions, texture coordinates and normals of an OBJ file
+     *
+     * Faces are fan-triangulated; each distinct position/uv/normal corner
+     * becomes one vertex. Missing normals are computed afterwards. OBJ is
+     * right-handed, so Z is mirrored for the engine's left-handed space.
+     */
+    bool LoadOBJ(const std::string& path, SM::MeshData& outData)
+    {
+        std::ifstream file(path);
+        if (!file)
+        {
+            std::cerr << "[meshcook] Failed to open " << path << std::endl;
+            return false;
+        }
+
+        std::vector<DirectX::XMFLOAT3> positions;
+        std::vector<DirectX::XMFLOAT2> texCoords;
+        std::vector<DirectX::XMFLOAT3> normals;
+        std::map<std::tuple<int, int, int>, uint32_t> corners;
+        bool missingNormals = false;
+
+        std::string line;
+        std::vector<uint32_t> face;
+        while (std::getline(file, line))
+        {
+            std::istringstream stream(line);
+            std::string keyword;
+            stream >> keyword;
+
+            if (keyword == "v")
+            {
+                DirectX::XMFLOAT3& p = positions.emplace_back();
+                stream >> p.x >> p.y >> p.z;
+                p.z = -p.z;
+            }
+            else if (keyword == "vt")
+            {
+                DirectX::XMFLOAT2& uv = texCoords.emplace_back();
+                stream >> uv.x >> uv.y;
+                uv.y = 1.0f - uv.y;
+            }
+            else if (keyword == "vn")
+            {
+                DirectX::XMFLOAT3& n = normals.emplace_back();
+                stream >> n.x >> n.y >> n.z;
+                n.z = -n.z;
+            }
+            else if (keyword == "f")
+            {
+                face.clear();
+                std::string corner;
+                while (stream >> corner)
+                {
+                    // v, v/vt, v//vn or v/vt/vn
+                    std::string parts[3];
+                    size_t part = 0;
+                    for (char c : corner)
+                    {
+                        if (c == '/')
+                        {
+                            part = std::min<size_t>(part + 1, 2);
+                        }
+                        else
+                        {
+                            parts[part] += c;
+                        }
+                    }
+
+                    const int p = ResolveIndex(parts[0], positions.size());
+                    if (p < 0)
+                    {
+                        std::cerr << "[meshcook] Bad face corner '" << corner << "' in " << path << std::endl;
+                        return false;
+                    }
+                    const int t = ResolveIndex(parts[1], texCoords.size());
+                    const int n = ResolveIndex(parts[2], normals.size());
+                    missingNormals |= (n < 0);
+
+                    auto [it, inserted] = corners.emplace(std::make_tuple(p, t, n), outData.GetVertexCount());
+                    if (inserted)
+                    {
+                        SM::Vertex& vertex = outData.Vertices.emplace_back();
+                        vertex.Position = positions[p];
+                        if (t >= 0)
+                        {
+                            vertex.TexCoord = texCoords[t];
+                        }
+                        if (n >= 0)
+                        {
+                            vertex.Normal = normals[n];
+                        }
+                    }
+                    face.push_back(it->second);
+                }
+
+                // Mirroring Z already turns OBJ's counter-clockwise faces clockwise
+                for (size_t i = 2; i < face.size(); ++i)
+                {
+                    outData.Indices.push_back(face[0]);
+                    outData.Indices.push_back(face[i - 1]);
+                    outData.Indices.push_back(face[i]);
+                }
+            }
+        }
+
+        if (missingNormals)
+        {
+            outData.CalculateNormals();
+        }
+        return !outData.Indices.empty();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc != 3 && argc != 4)
+    {
+        std::cerr << "Usage: meshcook <input.obj> <output.smmesh> [lod count]" << std::endl;
+        return 1;
+    }
+
+    const std::string inputPath = argv[1];
+    const std::string outputPath = argv[2];
+    const uint32_t lodCount = (argc == 4) ? static_cast<uint32_t>(std::strtoul(argv[3], nullptr, 10)) : DEFAULT_LOD_COUNT;
+
+    auto start = std::chrono::steady_clock::now();
+
+    SM::MeshData data;
+    if (!LoadOBJ(inputPath, data))
+    {
+        return 1;
+    }
+
+    std::vector<uint8_t> bytes;
+    if (!SM::CookedMesh::Cook(data, lodCount, bytes))
+    {
+        std::cerr << "[meshcook] " << inputPath << " has no valid triangles" << std::endl;
+        return 1;
+    }
+
+    if (!SM::FileSystem::WriteFile(outputPath, bytes))
+    {
+        std::cerr << "[meshcook] Failed to write " << outputPath << std::endl;
+        return 1;
+    }
+
+    SM::CookedMeshHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "[meshcook] " << inputPath << " -> " << outputPath << ": " << header.VertexCount << " vertices, "
+              << header.LODCount << " levels, " << header.MeshletCount << " meshlets (" << bytes.size()
+              << " bytes, " << elapsed << " ms)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file main.cpp
+ * @brief Entry point for the worldbake terrain pre-baker
+ *
+ * Generates a rectangle of terrain chunks into the on-disk chunk cache
+ * (ChunkCache region files), so spawn areas ship pre-generated and neither
+ * servers nor clients generate them at runtime. Runs headless: a
+ * ChunkManager with no DX12 device, generating each cache region's chunks
+ * across every core through the job system.
+ *
+ * Terrain settings match Engine::InitializeTerrain (only the seed can be
+ * changed), so the records land under the settings key the engine opens
+ * when ChunkManagerConfig::DiskCache is enabled. Cached records hold heights
+ * only: the apron and biomes are resampled on load, and runtime chunks are
+ * not eroded, so neither is computed here.
+ *
+ * Usage:
+ *   worldbake <minX> <minZ> <maxX> <maxZ> [--seed=<n>] [--cache=<dir>] [--threads=<n>]
+ *
+ * Coordinates are chunk coordinates, both corners inclusive.
+ */
+
+#include "core/JobSystem.h"
+#include "pcg/ChunkManager.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+namespace
+{
+    struct BakeOptions
+    {
+        PCG::ChunkCoord First;
+        PCG::ChunkCoord Last;
+        uint32_t Seed = 42;
+        std::string CachePath = "cache/terrain";
+        uint32_t Threads = 0;           ///< 0 = hardware concurrency - 1 workers
+    };
+
+    PCG::ChunkManagerConfig BuildConfig(const BakeOptions& options)
+    {
+        // Terrain settings match Engine::InitializeTerrain
+        PCG::ChunkManagerConfig config;
+        config.TerrainSettings.Seed = options.Seed;
+        config.TerrainSettings.Width = PCG::Chunk::SIZE;
+        config.TerrainSettings.Height = PCG::Chunk::SIZE;
+        config.TerrainSettings.MinHeight = 0.0f;
+        config.TerrainSettings.MaxHeight = 50.0f;
+        config.TerrainSettings.Noise = PCG::FBMSettings::Terrain();
+        config.TerrainSettings.Noise.Frequency = 0.01f;
+        config.TerrainSettings.ApplyDomainWarp = true;
+        config.TerrainSettings.WarpStrength = 0.2f;
+
+        // Only heights are stored, so skip what loading resamples anyway
+        config.ChunkApron = false;
+        config.ChunkBiomes = false;
+        config.HeightLRUBudget = 0;
+
+        config.DiskCache = true;
+        config.DiskCachePath = options.CachePath;
+        return config;
+    }
+
+    void PrintUsage()
+    {
+        std::cerr << "Usage: worldbake <minX> <minZ> <maxX> <maxZ> [--seed=<n>] [--cache=<dir>] [--threads=<n>]"
+                  << std::endl;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 5)
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    BakeOptions options;
+    options.First = PCG::ChunkCoord(std::atoi(argv[1]), std::atoi(argv[2]));
+    options.Last = PCG::ChunkCoord(std::atoi(argv[3]), std::atoi(argv[4]));
+
+    for (int i = 5; i < argc; ++i)
+    {
+        const char* arg = argv[i];
+        if (std::strncmp(arg, "--seed=", 7) == 0)
+        {
+            options.Seed = static_cast<uint32_t>(std::strtoul(arg + 7, nullptr, 10));
+        }
+        else if (std::strncmp(arg, "--cache=", 8) == 0)
+        {
+            options.CachePath = arg + 8;
+        }
+        else if (std::strncmp(arg, "--threads=", 10) == 0)
+        {
+            options.Threads = static_cast<uint32_t>(std::strtoul(arg + 10, nullptr, 10));
+        }
+        else
+        {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    SM::JobSystem& jobs = SM::JobSystem::Get();
+    if (!jobs.Initialize(options.Threads))
+    {
+        std::cerr << "[worldbake] Failed to start workers, baking on one thread" << std::endl;
+    }
+
+    PCG::ChunkManager manager;
+    if (!manager.Initialize(nullptr, BuildConfig(options)))
+    {
+        std::cerr << "[worldbake] Failed to initialize chunk manager" << std::endl;
+        jobs.Shutdown();
+        return 1;
+    }
+
+    if (!manager.GetConfig().DiskCache)
+    {
+        std::cerr << "[worldbake] Failed to open the chunk cache at " << options.CachePath << std::endl;
+        manager.Shutdown();
+        jobs.Shutdown();
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    const uint32_t baked = manager.BakeRegion(options.First, options.Last);
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const PCG::ChunkCacheStats& stats = manager.GetDiskCacheStats();
+    std::cout << "[worldbake] Chunks (" << options.First.X << ", " << options.First.Z << ") to ("
+              << options.Last.X << ", " << options.Last.Z << "), seed " << options.Seed << ": baked " << baked
+              << " (" << stats.BytesWritten << " bytes) in " << elapsed << " s on "
+              << jobs.GetWorkerCount() + 1 << " threads" << std::endl;
+
+    manager.Shutdown();
+    jobs.Shutdown();
+    return 0;
+}